@@ -0,0 +1,333 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+/// \file
+/// \brief This file implements a flat spatial index for radius and k-nearest neighbor queries
+
+#ifndef GEOMETRY__SPATIAL_INDEX_HPP_
+#define GEOMETRY__SPATIAL_INDEX_HPP_
+
+#include <common/types.hpp>
+#include <geometry/common_2d.hpp>
+#include <geometry/spatial_hash_config.hpp>
+#include <geometry/visibility_control.hpp>
+
+#include <geometry_msgs/msg/polygon.hpp>
+#include <geometry_msgs/msg/pose.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
+#include <sensor_msgs/point_cloud2_iterator.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace autoware
+{
+namespace common
+{
+namespace geometry
+{
+namespace spatial_hash
+{
+/// \brief A spatial index over flat storage, meant to be cleared and refilled every cycle.
+/// \tparam ConfigT Config2d or Config3d, the bins have the lookup radius of the config as side
+///
+/// Contrary to SpatialHash, the points are stored in a single vector reserved to the capacity of
+/// the config and sorted by bin before the first query, so that clear() and insert() never
+/// allocate and the points of a row of bins are contiguous in memory. Each point carries an id
+/// chosen by the caller, which is how results are mapped back to poses, polygons, etc.
+template <typename ConfigT>
+class GEOMETRY_PUBLIC SpatialIndex
+{
+  // lint -e{9131} NOLINT There's no other way to make this work in a static assert
+  static_assert(
+    std::is_same<ConfigT, Config2d>::value || std::is_same<ConfigT, Config3d>::value,
+    "SpatialIndex only works with Config2d or Config3d");
+
+public:
+  /// \brief A stored point, has float members x, y and z so that point adapters work with it
+  struct Entry
+  {
+    Index bin;
+    float32_t x;
+    float32_t y;
+    float32_t z;
+    Index id;
+  };
+  /// \brief Result of a query
+  struct Neighbor
+  {
+    Index id;
+    float32_t distance2;  ///< squared distance (2d or 3d) to the query point
+  };
+  /// \brief Results of a batch of queries, those of query i are neighbors[offsets[i]:offsets[i+1]]
+  struct BatchOutput
+  {
+    std::vector<Index> offsets;
+    std::vector<Neighbor> neighbors;
+  };
+
+  /// \brief Constructor, reserves the capacity of the config
+  /// \param[in] cfg The configuration object for this class
+  explicit SpatialIndex(const ConfigT & cfg)
+  : m_config{cfg},
+    m_side_length{std::sqrt(cfg.radius2())},
+    m_max_index3{cfg.index3(
+      std::numeric_limits<float32_t>::max(), std::numeric_limits<float32_t>::max(),
+      std::numeric_limits<float32_t>::max())},
+    m_is_sorted{true}
+  {
+    m_entries.reserve(m_config.get_capacity());
+  }
+
+  /// \brief Remove all points, keeps the memory
+  void clear()
+  {
+    m_entries.clear();
+    m_is_sorted = true;
+  }
+  /// \brief Get current number of points stored in this data structure
+  Index size() const { return m_entries.size(); }
+  /// \brief Get the maximum capacity of the data structure
+  Index capacity() const { return m_config.get_capacity(); }
+  /// \brief Whether the index is empty
+  bool8_t empty() const { return m_entries.empty(); }
+
+  /// \brief Inserts a point
+  /// \param[in] x The x component of the point
+  /// \param[in] y The y component of the point
+  /// \param[in] z The z component of the point, ignored by 2d queries
+  /// \param[in] id The id returned by queries for this point
+  /// \throw std::length_error If the data structure is at capacity
+  void insert(const float32_t x, const float32_t y, const float32_t z, const Index id)
+  {
+    if (size() >= capacity()) {
+      throw std::length_error{"SpatialIndex: Cannot insert past capacity"};
+    }
+    m_entries.push_back(Entry{m_config.bin(x, y, z), x, y, z, id});
+    m_is_sorted = false;
+  }
+  /// \brief Inserts a point with point adapters defined, e.g. Point32 or TrajectoryPoint
+  template <typename PointT>
+  void insert(const PointT & pt, const Index id)
+  {
+    insert(
+      static_cast<float32_t>(point_adapter::x_(pt)), static_cast<float32_t>(point_adapter::y_(pt)),
+      static_cast<float32_t>(point_adapter::z_(pt)), id);
+  }
+  /// \brief Inserts the position of a pose
+  void insert(const geometry_msgs::msg::Pose & pose, const Index id)
+  {
+    insert(
+      static_cast<float32_t>(pose.position.x), static_cast<float32_t>(pose.position.y),
+      static_cast<float32_t>(pose.position.z), id);
+  }
+  /// \brief Inserts all the vertices of a polygon with the same id
+  /// \note A radius query may return the id of a polygon once per vertex within the radius
+  void insert(const geometry_msgs::msg::Polygon & polygon, const Index id)
+  {
+    for (const auto & pt : polygon.points) {
+      insert(pt, id);
+    }
+  }
+  /// \brief Inserts a range of points, poses, polygons, etc., the id is the position in the range
+  /// plus first_id
+  template <typename IteratorT>
+  void insert(IteratorT begin, IteratorT end, const Index first_id = 0U)
+  {
+    Index id = first_id;
+    for (IteratorT it = begin; it != end; ++it) {
+      insert(*it, id++);
+    }
+  }
+  /// \brief Inserts the points of a point cloud with float x, y and z fields, the id is the index
+  ///        of the point in the cloud
+  /// \throw std::length_error If the points exceed the capacity, no point is inserted then
+  void insert(const sensor_msgs::msg::PointCloud2 & cloud)
+  {
+    const Index num_points = static_cast<Index>(cloud.width) * cloud.height;
+    if ((size() + num_points) > capacity()) {
+      throw std::length_error{"SpatialIndex: Cannot insert point cloud past capacity"};
+    }
+    sensor_msgs::PointCloud2ConstIterator<float32_t> iter_x(cloud, "x");
+    sensor_msgs::PointCloud2ConstIterator<float32_t> iter_y(cloud, "y");
+    sensor_msgs::PointCloud2ConstIterator<float32_t> iter_z(cloud, "z");
+    for (Index i = 0U; i < num_points; ++i, ++iter_x, ++iter_y, ++iter_z) {
+      insert(*iter_x, *iter_y, *iter_z, i);
+    }
+  }
+
+  /// \brief Finds all points within a radius of a reference point, in no particular order
+  /// \param[in] x The x component of the reference point
+  /// \param[in] y The y component of the reference point
+  /// \param[in] z The z component of the reference point, ignored in 2d
+  /// \param[in] radius The radius within which to find all near points
+  /// \param[out] output Cleared and filled with the points within the radius
+  void near(
+    const float32_t x, const float32_t y, const float32_t z, const float32_t radius,
+    std::vector<Neighbor> & output)
+  {
+    output.clear();
+    sort();
+    collect(x, y, z, radius, output);
+  }
+  /// \brief Finds all points within a radius of a reference point with point adapters defined
+  template <typename PointT>
+  void near(const PointT & pt, const float32_t radius, std::vector<Neighbor> & output)
+  {
+    near(
+      static_cast<float32_t>(point_adapter::x_(pt)), static_cast<float32_t>(point_adapter::y_(pt)),
+      static_cast<float32_t>(point_adapter::z_(pt)), radius, output);
+  }
+
+  /// \brief Radius queries for a range of reference points with point adapters defined
+  /// \param[out] output Cleared and filled with the results of every query
+  template <typename IteratorT>
+  void near_batch(
+    IteratorT begin, IteratorT end, const float32_t radius, BatchOutput & output)
+  {
+    output.offsets.clear();
+    output.neighbors.clear();
+    sort();
+    for (IteratorT it = begin; it != end; ++it) {
+      output.offsets.push_back(output.neighbors.size());
+      collect(
+        static_cast<float32_t>(point_adapter::x_(*it)),
+        static_cast<float32_t>(point_adapter::y_(*it)),
+        static_cast<float32_t>(point_adapter::z_(*it)), radius, output.neighbors);
+    }
+    output.offsets.push_back(output.neighbors.size());
+  }
+
+  /// \brief Finds the k nearest points of a reference point, sorted by increasing distance
+  /// \param[in] x The x component of the reference point
+  /// \param[in] y The y component of the reference point
+  /// \param[in] z The z component of the reference point, ignored in 2d
+  /// \param[in] k The number of points to find, fewer are returned if there are not enough
+  /// \param[out] output Cleared and filled with the nearest points
+  /// \param[in] max_radius Points farther than this are not returned
+  ///
+  /// The search radius starts at the bin size and doubles until k points are found.
+  void nearest(
+    const float32_t x, const float32_t y, const float32_t z, const Index k,
+    std::vector<Neighbor> & output,
+    const float32_t max_radius = std::numeric_limits<float32_t>::max())
+  {
+    output.clear();
+    if (k == 0U) {
+      return;
+    }
+    sort();
+    float32_t radius = std::min(m_side_length, max_radius);
+    while (true) {
+      output.clear();
+      const bool8_t is_last = (radius >= max_radius) || covers_all_bins(radius);
+      collect(x, y, z, is_last ? max_radius : radius, output);
+      if (is_last || (output.size() >= k)) {
+        break;
+      }
+      radius = std::min(radius * 2.0F, max_radius);
+    }
+    const auto by_distance = [](const Neighbor & a, const Neighbor & b) {
+      return a.distance2 < b.distance2;
+    };
+    if (output.size() > k) {
+      std::nth_element(output.begin(), output.begin() + (k - 1U), output.end(), by_distance);
+      output.resize(k);
+    }
+    std::sort(output.begin(), output.end(), by_distance);
+  }
+  /// \brief Finds the k nearest points of a reference point with point adapters defined
+  template <typename PointT>
+  void nearest(
+    const PointT & pt, const Index k, std::vector<Neighbor> & output,
+    const float32_t max_radius = std::numeric_limits<float32_t>::max())
+  {
+    nearest(
+      static_cast<float32_t>(point_adapter::x_(pt)), static_cast<float32_t>(point_adapter::y_(pt)),
+      static_cast<float32_t>(point_adapter::z_(pt)), k, output, max_radius);
+  }
+
+  /// \brief Get the stored points, sorted by bin once a query has been made
+  const std::vector<Entry> & entries() const { return m_entries; }
+
+private:
+  /// \brief Sort the points by bin if some were inserted since the last query
+  void sort()
+  {
+    if (!m_is_sorted) {
+      std::sort(m_entries.begin(), m_entries.end(), [](const Entry & a, const Entry & b) {
+        return a.bin < b.bin;
+      });
+      m_is_sorted = true;
+    }
+  }
+
+  /// \brief Whether a query of this radius visits all the bins
+  bool8_t covers_all_bins(const float32_t radius) const
+  {
+    const float32_t max_index = static_cast<float32_t>(
+      std::max(m_max_index3.x, std::max(m_max_index3.y, m_max_index3.z)));
+    return (radius / m_side_length) > max_index;
+  }
+
+  /// \brief Appends the points within radius of the reference point to output
+  void collect(
+    const float32_t x, const float32_t y, const float32_t z, const float32_t radius,
+    std::vector<Neighbor> & output) const
+  {
+    if (m_entries.empty()) {
+      return;
+    }
+    const float32_t radius2 = radius * radius;
+    details::BinRange range{{0U, 0U, 0U}, m_max_index3};
+    if (!covers_all_bins(radius)) {
+      range = m_config.bin_range(m_config.index3(x, y, z), radius);
+    }
+    const auto bin_less = [](const Entry & entry, const Index bin) { return entry.bin < bin; };
+    const auto less_bin = [](const Index bin, const Entry & entry) { return bin < entry.bin; };
+    // the bins of a row along x are consecutive, so each row is a single range of entries
+    for (Index zdx = range.first.z; zdx <= range.second.z; ++zdx) {
+      for (Index ydx = range.first.y; ydx <= range.second.y; ++ydx) {
+        const Index first_bin = m_config.index({range.first.x, ydx, zdx});
+        const Index last_bin = m_config.index({range.second.x, ydx, zdx});
+        const auto first =
+          std::lower_bound(m_entries.begin(), m_entries.end(), first_bin, bin_less);
+        const auto last = std::upper_bound(first, m_entries.end(), last_bin, less_bin);
+        for (auto it = first; it != last; ++it) {
+          const float32_t dist2 = m_config.distance_squared(x, y, z, *it);
+          if (dist2 <= radius2) {
+            output.push_back(Neighbor{it->id, dist2});
+          }
+        }
+      }
+    }
+  }
+
+  const ConfigT m_config;
+  const float32_t m_side_length;
+  const details::Index3 m_max_index3;
+  std::vector<Entry> m_entries;
+  bool8_t m_is_sorted;
+};  // class SpatialIndex
+
+using SpatialIndex2d = SpatialIndex<Config2d>;
+using SpatialIndex3d = SpatialIndex<Config3d>;
+}  // namespace spatial_hash
+}  // namespace geometry
+}  // namespace common
+}  // namespace autoware
+
+#endif  // GEOMETRY__SPATIAL_INDEX_HPP_
@@ -0,0 +1,196 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <geometry/spatial_index.hpp>
+
+#include <geometry_msgs/msg/point32.hpp>
+#include <sensor_msgs/point_cloud2_iterator.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using autoware::common::geometry::spatial_hash::Config2d;
+using autoware::common::geometry::spatial_hash::Config3d;
+using autoware::common::geometry::spatial_hash::Index;
+using autoware::common::geometry::spatial_hash::SpatialIndex2d;
+using autoware::common::geometry::spatial_hash::SpatialIndex3d;
+using autoware::common::types::float32_t;
+using geometry_msgs::msg::Point32;
+
+namespace
+{
+std::vector<Point32> random_points(const size_t num_points, const float32_t range)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<float32_t> dist(-range, range);
+  std::vector<Point32> points(num_points);
+  for (auto & pt : points) {
+    pt.x = dist(engine);
+    pt.y = dist(engine);
+    pt.z = dist(engine);
+  }
+  return points;
+}
+
+template <typename NeighborT>
+std::vector<Index> sorted_ids(const std::vector<NeighborT> & neighbors)
+{
+  std::vector<Index> ids;
+  for (const auto & neighbor : neighbors) {
+    ids.push_back(neighbor.id);
+  }
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+float32_t distance2(const Point32 & a, const Point32 & b, const bool is_3d)
+{
+  const float32_t dx = a.x - b.x;
+  const float32_t dy = a.y - b.y;
+  const float32_t dz = is_3d ? a.z - b.z : 0.0F;
+  return dx * dx + dy * dy + dz * dz;
+}
+
+template <typename IndexT>
+void check_against_brute_force(IndexT & index, const bool is_3d)
+{
+  // some of the points and queries are out of the bounds of the config
+  const auto points = random_points(2000, 60.0F);
+  const auto queries = random_points(50, 70.0F);
+  index.insert(points.begin(), points.end());
+  ASSERT_EQ(index.size(), points.size());
+
+  std::vector<typename IndexT::Neighbor> neighbors;
+  for (const auto & query : queries) {
+    for (const float32_t radius : {0.5F, 3.0F, 17.0F}) {
+      std::vector<Index> expected;
+      for (Index i = 0U; i < points.size(); ++i) {
+        if (distance2(points.at(i), query, is_3d) <= radius * radius) {
+          expected.push_back(i);
+        }
+      }
+      index.near(query, radius, neighbors);
+      EXPECT_EQ(sorted_ids(neighbors), expected);
+    }
+
+    std::vector<Index> order(points.size());
+    for (Index i = 0U; i < order.size(); ++i) {
+      order.at(i) = i;
+    }
+    std::sort(order.begin(), order.end(), [&](const Index a, const Index b) {
+      return distance2(points.at(a), query, is_3d) < distance2(points.at(b), query, is_3d);
+    });
+    index.nearest(query, 5U, neighbors);
+    ASSERT_EQ(neighbors.size(), 5U);
+    for (Index i = 0U; i < neighbors.size(); ++i) {
+      EXPECT_FLOAT_EQ(
+        neighbors.at(i).distance2, distance2(points.at(order.at(i)), query, is_3d));
+    }
+  }
+
+  typename IndexT::BatchOutput batch;
+  index.near_batch(queries.begin(), queries.end(), 3.0F, batch);
+  ASSERT_EQ(batch.offsets.size(), queries.size() + 1U);
+  for (Index i = 0U; i < queries.size(); ++i) {
+    index.near(queries.at(i), 3.0F, neighbors);
+    EXPECT_EQ(batch.offsets.at(i + 1U) - batch.offsets.at(i), neighbors.size());
+  }
+}
+}  // namespace
+
+TEST(SpatialIndex, Near2d)
+{
+  SpatialIndex2d index(Config2d{-50.0F, 50.0F, -50.0F, 50.0F, 1.0F, 10000U});
+  check_against_brute_force(index, false);
+}
+
+TEST(SpatialIndex, Near3d)
+{
+  SpatialIndex3d index(Config3d{-50.0F, 50.0F, -50.0F, 50.0F, -50.0F, 50.0F, 2.0F, 10000U});
+  check_against_brute_force(index, true);
+}
+
+TEST(SpatialIndex, ClearAndReuse)
+{
+  SpatialIndex2d index(Config2d{-10.0F, 10.0F, -10.0F, 10.0F, 1.0F, 100U});
+  const auto * const data = index.entries().data();
+  std::vector<SpatialIndex2d::Neighbor> neighbors;
+  for (int cycle = 0; cycle < 3; ++cycle) {
+    index.clear();
+    for (Index i = 0U; i < 100U; ++i) {
+      index.insert(static_cast<float32_t>(i % 10U), static_cast<float32_t>(i / 10U), 0.0F, i);
+    }
+    index.near(0.0F, 0.0F, 0.0F, 1.0F, neighbors);
+    EXPECT_EQ(sorted_ids(neighbors), (std::vector<Index>{0U, 1U, 10U}));
+  }
+  EXPECT_EQ(index.entries().data(), data);
+  EXPECT_THROW(index.insert(0.0F, 0.0F, 0.0F, 100U), std::length_error);
+
+  // fewer points than requested
+  index.clear();
+  index.insert(3.0F, 4.0F, 0.0F, 7U);
+  index.nearest(0.0F, 0.0F, 0.0F, 3U, neighbors);
+  ASSERT_EQ(neighbors.size(), 1U);
+  EXPECT_EQ(neighbors.front().id, 7U);
+  EXPECT_FLOAT_EQ(neighbors.front().distance2, 25.0F);
+  index.nearest(0.0F, 0.0F, 0.0F, 3U, neighbors, 4.0F);
+  EXPECT_TRUE(neighbors.empty());
+}
+
+TEST(SpatialIndex, Adapters)
+{
+  SpatialIndex2d index(Config2d{-10.0F, 10.0F, -10.0F, 10.0F, 1.0F, 100U});
+
+  geometry_msgs::msg::Pose pose;
+  pose.position.x = 1.0;
+  pose.position.y = 1.0;
+  index.insert(pose, 3U);
+
+  geometry_msgs::msg::Polygon polygon;
+  for (const auto & [x, y] : {std::make_pair(5.0F, 5.0F), std::make_pair(6.0F, 5.0F)}) {
+    Point32 pt;
+    pt.x = x;
+    pt.y = y;
+    polygon.points.push_back(pt);
+  }
+  index.insert(polygon, 4U);
+
+  std::vector<SpatialIndex2d::Neighbor> neighbors;
+  index.near(1.0F, 1.0F, 0.0F, 0.5F, neighbors);
+  EXPECT_EQ(sorted_ids(neighbors), (std::vector<Index>{3U}));
+  index.near(5.5F, 5.0F, 0.0F, 1.0F, neighbors);
+  EXPECT_EQ(sorted_ids(neighbors), (std::vector<Index>{4U, 4U}));
+
+  sensor_msgs::msg::PointCloud2 cloud;
+  sensor_msgs::PointCloud2Modifier modifier(cloud);
+  modifier.setPointCloud2FieldsByString(1, "xyz");
+  modifier.resize(3);
+  sensor_msgs::PointCloud2Iterator<float32_t> iter_x(cloud, "x");
+  sensor_msgs::PointCloud2Iterator<float32_t> iter_y(cloud, "y");
+  sensor_msgs::PointCloud2Iterator<float32_t> iter_z(cloud, "z");
+  for (int i = 0; i < 3; ++i, ++iter_x, ++iter_y, ++iter_z) {
+    *iter_x = -5.0F - static_cast<float32_t>(i);
+    *iter_y = -5.0F;
+    *iter_z = 0.0F;
+  }
+  index.clear();
+  index.insert(cloud);
+  index.nearest(-7.2F, -5.0F, 0.0F, 2U, neighbors);
+  ASSERT_EQ(neighbors.size(), 2U);
+  EXPECT_EQ(neighbors.at(0).id, 2U);
+  EXPECT_EQ(neighbors.at(1).id, 1U);
+}
@@ -126,7 +126,8 @@ AUTOWARE_AUTO_PERCEPTION_RVIZ_PLUGIN_PUBLIC visualization_msgs::msg::Marker::Sha
 get_predicted_path_marker_ptr(
   const autoware_auto_perception_msgs::msg::Shape & shape,
   const autoware_auto_perception_msgs::msg::PredictedPath & predicted_path,
-  const std_msgs::msg::ColorRGBA & predicted_path_color, const bool is_simple = false);
+  const std_msgs::msg::ColorRGBA & predicted_path_color, const bool is_simple = false,
+  const size_t path_step = 1);
 
 AUTOWARE_AUTO_PERCEPTION_RVIZ_PLUGIN_PUBLIC visualization_msgs::msg::Marker::SharedPtr
 get_path_confidence_marker_ptr(
@@ -161,9 +162,12 @@ AUTOWARE_AUTO_PERCEPTION_RVIZ_PLUGIN_PUBLIC void calc_2d_polygon_bottom_line_lis
   const autoware_auto_perception_msgs::msg::Shape & shape,
   std::vector<geometry_msgs::msg::Point> & points);
 
+/// \brief Calculate the line list of a predicted path
+/// \param path_step Every path_step-th point of the path is used, which decimates far paths
 AUTOWARE_AUTO_PERCEPTION_RVIZ_PLUGIN_PUBLIC void calc_path_line_list(
   const autoware_auto_perception_msgs::msg::PredictedPath & paths,
-  std::vector<geometry_msgs::msg::Point> & points, const bool is_simple = false);
+  std::vector<geometry_msgs::msg::Point> & points, const bool is_simple = false,
+  const size_t path_step = 1);
 
 /// \brief Convert Point32 to Point
 /// \param val Point32 to be converted
@@ -262,14 +262,15 @@ protected:
   std::optional<Marker::SharedPtr> get_predicted_path_marker_ptr(
     const unique_identifier_msgs::msg::UUID & uuid,
     const autoware_auto_perception_msgs::msg::Shape & shape,
-    const autoware_auto_perception_msgs::msg::PredictedPath & predicted_path) const
+    const autoware_auto_perception_msgs::msg::PredictedPath & predicted_path,
+    const size_t path_step = 1) const
   {
     if (m_display_predicted_paths_property.getBool()) {
       const std::string uuid_str = uuid_to_string(uuid);
       const std_msgs::msg::ColorRGBA predicted_path_color = get_color_from_uuid(uuid_str);
       return detail::get_predicted_path_marker_ptr(
         shape, predicted_path, predicted_path_color,
-        m_simple_visualize_mode_property->getOptionInt() == 1);
+        m_simple_visualize_mode_property->getOptionInt() == 1, path_step);
     } else {
       return std::nullopt;
     }
@@ -22,10 +22,14 @@
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 
+#include <algorithm>
 #include <condition_variable>
 #include <list>
+#include <optional>
+#include <set>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace autoware
@@ -50,9 +54,8 @@ private:
 
   boost::uuids::uuid to_boost_uuid(const unique_identifier_msgs::msg::UUID & uuid_msg)
   {
-    const std::string uuid_str = uuid_to_string(uuid_msg);
-    boost::uuids::string_generator gen;
-    boost::uuids::uuid uuid = gen(uuid_str);
+    boost::uuids::uuid uuid;
+    std::copy(uuid_msg.uuid.begin(), uuid_msg.uuid.end(), uuid.begin());
     return uuid;
   }
 
@@ -101,6 +104,16 @@ private:
 
   void update(float wall_dt, float ros_dt) override;
 
+  /// \brief Update the camera position in the frame of the latest message for the path LOD
+  void updateCameraPosition();
+
+  /// \brief Step of the predicted path points, which grows with the distance from the camera
+  size_t getPathStep(
+    const geometry_msgs::msg::Point & position,
+    const std::optional<geometry_msgs::msg::Point> & camera_position_in_frame) const;
+
+  using MarkerKey = std::pair<std::string, int32_t>;  // namespace and id of a marker
+
   std::unordered_map<boost::uuids::uuid, int32_t, boost::hash<boost::uuids::uuid>> id_map;
   // std::unordered_map<boost::uuids::uuid, int32_t> id_map;
   std::list<int32_t> unused_marker_ids;
@@ -112,6 +125,13 @@ private:
   std::mutex mutex;
   std::condition_variable condition;
   std::vector<visualization_msgs::msg::Marker::SharedPtr> markers;
+  // markers shown now, which are deleted when they are not in the next markers
+  std::set<MarkerKey> marker_keys;
+
+  // Property to decide the distance from the camera where predicted paths start to be decimated
+  rviz_common::properties::FloatProperty m_path_lod_distance_property;
+  std::string frame_id;
+  std::optional<geometry_msgs::msg::Point> camera_position;
 };
 
 }  // namespace object_detection
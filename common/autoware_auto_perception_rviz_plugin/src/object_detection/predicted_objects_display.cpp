@@ -13,8 +13,18 @@
 // limitations under the License.
 
 #include <object_detection/predicted_objects_display.hpp>
+#include <rviz_common/display_context.hpp>
+#include <rviz_common/frame_manager_iface.hpp>
+#include <rviz_common/view_controller.hpp>
+#include <rviz_common/view_manager.hpp>
 
+#include <OgreCamera.h>
+#include <OgreSceneNode.h>
+
+#include <cmath>
 #include <memory>
+#include <set>
+#include <string>
 
 namespace autoware
 {
@@ -22,7 +32,13 @@ namespace rviz_plugins
 {
 namespace object_detection
 {
-PredictedObjectsDisplay::PredictedObjectsDisplay() : ObjectPolygonDisplayBase("tracks")
+PredictedObjectsDisplay::PredictedObjectsDisplay()
+: ObjectPolygonDisplayBase("tracks"),
+  m_path_lod_distance_property{
+    "Predicted Path LOD Distance", 50.0,
+    "Predicted paths are decimated by 2 for every this distance from the camera [m]. "
+    "0 disables the decimation.",
+    this}
 {
   std::thread worker(&PredictedObjectsDisplay::workerThread, this);
   worker.detach();
@@ -36,6 +52,7 @@ void PredictedObjectsDisplay::workerThread()
 
     auto tmp_msg = this->msg;
     this->msg.reset();
+    frame_id = tmp_msg->header.frame_id;
 
     lock.unlock();
 
@@ -52,9 +69,17 @@ std::vector<visualization_msgs::msg::Marker::SharedPtr> PredictedObjectsDisplay:
 {
   update_id_map(msg);
 
+  std::optional<geometry_msgs::msg::Point> tmp_camera_position;
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    tmp_camera_position = camera_position;
+  }
+
   std::vector<visualization_msgs::msg::Marker::SharedPtr> markers;
 
   for (const auto & object : msg->objects) {
+    const int32_t object_marker_id = uuid_to_marker_id(object.object_id);
+
     // Get marker for shape
     auto shape_marker = get_shape_marker_ptr(
       object.shape, object.kinematics.initial_pose_with_covariance.pose.position,
@@ -63,7 +88,7 @@ std::vector<visualization_msgs::msg::Marker::SharedPtr> PredictedObjectsDisplay:
     if (shape_marker) {
       auto shape_marker_ptr = shape_marker.value();
       shape_marker_ptr->header = msg->header;
-      shape_marker_ptr->id = uuid_to_marker_id(object.object_id);
+      shape_marker_ptr->id = object_marker_id;
       markers.push_back(shape_marker_ptr);
     }
 
@@ -74,7 +99,7 @@ std::vector<visualization_msgs::msg::Marker::SharedPtr> PredictedObjectsDisplay:
     if (label_marker) {
       auto label_marker_ptr = label_marker.value();
       label_marker_ptr->header = msg->header;
-      label_marker_ptr->id = uuid_to_marker_id(object.object_id);
+      label_marker_ptr->id = object_marker_id;
       markers.push_back(label_marker_ptr);
     }
 
@@ -89,7 +114,7 @@ std::vector<visualization_msgs::msg::Marker::SharedPtr> PredictedObjectsDisplay:
     if (id_marker) {
       auto id_marker_ptr = id_marker.value();
       id_marker_ptr->header = msg->header;
-      id_marker_ptr->id = uuid_to_marker_id(object.object_id);
+      id_marker_ptr->id = object_marker_id;
       markers.push_back(id_marker_ptr);
     }
 
@@ -99,7 +124,7 @@ std::vector<visualization_msgs::msg::Marker::SharedPtr> PredictedObjectsDisplay:
     if (pose_with_covariance_marker) {
       auto pose_with_covariance_marker_ptr = pose_with_covariance_marker.value();
       pose_with_covariance_marker_ptr->header = msg->header;
-      pose_with_covariance_marker_ptr->id = uuid_to_marker_id(object.object_id);
+      pose_with_covariance_marker_ptr->id = object_marker_id;
       markers.push_back(pose_with_covariance_marker_ptr);
     }
 
@@ -114,7 +139,7 @@ std::vector<visualization_msgs::msg::Marker::SharedPtr> PredictedObjectsDisplay:
     if (velocity_text_marker) {
       auto velocity_text_marker_ptr = velocity_text_marker.value();
       velocity_text_marker_ptr->header = msg->header;
-      velocity_text_marker_ptr->id = uuid_to_marker_id(object.object_id);
+      velocity_text_marker_ptr->id = object_marker_id;
       markers.push_back(velocity_text_marker_ptr);
     }
 
@@ -129,8 +154,8 @@ std::vector<visualization_msgs::msg::Marker::SharedPtr> PredictedObjectsDisplay:
     if (acceleration_text_marker) {
       auto acceleration_text_marker_ptr = acceleration_text_marker.value();
       acceleration_text_marker_ptr->header = msg->header;
-      acceleration_text_marker_ptr->id = uuid_to_marker_id(object.object_id);
-      add_marker(acceleration_text_marker_ptr);
+      acceleration_text_marker_ptr->id = object_marker_id;
+      markers.push_back(acceleration_text_marker_ptr);
     }
 
     // Get marker for twist
@@ -140,21 +165,23 @@ std::vector<visualization_msgs::msg::Marker::SharedPtr> PredictedObjectsDisplay:
     if (twist_marker) {
       auto twist_marker_ptr = twist_marker.value();
       twist_marker_ptr->header = msg->header;
-      twist_marker_ptr->id = uuid_to_marker_id(object.object_id);
+      twist_marker_ptr->id = object_marker_id;
       markers.push_back(twist_marker_ptr);
     }
 
     // Add marker for each candidate path
+    const size_t path_step = getPathStep(
+      object.kinematics.initial_pose_with_covariance.pose.position, tmp_camera_position);
     int32_t path_count = 0;
     for (const auto & predicted_path : object.kinematics.predicted_paths) {
       // Get marker for predicted path
       auto predicted_path_marker =
-        get_predicted_path_marker_ptr(object.object_id, object.shape, predicted_path);
+        get_predicted_path_marker_ptr(object.object_id, object.shape, predicted_path, path_step);
       if (predicted_path_marker) {
         auto predicted_path_marker_ptr = predicted_path_marker.value();
         predicted_path_marker_ptr->header = msg->header;
         predicted_path_marker_ptr->id =
-          uuid_to_marker_id(object.object_id) + path_count * PATH_ID_CONSTANT;
+          object_marker_id + path_count * PATH_ID_CONSTANT;
         path_count++;
         markers.push_back(predicted_path_marker_ptr);
       }
@@ -172,7 +199,7 @@ std::vector<visualization_msgs::msg::Marker::SharedPtr> PredictedObjectsDisplay:
         auto path_confidence_marker_ptr = path_confidence_marker.value();
         path_confidence_marker_ptr->header = msg->header;
         path_confidence_marker_ptr->id =
-          uuid_to_marker_id(object.object_id) + path_count * PATH_ID_CONSTANT;
+          object_marker_id + path_count * PATH_ID_CONSTANT;
         path_count++;
         markers.push_back(path_confidence_marker_ptr);
       }
@@ -192,16 +219,31 @@ void PredictedObjectsDisplay::processMessage(PredictedObjects::ConstSharedPtr ms
 
 void PredictedObjectsDisplay::update(float wall_dt, float ros_dt)
 {
-  std::unique_lock<std::mutex> lock(mutex);
+  updateCameraPosition();
 
-  if (!markers.empty()) {
-    clear_markers();
+  std::unique_lock<std::mutex> lock(mutex);
 
+  if (consumed) {
+    // update the markers in place, and delete only the markers of the objects or paths which
+    // disappeared instead of clearing and recreating all of them
+    std::set<MarkerKey> new_marker_keys;
     for (const auto & marker : markers) {
       add_marker(marker);
+      new_marker_keys.emplace(marker->ns, marker->id);
+    }
+    for (const auto & marker_key : marker_keys) {
+      if (new_marker_keys.count(marker_key) == 0) {
+        auto delete_marker = std::make_shared<visualization_msgs::msg::Marker>();
+        delete_marker->ns = marker_key.first;
+        delete_marker->id = marker_key.second;
+        delete_marker->action = visualization_msgs::msg::Marker::DELETE;
+        add_marker(delete_marker);
+      }
     }
+    marker_keys = std::move(new_marker_keys);
 
     markers.clear();
+    consumed = false;
   }
 
   lock.unlock();
@@ -210,6 +252,55 @@ void PredictedObjectsDisplay::update(float wall_dt, float ros_dt)
     wall_dt, ros_dt);
 }
 
+void PredictedObjectsDisplay::updateCameraPosition()
+{
+  std::string tmp_frame_id;
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    tmp_frame_id = frame_id;
+  }
+
+  std::optional<geometry_msgs::msg::Point> tmp_camera_position;
+  const auto view_controller = context_->getViewManager()->getCurrent();
+  Ogre::Vector3 frame_position;
+  Ogre::Quaternion frame_orientation;
+  if (
+    view_controller && !tmp_frame_id.empty() &&
+    context_->getFrameManager()->getTransform(tmp_frame_id, frame_position, frame_orientation)) {
+    const auto camera_position_in_fixed_frame =
+      view_controller->getCamera()->getParentSceneNode()->_getDerivedPosition();
+    const auto camera_position_in_frame =
+      frame_orientation.Inverse() * (camera_position_in_fixed_frame - frame_position);
+    tmp_camera_position = geometry_msgs::msg::Point()
+                            .set__x(camera_position_in_frame.x)
+                            .set__y(camera_position_in_frame.y)
+                            .set__z(camera_position_in_frame.z);
+  }
+
+  std::unique_lock<std::mutex> lock(mutex);
+  camera_position = tmp_camera_position;
+}
+
+size_t PredictedObjectsDisplay::getPathStep(
+  const geometry_msgs::msg::Point & position,
+  const std::optional<geometry_msgs::msg::Point> & camera_position_in_frame) const
+{
+  const double lod_distance = m_path_lod_distance_property.getFloat();
+  if (!camera_position_in_frame || lod_distance <= 0.0) {
+    return 1;
+  }
+
+  constexpr size_t max_path_step = 8;
+  const double distance = std::hypot(
+    position.x - camera_position_in_frame->x, position.y - camera_position_in_frame->y,
+    position.z - camera_position_in_frame->z);
+  size_t path_step = 1;
+  for (double d = lod_distance; d <= distance && path_step < max_path_step; d += lod_distance) {
+    path_step *= 2;
+  }
+  return path_step;
+}
+
 }  // namespace object_detection
 }  // namespace rviz_plugins
 }  // namespace autoware
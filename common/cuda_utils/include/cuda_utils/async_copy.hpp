@@ -0,0 +1,81 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CUDA_UTILS__ASYNC_COPY_HPP_
+#define CUDA_UTILS__ASYNC_COPY_HPP_
+
+#include "cuda_utils/cuda_check_error.hpp"
+#include "cuda_utils/pinned_host_memory.hpp"
+
+#include <cuda_runtime_api.h>
+
+#include <cstddef>
+#include <cstring>
+
+namespace cuda_utils
+{
+// Async copies of n elements. They only overlap with other work when the host side is pinned,
+// use the staged variants for pageable memory such as std::vector or PointCloud2::data.
+template <typename T>
+void copyToDeviceAsync(T * dst_d, const T * src_h, const std::size_t n, cudaStream_t stream)
+{
+  CHECK_CUDA_ERROR(
+    ::cudaMemcpyAsync(dst_d, src_h, sizeof(T) * n, ::cudaMemcpyHostToDevice, stream));
+}
+
+template <typename T>
+void copyToHostAsync(T * dst_h, const T * src_d, const std::size_t n, cudaStream_t stream)
+{
+  CHECK_CUDA_ERROR(
+    ::cudaMemcpyAsync(dst_h, src_d, sizeof(T) * n, ::cudaMemcpyDeviceToHost, stream));
+}
+
+/**
+ * @brief Copies pageable host memory to the device through a pinned staging buffer of pool.
+ *
+ * Only the memcpy into the staging buffer is done on the calling thread, src_h can be reused as
+ * soon as this returns. The staging buffer goes back to the pool when the copy has finished.
+ */
+template <typename T>
+void stageToDeviceAsync(
+  PinnedBufferPool & pool, T * dst_d, const T * src_h, const std::size_t n, cudaStream_t stream)
+{
+  if (n == 0) {
+    return;
+  }
+  auto staging = pool.acquire(sizeof(T) * n);
+  std::memcpy(staging.data(), src_h, sizeof(T) * n);
+  copyToDeviceAsync(dst_d, staging.as<T>(), n, stream);
+  staging.releaseAfter(stream);
+}
+
+/**
+ * @brief Enqueues a device to host copy into a pinned staging buffer of pool.
+ *
+ * The returned buffer holds the data once the stream has been synchronized, read it from there
+ * (or copy it out) and let it go out of scope to return it to the pool.
+ */
+template <typename T>
+PinnedBufferPool::Buffer stageToHostAsync(
+  PinnedBufferPool & pool, const T * src_d, const std::size_t n, cudaStream_t stream)
+{
+  auto staging = pool.acquire(sizeof(T) * n);
+  if (n > 0) {
+    copyToHostAsync(staging.as<T>(), src_d, n, stream);
+  }
+  return staging;
+}
+}  // namespace cuda_utils
+
+#endif  // CUDA_UTILS__ASYNC_COPY_HPP_
@@ -0,0 +1,251 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CUDA_UTILS__PINNED_HOST_MEMORY_HPP_
+#define CUDA_UTILS__PINNED_HOST_MEMORY_HPP_
+
+#include "cuda_utils/cuda_check_error.hpp"
+#include "cuda_utils/cuda_unique_ptr.hpp"
+
+#include <cuda_runtime_api.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace cuda_utils
+{
+// std allocator for page-locked host memory, so that cudaMemcpyAsync from/to the container
+// really is asynchronous instead of being staged by the driver.
+template <typename T>
+struct PinnedHostAllocator
+{
+  using value_type = T;
+
+  PinnedHostAllocator() = default;
+  template <typename U>
+  PinnedHostAllocator(const PinnedHostAllocator<U> &) noexcept  // NOLINT
+  {
+  }
+
+  T * allocate(const std::size_t n)
+  {
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    void * p = nullptr;
+    if (::cudaHostAlloc(&p, sizeof(T) * n, cudaHostAllocDefault) != ::cudaSuccess) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T *>(p);
+  }
+
+  void deallocate(T * p, std::size_t) noexcept { ::cudaFreeHost(p); }
+};
+
+template <typename T, typename U>
+bool operator==(const PinnedHostAllocator<T> &, const PinnedHostAllocator<U> &)
+{
+  return true;
+}
+template <typename T, typename U>
+bool operator!=(const PinnedHostAllocator<T> &, const PinnedHostAllocator<U> &)
+{
+  return false;
+}
+
+template <typename T>
+using PinnedVector = std::vector<T, PinnedHostAllocator<T>>;
+
+/**
+ * @brief Arena of reusable page-locked staging buffers.
+ *
+ * cudaHostAlloc is expensive (it maps the pages for the device), so the buffers are kept and
+ * handed out again. A buffer released with releaseAfter(stream) only becomes available once the
+ * work enqueued on the stream at that point has finished, which lets a caller fill a buffer,
+ * enqueue an async copy from it and move on without synchronizing.
+ * The pool must outlive the buffers acquired from it.
+ */
+class PinnedBufferPool
+{
+  struct Block
+  {
+    CudaUniquePtrHost<std::uint8_t[]> memory;
+    std::size_t size{0};
+    cudaEvent_t ready_event{nullptr};  // recorded by releaseAfter, nullptr until first used
+    bool in_use{false};
+  };
+
+public:
+  class Buffer
+  {
+  public:
+    Buffer() = default;
+    Buffer(const Buffer &) = delete;
+    Buffer & operator=(const Buffer &) = delete;
+    Buffer(Buffer && other) noexcept { *this = std::move(other); }
+    Buffer & operator=(Buffer && other) noexcept
+    {
+      if (this != &other) {
+        release();
+        pool_ = std::exchange(other.pool_, nullptr);
+        block_ = std::exchange(other.block_, nullptr);
+      }
+      return *this;
+    }
+    ~Buffer() { release(); }
+
+    void * data() const { return block_ ? block_->memory.get() : nullptr; }
+    template <typename T>
+    T * as() const
+    {
+      return static_cast<T *>(data());
+    }
+    std::size_t size() const { return block_ ? block_->size : 0; }
+    explicit operator bool() const { return block_ != nullptr; }
+
+    // returns the buffer to the pool right away, the caller must not have pending copies on it
+    void release() noexcept
+    {
+      if (pool_) {
+        pool_->giveBack(block_);
+      }
+      pool_ = nullptr;
+      block_ = nullptr;
+    }
+
+    // returns the buffer to the pool once the work currently enqueued on stream has finished
+    void releaseAfter(cudaStream_t stream)
+    {
+      if (pool_) {
+        pool_->giveBackAfter(block_, stream);
+      }
+      pool_ = nullptr;
+      block_ = nullptr;
+    }
+
+  private:
+    friend class PinnedBufferPool;
+    Buffer(PinnedBufferPool * pool, Block * block) : pool_(pool), block_(block) {}
+
+    PinnedBufferPool * pool_{nullptr};
+    Block * block_{nullptr};
+  };
+
+  PinnedBufferPool() = default;
+  PinnedBufferPool(const PinnedBufferPool &) = delete;
+  PinnedBufferPool & operator=(const PinnedBufferPool &) = delete;
+  ~PinnedBufferPool()
+  {
+    for (const auto & block : blocks_) {
+      if (block->ready_event) {
+        ::cudaEventSynchronize(block->ready_event);
+        ::cudaEventDestroy(block->ready_event);
+      }
+    }
+  }
+
+  // smallest free buffer of at least size bytes, a new one rounded up to a power of two otherwise
+  Buffer acquire(const std::size_t size)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Block * best = nullptr;
+    for (const auto & block : blocks_) {
+      if (block->in_use || block->size < size || (best && best->size <= block->size)) {
+        continue;
+      }
+      if (block->ready_event && ::cudaEventQuery(block->ready_event) == ::cudaErrorNotReady) {
+        continue;
+      }
+      best = block.get();
+    }
+    if (!best) {
+      auto block = std::make_unique<Block>();
+      block->size = roundUpSize(size);
+      block->memory = make_unique_host<std::uint8_t[]>(block->size, cudaHostAllocDefault);
+      best = block.get();
+      blocks_.push_back(std::move(block));
+    }
+    best->in_use = true;
+    return Buffer(this, best);
+  }
+
+  // synchronizes the pending copies and frees all the buffers that are not in use
+  void shrink()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::unique_ptr<Block>> kept;
+    for (auto & block : blocks_) {
+      if (block->in_use) {
+        kept.push_back(std::move(block));
+        continue;
+      }
+      if (block->ready_event) {
+        CHECK_CUDA_ERROR(::cudaEventSynchronize(block->ready_event));
+        CHECK_CUDA_ERROR(::cudaEventDestroy(block->ready_event));
+      }
+    }
+    blocks_ = std::move(kept);
+  }
+
+  std::size_t capacity() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t total = 0;
+    for (const auto & block : blocks_) {
+      total += block->size;
+    }
+    return total;
+  }
+
+private:
+  static constexpr std::size_t min_block_size = 4096;
+
+  static std::size_t roundUpSize(const std::size_t size)
+  {
+    std::size_t rounded = min_block_size;
+    while (rounded < size) {
+      rounded <<= 1;
+    }
+    return rounded;
+  }
+
+  // a block is only handed out once its previous event has completed, so this needs no sync
+  void giveBack(Block * block) noexcept
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    block->in_use = false;
+  }
+
+  void giveBackAfter(Block * block, cudaStream_t stream)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    block->in_use = false;
+    if (!block->ready_event) {
+      CHECK_CUDA_ERROR(::cudaEventCreateWithFlags(&block->ready_event, cudaEventDisableTiming));
+    }
+    CHECK_CUDA_ERROR(::cudaEventRecord(block->ready_event, stream));
+  }
+
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<Block>> blocks_;
+};
+}  // namespace cuda_utils
+
+#endif  // CUDA_UTILS__PINNED_HOST_MEMORY_HPP_
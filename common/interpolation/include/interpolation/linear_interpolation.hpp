@@ -21,16 +21,75 @@
 
 namespace interpolation
 {
+// NOTE: index of the base segment and ratio in it for a query key, which can be shared by the
+//       interpolation of several values on the same keys
+struct LerpSegment
+{
+  size_t index;
+  double ratio;
+};
+
 double lerp(const double src_val, const double dst_val, const double ratio);
 
+std::vector<LerpSegment> calcLerpSegments(
+  const std::vector<double> & base_keys, const std::vector<double> & query_keys);
+
+// NOTE: the single query key is located by binary search without allocation
+LerpSegment calcLerpSegment(const std::vector<double> & base_keys, const double query_key);
+
+std::vector<double> lerp(
+  const std::vector<double> & base_values, const std::vector<LerpSegment> & segments);
+
 std::vector<double> lerp(
   const std::vector<double> & base_keys, const std::vector<double> & base_values,
   const std::vector<double> & query_keys);
 
+double lerp(const std::vector<double> & base_values, const LerpSegment & segment);
+
 double lerp(
   const std::vector<double> & base_keys, const std::vector<double> & base_values,
   const double query_key);
 
+// linear interpolation on fixed base keys, which are validated only once on construction
+//
+// Usage:
+// ```
+// const LinearInterpolator interpolator(base_keys);
+// // O(log n) query
+// const double value = interpolator.lerp(base_values, query_key);
+// // O(1) query when the query keys change little between calls
+// size_t hint = 0;
+// for (const double query_key : query_keys) {
+//   const double value = interpolator.lerp(base_values, query_key, hint);
+// }
+// // the segment can be shared by other values on the same keys, e.g. quaternions
+// const auto quat = slerp(base_quats, interpolator.getSegment(query_key, hint));
+// ```
+class LinearInterpolator
+{
+public:
+  explicit LinearInterpolator(const std::vector<double> & base_keys);
+
+  //!< @brief get the segment of a query key by binary search.
+  //!< @details query_key is clamped into the range of base keys, and an exception is thrown
+  //            when it is out of the range by more than the tolerance of validateKeys().
+  LerpSegment getSegment(const double query_key) const;
+
+  //!< @brief get the segment of a query key by searching from the segment of the hint index.
+  //!< @details hint is updated to the found segment index for the next query.
+  LerpSegment getSegment(const double query_key, size_t & hint) const;
+
+  double lerp(const std::vector<double> & base_values, const double query_key) const;
+  double lerp(
+    const std::vector<double> & base_values, const double query_key, size_t & hint) const;
+
+  const std::vector<double> & getBaseKeys() const { return base_keys_; }
+
+private:
+  std::vector<double> base_keys_;
+
+  void validateValues(const size_t values_size) const;
+};
 }  // namespace interpolation
 
 #endif  // INTERPOLATION__LINEAR_INTERPOLATION_HPP_
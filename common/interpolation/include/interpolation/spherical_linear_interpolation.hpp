@@ -16,6 +16,7 @@
 #define INTERPOLATION__SPHERICAL_LINEAR_INTERPOLATION_HPP_
 
 #include "interpolation/interpolation_utils.hpp"
+#include "interpolation/linear_interpolation.hpp"
 
 #include <geometry_msgs/msg/quaternion.hpp>
 
@@ -39,6 +40,14 @@ std::vector<geometry_msgs::msg::Quaternion> slerp(
   const std::vector<double> & base_keys,
   const std::vector<geometry_msgs::msg::Quaternion> & base_values,
   const std::vector<double> & query_keys);
+
+geometry_msgs::msg::Quaternion slerp(
+  const std::vector<geometry_msgs::msg::Quaternion> & base_values, const LerpSegment & segment);
+
+// NOTE: the single query key is located by binary search without allocation
+geometry_msgs::msg::Quaternion slerp(
+  const std::vector<double> & base_keys,
+  const std::vector<geometry_msgs::msg::Quaternion> & base_values, const double query_key);
 }  // namespace interpolation
 
 #endif  // INTERPOLATION__SPHERICAL_LINEAR_INTERPOLATION_HPP_
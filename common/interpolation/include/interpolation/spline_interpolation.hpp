@@ -45,6 +45,31 @@ struct MultiSplineCoef
   std::vector<double> d;
 };
 
+// NOTE: buffers used while calculating the spline coefficients, which can be shared by several
+//       splines so that they are not allocated for every construction
+struct SplineWorkspace
+{
+  std::vector<double> diff_keys;
+  std::vector<double> diff_values;
+  std::vector<double> v;
+
+  // tridiagonal matrix and its forward sweep
+  std::vector<double> tdma_a;
+  std::vector<double> tdma_b;
+  std::vector<double> tdma_c;
+  std::vector<double> tdma_d;
+  std::vector<double> tdma_p;
+  std::vector<double> tdma_q;
+};
+
+// values, 1st and 2nd differential values of spline interpolation on the same query keys
+struct SplineInterpolatedValues
+{
+  std::vector<double> values;
+  std::vector<double> diff_values;
+  std::vector<double> quad_diff_values;
+};
+
 // static spline interpolation functions
 std::vector<double> spline(
   const std::vector<double> & base_keys, const std::vector<double> & base_values,
@@ -73,7 +98,14 @@ public:
   SplineInterpolation(
     const std::vector<double> & base_keys, const std::vector<double> & base_values)
   {
-    calcSplineCoefficients(base_keys, base_values);
+    interpolation::SplineWorkspace workspace;
+    calcSplineCoefficients(base_keys, base_values, workspace);
+  }
+  SplineInterpolation(
+    const std::vector<double> & base_keys, const std::vector<double> & base_values,
+    interpolation::SplineWorkspace & workspace)
+  {
+    calcSplineCoefficients(base_keys, base_values, workspace);
   }
 
   //!< @brief get values of spline interpolation on designated sampling points.
@@ -95,6 +127,18 @@ public:
   std::vector<double> getSplineInterpolatedQuadDiffValues(
     const std::vector<double> & query_keys) const;
 
+  //!< @brief get values, 1st and 2nd differential values of spline interpolation together.
+  //!< @details Each query key is located only once for the three kinds of values.
+  interpolation::SplineInterpolatedValues getSplineInterpolatedValuesWithDiffs(
+    const std::vector<double> & query_keys) const;
+
+  //!< @brief get a value of spline interpolation on a single sampling point.
+  //!< @details The segment of query_key is found by binary search, and query_key is clamped
+  //            into the range of base keys.
+  double getSplineInterpolatedValue(const double query_key) const;
+  double getSplineInterpolatedDiffValue(const double query_key) const;
+  double getSplineInterpolatedQuadDiffValue(const double query_key) const;
+
   size_t getSize() const { return base_keys_.size(); }
 
 private:
@@ -102,7 +146,9 @@ private:
   interpolation::MultiSplineCoef multi_spline_coef_;
 
   void calcSplineCoefficients(
-    const std::vector<double> & base_keys, const std::vector<double> & base_values);
+    const std::vector<double> & base_keys, const std::vector<double> & base_values,
+    interpolation::SplineWorkspace & workspace);
+  size_t getSegmentIndex(const double query_key) const;
 };
 
 #endif  // INTERPOLATION__SPLINE_INTERPOLATION_HPP_
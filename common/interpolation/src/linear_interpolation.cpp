@@ -14,8 +14,41 @@
 
 #include "interpolation/linear_interpolation.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
+namespace
+{
+double validateQueryKey(const std::vector<double> & base_keys, const double query_key)
+{
+  // when query_key is out of base_keys (same tolerance as interpolation_utils::validateKeys)
+  constexpr double epsilon = 1e-3;
+  if (query_key < base_keys.front() - epsilon || base_keys.back() + epsilon < query_key) {
+    throw std::invalid_argument("query_keys is out of base_keys");
+  }
+
+  return std::clamp(query_key, base_keys.front(), base_keys.back());
+}
+
+// NOTE: the first segment whose end key is not less than query_key, same as calcLerpSegments
+size_t findSegmentIndex(const std::vector<double> & base_keys, const double query_key)
+{
+  const auto itr = std::lower_bound(base_keys.begin() + 1, base_keys.end() - 1, query_key);
+  return std::distance(base_keys.begin() + 1, itr);
+}
+
+interpolation::LerpSegment calcSegment(
+  const std::vector<double> & base_keys, const size_t index, const double query_key)
+{
+  const double ratio =
+    (query_key - base_keys.at(index)) / (base_keys.at(index + 1) - base_keys.at(index));
+  return interpolation::LerpSegment{index, ratio};
+}
+}  // namespace
+
 namespace interpolation
 {
 double lerp(const double src_val, const double dst_val, const double ratio)
@@ -23,37 +56,139 @@ double lerp(const double src_val, const double dst_val, const double ratio)
   return src_val + (dst_val - src_val) * ratio;
 }
 
-std::vector<double> lerp(
-  const std::vector<double> & base_keys, const std::vector<double> & base_values,
-  const std::vector<double> & query_keys)
+std::vector<LerpSegment> calcLerpSegments(
+  const std::vector<double> & base_keys, const std::vector<double> & query_keys)
 {
   // throw exception for invalid arguments
   const auto validated_query_keys = interpolation_utils::validateKeys(base_keys, query_keys);
-  interpolation_utils::validateKeysAndValues(base_keys, base_values);
 
-  // calculate linear interpolation
-  std::vector<double> query_values;
+  std::vector<LerpSegment> segments;
+  segments.reserve(validated_query_keys.size());
   size_t key_index = 0;
   for (const auto query_key : validated_query_keys) {
     while (base_keys.at(key_index + 1) < query_key) {
       ++key_index;
     }
 
-    const double src_val = base_values.at(key_index);
-    const double dst_val = base_values.at(key_index + 1);
     const double ratio = (query_key - base_keys.at(key_index)) /
                          (base_keys.at(key_index + 1) - base_keys.at(key_index));
+    segments.push_back(LerpSegment{key_index, ratio});
+  }
 
-    const double interpolated_val = lerp(src_val, dst_val, ratio);
-    query_values.push_back(interpolated_val);
+  return segments;
+}
+
+LerpSegment calcLerpSegment(const std::vector<double> & base_keys, const double query_key)
+{
+  // throw exception for invalid arguments
+  if (base_keys.size() < 2) {
+    throw std::invalid_argument(
+      "The size of points is less than 2. base_keys.size() = " + std::to_string(base_keys.size()));
+  }
+  if (!interpolation_utils::isIncreasing(base_keys)) {
+    throw std::invalid_argument("Either base_keys or query_keys is not sorted.");
+  }
+
+  const double validated_query_key = validateQueryKey(base_keys, query_key);
+  return calcSegment(
+    base_keys, findSegmentIndex(base_keys, validated_query_key), validated_query_key);
+}
+
+std::vector<double> lerp(
+  const std::vector<double> & base_values, const std::vector<LerpSegment> & segments)
+{
+  std::vector<double> query_values(segments.size());
+  for (size_t i = 0; i < segments.size(); ++i) {
+    const auto & segment = segments[i];
+    query_values[i] =
+      lerp(base_values.at(segment.index), base_values.at(segment.index + 1), segment.ratio);
   }
 
   return query_values;
 }
 
+std::vector<double> lerp(
+  const std::vector<double> & base_keys, const std::vector<double> & base_values,
+  const std::vector<double> & query_keys)
+{
+  // throw exception for invalid arguments
+  const auto segments = calcLerpSegments(base_keys, query_keys);
+  interpolation_utils::validateKeysAndValues(base_keys, base_values);
+
+  // calculate linear interpolation
+  return lerp(base_values, segments);
+}
+
+double lerp(const std::vector<double> & base_values, const LerpSegment & segment)
+{
+  return lerp(base_values.at(segment.index), base_values.at(segment.index + 1), segment.ratio);
+}
+
 double lerp(
   const std::vector<double> & base_keys, const std::vector<double> & base_values, double query_key)
 {
-  return lerp(base_keys, base_values, std::vector<double>{query_key}).front();
+  // throw exception for invalid arguments
+  const auto segment = calcLerpSegment(base_keys, query_key);
+  interpolation_utils::validateKeysAndValues(base_keys, base_values);
+
+  return lerp(base_values, segment);
+}
+
+LinearInterpolator::LinearInterpolator(const std::vector<double> & base_keys)
+: base_keys_(base_keys)
+{
+  // throw exception for invalid arguments
+  if (base_keys_.size() < 2) {
+    throw std::invalid_argument(
+      "The size of points is less than 2. base_keys.size() = " + std::to_string(base_keys.size()));
+  }
+  if (!interpolation_utils::isIncreasing(base_keys_)) {
+    throw std::invalid_argument("base_keys is not sorted.");
+  }
+}
+
+LerpSegment LinearInterpolator::getSegment(const double query_key) const
+{
+  const double validated_query_key = validateQueryKey(base_keys_, query_key);
+  return calcSegment(
+    base_keys_, findSegmentIndex(base_keys_, validated_query_key), validated_query_key);
+}
+
+LerpSegment LinearInterpolator::getSegment(const double query_key, size_t & hint) const
+{
+  const double validated_query_key = validateQueryKey(base_keys_, query_key);
+
+  // walk from the hint to the same segment as findSegmentIndex
+  size_t index = std::min(hint, base_keys_.size() - 2);
+  while (index + 2 < base_keys_.size() && base_keys_[index + 1] < validated_query_key) {
+    ++index;
+  }
+  while (0 < index && validated_query_key <= base_keys_[index]) {
+    --index;
+  }
+  hint = index;
+
+  return calcSegment(base_keys_, index, validated_query_key);
+}
+
+double LinearInterpolator::lerp(
+  const std::vector<double> & base_values, const double query_key) const
+{
+  validateValues(base_values.size());
+  return interpolation::lerp(base_values, getSegment(query_key));
+}
+
+double LinearInterpolator::lerp(
+  const std::vector<double> & base_values, const double query_key, size_t & hint) const
+{
+  validateValues(base_values.size());
+  return interpolation::lerp(base_values, getSegment(query_key, hint));
+}
+
+void LinearInterpolator::validateValues(const size_t values_size) const
+{
+  if (values_size != base_keys_.size()) {
+    throw std::invalid_argument("The size of base_keys and base_values are not the same.");
+  }
 }
 }  // namespace interpolation
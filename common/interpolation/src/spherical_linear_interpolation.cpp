@@ -57,4 +57,20 @@ std::vector<geometry_msgs::msg::Quaternion> slerp(
   return query_values;
 }
 
+geometry_msgs::msg::Quaternion slerp(
+  const std::vector<geometry_msgs::msg::Quaternion> & base_values, const LerpSegment & segment)
+{
+  return slerp(base_values.at(segment.index), base_values.at(segment.index + 1), segment.ratio);
+}
+
+geometry_msgs::msg::Quaternion slerp(
+  const std::vector<double> & base_keys,
+  const std::vector<geometry_msgs::msg::Quaternion> & base_values, const double query_key)
+{
+  // throw exception for invalid arguments
+  const auto segment = calcLerpSegment(base_keys, query_key);
+  interpolation_utils::validateKeysAndValues(base_keys, base_values);
+
+  return slerp(base_values, segment);
+}
 }  // namespace interpolation
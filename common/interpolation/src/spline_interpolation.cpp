@@ -25,43 +25,34 @@ namespace
 // A = [            ...                   ]
 //     [   O         ... a_N-3 b_N-2 c_N-2]
 //     [                   ... a_N-2 b_N-1]
-struct TDMACoef
+// NOTE: a, b, c, d are tdma_a, tdma_b, tdma_c, tdma_d of the workspace, and the solution x is
+//       appended to v.
+void solveTridiagonalMatrixAlgorithm(interpolation::SplineWorkspace & workspace)
 {
-  explicit TDMACoef(const size_t num_row)
-  {
-    a.resize(num_row - 1);
-    b.resize(num_row);
-    c.resize(num_row - 1);
-    d.resize(num_row);
-  }
-
-  std::vector<double> a;
-  std::vector<double> b;
-  std::vector<double> c;
-  std::vector<double> d;
-};
-
-inline std::vector<double> solveTridiagonalMatrixAlgorithm(const TDMACoef & tdma_coef)
-{
-  const auto & a = tdma_coef.a;
-  const auto & b = tdma_coef.b;
-  const auto & c = tdma_coef.c;
-  const auto & d = tdma_coef.d;
+  const auto & a = workspace.tdma_a;
+  const auto & b = workspace.tdma_b;
+  const auto & c = workspace.tdma_c;
+  const auto & d = workspace.tdma_d;
+  auto & p = workspace.tdma_p;
+  auto & q = workspace.tdma_q;
+  auto & v = workspace.v;
 
   const size_t num_row = b.size();
+  const size_t v_offset = v.size();
+  v.resize(v_offset + num_row);
+  const auto x = v.begin() + v_offset;
 
-  std::vector<double> x(num_row);
   if (num_row != 1) {
     // calculate p and q
-    std::vector<double> p;
-    std::vector<double> q;
-    p.push_back(-c[0] / b[0]);
-    q.push_back(d[0] / b[0]);
+    p.resize(num_row);
+    q.resize(num_row);
+    p[0] = -c[0] / b[0];
+    q[0] = d[0] / b[0];
 
     for (size_t i = 1; i < num_row; ++i) {
       const double den = b[i] + a[i - 1] * p[i - 1];
-      p.push_back(-c[i - 1] / den);
-      q.push_back((d[i] - a[i - 1] * q[i - 1]) / den);
+      p[i] = -c[i - 1] / den;
+      q[i] = (d[i] - a[i - 1] * q[i - 1]) / den;
     }
 
     // calculate solution
@@ -74,8 +65,6 @@ inline std::vector<double> solveTridiagonalMatrixAlgorithm(const TDMACoef & tdma
   } else {
     x[0] = (d[0] / b[0]);
   }
-
-  return x;
 }
 }  // namespace
 
@@ -167,44 +156,53 @@ std::vector<double> splineByAkima(
 }  // namespace interpolation
 
 void SplineInterpolation::calcSplineCoefficients(
-  const std::vector<double> & base_keys, const std::vector<double> & base_values)
+  const std::vector<double> & base_keys, const std::vector<double> & base_values,
+  interpolation::SplineWorkspace & workspace)
 {
   // throw exceptions for invalid arguments
   interpolation_utils::validateKeysAndValues(base_keys, base_values);
 
   const size_t num_base = base_keys.size();  // N+1
 
-  std::vector<double> diff_keys;    // N
-  std::vector<double> diff_values;  // N
+  auto & diff_keys = workspace.diff_keys;      // N
+  auto & diff_values = workspace.diff_values;  // N
+  diff_keys.resize(num_base - 1);
+  diff_values.resize(num_base - 1);
   for (size_t i = 0; i < num_base - 1; ++i) {
-    diff_keys.push_back(base_keys.at(i + 1) - base_keys.at(i));
-    diff_values.push_back(base_values.at(i + 1) - base_values.at(i));
+    diff_keys[i] = base_keys[i + 1] - base_keys[i];
+    diff_values[i] = base_values[i + 1] - base_values[i];
   }
 
-  std::vector<double> v = {0.0};
+  auto & v = workspace.v;
+  v.assign(1, 0.0);
   if (num_base > 2) {
     // solve tridiagonal matrix algorithm
-    TDMACoef tdma_coef(num_base - 2);  // N-1
-
-    for (size_t i = 0; i < num_base - 2; ++i) {
-      tdma_coef.b[i] = 2 * (diff_keys[i] + diff_keys[i + 1]);
-      if (i != num_base - 3) {
-        tdma_coef.a[i] = diff_keys[i + 1];
-        tdma_coef.c[i] = diff_keys[i + 1];
+    const size_t num_row = num_base - 2;  // N-1
+    workspace.tdma_a.resize(num_row - 1);
+    workspace.tdma_b.resize(num_row);
+    workspace.tdma_c.resize(num_row - 1);
+    workspace.tdma_d.resize(num_row);
+
+    for (size_t i = 0; i < num_row; ++i) {
+      workspace.tdma_b[i] = 2 * (diff_keys[i] + diff_keys[i + 1]);
+      if (i != num_row - 1) {
+        workspace.tdma_a[i] = diff_keys[i + 1];
+        workspace.tdma_c[i] = diff_keys[i + 1];
       }
-      tdma_coef.d[i] =
+      workspace.tdma_d[i] =
         6.0 * (diff_values[i + 1] / diff_keys[i + 1] - diff_values[i] / diff_keys[i]);
     }
 
-    const std::vector<double> tdma_res = solveTridiagonalMatrixAlgorithm(tdma_coef);
-
     // calculate v
-    v.insert(v.end(), tdma_res.begin(), tdma_res.end());
+    solveTridiagonalMatrixAlgorithm(workspace);
   }
   v.push_back(0.0);
 
   // calculate a, b, c, d of spline coefficients
-  multi_spline_coef_ = interpolation::MultiSplineCoef{num_base - 1};  // N
+  multi_spline_coef_.a.resize(num_base - 1);  // N
+  multi_spline_coef_.b.resize(num_base - 1);
+  multi_spline_coef_.c.resize(num_base - 1);
+  multi_spline_coef_.d.resize(num_base - 1);
   for (size_t i = 0; i < num_base - 1; ++i) {
     multi_spline_coef_.a[i] = (v[i + 1] - v[i]) / 6.0 / diff_keys[i];
     multi_spline_coef_.b[i] = v[i] / 2.0;
@@ -216,6 +214,13 @@ void SplineInterpolation::calcSplineCoefficients(
   base_keys_ = base_keys;
 }
 
+size_t SplineInterpolation::getSegmentIndex(const double query_key) const
+{
+  // NOTE: the last base key belongs to the last segment
+  const auto itr = std::upper_bound(base_keys_.begin() + 1, base_keys_.end() - 1, query_key);
+  return static_cast<size_t>(std::distance(base_keys_.begin(), itr)) - 1;
+}
+
 std::vector<double> SplineInterpolation::getSplineInterpolatedValues(
   const std::vector<double> & query_keys) const
 {
@@ -227,15 +232,17 @@ std::vector<double> SplineInterpolation::getSplineInterpolatedValues(
   const auto & c = multi_spline_coef_.c;
   const auto & d = multi_spline_coef_.d;
 
-  std::vector<double> res;
+  // NOTE: query keys are sorted, so their segments are found by sweeping the base keys once
+  std::vector<double> res(validated_query_keys.size());
   size_t j = 0;
-  for (const auto & query_key : validated_query_keys) {
-    while (base_keys_.at(j + 1) < query_key) {
+  for (size_t i = 0; i < validated_query_keys.size(); ++i) {
+    const double query_key = validated_query_keys[i];
+    while (base_keys_[j + 1] < query_key) {
       ++j;
     }
 
-    const double ds = query_key - base_keys_.at(j);
-    res.push_back(d.at(j) + (c.at(j) + (b.at(j) + a.at(j) * ds) * ds) * ds);
+    const double ds = query_key - base_keys_[j];
+    res[i] = d[j] + (c[j] + (b[j] + a[j] * ds) * ds) * ds;
   }
 
   return res;
@@ -251,15 +258,16 @@ std::vector<double> SplineInterpolation::getSplineInterpolatedDiffValues(
   const auto & b = multi_spline_coef_.b;
   const auto & c = multi_spline_coef_.c;
 
-  std::vector<double> res;
+  std::vector<double> res(validated_query_keys.size());
   size_t j = 0;
-  for (const auto & query_key : validated_query_keys) {
-    while (base_keys_.at(j + 1) < query_key) {
+  for (size_t i = 0; i < validated_query_keys.size(); ++i) {
+    const double query_key = validated_query_keys[i];
+    while (base_keys_[j + 1] < query_key) {
       ++j;
     }
 
-    const double ds = query_key - base_keys_.at(j);
-    res.push_back(c.at(j) + (2.0 * b.at(j) + 3.0 * a.at(j) * ds) * ds);
+    const double ds = query_key - base_keys_[j];
+    res[i] = c[j] + (2.0 * b[j] + 3.0 * a[j] * ds) * ds;
   }
 
   return res;
@@ -274,16 +282,78 @@ std::vector<double> SplineInterpolation::getSplineInterpolatedQuadDiffValues(
   const auto & a = multi_spline_coef_.a;
   const auto & b = multi_spline_coef_.b;
 
-  std::vector<double> res;
+  std::vector<double> res(validated_query_keys.size());
+  size_t j = 0;
+  for (size_t i = 0; i < validated_query_keys.size(); ++i) {
+    const double query_key = validated_query_keys[i];
+    while (base_keys_[j + 1] < query_key) {
+      ++j;
+    }
+
+    const double ds = query_key - base_keys_[j];
+    res[i] = 2.0 * b[j] + 6.0 * a[j] * ds;
+  }
+
+  return res;
+}
+
+interpolation::SplineInterpolatedValues SplineInterpolation::getSplineInterpolatedValuesWithDiffs(
+  const std::vector<double> & query_keys) const
+{
+  // throw exceptions for invalid arguments
+  const auto validated_query_keys = interpolation_utils::validateKeys(base_keys_, query_keys);
+
+  const auto & a = multi_spline_coef_.a;
+  const auto & b = multi_spline_coef_.b;
+  const auto & c = multi_spline_coef_.c;
+  const auto & d = multi_spline_coef_.d;
+
+  interpolation::SplineInterpolatedValues res;
+  res.values.resize(validated_query_keys.size());
+  res.diff_values.resize(validated_query_keys.size());
+  res.quad_diff_values.resize(validated_query_keys.size());
   size_t j = 0;
-  for (const auto & query_key : validated_query_keys) {
-    while (base_keys_.at(j + 1) < query_key) {
+  for (size_t i = 0; i < validated_query_keys.size(); ++i) {
+    const double query_key = validated_query_keys[i];
+    while (base_keys_[j + 1] < query_key) {
       ++j;
     }
 
-    const double ds = query_key - base_keys_.at(j);
-    res.push_back(2.0 * b.at(j) + 6.0 * a.at(j) * ds);
+    const double ds = query_key - base_keys_[j];
+    res.values[i] = d[j] + (c[j] + (b[j] + a[j] * ds) * ds) * ds;
+    res.diff_values[i] = c[j] + (2.0 * b[j] + 3.0 * a[j] * ds) * ds;
+    res.quad_diff_values[i] = 2.0 * b[j] + 6.0 * a[j] * ds;
   }
 
   return res;
 }
+
+double SplineInterpolation::getSplineInterpolatedValue(const double query_key) const
+{
+  const double clamped_key = std::clamp(query_key, base_keys_.front(), base_keys_.back());
+  const size_t j = getSegmentIndex(clamped_key);
+  const auto & coef = multi_spline_coef_;
+
+  const double ds = clamped_key - base_keys_[j];
+  return coef.d[j] + (coef.c[j] + (coef.b[j] + coef.a[j] * ds) * ds) * ds;
+}
+
+double SplineInterpolation::getSplineInterpolatedDiffValue(const double query_key) const
+{
+  const double clamped_key = std::clamp(query_key, base_keys_.front(), base_keys_.back());
+  const size_t j = getSegmentIndex(clamped_key);
+  const auto & coef = multi_spline_coef_;
+
+  const double ds = clamped_key - base_keys_[j];
+  return coef.c[j] + (2.0 * coef.b[j] + 3.0 * coef.a[j] * ds) * ds;
+}
+
+double SplineInterpolation::getSplineInterpolatedQuadDiffValue(const double query_key) const
+{
+  const double clamped_key = std::clamp(query_key, base_keys_.front(), base_keys_.back());
+  const size_t j = getSegmentIndex(clamped_key);
+  const auto & coef = multi_spline_coef_;
+
+  const double ds = clamped_key - base_keys_[j];
+  return 2.0 * coef.b[j] + 6.0 * coef.a[j] * ds;
+}
@@ -14,6 +14,8 @@
 
 #include "interpolation/spline_interpolation_points_2d.hpp"
 
+#include <algorithm>
+#include <utility>
 #include <vector>
 
 namespace
@@ -76,21 +78,19 @@ std::array<std::vector<double>, 3> slerp2dFromXY(
   const std::vector<double> & base_y_values, const std::vector<double> & query_keys)
 {
   // calculate spline coefficients
-  SplineInterpolation interpolator_x(base_keys, base_x_values);
-  SplineInterpolation interpolator_y(base_keys, base_y_values);
-  const auto diff_x = interpolator_x.getSplineInterpolatedDiffValues(query_keys);
-  const auto diff_y = interpolator_y.getSplineInterpolatedDiffValues(query_keys);
+  SplineWorkspace workspace;
+  SplineInterpolation interpolator_x(base_keys, base_x_values, workspace);
+  SplineInterpolation interpolator_y(base_keys, base_y_values, workspace);
+  auto interpolated_x = interpolator_x.getSplineInterpolatedValuesWithDiffs(query_keys);
+  auto interpolated_y = interpolator_y.getSplineInterpolatedValuesWithDiffs(query_keys);
 
   // calculate yaw
-  std::vector<double> yaw_vec;
-  for (size_t i = 0; i < diff_x.size(); i++) {
-    double yaw = std::atan2(diff_y[i], diff_x[i]);
-    yaw_vec.push_back(yaw);
+  std::vector<double> yaw_vec(interpolated_x.diff_values.size());
+  for (size_t i = 0; i < yaw_vec.size(); i++) {
+    yaw_vec[i] = std::atan2(interpolated_y.diff_values[i], interpolated_x.diff_values[i]);
   }
   // interpolate base_keys at query_keys
-  return {
-    interpolator_x.getSplineInterpolatedValues(query_keys),
-    interpolator_y.getSplineInterpolatedValues(query_keys), yaw_vec};
+  return {std::move(interpolated_x.values), std::move(interpolated_y.values), yaw_vec};
 }
 
 template <typename T>
@@ -137,9 +137,9 @@ geometry_msgs::msg::Point SplineInterpolationPoints2d::getSplineInterpolatedPoin
     whole_s = base_s_vec_.back();
   }
 
-  const double x = spline_x_.getSplineInterpolatedValues({whole_s}).at(0);
-  const double y = spline_y_.getSplineInterpolatedValues({whole_s}).at(0);
-  const double z = spline_z_.getSplineInterpolatedValues({whole_s}).at(0);
+  const double x = spline_x_.getSplineInterpolatedValue(whole_s);
+  const double y = spline_y_.getSplineInterpolatedValue(whole_s);
+  const double z = spline_z_.getSplineInterpolatedValue(whole_s);
 
   geometry_msgs::msg::Point geom_point;
   geom_point.x = x;
@@ -157,18 +157,20 @@ double SplineInterpolationPoints2d::getSplineInterpolatedYaw(const size_t idx, c
   const double whole_s =
     std::clamp(base_s_vec_.at(idx) + s, base_s_vec_.front(), base_s_vec_.back());
 
-  const double diff_x = spline_x_.getSplineInterpolatedDiffValues({whole_s}).at(0);
-  const double diff_y = spline_y_.getSplineInterpolatedDiffValues({whole_s}).at(0);
+  const double diff_x = spline_x_.getSplineInterpolatedDiffValue(whole_s);
+  const double diff_y = spline_y_.getSplineInterpolatedDiffValue(whole_s);
 
   return std::atan2(diff_y, diff_x);
 }
 
 std::vector<double> SplineInterpolationPoints2d::getSplineInterpolatedYaws() const
 {
-  std::vector<double> yaw_vec;
-  for (size_t i = 0; i < spline_x_.getSize(); ++i) {
-    const double yaw = getSplineInterpolatedYaw(i, 0.0);
-    yaw_vec.push_back(yaw);
+  const auto diff_x = spline_x_.getSplineInterpolatedDiffValues(base_s_vec_);
+  const auto diff_y = spline_y_.getSplineInterpolatedDiffValues(base_s_vec_);
+
+  std::vector<double> yaw_vec(base_s_vec_.size());
+  for (size_t i = 0; i < yaw_vec.size(); ++i) {
+    yaw_vec.at(i) = std::atan2(diff_y.at(i), diff_x.at(i));
   }
   return yaw_vec;
 }
@@ -183,11 +185,11 @@ double SplineInterpolationPoints2d::getSplineInterpolatedCurvature(
   const double whole_s =
     std::clamp(base_s_vec_.at(idx) + s, base_s_vec_.front(), base_s_vec_.back());
 
-  const double diff_x = spline_x_.getSplineInterpolatedDiffValues({whole_s}).at(0);
-  const double diff_y = spline_y_.getSplineInterpolatedDiffValues({whole_s}).at(0);
+  const double diff_x = spline_x_.getSplineInterpolatedDiffValue(whole_s);
+  const double diff_y = spline_y_.getSplineInterpolatedDiffValue(whole_s);
 
-  const double quad_diff_x = spline_x_.getSplineInterpolatedQuadDiffValues({whole_s}).at(0);
-  const double quad_diff_y = spline_y_.getSplineInterpolatedQuadDiffValues({whole_s}).at(0);
+  const double quad_diff_x = spline_x_.getSplineInterpolatedQuadDiffValue(whole_s);
+  const double quad_diff_y = spline_y_.getSplineInterpolatedQuadDiffValue(whole_s);
 
   return (diff_x * quad_diff_y - quad_diff_x * diff_y) /
          std::pow(std::pow(diff_x, 2) + std::pow(diff_y, 2), 1.5);
@@ -195,10 +197,17 @@ double SplineInterpolationPoints2d::getSplineInterpolatedCurvature(
 
 std::vector<double> SplineInterpolationPoints2d::getSplineInterpolatedCurvatures() const
 {
-  std::vector<double> curvature_vec;
-  for (size_t i = 0; i < spline_x_.getSize(); ++i) {
-    const double curvature = getSplineInterpolatedCurvature(i, 0.0);
-    curvature_vec.push_back(curvature);
+  const auto interpolated_x = spline_x_.getSplineInterpolatedValuesWithDiffs(base_s_vec_);
+  const auto interpolated_y = spline_y_.getSplineInterpolatedValuesWithDiffs(base_s_vec_);
+
+  std::vector<double> curvature_vec(base_s_vec_.size());
+  for (size_t i = 0; i < curvature_vec.size(); ++i) {
+    const double diff_x = interpolated_x.diff_values.at(i);
+    const double diff_y = interpolated_y.diff_values.at(i);
+    const double quad_diff_x = interpolated_x.quad_diff_values.at(i);
+    const double quad_diff_y = interpolated_y.quad_diff_values.at(i);
+    curvature_vec.at(i) = (diff_x * quad_diff_y - quad_diff_x * diff_y) /
+                          std::pow(std::pow(diff_x, 2) + std::pow(diff_y, 2), 1.5);
   }
   return curvature_vec;
 }
@@ -206,12 +215,11 @@ std::vector<double> SplineInterpolationPoints2d::getSplineInterpolatedCurvatures
 size_t SplineInterpolationPoints2d::getOffsetIndex(const size_t idx, const double offset) const
 {
   const double whole_s = base_s_vec_.at(idx) + offset;
-  for (size_t s_idx = 0; s_idx < base_s_vec_.size(); ++s_idx) {
-    if (whole_s < base_s_vec_.at(s_idx)) {
-      return s_idx;
-    }
+  const auto itr = std::upper_bound(base_s_vec_.begin(), base_s_vec_.end(), whole_s);
+  if (itr == base_s_vec_.end()) {
+    return base_s_vec_.size() - 1;
   }
-  return base_s_vec_.size() - 1;
+  return static_cast<size_t>(std::distance(base_s_vec_.begin(), itr));
 }
 
 double SplineInterpolationPoints2d::getAccumulatedLength(const size_t idx) const
@@ -233,7 +241,8 @@ void SplineInterpolationPoints2d::calcSplineCoefficientsInner(
   const auto & base_z_vec = base.at(3);
 
   // calculate spline coefficients
-  spline_x_ = SplineInterpolation(base_s_vec_, base_x_vec);
-  spline_y_ = SplineInterpolation(base_s_vec_, base_y_vec);
-  spline_z_ = SplineInterpolation(base_s_vec_, base_z_vec);
+  interpolation::SplineWorkspace workspace;
+  spline_x_ = SplineInterpolation(base_s_vec_, base_x_vec, workspace);
+  spline_y_ = SplineInterpolation(base_s_vec_, base_y_vec, workspace);
+  spline_z_ = SplineInterpolation(base_s_vec_, base_z_vec, workspace);
 }
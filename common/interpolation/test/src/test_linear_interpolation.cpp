@@ -78,6 +78,34 @@ TEST(linear_interpolation, lerp_vector)
   }
 }
 
+TEST(linear_interpolation, lerp_segments)
+{
+  const std::vector<double> base_keys{0.0, 1.0, 2.0, 3.0, 4.0};
+  const std::vector<double> query_keys{0.0, 0.7, 1.9, 4.0};
+
+  const auto segments = interpolation::calcLerpSegments(base_keys, query_keys);
+  ASSERT_EQ(segments.size(), query_keys.size());
+  EXPECT_EQ(segments.at(0).index, 0U);
+  EXPECT_NEAR(segments.at(0).ratio, 0.0, epsilon);
+  EXPECT_EQ(segments.at(1).index, 0U);
+  EXPECT_NEAR(segments.at(1).ratio, 0.7, epsilon);
+  EXPECT_EQ(segments.at(2).index, 1U);
+  EXPECT_NEAR(segments.at(2).ratio, 0.9, epsilon);
+  EXPECT_EQ(segments.at(3).index, 3U);
+  EXPECT_NEAR(segments.at(3).ratio, 1.0, epsilon);
+
+  // the segments are shared by several values on the same keys
+  const std::vector<double> base_values1{0.0, 1.5, 3.0, 4.5, 6.0};
+  const std::vector<double> base_values2{-1.2, 0.5, 1.0, 1.2, 2.0};
+  for (const auto & base_values : {base_values1, base_values2}) {
+    const auto query_values = interpolation::lerp(base_values, segments);
+    const auto ans = interpolation::lerp(base_keys, base_values, query_keys);
+    for (size_t i = 0; i < query_values.size(); ++i) {
+      EXPECT_NEAR(query_values.at(i), ans.at(i), epsilon);
+    }
+  }
+}
+
 TEST(linear_interpolation, lerp_scalar_query)
 {
   {  // curve: query_keys is same as random
@@ -92,3 +120,38 @@ TEST(linear_interpolation, lerp_scalar_query)
     }
   }
 }
+
+TEST(linear_interpolation, linear_interpolator)
+{
+  const std::vector<double> base_keys{-1.5, 1.0, 5.0, 10.0, 15.0, 20.0};
+  const std::vector<double> base_values{-1.2, 0.5, 1.0, 1.2, 2.0, 1.0};
+  const interpolation::LinearInterpolator interpolator(base_keys);
+
+  // same as lerp for the query keys in any order, with or without the hint
+  const std::vector<double> query_keys{0.0, 8.0, 18.0, 20.0, 5.0, -1.5, 1.0, 19.9999, 12.0};
+  size_t hint = 0;
+  for (const double query_key : query_keys) {
+    const auto segment = interpolator.getSegment(query_key);
+    const auto hinted_segment = interpolator.getSegment(query_key, hint);
+    EXPECT_EQ(segment.index, hinted_segment.index);
+    EXPECT_NEAR(segment.ratio, hinted_segment.ratio, epsilon);
+    EXPECT_EQ(hint, segment.index);
+
+    const auto ans_segment = interpolation::calcLerpSegments(base_keys, {query_key}).front();
+    EXPECT_EQ(segment.index, ans_segment.index);
+    EXPECT_NEAR(segment.ratio, ans_segment.ratio, epsilon);
+    EXPECT_NEAR(
+      interpolator.lerp(base_values, query_key),
+      interpolation::lerp(base_keys, base_values, query_key), epsilon);
+  }
+
+  // query keys slightly out of base keys are cropped
+  EXPECT_NEAR(interpolator.lerp(base_values, -1.5 - 1e-4), -1.2, epsilon);
+  EXPECT_NEAR(interpolator.lerp(base_values, 20.0 + 1e-4, hint), 1.0, epsilon);
+
+  // invalid arguments
+  EXPECT_THROW(interpolator.lerp(base_values, 21.0), std::invalid_argument);
+  EXPECT_THROW(interpolator.lerp({0.0, 1.0}, 0.0), std::invalid_argument);
+  EXPECT_THROW(interpolation::LinearInterpolator({0.0}), std::invalid_argument);
+  EXPECT_THROW(interpolation::LinearInterpolator({0.0, 2.0, 1.0}), std::invalid_argument);
+}
@@ -135,3 +135,29 @@ TEST(slerp, spline_vector)
     }
   }
 }
+
+TEST(slerp, spline_scalar_query)
+{
+  using interpolation::slerp;
+
+  const std::vector<double> base_keys{0.0, 1.0, 2.0, 3.0, 4.0};
+  std::vector<geometry_msgs::msg::Quaternion> base_values;
+  for (size_t i = 0; i < 5; ++i) {
+    base_values.push_back(createQuaternionFromRPY(0.0, 0.0, i * M_PI / 5.0));
+  }
+  const std::vector<double> query_keys = {0.0, 0.1, 1.5, 2.6, 3.1, 3.8, 4.0};
+  const auto ans = slerp(base_keys, base_values, query_keys);
+
+  const interpolation::LinearInterpolator interpolator(base_keys);
+  size_t hint = 0;
+  for (size_t i = 0; i < query_keys.size(); ++i) {
+    const auto interpolated_quat = slerp(base_keys, base_values, query_keys.at(i));
+    const auto hinted_quat = slerp(base_values, interpolator.getSegment(query_keys.at(i), hint));
+    for (const auto & quat : {interpolated_quat, hinted_quat}) {
+      EXPECT_NEAR(ans.at(i).x, quat.x, epsilon);
+      EXPECT_NEAR(ans.at(i).y, quat.y, epsilon);
+      EXPECT_NEAR(ans.at(i).z, quat.z, epsilon);
+      EXPECT_NEAR(ans.at(i).w, quat.w, epsilon);
+    }
+  }
+}
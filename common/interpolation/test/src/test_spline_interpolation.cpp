@@ -235,3 +235,32 @@ TEST(spline_interpolation, SplineInterpolation)
     EXPECT_NEAR(query_values.at(i), ans.at(i), epsilon);
   }
 }
+
+TEST(spline_interpolation, SplineInterpolationWithWorkspace)
+{
+  // curve: query_keys is random
+  const std::vector<double> base_keys{-1.5, 1.0, 5.0, 10.0, 15.0, 20.0};
+  const std::vector<double> base_values{-1.2, 0.5, 1.0, 1.2, 2.0, 1.0};
+  const std::vector<double> query_keys{0.0, 8.0, 18.0};
+  const std::vector<double> ans{-0.075611, 0.997242, 1.573258};
+
+  // the workspace is shared with another spline
+  interpolation::SplineWorkspace workspace;
+  SplineInterpolation s_zero(base_keys, std::vector<double>(base_keys.size(), 0.0), workspace);
+  SplineInterpolation s(base_keys, base_values, workspace);
+  const auto query_values = s.getSplineInterpolatedValuesWithDiffs(query_keys);
+  const auto diff_values = s.getSplineInterpolatedDiffValues(query_keys);
+  const auto quad_diff_values = s.getSplineInterpolatedQuadDiffValues(query_keys);
+
+  for (size_t i = 0; i < query_keys.size(); ++i) {
+    EXPECT_NEAR(query_values.values.at(i), ans.at(i), epsilon);
+    EXPECT_NEAR(query_values.diff_values.at(i), diff_values.at(i), epsilon);
+    EXPECT_NEAR(query_values.quad_diff_values.at(i), quad_diff_values.at(i), epsilon);
+
+    // single query key
+    EXPECT_NEAR(s.getSplineInterpolatedValue(query_keys.at(i)), ans.at(i), epsilon);
+    EXPECT_NEAR(s.getSplineInterpolatedDiffValue(query_keys.at(i)), diff_values.at(i), epsilon);
+    EXPECT_NEAR(
+      s.getSplineInterpolatedQuadDiffValue(query_keys.at(i)), quad_diff_values.at(i), epsilon);
+  }
+}
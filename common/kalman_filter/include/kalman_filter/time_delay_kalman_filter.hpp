@@ -27,6 +27,10 @@
  * @brief kalman filter with delayed measurement class
  * @author Takamasa Horibe
  * @date 2019.05.01
+ *
+ * The delayed states are stored as a ring buffer of dim_x blocks in x_ and P_. The block of delay
+ * step d is at the slot (head + d) % max_delay_step, so the prediction moves the head instead of
+ * sliding the whole extended state.
  */
 
 class TimeDelayKalmanFilter : public KalmanFilter
@@ -56,6 +60,22 @@ public:
    */
   Eigen::MatrixXd getLatestP() const;
 
+  /**
+   * @brief get element of the extended state in the order of the delay steps
+   * @param i index of the element, delay_step * dim_x + index in the state
+   */
+  double getXelement(unsigned int i) const;
+
+  /**
+   * @brief get extended state in the order of the delay steps
+   */
+  void getX(Eigen::MatrixXd & x) const;
+
+  /**
+   * @brief get extended covariance in the order of the delay steps
+   */
+  void getP(Eigen::MatrixXd & P) const;
+
   /**
    * @brief calculate kalman filter covariance by precision model with time delay. This is mainly
    * for EKF of nonlinear process model.
@@ -79,8 +99,17 @@ public:
     const int delay_step);
 
 private:
+  /**
+   * @brief first row of the block of the delay step in x_ and P_
+   */
+  int getBlockIndex(const int delay_step) const;
+
   int max_delay_step_;  //!< @brief maximum number of delay steps
   int dim_x_;           //!< @brief dimension of latest state
   int dim_x_ex_;        //!< @brief dimension of extended state with dime delay
+  int head_;            //!< @brief slot of the latest state in the ring buffer
+
+  Eigen::MatrixXd AP_;   //!< @brief buffer of A * (rows of the latest state in P)
+  Eigen::MatrixXd PCT_;  //!< @brief buffer of P * C' for the update
 };
 #endif  // KALMAN_FILTER__TIME_DELAY_KALMAN_FILTER_HPP_
@@ -22,9 +22,11 @@ void TimeDelayKalmanFilter::init(
   max_delay_step_ = max_delay_step;
   dim_x_ = x.rows();
   dim_x_ex_ = dim_x_ * max_delay_step;
+  head_ = 0;
 
   x_ = Eigen::MatrixXd::Zero(dim_x_ex_, 1);
   P_ = Eigen::MatrixXd::Zero(dim_x_ex_, dim_x_ex_);
+  AP_.resize(dim_x_, dim_x_ex_);
 
   for (int i = 0; i < max_delay_step_; ++i) {
     x_.block(i * dim_x_, 0, dim_x_, 1) = x;
@@ -32,9 +34,44 @@ void TimeDelayKalmanFilter::init(
   }
 }
 
-Eigen::MatrixXd TimeDelayKalmanFilter::getLatestX() const { return x_.block(0, 0, dim_x_, 1); }
+int TimeDelayKalmanFilter::getBlockIndex(const int delay_step) const
+{
+  return ((head_ + delay_step) % max_delay_step_) * dim_x_;
+}
+
+Eigen::MatrixXd TimeDelayKalmanFilter::getLatestX() const
+{
+  return x_.block(getBlockIndex(0), 0, dim_x_, 1);
+}
+
+Eigen::MatrixXd TimeDelayKalmanFilter::getLatestP() const
+{
+  return P_.block(getBlockIndex(0), getBlockIndex(0), dim_x_, dim_x_);
+}
+
+double TimeDelayKalmanFilter::getXelement(unsigned int i) const
+{
+  return x_(getBlockIndex(i / dim_x_) + i % dim_x_, 0);
+}
+
+void TimeDelayKalmanFilter::getX(Eigen::MatrixXd & x) const
+{
+  x.resize(dim_x_ex_, 1);
+  for (int i = 0; i < max_delay_step_; ++i) {
+    x.block(i * dim_x_, 0, dim_x_, 1) = x_.block(getBlockIndex(i), 0, dim_x_, 1);
+  }
+}
 
-Eigen::MatrixXd TimeDelayKalmanFilter::getLatestP() const { return P_.block(0, 0, dim_x_, dim_x_); }
+void TimeDelayKalmanFilter::getP(Eigen::MatrixXd & P) const
+{
+  P.resize(dim_x_ex_, dim_x_ex_);
+  for (int i = 0; i < max_delay_step_; ++i) {
+    for (int j = 0; j < max_delay_step_; ++j) {
+      P.block(i * dim_x_, j * dim_x_, dim_x_, dim_x_) =
+        P_.block(getBlockIndex(i), getBlockIndex(j), dim_x_, dim_x_);
+    }
+  }
+}
 
 bool TimeDelayKalmanFilter::predictWithDelay(
   const Eigen::MatrixXd & x_next, const Eigen::MatrixXd & A, const Eigen::MatrixXd & Q)
@@ -51,23 +88,24 @@ bool TimeDelayKalmanFilter::predictWithDelay(
    *     [A*P11*A'*+Q  A*P11  A*P12]
    * P = [     P11*A'    P11    P12]
    *     [     P21*A'    P21    P22]
+   *
+   * The blocks of the delayed states keep their values, so only the slot of the oldest state is
+   * overwritten by the new latest state and the head of the ring buffer moves to it.
    */
 
-  const int d_dim_x = dim_x_ex_ - dim_x_;
+  const int prev_head = getBlockIndex(0);
+  head_ = (head_ + max_delay_step_ - 1) % max_delay_step_;
+  const int head = getBlockIndex(0);
 
-  /* slide states in the time direction */
-  Eigen::MatrixXd x_tmp = Eigen::MatrixXd::Zero(dim_x_ex_, 1);
-  x_tmp.block(0, 0, dim_x_, 1) = x_next;
-  x_tmp.block(dim_x_, 0, d_dim_x, 1) = x_.block(0, 0, d_dim_x, 1);
-  x_ = x_tmp;
+  x_.block(head, 0, dim_x_, 1) = x_next;
 
   /* update P with delayed measurement A matrix structure */
-  Eigen::MatrixXd P_tmp = Eigen::MatrixXd::Zero(dim_x_ex_, dim_x_ex_);
-  P_tmp.block(0, 0, dim_x_, dim_x_) = A * P_.block(0, 0, dim_x_, dim_x_) * A.transpose() + Q;
-  P_tmp.block(0, dim_x_, dim_x_, d_dim_x) = A * P_.block(0, 0, dim_x_, d_dim_x);
-  P_tmp.block(dim_x_, 0, d_dim_x, dim_x_) = P_.block(0, 0, d_dim_x, dim_x_) * A.transpose();
-  P_tmp.block(dim_x_, dim_x_, d_dim_x, d_dim_x) = P_.block(0, 0, d_dim_x, d_dim_x);
-  P_ = P_tmp;
+  AP_.noalias() = A * P_.middleRows(prev_head, dim_x_);
+  P_.middleRows(head, dim_x_) = AP_;
+  P_.middleCols(head, dim_x_) = AP_.transpose();
+  P_.block(head, head, dim_x_, dim_x_).noalias() =
+    AP_.middleCols(prev_head, dim_x_) * A.transpose();
+  P_.block(head, head, dim_x_, dim_x_) += Q;
 
   return true;
 }
@@ -82,15 +120,26 @@ bool TimeDelayKalmanFilter::updateWithDelay(
   }
 
   const int dim_y = y.rows();
+  if (C.cols() != dim_x_ || C.rows() != dim_y || R.rows() != dim_y || R.cols() != dim_y) {
+    return false;
+  }
 
-  /* set measurement matrix */
-  Eigen::MatrixXd C_ex = Eigen::MatrixXd::Zero(dim_y, dim_x_ex_);
-  C_ex.block(0, dim_x_ * delay_step, dim_y, dim_x_) = C;
+  /*
+   * The measurement matrix of the extended state is C at the block of the delay step and zero
+   * elsewhere, so only the columns of the block are used to compute P * C_ex'.
+   */
+  const int block = getBlockIndex(delay_step);
+  PCT_.noalias() = P_.middleCols(block, dim_x_) * C.transpose();
+  const Eigen::MatrixXd S = R + C * PCT_.middleRows(block, dim_x_);
+  const Eigen::MatrixXd K = PCT_ * S.inverse();
 
-  /* update */
-  if (!update(y, C_ex, R)) {
+  if (isnan(K.array()).any() || isinf(K.array()).any()) {
     return false;
   }
 
+  /* update */
+  x_.noalias() += K * (y - C * x_.block(block, 0, dim_x_, 1));
+  P_.noalias() -= K * PCT_.transpose();
+
   return true;
 }
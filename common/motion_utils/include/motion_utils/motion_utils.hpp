@@ -18,7 +18,9 @@
 #include "motion_utils/constants.hpp"
 #include "motion_utils/marker/marker_helper.hpp"
 #include "motion_utils/resample/resample.hpp"
+#include "motion_utils/trajectory/indexed_trajectory.hpp"
 #include "motion_utils/trajectory/interpolation.hpp"
+#include "motion_utils/trajectory/nearest_index_tracker.hpp"
 #include "motion_utils/trajectory/path_with_lane_id.hpp"
 #include "motion_utils/trajectory/tmp_conversion.hpp"
 #include "motion_utils/trajectory/trajectory.hpp"
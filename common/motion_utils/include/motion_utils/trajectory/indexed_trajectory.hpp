@@ -0,0 +1,448 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MOTION_UTILS__TRAJECTORY__INDEXED_TRAJECTORY_HPP_
+#define MOTION_UTILS__TRAJECTORY__INDEXED_TRAJECTORY_HPP_
+
+#include "motion_utils/trajectory/trajectory.hpp"
+#include "tier4_autoware_utils/geometry/geometry.hpp"
+
+#include <boost/optional.hpp>
+
+#include <geometry_msgs/msg/point.hpp>
+#include <geometry_msgs/msg/pose.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace motion_utils
+{
+
+/**
+ * @brief view of points container (trajectory, path, ...) with its cumulative arc lengths and
+ * segment directions computed once on construction, so that the arc length
+ * queries of trajectory.hpp are answered in O(1) and the longitudinal offset queries in O(log n).
+ * The results are the same as the ones of the functions with the same names in trajectory.hpp up
+ * to the rounding of the arc length sums.
+ * The points container is referred to and must outlive the view without being modified.
+ */
+template <class T>
+class IndexedTrajectory
+{
+public:
+  explicit IndexedTrajectory(const T & points) : points_(points)
+  {
+    const size_t num_points = points.size();
+    arc_lengths_.reserve(num_points);
+    segment_lengths_.reserve(num_points);
+    for (size_t i = 0; i < num_points; ++i) {
+      if (i == 0) {
+        arc_lengths_.push_back(0.0);
+        continue;
+      }
+      segment_lengths_.push_back(
+        tier4_autoware_utils::calcDistance2d(points.at(i - 1), points.at(i)));
+      arc_lengths_.push_back(arc_lengths_.back() + segment_lengths_.back());
+    }
+
+    // direction to the next point not overlapping with the segment start, as in
+    // removeOverlapPoints()
+    constexpr double eps = 1.0E-08;
+    segment_directions_.reserve(num_points);
+    for (size_t i = 0; i + 1 < num_points; ++i) {
+      const auto p_front = tier4_autoware_utils::getPoint(points.at(i));
+      boost::optional<Direction> direction;
+      for (size_t j = i + 1; j < num_points; ++j) {
+        const auto p_back = tier4_autoware_utils::getPoint(points.at(j));
+        if (tier4_autoware_utils::calcDistance2d(p_front, p_back) < eps) {
+          continue;
+        }
+        const double dx = p_back.x - p_front.x;
+        const double dy = p_back.y - p_front.y;
+        const double norm = std::hypot(dx, dy);
+        direction = Direction{dx / norm, dy / norm};
+        break;
+      }
+      segment_directions_.push_back(direction);
+    }
+  }
+
+  const T & points() const { return points_; }
+  size_t size() const { return points_.size(); }
+
+  /**
+   * @brief get arc length from the first point to the point of given index
+   */
+  double getArcLength(const size_t idx) const { return arc_lengths_.at(idx); }
+  const std::vector<double> & getArcLengths() const { return arc_lengths_; }
+
+  /**
+   * @brief get curvatures calculated by calcCurvature(), which are computed on the first call
+   * since they throw for too close points
+   */
+  const std::vector<double> & getCurvatures() const
+  {
+    if (!curvatures_) {
+      curvatures_ = 2 < points_.size() ? motion_utils::calcCurvature(points_)
+                                       : std::vector<double>(points_.size(), 0.0);
+    }
+    return *curvatures_;
+  }
+  double getCurvature(const size_t idx) const { return getCurvatures().at(idx); }
+
+  /**
+   * @brief find index of the segment containing the point at given arc length from the first
+   * point. Arc lengths out of the points are clamped to the first or last segment.
+   */
+  size_t findSegmentIndex(const double arc_length) const
+  {
+    validateNonEmpty(points_);
+    if (points_.size() == 1) {
+      return 0;
+    }
+    const auto itr = std::upper_bound(arc_lengths_.begin(), arc_lengths_.end(), arc_length);
+    const size_t idx = static_cast<size_t>(std::distance(arc_lengths_.begin(), itr));
+    return std::min(idx == 0 ? 0 : idx - 1, points_.size() - 2);
+  }
+
+  /**
+   * @brief same as calcLongitudinalOffsetToSegment()
+   */
+  double calcLongitudinalOffsetToSegment(
+    const size_t seg_idx, const geometry_msgs::msg::Point & p_target,
+    const bool throw_exception = false) const
+  {
+    if (points_.empty() || seg_idx >= points_.size() - 1) {
+      const std::out_of_range e("Segment index is invalid.");
+      if (throw_exception) {
+        throw e;
+      }
+      std::cerr << e.what() << std::endl;
+      return std::nan("");
+    }
+
+    const auto & direction = segment_directions_.at(seg_idx);
+    if (!direction) {
+      const std::runtime_error e("Same points are given.");
+      if (throw_exception) {
+        throw e;
+      }
+      std::cerr << e.what() << std::endl;
+      return std::nan("");
+    }
+
+    const auto p_front = tier4_autoware_utils::getPoint(points_.at(seg_idx));
+    return direction->x * (p_target.x - p_front.x) + direction->y * (p_target.y - p_front.y);
+  }
+
+  /**
+   * @brief same as calcSignedArcLength(points, src_idx, dst_idx)
+   */
+  double calcSignedArcLength(const size_t src_idx, const size_t dst_idx) const
+  {
+    if (points_.empty()) {
+      std::cerr << "Points is empty." << std::endl;
+      return 0.0;
+    }
+    return arc_lengths_.at(dst_idx) - arc_lengths_.at(src_idx);
+  }
+
+  /**
+   * @brief same as calcSignedArcLength(points, src_point, src_seg_idx, dst_idx)
+   */
+  double calcSignedArcLength(
+    const geometry_msgs::msg::Point & src_point, const size_t src_seg_idx,
+    const size_t dst_idx) const
+  {
+    validateNonEmpty(points_);
+    return calcSignedArcLength(src_seg_idx, dst_idx) -
+           calcLongitudinalOffsetToSegment(src_seg_idx, src_point);
+  }
+
+  /**
+   * @brief same as calcSignedArcLength(points, src_idx, dst_point, dst_seg_idx)
+   */
+  double calcSignedArcLength(
+    const size_t src_idx, const geometry_msgs::msg::Point & dst_point,
+    const size_t dst_seg_idx) const
+  {
+    validateNonEmpty(points_);
+    return calcSignedArcLength(src_idx, dst_seg_idx) +
+           calcLongitudinalOffsetToSegment(dst_seg_idx, dst_point);
+  }
+
+  /**
+   * @brief same as calcSignedArcLength(points, src_point, src_seg_idx, dst_point, dst_seg_idx)
+   */
+  double calcSignedArcLength(
+    const geometry_msgs::msg::Point & src_point, const size_t src_seg_idx,
+    const geometry_msgs::msg::Point & dst_point, const size_t dst_seg_idx) const
+  {
+    validateNonEmpty(points_);
+    return calcSignedArcLength(src_seg_idx, dst_seg_idx) -
+           calcLongitudinalOffsetToSegment(src_seg_idx, src_point) +
+           calcLongitudinalOffsetToSegment(dst_seg_idx, dst_point);
+  }
+
+  /**
+   * @brief same as calcSignedArcLength(points, src_point, dst_point). The nearest segments are
+   * still searched linearly.
+   */
+  double calcSignedArcLength(
+    const geometry_msgs::msg::Point & src_point, const geometry_msgs::msg::Point & dst_point) const
+  {
+    if (points_.empty()) {
+      std::cerr << "Points is empty." << std::endl;
+      return 0.0;
+    }
+    const size_t src_seg_idx = findNearestSegmentIndex(points_, src_point);
+    const size_t dst_seg_idx = findNearestSegmentIndex(points_, dst_point);
+    return calcSignedArcLength(src_point, src_seg_idx, dst_point, dst_seg_idx);
+  }
+
+  /**
+   * @brief same as calcArcLength(points)
+   */
+  double calcArcLength() const
+  {
+    if (points_.empty()) {
+      std::cerr << "Points is empty." << std::endl;
+      return 0.0;
+    }
+    return arc_lengths_.back();
+  }
+
+  /**
+   * @brief same as calcDistanceToForwardStopPoint(points_with_twist, src_idx)
+   */
+  boost::optional<double> calcDistanceToForwardStopPoint(const size_t src_idx = 0) const
+  {
+    if (points_.empty()) {
+      std::cerr << "Points is empty." << std::endl;
+      return {};
+    }
+
+    const auto closest_stop_idx = searchZeroVelocityIndex(points_, src_idx, points_.size());
+    if (!closest_stop_idx) {
+      return boost::none;
+    }
+
+    return std::max(0.0, calcSignedArcLength(src_idx, *closest_stop_idx));
+  }
+
+  /**
+   * @brief same as calcDistanceToForwardStopPoint(points_with_twist, pose, max_dist, max_yaw).
+   * The nearest segment is still searched linearly.
+   */
+  boost::optional<double> calcDistanceToForwardStopPoint(
+    const geometry_msgs::msg::Pose & pose,
+    const double max_dist = std::numeric_limits<double>::max(),
+    const double max_yaw = std::numeric_limits<double>::max()) const
+  {
+    if (points_.empty()) {
+      std::cerr << "Points is empty." << std::endl;
+      return {};
+    }
+
+    const auto nearest_segment_idx = findNearestSegmentIndex(points_, pose, max_dist, max_yaw);
+    if (!nearest_segment_idx) {
+      return boost::none;
+    }
+
+    const auto stop_idx =
+      searchZeroVelocityIndex(points_, *nearest_segment_idx + 1, points_.size());
+    if (!stop_idx) {
+      return boost::none;
+    }
+
+    const auto closest_stop_dist =
+      calcSignedArcLength(pose.position, *nearest_segment_idx, *stop_idx);
+
+    return std::max(0.0, closest_stop_dist);
+  }
+
+  /**
+   * @brief same as calcLongitudinalOffsetPoint(points, src_idx, offset)
+   */
+  boost::optional<geometry_msgs::msg::Point> calcLongitudinalOffsetPoint(
+    const size_t src_idx, const double offset, const bool throw_exception = false) const
+  {
+    if (!validateOffsetSource(src_idx, throw_exception)) {
+      return {};
+    }
+
+    if (src_idx + 1 == points_.size() && offset == 0.0) {
+      return tier4_autoware_utils::getPoint(points_.at(src_idx));
+    }
+
+    const auto offset_segment = findOffsetSegment(src_idx, offset);
+    if (!offset_segment) {
+      return {};
+    }
+
+    // interpolate from the end of the segment farther from the source point
+    const auto & [seg_idx, ratio] = *offset_segment;
+    if (offset < 0.0) {
+      return tier4_autoware_utils::calcInterpolatedPoint(
+        points_.at(seg_idx), points_.at(seg_idx + 1), ratio);
+    }
+    return tier4_autoware_utils::calcInterpolatedPoint(
+      points_.at(seg_idx + 1), points_.at(seg_idx), ratio);
+  }
+
+  /**
+   * @brief same as calcLongitudinalOffsetPoint(points, src_point, offset)
+   */
+  boost::optional<geometry_msgs::msg::Point> calcLongitudinalOffsetPoint(
+    const geometry_msgs::msg::Point & src_point, const double offset) const
+  {
+    if (points_.empty()) {
+      std::cerr << "Points is empty." << std::endl;
+      return {};
+    }
+
+    const size_t src_seg_idx = findNearestSegmentIndex(points_, src_point);
+    const double signed_length_src_offset =
+      calcLongitudinalOffsetToSegment(src_seg_idx, src_point);
+
+    return calcLongitudinalOffsetPoint(src_seg_idx, offset + signed_length_src_offset);
+  }
+
+  /**
+   * @brief same as calcLongitudinalOffsetPose(points, src_idx, offset)
+   */
+  boost::optional<geometry_msgs::msg::Pose> calcLongitudinalOffsetPose(
+    const size_t src_idx, const double offset,
+    const bool set_orientation_from_position_direction = true,
+    const bool throw_exception = false) const
+  {
+    if (!validateOffsetSource(src_idx, throw_exception)) {
+      return {};
+    }
+
+    if (src_idx + 1 == points_.size() && offset == 0.0) {
+      return tier4_autoware_utils::getPose(points_.at(src_idx));
+    }
+
+    const auto offset_segment = findOffsetSegment(src_idx, offset);
+    if (!offset_segment) {
+      return {};
+    }
+
+    const auto & [seg_idx, ratio] = *offset_segment;
+    return tier4_autoware_utils::calcInterpolatedPose(
+      points_.at(seg_idx), points_.at(seg_idx + 1), offset < 0.0 ? ratio : 1.0 - ratio,
+      set_orientation_from_position_direction);
+  }
+
+  /**
+   * @brief same as calcLongitudinalOffsetPose(points, src_point, offset)
+   */
+  boost::optional<geometry_msgs::msg::Pose> calcLongitudinalOffsetPose(
+    const geometry_msgs::msg::Point & src_point, const double offset,
+    const bool set_orientation_from_position_direction = true) const
+  {
+    if (points_.empty()) {
+      std::cerr << "Points is empty." << std::endl;
+      return {};
+    }
+
+    const size_t src_seg_idx = findNearestSegmentIndex(points_, src_point);
+    const double signed_length_src_offset =
+      calcLongitudinalOffsetToSegment(src_seg_idx, src_point);
+
+    return calcLongitudinalOffsetPose(
+      src_seg_idx, offset + signed_length_src_offset, set_orientation_from_position_direction);
+  }
+
+private:
+  struct Direction
+  {
+    double x;
+    double y;
+  };
+
+  struct OffsetSegment
+  {
+    size_t seg_idx;
+    double ratio;  // ratio of the offset point on the segment from its end farther from source
+  };
+
+  bool validateOffsetSource(const size_t src_idx, const bool throw_exception) const
+  {
+    if (points_.empty()) {
+      std::cerr << "Points is empty." << std::endl;
+      return false;
+    }
+
+    if (points_.size() - 1 < src_idx) {
+      const auto e = std::out_of_range("Invalid source index");
+      if (throw_exception) {
+        throw e;
+      }
+      std::cerr << e.what() << std::endl;
+      return false;
+    }
+
+    return points_.size() != 1;
+  }
+
+  /**
+   * @brief find the segment where the point offset from the source point is, searching forward if
+   * offset is positive and backward otherwise
+   * @return segment index and the ratio of the offset point on it
+   */
+  boost::optional<OffsetSegment> findOffsetSegment(const size_t src_idx, const double offset) const
+  {
+    const double src_arc_length = arc_lengths_.at(src_idx);
+
+    if (offset < 0.0) {
+      // last point before the source point whose distance to it is not less than the offset
+      const auto itr = std::partition_point(
+        arc_lengths_.begin(), arc_lengths_.begin() + src_idx,
+        [&](const double s) { return -offset <= src_arc_length - s; });
+      if (itr == arc_lengths_.begin()) {
+        return {};
+      }
+      const size_t seg_idx = static_cast<size_t>(std::distance(arc_lengths_.begin(), itr)) - 1;
+      const double dist_res = -offset - (src_arc_length - arc_lengths_.at(seg_idx));
+      return OffsetSegment{seg_idx, std::abs(dist_res / segment_lengths_.at(seg_idx))};
+    }
+
+    // first point after the source point whose distance to it is not less than the offset
+    const auto itr = std::partition_point(
+      arc_lengths_.begin() + src_idx + 1, arc_lengths_.end(),
+      [&](const double s) { return s - src_arc_length < offset; });
+    if (itr == arc_lengths_.end()) {
+      return {};
+    }
+    const size_t seg_idx = static_cast<size_t>(std::distance(arc_lengths_.begin(), itr)) - 1;
+    const double dist_res = offset - (arc_lengths_.at(seg_idx + 1) - src_arc_length);
+    return OffsetSegment{seg_idx, std::abs(dist_res / segment_lengths_.at(seg_idx))};
+  }
+
+  const T & points_;
+  std::vector<double> arc_lengths_;
+  std::vector<double> segment_lengths_;
+  std::vector<boost::optional<Direction>> segment_directions_;
+  mutable boost::optional<std::vector<double>> curvatures_;
+};
+}  // namespace motion_utils
+
+#endif  // MOTION_UTILS__TRAJECTORY__INDEXED_TRAJECTORY_HPP_
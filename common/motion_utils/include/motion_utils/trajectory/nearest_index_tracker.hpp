@@ -0,0 +1,320 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MOTION_UTILS__TRAJECTORY__NEAREST_INDEX_TRACKER_HPP_
+#define MOTION_UTILS__TRAJECTORY__NEAREST_INDEX_TRACKER_HPP_
+
+#include "motion_utils/trajectory/trajectory.hpp"
+#include "tier4_autoware_utils/geometry/geometry.hpp"
+#include "tier4_autoware_utils/geometry/pose_deviation.hpp"
+
+#include <boost/optional.hpp>
+
+#include <builtin_interfaces/msg/time.hpp>
+#include <geometry_msgs/msg/point.hpp>
+#include <geometry_msgs/msg/pose.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace motion_utils
+{
+
+/**
+ * @brief nearest index search which remembers its last result for a trajectory.
+ * A trajectory is identified by its stamp and its size. While the same trajectory is given, the
+ * search starts from the last nearest index and only looks at the points within search_window
+ * from it. When the nearest point in the window is on the border of the window, or no point in
+ * the window satisfies the constraints, the whole trajectory is searched as in findNearestIndex().
+ * Therefore the result is the nearest point around the last one, which is the same as the one of
+ * findNearestIndex() unless the trajectory comes back to the given point from far away.
+ * The queries with soft constraints are not warm started since they look for the first nearest
+ * point from the beginning of the trajectory, but the result for the same pose is reused.
+ */
+class NearestIndexTracker
+{
+public:
+  explicit NearestIndexTracker(const size_t search_window = 10) : search_window_(search_window) {}
+
+  /**
+   * @brief forget the last results
+   */
+  void reset()
+  {
+    stamp_ = boost::none;
+    size_ = 0;
+    last_nearest_idx_ = boost::none;
+    soft_constraints_query_ = boost::none;
+  }
+
+  /**
+   * @brief find nearest point index for a given point, starting from the last nearest index
+   * @param points points of trajectory, path, ...
+   * @param stamp stamp of the trajectory used with the size of points to identify it
+   * @param point given point
+   * @return index of nearest point
+   */
+  template <class T>
+  size_t findNearestIndex(
+    const T & points, const builtin_interfaces::msg::Time & stamp,
+    const geometry_msgs::msg::Point & point)
+  {
+    validateNonEmpty(points);
+    updateTrajectory(stamp, points.size());
+
+    if (last_nearest_idx_) {
+      const auto nearest_idx = findNearestIndexInWindow(
+        points, *last_nearest_idx_, [&](const size_t i) {
+          return boost::optional<double>(
+            tier4_autoware_utils::calcSquaredDistance2d(points.at(i), point));
+        });
+      if (nearest_idx) {
+        last_nearest_idx_ = *nearest_idx;
+        return *nearest_idx;
+      }
+    }
+
+    const size_t nearest_idx = motion_utils::findNearestIndex(points, point);
+    last_nearest_idx_ = nearest_idx;
+    return nearest_idx;
+  }
+
+  /**
+   * @brief find nearest point index for a given pose, starting from the last nearest index
+   * @param points points of trajectory, path, ...
+   * @param stamp stamp of the trajectory used with the size of points to identify it
+   * @param pose given pose
+   * @param max_dist max distance used to get squared distance for finding the nearest point to
+   * given pose
+   * @param max_yaw max yaw used for finding nearest point to given pose
+   * @return index of nearest point (index or none if not found)
+   */
+  template <class T>
+  boost::optional<size_t> findNearestIndex(
+    const T & points, const builtin_interfaces::msg::Time & stamp,
+    const geometry_msgs::msg::Pose & pose,
+    const double max_dist = std::numeric_limits<double>::max(),
+    const double max_yaw = std::numeric_limits<double>::max())
+  {
+    if (points.empty()) {
+      return motion_utils::findNearestIndex(points, pose, max_dist, max_yaw);
+    }
+    updateTrajectory(stamp, points.size());
+
+    if (last_nearest_idx_) {
+      const double max_squared_dist = max_dist * max_dist;
+      const auto nearest_idx = findNearestIndexInWindow(
+        points, *last_nearest_idx_, [&](const size_t i) -> boost::optional<double> {
+          const auto squared_dist = tier4_autoware_utils::calcSquaredDistance2d(points.at(i), pose);
+          if (squared_dist > max_squared_dist) {
+            return boost::none;
+          }
+          const auto yaw = tier4_autoware_utils::calcYawDeviation(
+            tier4_autoware_utils::getPose(points.at(i)), pose);
+          if (std::fabs(yaw) > max_yaw) {
+            return boost::none;
+          }
+          return squared_dist;
+        });
+      if (nearest_idx) {
+        last_nearest_idx_ = *nearest_idx;
+        return *nearest_idx;
+      }
+    }
+
+    const auto nearest_idx = motion_utils::findNearestIndex(points, pose, max_dist, max_yaw);
+    if (nearest_idx) {
+      last_nearest_idx_ = *nearest_idx;
+    }
+    return nearest_idx;
+  }
+
+  /**
+   * @brief find nearest segment index to point, starting from the last nearest index
+   * @param points points of trajectory, path, ...
+   * @param stamp stamp of the trajectory used with the size of points to identify it
+   * @param point point to which to find nearest segment index
+   * @return nearest segment index
+   */
+  template <class T>
+  size_t findNearestSegmentIndex(
+    const T & points, const builtin_interfaces::msg::Time & stamp,
+    const geometry_msgs::msg::Point & point)
+  {
+    const size_t nearest_idx = findNearestIndex(points, stamp, point);
+    return toSegmentIndex(points, nearest_idx, point);
+  }
+
+  /**
+   * @brief find nearest segment index to pose, starting from the last nearest index
+   * @param points points of trajectory, path, ...
+   * @param stamp stamp of the trajectory used with the size of points to identify it
+   * @param pose pose to which to find nearest segment index
+   * @param max_dist max distance used for finding the nearest index to given pose
+   * @param max_yaw max yaw used for finding nearest index to given pose
+   * @return nearest segment index
+   */
+  template <class T>
+  boost::optional<size_t> findNearestSegmentIndex(
+    const T & points, const builtin_interfaces::msg::Time & stamp,
+    const geometry_msgs::msg::Pose & pose,
+    const double max_dist = std::numeric_limits<double>::max(),
+    const double max_yaw = std::numeric_limits<double>::max())
+  {
+    const auto nearest_idx = findNearestIndex(points, stamp, pose, max_dist, max_yaw);
+    if (!nearest_idx) {
+      return boost::none;
+    }
+    return toSegmentIndex(points, *nearest_idx, pose.position);
+  }
+
+  /**
+   * @brief find first nearest point index for a given pose with soft constraints. The result is
+   * reused while the same trajectory, pose and thresholds are given.
+   * @param points points of trajectory, path, ...
+   * @param stamp stamp of the trajectory used with the size of points to identify it
+   * @param pose given pose
+   * @param dist_threshold distance threshold used for searching for first nearest index to given
+   * pose
+   * @param yaw_threshold yaw threshold used for searching for first nearest index to given pose
+   * @return index of nearest point
+   */
+  template <class T>
+  size_t findFirstNearestIndexWithSoftConstraints(
+    const T & points, const builtin_interfaces::msg::Time & stamp,
+    const geometry_msgs::msg::Pose & pose,
+    const double dist_threshold = std::numeric_limits<double>::max(),
+    const double yaw_threshold = std::numeric_limits<double>::max())
+  {
+    validateNonEmpty(points);
+    updateTrajectory(stamp, points.size());
+
+    if (
+      soft_constraints_query_ && soft_constraints_query_->pose == pose &&
+      soft_constraints_query_->dist_threshold == dist_threshold &&
+      soft_constraints_query_->yaw_threshold == yaw_threshold) {
+      return soft_constraints_query_->nearest_idx;
+    }
+
+    const size_t nearest_idx = motion_utils::findFirstNearestIndexWithSoftConstraints(
+      points, pose, dist_threshold, yaw_threshold);
+    soft_constraints_query_ =
+      SoftConstraintsQuery{pose, dist_threshold, yaw_threshold, nearest_idx};
+    return nearest_idx;
+  }
+
+  /**
+   * @brief find nearest point indices for many points against one trajectory. Each search starts
+   * from the result for the previous point, so the points should be ordered along the trajectory.
+   * @param points points of trajectory, path, ...
+   * @param stamp stamp of the trajectory used with the size of points to identify it
+   * @param target_points given points
+   * @return indices of nearest points for target_points
+   */
+  template <class T>
+  std::vector<size_t> findNearestIndices(
+    const T & points, const builtin_interfaces::msg::Time & stamp,
+    const std::vector<geometry_msgs::msg::Point> & target_points)
+  {
+    std::vector<size_t> nearest_indices;
+    nearest_indices.reserve(target_points.size());
+    for (const auto & target_point : target_points) {
+      nearest_indices.push_back(findNearestIndex(points, stamp, target_point));
+    }
+    return nearest_indices;
+  }
+
+private:
+  struct SoftConstraintsQuery
+  {
+    geometry_msgs::msg::Pose pose;
+    double dist_threshold;
+    double yaw_threshold;
+    size_t nearest_idx;
+  };
+
+  void updateTrajectory(const builtin_interfaces::msg::Time & stamp, const size_t size)
+  {
+    if (stamp_ && *stamp_ == stamp && size_ == size) {
+      return;
+    }
+    reset();
+    stamp_ = stamp;
+    size_ = size;
+  }
+
+  /**
+   * @brief find the point with the minimum squared distance around center_idx
+   * @param calc_squared_dist squared distance of a point, or none if it does not satisfy the
+   * constraints
+   * @return index of the nearest point, or none if it may be out of the window
+   */
+  template <class T, class F>
+  boost::optional<size_t> findNearestIndexInWindow(
+    const T & points, const size_t center_idx, const F & calc_squared_dist) const
+  {
+    const size_t front_idx = center_idx < search_window_ ? 0 : center_idx - search_window_;
+    const size_t back_idx = std::min(center_idx + search_window_, points.size() - 1);
+
+    double min_squared_dist = std::numeric_limits<double>::max();
+    boost::optional<size_t> min_idx;
+    for (size_t i = front_idx; i <= back_idx; ++i) {
+      const auto squared_dist = calc_squared_dist(i);
+      if (squared_dist && *squared_dist < min_squared_dist) {
+        min_squared_dist = *squared_dist;
+        min_idx = i;
+      }
+    }
+
+    // the nearest point may be further ahead or behind the window
+    if (!min_idx || (*min_idx == front_idx && front_idx != 0)) {
+      return boost::none;
+    }
+    if (*min_idx == back_idx && back_idx != points.size() - 1) {
+      return boost::none;
+    }
+    return min_idx;
+  }
+
+  template <class T>
+  static size_t toSegmentIndex(
+    const T & points, const size_t nearest_idx, const geometry_msgs::msg::Point & point)
+  {
+    if (nearest_idx == 0) {
+      return 0;
+    }
+    if (nearest_idx == points.size() - 1) {
+      return points.size() - 2;
+    }
+
+    const double signed_length = calcLongitudinalOffsetToSegment(points, nearest_idx, point);
+
+    if (signed_length <= 0) {
+      return nearest_idx - 1;
+    }
+
+    return nearest_idx;
+  }
+
+  size_t search_window_;
+  boost::optional<builtin_interfaces::msg::Time> stamp_;
+  size_t size_{0};
+  boost::optional<size_t> last_nearest_idx_;
+  boost::optional<SoftConstraintsQuery> soft_constraints_query_;
+};
+}  // namespace motion_utils
+
+#endif  // MOTION_UTILS__TRAJECTORY__NEAREST_INDEX_TRACKER_HPP_
@@ -290,6 +290,75 @@ boost::optional<size_t> findNearestIndex(
   return is_nearest_found ? boost::optional<size_t>(min_idx) : boost::none;
 }
 
+/**
+ * @brief find nearest point index for a given pose, starting from the nearest index of the last
+ * search. The points within search_window_length along the points from hint_idx are searched
+ * first, and the result is used when the points are farther than max_dist from the pose at both
+ * ends of the window. Otherwise, or when no point in the window satisfies the thresholds, the
+ * whole points are searched as in findNearestIndex().
+ * Note that the result is the nearest point around hint_idx. When the points come back close to
+ * the pose from outside of the window, e.g. on a loop, a nearer point there is not returned, so
+ * the result can differ from the one of findNearestIndex().
+ * @param points points of trajectory, path, ...
+ * @param arc_lengths arc length from the first point to each point of points
+ * @param pose given pose
+ * @param hint_idx nearest index of the last search, or none to search the whole points
+ * @param search_window_length length along the points before and after hint_idx searched first
+ * @param max_dist max distance used to get squared distance for finding the nearest point to given
+ * pose
+ * @param max_yaw max yaw used for finding nearest point to given pose
+ * @return index of nearest point (index or none if not found)
+ */
+template <class T>
+boost::optional<size_t> findNearestIndexWithHint(
+  const T & points, const std::vector<double> & arc_lengths, const geometry_msgs::msg::Pose & pose,
+  const boost::optional<size_t> & hint_idx, const double search_window_length,
+  const double max_dist, const double max_yaw)
+{
+  if (!hint_idx || *hint_idx >= points.size() || arc_lengths.size() != points.size()) {
+    return findNearestIndex(points, pose, max_dist, max_yaw);
+  }
+
+  const double max_squared_dist = max_dist * max_dist;
+  const double hint_arc_length = arc_lengths.at(*hint_idx);
+  const size_t start_idx = std::distance(
+    arc_lengths.begin(), std::lower_bound(
+                           arc_lengths.begin(), arc_lengths.end(),
+                           hint_arc_length - search_window_length));
+  const size_t end_idx = std::distance(
+    arc_lengths.begin(), std::upper_bound(
+                           arc_lengths.begin(), arc_lengths.end(),
+                           hint_arc_length + search_window_length));
+
+  const auto is_out_of_distance = [&](const size_t idx) {
+    return tier4_autoware_utils::calcSquaredDistance2d(points.at(idx), pose) > max_squared_dist;
+  };
+  if (
+    (start_idx != 0 && !is_out_of_distance(start_idx)) ||
+    (end_idx != points.size() && !is_out_of_distance(end_idx - 1))) {
+    return findNearestIndex(points, pose, max_dist, max_yaw);
+  }
+
+  double min_squared_dist = std::numeric_limits<double>::max();
+  boost::optional<size_t> min_idx;
+  for (size_t i = start_idx; i < end_idx; ++i) {
+    const auto squared_dist = tier4_autoware_utils::calcSquaredDistance2d(points.at(i), pose);
+    if (squared_dist > max_squared_dist || squared_dist >= min_squared_dist) {
+      continue;
+    }
+
+    const auto yaw =
+      tier4_autoware_utils::calcYawDeviation(tier4_autoware_utils::getPose(points.at(i)), pose);
+    if (std::fabs(yaw) > max_yaw) {
+      continue;
+    }
+
+    min_squared_dist = squared_dist;
+    min_idx = i;
+  }
+  return min_idx ? min_idx : findNearestIndex(points, pose, max_dist, max_yaw);
+}
+
 /**
  * @brief calculate longitudinal offset (length along trajectory from seg_idx point to nearest point
  * to p_target on trajectory). If seg_idx point is after that nearest point, length is negative.
@@ -17,71 +17,135 @@
 #include "motion_utils/resample/resample_utils.hpp"
 #include "tier4_autoware_utils/geometry/geometry.hpp"
 
-namespace motion_utils
+namespace
 {
-std::vector<geometry_msgs::msg::Point> resamplePointVector(
-  const std::vector<geometry_msgs::msg::Point> & points,
-  const std::vector<double> & resampled_arclength, const bool use_akima_spline_for_xy,
-  const bool use_lerp_for_z)
+template <class T>
+std::vector<double> calcInputArcLength(const T & points)
 {
-  // validate arguments
-  if (!resample_utils::validate_arguments(points, resampled_arclength)) {
-    return points;
-  }
-
-  // Input Path Information
   std::vector<double> input_arclength;
-  std::vector<double> x;
-  std::vector<double> y;
-  std::vector<double> z;
   input_arclength.reserve(points.size());
-  x.reserve(points.size());
-  y.reserve(points.size());
-  z.reserve(points.size());
-
   input_arclength.push_back(0.0);
-  x.push_back(points.front().x);
-  y.push_back(points.front().y);
-  z.push_back(points.front().z);
   for (size_t i = 1; i < points.size(); ++i) {
-    const auto & prev_pt = points.at(i - 1);
-    const auto & curr_pt = points.at(i);
-    const double ds = tier4_autoware_utils::calcDistance2d(prev_pt, curr_pt);
+    const double ds = tier4_autoware_utils::calcDistance2d(points.at(i - 1), points.at(i));
     input_arclength.push_back(ds + input_arclength.back());
-    x.push_back(curr_pt.x);
-    y.push_back(curr_pt.y);
-    z.push_back(curr_pt.z);
+  }
+  return input_arclength;
+}
+
+// NOTE: lerp_segments are the ones of resampled_arclength on input_arclength, which are shared with
+//       the other fields. They are not used when neither xy nor z is linearly interpolated.
+template <class T>
+std::vector<geometry_msgs::msg::Point> interpolatePositions(
+  const T & points, const std::vector<double> & input_arclength,
+  const std::vector<double> & resampled_arclength,
+  const std::vector<interpolation::LerpSegment> & lerp_segments,
+  const bool use_akima_spline_for_xy, const bool use_lerp_for_z)
+{
+  std::vector<geometry_msgs::msg::Point> resampled_points(resampled_arclength.size());
+
+  // Interpolate linearly in one pass over the shared segments
+  if (use_akima_spline_for_xy || use_lerp_for_z) {
+    for (size_t i = 0; i < resampled_points.size(); ++i) {
+      const auto & segment = lerp_segments.at(i);
+      const auto prev_pt = tier4_autoware_utils::getPoint(points.at(segment.index));
+      const auto next_pt = tier4_autoware_utils::getPoint(points.at(segment.index + 1));
+      auto & resampled_pt = resampled_points.at(i);
+      if (use_akima_spline_for_xy) {
+        resampled_pt.x = interpolation::lerp(prev_pt.x, next_pt.x, segment.ratio);
+        resampled_pt.y = interpolation::lerp(prev_pt.y, next_pt.y, segment.ratio);
+      }
+      if (use_lerp_for_z) {
+        resampled_pt.z = interpolation::lerp(prev_pt.z, next_pt.z, segment.ratio);
+      }
+    }
+  }
+
+  // Interpolate by spline
+  if (!use_akima_spline_for_xy) {
+    std::vector<double> x(points.size());
+    std::vector<double> y(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+      const auto pt = tier4_autoware_utils::getPoint(points.at(i));
+      x.at(i) = pt.x;
+      y.at(i) = pt.y;
+    }
+    const auto interpolated_x =
+      interpolation::splineByAkima(input_arclength, x, resampled_arclength);
+    const auto interpolated_y =
+      interpolation::splineByAkima(input_arclength, y, resampled_arclength);
+    for (size_t i = 0; i < resampled_points.size(); ++i) {
+      resampled_points.at(i).x = interpolated_x.at(i);
+      resampled_points.at(i).y = interpolated_y.at(i);
+    }
+  }
+  if (!use_lerp_for_z) {
+    std::vector<double> z(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+      z.at(i) = tier4_autoware_utils::getPoint(points.at(i)).z;
+    }
+    const auto interpolated_z = interpolation::spline(input_arclength, z, resampled_arclength);
+    for (size_t i = 0; i < resampled_points.size(); ++i) {
+      resampled_points.at(i).z = interpolated_z.at(i);
+    }
   }
 
-  // Interpolate
-  const auto lerp = [&](const auto & input) {
-    return interpolation::lerp(input_arclength, input, resampled_arclength);
-  };
-  const auto spline = [&](const auto & input) {
-    return interpolation::spline(input_arclength, input, resampled_arclength);
-  };
-  const auto spline_by_akima = [&](const auto & input) {
-    return interpolation::splineByAkima(input_arclength, input, resampled_arclength);
-  };
+  return resampled_points;
+}
 
-  const auto interpolated_x = use_akima_spline_for_xy ? lerp(x) : spline_by_akima(x);
-  const auto interpolated_y = use_akima_spline_for_xy ? lerp(y) : spline_by_akima(y);
-  const auto interpolated_z = use_lerp_for_z ? lerp(z) : spline(z);
+template <class T>
+std::vector<geometry_msgs::msg::Pose> interpolatePoses(
+  const T & points, const std::vector<double> & input_arclength,
+  const std::vector<double> & resampled_arclength,
+  const std::vector<interpolation::LerpSegment> & lerp_segments,
+  const bool use_akima_spline_for_xy, const bool use_lerp_for_z)
+{
+  const auto resampled_position = interpolatePositions(
+    points, input_arclength, resampled_arclength, lerp_segments, use_akima_spline_for_xy,
+    use_lerp_for_z);
 
-  std::vector<geometry_msgs::msg::Point> resampled_points;
-  resampled_points.resize(interpolated_x.size());
+  std::vector<geometry_msgs::msg::Pose> resampled_points(resampled_position.size());
 
   // Insert Position
-  for (size_t i = 0; i < resampled_points.size(); ++i) {
-    geometry_msgs::msg::Point point;
-    point.x = interpolated_x.at(i);
-    point.y = interpolated_y.at(i);
-    point.z = interpolated_z.at(i);
-    resampled_points.at(i) = point;
+  for (size_t i = 0; i < resampled_position.size(); ++i) {
+    resampled_points.at(i).position = resampled_position.at(i);
+  }
+
+  const bool is_driving_forward =
+    tier4_autoware_utils::isDrivingForward(points.at(0), points.at(1));
+  motion_utils::insertOrientation(resampled_points, is_driving_forward);
+
+  // Initial orientation is depend on the initial value of the resampled_arclength
+  // when backward driving
+  if (!is_driving_forward && resampled_arclength.front() < 1e-3) {
+    resampled_points.at(0).orientation = tier4_autoware_utils::getPose(points.at(0)).orientation;
   }
 
   return resampled_points;
 }
+}  // namespace
+
+namespace motion_utils
+{
+std::vector<geometry_msgs::msg::Point> resamplePointVector(
+  const std::vector<geometry_msgs::msg::Point> & points,
+  const std::vector<double> & resampled_arclength, const bool use_akima_spline_for_xy,
+  const bool use_lerp_for_z)
+{
+  // validate arguments
+  if (!resample_utils::validate_arguments(points, resampled_arclength)) {
+    return points;
+  }
+
+  const auto input_arclength = calcInputArcLength(points);
+  const auto lerp_segments =
+    use_akima_spline_for_xy || use_lerp_for_z
+      ? interpolation::calcLerpSegments(input_arclength, resampled_arclength)
+      : std::vector<interpolation::LerpSegment>{};
+
+  return interpolatePositions(
+    points, input_arclength, resampled_arclength, lerp_segments, use_akima_spline_for_xy,
+    use_lerp_for_z);
+}
 
 std::vector<geometry_msgs::msg::Point> resamplePointVector(
   const std::vector<geometry_msgs::msg::Point> & points, const double resample_interval,
@@ -118,35 +182,15 @@ std::vector<geometry_msgs::msg::Pose> resamplePoseVector(
     return points;
   }
 
-  std::vector<geometry_msgs::msg::Point> position(points.size());
-  for (size_t i = 0; i < points.size(); ++i) {
-    position.at(i) = points.at(i).position;
-  }
-  const auto resampled_position =
-    resamplePointVector(position, resampled_arclength, use_akima_spline_for_xy, use_lerp_for_z);
-
-  std::vector<geometry_msgs::msg::Pose> resampled_points(resampled_position.size());
-
-  // Insert Position
-  for (size_t i = 0; i < resampled_position.size(); ++i) {
-    geometry_msgs::msg::Pose pose;
-    pose.position.x = resampled_position.at(i).x;
-    pose.position.y = resampled_position.at(i).y;
-    pose.position.z = resampled_position.at(i).z;
-    resampled_points.at(i) = pose;
-  }
-
-  const bool is_driving_forward =
-    tier4_autoware_utils::isDrivingForward(points.at(0), points.at(1));
-  motion_utils::insertOrientation(resampled_points, is_driving_forward);
+  const auto input_arclength = calcInputArcLength(points);
+  const auto lerp_segments =
+    use_akima_spline_for_xy || use_lerp_for_z
+      ? interpolation::calcLerpSegments(input_arclength, resampled_arclength)
+      : std::vector<interpolation::LerpSegment>{};
 
-  // Initial orientation is depend on the initial value of the resampled_arclength
-  // when backward driving
-  if (!is_driving_forward && resampled_arclength.front() < 1e-3) {
-    resampled_points.at(0).orientation = points.at(0).orientation;
-  }
-
-  return resampled_points;
+  return interpolatePoses(
+    points, input_arclength, resampled_arclength, lerp_segments, use_akima_spline_for_xy,
+    use_lerp_for_z);
 }
 
 std::vector<geometry_msgs::msg::Pose> resamplePoseVector(
@@ -197,41 +241,7 @@ autoware_auto_planning_msgs::msg::PathWithLaneId resamplePath(
   // resampled[6] = base[2]
 
   // Input Path Information
-  std::vector<double> input_arclength;
-  std::vector<geometry_msgs::msg::Pose> input_pose;
-  std::vector<double> v_lon;
-  std::vector<double> v_lat;
-  std::vector<double> heading_rate;
-  std::vector<bool> is_final;
-  std::vector<std::vector<int64_t>> lane_ids;
-  input_arclength.reserve(input_path.points.size());
-  input_pose.reserve(input_path.points.size());
-  v_lon.reserve(input_path.points.size());
-  v_lat.reserve(input_path.points.size());
-  heading_rate.reserve(input_path.points.size());
-  is_final.reserve(input_path.points.size());
-  lane_ids.reserve(input_path.points.size());
-
-  input_arclength.push_back(0.0);
-  input_pose.push_back(input_path.points.front().point.pose);
-  v_lon.push_back(input_path.points.front().point.longitudinal_velocity_mps);
-  v_lat.push_back(input_path.points.front().point.lateral_velocity_mps);
-  heading_rate.push_back(input_path.points.front().point.heading_rate_rps);
-  is_final.push_back(input_path.points.front().point.is_final);
-  lane_ids.push_back(input_path.points.front().lane_ids);
-  for (size_t i = 1; i < input_path.points.size(); ++i) {
-    const auto & prev_pt = input_path.points.at(i - 1).point;
-    const auto & curr_pt = input_path.points.at(i).point;
-    const double ds =
-      tier4_autoware_utils::calcDistance2d(prev_pt.pose.position, curr_pt.pose.position);
-    input_arclength.push_back(ds + input_arclength.back());
-    input_pose.push_back(curr_pt.pose);
-    v_lon.push_back(curr_pt.longitudinal_velocity_mps);
-    v_lat.push_back(curr_pt.lateral_velocity_mps);
-    heading_rate.push_back(curr_pt.heading_rate_rps);
-    is_final.push_back(curr_pt.is_final);
-    lane_ids.push_back(input_path.points.at(i).lane_ids);
-  }
+  const auto input_arclength = calcInputArcLength(input_path.points);
 
   if (input_arclength.back() < resampled_arclength.back()) {
     std::cerr << "[motion_utils]: resampled path length is longer than input path length"
@@ -239,31 +249,14 @@ autoware_auto_planning_msgs::msg::PathWithLaneId resamplePath(
     return input_path;
   }
 
-  // Interpolate
-  const auto lerp = [&](const auto & input) {
-    return interpolation::lerp(input_arclength, input, resampled_arclength);
-  };
-
-  auto closest_segment_indices =
+  // Find the segment of each resampled point once for all the fields
+  const auto lerp_segments = interpolation::calcLerpSegments(input_arclength, resampled_arclength);
+  const auto closest_segment_indices =
     interpolation::calc_closest_segment_indices(input_arclength, resampled_arclength);
 
-  const auto zoh = [&](const auto & input) {
-    return interpolation::zero_order_hold(input_arclength, input, closest_segment_indices);
-  };
-
-  const auto interpolated_pose =
-    resamplePoseVector(input_pose, resampled_arclength, use_akima_spline_for_xy, use_lerp_for_z);
-  const auto interpolated_v_lon = use_zero_order_hold_for_v ? zoh(v_lon) : lerp(v_lon);
-  const auto interpolated_v_lat = use_zero_order_hold_for_v ? zoh(v_lat) : lerp(v_lat);
-  const auto interpolated_heading_rate = lerp(heading_rate);
-  const auto interpolated_is_final = zoh(is_final);
-  const auto interpolated_lane_ids = zoh(lane_ids);
-
-  if (interpolated_pose.size() != resampled_arclength.size()) {
-    std::cerr << "[motion_utils]: Resampled pose size is different from resampled arclength"
-              << std::endl;
-    return input_path;
-  }
+  const auto interpolated_pose = interpolatePoses(
+    input_path.points, input_arclength, resampled_arclength, lerp_segments,
+    use_akima_spline_for_xy, use_lerp_for_z);
 
   autoware_auto_planning_msgs::msg::PathWithLaneId resampled_path;
   resampled_path.header = input_path.header;
@@ -271,14 +264,26 @@ autoware_auto_planning_msgs::msg::PathWithLaneId resamplePath(
   resampled_path.right_bound = input_path.right_bound;
   resampled_path.points.resize(interpolated_pose.size());
   for (size_t i = 0; i < resampled_path.points.size(); ++i) {
-    autoware_auto_planning_msgs::msg::PathPoint path_point;
+    const auto & segment = lerp_segments.at(i);
+    const auto & prev_pt = input_path.points.at(segment.index).point;
+    const auto & next_pt = input_path.points.at(segment.index + 1).point;
+    const auto & closest_pt = input_path.points.at(closest_segment_indices.at(i));
+    const auto lerp = [&](const double prev_val, const double next_val) {
+      return interpolation::lerp(prev_val, next_val, segment.ratio);
+    };
+
+    auto & path_point = resampled_path.points.at(i).point;
     path_point.pose = interpolated_pose.at(i);
-    path_point.longitudinal_velocity_mps = interpolated_v_lon.at(i);
-    path_point.lateral_velocity_mps = interpolated_v_lat.at(i);
-    path_point.heading_rate_rps = interpolated_heading_rate.at(i);
-    path_point.is_final = interpolated_is_final.at(i);
-    resampled_path.points.at(i).point = path_point;
-    resampled_path.points.at(i).lane_ids = interpolated_lane_ids.at(i);
+    path_point.longitudinal_velocity_mps =
+      use_zero_order_hold_for_v
+        ? closest_pt.point.longitudinal_velocity_mps
+        : lerp(prev_pt.longitudinal_velocity_mps, next_pt.longitudinal_velocity_mps);
+    path_point.lateral_velocity_mps =
+      use_zero_order_hold_for_v ? closest_pt.point.lateral_velocity_mps
+                                : lerp(prev_pt.lateral_velocity_mps, next_pt.lateral_velocity_mps);
+    path_point.heading_rate_rps = lerp(prev_pt.heading_rate_rps, next_pt.heading_rate_rps);
+    path_point.is_final = closest_pt.point.is_final;
+    resampled_path.points.at(i).lane_ids = closest_pt.lane_ids;
   }
 
   return resampled_path;
@@ -361,59 +366,19 @@ autoware_auto_planning_msgs::msg::Path resamplePath(
   }
 
   // Input Path Information
-  std::vector<double> input_arclength;
-  std::vector<geometry_msgs::msg::Pose> input_pose;
-  std::vector<double> v_lon;
-  std::vector<double> v_lat;
-  std::vector<double> heading_rate;
-  input_arclength.reserve(input_path.points.size());
-  input_pose.reserve(input_path.points.size());
-  v_lon.reserve(input_path.points.size());
-  v_lat.reserve(input_path.points.size());
-  heading_rate.reserve(input_path.points.size());
-
-  input_arclength.push_back(0.0);
-  input_pose.push_back(input_path.points.front().pose);
-  v_lon.push_back(input_path.points.front().longitudinal_velocity_mps);
-  v_lat.push_back(input_path.points.front().lateral_velocity_mps);
-  heading_rate.push_back(input_path.points.front().heading_rate_rps);
-  for (size_t i = 1; i < input_path.points.size(); ++i) {
-    const auto & prev_pt = input_path.points.at(i - 1);
-    const auto & curr_pt = input_path.points.at(i);
-    const double ds =
-      tier4_autoware_utils::calcDistance2d(prev_pt.pose.position, curr_pt.pose.position);
-    input_arclength.push_back(ds + input_arclength.back());
-    input_pose.push_back(curr_pt.pose);
-    v_lon.push_back(curr_pt.longitudinal_velocity_mps);
-    v_lat.push_back(curr_pt.lateral_velocity_mps);
-    heading_rate.push_back(curr_pt.heading_rate_rps);
-  }
-
-  // Interpolate
-  const auto lerp = [&](const auto & input) {
-    return interpolation::lerp(input_arclength, input, resampled_arclength);
-  };
+  const auto input_arclength = calcInputArcLength(input_path.points);
 
+  // Find the segment of each resampled point once for all the fields
+  const auto lerp_segments = interpolation::calcLerpSegments(input_arclength, resampled_arclength);
   std::vector<size_t> closest_segment_indices;
   if (use_zero_order_hold_for_v) {
     closest_segment_indices =
       interpolation::calc_closest_segment_indices(input_arclength, resampled_arclength);
   }
-  const auto zoh = [&](const auto & input) {
-    return interpolation::zero_order_hold(input_arclength, input, closest_segment_indices);
-  };
 
-  const auto interpolated_pose =
-    resamplePoseVector(input_pose, resampled_arclength, use_akima_spline_for_xy, use_lerp_for_z);
-  const auto interpolated_v_lon = use_zero_order_hold_for_v ? zoh(v_lon) : lerp(v_lon);
-  const auto interpolated_v_lat = use_zero_order_hold_for_v ? zoh(v_lat) : lerp(v_lat);
-  const auto interpolated_heading_rate = lerp(heading_rate);
-
-  if (interpolated_pose.size() != resampled_arclength.size()) {
-    std::cerr << "[motion_utils]: Resampled pose size is different from resampled arclength"
-              << std::endl;
-    return input_path;
-  }
+  const auto interpolated_pose = interpolatePoses(
+    input_path.points, input_arclength, resampled_arclength, lerp_segments,
+    use_akima_spline_for_xy, use_lerp_for_z);
 
   autoware_auto_planning_msgs::msg::Path resampled_path;
   resampled_path.header = input_path.header;
@@ -421,12 +386,26 @@ autoware_auto_planning_msgs::msg::Path resamplePath(
   resampled_path.right_bound = resampled_path.right_bound;
   resampled_path.points.resize(interpolated_pose.size());
   for (size_t i = 0; i < resampled_path.points.size(); ++i) {
-    autoware_auto_planning_msgs::msg::PathPoint path_point;
+    const auto & segment = lerp_segments.at(i);
+    const auto & prev_pt = input_path.points.at(segment.index);
+    const auto & next_pt = input_path.points.at(segment.index + 1);
+    const auto lerp = [&](const double prev_val, const double next_val) {
+      return interpolation::lerp(prev_val, next_val, segment.ratio);
+    };
+
+    auto & path_point = resampled_path.points.at(i);
     path_point.pose = interpolated_pose.at(i);
-    path_point.longitudinal_velocity_mps = interpolated_v_lon.at(i);
-    path_point.lateral_velocity_mps = interpolated_v_lat.at(i);
-    path_point.heading_rate_rps = interpolated_heading_rate.at(i);
-    resampled_path.points.at(i) = path_point;
+    if (use_zero_order_hold_for_v) {
+      const auto & closest_pt = input_path.points.at(closest_segment_indices.at(i));
+      path_point.longitudinal_velocity_mps = closest_pt.longitudinal_velocity_mps;
+      path_point.lateral_velocity_mps = closest_pt.lateral_velocity_mps;
+    } else {
+      path_point.longitudinal_velocity_mps =
+        lerp(prev_pt.longitudinal_velocity_mps, next_pt.longitudinal_velocity_mps);
+      path_point.lateral_velocity_mps =
+        lerp(prev_pt.lateral_velocity_mps, next_pt.lateral_velocity_mps);
+    }
+    path_point.heading_rate_rps = lerp(prev_pt.heading_rate_rps, next_pt.heading_rate_rps);
   }
 
   return resampled_path;
@@ -502,96 +481,53 @@ autoware_auto_planning_msgs::msg::Trajectory resampleTrajectory(
   }
 
   // Input Trajectory Information
-  std::vector<double> input_arclength;
-  std::vector<geometry_msgs::msg::Pose> input_pose;
-  std::vector<double> v_lon;
-  std::vector<double> v_lat;
-  std::vector<double> heading_rate;
-  std::vector<double> acceleration;
-  std::vector<double> front_wheel_angle;
-  std::vector<double> rear_wheel_angle;
-  std::vector<double> time_from_start;
-  input_arclength.reserve(input_trajectory.points.size());
-  input_pose.reserve(input_trajectory.points.size());
-  v_lon.reserve(input_trajectory.points.size());
-  v_lat.reserve(input_trajectory.points.size());
-  heading_rate.reserve(input_trajectory.points.size());
-  acceleration.reserve(input_trajectory.points.size());
-  front_wheel_angle.reserve(input_trajectory.points.size());
-  rear_wheel_angle.reserve(input_trajectory.points.size());
-  time_from_start.reserve(input_trajectory.points.size());
-
-  input_arclength.push_back(0.0);
-  input_pose.push_back(input_trajectory.points.front().pose);
-  v_lon.push_back(input_trajectory.points.front().longitudinal_velocity_mps);
-  v_lat.push_back(input_trajectory.points.front().lateral_velocity_mps);
-  heading_rate.push_back(input_trajectory.points.front().heading_rate_rps);
-  acceleration.push_back(input_trajectory.points.front().acceleration_mps2);
-  front_wheel_angle.push_back(input_trajectory.points.front().front_wheel_angle_rad);
-  rear_wheel_angle.push_back(input_trajectory.points.front().rear_wheel_angle_rad);
-  time_from_start.push_back(
-    rclcpp::Duration(input_trajectory.points.front().time_from_start).seconds());
-  for (size_t i = 1; i < input_trajectory.points.size(); ++i) {
-    const auto & prev_pt = input_trajectory.points.at(i - 1);
-    const auto & curr_pt = input_trajectory.points.at(i);
-    const double ds =
-      tier4_autoware_utils::calcDistance2d(prev_pt.pose.position, curr_pt.pose.position);
-    input_arclength.push_back(ds + input_arclength.back());
-    input_pose.push_back(curr_pt.pose);
-    v_lon.push_back(curr_pt.longitudinal_velocity_mps);
-    v_lat.push_back(curr_pt.lateral_velocity_mps);
-    heading_rate.push_back(curr_pt.heading_rate_rps);
-    acceleration.push_back(curr_pt.acceleration_mps2);
-    front_wheel_angle.push_back(curr_pt.front_wheel_angle_rad);
-    rear_wheel_angle.push_back(curr_pt.rear_wheel_angle_rad);
-    time_from_start.push_back(rclcpp::Duration(curr_pt.time_from_start).seconds());
-  }
-
-  // Interpolate
-  const auto lerp = [&](const auto & input) {
-    return interpolation::lerp(input_arclength, input, resampled_arclength);
-  };
+  const auto input_arclength = calcInputArcLength(input_trajectory.points);
 
+  // Find the segment of each resampled point once for all the fields
+  const auto lerp_segments = interpolation::calcLerpSegments(input_arclength, resampled_arclength);
   std::vector<size_t> closest_segment_indices;
   if (use_zero_order_hold_for_twist) {
     closest_segment_indices =
       interpolation::calc_closest_segment_indices(input_arclength, resampled_arclength);
   }
-  const auto zoh = [&](const auto & input) {
-    return interpolation::zero_order_hold(input_arclength, input, closest_segment_indices);
-  };
-
-  const auto interpolated_pose =
-    resamplePoseVector(input_pose, resampled_arclength, use_akima_spline_for_xy, use_lerp_for_z);
-  const auto interpolated_v_lon = use_zero_order_hold_for_twist ? zoh(v_lon) : lerp(v_lon);
-  const auto interpolated_v_lat = use_zero_order_hold_for_twist ? zoh(v_lat) : lerp(v_lat);
-  const auto interpolated_heading_rate = lerp(heading_rate);
-  const auto interpolated_acceleration =
-    use_zero_order_hold_for_twist ? zoh(acceleration) : lerp(acceleration);
-  const auto interpolated_front_wheel_angle = lerp(front_wheel_angle);
-  const auto interpolated_rear_wheel_angle = lerp(rear_wheel_angle);
-  const auto interpolated_time_from_start = lerp(time_from_start);
-
-  if (interpolated_pose.size() != resampled_arclength.size()) {
-    std::cerr << "[motion_utils]: Resampled pose size is different from resampled arclength"
-              << std::endl;
-    return input_trajectory;
-  }
+
+  const auto interpolated_pose = interpolatePoses(
+    input_trajectory.points, input_arclength, resampled_arclength, lerp_segments,
+    use_akima_spline_for_xy, use_lerp_for_z);
 
   autoware_auto_planning_msgs::msg::Trajectory resampled_trajectory;
   resampled_trajectory.header = input_trajectory.header;
   resampled_trajectory.points.resize(interpolated_pose.size());
   for (size_t i = 0; i < resampled_trajectory.points.size(); ++i) {
-    autoware_auto_planning_msgs::msg::TrajectoryPoint traj_point;
+    const auto & segment = lerp_segments.at(i);
+    const auto & prev_pt = input_trajectory.points.at(segment.index);
+    const auto & next_pt = input_trajectory.points.at(segment.index + 1);
+    const auto lerp = [&](const double prev_val, const double next_val) {
+      return interpolation::lerp(prev_val, next_val, segment.ratio);
+    };
+
+    auto & traj_point = resampled_trajectory.points.at(i);
     traj_point.pose = interpolated_pose.at(i);
-    traj_point.longitudinal_velocity_mps = interpolated_v_lon.at(i);
-    traj_point.lateral_velocity_mps = interpolated_v_lat.at(i);
-    traj_point.heading_rate_rps = interpolated_heading_rate.at(i);
-    traj_point.acceleration_mps2 = interpolated_acceleration.at(i);
-    traj_point.front_wheel_angle_rad = interpolated_front_wheel_angle.at(i);
-    traj_point.rear_wheel_angle_rad = interpolated_rear_wheel_angle.at(i);
-    traj_point.time_from_start = rclcpp::Duration::from_seconds(interpolated_time_from_start.at(i));
-    resampled_trajectory.points.at(i) = traj_point;
+    if (use_zero_order_hold_for_twist) {
+      const auto & closest_pt = input_trajectory.points.at(closest_segment_indices.at(i));
+      traj_point.longitudinal_velocity_mps = closest_pt.longitudinal_velocity_mps;
+      traj_point.lateral_velocity_mps = closest_pt.lateral_velocity_mps;
+      traj_point.acceleration_mps2 = closest_pt.acceleration_mps2;
+    } else {
+      traj_point.longitudinal_velocity_mps =
+        lerp(prev_pt.longitudinal_velocity_mps, next_pt.longitudinal_velocity_mps);
+      traj_point.lateral_velocity_mps =
+        lerp(prev_pt.lateral_velocity_mps, next_pt.lateral_velocity_mps);
+      traj_point.acceleration_mps2 = lerp(prev_pt.acceleration_mps2, next_pt.acceleration_mps2);
+    }
+    traj_point.heading_rate_rps = lerp(prev_pt.heading_rate_rps, next_pt.heading_rate_rps);
+    traj_point.front_wheel_angle_rad =
+      lerp(prev_pt.front_wheel_angle_rad, next_pt.front_wheel_angle_rad);
+    traj_point.rear_wheel_angle_rad =
+      lerp(prev_pt.rear_wheel_angle_rad, next_pt.rear_wheel_angle_rad);
+    traj_point.time_from_start = rclcpp::Duration::from_seconds(lerp(
+      rclcpp::Duration(prev_pt.time_from_start).seconds(),
+      rclcpp::Duration(next_pt.time_from_start).seconds()));
   }
 
   return resampled_trajectory;
@@ -0,0 +1,228 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "motion_utils/trajectory/indexed_trajectory.hpp"
+#include "motion_utils/trajectory/trajectory.hpp"
+
+#include <gtest/gtest.h>
+
+#include <autoware_auto_planning_msgs/msg/trajectory.hpp>
+
+#include <limits>
+#include <vector>
+
+namespace
+{
+using autoware_auto_planning_msgs::msg::Trajectory;
+using TrajectoryPointArray = std::vector<autoware_auto_planning_msgs::msg::TrajectoryPoint>;
+using tier4_autoware_utils::createPoint;
+using tier4_autoware_utils::createQuaternionFromRPY;
+
+constexpr double epsilon = 1e-6;
+
+// curved trajectory whose point intervals vary, with a duplicated point at index 5
+TrajectoryPointArray generateTestTrajectoryPointArray(const size_t num_points)
+{
+  TrajectoryPointArray points;
+  double x = 0.0;
+  double y = 0.0;
+  for (size_t i = 0; i < num_points; ++i) {
+    const double theta = 0.05 * static_cast<double>(i);
+    autoware_auto_planning_msgs::msg::TrajectoryPoint p;
+    p.pose.position = createPoint(x, y, 0.0);
+    p.pose.orientation = createQuaternionFromRPY(0.0, 0.0, theta);
+    p.longitudinal_velocity_mps = i < 15 ? 1.0 : 0.0;
+    points.push_back(p);
+    if (i == 5) {
+      points.push_back(p);
+    }
+    const double interval = 0.5 + 0.1 * static_cast<double>(i % 3);
+    x += interval * std::cos(theta);
+    y += interval * std::sin(theta);
+  }
+  return points;
+}
+
+void expectNear(
+  const boost::optional<geometry_msgs::msg::Point> & a,
+  const boost::optional<geometry_msgs::msg::Point> & b)
+{
+  ASSERT_EQ(static_cast<bool>(a), static_cast<bool>(b));
+  if (a) {
+    EXPECT_NEAR(a->x, b->x, epsilon);
+    EXPECT_NEAR(a->y, b->y, epsilon);
+    EXPECT_NEAR(a->z, b->z, epsilon);
+  }
+}
+
+void expectNear(
+  const boost::optional<geometry_msgs::msg::Pose> & a,
+  const boost::optional<geometry_msgs::msg::Pose> & b)
+{
+  ASSERT_EQ(static_cast<bool>(a), static_cast<bool>(b));
+  if (a) {
+    EXPECT_NEAR(a->position.x, b->position.x, epsilon);
+    EXPECT_NEAR(a->position.y, b->position.y, epsilon);
+    EXPECT_NEAR(a->orientation.z, b->orientation.z, epsilon);
+    EXPECT_NEAR(a->orientation.w, b->orientation.w, epsilon);
+  }
+}
+}  // namespace
+
+TEST(indexed_trajectory, calcSignedArcLength)
+{
+  const auto points = generateTestTrajectoryPointArray(30);
+  const motion_utils::IndexedTrajectory indexed_points(points);
+
+  EXPECT_NEAR(indexed_points.calcArcLength(), motion_utils::calcArcLength(points), epsilon);
+  for (size_t i = 0; i < points.size(); ++i) {
+    EXPECT_NEAR(
+      indexed_points.getArcLength(i), motion_utils::calcSignedArcLength(points, 0, i), epsilon);
+    for (size_t j = 0; j < points.size(); j += 3) {
+      EXPECT_NEAR(
+        indexed_points.calcSignedArcLength(i, j), motion_utils::calcSignedArcLength(points, i, j),
+        epsilon);
+    }
+  }
+
+  const auto src_point = createPoint(2.3, 0.4, 0.0);
+  const auto dst_point = createPoint(9.1, 3.5, 0.0);
+  const size_t src_seg_idx = motion_utils::findNearestSegmentIndex(points, src_point);
+  const size_t dst_seg_idx = motion_utils::findNearestSegmentIndex(points, dst_point);
+  EXPECT_NEAR(
+    indexed_points.calcSignedArcLength(src_point, src_seg_idx, 20),
+    motion_utils::calcSignedArcLength(points, src_point, src_seg_idx, 20), epsilon);
+  EXPECT_NEAR(
+    indexed_points.calcSignedArcLength(1, dst_point, dst_seg_idx),
+    motion_utils::calcSignedArcLength(points, 1, dst_point, dst_seg_idx), epsilon);
+  EXPECT_NEAR(
+    indexed_points.calcSignedArcLength(dst_point, dst_seg_idx, src_point, src_seg_idx),
+    motion_utils::calcSignedArcLength(points, dst_point, dst_seg_idx, src_point, src_seg_idx),
+    epsilon);
+  EXPECT_NEAR(
+    indexed_points.calcSignedArcLength(src_point, dst_point),
+    motion_utils::calcSignedArcLength(points, src_point, dst_point), epsilon);
+
+  // Empty
+  const TrajectoryPointArray empty_points;
+  const motion_utils::IndexedTrajectory indexed_empty_points(empty_points);
+  EXPECT_DOUBLE_EQ(indexed_empty_points.calcArcLength(), 0.0);
+  EXPECT_DOUBLE_EQ(indexed_empty_points.calcSignedArcLength(0, 0), 0.0);
+}
+
+TEST(indexed_trajectory, calcLongitudinalOffsetToSegment)
+{
+  const auto points = generateTestTrajectoryPointArray(30);
+  const motion_utils::IndexedTrajectory indexed_points(points);
+
+  const auto p_target = createPoint(4.0, 1.0, 0.0);
+  for (size_t i = 0; i < points.size() - 1; ++i) {
+    EXPECT_NEAR(
+      indexed_points.calcLongitudinalOffsetToSegment(i, p_target),
+      motion_utils::calcLongitudinalOffsetToSegment(points, i, p_target), epsilon);
+  }
+
+  // Invalid segment index
+  EXPECT_TRUE(std::isnan(indexed_points.calcLongitudinalOffsetToSegment(points.size(), p_target)));
+  EXPECT_THROW(
+    indexed_points.calcLongitudinalOffsetToSegment(points.size() - 1, p_target, true),
+    std::out_of_range);
+}
+
+TEST(indexed_trajectory, calcLongitudinalOffsetPointAndPose)
+{
+  const auto points = generateTestTrajectoryPointArray(30);
+  const motion_utils::IndexedTrajectory indexed_points(points);
+
+  for (size_t src_idx = 0; src_idx < points.size(); src_idx += 4) {
+    // the offsets do not end on the points, where the search may pick either segment by rounding
+    for (double offset = -20.013; offset < 20.0; offset += 0.37) {
+      expectNear(
+        indexed_points.calcLongitudinalOffsetPoint(src_idx, offset),
+        motion_utils::calcLongitudinalOffsetPoint(points, src_idx, offset));
+      expectNear(
+        indexed_points.calcLongitudinalOffsetPose(src_idx, offset),
+        motion_utils::calcLongitudinalOffsetPose(points, src_idx, offset));
+      expectNear(
+        indexed_points.calcLongitudinalOffsetPose(src_idx, offset, false),
+        motion_utils::calcLongitudinalOffsetPose(points, src_idx, offset, false));
+    }
+  }
+
+  // Boundary conditions
+  const size_t last_idx = points.size() - 1;
+  expectNear(
+    indexed_points.calcLongitudinalOffsetPoint(last_idx, 0.0),
+    motion_utils::calcLongitudinalOffsetPoint(points, last_idx, 0.0));
+  expectNear(
+    indexed_points.calcLongitudinalOffsetPose(0, indexed_points.calcArcLength()),
+    motion_utils::calcLongitudinalOffsetPose(points, 0, motion_utils::calcArcLength(points)));
+  EXPECT_FALSE(indexed_points.calcLongitudinalOffsetPoint(points.size(), 1.0));
+  EXPECT_THROW(
+    indexed_points.calcLongitudinalOffsetPose(points.size(), 1.0, true, true), std::out_of_range);
+
+  const auto src_point = createPoint(5.2, 1.1, 0.0);
+  for (double offset = -10.0; offset < 10.0; offset += 0.53) {
+    expectNear(
+      indexed_points.calcLongitudinalOffsetPoint(src_point, offset),
+      motion_utils::calcLongitudinalOffsetPoint(points, src_point, offset));
+    expectNear(
+      indexed_points.calcLongitudinalOffsetPose(src_point, offset),
+      motion_utils::calcLongitudinalOffsetPose(points, src_point, offset));
+  }
+}
+
+TEST(indexed_trajectory, calcDistanceToForwardStopPoint)
+{
+  const auto points = generateTestTrajectoryPointArray(30);
+  const motion_utils::IndexedTrajectory indexed_points(points);
+
+  for (size_t src_idx = 0; src_idx < points.size(); ++src_idx) {
+    const auto dist = indexed_points.calcDistanceToForwardStopPoint(src_idx);
+    const auto expected = motion_utils::calcDistanceToForwardStopPoint(points, src_idx);
+    ASSERT_TRUE(dist);
+    ASSERT_TRUE(expected);
+    EXPECT_NEAR(*dist, *expected, epsilon);
+  }
+
+  geometry_msgs::msg::Pose pose;
+  pose.position = createPoint(3.0, 0.5, 0.0);
+  pose.orientation = createQuaternionFromRPY(0.0, 0.0, 0.2);
+  const auto dist = indexed_points.calcDistanceToForwardStopPoint(pose);
+  const auto expected = motion_utils::calcDistanceToForwardStopPoint(points, pose);
+  ASSERT_TRUE(dist);
+  ASSERT_TRUE(expected);
+  EXPECT_NEAR(*dist, *expected, epsilon);
+
+  // No stop point
+  auto moving_points = points;
+  for (auto & p : moving_points) {
+    p.longitudinal_velocity_mps = 1.0;
+  }
+  const motion_utils::IndexedTrajectory indexed_moving_points(moving_points);
+  EXPECT_FALSE(indexed_moving_points.calcDistanceToForwardStopPoint(0));
+}
+
+TEST(indexed_trajectory, findSegmentIndex)
+{
+  const auto points = generateTestTrajectoryPointArray(30);
+  const motion_utils::IndexedTrajectory indexed_points(points);
+
+  EXPECT_EQ(indexed_points.findSegmentIndex(-1.0), 0U);
+  EXPECT_EQ(indexed_points.findSegmentIndex(0.0), 0U);
+  EXPECT_EQ(indexed_points.findSegmentIndex(indexed_points.getArcLength(3) + 0.01), 3U);
+  // the duplicated point makes a zero length segment, which is skipped
+  EXPECT_EQ(indexed_points.findSegmentIndex(indexed_points.getArcLength(5)), 6U);
+  EXPECT_EQ(indexed_points.findSegmentIndex(1000.0), points.size() - 2);
+}
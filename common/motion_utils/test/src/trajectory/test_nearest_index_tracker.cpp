@@ -0,0 +1,203 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "motion_utils/trajectory/nearest_index_tracker.hpp"
+#include "motion_utils/trajectory/trajectory.hpp"
+#include "tier4_autoware_utils/math/unit_conversion.hpp"
+
+#include <gtest/gtest.h>
+
+#include <autoware_auto_planning_msgs/msg/trajectory.hpp>
+
+#include <limits>
+#include <vector>
+
+namespace
+{
+using autoware_auto_planning_msgs::msg::Trajectory;
+using tier4_autoware_utils::createPoint;
+using tier4_autoware_utils::createQuaternionFromRPY;
+using tier4_autoware_utils::deg2rad;
+
+geometry_msgs::msg::Pose createPose(double x, double y, double yaw)
+{
+  geometry_msgs::msg::Pose p;
+  p.position = createPoint(x, y, 0.0);
+  p.orientation = createQuaternionFromRPY(0.0, 0.0, yaw);
+  return p;
+}
+
+Trajectory generateTestTrajectory(
+  const size_t num_points, const double point_interval, const int32_t stamp_sec = 0)
+{
+  Trajectory traj;
+  traj.header.stamp.sec = stamp_sec;
+  for (size_t i = 0; i < num_points; ++i) {
+    autoware_auto_planning_msgs::msg::TrajectoryPoint p;
+    p.pose = createPose(i * point_interval, 0.0, 0.0);
+    traj.points.push_back(p);
+  }
+  return traj;
+}
+}  // namespace
+
+TEST(nearest_index_tracker, findNearestIndex_Pos)
+{
+  using motion_utils::findNearestIndex;
+
+  const auto traj = generateTestTrajectory(100, 1.0);
+  motion_utils::NearestIndexTracker tracker(5);
+
+  // Empty
+  EXPECT_THROW(
+    tracker.findNearestIndex(Trajectory{}.points, traj.header.stamp, geometry_msgs::msg::Point{}),
+    std::invalid_argument);
+
+  // Moving forward and backward along the trajectory
+  for (double x = -3.0; x < 105.0; x += 0.3) {
+    const auto p = createPoint(x, 1.0, 0.0);
+    EXPECT_EQ(
+      tracker.findNearestIndex(traj.points, traj.header.stamp, p),
+      findNearestIndex(traj.points, p));
+  }
+  for (double x = 105.0; x > -3.0; x -= 0.7) {
+    const auto p = createPoint(x, -1.0, 0.0);
+    EXPECT_EQ(
+      tracker.findNearestIndex(traj.points, traj.header.stamp, p),
+      findNearestIndex(traj.points, p));
+  }
+
+  // Jump out of the search window
+  const auto & stamp = traj.header.stamp;
+  EXPECT_EQ(tracker.findNearestIndex(traj.points, stamp, createPoint(50.2, 0.0, 0.0)), 50U);
+  EXPECT_EQ(tracker.findNearestIndex(traj.points, stamp, createPoint(3.0, 0.0, 0.0)), 3U);
+  EXPECT_EQ(tracker.findNearestIndex(traj.points, stamp, createPoint(90.0, 0.0, 0.0)), 90U);
+
+  // New trajectory
+  const auto new_traj = generateTestTrajectory(10, 2.0, 1);
+  EXPECT_EQ(
+    tracker.findNearestIndex(new_traj.points, new_traj.header.stamp, createPoint(5.0, 0.0, 0.0)),
+    2U);
+}
+
+TEST(nearest_index_tracker, findNearestIndex_Pos_LoopTrajectory)
+{
+  // go forward to x = 20 and come back to x = 0 at y = 0.5
+  Trajectory traj;
+  for (size_t i = 0; i <= 20; ++i) {
+    autoware_auto_planning_msgs::msg::TrajectoryPoint p;
+    p.pose = createPose(static_cast<double>(i), 0.0, 0.0);
+    traj.points.push_back(p);
+  }
+  for (size_t i = 0; i <= 20; ++i) {
+    autoware_auto_planning_msgs::msg::TrajectoryPoint p;
+    p.pose = createPose(20.0 - static_cast<double>(i), 0.5, M_PI);
+    traj.points.push_back(p);
+  }
+
+  motion_utils::NearestIndexTracker tracker(5);
+  EXPECT_EQ(
+    tracker.findNearestIndex(traj.points, traj.header.stamp, createPoint(2.0, 0.0, 0.0)), 2U);
+
+  // the point on the returning part is nearer, but the one around the last index is kept
+  const auto p = createPoint(4.0, 0.3, 0.0);
+  EXPECT_EQ(motion_utils::findNearestIndex(traj.points, p), 37U);
+  EXPECT_EQ(tracker.findNearestIndex(traj.points, traj.header.stamp, p), 4U);
+}
+
+TEST(nearest_index_tracker, findNearestIndex_Pose)
+{
+  using motion_utils::findNearestIndex;
+
+  const auto traj = generateTestTrajectory(100, 1.0);
+  motion_utils::NearestIndexTracker tracker(5);
+
+  // Empty
+  EXPECT_FALSE(
+    tracker.findNearestIndex(Trajectory{}.points, traj.header.stamp, geometry_msgs::msg::Pose{}));
+
+  for (double x = -3.0; x < 105.0; x += 0.3) {
+    const auto pose = createPose(x, 0.5, deg2rad(10.0));
+    EXPECT_TRUE(
+      tracker.findNearestIndex(traj.points, traj.header.stamp, pose, 2.0, deg2rad(30.0)) ==
+      findNearestIndex(traj.points, pose, 2.0, deg2rad(30.0)));
+  }
+
+  // Out of the thresholds
+  EXPECT_FALSE(tracker.findNearestIndex(
+    traj.points, traj.header.stamp, createPose(50.0, 0.0, deg2rad(60.0)), 2.0, deg2rad(30.0)));
+  EXPECT_FALSE(tracker.findNearestIndex(
+    traj.points, traj.header.stamp, createPose(50.0, 3.0, 0.0), 2.0, deg2rad(30.0)));
+}
+
+TEST(nearest_index_tracker, findNearestSegmentIndex)
+{
+  using motion_utils::findNearestSegmentIndex;
+
+  const auto traj = generateTestTrajectory(100, 1.0);
+  motion_utils::NearestIndexTracker tracker(5);
+
+  for (double x = -3.0; x < 105.0; x += 0.3) {
+    const auto pose = createPose(x, 0.5, 0.0);
+    EXPECT_EQ(
+      tracker.findNearestSegmentIndex(traj.points, traj.header.stamp, pose.position),
+      findNearestSegmentIndex(traj.points, pose.position));
+    EXPECT_TRUE(
+      tracker.findNearestSegmentIndex(traj.points, traj.header.stamp, pose) ==
+      findNearestSegmentIndex(traj.points, pose));
+  }
+}
+
+TEST(nearest_index_tracker, findFirstNearestIndexWithSoftConstraints)
+{
+  using motion_utils::findFirstNearestIndexWithSoftConstraints;
+
+  auto traj = generateTestTrajectory(100, 1.0);
+  motion_utils::NearestIndexTracker tracker(5);
+
+  const auto pose = createPose(10.2, 0.3, 0.0);
+  EXPECT_EQ(
+    tracker.findFirstNearestIndexWithSoftConstraints(
+      traj.points, traj.header.stamp, pose, 1.0, deg2rad(45.0)),
+    findFirstNearestIndexWithSoftConstraints(traj.points, pose, 1.0, deg2rad(45.0)));
+
+  // Different thresholds
+  EXPECT_EQ(
+    tracker.findFirstNearestIndexWithSoftConstraints(traj.points, traj.header.stamp, pose), 10U);
+
+  // New trajectory with the same pose
+  traj.header.stamp.sec = 1;
+  traj.points.erase(traj.points.begin(), traj.points.begin() + 5);
+  EXPECT_EQ(
+    tracker.findFirstNearestIndexWithSoftConstraints(traj.points, traj.header.stamp, pose), 5U);
+}
+
+TEST(nearest_index_tracker, findNearestIndices)
+{
+  const auto traj = generateTestTrajectory(100, 1.0);
+  motion_utils::NearestIndexTracker tracker(5);
+
+  std::vector<geometry_msgs::msg::Point> target_points;
+  for (double x = 0.0; x < 100.0; x += 2.4) {
+    target_points.push_back(createPoint(x, 0.2, 0.0));
+  }
+
+  const auto nearest_indices =
+    tracker.findNearestIndices(traj.points, traj.header.stamp, target_points);
+  ASSERT_EQ(nearest_indices.size(), target_points.size());
+  for (size_t i = 0; i < target_points.size(); ++i) {
+    EXPECT_EQ(
+      nearest_indices.at(i), motion_utils::findNearestIndex(traj.points, target_points.at(i)));
+  }
+}
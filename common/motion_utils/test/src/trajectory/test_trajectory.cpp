@@ -421,6 +421,81 @@ TEST(trajectory, findNearestIndex_Pose_DistAndYawThreshold)
     *findNearestIndex(traj.points, createPose(8.5, -0.5, 0.0, 0.0, 0.0, 0.0), 1.0, 0.1), 8U);
 }
 
+TEST(trajectory, findNearestIndexWithHint)
+{
+  using motion_utils::findNearestIndex;
+  using motion_utils::findNearestIndexWithHint;
+
+  const auto traj = generateTestTrajectory<Trajectory>(100, 1.0);
+  std::vector<double> arc_lengths;
+  for (size_t i = 0; i < traj.points.size(); ++i) {
+    arc_lengths.push_back(static_cast<double>(i));
+  }
+  const double window = 10.0;
+
+  // Empty
+  EXPECT_FALSE(findNearestIndexWithHint(
+    Trajectory{}.points, std::vector<double>{}, geometry_msgs::msg::Pose{}, size_t{0}, window, 3.0,
+    1.0));
+
+  // No hint, invalid hint or arc lengths of other points
+  const auto pose = createPose(52.2, 0.5, 0.0, 0.0, 0.0, 0.0);
+  EXPECT_EQ(*findNearestIndexWithHint(traj.points, arc_lengths, pose, {}, window, 3.0, 1.0), 52U);
+  EXPECT_EQ(*findNearestIndexWithHint(traj.points, arc_lengths, pose, 100, window, 3.0, 1.0), 52U);
+  EXPECT_EQ(
+    *findNearestIndexWithHint(traj.points, std::vector<double>{}, pose, 50, window, 3.0, 1.0), 52U);
+
+  // Nearest point in the window
+  EXPECT_EQ(*findNearestIndexWithHint(traj.points, arc_lengths, pose, 50, window, 3.0, 1.0), 52U);
+  EXPECT_EQ(*findNearestIndexWithHint(traj.points, arc_lengths, pose, 45, window, 3.0, 1.0), 52U);
+
+  // Nearest point close to or out of the window
+  EXPECT_EQ(
+    *findNearestIndexWithHint(
+      traj.points, arc_lengths, createPose(61.9, 0.0, 0.0, 0.0, 0.0, 0.0), 50, window, 3.0, 1.0),
+    62U);
+  EXPECT_EQ(
+    *findNearestIndexWithHint(
+      traj.points, arc_lengths, createPose(80.1, 0.0, 0.0, 0.0, 0.0, 0.0), 50, window, 3.0, 1.0),
+    80U);
+  EXPECT_EQ(
+    *findNearestIndexWithHint(
+      traj.points, arc_lengths, createPose(0.1, 0.0, 0.0, 0.0, 0.0, 0.0), 99, window, 3.0, 1.0),
+    0U);
+
+  // Out of the thresholds
+  EXPECT_FALSE(findNearestIndexWithHint(
+    traj.points, arc_lengths, createPose(52.0, 5.0, 0.0, 0.0, 0.0, 0.0), 50, window, 3.0, 1.0));
+  EXPECT_FALSE(findNearestIndexWithHint(
+    traj.points, arc_lengths, createPose(52.0, 0.0, 0.0, 0.0, 0.0, 2.0), 50, window, 3.0, 1.0));
+
+  // Loop: the second lap passes slightly closer to the pose than the first one
+  Trajectory loop;
+  std::vector<double> loop_arc_lengths;
+  for (size_t i = 0; i < 200; ++i) {
+    const double radius = i < 100 ? 10.0 : 10.2;
+    const double theta = 2.0 * M_PI * static_cast<double>(i % 100) / 100.0;
+    autoware_auto_planning_msgs::msg::TrajectoryPoint p;
+    p.pose = createPose(
+      radius * std::cos(theta), radius * std::sin(theta), 0.0, 0.0, 0.0, theta + M_PI_2);
+    loop.points.push_back(p);
+    loop_arc_lengths.push_back(
+      i == 0 ? 0.0
+             : loop_arc_lengths.back() +
+                 tier4_autoware_utils::calcDistance2d(loop.points.at(i - 1), p));
+  }
+  const double loop_theta = 2.0 * M_PI * 5.0 / 100.0;
+  const auto loop_pose = createPose(
+    10.15 * std::cos(loop_theta), 10.15 * std::sin(loop_theta), 0.0, 0.0, 0.0,
+    loop_theta + M_PI_2);
+  EXPECT_EQ(*findNearestIndex(loop.points, loop_pose, 3.0, 1.0), 105U);
+  EXPECT_EQ(
+    *findNearestIndexWithHint(loop.points, loop_arc_lengths, loop_pose, 5, window, 3.0, 1.0), 5U);
+  EXPECT_EQ(
+    *findNearestIndexWithHint(loop.points, loop_arc_lengths, loop_pose, 105, window, 3.0, 1.0),
+    105U);
+}
+
 TEST(trajectory, findNearestSegmentIndex)
 {
   using motion_utils::findNearestSegmentIndex;
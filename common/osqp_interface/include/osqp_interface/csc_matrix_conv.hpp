@@ -16,6 +16,7 @@
 #define OSQP_INTERFACE__CSC_MATRIX_CONV_HPP_
 
 #include "eigen3/Eigen/Core"
+#include "eigen3/Eigen/SparseCore"
 #include "osqp/glob_opts.h"  // for 'c_int' type ('long' or 'long long')
 #include "osqp_interface/visibility_control.hpp"
 
@@ -40,6 +41,10 @@ struct OSQP_INTERFACE_PUBLIC CSC_Matrix
 
 /// \brief Calculate CSC matrix from Eigen matrix
 OSQP_INTERFACE_PUBLIC CSC_Matrix calCSCMatrix(const Eigen::MatrixXd & mat);
+/// \brief Calculate CSC matrix from Eigen sparse matrix keeping all the stored elements
+/// \details Explicitly stored zeros are kept, so that matrices assembled with the same
+///          structure share the sparsity pattern regardless of their values.
+OSQP_INTERFACE_PUBLIC CSC_Matrix calCSCMatrix(const Eigen::SparseMatrix<double> & mat);
 /// \brief Calculate upper trapezoidal CSC matrix from square Eigen matrix
 OSQP_INTERFACE_PUBLIC CSC_Matrix calCSCMatrixTrapezoidal(const Eigen::MatrixXd & mat);
 /// \brief Print the given CSC matrix to the standard output
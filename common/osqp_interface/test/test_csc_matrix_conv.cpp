@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "eigen3/Eigen/Core"
+#include "eigen3/Eigen/SparseCore"
 #include "gtest/gtest.h"
 #include "osqp_interface/csc_matrix_conv.hpp"
 
@@ -114,6 +115,39 @@ TEST(TestCscMatrixConv, Nominal)
   EXPECT_EQ(square_m2.m_col_idxs[5], c_int(16));
   EXPECT_EQ(square_m2.m_col_idxs[6], c_int(19));
 }
+TEST(TestCscMatrixConv, Sparse)
+{
+  using autoware::common::osqp::calCSCMatrix;
+  using autoware::common::osqp::CSC_Matrix;
+
+  // explicitly stored zeros are kept in the pattern
+  std::vector<Eigen::Triplet<double>> triplets;
+  triplets.emplace_back(0, 0, 1.0);
+  triplets.emplace_back(1, 1, 6.0);
+  triplets.emplace_back(0, 2, 3.0);
+  triplets.emplace_back(1, 2, 0.0);
+  Eigen::SparseMatrix<double> rect(2, 4);
+  rect.setFromTriplets(triplets.begin(), triplets.end());
+
+  const CSC_Matrix rect_m = calCSCMatrix(rect);
+  ASSERT_EQ(rect_m.m_vals.size(), size_t(4));
+  EXPECT_EQ(rect_m.m_vals[0], 1.0);
+  EXPECT_EQ(rect_m.m_vals[1], 6.0);
+  EXPECT_EQ(rect_m.m_vals[2], 3.0);
+  EXPECT_EQ(rect_m.m_vals[3], 0.0);
+  ASSERT_EQ(rect_m.m_row_idxs.size(), size_t(4));
+  EXPECT_EQ(rect_m.m_row_idxs[0], c_int(0));
+  EXPECT_EQ(rect_m.m_row_idxs[1], c_int(1));
+  EXPECT_EQ(rect_m.m_row_idxs[2], c_int(0));
+  EXPECT_EQ(rect_m.m_row_idxs[3], c_int(1));
+  ASSERT_EQ(rect_m.m_col_idxs.size(), size_t(5));  // nb of columns + 1
+  EXPECT_EQ(rect_m.m_col_idxs[0], c_int(0));
+  EXPECT_EQ(rect_m.m_col_idxs[1], c_int(1));
+  EXPECT_EQ(rect_m.m_col_idxs[2], c_int(2));
+  EXPECT_EQ(rect_m.m_col_idxs[3], c_int(4));
+  EXPECT_EQ(rect_m.m_col_idxs[4], c_int(4));
+}
+
 TEST(TestCscMatrixConv, Trapezoidal)
 {
   using autoware::common::osqp::calCSCMatrixTrapezoidal;
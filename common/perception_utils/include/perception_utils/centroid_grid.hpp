@@ -0,0 +1,98 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PERCEPTION_UTILS__CENTROID_GRID_HPP_
+#define PERCEPTION_UTILS__CENTROID_GRID_HPP_
+
+#include <autoware_auto_perception_msgs/msg/detected_object.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace perception_utils
+{
+/**
+ * @brief 2d positions, e.g. the centroids of objects, bucketed in a uniform grid with a counting
+ * sort. It is meant to be rebuilt every frame and keeps its memory between builds.
+ * @details the indices of the points in cell i are indices_[cell_offsets_[i]:cell_offsets_[i + 1]].
+ * The points with a non-finite position are left out of the cells.
+ */
+class CentroidGrid
+{
+public:
+  /**
+   * @brief bucket the points
+   * @param xs x of the points
+   * @param ys y of the points, of the same size as xs
+   * @param cell_size side of the cells, it is made larger when the points would spread over too
+   * many cells
+   */
+  void build(
+    const std::vector<double> & xs, const std::vector<double> & ys, const double cell_size);
+
+  /**
+   * @brief bucket the centroids of objects
+   */
+  void build(
+    const std::vector<autoware_auto_perception_msgs::msg::DetectedObject> & objects,
+    const double cell_size);
+
+  /**
+   * @brief find the points within radius of (x, y)
+   * @param indices cleared and filled with the indices of the points, in increasing order
+   */
+  void query(
+    const double x, const double y, const double radius, std::vector<size_t> & indices) const;
+
+  /**
+   * @brief find the points in the cells overlapped by a box, they are candidates to be in the box
+   * @param indices cleared and filled with the indices of the points, in increasing order
+   */
+  void queryBox(
+    const double min_x, const double min_y, const double max_x, const double max_y,
+    std::vector<size_t> & indices) const;
+
+  /**
+   * @brief find the points which may pass a "not farther than radius from (x, y)" gate, that is
+   * the points in the cells overlapped by the square around (x, y) and the points with a
+   * non-finite position, or all the points when (x, y) or radius is not finite. A non-finite
+   * distance is never greater than the gate.
+   * @param indices cleared and filled with the indices of the points, in increasing order
+   */
+  void queryCandidates(
+    const double x, const double y, const double radius, std::vector<size_t> & indices) const;
+
+private:
+  // append the points of the cells overlapped by the box
+  void appendCells(
+    const double min_x, const double min_y, const double max_x, const double max_y,
+    std::vector<size_t> & indices) const;
+
+  std::vector<double> xs_{};
+  std::vector<double> ys_{};
+  double min_x_{};
+  double min_y_{};
+  double cell_size_{1.0};
+  size_t width_{};
+  size_t height_{};
+  std::vector<size_t> cell_offsets_{};
+  std::vector<size_t> indices_{};
+  std::vector<size_t> non_finite_indices_{};
+  std::vector<size_t> cells_{};         // cell of each point
+  std::vector<size_t> cell_cursors_{};  // next free position of each cell while sorting
+};
+}  // namespace perception_utils
+
+#endif  // PERCEPTION_UTILS__CENTROID_GRID_HPP_
@@ -0,0 +1,229 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PERCEPTION_UTILS__CONVEX_POLYGON_HPP_
+#define PERCEPTION_UTILS__CONVEX_POLYGON_HPP_
+
+#include "tier4_autoware_utils/geometry/boost_geometry.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <optional>
+
+namespace perception_utils
+{
+using tier4_autoware_utils::Point2d;
+using tier4_autoware_utils::Polygon2d;
+
+// Convex polygon with a fixed capacity so that the area kernels below run without any heap
+// allocation. The vertices are stored counter-clockwise without the closing point.
+struct ConvexPolygon2d
+{
+  static constexpr size_t max_size = 64;
+
+  std::array<Point2d, max_size> points;
+  size_t size{0};
+  double area{0.0};
+  double min_x{0.0};
+  double max_x{0.0};
+  double min_y{0.0};
+  double max_y{0.0};
+};
+
+namespace convex_polygon
+{
+// vertex buffer which can hold the intersection or the convex hull of two convex polygons
+using VertexBuffer = std::array<Point2d, ConvexPolygon2d::max_size * 2 + 1>;
+
+inline double cross(const Point2d & o, const Point2d & a, const Point2d & b)
+{
+  return (a.x() - o.x()) * (b.y() - o.y()) - (a.y() - o.y()) * (b.x() - o.x());
+}
+
+inline double calcSignedArea(const Point2d * points, const size_t size)
+{
+  double area = 0.0;
+  for (size_t i = 0; i < size; ++i) {
+    const auto & p0 = points[i];
+    const auto & p1 = points[(i + 1) % size];
+    area += p0.x() * p1.y() - p1.x() * p0.y();
+  }
+  return area / 2.0;
+}
+
+inline bool isAabbOverlapped(const ConvexPolygon2d & poly1, const ConvexPolygon2d & poly2)
+{
+  return poly1.min_x <= poly2.max_x && poly2.min_x <= poly1.max_x && poly1.min_y <= poly2.max_y &&
+         poly2.min_y <= poly1.max_y;
+}
+}  // namespace convex_polygon
+
+/**
+ * @brief convert a boost polygon to a fixed-capacity convex polygon
+ * @return false if the polygon is not convex, has holes or does not fit in the capacity, in which
+ *         case the general boost::geometry algorithms have to be used
+ */
+inline bool toConvexPolygon2d(const Polygon2d & polygon, ConvexPolygon2d & convex_polygon)
+{
+  convex_polygon.size = 0;
+  if (!polygon.inners().empty()) {
+    return false;
+  }
+
+  // remove the closing point and the duplicated consecutive points
+  for (const auto & p : polygon.outer()) {
+    if (convex_polygon.size != 0 && convex_polygon.points[convex_polygon.size - 1] == p) {
+      continue;
+    }
+    if (convex_polygon.size == ConvexPolygon2d::max_size) {
+      return false;
+    }
+    convex_polygon.points[convex_polygon.size++] = p;
+  }
+  auto & points = convex_polygon.points;
+  if (convex_polygon.size > 1 && points[0] == points[convex_polygon.size - 1]) {
+    --convex_polygon.size;
+  }
+  if (convex_polygon.size < 3) {
+    return false;
+  }
+
+  const size_t size = convex_polygon.size;
+  const double signed_area = convex_polygon::calcSignedArea(points.data(), size);
+  if (signed_area < 0.0) {
+    std::reverse(points.begin(), points.begin() + size);
+  }
+  convex_polygon.area = std::abs(signed_area);
+
+  // every corner has to turn left, allowing for collinear points
+  const double eps = 1e-9 * std::max(convex_polygon.area, 1.0);
+  for (size_t i = 0; i < size; ++i) {
+    if (convex_polygon::cross(points[i], points[(i + 1) % size], points[(i + 2) % size]) < -eps) {
+      return false;
+    }
+  }
+
+  const auto [min_x, max_x] = std::minmax_element(
+    points.begin(), points.begin() + size,
+    [](const Point2d & a, const Point2d & b) { return a.x() < b.x(); });
+  const auto [min_y, max_y] = std::minmax_element(
+    points.begin(), points.begin() + size,
+    [](const Point2d & a, const Point2d & b) { return a.y() < b.y(); });
+  convex_polygon.min_x = min_x->x();
+  convex_polygon.max_x = max_x->x();
+  convex_polygon.min_y = min_y->y();
+  convex_polygon.max_y = max_y->y();
+  return true;
+}
+
+/**
+ * @brief area of the intersection of two convex polygons by Sutherland-Hodgman clipping
+ * @return std::nullopt if the clipped polygon degenerates numerically and overflows the capacity
+ */
+inline std::optional<double> getConvexIntersectionArea(
+  const ConvexPolygon2d & source_polygon, const ConvexPolygon2d & target_polygon)
+{
+  if (!convex_polygon::isAabbOverlapped(source_polygon, target_polygon)) {
+    return 0.0;
+  }
+
+  // clip the source polygon by every edge of the target polygon
+  convex_polygon::VertexBuffer buffer1;
+  convex_polygon::VertexBuffer buffer2;
+  std::copy(
+    source_polygon.points.begin(), source_polygon.points.begin() + source_polygon.size,
+    buffer1.begin());
+  Point2d * input = buffer1.data();
+  Point2d * output = buffer2.data();
+  size_t input_size = source_polygon.size;
+
+  for (size_t i = 0; i < target_polygon.size && input_size != 0; ++i) {
+    const auto & edge_start = target_polygon.points[i];
+    const auto & edge_end = target_polygon.points[(i + 1) % target_polygon.size];
+
+    size_t output_size = 0;
+    for (size_t j = 0; j < input_size; ++j) {
+      const auto & curr_p = input[j];
+      const auto & next_p = input[(j + 1) % input_size];
+      const double curr_side = convex_polygon::cross(edge_start, edge_end, curr_p);
+      const double next_side = convex_polygon::cross(edge_start, edge_end, next_p);
+
+      if (output_size + 2 > buffer1.size()) {
+        return std::nullopt;
+      }
+      if (curr_side >= 0.0) {
+        output[output_size++] = curr_p;
+      }
+      if ((curr_side >= 0.0) != (next_side >= 0.0)) {
+        const double ratio = curr_side / (curr_side - next_side);
+        output[output_size++] = Point2d(
+          curr_p.x() + (next_p.x() - curr_p.x()) * ratio,
+          curr_p.y() + (next_p.y() - curr_p.y()) * ratio);
+      }
+    }
+    std::swap(input, output);
+    input_size = output_size;
+  }
+
+  if (input_size < 3) {
+    return 0.0;
+  }
+  return std::max(convex_polygon::calcSignedArea(input, input_size), 0.0);
+}
+
+/**
+ * @brief area of the convex hull of two convex polygons by Andrew's monotone chain
+ */
+inline double getConvexHullArea(
+  const ConvexPolygon2d & source_polygon, const ConvexPolygon2d & target_polygon)
+{
+  convex_polygon::VertexBuffer points;
+  auto points_end = std::copy(
+    source_polygon.points.begin(), source_polygon.points.begin() + source_polygon.size,
+    points.begin());
+  points_end = std::copy(
+    target_polygon.points.begin(), target_polygon.points.begin() + target_polygon.size,
+    points_end);
+  std::sort(points.begin(), points_end, [](const Point2d & a, const Point2d & b) {
+    return a.x() < b.x() || (a.x() == b.x() && a.y() < b.y());
+  });
+  const size_t num_points = static_cast<size_t>(points_end - points.begin());
+
+  convex_polygon::VertexBuffer hull;
+  size_t hull_size = 0;
+  // lower hull
+  for (size_t i = 0; i < num_points; ++i) {
+    while (hull_size >= 2 &&
+           convex_polygon::cross(hull[hull_size - 2], hull[hull_size - 1], points[i]) <= 0.0) {
+      --hull_size;
+    }
+    hull[hull_size++] = points[i];
+  }
+  // upper hull
+  const size_t lower_hull_size = hull_size + 1;
+  for (size_t i = num_points - 1; i > 0; --i) {
+    while (hull_size >= lower_hull_size &&
+           convex_polygon::cross(hull[hull_size - 2], hull[hull_size - 1], points[i - 1]) <= 0.0) {
+      --hull_size;
+    }
+    hull[hull_size++] = points[i - 1];
+  }
+
+  // the last point is the same as the first one
+  return convex_polygon::calcSignedArea(hull.data(), hull_size - 1);
+}
+}  // namespace perception_utils
+
+#endif  // PERCEPTION_UTILS__CONVEX_POLYGON_HPP_
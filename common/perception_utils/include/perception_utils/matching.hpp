@@ -15,6 +15,7 @@
 #ifndef PERCEPTION_UTILS__MATCHING_HPP_
 #define PERCEPTION_UTILS__MATCHING_HPP_
 
+#include "perception_utils/convex_polygon.hpp"
 #include "perception_utils/geometry.hpp"
 #include "tier4_autoware_utils/geometry/boost_geometry.hpp"
 #include "tier4_autoware_utils/geometry/boost_polygon_utils.hpp"
@@ -62,60 +63,177 @@ inline double getUnionArea(const Polygon2d & source_polygon, const Polygon2d & t
   return getSumArea(union_polygons);
 }
 
-template <class T1, class T2>
-double get2dIoU(const T1 source_object, const T2 target_object, const double min_union_area = 0.01)
+/**
+ * @brief footprint of an object prepared for the repeated matching against other objects
+ * @details convex footprints, which are nearly all of them, are matched by the allocation-free
+ *          kernels in convex_polygon.hpp, and the others by the general boost::geometry ones.
+ */
+struct MatchingPolygon2d
+{
+  explicit MatchingPolygon2d(Polygon2d input_polygon) : polygon(std::move(input_polygon))
+  {
+    is_convex = toConvexPolygon2d(polygon, convex_polygon);
+  }
+
+  double getArea() const
+  {
+    return is_convex ? convex_polygon.area : boost::geometry::area(polygon);
+  }
+
+  Polygon2d polygon;
+  ConvexPolygon2d convex_polygon;
+  bool is_convex{false};
+};
+
+template <class T>
+MatchingPolygon2d toMatchingPolygon2d(const T & object)
+{
+  return MatchingPolygon2d(tier4_autoware_utils::toPolygon2d(object));
+}
+
+inline double getIntersectionArea(
+  const MatchingPolygon2d & source_polygon, const MatchingPolygon2d & target_polygon)
 {
-  const auto source_polygon = tier4_autoware_utils::toPolygon2d(source_object);
-  const auto target_polygon = tier4_autoware_utils::toPolygon2d(target_object);
+  if (source_polygon.is_convex && target_polygon.is_convex) {
+    const auto intersection_area =
+      getConvexIntersectionArea(source_polygon.convex_polygon, target_polygon.convex_polygon);
+    if (intersection_area) {
+      return *intersection_area;
+    }
+  }
+  return getIntersectionArea(source_polygon.polygon, target_polygon.polygon);
+}
 
+inline double getUnionArea(
+  const MatchingPolygon2d & source_polygon, const MatchingPolygon2d & target_polygon,
+  const double intersection_area)
+{
+  if (source_polygon.is_convex && target_polygon.is_convex) {
+    return source_polygon.getArea() + target_polygon.getArea() - intersection_area;
+  }
+  return getUnionArea(source_polygon.polygon, target_polygon.polygon);
+}
+
+inline double getConvexShapeArea(
+  const MatchingPolygon2d & source_polygon, const MatchingPolygon2d & target_polygon)
+{
+  if (source_polygon.is_convex && target_polygon.is_convex) {
+    return getConvexHullArea(source_polygon.convex_polygon, target_polygon.convex_polygon);
+  }
+  return getConvexShapeArea(source_polygon.polygon, target_polygon.polygon);
+}
+
+inline double get2dIoU(
+  const MatchingPolygon2d & source_polygon, const MatchingPolygon2d & target_polygon,
+  const double min_union_area = 0.01)
+{
   const double intersection_area = getIntersectionArea(source_polygon, target_polygon);
   if (intersection_area == 0.0) return 0.0;
-  const double union_area = getUnionArea(source_polygon, target_polygon);
+  const double union_area = getUnionArea(source_polygon, target_polygon, intersection_area);
 
   const double iou =
     union_area < min_union_area ? 0.0 : std::min(1.0, intersection_area / union_area);
   return iou;
 }
 
-template <class T1, class T2>
-double get2dGeneralizedIoU(const T1 & source_object, const T2 & target_object)
+inline double get2dGeneralizedIoU(
+  const MatchingPolygon2d & source_polygon, const MatchingPolygon2d & target_polygon)
 {
-  const auto source_polygon = tier4_autoware_utils::toPolygon2d(source_object);
-  const auto target_polygon = tier4_autoware_utils::toPolygon2d(target_object);
-
   const double intersection_area = getIntersectionArea(source_polygon, target_polygon);
-  const double union_area = getUnionArea(source_polygon, target_polygon);
+  const double union_area = getUnionArea(source_polygon, target_polygon, intersection_area);
   const double convex_shape_area = getConvexShapeArea(source_polygon, target_polygon);
 
   const double iou = union_area < 0.01 ? 0.0 : std::min(1.0, intersection_area / union_area);
   return iou - (convex_shape_area - union_area) / convex_shape_area;
 }
 
-template <class T1, class T2>
-double get2dPrecision(const T1 source_object, const T2 target_object)
+inline double get2dPrecision(
+  const MatchingPolygon2d & source_polygon, const MatchingPolygon2d & target_polygon)
 {
-  const auto source_polygon = tier4_autoware_utils::toPolygon2d(source_object);
-  const auto target_polygon = tier4_autoware_utils::toPolygon2d(target_object);
-
   const double intersection_area = getIntersectionArea(source_polygon, target_polygon);
   if (intersection_area == 0.0) return 0.0;
-  const double source_area = boost::geometry::area(source_polygon);
+  const double source_area = source_polygon.getArea();
 
   return std::min(1.0, intersection_area / source_area);
 }
 
-template <class T1, class T2>
-double get2dRecall(const T1 source_object, const T2 target_object)
+inline double get2dRecall(
+  const MatchingPolygon2d & source_polygon, const MatchingPolygon2d & target_polygon)
 {
-  const auto source_polygon = tier4_autoware_utils::toPolygon2d(source_object);
-  const auto target_polygon = tier4_autoware_utils::toPolygon2d(target_object);
-
   const double intersection_area = getIntersectionArea(source_polygon, target_polygon);
   if (intersection_area == 0.0) return 0.0;
-  const double target_area = boost::geometry::area(target_polygon);
+  const double target_area = target_polygon.getArea();
 
   return std::min(1.0, intersection_area / target_area);
 }
+
+template <class T1, class T2>
+double get2dIoU(const T1 source_object, const T2 target_object, const double min_union_area = 0.01)
+{
+  return get2dIoU(
+    toMatchingPolygon2d(source_object), toMatchingPolygon2d(target_object), min_union_area);
+}
+
+template <class T1, class T2>
+double get2dGeneralizedIoU(const T1 & source_object, const T2 & target_object)
+{
+  return get2dGeneralizedIoU(
+    toMatchingPolygon2d(source_object), toMatchingPolygon2d(target_object));
+}
+
+template <class T1, class T2>
+double get2dPrecision(const T1 source_object, const T2 target_object)
+{
+  return get2dPrecision(toMatchingPolygon2d(source_object), toMatchingPolygon2d(target_object));
+}
+
+template <class T1, class T2>
+double get2dRecall(const T1 source_object, const T2 target_object)
+{
+  return get2dRecall(toMatchingPolygon2d(source_object), toMatchingPolygon2d(target_object));
+}
+
+// one-to-many variants, which convert the source object only once
+
+template <class T1, class T2>
+std::vector<double> get2dIoUBatch(
+  const T1 & source_object, const std::vector<T2> & target_objects,
+  const double min_union_area = 0.01)
+{
+  const auto source_polygon = toMatchingPolygon2d(source_object);
+  std::vector<double> ious;
+  ious.reserve(target_objects.size());
+  for (const auto & target_object : target_objects) {
+    ious.push_back(get2dIoU(source_polygon, toMatchingPolygon2d(target_object), min_union_area));
+  }
+  return ious;
+}
+
+template <class T1, class T2>
+std::vector<double> get2dPrecisionBatch(
+  const T1 & source_object, const std::vector<T2> & target_objects)
+{
+  const auto source_polygon = toMatchingPolygon2d(source_object);
+  std::vector<double> precisions;
+  precisions.reserve(target_objects.size());
+  for (const auto & target_object : target_objects) {
+    precisions.push_back(get2dPrecision(source_polygon, toMatchingPolygon2d(target_object)));
+  }
+  return precisions;
+}
+
+template <class T1, class T2>
+std::vector<double> get2dRecallBatch(
+  const T1 & source_object, const std::vector<T2> & target_objects)
+{
+  const auto source_polygon = toMatchingPolygon2d(source_object);
+  std::vector<double> recalls;
+  recalls.reserve(target_objects.size());
+  for (const auto & target_object : target_objects) {
+    recalls.push_back(get2dRecall(source_polygon, toMatchingPolygon2d(target_object)));
+  }
+  return recalls;
+}
 }  // namespace perception_utils
 
 #endif  // PERCEPTION_UTILS__MATCHING_HPP_
@@ -15,6 +15,7 @@
 #ifndef PERCEPTION_UTILS__PERCEPTION_UTILS_HPP_
 #define PERCEPTION_UTILS__PERCEPTION_UTILS_HPP_
 
+#include "perception_utils/centroid_grid.hpp"
 #include "perception_utils/conversion.hpp"
 #include "perception_utils/geometry.hpp"
 #include "perception_utils/matching.hpp"
@@ -0,0 +1,187 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "perception_utils/centroid_grid.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace
+{
+// the cells grow when the points are spread over more cells than this
+constexpr size_t kMaxCells = 1 << 16;
+constexpr double kMinCellSize = 1e-3;
+}  // namespace
+
+namespace perception_utils
+{
+void CentroidGrid::build(
+  const std::vector<double> & xs, const std::vector<double> & ys, const double cell_size)
+{
+  xs_.assign(xs.begin(), xs.end());
+  ys_.assign(ys.begin(), ys.end());
+  cells_.resize(xs_.size());
+  indices_.clear();
+  non_finite_indices_.clear();
+  cell_offsets_.assign(1, 0);
+  width_ = 0;
+  height_ = 0;
+
+  double max_x = std::numeric_limits<double>::lowest();
+  double max_y = std::numeric_limits<double>::lowest();
+  min_x_ = std::numeric_limits<double>::max();
+  min_y_ = std::numeric_limits<double>::max();
+  for (size_t i = 0; i < xs_.size(); ++i) {
+    if (!std::isfinite(xs_[i]) || !std::isfinite(ys_[i])) {
+      non_finite_indices_.push_back(i);
+      continue;
+    }
+    min_x_ = std::min(min_x_, xs_[i]);
+    min_y_ = std::min(min_y_, ys_[i]);
+    max_x = std::max(max_x, xs_[i]);
+    max_y = std::max(max_y, ys_[i]);
+  }
+  const size_t num_finite = xs_.size() - non_finite_indices_.size();
+  if (num_finite == 0) {
+    return;
+  }
+
+  cell_size_ = std::isfinite(cell_size) ? std::max(cell_size, kMinCellSize)
+                                        : std::numeric_limits<double>::max();
+  const double span_x = max_x - min_x_;
+  const double span_y = max_y - min_y_;
+  while ((span_x / cell_size_ + 1.0) * (span_y / cell_size_ + 1.0) >
+         static_cast<double>(kMaxCells)) {
+    cell_size_ *= 2.0;
+  }
+  width_ = static_cast<size_t>(span_x / cell_size_) + 1;
+  height_ = static_cast<size_t>(span_y / cell_size_) + 1;
+
+  // counting sort of the points by cell
+  constexpr size_t invalid_cell = std::numeric_limits<size_t>::max();
+  cell_offsets_.assign(width_ * height_ + 1, 0);
+  for (size_t i = 0; i < xs_.size(); ++i) {
+    if (!std::isfinite(xs_[i]) || !std::isfinite(ys_[i])) {
+      cells_[i] = invalid_cell;
+      continue;
+    }
+    const auto ix = std::min(static_cast<size_t>((xs_[i] - min_x_) / cell_size_), width_ - 1);
+    const auto iy = std::min(static_cast<size_t>((ys_[i] - min_y_) / cell_size_), height_ - 1);
+    cells_[i] = iy * width_ + ix;
+    ++cell_offsets_[cells_[i] + 1];
+  }
+  std::partial_sum(cell_offsets_.begin(), cell_offsets_.end(), cell_offsets_.begin());
+  cell_cursors_.assign(cell_offsets_.begin(), cell_offsets_.end() - 1);
+  indices_.resize(num_finite);
+  for (size_t i = 0; i < xs_.size(); ++i) {
+    if (cells_[i] != invalid_cell) {
+      indices_[cell_cursors_[cells_[i]]++] = i;
+    }
+  }
+}
+
+void CentroidGrid::build(
+  const std::vector<autoware_auto_perception_msgs::msg::DetectedObject> & objects,
+  const double cell_size)
+{
+  std::vector<double> xs;
+  std::vector<double> ys;
+  xs.reserve(objects.size());
+  ys.reserve(objects.size());
+  for (const auto & object : objects) {
+    const auto & position = object.kinematics.pose_with_covariance.pose.position;
+    xs.push_back(position.x);
+    ys.push_back(position.y);
+  }
+  build(xs, ys, cell_size);
+}
+
+void CentroidGrid::query(
+  const double x, const double y, const double radius, std::vector<size_t> & indices) const
+{
+  indices.clear();
+  if (!(radius >= 0.0) || !std::isfinite(x) || !std::isfinite(y)) {
+    return;
+  }
+  appendCells(x - radius, y - radius, x + radius, y + radius, indices);
+
+  const double sq_radius = radius * radius;
+  const auto is_out_of_radius = [&](const size_t i) {
+    const double dx = xs_[i] - x;
+    const double dy = ys_[i] - y;
+    return dx * dx + dy * dy > sq_radius;
+  };
+  indices.erase(std::remove_if(indices.begin(), indices.end(), is_out_of_radius), indices.end());
+  std::sort(indices.begin(), indices.end());
+}
+
+void CentroidGrid::queryBox(
+  const double min_x, const double min_y, const double max_x, const double max_y,
+  std::vector<size_t> & indices) const
+{
+  indices.clear();
+  appendCells(min_x, min_y, max_x, max_y, indices);
+  std::sort(indices.begin(), indices.end());
+}
+
+void CentroidGrid::queryCandidates(
+  const double x, const double y, const double radius, std::vector<size_t> & indices) const
+{
+  indices.clear();
+  if (!std::isfinite(x) || !std::isfinite(y) || !std::isfinite(radius)) {
+    indices.resize(xs_.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    return;
+  }
+  appendCells(x - radius, y - radius, x + radius, y + radius, indices);
+  indices.insert(indices.end(), non_finite_indices_.begin(), non_finite_indices_.end());
+  std::sort(indices.begin(), indices.end());
+}
+
+void CentroidGrid::appendCells(
+  const double min_x, const double min_y, const double max_x, const double max_y,
+  std::vector<size_t> & indices) const
+{
+  if (
+    indices_.empty() || !std::isfinite(min_x) || !std::isfinite(min_y) ||
+    !std::isfinite(max_x) || !std::isfinite(max_y)) {
+    return;
+  }
+
+  // cells overlapped by the box, clamped to the grid
+  const auto to_cell = [this](const double value, const double min, const size_t size) {
+    const double cell = std::floor((value - min) / cell_size_);
+    return static_cast<int64_t>(std::clamp(cell, -1.0, static_cast<double>(size)));
+  };
+  const int64_t first_x = std::max(to_cell(min_x, min_x_, width_), int64_t{0});
+  const int64_t first_y = std::max(to_cell(min_y, min_y_, height_), int64_t{0});
+  const int64_t last_x =
+    std::min(to_cell(max_x, min_x_, width_), static_cast<int64_t>(width_) - 1);
+  const int64_t last_y =
+    std::min(to_cell(max_y, min_y_, height_), static_cast<int64_t>(height_) - 1);
+  if (last_x < first_x || last_y < first_y) {
+    return;
+  }
+
+  for (int64_t iy = first_y; iy <= last_y; ++iy) {
+    // the cells of a row are consecutive, so a row is a single range of indices
+    const size_t row = static_cast<size_t>(iy) * width_;
+    const size_t first = cell_offsets_[row + static_cast<size_t>(first_x)];
+    const size_t last = cell_offsets_[row + static_cast<size_t>(last_x) + 1];
+    indices.insert(indices.end(), indices_.begin() + first, indices_.begin() + last);
+  }
+}
+}  // namespace perception_utils
@@ -0,0 +1,151 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "perception_utils/centroid_grid.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+constexpr double kInf = std::numeric_limits<double>::infinity();
+
+std::vector<size_t> bruteForceQuery(
+  const std::vector<double> & xs, const std::vector<double> & ys, const double x, const double y,
+  const double radius)
+{
+  std::vector<size_t> indices;
+  for (size_t i = 0; i < xs.size(); ++i) {
+    const double dx = xs.at(i) - x;
+    const double dy = ys.at(i) - y;
+    if (std::isfinite(dx) && std::isfinite(dy) && dx * dx + dy * dy <= radius * radius) {
+      indices.push_back(i);
+    }
+  }
+  return indices;
+}
+
+bool contains(const std::vector<size_t> & indices, const size_t index)
+{
+  return std::find(indices.begin(), indices.end(), index) != indices.end();
+}
+}  // namespace
+
+TEST(centroid_grid, query)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> position(-50.0, 50.0);
+  std::uniform_real_distribution<double> radius(0.0, 20.0);
+
+  std::vector<double> xs;
+  std::vector<double> ys;
+  for (size_t i = 0; i < 300; ++i) {
+    xs.push_back(position(engine));
+    ys.push_back(position(engine));
+  }
+  xs.at(10) = kNaN;
+  ys.at(20) = kInf;
+
+  perception_utils::CentroidGrid grid;
+  std::vector<size_t> indices;
+  for (const double cell_size : {0.0, 1.0, 5.0, 200.0, kInf}) {
+    grid.build(xs, ys, cell_size);
+    for (size_t i = 0; i < 100; ++i) {
+      const double x = position(engine);
+      const double y = position(engine);
+      const double r = radius(engine);
+      grid.query(x, y, r, indices);
+      EXPECT_EQ(indices, bruteForceQuery(xs, ys, x, y, r));
+    }
+  }
+
+  // Invalid queries
+  grid.build(xs, ys, 5.0);
+  grid.query(kNaN, 0.0, 10.0, indices);
+  EXPECT_TRUE(indices.empty());
+  grid.query(0.0, 0.0, -1.0, indices);
+  EXPECT_TRUE(indices.empty());
+
+  // Empty
+  grid.build(std::vector<double>{}, std::vector<double>{}, 5.0);
+  grid.query(0.0, 0.0, 10.0, indices);
+  EXPECT_TRUE(indices.empty());
+}
+
+TEST(centroid_grid, queryBox)
+{
+  const std::vector<double> xs{0.0, 3.0, 10.0, 20.0, kNaN};
+  const std::vector<double> ys{0.0, 3.0, 10.0, -20.0, 0.0};
+
+  perception_utils::CentroidGrid grid;
+  grid.build(xs, ys, 4.0);
+
+  std::vector<size_t> indices;
+  grid.queryBox(-1.0, -1.0, 4.0, 4.0, indices);
+  EXPECT_TRUE(contains(indices, 0));
+  EXPECT_TRUE(contains(indices, 1));
+  EXPECT_FALSE(contains(indices, 3));
+  EXPECT_FALSE(contains(indices, 4));
+  EXPECT_TRUE(std::is_sorted(indices.begin(), indices.end()));
+
+  // Out of the grid
+  grid.queryBox(100.0, 100.0, 110.0, 110.0, indices);
+  EXPECT_TRUE(indices.empty());
+
+  // Not finite
+  grid.queryBox(kNaN, 0.0, 1.0, 1.0, indices);
+  EXPECT_TRUE(indices.empty());
+}
+
+TEST(centroid_grid, queryCandidates)
+{
+  std::mt19937 engine(1);
+  std::uniform_real_distribution<double> position(-50.0, 50.0);
+
+  std::vector<double> xs;
+  std::vector<double> ys;
+  for (size_t i = 0; i < 300; ++i) {
+    xs.push_back(position(engine));
+    ys.push_back(position(engine));
+  }
+  xs.at(5) = kNaN;
+
+  perception_utils::CentroidGrid grid;
+  grid.build(xs, ys, 3.0);
+
+  // A superset of the points within the radius, with the non-finite one
+  std::vector<size_t> indices;
+  for (size_t i = 0; i < 100; ++i) {
+    const double x = position(engine);
+    const double y = position(engine);
+    grid.queryCandidates(x, y, 3.0, indices);
+    EXPECT_TRUE(std::is_sorted(indices.begin(), indices.end()));
+    EXPECT_TRUE(contains(indices, 5));
+    for (const size_t index : bruteForceQuery(xs, ys, x, y, 3.0)) {
+      EXPECT_TRUE(contains(indices, index));
+    }
+  }
+
+  // All the points for a non-finite query
+  grid.queryCandidates(kNaN, 0.0, 3.0, indices);
+  EXPECT_EQ(indices.size(), xs.size());
+  grid.queryCandidates(0.0, 0.0, kInf, indices);
+  EXPECT_EQ(indices.size(), xs.size());
+}
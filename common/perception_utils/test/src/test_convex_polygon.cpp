@@ -0,0 +1,139 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "perception_utils/convex_polygon.hpp"
+
+#include <boost/geometry.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+using perception_utils::ConvexPolygon2d;
+using tier4_autoware_utils::Point2d;
+using tier4_autoware_utils::Polygon2d;
+
+namespace
+{
+Polygon2d createRectangle(
+  const double x, const double y, const double yaw, const double length, const double width)
+{
+  Polygon2d polygon;
+  const std::vector<std::pair<double, double>> offsets{
+    {length / 2.0, width / 2.0},
+    {length / 2.0, -width / 2.0},
+    {-length / 2.0, -width / 2.0},
+    {-length / 2.0, width / 2.0}};
+  for (const auto & [lon, lat] : offsets) {
+    polygon.outer().emplace_back(
+      x + lon * std::cos(yaw) - lat * std::sin(yaw), y + lon * std::sin(yaw) + lat * std::cos(yaw));
+  }
+  boost::geometry::correct(polygon);
+  return polygon;
+}
+
+double getBoostIntersectionArea(const Polygon2d & poly1, const Polygon2d & poly2)
+{
+  std::vector<Polygon2d> intersection_polygons;
+  boost::geometry::intersection(poly1, poly2, intersection_polygons);
+  double area = 0.0;
+  for (const auto & polygon : intersection_polygons) {
+    area += boost::geometry::area(polygon);
+  }
+  return area;
+}
+}  // namespace
+
+TEST(convex_polygon, test_toConvexPolygon2d)
+{
+  using perception_utils::toConvexPolygon2d;
+
+  {  // clockwise rectangle
+    ConvexPolygon2d convex_polygon;
+    EXPECT_TRUE(toConvexPolygon2d(createRectangle(1.0, 2.0, 0.3, 4.0, 2.0), convex_polygon));
+    EXPECT_EQ(convex_polygon.size, 4u);
+    EXPECT_NEAR(convex_polygon.area, 8.0, 1e-9);
+  }
+
+  {  // concave polygon
+    Polygon2d polygon;
+    polygon.outer() = {
+      Point2d(0.0, 0.0), Point2d(0.0, 2.0), Point2d(1.0, 1.0), Point2d(2.0, 2.0),
+      Point2d(2.0, 0.0)};
+    boost::geometry::correct(polygon);
+    ConvexPolygon2d convex_polygon;
+    EXPECT_FALSE(toConvexPolygon2d(polygon, convex_polygon));
+  }
+
+  {  // too few points
+    Polygon2d polygon;
+    polygon.outer() = {Point2d(0.0, 0.0), Point2d(1.0, 0.0), Point2d(0.0, 0.0)};
+    ConvexPolygon2d convex_polygon;
+    EXPECT_FALSE(toConvexPolygon2d(polygon, convex_polygon));
+  }
+}
+
+TEST(convex_polygon, test_getConvexIntersectionArea)
+{
+  using perception_utils::getConvexIntersectionArea;
+  using perception_utils::toConvexPolygon2d;
+
+  const Polygon2d base_polygon = createRectangle(0.0, 0.0, 0.0, 4.0, 2.0);
+  ConvexPolygon2d base_convex_polygon;
+  ASSERT_TRUE(toConvexPolygon2d(base_polygon, base_convex_polygon));
+
+  // compare with boost::geometry on rotated and shifted rectangles
+  for (int i = 0; i < 50; ++i) {
+    const double x = -4.0 + 0.16 * i;
+    const double y = std::sin(i) * 1.5;
+    const double yaw = 0.37 * i;
+    const Polygon2d polygon = createRectangle(x, y, yaw, 3.0, 1.5);
+    ConvexPolygon2d convex_polygon;
+    ASSERT_TRUE(toConvexPolygon2d(polygon, convex_polygon));
+
+    const auto area = getConvexIntersectionArea(base_convex_polygon, convex_polygon);
+    ASSERT_TRUE(area);
+    EXPECT_NEAR(*area, getBoostIntersectionArea(base_polygon, polygon), 1e-6);
+  }
+
+  {  // identical polygons
+    const auto area = getConvexIntersectionArea(base_convex_polygon, base_convex_polygon);
+    ASSERT_TRUE(area);
+    EXPECT_NEAR(*area, 8.0, 1e-9);
+  }
+
+  {  // far polygons are rejected by their bounding boxes
+    ConvexPolygon2d convex_polygon;
+    ASSERT_TRUE(toConvexPolygon2d(createRectangle(10.0, 0.0, 0.0, 4.0, 2.0), convex_polygon));
+    const auto area = getConvexIntersectionArea(base_convex_polygon, convex_polygon);
+    ASSERT_TRUE(area);
+    EXPECT_DOUBLE_EQ(*area, 0.0);
+  }
+}
+
+TEST(convex_polygon, test_getConvexHullArea)
+{
+  using perception_utils::getConvexHullArea;
+  using perception_utils::toConvexPolygon2d;
+
+  ConvexPolygon2d convex_polygon1;
+  ConvexPolygon2d convex_polygon2;
+  ASSERT_TRUE(toConvexPolygon2d(createRectangle(0.0, 0.0, 0.0, 2.0, 2.0), convex_polygon1));
+  ASSERT_TRUE(toConvexPolygon2d(createRectangle(2.0, 2.0, 0.0, 2.0, 2.0), convex_polygon2));
+
+  // hexagon (-1, -1), (1, -1), (3, 1), (3, 3), (1, 3), (-1, 1)
+  EXPECT_NEAR(getConvexHullArea(convex_polygon1, convex_polygon2), 12.0, 1e-9);
+  EXPECT_NEAR(getConvexHullArea(convex_polygon1, convex_polygon1), 4.0, 1e-9);
+}
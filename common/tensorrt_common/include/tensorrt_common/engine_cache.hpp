@@ -0,0 +1,74 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORRT_COMMON__ENGINE_CACHE_HPP_
+#define TENSORRT_COMMON__ENGINE_CACHE_HPP_
+
+#include <tensorrt_common/tensorrt_common.hpp>
+
+#include <NvInfer.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace tensorrt_common
+{
+// The engines deserialized in this process, by engine file.
+//
+// The nodes loading the same engine file, e.g. several instances of a detector run in a single
+// component container, share one engine, and only create their own execution context, so that
+// the weights are on the GPU once. An engine is released when its last user is destroyed.
+class EngineCache
+{
+public:
+  static EngineCache & getInstance();
+
+  // the runtime deserializing all the engines of the process
+  nvinfer1::IRuntime & getRuntime() { return *runtime_; }
+
+  // the engine of the file, deserialized unless another user already loaded it
+  std::shared_ptr<nvinfer1::ICudaEngine> load(const std::string & engine_file_path);
+
+  // make engine, deserialized by getRuntime(), the shared engine of the file
+  std::shared_ptr<nvinfer1::ICudaEngine> add(
+    const std::string & engine_file_path, nvinfer1::ICudaEngine * engine);
+
+  // engine deserialized by getRuntime() from the blob, not shared until it is added
+  std::shared_ptr<nvinfer1::ICudaEngine> deserialize(const void * blob, const size_t size);
+
+  // make engine, deserialized by getRuntime(), the shared engine of the file
+  void add(
+    const std::string & engine_file_path, const std::shared_ptr<nvinfer1::ICudaEngine> & engine);
+
+  // held while building the engine of the file, so that it is built only once in this process
+  std::unique_lock<std::mutex> lockBuild(const std::string & engine_file_path);
+
+private:
+  EngineCache();
+
+  std::shared_ptr<nvinfer1::ICudaEngine> find(const std::string & key);
+
+  // the runtime keeps a reference to the logger
+  Logger logger_;
+  TrtUniquePtr<nvinfer1::IRuntime> runtime_;
+  std::mutex mutex_;
+  std::map<std::string, std::weak_ptr<nvinfer1::ICudaEngine>> engines_;
+  std::map<std::string, std::unique_ptr<std::mutex>> build_mutexes_;
+};
+
+}  // namespace tensorrt_common
+
+#endif  // TENSORRT_COMMON__ENGINE_CACHE_HPP_
@@ -19,6 +19,7 @@
 
 #include <NvInfer.h>
 #include <NvOnnxParser.h>
+#include <cuda_runtime_api.h>
 
 #if (defined(_MSC_VER) or (defined(__GNUC__) and (7 <= __GNUC_MAJOR__)))
 #include <filesystem>
@@ -28,6 +29,7 @@ namespace fs = ::std::filesystem;
 namespace fs = ::std::experimental::filesystem;
 #endif
 
+#include <functional>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -100,6 +102,7 @@ public:
     std::unique_ptr<nvinfer1::IInt8EntropyCalibrator2> calibrator = nullptr,
     const BatchConfig & batch_config = {1, 1, 1}, const size_t max_workspace_size = (16 << 20),
     const std::vector<std::string> & plugin_paths = {});
+  ~TrtCommon();
 
   bool loadEngine(const std::string & engine_file_path);
   bool buildEngineFromOnnx(
@@ -113,11 +116,24 @@ public:
   bool setBindingDimensions(const int32_t index, const nvinfer1::Dims & dimensions) const;
   bool enqueueV2(void ** bindings, cudaStream_t stream, cudaEvent_t * input_consumed);
 
+  /**
+   * @brief run the sequence launched by `launch` on `stream` as a CUDA graph
+   * @details The sequence is run eagerly once, so that TensorRT finishes its lazy initialization,
+   *          then captured and replayed on the following calls. The sequence must only contain
+   *          asynchronous work on `stream`, and the buffers it uses must stay at the same
+   *          addresses; only their content may change between the calls. The graph is captured
+   *          again when the binding dimensions change, and the sequence is run eagerly if the
+   *          capture fails.
+   */
+  bool launchWithCudaGraph(cudaStream_t stream, const std::function<bool(cudaStream_t)> & launch);
+  // discard the captured graph, e.g. when the buffers used by the sequence are reallocated
+  void resetCudaGraph();
+
 private:
   Logger logger_;
   fs::path model_file_path_;
-  TrtUniquePtr<nvinfer1::IRuntime> runtime_;
-  TrtUniquePtr<nvinfer1::ICudaEngine> engine_;
+  // shared with the other instances of this process loading the same engine file
+  std::shared_ptr<nvinfer1::ICudaEngine> engine_;
   TrtUniquePtr<nvinfer1::IExecutionContext> context_;
   std::unique_ptr<nvinfer1::IInt8EntropyCalibrator2> calibrator_;
 
@@ -127,6 +143,11 @@ private:
   BatchConfig batch_config_;
   size_t max_workspace_size_;
   bool is_initialized_{false};
+
+  cudaGraphExec_t graph_exec_{nullptr};
+  std::vector<nvinfer1::Dims> graph_binding_dims_;
+  bool is_graph_warmed_up_{false};
+  bool is_graph_disabled_{false};
 };
 
 }  // namespace tensorrt_common
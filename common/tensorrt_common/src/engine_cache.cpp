@@ -0,0 +1,124 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <tensorrt_common/engine_cache.hpp>
+
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+
+namespace tensorrt_common
+{
+namespace
+{
+// the same file may be given by different paths
+std::string toKey(const std::string & engine_file_path)
+{
+  return fs::weakly_canonical(fs::path(engine_file_path)).string();
+}
+
+std::shared_ptr<nvinfer1::ICudaEngine> makeShared(nvinfer1::ICudaEngine * engine)
+{
+  return std::shared_ptr<nvinfer1::ICudaEngine>(engine, InferDeleter<nvinfer1::ICudaEngine>());
+}
+}  // namespace
+
+EngineCache::EngineCache()
+: runtime_(TrtUniquePtr<nvinfer1::IRuntime>(nvinfer1::createInferRuntime(logger_)))
+{
+}
+
+EngineCache & EngineCache::getInstance()
+{
+  static EngineCache engine_cache;
+  return engine_cache;
+}
+
+std::shared_ptr<nvinfer1::ICudaEngine> EngineCache::find(const std::string & key)
+{
+  const auto it = engines_.find(key);
+  return it == engines_.end() ? nullptr : it->second.lock();
+}
+
+std::shared_ptr<nvinfer1::ICudaEngine> EngineCache::load(const std::string & engine_file_path)
+{
+  const auto key = toKey(engine_file_path);
+  std::scoped_lock lock(mutex_);
+  if (auto engine = find(key)) {
+    return engine;
+  }
+
+  std::ifstream engine_file(engine_file_path);
+  std::stringstream engine_buffer;
+  engine_buffer << engine_file.rdbuf();
+  const std::string engine_str = engine_buffer.str();
+  auto * engine = runtime_->deserializeCudaEngine(
+    reinterpret_cast<const void *>(engine_str.data()), engine_str.size());
+  if (!engine) {
+    return nullptr;
+  }
+  auto shared_engine = makeShared(engine);
+  engines_[key] = shared_engine;
+  return shared_engine;
+}
+
+std::shared_ptr<nvinfer1::ICudaEngine> EngineCache::add(
+  const std::string & engine_file_path, nvinfer1::ICudaEngine * engine)
+{
+  if (!engine) {
+    return nullptr;
+  }
+  auto shared_engine = makeShared(engine);
+  const auto key = toKey(engine_file_path);
+  std::scoped_lock lock(mutex_);
+  engines_[key] = shared_engine;
+  return shared_engine;
+}
+
+std::shared_ptr<nvinfer1::ICudaEngine> EngineCache::deserialize(
+  const void * blob, const size_t size)
+{
+  std::scoped_lock lock(mutex_);
+  auto * engine = runtime_->deserializeCudaEngine(blob, size);
+  return engine ? makeShared(engine) : nullptr;
+}
+
+void EngineCache::add(
+  const std::string & engine_file_path, const std::shared_ptr<nvinfer1::ICudaEngine> & engine)
+{
+  if (!engine) {
+    return;
+  }
+  const auto key = toKey(engine_file_path);
+  std::scoped_lock lock(mutex_);
+  engines_[key] = engine;
+}
+
+std::unique_lock<std::mutex> EngineCache::lockBuild(const std::string & engine_file_path)
+{
+  std::mutex * build_mutex{nullptr};
+  {
+    std::scoped_lock lock(mutex_);
+    auto & mutex = build_mutexes_[toKey(engine_file_path)];
+    if (!mutex) {
+      mutex = std::make_unique<std::mutex>();
+    }
+    build_mutex = mutex.get();
+  }
+  return std::unique_lock<std::mutex>(*build_mutex);
+}
+
+}  // namespace tensorrt_common
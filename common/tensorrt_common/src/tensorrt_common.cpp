@@ -12,11 +12,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <tensorrt_common/engine_cache.hpp>
 #include <tensorrt_common/tensorrt_common.hpp>
 
 #include <NvInferPlugin.h>
 #include <dlfcn.h>
 
+#include <algorithm>
 #include <fstream>
 #include <functional>
 #include <memory>
@@ -52,10 +54,11 @@ TrtCommon::TrtCommon(
       logger_.log(nvinfer1::ILogger::Severity::kERROR, "Could not load plugin library");
     }
   }
-  runtime_ = TrtUniquePtr<nvinfer1::IRuntime>(nvinfer1::createInferRuntime(logger_));
   initLibNvInferPlugins(&logger_, "");
 }
 
+TrtCommon::~TrtCommon() { resetCudaGraph(); }
+
 void TrtCommon::setup()
 {
   if (!fs::exists(model_file_path_)) {
@@ -67,6 +70,8 @@ void TrtCommon::setup()
   } else if (model_file_path_.extension() == ".onnx") {
     fs::path cache_engine_path{model_file_path_};
     cache_engine_path.replace_extension("engine");
+    // another node of this process may be building the same engine
+    const auto build_lock = EngineCache::getInstance().lockBuild(cache_engine_path);
     if (fs::exists(cache_engine_path)) {
       loadEngine(cache_engine_path);
     } else {
@@ -78,7 +83,13 @@ void TrtCommon::setup()
     is_initialized_ = false;
     return;
   }
+  if (!engine_) {
+    logger_.log(nvinfer1::ILogger::Severity::kERROR, "Fail to load engine");
+    is_initialized_ = false;
+    return;
+  }
 
+  // the engine may be shared, but the context is of this instance
   context_ = TrtUniquePtr<nvinfer1::IExecutionContext>(engine_->createExecutionContext());
   if (!context_) {
     logger_.log(nvinfer1::ILogger::Severity::kERROR, "Fail to create context");
@@ -91,13 +102,8 @@ void TrtCommon::setup()
 
 bool TrtCommon::loadEngine(const std::string & engine_file_path)
 {
-  std::ifstream engine_file(engine_file_path);
-  std::stringstream engine_buffer;
-  engine_buffer << engine_file.rdbuf();
-  std::string engine_str = engine_buffer.str();
-  engine_ = TrtUniquePtr<nvinfer1::ICudaEngine>(runtime_->deserializeCudaEngine(
-    reinterpret_cast<const void *>(engine_str.data()), engine_str.size()));
-  return true;
+  engine_ = EngineCache::getInstance().load(engine_file_path);
+  return engine_ != nullptr;
 }
 
 bool TrtCommon::buildEngineFromOnnx(
@@ -170,10 +176,13 @@ bool TrtCommon::buildEngineFromOnnx(
     logger_.log(nvinfer1::ILogger::Severity::kERROR, "Fail to create host memory");
     return false;
   }
-  engine_ = TrtUniquePtr<nvinfer1::ICudaEngine>(
-    runtime_->deserializeCudaEngine(plan->data(), plan->size()));
+  auto & engine_cache = EngineCache::getInstance();
+  engine_ = engine_cache.add(
+    output_engine_file_path,
+    engine_cache.getRuntime().deserializeCudaEngine(plan->data(), plan->size()));
 #else
-  engine_ = TrtUniquePtr<nvinfer1::ICudaEngine>(builder->buildEngineWithConfig(*network, *config));
+  engine_ = EngineCache::getInstance().add(
+    output_engine_file_path, builder->buildEngineWithConfig(*network, *config));
 #endif
 
   if (!engine_) {
@@ -220,4 +229,72 @@ bool TrtCommon::enqueueV2(void ** bindings, cudaStream_t stream, cudaEvent_t * i
   return context_->enqueueV2(bindings, stream, input_consumed);
 }
 
+bool TrtCommon::launchWithCudaGraph(
+  cudaStream_t stream, const std::function<bool(cudaStream_t)> & launch)
+{
+  if (is_graph_disabled_ || !context_ || !context_->allInputDimensionsSpecified()) {
+    return launch(stream);
+  }
+
+  // the graph holds the shapes of the capture, so it is captured again when they change
+  std::vector<nvinfer1::Dims> binding_dims;
+  for (int32_t i = 0; i < engine_->getNbBindings(); ++i) {
+    binding_dims.push_back(context_->getBindingDimensions(i));
+  }
+  const auto is_same_dims = [](const nvinfer1::Dims & a, const nvinfer1::Dims & b) {
+    return a.nbDims == b.nbDims && std::equal(a.d, a.d + a.nbDims, b.d);
+  };
+  if (
+    graph_exec_ && !std::equal(
+                     binding_dims.begin(), binding_dims.end(), graph_binding_dims_.begin(),
+                     graph_binding_dims_.end(), is_same_dims)) {
+    resetCudaGraph();
+  }
+
+  if (graph_exec_) {
+    return cudaGraphLaunch(graph_exec_, stream) == cudaSuccess;
+  }
+
+  // TensorRT allocates some of its resources on the first enqueue, which can not be captured
+  if (!is_graph_warmed_up_) {
+    is_graph_warmed_up_ = true;
+    return launch(stream);
+  }
+
+  cudaGraph_t graph{nullptr};
+  bool is_captured = false;
+  if (cudaStreamBeginCapture(stream, cudaStreamCaptureModeThreadLocal) == cudaSuccess) {
+    const bool is_launched = launch(stream);
+    is_captured = cudaStreamEndCapture(stream, &graph) == cudaSuccess && is_launched;
+  }
+  if (is_captured) {
+    is_captured = cudaGraphInstantiateWithFlags(&graph_exec_, graph, 0) == cudaSuccess;
+  }
+  if (graph) {
+    cudaGraphDestroy(graph);
+  }
+  if (!is_captured) {
+    // nothing was run while capturing, so run the sequence eagerly from now on
+    graph_exec_ = nullptr;
+    is_graph_disabled_ = true;
+    static_cast<void>(cudaGetLastError());
+    logger_.log(
+      nvinfer1::ILogger::Severity::kWARNING,
+      "Fail to capture a CUDA graph, the inference is launched without it");
+    return launch(stream);
+  }
+
+  graph_binding_dims_ = binding_dims;
+  return cudaGraphLaunch(graph_exec_, stream) == cudaSuccess;
+}
+
+void TrtCommon::resetCudaGraph()
+{
+  if (graph_exec_) {
+    cudaGraphExecDestroy(graph_exec_);
+    graph_exec_ = nullptr;
+  }
+  graph_binding_dims_.clear();
+}
+
 }  // namespace tensorrt_common
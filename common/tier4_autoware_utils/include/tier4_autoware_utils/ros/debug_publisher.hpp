@@ -23,7 +23,9 @@
 
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 
 namespace tier4_autoware_utils
 {
@@ -52,11 +54,7 @@ public:
     std::enable_if_t<rosidl_generator_traits::is_message<T>::value, std::nullptr_t> = nullptr>
   void publish(const std::string & name, const T & data, const rclcpp::QoS & qos = rclcpp::QoS(1))
   {
-    if (pub_map_.count(name) == 0) {
-      pub_map_[name] = node_->create_publisher<T>(std::string(ns_) + "/" + name, qos);
-    }
-
-    std::dynamic_pointer_cast<rclcpp::Publisher<T>>(pub_map_.at(name))->publish(data);
+    getPublisher<T>(name, qos)->publish(data);
   }
 
   template <
@@ -67,6 +65,56 @@ public:
     publish(name, debug_publisher::toDebugMsg<T_msg>(data, node_->now()), qos);
   }
 
+  /**
+   * @brief get the publisher of a topic, which is created on the first call
+   * @details The returned handle can be kept by the caller to publish without looking up the
+   *          publisher by name on every call.
+   */
+  template <
+    class T,
+    std::enable_if_t<rosidl_generator_traits::is_message<T>::value, std::nullptr_t> = nullptr>
+  typename rclcpp::Publisher<T>::SharedPtr getPublisher(
+    const std::string & name, const rclcpp::QoS & qos = rclcpp::QoS(1))
+  {
+    auto itr = pub_map_.find(name);
+    if (itr == pub_map_.end()) {
+      itr = pub_map_.emplace(name, node_->create_publisher<T>(std::string(ns_) + "/" + name, qos))
+              .first;
+    }
+
+    return std::dynamic_pointer_cast<rclcpp::Publisher<T>>(itr->second);
+  }
+
+  /**
+   * @brief publish the message made by generator only when the topic has subscribers
+   * @details generator is a callable returning the message, and it is not called at all when
+   *          nobody subscribes. Publishers with transient local durability always publish so that
+   *          late subscribers receive the latest message.
+   */
+  template <class F>
+  void publishIfSubscribed(
+    const std::string & name, F && generator, const rclcpp::QoS & qos = rclcpp::QoS(1))
+  {
+    using T = std::decay_t<std::invoke_result_t<F>>;
+    publishIfSubscribed(getPublisher<T>(name, qos), std::forward<F>(generator));
+  }
+
+  template <class T, class F>
+  static void publishIfSubscribed(
+    const std::shared_ptr<rclcpp::Publisher<T>> & publisher, F && generator)
+  {
+    if (hasSubscribers(*publisher)) {
+      publisher->publish(std::forward<F>(generator)());
+    }
+  }
+
+  static bool hasSubscribers(const rclcpp::PublisherBase & publisher)
+  {
+    return publisher.get_subscription_count() > 0 ||
+           publisher.get_intra_process_subscription_count() > 0 ||
+           publisher.get_actual_qos().durability() == rclcpp::DurabilityPolicy::TransientLocal;
+  }
+
 private:
   rclcpp::Node * node_;
   const char * ns_;
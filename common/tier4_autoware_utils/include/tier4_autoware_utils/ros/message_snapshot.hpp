@@ -0,0 +1,69 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TIER4_AUTOWARE_UTILS__ROS__MESSAGE_SNAPSHOT_HPP_
+#define TIER4_AUTOWARE_UTILS__ROS__MESSAGE_SNAPSHOT_HPP_
+
+#include <rclcpp/serialization.hpp>
+#include <rclcpp/serialized_message.hpp>
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace tier4_autoware_utils
+{
+// A snapshot is a single message in CDR, i.e. exactly the serialized_data of a rosbag2 message,
+// so that benchmarks and tests can replay inputs recorded on the vehicle.
+template <class T>
+void writeMessageSnapshot(const T & msg, const std::string & path)
+{
+  rclcpp::Serialization<T> serialization;
+  rclcpp::SerializedMessage serialized_msg;
+  serialization.serialize_message(&msg, &serialized_msg);
+
+  const auto & rcl_msg = serialized_msg.get_rcl_serialized_message();
+  std::ofstream ofs(path, std::ios::binary);
+  ofs.write(reinterpret_cast<const char *>(rcl_msg.buffer), rcl_msg.buffer_length);
+  if (!ofs) {
+    throw std::runtime_error("failed to write the message snapshot " + path);
+  }
+}
+
+template <class T>
+T readMessageSnapshot(const std::string & path)
+{
+  std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+  if (!ifs) {
+    throw std::runtime_error("failed to open the message snapshot " + path);
+  }
+  const auto size = static_cast<size_t>(ifs.tellg());
+  ifs.seekg(0);
+
+  rclcpp::SerializedMessage serialized_msg(size);
+  auto & rcl_msg = serialized_msg.get_rcl_serialized_message();
+  ifs.read(reinterpret_cast<char *>(rcl_msg.buffer), size);
+  if (!ifs) {
+    throw std::runtime_error("failed to read the message snapshot " + path);
+  }
+  rcl_msg.buffer_length = size;
+
+  T msg;
+  rclcpp::Serialization<T> serialization;
+  serialization.deserialize_message(&serialized_msg, &msg);
+  return msg;
+}
+}  // namespace tier4_autoware_utils
+
+#endif  // TIER4_AUTOWARE_UTILS__ROS__MESSAGE_SNAPSHOT_HPP_
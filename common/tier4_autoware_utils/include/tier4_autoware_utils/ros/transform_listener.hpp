@@ -23,11 +23,19 @@
 #include <tf2_ros/create_timer_ros.h>
 #include <tf2_ros/transform_listener.h>
 
+#include <chrono>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <tuple>
 
 namespace tier4_autoware_utils
 {
+// NOTE: Transforms are cached for each frame pair. A pair whose latest transform has a zero stamp
+//       consists only of static transforms, and it is returned without looking up the buffer
+//       until static_cache_period_ passes. A transform at a specific stamp is memoized so that
+//       several lookups of the same pair at the same stamp in a cycle share one result.
 class TransformListener
 {
 public:
@@ -44,6 +52,10 @@ public:
   geometry_msgs::msg::TransformStamped::ConstSharedPtr getLatestTransform(
     const std::string & from, const std::string & to)
   {
+    if (auto transform = findStaticTransform(from, to)) {
+      return transform;
+    }
+
     geometry_msgs::msg::TransformStamped tf;
     try {
       tf = tf_buffer_->lookupTransform(from, to, tf2::TimePointZero);
@@ -53,32 +65,132 @@ public:
       return {};
     }
 
-    return std::make_shared<const geometry_msgs::msg::TransformStamped>(tf);
+    auto transform = std::make_shared<const geometry_msgs::msg::TransformStamped>(tf);
+    std::lock_guard<std::mutex> lock(mutex_);
+    updateStaticCache(getCache(from, to), transform);
+    return transform;
   }
 
   geometry_msgs::msg::TransformStamped::ConstSharedPtr getTransform(
     const std::string & from, const std::string & to, const rclcpp::Time & time,
     const rclcpp::Duration & duration)
   {
+    bool needs_static_check{false};
+    geometry_msgs::msg::TransformStamped::ConstSharedPtr static_transform;
+    geometry_msgs::msg::TransformStamped::ConstSharedPtr stamped_transform;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      const auto & cache = getCache(from, to);
+      needs_static_check =
+        !cache.is_static_checked || (cache.static_transform && !isStaticCacheValid(cache));
+      if (isStaticCacheValid(cache)) {
+        static_transform = cache.static_transform;
+      }
+      stamped_transform = cache.stamped_transform;
+    }
+
+    if (needs_static_check) {
+      try {
+        auto latest_transform = std::make_shared<const geometry_msgs::msg::TransformStamped>(
+          tf_buffer_->lookupTransform(from, to, tf2::TimePointZero));
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto & cache = getCache(from, to);
+        updateStaticCache(cache, latest_transform);
+        static_transform = cache.static_transform;
+      } catch (tf2::TransformException &) {
+        // the pair is checked again in the next call
+      }
+    }
+
+    // a zero stamp means the latest transform, which must be looked up every time
+    const bool is_memoizable = time.nanoseconds() != 0;
+    if (
+      is_memoizable && stamped_transform &&
+      rclcpp::Time(stamped_transform->header.stamp).nanoseconds() == time.nanoseconds()) {
+      return stamped_transform;
+    }
+
     geometry_msgs::msg::TransformStamped tf;
-    try {
-      tf = tf_buffer_->lookupTransform(from, to, time, duration);
-    } catch (tf2::TransformException & ex) {
-      RCLCPP_WARN(
-        logger_, "failed to get transform from %s to %s: %s", from.c_str(), to.c_str(), ex.what());
-      return {};
+    if (static_transform) {
+      tf = *static_transform;
+      tf.header.stamp = time;
+    } else {
+      try {
+        tf = tf_buffer_->lookupTransform(from, to, time, duration);
+      } catch (tf2::TransformException & ex) {
+        RCLCPP_WARN(
+          logger_, "failed to get transform from %s to %s: %s", from.c_str(), to.c_str(),
+          ex.what());
+        return {};
+      }
     }
 
-    return std::make_shared<const geometry_msgs::msg::TransformStamped>(tf);
+    auto transform = std::make_shared<const geometry_msgs::msg::TransformStamped>(tf);
+    if (is_memoizable) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      getCache(from, to).stamped_transform = transform;
+    }
+    return transform;
   }
 
   rclcpp::Logger getLogger() { return logger_; }
 
 private:
+  struct TransformCache
+  {
+    bool is_static_checked{false};
+    geometry_msgs::msg::TransformStamped::ConstSharedPtr static_transform;
+    std::chrono::steady_clock::time_point static_expiration;
+    geometry_msgs::msg::TransformStamped::ConstSharedPtr stamped_transform;
+  };
+
+  TransformCache & getCache(const std::string & from, const std::string & to)
+  {
+    // NOTE: the frame names are compared without being copied unless the pair is new
+    const auto itr = caches_.find(std::tie(from, to));
+    if (itr != caches_.end()) {
+      return itr->second;
+    }
+    return caches_[std::make_tuple(from, to)];
+  }
+
+  geometry_msgs::msg::TransformStamped::ConstSharedPtr findStaticTransform(
+    const std::string & from, const std::string & to)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto & cache = getCache(from, to);
+    return isStaticCacheValid(cache) ? cache.static_transform : nullptr;
+  }
+
+  bool isStaticCacheValid(const TransformCache & cache) const
+  {
+    return cache.static_transform && std::chrono::steady_clock::now() < cache.static_expiration;
+  }
+
+  void updateStaticCache(
+    TransformCache & cache,
+    const geometry_msgs::msg::TransformStamped::ConstSharedPtr & latest_transform)
+  {
+    cache.is_static_checked = true;
+    if (rclcpp::Time(latest_transform->header.stamp).nanoseconds() != 0) {
+      cache.static_transform = nullptr;
+      return;
+    }
+    cache.static_transform = latest_transform;
+    cache.static_expiration = std::chrono::steady_clock::now() + static_cache_period_;
+  }
+
+  // static transforms are looked up again after this period in case /tf_static is republished
+  static constexpr std::chrono::seconds static_cache_period_{1};
+
   rclcpp::Clock::SharedPtr clock_;
   rclcpp::Logger logger_;
   std::shared_ptr<tf2_ros::Buffer> tf_buffer_;
   std::shared_ptr<tf2_ros::TransformListener> tf_listener_;
+
+  // guards caches_ only, so that a blocking lookup of the buffer does not stall the other callers
+  std::mutex mutex_;
+  std::map<std::tuple<std::string, std::string>, TransformCache, std::less<>> caches_;
 };
 }  // namespace tier4_autoware_utils
 
@@ -0,0 +1,160 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TIER4_AUTOWARE_UTILS__SYSTEM__BENCHMARK_HPP_
+#define TIER4_AUTOWARE_UTILS__SYSTEM__BENCHMARK_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace tier4_autoware_utils
+{
+struct BenchmarkResult
+{
+  std::string name;
+  std::size_t iterations{0};
+  double min_ms{0.0};
+  double mean_ms{0.0};
+  double median_ms{0.0};
+  double p90_ms{0.0};
+  double max_ms{0.0};
+};
+
+/**
+ * @brief Runs the benchmarks of a suite and reports them in a machine-readable format.
+ *
+ * Command line options:
+ *   --iterations <n>  overrides the number of measured iterations of every benchmark
+ *   --output <path>   writes the results as JSON to path (e.g. for tracking regressions)
+ * Other "--key value" pairs are available through getArgument(), e.g. input snapshot paths.
+ */
+class BenchmarkRunner
+{
+public:
+  BenchmarkRunner(const int argc, const char * const * argv, std::string suite_name)
+  : suite_name_(std::move(suite_name))
+  {
+    for (int i = 1; i + 1 < argc; i += 2) {
+      const std::string key = argv[i];
+      if (key.rfind("--", 0) != 0) {
+        throw std::invalid_argument("unexpected benchmark argument: " + key);
+      }
+      arguments_.emplace_back(key.substr(2), argv[i + 1]);
+    }
+    if (const auto iterations = getArgument("iterations")) {
+      iterations_override_ = std::stoul(*iterations);
+    }
+  }
+
+  std::optional<std::string> getArgument(const std::string & key) const
+  {
+    for (const auto & [k, v] : arguments_) {
+      if (k == key) {
+        return v;
+      }
+    }
+    return std::nullopt;
+  }
+
+  // calls f a tenth of the iterations (at least once) to warm up, then times every call
+  template <class F>
+  const BenchmarkResult & run(const std::string & name, F && f, const std::size_t iterations = 100)
+  {
+    const std::size_t num_iterations = std::max<std::size_t>(
+      1, iterations_override_ ? *iterations_override_ : iterations);
+    for (std::size_t i = 0; i < std::max<std::size_t>(1, num_iterations / 10); ++i) {
+      f();
+    }
+
+    std::vector<double> durations_ms(num_iterations);
+    for (auto & duration_ms : durations_ms) {
+      const auto start = std::chrono::steady_clock::now();
+      f();
+      const auto end = std::chrono::steady_clock::now();
+      duration_ms = std::chrono::duration<double, std::milli>(end - start).count();
+    }
+    std::sort(durations_ms.begin(), durations_ms.end());
+
+    BenchmarkResult result;
+    result.name = name;
+    result.iterations = num_iterations;
+    result.min_ms = durations_ms.front();
+    result.max_ms = durations_ms.back();
+    result.median_ms = durations_ms.at(num_iterations / 2);
+    result.p90_ms = durations_ms.at(std::min(num_iterations - 1, num_iterations * 9 / 10));
+    double sum_ms = 0.0;
+    for (const auto duration_ms : durations_ms) {
+      sum_ms += duration_ms;
+    }
+    result.mean_ms = sum_ms / num_iterations;
+
+    std::cout << std::fixed << std::setprecision(4) << suite_name_ << "/" << name
+              << ": median " << result.median_ms << " ms, p90 " << result.p90_ms << " ms, max "
+              << result.max_ms << " ms (" << num_iterations << " iterations)" << std::endl;
+    results_.push_back(result);
+    return results_.back();
+  }
+
+  const std::vector<BenchmarkResult> & getResults() const { return results_; }
+
+  std::string toJson() const
+  {
+    std::ostringstream ss;
+    ss << std::setprecision(6) << "{\"suite\": \"" << suite_name_ << "\", \"results\": [";
+    for (std::size_t i = 0; i < results_.size(); ++i) {
+      const auto & r = results_.at(i);
+      ss << (i == 0 ? "" : ", ") << "{\"name\": \"" << r.name << "\", \"iterations\": "
+         << r.iterations << ", \"min_ms\": " << r.min_ms << ", \"mean_ms\": " << r.mean_ms
+         << ", \"median_ms\": " << r.median_ms << ", \"p90_ms\": " << r.p90_ms
+         << ", \"max_ms\": " << r.max_ms << "}";
+    }
+    ss << "]}\n";
+    return ss.str();
+  }
+
+  // writes the results if --output was given, returns the exit code of the benchmark
+  int finish() const
+  {
+    const auto output = getArgument("output");
+    if (!output) {
+      return 0;
+    }
+    std::ofstream ofs(*output);
+    ofs << toJson();
+    if (!ofs) {
+      std::cerr << "failed to write the benchmark results to " << *output << std::endl;
+      return 1;
+    }
+    return 0;
+  }
+
+private:
+  std::string suite_name_;
+  std::vector<std::pair<std::string, std::string>> arguments_;
+  std::optional<std::size_t> iterations_override_;
+  std::vector<BenchmarkResult> results_;
+};
+}  // namespace tier4_autoware_utils
+
+#endif  // TIER4_AUTOWARE_UTILS__SYSTEM__BENCHMARK_HPP_
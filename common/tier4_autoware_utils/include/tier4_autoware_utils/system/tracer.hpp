@@ -0,0 +1,206 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TIER4_AUTOWARE_UTILS__SYSTEM__TRACER_HPP_
+#define TIER4_AUTOWARE_UTILS__SYSTEM__TRACER_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Static tracepoints for processing time measurement.
+//
+//   void Node::onTimer()
+//   {
+//     TIER4_TRACE_SCOPE("my_node/on_timer");
+//     ...
+//   }
+//
+// Events are written to a lock-free ring buffer owned by the recording thread and are drained by
+// a TraceExporter, which hands them to its sinks (e.g. TraceHistogramSink). A name used by
+// tracepoints at different source locations is suffixed with the location from the second one on,
+// so that each tracepoint keeps its own histogram. While no exporter
+// exists a tracepoint costs one relaxed atomic load. Define
+// TIER4_AUTOWARE_UTILS_DISABLE_TRACING to compile the tracepoints out entirely.
+
+namespace tier4_autoware_utils
+{
+struct TraceEvent
+{
+  std::uint32_t tracepoint_id;
+  std::uint32_t thread_id;
+  std::int64_t start_ns;  // steady clock
+  std::int64_t duration_ns;
+};
+
+class TracePoint
+{
+public:
+  TracePoint(const char * name, const char * file, const int line);
+
+  std::uint32_t id() const noexcept { return id_; }
+
+private:
+  std::uint32_t id_;
+};
+
+class Tracer
+{
+public:
+  static constexpr std::size_t ring_buffer_capacity = 4096;  // events per thread
+
+  static bool isEnabled() noexcept { return listener_count_.load(std::memory_order_relaxed) > 0; }
+
+  static std::int64_t nowNs() noexcept
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+  }
+
+  // returns the id already registered for the same name and source location, if any
+  static std::uint32_t registerTracePoint(const char * name, const char * file, const int line);
+  static std::string getTracePointName(const std::uint32_t tracepoint_id);
+
+  // called by the recording thread, drops the event when its ring buffer is full
+  static void record(
+    const std::uint32_t tracepoint_id, const std::int64_t start_ns,
+    const std::int64_t duration_ns) noexcept;
+
+  // appends the events of all threads to events, returns the number of appended events
+  static std::size_t drain(std::vector<TraceEvent> & events);
+
+  static std::uint64_t getDroppedEventCount() noexcept;
+
+private:
+  friend class TraceExporter;
+  static std::atomic<std::uint32_t> listener_count_;
+};
+
+class ScopedTrace
+{
+public:
+  explicit ScopedTrace(const TracePoint & tracepoint) noexcept
+  : tracepoint_id_(tracepoint.id()), start_ns_(Tracer::isEnabled() ? Tracer::nowNs() : -1)
+  {
+  }
+  ScopedTrace(const ScopedTrace &) = delete;
+  ScopedTrace & operator=(const ScopedTrace &) = delete;
+  ~ScopedTrace()
+  {
+    if (start_ns_ >= 0) {
+      Tracer::record(tracepoint_id_, start_ns_, Tracer::nowNs() - start_ns_);
+    }
+  }
+
+private:
+  std::uint32_t tracepoint_id_;
+  std::int64_t start_ns_;
+};
+
+class TraceSink
+{
+public:
+  virtual ~TraceSink() = default;
+  // called from the exporter thread
+  virtual void onEvents(const std::vector<TraceEvent> & events) = 0;
+};
+
+// log2 histogram of the durations of one tracepoint
+struct TraceHistogram
+{
+  std::uint64_t count{0};
+  std::int64_t sum_ns{0};
+  std::int64_t min_ns{0};
+  std::int64_t max_ns{0};
+  std::array<std::uint64_t, 64> buckets{};  // bucket i counts durations in [2^(i-1), 2^i) ns
+
+  void add(const std::int64_t duration_ns);
+  double meanMs() const { return count == 0 ? 0.0 : sum_ns * 1e-6 / count; }
+  // upper bound of the bucket holding the q-quantile, i.e. accurate within a factor of two
+  double quantileMs(const double q) const;
+};
+
+class TraceHistogramSink : public TraceSink
+{
+public:
+  void onEvents(const std::vector<TraceEvent> & events) override;
+
+  // keyed by tracepoint name
+  std::map<std::string, TraceHistogram> getHistograms() const;
+  // in the format of ProcessingTimePublisher::publish
+  std::map<std::string, double> getMeanProcessingTimeMs() const;
+  void reset();
+
+private:
+  mutable std::mutex mutex_;
+  std::unordered_map<std::uint32_t, TraceHistogram> histograms_;
+};
+
+/**
+ * @brief Enables the tracepoints while it exists and periodically forwards their events to sinks.
+ *
+ * The exporter thread runs with the lowest scheduling priority so that it does not perturb the
+ * latencies being measured. Without start(), events are only forwarded by flush().
+ * Each event is delivered to only one exporter, so use a single one per process.
+ */
+class TraceExporter
+{
+public:
+  explicit TraceExporter(
+    const std::chrono::milliseconds & period = std::chrono::milliseconds(100));
+  ~TraceExporter();
+  TraceExporter(const TraceExporter &) = delete;
+  TraceExporter & operator=(const TraceExporter &) = delete;
+
+  void addSink(const std::shared_ptr<TraceSink> & sink);
+  void start();
+  void stop();
+  void flush();
+
+private:
+  std::chrono::milliseconds period_;
+  std::mutex mutex_;
+  std::vector<std::shared_ptr<TraceSink>> sinks_;
+  std::vector<TraceEvent> events_;
+  std::mutex thread_mutex_;
+  std::condition_variable cv_;
+  bool is_running_{false};
+  std::thread thread_;
+};
+}  // namespace tier4_autoware_utils
+
+#define TIER4_TRACE_CONCAT_INNER(a, b) a##b
+#define TIER4_TRACE_CONCAT(a, b) TIER4_TRACE_CONCAT_INNER(a, b)
+
+#ifdef TIER4_AUTOWARE_UTILS_DISABLE_TRACING
+#define TIER4_TRACE_SCOPE(name)
+#else
+#define TIER4_TRACE_SCOPE(name)                                                             \
+  static const ::tier4_autoware_utils::TracePoint TIER4_TRACE_CONCAT(                      \
+    tier4_trace_point_, __LINE__)(name, __FILE__, __LINE__);                                \
+  const ::tier4_autoware_utils::ScopedTrace TIER4_TRACE_CONCAT(tier4_trace_scope_, __LINE__)( \
+    TIER4_TRACE_CONCAT(tier4_trace_point_, __LINE__))
+#endif
+
+#endif  // TIER4_AUTOWARE_UTILS__SYSTEM__TRACER_HPP_
@@ -0,0 +1,324 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tier4_autoware_utils/system/tracer.hpp"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <utility>
+
+namespace tier4_autoware_utils
+{
+namespace
+{
+// single producer (the owning thread), single consumer (Tracer::drain under drain_mutex)
+struct ThreadBuffer
+{
+  explicit ThreadBuffer(const std::uint32_t id) : thread_id(id) {}
+
+  const std::uint32_t thread_id;
+  std::array<TraceEvent, Tracer::ring_buffer_capacity> events;
+  std::atomic<std::uint64_t> head{0};
+  std::atomic<std::uint64_t> tail{0};
+  std::atomic<bool> is_retired{false};  // the owning thread has exited
+};
+
+struct Registry
+{
+  std::mutex mutex;
+  std::vector<std::string> tracepoint_names;
+  std::vector<std::string> tracepoint_sources;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  std::uint32_t next_thread_id{0};
+
+  std::mutex drain_mutex;
+  std::atomic<std::uint64_t> dropped_event_count{0};
+};
+
+// never destroyed, threads may still record while static objects are being destroyed
+Registry & getRegistry()
+{
+  static auto * registry = new Registry();
+  return *registry;
+}
+
+struct ThreadBufferHandle
+{
+  std::shared_ptr<ThreadBuffer> buffer;
+  ~ThreadBufferHandle()
+  {
+    if (buffer) {
+      buffer->is_retired.store(true, std::memory_order_release);
+    }
+  }
+};
+
+ThreadBuffer & getThreadBuffer()
+{
+  thread_local ThreadBufferHandle handle;
+  if (!handle.buffer) {
+    auto & registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    handle.buffer = std::make_shared<ThreadBuffer>(registry.next_thread_id++);
+    registry.buffers.push_back(handle.buffer);
+  }
+  return *handle.buffer;
+}
+
+int getBitWidth(const std::int64_t value)
+{
+  return value <= 0 ? 0 : 64 - __builtin_clzll(static_cast<std::uint64_t>(value));
+}
+}  // namespace
+
+std::atomic<std::uint32_t> Tracer::listener_count_{0};
+
+TracePoint::TracePoint(const char * name, const char * file, const int line)
+: id_(Tracer::registerTracePoint(name, file, line))
+{
+}
+
+std::uint32_t Tracer::registerTracePoint(const char * name, const char * file, const int line)
+{
+  std::string source(file);
+  source = source.substr(source.find_last_of('/') + 1) + ":" + std::to_string(line);
+
+  auto & registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto & names = registry.tracepoint_names;
+  auto & sources = registry.tracepoint_sources;
+  const std::string suffixed_name = std::string(name) + " (" + source + ")";
+  bool is_name_used = false;
+  for (std::size_t i = 0; i < names.size(); ++i) {
+    // e.g. the tracepoints of the instances of a function template
+    if (sources.at(i) == source && (names.at(i) == name || names.at(i) == suffixed_name)) {
+      return static_cast<std::uint32_t>(i);
+    }
+    is_name_used |= names.at(i) == name;
+  }
+  names.push_back(is_name_used ? suffixed_name : std::string(name));
+  sources.push_back(source);
+  return static_cast<std::uint32_t>(names.size() - 1);
+}
+
+std::string Tracer::getTracePointName(const std::uint32_t tracepoint_id)
+{
+  auto & registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  return tracepoint_id < registry.tracepoint_names.size()
+           ? registry.tracepoint_names.at(tracepoint_id)
+           : std::string();
+}
+
+void Tracer::record(
+  const std::uint32_t tracepoint_id, const std::int64_t start_ns,
+  const std::int64_t duration_ns) noexcept
+{
+  ThreadBuffer * buffer = nullptr;
+  try {
+    buffer = &getThreadBuffer();
+  } catch (...) {
+    getRegistry().dropped_event_count.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  const auto head = buffer->head.load(std::memory_order_relaxed);
+  const auto tail = buffer->tail.load(std::memory_order_acquire);
+  if (head - tail >= ring_buffer_capacity) {
+    getRegistry().dropped_event_count.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  buffer->events[head % ring_buffer_capacity] =
+    TraceEvent{tracepoint_id, buffer->thread_id, start_ns, duration_ns};
+  buffer->head.store(head + 1, std::memory_order_release);
+}
+
+std::size_t Tracer::drain(std::vector<TraceEvent> & events)
+{
+  auto & registry = getRegistry();
+  std::lock_guard<std::mutex> drain_lock(registry.drain_mutex);
+
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  {
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    buffers = registry.buffers;
+  }
+
+  const auto num_events_before = events.size();
+  bool has_retired_buffer = false;
+  for (const auto & buffer : buffers) {
+    const bool is_retired = buffer->is_retired.load(std::memory_order_acquire);
+    const auto tail = buffer->tail.load(std::memory_order_relaxed);
+    const auto head = buffer->head.load(std::memory_order_acquire);
+    for (auto i = tail; i < head; ++i) {
+      events.push_back(buffer->events[i % ring_buffer_capacity]);
+    }
+    buffer->tail.store(head, std::memory_order_release);
+    has_retired_buffer |= is_retired;
+  }
+
+  // the buffers of exited threads are dropped once they have been drained
+  if (has_retired_buffer) {
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto & all_buffers = registry.buffers;
+    all_buffers.erase(
+      std::remove_if(
+        all_buffers.begin(), all_buffers.end(),
+        [](const auto & buffer) {
+          return buffer->is_retired.load(std::memory_order_acquire) &&
+                 buffer->head.load(std::memory_order_acquire) ==
+                   buffer->tail.load(std::memory_order_relaxed);
+        }),
+      all_buffers.end());
+  }
+
+  return events.size() - num_events_before;
+}
+
+std::uint64_t Tracer::getDroppedEventCount() noexcept
+{
+  return getRegistry().dropped_event_count.load(std::memory_order_relaxed);
+}
+
+void TraceHistogram::add(const std::int64_t duration_ns)
+{
+  min_ns = count == 0 ? duration_ns : std::min(min_ns, duration_ns);
+  max_ns = count == 0 ? duration_ns : std::max(max_ns, duration_ns);
+  ++count;
+  sum_ns += duration_ns;
+  ++buckets.at(std::min<std::size_t>(getBitWidth(duration_ns), buckets.size() - 1));
+}
+
+double TraceHistogram::quantileMs(const double q) const
+{
+  if (count == 0) {
+    return 0.0;
+  }
+  const auto rank = std::max<std::uint64_t>(
+    1, static_cast<std::uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * count)));
+  std::uint64_t cumulative_count = 0;
+  for (std::size_t i = 0; i < buckets.size(); ++i) {
+    cumulative_count += buckets.at(i);
+    if (cumulative_count >= rank) {
+      const auto upper_ns = i < 63 ? static_cast<std::int64_t>(1ULL << i) : max_ns;
+      return std::clamp(upper_ns, min_ns, max_ns) * 1e-6;
+    }
+  }
+  return max_ns * 1e-6;
+}
+
+void TraceHistogramSink::onEvents(const std::vector<TraceEvent> & events)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto & event : events) {
+    histograms_[event.tracepoint_id].add(event.duration_ns);
+  }
+}
+
+std::map<std::string, TraceHistogram> TraceHistogramSink::getHistograms() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::map<std::string, TraceHistogram> histograms;
+  for (const auto & [id, histogram] : histograms_) {
+    histograms.emplace(Tracer::getTracePointName(id), histogram);
+  }
+  return histograms;
+}
+
+std::map<std::string, double> TraceHistogramSink::getMeanProcessingTimeMs() const
+{
+  std::map<std::string, double> processing_time_map;
+  for (const auto & [name, histogram] : getHistograms()) {
+    processing_time_map.emplace(name, histogram.meanMs());
+  }
+  return processing_time_map;
+}
+
+void TraceHistogramSink::reset()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  histograms_.clear();
+}
+
+TraceExporter::TraceExporter(const std::chrono::milliseconds & period) : period_(period)
+{
+  Tracer::listener_count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+TraceExporter::~TraceExporter()
+{
+  stop();
+  Tracer::listener_count_.fetch_sub(1, std::memory_order_relaxed);
+  flush();
+}
+
+void TraceExporter::addSink(const std::shared_ptr<TraceSink> & sink)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  sinks_.push_back(sink);
+}
+
+void TraceExporter::start()
+{
+  std::lock_guard<std::mutex> lock(thread_mutex_);
+  if (is_running_) {
+    return;
+  }
+  is_running_ = true;
+  thread_ = std::thread([this]() {
+#ifdef __linux__
+    sched_param param{};
+    param.sched_priority = 0;
+    pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+#endif
+    std::unique_lock<std::mutex> lock(thread_mutex_);
+    while (!cv_.wait_for(lock, period_, [this]() { return !is_running_; })) {
+      lock.unlock();
+      flush();
+      lock.lock();
+    }
+  });
+}
+
+void TraceExporter::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(thread_mutex_);
+    if (!is_running_) {
+      return;
+    }
+    is_running_ = false;
+  }
+  cv_.notify_all();
+  thread_.join();
+}
+
+void TraceExporter::flush()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  events_.clear();
+  if (Tracer::drain(events_) == 0) {
+    return;
+  }
+  for (const auto & sink : sinks_) {
+    sink->onEvents(events_);
+  }
+}
+}  // namespace tier4_autoware_utils
@@ -0,0 +1,126 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tier4_autoware_utils/ros/transform_listener.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <geometry_msgs/msg/transform_stamped.hpp>
+
+#include <gtest/gtest.h>
+#include <tf2_ros/static_transform_broadcaster.h>
+#include <tf2_ros/transform_broadcaster.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace
+{
+geometry_msgs::msg::TransformStamped makeTransform(
+  const std::string & parent, const std::string & child, const rclcpp::Time & stamp,
+  const double x)
+{
+  geometry_msgs::msg::TransformStamped transform;
+  transform.header.stamp = stamp;
+  transform.header.frame_id = parent;
+  transform.child_frame_id = child;
+  transform.transform.translation.x = x;
+  transform.transform.rotation.w = 1.0;
+  return transform;
+}
+
+// the listener receives the transforms on its own thread
+template <class Lookup>
+geometry_msgs::msg::TransformStamped::ConstSharedPtr waitForTransform(const Lookup & lookup)
+{
+  for (int i = 0; i < 100; ++i) {
+    if (const auto transform = lookup()) {
+      return transform;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+  return nullptr;
+}
+}  // namespace
+
+TEST(transform_listener, static_transform_cache)
+{
+  const auto node = std::make_shared<rclcpp::Node>("test_static_transform_cache");
+  tier4_autoware_utils::TransformListener listener(node.get());
+  tf2_ros::StaticTransformBroadcaster broadcaster(node);
+  broadcaster.sendTransform(makeTransform("base_link", "sensor", rclcpp::Time(0), 1.0));
+
+  const auto first =
+    waitForTransform([&]() { return listener.getLatestTransform("base_link", "sensor"); });
+  ASSERT_TRUE(first);
+  EXPECT_DOUBLE_EQ(first->transform.translation.x, 1.0);
+
+  // hit: the static transform is returned without a new lookup
+  EXPECT_EQ(listener.getLatestTransform("base_link", "sensor"), first);
+
+  // a stamped lookup of a static pair is answered from the cache, with the requested stamp
+  const rclcpp::Time stamp(10, 0);
+  const auto stamped =
+    listener.getTransform("base_link", "sensor", stamp, rclcpp::Duration::from_seconds(0.0));
+  ASSERT_TRUE(stamped);
+  EXPECT_EQ(rclcpp::Time(stamped->header.stamp).nanoseconds(), stamp.nanoseconds());
+  EXPECT_DOUBLE_EQ(stamped->transform.translation.x, 1.0);
+
+  // miss: the static transform is looked up again after the cache period
+  std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+  const auto refreshed = listener.getLatestTransform("base_link", "sensor");
+  ASSERT_TRUE(refreshed);
+  EXPECT_NE(refreshed, first);
+  EXPECT_DOUBLE_EQ(refreshed->transform.translation.x, 1.0);
+}
+
+TEST(transform_listener, stamped_transform_memo)
+{
+  const auto node = std::make_shared<rclcpp::Node>("test_stamped_transform_memo");
+  tier4_autoware_utils::TransformListener listener(node.get());
+  tf2_ros::TransformBroadcaster broadcaster(node);
+
+  const rclcpp::Time stamp1(100, 0);
+  const rclcpp::Time stamp2(101, 0);
+  const auto timeout = rclcpp::Duration::from_seconds(0.0);
+
+  // unknown frames are not found
+  EXPECT_FALSE(listener.getTransform("map", "base_link", stamp1, timeout));
+
+  const auto first = waitForTransform([&]() {
+    broadcaster.sendTransform(makeTransform("map", "base_link", stamp1, 1.0));
+    broadcaster.sendTransform(makeTransform("map", "base_link", stamp2, 2.0));
+    return listener.getTransform("map", "base_link", stamp1, timeout);
+  });
+  ASSERT_TRUE(first);
+  EXPECT_DOUBLE_EQ(first->transform.translation.x, 1.0);
+
+  // hit: the same pair at the same stamp shares the result
+  EXPECT_EQ(listener.getTransform("map", "base_link", stamp1, timeout), first);
+
+  // miss: another stamp is looked up
+  const auto second = listener.getTransform("map", "base_link", stamp2, timeout);
+  ASSERT_TRUE(second);
+  EXPECT_NE(second, first);
+  EXPECT_DOUBLE_EQ(second->transform.translation.x, 2.0);
+
+  // the latest transform is never memoized
+  const auto latest1 = listener.getTransform("map", "base_link", rclcpp::Time(0), timeout);
+  const auto latest2 = listener.getTransform("map", "base_link", rclcpp::Time(0), timeout);
+  ASSERT_TRUE(latest1);
+  ASSERT_TRUE(latest2);
+  EXPECT_NE(latest1, latest2);
+}
@@ -0,0 +1,48 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tier4_autoware_utils/system/benchmark.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+TEST(system, BenchmarkRunner)
+{
+  using tier4_autoware_utils::BenchmarkRunner;
+
+  const char * argv[] = {"benchmark", "--iterations", "20", "--input", "snapshot.cdr"};
+  BenchmarkRunner runner(5, argv, "suite");
+  EXPECT_EQ(runner.getArgument("input"), "snapshot.cdr");
+  EXPECT_FALSE(runner.getArgument("output"));
+
+  int num_calls = 0;
+  const auto & result = runner.run(
+    "sleep",
+    [&num_calls]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      ++num_calls;
+    },
+    1000);
+
+  EXPECT_EQ(result.iterations, 20u);
+  EXPECT_EQ(num_calls, 22);  // with the warm up
+  EXPECT_GE(result.min_ms, 1.0);
+  EXPECT_LE(result.min_ms, result.median_ms);
+  EXPECT_LE(result.median_ms, result.p90_ms);
+  EXPECT_LE(result.p90_ms, result.max_ms);
+  EXPECT_NE(runner.toJson().find("\"name\": \"sleep\""), std::string::npos);
+  EXPECT_EQ(runner.finish(), 0);
+}
@@ -0,0 +1,153 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tier4_autoware_utils/system/tracer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+void tracedFunction()
+{
+  TIER4_TRACE_SCOPE("test/traced_function");
+}
+
+void sameNameFunction()
+{
+  TIER4_TRACE_SCOPE("test/same_name");
+}
+
+void otherSameNameFunction()
+{
+  TIER4_TRACE_SCOPE("test/same_name");
+}
+
+template <typename T>
+void tracedTemplate()
+{
+  TIER4_TRACE_SCOPE("test/traced_template");
+}
+}  // namespace
+
+TEST(system, Tracer_disabled)
+{
+  using tier4_autoware_utils::Tracer;
+
+  EXPECT_FALSE(Tracer::isEnabled());
+  tracedFunction();
+
+  std::vector<tier4_autoware_utils::TraceEvent> events;
+  EXPECT_EQ(Tracer::drain(events), 0u);
+}
+
+TEST(system, Tracer_histogram)
+{
+  using tier4_autoware_utils::TraceExporter;
+  using tier4_autoware_utils::TraceHistogramSink;
+
+  auto sink = std::make_shared<TraceHistogramSink>();
+  {
+    TraceExporter exporter;
+    exporter.addSink(sink);
+    exporter.start();
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+      threads.emplace_back([]() {
+        for (int j = 0; j < 1000; ++j) {
+          tracedFunction();
+        }
+      });
+    }
+    for (auto & thread : threads) {
+      thread.join();
+    }
+  }  // the exporter flushes the remaining events when destroyed
+
+  EXPECT_FALSE(tier4_autoware_utils::Tracer::isEnabled());
+  const auto histograms = sink->getHistograms();
+  ASSERT_EQ(histograms.count("test/traced_function"), 1u);
+  const auto & histogram = histograms.at("test/traced_function");
+  EXPECT_EQ(histogram.count, 4000u);
+  EXPECT_LE(histogram.min_ns, histogram.max_ns);
+  EXPECT_LE(histogram.quantileMs(0.5), histogram.quantileMs(0.99));
+  EXPECT_EQ(sink->getMeanProcessingTimeMs().size(), 1u);
+}
+
+TEST(system, Tracer_overflow)
+{
+  using tier4_autoware_utils::Tracer;
+  using tier4_autoware_utils::TraceExporter;
+  using tier4_autoware_utils::TraceHistogramSink;
+
+  auto sink = std::make_shared<TraceHistogramSink>();
+  TraceExporter exporter;
+  exporter.addSink(sink);
+
+  const auto dropped_event_count = Tracer::getDroppedEventCount();
+  for (size_t i = 0; i < Tracer::ring_buffer_capacity + 10; ++i) {
+    tracedFunction();
+  }
+  exporter.flush();
+
+  EXPECT_EQ(Tracer::getDroppedEventCount() - dropped_event_count, 10u);
+  EXPECT_EQ(sink->getHistograms().at("test/traced_function").count, Tracer::ring_buffer_capacity);
+}
+
+TEST(system, Tracer_sameName)
+{
+  using tier4_autoware_utils::TraceExporter;
+  using tier4_autoware_utils::TraceHistogramSink;
+
+  auto sink = std::make_shared<TraceHistogramSink>();
+  TraceExporter exporter;
+  exporter.addSink(sink);
+
+  sameNameFunction();
+  otherSameNameFunction();
+  otherSameNameFunction();
+  tracedTemplate<int>();
+  tracedTemplate<double>();
+  exporter.flush();
+
+  // the tracepoints of different source locations are kept apart
+  const auto histograms = sink->getHistograms();
+  ASSERT_EQ(histograms.size(), 3u);
+  EXPECT_EQ(histograms.at("test/same_name").count, 1u);
+  const auto other = std::next(histograms.find("test/same_name"));
+  ASSERT_NE(other, histograms.end());
+  EXPECT_EQ(other->first.rfind("test/same_name (test_tracer.cpp:", 0), 0u);
+  EXPECT_EQ(other->second.count, 2u);
+  // the instances of a template share the tracepoint of their source location
+  EXPECT_EQ(histograms.at("test/traced_template").count, 2u);
+}
+
+TEST(system, TraceHistogram_quantile)
+{
+  tier4_autoware_utils::TraceHistogram histogram;
+  for (int i = 0; i < 99; ++i) {
+    histogram.add(1000);  // in [512, 1024) ns
+  }
+  histogram.add(1000000);
+
+  EXPECT_EQ(histogram.count, 100u);
+  EXPECT_NEAR(histogram.meanMs(), (99 * 1000 + 1000000) * 1e-8, 1e-12);
+  EXPECT_DOUBLE_EQ(histogram.quantileMs(0.5), 1024 * 1e-6);
+  EXPECT_DOUBLE_EQ(histogram.quantileMs(1.0), 1000000 * 1e-6);
+}
@@ -35,8 +35,11 @@
 #include <OgreSceneManager.h>
 #include <OgreSceneNode.h>
 
+#include <array>
+#include <cstdio>
 #include <deque>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #define EIGEN_MPL2_ONLY
@@ -46,38 +49,44 @@
 
 namespace
 {
-std::unique_ptr<Ogre::ColourValue> gradation(
-  const QColor & color_min, const QColor & color_max, const double ratio)
+Ogre::ColourValue gradation(
+  const Ogre::ColourValue & color_min, const Ogre::ColourValue & color_max, const double ratio)
 {
-  std::unique_ptr<Ogre::ColourValue> color_ptr(new Ogre::ColourValue);
-  color_ptr->g =
-    static_cast<float>(color_max.greenF() * ratio + color_min.greenF() * (1.0 - ratio));
-  color_ptr->r = static_cast<float>(color_max.redF() * ratio + color_min.redF() * (1.0 - ratio));
-  color_ptr->b = static_cast<float>(color_max.blueF() * ratio + color_min.blueF() * (1.0 - ratio));
+  Ogre::ColourValue color;
+  color.g = static_cast<float>(color_max.g * ratio + color_min.g * (1.0 - ratio));
+  color.r = static_cast<float>(color_max.r * ratio + color_min.r * (1.0 - ratio));
+  color.b = static_cast<float>(color_max.b * ratio + color_min.b * (1.0 - ratio));
 
-  return color_ptr;
+  return color;
 }
 
-std::unique_ptr<Ogre::ColourValue> setColorDependsOnVelocity(
-  const double vel_max, const double cmd_vel)
+Ogre::ColourValue setColorDependsOnVelocity(const double vel_max, const double cmd_vel)
 {
   const double cmd_vel_abs = std::fabs(cmd_vel);
   const double vel_min = 0.0;
 
-  std::unique_ptr<Ogre::ColourValue> color_ptr(new Ogre::ColourValue());
   if (vel_min < cmd_vel_abs && cmd_vel_abs <= (vel_max / 2.0)) {
     double ratio = (cmd_vel_abs - vel_min) / (vel_max / 2.0 - vel_min);
-    color_ptr = gradation(Qt::red, Qt::yellow, ratio);
+    return gradation(Ogre::ColourValue::Red, Ogre::ColourValue(1.0f, 1.0f, 0.0f), ratio);
   } else if ((vel_max / 2.0) < cmd_vel_abs && cmd_vel_abs <= vel_max) {
     double ratio = (cmd_vel_abs - vel_max / 2.0) / (vel_max - vel_max / 2.0);
-    color_ptr = gradation(Qt::yellow, Qt::green, ratio);
+    return gradation(Ogre::ColourValue(1.0f, 1.0f, 0.0f), Ogre::ColourValue::Green, ratio);
   } else if (vel_max < cmd_vel_abs) {
-    *color_ptr = Ogre::ColourValue::Green;
-  } else {
-    *color_ptr = Ogre::ColourValue::Red;
+    return Ogre::ColourValue::Green;
   }
+  return Ogre::ColourValue::Red;
+}
 
-  return color_ptr;
+// Start writing the first section of the manual object. Once the section exists, it is updated in
+// place so that its dynamic vertex buffer is reused instead of being reallocated for every message.
+void beginManualObject(
+  Ogre::ManualObject * manual_object, const Ogre::RenderOperation::OperationType operation_type)
+{
+  if (manual_object->getNumSections() == 0) {
+    manual_object->begin("BaseWhiteNoLighting", operation_type);
+  } else {
+    manual_object->beginUpdate(0);
+  }
 }
 
 template <typename T>
@@ -119,6 +128,9 @@ public:
     // velocity text
     property_velocity_text_view_{"View Text Velocity", false, "", this},
     property_velocity_text_scale_{"Scale", 0.3, "", &property_velocity_text_view_},
+    property_velocity_text_interval_{
+      "Min Interval", 0.0, "minimum distance between velocity texts [m]",
+      &property_velocity_text_view_},
     // footprint
     property_footprint_view_{"View Footprint", false, "", this},
     property_footprint_alpha_{"Alpha", 1.0, "", &property_footprint_view_},
@@ -145,6 +157,7 @@ public:
     // velocity text
     property_velocity_scale_.setMin(0.1);
     property_velocity_scale_.setMax(10.0);
+    property_velocity_text_interval_.setMin(0.0);
 
     // initialize footprint
     property_footprint_alpha_.setMin(0.0);
@@ -197,14 +210,7 @@ public:
     rviz_common::MessageFilterDisplay<T>::MFDClass::reset();
     path_manual_object_->clear();
     velocity_manual_object_->clear();
-    for (size_t i = 0; i < velocity_texts_.size(); i++) {
-      Ogre::SceneNode * node = velocity_text_nodes_.at(i);
-      node->detachAllObjects();
-      node->removeAndDestroyAllChildren();
-      this->scene_manager_->destroySceneNode(node);
-    }
-    velocity_text_nodes_.clear();
-    velocity_texts_.clear();
+    hideVelocityTexts(0);
     footprint_manual_object_->clear();
     point_manual_object_->clear();
   }
@@ -219,12 +225,8 @@ protected:
 
   void processMessage(const typename T::ConstSharedPtr msg_ptr) override
   {
-    path_manual_object_->clear();
-    velocity_manual_object_->clear();
-    footprint_manual_object_->clear();
-    point_manual_object_->clear();
-
     if (!validateFloats<T>(msg_ptr)) {
+      clearManualObjects();
       this->setStatus(
         rviz_common::properties::StatusProperty::Error, "Topic",
         "Message contained invalid floating point values (nans or infs)");
@@ -254,9 +256,44 @@ protected:
     last_msg_ptr_ = msg_ptr;
   }
 
+  void clearManualObjects()
+  {
+    path_manual_object_->clear();
+    velocity_manual_object_->clear();
+    footprint_manual_object_->clear();
+    point_manual_object_->clear();
+    hideVelocityTexts(0);
+  }
+
+  // The text nodes are pooled: they are only created when more texts are needed than ever before,
+  // and the ones that are not used for the current message are hidden instead of being destroyed.
+  rviz_rendering::MovableText * getVelocityText(const size_t text_idx)
+  {
+    while (velocity_texts_.size() <= text_idx) {
+      Ogre::SceneNode * node = this->scene_node_->createChildSceneNode();
+      rviz_rendering::MovableText * text =
+        new rviz_rendering::MovableText("not initialized", "Liberation Sans", 0.1);
+      text->setVisible(false);
+      text->setTextAlignment(
+        rviz_rendering::MovableText::H_CENTER, rviz_rendering::MovableText::V_ABOVE);
+      node->attachObject(text);
+      velocity_texts_.push_back(text);
+      velocity_text_nodes_.push_back(node);
+    }
+    return velocity_texts_.at(text_idx);
+  }
+
+  void hideVelocityTexts(const size_t begin_idx)
+  {
+    for (size_t i = begin_idx; i < velocity_texts_.size(); ++i) {
+      velocity_texts_.at(i)->setVisible(false);
+    }
+  }
+
   void visualizePath(const typename T::ConstSharedPtr msg_ptr)
   {
     if (msg_ptr->points.empty()) {
+      clearManualObjects();
       return;
     }
 
@@ -267,31 +304,24 @@ protected:
 
     path_manual_object_->estimateVertexCount(msg_ptr->points.size() * 2);
     velocity_manual_object_->estimateVertexCount(msg_ptr->points.size());
-    path_manual_object_->begin("BaseWhiteNoLighting", Ogre::RenderOperation::OT_TRIANGLE_STRIP);
-    velocity_manual_object_->begin("BaseWhiteNoLighting", Ogre::RenderOperation::OT_LINE_STRIP);
-
-    if (msg_ptr->points.size() > velocity_texts_.size()) {
-      for (size_t i = velocity_texts_.size(); i < msg_ptr->points.size(); i++) {
-        Ogre::SceneNode * node = this->scene_node_->createChildSceneNode();
-        rviz_rendering::MovableText * text =
-          new rviz_rendering::MovableText("not initialized", "Liberation Sans", 0.1);
-        text->setVisible(false);
-        text->setTextAlignment(
-          rviz_rendering::MovableText::H_CENTER, rviz_rendering::MovableText::V_ABOVE);
-        node->attachObject(text);
-        velocity_texts_.push_back(text);
-        velocity_text_nodes_.push_back(node);
-      }
-    } else if (msg_ptr->points.size() < velocity_texts_.size()) {
-      for (size_t i = velocity_texts_.size() - 1; i >= msg_ptr->points.size(); i--) {
-        Ogre::SceneNode * node = velocity_text_nodes_.at(i);
-        node->detachAllObjects();
-        node->removeAndDestroyAllChildren();
-        this->scene_manager_->destroySceneNode(node);
-      }
-      velocity_texts_.resize(msg_ptr->points.size());
-      velocity_text_nodes_.resize(msg_ptr->points.size());
-    }
+    beginManualObject(path_manual_object_, Ogre::RenderOperation::OT_TRIANGLE_STRIP);
+    beginManualObject(velocity_manual_object_, Ogre::RenderOperation::OT_LINE_STRIP);
+
+    const float vel_max = property_vel_max_.getFloat();
+    const Eigen::Vector3f path_half_width_vec(0.0f, property_path_width_.getFloat() / 2.0f, 0.0f);
+    const Eigen::Quaternionf quat_yaw_reverse(0, 0, 0, 1);
+    Ogre::ColourValue path_color =
+      rviz_common::properties::qtToOgre(property_path_color_.getColor());
+    path_color.a = property_path_alpha_.getFloat();
+    Ogre::ColourValue velocity_color =
+      rviz_common::properties::qtToOgre(property_velocity_color_.getColor());
+    velocity_color.a = property_velocity_alpha_.getFloat();
+
+    const float text_height = property_velocity_text_scale_.getFloat();
+    const double text_interval = property_velocity_text_interval_.getFloat();
+    size_t text_idx = 0;
+    double dist_from_last_text = 0.0;
+    char caption[32];
 
     for (size_t point_idx = 0; point_idx < msg_ptr->points.size(); point_idx++) {
       const auto & path_point = msg_ptr->points.at(point_idx);
@@ -300,89 +330,69 @@ protected:
 
       // path
       if (property_path_view_.getBool()) {
-        Ogre::ColourValue color;
-        if (property_path_color_view_.getBool()) {
-          color = rviz_common::properties::qtToOgre(property_path_color_.getColor());
-        } else {
+        if (!property_path_color_view_.getBool()) {
           // color change depending on velocity
-          std::unique_ptr<Ogre::ColourValue> dynamic_color_ptr =
-            setColorDependsOnVelocity(property_vel_max_.getFloat(), velocity);
-          color = *dynamic_color_ptr;
-        }
-        color.a = property_path_alpha_.getFloat();
-        Eigen::Vector3f vec_in;
-        Eigen::Vector3f vec_out;
-        Eigen::Quaternionf quat_yaw_reverse(0, 0, 0, 1);
-        {
-          vec_in << 0, (property_path_width_.getFloat() / 2.0), 0;
-          Eigen::Quaternionf quat(
-            pose.orientation.w, pose.orientation.x, pose.orientation.y, pose.orientation.z);
-          if (!isDrivingForward(msg_ptr->points, point_idx)) {
-            quat *= quat_yaw_reverse;
-          }
-          vec_out = quat * vec_in;
-          path_manual_object_->position(
-            static_cast<float>(pose.position.x) + vec_out.x(),
-            static_cast<float>(pose.position.y) + vec_out.y(),
-            static_cast<float>(pose.position.z) + vec_out.z());
-          path_manual_object_->colour(color);
+          path_color = setColorDependsOnVelocity(vel_max, velocity);
+          path_color.a = property_path_alpha_.getFloat();
         }
-        {
-          vec_in << 0, -(property_path_width_.getFloat() / 2.0), 0;
-          Eigen::Quaternionf quat(
-            pose.orientation.w, pose.orientation.x, pose.orientation.y, pose.orientation.z);
-          if (!isDrivingForward(msg_ptr->points, point_idx)) {
-            quat *= quat_yaw_reverse;
-          }
-          vec_out = quat * vec_in;
-          path_manual_object_->position(
-            static_cast<float>(pose.position.x) + vec_out.x(),
-            static_cast<float>(pose.position.y) + vec_out.y(),
-            static_cast<float>(pose.position.z) + vec_out.z());
-          path_manual_object_->colour(color);
+        Eigen::Quaternionf quat(
+          pose.orientation.w, pose.orientation.x, pose.orientation.y, pose.orientation.z);
+        if (!isDrivingForward(msg_ptr->points, point_idx)) {
+          quat *= quat_yaw_reverse;
         }
+        const Eigen::Vector3f vec_out = quat * path_half_width_vec;
+        path_manual_object_->position(
+          static_cast<float>(pose.position.x) + vec_out.x(),
+          static_cast<float>(pose.position.y) + vec_out.y(),
+          static_cast<float>(pose.position.z) + vec_out.z());
+        path_manual_object_->colour(path_color);
+        path_manual_object_->position(
+          static_cast<float>(pose.position.x) - vec_out.x(),
+          static_cast<float>(pose.position.y) - vec_out.y(),
+          static_cast<float>(pose.position.z) - vec_out.z());
+        path_manual_object_->colour(path_color);
       }
 
       // velocity
       if (property_velocity_view_.getBool()) {
-        Ogre::ColourValue color;
-        if (property_velocity_color_view_.getBool()) {
-          color = rviz_common::properties::qtToOgre(property_velocity_color_.getColor());
-        } else {
+        if (!property_velocity_color_view_.getBool()) {
           /* color change depending on velocity */
-          std::unique_ptr<Ogre::ColourValue> dynamic_color_ptr =
-            setColorDependsOnVelocity(property_vel_max_.getFloat(), velocity);
-          color = *dynamic_color_ptr;
+          velocity_color = setColorDependsOnVelocity(vel_max, velocity);
+          velocity_color.a = property_velocity_alpha_.getFloat();
         }
-        color.a = property_velocity_alpha_.getFloat();
 
         velocity_manual_object_->position(
           pose.position.x, pose.position.y,
           static_cast<float>(pose.position.z) + velocity * property_velocity_scale_.getFloat());
-        velocity_manual_object_->colour(color);
+        velocity_manual_object_->colour(velocity_color);
       }
 
-      // velocity text
+      // velocity text, decimated so that neighboring texts are at least text_interval apart
       if (property_velocity_text_view_.getBool()) {
-        Ogre::Vector3 position;
-        position.x = pose.position.x;
-        position.y = pose.position.y;
-        position.z = pose.position.z;
-        Ogre::SceneNode * node = velocity_text_nodes_.at(point_idx);
-        node->setPosition(position);
-
-        rviz_rendering::MovableText * text = velocity_texts_.at(point_idx);
-        const double vel = velocity;
-        std::stringstream ss;
-        ss << std::fixed << std::setprecision(2) << vel;
-        text->setCaption(ss.str());
-        text->setCharacterHeight(property_velocity_text_scale_.getFloat());
-        text->setVisible(true);
-      } else {
-        rviz_rendering::MovableText * text = velocity_texts_.at(point_idx);
-        text->setVisible(false);
+        if (point_idx != 0) {
+          dist_from_last_text += tier4_autoware_utils::calcDistance2d(
+            tier4_autoware_utils::getPoint(msg_ptr->points.at(point_idx - 1)), pose.position);
+        }
+        if (point_idx == 0 || text_interval <= dist_from_last_text) {
+          dist_from_last_text = 0.0;
+          rviz_rendering::MovableText * text = getVelocityText(text_idx);
+          velocity_text_nodes_.at(text_idx)->setPosition(
+            Ogre::Vector3(pose.position.x, pose.position.y, pose.position.z));
+          ++text_idx;
+
+          // changing the caption or the height rebuilds the text geometry, so skip it if unchanged
+          std::snprintf(caption, sizeof(caption), "%.2f", velocity);
+          if (text->getCaption() != caption) {
+            text->setCaption(caption);
+          }
+          if (text->getCharacterHeight() != text_height) {
+            text->setCharacterHeight(text_height);
+          }
+          text->setVisible(true);
+        }
       }
     }
+    hideVelocityTexts(text_idx);
 
     path_manual_object_->end();
     velocity_manual_object_->end();
@@ -400,12 +410,36 @@ protected:
     material->setDepthWriteEnabled(false);
 
     footprint_manual_object_->estimateVertexCount(msg_ptr->points.size() * 4 * 2);
-    footprint_manual_object_->begin("BaseWhiteNoLighting", Ogre::RenderOperation::OT_LINE_LIST);
+    beginManualObject(footprint_manual_object_, Ogre::RenderOperation::OT_LINE_LIST);
     point_manual_object_->estimateVertexCount(msg_ptr->points.size() * 3 * 8);
-    point_manual_object_->begin("BaseWhiteNoLighting", Ogre::RenderOperation::OT_TRIANGLE_LIST);
+    beginManualObject(point_manual_object_, Ogre::RenderOperation::OT_TRIANGLE_LIST);
 
     const float offset_from_baselink = property_offset_.getFloat();
 
+    // footprint corners and point outline in the local frame, shared by all the points
+    Ogre::ColourValue footprint_color =
+      rviz_common::properties::qtToOgre(property_footprint_color_.getColor());
+    footprint_color.a = property_footprint_alpha_.getFloat();
+    const auto info = vehicle_footprint_info_;
+    const float top = info->length - info->rear_overhang - offset_from_baselink;
+    const float bottom = -info->rear_overhang + offset_from_baselink;
+    const float left = -info->width / 2.0;
+    const float right = info->width / 2.0;
+    const std::array<Eigen::Vector3f, 4> footprint_corners{
+      Eigen::Vector3f{top, left, 0.0f}, Eigen::Vector3f{top, right, 0.0f},
+      Eigen::Vector3f{bottom, right, 0.0f}, Eigen::Vector3f{bottom, left, 0.0f}};
+
+    Ogre::ColourValue point_color =
+      rviz_common::properties::qtToOgre(property_point_color_.getColor());
+    point_color.a = property_point_alpha_.getFloat();
+    const double point_offset = property_point_offset_.getFloat();
+    const double radius = property_point_radius_.getFloat();
+    std::array<std::pair<double, double>, 9> point_outline;
+    for (size_t s_idx = 0; s_idx < point_outline.size(); ++s_idx) {
+      const double angle = static_cast<double>(s_idx) / 8.0 * 2.0 * M_PI;
+      point_outline.at(s_idx) = {radius * std::cos(angle), radius * std::sin(angle)};
+    }
+
     preprocessMessageDetail(msg_ptr);
 
     for (size_t p_idx = 0; p_idx < msg_ptr->points.size(); p_idx++) {
@@ -413,71 +447,42 @@ protected:
       const auto & pose = tier4_autoware_utils::getPose(point);
       // footprint
       if (property_footprint_view_.getBool()) {
-        Ogre::ColourValue color;
-        color = rviz_common::properties::qtToOgre(property_footprint_color_.getColor());
-        color.a = property_footprint_alpha_.getFloat();
-
-        const auto info = vehicle_footprint_info_;
-        const float top = info->length - info->rear_overhang - offset_from_baselink;
-        const float bottom = -info->rear_overhang + offset_from_baselink;
-        const float left = -info->width / 2.0;
-        const float right = info->width / 2.0;
-
-        const std::array<float, 4> lon_offset_vec{top, top, bottom, bottom};
-        const std::array<float, 4> lat_offset_vec{left, right, right, left};
-
-        for (int f_idx = 0; f_idx < 4; ++f_idx) {
-          const Eigen::Quaternionf quat(
-            pose.orientation.w, pose.orientation.x, pose.orientation.y, pose.orientation.z);
-
-          {
-            const Eigen::Vector3f offset_vec{
-              lon_offset_vec.at(f_idx), lat_offset_vec.at(f_idx), 0.0};
-            const auto offset_to_edge = quat * offset_vec;
-            footprint_manual_object_->position(
-              pose.position.x + offset_to_edge.x(), pose.position.y + offset_to_edge.y(),
-              pose.position.z);
-            footprint_manual_object_->colour(color);
-          }
-          {
-            const Eigen::Vector3f offset_vec{
-              lon_offset_vec.at((f_idx + 1) % 4), lat_offset_vec.at((f_idx + 1) % 4), 0.0};
-            const auto offset_to_edge = quat * offset_vec;
+        const Eigen::Quaternionf quat(
+          pose.orientation.w, pose.orientation.x, pose.orientation.y, pose.orientation.z);
+        std::array<Eigen::Vector3f, 4> offsets_to_edge;
+        for (size_t f_idx = 0; f_idx < 4; ++f_idx) {
+          offsets_to_edge.at(f_idx) = quat * footprint_corners.at(f_idx);
+        }
+
+        for (size_t f_idx = 0; f_idx < 4; ++f_idx) {
+          for (const size_t e_idx : {f_idx, (f_idx + 1) % 4}) {
+            const auto & offset_to_edge = offsets_to_edge.at(e_idx);
             footprint_manual_object_->position(
               pose.position.x + offset_to_edge.x(), pose.position.y + offset_to_edge.y(),
               pose.position.z);
-            footprint_manual_object_->colour(color);
+            footprint_manual_object_->colour(footprint_color);
           }
         }
       }
 
       // point
       if (property_point_view_.getBool()) {
-        Ogre::ColourValue color;
-        color = rviz_common::properties::qtToOgre(property_point_color_.getColor());
-        color.a = property_point_alpha_.getFloat();
-
-        const double offset = property_point_offset_.getFloat();
         const double yaw = tf2::getYaw(pose.orientation);
-        const double base_x = pose.position.x + offset * std::cos(yaw);
-        const double base_y = pose.position.y + offset * std::sin(yaw);
+        const double base_x = pose.position.x + point_offset * std::cos(yaw);
+        const double base_y = pose.position.y + point_offset * std::sin(yaw);
         const double base_z = pose.position.z;
 
-        const double radius = property_point_radius_.getFloat();
         for (size_t s_idx = 0; s_idx < 8; ++s_idx) {
-          const double current_angle = static_cast<double>(s_idx) / 8.0 * 2.0 * M_PI;
-          const double next_angle = static_cast<double>(s_idx + 1) / 8.0 * 2.0 * M_PI;
-          point_manual_object_->position(
-            base_x + radius * std::cos(current_angle), base_y + radius * std::sin(current_angle),
-            base_z);
-          point_manual_object_->colour(color);
+          const auto & current = point_outline.at(s_idx);
+          const auto & next = point_outline.at(s_idx + 1);
+          point_manual_object_->position(base_x + current.first, base_y + current.second, base_z);
+          point_manual_object_->colour(point_color);
 
-          point_manual_object_->position(
-            base_x + radius * std::cos(next_angle), base_y + radius * std::sin(next_angle), base_z);
-          point_manual_object_->colour(color);
+          point_manual_object_->position(base_x + next.first, base_y + next.second, base_z);
+          point_manual_object_->colour(point_color);
 
           point_manual_object_->position(base_x, base_y, base_z);
-          point_manual_object_->colour(color);
+          point_manual_object_->colour(point_color);
         }
       }
 
@@ -508,6 +513,7 @@ protected:
   rviz_common::properties::ColorProperty property_velocity_color_;
   rviz_common::properties::BoolProperty property_velocity_text_view_;
   rviz_common::properties::FloatProperty property_velocity_text_scale_;
+  rviz_common::properties::FloatProperty property_velocity_text_interval_;
 
   rviz_common::properties::BoolProperty property_footprint_view_;
   rviz_common::properties::FloatProperty property_footprint_alpha_;
@@ -23,9 +23,19 @@
 #include <tvm_vendor/tvm/runtime/packed_func.h>
 #include <tvm_vendor/tvm/runtime/registry.h>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
 #include <fstream>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -182,6 +192,251 @@ private:
   PostProcessorType post_processor_{};
 };
 
+/**
+ * @brief Latency statistics of a pipeline stage, over the frames it processed without error.
+ */
+struct StageLatency
+{
+  std::size_t count{0};
+  std::chrono::nanoseconds last{0};
+  std::chrono::nanoseconds max{0};
+  std::chrono::nanoseconds total{0};
+
+  std::chrono::nanoseconds mean() const
+  {
+    return count > 0 ? total / static_cast<int64_t>(count) : std::chrono::nanoseconds{0};
+  }
+};
+
+/**
+ * @class AsyncPipeline
+ * @brief Inference Pipeline whose 3 stages run concurrently on frames in flight: while
+ * the inference engine processes a frame, the preprocessor already processes the next one and
+ * the postprocessor the previous one. Each stage runs on its own thread and the frames go from a
+ * stage to the next one through queues, in order.
+ *
+ * The stages usually reuse their output buffers from a call to the next one, so that each frame
+ * in flight uses its own set of stages: frame k is processed by the stages at index k modulo the
+ * number of sets, which bounds the number of frames in flight. A stage which does not reuse
+ * its outputs can be shared between the sets.
+ */
+template <class PreProcessorType, class InferenceEngineType, class PostProcessorType>
+class AsyncPipeline
+{
+  using InputType = decltype(std::declval<PreProcessorType>().input_type_indicator_);
+  using OutputType = decltype(std::declval<PostProcessorType>().output_type_indicator_);
+
+public:
+  static constexpr std::size_t NUM_STAGES = 3;
+
+  /**
+   * @brief Construct a new AsyncPipeline object and start the threads of the stages
+   *
+   * @param pre_processors a PreProcessor object per frame in flight
+   * @param inference_engines a InferenceEngine object per frame in flight
+   * @param post_processors a PostProcessor object per frame in flight
+   * @throw std::runtime_error If the numbers of stages differ or are zero.
+   */
+  AsyncPipeline(
+    std::vector<std::shared_ptr<PreProcessorType>> pre_processors,
+    std::vector<std::shared_ptr<InferenceEngineType>> inference_engines,
+    std::vector<std::shared_ptr<PostProcessorType>> post_processors)
+  : pre_processors_(std::move(pre_processors)),
+    inference_engines_(std::move(inference_engines)),
+    post_processors_(std::move(post_processors))
+  {
+    if (
+      pre_processors_.empty() || pre_processors_.size() != inference_engines_.size() ||
+      pre_processors_.size() != post_processors_.size()) {
+      throw std::runtime_error("AsyncPipeline needs the same non-zero number of each stage");
+    }
+    for (std::size_t stage = 0; stage < NUM_STAGES; ++stage) {
+      workers_.emplace_back([this, stage]() { work(stage); });
+    }
+  }
+
+  AsyncPipeline(const AsyncPipeline &) = delete;
+  AsyncPipeline & operator=(const AsyncPipeline &) = delete;
+
+  /**
+   * @brief Stop the threads of the stages. The frames in flight are dropped.
+   */
+  ~AsyncPipeline()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    condition_.notify_all();
+    for (auto & worker : workers_) {
+      worker.join();
+    }
+  }
+
+  /**
+   * @brief Get the maximum number of frames in flight, i.e. the number of sets of stages
+   */
+  std::size_t maxFramesInFlight() const { return pre_processors_.size(); }
+
+  /**
+   * @brief Push a frame into the pipeline. Blocks while the maximum number of frames are in
+   * flight, the output of a frame being collected by pop().
+   *
+   * @param input The data to push into the pipeline
+   */
+  void push(const InputType & input)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait(lock, [this]() { return frames_in_flight_ < maxFramesInFlight(); });
+    Frame frame;
+    frame.set = next_set_;
+    frame.input = input;
+    next_set_ = (next_set_ + 1) % maxFramesInFlight();
+    ++frames_in_flight_;
+    queues_[0].push_back(std::move(frame));
+    lock.unlock();
+    condition_.notify_all();
+  }
+
+  /**
+   * @brief Wait for the output of the oldest frame in flight
+   *
+   * @return The pipeline output
+   * @throw std::runtime_error If no frame is in flight.
+   * @throw Any exception thrown by a stage processing the frame.
+   */
+  OutputType pop()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (frames_in_flight_ == 0) {
+      throw std::runtime_error("AsyncPipeline has no frame in flight");
+    }
+    condition_.wait(lock, [this]() { return !queues_[NUM_STAGES].empty(); });
+    return takeOutput(lock);
+  }
+
+  /**
+   * @brief Take the output of the oldest frame in flight if it is ready, without waiting
+   *
+   * @param output The pipeline output
+   * @return Whether the output was ready
+   * @throw Any exception thrown by a stage processing the frame.
+   */
+  bool tryPop(OutputType & output)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (queues_[NUM_STAGES].empty()) {
+      return false;
+    }
+    output = takeOutput(lock);
+    return true;
+  }
+
+  /**
+   * @brief Get the latencies of the preprocessor, the inference engine and the postprocessor
+   */
+  std::array<StageLatency, NUM_STAGES> getStageLatencies() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stage_latencies_;
+  }
+
+private:
+  struct Frame
+  {
+    std::size_t set{0};
+    InputType input{};
+    TVMArrayContainerVector tensors{};
+    OutputType output{};
+    std::exception_ptr error{nullptr};
+  };
+
+  void runStage(const std::size_t stage, Frame & frame)
+  {
+    switch (stage) {
+      case 0:
+        frame.tensors = pre_processors_[frame.set]->schedule(frame.input);
+        frame.input = InputType{};
+        break;
+      case 1:
+        frame.tensors = inference_engines_[frame.set]->schedule(frame.tensors);
+        break;
+      default:
+        frame.output = post_processors_[frame.set]->schedule(frame.tensors);
+        frame.tensors.clear();
+        break;
+    }
+  }
+
+  void work(const std::size_t stage)
+  {
+    while (true) {
+      Frame frame;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this, stage]() { return stopping_ || !queues_[stage].empty(); });
+        if (stopping_) {
+          return;
+        }
+        frame = std::move(queues_[stage].front());
+        queues_[stage].pop_front();
+      }
+
+      // a frame which failed in a stage skips the next ones
+      const auto start = std::chrono::steady_clock::now();
+      if (!frame.error) {
+        try {
+          runStage(stage, frame);
+        } catch (...) {
+          frame.error = std::current_exception();
+        }
+      }
+      const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start);
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!frame.error) {
+          auto & stage_latency = stage_latencies_[stage];
+          ++stage_latency.count;
+          stage_latency.last = latency;
+          stage_latency.max = std::max(stage_latency.max, latency);
+          stage_latency.total += latency;
+        }
+        queues_[stage + 1].push_back(std::move(frame));
+      }
+      condition_.notify_all();
+    }
+  }
+
+  OutputType takeOutput(std::unique_lock<std::mutex> & lock)
+  {
+    Frame frame = std::move(queues_[NUM_STAGES].front());
+    queues_[NUM_STAGES].pop_front();
+    --frames_in_flight_;
+    lock.unlock();
+    condition_.notify_all();
+    if (frame.error) {
+      std::rethrow_exception(frame.error);
+    }
+    return std::move(frame.output);
+  }
+
+  std::vector<std::shared_ptr<PreProcessorType>> pre_processors_;
+  std::vector<std::shared_ptr<InferenceEngineType>> inference_engines_;
+  std::vector<std::shared_ptr<PostProcessorType>> post_processors_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable condition_;
+  // the input queue of each stage, then the outputs to pop
+  std::array<std::deque<Frame>, NUM_STAGES + 1> queues_;
+  std::size_t frames_in_flight_{0};
+  std::size_t next_set_{0};
+  bool stopping_{false};
+  std::array<StageLatency, NUM_STAGES> stage_latencies_{};
+  std::vector<std::thread> workers_;
+};
+
 // NetworkNode
 typedef struct
 {
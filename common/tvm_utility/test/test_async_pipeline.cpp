@@ -0,0 +1,229 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+#include "tvm_utility/pipeline.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using tvm_utility::pipeline::AsyncPipeline;
+using tvm_utility::pipeline::TVMArrayContainer;
+using tvm_utility::pipeline::TVMArrayContainerVector;
+
+// The stages carry a frame as the number of (empty) tensors, so that no TVM array is allocated:
+// input n gives (n + 1) * 10.
+
+void sleepFor(const int input)
+{
+  std::this_thread::sleep_for(std::chrono::milliseconds((input * 7) % 5));
+}
+
+class PreProcessorStub : public tvm_utility::pipeline::PreProcessor<int>
+{
+public:
+  TVMArrayContainerVector schedule(const int & input)
+  {
+    inputs.push_back(input);
+    sleepFor(input);
+    if (input == throwing_input) {
+      throw std::runtime_error("preprocessor error");
+    }
+    return TVMArrayContainerVector(static_cast<size_t>(input));
+  }
+
+  std::vector<int> inputs{};
+  int throwing_input{-1};
+};
+
+class InferenceEngineStub : public tvm_utility::pipeline::InferenceEngine
+{
+public:
+  TVMArrayContainerVector schedule(const TVMArrayContainerVector & input)
+  {
+    sleepFor(static_cast<int>(input.size()) + 1);
+    auto output = input;
+    output.push_back(TVMArrayContainer{});
+    return output;
+  }
+};
+
+class PostProcessorStub : public tvm_utility::pipeline::PostProcessor<int>
+{
+public:
+  int schedule(const TVMArrayContainerVector & input)
+  {
+    ++num_calls;
+    sleepFor(static_cast<int>(input.size()) + 2);
+    return static_cast<int>(input.size()) * 10;
+  }
+
+  std::atomic<int> num_calls{0};
+};
+
+using Pipeline = AsyncPipeline<PreProcessorStub, InferenceEngineStub, PostProcessorStub>;
+
+struct Stages
+{
+  explicit Stages(const size_t num_sets)
+  {
+    for (size_t i = 0; i < num_sets; ++i) {
+      pre_processors.push_back(std::make_shared<PreProcessorStub>());
+      inference_engines.push_back(std::make_shared<InferenceEngineStub>());
+      post_processors.push_back(std::make_shared<PostProcessorStub>());
+    }
+  }
+
+  std::unique_ptr<Pipeline> makePipeline() const
+  {
+    return std::make_unique<Pipeline>(pre_processors, inference_engines, post_processors);
+  }
+
+  int numPostProcessorCalls() const
+  {
+    int num_calls = 0;
+    for (const auto & post_processor : post_processors) {
+      num_calls += post_processor->num_calls;
+    }
+    return num_calls;
+  }
+
+  std::vector<std::shared_ptr<PreProcessorStub>> pre_processors;
+  std::vector<std::shared_ptr<InferenceEngineStub>> inference_engines;
+  std::vector<std::shared_ptr<PostProcessorStub>> post_processors;
+};
+}  // namespace
+
+TEST(AsyncPipeline, Construction)
+{
+  Stages stages(2);
+  EXPECT_EQ(stages.makePipeline()->maxFramesInFlight(), 2U);
+
+  stages.post_processors.pop_back();
+  EXPECT_THROW(stages.makePipeline(), std::runtime_error);
+
+  Stages empty_stages(0);
+  EXPECT_THROW(empty_stages.makePipeline(), std::runtime_error);
+}
+
+TEST(AsyncPipeline, Ordering)
+{
+  constexpr int num_frames = 20;
+  Stages stages(3);
+  {
+    auto pipeline = stages.makePipeline();
+
+    // push blocks while 3 frames are in flight, so pop the oldest before pushing more
+    std::vector<int> outputs;
+    for (int input = 0; input < num_frames; ++input) {
+      if (input >= 3) {
+        outputs.push_back(pipeline->pop());
+      }
+      pipeline->push(input);
+    }
+    while (outputs.size() < num_frames) {
+      outputs.push_back(pipeline->pop());
+    }
+
+    for (int input = 0; input < num_frames; ++input) {
+      EXPECT_EQ(outputs.at(input), (input + 1) * 10);
+    }
+
+    const auto latencies = pipeline->getStageLatencies();
+    for (const auto & latency : latencies) {
+      EXPECT_EQ(latency.count, static_cast<size_t>(num_frames));
+      EXPECT_LE(latency.last, latency.max);
+      EXPECT_LE(latency.mean(), latency.max);
+    }
+  }
+
+  // frame k is processed by the set k modulo 3
+  for (size_t set = 0; set < 3; ++set) {
+    const auto & inputs = stages.pre_processors.at(set)->inputs;
+    ASSERT_FALSE(inputs.empty());
+    for (const int input : inputs) {
+      EXPECT_EQ(static_cast<size_t>(input) % 3, set);
+    }
+  }
+}
+
+TEST(AsyncPipeline, Pop)
+{
+  Stages stages(2);
+  auto pipeline = stages.makePipeline();
+
+  // nothing in flight
+  EXPECT_THROW(pipeline->pop(), std::runtime_error);
+  int output = 0;
+  EXPECT_FALSE(pipeline->tryPop(output));
+
+  pipeline->push(4);
+  while (!pipeline->tryPop(output)) {
+    std::this_thread::yield();
+  }
+  EXPECT_EQ(output, 50);
+  EXPECT_FALSE(pipeline->tryPop(output));
+}
+
+TEST(AsyncPipeline, FailedFrameIsDropped)
+{
+  Stages stages(2);
+  stages.pre_processors.at(1)->throwing_input = 1;
+  auto pipeline = stages.makePipeline();
+
+  pipeline->push(0);
+  pipeline->push(1);
+  EXPECT_EQ(pipeline->pop(), 10);
+  pipeline->push(2);
+
+  // the failed frame skips the next stages and its error is rethrown by its pop, in order
+  EXPECT_THROW(pipeline->pop(), std::runtime_error);
+  EXPECT_EQ(pipeline->pop(), 30);
+  EXPECT_EQ(stages.numPostProcessorCalls(), 2);
+
+  const auto latencies = pipeline->getStageLatencies();
+  EXPECT_EQ(latencies.at(0).count, 2U);
+  EXPECT_EQ(latencies.at(2).count, 2U);
+
+  // the pipeline keeps running after a failure
+  pipeline->push(3);
+  EXPECT_EQ(pipeline->pop(), 40);
+}
+
+TEST(AsyncPipeline, Shutdown)
+{
+  Stages stages(4);
+  {
+    // the frames in flight are dropped by the destructor, which returns once the stages in
+    // progress are done
+    auto pipeline = stages.makePipeline();
+    for (int input = 0; input < 4; ++input) {
+      pipeline->push(input);
+    }
+  }
+  EXPECT_LE(stages.numPostProcessorCalls(), 4);
+
+  // destroyed while idle
+  {
+    auto pipeline = stages.makePipeline();
+    pipeline->push(0);
+    EXPECT_EQ(pipeline->pop(), 10);
+  }
+}
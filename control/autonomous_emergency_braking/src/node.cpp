@@ -17,6 +17,8 @@
 #include <motion_utils/trajectory/trajectory.hpp>
 #include <tier4_autoware_utils/tier4_autoware_utils.hpp>
 
+#include <sensor_msgs/point_cloud2_iterator.hpp>
+
 #include <pcl/filters/voxel_grid.h>
 #include <tf2/utils.h>
 
@@ -160,9 +162,7 @@ void AEB::onAutowareState(const AutowareState::ConstSharedPtr input_msg)
 
 void AEB::onPointCloud(const PointCloud2::ConstSharedPtr input_msg)
 {
-  PointCloud::Ptr pointcloud_ptr(new PointCloud);
-  pcl::fromROSMsg(*input_msg, *pointcloud_ptr);
-
+  Eigen::Affine3f affine = Eigen::Affine3f::Identity();
   if (input_msg->header.frame_id != "base_link") {
     RCLCPP_ERROR_STREAM(
       get_logger(),
@@ -179,20 +179,26 @@ void AEB::onPointCloud(const PointCloud2::ConstSharedPtr input_msg)
         "[AEB] Failed to look up transform from base_link to" << input_msg->header.frame_id);
       return;
     }
+    affine = tf2::transformToEigen(transform_stamped.transform).matrix().cast<float>();
+  }
 
-    // transform by using eigen matrix
-    PointCloud2 transformed_points{};
-    const Eigen::Matrix4f affine_matrix =
-      tf2::transformToEigen(transform_stamped.transform).matrix().cast<float>();
-    pcl_ros::transformPointCloud(affine_matrix, *input_msg, transformed_points);
-    pcl::fromROSMsg(transformed_points, *pointcloud_ptr);
+  // read and transform the points in a single pass over the message buffer
+  PointCloud::Ptr pointcloud_ptr(new PointCloud);
+  pointcloud_ptr->reserve(static_cast<size_t>(input_msg->width) * input_msg->height);
+  for (sensor_msgs::PointCloud2ConstIterator<float> iter_x(*input_msg, "x"),
+       iter_y(*input_msg, "y"), iter_z(*input_msg, "z");
+       iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
+    const Eigen::Vector3f p = affine * Eigen::Vector3f(*iter_x, *iter_y, *iter_z);
+    pointcloud_ptr->push_back(pcl::PointXYZ(p.x(), p.y(), p.z()));
   }
+  pointcloud_ptr->is_dense = input_msg->is_dense;
 
   pcl::VoxelGrid<pcl::PointXYZ> filter;
   PointCloud::Ptr no_height_filtered_pointcloud_ptr(new PointCloud);
   filter.setInputCloud(pointcloud_ptr);
   filter.setLeafSize(voxel_grid_x_, voxel_grid_y_, voxel_grid_z_);
   filter.filter(*no_height_filtered_pointcloud_ptr);
+  obstacle_points_ptr_ = no_height_filtered_pointcloud_ptr;
 
   obstacle_ros_pointcloud_ptr_ = std::make_shared<PointCloud2>();
   pcl::toROSMsg(*no_height_filtered_pointcloud_ptr, *obstacle_ros_pointcloud_ptr_);
@@ -420,22 +426,40 @@ void AEB::createObjectData(
   const Path & ego_path, const std::vector<tier4_autoware_utils::Polygon2d> & ego_polys,
   std::vector<ObjectData> & objects)
 {
-  PointCloud::Ptr obstacle_points_ptr(new PointCloud);
-  pcl::fromROSMsg(*obstacle_ros_pointcloud_ptr_, *obstacle_points_ptr);
-  for (const auto & point : obstacle_points_ptr->points) {
-    ObjectData obj;
-    obj.position = tier4_autoware_utils::createPoint(point.x, point.y, point.z);
-    obj.velocity = 0.0;
+  // cull the points by the bounding boxes of the ego polygons before the exact tests
+  std::vector<Box2d> ego_poly_boxes;
+  ego_poly_boxes.reserve(ego_polys.size());
+  Box2d ego_path_box;
+  bg::assign_inverse(ego_path_box);
+  for (const auto & ego_poly : ego_polys) {
+    Box2d box;
+    bg::assign_inverse(box);
+    if (!ego_poly.outer().empty()) {
+      bg::envelope(ego_poly, box);
+      bg::expand(ego_path_box, box);
+    }
+    ego_poly_boxes.push_back(box);
+  }
+
+  for (const auto & point : obstacle_points_ptr_->points) {
     const Point2d obj_point(point.x, point.y);
-    const double lat_dist = motion_utils::calcLateralOffset(ego_path, obj.position);
-    if (lat_dist > 5.0) {
+    if (!bg::covered_by(obj_point, ego_path_box)) {
       continue;
     }
-    for (const auto & ego_poly : ego_polys) {
-      if (bg::within(obj_point, ego_poly)) {
+    for (size_t i = 0; i < ego_polys.size(); ++i) {
+      if (
+        !bg::covered_by(obj_point, ego_poly_boxes.at(i)) ||
+        !bg::within(obj_point, ego_polys.at(i))) {
+        continue;
+      }
+      ObjectData obj;
+      obj.position = tier4_autoware_utils::createPoint(point.x, point.y, point.z);
+      obj.velocity = 0.0;
+      const double lat_dist = motion_utils::calcLateralOffset(ego_path, obj.position);
+      if (lat_dist <= 5.0) {
         objects.push_back(obj);
-        break;
       }
+      break;
     }
   }
 }
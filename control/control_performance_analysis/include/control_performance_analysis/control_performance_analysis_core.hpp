@@ -18,7 +18,9 @@
 #include "control_performance_analysis/control_performance_analysis_utils.hpp"
 #include "control_performance_analysis/msg/driving_monitor_stamped.hpp"
 #include "control_performance_analysis/msg/error_stamped.hpp"
+#include "control_performance_analysis/msg/error_statistics_stamped.hpp"
 #include "control_performance_analysis/msg/float_stamped.hpp"
+#include "control_performance_analysis/rolling_window_statistics.hpp"
 #include "motion_utils/trajectory/trajectory.hpp"
 
 #include <eigen3/Eigen/Core>
@@ -32,6 +34,8 @@
 #include <geometry_msgs/msg/twist.hpp>
 #include <nav_msgs/msg/odometry.hpp>
 
+#include <boost/optional.hpp>
+
 #include <memory>
 #include <utility>
 #include <vector>
@@ -43,6 +47,7 @@ using autoware_auto_planning_msgs::msg::Trajectory;
 using autoware_auto_vehicle_msgs::msg::SteeringReport;
 using control_performance_analysis::msg::DrivingMonitorStamped;
 using control_performance_analysis::msg::ErrorStamped;
+using control_performance_analysis::msg::ErrorStatisticsStamped;
 using control_performance_analysis::msg::FloatStamped;
 using geometry_msgs::msg::Pose;
 using geometry_msgs::msg::PoseArray;
@@ -58,6 +63,7 @@ struct Params
   double acceptable_max_yaw_difference_rad_;
   double prevent_zero_division_value_;
   double lpf_gain_;
+  uint statistics_window_size_;
 };
 
 class ControlPerformanceAnalysisCore
@@ -92,6 +98,7 @@ public:
 
   // Output variables
   ErrorStamped error_vars;
+  ErrorStatisticsStamped error_statistics_vars;  // statistics of the error vars before the LPF
   DrivingMonitorStamped driving_status_vars;
 
 private:
@@ -105,6 +112,10 @@ private:
   std::shared_ptr<AckermannControlCommand> current_control_ptr_;
   std::shared_ptr<SteeringReport> current_vec_steering_msg_ptr_;
 
+  // cumulative arc length of the waypoints, and the stamp of the trajectory they come from
+  std::vector<double> current_waypoints_arc_length_;
+  builtin_interfaces::msg::Time current_waypoints_stamp_;
+
   // State holder
 
   std_msgs::msg::Header last_odom_header;
@@ -115,6 +126,7 @@ private:
   std::unique_ptr<int32_t> idx_prev_wp_;       // the waypoint index, vehicle
   std::unique_ptr<int32_t> idx_curve_ref_wp_;  // index of waypoint corresponds to front axle center
   std::unique_ptr<int32_t> idx_next_wp_;       //  the next waypoint index, vehicle heading to
+  boost::optional<size_t> idx_closest_hint_;   // closest waypoint index of the last search
   std::unique_ptr<ErrorStamped> prev_target_vars_{};
   std::unique_ptr<DrivingMonitorStamped> prev_driving_vars_{};
   std::shared_ptr<Pose> interpolated_pose_ptr_;
@@ -126,6 +138,10 @@ private:
   Eigen::Matrix2d const lyap_P_ = (Eigen::MatrixXd(2, 2) << 2.342, 8.60, 8.60, 64.29).finished();
   double const contR{10.0};  // Control weight in LQR
 
+  std::unique_ptr<RollingWindowStatistics> error_statistics_;
+
+  void updateErrorStatistics();
+
   rclcpp::Logger logger_{rclcpp::get_logger("control_performance_analysis")};
   rclcpp::Clock clock_{RCL_ROS_TIME};
 };
@@ -18,6 +18,7 @@
 #include "control_performance_analysis/control_performance_analysis_core.hpp"
 #include "control_performance_analysis/msg/driving_monitor_stamped.hpp"
 #include "control_performance_analysis/msg/error_stamped.hpp"
+#include "control_performance_analysis/msg/error_statistics_stamped.hpp"
 
 #include <rclcpp/rclcpp.hpp>
 #include <signal_processing/lowpass_filter_1d.hpp>
@@ -41,6 +42,7 @@ using autoware_auto_planning_msgs::msg::Trajectory;
 using autoware_auto_vehicle_msgs::msg::SteeringReport;
 using control_performance_analysis::msg::DrivingMonitorStamped;
 using control_performance_analysis::msg::ErrorStamped;
+using control_performance_analysis::msg::ErrorStatisticsStamped;
 using geometry_msgs::msg::PoseStamped;
 using nav_msgs::msg::Odometry;
 
@@ -64,6 +66,8 @@ private:
   rclcpp::Publisher<ErrorStamped>::SharedPtr pub_error_msg_;  // publish error message
   rclcpp::Publisher<DrivingMonitorStamped>::SharedPtr
     pub_driving_msg_;  // publish driving status message
+  rclcpp::Publisher<ErrorStatisticsStamped>::SharedPtr
+    pub_error_statistics_msg_;  // publish rolling window statistics of the error message
 
   // Node Methods
   bool isDataReady() const;  // check if data arrive
@@ -0,0 +1,60 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CONTROL_PERFORMANCE_ANALYSIS__ROLLING_WINDOW_STATISTICS_HPP_
+#define CONTROL_PERFORMANCE_ANALYSIS__ROLLING_WINDOW_STATISTICS_HPP_
+
+#include <eigen3/Eigen/Core>
+
+#include <cstddef>
+#include <deque>
+#include <utility>
+#include <vector>
+
+namespace control_performance_analysis
+{
+/*
+ *  Mean, variance and maximum of several metrics over the last window_size samples.
+ *  Each update is O(1) per metric: the mean and the variance are updated with the sliding window
+ *  form of Welford's algorithm on whole arrays, and the maximum is kept by a monotonic queue.
+ * */
+class RollingWindowStatistics
+{
+public:
+  RollingWindowStatistics(const size_t num_metrics, const size_t window_size);
+
+  void update(const Eigen::ArrayXd & values);
+  void reset();
+
+  size_t size() const { return count_; }
+  const Eigen::ArrayXd & mean() const { return mean_; }
+  Eigen::ArrayXd variance() const;  // unbiased sample variance
+  Eigen::ArrayXd max() const;
+
+private:
+  size_t num_metrics_;
+  size_t window_size_;
+  size_t count_{0};
+  size_t num_updates_{0};
+
+  Eigen::ArrayXXd samples_;  // ring buffer of the samples, one column per sample
+  Eigen::ArrayXd mean_;
+  Eigen::ArrayXd m2_;  // sum of the squared deviations from the mean
+
+  // (update number, value) pairs with decreasing values, the front is the maximum of the window
+  std::vector<std::deque<std::pair<size_t, double>>> max_queues_;
+};
+}  // namespace control_performance_analysis
+
+#endif  // CONTROL_PERFORMANCE_ANALYSIS__ROLLING_WINDOW_STATISTICS_HPP_
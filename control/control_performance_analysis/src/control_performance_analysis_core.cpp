@@ -17,6 +17,7 @@
 #include "tier4_autoware_utils/tier4_autoware_utils.hpp"
 
 #include <algorithm>
+#include <array>
 #include <limits>
 #include <memory>
 #include <utility>
@@ -26,6 +27,75 @@ namespace control_performance_analysis
 {
 using geometry_msgs::msg::Quaternion;
 
+namespace
+{
+using ErrorField = double msg::Error::*;
+using DrivingField = msg::FloatStamped DrivingMonitorStamped::*;
+
+// all the error vars, in the order of the statistics arrays
+constexpr std::array<ErrorField, 15> error_fields{
+  &msg::Error::lateral_error,
+  &msg::Error::lateral_error_velocity,
+  &msg::Error::lateral_error_acceleration,
+  &msg::Error::longitudinal_error,
+  &msg::Error::longitudinal_error_velocity,
+  &msg::Error::longitudinal_error_acceleration,
+  &msg::Error::heading_error,
+  &msg::Error::heading_error_velocity,
+  &msg::Error::control_effort_energy,
+  &msg::Error::error_energy,
+  &msg::Error::value_approximation,
+  &msg::Error::curvature_estimate,
+  &msg::Error::curvature_estimate_pp,
+  &msg::Error::vehicle_velocity_error,
+  &msg::Error::tracking_curvature_discontinuity_ability};
+
+// error vars smoothed by the LPF
+constexpr std::array<ErrorField, 12> lpf_error_fields{
+  &msg::Error::curvature_estimate,
+  &msg::Error::curvature_estimate_pp,
+  &msg::Error::lateral_error,
+  &msg::Error::lateral_error_velocity,
+  &msg::Error::lateral_error_acceleration,
+  &msg::Error::longitudinal_error,
+  &msg::Error::longitudinal_error_velocity,
+  &msg::Error::longitudinal_error_acceleration,
+  &msg::Error::heading_error,
+  &msg::Error::heading_error_velocity,
+  &msg::Error::control_effort_energy,
+  &msg::Error::error_energy};
+
+// driving status vars smoothed by the LPF
+constexpr std::array<DrivingField, 6> lpf_driving_fields{
+  &DrivingMonitorStamped::longitudinal_acceleration,
+  &DrivingMonitorStamped::lateral_acceleration,
+  &DrivingMonitorStamped::lateral_jerk,
+  &DrivingMonitorStamped::longitudinal_jerk,
+  &DrivingMonitorStamped::controller_processing_time,
+  &DrivingMonitorStamped::desired_steering_angle};
+
+// length along the trajectory around the last closest waypoint searched first [m]
+constexpr double nearest_search_window_length = 10.0;
+
+Eigen::ArrayXd toArray(const msg::Error & error)
+{
+  Eigen::ArrayXd values(error_fields.size());
+  for (size_t i = 0; i < error_fields.size(); ++i) {
+    values(i) = error.*error_fields.at(i);
+  }
+  return values;
+}
+
+msg::Error fromArray(const Eigen::ArrayXd & values)
+{
+  msg::Error error;
+  for (size_t i = 0; i < error_fields.size(); ++i) {
+    error.*error_fields.at(i) = values(i);
+  }
+  return error;
+}
+}  // namespace
+
 ControlPerformanceAnalysisCore::ControlPerformanceAnalysisCore()
 {
   prev_target_vars_ = std::make_unique<msg::ErrorStamped>();
@@ -38,6 +108,9 @@ ControlPerformanceAnalysisCore::ControlPerformanceAnalysisCore()
   p_.prevent_zero_division_value_ = 0.001;
   p_.lpf_gain_ = 0.8;
   p_.wheelbase_ = 2.74;
+  p_.statistics_window_size_ = 100;
+  error_statistics_ =
+    std::make_unique<RollingWindowStatistics>(2 * error_fields.size(), p_.statistics_window_size_);
 }
 
 ControlPerformanceAnalysisCore::ControlPerformanceAnalysisCore(Params & p) : p_{p}
@@ -46,17 +119,39 @@ ControlPerformanceAnalysisCore::ControlPerformanceAnalysisCore(Params & p) : p_{
   prev_target_vars_ = std::make_unique<msg::ErrorStamped>();
   prev_driving_vars_ = std::make_unique<msg::DrivingMonitorStamped>();
   odom_history_ptr_ = std::make_shared<std::vector<Odometry>>();
+  error_statistics_ =
+    std::make_unique<RollingWindowStatistics>(2 * error_fields.size(), p_.statistics_window_size_);
 }
 
 void ControlPerformanceAnalysisCore::setCurrentWaypoints(const Trajectory & trajectory)
 {
+  // The same trajectory is given on every odometry, so the waypoints and the search hint are kept
+  // until a new trajectory arrives.
+  if (
+    current_waypoints_ptr_ && trajectory.header.stamp == current_waypoints_stamp_ &&
+    trajectory.points.size() == current_waypoints_ptr_->poses.size()) {
+    return;
+  }
+
   current_waypoints_ptr_ = std::make_shared<PoseArray>();
   current_waypoints_vel_ptr_ = std::make_shared<std::vector<double>>();
+  current_waypoints_ptr_->poses.reserve(trajectory.points.size());
+  current_waypoints_vel_ptr_->reserve(trajectory.points.size());
+  current_waypoints_arc_length_.clear();
+  current_waypoints_arc_length_.reserve(trajectory.points.size());
 
   for (const auto & point : trajectory.points) {
+    const double arc_length =
+      current_waypoints_ptr_->poses.empty()
+        ? 0.0
+        : current_waypoints_arc_length_.back() +
+            tier4_autoware_utils::calcDistance2d(current_waypoints_ptr_->poses.back(), point.pose);
     current_waypoints_ptr_->poses.emplace_back(point.pose);
     current_waypoints_vel_ptr_->emplace_back(point.longitudinal_velocity_mps);
+    current_waypoints_arc_length_.push_back(arc_length);
   }
+  current_waypoints_stamp_ = trajectory.header.stamp;
+  idx_closest_hint_ = boost::none;
 }
 
 void ControlPerformanceAnalysisCore::setOdomHistory(const Odometry & odom)
@@ -90,9 +185,14 @@ std::pair<bool, int32_t> ControlPerformanceAnalysisCore::findClosestPrevWayPoint
     return std::make_pair(false, std::numeric_limits<int32_t>::quiet_NaN());
   }
 
-  auto closest_idx = motion_utils::findNearestIndex(
-    current_waypoints_ptr_->poses, *current_vec_pose_ptr_, p_.acceptable_max_distance_to_waypoint_,
+  const auto closest_idx = motion_utils::findNearestIndexWithHint(
+    current_waypoints_ptr_->poses, current_waypoints_arc_length_, *current_vec_pose_ptr_,
+    idx_closest_hint_, nearest_search_window_length, p_.acceptable_max_distance_to_waypoint_,
     p_.acceptable_max_yaw_difference_rad_);
+  if (!closest_idx) {
+    return std::make_pair(false, std::numeric_limits<int32_t>::quiet_NaN());
+  }
+  idx_closest_hint_ = closest_idx;
 
   // find the prev and next waypoint
 
@@ -286,53 +386,14 @@ bool ControlPerformanceAnalysisCore::calculateErrorVars()
     (std::fabs(curvature_est - prev_target_vars_->error.curvature_estimate)) /
     (1 + std::fabs(lateral_error - prev_target_vars_->error.lateral_error));
 
+  updateErrorStatistics();
+
   if (prev_target_vars_) {
     // LPF for error vars
-
-    error_vars.error.curvature_estimate =
-      p_.lpf_gain_ * prev_target_vars_->error.curvature_estimate +
-      (1 - p_.lpf_gain_) * error_vars.error.curvature_estimate;
-
-    error_vars.error.curvature_estimate_pp =
-      p_.lpf_gain_ * prev_target_vars_->error.curvature_estimate_pp +
-      (1 - p_.lpf_gain_) * error_vars.error.curvature_estimate_pp;
-
-    error_vars.error.lateral_error = p_.lpf_gain_ * prev_target_vars_->error.lateral_error +
-                                     (1 - p_.lpf_gain_) * error_vars.error.lateral_error;
-
-    error_vars.error.lateral_error_velocity =
-      p_.lpf_gain_ * prev_target_vars_->error.lateral_error_velocity +
-      (1 - p_.lpf_gain_) * error_vars.error.lateral_error_velocity;
-
-    error_vars.error.lateral_error_acceleration =
-      p_.lpf_gain_ * prev_target_vars_->error.lateral_error_acceleration +
-      (1 - p_.lpf_gain_) * error_vars.error.lateral_error_acceleration;
-
-    error_vars.error.longitudinal_error =
-      p_.lpf_gain_ * prev_target_vars_->error.longitudinal_error +
-      (1 - p_.lpf_gain_) * error_vars.error.longitudinal_error;
-
-    error_vars.error.longitudinal_error_velocity =
-      p_.lpf_gain_ * prev_target_vars_->error.longitudinal_error_velocity +
-      (1 - p_.lpf_gain_) * error_vars.error.longitudinal_error_velocity;
-
-    error_vars.error.longitudinal_error_acceleration =
-      p_.lpf_gain_ * prev_target_vars_->error.longitudinal_error_acceleration +
-      (1 - p_.lpf_gain_) * error_vars.error.longitudinal_error_acceleration;
-
-    error_vars.error.heading_error = p_.lpf_gain_ * prev_target_vars_->error.heading_error +
-                                     (1 - p_.lpf_gain_) * error_vars.error.heading_error;
-
-    error_vars.error.heading_error_velocity =
-      p_.lpf_gain_ * prev_target_vars_->error.heading_error_velocity +
-      (1 - p_.lpf_gain_) * error_vars.error.heading_error_velocity;
-
-    error_vars.error.control_effort_energy =
-      p_.lpf_gain_ * prev_target_vars_->error.control_effort_energy +
-      (1 - p_.lpf_gain_) * error_vars.error.control_effort_energy;
-
-    error_vars.error.error_energy = p_.lpf_gain_ * prev_target_vars_->error.error_energy +
-                                    (1 - p_.lpf_gain_) * error_vars.error.error_energy;
+    for (const auto field : lpf_error_fields) {
+      error_vars.error.*field = p_.lpf_gain_ * prev_target_vars_->error.*field +
+                                (1 - p_.lpf_gain_) * error_vars.error.*field;
+    }
   }
 
   prev_target_vars_ = std::make_unique<msg::ErrorStamped>(error_vars);
@@ -407,30 +468,11 @@ bool ControlPerformanceAnalysisCore::calculateDrivingVars()
       }
       if (prev_driving_vars_) {
         // LPF for driving status vars
-
-        driving_status_vars.longitudinal_acceleration.data =
-          p_.lpf_gain_ * prev_driving_vars_->longitudinal_acceleration.data +
-          (1 - p_.lpf_gain_) * driving_status_vars.longitudinal_acceleration.data;
-
-        driving_status_vars.lateral_acceleration.data =
-          p_.lpf_gain_ * prev_driving_vars_->lateral_acceleration.data +
-          (1 - p_.lpf_gain_) * driving_status_vars.lateral_acceleration.data;
-
-        driving_status_vars.lateral_jerk.data =
-          p_.lpf_gain_ * prev_driving_vars_->lateral_jerk.data +
-          (1 - p_.lpf_gain_) * driving_status_vars.lateral_jerk.data;
-
-        driving_status_vars.longitudinal_jerk.data =
-          p_.lpf_gain_ * prev_driving_vars_->longitudinal_jerk.data +
-          (1 - p_.lpf_gain_) * driving_status_vars.longitudinal_jerk.data;
-
-        driving_status_vars.controller_processing_time.data =
-          p_.lpf_gain_ * prev_driving_vars_->controller_processing_time.data +
-          (1 - p_.lpf_gain_) * driving_status_vars.controller_processing_time.data;
-
-        driving_status_vars.desired_steering_angle.data =
-          p_.lpf_gain_ * prev_driving_vars_->desired_steering_angle.data +
-          (1 - p_.lpf_gain_) * driving_status_vars.desired_steering_angle.data;
+        for (const auto field : lpf_driving_fields) {
+          (driving_status_vars.*field).data =
+            p_.lpf_gain_ * (prev_driving_vars_.get()->*field).data +
+            (1 - p_.lpf_gain_) * (driving_status_vars.*field).data;
+        }
       }
 
       prev_driving_vars_ =
@@ -455,6 +497,23 @@ bool ControlPerformanceAnalysisCore::calculateDrivingVars()
   }
 }
 
+void ControlPerformanceAnalysisCore::updateErrorStatistics()
+{
+  // the absolute values are appended to the error vars to take their maximum in the same update
+  const size_t n = error_fields.size();
+  Eigen::ArrayXd values(2 * n);
+  values.head(n) = toArray(error_vars.error);
+  values.tail(n) = values.head(n).abs();
+  error_statistics_->update(values);
+
+  error_statistics_vars.header = error_vars.header;
+  error_statistics_vars.window_size = error_statistics_->size();
+  error_statistics_vars.mean = fromArray(error_statistics_->mean().head(n));
+  error_statistics_vars.standard_deviation =
+    fromArray(error_statistics_->variance().head(n).sqrt());
+  error_statistics_vars.abs_max = fromArray(error_statistics_->max().tail(n));
+}
+
 void ControlPerformanceAnalysisCore::setSteeringStatus(const SteeringReport & steering)
 {
   current_vec_steering_msg_ptr_ = std::make_shared<SteeringReport>(steering);
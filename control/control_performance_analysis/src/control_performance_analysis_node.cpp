@@ -20,6 +20,7 @@
 #include <vehicle_info_util/vehicle_info_util.hpp>
 
 #include <memory>
+#include <stdexcept>
 #include <utility>
 
 namespace
@@ -53,6 +54,11 @@ ControlPerformanceAnalysisNode::ControlPerformanceAnalysisNode(
   param_.acceptable_max_yaw_difference_rad_ =
     declare_parameter<double>("acceptable_max_yaw_difference_rad");
   param_.lpf_gain_ = declare_parameter<double>("low_pass_filter_gain");
+  const auto statistics_window_size = declare_parameter<int>("statistics_window_size");
+  if (statistics_window_size <= 0) {
+    throw std::invalid_argument("statistics_window_size must be positive");
+  }
+  param_.statistics_window_size_ = static_cast<uint>(statistics_window_size);
 
   // Prepare error computation class with the wheelbase parameter.
   control_performance_core_ptr_ = std::make_unique<ControlPerformanceAnalysisCore>(param_);
@@ -77,6 +83,9 @@ ControlPerformanceAnalysisNode::ControlPerformanceAnalysisNode(
 
   pub_driving_msg_ = create_publisher<DrivingMonitorStamped>("~/output/driving_status_stamped", 1);
 
+  pub_error_statistics_msg_ =
+    create_publisher<ErrorStatisticsStamped>("~/output/error_statistics_stamped", 1);
+
   // Wait for first self pose
   self_pose_listener_.waitForFirstPose();
 }
@@ -166,6 +175,7 @@ void ControlPerformanceAnalysisNode::onVelocity(const Odometry::ConstSharedPtr m
   // Compute control performance values.
   if (control_performance_core_ptr_->calculateErrorVars()) {
     pub_error_msg_->publish(control_performance_core_ptr_->error_vars);
+    pub_error_statistics_msg_->publish(control_performance_core_ptr_->error_statistics_vars);
   } else {
     RCLCPP_ERROR(get_logger(), "Cannot compute error vars ...");
   }
@@ -0,0 +1,98 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "control_performance_analysis/rolling_window_statistics.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace control_performance_analysis
+{
+RollingWindowStatistics::RollingWindowStatistics(const size_t num_metrics, const size_t window_size)
+: num_metrics_(num_metrics), window_size_(window_size)
+{
+  if (window_size_ == 0) {
+    throw std::invalid_argument("window size of the statistics must be positive");
+  }
+  samples_.resize(num_metrics_, window_size_);
+  max_queues_.resize(num_metrics_);
+  reset();
+}
+
+void RollingWindowStatistics::reset()
+{
+  count_ = 0;
+  num_updates_ = 0;
+  mean_ = Eigen::ArrayXd::Zero(num_metrics_);
+  m2_ = Eigen::ArrayXd::Zero(num_metrics_);
+  for (auto & queue : max_queues_) {
+    queue.clear();
+  }
+}
+
+void RollingWindowStatistics::update(const Eigen::ArrayXd & values)
+{
+  if (static_cast<size_t>(values.size()) != num_metrics_) {
+    throw std::invalid_argument("number of the metrics does not match the statistics");
+  }
+
+  const size_t column = num_updates_ % window_size_;
+  if (count_ < window_size_) {
+    // the window is growing
+    ++count_;
+    const Eigen::ArrayXd delta = values - mean_;
+    mean_ += delta / static_cast<double>(count_);
+    m2_ += delta * (values - mean_);
+  } else {
+    // the oldest sample leaves the window
+    const Eigen::ArrayXd oldest = samples_.col(column);
+    const Eigen::ArrayXd prev_mean = mean_;
+    mean_ += (values - oldest) / static_cast<double>(window_size_);
+    m2_ += (values - oldest) * (values - mean_ + oldest - prev_mean);
+  }
+  samples_.col(column) = values;
+
+  for (size_t i = 0; i < num_metrics_; ++i) {
+    auto & queue = max_queues_.at(i);
+    while (!queue.empty() && queue.back().second <= values(i)) {
+      queue.pop_back();
+    }
+    queue.emplace_back(num_updates_, values(i));
+    while (queue.front().first + window_size_ <= num_updates_) {
+      queue.pop_front();
+    }
+  }
+  ++num_updates_;
+}
+
+Eigen::ArrayXd RollingWindowStatistics::variance() const
+{
+  if (count_ < 2) {
+    return Eigen::ArrayXd::Zero(num_metrics_);
+  }
+  // rounding errors of the sliding update may make it slightly negative
+  return m2_.max(0.0) / static_cast<double>(count_ - 1);
+}
+
+Eigen::ArrayXd RollingWindowStatistics::max() const
+{
+  Eigen::ArrayXd max_values = Eigen::ArrayXd::Zero(num_metrics_);
+  for (size_t i = 0; i < num_metrics_; ++i) {
+    if (!max_queues_.at(i).empty()) {
+      max_values(i) = max_queues_.at(i).front().second;
+    }
+  }
+  return max_values;
+}
+}  // namespace control_performance_analysis
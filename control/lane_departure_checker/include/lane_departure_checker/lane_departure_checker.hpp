@@ -15,6 +15,8 @@
 #ifndef LANE_DEPARTURE_CHECKER__LANE_DEPARTURE_CHECKER_HPP_
 #define LANE_DEPARTURE_CHECKER__LANE_DEPARTURE_CHECKER_HPP_
 
+#include "lane_departure_checker/util/create_vehicle_footprint.hpp"
+
 #include <rosidl_runtime_cpp/message_initialization.hpp>
 #include <tier4_autoware_utils/geometry/boost_geometry.hpp>
 #include <tier4_autoware_utils/geometry/pose_deviation.hpp>
@@ -30,13 +32,16 @@
 #include <geometry_msgs/msg/twist_stamped.hpp>
 #include <nav_msgs/msg/odometry.hpp>
 
+#include <boost/geometry/index/rtree.hpp>
 #include <boost/optional.hpp>
 
 #include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_core/primitives/Polygon.h>
 
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace lane_departure_checker
@@ -45,6 +50,7 @@ using autoware_auto_planning_msgs::msg::PathWithLaneId;
 using autoware_auto_planning_msgs::msg::Trajectory;
 using autoware_auto_planning_msgs::msg::TrajectoryPoint;
 using autoware_planning_msgs::msg::LaneletRoute;
+using tier4_autoware_utils::Box2d;
 using tier4_autoware_utils::LinearRing2d;
 using tier4_autoware_utils::PoseDeviation;
 using TrajectoryPoints = std::vector<TrajectoryPoint>;
@@ -75,6 +81,15 @@ struct Input
   Trajectory::ConstSharedPtr predicted_trajectory{};
 };
 
+// polygons of lanelets with an rtree of their envelopes, built once for each set of lanelets
+struct LaneletsIndex
+{
+  std::vector<lanelet::Id> ids{};
+  std::vector<lanelet::BasicPolygon2d> polygons{};
+  boost::geometry::index::rtree<std::pair<Box2d, size_t>, boost::geometry::index::rstar<16>>
+    rtree{};
+};
+
 struct Output
 {
   std::map<std::string, double> processing_time_map{};
@@ -115,6 +130,17 @@ private:
   Param param_;
   std::shared_ptr<vehicle_info_util::VehicleInfo> vehicle_info_ptr_;
 
+  LaneletsIndex route_lanelets_index_;
+  LaneletsIndex shoulder_lanelets_index_;
+
+  // footprints of the last update, reused for the unchanged prefix of the trajectory
+  FootprintMargin prev_footprint_margin_{};
+  std::vector<geometry_msgs::msg::Pose> prev_footprint_poses_;
+  std::vector<LinearRing2d> prev_vehicle_footprints_;
+
+  static void updateLaneletsIndex(
+    const lanelet::ConstLanelets & lanelets, LaneletsIndex & lanelets_index);
+
   static PoseDeviation calcTrajectoryDeviation(
     const Trajectory & trajectory, const geometry_msgs::msg::Pose & pose,
     const double dist_threshold, const double yaw_threshold);
@@ -135,6 +161,13 @@ private:
   static bool willLeaveLane(
     const lanelet::ConstLanelets & candidate_lanelets,
     const std::vector<LinearRing2d> & vehicle_footprints);
+  static bool willLeaveLane(
+    const std::vector<lanelet::BasicPolygon2d> & candidate_polygons,
+    const std::vector<LinearRing2d> & vehicle_footprints);
+
+  static bool isOutOfLane(
+    const std::vector<lanelet::BasicPolygon2d> & candidate_polygons,
+    const LinearRing2d & vehicle_footprint);
 };
 }  // namespace lane_departure_checker
 
@@ -28,8 +28,11 @@
 #include <tf2/utils.h>
 
 #include <algorithm>
+#include <iterator>
+#include <utility>
 #include <vector>
 
+using tier4_autoware_utils::Box2d;
 using tier4_autoware_utils::LinearRing2d;
 using tier4_autoware_utils::MultiPoint2d;
 using tier4_autoware_utils::Point2d;
@@ -46,10 +49,11 @@ double calcBrakingDistance(
   return (abs_velocity * abs_velocity) / (2.0 * max_deceleration) + delay_time * abs_velocity;
 }
 
-bool isInAnyLane(const lanelet::ConstLanelets & candidate_lanelets, const Point2d & point)
+bool isInAnyLane(
+  const std::vector<lanelet::BasicPolygon2d> & candidate_polygons, const Point2d & point)
 {
-  for (const auto & ll : candidate_lanelets) {
-    if (boost::geometry::within(point, ll.polygon2d().basicPolygon())) {
+  for (const auto & polygon : candidate_polygons) {
+    if (boost::geometry::within(point, polygon)) {
       return true;
     }
   }
@@ -57,6 +61,26 @@ bool isInAnyLane(const lanelet::ConstLanelets & candidate_lanelets, const Point2
   return false;
 }
 
+std::vector<lanelet::BasicPolygon2d> toBasicPolygons(const lanelet::ConstLanelets & lanelets)
+{
+  std::vector<lanelet::BasicPolygon2d> polygons;
+  polygons.reserve(lanelets.size());
+  for (const auto & lanelet : lanelets) {
+    polygons.push_back(lanelet.polygon2d().basicPolygon());
+  }
+  return polygons;
+}
+
+Box2d calcEnvelope(const lanelet::BasicPolygon2d & polygon)
+{
+  Box2d box;
+  boost::geometry::assign_inverse(box);
+  for (const auto & p : polygon) {
+    boost::geometry::expand(box, Point2d(p.x(), p.y()));
+  }
+  return box;
+}
+
 LinearRing2d createHullFromFootprints(const std::vector<LinearRing2d> & footprints)
 {
   MultiPoint2d combined;
@@ -89,6 +113,34 @@ lanelet::ConstLanelets getCandidateLanelets(
 
   return candidate_lanelets;
 }
+
+void getCandidateLanelets(
+  const lanelet::ConstLanelets & lanelets, const lane_departure_checker::LaneletsIndex & index,
+  const LinearRing2d & footprint_hull, lanelet::ConstLanelets & candidate_lanelets,
+  std::vector<lanelet::BasicPolygon2d> & candidate_polygons)
+{
+  Box2d hull_box;
+  boost::geometry::envelope(footprint_hull, hull_box);
+
+  std::vector<std::pair<Box2d, size_t>> query_results;
+  index.rtree.query(
+    boost::geometry::index::intersects(hull_box), std::back_inserter(query_results));
+
+  // keep the order of the given lanelets
+  std::vector<size_t> candidate_indices;
+  candidate_indices.reserve(query_results.size());
+  for (const auto & result : query_results) {
+    candidate_indices.push_back(result.second);
+  }
+  std::sort(candidate_indices.begin(), candidate_indices.end());
+
+  for (const auto i : candidate_indices) {
+    if (!boost::geometry::disjoint(index.polygons.at(i), footprint_hull)) {
+      candidate_lanelets.push_back(lanelets.at(i));
+      candidate_polygons.push_back(index.polygons.at(i));
+    }
+  }
+}
 }  // namespace
 
 namespace lane_departure_checker
@@ -124,26 +176,55 @@ Output LaneDepartureChecker::update(const Input & input)
   output.vehicle_passing_areas = createVehiclePassingAreas(output.vehicle_footprints);
   output.processing_time_map["createVehiclePassingAreas"] = stop_watch.toc(true);
 
-  const auto candidate_road_lanelets =
-    getCandidateLanelets(input.route_lanelets, output.vehicle_footprints);
-  const auto candidate_shoulder_lanelets =
-    getCandidateLanelets(input.shoulder_lanelets, output.vehicle_footprints);
-  output.candidate_lanelets = candidate_road_lanelets;
-  output.candidate_lanelets.insert(
-    output.candidate_lanelets.end(), candidate_shoulder_lanelets.begin(),
-    candidate_shoulder_lanelets.end());
+  updateLaneletsIndex(input.route_lanelets, route_lanelets_index_);
+  updateLaneletsIndex(input.shoulder_lanelets, shoulder_lanelets_index_);
+  output.processing_time_map["updateLaneletsIndex"] = stop_watch.toc(true);
+
+  std::vector<lanelet::BasicPolygon2d> candidate_polygons;
+  {
+    const auto footprint_hull = createHullFromFootprints(output.vehicle_footprints);
+    getCandidateLanelets(
+      input.route_lanelets, route_lanelets_index_, footprint_hull, output.candidate_lanelets,
+      candidate_polygons);
+    getCandidateLanelets(
+      input.shoulder_lanelets, shoulder_lanelets_index_, footprint_hull, output.candidate_lanelets,
+      candidate_polygons);
+  }
 
   output.processing_time_map["getCandidateLanelets"] = stop_watch.toc(true);
 
-  output.will_leave_lane = willLeaveLane(output.candidate_lanelets, output.vehicle_footprints);
+  output.will_leave_lane = willLeaveLane(candidate_polygons, output.vehicle_footprints);
   output.processing_time_map["willLeaveLane"] = stop_watch.toc(true);
 
-  output.is_out_of_lane = isOutOfLane(output.candidate_lanelets, output.vehicle_footprints.front());
+  output.is_out_of_lane = isOutOfLane(candidate_polygons, output.vehicle_footprints.front());
   output.processing_time_map["isOutOfLane"] = stop_watch.toc(true);
 
   return output;
 }
 
+void LaneDepartureChecker::updateLaneletsIndex(
+  const lanelet::ConstLanelets & lanelets, LaneletsIndex & lanelets_index)
+{
+  std::vector<lanelet::Id> ids;
+  ids.reserve(lanelets.size());
+  for (const auto & lanelet : lanelets) {
+    ids.push_back(lanelet.id());
+  }
+  if (ids == lanelets_index.ids) {
+    return;
+  }
+
+  lanelets_index.ids = std::move(ids);
+  lanelets_index.polygons = toBasicPolygons(lanelets);
+
+  std::vector<std::pair<Box2d, size_t>> boxes;
+  boxes.reserve(lanelets_index.polygons.size());
+  for (size_t i = 0; i < lanelets_index.polygons.size(); ++i) {
+    boxes.emplace_back(calcEnvelope(lanelets_index.polygons.at(i)), i);
+  }
+  lanelets_index.rtree = decltype(lanelets_index.rtree)(boxes.begin(), boxes.end());
+}
+
 bool LaneDepartureChecker::checkPathWillLeaveLane(
   const lanelet::ConstLanelets & lanelets, const PathWithLaneId & path) const
 {
@@ -234,13 +315,31 @@ std::vector<LinearRing2d> LaneDepartureChecker::createVehicleFootprints(
   // Create vehicle footprint in base_link coordinate
   const auto local_vehicle_footprint = vehicle_info_ptr_->createFootprint(margin.lat, margin.lon);
 
-  // Create vehicle footprint on each TrajectoryPoint
+  // Create vehicle footprint on each TrajectoryPoint, reusing the ones of the previous trajectory
+  // as long as the poses and the margin are unchanged
+  bool is_same_prefix =
+    margin.lon == prev_footprint_margin_.lon && margin.lat == prev_footprint_margin_.lat;
   std::vector<LinearRing2d> vehicle_footprints;
-  for (const auto & p : trajectory) {
-    vehicle_footprints.push_back(
-      transformVector(local_vehicle_footprint, tier4_autoware_utils::pose2transform(p.pose)));
+  std::vector<geometry_msgs::msg::Pose> poses;
+  vehicle_footprints.reserve(trajectory.size());
+  poses.reserve(trajectory.size());
+  for (size_t i = 0; i < trajectory.size(); ++i) {
+    const auto & pose = trajectory.at(i).pose;
+    is_same_prefix = is_same_prefix && i < prev_footprint_poses_.size() &&
+                     pose == prev_footprint_poses_.at(i);
+    if (is_same_prefix) {
+      vehicle_footprints.push_back(prev_vehicle_footprints_.at(i));
+    } else {
+      vehicle_footprints.push_back(
+        transformVector(local_vehicle_footprint, tier4_autoware_utils::pose2transform(pose)));
+    }
+    poses.push_back(pose);
   }
 
+  prev_footprint_margin_ = margin;
+  prev_footprint_poses_ = std::move(poses);
+  prev_vehicle_footprints_ = vehicle_footprints;
+
   return vehicle_footprints;
 }
 
@@ -277,9 +376,16 @@ std::vector<LinearRing2d> LaneDepartureChecker::createVehiclePassingAreas(
 bool LaneDepartureChecker::willLeaveLane(
   const lanelet::ConstLanelets & candidate_lanelets,
   const std::vector<LinearRing2d> & vehicle_footprints)
+{
+  return willLeaveLane(toBasicPolygons(candidate_lanelets), vehicle_footprints);
+}
+
+bool LaneDepartureChecker::willLeaveLane(
+  const std::vector<lanelet::BasicPolygon2d> & candidate_polygons,
+  const std::vector<LinearRing2d> & vehicle_footprints)
 {
   for (const auto & vehicle_footprint : vehicle_footprints) {
-    if (isOutOfLane(candidate_lanelets, vehicle_footprint)) {
+    if (isOutOfLane(candidate_polygons, vehicle_footprint)) {
       return true;
     }
   }
@@ -289,9 +395,16 @@ bool LaneDepartureChecker::willLeaveLane(
 
 bool LaneDepartureChecker::isOutOfLane(
   const lanelet::ConstLanelets & candidate_lanelets, const LinearRing2d & vehicle_footprint)
+{
+  return isOutOfLane(toBasicPolygons(candidate_lanelets), vehicle_footprint);
+}
+
+bool LaneDepartureChecker::isOutOfLane(
+  const std::vector<lanelet::BasicPolygon2d> & candidate_polygons,
+  const LinearRing2d & vehicle_footprint)
 {
   for (const auto & point : vehicle_footprint) {
-    if (!isInAnyLane(candidate_lanelets, point)) {
+    if (!isInAnyLane(candidate_polygons, point)) {
       return true;
     }
   }
@@ -41,6 +41,7 @@
 #include <deque>
 #include <memory>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace autoware::motion::control::mpc_lateral_controller
@@ -179,6 +180,16 @@ private:
   std::vector<AckermannLateralCommand> m_ctrl_cmd_vec;
   //!< @brief minimum prediction distance
   double m_min_prediction_length = 5.0;
+  //!< @brief mpc matrices, kept to reuse their memory over the control cycles
+  MPCMatrix m_mpc_matrix;
+  //!< @brief input of the last reference trajectory update, to skip the unchanged ones
+  Trajectory m_ref_traj_source;
+  std::tuple<double, bool, int, int, int, bool> m_ref_traj_source_param;
+  //!< @brief workspace of the condensed QP: Cex * Bex, Qex * Cex * Bex, Hessian and constraint
+  Eigen::MatrixXd m_qp_CB;
+  Eigen::MatrixXd m_qp_QCB;
+  Eigen::MatrixXd m_qp_H;
+  Eigen::MatrixXd m_qp_A;
 
   /**
    * @brief get variables for mpc calculation
@@ -216,8 +227,9 @@ private:
   /**
    * @brief generate MPC matrix with trajectory and vehicle model
    * @param [in] reference_trajectory used for linearization around reference trajectory
+   * @return reference to the matrices stored in this instance, valid until the next call
    */
-  MPCMatrix generateMPCMatrix(
+  const MPCMatrix & generateMPCMatrix(
     const MPCTrajectory & reference_trajectory, const double prediction_dt);
   /**
    * @brief generate MPC matrix with trajectory and vehicle model
@@ -384,6 +396,8 @@ public:
     Float32MultiArrayStamped & diagnostic);
   /**
    * @brief set the reference trajectory to follow
+   * @note the preprocessing is skipped when the trajectory and the parameters are the same as the
+   * ones of the last successful update
    */
   void setReferenceTrajectory(
     const Trajectory & trajectory_msg, const double traj_resample_dist,
@@ -17,6 +17,7 @@
 
 #include "eigen3/Eigen/Dense"
 #include "mpc_lateral_controller/qp_solver/qp_solver_interface.hpp"
+#include "osqp_interface/csc_matrix_conv.hpp"
 #include "osqp_interface/osqp_interface.hpp"
 #include "rclcpp/rclcpp.hpp"
 
@@ -55,8 +56,17 @@ public:
     const Eigen::VectorXd & ub_a, Eigen::VectorXd & u) override;
 
 private:
+  using CSC_Matrix = autoware::common::osqp::CSC_Matrix;
+
   autoware::common::osqp::OSQPInterface osqpsolver_;
   rclcpp::Logger logger_;
+
+  // the problem is kept between the calls and updated in place while the sparsity patterns of
+  // h_mat and a are unchanged, so that OSQP reuses its factorization and warm starts
+  bool is_problem_initialized_ = false;
+  Eigen::MatrixXd prev_a_;
+  CSC_Matrix prev_P_csc_;
+  CSC_Matrix prev_A_csc_;
 };
 }  // namespace autoware::motion::control::mpc_lateral_controller
 #endif  // MPC_LATERAL_CONTROLLER__QP_SOLVER__QP_SOLVER_OSQP_HPP_
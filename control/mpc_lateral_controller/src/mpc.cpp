@@ -21,6 +21,7 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -69,7 +70,7 @@ bool MPC::calculateMPC(
   }
 
   /* generate mpc matrix : predict equation Xec = Aex * x0 + Bex * Uex + Wex */
-  MPCMatrix mpc_matrix = generateMPCMatrix(mpc_resampled_ref_traj, prediction_dt);
+  const MPCMatrix & mpc_matrix = generateMPCMatrix(mpc_resampled_ref_traj, prediction_dt);
 
   /* solve quadratic optimization */
   Eigen::VectorXd Uex;
@@ -174,6 +175,18 @@ void MPC::setReferenceTrajectory(
   const int curvature_smoothing_num_traj, const int curvature_smoothing_num_ref_steer,
   const bool extend_trajectory_for_end_yaw_control)
 {
+  // the same trajectory is usually received many times, and the preprocessing below only depends
+  // on the message and the parameters
+  const auto param = std::make_tuple(
+    traj_resample_dist, enable_path_smoothing, path_filter_moving_ave_num,
+    curvature_smoothing_num_traj, curvature_smoothing_num_ref_steer,
+    extend_trajectory_for_end_yaw_control);
+  if (
+    !m_ref_traj.empty() && param == m_ref_traj_source_param &&
+    trajectory_msg == m_ref_traj_source) {
+    return;
+  }
+
   MPCTrajectory mpc_traj_raw;        // received raw trajectory
   MPCTrajectory mpc_traj_resampled;  // resampled trajectory
   MPCTrajectory mpc_traj_smoothed;   // smooth filtered trajectory
@@ -244,6 +257,8 @@ void MPC::setReferenceTrajectory(
   }
 
   m_ref_traj = mpc_traj_smoothed;
+  m_ref_traj_source = trajectory_msg;
+  m_ref_traj_source_param = param;
 }
 
 void MPC::resetPrevResult(const SteeringReport & current_steer)
@@ -505,7 +520,7 @@ MPCTrajectory MPC::applyVelocityDynamicsFilter(
  * cost function: J = Xex' * Qex * Xex + (Uex - Uref)' * R1ex * (Uex - Uref_ex) + Uex' * R2ex * Uex
  * Qex = diag([Q,Q,...]), R1ex = diag([R,R,...])
  */
-MPCMatrix MPC::generateMPCMatrix(
+const MPCMatrix & MPC::generateMPCMatrix(
   const MPCTrajectory & reference_trajectory, const double prediction_dt)
 {
   using Eigen::MatrixXd;
@@ -516,7 +531,8 @@ MPCMatrix MPC::generateMPCMatrix(
   const int DIM_U = m_vehicle_model_ptr->getDimU();
   const int DIM_Y = m_vehicle_model_ptr->getDimY();
 
-  MPCMatrix m;
+  // the matrices are reset in place, so that no allocation occurs while the horizon is unchanged
+  MPCMatrix & m = m_mpc_matrix;
   m.Aex = MatrixXd::Zero(DIM_X * N, DIM_X);
   m.Bex = MatrixXd::Zero(DIM_X * N, DIM_U * N);
   m.Wex = MatrixXd::Zero(DIM_X * N, 1);
@@ -649,23 +665,48 @@ bool MPC::executeOptimization(
     return false;
   }
 
-  const int DIM_U_N = m_param.prediction_horizon * m_vehicle_model_ptr->getDimU();
+  const int N = m_param.prediction_horizon;
+  const int DIM_X = m_vehicle_model_ptr->getDimX();
+  const int DIM_U = m_vehicle_model_ptr->getDimU();
+  const int DIM_Y = m_vehicle_model_ptr->getDimY();
+  const int DIM_U_N = N * DIM_U;
 
   // cost function: 1/2 * Uex' * H * Uex + f' * Uex,  H = B' * C' * Q * C * B + R
-  const MatrixXd CB = m.Cex * m.Bex;
-  const MatrixXd QCB = m.Qex * CB;
-  // MatrixXd H = CB.transpose() * QCB + m.R1ex + m.R2ex; // This calculation is heavy. looking for
-  // a good way.  //NOLINT
-  MatrixXd H = MatrixXd::Zero(DIM_U_N, DIM_U_N);
-  H.triangularView<Eigen::Upper>() = CB.transpose() * QCB;
+  // Cex and Qex are block diagonal and Bex is block lower triangular, so only the non-zero blocks
+  // are multiplied. The i-th block row of CB depends on the first (i + 1) inputs only, and its
+  // contribution to H is accumulated into the corresponding leading block of the upper triangle.
+  MatrixXd & CB = m_qp_CB;
+  MatrixXd & QCB = m_qp_QCB;
+  MatrixXd & H = m_qp_H;
+  CB.setZero(DIM_Y * N, DIM_U_N);
+  QCB.setZero(DIM_Y * N, DIM_U_N);
+  H.setZero(DIM_U_N, DIM_U_N);
+  VectorXd Cx_free(DIM_Y * N);  // Cex * (Aex * x0 + Wex)
+  for (int i = 0; i < N; ++i) {
+    const int idx_x_i = i * DIM_X;
+    const int idx_y_i = i * DIM_Y;
+    const int dim_u_i = (i + 1) * DIM_U;
+    const auto Cd = m.Cex.block(idx_y_i, idx_x_i, DIM_Y, DIM_X);
+    auto CB_i = CB.block(idx_y_i, 0, DIM_Y, dim_u_i);
+    auto QCB_i = QCB.block(idx_y_i, 0, DIM_Y, dim_u_i);
+    CB_i.noalias() = Cd * m.Bex.block(idx_x_i, 0, DIM_X, dim_u_i);
+    QCB_i.noalias() = m.Qex.block(idx_y_i, idx_y_i, DIM_Y, DIM_Y) * CB_i;
+    H.topLeftCorner(dim_u_i, dim_u_i).triangularView<Eigen::Upper>() += CB_i.transpose() * QCB_i;
+    Cx_free.segment(idx_y_i, DIM_Y).noalias() =
+      Cd * (m.Aex.block(idx_x_i, 0, DIM_X, DIM_X) * x0 + m.Wex.block(idx_x_i, 0, DIM_X, 1));
+  }
   H.triangularView<Eigen::Upper>() += m.R1ex + m.R2ex;
   H.triangularView<Eigen::Lower>() = H.transpose();
-  MatrixXd f = (m.Cex * (m.Aex * x0 + m.Wex)).transpose() * QCB - m.Uref_ex.transpose() * m.R1ex;
+  MatrixXd f = Cx_free.transpose() * QCB - m.Uref_ex.transpose() * m.R1ex;
   addSteerWeightF(prediction_dt, &f);
 
-  MatrixXd A = MatrixXd::Identity(DIM_U_N, DIM_U_N);
-  for (int i = 1; i < DIM_U_N; i++) {
-    A(i, i - 1) = -1.0;
+  // the constraint matrix only depends on the horizon
+  MatrixXd & A = m_qp_A;
+  if (A.rows() != DIM_U_N) {
+    A = MatrixXd::Identity(DIM_U_N, DIM_U_N);
+    for (int i = 1; i < DIM_U_N; i++) {
+      A(i, i - 1) = -1.0;
+    }
   }
 
   VectorXd lb = VectorXd::Constant(DIM_U_N, -m_steer_lim);  // min steering angle
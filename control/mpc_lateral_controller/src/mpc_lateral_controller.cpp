@@ -184,9 +184,9 @@ trajectory_follower::LateralOutput MpcLateralController::run(
   trajectory_follower::InputData const & input_data)
 {
   // set input data
-  setTrajectory(input_data.current_trajectory);
-  m_current_kinematic_state = input_data.current_odometry;
-  m_current_steering = input_data.current_steering;
+  setTrajectory(*input_data.current_trajectory);
+  m_current_kinematic_state = *input_data.current_odometry;
+  m_current_steering = *input_data.current_steering;
   if (enable_auto_steering_offset_removal_) {
     m_current_steering.steering_tire_angle -= steering_offset_->getOffset();
   }
@@ -216,7 +216,7 @@ trajectory_follower::LateralOutput MpcLateralController::run(
   if (enable_auto_steering_offset_removal_) {
     steering_offset_->updateOffset(
       m_current_kinematic_state.twist.twist,
-      input_data.current_steering.steering_tire_angle);  // use unbiased steering
+      input_data.current_steering->steering_tire_angle);  // use unbiased steering
     ctrl_cmd.steering_tire_angle += steering_offset_->getOffset();
   }
 
@@ -270,9 +270,9 @@ bool MpcLateralController::isSteerConverged(
 
 bool MpcLateralController::isReady(const trajectory_follower::InputData & input_data)
 {
-  setTrajectory(input_data.current_trajectory);
-  m_current_kinematic_state = input_data.current_odometry;
-  m_current_steering = input_data.current_steering;
+  setTrajectory(*input_data.current_trajectory);
+  m_current_kinematic_state = *input_data.current_odometry;
+  m_current_steering = *input_data.current_steering;
 
   if (!m_mpc.hasVehicleModel()) {
     RCLCPP_INFO_THROTTLE(
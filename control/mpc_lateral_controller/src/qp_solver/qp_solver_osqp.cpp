@@ -15,10 +15,20 @@
 #include "mpc_lateral_controller/qp_solver/qp_solver_osqp.hpp"
 
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace autoware::motion::control::mpc_lateral_controller
 {
+namespace
+{
+bool hasSameSparsity(
+  const autoware::common::osqp::CSC_Matrix & m1, const autoware::common::osqp::CSC_Matrix & m2)
+{
+  return m1.m_row_idxs == m2.m_row_idxs && m1.m_col_idxs == m2.m_col_idxs;
+}
+}  // namespace
+
 QPSolverOSQP::QPSolverOSQP(const rclcpp::Logger & logger) : logger_{logger} {}
 bool QPSolverOSQP::solve(
   const Eigen::MatrixXd & h_mat, const Eigen::MatrixXd & f_vec, const Eigen::MatrixXd & a,
@@ -28,13 +38,14 @@ bool QPSolverOSQP::solve(
   const Eigen::Index raw_a = a.rows();
   const Eigen::Index col_a = a.cols();
   const Eigen::Index dim_u = ub.size();
-  Eigen::MatrixXd Identity = Eigen::MatrixXd::Identity(dim_u, dim_u);
 
   // convert matrix to vector for osqpsolver
   std::vector<double> f(&f_vec(0), f_vec.data() + f_vec.cols() * f_vec.rows());
 
   std::vector<double> lower_bound;
   std::vector<double> upper_bound;
+  lower_bound.reserve(dim_u + col_a);
+  upper_bound.reserve(dim_u + col_a);
 
   for (int i = 0; i < dim_u; ++i) {
     lower_bound.push_back(lb(i));
@@ -46,11 +57,37 @@ bool QPSolverOSQP::solve(
     upper_bound.push_back(ub_a(i));
   }
 
-  Eigen::MatrixXd osqpA = Eigen::MatrixXd(dim_u + col_a, raw_a);
-  osqpA << Identity, a;
+  const CSC_Matrix P_csc = autoware::common::osqp::calCSCMatrixTrapezoidal(h_mat);
+  bool is_structure_changed = !is_problem_initialized_ || !hasSameSparsity(P_csc, prev_P_csc_);
+
+  // the constraint matrix is usually constant, so it is converted only when it changes
+  const bool is_a_changed = !is_problem_initialized_ || a.rows() != prev_a_.rows() ||
+                            a.cols() != prev_a_.cols() || a != prev_a_;
+  if (is_a_changed) {
+    Eigen::MatrixXd osqpA = Eigen::MatrixXd(dim_u + col_a, raw_a);
+    osqpA << Eigen::MatrixXd::Identity(dim_u, dim_u), a;
+    CSC_Matrix A_csc = autoware::common::osqp::calCSCMatrix(osqpA);
+    is_structure_changed = is_structure_changed || !hasSameSparsity(A_csc, prev_A_csc_);
+    prev_A_csc_ = std::move(A_csc);
+    prev_a_ = a;
+  }
+
+  if (is_structure_changed) {
+    osqpsolver_.initializeProblem(P_csc, prev_A_csc_, f, lower_bound, upper_bound);
+  } else {
+    // keep the workspace and the previous solution as the warm start
+    osqpsolver_.updateCscP(P_csc);
+    if (is_a_changed) {
+      osqpsolver_.updateCscA(prev_A_csc_);
+    }
+    osqpsolver_.updateQ(f);
+    osqpsolver_.updateBounds(lower_bound, upper_bound);
+  }
+  prev_P_csc_ = P_csc;
+  is_problem_initialized_ = true;
 
   /* execute optimization */
-  auto result = osqpsolver_.optimize(h_mat, osqpA, f, lower_bound, upper_bound);
+  auto result = osqpsolver_.optimize();
 
   std::vector<double> U_osqp = std::get<0>(result);
   u = Eigen::Map<Eigen::Matrix<double, Eigen::Dynamic, 1>>(
@@ -60,6 +97,8 @@ bool QPSolverOSQP::solve(
   if (status_val != 1) {
     // TODO(Horibe): Should return false and the failure must be handled in an appropriate way.
     RCLCPP_WARN(logger_, "optimization failed : %s", osqpsolver_.getStatusMessage().c_str());
+    // do not warm start the next problem from an unconverged solution
+    is_problem_initialized_ = false;
   }
 
   // polish status: successful (1), unperformed (0), (-1) unsuccessful
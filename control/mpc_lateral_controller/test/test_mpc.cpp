@@ -213,6 +213,31 @@ TEST_F(MPCTest, InitializeAndCalculate)
   EXPECT_EQ(ctrl_cmd.steering_tire_rotation_rate, 0.0f);
 }
 
+TEST_F(MPCTest, SetSameReferenceTrajectory)
+{
+  mpc_lateral_controller::MPC mpc;
+  initializeMPC(mpc);
+  const auto set_reference_trajectory = [&](const Trajectory & trajectory) {
+    mpc.setReferenceTrajectory(
+      trajectory, traj_resample_dist, enable_path_smoothing, path_filter_moving_ave_num,
+      curvature_smoothing_num_traj, curvature_smoothing_num_ref_steer,
+      extend_trajectory_for_end_yaw_control);
+  };
+
+  set_reference_trajectory(dummy_straight_trajectory);
+  const auto straight_ref_traj = mpc.m_ref_traj;
+  set_reference_trajectory(dummy_straight_trajectory);
+  EXPECT_EQ(mpc.m_ref_traj.y, straight_ref_traj.y);
+  EXPECT_EQ(mpc.m_ref_traj.k, straight_ref_traj.k);
+
+  set_reference_trajectory(dummy_right_turn_trajectory);
+  EXPECT_NE(mpc.m_ref_traj.y, straight_ref_traj.y);
+
+  set_reference_trajectory(dummy_straight_trajectory);
+  EXPECT_EQ(mpc.m_ref_traj.y, straight_ref_traj.y);
+  EXPECT_EQ(mpc.m_ref_traj.k, straight_ref_traj.k);
+}
+
 TEST_F(MPCTest, InitializeAndCalculateRightTurn)
 {
   mpc_lateral_controller::MPC mpc;
@@ -483,4 +508,38 @@ TEST_F(MPCTest, FailureCases)
   EXPECT_TRUE(
     mpc.calculateMPC(neutral_steer, default_velocity, pose_zero, ctrl_cmd, pred_traj, diag));
 }
+
+TEST(QPSolverOSQPTest, SolveUpdatedProblem)
+{
+  const rclcpp::Logger logger = rclcpp::get_logger("mpc_test_logger");
+  const Eigen::Index n = 4;
+  // minimize 1/2 u' * H * u + f' * u s.t. |u| < 1 and |u(i) - u(i-1)| < 0.5
+  Eigen::MatrixXd H = Eigen::MatrixXd::Identity(n, n) * 2.0;
+  H.diagonal(1).setConstant(-0.5);
+  H.diagonal(-1).setConstant(-0.5);
+  Eigen::MatrixXd A = Eigen::MatrixXd::Identity(n, n);
+  A.diagonal(-1).setConstant(-1.0);
+  const Eigen::VectorXd lb = Eigen::VectorXd::Constant(n, -1.0);
+  const Eigen::VectorXd ub = Eigen::VectorXd::Constant(n, 1.0);
+  const Eigen::VectorXd lb_a = Eigen::VectorXd::Constant(n, -0.5);
+  const Eigen::VectorXd ub_a = Eigen::VectorXd::Constant(n, 0.5);
+
+  // the second solve of the same solver updates the problem kept from the first one
+  mpc_lateral_controller::QPSolverOSQP updated_solver(logger);
+  Eigen::VectorXd u;
+  const Eigen::MatrixXd f1 = (Eigen::MatrixXd(n, 1) << 1.0, -2.0, 0.5, 3.0).finished();
+  ASSERT_TRUE(updated_solver.solve(H, f1, A, lb, ub, lb_a, ub_a, u));
+
+  const Eigen::MatrixXd f2 = (Eigen::MatrixXd(n, 1) << -1.0, 0.5, 2.0, -3.0).finished();
+  const Eigen::MatrixXd H2 = H * 1.5;
+  ASSERT_TRUE(updated_solver.solve(H2, f2, A, lb, ub, lb_a, ub_a, u));
+
+  mpc_lateral_controller::QPSolverOSQP new_solver(logger);
+  Eigen::VectorXd u_expected;
+  ASSERT_TRUE(new_solver.solve(H2, f2, A, lb, ub, lb_a, ub_a, u_expected));
+  ASSERT_EQ(u.size(), n);
+  for (Eigen::Index i = 0; i < n; ++i) {
+    EXPECT_NEAR(u(i), u_expected(i), 1e-3);
+  }
+}
 }  // namespace
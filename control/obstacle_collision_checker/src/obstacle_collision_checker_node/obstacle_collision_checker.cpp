@@ -14,16 +14,17 @@
 
 #include "obstacle_collision_checker/obstacle_collision_checker.hpp"
 
-#include <pcl_ros/transforms.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <tier4_autoware_utils/geometry/geometry.hpp>
 #include <tier4_autoware_utils/math/normalization.hpp>
 #include <tier4_autoware_utils/math/unit_conversion.hpp>
 #include <tier4_autoware_utils/system/stop_watch.hpp>
 
+#include <sensor_msgs/point_cloud2_iterator.hpp>
+
 #include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
 
-#include <pcl_conversions/pcl_conversions.h>
 #include <tf2/utils.h>
 
 #ifdef ROS_DISTRO_GALACTIC
@@ -33,23 +34,51 @@
 #endif
 
 #include <iostream>
+#include <utility>
 #include <vector>
 
 namespace
 {
-pcl::PointCloud<pcl::PointXYZ> getTransformedPointCloud(
+using tier4_autoware_utils::Box2d;
+using tier4_autoware_utils::LinearRing2d;
+using tier4_autoware_utils::Point2d;
+
+// transform the pointcloud in a single pass, keeping only the points within the given areas
+pcl::PointCloud<pcl::PointXYZ> getTransformedPointCloudWithinAreas(
   const sensor_msgs::msg::PointCloud2 & pointcloud_msg,
-  const geometry_msgs::msg::Transform & transform)
+  const geometry_msgs::msg::Transform & transform, const std::vector<LinearRing2d> & areas)
 {
-  const Eigen::Matrix4f transform_matrix = tf2::transformToEigen(transform).matrix().cast<float>();
+  namespace bgi = boost::geometry::index;
 
-  sensor_msgs::msg::PointCloud2 transformed_msg;
-  pcl_ros::transformPointCloud(transform_matrix, pointcloud_msg, transformed_msg);
+  std::vector<std::pair<Box2d, size_t>> area_boxes;
+  area_boxes.reserve(areas.size());
+  for (size_t i = 0; i < areas.size(); ++i) {
+    if (!areas.at(i).empty()) {
+      area_boxes.emplace_back(boost::geometry::return_envelope<Box2d>(areas.at(i)), i);
+    }
+  }
+  const bgi::rtree<std::pair<Box2d, size_t>, bgi::rstar<16>> area_rtree(
+    area_boxes.begin(), area_boxes.end());
 
-  pcl::PointCloud<pcl::PointXYZ> transformed_pointcloud;
-  pcl::fromROSMsg(transformed_msg, transformed_pointcloud);
+  const Eigen::Affine3f affine(tf2::transformToEigen(transform).matrix().cast<float>());
 
-  return transformed_pointcloud;
+  pcl::PointCloud<pcl::PointXYZ> pointcloud_within_areas;
+  if (area_rtree.empty()) {
+    return pointcloud_within_areas;
+  }
+  for (sensor_msgs::PointCloud2ConstIterator<float> iter_x(pointcloud_msg, "x"),
+       iter_y(pointcloud_msg, "y"), iter_z(pointcloud_msg, "z");
+       iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
+    const Eigen::Vector3f p = affine * Eigen::Vector3f(*iter_x, *iter_y, *iter_z);
+    const Point2d point(p.x(), p.y());
+    for (auto it = area_rtree.qbegin(bgi::intersects(point)); it != area_rtree.qend(); ++it) {
+      if (boost::geometry::within(point, areas.at(it->second))) {
+        pointcloud_within_areas.push_back(pcl::PointXYZ(p.x(), p.y(), p.z()));
+        break;
+      }
+    }
+  }
+  return pointcloud_within_areas;
 }
 
 pcl::PointCloud<pcl::PointXYZ> filterPointCloudByTrajectory(
@@ -102,12 +131,6 @@ Output ObstacleCollisionChecker::update(const Input & input)
     resampleTrajectory(*input.predicted_trajectory, param_.resample_interval), braking_distance);
   output.processing_time_map["resampleTrajectory"] = stop_watch.toc(true);
 
-  // resample pointcloud
-  const auto obstacle_pointcloud =
-    getTransformedPointCloud(*input.obstacle_pointcloud, input.obstacle_transform->transform);
-  const auto filtered_obstacle_pointcloud = filterPointCloudByTrajectory(
-    obstacle_pointcloud, output.resampled_trajectory, param_.search_radius);
-
   output.vehicle_footprints =
     createVehicleFootprints(output.resampled_trajectory, param_, vehicle_info_);
   output.processing_time_map["createVehicleFootprints"] = stop_watch.toc(true);
@@ -115,6 +138,17 @@ Output ObstacleCollisionChecker::update(const Input & input)
   output.vehicle_passing_areas = createVehiclePassingAreas(output.vehicle_footprints);
   output.processing_time_map["createVehiclePassingAreas"] = stop_watch.toc(true);
 
+  // resample pointcloud
+  // skip first passing area because surround obstacle checker handle it
+  const std::vector<LinearRing2d> checked_passing_areas(
+    std::next(output.vehicle_passing_areas.begin(), output.vehicle_passing_areas.empty() ? 0 : 1),
+    output.vehicle_passing_areas.end());
+  const auto obstacle_pointcloud = getTransformedPointCloudWithinAreas(
+    *input.obstacle_pointcloud, input.obstacle_transform->transform, checked_passing_areas);
+  const auto filtered_obstacle_pointcloud = filterPointCloudByTrajectory(
+    obstacle_pointcloud, output.resampled_trajectory, param_.search_radius);
+  output.processing_time_map["filterPointCloud"] = stop_watch.toc(true);
+
   output.will_collide = willCollide(filtered_obstacle_pointcloud, output.vehicle_passing_areas);
   output.processing_time_map["willCollide"] = stop_watch.toc(true);
 
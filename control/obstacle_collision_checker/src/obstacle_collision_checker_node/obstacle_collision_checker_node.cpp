@@ -227,7 +227,7 @@ void ObstacleCollisionCheckerNode::onTimer()
 
   updater_.force_update();
 
-  debug_publisher_->publish("marker_array", createMarkerArray());
+  debug_publisher_->publishIfSubscribed("marker_array", [this]() { return createMarkerArray(); });
 
   time_publisher_->publish(output_.processing_time_map);
 }
@@ -44,3 +44,37 @@ TEST(test_obstacle_collision_checker, filterPointCloudByTrajectory)
     }
   }
 }
+
+TEST(test_obstacle_collision_checker, getTransformedPointCloudWithinAreas)
+{
+  sensor_msgs::msg::PointCloud2 pointcloud_msg;
+  sensor_msgs::PointCloud2Modifier modifier(pointcloud_msg);
+  modifier.setPointCloud2FieldsByString(1, "xyz");
+  modifier.resize(10);
+  sensor_msgs::PointCloud2Iterator<float> iter_x(pointcloud_msg, "x");
+  sensor_msgs::PointCloud2Iterator<float> iter_y(pointcloud_msg, "y");
+  sensor_msgs::PointCloud2Iterator<float> iter_z(pointcloud_msg, "z");
+  for (int i = 0; i < 10; ++i, ++iter_x, ++iter_y, ++iter_z) {
+    *iter_x = static_cast<float>(i);
+    *iter_y = 0.0f;
+    *iter_z = 0.0f;
+  }
+
+  // points are shifted by 1.0 along x
+  geometry_msgs::msg::Transform transform;
+  transform.translation.x = 1.0;
+  transform.rotation.w = 1.0;
+
+  std::vector<LinearRing2d> areas;
+  areas.push_back(LinearRing2d{{1.5, -1.0}, {1.5, 1.0}, {3.5, 1.0}, {3.5, -1.0}, {1.5, -1.0}});
+  areas.push_back(LinearRing2d{{6.5, -1.0}, {6.5, 1.0}, {7.5, 1.0}, {7.5, -1.0}, {6.5, -1.0}});
+
+  const auto pcl = getTransformedPointCloudWithinAreas(pointcloud_msg, transform, areas);
+  ASSERT_EQ(pcl.size(), 3ul);
+  EXPECT_FLOAT_EQ(pcl[0].x, 2.0f);
+  EXPECT_FLOAT_EQ(pcl[1].x, 3.0f);
+  EXPECT_FLOAT_EQ(pcl[2].x, 7.0f);
+
+  // no point is kept without areas
+  EXPECT_TRUE(getTransformedPointCloudWithinAreas(pointcloud_msg, transform, {}).empty());
+}
@@ -16,7 +16,7 @@
 
 #include "util.hpp"
 
-#include <motion_utils/motion_utils.hpp>
+#include <motion_utils/trajectory/trajectory.hpp>
 #include <tier4_autoware_utils/tier4_autoware_utils.hpp>
 
 #include <algorithm>
@@ -25,10 +25,12 @@
 namespace operation_mode_transition_manager
 {
 
-using motion_utils::findNearestIndex;
 using tier4_autoware_utils::calcDistance2d;
 using tier4_autoware_utils::calcYawDeviation;
 
+// length along the trajectory around the last nearest index searched first [m]
+constexpr double nearest_search_window_length = 10.0;
+
 AutonomousMode::AutonomousMode(rclcpp::Node * node)
 : logger_(node->get_logger()), clock_(node->get_clock())
 {
@@ -39,10 +41,13 @@ AutonomousMode::AutonomousMode(rclcpp::Node * node)
     [this](const AckermannControlCommand::SharedPtr msg) { control_cmd_ = *msg; });
 
   sub_kinematics_ = node->create_subscription<Odometry>(
-    "kinematics", 1, [this](const Odometry::SharedPtr msg) { kinematics_ = *msg; });
+    "kinematics", 1, [this](const Odometry::SharedPtr msg) {
+      kinematics_ = *msg;
+      is_nearest_point_outdated_ = true;
+    });
 
   sub_trajectory_ = node->create_subscription<Trajectory>(
-    "trajectory", 1, [this](const Trajectory::SharedPtr msg) { trajectory_ = *msg; });
+    "trajectory", 1, [this](const Trajectory::SharedPtr msg) { setTrajectory(*msg); });
 
   check_engage_condition_ = node->declare_parameter<bool>("check_engage_condition");
   nearest_dist_deviation_threshold_ =
@@ -86,6 +91,46 @@ void AutonomousMode::update(bool transition)
   }
 }
 
+void AutonomousMode::setTrajectory(const Trajectory & trajectory)
+{
+  trajectory_ = trajectory;
+
+  trajectory_arc_length_.resize(trajectory_.points.size());
+  for (size_t i = 0; i < trajectory_.points.size(); ++i) {
+    trajectory_arc_length_.at(i) =
+      i == 0 ? 0.0
+             : trajectory_arc_length_.at(i - 1) +
+                 calcDistance2d(trajectory_.points.at(i - 1), trajectory_.points.at(i));
+  }
+
+  nearest_index_hint_.reset();
+  is_nearest_point_outdated_ = true;
+}
+
+const std::optional<AutonomousMode::NearestPoint> & AutonomousMode::getNearestPoint()
+{
+  if (!is_nearest_point_outdated_) {
+    return nearest_point_;
+  }
+  is_nearest_point_outdated_ = false;
+
+  const auto nearest_idx = motion_utils::findNearestIndexWithHint(
+    trajectory_.points, trajectory_arc_length_, kinematics_.pose.pose, nearest_index_hint_,
+    nearest_search_window_length, nearest_dist_deviation_threshold_,
+    nearest_yaw_deviation_threshold_);
+  if (!nearest_idx) {
+    nearest_point_.reset();
+    return nearest_point_;
+  }
+  nearest_index_hint_ = nearest_idx;
+
+  const auto & nearest_pose = trajectory_.points.at(*nearest_idx).pose;
+  nearest_point_ = NearestPoint{
+    *nearest_idx, calcDistance2d(nearest_pose, kinematics_.pose.pose),
+    calcYawDeviation(nearest_pose, kinematics_.pose.pose)};
+  return nearest_point_;
+}
+
 bool AutonomousMode::isModeChangeCompleted()
 {
   if (!check_engage_condition_) {
@@ -110,25 +155,23 @@ bool AutonomousMode::isModeChangeCompleted()
     return unstable();
   }
 
-  const auto closest_idx = findNearestIndex(
-    trajectory_.points, kinematics_.pose.pose, nearest_dist_deviation_threshold_,
-    nearest_yaw_deviation_threshold_);
-  if (!closest_idx) {
+  const auto & nearest_point = getNearestPoint();
+  if (!nearest_point) {
     RCLCPP_INFO(logger_, "Not stable yet: closest point not found");
     return unstable();
   }
 
-  const auto closest_point = trajectory_.points.at(*closest_idx);
+  const auto & closest_point = trajectory_.points.at(nearest_point->index);
 
   // check for lateral deviation
-  const auto dist_deviation = calcDistance2d(closest_point.pose, kinematics_.pose.pose);
+  const auto dist_deviation = nearest_point->dist_deviation;
   if (dist_deviation > stable_check_param_.dist_threshold) {
     RCLCPP_INFO(logger_, "Not stable yet: distance deviation is too large: %f", dist_deviation);
     return unstable();
   }
 
   // check for yaw deviation
-  const auto yaw_deviation = calcYawDeviation(closest_point.pose, kinematics_.pose.pose);
+  const auto yaw_deviation = nearest_point->yaw_deviation;
   if (yaw_deviation > stable_check_param_.yaw_threshold) {
     RCLCPP_INFO(logger_, "Not stable yet: yaw deviation is too large: %f", yaw_deviation);
     return unstable();
@@ -214,24 +257,22 @@ bool AutonomousMode::isModeChangeAvailable()
     return false;
   }
 
-  const auto closest_idx = findNearestIndex(
-    trajectory_.points, kinematics_.pose.pose, nearest_dist_deviation_threshold_,
-    nearest_yaw_deviation_threshold_);
-  if (!closest_idx) {
+  const auto & nearest_point = getNearestPoint();
+  if (!nearest_point) {
     RCLCPP_INFO(logger_, "Engage unavailable: closest point not found");
     debug_info_ = DebugInfo{};  // all false
     return false;               // closest trajectory point not found.
   }
-  const auto closest_point = trajectory_.points.at(*closest_idx);
+  const auto & closest_point = trajectory_.points.at(nearest_point->index);
   const auto target_planning_speed = closest_point.longitudinal_velocity_mps;
   debug_info_.trajectory_available_ok = true;
 
   // No engagement is lateral control error is large
-  const auto lateral_deviation = calcDistance2d(closest_point.pose, kinematics_.pose.pose);
+  const auto lateral_deviation = nearest_point->dist_deviation;
   const bool lateral_deviation_ok = lateral_deviation < param.dist_threshold;
 
   // No engagement is yaw control error is large
-  const auto yaw_deviation = calcYawDeviation(closest_point.pose, kinematics_.pose.pose);
+  const auto yaw_deviation = nearest_point->yaw_deviation;
   const bool yaw_deviation_ok = yaw_deviation < param.yaw_threshold;
 
   // No engagement if speed control error is large
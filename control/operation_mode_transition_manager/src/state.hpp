@@ -25,8 +25,12 @@
 #include <autoware_auto_planning_msgs/msg/trajectory.hpp>
 #include <nav_msgs/msg/odometry.hpp>
 
+#include <boost/optional.hpp>
+
 #include <memory>
+#include <optional>
 #include <utility>
+#include <vector>
 
 namespace operation_mode_transition_manager
 {
@@ -60,12 +64,22 @@ public:
   DebugInfo getDebugInfo() override { return debug_info_; }
 
 private:
-  bool hasDangerAcceleration();
-  std::pair<bool, bool> hasDangerLateralAcceleration();
-
   using AckermannControlCommand = autoware_auto_control_msgs::msg::AckermannControlCommand;
   using Odometry = nav_msgs::msg::Odometry;
   using Trajectory = autoware_auto_planning_msgs::msg::Trajectory;
+
+  struct NearestPoint
+  {
+    size_t index;
+    double dist_deviation;  // [m]
+    double yaw_deviation;   // [rad]
+  };
+
+  bool hasDangerAcceleration();
+  std::pair<bool, bool> hasDangerLateralAcceleration();
+  void setTrajectory(const Trajectory & trajectory);
+  const std::optional<NearestPoint> & getNearestPoint();
+
   rclcpp::Subscription<AckermannControlCommand>::SharedPtr sub_control_cmd_;
   rclcpp::Subscription<Odometry>::SharedPtr sub_kinematics_;
   rclcpp::Subscription<Trajectory>::SharedPtr sub_trajectory_;
@@ -82,6 +96,13 @@ private:
   Trajectory trajectory_;
   vehicle_info_util::VehicleInfo vehicle_info_;
 
+  // Nearest trajectory point of the ego shared by the checks. It is searched again only when new
+  // kinematics or a new trajectory arrive, around the index found last time.
+  std::vector<double> trajectory_arc_length_;
+  boost::optional<size_t> nearest_index_hint_;
+  std::optional<NearestPoint> nearest_point_;
+  bool is_nearest_point_outdated_ = true;
+
   DebugInfo debug_info_;
   std::shared_ptr<rclcpp::Time> stable_start_time_;  // Reset every transition start.
 };
@@ -359,10 +359,10 @@ trajectory_follower::LongitudinalOutput PidLongitudinalController::run(
   trajectory_follower::InputData const & input_data)
 {
   // set input data
-  setTrajectory(input_data.current_trajectory);
-  setKinematicState(input_data.current_odometry);
-  setCurrentAcceleration(input_data.current_accel);
-  setCurrentOperationMode(input_data.current_operation_mode);
+  setTrajectory(*input_data.current_trajectory);
+  setKinematicState(*input_data.current_odometry);
+  setCurrentAcceleration(*input_data.current_accel);
+  setCurrentOperationMode(*input_data.current_operation_mode);
 
   // calculate current pose and control data
   geometry_msgs::msg::Pose current_pose = m_current_kinematic_state.pose.pose;
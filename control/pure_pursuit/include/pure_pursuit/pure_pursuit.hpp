@@ -34,6 +34,8 @@
 
 #include <geometry_msgs/msg/pose.hpp>
 
+#include <boost/optional.hpp>
+
 #include <memory>
 #include <utility>
 #include <vector>
@@ -78,6 +80,10 @@ private:
   std::shared_ptr<std::vector<geometry_msgs::msg::Pose>> curr_wps_ptr_;
   std::shared_ptr<geometry_msgs::msg::Pose> curr_pose_ptr_;
 
+  // cumulative arc length of the waypoints and closest index of the last run, for bounded searches
+  std::vector<double> curr_wps_arc_lengths_;
+  boost::optional<size_t> clst_idx_hint_;
+
   // functions
   int32_t findNextPointIdx(int32_t search_start_idx);
   std::pair<bool, geometry_msgs::msg::Point> lerpNextTarget(int32_t next_wp_idx);
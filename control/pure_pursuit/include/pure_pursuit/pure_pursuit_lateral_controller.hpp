@@ -104,7 +104,10 @@ public:
 
 private:
   rclcpp::Node::SharedPtr node_;
-  std::vector<TrajectoryPoint> output_tp_array_;
+  // poses of the resampled trajectory before smoothing, used to find the closest index
+  std::vector<geometry_msgs::msg::Pose> output_poses_;
+  std::vector<double> output_arc_lengths_;
+  boost::optional<size_t> closest_idx_hint_;
   autoware_auto_planning_msgs::msg::Trajectory::SharedPtr trajectory_resampled_;
   autoware_auto_planning_msgs::msg::Trajectory trajectory_;
   nav_msgs::msg::Odometry current_odometry_;
@@ -168,6 +171,8 @@ private:
 
   double calcCurvature(const size_t closest_idx);
 
+  boost::optional<size_t> findClosestIdx(const geometry_msgs::msg::Pose & pose);
+
   void averageFilterTrajectory(autoware_auto_planning_msgs::msg::Trajectory & u);
 
   // Debug
@@ -53,6 +53,8 @@ constexpr double ERROR = 1e-6;
 double calcArcLengthFromWayPoint(
   const autoware_auto_planning_msgs::msg::Trajectory & input_path, const size_t src_idx,
   const size_t dst_idx);
+// cumulative 2D arc length of the poses, the first element is always 0
+std::vector<double> calcArcLengths(const std::vector<geometry_msgs::msg::Pose> & poses);
 double calcCurvature(
   const geometry_msgs::msg::Point & target, const geometry_msgs::msg::Pose & curr_pose);
 double calcDistance2D(const geometry_msgs::msg::Point & p, const geometry_msgs::msg::Point & q);
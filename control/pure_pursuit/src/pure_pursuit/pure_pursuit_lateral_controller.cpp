@@ -52,6 +52,9 @@ enum TYPE {
   VELOCITY = 6,
   SIZE  // this is the number of enum elements
 };
+
+// length along the trajectory around the last closest index searched for the closest point [m]
+constexpr double closest_search_window_length = 10.0;
 }  // namespace
 
 namespace pure_pursuit
@@ -170,7 +173,21 @@ void PurePursuitLateralController::setResampledTrajectory()
       motion_utils::convertToTrajectory(input_tp_array), out_arclength));
   trajectory_resampled_->points.back() = trajectory_.points.back();
   trajectory_resampled_->header = trajectory_.header;
-  output_tp_array_ = motion_utils::convertToTrajectoryPointArray(*trajectory_resampled_);
+  output_poses_ = planning_utils::extractPoses(*trajectory_resampled_);
+  output_arc_lengths_ = planning_utils::calcArcLengths(output_poses_);
+  closest_idx_hint_ = boost::none;
+}
+
+boost::optional<size_t> PurePursuitLateralController::findClosestIdx(
+  const geometry_msgs::msg::Pose & pose)
+{
+  const auto closest_idx = motion_utils::findNearestIndexWithHint(
+    output_poses_, output_arc_lengths_, pose, closest_idx_hint_, closest_search_window_length, 3.0,
+    M_PI_4);
+  if (closest_idx) {
+    closest_idx_hint_ = closest_idx;
+  }
+  return closest_idx;
 }
 
 double PurePursuitLateralController::calcCurvature(const size_t closest_idx)
@@ -270,8 +287,7 @@ void PurePursuitLateralController::averageFilterTrajectory(
 
 boost::optional<Trajectory> PurePursuitLateralController::generatePredictedTrajectory()
 {
-  const auto closest_idx_result =
-    motion_utils::findNearestIndex(output_tp_array_, current_odometry_.pose.pose, 3.0, M_PI_4);
+  const auto closest_idx_result = findClosestIdx(current_odometry_.pose.pose);
 
   if (!closest_idx_result) {
     return boost::none;
@@ -345,15 +361,17 @@ bool PurePursuitLateralController::isReady([[maybe_unused]] const InputData & in
 
 LateralOutput PurePursuitLateralController::run(const InputData & input_data)
 {
-  current_pose_ = input_data.current_odometry.pose.pose;
-  trajectory_ = input_data.current_trajectory;
-  current_odometry_ = input_data.current_odometry;
-  current_steering_ = input_data.current_steering;
+  current_pose_ = input_data.current_odometry->pose.pose;
+  trajectory_ = *input_data.current_trajectory;
+  current_odometry_ = *input_data.current_odometry;
+  current_steering_ = *input_data.current_steering;
 
   setResampledTrajectory();
   if (param_.enable_path_smoothing) {
     averageFilterTrajectory(*trajectory_resampled_);
   }
+  // waypoints are common to all the pure pursuit runs of this cycle
+  pure_pursuit_->setWaypoints(planning_utils::extractPoses(*trajectory_resampled_));
   const auto cmd_msg = generateOutputControlCmd();
 
   LateralOutput output;
@@ -435,8 +453,7 @@ boost::optional<PpOutput> PurePursuitLateralController::calcTargetCurvature(
 
   // Calculate target point for velocity/acceleration
 
-  const auto closest_idx_result =
-    motion_utils::findNearestIndex(output_tp_array_, pose, 3.0, M_PI_4);
+  const auto closest_idx_result = findClosestIdx(pose);
   if (!closest_idx_result) {
     RCLCPP_ERROR(node_->get_logger(), "cannot find closest waypoint");
     return {};
@@ -471,7 +488,6 @@ boost::optional<PpOutput> PurePursuitLateralController::calcTargetCurvature(
 
   // Set PurePursuit data
   pure_pursuit_->setCurrentPose(pose);
-  pure_pursuit_->setWaypoints(planning_utils::extractPoses(*trajectory_resampled_));
   pure_pursuit_->setLookaheadDistance(lookahead_distance);
 
   // Run PurePursuit
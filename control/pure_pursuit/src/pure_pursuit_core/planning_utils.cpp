@@ -37,6 +37,20 @@ double calcArcLengthFromWayPoint(
   return length;
 }
 
+std::vector<double> calcArcLengths(const std::vector<geometry_msgs::msg::Pose> & poses)
+{
+  std::vector<double> arc_lengths;
+  arc_lengths.reserve(poses.size());
+  double length = 0.0;
+  for (size_t i = 0; i < poses.size(); ++i) {
+    if (i > 0) {
+      length += calcDistance2D(poses.at(i - 1).position, poses.at(i).position);
+    }
+    arc_lengths.push_back(length);
+  }
+  return arc_lengths;
+}
+
 double calcCurvature(
   const geometry_msgs::msg::Point & target, const geometry_msgs::msg::Pose & current_pose)
 {
@@ -120,13 +134,13 @@ std::pair<bool, int32_t> findClosestIdxWithDistAngThr(
   double dist_squared_min = std::numeric_limits<double>::max();
   int32_t idx_min = -1;
 
+  const double yaw_pose = tf2::getYaw(current_pose.orientation);
   for (size_t i = 0; i < poses.size(); ++i) {
     const double ds = calcDistSquared2D(poses.at(i).position, current_pose.position);
     if (ds > th_dist * th_dist) {
       continue;
     }
 
-    const double yaw_pose = tf2::getYaw(current_pose.orientation);
     const double yaw_ps = tf2::getYaw(poses.at(i).orientation);
     const double yaw_diff = normalizeEulerAngle(yaw_pose - yaw_ps);
     if (fabs(yaw_diff) > th_yaw) {
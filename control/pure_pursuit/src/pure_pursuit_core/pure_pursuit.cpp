@@ -31,11 +31,20 @@
 
 #include "pure_pursuit/util/planning_utils.hpp"
 
+#include <motion_utils/trajectory/trajectory.hpp>
+
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <utility>
 #include <vector>
 
+namespace
+{
+// length along the waypoints around the last closest index searched for the closest waypoint [m]
+constexpr double closest_search_window_length = 10.0;
+}  // namespace
+
 namespace pure_pursuit
 {
 bool PurePursuit::isDataReady()
@@ -55,16 +64,17 @@ std::pair<bool, double> PurePursuit::run()
     return std::make_pair(false, std::numeric_limits<double>::quiet_NaN());
   }
 
-  auto clst_pair = planning_utils::findClosestIdxWithDistAngThr(
-    *curr_wps_ptr_, *curr_pose_ptr_, clst_thr_dist_, clst_thr_ang_);
+  const auto clst_idx = motion_utils::findNearestIndexWithHint(
+    *curr_wps_ptr_, curr_wps_arc_lengths_, *curr_pose_ptr_, clst_idx_hint_,
+    closest_search_window_length, clst_thr_dist_, clst_thr_ang_);
+  clst_idx_hint_ = clst_idx;
 
-  if (!clst_pair.first) {
-    RCLCPP_WARN(
-      logger, "cannot find, curr_bool: %d, clst_idx: %d", clst_pair.first, clst_pair.second);
+  if (!clst_idx) {
+    RCLCPP_WARN(logger, "cannot find the closest waypoint");
     return std::make_pair(false, std::numeric_limits<double>::quiet_NaN());
   }
 
-  int32_t next_wp_idx = findNextPointIdx(clst_pair.second);
+  int32_t next_wp_idx = findNextPointIdx(static_cast<int32_t>(*clst_idx));
   if (next_wp_idx == -1) {
     RCLCPP_WARN(logger, "lost next waypoint");
     return std::make_pair(false, std::numeric_limits<double>::quiet_NaN());
@@ -154,15 +164,42 @@ int32_t PurePursuit::findNextPointIdx(int32_t search_start_idx)
     return -1;
   }
 
+  // if search waypoint is the last
+  const int32_t last_idx = static_cast<int32_t>(curr_wps_ptr_->size()) - 1;
+  if (search_start_idx >= last_idx) {
+    return last_idx;
+  }
+
+  // waypoint direction does not depend on the searched waypoint
+  const auto gld = planning_utils::getLaneDirection(*curr_wps_ptr_, 0.05);
+  if (gld != 0 && gld != 1) {
+    return -1;
+  }
+
+  // waypoints nearer than lookahead distance along the path from the search start cannot be
+  // farther than lookahead distance from ego, so skip them with the cumulative arc length
+  int32_t first_idx = search_start_idx;
+  if (curr_wps_arc_lengths_.size() == curr_wps_ptr_->size()) {
+    const double min_arc_length =
+      curr_wps_arc_lengths_.at(search_start_idx) + lookahead_distance_ -
+      planning_utils::calcDistance2D(
+        curr_wps_ptr_->at(search_start_idx).position, curr_pose_ptr_->position) -
+      planning_utils::ERROR;
+    const auto first_itr = std::lower_bound(
+      curr_wps_arc_lengths_.begin() + search_start_idx, curr_wps_arc_lengths_.end(),
+      min_arc_length);
+    first_idx = std::min(
+      static_cast<int32_t>(std::distance(curr_wps_arc_lengths_.begin(), first_itr)), last_idx);
+  }
+
   // look for the next waypoint.
-  for (int32_t i = search_start_idx; i < (int32_t)curr_wps_ptr_->size(); i++) {
+  for (int32_t i = first_idx; i < (int32_t)curr_wps_ptr_->size(); i++) {
     // if search waypoint is the last
-    if (i == ((int32_t)curr_wps_ptr_->size() - 1)) {
+    if (i == last_idx) {
       return i;
     }
 
     // if waypoint direction is forward
-    const auto gld = planning_utils::getLaneDirection(*curr_wps_ptr_, 0.05);
     if (gld == 0) {
       // if waypoint is not in front of ego, skip
       auto ret = planning_utils::transformToRelativeCoordinate2D(
@@ -170,7 +207,7 @@ int32_t PurePursuit::findNextPointIdx(int32_t search_start_idx)
       if (ret.x < 0) {
         continue;
       }
-    } else if (gld == 1) {
+    } else {
       // waypoint direction is backward
 
       // if waypoint is in front of ego, skip
@@ -179,8 +216,6 @@ int32_t PurePursuit::findNextPointIdx(int32_t search_start_idx)
       if (ret.x > 0) {
         continue;
       }
-    } else {
-      return -1;
     }
 
     const geometry_msgs::msg::Point & curr_motion_point = curr_wps_ptr_->at(i).position;
@@ -206,6 +241,8 @@ void PurePursuit::setWaypoints(const std::vector<geometry_msgs::msg::Pose> & msg
 {
   curr_wps_ptr_ = std::make_shared<std::vector<geometry_msgs::msg::Pose>>();
   *curr_wps_ptr_ = msg;
+  curr_wps_arc_lengths_ = planning_utils::calcArcLengths(msg);
+  clst_idx_hint_ = boost::none;
 }
 
 }  // namespace pure_pursuit
@@ -25,11 +25,11 @@ namespace autoware::motion::control::trajectory_follower
 {
 struct InputData
 {
-  autoware_auto_planning_msgs::msg::Trajectory current_trajectory;
-  nav_msgs::msg::Odometry current_odometry;
-  autoware_auto_vehicle_msgs::msg::SteeringReport current_steering;
-  geometry_msgs::msg::AccelWithCovarianceStamped current_accel;
-  autoware_adapi_v1_msgs::msg::OperationModeState current_operation_mode;
+  autoware_auto_planning_msgs::msg::Trajectory::ConstSharedPtr current_trajectory;
+  nav_msgs::msg::Odometry::ConstSharedPtr current_odometry;
+  autoware_auto_vehicle_msgs::msg::SteeringReport::ConstSharedPtr current_steering;
+  geometry_msgs::msg::AccelWithCovarianceStamped::ConstSharedPtr current_accel;
+  autoware_adapi_v1_msgs::msg::OperationModeState::ConstSharedPtr current_operation_mode;
 };
 }  // namespace autoware::motion::control::trajectory_follower
 
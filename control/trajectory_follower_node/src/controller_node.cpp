@@ -19,6 +19,7 @@
 #include "pure_pursuit/pure_pursuit_lateral_controller.hpp"
 
 #include <algorithm>
+#include <future>
 #include <limits>
 #include <memory>
 #include <string>
@@ -33,6 +34,7 @@ Controller::Controller(const rclcpp::NodeOptions & node_options) : Node("control
 
   const double ctrl_period = declare_parameter<double>("ctrl_period");
   timeout_thr_sec_ = declare_parameter<double>("timeout_thr_sec");
+  enable_parallel_controllers_ = declare_parameter<bool>("enable_parallel_controllers", false);
 
   const auto lateral_controller_mode =
     getLateralControllerMode(declare_parameter<std::string>("lateral_controller_mode", "mpc"));
@@ -72,10 +74,15 @@ Controller::Controller(const rclcpp::NodeOptions & node_options) : Node("control
   sub_operation_mode_ = create_subscription<OperationModeState>(
     "~/input/current_operation_mode", rclcpp::QoS{1},
     [this](const OperationModeState::SharedPtr msg) { current_operation_mode_ptr_ = msg; });
+  // intra-process communication does not support transient local durability
+  const auto control_cmd_qos =
+    node_options.use_intra_process_comms() ? rclcpp::QoS{1} : rclcpp::QoS{1}.transient_local();
   control_cmd_pub_ = create_publisher<autoware_auto_control_msgs::msg::AckermannControlCommand>(
-    "~/output/control_cmd", rclcpp::QoS{1}.transient_local());
+    "~/output/control_cmd", control_cmd_qos);
   debug_marker_pub_ =
     create_publisher<visualization_msgs::msg::MarkerArray>("~/output/debug_marker", rclcpp::QoS{1});
+  control_cmd_latency_pub_ = create_publisher<tier4_debug_msgs::msg::Float64Stamped>(
+    "~/debug/odometry_to_control_cmd_latency_ms", rclcpp::QoS{1});
 
   // Timer
   {
@@ -171,12 +178,13 @@ boost::optional<trajectory_follower::InputData> Controller::createInputData(
     return {};
   }
 
+  // the received messages are never modified, so they are shared with the controllers
   trajectory_follower::InputData input_data;
-  input_data.current_trajectory = *current_trajectory_ptr_;
-  input_data.current_odometry = *current_odometry_ptr_;
-  input_data.current_steering = *current_steering_ptr_;
-  input_data.current_accel = *current_accel_ptr_;
-  input_data.current_operation_mode = *current_operation_mode_ptr_;
+  input_data.current_trajectory = current_trajectory_ptr_;
+  input_data.current_odometry = current_odometry_ptr_;
+  input_data.current_steering = current_steering_ptr_;
+  input_data.current_accel = current_accel_ptr_;
+  input_data.current_operation_mode = current_operation_mode_ptr_;
 
   return input_data;
 }
@@ -202,8 +210,18 @@ void Controller::callbackTimerControl()
   }
 
   // 3. run controllers
-  const auto lat_out = lateral_controller_->run(*input_data);
-  const auto lon_out = longitudinal_controller_->run(*input_data);
+  // The controllers only exchange their states in sync(), so they can run concurrently.
+  trajectory_follower::LateralOutput lat_out;
+  trajectory_follower::LongitudinalOutput lon_out;
+  if (enable_parallel_controllers_) {
+    auto lat_future = std::async(
+      std::launch::async, [this, &input_data]() { return lateral_controller_->run(*input_data); });
+    lon_out = longitudinal_controller_->run(*input_data);
+    lat_out = lat_future.get();
+  } else {
+    lat_out = lateral_controller_->run(*input_data);
+    lon_out = longitudinal_controller_->run(*input_data);
+  }
 
   // 4. sync with each other controllers
   longitudinal_controller_->sync(lat_out.sync_data);
@@ -213,11 +231,20 @@ void Controller::callbackTimerControl()
   if (isTimeOut(lon_out, lat_out)) return;
 
   // 5. publish control command
-  autoware_auto_control_msgs::msg::AckermannControlCommand out;
-  out.stamp = this->now();
-  out.lateral = lat_out.control_cmd;
-  out.longitudinal = lon_out.control_cmd;
-  control_cmd_pub_->publish(out);
+  // The command is moved to the publisher, so that it is not copied on intra-process communication.
+  auto out = std::make_unique<autoware_auto_control_msgs::msg::AckermannControlCommand>();
+  out->stamp = this->now();
+  out->lateral = lat_out.control_cmd;
+  out->longitudinal = lon_out.control_cmd;
+
+  // latency from the odometry the command is based on
+  tier4_debug_msgs::msg::Float64Stamped latency_msg;
+  latency_msg.stamp = out->stamp;
+  const rclcpp::Time odometry_stamp = input_data->current_odometry->header.stamp;
+  latency_msg.data = (rclcpp::Time(out->stamp) - odometry_stamp).seconds() * 1e3;
+
+  control_cmd_pub_->publish(std::move(out));
+  control_cmd_latency_pub_->publish(latency_msg);
 
   // 6. publish debug marker
   publishDebugMarker(*input_data, lat_out);
@@ -235,10 +262,10 @@ void Controller::publishDebugMarker(
       "map", this->now(), "steer_converged", 0, visualization_msgs::msg::Marker::TEXT_VIEW_FACING,
       tier4_autoware_utils::createMarkerScale(0.0, 0.0, 1.0),
       tier4_autoware_utils::createMarkerColor(1.0, 1.0, 1.0, 0.99));
-    marker.pose = input_data.current_odometry.pose.pose;
+    marker.pose = input_data.current_odometry->pose.pose;
 
     std::stringstream ss;
-    const double current = input_data.current_steering.steering_tire_angle;
+    const double current = input_data.current_steering->steering_tire_angle;
     const double cmd = lat_out.control_cmd.steering_tire_angle;
     const double diff = current - cmd;
     ss << "current:" << current << " cmd:" << cmd << " diff:" << diff
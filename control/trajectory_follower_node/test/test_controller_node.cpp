@@ -47,7 +47,9 @@ using FakeNodeFixture = autoware::tools::testing::FakeTestNode;
 
 const rclcpp::Duration one_second(1, 0);
 
-rclcpp::NodeOptions makeNodeOptions(const bool enable_keep_stopped_until_steer_convergence = false)
+rclcpp::NodeOptions makeNodeOptions(
+  const bool enable_keep_stopped_until_steer_convergence = false,
+  const bool enable_parallel_controllers = false)
 {
   // Pass default parameter file to the node
   const auto share_dir = ament_index_cpp::get_package_share_directory("trajectory_follower_node");
@@ -60,6 +62,8 @@ rclcpp::NodeOptions makeNodeOptions(const bool enable_keep_stopped_until_steer_c
   node_options.append_parameter_override("timeout_thr_sec", 0.5);
   node_options.append_parameter_override("lateral_controller_mode", "mpc");
   node_options.append_parameter_override("longitudinal_controller_mode", "pid");
+  node_options.append_parameter_override(
+    "enable_parallel_controllers", enable_parallel_controllers);
   node_options.append_parameter_override(
     "enable_keep_stopped_until_steer_convergence",
     enable_keep_stopped_until_steer_convergence);  // longitudinal
@@ -287,6 +291,63 @@ TEST_F(FakeNodeFixture, right_turn)
   EXPECT_GT(rclcpp::Time(tester.cmd_msg->stamp), rclcpp::Time(traj_msg.header.stamp));
 }
 
+TEST_F(FakeNodeFixture, right_turn_parallel_controllers)
+{
+  const auto node_options = makeNodeOptions(false, true);
+  ControllerTester tester(this, node_options);
+
+  tester.send_default_transform();
+  tester.publish_odom_vx(1.0);
+  tester.publish_autonomous_operation_mode();
+  tester.publish_default_steer();
+  tester.publish_default_acc();
+
+  // Right turning trajectory: expect right steering
+  Trajectory traj_msg;
+  traj_msg.header.stamp = tester.node->now();
+  traj_msg.header.frame_id = "map";
+  traj_msg.points.push_back(make_traj_point(-1.0, -1.0, 1.0f));
+  traj_msg.points.push_back(make_traj_point(0.0, 0.0, 1.0f));
+  traj_msg.points.push_back(make_traj_point(1.0, -1.0, 1.0f));
+  traj_msg.points.push_back(make_traj_point(2.0, -2.0, 1.0f));
+  tester.traj_pub->publish(traj_msg);
+
+  test_utils::waitForMessage(tester.node, this, tester.received_control_command);
+  ASSERT_TRUE(tester.received_control_command);
+  EXPECT_LT(tester.cmd_msg->lateral.steering_tire_angle, 0.0f);
+  EXPECT_LT(tester.cmd_msg->lateral.steering_tire_rotation_rate, 0.0f);
+  EXPECT_GT(rclcpp::Time(tester.cmd_msg->stamp), rclcpp::Time(traj_msg.header.stamp));
+}
+
+TEST_F(FakeNodeFixture, right_turn_intra_process)
+{
+  auto node_options = makeNodeOptions();
+  node_options.use_intra_process_comms(true);
+  ControllerTester tester(this, node_options);
+
+  tester.send_default_transform();
+  tester.publish_odom_vx(1.0);
+  tester.publish_autonomous_operation_mode();
+  tester.publish_default_steer();
+  tester.publish_default_acc();
+
+  // Right turning trajectory: expect right steering
+  Trajectory traj_msg;
+  traj_msg.header.stamp = tester.node->now();
+  traj_msg.header.frame_id = "map";
+  traj_msg.points.push_back(make_traj_point(-1.0, -1.0, 1.0f));
+  traj_msg.points.push_back(make_traj_point(0.0, 0.0, 1.0f));
+  traj_msg.points.push_back(make_traj_point(1.0, -1.0, 1.0f));
+  traj_msg.points.push_back(make_traj_point(2.0, -2.0, 1.0f));
+  tester.traj_pub->publish(traj_msg);
+
+  test_utils::waitForMessage(tester.node, this, tester.received_control_command);
+  ASSERT_TRUE(tester.received_control_command);
+  EXPECT_LT(tester.cmd_msg->lateral.steering_tire_angle, 0.0f);
+  EXPECT_LT(tester.cmd_msg->lateral.steering_tire_rotation_rate, 0.0f);
+  EXPECT_GT(rclcpp::Time(tester.cmd_msg->stamp), rclcpp::Time(traj_msg.header.stamp));
+}
+
 TEST_F(FakeNodeFixture, left_turn)
 {
   const auto node_options = makeNodeOptions();
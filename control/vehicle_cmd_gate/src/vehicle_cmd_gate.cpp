@@ -51,20 +51,37 @@ VehicleCmdGate::VehicleCmdGate(const rclcpp::NodeOptions & node_options)
   rclcpp::QoS durable_qos{1};
   durable_qos.transient_local();
 
+  // intra-process communication does not support transient local durability, so it is used only
+  // for the control command which is published with volatile durability in that case
+  rclcpp::PublisherOptions durable_pub_options;
+  durable_pub_options.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+  const auto control_cmd_qos =
+    node_options.use_intra_process_comms() ? rclcpp::QoS{1} : durable_qos;
+
   // Publisher
-  vehicle_cmd_emergency_pub_ =
-    create_publisher<VehicleEmergencyStamped>("output/vehicle_cmd_emergency", durable_qos);
-  control_cmd_pub_ = create_publisher<AckermannControlCommand>("output/control_cmd", durable_qos);
-  gear_cmd_pub_ = create_publisher<GearCommand>("output/gear_cmd", durable_qos);
-  turn_indicator_cmd_pub_ =
-    create_publisher<TurnIndicatorsCommand>("output/turn_indicators_cmd", durable_qos);
-  hazard_light_cmd_pub_ =
-    create_publisher<HazardLightsCommand>("output/hazard_lights_cmd", durable_qos);
-
-  gate_mode_pub_ = create_publisher<GateMode>("output/gate_mode", durable_qos);
-  engage_pub_ = create_publisher<EngageMsg>("output/engage", durable_qos);
-  pub_external_emergency_ = create_publisher<Emergency>("output/external_emergency", durable_qos);
-  operation_mode_pub_ = create_publisher<OperationModeState>("output/operation_mode", durable_qos);
+  vehicle_cmd_emergency_pub_ = create_publisher<VehicleEmergencyStamped>(
+    "output/vehicle_cmd_emergency", durable_qos, durable_pub_options);
+  control_cmd_pub_ =
+    create_publisher<AckermannControlCommand>("output/control_cmd", control_cmd_qos);
+  gear_cmd_pub_ =
+    create_publisher<GearCommand>("output/gear_cmd", durable_qos, durable_pub_options);
+  turn_indicator_cmd_pub_ = create_publisher<TurnIndicatorsCommand>(
+    "output/turn_indicators_cmd", durable_qos, durable_pub_options);
+  hazard_light_cmd_pub_ = create_publisher<HazardLightsCommand>(
+    "output/hazard_lights_cmd", durable_qos, durable_pub_options);
+
+  gate_mode_pub_ = create_publisher<GateMode>("output/gate_mode", durable_qos, durable_pub_options);
+  engage_pub_ = create_publisher<EngageMsg>("output/engage", durable_qos, durable_pub_options);
+  pub_external_emergency_ =
+    create_publisher<Emergency>("output/external_emergency", durable_qos, durable_pub_options);
+  operation_mode_pub_ = create_publisher<OperationModeState>(
+    "output/operation_mode", durable_qos, durable_pub_options);
+
+  // Debug publisher for the latency of the control command
+  control_cmd_input_latency_pub_ =
+    create_publisher<Float64Stamped>("~/debug/control_cmd_input_latency_ms", 1);
+  control_cmd_processing_time_pub_ =
+    create_publisher<Float64Stamped>("~/debug/control_cmd_processing_time_ms", 1);
 
   // Subscriber
   external_emergency_stop_heartbeat_sub_ = create_subscription<Heartbeat>(
@@ -371,6 +388,8 @@ void VehicleCmdGate::onTimer()
 
 void VehicleCmdGate::publishControlCommands(const Commands & commands)
 {
+  const auto received_time = this->now();
+
   // Check system emergency
   if (use_emergency_handling_ && is_emergency_state_heartbeat_timeout_) {
     return;
@@ -422,12 +441,26 @@ void VehicleCmdGate::publishControlCommands(const Commands & commands)
   vehicle_cmd_emergency.emergency = (use_emergency_handling_ && is_system_emergency_);
   vehicle_cmd_emergency.stamp = filtered_commands.control.stamp;
 
-  // Publish commands
-  vehicle_cmd_emergency_pub_->publish(vehicle_cmd_emergency);
-  control_cmd_pub_->publish(filtered_commands.control);
-
   // Save ControlCmd to steering angle when disengaged
   prev_control_cmd_ = filtered_commands.control;
+
+  // Publish commands
+  // The stamp of the input command is kept unless the command is replaced above, and the command is
+  // moved to the publisher so that it is not copied on intra-process communication.
+  vehicle_cmd_emergency_pub_->publish(vehicle_cmd_emergency);
+  control_cmd_pub_->publish(
+    std::make_unique<AckermannControlCommand>(std::move(filtered_commands.control)));
+
+  // Publish latency of each hop: from the input command stamp to the reception, and in this node
+  Float64Stamped input_latency;
+  input_latency.stamp = received_time;
+  input_latency.data = (received_time - rclcpp::Time(commands.control.stamp)).seconds() * 1e3;
+  control_cmd_input_latency_pub_->publish(input_latency);
+
+  Float64Stamped processing_time;
+  processing_time.stamp = received_time;
+  processing_time.data = (this->now() - received_time).seconds() * 1e3;
+  control_cmd_processing_time_pub_->publish(processing_time);
 }
 
 void VehicleCmdGate::publishEmergencyStopControlCommands()
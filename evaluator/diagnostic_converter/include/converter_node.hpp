@@ -52,14 +52,33 @@ public:
 
   UserDefinedValue createUserDefinedValue(const KeyValue & key_value) const;
 
-  rclcpp::Publisher<UserDefinedValue>::SharedPtr getPublisher(
-    const std::string & topic, const size_t pub_idx);
-
 private:
+  /**
+   * @brief publisher of one status/key pair and its message reused for each publication
+   */
+  struct KeyRoute
+  {
+    rclcpp::Publisher<UserDefinedValue>::SharedPtr publisher;
+    UserDefinedValue msg;
+  };
+  // routes of the keys of one status, found by the key without building the topic name
+  using StatusRoute = std::unordered_map<std::string, KeyRoute>;
+
+  /**
+   * @brief get the route of a status/key pair, creating its publisher the first time
+   * @param [in] status_route routes of the keys of the status
+   * @param [in] base_topic input topic of the status
+   * @param [in] status_name name of the status
+   * @param [in] key key of the value
+   */
+  KeyRoute & getKeyRoute(
+    StatusRoute & status_route, const std::string & base_topic, const std::string & status_name,
+    const std::string & key);
+
   // ROS
   std::vector<rclcpp::Subscription<DiagnosticArray>::SharedPtr> diagnostics_sub_;
-  std::vector<std::unordered_map<std::string, rclcpp::Publisher<UserDefinedValue>::SharedPtr>>
-    params_pub_;
+  // routes of the statuses of each input topic, found by the status name
+  std::vector<std::unordered_map<std::string, StatusRoute>> routes_;
 };
 }  // namespace diagnostic_converter
 
@@ -31,18 +31,20 @@ DiagnosticConverter::DiagnosticConverter(const rclcpp::NodeOptions & node_option
       std::bind(&DiagnosticConverter::onDiagnostic, this, _1, sub_counter++, diagnostic_topic);
     diagnostics_sub_.push_back(create_subscription<DiagnosticArray>(diagnostic_topic, 1, fn));
   }
-  params_pub_.resize(diagnostics_sub_.size());
+  routes_.resize(diagnostics_sub_.size());
 }
 
 void DiagnosticConverter::onDiagnostic(
   const DiagnosticArray::ConstSharedPtr diag_msg, const size_t diag_idx,
   const std::string & base_topic)
 {
+  auto & status_routes = routes_[diag_idx];
   for (const auto & status : diag_msg->status) {
-    std::string status_topic = base_topic + (status.name.empty() ? "" : "_" + status.name);
+    auto & status_route = status_routes[status.name];
     for (const auto & key_value : status.values) {
-      getPublisher(status_topic + "_" + key_value.key, diag_idx)
-        ->publish(createUserDefinedValue(key_value));
+      auto & key_route = getKeyRoute(status_route, base_topic, status.name, key_value.key);
+      key_route.msg.value = key_value.value;
+      key_route.publisher->publish(key_route.msg);
     }
   }
 }
@@ -55,14 +57,20 @@ UserDefinedValue DiagnosticConverter::createUserDefinedValue(const KeyValue & ke
   return param_msg;
 }
 
-rclcpp::Publisher<UserDefinedValue>::SharedPtr DiagnosticConverter::getPublisher(
-  const std::string & topic, const size_t pub_idx)
+DiagnosticConverter::KeyRoute & DiagnosticConverter::getKeyRoute(
+  StatusRoute & status_route, const std::string & base_topic, const std::string & status_name,
+  const std::string & key)
 {
-  auto & pubs = params_pub_[pub_idx];
-  if (pubs.count(topic) == 0) {
-    pubs[topic] = create_publisher<UserDefinedValue>(topic, 1);
+  const auto it = status_route.find(key);
+  if (it != status_route.end()) {
+    return it->second;
   }
-  return pubs.at(topic);
+
+  const std::string topic = base_topic + (status_name.empty() ? "" : "_" + status_name) + "_" + key;
+  KeyRoute & key_route = status_route[key];
+  key_route.publisher = create_publisher<UserDefinedValue>(topic, 1);
+  key_route.msg = createUserDefinedValue(KeyValue().set__key(key));
+  return key_route;
 }
 }  // namespace diagnostic_converter
 
@@ -19,6 +19,7 @@
 
 #include "autoware_auto_planning_msgs/msg/trajectory.hpp"
 #include "autoware_auto_planning_msgs/msg/trajectory_point.hpp"
+#include "geometry_msgs/msg/point.hpp"
 
 namespace planning_diagnostics
 {
@@ -27,6 +28,7 @@ namespace metrics
 namespace utils
 {
 using autoware_auto_planning_msgs::msg::Trajectory;
+using geometry_msgs::msg::Point;
 
 /**
  * @brief find the index in the trajectory at the given distance of the given index
@@ -37,6 +39,28 @@ using autoware_auto_planning_msgs::msg::Trajectory;
  */
 size_t getIndexAfterDistance(const Trajectory & traj, const size_t curr_id, const double distance);
 
+/**
+ * @brief find the index of the trajectory point nearest to the given point, starting from a hint
+ * @details gives the same result as a full search when successive points move monotonically along
+ * the trajectory and the hint is the result for the previous point
+ * @param [in] traj input trajectory
+ * @param [in] point point to search for
+ * @param [in] hint_id index from which the search starts
+ * @return index of the nearest trajectory point around the hint
+ */
+size_t findNearestIndexFromHint(const Trajectory & traj, const Point & point, const size_t hint_id);
+
+/**
+ * @brief find the index of the trajectory segment nearest to the given point from a hint
+ * @details same selection of the segment as motion_utils::findNearestSegmentIndex
+ * @param [in] traj input trajectory with at least 2 points
+ * @param [in] point point to search for
+ * @param [in] hint_id index from which the search starts
+ * @return index of the first point of the nearest segment around the hint
+ */
+size_t findNearestSegmentIndexFromHint(
+  const Trajectory & traj, const Point & point, const size_t hint_id);
+
 }  // namespace utils
 }  // namespace metrics
 }  // namespace planning_diagnostics
@@ -15,6 +15,7 @@
 #include "planning_evaluator/metrics/deviation_metrics.hpp"
 
 #include "motion_utils/trajectory/trajectory.hpp"
+#include "planning_evaluator/metrics/metrics_utils.hpp"
 #include "tier4_autoware_utils/tier4_autoware_utils.hpp"
 
 namespace planning_diagnostics
@@ -35,8 +36,10 @@ Stat<double> calcLateralDeviation(const Trajectory & ref, const Trajectory & tra
   /** TODO(Maxime CLEMENT):
    * need more precise calculation, e.g., lateral distance from spline of the reference traj
    */
-  for (TrajectoryPoint p : traj.points) {
-    const size_t nearest_index = motion_utils::findNearestIndex(ref.points, p.pose.position);
+  size_t nearest_index =
+    motion_utils::findNearestIndex(ref.points, traj.points.front().pose.position);
+  for (const TrajectoryPoint & p : traj.points) {
+    nearest_index = utils::findNearestIndexFromHint(ref, p.pose.position, nearest_index);
     stat.add(
       tier4_autoware_utils::calcLateralDeviation(ref.points[nearest_index].pose, p.pose.position));
   }
@@ -54,8 +57,10 @@ Stat<double> calcYawDeviation(const Trajectory & ref, const Trajectory & traj)
   /** TODO(Maxime CLEMENT):
    * need more precise calculation, e.g., yaw distance from spline of the reference traj
    */
-  for (TrajectoryPoint p : traj.points) {
-    const size_t nearest_index = motion_utils::findNearestIndex(ref.points, p.pose.position);
+  size_t nearest_index =
+    motion_utils::findNearestIndex(ref.points, traj.points.front().pose.position);
+  for (const TrajectoryPoint & p : traj.points) {
+    nearest_index = utils::findNearestIndexFromHint(ref, p.pose.position, nearest_index);
     stat.add(tier4_autoware_utils::calcYawDeviation(ref.points[nearest_index].pose, p.pose));
   }
   return stat;
@@ -70,8 +75,10 @@ Stat<double> calcVelocityDeviation(const Trajectory & ref, const Trajectory & tr
   }
 
   // TODO(Maxime CLEMENT) need more precise calculation
-  for (TrajectoryPoint p : traj.points) {
-    const size_t nearest_index = motion_utils::findNearestIndex(ref.points, p.pose.position);
+  size_t nearest_index =
+    motion_utils::findNearestIndex(ref.points, traj.points.front().pose.position);
+  for (const TrajectoryPoint & p : traj.points) {
+    nearest_index = utils::findNearestIndexFromHint(ref, p.pose.position, nearest_index);
     stat.add(p.longitudinal_velocity_mps - ref.points[nearest_index].longitudinal_velocity_mps);
   }
   return stat;
@@ -12,9 +12,14 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "planning_evaluator/metrics/metrics_utils.hpp"
+
+#include "motion_utils/trajectory/trajectory.hpp"
 #include "planning_evaluator/metrics/trajectory_metrics.hpp"
 #include "tier4_autoware_utils/tier4_autoware_utils.hpp"
 
+#include <algorithm>
+
 namespace planning_diagnostics
 {
 namespace metrics
@@ -24,6 +29,7 @@ namespace utils
 using autoware_auto_planning_msgs::msg::Trajectory;
 using autoware_auto_planning_msgs::msg::TrajectoryPoint;
 using tier4_autoware_utils::calcDistance2d;
+using tier4_autoware_utils::calcSquaredDistance2d;
 
 size_t getIndexAfterDistance(const Trajectory & traj, const size_t curr_id, const double distance)
 {
@@ -43,6 +49,65 @@ size_t getIndexAfterDistance(const Trajectory & traj, const size_t curr_id, cons
   return target_id;
 }
 
+size_t findNearestIndexFromHint(const Trajectory & traj, const Point & point, const size_t hint_id)
+{
+  // duplicated points are stepped over, as they would stop the descent
+  const auto is_duplicate = [&traj](const size_t i, const size_t j) {
+    return calcSquaredDistance2d(traj.points[i], traj.points[j]) == 0.0;
+  };
+
+  size_t nearest_id = std::min(hint_id, traj.points.size() - 1);
+  double min_dist = calcSquaredDistance2d(traj.points[nearest_id], point);
+  // descend forward first as the points usually move forward along the trajectory
+  while (true) {
+    size_t next_id = nearest_id + 1;
+    while (next_id < traj.points.size() && is_duplicate(next_id, nearest_id)) {
+      ++next_id;
+    }
+    if (next_id >= traj.points.size()) {
+      break;
+    }
+    const double dist = calcSquaredDistance2d(traj.points[next_id], point);
+    if (dist >= min_dist) {
+      break;
+    }
+    min_dist = dist;
+    nearest_id = next_id;
+  }
+  while (true) {
+    // the first of the duplicated points, as a full search returns
+    while (nearest_id > 0 && is_duplicate(nearest_id - 1, nearest_id)) {
+      --nearest_id;
+    }
+    if (nearest_id == 0) {
+      break;
+    }
+    const double dist = calcSquaredDistance2d(traj.points[nearest_id - 1], point);
+    if (dist >= min_dist) {
+      break;
+    }
+    min_dist = dist;
+    --nearest_id;
+  }
+  return nearest_id;
+}
+
+size_t findNearestSegmentIndexFromHint(
+  const Trajectory & traj, const Point & point, const size_t hint_id)
+{
+  const size_t nearest_id = findNearestIndexFromHint(traj, point, hint_id);
+  if (nearest_id == 0) {
+    return 0;
+  }
+  if (nearest_id == traj.points.size() - 1) {
+    return traj.points.size() - 2;
+  }
+  if (motion_utils::calcLongitudinalOffsetToSegment(traj.points, nearest_id, point) <= 0) {
+    return nearest_id - 1;
+  }
+  return nearest_id;
+}
+
 }  // namespace utils
 }  // namespace metrics
 }  // namespace planning_diagnostics
@@ -15,12 +15,18 @@
 #include "planning_evaluator/metrics/obstacle_metrics.hpp"
 
 #include "eigen3/Eigen/Core"
+#include "tier4_autoware_utils/geometry/boost_geometry.hpp"
 #include "tier4_autoware_utils/tier4_autoware_utils.hpp"
 
 #include "autoware_auto_planning_msgs/msg/trajectory_point.hpp"
 
+#include <boost/geometry/index/rtree.hpp>
+
 #include <algorithm>
+#include <cmath>
+#include <iterator>
 #include <limits>
+#include <vector>
 
 namespace planning_diagnostics
 {
@@ -28,18 +34,43 @@ namespace metrics
 {
 using autoware_auto_planning_msgs::msg::TrajectoryPoint;
 using tier4_autoware_utils::calcDistance2d;
+using tier4_autoware_utils::Point2d;
+
+namespace
+{
+namespace bgi = boost::geometry::index;
+using ObstacleRtree = bgi::rtree<Point2d, bgi::rstar<16>>;
+
+ObstacleRtree createObstacleRtree(const PredictedObjects & obstacles)
+{
+  // TODO(Maxime CLEMENT): take into account the shape, not only the centroid
+  std::vector<Point2d> positions;
+  positions.reserve(obstacles.objects.size());
+  for (const auto & object : obstacles.objects) {
+    const auto & position = object.kinematics.initial_pose_with_covariance.pose.position;
+    positions.emplace_back(position.x, position.y);
+  }
+  return ObstacleRtree(positions);  // packing construction
+}
+
+double calcDistanceToNearestObstacle(const ObstacleRtree & rtree, const TrajectoryPoint & p)
+{
+  const Point2d point(p.pose.position.x, p.pose.position.y);
+  std::vector<Point2d> nearest;
+  rtree.query(bgi::nearest(point, 1), std::back_inserter(nearest));
+  if (nearest.empty()) {
+    return std::numeric_limits<double>::max();
+  }
+  return std::hypot(nearest.front().x() - point.x(), nearest.front().y() - point.y());
+}
+}  // namespace
 
 Stat<double> calcDistanceToObstacle(const PredictedObjects & obstacles, const Trajectory & traj)
 {
   Stat<double> stat;
+  const auto rtree = createObstacleRtree(obstacles);
   for (const TrajectoryPoint & p : traj.points) {
-    double min_dist = std::numeric_limits<double>::max();
-    for (const auto & object : obstacles.objects) {
-      // TODO(Maxime CLEMENT): take into account the shape, not only the centroid
-      const auto dist = calcDistance2d(object.kinematics.initial_pose_with_covariance.pose, p);
-      min_dist = std::min(min_dist, dist);
-    }
-    stat.add(min_dist);
+    stat.add(calcDistanceToNearestObstacle(rtree, p));
   }
   return stat;
 }
@@ -56,20 +87,15 @@ Stat<double> calcTimeToCollision(
     p0 = traj.points.front();
   }
 
+  const auto rtree = createObstacleRtree(obstacles);
   double t = 0.0;  // [s] time from start of trajectory
   for (const TrajectoryPoint & p : traj.points) {
     const double traj_dist = calcDistance2d(p0, p);
     if (p0.longitudinal_velocity_mps != 0) {
       const double dt = traj_dist / std::abs(p0.longitudinal_velocity_mps);
       t += dt;
-      for (auto obstacle : obstacles.objects) {
-        const double obst_dist =
-          calcDistance2d(p, obstacle.kinematics.initial_pose_with_covariance.pose);
-        // TODO(Maxime CLEMENT): take shape into consideration
-        if (obst_dist <= distance_threshold) {
-          stat.add(t);
-          break;
-        }
+      if (calcDistanceToNearestObstacle(rtree, p) <= distance_threshold) {
+        stat.add(t);
       }
     }
     if (stat.count() > 0) {
@@ -14,13 +14,15 @@
 
 #include "planning_evaluator/metrics/stability_metrics.hpp"
 
-#include "eigen3/Eigen/Core"
 #include "motion_utils/trajectory/trajectory.hpp"
+#include "planning_evaluator/metrics/metrics_utils.hpp"
 #include "tier4_autoware_utils/tier4_autoware_utils.hpp"
 
 #include "autoware_auto_planning_msgs/msg/trajectory_point.hpp"
 
 #include <algorithm>
+#include <utility>
+#include <vector>
 
 namespace planning_diagnostics
 {
@@ -36,23 +38,26 @@ Stat<double> calcFrechetDistance(const Trajectory & traj1, const Trajectory & tr
     return stat;
   }
 
-  Eigen::MatrixXd ca = Eigen::MatrixXd::Zero(traj1.points.size(), traj2.points.size());
-
+  // only the previous row of the coupling distances is needed
+  std::vector<double> prev_row(traj2.points.size());
+  std::vector<double> curr_row(traj2.points.size());
   for (size_t i = 0; i < traj1.points.size(); ++i) {
     for (size_t j = 0; j < traj2.points.size(); ++j) {
       const double dist = tier4_autoware_utils::calcDistance2d(traj1.points[i], traj2.points[j]);
       if (i > 0 && j > 0) {
-        ca(i, j) = std::max(std::min(ca(i - 1, j), std::min(ca(i - 1, j - 1), ca(i, j - 1))), dist);
+        curr_row[j] =
+          std::max(std::min(prev_row[j], std::min(prev_row[j - 1], curr_row[j - 1])), dist);
       } else if (i > 0 /*&& j == 0*/) {
-        ca(i, j) = std::max(ca(i - 1, 0), dist);
+        curr_row[j] = std::max(prev_row[0], dist);
       } else if (j > 0 /*&& i == 0*/) {
-        ca(i, j) = std::max(ca(0, j - 1), dist);
+        curr_row[j] = std::max(curr_row[j - 1], dist);
       } else { /* i == j == 0 */
-        ca(i, j) = dist;
+        curr_row[j] = dist;
       }
     }
+    std::swap(prev_row, curr_row);
   }
-  stat.add(ca(traj1.points.size() - 1, traj2.points.size() - 1));
+  stat.add(prev_row.back());
   return stat;
 }
 
@@ -62,10 +67,13 @@ Stat<double> calcLateralDistance(const Trajectory & traj1, const Trajectory & tr
   if (traj1.points.empty()) {
     return stat;
   }
-  for (const auto & point : traj2.points) {
-    const auto p0 = tier4_autoware_utils::getPoint(point);
-    // find nearest segment
-    const size_t nearest_segment_idx = motion_utils::findNearestSegmentIndex(traj1.points, p0);
+  size_t nearest_segment_idx = 0;
+  for (size_t i = 0; i < traj2.points.size(); ++i) {
+    const auto p0 = tier4_autoware_utils::getPoint(traj2.points[i]);
+    // find nearest segment, starting from the one of the previous point
+    nearest_segment_idx =
+      i == 0 ? motion_utils::findNearestSegmentIndex(traj1.points, p0)
+             : utils::findNearestSegmentIndexFromHint(traj1, p0, nearest_segment_idx);
     double dist;
     // distance to segment
     if (
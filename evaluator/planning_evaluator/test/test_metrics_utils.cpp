@@ -0,0 +1,75 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+#include "motion_utils/trajectory/trajectory.hpp"
+#include "planning_evaluator/metrics/metrics_utils.hpp"
+
+#include <vector>
+
+using autoware_auto_planning_msgs::msg::Trajectory;
+using autoware_auto_planning_msgs::msg::TrajectoryPoint;
+using geometry_msgs::msg::Point;
+using planning_diagnostics::metrics::utils::findNearestIndexFromHint;
+
+namespace
+{
+Trajectory makeTrajectory(const std::vector<double> & xs)
+{
+  Trajectory traj;
+  for (const double x : xs) {
+    TrajectoryPoint p;
+    p.pose.position.x = x;
+    traj.points.push_back(p);
+  }
+  return traj;
+}
+
+Point makePoint(const double x, const double y)
+{
+  Point p;
+  p.x = x;
+  p.y = y;
+  return p;
+}
+}  // namespace
+
+TEST(MetricsUtilsTest, findNearestIndexFromHint)
+{
+  const Trajectory traj = makeTrajectory({0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0});
+
+  EXPECT_EQ(findNearestIndexFromHint(traj, makePoint(3.2, 0.5), 0), 3UL);
+  EXPECT_EQ(findNearestIndexFromHint(traj, makePoint(3.2, 0.5), 9), 3UL);
+  EXPECT_EQ(findNearestIndexFromHint(traj, makePoint(-1.0, 0.0), 5), 0UL);
+  EXPECT_EQ(findNearestIndexFromHint(traj, makePoint(20.0, 0.0), 5), 9UL);
+  // hint out of the trajectory
+  EXPECT_EQ(findNearestIndexFromHint(traj, makePoint(7.9, 0.0), 100), 8UL);
+}
+
+TEST(MetricsUtilsTest, findNearestIndexFromHintWithDuplicatedPoints)
+{
+  const Trajectory traj =
+    makeTrajectory({0.0, 0.0, 1.0, 2.0, 2.0, 2.0, 3.0, 4.0, 5.0, 5.0, 6.0, 7.0, 7.0});
+
+  // x never at the middle of two points, where the nearest point is not unique
+  for (int i = 0; i < 30; ++i) {
+    const Point point = makePoint(-0.99 + 0.3 * i, 1.0);
+    const size_t expected = motion_utils::findNearestIndex(traj.points, point);
+    // hint at either end and at each point
+    for (size_t hint_id = 0; hint_id < traj.points.size(); ++hint_id) {
+      EXPECT_EQ(findNearestIndexFromHint(traj, point, hint_id), expected)
+        << "x: " << point.x << ", hint: " << hint_id;
+    }
+  }
+}
@@ -19,8 +19,16 @@
 
 #include <cmath>
 
-inline bool hasInf(const Eigen::MatrixXd & v) { return v.array().isInf().any(); }
+template <typename Derived>
+bool hasInf(const Eigen::MatrixBase<Derived> & v)
+{
+  return v.array().isInf().any();
+}
 
-inline bool hasNan(const Eigen::MatrixXd & v) { return v.array().isNaN().any(); }
+template <typename Derived>
+bool hasNan(const Eigen::MatrixBase<Derived> & v)
+{
+  return v.array().isNaN().any();
+}
 
 #endif  // EKF_LOCALIZER__NUMERIC_HPP_
@@ -155,11 +155,9 @@ void EKFLocalizer::timerCallback()
   stop_watch_.tic();
   DEBUG_INFO(get_logger(), "------------------------- start prediction -------------------------");
 
-  const Eigen::MatrixXd X_curr = ekf_.getLatestX();
+  const Vector6d X_curr = ekf_.getLatestX();
   DEBUG_PRINT_MAT(X_curr.transpose());
 
-  const Eigen::MatrixXd P_curr = ekf_.getLatestP();
-
   const double dt = ekf_dt_;
 
   const Vector6d X_next = predictNextState(X_curr, dt);
@@ -169,7 +167,7 @@ void EKFLocalizer::timerCallback()
   ekf_.predictWithDelay(X_next, A, Q);
 
   // debug
-  const Eigen::MatrixXd X_result = ekf_.getLatestX();
+  const Vector6d X_result = ekf_.getLatestX();
   DEBUG_PRINT_MAT(X_result.transpose());
   DEBUG_PRINT_MAT((X_result - X_curr).transpose());
   DEBUG_INFO(get_logger(), "[EKF] predictKinematicsModel calc time = %f [ms]", stop_watch_.toc());
@@ -240,7 +238,7 @@ void EKFLocalizer::timerCallback()
 void EKFLocalizer::showCurrentX()
 {
   if (params_.show_debug_info) {
-    const Eigen::MatrixXd X = ekf_.getLatestX();
+    const Vector6d X = ekf_.getLatestX();
     DEBUG_PRINT_MAT(X.transpose());
   }
 }
@@ -387,7 +385,7 @@ void EKFLocalizer::measurementUpdatePose(const geometry_msgs::msg::PoseWithCovar
         pose.header.frame_id.c_str(), params_.pose_frame_id.c_str()),
       2000);
   }
-  const Eigen::MatrixXd X_curr = ekf_.getLatestX();
+  const Vector6d X_curr = ekf_.getLatestX();
   DEBUG_PRINT_MAT(X_curr.transpose());
 
   constexpr int dim_y = 3;  // pos_x, pos_y, yaw, depending on Pose output
@@ -416,8 +414,7 @@ void EKFLocalizer::measurementUpdatePose(const geometry_msgs::msg::PoseWithCovar
   yaw = yaw_error + ekf_yaw;
 
   /* Set measurement matrix */
-  Eigen::MatrixXd y(dim_y, 1);
-  y << pose.pose.pose.position.x, pose.pose.pose.position.y, yaw;
+  const Eigen::Vector3d y(pose.pose.pose.position.x, pose.pose.pose.position.y, yaw);
 
   if (hasNan(y) || hasInf(y)) {
     warning_.warn(
@@ -429,8 +426,8 @@ void EKFLocalizer::measurementUpdatePose(const geometry_msgs::msg::PoseWithCovar
   const Eigen::Vector3d y_ekf(
     ekf_.getXelement(delay_step * dim_x_ + IDX::X), ekf_.getXelement(delay_step * dim_x_ + IDX::Y),
     ekf_yaw);
-  const Eigen::MatrixXd P_curr = ekf_.getLatestP();
-  const Eigen::MatrixXd P_y = P_curr.block(0, 0, dim_y, dim_y);
+  const Matrix6d P_curr = ekf_.getLatestP();
+  const Eigen::Matrix3d P_y = P_curr.block<dim_y, dim_y>(IDX::X, IDX::X);
 
   const double distance = mahalanobis(y_ekf, y, P_y);
   if (distance > params_.pose_gate_dist) {
@@ -443,14 +440,14 @@ void EKFLocalizer::measurementUpdatePose(const geometry_msgs::msg::PoseWithCovar
   DEBUG_PRINT_MAT(y_ekf.transpose());
   DEBUG_PRINT_MAT((y - y_ekf).transpose());
 
-  const Eigen::Matrix<double, 3, 6> C = poseMeasurementMatrix();
+  const Eigen::Matrix<double, dim_y, 6> C = poseMeasurementMatrix();
   const Eigen::Matrix3d R =
     poseMeasurementCovariance(pose.pose.covariance, params_.pose_smoothing_steps);
 
   ekf_.updateWithDelay(y, C, R, delay_step);
 
   // debug
-  const Eigen::MatrixXd X_result = ekf_.getLatestX();
+  const Vector6d X_result = ekf_.getLatestX();
   DEBUG_PRINT_MAT(X_result.transpose());
   DEBUG_PRINT_MAT((X_result - X_curr).transpose());
 }
@@ -467,7 +464,7 @@ void EKFLocalizer::measurementUpdateTwist(
       "twist frame_id must be base_link");
   }
 
-  const Eigen::MatrixXd X_curr = ekf_.getLatestX();
+  const Vector6d X_curr = ekf_.getLatestX();
   DEBUG_PRINT_MAT(X_curr.transpose());
 
   constexpr int dim_y = 2;  // vx, wz
@@ -489,8 +486,7 @@ void EKFLocalizer::measurementUpdateTwist(
   DEBUG_INFO(get_logger(), "delay_time: %f [s]", delay_time);
 
   /* Set measurement matrix */
-  Eigen::MatrixXd y(dim_y, 1);
-  y << twist.twist.twist.linear.x, twist.twist.twist.angular.z;
+  const Eigen::Vector2d y(twist.twist.twist.linear.x, twist.twist.twist.angular.z);
 
   if (hasNan(y) || hasInf(y)) {
     warning_.warn(
@@ -501,8 +497,8 @@ void EKFLocalizer::measurementUpdateTwist(
   const Eigen::Vector2d y_ekf(
     ekf_.getXelement(delay_step * dim_x_ + IDX::VX),
     ekf_.getXelement(delay_step * dim_x_ + IDX::WZ));
-  const Eigen::MatrixXd P_curr = ekf_.getLatestP();
-  const Eigen::MatrixXd P_y = P_curr.block(4, 4, dim_y, dim_y);
+  const Matrix6d P_curr = ekf_.getLatestP();
+  const Eigen::Matrix2d P_y = P_curr.block<dim_y, dim_y>(IDX::VX, IDX::VX);
 
   const double distance = mahalanobis(y_ekf, y, P_y);
   if (distance > params_.twist_gate_dist) {
@@ -515,14 +511,14 @@ void EKFLocalizer::measurementUpdateTwist(
   DEBUG_PRINT_MAT(y_ekf.transpose());
   DEBUG_PRINT_MAT((y - y_ekf).transpose());
 
-  const Eigen::Matrix<double, 2, 6> C = twistMeasurementMatrix();
+  const Eigen::Matrix<double, dim_y, 6> C = twistMeasurementMatrix();
   const Eigen::Matrix2d R =
     twistMeasurementCovariance(twist.twist.covariance, params_.twist_smoothing_steps);
 
   ekf_.updateWithDelay(y, C, R, delay_step);
 
   // debug
-  const Eigen::MatrixXd X_result = ekf_.getLatestX();
+  const Vector6d X_result = ekf_.getLatestX();
   DEBUG_PRINT_MAT(X_result.transpose());
   DEBUG_PRINT_MAT((X_result - X_curr).transpose());
 }
@@ -533,8 +529,8 @@ void EKFLocalizer::measurementUpdateTwist(
 void EKFLocalizer::publishEstimateResult()
 {
   rclcpp::Time current_time = this->now();
-  const Eigen::MatrixXd X = ekf_.getLatestX();
-  const Eigen::MatrixXd P = ekf_.getLatestP();
+  const Vector6d X = ekf_.getLatestX();
+  const Matrix6d P = ekf_.getLatestP();
 
   /* publish latest pose */
   pub_pose_->publish(current_ekf_pose_);
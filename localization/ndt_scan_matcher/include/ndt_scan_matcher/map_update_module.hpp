@@ -37,6 +37,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 class MapUpdateModule
@@ -49,7 +50,7 @@ class MapUpdateModule
 public:
   MapUpdateModule(
     rclcpp::Node * node, std::mutex * ndt_ptr_mutex,
-    std::shared_ptr<NormalDistributionsTransform> ndt_ptr,
+    std::shared_ptr<NormalDistributionsTransform> * ndt_ptr_ptr,
     std::shared_ptr<Tf2ListenerModule> tf2_listener_module, std::string map_frame,
     rclcpp::CallbackGroup::SharedPtr main_callback_group,
     std::shared_ptr<std::map<std::string, std::string>> state_ptr);
@@ -64,12 +65,21 @@ private:
   void update_ndt(
     const std::vector<autoware_map_msgs::msg::PointCloudMapCellWithID> & maps_to_add,
     const std::vector<std::string> & map_ids_to_remove);
+  void apply_map_update(
+    NormalDistributionsTransform & ndt,
+    const std::vector<std::pair<std::string, pcl::shared_ptr<pcl::PointCloud<PointTarget>>>> &
+      maps_to_add,
+    const std::vector<std::string> & map_ids_to_remove) const;
   void update_map(const geometry_msgs::msg::Point & position);
   bool should_update_map(const geometry_msgs::msg::Point & position) const;
-  void publish_partial_pcd_map();
+  geometry_msgs::msg::Point predict_update_position(const nav_msgs::msg::Odometry & odom) const;
+  void publish_partial_pcd_map(const std::shared_ptr<NormalDistributionsTransform> & ndt_ptr);
   geometry_msgs::msg::PoseWithCovarianceStamped align_using_monte_carlo(
     const std::shared_ptr<NormalDistributionsTransform> & ndt_ptr,
     const geometry_msgs::msg::PoseWithCovarianceStamped & initial_pose_with_cov);
+  void align_particles(
+    NormalDistributionsTransform & ndt, const std::vector<size_t> & particle_indices,
+    const int max_iterations, std::vector<Particle> & particle_array) const;
   void publish_point_cloud(
     const rclcpp::Time & sensor_ros_time, const std::string & frame_id,
     const std::shared_ptr<const pcl::PointCloud<PointSource>> & sensor_points_mapTF_ptr);
@@ -88,7 +98,10 @@ private:
 
   rclcpp::CallbackGroup::SharedPtr map_callback_group_;
 
-  std::shared_ptr<NormalDistributionsTransform> ndt_ptr_;
+  // The scan matcher always reads *ndt_ptr_ptr_, the map is updated on secondary_ndt_ptr_ which
+  // only this module touches, and both are swapped once the update is ready.
+  std::shared_ptr<NormalDistributionsTransform> * ndt_ptr_ptr_;
+  std::shared_ptr<NormalDistributionsTransform> secondary_ndt_ptr_;
   std::mutex * ndt_ptr_mutex_;
   std::string map_frame_;
   rclcpp::Logger logger_;
@@ -97,11 +110,16 @@ private:
   std::shared_ptr<std::map<std::string, std::string>> state_ptr_;
 
   int initial_estimate_particles_num_;
+  int initial_estimate_num_threads_;
+  int initial_estimate_coarse_iterations_;
+  int initial_estimate_refined_particles_num_;
   std::optional<geometry_msgs::msg::Point> last_update_position_ = std::nullopt;
   std::optional<geometry_msgs::msg::Point> current_position_ = std::nullopt;
+  std::optional<nav_msgs::msg::Odometry> current_odom_ = std::nullopt;
   const double dynamic_map_loading_update_distance_;
   const double dynamic_map_loading_map_radius_;
   const double lidar_radius_;
+  const double dynamic_map_loading_lookahead_time_;
 };
 
 #endif  // NDT_SCAN_MATCHER__MAP_UPDATE_MODULE_HPP_
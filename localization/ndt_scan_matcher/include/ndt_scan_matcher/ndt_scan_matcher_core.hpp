@@ -95,10 +95,13 @@ private:
     const std::shared_ptr<NormalDistributionsTransform> & ndt_ptr,
     const geometry_msgs::msg::PoseWithCovarianceStamped & initial_pose_with_cov);
 
+  pclomp::NdtResult align_within_time_budget(
+    const Eigen::Matrix4f & initial_pose_matrix, const double time_budget_ms,
+    bool & is_time_budget_exceeded);
+
   void transform_sensor_measurement(
-    const std::string source_frame, const std::string target_frame,
-    const pcl::shared_ptr<pcl::PointCloud<PointSource>> sensor_points_input_ptr,
-    pcl::shared_ptr<pcl::PointCloud<PointSource>> sensor_points_output_ptr);
+    const sensor_msgs::msg::PointCloud2 & sensor_points_input_msg, const std::string & target_frame,
+    pcl::PointCloud<PointSource> & sensor_points_output);
   void update_transforms();
 
   void publish_tf(
@@ -142,6 +145,10 @@ private:
   rclcpp::Publisher<geometry_msgs::msg::PoseWithCovarianceStamped>::SharedPtr
     initial_pose_with_covariance_pub_;
   rclcpp::Publisher<tier4_debug_msgs::msg::Float32Stamped>::SharedPtr exe_time_pub_;
+  rclcpp::Publisher<tier4_debug_msgs::msg::Float32Stamped>::SharedPtr
+    transform_sensor_measurement_time_pub_;
+  rclcpp::Publisher<tier4_debug_msgs::msg::Float32Stamped>::SharedPtr
+    align_time_per_iteration_pub_;
   rclcpp::Publisher<tier4_debug_msgs::msg::Float32Stamped>::SharedPtr transform_probability_pub_;
   rclcpp::Publisher<tier4_debug_msgs::msg::Float32Stamped>::SharedPtr
     nearest_voxel_transformation_likelihood_pub_;
@@ -206,6 +213,15 @@ private:
   // cspell: ignore degrounded
   bool estimate_scores_for_degrounded_scan_;
   double z_margin_for_ground_removal_;
+
+  // 0 runs the alignment until max_iterations regardless of the processing time
+  double alignment_time_budget_ms_;
+
+  // scratch clouds reused across callback_sensor_points calls
+  pcl::shared_ptr<pcl::PointCloud<PointSource>> sensor_points_baselinkTF_ptr_;
+  pcl::shared_ptr<pcl::PointCloud<PointSource>> sensor_points_mapTF_ptr_;
+  pcl::shared_ptr<pcl::PointCloud<PointSource>> no_ground_points_mapTF_ptr_;
+  pcl::shared_ptr<pcl::PointCloud<PointSource>> output_cloud_;
 };
 
 #endif  // NDT_SCAN_MATCHER__NDT_SCAN_MATCHER_CORE_HPP_
@@ -44,7 +44,7 @@ class PoseInitializationModule
 public:
   PoseInitializationModule(
     rclcpp::Node * node, std::mutex * ndt_ptr_mutex,
-    std::shared_ptr<NormalDistributionsTransform> ndt_ptr,
+    std::shared_ptr<NormalDistributionsTransform> * ndt_ptr_ptr,
     std::shared_ptr<Tf2ListenerModule> tf2_listener_module, std::string map_frame,
     rclcpp::CallbackGroup::SharedPtr main_callback_group,
     std::shared_ptr<std::map<std::string, std::string>> state_ptr);
@@ -67,7 +67,7 @@ private:
     ndt_monte_carlo_initial_pose_marker_pub_;
   int initial_estimate_particles_num_;
 
-  std::shared_ptr<NormalDistributionsTransform> ndt_ptr_;
+  std::shared_ptr<NormalDistributionsTransform> * ndt_ptr_ptr_;
   std::mutex * ndt_ptr_mutex_;
   std::string map_frame_;
   rclcpp::Logger logger_;
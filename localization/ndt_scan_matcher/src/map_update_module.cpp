@@ -14,6 +14,12 @@
 
 #include "ndt_scan_matcher/map_update_module.hpp"
 
+#include <tf2/utils.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
 template <typename T, typename U>
 double norm_xy(const T p1, const U p2)
 {
@@ -24,11 +30,11 @@ double norm_xy(const T p1, const U p2)
 
 MapUpdateModule::MapUpdateModule(
   rclcpp::Node * node, std::mutex * ndt_ptr_mutex,
-  std::shared_ptr<NormalDistributionsTransform> ndt_ptr,
+  std::shared_ptr<NormalDistributionsTransform> * ndt_ptr_ptr,
   std::shared_ptr<Tf2ListenerModule> tf2_listener_module, std::string map_frame,
   rclcpp::CallbackGroup::SharedPtr main_callback_group,
   std::shared_ptr<std::map<std::string, std::string>> state_ptr)
-: ndt_ptr_(ndt_ptr),
+: ndt_ptr_ptr_(ndt_ptr_ptr),
   ndt_ptr_mutex_(ndt_ptr_mutex),
   map_frame_(map_frame),
   logger_(node->get_logger()),
@@ -39,9 +45,21 @@ MapUpdateModule::MapUpdateModule(
     node->declare_parameter<double>("dynamic_map_loading_update_distance")),
   dynamic_map_loading_map_radius_(
     node->declare_parameter<double>("dynamic_map_loading_map_radius")),
-  lidar_radius_(node->declare_parameter<double>("lidar_radius"))
+  lidar_radius_(node->declare_parameter<double>("lidar_radius")),
+  dynamic_map_loading_lookahead_time_(
+    node->declare_parameter<double>("dynamic_map_loading_lookahead_time", 0.0))
 {
   initial_estimate_particles_num_ = node->declare_parameter<int>("initial_estimate_particles_num");
+  initial_estimate_num_threads_ =
+    std::max(node->declare_parameter<int>("initial_estimate_num_threads", 4), 1);
+  initial_estimate_coarse_iterations_ =
+    node->declare_parameter<int>("initial_estimate_coarse_iterations", 10);
+  initial_estimate_refined_particles_num_ = std::max(
+    node->declare_parameter<int>("initial_estimate_refined_particles_num", 10), 1);
+
+  // no map is loaded yet, so the secondary buffer only needs the same parameters
+  secondary_ndt_ptr_ = std::make_shared<NormalDistributionsTransform>();
+  secondary_ndt_ptr_->setParams(std::atomic_load(ndt_ptr_ptr_)->getParams());
 
   sensor_aligned_pose_pub_ =
     node->create_publisher<sensor_msgs::msg::PointCloud2>("monte_carlo_points_aligned", 10);
@@ -97,13 +115,14 @@ void MapUpdateModule::service_ndt_align(
   const auto mapTF_initial_pose_msg = transform(req->pose_with_covariance, *TF_pose_to_map_ptr);
   update_map(mapTF_initial_pose_msg.pose.pose.position);
 
-  if (ndt_ptr_->getInputTarget() == nullptr) {
+  const auto ndt_ptr = std::atomic_load(ndt_ptr_ptr_);
+  if (ndt_ptr->getInputTarget() == nullptr) {
     res->success = false;
     RCLCPP_WARN(logger_, "No InputTarget");
     return;
   }
 
-  if (ndt_ptr_->getInputSource() == nullptr) {
+  if (ndt_ptr->getInputSource() == nullptr) {
     res->success = false;
     RCLCPP_WARN(logger_, "No InputSource");
     return;
@@ -113,7 +132,7 @@ void MapUpdateModule::service_ndt_align(
   std::lock_guard<std::mutex> lock(*ndt_ptr_mutex_);
 
   (*state_ptr_)["state"] = "Aligning";
-  res->pose_with_covariance = align_using_monte_carlo(ndt_ptr_, mapTF_initial_pose_msg);
+  res->pose_with_covariance = align_using_monte_carlo(*ndt_ptr_ptr_, mapTF_initial_pose_msg);
   (*state_ptr_)["state"] = "Sleeping";
   res->success = true;
   res->pose_with_covariance.pose.covariance = req->pose_with_covariance.pose.covariance;
@@ -124,6 +143,7 @@ void MapUpdateModule::service_ndt_align(
 void MapUpdateModule::callback_ekf_odom(nav_msgs::msg::Odometry::ConstSharedPtr odom_ptr)
 {
   current_position_ = odom_ptr->pose.pose.position;
+  current_odom_ = *odom_ptr;
 
   if (last_update_position_ == std::nullopt) {
     return;
@@ -145,14 +165,39 @@ void MapUpdateModule::map_update_timer_callback()
   }
   if (last_update_position_ == std::nullopt) return;
 
+  // when looking ahead, the map is centered ahead of the ego so that the upcoming map cells are
+  // loaded before the ego reaches them
+  const geometry_msgs::msg::Point update_position =
+    (dynamic_map_loading_lookahead_time_ > 0.0 && current_odom_ != std::nullopt)
+      ? predict_update_position(current_odom_.value())
+      : current_position_.value();
+
   // continue only if we should update the map
-  if (should_update_map(current_position_.value())) {
+  if (should_update_map(update_position)) {
     RCLCPP_INFO(logger_, "Start updating NDT map (timer_callback)");
-    update_map(current_position_.value());
-    last_update_position_ = current_position_;
+    update_map(update_position);
+    last_update_position_ = update_position;
   }
 }
 
+geometry_msgs::msg::Point MapUpdateModule::predict_update_position(
+  const nav_msgs::msg::Odometry & odom) const
+{
+  // The ego may travel up to the update distance away from the map center before the next
+  // update, so the lead is bounded to keep the LiDAR range inside the loaded map
+  const double max_lead_distance = std::max(
+    dynamic_map_loading_map_radius_ - lidar_radius_ - dynamic_map_loading_update_distance_, 0.0);
+  const double lead_distance = std::min(
+    std::abs(odom.twist.twist.linear.x) * dynamic_map_loading_lookahead_time_, max_lead_distance);
+  const double direction = odom.twist.twist.linear.x < 0.0 ? -1.0 : 1.0;
+  const double yaw = tf2::getYaw(odom.pose.pose.orientation);
+
+  geometry_msgs::msg::Point position = odom.pose.pose.position;
+  position.x += direction * lead_distance * std::cos(yaw);
+  position.y += direction * lead_distance * std::sin(yaw);
+  return position;
+}
+
 bool MapUpdateModule::should_update_map(const geometry_msgs::msg::Point & position) const
 {
   if (last_update_position_ == std::nullopt) return false;
@@ -165,7 +210,7 @@ void MapUpdateModule::update_map(const geometry_msgs::msg::Point & position)
   auto request = std::make_shared<autoware_map_msgs::srv::GetDifferentialPointCloudMap::Request>();
   request->area.center = position;
   request->area.radius = dynamic_map_loading_map_radius_;
-  request->cached_ids = ndt_ptr_->getCurrentMapIDs();
+  request->cached_ids = secondary_ndt_ptr_->getCurrentMapIDs();
 
   // // send a request to map_loader
   auto result{pcd_loader_client_->async_send_request(
@@ -195,21 +240,16 @@ void MapUpdateModule::update_ndt(
   }
   const auto exe_start_time = std::chrono::system_clock::now();
 
-  NormalDistributionsTransform backup_ndt = *ndt_ptr_;
-
-  // Add pcd
+  std::vector<std::pair<std::string, pcl::shared_ptr<pcl::PointCloud<PointTarget>>>> map_points;
+  map_points.reserve(maps_to_add.size());
   for (const auto & map_to_add : maps_to_add) {
     pcl::shared_ptr<pcl::PointCloud<PointTarget>> map_points_ptr(new pcl::PointCloud<PointTarget>);
     pcl::fromROSMsg(map_to_add.pointcloud, *map_points_ptr);
-    backup_ndt.addTarget(map_points_ptr, map_to_add.cell_id);
+    map_points.emplace_back(map_to_add.cell_id, map_points_ptr);
   }
 
-  // Remove pcd
-  for (const std::string & map_id_to_remove : map_ids_to_remove) {
-    backup_ndt.removeTarget(map_id_to_remove);
-  }
-
-  backup_ndt.createVoxelKdtree();
+  // the secondary buffer is not visible to the scan matcher, so it is updated without the lock
+  apply_map_update(*secondary_ndt_ptr_, map_points, map_ids_to_remove);
 
   const auto exe_end_time = std::chrono::system_clock::now();
   const double exe_time =
@@ -217,15 +257,57 @@ void MapUpdateModule::update_ndt(
     1000.0;
   RCLCPP_INFO(logger_, "Time duration for creating new ndt_ptr: %lf [ms]", exe_time);
 
-  // swap
+  publish_partial_pcd_map(secondary_ndt_ptr_);
+
+  // swap, only the pointers are exchanged while the scan matcher is blocked
   (*ndt_ptr_mutex_).lock();
-  // ToDo (kminoda): Here negligible NDT copy occurs during the new map loading phase, which should
-  // ideally be avoided. But I will leave this for now since I cannot come up with a solution other
-  // than using pointer of pointer.
-  *ndt_ptr_ = backup_ndt;
+  if ((*ndt_ptr_ptr_)->getInputSource() != nullptr) {
+    secondary_ndt_ptr_->setInputSource((*ndt_ptr_ptr_)->getInputSource());
+  }
+  secondary_ndt_ptr_ = std::atomic_exchange(ndt_ptr_ptr_, secondary_ndt_ptr_);
   (*ndt_ptr_mutex_).unlock();
 
-  publish_partial_pcd_map();
+  // the previous map is no longer used by the scan matcher, bring it up to date for the next swap
+  apply_map_update(*secondary_ndt_ptr_, map_points, map_ids_to_remove);
+}
+
+void MapUpdateModule::apply_map_update(
+  NormalDistributionsTransform & ndt,
+  const std::vector<std::pair<std::string, pcl::shared_ptr<pcl::PointCloud<PointTarget>>>> &
+    maps_to_add,
+  const std::vector<std::string> & map_ids_to_remove) const
+{
+  // Add pcd
+  for (const auto & [map_id, map_points_ptr] : maps_to_add) {
+    ndt.addTarget(map_points_ptr, map_id);
+  }
+
+  // Remove pcd
+  for (const std::string & map_id_to_remove : map_ids_to_remove) {
+    ndt.removeTarget(map_id_to_remove);
+  }
+
+  ndt.createVoxelKdtree();
+}
+
+void MapUpdateModule::align_particles(
+  NormalDistributionsTransform & ndt, const std::vector<size_t> & particle_indices,
+  const int max_iterations, std::vector<Particle> & particle_array) const
+{
+  pclomp::NdtParams params = ndt.getParams();
+  params.max_iterations = max_iterations;
+  ndt.setParams(params);
+
+  // a particle continues from its last result, so the iterations of the passes add up
+  auto output_cloud = std::make_shared<pcl::PointCloud<PointSource>>();
+  for (const size_t particle_index : particle_indices) {
+    Particle & particle = particle_array[particle_index];
+    ndt.align(*output_cloud, pose_to_matrix4f(particle.result_pose));
+    const pclomp::NdtResult ndt_result = ndt.getResult();
+    particle.result_pose = matrix4f_to_pose(ndt_result.pose);
+    particle.score = ndt_result.transform_probability;
+    particle.iteration += ndt_result.iteration_num;
+  }
 }
 
 geometry_msgs::msg::PoseWithCovarianceStamped MapUpdateModule::align_using_monte_carlo(
@@ -240,38 +322,77 @@ geometry_msgs::msg::PoseWithCovarianceStamped MapUpdateModule::align_using_monte
   // generateParticle
   const auto initial_poses =
     create_random_pose_array(initial_pose_with_cov, initial_estimate_particles_num_);
+  if (initial_poses.empty()) {
+    RCLCPP_WARN(logger_, "No initial pose particle");
+    return geometry_msgs::msg::PoseWithCovarianceStamped();
+  }
 
   std::vector<Particle> particle_array;
-  auto output_cloud = std::make_shared<pcl::PointCloud<PointSource>>();
+  particle_array.reserve(initial_poses.size());
+  for (const auto & initial_pose : initial_poses) {
+    particle_array.emplace_back(initial_pose, initial_pose, 0.0, 0);
+  }
 
-  for (unsigned int i = 0; i < initial_poses.size(); i++) {
-    const auto & initial_pose = initial_poses[i];
-    const Eigen::Matrix4f initial_pose_matrix = pose_to_matrix4f(initial_pose);
-    ndt_ptr->align(*output_cloud, initial_pose_matrix);
-    const pclomp::NdtResult ndt_result = ndt_ptr->getResult();
-
-    Particle particle(
-      initial_pose, matrix4f_to_pose(ndt_result.pose), ndt_result.transform_probability,
-      ndt_result.iteration_num);
-    particle_array.push_back(particle);
-    const auto marker_array = make_debug_markers(
-      clock_->now(), map_frame_, tier4_autoware_utils::createMarkerScale(0.3, 0.1, 0.1), particle,
+  // the particles share the map of the scan matcher and each alignment is parallelized over the
+  // scan points, so the search runs on the shared instance with its parameters restored afterwards
+  const pclomp::NdtParams original_params = ndt_ptr->getParams();
+  pclomp::NdtParams search_params = original_params;
+  search_params.num_threads = initial_estimate_num_threads_;
+
+  // coarse pass on every particle, then only the best scored ones continue until convergence
+  const int max_iterations = original_params.max_iterations;
+  std::vector<size_t> particle_indices(particle_array.size());
+  std::iota(particle_indices.begin(), particle_indices.end(), 0);
+  const bool use_coarse_pass =
+    initial_estimate_coarse_iterations_ < max_iterations &&
+    static_cast<size_t>(initial_estimate_refined_particles_num_) < particle_indices.size();
+  ndt_ptr->setParams(search_params);
+  if (use_coarse_pass) {
+    align_particles(
+      *ndt_ptr, particle_indices, initial_estimate_coarse_iterations_, particle_array);
+    const auto refined_end = particle_indices.begin() + initial_estimate_refined_particles_num_;
+    std::partial_sort(
+      particle_indices.begin(), refined_end, particle_indices.end(),
+      [&](const size_t lhs, const size_t rhs) {
+        return particle_array[lhs].score > particle_array[rhs].score;
+      });
+    particle_indices.erase(refined_end, particle_indices.end());
+    align_particles(
+      *ndt_ptr, particle_indices, max_iterations - initial_estimate_coarse_iterations_,
+      particle_array);
+  } else {
+    align_particles(*ndt_ptr, particle_indices, max_iterations, particle_array);
+  }
+  ndt_ptr->setParams(original_params);
+
+  const size_t best_index = *std::max_element(
+    particle_indices.begin(), particle_indices.end(), [&](const size_t lhs, const size_t rhs) {
+      return particle_array[lhs].score < particle_array[rhs].score;
+    });
+  const Particle & best_particle = particle_array[best_index];
+
+  // debug publication is done once after the search
+  visualization_msgs::msg::MarkerArray marker_array;
+  const auto stamp = clock_->now();
+  for (size_t i = 0; i < particle_array.size(); ++i) {
+    const auto particle_markers = make_debug_markers(
+      stamp, map_frame_, tier4_autoware_utils::createMarkerScale(0.3, 0.1, 0.1), particle_array[i],
       i);
-    ndt_monte_carlo_initial_pose_marker_pub_->publish(marker_array);
-
-    auto sensor_points_mapTF_ptr = std::make_shared<pcl::PointCloud<PointSource>>();
-    pcl::transformPointCloud(*ndt_ptr->getInputSource(), *sensor_points_mapTF_ptr, ndt_result.pose);
-    publish_point_cloud(initial_pose_with_cov.header.stamp, map_frame_, sensor_points_mapTF_ptr);
+    marker_array.markers.insert(
+      marker_array.markers.end(), particle_markers.markers.begin(), particle_markers.markers.end());
   }
+  ndt_monte_carlo_initial_pose_marker_pub_->publish(marker_array);
 
-  auto best_particle_ptr = std::max_element(
-    std::begin(particle_array), std::end(particle_array),
-    [](const Particle & lhs, const Particle & rhs) { return lhs.score < rhs.score; });
+  auto sensor_points_mapTF_ptr = std::make_shared<pcl::PointCloud<PointSource>>();
+  pcl::transformPointCloud(
+    *ndt_ptr->getInputSource(), *sensor_points_mapTF_ptr,
+    pose_to_matrix4f(best_particle.result_pose));
+  publish_point_cloud(initial_pose_with_cov.header.stamp, map_frame_, sensor_points_mapTF_ptr);
 
   geometry_msgs::msg::PoseWithCovarianceStamped result_pose_with_cov_msg;
   result_pose_with_cov_msg.header.stamp = initial_pose_with_cov.header.stamp;
   result_pose_with_cov_msg.header.frame_id = map_frame_;
-  result_pose_with_cov_msg.pose.pose = best_particle_ptr->result_pose;
+  result_pose_with_cov_msg.pose.pose = best_particle.result_pose;
 
   return result_pose_with_cov_msg;
 }
@@ -287,9 +408,10 @@ void MapUpdateModule::publish_point_cloud(
   sensor_aligned_pose_pub_->publish(sensor_points_mapTF_msg);
 }
 
-void MapUpdateModule::publish_partial_pcd_map()
+void MapUpdateModule::publish_partial_pcd_map(
+  const std::shared_ptr<NormalDistributionsTransform> & ndt_ptr)
 {
-  pcl::PointCloud<PointTarget> map_pcl = ndt_ptr_->getVoxelPCD();
+  pcl::PointCloud<PointTarget> map_pcl = ndt_ptr->getVoxelPCD();
 
   sensor_msgs::msg::PointCloud2 map_msg;
   pcl::toROSMsg(map_pcl, map_msg);
@@ -22,6 +22,7 @@
 #include <tier4_autoware_utils/geometry/geometry.hpp>
 
 #include <pcl_conversions/pcl_conversions.h>
+#include <sensor_msgs/point_cloud2_iterator.hpp>
 
 #ifdef ROS_DISTRO_GALACTIC
 #include <tf2_eigen/tf2_eigen.h>
@@ -49,6 +50,12 @@ tier4_debug_msgs::msg::Int32Stamped make_int32_stamped(
   return tier4_debug_msgs::build<T>().stamp(stamp).data(data);
 }
 
+template <class PublisherSharedPtr>
+bool has_subscriber(const PublisherSharedPtr & pub)
+{
+  return (pub->get_subscription_count() + pub->get_intra_process_subscription_count()) > 0;
+}
+
 bool validate_local_optimal_solution_oscillation(
   const std::vector<geometry_msgs::msg::Pose> & result_pose_msg_array,
   const float oscillation_threshold, const float inversion_vector_threshold)
@@ -97,7 +104,12 @@ NDTScanMatcher::NDTScanMatcher()
   regularization_enabled_(declare_parameter("regularization_enabled", false)),
   estimate_scores_for_degrounded_scan_(
     declare_parameter("estimate_scores_for_degrounded_scan", false)),
-  z_margin_for_ground_removal_(declare_parameter("z_margin_for_ground_removal", 0.8))
+  z_margin_for_ground_removal_(declare_parameter("z_margin_for_ground_removal", 0.8)),
+  alignment_time_budget_ms_(declare_parameter("alignment_time_budget_ms", 0.0)),
+  sensor_points_baselinkTF_ptr_(new pcl::PointCloud<PointSource>),
+  sensor_points_mapTF_ptr_(new pcl::PointCloud<PointSource>),
+  no_ground_points_mapTF_ptr_(new pcl::PointCloud<PointSource>),
+  output_cloud_(new pcl::PointCloud<PointSource>)
 {
   (*state_ptr_)["state"] = "Initializing";
   is_activated_ = false;
@@ -186,6 +198,11 @@ NDTScanMatcher::NDTScanMatcher()
     this->create_publisher<geometry_msgs::msg::PoseWithCovarianceStamped>(
       "initial_pose_with_covariance", 10);
   exe_time_pub_ = this->create_publisher<tier4_debug_msgs::msg::Float32Stamped>("exe_time_ms", 10);
+  transform_sensor_measurement_time_pub_ =
+    this->create_publisher<tier4_debug_msgs::msg::Float32Stamped>(
+      "transform_sensor_measurement_time_ms", 10);
+  align_time_per_iteration_pub_ = this->create_publisher<tier4_debug_msgs::msg::Float32Stamped>(
+    "align_time_per_iteration_ms", 10);
   transform_probability_pub_ =
     this->create_publisher<tier4_debug_msgs::msg::Float32Stamped>("transform_probability", 10);
   nearest_voxel_transformation_likelihood_pub_ =
@@ -224,12 +241,12 @@ NDTScanMatcher::NDTScanMatcher()
 
   if (this->declare_parameter<bool>("use_dynamic_map_loading")) {
     map_update_module_ = std::make_unique<MapUpdateModule>(
-      this, &ndt_ptr_mtx_, ndt_ptr_, tf2_listener_module_, map_frame_, main_callback_group,
+      this, &ndt_ptr_mtx_, &ndt_ptr_, tf2_listener_module_, map_frame_, main_callback_group,
       state_ptr_);
   } else {
-    map_module_ = std::make_unique<MapModule>(this, &ndt_ptr_mtx_, ndt_ptr_, main_callback_group);
+    map_module_ = std::make_unique<MapModule>(this, &ndt_ptr_mtx_, &ndt_ptr_, main_callback_group);
     pose_init_module_ = std::make_unique<PoseInitializationModule>(
-      this, &ndt_ptr_mtx_, ndt_ptr_, tf2_listener_module_, map_frame_, main_callback_group,
+      this, &ndt_ptr_mtx_, &ndt_ptr_, tf2_listener_module_, map_frame_, main_callback_group,
       state_ptr_);
   }
 }
@@ -267,6 +284,12 @@ void NDTScanMatcher::timer_diagnostic()
       diag_status_msg.level = diagnostic_msgs::msg::DiagnosticStatus::ERROR;
       diag_status_msg.message += "skipping_publish_num exceed limit. ";
     }
+    if (
+      state_ptr_->count("is_time_budget_exceeded") &&
+      std::stoi((*state_ptr_)["is_time_budget_exceeded"])) {
+      diag_status_msg.level = diagnostic_msgs::msg::DiagnosticStatus::WARN;
+      diag_status_msg.message += "alignment stopped by the time budget. ";
+    }
     // Ignore local optimal solution
     if (
       state_ptr_->count("is_local_optimal_solution_oscillation") &&
@@ -335,16 +358,16 @@ void NDTScanMatcher::callback_sensor_points(
   const rclcpp::Time sensor_ros_time = sensor_points_sensorTF_msg_ptr->header.stamp;
 
   // preprocess input pointcloud
-  pcl::shared_ptr<pcl::PointCloud<PointSource>> sensor_points_sensorTF_ptr(
-    new pcl::PointCloud<PointSource>);
-  pcl::shared_ptr<pcl::PointCloud<PointSource>> sensor_points_baselinkTF_ptr(
-    new pcl::PointCloud<PointSource>);
-  const std::string & sensor_frame = sensor_points_sensorTF_msg_ptr->header.frame_id;
-
-  pcl::fromROSMsg(*sensor_points_sensorTF_msg_ptr, *sensor_points_sensorTF_ptr);
   transform_sensor_measurement(
-    sensor_frame, base_frame_, sensor_points_sensorTF_ptr, sensor_points_baselinkTF_ptr);
-  ndt_ptr_->setInputSource(sensor_points_baselinkTF_ptr);
+    *sensor_points_sensorTF_msg_ptr, base_frame_, *sensor_points_baselinkTF_ptr_);
+  ndt_ptr_->setInputSource(sensor_points_baselinkTF_ptr_);
+  const double transform_sensor_measurement_time =
+    std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::system_clock::now() - exe_start_time)
+      .count() /
+    1000.0;
+  transform_sensor_measurement_time_pub_->publish(
+    make_float32_stamped(sensor_ros_time, transform_sensor_measurement_time));
   if (!is_activated_) return;
 
   // calculate initial pose
@@ -372,15 +395,30 @@ void NDTScanMatcher::callback_sensor_points(
   (*state_ptr_)["state"] = "Aligning";
   const Eigen::Matrix4f initial_pose_matrix =
     pose_to_matrix4f(interpolator.get_current_pose().pose.pose);
-  auto output_cloud = std::make_shared<pcl::PointCloud<PointSource>>();
-  ndt_ptr_->align(*output_cloud, initial_pose_matrix);
-  const pclomp::NdtResult ndt_result = ndt_ptr_->getResult();
+  const auto align_start_time = std::chrono::system_clock::now();
+  bool is_time_budget_exceeded = false;
+  pclomp::NdtResult ndt_result;
+  if (alignment_time_budget_ms_ > 0.0) {
+    const double elapsed_time =
+      std::chrono::duration_cast<std::chrono::microseconds>(align_start_time - exe_start_time)
+        .count() /
+      1000.0;
+    ndt_result = align_within_time_budget(
+      initial_pose_matrix, alignment_time_budget_ms_ - elapsed_time, is_time_budget_exceeded);
+  } else {
+    ndt_ptr_->align(*output_cloud_, initial_pose_matrix);
+    ndt_result = ndt_ptr_->getResult();
+  }
   (*state_ptr_)["state"] = "Sleeping";
 
   const auto exe_end_time = std::chrono::system_clock::now();
   const double exe_time =
     std::chrono::duration_cast<std::chrono::microseconds>(exe_end_time - exe_start_time).count() /
     1000.0;
+  const double align_time =
+    std::chrono::duration_cast<std::chrono::microseconds>(exe_end_time - align_start_time)
+      .count() /
+    1000.0;
 
   const geometry_msgs::msg::Pose result_pose_msg = matrix4f_to_pose(ndt_result.pose);
   std::vector<geometry_msgs::msg::Pose> transformation_msg_array;
@@ -428,47 +466,70 @@ void NDTScanMatcher::callback_sensor_points(
   nearest_voxel_transformation_likelihood_pub_->publish(
     make_float32_stamped(sensor_ros_time, ndt_result.nearest_voxel_transformation_likelihood));
   iteration_num_pub_->publish(make_int32_stamped(sensor_ros_time, ndt_result.iteration_num));
+  align_time_per_iteration_pub_->publish(make_float32_stamped(
+    sensor_ros_time, align_time / std::max(ndt_result.iteration_num, 1)));
   publish_tf(sensor_ros_time, result_pose_msg);
   publish_pose(sensor_ros_time, result_pose_msg, is_converged);
-  publish_marker(sensor_ros_time, transformation_msg_array);
+  if (has_subscriber(ndt_marker_pub_)) {
+    publish_marker(sensor_ros_time, transformation_msg_array);
+  }
   publish_initial_to_result_distances(
     sensor_ros_time, result_pose_msg, interpolator.get_current_pose(), interpolator.get_old_pose(),
     interpolator.get_new_pose());
 
-  pcl::shared_ptr<pcl::PointCloud<PointSource>> sensor_points_mapTF_ptr(
-    new pcl::PointCloud<PointSource>);
-  pcl::transformPointCloud(
-    *sensor_points_baselinkTF_ptr, *sensor_points_mapTF_ptr, ndt_result.pose);
-  publish_point_cloud(sensor_ros_time, map_frame_, sensor_points_mapTF_ptr);
+  // The outputs below are only for monitoring, so they are skipped without subscribers.
+  if (has_subscriber(sensor_aligned_pose_pub_)) {
+    pcl::transformPointCloud(
+      *sensor_points_baselinkTF_ptr_, *sensor_points_mapTF_ptr_, ndt_result.pose);
+    publish_point_cloud(sensor_ros_time, map_frame_, sensor_points_mapTF_ptr_);
+  }
 
   // whether use de-grounded points calculate score
-  if (estimate_scores_for_degrounded_scan_) {
-    // remove ground
-    pcl::shared_ptr<pcl::PointCloud<PointSource>> no_ground_points_mapTF_ptr(
-      new pcl::PointCloud<PointSource>);
-    for (std::size_t i = 0; i < sensor_points_mapTF_ptr->size(); i++) {
-      if (
-        sensor_points_mapTF_ptr->points[i].z - matrix4f_to_pose(ndt_result.pose).position.z >
-        z_margin_for_ground_removal_) {
-        no_ground_points_mapTF_ptr->points.push_back(sensor_points_mapTF_ptr->points[i]);
+  const bool has_no_ground_points_subscriber = has_subscriber(no_ground_points_aligned_pose_pub_);
+  const bool has_no_ground_transform_probability_subscriber =
+    has_subscriber(no_ground_transform_probability_pub_);
+  const bool has_no_ground_nearest_voxel_transformation_likelihood_subscriber =
+    has_subscriber(no_ground_nearest_voxel_transformation_likelihood_pub_);
+  if (
+    estimate_scores_for_degrounded_scan_ &&
+    (has_no_ground_points_subscriber || has_no_ground_transform_probability_subscriber ||
+     has_no_ground_nearest_voxel_transformation_likelihood_subscriber)) {
+    // remove ground, transforming only the points above the ground into the map frame
+    const float ground_z = ndt_result.pose(2, 3) + z_margin_for_ground_removal_;
+    const auto & pose = ndt_result.pose;
+    pcl::Indices no_ground_indices;
+    no_ground_indices.reserve(sensor_points_baselinkTF_ptr_->size());
+    for (size_t i = 0; i < sensor_points_baselinkTF_ptr_->size(); ++i) {
+      const auto & point = sensor_points_baselinkTF_ptr_->points[i];
+      const float z =
+        pose(2, 0) * point.x + pose(2, 1) * point.y + pose(2, 2) * point.z + pose(2, 3);
+      if (z > ground_z) {
+        no_ground_indices.push_back(static_cast<pcl::index_t>(i));
       }
     }
+    pcl::transformPointCloud(
+      *sensor_points_baselinkTF_ptr_, no_ground_indices, *no_ground_points_mapTF_ptr_, pose);
     // pub remove-ground points
-    sensor_msgs::msg::PointCloud2 no_ground_points_mapTF_msg;
-    pcl::toROSMsg(*no_ground_points_mapTF_ptr, no_ground_points_mapTF_msg);
-    no_ground_points_mapTF_msg.header.stamp = sensor_ros_time;
-    no_ground_points_mapTF_msg.header.frame_id = map_frame_;
-    no_ground_points_aligned_pose_pub_->publish(no_ground_points_mapTF_msg);
-    // calculate score
-    const float no_ground_transform_probability =
-      ndt_ptr_->calculateTransformationProbability(*no_ground_points_mapTF_ptr);
-    const float no_ground_nearest_voxel_transformation_likelihood =
-      ndt_ptr_->calculateNearestVoxelTransformationLikelihood(*no_ground_points_mapTF_ptr);
-    // pub score
-    no_ground_transform_probability_pub_->publish(
-      make_float32_stamped(sensor_ros_time, no_ground_transform_probability));
-    no_ground_nearest_voxel_transformation_likelihood_pub_->publish(
-      make_float32_stamped(sensor_ros_time, no_ground_nearest_voxel_transformation_likelihood));
+    if (has_no_ground_points_subscriber) {
+      sensor_msgs::msg::PointCloud2 no_ground_points_mapTF_msg;
+      pcl::toROSMsg(*no_ground_points_mapTF_ptr_, no_ground_points_mapTF_msg);
+      no_ground_points_mapTF_msg.header.stamp = sensor_ros_time;
+      no_ground_points_mapTF_msg.header.frame_id = map_frame_;
+      no_ground_points_aligned_pose_pub_->publish(no_ground_points_mapTF_msg);
+    }
+    // calculate and pub score
+    if (has_no_ground_transform_probability_subscriber) {
+      const float no_ground_transform_probability =
+        ndt_ptr_->calculateTransformationProbability(*no_ground_points_mapTF_ptr_);
+      no_ground_transform_probability_pub_->publish(
+        make_float32_stamped(sensor_ros_time, no_ground_transform_probability));
+    }
+    if (has_no_ground_nearest_voxel_transformation_likelihood_subscriber) {
+      const float no_ground_nearest_voxel_transformation_likelihood =
+        ndt_ptr_->calculateNearestVoxelTransformationLikelihood(*no_ground_points_mapTF_ptr_);
+      no_ground_nearest_voxel_transformation_likelihood_pub_->publish(
+        make_float32_stamped(sensor_ros_time, no_ground_nearest_voxel_transformation_likelihood));
+    }
   }
 
   (*state_ptr_)["transform_probability"] = std::to_string(ndt_result.transform_probability);
@@ -476,6 +537,7 @@ void NDTScanMatcher::callback_sensor_points(
     std::to_string(ndt_result.nearest_voxel_transformation_likelihood);
   (*state_ptr_)["iteration_num"] = std::to_string(ndt_result.iteration_num);
   (*state_ptr_)["skipping_publish_num"] = std::to_string(skipping_publish_num);
+  (*state_ptr_)["is_time_budget_exceeded"] = is_time_budget_exceeded ? "1" : "0";
   if (is_local_optimal_solution_oscillation) {
     (*state_ptr_)["is_local_optimal_solution_oscillation"] = "1";
   } else {
@@ -483,20 +545,88 @@ void NDTScanMatcher::callback_sensor_points(
   }
 }
 
+pclomp::NdtResult NDTScanMatcher::align_within_time_budget(
+  const Eigen::Matrix4f & initial_pose_matrix, const double time_budget_ms,
+  bool & is_time_budget_exceeded)
+{
+  // ndt_omp cannot be interrupted, so the optimization is run one iteration at a time and stopped
+  // when the next iteration is predicted to end after the budget
+  const auto start_time = std::chrono::system_clock::now();
+  const int max_iterations = ndt_ptr_->getMaximumIterations();
+  const double trans_epsilon = ndt_ptr_->getParams().trans_epsilon;
+  ndt_ptr_->setMaximumIterations(1);
+
+  pclomp::NdtResult result;
+  std::vector<Eigen::Matrix4f> transformation_array;
+  int iteration_num = 0;
+  Eigen::Matrix4f guess = initial_pose_matrix;
+  double max_step_time = 0.0;
+  is_time_budget_exceeded = false;
+  while (iteration_num < max_iterations) {
+    const auto step_start_time = std::chrono::system_clock::now();
+    ndt_ptr_->align(*output_cloud_, guess);
+    result = ndt_ptr_->getResult();
+    const auto step_end_time = std::chrono::system_clock::now();
+
+    transformation_array.insert(
+      transformation_array.end(), result.transformation_array.begin(),
+      result.transformation_array.end());
+    iteration_num += std::max(result.iteration_num, 1);
+
+    const float translation_delta =
+      (result.pose.block<3, 1>(0, 3) - guess.block<3, 1>(0, 3)).norm();
+    if (translation_delta < trans_epsilon) break;
+    guess = result.pose;
+
+    const double step_time =
+      std::chrono::duration_cast<std::chrono::microseconds>(step_end_time - step_start_time)
+        .count() /
+      1000.0;
+    const double elapsed_time =
+      std::chrono::duration_cast<std::chrono::microseconds>(step_end_time - start_time).count() /
+      1000.0;
+    max_step_time = std::max(max_step_time, step_time);
+    if (elapsed_time + max_step_time > time_budget_ms) {
+      is_time_budget_exceeded = iteration_num < max_iterations;
+      break;
+    }
+  }
+  ndt_ptr_->setMaximumIterations(max_iterations);
+
+  result.transformation_array = transformation_array;
+  result.iteration_num = iteration_num;
+  return result;
+}
+
 void NDTScanMatcher::transform_sensor_measurement(
-  const std::string source_frame, const std::string target_frame,
-  const pcl::shared_ptr<pcl::PointCloud<PointSource>> sensor_points_input_ptr,
-  pcl::shared_ptr<pcl::PointCloud<PointSource>> sensor_points_output_ptr)
+  const sensor_msgs::msg::PointCloud2 & sensor_points_input_msg, const std::string & target_frame,
+  pcl::PointCloud<PointSource> & sensor_points_output)
 {
   auto TF_target_to_source_ptr = std::make_shared<geometry_msgs::msg::TransformStamped>();
   tf2_listener_module_->get_transform(
-    this->now(), target_frame, source_frame, TF_target_to_source_ptr);
+    this->now(), target_frame, sensor_points_input_msg.header.frame_id, TF_target_to_source_ptr);
   const geometry_msgs::msg::PoseStamped target_to_source_pose_stamped =
     tier4_autoware_utils::transform2pose(*TF_target_to_source_ptr);
-  const Eigen::Matrix4f base_to_sensor_matrix =
-    pose_to_matrix4f(target_to_source_pose_stamped.pose);
-  pcl::transformPointCloud(
-    *sensor_points_input_ptr, *sensor_points_output_ptr, base_to_sensor_matrix);
+  const Eigen::Affine3f base_to_sensor_affine(pose_to_matrix4f(target_to_source_pose_stamped.pose));
+
+  // convert and transform in one pass, the output keeps its capacity between calls
+  sensor_points_output.points.resize(
+    sensor_points_input_msg.width * sensor_points_input_msg.height);
+  auto output_it = sensor_points_output.points.begin();
+  for (sensor_msgs::PointCloud2ConstIterator<float> x_it(sensor_points_input_msg, "x"),
+       y_it(sensor_points_input_msg, "y"), z_it(sensor_points_input_msg, "z");
+       x_it != x_it.end(); ++x_it, ++y_it, ++z_it, ++output_it) {
+    const Eigen::Vector3f point(*x_it, *y_it, *z_it);
+    if (point.allFinite()) {
+      output_it->getVector3fMap() = base_to_sensor_affine * point;
+    } else {
+      output_it->getVector3fMap() = point;
+    }
+  }
+  pcl_conversions::toPCL(sensor_points_input_msg.header, sensor_points_output.header);
+  sensor_points_output.width = sensor_points_output.points.size();
+  sensor_points_output.height = 1;
+  sensor_points_output.is_dense = sensor_points_input_msg.is_dense;
 }
 
 void NDTScanMatcher::publish_tf(
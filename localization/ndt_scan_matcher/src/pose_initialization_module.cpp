@@ -16,11 +16,11 @@
 
 PoseInitializationModule::PoseInitializationModule(
   rclcpp::Node * node, std::mutex * ndt_ptr_mutex,
-  std::shared_ptr<NormalDistributionsTransform> ndt_ptr,
+  std::shared_ptr<NormalDistributionsTransform> * ndt_ptr_ptr,
   std::shared_ptr<Tf2ListenerModule> tf2_listener_module, std::string map_frame,
   rclcpp::CallbackGroup::SharedPtr main_callback_group,
   std::shared_ptr<std::map<std::string, std::string>> state_ptr)
-: ndt_ptr_(ndt_ptr),
+: ndt_ptr_ptr_(ndt_ptr_ptr),
   ndt_ptr_mutex_(ndt_ptr_mutex),
   map_frame_(map_frame),
   logger_(node->get_logger()),
@@ -57,13 +57,14 @@ void PoseInitializationModule::service_ndt_align(
   // transform pose_frame to map_frame
   const auto mapTF_initial_pose_msg = transform(req->pose_with_covariance, *TF_pose_to_map_ptr);
 
-  if (ndt_ptr_->getInputTarget() == nullptr) {
+  const auto ndt_ptr = std::atomic_load(ndt_ptr_ptr_);
+  if (ndt_ptr->getInputTarget() == nullptr) {
     res->success = false;
     RCLCPP_WARN(logger_, "No InputTarget");
     return;
   }
 
-  if (ndt_ptr_->getInputSource() == nullptr) {
+  if (ndt_ptr->getInputSource() == nullptr) {
     res->success = false;
     RCLCPP_WARN(logger_, "No InputSource");
     return;
@@ -73,7 +74,7 @@ void PoseInitializationModule::service_ndt_align(
   std::lock_guard<std::mutex> lock(*ndt_ptr_mutex_);
 
   (*state_ptr_)["state"] = "Aligning";
-  res->pose_with_covariance = align_using_monte_carlo(ndt_ptr_, mapTF_initial_pose_msg);
+  res->pose_with_covariance = align_using_monte_carlo(*ndt_ptr_ptr_, mapTF_initial_pose_msg);
   (*state_ptr_)["state"] = "Sleeping";
   res->success = true;
   res->pose_with_covariance.pose.covariance = req->pose_with_covariance.pose.covariance;
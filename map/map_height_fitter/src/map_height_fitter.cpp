@@ -23,9 +23,205 @@
 #include <pcl_conversions/pcl_conversions.h>
 #include <tf2_ros/transform_listener.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 namespace map_height_fitter
 {
 
+// XY grid of the map points to search them around the position instead of scanning the whole map.
+class GridIndex
+{
+public:
+  static constexpr double cell_size = 2.0;
+
+  explicit GridIndex(const pcl::PointCloud<pcl::PointXYZ> & cloud) : cloud_(cloud)
+  {
+    // sort the point indices by cell so that the points of a cell are contiguous
+    std::vector<std::pair<int64_t, uint32_t>> keys;
+    keys.reserve(cloud.size());
+    for (size_t i = 0; i < cloud.size(); ++i) {
+      const auto & p = cloud.points[i];
+      if (std::isfinite(p.x) && std::isfinite(p.y)) {
+        const int64_t ix = to_cell(p.x);
+        const int64_t iy = to_cell(p.y);
+        keys.emplace_back(to_key(ix, iy), static_cast<uint32_t>(i));
+        min_cell_x_ = std::min(min_cell_x_, ix);
+        max_cell_x_ = std::max(max_cell_x_, ix);
+        min_cell_y_ = std::min(min_cell_y_, iy);
+        max_cell_y_ = std::max(max_cell_y_, iy);
+      }
+    }
+    std::sort(keys.begin(), keys.end());
+
+    indices_.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (i == 0 || keys[i].first != keys[i - 1].first) {
+        cells_.emplace(keys[i].first, std::make_pair(i, keys.size()));
+        if (i != 0) {
+          cells_.at(keys[i - 1].first).second = i;
+        }
+      }
+      indices_.push_back(keys[i].second);
+    }
+  }
+
+  // minimum squared XY distance to the points, the same as scanning all the points
+  double find_min_dist2(const double x, const double y) const
+  {
+    const int64_t cx = to_cell(x);
+    const int64_t cy = to_cell(y);
+    double min_dist2 = INFINITY;
+
+    if (cells_.empty()) {
+      return min_dist2;
+    }
+
+    // the rings closer than the bounding box of the cells are empty
+    const int64_t first_ring = std::max(
+      {int64_t{0}, min_cell_x_ - cx, cx - max_cell_x_, min_cell_y_ - cy, cy - max_cell_y_});
+
+    // Scanning all the points is cheaper than looking up more cells than the occupied ones, e.g.
+    // when the position is far from the map.
+    size_t num_lookups = 0;
+    const auto visit = [&](const int64_t ix, const int64_t iy) {
+      ++num_lookups;
+      for_each_point_in_cell(ix, iy, [&](const uint32_t index) {
+        min_dist2 = std::min(min_dist2, dist2(x, y, index));
+      });
+    };
+
+    for (int64_t ring = first_ring;; ++ring) {
+      // visit the sides of the ring clipped by the bounding box
+      const int64_t min_ix = std::max(cx - ring, min_cell_x_);
+      const int64_t max_ix = std::min(cx + ring, max_cell_x_);
+      const int64_t min_iy = std::max(cy - ring + 1, min_cell_y_);
+      const int64_t max_iy = std::min(cy + ring - 1, max_cell_y_);
+      for (int64_t ix = min_ix; ix <= max_ix; ++ix) {
+        if (min_cell_y_ <= cy - ring) {
+          visit(ix, cy - ring);
+        }
+        if (ring != 0 && cy + ring <= max_cell_y_) {
+          visit(ix, cy + ring);
+        }
+      }
+      for (int64_t iy = min_iy; iy <= max_iy; ++iy) {
+        if (min_cell_x_ <= cx - ring) {
+          visit(cx - ring, iy);
+        }
+        if (cx + ring <= max_cell_x_) {
+          visit(cx + ring, iy);
+        }
+      }
+      if (num_lookups > cells_.size()) {
+        return scan_min_dist2(x, y);
+      }
+
+      // the cells out of this ring are farther than ring * cell_size
+      const double bound = static_cast<double>(ring) * cell_size;
+      if (min_dist2 <= bound * bound) {
+        return min_dist2;
+      }
+
+      // all the cells are visited
+      if (
+        cx - ring <= min_cell_x_ && max_cell_x_ <= cx + ring && cy - ring <= min_cell_y_ &&
+        max_cell_y_ <= cy + ring) {
+        return min_dist2;
+      }
+    }
+  }
+
+  // lowest height of the points strictly within the XY radius
+  double find_min_height(const double x, const double y, const double radius2) const
+  {
+    double height = INFINITY;
+    const auto update_height = [&](const uint32_t index) {
+      if (dist2(x, y, index) < radius2) {
+        height = std::min(height, static_cast<double>(cloud_.points[index].z));
+      }
+    };
+
+    const double radius = std::sqrt(radius2);
+    const int64_t min_ix = to_cell(x - radius);
+    const int64_t max_ix = to_cell(x + radius);
+    const int64_t min_iy = to_cell(y - radius);
+    const int64_t max_iy = to_cell(y + radius);
+
+    // scan all the points when the radius covers more cells than the occupied ones
+    if (static_cast<double>(max_ix - min_ix + 1) * (max_iy - min_iy + 1) > cells_.size()) {
+      for (const auto & p : cloud_.points) {
+        const double dx = x - p.x;
+        const double dy = y - p.y;
+        if ((dx * dx) + (dy * dy) < radius2) {
+          height = std::min(height, static_cast<double>(p.z));
+        }
+      }
+      return height;
+    }
+
+    for (int64_t ix = std::max(min_ix, min_cell_x_); ix <= std::min(max_ix, max_cell_x_); ++ix) {
+      for (int64_t iy = std::max(min_iy, min_cell_y_); iy <= std::min(max_iy, max_cell_y_); ++iy) {
+        for_each_point_in_cell(ix, iy, update_height);
+      }
+    }
+    return height;
+  }
+
+private:
+  static int64_t to_cell(const double v) { return static_cast<int64_t>(std::floor(v / cell_size)); }
+
+  static int64_t to_key(const int64_t ix, const int64_t iy)
+  {
+    return (ix << 32) ^ (iy & 0xffffffff);
+  }
+
+  double scan_min_dist2(const double x, const double y) const
+  {
+    double min_dist2 = INFINITY;
+    for (const auto & p : cloud_.points) {
+      const double dx = x - p.x;
+      const double dy = y - p.y;
+      min_dist2 = std::min(min_dist2, (dx * dx) + (dy * dy));
+    }
+    return min_dist2;
+  }
+
+  double dist2(const double x, const double y, const uint32_t index) const
+  {
+    const auto & p = cloud_.points[index];
+    const double dx = x - p.x;
+    const double dy = y - p.y;
+    return (dx * dx) + (dy * dy);
+  }
+
+  template <class Function>
+  void for_each_point_in_cell(const int64_t ix, const int64_t iy, const Function & function) const
+  {
+    const auto cell = cells_.find(to_key(ix, iy));
+    if (cell == cells_.end()) {
+      return;
+    }
+    for (size_t i = cell->second.first; i < cell->second.second; ++i) {
+      function(indices_[i]);
+    }
+  }
+
+  const pcl::PointCloud<pcl::PointXYZ> & cloud_;
+  std::vector<uint32_t> indices_;                                    // point indices sorted by cell
+  std::unordered_map<int64_t, std::pair<size_t, size_t>> cells_;  // range of the cell in indices_
+  int64_t min_cell_x_ = std::numeric_limits<int64_t>::max();
+  int64_t max_cell_x_ = std::numeric_limits<int64_t>::min();
+  int64_t min_cell_y_ = std::numeric_limits<int64_t>::max();
+  int64_t max_cell_y_ = std::numeric_limits<int64_t>::min();
+};
+
 struct MapHeightFitter::Impl
 {
   static constexpr char enable_partial_load[] = "enable_partial_load";
@@ -33,6 +229,7 @@ struct MapHeightFitter::Impl
   explicit Impl(rclcpp::Node * node);
   void on_map(const sensor_msgs::msg::PointCloud2::ConstSharedPtr msg);
   void get_partial_point_cloud_map(const Point & point);
+  void set_map_cloud(const sensor_msgs::msg::PointCloud2 & msg);
   double get_ground_height(const tf2::Vector3 & point) const;
   Point fit(const Point & position, const std::string & frame);
 
@@ -40,6 +237,7 @@ struct MapHeightFitter::Impl
   tf2_ros::TransformListener tf2_listener_;
   std::string map_frame_;
   pcl::PointCloud<pcl::PointXYZ>::Ptr map_cloud_;
+  std::unique_ptr<GridIndex> map_grid_;
   rclcpp::Node * node_;
 
   rclcpp::CallbackGroup::SharedPtr group_;
@@ -79,8 +277,15 @@ MapHeightFitter::Impl::Impl(rclcpp::Node * node) : tf2_listener_(tf2_buffer_), n
 void MapHeightFitter::Impl::on_map(const sensor_msgs::msg::PointCloud2::ConstSharedPtr msg)
 {
   map_frame_ = msg->header.frame_id;
+  set_map_cloud(*msg);
+}
+
+void MapHeightFitter::Impl::set_map_cloud(const sensor_msgs::msg::PointCloud2 & msg)
+{
+  map_grid_.reset();
   map_cloud_ = pcl::PointCloud<pcl::PointXYZ>::Ptr(new pcl::PointCloud<pcl::PointXYZ>);
-  pcl::fromROSMsg(*msg, *map_cloud_);
+  pcl::fromROSMsg(msg, *map_cloud_);
+  map_grid_ = std::make_unique<GridIndex>(*map_cloud_);
 }
 
 void MapHeightFitter::Impl::get_partial_point_cloud_map(const Point & point)
@@ -128,8 +333,7 @@ void MapHeightFitter::Impl::get_partial_point_cloud_map(const Point & point)
     }
   }
   map_frame_ = res->header.frame_id;
-  map_cloud_ = pcl::PointCloud<pcl::PointXYZ>::Ptr(new pcl::PointCloud<pcl::PointXYZ>);
-  pcl::fromROSMsg(pcd_msg, *map_cloud_);
+  set_map_cloud(pcd_msg);
 }
 
 double MapHeightFitter::Impl::get_ground_height(const tf2::Vector3 & point) const
@@ -138,25 +342,12 @@ double MapHeightFitter::Impl::get_ground_height(const tf2::Vector3 & point) cons
   const double y = point.getY();
 
   // find distance d to closest point
-  double min_dist2 = INFINITY;
-  for (const auto & p : map_cloud_->points) {
-    const double dx = x - p.x;
-    const double dy = y - p.y;
-    const double sd = (dx * dx) + (dy * dy);
-    min_dist2 = std::min(min_dist2, sd);
-  }
+  const double min_dist2 = map_grid_->find_min_dist2(x, y);
 
   // find lowest height within radius (d+1.0)
   const double radius2 = std::pow(std::sqrt(min_dist2) + 1.0, 2.0);
-  double height = INFINITY;
-  for (const auto & p : map_cloud_->points) {
-    const double dx = x - p.x;
-    const double dy = y - p.y;
-    const double sd = (dx * dx) + (dy * dy);
-    if (sd < radius2) {
-      height = std::min(height, static_cast<double>(p.z));
-    }
-  }
+  const double height =
+    std::isfinite(radius2) ? map_grid_->find_min_height(x, y, radius2) : INFINITY;
 
   return std::isfinite(height) ? height : point.getZ();
 }
@@ -170,6 +361,7 @@ Point MapHeightFitter::Impl::fit(const Point & position, const std::string & fra
 
   if (cli_map_) {
     map_cloud_.reset();
+    map_grid_.reset();
     get_partial_point_cloud_map(position);
   }
 
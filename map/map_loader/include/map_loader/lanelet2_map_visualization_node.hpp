@@ -15,14 +15,40 @@
 #ifndef MAP_LOADER__LANELET2_MAP_VISUALIZATION_NODE_HPP_
 #define MAP_LOADER__LANELET2_MAP_VISUALIZATION_NODE_HPP_
 
+#include <lanelet2_extension/utility/query.hpp>
 #include <rclcpp/rclcpp.hpp>
 
 #include <autoware_auto_mapping_msgs/msg/had_map_bin.hpp>
+#include <nav_msgs/msg/odometry.hpp>
 #include <visualization_msgs/msg/marker_array.hpp>
 
+#include <cstdint>
+#include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+// primitives drawn on the map, either of the whole map or of a tile
+struct MapPrimitives
+{
+  lanelet::ConstLanelets road_lanelets;
+  lanelet::ConstLanelets shoulder_lanelets;
+  lanelet::ConstLanelets crosswalk_lanelets;
+  lanelet::ConstLanelets walkway_lanelets;
+  std::vector<lanelet::ConstLineString3d> stop_lines;
+  lanelet::ConstLineStrings3d partitions;
+  lanelet::ConstLineStrings3d pedestrian_markings;
+  lanelet::ConstLineStrings3d parking_spaces;
+  std::vector<lanelet::AutowareTrafficLightConstPtr> aw_tl_reg_elems;
+  std::vector<lanelet::DetectionAreaConstPtr> da_reg_elems;
+  std::vector<lanelet::NoStoppingAreaConstPtr> no_reg_elems;
+  std::vector<lanelet::SpeedBumpConstPtr> sb_reg_elems;
+  lanelet::ConstPolygons3d parking_lots;
+  lanelet::ConstPolygons3d obstacle_polygons;
+  lanelet::ConstPolygons3d no_obstacle_segmentation_area;
+  lanelet::ConstPolygons3d no_obstacle_segmentation_area_for_run_out;
+};
+
 class Lanelet2MapVisualizationNode : public rclcpp::Node
 {
 public:
@@ -30,11 +56,23 @@ public:
 
 private:
   rclcpp::Subscription<autoware_auto_mapping_msgs::msg::HADMapBin>::SharedPtr sub_map_bin_;
+  rclcpp::Subscription<nav_msgs::msg::Odometry>::SharedPtr sub_kinematic_state_;
   rclcpp::Publisher<visualization_msgs::msg::MarkerArray>::SharedPtr pub_marker_;
 
   bool viz_lanelets_centerline_;
 
+  // tiled visualization, which publishes only the tiles around ego
+  bool enable_tiled_visualization_;
+  double tile_size_;
+  double visible_radius_;
+  std::unordered_map<uint64_t, MapPrimitives> tiles_;
+  std::map<uint64_t, visualization_msgs::msg::MarkerArray> visible_tile_markers_;
+  bool is_visible_tiles_outdated_{true};
+  uint64_t ego_tile_key_{0};
+
   void onMapBin(const autoware_auto_mapping_msgs::msg::HADMapBin::ConstSharedPtr msg);
+  void onKinematicState(const nav_msgs::msg::Odometry::ConstSharedPtr msg);
+  void createTiles(const lanelet::LaneletMapPtr & viz_lanelet_map);
 };
 
 #endif  // MAP_LOADER__LANELET2_MAP_VISUALIZATION_NODE_HPP_
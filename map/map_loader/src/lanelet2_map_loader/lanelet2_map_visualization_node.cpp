@@ -46,7 +46,12 @@
 #include <lanelet2_core/LaneletMap.h>
 #include <lanelet2_projection/UTM.h>
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
+#include <string>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace
@@ -64,64 +69,38 @@ void setColor(std_msgs::msg::ColorRGBA * cl, double r, double g, double b, doubl
   cl->b = b;
   cl->a = a;
 }
-}  // namespace
-
-Lanelet2MapVisualizationNode::Lanelet2MapVisualizationNode(const rclcpp::NodeOptions & options)
-: Node("lanelet2_map_visualization", options)
-{
-  using std::placeholders::_1;
-
-  viz_lanelets_centerline_ = this->declare_parameter("viz_lanelets_centerline", true);
-
-  sub_map_bin_ = this->create_subscription<autoware_auto_mapping_msgs::msg::HADMapBin>(
-    "input/lanelet2_map", rclcpp::QoS{1}.transient_local(),
-    std::bind(&Lanelet2MapVisualizationNode::onMapBin, this, _1));
-
-  pub_marker_ = this->create_publisher<visualization_msgs::msg::MarkerArray>(
-    "output/lanelet2_map_marker", rclcpp::QoS{1}.transient_local());
-}
 
-void Lanelet2MapVisualizationNode::onMapBin(
-  const autoware_auto_mapping_msgs::msg::HADMapBin::ConstSharedPtr msg)
+MapPrimitives queryMapPrimitives(const lanelet::LaneletMapPtr & viz_lanelet_map)
 {
-  lanelet::LaneletMapPtr viz_lanelet_map(new lanelet::LaneletMap);
-
-  lanelet::utils::conversion::fromBinMsg(*msg, viz_lanelet_map);
-  RCLCPP_INFO(this->get_logger(), "Map is loaded\n");
+  MapPrimitives p;
 
   // get lanelets etc to visualize
   lanelet::ConstLanelets all_lanelets = lanelet::utils::query::laneletLayer(viz_lanelet_map);
-  lanelet::ConstLanelets road_lanelets = lanelet::utils::query::roadLanelets(all_lanelets);
-  lanelet::ConstLanelets shoulder_lanelets = lanelet::utils::query::shoulderLanelets(all_lanelets);
-  lanelet::ConstLanelets crosswalk_lanelets =
-    lanelet::utils::query::crosswalkLanelets(all_lanelets);
-  lanelet::ConstLineStrings3d partitions = lanelet::utils::query::getAllPartitions(viz_lanelet_map);
-  lanelet::ConstLineStrings3d pedestrian_markings =
-    lanelet::utils::query::getAllPedestrianMarkings(viz_lanelet_map);
-  lanelet::ConstLanelets walkway_lanelets = lanelet::utils::query::walkwayLanelets(all_lanelets);
-  std::vector<lanelet::ConstLineString3d> stop_lines =
-    lanelet::utils::query::stopLinesLanelets(road_lanelets);
-  std::vector<lanelet::TrafficLightConstPtr> tl_reg_elems =
-    lanelet::utils::query::trafficLights(all_lanelets);
-  std::vector<lanelet::AutowareTrafficLightConstPtr> aw_tl_reg_elems =
-    lanelet::utils::query::autowareTrafficLights(all_lanelets);
-  std::vector<lanelet::DetectionAreaConstPtr> da_reg_elems =
-    lanelet::utils::query::detectionAreas(all_lanelets);
-  std::vector<lanelet::NoStoppingAreaConstPtr> no_reg_elems =
-    lanelet::utils::query::noStoppingAreas(all_lanelets);
-  std::vector<lanelet::SpeedBumpConstPtr> sb_reg_elems =
-    lanelet::utils::query::speedBumps(all_lanelets);
-  lanelet::ConstLineStrings3d parking_spaces =
-    lanelet::utils::query::getAllParkingSpaces(viz_lanelet_map);
-  lanelet::ConstPolygons3d parking_lots = lanelet::utils::query::getAllParkingLots(viz_lanelet_map);
-  lanelet::ConstPolygons3d obstacle_polygons =
-    lanelet::utils::query::getAllObstaclePolygons(viz_lanelet_map);
-  lanelet::ConstPolygons3d no_obstacle_segmentation_area =
+  p.road_lanelets = lanelet::utils::query::roadLanelets(all_lanelets);
+  p.shoulder_lanelets = lanelet::utils::query::shoulderLanelets(all_lanelets);
+  p.crosswalk_lanelets = lanelet::utils::query::crosswalkLanelets(all_lanelets);
+  p.partitions = lanelet::utils::query::getAllPartitions(viz_lanelet_map);
+  p.pedestrian_markings = lanelet::utils::query::getAllPedestrianMarkings(viz_lanelet_map);
+  p.walkway_lanelets = lanelet::utils::query::walkwayLanelets(all_lanelets);
+  p.stop_lines = lanelet::utils::query::stopLinesLanelets(p.road_lanelets);
+  p.aw_tl_reg_elems = lanelet::utils::query::autowareTrafficLights(all_lanelets);
+  p.da_reg_elems = lanelet::utils::query::detectionAreas(all_lanelets);
+  p.no_reg_elems = lanelet::utils::query::noStoppingAreas(all_lanelets);
+  p.sb_reg_elems = lanelet::utils::query::speedBumps(all_lanelets);
+  p.parking_spaces = lanelet::utils::query::getAllParkingSpaces(viz_lanelet_map);
+  p.parking_lots = lanelet::utils::query::getAllParkingLots(viz_lanelet_map);
+  p.obstacle_polygons = lanelet::utils::query::getAllObstaclePolygons(viz_lanelet_map);
+  p.no_obstacle_segmentation_area =
     lanelet::utils::query::getAllPolygonsByType(viz_lanelet_map, "no_obstacle_segmentation_area");
-  lanelet::ConstPolygons3d no_obstacle_segmentation_area_for_run_out =
-    lanelet::utils::query::getAllPolygonsByType(
-      viz_lanelet_map, "no_obstacle_segmentation_area_for_run_out");
+  p.no_obstacle_segmentation_area_for_run_out = lanelet::utils::query::getAllPolygonsByType(
+    viz_lanelet_map, "no_obstacle_segmentation_area_for_run_out");
+
+  return p;
+}
 
+visualization_msgs::msg::MarkerArray createMapMarkerArray(
+  const MapPrimitives & p, const bool viz_lanelets_centerline)
+{
   std_msgs::msg::ColorRGBA cl_road, cl_shoulder, cl_cross, cl_partitions, cl_pedestrian_markings,
     cl_ll_borders, cl_shoulder_borders, cl_stoplines, cl_trafficlights, cl_detection_areas,
     cl_speed_bumps, cl_parking_lots, cl_parking_spaces, cl_lanelet_id, cl_obstacle_polygons,
@@ -149,76 +128,290 @@ void Lanelet2MapVisualizationNode::onMapBin(
   visualization_msgs::msg::MarkerArray map_marker_array;
 
   insertMarkerArray(
-    &map_marker_array,
-    lanelet::visualization::lineStringsAsMarkerArray(stop_lines, "stop_lines", cl_stoplines, 0.5));
+    &map_marker_array, lanelet::visualization::lineStringsAsMarkerArray(
+                         p.stop_lines, "stop_lines", cl_stoplines, 0.5));
   insertMarkerArray(
-    &map_marker_array,
-    lanelet::visualization::lineStringsAsMarkerArray(partitions, "partitions", cl_partitions, 0.1));
+    &map_marker_array, lanelet::visualization::lineStringsAsMarkerArray(
+                         p.partitions, "partitions", cl_partitions, 0.1));
   insertMarkerArray(
     &map_marker_array,
-    lanelet::visualization::laneletDirectionAsMarkerArray(shoulder_lanelets, "shoulder_"));
+    lanelet::visualization::laneletDirectionAsMarkerArray(p.shoulder_lanelets, "shoulder_"));
   insertMarkerArray(
-    &map_marker_array, lanelet::visualization::laneletDirectionAsMarkerArray(road_lanelets));
+    &map_marker_array, lanelet::visualization::laneletDirectionAsMarkerArray(p.road_lanelets));
   insertMarkerArray(
     &map_marker_array, lanelet::visualization::laneletsAsTriangleMarkerArray(
-                         "crosswalk_lanelets", crosswalk_lanelets, cl_cross));
+                         "crosswalk_lanelets", p.crosswalk_lanelets, cl_cross));
   insertMarkerArray(
     &map_marker_array, lanelet::visualization::pedestrianMarkingsAsMarkerArray(
-                         pedestrian_markings, cl_pedestrian_markings));
+                         p.pedestrian_markings, cl_pedestrian_markings));
   insertMarkerArray(
     &map_marker_array, lanelet::visualization::laneletsAsTriangleMarkerArray(
-                         "walkway_lanelets", walkway_lanelets, cl_cross));
+                         "walkway_lanelets", p.walkway_lanelets, cl_cross));
   insertMarkerArray(
-    &map_marker_array,
-    lanelet::visualization::obstaclePolygonsAsMarkerArray(obstacle_polygons, cl_obstacle_polygons));
+    &map_marker_array, lanelet::visualization::obstaclePolygonsAsMarkerArray(
+                         p.obstacle_polygons, cl_obstacle_polygons));
   insertMarkerArray(
     &map_marker_array,
-    lanelet::visualization::detectionAreasAsMarkerArray(da_reg_elems, cl_detection_areas));
+    lanelet::visualization::detectionAreasAsMarkerArray(p.da_reg_elems, cl_detection_areas));
   insertMarkerArray(
     &map_marker_array,
-    lanelet::visualization::noStoppingAreasAsMarkerArray(no_reg_elems, cl_no_stopping_areas));
+    lanelet::visualization::noStoppingAreasAsMarkerArray(p.no_reg_elems, cl_no_stopping_areas));
   insertMarkerArray(
     &map_marker_array,
-    lanelet::visualization::speedBumpsAsMarkerArray(sb_reg_elems, cl_speed_bumps));
+    lanelet::visualization::speedBumpsAsMarkerArray(p.sb_reg_elems, cl_speed_bumps));
   insertMarkerArray(
     &map_marker_array,
-    lanelet::visualization::parkingLotsAsMarkerArray(parking_lots, cl_parking_lots));
+    lanelet::visualization::parkingLotsAsMarkerArray(p.parking_lots, cl_parking_lots));
   insertMarkerArray(
     &map_marker_array,
-    lanelet::visualization::parkingSpacesAsMarkerArray(parking_spaces, cl_parking_spaces));
+    lanelet::visualization::parkingSpacesAsMarkerArray(p.parking_spaces, cl_parking_spaces));
   insertMarkerArray(
     &map_marker_array,
     lanelet::visualization::laneletsBoundaryAsMarkerArray(
-      shoulder_lanelets, cl_shoulder_borders, viz_lanelets_centerline_, "shoulder_"));
+      p.shoulder_lanelets, cl_shoulder_borders, viz_lanelets_centerline, "shoulder_"));
   insertMarkerArray(
     &map_marker_array, lanelet::visualization::laneletsBoundaryAsMarkerArray(
-                         road_lanelets, cl_ll_borders, viz_lanelets_centerline_));
+                         p.road_lanelets, cl_ll_borders, viz_lanelets_centerline));
   insertMarkerArray(
-    &map_marker_array,
-    lanelet::visualization::autowareTrafficLightsAsMarkerArray(aw_tl_reg_elems, cl_trafficlights));
+    &map_marker_array, lanelet::visualization::autowareTrafficLightsAsMarkerArray(
+                         p.aw_tl_reg_elems, cl_trafficlights));
   insertMarkerArray(
     &map_marker_array,
-    lanelet::visualization::generateTrafficLightIdMaker(aw_tl_reg_elems, cl_trafficlights));
+    lanelet::visualization::generateTrafficLightIdMaker(p.aw_tl_reg_elems, cl_trafficlights));
   insertMarkerArray(
     &map_marker_array,
-    lanelet::visualization::generateLaneletIdMarker(shoulder_lanelets, cl_lanelet_id));
+    lanelet::visualization::generateLaneletIdMarker(p.shoulder_lanelets, cl_lanelet_id));
   insertMarkerArray(
     &map_marker_array,
-    lanelet::visualization::generateLaneletIdMarker(road_lanelets, cl_lanelet_id));
+    lanelet::visualization::generateLaneletIdMarker(p.road_lanelets, cl_lanelet_id));
   insertMarkerArray(
     &map_marker_array, lanelet::visualization::laneletsAsTriangleMarkerArray(
-                         "shoulder_road_lanelets", shoulder_lanelets, cl_shoulder));
+                         "shoulder_road_lanelets", p.shoulder_lanelets, cl_shoulder));
   insertMarkerArray(
-    &map_marker_array,
-    lanelet::visualization::laneletsAsTriangleMarkerArray("road_lanelets", road_lanelets, cl_road));
+    &map_marker_array, lanelet::visualization::laneletsAsTriangleMarkerArray(
+                         "road_lanelets", p.road_lanelets, cl_road));
   insertMarkerArray(
     &map_marker_array, lanelet::visualization::noObstacleSegmentationAreaAsMarkerArray(
-                         no_obstacle_segmentation_area, cl_no_obstacle_segmentation_area));
+                         p.no_obstacle_segmentation_area, cl_no_obstacle_segmentation_area));
   insertMarkerArray(
     &map_marker_array,
     lanelet::visualization::noObstacleSegmentationAreaForRunOutAsMarkerArray(
-      no_obstacle_segmentation_area_for_run_out, cl_no_obstacle_segmentation_area_for_run_out));
+      p.no_obstacle_segmentation_area_for_run_out, cl_no_obstacle_segmentation_area_for_run_out));
+
+  return map_marker_array;
+}
+
+template <class PointsT>
+lanelet::BasicPoint2d calcCenter(const PointsT & points)
+{
+  lanelet::BoundingBox2d box;
+  for (const auto & point : points) {
+    box.extend(lanelet::BasicPoint2d(point.x(), point.y()));
+  }
+  return box.center();
+}
+
+int64_t toTileIndex(const double value, const double tile_size)
+{
+  return static_cast<int64_t>(std::floor(value / tile_size));
+}
+
+uint64_t toTileKey(const int64_t x, const int64_t y)
+{
+  return (static_cast<uint64_t>(x) << 32) | (static_cast<uint64_t>(y) & 0xffffffff);
+}
+}  // namespace
 
+Lanelet2MapVisualizationNode::Lanelet2MapVisualizationNode(const rclcpp::NodeOptions & options)
+: Node("lanelet2_map_visualization", options)
+{
+  using std::placeholders::_1;
+
+  viz_lanelets_centerline_ = this->declare_parameter("viz_lanelets_centerline", true);
+  enable_tiled_visualization_ = this->declare_parameter("enable_tiled_visualization", false);
+  tile_size_ = this->declare_parameter("tile_size", 100.0);
+  visible_radius_ = this->declare_parameter("visible_radius", 300.0);
+
+  sub_map_bin_ = this->create_subscription<autoware_auto_mapping_msgs::msg::HADMapBin>(
+    "input/lanelet2_map", rclcpp::QoS{1}.transient_local(),
+    std::bind(&Lanelet2MapVisualizationNode::onMapBin, this, _1));
+  if (enable_tiled_visualization_) {
+    sub_kinematic_state_ = this->create_subscription<nav_msgs::msg::Odometry>(
+      "input/kinematic_state", rclcpp::QoS{1},
+      std::bind(&Lanelet2MapVisualizationNode::onKinematicState, this, _1));
+  }
+
+  pub_marker_ = this->create_publisher<visualization_msgs::msg::MarkerArray>(
+    "output/lanelet2_map_marker", rclcpp::QoS{1}.transient_local());
+}
+
+void Lanelet2MapVisualizationNode::onMapBin(
+  const autoware_auto_mapping_msgs::msg::HADMapBin::ConstSharedPtr msg)
+{
+  lanelet::LaneletMapPtr viz_lanelet_map(new lanelet::LaneletMap);
+
+  lanelet::utils::conversion::fromBinMsg(*msg, viz_lanelet_map);
+  RCLCPP_INFO(this->get_logger(), "Map is loaded\n");
+
+  if (enable_tiled_visualization_) {
+    createTiles(viz_lanelet_map);
+    return;
+  }
+
+  pub_marker_->publish(
+    createMapMarkerArray(queryMapPrimitives(viz_lanelet_map), viz_lanelets_centerline_));
+}
+
+void Lanelet2MapVisualizationNode::createTiles(const lanelet::LaneletMapPtr & viz_lanelet_map)
+{
+  tiles_.clear();
+  visible_tile_markers_.clear();
+  is_visible_tiles_outdated_ = true;
+
+  const auto get_tile = [&](const lanelet::BasicPoint2d & center) -> MapPrimitives & {
+    return tiles_[toTileKey(
+      toTileIndex(center.x(), tile_size_), toTileIndex(center.y(), tile_size_))];
+  };
+
+  // Sort lanelets and their regulatory elements in a single pass. Regulatory elements and stop
+  // lines shared by several lanelets belong to the tile of the first one.
+  std::unordered_set<lanelet::Id> visited_reg_elem_ids;
+  std::unordered_set<lanelet::Id> visited_stop_line_ids;
+  const auto append_reg_elems = [&](const auto & reg_elems, auto & tile_reg_elems) {
+    for (const auto & reg_elem : reg_elems) {
+      if (visited_reg_elem_ids.insert(reg_elem->id()).second) {
+        tile_reg_elems.push_back(reg_elem);
+      }
+    }
+  };
+  for (const lanelet::ConstLanelet & lanelet : viz_lanelet_map->laneletLayer) {
+    auto & tile = get_tile(calcCenter(lanelet.polygon3d()));
+
+    const std::string subtype = lanelet.attributeOr(lanelet::AttributeName::Subtype, "none");
+    if (subtype == lanelet::AttributeValueString::Road) {
+      tile.road_lanelets.push_back(lanelet);
+      for (const auto & stop_line : lanelet::utils::query::stopLinesLanelet(lanelet)) {
+        if (visited_stop_line_ids.insert(stop_line.id()).second) {
+          tile.stop_lines.push_back(stop_line);
+        }
+      }
+    } else if (subtype == "road_shoulder") {
+      tile.shoulder_lanelets.push_back(lanelet);
+    } else if (subtype == lanelet::AttributeValueString::Crosswalk) {
+      tile.crosswalk_lanelets.push_back(lanelet);
+    } else if (subtype == lanelet::AttributeValueString::Walkway) {
+      tile.walkway_lanelets.push_back(lanelet);
+    }
+
+    append_reg_elems(
+      lanelet.regulatoryElementsAs<lanelet::autoware::AutowareTrafficLight>(),
+      tile.aw_tl_reg_elems);
+    append_reg_elems(
+      lanelet.regulatoryElementsAs<lanelet::autoware::DetectionArea>(), tile.da_reg_elems);
+    append_reg_elems(
+      lanelet.regulatoryElementsAs<lanelet::autoware::NoStoppingArea>(), tile.no_reg_elems);
+    append_reg_elems(
+      lanelet.regulatoryElementsAs<lanelet::autoware::SpeedBump>(), tile.sb_reg_elems);
+  }
+
+  // line strings and polygons are sorted by their own positions
+  const auto append_by_position = [&](const auto & primitives, const auto get_tile_primitives) {
+    for (const auto & primitive : primitives) {
+      get_tile_primitives(get_tile(calcCenter(primitive))).push_back(primitive);
+    }
+  };
+  append_by_position(
+    lanelet::utils::query::getAllPartitions(viz_lanelet_map),
+    [](MapPrimitives & tile) -> auto & { return tile.partitions; });
+  append_by_position(
+    lanelet::utils::query::getAllPedestrianMarkings(viz_lanelet_map),
+    [](MapPrimitives & tile) -> auto & { return tile.pedestrian_markings; });
+  append_by_position(
+    lanelet::utils::query::getAllParkingSpaces(viz_lanelet_map),
+    [](MapPrimitives & tile) -> auto & { return tile.parking_spaces; });
+  append_by_position(
+    lanelet::utils::query::getAllParkingLots(viz_lanelet_map),
+    [](MapPrimitives & tile) -> auto & { return tile.parking_lots; });
+  append_by_position(
+    lanelet::utils::query::getAllObstaclePolygons(viz_lanelet_map),
+    [](MapPrimitives & tile) -> auto & { return tile.obstacle_polygons; });
+  append_by_position(
+    lanelet::utils::query::getAllPolygonsByType(viz_lanelet_map, "no_obstacle_segmentation_area"),
+    [](MapPrimitives & tile) -> auto & { return tile.no_obstacle_segmentation_area; });
+  append_by_position(
+    lanelet::utils::query::getAllPolygonsByType(
+      viz_lanelet_map, "no_obstacle_segmentation_area_for_run_out"),
+    [](MapPrimitives & tile) -> auto & { return tile.no_obstacle_segmentation_area_for_run_out; });
+
+  RCLCPP_INFO(this->get_logger(), "Map is split into %lu tiles", tiles_.size());
+}
+
+void Lanelet2MapVisualizationNode::onKinematicState(
+  const nav_msgs::msg::Odometry::ConstSharedPtr msg)
+{
+  if (tiles_.empty()) {
+    return;
+  }
+
+  // the visible tiles are updated only when ego enters another tile
+  const int64_t ego_x = toTileIndex(msg->pose.pose.position.x, tile_size_);
+  const int64_t ego_y = toTileIndex(msg->pose.pose.position.y, tile_size_);
+  const uint64_t ego_tile_key = toTileKey(ego_x, ego_y);
+  if (!is_visible_tiles_outdated_ && ego_tile_key == ego_tile_key_) {
+    return;
+  }
+  ego_tile_key_ = ego_tile_key;
+
+  // tiles within visible_radius_ from anywhere in the ego tile
+  std::vector<uint64_t> visible_tile_keys;
+  const int64_t range = static_cast<int64_t>(std::ceil(visible_radius_ / tile_size_)) + 1;
+  for (int64_t dx = -range; dx <= range; ++dx) {
+    for (int64_t dy = -range; dy <= range; ++dy) {
+      const double gap_x = std::max<int64_t>(std::abs(dx) - 1, 0) * tile_size_;
+      const double gap_y = std::max<int64_t>(std::abs(dy) - 1, 0) * tile_size_;
+      const uint64_t tile_key = toTileKey(ego_x + dx, ego_y + dy);
+      if (std::hypot(gap_x, gap_y) <= visible_radius_ && tiles_.count(tile_key) != 0) {
+        visible_tile_keys.push_back(tile_key);
+      }
+    }
+  }
+  std::sort(visible_tile_keys.begin(), visible_tile_keys.end());
+
+  const bool is_visible_tiles_changed = !std::equal(
+    visible_tile_keys.begin(), visible_tile_keys.end(), visible_tile_markers_.begin(),
+    visible_tile_markers_.end(),
+    [](const uint64_t key, const auto & tile_markers) { return key == tile_markers.first; });
+  if (!is_visible_tiles_outdated_ && !is_visible_tiles_changed) {
+    return;
+  }
+  is_visible_tiles_outdated_ = false;
+
+  // create markers of the tiles which have become visible, and reuse the others
+  std::map<uint64_t, visualization_msgs::msg::MarkerArray> visible_tile_markers;
+  for (const auto tile_key : visible_tile_keys) {
+    const auto marker_itr = visible_tile_markers_.find(tile_key);
+    if (marker_itr != visible_tile_markers_.end()) {
+      visible_tile_markers.emplace(tile_key, std::move(marker_itr->second));
+    } else {
+      visible_tile_markers.emplace(
+        tile_key, createMapMarkerArray(tiles_.at(tile_key), viz_lanelets_centerline_));
+    }
+  }
+  visible_tile_markers_ = std::move(visible_tile_markers);
+
+  // Replace all the markers so that the latched message alone shows the visible tiles. Markers
+  // of different tiles may have the same id in a namespace, so they are renumbered.
+  visualization_msgs::msg::MarkerArray map_marker_array;
+  visualization_msgs::msg::Marker delete_all_marker;
+  delete_all_marker.action = visualization_msgs::msg::Marker::DELETEALL;
+  map_marker_array.markers.push_back(delete_all_marker);
+  std::unordered_map<std::string, int32_t> next_marker_ids;
+  for (const auto & [tile_key, tile_markers] : visible_tile_markers_) {
+    for (const auto & marker : tile_markers.markers) {
+      map_marker_array.markers.push_back(marker);
+      map_marker_array.markers.back().id = next_marker_ids[marker.ns]++;
+    }
+  }
   pub_marker_->publish(map_marker_array);
 }
 
@@ -0,0 +1,263 @@
+// Copyright 2023 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "binary_tile.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+constexpr char kTileMagic[8] = {'A', 'W', 'P', 'C', 'T', 'I', 'L', 'E'};
+constexpr std::uint32_t kTileVersion = 1;
+constexpr std::size_t kFieldNameSize = 32;
+constexpr std::size_t kDataAlignment = 16;
+constexpr char kIndexHeader[] = "# map_loader binary tile index v1";
+
+struct TileHeader
+{
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t num_fields;
+  std::uint32_t point_step;
+  std::uint32_t data_offset;
+  std::uint32_t width;
+  std::uint32_t height;
+};
+
+struct TileField
+{
+  char name[kFieldNameSize];
+  std::uint32_t offset;
+  std::uint32_t count;
+  std::uint8_t datatype;
+  std::uint8_t reserved[7];
+};
+
+static_assert(sizeof(TileHeader) == 32, "unexpected padding in TileHeader");
+static_assert(sizeof(TileField) == 48, "unexpected padding in TileField");
+
+std::size_t computeDataOffset(const std::size_t num_fields)
+{
+  const std::size_t header_size = sizeof(TileHeader) + num_fields * sizeof(TileField);
+  return (header_size + kDataAlignment - 1) / kDataAlignment * kDataAlignment;
+}
+
+// read-only private mapping of a whole file, unmapped on destruction
+class MappedFile
+{
+public:
+  explicit MappedFile(const std::string & path)
+  {
+    fd_ = open(path.c_str(), O_RDONLY);
+    if (fd_ < 0) return;
+    struct stat st = {};
+    if (fstat(fd_, &st) != 0 || st.st_size <= 0) return;
+    const auto size = static_cast<std::size_t>(st.st_size);
+    void * addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd_, 0);
+    if (addr == MAP_FAILED) return;
+    madvise(addr, size, MADV_SEQUENTIAL);
+    data_ = static_cast<const std::uint8_t *>(addr);
+    size_ = size;
+  }
+  ~MappedFile()
+  {
+    if (data_) munmap(const_cast<std::uint8_t *>(data_), size_);
+    if (fd_ >= 0) close(fd_);
+  }
+  MappedFile(const MappedFile &) = delete;
+  MappedFile & operator=(const MappedFile &) = delete;
+
+  const std::uint8_t * data() const { return data_; }
+  std::size_t size() const { return size_; }
+
+private:
+  int fd_{-1};
+  const std::uint8_t * data_{nullptr};
+  std::size_t size_{0};
+};
+}  // namespace
+
+bool isLittleEndianHost()
+{
+  const std::uint16_t value = 1;
+  std::uint8_t first_byte = 0;
+  std::memcpy(&first_byte, &value, 1);
+  return first_byte == 1;
+}
+
+bool saveBinaryTile(const std::string & path, const sensor_msgs::msg::PointCloud2 & pcd)
+{
+  if (!isLittleEndianHost() || pcd.is_bigendian) return false;
+  if (static_cast<std::size_t>(pcd.row_step) * pcd.height != pcd.data.size()) return false;
+  if (static_cast<std::size_t>(pcd.point_step) * pcd.width != pcd.row_step) return false;
+
+  TileHeader header = {};
+  std::memcpy(header.magic, kTileMagic, sizeof(kTileMagic));
+  header.version = kTileVersion;
+  header.num_fields = static_cast<std::uint32_t>(pcd.fields.size());
+  header.point_step = pcd.point_step;
+  header.data_offset = static_cast<std::uint32_t>(computeDataOffset(pcd.fields.size()));
+  header.width = pcd.width;
+  header.height = pcd.height;
+
+  std::vector<TileField> fields(pcd.fields.size());
+  for (std::size_t i = 0; i < pcd.fields.size(); ++i) {
+    const auto & field = pcd.fields[i];
+    if (field.name.size() >= kFieldNameSize) return false;
+    std::memset(&fields[i], 0, sizeof(TileField));
+    std::memcpy(fields[i].name, field.name.data(), field.name.size());
+    fields[i].offset = field.offset;
+    fields[i].count = field.count;
+    fields[i].datatype = field.datatype;
+  }
+
+  // write next to the target and rename, so that a killed node never leaves a truncated tile
+  const std::string tmp_path = path + ".tmp";
+  {
+    std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!ofs) return false;
+    ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    ofs.write(
+      reinterpret_cast<const char *>(fields.data()),
+      static_cast<std::streamsize>(fields.size() * sizeof(TileField)));
+    const std::size_t padding =
+      header.data_offset - sizeof(TileHeader) - fields.size() * sizeof(TileField);
+    const char zeros[kDataAlignment] = {};
+    ofs.write(zeros, static_cast<std::streamsize>(padding));
+    ofs.write(
+      reinterpret_cast<const char *>(pcd.data.data()),
+      static_cast<std::streamsize>(pcd.data.size()));
+    if (!ofs) return false;
+  }
+
+  std::error_code ec;
+  fs::rename(tmp_path, path, ec);
+  return !ec;
+}
+
+bool loadBinaryTile(const std::string & path, sensor_msgs::msg::PointCloud2 & pcd)
+{
+  if (!isLittleEndianHost()) return false;
+
+  const MappedFile file(path);
+  if (!file.data() || file.size() < sizeof(TileHeader)) return false;
+
+  TileHeader header;
+  std::memcpy(&header, file.data(), sizeof(header));
+  if (std::memcmp(header.magic, kTileMagic, sizeof(kTileMagic)) != 0) return false;
+  if (header.version != kTileVersion) return false;
+  if (header.data_offset != computeDataOffset(header.num_fields)) return false;
+
+  const std::size_t data_size =
+    static_cast<std::size_t>(header.point_step) * header.width * header.height;
+  if (file.size() != header.data_offset + data_size) return false;
+
+  pcd.fields.resize(header.num_fields);
+  const auto * fields = file.data() + sizeof(TileHeader);
+  for (std::size_t i = 0; i < header.num_fields; ++i) {
+    TileField field;
+    std::memcpy(&field, fields + i * sizeof(TileField), sizeof(field));
+    pcd.fields[i].name.assign(field.name, strnlen(field.name, kFieldNameSize));
+    pcd.fields[i].offset = field.offset;
+    pcd.fields[i].count = field.count;
+    pcd.fields[i].datatype = field.datatype;
+  }
+
+  pcd.height = header.height;
+  pcd.width = header.width;
+  pcd.is_bigendian = false;
+  pcd.point_step = header.point_step;
+  pcd.row_step = header.point_step * header.width;
+  pcd.is_dense = false;
+  pcd.data.resize(data_size);
+  std::memcpy(pcd.data.data(), file.data() + header.data_offset, data_size);
+  return true;
+}
+
+bool saveBinaryTileIndex(
+  const std::string & path, const std::map<std::string, BinaryTileIndexEntry> & index)
+{
+  const std::string tmp_path = path + ".tmp";
+  {
+    std::ofstream ofs(tmp_path, std::ios::trunc);
+    if (!ofs) return false;
+    ofs << kIndexHeader << '\n';
+    ofs << std::setprecision(std::numeric_limits<float>::max_digits10);
+    for (const auto & [source_path, entry] : index) {
+      const auto & metadata = entry.metadata;
+      ofs << source_path << '\t' << entry.source_size << '\t' << entry.source_mtime << '\t'
+          << metadata.binary_tile_path << '\t' << metadata.num_points << '\t' << metadata.min.x
+          << '\t' << metadata.min.y << '\t' << metadata.min.z << '\t' << metadata.max.x << '\t'
+          << metadata.max.y << '\t' << metadata.max.z << '\n';
+    }
+    if (!ofs) return false;
+  }
+
+  std::error_code ec;
+  fs::rename(tmp_path, path, ec);
+  return !ec;
+}
+
+bool loadBinaryTileIndex(
+  const std::string & path, std::map<std::string, BinaryTileIndexEntry> & index)
+{
+  std::ifstream ifs(path);
+  if (!ifs) return false;
+
+  std::string line;
+  if (!std::getline(ifs, line) || line != kIndexHeader) return false;
+
+  while (std::getline(ifs, line)) {
+    if (line.empty()) continue;
+    std::istringstream iss(line);
+    std::string source_path;
+    BinaryTileIndexEntry entry;
+    auto & metadata = entry.metadata;
+    if (!std::getline(iss, source_path, '\t')) return false;
+    iss >> entry.source_size >> entry.source_mtime;
+    iss.ignore(1, '\t');
+    if (!std::getline(iss, metadata.binary_tile_path, '\t')) return false;
+    iss >> metadata.num_points >> metadata.min.x >> metadata.min.y >> metadata.min.z >>
+      metadata.max.x >> metadata.max.y >> metadata.max.z;
+    if (iss.fail()) return false;
+    index[source_path] = entry;
+  }
+  return true;
+}
+
+bool getSourceStamp(
+  const std::string & source_path, std::uintmax_t & source_size, std::int64_t & source_mtime)
+{
+  std::error_code ec;
+  source_size = fs::file_size(source_path, ec);
+  if (ec) return false;
+  const auto mtime = fs::last_write_time(source_path, ec);
+  if (ec) return false;
+  source_mtime = static_cast<std::int64_t>(mtime.time_since_epoch().count());
+  return true;
+}
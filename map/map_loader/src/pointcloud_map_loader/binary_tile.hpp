@@ -0,0 +1,54 @@
+// Copyright 2023 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINTCLOUD_MAP_LOADER__BINARY_TILE_HPP_
+#define POINTCLOUD_MAP_LOADER__BINARY_TILE_HPP_
+
+#include "utils.hpp"
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+// A binary tile is the PointCloud2 payload of a PCD file dumped as is, preceded by a small
+// little-endian header describing the point fields. Serving it is a single mmap + memcpy.
+//
+// The index is a text sidecar listing, for every source PCD file, its size and modification time
+// (to detect stale entries), the bounds and point count of the tile, and the binary tile file.
+
+struct BinaryTileIndexEntry
+{
+  std::uintmax_t source_size{0};
+  std::int64_t source_mtime{0};
+  PCDFileMetadata metadata;
+};
+
+bool isLittleEndianHost();
+
+bool saveBinaryTile(const std::string & path, const sensor_msgs::msg::PointCloud2 & pcd);
+bool loadBinaryTile(const std::string & path, sensor_msgs::msg::PointCloud2 & pcd);
+
+// keys are the source PCD paths
+bool saveBinaryTileIndex(
+  const std::string & path, const std::map<std::string, BinaryTileIndexEntry> & index);
+bool loadBinaryTileIndex(
+  const std::string & path, std::map<std::string, BinaryTileIndexEntry> & index);
+
+// returns false when the source file cannot be stat'ed
+bool getSourceStamp(
+  const std::string & source_path, std::uintmax_t & source_size, std::int64_t & source_mtime);
+
+#endif  // POINTCLOUD_MAP_LOADER__BINARY_TILE_HPP_
@@ -14,10 +14,43 @@
 
 #include "differential_map_loader_module.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <unordered_set>
+
+namespace
+{
+template <typename Function>
+void parallel_run(const size_t num_threads, Function && function)
+{
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+  for (size_t i = 1; i < num_threads; ++i) {
+    threads.emplace_back(function);
+  }
+  function();
+  for (auto & thread : threads) {
+    thread.join();
+  }
+}
+}  // namespace
+
 DifferentialMapLoaderModule::DifferentialMapLoaderModule(
   rclcpp::Node * node, const std::map<std::string, PCDFileMetadata> & pcd_file_metadata_dict)
-: logger_(node->get_logger()), all_pcd_file_metadata_dict_(pcd_file_metadata_dict)
+: logger_(node->get_logger()),
+  all_pcd_file_metadata_list_(pcd_file_metadata_dict.begin(), pcd_file_metadata_dict.end())
 {
+  std::vector<PCDFileMetadata> metadata_list;
+  metadata_list.reserve(all_pcd_file_metadata_list_.size());
+  for (const auto & ele : all_pcd_file_metadata_list_) {
+    metadata_list.push_back(ele.second);
+  }
+  grid_index_ = MapGridIndex(metadata_list);
+
+  num_load_threads_ = static_cast<size_t>(
+    std::max(node->declare_parameter<int>("differential_load_num_threads", 4), 1));
+
   get_differential_pcd_maps_service_ = node->create_service<GetDifferentialPointCloudMap>(
     "service/get_differential_pcd_map",
     std::bind(
@@ -29,32 +62,41 @@ void DifferentialMapLoaderModule::differentialAreaLoad(
   const autoware_map_msgs::msg::AreaInfo & area, const std::vector<std::string> & cached_ids,
   GetDifferentialPointCloudMap::Response::SharedPtr & response) const
 {
-  // iterate over all the available pcd map grids
-  std::vector<bool> should_remove(static_cast<int>(cached_ids.size()), true);
-  for (const auto & ele : all_pcd_file_metadata_dict_) {
-    std::string path = ele.first;
-    PCDFileMetadata metadata = ele.second;
+  const std::unordered_set<std::string> cached_id_set(cached_ids.begin(), cached_ids.end());
+
+  // iterate over the pcd map grids around the queried area
+  std::unordered_set<std::string> ids_in_area;
+  std::vector<size_t> grids_to_load;
+  for (const size_t i : grid_index_.queryCandidates(area.center, area.radius)) {
+    const auto & [path, metadata] = all_pcd_file_metadata_list_[i];
 
     // assume that the map ID = map path (for now)
-    std::string map_id = path;
+    const std::string & map_id = path;
 
     // skip if the pcd file is not within the queried area
     if (!isGridWithinQueriedArea(area, metadata)) continue;
 
-    auto id_in_cached_list = std::find(cached_ids.begin(), cached_ids.end(), map_id);
-    if (id_in_cached_list != cached_ids.end()) {
-      int index = id_in_cached_list - cached_ids.begin();
-      should_remove[index] = false;
-    } else {
-      autoware_map_msgs::msg::PointCloudMapCellWithID pointcloud_map_cell_with_id =
-        loadPointCloudMapCellWithID(path, map_id);
-      response->new_pointcloud_with_ids.push_back(pointcloud_map_cell_with_id);
+    ids_in_area.insert(map_id);
+    if (cached_id_set.count(map_id) == 0) {
+      grids_to_load.push_back(i);
     }
   }
 
-  for (size_t i = 0; i < cached_ids.size(); ++i) {
-    if (should_remove[i]) {
-      response->ids_to_remove.push_back(cached_ids[i]);
+  // load the new grids in parallel, keeping the order of the grid list in the response
+  auto & new_pointcloud_with_ids = response->new_pointcloud_with_ids;
+  new_pointcloud_with_ids.resize(grids_to_load.size());
+  std::atomic<size_t> next{0};
+  const size_t num_threads = std::max<size_t>(std::min(num_load_threads_, grids_to_load.size()), 1);
+  parallel_run(num_threads, [&]() {
+    for (size_t i = next++; i < grids_to_load.size(); i = next++) {
+      const auto & [path, metadata] = all_pcd_file_metadata_list_[grids_to_load[i]];
+      new_pointcloud_with_ids[i] = loadPointCloudMapCellWithID(path, path, metadata);
+    }
+  });
+
+  for (const auto & cached_id : cached_ids) {
+    if (ids_in_area.count(cached_id) == 0) {
+      response->ids_to_remove.push_back(cached_id);
     }
   }
 }
@@ -72,14 +114,18 @@ bool DifferentialMapLoaderModule::onServiceGetDifferentialPointCloudMap(
 
 autoware_map_msgs::msg::PointCloudMapCellWithID
 DifferentialMapLoaderModule::loadPointCloudMapCellWithID(
-  const std::string & path, const std::string & map_id) const
+  const std::string & path, const std::string & map_id, const PCDFileMetadata & metadata) const
 {
-  sensor_msgs::msg::PointCloud2 pcd;
-  if (pcl::io::loadPCDFile(path, pcd) == -1) {
-    RCLCPP_ERROR_STREAM(logger_, "PCD load failed: " << path);
-  }
   autoware_map_msgs::msg::PointCloudMapCellWithID pointcloud_map_cell_with_id;
-  pointcloud_map_cell_with_id.pointcloud = pcd;
+  auto & pcd = pointcloud_map_cell_with_id.pointcloud;
+  if (metadata.binary_tile_path.empty() || !loadBinaryTile(metadata.binary_tile_path, pcd)) {
+    if (!metadata.binary_tile_path.empty()) {
+      RCLCPP_WARN_STREAM(logger_, "Binary tile load failed, parsing PCD: " << path);
+    }
+    if (pcl::io::loadPCDFile(path, pcd) == -1) {
+      RCLCPP_ERROR_STREAM(logger_, "PCD load failed: " << path);
+    }
+  }
   pointcloud_map_cell_with_id.cell_id = map_id;
   return pointcloud_map_cell_with_id;
 }
@@ -15,6 +15,8 @@
 #ifndef POINTCLOUD_MAP_LOADER__DIFFERENTIAL_MAP_LOADER_MODULE_HPP_
 #define POINTCLOUD_MAP_LOADER__DIFFERENTIAL_MAP_LOADER_MODULE_HPP_
 
+#include "binary_tile.hpp"
+#include "map_grid_index.hpp"
 #include "utils.hpp"
 
 #include <rclcpp/rclcpp.hpp>
@@ -30,6 +32,7 @@
 
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 class DifferentialMapLoaderModule
@@ -43,7 +46,10 @@ public:
 private:
   rclcpp::Logger logger_;
 
-  std::map<std::string, PCDFileMetadata> all_pcd_file_metadata_dict_;
+  // sorted by path, indexed by grid_index_
+  std::vector<std::pair<std::string, PCDFileMetadata>> all_pcd_file_metadata_list_;
+  MapGridIndex grid_index_;
+  size_t num_load_threads_;
   rclcpp::Service<GetDifferentialPointCloudMap>::SharedPtr get_differential_pcd_maps_service_;
 
   bool onServiceGetDifferentialPointCloudMap(
@@ -53,7 +59,7 @@ private:
     const autoware_map_msgs::msg::AreaInfo & area_info, const std::vector<std::string> & cached_ids,
     GetDifferentialPointCloudMap::Response::SharedPtr & response) const;
   autoware_map_msgs::msg::PointCloudMapCellWithID loadPointCloudMapCellWithID(
-    const std::string & path, const std::string & map_id) const;
+    const std::string & path, const std::string & map_id, const PCDFileMetadata & metadata) const;
 };
 
 #endif  // POINTCLOUD_MAP_LOADER__DIFFERENTIAL_MAP_LOADER_MODULE_HPP_
@@ -0,0 +1,95 @@
+// Copyright 2023 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "map_grid_index.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+bool hasValidBounds(const PCDFileMetadata & metadata)
+{
+  return std::isfinite(metadata.min.x) && std::isfinite(metadata.min.y) &&
+         std::isfinite(metadata.max.x) && std::isfinite(metadata.max.y) &&
+         metadata.min.x <= metadata.max.x && metadata.min.y <= metadata.max.y;
+}
+}  // namespace
+
+MapGridIndex::MapGridIndex(const std::vector<PCDFileMetadata> & metadata_list)
+{
+  for (const auto & metadata : metadata_list) {
+    if (!hasValidBounds(metadata)) continue;
+    cell_size_ = std::max(
+      cell_size_, static_cast<double>(std::max(
+                    metadata.max.x - metadata.min.x, metadata.max.y - metadata.min.y)));
+  }
+
+  // grids without valid bounds (e.g. empty pcd files) can never overlap with a queried area
+  for (size_t i = 0; i < metadata_list.size(); ++i) {
+    const auto & metadata = metadata_list[i];
+    if (!hasValidBounds(metadata)) continue;
+    for (int64_t x = toCellIndex(metadata.min.x); x <= toCellIndex(metadata.max.x); ++x) {
+      for (int64_t y = toCellIndex(metadata.min.y); y <= toCellIndex(metadata.max.y); ++y) {
+        cells_[toCellKey(x, y)].push_back(i);
+      }
+    }
+  }
+}
+
+std::vector<size_t> MapGridIndex::queryCandidates(
+  const geometry_msgs::msg::Point & center, const double radius) const
+{
+  std::vector<size_t> candidates;
+  const int64_t x_min = toCellIndex(center.x - radius);
+  const int64_t x_max = toCellIndex(center.x + radius);
+  const int64_t y_min = toCellIndex(center.y - radius);
+  const int64_t y_max = toCellIndex(center.y + radius);
+
+  const double num_query_cells =
+    static_cast<double>(x_max - x_min + 1) * static_cast<double>(y_max - y_min + 1);
+  if (num_query_cells > static_cast<double>(cells_.size())) {
+    // the queried area covers most of the map, visiting the occupied cells is cheaper
+    for (const auto & [key, indices] : cells_) {
+      const auto x = static_cast<int64_t>(static_cast<int32_t>(key >> 32));
+      const auto y = static_cast<int64_t>(static_cast<int32_t>(key & 0xFFFFFFFF));
+      if (x < x_min || x_max < x || y < y_min || y_max < y) continue;
+      candidates.insert(candidates.end(), indices.begin(), indices.end());
+    }
+  } else {
+    for (int64_t x = x_min; x <= x_max; ++x) {
+      for (int64_t y = y_min; y <= y_max; ++y) {
+        const auto cell = cells_.find(toCellKey(x, y));
+        if (cell == cells_.end()) continue;
+        candidates.insert(candidates.end(), cell->second.begin(), cell->second.end());
+      }
+    }
+  }
+
+  // a grid registered in several cells is reported once
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+  return candidates;
+}
+
+int64_t MapGridIndex::toCellIndex(const double value) const
+{
+  return static_cast<int64_t>(std::floor(value / cell_size_));
+}
+
+uint64_t MapGridIndex::toCellKey(const int64_t x, const int64_t y)
+{
+  return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) |
+         static_cast<uint64_t>(static_cast<uint32_t>(y));
+}
@@ -0,0 +1,47 @@
+// Copyright 2023 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINTCLOUD_MAP_LOADER__MAP_GRID_INDEX_HPP_
+#define POINTCLOUD_MAP_LOADER__MAP_GRID_INDEX_HPP_
+
+#include "utils.hpp"
+
+#include <geometry_msgs/msg/point.hpp>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Uniform 2D grid over the bounds of the pcd map grids. The cell size is the largest grid extent,
+// so that each grid is registered in at most 2x2 cells and a query only visits the cells around
+// the queried area instead of every grid.
+class MapGridIndex
+{
+public:
+  MapGridIndex() = default;
+  explicit MapGridIndex(const std::vector<PCDFileMetadata> & metadata_list);
+
+  // indices of the grids whose xy bounds may overlap with the sphere, in ascending order
+  std::vector<size_t> queryCandidates(
+    const geometry_msgs::msg::Point & center, const double radius) const;
+
+private:
+  int64_t toCellIndex(const double value) const;
+  static uint64_t toCellKey(const int64_t x, const int64_t y);
+
+  double cell_size_{1.0};
+  std::unordered_map<uint64_t, std::vector<size_t>> cells_;
+};
+
+#endif  // POINTCLOUD_MAP_LOADER__MAP_GRID_INDEX_HPP_
@@ -32,7 +32,7 @@ void PartialMapLoaderModule::partialAreaLoad(
 
   for (const auto & ele : all_pcd_file_metadata_dict_) {
     std::string path = ele.first;
-    PCDFileMetadata metadata = ele.second;
+    const PCDFileMetadata & metadata = ele.second;
 
     // assume that the map ID = map path (for now)
     std::string map_id = path;
@@ -41,8 +41,8 @@ void PartialMapLoaderModule::partialAreaLoad(
     if (!isGridWithinQueriedArea(area, metadata)) continue;
 
     autoware_map_msgs::msg::PointCloudMapCellWithID pointcloud_map_cell_with_id =
-      loadPointCloudMapCellWithID(path, map_id);
-    response->new_pointcloud_with_ids.push_back(pointcloud_map_cell_with_id);
+      loadPointCloudMapCellWithID(path, map_id, metadata);
+    response->new_pointcloud_with_ids.push_back(std::move(pointcloud_map_cell_with_id));
   }
 }
 
@@ -56,14 +56,18 @@ bool PartialMapLoaderModule::onServiceGetPartialPointCloudMap(
 }
 
 autoware_map_msgs::msg::PointCloudMapCellWithID PartialMapLoaderModule::loadPointCloudMapCellWithID(
-  const std::string & path, const std::string & map_id) const
+  const std::string & path, const std::string & map_id, const PCDFileMetadata & metadata) const
 {
-  sensor_msgs::msg::PointCloud2 pcd;
-  if (pcl::io::loadPCDFile(path, pcd) == -1) {
-    RCLCPP_ERROR_STREAM(logger_, "PCD load failed: " << path);
-  }
   autoware_map_msgs::msg::PointCloudMapCellWithID pointcloud_map_cell_with_id;
-  pointcloud_map_cell_with_id.pointcloud = pcd;
+  auto & pcd = pointcloud_map_cell_with_id.pointcloud;
+  if (metadata.binary_tile_path.empty() || !loadBinaryTile(metadata.binary_tile_path, pcd)) {
+    if (!metadata.binary_tile_path.empty()) {
+      RCLCPP_WARN_STREAM(logger_, "Binary tile load failed, parsing PCD: " << path);
+    }
+    if (pcl::io::loadPCDFile(path, pcd) == -1) {
+      RCLCPP_ERROR_STREAM(logger_, "PCD load failed: " << path);
+    }
+  }
   pointcloud_map_cell_with_id.cell_id = map_id;
   return pointcloud_map_cell_with_id;
 }
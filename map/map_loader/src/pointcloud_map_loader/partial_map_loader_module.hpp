@@ -15,6 +15,7 @@
 #ifndef POINTCLOUD_MAP_LOADER__PARTIAL_MAP_LOADER_MODULE_HPP_
 #define POINTCLOUD_MAP_LOADER__PARTIAL_MAP_LOADER_MODULE_HPP_
 
+#include "binary_tile.hpp"
 #include "utils.hpp"
 
 #include <rclcpp/rclcpp.hpp>
@@ -30,6 +31,7 @@
 
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 class PartialMapLoaderModule
@@ -53,7 +55,7 @@ private:
     const autoware_map_msgs::msg::AreaInfo & area,
     GetPartialPointCloudMap::Response::SharedPtr & response) const;
   autoware_map_msgs::msg::PointCloudMapCellWithID loadPointCloudMapCellWithID(
-    const std::string & path, const std::string & map_id) const;
+    const std::string & path, const std::string & map_id, const PCDFileMetadata & metadata) const;
 };
 
 #endif  // POINTCLOUD_MAP_LOADER__PARTIAL_MAP_LOADER_MODULE_HPP_
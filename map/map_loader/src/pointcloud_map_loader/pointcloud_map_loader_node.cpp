@@ -14,6 +14,9 @@
 
 #include "pointcloud_map_loader_node.hpp"
 
+#include "binary_tile.hpp"
+
+#include <fmt/format.h>
 #include <glob.h>
 #include <pcl/filters/voxel_grid.h>
 #include <pcl/io/pcd_io.h>
@@ -53,6 +56,8 @@ PointCloudMapLoaderNode::PointCloudMapLoaderNode(const rclcpp::NodeOptions & opt
   bool enable_downsample_whole_load = declare_parameter<bool>("enable_downsampled_whole_load");
   bool enable_partial_load = declare_parameter<bool>("enable_partial_load");
   bool enable_differential_load = declare_parameter<bool>("enable_differential_load");
+  const auto binary_tile_cache_directory =
+    declare_parameter<std::string>("binary_tile_cache_directory", "");
 
   if (enable_whole_load) {
     std::string publisher_name = "output/pointcloud_map";
@@ -67,7 +72,9 @@ PointCloudMapLoaderNode::PointCloudMapLoaderNode(const rclcpp::NodeOptions & opt
   }
 
   if (enable_partial_load | enable_differential_load) {
-    pcd_metadata_dict_ = generatePCDMetadata(pcd_paths);
+    pcd_metadata_dict_ = binary_tile_cache_directory.empty()
+                           ? generatePCDMetadata(pcd_paths)
+                           : loadBinaryTileMetadata(pcd_paths, binary_tile_cache_directory);
   }
 
   if (enable_partial_load) {
@@ -121,5 +128,84 @@ std::map<std::string, PCDFileMetadata> PointCloudMapLoaderNode::generatePCDMetad
   return all_pcd_file_metadata_dict;
 }
 
+std::map<std::string, PCDFileMetadata> PointCloudMapLoaderNode::loadBinaryTileMetadata(
+  const std::vector<std::string> & pcd_paths, const std::string & cache_directory) const
+{
+  if (!isLittleEndianHost()) {
+    RCLCPP_WARN(get_logger(), "Binary tile cache requires a little-endian host, using PCD");
+    return generatePCDMetadata(pcd_paths);
+  }
+
+  std::error_code ec;
+  fs::create_directories(cache_directory, ec);
+  if (ec) {
+    RCLCPP_ERROR_STREAM(get_logger(), "Cannot create binary tile cache: " << cache_directory);
+    return generatePCDMetadata(pcd_paths);
+  }
+
+  const std::string index_path = (fs::path(cache_directory) / "index.txt").string();
+  std::map<std::string, BinaryTileIndexEntry> index;
+  if (fs::exists(index_path) && !loadBinaryTileIndex(index_path, index)) {
+    RCLCPP_WARN_STREAM(get_logger(), "Broken binary tile index, rebuilding: " << index_path);
+    index.clear();
+  }
+
+  // only the tiles which are new or whose source PCD changed are parsed
+  std::map<std::string, BinaryTileIndexEntry> new_index;
+  size_t num_rebuilt_tiles = 0;
+  for (const auto & path : pcd_paths) {
+    BinaryTileIndexEntry entry;
+    if (!getSourceStamp(path, entry.source_size, entry.source_mtime)) {
+      RCLCPP_ERROR_STREAM(get_logger(), "PCD load failed: " << path);
+      continue;
+    }
+
+    const auto cached = index.find(path);
+    if (
+      cached != index.end() && cached->second.source_size == entry.source_size &&
+      cached->second.source_mtime == entry.source_mtime &&
+      fs::exists(cached->second.metadata.binary_tile_path)) {
+      new_index[path] = cached->second;
+      continue;
+    }
+
+    sensor_msgs::msg::PointCloud2 pcd;
+    if (pcl::io::loadPCDFile(path, pcd) == -1) {
+      RCLCPP_ERROR_STREAM(get_logger(), "PCD load failed: " << path);
+      continue;
+    }
+    pcl::PointCloud<pcl::PointXYZ> partial_pcd;
+    pcl::fromROSMsg(pcd, partial_pcd);
+    pcl::getMinMax3D(partial_pcd, entry.metadata.min, entry.metadata.max);
+    entry.metadata.num_points = partial_pcd.size();
+
+    // tiles from different directories may share a file name
+    const std::string tile_name = fmt::format(
+      "{}_{:016x}.bin", fs::path(path).stem().string(), std::hash<std::string>{}(path));
+    entry.metadata.binary_tile_path = (fs::path(cache_directory) / tile_name).string();
+    if (!saveBinaryTile(entry.metadata.binary_tile_path, pcd)) {
+      RCLCPP_WARN_STREAM(get_logger(), "Binary tile save failed, serving PCD instead: " << path);
+      entry.metadata.binary_tile_path.clear();
+    }
+    new_index[path] = entry;
+    ++num_rebuilt_tiles;
+  }
+
+  if (num_rebuilt_tiles > 0 || new_index.size() != index.size()) {
+    if (!saveBinaryTileIndex(index_path, new_index)) {
+      RCLCPP_WARN_STREAM(get_logger(), "Binary tile index save failed: " << index_path);
+    }
+  }
+  RCLCPP_INFO_STREAM(
+    get_logger(), "Binary tile cache: " << new_index.size() - num_rebuilt_tiles << " tiles reused, "
+                                        << num_rebuilt_tiles << " tiles rebuilt");
+
+  std::map<std::string, PCDFileMetadata> all_pcd_file_metadata_dict;
+  for (const auto & [path, entry] : new_index) {
+    all_pcd_file_metadata_dict[path] = entry.metadata;
+  }
+  return all_pcd_file_metadata_dict;
+}
+
 #include <rclcpp_components/register_node_macro.hpp>
 RCLCPP_COMPONENTS_REGISTER_NODE(PointCloudMapLoaderNode)
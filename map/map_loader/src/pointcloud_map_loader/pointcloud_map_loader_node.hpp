@@ -50,6 +50,8 @@ private:
     const std::vector<std::string> & pcd_paths_or_directory) const;
   std::map<std::string, PCDFileMetadata> generatePCDMetadata(
     const std::vector<std::string> & pcd_paths) const;
+  std::map<std::string, PCDFileMetadata> loadBinaryTileMetadata(
+    const std::vector<std::string> & pcd_paths, const std::string & cache_directory) const;
 };
 
 #endif  // POINTCLOUD_MAP_LOADER__POINTCLOUD_MAP_LOADER_NODE_HPP_
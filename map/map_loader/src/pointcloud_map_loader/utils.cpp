@@ -62,7 +62,7 @@ bool sphereAndBoxOverlapExists(
 }
 
 bool isGridWithinQueriedArea(
-  const autoware_map_msgs::msg::AreaInfo area, const PCDFileMetadata metadata)
+  const autoware_map_msgs::msg::AreaInfo area, const PCDFileMetadata & metadata)
 {
   // Currently, the area load only supports spherical area
   geometry_msgs::msg::Point center = area.center;
@@ -20,16 +20,21 @@
 
 #include <pcl/common/common.h>
 
+#include <string>
+
 struct PCDFileMetadata
 {
   pcl::PointXYZ min;
   pcl::PointXYZ max;
+  // only filled when the binary tile cache is enabled
+  std::string binary_tile_path;
+  std::size_t num_points{0};
 };
 
 bool sphereAndBoxOverlapExists(
   const geometry_msgs::msg::Point position, const double radius, const pcl::PointXYZ position_min,
   const pcl::PointXYZ position_max);
 bool isGridWithinQueriedArea(
-  const autoware_map_msgs::msg::AreaInfo area, const PCDFileMetadata metadata);
+  const autoware_map_msgs::msg::AreaInfo area, const PCDFileMetadata & metadata);
 
 #endif  // POINTCLOUD_MAP_LOADER__UTILS_HPP_
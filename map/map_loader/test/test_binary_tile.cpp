@@ -0,0 +1,119 @@
+// Copyright 2023 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../src/pointcloud_map_loader/binary_tile.hpp"
+
+#include <gmock/gmock.h>
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+TEST(BinaryTile, SaveAndLoad)
+{
+  // 3 points of (x, y, z, intensity)
+  sensor_msgs::msg::PointCloud2 pcd;
+  pcd.height = 1;
+  pcd.width = 3;
+  pcd.is_bigendian = false;
+  pcd.point_step = 16;
+  pcd.row_step = pcd.point_step * pcd.width;
+  const std::vector<std::string> names = {"x", "y", "z", "intensity"};
+  for (size_t i = 0; i < names.size(); ++i) {
+    sensor_msgs::msg::PointField field;
+    field.name = names[i];
+    field.offset = static_cast<uint32_t>(i * 4);
+    field.datatype = sensor_msgs::msg::PointField::FLOAT32;
+    field.count = 1;
+    pcd.fields.push_back(field);
+  }
+  for (size_t i = 0; i < pcd.row_step; ++i) {
+    pcd.data.push_back(static_cast<uint8_t>(i));
+  }
+
+  const std::string path = (fs::temp_directory_path() / "test_binary_tile.bin").string();
+  ASSERT_TRUE(saveBinaryTile(path, pcd));
+
+  sensor_msgs::msg::PointCloud2 loaded;
+  ASSERT_TRUE(loadBinaryTile(path, loaded));
+  EXPECT_EQ(loaded.width, pcd.width);
+  EXPECT_EQ(loaded.height, pcd.height);
+  EXPECT_EQ(loaded.point_step, pcd.point_step);
+  EXPECT_EQ(loaded.row_step, pcd.row_step);
+  EXPECT_EQ(loaded.data, pcd.data);
+  ASSERT_EQ(loaded.fields.size(), pcd.fields.size());
+  for (size_t i = 0; i < pcd.fields.size(); ++i) {
+    EXPECT_EQ(loaded.fields[i].name, pcd.fields[i].name);
+    EXPECT_EQ(loaded.fields[i].offset, pcd.fields[i].offset);
+    EXPECT_EQ(loaded.fields[i].datatype, pcd.fields[i].datatype);
+    EXPECT_EQ(loaded.fields[i].count, pcd.fields[i].count);
+  }
+  fs::remove(path);
+}
+
+TEST(BinaryTile, LoadInvalidFile)
+{
+  const std::string path = (fs::temp_directory_path() / "test_binary_tile_invalid.bin").string();
+  {
+    std::ofstream ofs(path);
+    ofs << "not a binary tile";
+  }
+  sensor_msgs::msg::PointCloud2 loaded;
+  EXPECT_FALSE(loadBinaryTile(path, loaded));
+  fs::remove(path);
+}
+
+TEST(BinaryTileIndex, SaveAndLoad)
+{
+  BinaryTileIndexEntry entry;
+  entry.source_size = 1024;
+  entry.source_mtime = 1234567890123;
+  entry.metadata.min.x = -0.1f;
+  entry.metadata.min.y = 2.5f;
+  entry.metadata.min.z = -3.3f;
+  entry.metadata.max.x = 100.1f;
+  entry.metadata.max.y = 200.2f;
+  entry.metadata.max.z = 300.3f;
+  entry.metadata.num_points = 42;
+  entry.metadata.binary_tile_path = "/path with space/tile.bin";
+
+  std::map<std::string, BinaryTileIndexEntry> index;
+  index["/map/a.pcd"] = entry;
+  index["/map dir/b.pcd"] = entry;
+
+  const std::string path = (fs::temp_directory_path() / "test_binary_tile_index.txt").string();
+  ASSERT_TRUE(saveBinaryTileIndex(path, index));
+
+  std::map<std::string, BinaryTileIndexEntry> loaded;
+  ASSERT_TRUE(loadBinaryTileIndex(path, loaded));
+  ASSERT_EQ(loaded.size(), index.size());
+  for (const auto & [source_path, loaded_entry] : loaded) {
+    ASSERT_EQ(index.count(source_path), 1U);
+    EXPECT_EQ(loaded_entry.source_size, entry.source_size);
+    EXPECT_EQ(loaded_entry.source_mtime, entry.source_mtime);
+    EXPECT_EQ(loaded_entry.metadata.binary_tile_path, entry.metadata.binary_tile_path);
+    EXPECT_EQ(loaded_entry.metadata.num_points, entry.metadata.num_points);
+    EXPECT_FLOAT_EQ(loaded_entry.metadata.min.x, entry.metadata.min.x);
+    EXPECT_FLOAT_EQ(loaded_entry.metadata.min.y, entry.metadata.min.y);
+    EXPECT_FLOAT_EQ(loaded_entry.metadata.min.z, entry.metadata.min.z);
+    EXPECT_FLOAT_EQ(loaded_entry.metadata.max.x, entry.metadata.max.x);
+    EXPECT_FLOAT_EQ(loaded_entry.metadata.max.y, entry.metadata.max.y);
+    EXPECT_FLOAT_EQ(loaded_entry.metadata.max.z, entry.metadata.max.z);
+  }
+  fs::remove(path);
+}
@@ -0,0 +1,107 @@
+// Copyright 2023 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../src/pointcloud_map_loader/map_grid_index.hpp"
+
+#include <gmock/gmock.h>
+
+#include <limits>
+#include <vector>
+
+namespace
+{
+PCDFileMetadata createMetadata(
+  const float min_x, const float min_y, const float max_x, const float max_y)
+{
+  PCDFileMetadata metadata;
+  metadata.min.x = min_x;
+  metadata.min.y = min_y;
+  metadata.min.z = 0.0;
+  metadata.max.x = max_x;
+  metadata.max.y = max_y;
+  metadata.max.z = 10.0;
+  return metadata;
+}
+
+geometry_msgs::msg::Point createPoint(const double x, const double y, const double z)
+{
+  geometry_msgs::msg::Point point;
+  point.x = x;
+  point.y = y;
+  point.z = z;
+  return point;
+}
+}  // namespace
+
+TEST(MapGridIndex, QueryCandidatesMatchesLinearSearch)
+{
+  // 10x10 grids of 20m, with negative coordinates
+  std::vector<PCDFileMetadata> metadata_list;
+  for (int i = -5; i < 5; ++i) {
+    for (int j = -5; j < 5; ++j) {
+      metadata_list.push_back(createMetadata(i * 20.0, j * 20.0, (i + 1) * 20.0, (j + 1) * 20.0));
+    }
+  }
+  const MapGridIndex index(metadata_list);
+
+  for (const double radius : {1.0, 15.0, 45.0, 500.0}) {
+    for (const auto & center :
+         {createPoint(0.0, 0.0, 5.0), createPoint(-37.0, 12.0, 5.0), createPoint(95.0, -95.0, 5.0),
+          createPoint(300.0, 300.0, 5.0)}) {
+      std::vector<size_t> expected;
+      for (size_t i = 0; i < metadata_list.size(); ++i) {
+        if (sphereAndBoxOverlapExists(center, radius, metadata_list[i].min, metadata_list[i].max)) {
+          expected.push_back(i);
+        }
+      }
+
+      std::vector<size_t> actual;
+      for (const size_t i : index.queryCandidates(center, radius)) {
+        if (sphereAndBoxOverlapExists(center, radius, metadata_list[i].min, metadata_list[i].max)) {
+          actual.push_back(i);
+        }
+      }
+      EXPECT_EQ(actual, expected);
+    }
+  }
+}
+
+TEST(MapGridIndex, QueryCandidatesIsLocal)
+{
+  std::vector<PCDFileMetadata> metadata_list;
+  for (int i = 0; i < 100; ++i) {
+    metadata_list.push_back(createMetadata(i * 10.0, 0.0, (i + 1) * 10.0, 10.0));
+  }
+  const MapGridIndex index(metadata_list);
+
+  // only the grids in the 3 cells around the center are candidates
+  const auto candidates = index.queryCandidates(createPoint(505.0, 5.0, 5.0), 1.0);
+  EXPECT_GE(candidates.size(), 1U);
+  EXPECT_LE(candidates.size(), 6U);
+  EXPECT_THAT(candidates, testing::Contains(50U));
+}
+
+TEST(MapGridIndex, EmptyGridIsNeverCandidate)
+{
+  std::vector<PCDFileMetadata> metadata_list;
+  metadata_list.push_back(createMetadata(0.0, 0.0, 10.0, 10.0));
+  // bounds of an empty point cloud
+  metadata_list.push_back(createMetadata(
+    std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+    -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max()));
+  const MapGridIndex index(metadata_list);
+
+  const auto candidates = index.queryCandidates(createPoint(5.0, 5.0, 5.0), 1e6);
+  EXPECT_THAT(candidates, testing::ElementsAre(0U));
+}
@@ -20,11 +20,16 @@
 #include <lanelet2_core/LaneletMap.h>
 #include <lanelet2_io/Io.h>
 #include <pcl/io/pcd_io.h>
-#include <pcl/kdtree/kdtree_flann.h>
 #include <pcl/point_types.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <limits>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 bool loadLaneletMap(
@@ -56,86 +61,137 @@ bool loadPCDMap(const std::string & pcd_map_path, pcl::PointCloud<pcl::PointXYZ>
   return true;
 }
 
-double getMinHeightAroundPoint(
-  const pcl::PointCloud<pcl::PointXYZ>::Ptr & pcd_map_ptr,
-  const pcl::KdTreeFLANN<pcl::PointXYZ> & kdtree, const pcl::PointXYZ & search_pt,
-  const double search_radius3d, const double search_radius2d)
+// PCD points sorted by the 2d column of side column_size they are in, so that a point only needs to
+// be compared with the points of the 9 columns around it
+class PointColumnIndex
 {
-  std::vector<int> pointIdxRadiusSearch;
-  std::vector<float> pointRadiusSquaredDistance;
-  if (
-    kdtree.radiusSearch(
-      search_pt, search_radius3d, pointIdxRadiusSearch, pointRadiusSquaredDistance) <= 0) {
-    std::cout << "no points found within 3d radius " << search_radius3d << std::endl;
-    return search_pt.z;
+public:
+  PointColumnIndex(const pcl::PointCloud<pcl::PointXYZ> & cloud, const double column_size)
+  : column_size_(column_size)
+  {
+    std::vector<std::pair<uint64_t, size_t>> keys;
+    keys.reserve(cloud.points.size());
+    for (size_t i = 0; i < cloud.points.size(); ++i) {
+      const auto & pt = cloud.points[i];
+      if (std::isfinite(pt.x) && std::isfinite(pt.y) && std::isfinite(pt.z)) {
+        keys.emplace_back(getColumnKey(pt.x, pt.y), i);
+      }
+    }
+    std::sort(keys.begin(), keys.end());
+
+    points_.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (i == 0 || keys[i].first != keys[i - 1].first) {
+        column_ranges_.emplace(keys[i].first, std::make_pair(i, i));
+      }
+      ++column_ranges_.at(keys[i].first).second;
+      points_.push_back(cloud.points[keys[i].second]);
+    }
+  }
+
+  // calls f for the points of the columns within radius of (x, y) in 2d
+  template <typename F>
+  void forEachPointAround(const double x, const double y, const double radius, F && f) const
+  {
+    const auto min_ix = static_cast<int32_t>(std::floor((x - radius) / column_size_));
+    const auto max_ix = static_cast<int32_t>(std::floor((x + radius) / column_size_));
+    const auto min_iy = static_cast<int32_t>(std::floor((y - radius) / column_size_));
+    const auto max_iy = static_cast<int32_t>(std::floor((y + radius) / column_size_));
+    for (int32_t ix = min_ix; ix <= max_ix; ++ix) {
+      for (int32_t iy = min_iy; iy <= max_iy; ++iy) {
+        const auto range = column_ranges_.find(toKey(ix, iy));
+        if (range == column_ranges_.end()) {
+          continue;
+        }
+        for (size_t i = range->second.first; i < range->second.second; ++i) {
+          f(points_[i]);
+        }
+      }
+    }
+  }
+
+private:
+  static uint64_t toKey(const int32_t ix, const int32_t iy)
+  {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(ix)) << 32) | static_cast<uint32_t>(iy);
+  }
+  uint64_t getColumnKey(const double x, const double y) const
+  {
+    return toKey(
+      static_cast<int32_t>(std::floor(x / column_size_)),
+      static_cast<int32_t>(std::floor(y / column_size_)));
   }
 
+  double column_size_;
+  std::vector<pcl::PointXYZ> points_;
+  std::unordered_map<uint64_t, std::pair<size_t, size_t>> column_ranges_;
+};
+
+double getMinHeightAroundPoint(
+  const PointColumnIndex & column_index, const pcl::PointXYZ & search_pt,
+  const double search_radius3d, const double search_radius2d)
+{
   double min_height = std::numeric_limits<double>::max();
   bool found = false;
 
-  for (std::size_t i = 0; i < pointIdxRadiusSearch.size(); i++) {
-    std::size_t pt_idx = pointIdxRadiusSearch.at(i);
-    const auto pt = pcd_map_ptr->points.at(pt_idx);
-    if (pt.z > min_height) {
-      continue;
-    }
-    double distance2d = std::hypot(pt.x - search_pt.x, pt.y - search_pt.y);
-    if (distance2d < search_radius2d) {
-      found = true;
-      min_height = pt.z;
-    }
-  }
+  column_index.forEachPointAround(
+    search_pt.x, search_pt.y, search_radius2d, [&](const pcl::PointXYZ & pt) {
+      if (pt.z > min_height) {
+        return;
+      }
+      const double distance2d = std::hypot(pt.x - search_pt.x, pt.y - search_pt.y);
+      const double distance3d = std::hypot(distance2d, pt.z - search_pt.z);
+      if (distance2d < search_radius2d && distance3d < search_radius3d) {
+        found = true;
+        min_height = pt.z;
+      }
+    });
   if (!found) {
     min_height = search_pt.z;
   }
   return min_height;
 }
 
-bool exists(std::unordered_set<lanelet::Id> & set, lanelet::Id element)
-{
-  return std::find(set.begin(), set.end(), element) != set.end();
-}
-
 void adjustHeight(
   const pcl::PointCloud<pcl::PointXYZ>::Ptr & pcd_map_ptr, lanelet::LaneletMapPtr & lanelet_map_ptr)
 {
-  std::unordered_set<lanelet::Id> done;
   double search_radius2d = 0.5;
   double search_radius3d = 10;
 
-  pcl::KdTreeFLANN<pcl::PointXYZ> kdtree;
-  kdtree.setInputCloud(pcd_map_ptr);
+  const PointColumnIndex column_index(*pcd_map_ptr, search_radius2d);
 
+  // bound points shared by several lanelets are fitted once
+  std::unordered_set<lanelet::Id> done;
+  std::vector<lanelet::Point3d> bound_points;
   for (lanelet::Lanelet & llt : lanelet_map_ptr->laneletLayer) {
     for (lanelet::Point3d & pt : llt.leftBound()) {
-      if (exists(done, pt.id())) {
-        continue;
+      if (done.insert(pt.id()).second) {
+        bound_points.push_back(pt);
       }
-      pcl::PointXYZ pcl_pt;
-      pcl_pt.x = pt.x();
-      pcl_pt.y = pt.y();
-      pcl_pt.z = pt.z();
-      double min_height =
-        getMinHeightAroundPoint(pcd_map_ptr, kdtree, pcl_pt, search_radius3d, search_radius2d);
-      std::cout << "moving from " << pt.z() << " to " << min_height << std::endl;
-      pt.z() = min_height;
-      done.insert(pt.id());
     }
     for (lanelet::Point3d & pt : llt.rightBound()) {
-      if (exists(done, pt.id())) {
-        continue;
+      if (done.insert(pt.id()).second) {
+        bound_points.push_back(pt);
       }
-      pcl::PointXYZ pcl_pt;
-      pcl_pt.x = pt.x();
-      pcl_pt.y = pt.y();
-      pcl_pt.z = pt.z();
-      double min_height =
-        getMinHeightAroundPoint(pcd_map_ptr, kdtree, pcl_pt, search_radius3d, search_radius2d);
-      std::cout << "moving from " << pt.z() << " to " << min_height << std::endl;
-      pt.z() = min_height;
-      done.insert(pt.id());
     }
   }
+
+  std::vector<double> min_heights(bound_points.size());
+#pragma omp parallel for schedule(dynamic, 64)
+  for (int64_t i = 0; i < static_cast<int64_t>(bound_points.size()); ++i) {
+    const auto & pt = bound_points[i];
+    pcl::PointXYZ pcl_pt;
+    pcl_pt.x = pt.x();
+    pcl_pt.y = pt.y();
+    pcl_pt.z = pt.z();
+    min_heights[i] =
+      getMinHeightAroundPoint(column_index, pcl_pt, search_radius3d, search_radius2d);
+  }
+
+  for (size_t i = 0; i < bound_points.size(); ++i) {
+    std::cout << "moving from " << bound_points[i].z() << " to " << min_heights[i] << std::endl;
+    bound_points[i].z() = min_heights[i];
+  }
 }
 
 int main(int argc, char * argv[])
@@ -21,7 +21,12 @@
 #include <lanelet2_core/geometry/Lanelet.h>
 #include <lanelet2_io/Io.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -72,28 +77,122 @@ lanelet::Points3d convertPointsLayerToPoints(lanelet::LaneletMapPtr & lanelet_ma
 //   return lanelet::LineString3d(lanelet::utils::getId(), new_points);
 // }
 
+// Points hashed by the cube of side kMergeDistance they are in, so that only the points in the 27
+// cubes around a point can be closer to it than kMergeDistance
+constexpr double kMergeDistance = 0.1;
+
+struct CellKey
+{
+  int64_t x;
+  int64_t y;
+  int64_t z;
+  bool operator==(const CellKey & other) const
+  {
+    return x == other.x && y == other.y && z == other.z;
+  }
+};
+
+struct CellKeyHash
+{
+  size_t operator()(const CellKey & key) const
+  {
+    size_t seed = std::hash<int64_t>()(key.x);
+    seed ^= std::hash<int64_t>()(key.y) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    seed ^= std::hash<int64_t>()(key.z) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    return seed;
+  }
+};
+
+using PointGrid = std::unordered_map<CellKey, std::vector<size_t>, CellKeyHash>;
+
+CellKey getCellKey(const lanelet::Point3d & point)
+{
+  return CellKey{
+    static_cast<int64_t>(std::floor(point.x() / kMergeDistance)),
+    static_cast<int64_t>(std::floor(point.y() / kMergeDistance)),
+    static_cast<int64_t>(std::floor(point.z() / kMergeDistance))};
+}
+
+// indices of the points in the cubes around key that are not smaller than first_index, sorted
+void getCandidates(
+  const PointGrid & grid, const CellKey & key, const size_t first_index,
+  std::vector<size_t> & candidates)
+{
+  candidates.clear();
+  for (int64_t dx = -1; dx <= 1; ++dx) {
+    for (int64_t dy = -1; dy <= 1; ++dy) {
+      for (int64_t dz = -1; dz <= 1; ++dz) {
+        const auto cell = grid.find(CellKey{key.x + dx, key.y + dy, key.z + dz});
+        if (cell == grid.end()) {
+          continue;
+        }
+        for (const auto index : cell->second) {
+          if (first_index <= index) {
+            candidates.push_back(index);
+          }
+        }
+      }
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+}
+
+void moveInGrid(PointGrid & grid, const size_t index, const CellKey & from, const CellKey & to)
+{
+  if (from == to) {
+    return;
+  }
+  auto & from_indices = grid.at(from);
+  from_indices.erase(std::find(from_indices.begin(), from_indices.end(), index));
+  if (from_indices.empty()) {
+    grid.erase(from);
+  }
+  grid[to].push_back(index);
+}
+
 void mergePoints(lanelet::LaneletMapPtr & lanelet_map_ptr)
 {
   const auto & points = convertPointsLayerToPoints(lanelet_map_ptr);
 
+  // each point is compared with the earlier points in the grid only, in the same order as a
+  // comparison with every earlier point, so that the points are merged the same way
+  PointGrid grid;
+  std::vector<CellKey> point_cells(points.size());
+  std::vector<size_t> candidates;
   for (size_t i = 0; i < points.size(); i++) {
     auto point_i = points.at(i);
-    for (size_t j = 0; j < i; j++) {
-      auto point_j = points.at(j);
-
-      double distance = boost::geometry::distance(point_i, point_j);
-      if (distance < 0.1) {
-        const auto new_point = (point_i.basicPoint() + point_j.basicPoint()) / 2;
-        // const auto new_pt3d = lanelet::Point3d(lanelet::utils::getId(), new_point);
-        point_i.x() = new_point.x();
-        point_i.y() = new_point.y();
-        point_i.z() = new_point.z();
-        point_j.x() = new_point.x();
-        point_j.y() = new_point.y();
-        point_j.z() = new_point.z();
-        point_i.setId(point_j.id());
+    size_t first_j = 0;
+    bool is_merged = true;
+    while (is_merged) {
+      // point_i moves when it is merged, so the candidates are looked up again from there
+      is_merged = false;
+      getCandidates(grid, getCellKey(point_i), first_j, candidates);
+      for (const auto j : candidates) {
+        auto point_j = points.at(j);
+
+        double distance = boost::geometry::distance(point_i, point_j);
+        if (distance < kMergeDistance) {
+          const auto new_point = (point_i.basicPoint() + point_j.basicPoint()) / 2;
+          // const auto new_pt3d = lanelet::Point3d(lanelet::utils::getId(), new_point);
+          point_i.x() = new_point.x();
+          point_i.y() = new_point.y();
+          point_i.z() = new_point.z();
+          point_j.x() = new_point.x();
+          point_j.y() = new_point.y();
+          point_j.z() = new_point.z();
+          point_i.setId(point_j.id());
+
+          const auto new_cell = getCellKey(point_j);
+          moveInGrid(grid, j, point_cells.at(j), new_cell);
+          point_cells.at(j) = new_cell;
+          first_j = j + 1;
+          is_merged = true;
+          break;
+        }
       }
     }
+    point_cells.at(i) = getCellKey(point_i);
+    grid[point_cells.at(i)].push_back(i);
   }
 }
 
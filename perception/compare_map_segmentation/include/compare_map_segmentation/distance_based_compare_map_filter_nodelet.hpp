@@ -15,11 +15,12 @@
 #ifndef COMPARE_MAP_SEGMENTATION__DISTANCE_BASED_COMPARE_MAP_FILTER_NODELET_HPP_
 #define COMPARE_MAP_SEGMENTATION__DISTANCE_BASED_COMPARE_MAP_FILTER_NODELET_HPP_
 
+#include "compare_map_segmentation/map_tile_loader_module.hpp"
 #include "pointcloud_preprocessor/filter.hpp"
 
-#include <pcl/filters/voxel_grid.h>
 #include <pcl/search/pcl_search.h>
 
+#include <memory>
 #include <vector>
 
 namespace compare_map_segmentation
@@ -30,13 +31,10 @@ protected:
   virtual void filter(
     const PointCloud2ConstPtr & input, const IndicesPtr & indices, PointCloud2 & output);
 
-  void input_target_callback(const PointCloud2ConstPtr map);
-
 private:
-  rclcpp::Subscription<PointCloud2>::SharedPtr sub_map_;
-  PointCloudConstPtr map_ptr_;
   double distance_threshold_;
-  pcl::search::Search<pcl::PointXYZ>::Ptr tree_;
+  // search tree of every tile
+  std::unique_ptr<MapTileLoaderModule<pcl::search::Search<pcl::PointXYZ>>> map_loader_;
 
   /** \brief Parameter service callback result : needed to be hold */
   OnSetParametersCallbackHandle::SharedPtr set_param_res_;
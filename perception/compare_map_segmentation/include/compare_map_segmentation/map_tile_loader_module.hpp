@@ -0,0 +1,279 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMPARE_MAP_SEGMENTATION__MAP_TILE_LOADER_MODULE_HPP_
+#define COMPARE_MAP_SEGMENTATION__MAP_TILE_LOADER_MODULE_HPP_
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <autoware_map_msgs/srv/get_differential_point_cloud_map.hpp>
+#include <geometry_msgs/msg/point.hpp>
+#include <nav_msgs/msg/odometry.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace compare_map_segmentation
+{
+// A part of the map together with the search structure a filter builds from it
+template <class SearchT>
+struct MapTile
+{
+  std::string id;
+  pcl::PointCloud<pcl::PointXYZ>::ConstPtr cloud;
+  std::shared_ptr<SearchT> search;
+  // xy bounds of the points, empty when the tile has no point
+  float min_x{std::numeric_limits<float>::max()};
+  float min_y{std::numeric_limits<float>::max()};
+  float max_x{std::numeric_limits<float>::lowest()};
+  float max_y{std::numeric_limits<float>::lowest()};
+
+  // whether a point of the tile may be closer than margin to (x, y)
+  bool isNear(const float x, const float y, const float margin) const
+  {
+    return min_x - margin <= x && x <= max_x + margin && min_y - margin <= y &&
+           y <= max_y + margin;
+  }
+};
+
+// Keeps the map of a compare map filter as tiles, each with its own search structure.
+//
+// Without dynamic map loading, the whole map is received once on the "map" topic and becomes a
+// single tile. With it, the tiles around the ego are requested to the differential map loader
+// of map_loader whenever the ego has moved enough, so that only the new tiles are built and the
+// tiles which are too far are dropped.
+//
+// The tiles are published as an immutable snapshot, which the filters read without locking.
+template <class SearchT>
+class MapTileLoaderModule
+{
+public:
+  using PointCloud = pcl::PointCloud<pcl::PointXYZ>;
+  using Tiles = std::vector<MapTile<SearchT>>;
+  using SearchBuilder = std::function<std::shared_ptr<SearchT>(const PointCloud::ConstPtr &)>;
+  using FrameIdCallback = std::function<void(const std::string &)>;
+  using GetDifferentialPointCloudMap = autoware_map_msgs::srv::GetDifferentialPointCloudMap;
+
+  MapTileLoaderModule(
+    rclcpp::Node * node, SearchBuilder search_builder, FrameIdCallback frame_id_callback)
+  : logger_(node->get_logger()),
+    clock_(node->get_clock()),
+    search_builder_(std::move(search_builder)),
+    frame_id_callback_(std::move(frame_id_callback)),
+    tiles_(std::make_shared<const Tiles>())
+  {
+    const bool use_dynamic_map_loading =
+      node->declare_parameter<bool>("use_dynamic_map_loading", false);
+    if (!use_dynamic_map_loading) {
+      sub_map_ = node->create_subscription<sensor_msgs::msg::PointCloud2>(
+        "map", rclcpp::QoS{1}.transient_local(),
+        std::bind(&MapTileLoaderModule::onMap, this, std::placeholders::_1));
+      return;
+    }
+
+    map_update_distance_threshold_ =
+      node->declare_parameter<double>("map_update_distance_threshold", 10.0);
+    map_loader_radius_ = node->declare_parameter<double>("map_loader_radius", 150.0);
+    const int timer_interval_ms = node->declare_parameter<int>("timer_interval_ms", 100);
+
+    // the map is updated out of the filter callback, so that a slow update never delays it
+    map_callback_group_ =
+      node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+    auto sub_options = rclcpp::SubscriptionOptions();
+    sub_options.callback_group = map_callback_group_;
+    sub_kinematic_state_ = node->create_subscription<nav_msgs::msg::Odometry>(
+      "kinematic_state", rclcpp::QoS{1},
+      std::bind(&MapTileLoaderModule::onKinematicState, this, std::placeholders::_1),
+      sub_options);
+    map_loader_client_ = node->create_client<GetDifferentialPointCloudMap>(
+      "map_loader_service", rmw_qos_profile_services_default, map_callback_group_);
+    map_update_timer_ = rclcpp::create_timer(
+      node, clock_, std::chrono::milliseconds(timer_interval_ms),
+      std::bind(&MapTileLoaderModule::onTimer, this), map_callback_group_);
+  }
+
+  // the tiles at the time of the call, never modified afterwards
+  std::shared_ptr<const Tiles> getTiles() const { return std::atomic_load(&tiles_); }
+
+  // rebuild the search structures of all the tiles, e.g. after a parameter change
+  void rebuild(SearchBuilder search_builder)
+  {
+    std::scoped_lock lock(update_mutex_);
+    search_builder_ = std::move(search_builder);
+    auto tiles = std::make_shared<Tiles>(*getTiles());
+    for (auto & tile : *tiles) {
+      tile.search = search_builder_(tile.cloud);
+    }
+    std::atomic_store(&tiles_, std::shared_ptr<const Tiles>(std::move(tiles)));
+  }
+
+private:
+  MapTile<SearchT> makeTile(
+    const std::string & id, const sensor_msgs::msg::PointCloud2 & pointcloud) const
+  {
+    const auto cloud = pcl::make_shared<PointCloud>();
+    pcl::fromROSMsg<pcl::PointXYZ>(pointcloud, *cloud);
+
+    MapTile<SearchT> tile;
+    tile.id = id;
+    tile.cloud = cloud;
+    tile.search = search_builder_(cloud);
+    for (const auto & point : cloud->points) {
+      if (!std::isfinite(point.x) || !std::isfinite(point.y)) {
+        continue;
+      }
+      tile.min_x = std::min(tile.min_x, point.x);
+      tile.min_y = std::min(tile.min_y, point.y);
+      tile.max_x = std::max(tile.max_x, point.x);
+      tile.max_y = std::max(tile.max_y, point.y);
+    }
+    return tile;
+  }
+
+  void onMap(const sensor_msgs::msg::PointCloud2::ConstSharedPtr map)
+  {
+    {
+      std::scoped_lock lock(update_mutex_);
+      auto tiles = std::make_shared<Tiles>();
+      tiles->push_back(makeTile("", *map));
+      std::atomic_store(&tiles_, std::shared_ptr<const Tiles>(std::move(tiles)));
+    }
+    frame_id_callback_(map->header.frame_id);
+  }
+
+  void onKinematicState(const nav_msgs::msg::Odometry::ConstSharedPtr kinematic_state)
+  {
+    current_position_ = kinematic_state->pose.pose.position;
+  }
+
+  void onTimer()
+  {
+    if (!current_position_) {
+      RCLCPP_WARN_THROTTLE(logger_, *clock_, 5000, "Waiting for the ego position to load the map.");
+      return;
+    }
+    if (is_request_pending_) {
+      return;
+    }
+    if (last_update_position_) {
+      const double dx = current_position_->x - last_update_position_->x;
+      const double dy = current_position_->y - last_update_position_->y;
+      if (std::hypot(dx, dy) < map_update_distance_threshold_) {
+        return;
+      }
+    }
+    if (!map_loader_client_->service_is_ready()) {
+      RCLCPP_WARN_THROTTLE(
+        logger_, *clock_, 5000,
+        "Waiting for the map loader service. Check if enable_differential_load is set `true` in "
+        "pointcloud_map_loader.");
+      return;
+    }
+
+    auto request = std::make_shared<GetDifferentialPointCloudMap::Request>();
+    request->area.center = *current_position_;
+    request->area.radius = static_cast<float>(map_loader_radius_);
+    for (const auto & tile : *getTiles()) {
+      request->cached_ids.push_back(tile.id);
+    }
+
+    is_request_pending_ = true;
+    const auto request_position = *current_position_;
+    map_loader_client_->async_send_request(
+      request, [this, request_position](rclcpp::Client<GetDifferentialPointCloudMap>::SharedFuture
+                                          future) {
+        is_request_pending_ = false;
+        const auto response = future.get();
+        if (!response) {
+          return;
+        }
+        updateTiles(*response);
+        last_update_position_ = request_position;
+      });
+  }
+
+  void updateTiles(const GetDifferentialPointCloudMap::Response & response)
+  {
+    // the filters keep reading the previous snapshot while the new tiles are built
+    Tiles new_tiles;
+    new_tiles.reserve(response.new_pointcloud_with_ids.size());
+    std::string frame_id;
+    {
+      std::scoped_lock lock(update_mutex_);
+      for (const auto & pointcloud_with_id : response.new_pointcloud_with_ids) {
+        new_tiles.push_back(makeTile(pointcloud_with_id.cell_id, pointcloud_with_id.pointcloud));
+      }
+
+      auto tiles = std::make_shared<Tiles>();
+      for (const auto & tile : *getTiles()) {
+        const bool is_removed =
+          std::find(response.ids_to_remove.begin(), response.ids_to_remove.end(), tile.id) !=
+          response.ids_to_remove.end();
+        if (!is_removed) {
+          tiles->push_back(tile);
+        }
+      }
+      std::move(new_tiles.begin(), new_tiles.end(), std::back_inserter(*tiles));
+      std::atomic_store(&tiles_, std::shared_ptr<const Tiles>(std::move(tiles)));
+      frame_id = response.header.frame_id;
+    }
+    RCLCPP_DEBUG(
+      logger_, "Map tiles updated: %zu added, %zu removed.",
+      response.new_pointcloud_with_ids.size(), response.ids_to_remove.size());
+    if (!frame_id.empty()) {
+      frame_id_callback_(frame_id);
+    }
+  }
+
+  rclcpp::Logger logger_;
+  rclcpp::Clock::SharedPtr clock_;
+
+  rclcpp::Subscription<sensor_msgs::msg::PointCloud2>::SharedPtr sub_map_;
+  rclcpp::Subscription<nav_msgs::msg::Odometry>::SharedPtr sub_kinematic_state_;
+  rclcpp::Client<GetDifferentialPointCloudMap>::SharedPtr map_loader_client_;
+  rclcpp::TimerBase::SharedPtr map_update_timer_;
+  rclcpp::CallbackGroup::SharedPtr map_callback_group_;
+
+  double map_update_distance_threshold_{0.0};
+  double map_loader_radius_{0.0};
+
+  // only used from the callbacks of map_callback_group_
+  std::optional<geometry_msgs::msg::Point> current_position_;
+  std::optional<geometry_msgs::msg::Point> last_update_position_;
+  bool is_request_pending_{false};
+
+  // serializes the writers of tiles_
+  std::mutex update_mutex_;
+  SearchBuilder search_builder_;
+  FrameIdCallback frame_id_callback_;
+  std::shared_ptr<const Tiles> tiles_;
+};
+}  // namespace compare_map_segmentation
+
+#endif  // COMPARE_MAP_SEGMENTATION__MAP_TILE_LOADER_MODULE_HPP_
@@ -0,0 +1,192 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMPARE_MAP_SEGMENTATION__VOXEL_HASH_MAP_HPP_
+#define COMPARE_MAP_SEGMENTATION__VOXEL_HASH_MAP_HPP_
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace compare_map_segmentation
+{
+// Centroids of the occupied voxels of a point cloud, as pcl::VoxelGrid computes them, in an
+// open addressing hash table keyed by the packed grid coordinates. Lookups only hash an integer,
+// and the table is flat, so that probing neighbor voxels is cheap and thread safe.
+class VoxelHashMap
+{
+public:
+  void build(const pcl::PointCloud<pcl::PointXYZ> & cloud, const float leaf_size)
+  {
+    inverse_leaf_size_ = 1.0f / leaf_size;
+    keys_.assign(16, EMPTY_KEY);
+    num_voxels_ = 0;
+
+    std::vector<std::array<double, 3>> sums(keys_.size(), {0.0, 0.0, 0.0});
+    std::vector<std::uint32_t> counts(keys_.size(), 0);
+    for (const auto & point : cloud.points) {
+      std::uint64_t key;
+      if (!toKey(point.x, point.y, point.z, key)) {
+        continue;
+      }
+      if (2 * (num_voxels_ + 1) > keys_.size()) {
+        rehash(sums, counts);
+      }
+      const std::size_t slot = findSlot(key);
+      if (keys_[slot] == EMPTY_KEY) {
+        keys_[slot] = key;
+        ++num_voxels_;
+      }
+      sums[slot][0] += point.x;
+      sums[slot][1] += point.y;
+      sums[slot][2] += point.z;
+      ++counts[slot];
+    }
+
+    centroids_.assign(keys_.size(), {0.0f, 0.0f, 0.0f});
+    for (std::size_t slot = 0; slot < keys_.size(); ++slot) {
+      if (counts[slot] == 0) {
+        continue;
+      }
+      for (std::size_t i = 0; i < 3; ++i) {
+        centroids_[slot][i] = static_cast<float>(sums[slot][i] / counts[slot]);
+      }
+    }
+  }
+
+  bool empty() const { return num_voxels_ == 0; }
+
+  // whether the voxel containing the point is occupied
+  bool contains(const float x, const float y, const float z) const
+  {
+    std::uint64_t key;
+    if (empty() || !toKey(x, y, z, key)) {
+      return false;
+    }
+    return keys_[findSlot(key)] != EMPTY_KEY;
+  }
+
+  // whether the centroid of the voxel containing the point, or of one of its 26 neighbors, is
+  // closer to the point than distance
+  bool isNearCentroid(const float x, const float y, const float z, const double distance) const
+  {
+    if (empty() || !std::isfinite(x) || !std::isfinite(y) || !std::isfinite(z)) {
+      return false;
+    }
+    const int i = static_cast<int>(std::floor(x * inverse_leaf_size_));
+    const int j = static_cast<int>(std::floor(y * inverse_leaf_size_));
+    const int k = static_cast<int>(std::floor(z * inverse_leaf_size_));
+    const double sqr_distance_threshold = distance * distance;
+    for (int di = -1; di <= 1; ++di) {
+      for (int dj = -1; dj <= 1; ++dj) {
+        for (int dk = -1; dk <= 1; ++dk) {
+          std::uint64_t key;
+          if (!packKey(i + di, j + dj, k + dk, key)) {
+            continue;
+          }
+          const std::size_t slot = findSlot(key);
+          if (keys_[slot] == EMPTY_KEY) {
+            continue;
+          }
+          const double dist_x = centroids_[slot][0] - x;
+          const double dist_y = centroids_[slot][1] - y;
+          const double dist_z = centroids_[slot][2] - z;
+          if (dist_x * dist_x + dist_y * dist_y + dist_z * dist_z < sqr_distance_threshold) {
+            return true;
+          }
+        }
+      }
+    }
+    return false;
+  }
+
+private:
+  static constexpr std::uint64_t EMPTY_KEY = std::numeric_limits<std::uint64_t>::max();
+  // 21 bits per axis
+  static constexpr int KEY_BITS = 21;
+  static constexpr int KEY_BIAS = 1 << (KEY_BITS - 1);
+
+  static bool packKey(const int i, const int j, const int k, std::uint64_t & key)
+  {
+    if (
+      i < -KEY_BIAS || i >= KEY_BIAS || j < -KEY_BIAS || j >= KEY_BIAS || k < -KEY_BIAS ||
+      k >= KEY_BIAS) {
+      return false;
+    }
+    key = (static_cast<std::uint64_t>(i + KEY_BIAS) << (2 * KEY_BITS)) |
+          (static_cast<std::uint64_t>(j + KEY_BIAS) << KEY_BITS) |
+          static_cast<std::uint64_t>(k + KEY_BIAS);
+    return true;
+  }
+
+  bool toKey(const float x, const float y, const float z, std::uint64_t & key) const
+  {
+    // pcl::VoxelGrid skips non-finite points
+    if (!std::isfinite(x) || !std::isfinite(y) || !std::isfinite(z)) {
+      return false;
+    }
+    return packKey(
+      static_cast<int>(std::floor(x * inverse_leaf_size_)),
+      static_cast<int>(std::floor(y * inverse_leaf_size_)),
+      static_cast<int>(std::floor(z * inverse_leaf_size_)), key);
+  }
+
+  // slot of the key, or of the empty slot where it would be inserted, by linear probing
+  std::size_t findSlot(const std::uint64_t key) const
+  {
+    const std::size_t mask = keys_.size() - 1;
+    // the table size is a power of two, so mix the high bits into the low ones
+    std::uint64_t hash = key * 0x9E3779B97F4A7C15ULL;
+    hash ^= hash >> 32;
+    std::size_t slot = static_cast<std::size_t>(hash) & mask;
+    while (keys_[slot] != EMPTY_KEY && keys_[slot] != key) {
+      slot = (slot + 1) & mask;
+    }
+    return slot;
+  }
+
+  void rehash(std::vector<std::array<double, 3>> & sums, std::vector<std::uint32_t> & counts)
+  {
+    const auto old_keys = std::move(keys_);
+    const auto old_sums = std::move(sums);
+    const auto old_counts = std::move(counts);
+    keys_.assign(2 * old_keys.size(), EMPTY_KEY);
+    sums.assign(keys_.size(), {0.0, 0.0, 0.0});
+    counts.assign(keys_.size(), 0);
+
+    for (std::size_t old_slot = 0; old_slot < old_keys.size(); ++old_slot) {
+      if (old_keys[old_slot] == EMPTY_KEY) {
+        continue;
+      }
+      const std::size_t slot = findSlot(old_keys[old_slot]);
+      keys_[slot] = old_keys[old_slot];
+      sums[slot] = old_sums[old_slot];
+      counts[slot] = old_counts[old_slot];
+    }
+  }
+
+  float inverse_leaf_size_{1.0f};
+  std::size_t num_voxels_{0};
+  std::vector<std::uint64_t> keys_;
+  std::vector<std::array<float, 3>> centroids_;
+};
+}  // namespace compare_map_segmentation
+
+#endif  // COMPARE_MAP_SEGMENTATION__VOXEL_HASH_MAP_HPP_
@@ -16,8 +16,11 @@
 
 #include <pcl/kdtree/kdtree_flann.h>
 #include <pcl/search/kdtree.h>
-#include <pcl/segmentation/segment_differences.h>
 
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace compare_map_segmentation
@@ -30,10 +33,24 @@ DistanceBasedCompareMapFilterComponent::DistanceBasedCompareMapFilterComponent(
 {
   distance_threshold_ = static_cast<double>(declare_parameter("distance_threshold", 0.3));
 
+  map_loader_ = std::make_unique<MapTileLoaderModule<pcl::search::Search<pcl::PointXYZ>>>(
+    this,
+    [](const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & cloud) {
+      pcl::search::Search<pcl::PointXYZ>::Ptr tree;
+      if (cloud->isOrganized()) {
+        tree.reset(new pcl::search::OrganizedNeighbor<pcl::PointXYZ>());
+      } else {
+        tree.reset(new pcl::search::KdTree<pcl::PointXYZ>(false));
+      }
+      tree->setInputCloud(cloud);
+      return tree;
+    },
+    [this](const std::string & frame_id) {
+      std::scoped_lock lock(mutex_);
+      tf_input_frame_ = frame_id;
+    });
+
   using std::placeholders::_1;
-  sub_map_ = this->create_subscription<PointCloud2>(
-    "map", rclcpp::QoS{1}.transient_local(),
-    std::bind(&DistanceBasedCompareMapFilterComponent::input_target_callback, this, _1));
 
   set_param_res_ = this->add_on_set_parameters_callback(
     std::bind(&DistanceBasedCompareMapFilterComponent::paramCallback, this, _1));
@@ -44,7 +61,8 @@ void DistanceBasedCompareMapFilterComponent::filter(
   PointCloud2 & output)
 {
   std::scoped_lock lock(mutex_);
-  if (map_ptr_ == NULL || tree_ == NULL) {
+  const auto tiles = map_loader_->getTiles();
+  if (tiles->empty()) {
     output = *input;
     return;
   }
@@ -52,32 +70,27 @@ void DistanceBasedCompareMapFilterComponent::filter(
   pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_output(new pcl::PointCloud<pcl::PointXYZ>);
   pcl::fromROSMsg(*input, *pcl_input);
   pcl_output->points.reserve(pcl_input->points.size());
-  pcl::getPointCloudDifference<pcl::PointXYZ>(
-    *pcl_input, distance_threshold_ * distance_threshold_, tree_, *pcl_output);
+  std::vector<int> nn_indices(1);  // nn means nearest neighbor
+  std::vector<float> nn_distances(1);
+  for (const auto & point : pcl_input->points) {
+    // as pcl::getPointCloudDifference, which this replaces, drop the non-finite points
+    if (!std::isfinite(point.x) || !std::isfinite(point.y) || !std::isfinite(point.z)) {
+      continue;
+    }
+    const bool is_near_map = std::any_of(tiles->begin(), tiles->end(), [&](const auto & tile) {
+      return tile.isNear(point.x, point.y, static_cast<float>(distance_threshold_)) &&
+             tile.search->radiusSearch(point, distance_threshold_, nn_indices, nn_distances, 1) >
+               0;
+    });
+    if (!is_near_map) {
+      pcl_output->points.push_back(point);
+    }
+  }
 
   pcl::toROSMsg(*pcl_output, output);
   output.header = input->header;
 }
 
-void DistanceBasedCompareMapFilterComponent::input_target_callback(const PointCloud2ConstPtr map)
-{
-  pcl::PointCloud<pcl::PointXYZ> map_pcl;
-  pcl::fromROSMsg<pcl::PointXYZ>(*map, map_pcl);
-  const auto map_pcl_ptr = pcl::make_shared<pcl::PointCloud<pcl::PointXYZ>>(map_pcl);
-
-  std::scoped_lock lock(mutex_);
-  map_ptr_ = map_pcl_ptr;
-  tf_input_frame_ = map_ptr_->header.frame_id;
-  if (!tree_) {
-    if (map_ptr_->isOrganized()) {
-      tree_.reset(new pcl::search::OrganizedNeighbor<pcl::PointXYZ>());
-    } else {
-      tree_.reset(new pcl::search::KdTree<pcl::PointXYZ>(false));
-    }
-  }
-  tree_->setInputCloud(map_ptr_);
-}
-
 rcl_interfaces::msg::SetParametersResult DistanceBasedCompareMapFilterComponent::paramCallback(
   const std::vector<rclcpp::Parameter> & p)
 {
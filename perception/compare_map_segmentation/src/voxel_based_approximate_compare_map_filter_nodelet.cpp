@@ -14,16 +14,27 @@
 
 #include "compare_map_segmentation/voxel_based_approximate_compare_map_filter_nodelet.hpp"
 
-#include <pcl/kdtree/kdtree_flann.h>
-#include <pcl/search/kdtree.h>
-#include <pcl/segmentation/segment_differences.h>
-
+#include <algorithm>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace compare_map_segmentation
 {
 using pointcloud_preprocessor::get_param;
 
+namespace
+{
+MapTileLoaderModule<VoxelHashMap>::SearchBuilder makeSearchBuilder(const double leaf_size)
+{
+  return [leaf_size](const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & cloud) {
+    auto voxel_map = std::make_shared<VoxelHashMap>();
+    voxel_map->build(*cloud, static_cast<float>(leaf_size));
+    return voxel_map;
+  };
+}
+}  // namespace
+
 VoxelBasedApproximateCompareMapFilterComponent::VoxelBasedApproximateCompareMapFilterComponent(
   const rclcpp::NodeOptions & options)
 : Filter("VoxelBasedApproximateCompareMapFilter", options)
@@ -41,12 +52,13 @@ VoxelBasedApproximateCompareMapFilterComponent::VoxelBasedApproximateCompareMapF
 
   distance_threshold_ = static_cast<double>(declare_parameter("distance_threshold", 0.3));
 
-  set_map_in_voxel_grid_ = false;
+  map_loader_ = std::make_unique<MapTileLoaderModule<VoxelHashMap>>(
+    this, makeSearchBuilder(distance_threshold_), [this](const std::string & frame_id) {
+      std::scoped_lock lock(mutex_);
+      tf_input_frame_ = frame_id;
+    });
 
   using std::placeholders::_1;
-  sub_map_ = this->create_subscription<PointCloud2>(
-    "map", rclcpp::QoS{1}.transient_local(),
-    std::bind(&VoxelBasedApproximateCompareMapFilterComponent::input_target_callback, this, _1));
 
   set_param_res_ = this->add_on_set_parameters_callback(
     std::bind(&VoxelBasedApproximateCompareMapFilterComponent::paramCallback, this, _1));
@@ -57,7 +69,9 @@ void VoxelBasedApproximateCompareMapFilterComponent::filter(
   PointCloud2 & output)
 {
   std::scoped_lock lock(mutex_);
-  if (voxel_map_ptr_ == NULL) {
+  stop_watch_ptr_->toc("processing_time", true);
+  const auto tiles = map_loader_->getTiles();
+  if (tiles->empty()) {
     output = *input;
     return;
   }
@@ -65,35 +79,20 @@ void VoxelBasedApproximateCompareMapFilterComponent::filter(
   pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_output(new pcl::PointCloud<pcl::PointXYZ>);
   pcl::fromROSMsg(*input, *pcl_input);
   pcl_output->points.reserve(pcl_input->points.size());
-  for (size_t i = 0; i < pcl_input->points.size(); ++i) {
-    const int index = voxel_grid_.getCentroidIndexAt(voxel_grid_.getGridCoordinates(
-      pcl_input->points.at(i).x, pcl_input->points.at(i).y, pcl_input->points.at(i).z));
-    if (index == -1) {  // empty voxel
-      // map_ptr_->points.at(index)
-      pcl_output->points.push_back(pcl_input->points.at(i));
+  for (const auto & point : pcl_input->points) {
+    // a voxel of a tile holds points of the tile, so it is less than a voxel away from it
+    const bool is_in_map_voxel = std::any_of(tiles->begin(), tiles->end(), [&](const auto & tile) {
+      return tile.isNear(point.x, point.y, static_cast<float>(distance_threshold_)) &&
+             tile.search->contains(point.x, point.y, point.z);
+    });
+    if (!is_in_map_voxel) {
+      pcl_output->points.push_back(point);
     }
   }
 
   pcl::toROSMsg(*pcl_output, output);
   output.header = input->header;
-}
-
-void VoxelBasedApproximateCompareMapFilterComponent::input_target_callback(
-  const PointCloud2ConstPtr map)
-{
-  stop_watch_ptr_->toc("processing_time", true);
-  pcl::PointCloud<pcl::PointXYZ> map_pcl;
-  pcl::fromROSMsg<pcl::PointXYZ>(*map, map_pcl);
-  const auto map_pcl_ptr = pcl::make_shared<pcl::PointCloud<pcl::PointXYZ>>(map_pcl);
 
-  std::scoped_lock lock(mutex_);
-  set_map_in_voxel_grid_ = true;
-  tf_input_frame_ = map_pcl_ptr->header.frame_id;
-  voxel_map_ptr_.reset(new pcl::PointCloud<pcl::PointXYZ>);
-  voxel_grid_.setLeafSize(distance_threshold_, distance_threshold_, distance_threshold_);
-  voxel_grid_.setInputCloud(map_pcl_ptr);
-  voxel_grid_.setSaveLeafLayout(true);
-  voxel_grid_.filter(*voxel_map_ptr_);
   // add processing time for debug
   if (debug_publisher_) {
     const double cyclic_time_ms = stop_watch_ptr_->toc("cyclic_time", true);
@@ -112,11 +111,7 @@ VoxelBasedApproximateCompareMapFilterComponent::paramCallback(
   std::scoped_lock lock(mutex_);
 
   if (get_param(p, "distance_threshold", distance_threshold_)) {
-    voxel_grid_.setLeafSize(distance_threshold_, distance_threshold_, distance_threshold_);
-    voxel_grid_.setSaveLeafLayout(true);
-    if (set_map_in_voxel_grid_) {
-      voxel_grid_.filter(*voxel_map_ptr_);
-    }
+    map_loader_->rebuild(makeSearchBuilder(distance_threshold_));
     RCLCPP_DEBUG(get_logger(), "Setting new distance threshold to: %f.", distance_threshold_);
   }
 
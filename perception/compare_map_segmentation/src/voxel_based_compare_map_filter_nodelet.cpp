@@ -14,16 +14,30 @@
 
 #include "compare_map_segmentation/voxel_based_compare_map_filter_nodelet.hpp"
 
-#include <pcl/kdtree/kdtree_flann.h>
-#include <pcl/search/kdtree.h>
-#include <pcl/segmentation/segment_differences.h>
+#include <sensor_msgs/point_cloud2_iterator.hpp>
 
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace compare_map_segmentation
 {
 using pointcloud_preprocessor::get_param;
 
+namespace
+{
+MapTileLoaderModule<VoxelHashMap>::SearchBuilder makeSearchBuilder(const double leaf_size)
+{
+  return [leaf_size](const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & cloud) {
+    auto voxel_map = std::make_shared<VoxelHashMap>();
+    voxel_map->build(*cloud, static_cast<float>(leaf_size));
+    return voxel_map;
+  };
+}
+}  // namespace
+
 VoxelBasedCompareMapFilterComponent::VoxelBasedCompareMapFilterComponent(
   const rclcpp::NodeOptions & options)
 : Filter("VoxelBasedCompareMapFilter", options)
@@ -39,13 +53,15 @@ VoxelBasedCompareMapFilterComponent::VoxelBasedCompareMapFilterComponent(
   }
 
   distance_threshold_ = static_cast<double>(declare_parameter("distance_threshold", 0.3));
+  num_threads_ = std::max(static_cast<int>(declare_parameter("num_threads", 1)), 1);
 
-  set_map_in_voxel_grid_ = false;
+  map_loader_ = std::make_unique<MapTileLoaderModule<VoxelHashMap>>(
+    this, makeSearchBuilder(distance_threshold_), [this](const std::string & frame_id) {
+      std::scoped_lock lock(mutex_);
+      tf_input_frame_ = frame_id;
+    });
 
   using std::placeholders::_1;
-  sub_map_ = this->create_subscription<PointCloud2>(
-    "map", rclcpp::QoS{1}.transient_local(),
-    std::bind(&VoxelBasedCompareMapFilterComponent::input_target_callback, this, _1));
 
   set_param_res_ = this->add_on_set_parameters_callback(
     std::bind(&VoxelBasedCompareMapFilterComponent::paramCallback, this, _1));
@@ -57,174 +73,59 @@ void VoxelBasedCompareMapFilterComponent::filter(
 {
   std::scoped_lock lock(mutex_);
   stop_watch_ptr_->toc("processing_time", true);
-  if (voxel_map_ptr_ == NULL) {
+  const auto tiles = map_loader_->getTiles();
+  if (tiles->empty()) {
     output = *input;
     return;
   }
-  pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_input(new pcl::PointCloud<pcl::PointXYZ>);
-  pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_output(new pcl::PointCloud<pcl::PointXYZ>);
-  pcl::fromROSMsg(*input, *pcl_input);
-  pcl_output->points.reserve(pcl_input->points.size());
-  for (size_t i = 0; i < pcl_input->points.size(); ++i) {
-    const pcl::PointXYZ point = pcl_input->points.at(i);
-    if (is_in_voxel(
-          pcl::PointXYZ(point.x, point.y, point.z), point, distance_threshold_, voxel_map_ptr_,
-          voxel_grid_)) {
-      continue;
-    }
-    if (is_in_voxel(
-          pcl::PointXYZ(point.x, point.y - distance_threshold_, point.z - distance_threshold_),
-          point, distance_threshold_, voxel_map_ptr_, voxel_grid_)) {
-      continue;
-    }
-    if (is_in_voxel(
-          pcl::PointXYZ(point.x, point.y - distance_threshold_, point.z), point,
-          distance_threshold_, voxel_map_ptr_, voxel_grid_)) {
-      continue;
-    }
-    if (is_in_voxel(
-          pcl::PointXYZ(point.x, point.y - distance_threshold_, point.z + distance_threshold_),
-          point, distance_threshold_, voxel_map_ptr_, voxel_grid_)) {
-      continue;
-    }
-    if (is_in_voxel(
-          pcl::PointXYZ(point.x, point.y, point.z - distance_threshold_), point,
-          distance_threshold_, voxel_map_ptr_, voxel_grid_)) {
-      continue;
-    }
-    if (is_in_voxel(
-          pcl::PointXYZ(point.x, point.y, point.z + distance_threshold_), point,
-          distance_threshold_, voxel_map_ptr_, voxel_grid_)) {
-      continue;
-    }
-    if (is_in_voxel(
-          pcl::PointXYZ(point.x, point.y + distance_threshold_, point.z - distance_threshold_),
-          point, distance_threshold_, voxel_map_ptr_, voxel_grid_)) {
-      continue;
-    }
-    if (is_in_voxel(
-          pcl::PointXYZ(point.x, point.y + distance_threshold_, point.z), point,
-          distance_threshold_, voxel_map_ptr_, voxel_grid_)) {
-      continue;
-    }
-    if (is_in_voxel(
-          pcl::PointXYZ(point.x, point.y + distance_threshold_, point.z + distance_threshold_),
-          point, distance_threshold_, voxel_map_ptr_, voxel_grid_)) {
-      continue;
-    }
-
-    if (is_in_voxel(
-          pcl::PointXYZ(
-            point.x - distance_threshold_, point.y - distance_threshold_,
-            point.z - distance_threshold_),
-          point, distance_threshold_, voxel_map_ptr_, voxel_grid_)) {
-      continue;
-    }
-    if (is_in_voxel(
-          pcl::PointXYZ(point.x - distance_threshold_, point.y - distance_threshold_, point.z),
-          point, distance_threshold_, voxel_map_ptr_, voxel_grid_)) {
-      continue;
-    }
-    if (is_in_voxel(
-          pcl::PointXYZ(
-            point.x - distance_threshold_, point.y - distance_threshold_,
-            point.z + distance_threshold_),
-          point, distance_threshold_, voxel_map_ptr_, voxel_grid_)) {
-      continue;
-    }
-    if (is_in_voxel(
-          pcl::PointXYZ(point.x - distance_threshold_, point.y, point.z - distance_threshold_),
-          point, distance_threshold_, voxel_map_ptr_, voxel_grid_)) {
-      continue;
-    }
-    if (is_in_voxel(
-          pcl::PointXYZ(point.x - distance_threshold_, point.y, point.z), point,
-          distance_threshold_, voxel_map_ptr_, voxel_grid_)) {
-      continue;
-    }
-    if (is_in_voxel(
-          pcl::PointXYZ(point.x - distance_threshold_, point.y, point.z + distance_threshold_),
-          point, distance_threshold_, voxel_map_ptr_, voxel_grid_)) {
-      continue;
-    }
-    if (is_in_voxel(
-          pcl::PointXYZ(
-            point.x - distance_threshold_, point.y + distance_threshold_,
-            point.z - distance_threshold_),
-          point, distance_threshold_, voxel_map_ptr_, voxel_grid_)) {
-      continue;
-    }
-    if (is_in_voxel(
-          pcl::PointXYZ(point.x - distance_threshold_, point.y + distance_threshold_, point.z),
-          point, distance_threshold_, voxel_map_ptr_, voxel_grid_)) {
-      continue;
-    }
-    if (is_in_voxel(
-          pcl::PointXYZ(
-            point.x - distance_threshold_, point.y + distance_threshold_,
-            point.z + distance_threshold_),
-          point, distance_threshold_, voxel_map_ptr_, voxel_grid_)) {
-      continue;
-    }
 
-    if (is_in_voxel(
-          pcl::PointXYZ(
-            point.x + distance_threshold_, point.y - distance_threshold_,
-            point.z - distance_threshold_),
-          point, distance_threshold_, voxel_map_ptr_, voxel_grid_)) {
-      continue;
-    }
-    if (is_in_voxel(
-          pcl::PointXYZ(point.x + distance_threshold_, point.y - distance_threshold_, point.z),
-          point, distance_threshold_, voxel_map_ptr_, voxel_grid_)) {
-      continue;
-    }
-    if (is_in_voxel(
-          pcl::PointXYZ(
-            point.x + distance_threshold_, point.y - distance_threshold_,
-            point.z + distance_threshold_),
-          point, distance_threshold_, voxel_map_ptr_, voxel_grid_)) {
-      continue;
-    }
-    if (is_in_voxel(
-          pcl::PointXYZ(point.x + distance_threshold_, point.y, point.z - distance_threshold_),
-          point, distance_threshold_, voxel_map_ptr_, voxel_grid_)) {
-      continue;
-    }
-    if (is_in_voxel(
-          pcl::PointXYZ(point.x + distance_threshold_, point.y, point.z), point,
-          distance_threshold_, voxel_map_ptr_, voxel_grid_)) {
-      continue;
-    }
-    if (is_in_voxel(
-          pcl::PointXYZ(point.x + distance_threshold_, point.y, point.z + distance_threshold_),
-          point, distance_threshold_, voxel_map_ptr_, voxel_grid_)) {
-      continue;
-    }
-    if (is_in_voxel(
-          pcl::PointXYZ(
-            point.x + distance_threshold_, point.y + distance_threshold_,
-            point.z - distance_threshold_),
-          point, distance_threshold_, voxel_map_ptr_, voxel_grid_)) {
-      continue;
-    }
-    if (is_in_voxel(
-          pcl::PointXYZ(point.x + distance_threshold_, point.y + distance_threshold_, point.z),
-          point, distance_threshold_, voxel_map_ptr_, voxel_grid_)) {
-      continue;
-    }
-    if (is_in_voxel(
-          pcl::PointXYZ(
-            point.x + distance_threshold_, point.y + distance_threshold_,
-            point.z + distance_threshold_),
-          point, distance_threshold_, voxel_map_ptr_, voxel_grid_)) {
-      continue;
-    }
+  const int x_idx = pcl::getFieldIndex(*input, "x");
+  const int y_idx = pcl::getFieldIndex(*input, "y");
+  const int z_idx = pcl::getFieldIndex(*input, "z");
+  if (x_idx < 0 || y_idx < 0 || z_idx < 0) {
+    RCLCPP_ERROR(get_logger(), "The input pointcloud does not have x, y and z fields.");
+    return;
+  }
+  const std::size_t x_offset = input->fields.at(x_idx).offset;
+  const std::size_t y_offset = input->fields.at(y_idx).offset;
+  const std::size_t z_offset = input->fields.at(z_idx).offset;
+
+  // the points closer than distance_threshold_ to a map voxel centroid are removed. The voxels
+  // having the size of distance_threshold_, only the 27 voxels around a point can be that close.
+  const std::size_t num_points = static_cast<std::size_t>(input->width) * input->height;
+  std::vector<std::uint8_t> is_kept(num_points, 0);
+#pragma omp parallel for num_threads(num_threads_)
+  for (std::size_t i = 0; i < num_points; ++i) {
+    const std::uint8_t * point = &input->data[(i / input->width) * input->row_step +
+                                              (i % input->width) * input->point_step];
+    float x, y, z;
+    std::memcpy(&x, point + x_offset, sizeof(float));
+    std::memcpy(&y, point + y_offset, sizeof(float));
+    std::memcpy(&z, point + z_offset, sizeof(float));
+    is_kept[i] = std::none_of(tiles->begin(), tiles->end(), [&](const auto & tile) {
+      return tile.isNear(x, y, static_cast<float>(distance_threshold_)) &&
+             tile.search->isNearCentroid(x, y, z, distance_threshold_);
+    });
+  }
 
-    pcl_output->points.push_back(pcl_input->points.at(i));
+  // same layout as pcl::PointXYZ
+  sensor_msgs::PointCloud2Modifier modifier(output);
+  modifier.setPointCloud2FieldsByString(1, "xyz");
+  modifier.resize(std::count(is_kept.begin(), is_kept.end(), 1));
+  std::size_t output_idx = 0;
+  for (std::size_t i = 0; i < num_points; ++i) {
+    if (!is_kept[i]) {
+      continue;
+    }
+    const std::uint8_t * point = &input->data[(i / input->width) * input->row_step +
+                                              (i % input->width) * input->point_step];
+    std::uint8_t * output_point = &output.data[output_idx++ * output.point_step];
+    std::memcpy(output_point + output.fields.at(0).offset, point + x_offset, sizeof(float));
+    std::memcpy(output_point + output.fields.at(1).offset, point + y_offset, sizeof(float));
+    std::memcpy(output_point + output.fields.at(2).offset, point + z_offset, sizeof(float));
   }
-  pcl::toROSMsg(*pcl_output, output);
   output.header = input->header;
+  output.is_dense = input->is_dense;
 
   // add processing time for debug
   if (debug_publisher_) {
@@ -237,54 +138,19 @@ void VoxelBasedCompareMapFilterComponent::filter(
   }
 }
 
-bool VoxelBasedCompareMapFilterComponent::is_in_voxel(
-  const pcl::PointXYZ & src_point, const pcl::PointXYZ & target_point,
-  const double distance_threshold, const PointCloudPtr & map,
-  pcl::VoxelGrid<pcl::PointXYZ> & voxel) const
-{
-  int voxel_index =
-    voxel.getCentroidIndexAt(voxel.getGridCoordinates(src_point.x, src_point.y, src_point.z));
-  if (voxel_index != -1) {  // not empty voxel
-    const double dist_x = map->points.at(voxel_index).x - target_point.x;
-    const double dist_y = map->points.at(voxel_index).y - target_point.y;
-    const double dist_z = map->points.at(voxel_index).z - target_point.z;
-    const double sqr_distance = dist_x * dist_x + dist_y * dist_y + dist_z * dist_z;
-    if (sqr_distance < distance_threshold * distance_threshold) {
-      return true;
-    }
-  }
-  return false;
-}
-
-void VoxelBasedCompareMapFilterComponent::input_target_callback(const PointCloud2ConstPtr map)
-{
-  pcl::PointCloud<pcl::PointXYZ> map_pcl;
-  pcl::fromROSMsg<pcl::PointXYZ>(*map, map_pcl);
-  const auto map_pcl_ptr = pcl::make_shared<pcl::PointCloud<pcl::PointXYZ>>(map_pcl);
-
-  std::scoped_lock lock(mutex_);
-  set_map_in_voxel_grid_ = true;
-  tf_input_frame_ = map_pcl_ptr->header.frame_id;
-  voxel_map_ptr_.reset(new pcl::PointCloud<pcl::PointXYZ>);
-  voxel_grid_.setLeafSize(distance_threshold_, distance_threshold_, distance_threshold_);
-  voxel_grid_.setInputCloud(map_pcl_ptr);
-  voxel_grid_.setSaveLeafLayout(true);
-  voxel_grid_.filter(*voxel_map_ptr_);
-}
-
 rcl_interfaces::msg::SetParametersResult VoxelBasedCompareMapFilterComponent::paramCallback(
   const std::vector<rclcpp::Parameter> & p)
 {
   std::scoped_lock lock(mutex_);
 
   if (get_param(p, "distance_threshold", distance_threshold_)) {
-    voxel_grid_.setLeafSize(distance_threshold_, distance_threshold_, distance_threshold_);
-    voxel_grid_.setSaveLeafLayout(true);
-    if (set_map_in_voxel_grid_) {
-      voxel_grid_.filter(*voxel_map_ptr_);
-    }
+    map_loader_->rebuild(makeSearchBuilder(distance_threshold_));
     RCLCPP_DEBUG(get_logger(), "Setting new distance threshold to: %f.", distance_threshold_);
   }
+  if (get_param(p, "num_threads", num_threads_)) {
+    num_threads_ = std::max(num_threads_, 1);
+    RCLCPP_DEBUG(get_logger(), "Setting new number of threads to: %d.", num_threads_);
+  }
 
   rcl_interfaces::msg::SetParametersResult result;
   result.successful = true;
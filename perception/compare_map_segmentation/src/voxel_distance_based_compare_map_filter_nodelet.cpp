@@ -16,24 +16,48 @@
 
 #include <pcl/kdtree/kdtree_flann.h>
 #include <pcl/search/kdtree.h>
-#include <pcl/segmentation/segment_differences.h>
 
+#include <algorithm>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace compare_map_segmentation
 {
 using pointcloud_preprocessor::get_param;
 
+namespace
+{
+MapTileLoaderModule<VoxelDistanceTileSearch>::SearchBuilder makeSearchBuilder(
+  const double leaf_size)
+{
+  return [leaf_size](const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & cloud) {
+    auto search = std::make_shared<VoxelDistanceTileSearch>();
+    search->voxel_map.build(*cloud, static_cast<float>(leaf_size));
+    if (cloud->isOrganized()) {
+      search->tree.reset(new pcl::search::OrganizedNeighbor<pcl::PointXYZ>());
+    } else {
+      search->tree.reset(new pcl::search::KdTree<pcl::PointXYZ>(false));
+    }
+    search->tree->setInputCloud(cloud);
+    return search;
+  };
+}
+}  // namespace
+
 VoxelDistanceBasedCompareMapFilterComponent::VoxelDistanceBasedCompareMapFilterComponent(
   const rclcpp::NodeOptions & options)
 : Filter("VoxelDistanceBasedCompareMapFilter", options)
 {
   distance_threshold_ = static_cast<double>(declare_parameter("distance_threshold", 0.3));
 
+  map_loader_ = std::make_unique<MapTileLoaderModule<VoxelDistanceTileSearch>>(
+    this, makeSearchBuilder(distance_threshold_), [this](const std::string & frame_id) {
+      std::scoped_lock lock(mutex_);
+      tf_input_frame_ = frame_id;
+    });
+
   using std::placeholders::_1;
-  sub_map_ = this->create_subscription<PointCloud2>(
-    "map", rclcpp::QoS{1}.transient_local(),
-    std::bind(&VoxelDistanceBasedCompareMapFilterComponent::input_target_callback, this, _1));
 
   set_param_res_ = this->add_on_set_parameters_callback(
     std::bind(&VoxelDistanceBasedCompareMapFilterComponent::paramCallback, this, _1));
@@ -44,7 +68,8 @@ void VoxelDistanceBasedCompareMapFilterComponent::filter(
   PointCloud2 & output)
 {
   std::scoped_lock lock(mutex_);
-  if (voxel_map_ptr_ == NULL || map_ptr_ == NULL || tree_ == NULL) {
+  const auto tiles = map_loader_->getTiles();
+  if (tiles->empty()) {
     output = *input;
     return;
   }
@@ -52,17 +77,17 @@ void VoxelDistanceBasedCompareMapFilterComponent::filter(
   pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_output(new pcl::PointCloud<pcl::PointXYZ>);
   pcl::fromROSMsg(*input, *pcl_input);
   pcl_output->points.reserve(pcl_input->points.size());
-  for (size_t i = 0; i < pcl_input->points.size(); ++i) {
-    const int index = voxel_grid_.getCentroidIndexAt(voxel_grid_.getGridCoordinates(
-      pcl_input->points.at(i).x, pcl_input->points.at(i).y, pcl_input->points.at(i).z));
-    if (index == -1) {                 // empty voxel
-      std::vector<int> nn_indices(1);  // nn means nearest neighbor
-      std::vector<float> nn_distances(1);
-      if (
-        tree_->radiusSearch(
-          pcl_input->points.at(i), distance_threshold_, nn_indices, nn_distances, 1) == 0) {
-        pcl_output->points.push_back(pcl_input->points.at(i));
-      }
+  std::vector<int> nn_indices(1);  // nn means nearest neighbor
+  std::vector<float> nn_distances(1);
+  for (const auto & point : pcl_input->points) {
+    const auto is_near_map = [&](const auto & tile) {
+      return tile.isNear(point.x, point.y, static_cast<float>(distance_threshold_)) &&
+             (tile.search->voxel_map.contains(point.x, point.y, point.z) ||
+              tile.search->tree->radiusSearch(
+                point, distance_threshold_, nn_indices, nn_distances, 1) > 0);
+    };
+    if (std::none_of(tiles->begin(), tiles->end(), is_near_map)) {
+      pcl_output->points.push_back(point);
     }
   }
 
@@ -70,44 +95,13 @@ void VoxelDistanceBasedCompareMapFilterComponent::filter(
   output.header = input->header;
 }
 
-void VoxelDistanceBasedCompareMapFilterComponent::input_target_callback(
-  const PointCloud2ConstPtr map)
-{
-  pcl::PointCloud<pcl::PointXYZ> map_pcl;
-  pcl::fromROSMsg<pcl::PointXYZ>(*map, map_pcl);
-  const auto map_pcl_ptr = pcl::make_shared<pcl::PointCloud<pcl::PointXYZ>>(map_pcl);
-
-  std::scoped_lock lock(mutex_);
-  tf_input_frame_ = map_pcl_ptr->header.frame_id;
-  // voxel
-  voxel_map_ptr_.reset(new pcl::PointCloud<pcl::PointXYZ>);
-  voxel_grid_.setLeafSize(distance_threshold_, distance_threshold_, distance_threshold_);
-  voxel_grid_.setInputCloud(map_pcl_ptr);
-  voxel_grid_.setSaveLeafLayout(true);
-  voxel_grid_.filter(*voxel_map_ptr_);
-  // kdtree
-  map_ptr_ = map_pcl_ptr;
-  if (!tree_) {
-    if (map_ptr_->isOrganized()) {
-      tree_.reset(new pcl::search::OrganizedNeighbor<pcl::PointXYZ>());
-    } else {
-      tree_.reset(new pcl::search::KdTree<pcl::PointXYZ>(false));
-    }
-  }
-  tree_->setInputCloud(map_ptr_);
-}
-
 rcl_interfaces::msg::SetParametersResult VoxelDistanceBasedCompareMapFilterComponent::paramCallback(
   const std::vector<rclcpp::Parameter> & p)
 {
   std::scoped_lock lock(mutex_);
 
   if (get_param(p, "distance_threshold", distance_threshold_)) {
-    voxel_grid_.setLeafSize(distance_threshold_, distance_threshold_, distance_threshold_);
-    voxel_grid_.setSaveLeafLayout(true);
-    if (set_map_in_voxel_grid_) {
-      voxel_grid_.filter(*voxel_map_ptr_);
-    }
+    map_loader_->rebuild(makeSearchBuilder(distance_threshold_));
     RCLCPP_DEBUG(get_logger(), "Setting new distance threshold to: %f.", distance_threshold_);
   }
 
@@ -36,6 +36,7 @@
 
 #include <memory>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace traffic_light
@@ -67,7 +68,28 @@ private:
   lanelet::routing::RoutingGraphPtr routing_graph_ptr_;
   std::shared_ptr<const lanelet::routing::RoutingGraphContainer> overall_graphs_ptr_;
 
-  lanelet::ConstLanelets conflicting_crosswalks_;
+  // Vehicle lanelet with a traffic light that conflicts with a crosswalk of the route
+  struct ConflictingLanelet
+  {
+    lanelet::Id traffic_light_reg_elem_id;
+    lanelet::Ids traffic_light_ids;  // line string lights of the first traffic light reg elem
+    bool is_left;
+    bool is_right;
+  };
+  // Crosswalk of the route, the conflicts only depend on the map and the route so they are looked
+  // up in the routing graphs once per route
+  struct RouteCrosswalk
+  {
+    lanelet::ConstLanelet lanelet;
+    lanelet::Id related_traffic_light_id;
+    std::vector<size_t> conflicting_lanelet_indices;  // into conflicting_lanelets_
+    // conflicting lanelets with different turn directions that merge into the same lanelet
+    std::vector<std::pair<size_t, size_t>> merging_lanelet_pairs;
+  };
+
+  std::vector<RouteCrosswalk> route_crosswalks_;
+  std::vector<ConflictingLanelet> conflicting_lanelets_;
+  std::vector<bool> is_non_red_lanelet_;  // per conflicting lanelet, updated on every message
 
   void onMap(const HADMapBin::ConstSharedPtr msg);
   void onRoute(const LaneletRoute::ConstSharedPtr msg);
@@ -77,15 +99,13 @@ private:
   void setCrosswalkTrafficSignal(
     const lanelet::ConstLanelet & crosswalk, const uint8_t color, TrafficSignalArray & msg) const;
 
-  lanelet::ConstLanelets getNonRedLanelets(
-    const lanelet::ConstLanelets & lanelets, const TrafficLightIdMap & traffic_light_id_map) const;
+  bool isNonRedLanelet(
+    const ConflictingLanelet & lanelet, const TrafficLightIdMap & traffic_light_id_map) const;
 
-  uint8_t estimateCrosswalkTrafficSignal(
-    const lanelet::ConstLanelet & crosswalk, const lanelet::ConstLanelets & non_red_lanelets) const;
+  uint8_t estimateCrosswalkTrafficSignal(const RouteCrosswalk & crosswalk) const;
 
   boost::optional<uint8_t> getHighestConfidenceTrafficSignal(
-    const lanelet::ConstLineStringsOrPolygons3d & traffic_lights,
-    const TrafficLightIdMap & traffic_light_id_map) const;
+    const lanelet::Ids & traffic_light_ids, const TrafficLightIdMap & traffic_light_id_map) const;
 
   // Node param
   bool use_last_detect_color_;
@@ -15,8 +15,11 @@
 
 #include <lanelet2_extension/utility/message_conversion.hpp>
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -43,36 +46,6 @@ bool hasMergeLane(
   return false;
 }
 
-bool hasMergeLane(
-  const lanelet::ConstLanelets & lanelets,
-  const lanelet::routing::RoutingGraphPtr & routing_graph_ptr)
-{
-  for (size_t i = 0; i < lanelets.size(); ++i) {
-    for (size_t j = i + 1; j < lanelets.size(); ++j) {
-      const auto lanelet_1 = lanelets.at(i);
-      const auto lanelet_2 = lanelets.at(j);
-
-      if (lanelet_1.id() == lanelet_2.id()) {
-        continue;
-      }
-
-      const std::string turn_direction_1 = lanelet_1.attributeOr("turn_direction", "none");
-      const std::string turn_direction_2 = lanelet_2.attributeOr("turn_direction", "none");
-      if (turn_direction_1 == turn_direction_2) {
-        continue;
-      }
-
-      if (!hasMergeLane(lanelet_1, lanelet_2, routing_graph_ptr)) {
-        continue;
-      }
-
-      return true;
-    }
-  }
-
-  return false;
-}
-
 }  // namespace
 
 CrosswalkTrafficLightEstimatorNode::CrosswalkTrafficLightEstimatorNode(
@@ -137,14 +110,85 @@ void CrosswalkTrafficLightEstimatorNode::onRoute(const LaneletRoute::ConstShared
     }
   }
 
-  conflicting_crosswalks_.clear();
+  route_crosswalks_.clear();
+  conflicting_lanelets_.clear();
 
+  constexpr int VEHICLE_GRAPH_ID = 0;
+  constexpr int PEDESTRIAN_GRAPH_ID = 1;
+  std::unordered_map<lanelet::Id, size_t> crosswalk_index_map;
+  std::unordered_map<lanelet::Id, size_t> conflicting_lanelet_index_map;
   for (const auto & route_lanelet : route_lanelets) {
-    constexpr int PEDESTRIAN_GRAPH_ID = 1;
     const auto conflict_lls =
       overall_graphs_ptr_->conflictingInGraph(route_lanelet, PEDESTRIAN_GRAPH_ID);
-    for (const auto & lanelet : conflict_lls) {
-      conflicting_crosswalks_.push_back(lanelet);
+    for (const auto & crosswalk : conflict_lls) {
+      // a crosswalk conflicting with several route lanelets is output once for each of them
+      const auto cached = crosswalk_index_map.find(crosswalk.id());
+      if (cached != crosswalk_index_map.end()) {
+        route_crosswalks_.push_back(route_crosswalks_.at(cached->second));
+        continue;
+      }
+      crosswalk_index_map.emplace(crosswalk.id(), route_crosswalks_.size());
+
+      RouteCrosswalk route_crosswalk;
+      route_crosswalk.lanelet = crosswalk;
+      route_crosswalk.related_traffic_light_id =
+        std::atoi(crosswalk.attributeOr("related_traffic_light", "none").c_str());
+
+      // lanelets without traffic light are never non red, so they are left out
+      lanelet::ConstLanelets vehicle_lanelets;
+      const auto vehicle_conflict_lls =
+        overall_graphs_ptr_->conflictingInGraph(crosswalk, VEHICLE_GRAPH_ID);
+      for (const auto & lanelet : vehicle_conflict_lls) {
+        const auto tl_reg_elems = lanelet.regulatoryElementsAs<const lanelet::TrafficLight>();
+        if (tl_reg_elems.empty()) {
+          continue;
+        }
+
+        const auto [itr, inserted] =
+          conflicting_lanelet_index_map.emplace(lanelet.id(), conflicting_lanelets_.size());
+        if (inserted) {
+          const std::string turn_direction = lanelet.attributeOr("turn_direction", "none");
+          ConflictingLanelet conflicting_lanelet;
+          conflicting_lanelet.traffic_light_reg_elem_id = tl_reg_elems.front()->id();
+          for (const auto & traffic_light : tl_reg_elems.front()->trafficLights()) {
+            if (traffic_light.isLineString()) {
+              conflicting_lanelet.traffic_light_ids.push_back(
+                static_cast<lanelet::ConstLineString3d>(traffic_light).id());
+            }
+          }
+          conflicting_lanelet.is_left = turn_direction == "left";
+          conflicting_lanelet.is_right = turn_direction == "right";
+          conflicting_lanelets_.push_back(conflicting_lanelet);
+        }
+
+        auto & indices = route_crosswalk.conflicting_lanelet_indices;
+        if (std::find(indices.begin(), indices.end(), itr->second) == indices.end()) {
+          indices.push_back(itr->second);
+          vehicle_lanelets.push_back(lanelet);
+        }
+      }
+
+      for (size_t i = 0; i < vehicle_lanelets.size(); ++i) {
+        for (size_t j = i + 1; j < vehicle_lanelets.size(); ++j) {
+          const std::string turn_direction_1 =
+            vehicle_lanelets.at(i).attributeOr("turn_direction", "none");
+          const std::string turn_direction_2 =
+            vehicle_lanelets.at(j).attributeOr("turn_direction", "none");
+          if (turn_direction_1 == turn_direction_2) {
+            continue;
+          }
+
+          if (!hasMergeLane(vehicle_lanelets.at(i), vehicle_lanelets.at(j), routing_graph_ptr_)) {
+            continue;
+          }
+
+          route_crosswalk.merging_lanelet_pairs.emplace_back(
+            route_crosswalk.conflicting_lanelet_indices.at(i),
+            route_crosswalk.conflicting_lanelet_indices.at(j));
+        }
+      }
+
+      route_crosswalks_.push_back(std::move(route_crosswalk));
     }
   }
 }
@@ -162,13 +206,14 @@ void CrosswalkTrafficLightEstimatorNode::onTrafficLightArray(
     traffic_light_id_map[traffic_signal.map_primitive_id] = traffic_signal;
   }
 
-  for (const auto & crosswalk : conflicting_crosswalks_) {
-    constexpr int VEHICLE_GRAPH_ID = 0;
-    const auto conflict_lls = overall_graphs_ptr_->conflictingInGraph(crosswalk, VEHICLE_GRAPH_ID);
-    const auto non_red_lanelets = getNonRedLanelets(conflict_lls, traffic_light_id_map);
+  is_non_red_lanelet_.resize(conflicting_lanelets_.size());
+  for (size_t i = 0; i < conflicting_lanelets_.size(); ++i) {
+    is_non_red_lanelet_.at(i) = isNonRedLanelet(conflicting_lanelets_.at(i), traffic_light_id_map);
+  }
 
-    const auto crosswalk_tl_color = estimateCrosswalkTrafficSignal(crosswalk, non_red_lanelets);
-    setCrosswalkTrafficSignal(crosswalk, crosswalk_tl_color, output);
+  for (const auto & crosswalk : route_crosswalks_) {
+    const auto crosswalk_tl_color = estimateCrosswalkTrafficSignal(crosswalk);
+    setCrosswalkTrafficSignal(crosswalk.lanelet, crosswalk_tl_color, output);
   }
 
   updateLastDetectedSignal(traffic_light_id_map);
@@ -236,76 +281,57 @@ void CrosswalkTrafficLightEstimatorNode::setCrosswalkTrafficSignal(
   }
 }
 
-lanelet::ConstLanelets CrosswalkTrafficLightEstimatorNode::getNonRedLanelets(
-  const lanelet::ConstLanelets & lanelets, const TrafficLightIdMap & traffic_light_id_map) const
+bool CrosswalkTrafficLightEstimatorNode::isNonRedLanelet(
+  const ConflictingLanelet & lanelet, const TrafficLightIdMap & traffic_light_id_map) const
 {
-  lanelet::ConstLanelets non_red_lanelets{};
-
-  for (const auto & lanelet : lanelets) {
-    const auto tl_reg_elems = lanelet.regulatoryElementsAs<const lanelet::TrafficLight>();
-
-    if (tl_reg_elems.empty()) {
-      continue;
-    }
-
-    const auto tl_reg_elem = tl_reg_elems.front();
-    const auto traffic_lights_for_vehicle = tl_reg_elem->trafficLights();
-
-    const auto current_detected_signal =
-      getHighestConfidenceTrafficSignal(traffic_lights_for_vehicle, traffic_light_id_map);
-
-    if (!current_detected_signal) {
-      continue;
-    }
-
-    const auto is_not_read = current_detected_signal.get() == TrafficLight::GREEN ||
-                             current_detected_signal.get() == TrafficLight::AMBER;
-
-    const auto last_detected_signal =
-      getHighestConfidenceTrafficSignal(traffic_lights_for_vehicle, last_detect_color_);
+  const auto current_detected_signal =
+    getHighestConfidenceTrafficSignal(lanelet.traffic_light_ids, traffic_light_id_map);
 
-    if (!last_detected_signal) {
-      continue;
-    }
+  if (!current_detected_signal) {
+    return false;
+  }
 
-    const auto was_not_read = current_detected_signal.get() == TrafficLight::UNKNOWN &&
-                              (last_detected_signal.get() == TrafficLight::GREEN ||
-                               last_detected_signal.get() == TrafficLight::AMBER) &&
-                              use_last_detect_color_;
+  const auto is_not_read = current_detected_signal.get() == TrafficLight::GREEN ||
+                           current_detected_signal.get() == TrafficLight::AMBER;
 
-    if (!is_not_read && !was_not_read) {
-      continue;
-    }
+  const auto last_detected_signal =
+    getHighestConfidenceTrafficSignal(lanelet.traffic_light_ids, last_detect_color_);
 
-    non_red_lanelets.push_back(lanelet);
+  if (!last_detected_signal) {
+    return false;
   }
 
-  return non_red_lanelets;
+  const auto was_not_read = current_detected_signal.get() == TrafficLight::UNKNOWN &&
+                            (last_detected_signal.get() == TrafficLight::GREEN ||
+                             last_detected_signal.get() == TrafficLight::AMBER) &&
+                            use_last_detect_color_;
+
+  return is_not_read || was_not_read;
 }
 
 uint8_t CrosswalkTrafficLightEstimatorNode::estimateCrosswalkTrafficSignal(
-  const lanelet::ConstLanelet & crosswalk, const lanelet::ConstLanelets & non_red_lanelets) const
+  const RouteCrosswalk & crosswalk) const
 {
   bool has_left_non_red_lane = false;
   bool has_right_non_red_lane = false;
   bool has_straight_non_red_lane = false;
   bool has_related_non_red_tl = false;
 
-  const std::string related_tl_id = crosswalk.attributeOr("related_traffic_light", "none");
-
-  for (const auto & lanelet : non_red_lanelets) {
-    const std::string turn_direction = lanelet.attributeOr("turn_direction", "none");
+  for (const auto lanelet_idx : crosswalk.conflicting_lanelet_indices) {
+    if (!is_non_red_lanelet_.at(lanelet_idx)) {
+      continue;
+    }
 
-    if (turn_direction == "left") {
+    const auto & lanelet = conflicting_lanelets_.at(lanelet_idx);
+    if (lanelet.is_left) {
       has_left_non_red_lane = true;
-    } else if (turn_direction == "right") {
+    } else if (lanelet.is_right) {
       has_right_non_red_lane = true;
     } else {
       has_straight_non_red_lane = true;
     }
 
-    const auto tl_reg_elems = lanelet.regulatoryElementsAs<const lanelet::TrafficLight>();
-    if (tl_reg_elems.front()->id() == std::atoi(related_tl_id.c_str())) {
+    if (lanelet.traffic_light_reg_elem_id == crosswalk.related_traffic_light_id) {
       has_related_non_red_tl = true;
     }
   }
@@ -314,24 +340,22 @@ uint8_t CrosswalkTrafficLightEstimatorNode::estimateCrosswalkTrafficSignal(
     return TrafficLight::RED;
   }
 
-  const auto has_merge_lane = hasMergeLane(non_red_lanelets, routing_graph_ptr_);
+  const auto has_merge_lane = std::any_of(
+    crosswalk.merging_lanelet_pairs.begin(), crosswalk.merging_lanelet_pairs.end(),
+    [this](const auto & pair) {
+      return is_non_red_lanelet_.at(pair.first) && is_non_red_lanelet_.at(pair.second);
+    });
   return !has_merge_lane && has_left_non_red_lane && has_right_non_red_lane ? TrafficLight::RED
                                                                             : TrafficLight::UNKNOWN;
 }
 
 boost::optional<uint8_t> CrosswalkTrafficLightEstimatorNode::getHighestConfidenceTrafficSignal(
-  const lanelet::ConstLineStringsOrPolygons3d & traffic_lights,
-  const TrafficLightIdMap & traffic_light_id_map) const
+  const lanelet::Ids & traffic_light_ids, const TrafficLightIdMap & traffic_light_id_map) const
 {
   boost::optional<uint8_t> ret{boost::none};
 
   double highest_confidence = 0.0;
-  for (const auto & traffic_light : traffic_lights) {
-    if (!traffic_light.isLineString()) {
-      continue;
-    }
-
-    const int id = static_cast<lanelet::ConstLineString3d>(traffic_light).id();
+  for (const auto id : traffic_light_ids) {
     if (traffic_light_id_map.count(id) == 0) {
       continue;
     }
@@ -25,15 +25,18 @@
 #include <autoware_auto_mapping_msgs/msg/had_map_bin.hpp>
 #include <autoware_auto_perception_msgs/msg/detected_objects.hpp>
 
+#include <boost/geometry/index/rtree.hpp>
+
 #include <tf2_ros/buffer.h>
 #include <tf2_ros/transform_listener.h>
 
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace object_lanelet_filter
 {
-using tier4_autoware_utils::LinearRing2d;
-using tier4_autoware_utils::MultiPoint2d;
+using tier4_autoware_utils::Box2d;
 using tier4_autoware_utils::Point2d;
 using tier4_autoware_utils::Polygon2d;
 
@@ -51,7 +54,10 @@ private:
   rclcpp::Subscription<autoware_auto_perception_msgs::msg::DetectedObjects>::SharedPtr object_sub_;
 
   lanelet::LaneletMapPtr lanelet_map_ptr_;
-  lanelet::ConstLanelets road_lanelets_;
+  // polygons of the road lanelets with an rtree of their envelopes, built once on map load
+  std::vector<lanelet::BasicPolygon2d> road_polygons_;
+  boost::geometry::index::rtree<std::pair<Box2d, size_t>, boost::geometry::index::rstar<16>>
+    road_polygons_rtree_;
   std::string lanelet_frame_id_;
 
   tf2_ros::Buffer tf_buffer_;
@@ -59,10 +65,11 @@ private:
 
   utils::FilterTargetLabel filter_target_;
 
-  LinearRing2d getConvexHull(const autoware_auto_perception_msgs::msg::DetectedObjects &);
-  lanelet::ConstLanelets getIntersectedLanelets(
-    const LinearRing2d &, const lanelet::ConstLanelets &);
-  bool isPolygonOverlapLanelets(const Polygon2d &, const lanelet::ConstLanelets &);
+  // footprint of the current object, kept to reuse its memory
+  Polygon2d footprint_polygon_;
+
+  void setFootprintPolygon(const autoware_auto_perception_msgs::msg::DetectedObject &);
+  bool isPolygonOverlapLanelets(const Polygon2d &) const;
 };
 
 }  // namespace object_lanelet_filter
@@ -69,18 +69,16 @@ public:
     pointcloud_within_polygon_->clear();
   }
 
-  void addNeighborPointcloud(const pcl::PointCloud<pcl::PointXY>::Ptr & input)
+  void addNeighborPointcloud(const pcl::PointCloud<pcl::PointXYZ> & input)
   {
-    pcl::PointCloud<pcl::PointXYZ>::Ptr input_xyz = toXYZ(input);
-    for (const auto & point : *input_xyz) {
+    for (const auto & point : input) {
       neighbor_pointcloud_->push_back(point);
     }
   }
 
-  void addPointcloudWithinPolygon(const pcl::PointCloud<pcl::PointXYZ>::Ptr & input)
+  void addPointcloudWithinPolygon(const pcl::PointCloud<pcl::PointXYZ> & input)
   {
-    // pcl::PointCloud<pcl::PointXYZ>::Ptr input_xyz = toXYZ(input);
-    for (const auto & point : *input) {
+    for (const auto & point : input) {
       pointcloud_within_polygon_->push_back(point);
     }
   }
@@ -92,18 +90,6 @@ private:
   rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr pointcloud_within_polygon_pub_;
   pcl::PointCloud<pcl::PointXYZ>::Ptr neighbor_pointcloud_;
   pcl::PointCloud<pcl::PointXYZ>::Ptr pointcloud_within_polygon_;
-
-private:
-  inline pcl::PointCloud<pcl::PointXYZ>::Ptr toXYZ(
-    const pcl::PointCloud<pcl::PointXY>::Ptr & pointcloud)
-  {
-    pcl::PointCloud<pcl::PointXYZ>::Ptr pointcloud_xyz(new pcl::PointCloud<pcl::PointXYZ>);
-    pointcloud_xyz->reserve(pointcloud->size());
-    for (const auto & point : *pointcloud) {
-      pointcloud_xyz->push_back(pcl::PointXYZ(point.x, point.y, 0.0));
-    }
-    return pointcloud_xyz;
-  }
 };
 }  // namespace obstacle_pointcloud_based_validator
 
@@ -16,10 +16,12 @@
 #define OBSTACLE_POINTCLOUD_BASED_VALIDATOR__OBSTACLE_POINTCLOUD_BASED_VALIDATOR_HPP_
 
 #include "obstacle_pointcloud_based_validator/debugger.hpp"
+#include "obstacle_pointcloud_based_validator/point_grid.hpp"
 
 #include <rclcpp/rclcpp.hpp>
 
 #include <autoware_auto_perception_msgs/msg/detected_objects.hpp>
+#include <geometry_msgs/msg/point.hpp>
 #include <sensor_msgs/msg/point_cloud2.hpp>
 
 #include <message_filters/subscriber.h>
@@ -59,6 +61,8 @@ private:
   typedef message_filters::Synchronizer<SyncPolicy> Sync;
   Sync sync_;
   PointsNumThresholdParam points_num_threshold_param_;
+  float grid_cell_size_;
+  int num_threads_;
 
   std::shared_ptr<Debugger> debugger_;
 
@@ -68,7 +72,10 @@ private:
     const sensor_msgs::msg::PointCloud2::ConstSharedPtr & input_obstacle_pointcloud);
   std::optional<size_t> getPointCloudNumWithinPolygon(
     const autoware_auto_perception_msgs::msg::DetectedObject & object,
-    const pcl::PointCloud<pcl::PointXY>::Ptr pointcloud);
+    const PointGrid2d & obstacle_grid, pcl::PointCloud<pcl::PointXYZ> * pointcloud_within_polygon);
+  void getNeighborPointcloud(
+    const PointGrid2d & obstacle_grid, const geometry_msgs::msg::Point & center, const float radius,
+    pcl::PointCloud<pcl::PointXYZ> & neighbor_pointcloud);
   std::optional<float> getMaxRadius(
     const autoware_auto_perception_msgs::msg::DetectedObject & object);
 };
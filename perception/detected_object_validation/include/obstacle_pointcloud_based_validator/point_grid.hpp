@@ -0,0 +1,135 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OBSTACLE_POINTCLOUD_BASED_VALIDATOR__POINT_GRID_HPP_
+#define OBSTACLE_POINTCLOUD_BASED_VALIDATOR__POINT_GRID_HPP_
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace obstacle_pointcloud_based_validator
+{
+// xy points binned into a regular grid, and stored cell by cell so that the points of a range of
+// cells are contiguous. Building is a counting sort, and the grid is read-only afterwards, so
+// that it can be queried from several threads.
+class PointGrid2d
+{
+public:
+  PointGrid2d(const pcl::PointCloud<pcl::PointXY> & pointcloud, const float cell_size)
+  {
+    float min_x = std::numeric_limits<float>::max();
+    float min_y = std::numeric_limits<float>::max();
+    float max_x = std::numeric_limits<float>::lowest();
+    float max_y = std::numeric_limits<float>::lowest();
+    for (const auto & point : pointcloud) {
+      if (!std::isfinite(point.x) || !std::isfinite(point.y)) continue;
+      min_x = std::min(min_x, point.x);
+      min_y = std::min(min_y, point.y);
+      max_x = std::max(max_x, point.x);
+      max_y = std::max(max_y, point.y);
+    }
+    if (max_x < min_x) return;  // no finite point
+
+    // a few outliers far away must not make the grid huge
+    cell_size_ = std::max(
+      {cell_size, (max_x - min_x) / MAX_CELLS_PER_AXIS, (max_y - min_y) / MAX_CELLS_PER_AXIS});
+    min_x_ = min_x;
+    min_y_ = min_y;
+    max_x_ = max_x;
+    max_y_ = max_y;
+    size_x_ = static_cast<int>((max_x - min_x) / cell_size_) + 1;
+    size_y_ = static_cast<int>((max_y - min_y) / cell_size_) + 1;
+
+    std::vector<std::size_t> cell_indices(pointcloud.size());
+    cell_begins_.assign(static_cast<std::size_t>(size_x_) * size_y_ + 1, 0);
+    for (std::size_t i = 0; i < pointcloud.size(); ++i) {
+      const auto & point = pointcloud[i];
+      if (!std::isfinite(point.x) || !std::isfinite(point.y)) {
+        cell_indices[i] = cell_begins_.size();
+        continue;
+      }
+      cell_indices[i] = toCellIndex(toCellX(point.x), toCellY(point.y));
+      ++cell_begins_[cell_indices[i] + 1];
+    }
+    for (std::size_t cell = 1; cell < cell_begins_.size(); ++cell) {
+      cell_begins_[cell] += cell_begins_[cell - 1];
+    }
+    points_.resize(cell_begins_.back());
+    std::vector<std::size_t> cell_ends(cell_begins_.begin(), cell_begins_.end() - 1);
+    for (std::size_t i = 0; i < pointcloud.size(); ++i) {
+      if (cell_indices[i] < cell_ends.size()) {
+        points_[cell_ends[cell_indices[i]]++] = pointcloud[i];
+      }
+    }
+  }
+
+  // calls function for every point of the cells overlapping the box
+  template <typename Function>
+  void forEachPointInBox(
+    const float min_x, const float min_y, const float max_x, const float max_y,
+    Function && function) const
+  {
+    if (points_.empty() || max_x < min_x_ || max_y < min_y_ || max_x_ < min_x || max_y_ < min_y) {
+      return;
+    }
+    const int begin_x = toCellX(std::max(min_x, min_x_));
+    const int begin_y = toCellY(std::max(min_y, min_y_));
+    const int end_x = toCellX(max_x);
+    const int end_y = toCellY(max_y);
+    for (int y = begin_y; y <= end_y; ++y) {
+      // the cells of a row are contiguous
+      const auto begin = cell_begins_[toCellIndex(begin_x, y)];
+      const auto end = cell_begins_[toCellIndex(end_x, y) + 1];
+      for (auto i = begin; i < end; ++i) {
+        function(points_[i]);
+      }
+    }
+  }
+
+private:
+  static constexpr float MAX_CELLS_PER_AXIS = 4096.0f;
+
+  int toCellX(const float x) const
+  {
+    return std::clamp(static_cast<int>((x - min_x_) / cell_size_), 0, size_x_ - 1);
+  }
+  int toCellY(const float y) const
+  {
+    return std::clamp(static_cast<int>((y - min_y_) / cell_size_), 0, size_y_ - 1);
+  }
+  std::size_t toCellIndex(const int x, const int y) const
+  {
+    return static_cast<std::size_t>(y) * size_x_ + x;
+  }
+
+  float cell_size_{1.0f};
+  float min_x_{0.0f};
+  float min_y_{0.0f};
+  float max_x_{0.0f};
+  float max_y_{0.0f};
+  int size_x_{0};
+  int size_y_{0};
+  // points of the cell i are points_[cell_begins_[i]] to points_[cell_begins_[i + 1]]
+  std::vector<std::size_t> cell_begins_;
+  std::vector<pcl::PointXY> points_;
+};
+}  // namespace obstacle_pointcloud_based_validator
+
+#endif  // OBSTACLE_POINTCLOUD_BASED_VALIDATOR__POINT_GRID_HPP_
@@ -50,13 +50,17 @@ private:
   Sync sync_;
   float mean_threshold_;
   bool enable_debug_;
+  cv::Mat mask_buffer_;  // reused by getMeanOccupancy(), grown to the largest footprint seen
 
   void onObjectsAndOccGrid(
     const autoware_auto_perception_msgs::msg::DetectedObjects::ConstSharedPtr & input_objects,
     const nav_msgs::msg::OccupancyGrid::ConstSharedPtr & input_occ_grid);
 
   cv::Mat fromOccupancyGrid(const nav_msgs::msg::OccupancyGrid & occupancy_grid);
-  std::optional<cv::Mat> getMask(
+  std::optional<std::vector<cv::Point>> getPixelVertices(
+    const nav_msgs::msg::OccupancyGrid & occupancy_grid,
+    const autoware_auto_perception_msgs::msg::DetectedObject & object);
+  std::optional<float> getMeanOccupancy(
     const nav_msgs::msg::OccupancyGrid & occupancy_grid,
     const autoware_auto_perception_msgs::msg::DetectedObject & object);
   std::optional<cv::Mat> getMask(
@@ -64,7 +68,7 @@ private:
     const autoware_auto_perception_msgs::msg::DetectedObject & object, cv::Mat mask);
   void showDebugImage(
     const nav_msgs::msg::OccupancyGrid & ros_occ_grid,
-    const autoware_auto_perception_msgs::msg::DetectedObjects & objects, const cv::Mat & occ_grid);
+    const autoware_auto_perception_msgs::msg::DetectedObjects & objects);
 };
 }  // namespace occupancy_grid_based_validator
 
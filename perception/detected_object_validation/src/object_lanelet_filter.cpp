@@ -17,9 +17,8 @@
 #include <perception_utils/perception_utils.hpp>
 #include <tier4_autoware_utils/tier4_autoware_utils.hpp>
 
-#include <boost/geometry/algorithms/convex_hull.hpp>
 #include <boost/geometry/algorithms/disjoint.hpp>
-#include <boost/geometry/algorithms/intersects.hpp>
+#include <boost/geometry/algorithms/envelope.hpp>
 
 #include <lanelet2_core/geometry/Polygon.h>
 
@@ -59,7 +58,17 @@ void ObjectLaneletFilterNode::mapCallback(
   lanelet_map_ptr_ = std::make_shared<lanelet::LaneletMap>();
   lanelet::utils::conversion::fromBinMsg(*map_msg, lanelet_map_ptr_);
   const lanelet::ConstLanelets all_lanelets = lanelet::utils::query::laneletLayer(lanelet_map_ptr_);
-  road_lanelets_ = lanelet::utils::query::roadLanelets(all_lanelets);
+  const lanelet::ConstLanelets road_lanelets = lanelet::utils::query::roadLanelets(all_lanelets);
+
+  road_polygons_.clear();
+  std::vector<std::pair<Box2d, size_t>> envelopes;
+  for (const auto & road_lanelet : road_lanelets) {
+    road_polygons_.push_back(road_lanelet.polygon2d().basicPolygon());
+    Box2d envelope;
+    boost::geometry::envelope(road_polygons_.back(), envelope);
+    envelopes.emplace_back(envelope, road_polygons_.size() - 1);
+  }
+  road_polygons_rtree_ = decltype(road_polygons_rtree_)(envelopes);
 }
 
 void ObjectLaneletFilterNode::objectCallback(
@@ -82,24 +91,12 @@ void ObjectLaneletFilterNode::objectCallback(
     return;
   }
 
-  // calculate convex hull
-  const auto convex_hull = getConvexHull(transformed_objects);
-  // get intersected lanelets
-  lanelet::ConstLanelets intersected_lanelets = getIntersectedLanelets(convex_hull, road_lanelets_);
-
   int index = 0;
   for (const auto & object : transformed_objects.objects) {
-    const auto & footprint = object.shape.footprint;
     const auto & label = object.classification.front().label;
     if (filter_target_.isTarget(label)) {
-      Polygon2d polygon;
-      for (const auto & point : footprint.points) {
-        const geometry_msgs::msg::Point32 point_transformed =
-          tier4_autoware_utils::transformPoint(point, object.kinematics.pose_with_covariance.pose);
-        polygon.outer().emplace_back(point_transformed.x, point_transformed.y);
-      }
-      polygon.outer().push_back(polygon.outer().front());
-      if (isPolygonOverlapLanelets(polygon, intersected_lanelets)) {
+      setFootprintPolygon(object);
+      if (isPolygonOverlapLanelets(footprint_polygon_)) {
         output_object_msg.objects.emplace_back(input_msg->objects.at(index));
       }
     } else {
@@ -110,40 +107,33 @@ void ObjectLaneletFilterNode::objectCallback(
   object_pub_->publish(output_object_msg);
 }
 
-LinearRing2d ObjectLaneletFilterNode::getConvexHull(
-  const autoware_auto_perception_msgs::msg::DetectedObjects & detected_objects)
+void ObjectLaneletFilterNode::setFootprintPolygon(
+  const autoware_auto_perception_msgs::msg::DetectedObject & object)
 {
-  MultiPoint2d candidate_points;
-  for (const auto & object : detected_objects.objects) {
-    const auto & pos = object.kinematics.pose_with_covariance.pose.position;
-    for (const auto & p : object.shape.footprint.points) {
-      candidate_points.emplace_back(p.x + pos.x, p.y + pos.y);
-    }
+  const auto & footprint = object.shape.footprint;
+  if (footprint.points.empty()) {
+    // bounding box and cylinder shapes have no footprint
+    footprint_polygon_ = tier4_autoware_utils::toPolygon2d(object);
+    return;
   }
 
-  LinearRing2d convex_hull;
-  boost::geometry::convex_hull(candidate_points, convex_hull);
-
-  return convex_hull;
-}
-
-lanelet::ConstLanelets ObjectLaneletFilterNode::getIntersectedLanelets(
-  const LinearRing2d & convex_hull, const lanelet::ConstLanelets & road_lanelets)
-{
-  lanelet::ConstLanelets intersected_lanelets;
-  for (const auto & road_lanelet : road_lanelets) {
-    if (boost::geometry::intersects(convex_hull, road_lanelet.polygon2d().basicPolygon())) {
-      intersected_lanelets.emplace_back(road_lanelet);
-    }
+  footprint_polygon_.outer().clear();
+  for (const auto & point : footprint.points) {
+    const geometry_msgs::msg::Point32 point_transformed =
+      tier4_autoware_utils::transformPoint(point, object.kinematics.pose_with_covariance.pose);
+    footprint_polygon_.outer().emplace_back(point_transformed.x, point_transformed.y);
   }
-  return intersected_lanelets;
+  footprint_polygon_.outer().push_back(footprint_polygon_.outer().front());
 }
 
-bool ObjectLaneletFilterNode::isPolygonOverlapLanelets(
-  const Polygon2d & polygon, const lanelet::ConstLanelets & intersected_lanelets)
+bool ObjectLaneletFilterNode::isPolygonOverlapLanelets(const Polygon2d & polygon) const
 {
-  for (const auto & lanelet : intersected_lanelets) {
-    if (!boost::geometry::disjoint(polygon, lanelet.polygon2d().basicPolygon())) {
+  Box2d envelope;
+  boost::geometry::envelope(polygon, envelope);
+  // the query is iterated instead of copied out so that it stops at the first overlapped lanelet
+  for (auto itr = road_polygons_rtree_.qbegin(boost::geometry::index::intersects(envelope));
+       itr != road_polygons_rtree_.qend(); ++itr) {
+    if (!boost::geometry::disjoint(polygon, road_polygons_.at(itr->second))) {
       return true;
     }
   }
@@ -19,10 +19,6 @@
 
 #include <boost/geometry.hpp>
 
-#include <pcl/filters/crop_hull.h>
-#include <pcl/kdtree/kdtree_flann.h>
-#include <pcl/search/kdtree.h>
-#include <pcl/search/pcl_search.h>
 #include <pcl_conversions/pcl_conversions.h>
 
 #ifdef ROS_DISTRO_GALACTIC
@@ -35,35 +31,33 @@
 #include <Eigen/Core>
 #include <Eigen/Geometry>
 
-namespace
-{
-inline pcl::PointXY toPCL(const double x, const double y)
-{
-  pcl::PointXY pcl_point;
-  pcl_point.x = x;
-  pcl_point.y = y;
-  return pcl_point;
-}
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <vector>
 
-inline pcl::PointXY toPCL(const geometry_msgs::msg::Point & point)
+namespace
 {
-  return toPCL(point.x, point.y);
-}
-
 inline pcl::PointXYZ toXYZ(const pcl::PointXY & point)
 {
   return pcl::PointXYZ(point.x, point.y, 0.0);
 }
 
-inline pcl::PointCloud<pcl::PointXYZ>::Ptr toXYZ(
-  const pcl::PointCloud<pcl::PointXY>::Ptr & pointcloud)
+// crossing number test, as pcl::CropHull does in 2D
+template <typename Ring>
+bool isInPolygon(const Ring & ring, const pcl::PointXY & point)
 {
-  pcl::PointCloud<pcl::PointXYZ>::Ptr pointcloud_xyz(new pcl::PointCloud<pcl::PointXYZ>);
-  pointcloud_xyz->reserve(pointcloud->size());
-  for (const auto & point : *pointcloud) {
-    pointcloud_xyz->push_back(toXYZ(point));
+  bool is_in = false;
+  for (size_t i = 0, j = ring.size() - 1; i < ring.size(); j = i++) {
+    const float xi = ring.at(i).x();
+    const float yi = ring.at(i).y();
+    const float xj = ring.at(j).x();
+    const float yj = ring.at(j).y();
+    if ((yi > point.y) != (yj > point.y) && point.x < (xj - xi) * (point.y - yi) / (yj - yi) + xi) {
+      is_in = !is_in;
+    }
   }
-  return pointcloud_xyz;
+  return is_in;
 }
 
 }  // namespace
@@ -97,6 +91,12 @@ ObstaclePointCloudBasedValidator::ObstaclePointCloudBasedValidator(
   points_num_threshold_param_.min_points_and_distance_ratio =
     declare_parameter<float>("min_points_and_distance_ratio", 800.0);
 
+  grid_cell_size_ = declare_parameter<float>("grid_cell_size", 1.0);
+  if (!(grid_cell_size_ > 0.0f)) {
+    throw std::invalid_argument("grid_cell_size must be positive");
+  }
+  num_threads_ = std::max(declare_parameter<int>("num_threads", 1), 1);
+
   const bool enable_debugger = declare_parameter<bool>("enable_debugger", false);
   if (enable_debugger) debugger_ = std::make_shared<Debugger>(this);
 }
@@ -127,47 +127,58 @@ void ObstaclePointCloudBasedValidator::onObjectsAndObstaclePointCloud(
     return;
   }
 
-  // Create Kd-tree to search neighbor pointcloud to reduce cost.
-  pcl::search::Search<pcl::PointXY>::Ptr kdtree =
-    pcl::make_shared<pcl::search::KdTree<pcl::PointXY>>(false);
-  kdtree->setInputCloud(obstacle_pointcloud);
+  // Bin the pointcloud once, so that each object only visits the points around its polygon.
+  const PointGrid2d obstacle_grid(*obstacle_pointcloud, grid_cell_size_);
+
+  const auto num_objects = transformed_objects.objects.size();
+  std::vector<std::optional<float>> search_radii(num_objects);
+  for (size_t i = 0; i < num_objects; ++i) {
+    search_radii.at(i) = getMaxRadius(transformed_objects.objects.at(i));
+  }
 
-  for (size_t i = 0; i < transformed_objects.objects.size(); ++i) {
+  std::vector<std::optional<size_t>> points_nums(num_objects);
+  std::vector<pcl::PointCloud<pcl::PointXYZ>> neighbor_pointclouds(debugger_ ? num_objects : 0);
+  std::vector<pcl::PointCloud<pcl::PointXYZ>> pointclouds_within_polygon(
+    debugger_ ? num_objects : 0);
+#pragma omp parallel for num_threads(num_threads_)
+  for (size_t i = 0; i < num_objects; ++i) {
     const auto & transformed_object = transformed_objects.objects.at(i);
+    const auto & search_radius = search_radii.at(i);
+    if (!search_radius) continue;
+
+    if (debugger_) {
+      const auto & position = transformed_object.kinematics.pose_with_covariance.pose.position;
+      getNeighborPointcloud(
+        obstacle_grid, position, search_radius.value(), neighbor_pointclouds.at(i));
+    }
+    // Filter object that have few pointcloud in them.
+    points_nums.at(i) = getPointCloudNumWithinPolygon(
+      transformed_object, obstacle_grid,
+      debugger_ ? &pointclouds_within_polygon.at(i) : nullptr);
+  }
+
+  for (size_t i = 0; i < num_objects; ++i) {
     const auto & object = input_objects->objects.at(i);
-    const auto & transformed_object_position =
-      transformed_object.kinematics.pose_with_covariance.pose.position;
-    const auto search_radius = getMaxRadius(transformed_object);
-    if (!search_radius) {
+    const auto & num = points_nums.at(i);
+    if (debugger_) {
+      debugger_->addNeighborPointcloud(neighbor_pointclouds.at(i));
+      debugger_->addPointcloudWithinPolygon(pointclouds_within_polygon.at(i));
+    }
+    if (!num) {
       output.objects.push_back(object);
       continue;
     }
 
-    // Search neighbor pointcloud to reduce cost.
-    pcl::PointCloud<pcl::PointXY>::Ptr neighbor_pointcloud(new pcl::PointCloud<pcl::PointXY>);
-    std::vector<int> indices;
-    std::vector<float> distances;
-    kdtree->radiusSearch(
-      toPCL(transformed_object_position), search_radius.value(), indices, distances);
-    for (const auto & index : indices) {
-      neighbor_pointcloud->push_back(obstacle_pointcloud->at(index));
-    }
-    if (debugger_) debugger_->addNeighborPointcloud(neighbor_pointcloud);
-
-    // Filter object that have few pointcloud in them.
-    const auto num = getPointCloudNumWithinPolygon(transformed_object, neighbor_pointcloud);
+    const auto & transformed_object_position =
+      transformed_objects.objects.at(i).kinematics.pose_with_covariance.pose.position;
     const auto object_distance =
       std::hypot(transformed_object_position.x, transformed_object_position.y);
     size_t min_pointcloud_num = std::clamp(
       static_cast<size_t>(
         points_num_threshold_param_.min_points_and_distance_ratio / object_distance + 0.5f),
       points_num_threshold_param_.min_points_num, points_num_threshold_param_.max_points_num);
-    if (num) {
-      (min_pointcloud_num <= num.value()) ? output.objects.push_back(object)
-                                          : removed_objects.objects.push_back(object);
-    } else {
-      output.objects.push_back(object);
-    }
+    (min_pointcloud_num <= num.value()) ? output.objects.push_back(object)
+                                        : removed_objects.objects.push_back(object);
   }
 
   objects_pub_->publish(output);
@@ -180,34 +191,46 @@ void ObstaclePointCloudBasedValidator::onObjectsAndObstaclePointCloud(
 
 std::optional<size_t> ObstaclePointCloudBasedValidator::getPointCloudNumWithinPolygon(
   const autoware_auto_perception_msgs::msg::DetectedObject & object,
-  const pcl::PointCloud<pcl::PointXY>::Ptr pointcloud)
+  const PointGrid2d & obstacle_grid, pcl::PointCloud<pcl::PointXYZ> * pointcloud_within_polygon)
 {
-  pcl::PointCloud<pcl::PointXYZ>::Ptr cropped_pointcloud(new pcl::PointCloud<pcl::PointXYZ>);
-  std::vector<pcl::Vertices> vertices_array;
-  pcl::Vertices vertices;
-
   Polygon2d poly2d =
     tier4_autoware_utils::toPolygon2d(object.kinematics.pose_with_covariance.pose, object.shape);
   if (bg::is_empty(poly2d)) return std::nullopt;
 
-  pcl::PointCloud<pcl::PointXYZ>::Ptr poly3d(new pcl::PointCloud<pcl::PointXYZ>);
-
-  for (size_t i = 0; i < poly2d.outer().size(); ++i) {
-    vertices.vertices.emplace_back(i);
-    vertices_array.emplace_back(vertices);
-    poly3d->emplace_back(poly2d.outer().at(i).x(), poly2d.outer().at(i).y(), 0.0);
+  const auto & ring = poly2d.outer();
+  float min_x = std::numeric_limits<float>::max();
+  float min_y = std::numeric_limits<float>::max();
+  float max_x = std::numeric_limits<float>::lowest();
+  float max_y = std::numeric_limits<float>::lowest();
+  for (const auto & vertex : ring) {
+    min_x = std::min(min_x, static_cast<float>(vertex.x()));
+    min_y = std::min(min_y, static_cast<float>(vertex.y()));
+    max_x = std::max(max_x, static_cast<float>(vertex.x()));
+    max_y = std::max(max_y, static_cast<float>(vertex.y()));
   }
 
-  pcl::CropHull<pcl::PointXYZ> cropper;  // don't be implemented PointXY by PCL
-  cropper.setInputCloud(toXYZ(pointcloud));
-  cropper.setDim(2);
-  cropper.setHullIndices(vertices_array);
-  cropper.setHullCloud(poly3d);
-  cropper.setCropOutside(true);
-  cropper.filter(*cropped_pointcloud);
+  size_t num = 0;
+  obstacle_grid.forEachPointInBox(min_x, min_y, max_x, max_y, [&](const pcl::PointXY & point) {
+    if (!isInPolygon(ring, point)) return;
+    ++num;
+    if (pointcloud_within_polygon) pointcloud_within_polygon->push_back(toXYZ(point));
+  });
+  return num;
+}
 
-  if (debugger_) debugger_->addPointcloudWithinPolygon(cropped_pointcloud);
-  return cropped_pointcloud->size();
+void ObstaclePointCloudBasedValidator::getNeighborPointcloud(
+  const PointGrid2d & obstacle_grid, const geometry_msgs::msg::Point & center, const float radius,
+  pcl::PointCloud<pcl::PointXYZ> & neighbor_pointcloud)
+{
+  const float center_x = static_cast<float>(center.x);
+  const float center_y = static_cast<float>(center.y);
+  obstacle_grid.forEachPointInBox(
+    center_x - radius, center_y - radius, center_x + radius, center_y + radius,
+    [&](const pcl::PointXY & point) {
+      if (std::hypot(point.x - center_x, point.y - center_y) <= radius) {
+        neighbor_pointcloud.push_back(toXYZ(point));
+      }
+    });
 }
 
 std::optional<float> ObstaclePointCloudBasedValidator::getMaxRadius(
@@ -30,6 +30,9 @@
 #include <Eigen/Core>
 #include <Eigen/Geometry>
 
+#include <algorithm>
+#include <vector>
+
 namespace occupancy_grid_based_validator
 {
 using Shape = autoware_auto_perception_msgs::msg::Shape;
@@ -67,17 +70,21 @@ void OccupancyGridBasedValidator::onObjectsAndOccGrid(
         *input_objects, input_occ_grid->header.frame_id, tf_buffer_, transformed_objects))
     return;
 
-  // Convert ros data type to cv::Mat
-  cv::Mat occ_grid = fromOccupancyGrid(*input_occ_grid);
+  if (
+    input_occ_grid->data.size() <
+    static_cast<size_t>(input_occ_grid->info.width) * input_occ_grid->info.height) {
+    RCLCPP_WARN_THROTTLE(
+      get_logger(), *get_clock(), 1000, "occupancy grid data is smaller than its width x height");
+    return;
+  }
 
-  // Get vehicle mask image and calculate mean within mask.
+  // Get vehicle footprint and calculate mean occupancy within it.
   for (size_t i = 0; i < transformed_objects.objects.size(); ++i) {
     const auto & transformed_object = transformed_objects.objects.at(i);
     const auto & object = input_objects->objects.at(i);
     const auto & label = object.classification.front().label;
     if (perception_utils::isCarLikeVehicle(label)) {
-      auto mask = getMask(*input_occ_grid, transformed_object);
-      const float mean = mask ? cv::mean(occ_grid, mask.value())[0] * 0.01 : 1.0;
+      const float mean = getMeanOccupancy(*input_occ_grid, transformed_object).value_or(1.0);
       if (mean_threshold_ < mean) output.objects.push_back(object);
     } else {
       output.objects.push_back(object);
@@ -86,23 +93,17 @@ void OccupancyGridBasedValidator::onObjectsAndOccGrid(
 
   objects_pub_->publish(output);
 
-  if (enable_debug_) showDebugImage(*input_occ_grid, transformed_objects, occ_grid);
+  if (enable_debug_) showDebugImage(*input_occ_grid, transformed_objects);
 }
 
-std::optional<cv::Mat> OccupancyGridBasedValidator::getMask(
+std::optional<std::vector<cv::Point>> OccupancyGridBasedValidator::getPixelVertices(
   const nav_msgs::msg::OccupancyGrid & occupancy_grid,
   const autoware_auto_perception_msgs::msg::DetectedObject & object)
-{
-  cv::Mat mask = cv::Mat::zeros(occupancy_grid.info.height, occupancy_grid.info.width, CV_8UC1);
-  return getMask(occupancy_grid, object, mask);
-}
-
-std::optional<cv::Mat> OccupancyGridBasedValidator::getMask(
-  const nav_msgs::msg::OccupancyGrid & occupancy_grid,
-  const autoware_auto_perception_msgs::msg::DetectedObject & object, cv::Mat mask)
 {
   const auto & resolution = occupancy_grid.info.resolution;
   const auto & origin = occupancy_grid.info.origin;
+  const auto cols = static_cast<float>(occupancy_grid.info.width);
+  const auto rows = static_cast<float>(occupancy_grid.info.height);
   std::vector<cv::Point> pixel_vertices;
   Polygon2d poly2d =
     tier4_autoware_utils::toPolygon2d(object.kinematics.pose_with_covariance.pose, object.shape);
@@ -111,7 +112,7 @@ std::optional<cv::Mat> OccupancyGridBasedValidator::getMask(
   for (const auto & p : poly2d.outer()) {
     const float px = (p.x() - origin.position.x) / resolution;
     const float py = (p.y() - origin.position.y) / resolution;
-    const bool is_point_within_image = (0 <= px && px < mask.cols && 0 <= py && py < mask.rows);
+    const bool is_point_within_image = (0 <= px && px < cols && 0 <= py && py < rows);
 
     if (!is_point_within_image) is_polygon_within_image = false;
 
@@ -119,7 +120,63 @@ std::optional<cv::Mat> OccupancyGridBasedValidator::getMask(
   }
 
   if (is_polygon_within_image && !pixel_vertices.empty()) {
-    cv::fillConvexPoly(mask, pixel_vertices, cv::Scalar(255));
+    return pixel_vertices;
+  } else {
+    return std::nullopt;
+  }
+}
+
+// Rasterizes the footprint into a mask of its bounding box only and averages the occupancy under
+// it, read in place from the message through a cv::Mat header.
+std::optional<float> OccupancyGridBasedValidator::getMeanOccupancy(
+  const nav_msgs::msg::OccupancyGrid & occupancy_grid,
+  const autoware_auto_perception_msgs::msg::DetectedObject & object)
+{
+  auto pixel_vertices = getPixelVertices(occupancy_grid, object);
+  if (!pixel_vertices) {
+    return std::nullopt;
+  }
+
+  const cv::Mat occ_grid(
+    occupancy_grid.info.height, occupancy_grid.info.width, CV_8SC1,
+    const_cast<int8_t *>(occupancy_grid.data.data()));
+  const cv::Rect roi =
+    cv::boundingRect(pixel_vertices.value()) & cv::Rect(0, 0, occ_grid.cols, occ_grid.rows);
+  for (auto & vertex : pixel_vertices.value()) {
+    vertex -= roi.tl();
+  }
+
+  if (mask_buffer_.rows < roi.height || mask_buffer_.cols < roi.width) {
+    mask_buffer_.create(
+      std::max(mask_buffer_.rows, roi.height), std::max(mask_buffer_.cols, roi.width), CV_8UC1);
+  }
+  cv::Mat mask = mask_buffer_(cv::Rect(0, 0, roi.width, roi.height));
+  mask.setTo(cv::Scalar(0));
+  cv::fillConvexPoly(mask, pixel_vertices.value(), cv::Scalar(255));
+
+  // same scaling as fromOccupancyGrid(): occupancy clamped to [0, 50] and mapped to [0, 1]
+  int sum = 0;
+  int count = 0;
+  for (int y = 0; y < roi.height; ++y) {
+    const auto * occ_row = occ_grid.ptr<int8_t>(roi.y + y) + roi.x;
+    const auto * mask_row = mask.ptr<uint8_t>(y);
+    for (int x = 0; x < roi.width; ++x) {
+      if (mask_row[x]) {
+        sum += std::clamp(occ_row[x], static_cast<int8_t>(0), static_cast<int8_t>(50));
+        ++count;
+      }
+    }
+  }
+  return count == 0 ? 0.0f : static_cast<float>(sum) * 2.0f / count * 0.01f;
+}
+
+std::optional<cv::Mat> OccupancyGridBasedValidator::getMask(
+  const nav_msgs::msg::OccupancyGrid & occupancy_grid,
+  const autoware_auto_perception_msgs::msg::DetectedObject & object, cv::Mat mask)
+{
+  const auto pixel_vertices = getPixelVertices(occupancy_grid, object);
+  if (pixel_vertices) {
+    cv::fillConvexPoly(mask, pixel_vertices.value(), cv::Scalar(255));
     return mask;
   } else {
     return std::nullopt;
@@ -143,8 +200,9 @@ cv::Mat OccupancyGridBasedValidator::fromOccupancyGrid(
 
 void OccupancyGridBasedValidator::showDebugImage(
   const nav_msgs::msg::OccupancyGrid & ros_occ_grid,
-  const autoware_auto_perception_msgs::msg::DetectedObjects & objects, const cv::Mat & occ_grid)
+  const autoware_auto_perception_msgs::msg::DetectedObjects & objects)
 {
+  const cv::Mat occ_grid = fromOccupancyGrid(ros_occ_grid);
   cv::namedWindow("removed_objects_image", cv::WINDOW_NORMAL);
   cv::namedWindow("passed_objects_image", cv::WINDOW_NORMAL);
   cv::Mat removed_objects_image = occ_grid.clone();
@@ -154,8 +212,7 @@ void OccupancyGridBasedValidator::showDebugImage(
   for (const auto & object : objects.objects) {
     const auto & label = object.classification.front().label;
     if (perception_utils::isCarLikeVehicle(label)) {
-      auto mask = getMask(ros_occ_grid, object);
-      const float mean = mask ? cv::mean(occ_grid, mask.value())[0] * 0.01 : 1.0;
+      const float mean = getMeanOccupancy(ros_occ_grid, object).value_or(1.0);
       if (mean_threshold_ < mean) {
         auto mask = getMask(ros_occ_grid, object, passed_objects_image);
         if (mask) passed_objects_image = mask.value();
@@ -20,6 +20,7 @@
 #include <euclidean_cluster/euclidean_cluster.hpp>
 #include <euclidean_cluster/utils.hpp>
 #include <euclidean_cluster/voxel_grid_based_euclidean_cluster.hpp>
+#include <perception_utils/centroid_grid.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <shape_estimation/shape_estimator.hpp>
 #include <tier4_autoware_utils/tier4_autoware_utils.hpp>
@@ -46,6 +47,7 @@
 #include <deque>
 #include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 class TrackerHandler
@@ -81,6 +83,7 @@ private:
   std::shared_ptr<Debugger> debugger_;
   std::map<uint8_t, int> max_search_distance_for_merger_;
   std::map<uint8_t, int> max_search_distance_for_divider_;
+  double max_search_distance_{0.0};
 
   bool ignore_unknown_tracker_;
 
@@ -89,20 +92,26 @@ private:
   void onObjects(
     const tier4_perception_msgs::msg::DetectedObjectsWithFeature::ConstSharedPtr input_msg);
 
+  // clusters of the input objects converted to pcl on first use, shared by all the trackers
+  using PclClusters = std::vector<pcl::PointCloud<pcl::PointXYZ>::Ptr>;
+
   void divideUnderSegmentedObjects(
     const autoware_auto_perception_msgs::msg::DetectedObjects & tracked_objects,
     const tier4_perception_msgs::msg::DetectedObjectsWithFeature & in_objects,
+    const perception_utils::CentroidGrid & cluster_grid, PclClusters & pcl_clusters,
     autoware_auto_perception_msgs::msg::DetectedObjects & out_no_found_tracked_objects,
     tier4_perception_msgs::msg::DetectedObjectsWithFeature & out_objects);
 
   float optimizeUnderSegmentedObject(
     const autoware_auto_perception_msgs::msg::DetectedObject & target_object,
-    const sensor_msgs::msg::PointCloud2 & under_segmented_cluster,
-    tier4_perception_msgs::msg::DetectedObjectWithFeature & output);
+    const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & under_segmented_cluster,
+    const std_msgs::msg::Header & cluster_header,
+    tier4_perception_msgs::msg::DetectedObjectWithFeature & output) const;
 
   void mergeOverSegmentedObjects(
     const autoware_auto_perception_msgs::msg::DetectedObjects & tracked_objects,
     const tier4_perception_msgs::msg::DetectedObjectsWithFeature & in_objects,
+    const perception_utils::CentroidGrid & cluster_grid, PclClusters & pcl_clusters,
     autoware_auto_perception_msgs::msg::DetectedObjects & out_no_found_tracked_objects,
     tier4_perception_msgs::msg::DetectedObjectsWithFeature & out_objects);
 };
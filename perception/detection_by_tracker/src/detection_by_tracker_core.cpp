@@ -16,7 +16,9 @@
 
 #include "perception_utils/perception_utils.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
@@ -38,6 +40,18 @@ void setClusterInObjectWithFeature(
   ros_pointcloud.header = header;
   feature_object.feature.cluster = ros_pointcloud;
 }
+
+const pcl::PointCloud<pcl::PointXYZ>::Ptr & getPclCluster(
+  const tier4_perception_msgs::msg::DetectedObjectsWithFeature & cluster_objects,
+  const size_t cluster_idx, std::vector<pcl::PointCloud<pcl::PointXYZ>::Ptr> & pcl_clusters)
+{
+  auto & pcl_cluster = pcl_clusters.at(cluster_idx);
+  if (!pcl_cluster) {
+    pcl_cluster.reset(new pcl::PointCloud<pcl::PointXYZ>);
+    pcl::fromROSMsg(cluster_objects.feature_objects.at(cluster_idx).feature.cluster, *pcl_cluster);
+  }
+  return pcl_cluster;
+}
 autoware_auto_perception_msgs::msg::Shape extendShape(
   const autoware_auto_perception_msgs::msg::Shape & shape, const float scale)
 {
@@ -190,6 +204,14 @@ void DetectionByTracker::setMaxSearchRange()
   max_search_distance_for_divider_[Label::MOTORCYCLE] = 3.0;
   max_search_distance_for_divider_[Label::BICYCLE] = 2.0;
   max_search_distance_for_divider_[Label::PEDESTRIAN] = 2.0;
+
+  // cell size of the grid used to search the clusters around a tracker
+  for (const auto & search_distances :
+       {max_search_distance_for_merger_, max_search_distance_for_divider_}) {
+    for (const auto & [label, distance] : search_distances) {
+      max_search_distance_ = std::max(max_search_distance_, static_cast<double>(distance));
+    }
+  }
 }
 
 void DetectionByTracker::onObjects(
@@ -217,17 +239,34 @@ void DetectionByTracker::onObjects(
   debugger_->publishInitialObjects(*input_msg);
   debugger_->publishTrackedObjects(tracked_objects);
 
+  // index the clusters by position, and convert each of them to pcl at most once
+  std::vector<double> cluster_xs;
+  std::vector<double> cluster_ys;
+  cluster_xs.reserve(input_msg->feature_objects.size());
+  cluster_ys.reserve(input_msg->feature_objects.size());
+  for (const auto & feature_object : input_msg->feature_objects) {
+    const auto & position = feature_object.object.kinematics.pose_with_covariance.pose.position;
+    cluster_xs.push_back(position.x);
+    cluster_ys.push_back(position.y);
+  }
+  perception_utils::CentroidGrid cluster_grid;
+  cluster_grid.build(cluster_xs, cluster_ys, max_search_distance_);
+  PclClusters pcl_clusters(input_msg->feature_objects.size());
+
   // merge over segmented objects
   tier4_perception_msgs::msg::DetectedObjectsWithFeature merged_objects;
   autoware_auto_perception_msgs::msg::DetectedObjects no_found_tracked_objects;
-  mergeOverSegmentedObjects(tracked_objects, *input_msg, no_found_tracked_objects, merged_objects);
+  mergeOverSegmentedObjects(
+    tracked_objects, *input_msg, cluster_grid, pcl_clusters, no_found_tracked_objects,
+    merged_objects);
   debugger_->publishMergedObjects(merged_objects);
 
   // divide under segmented objects
   tier4_perception_msgs::msg::DetectedObjectsWithFeature divided_objects;
   autoware_auto_perception_msgs::msg::DetectedObjects temp_no_found_tracked_objects;
   divideUnderSegmentedObjects(
-    no_found_tracked_objects, *input_msg, temp_no_found_tracked_objects, divided_objects);
+    no_found_tracked_objects, *input_msg, cluster_grid, pcl_clusters,
+    temp_no_found_tracked_objects, divided_objects);
   debugger_->publishDividedObjects(divided_objects);
 
   // merge under/over segmented objects to build output objects
@@ -244,6 +283,7 @@ void DetectionByTracker::onObjects(
 void DetectionByTracker::divideUnderSegmentedObjects(
   const autoware_auto_perception_msgs::msg::DetectedObjects & tracked_objects,
   const tier4_perception_msgs::msg::DetectedObjectsWithFeature & in_cluster_objects,
+  const perception_utils::CentroidGrid & cluster_grid, PclClusters & pcl_clusters,
   autoware_auto_perception_msgs::msg::DetectedObjects & out_no_found_tracked_objects,
   tier4_perception_msgs::msg::DetectedObjectsWithFeature & out_objects)
 {
@@ -254,59 +294,90 @@ void DetectionByTracker::divideUnderSegmentedObjects(
   out_objects.header = in_cluster_objects.header;
   out_no_found_tracked_objects.header = tracked_objects.header;
 
-  for (const auto & tracked_object : tracked_objects.objects) {
+  // find the under segmented clusters around each tracker
+  const size_t num_trackers = tracked_objects.objects.size();
+  std::vector<bool> is_ignored(num_trackers, false);
+  std::vector<std::vector<size_t>> under_segmented_cluster_indices(num_trackers);
+  std::vector<size_t> candidates;
+  for (size_t tracker_idx = 0; tracker_idx < num_trackers; ++tracker_idx) {
+    const auto & tracked_object = tracked_objects.objects.at(tracker_idx);
     const auto & label = tracked_object.classification.front().label;
-    if (ignore_unknown_tracker_ && (label == Label::UNKNOWN)) continue;
+    if (ignore_unknown_tracker_ && (label == Label::UNKNOWN)) {
+      is_ignored.at(tracker_idx) = true;
+      continue;
+    }
 
     // change search range according to label type
     const float max_search_range = max_search_distance_for_divider_[label];
 
-    std::optional<tier4_perception_msgs::msg::DetectedObjectWithFeature>
-      highest_score_divided_object = std::nullopt;
-    float highest_score = 0.0;
-
-    for (const auto & initial_object : in_cluster_objects.feature_objects) {
+    const auto & tracked_pose = tracked_object.kinematics.pose_with_covariance.pose;
+    const auto tracked_polygon = perception_utils::toMatchingPolygon2d(tracked_object);
+    cluster_grid.queryCandidates(
+      tracked_pose.position.x, tracked_pose.position.y, max_search_range, candidates);
+    for (const size_t cluster_idx : candidates) {
+      const auto & initial_object = in_cluster_objects.feature_objects.at(cluster_idx);
       // search near object
       const float distance = tier4_autoware_utils::calcDistance2d(
-        tracked_object.kinematics.pose_with_covariance.pose,
-        initial_object.object.kinematics.pose_with_covariance.pose);
+        tracked_pose, initial_object.object.kinematics.pose_with_covariance.pose);
       if (max_search_range < distance) {
         continue;
       }
       // detect under segmented cluster
-      const float recall = perception_utils::get2dRecall(initial_object.object, tracked_object);
-      const float precision =
-        perception_utils::get2dPrecision(initial_object.object, tracked_object);
+      const auto initial_polygon = perception_utils::toMatchingPolygon2d(initial_object.object);
+      const float recall = perception_utils::get2dRecall(initial_polygon, tracked_polygon);
+      const float precision = perception_utils::get2dPrecision(initial_polygon, tracked_polygon);
       const bool is_under_segmented =
         (recall_min_threshold < recall && precision < precision_max_threshold);
       if (!is_under_segmented) {
         continue;
       }
-      // optimize clustering
+      under_segmented_cluster_indices.at(tracker_idx).push_back(cluster_idx);
+      getPclCluster(in_cluster_objects, cluster_idx, pcl_clusters);
+    }
+  }
+
+  // optimize clustering of each tracker independently, the clusters are only read from here
+  std::vector<std::optional<tier4_perception_msgs::msg::DetectedObjectWithFeature>>
+    highest_score_divided_objects(num_trackers);
+#pragma omp parallel for schedule(dynamic)
+  for (int64_t i = 0; i < static_cast<int64_t>(num_trackers); ++i) {
+    const size_t tracker_idx = static_cast<size_t>(i);
+    const auto & tracked_object = tracked_objects.objects.at(tracker_idx);
+    float highest_score = 0.0;
+    for (const size_t cluster_idx : under_segmented_cluster_indices.at(tracker_idx)) {
       tier4_perception_msgs::msg::DetectedObjectWithFeature divided_object;
       float score = optimizeUnderSegmentedObject(
-        tracked_object, initial_object.feature.cluster, divided_object);
+        tracked_object, pcl_clusters.at(cluster_idx),
+        in_cluster_objects.feature_objects.at(cluster_idx).feature.cluster.header, divided_object);
       if (score < min_score_threshold) {
         continue;
       }
 
       if (highest_score < score) {
         highest_score = score;
-        highest_score_divided_object = divided_object;
+        highest_score_divided_objects.at(tracker_idx) = divided_object;
       }
     }
+  }
+
+  for (size_t tracker_idx = 0; tracker_idx < num_trackers; ++tracker_idx) {
+    if (is_ignored.at(tracker_idx)) {
+      continue;
+    }
+    const auto & highest_score_divided_object = highest_score_divided_objects.at(tracker_idx);
     if (highest_score_divided_object) {  // found
       out_objects.feature_objects.push_back(highest_score_divided_object.value());
     } else {  // not found
-      out_no_found_tracked_objects.objects.push_back(tracked_object);
+      out_no_found_tracked_objects.objects.push_back(tracked_objects.objects.at(tracker_idx));
     }
   }
 }
 
 float DetectionByTracker::optimizeUnderSegmentedObject(
   const autoware_auto_perception_msgs::msg::DetectedObject & target_object,
-  const sensor_msgs::msg::PointCloud2 & under_segmented_cluster,
-  tier4_perception_msgs::msg::DetectedObjectWithFeature & output)
+  const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & under_segmented_cluster,
+  const std_msgs::msg::Header & cluster_header,
+  tier4_perception_msgs::msg::DetectedObjectWithFeature & output) const
 {
   constexpr float iter_rate = 0.8;
   constexpr int iter_max_count = 5;
@@ -321,10 +392,6 @@ float DetectionByTracker::optimizeUnderSegmentedObject(
   euclidean_cluster::VoxelGridBasedEuclideanCluster cluster(
     false, 4, 10000, initial_cluster_range, initial_voxel_size, 0);
 
-  // convert to pcl
-  pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_cluster(new pcl::PointCloud<pcl::PointXYZ>);
-  pcl::fromROSMsg(under_segmented_cluster, *pcl_cluster);
-
   // iterate to find best fit divided object
   float highest_iou = 0.0;
   tier4_perception_msgs::msg::DetectedObjectWithFeature highest_iou_object;
@@ -334,12 +401,13 @@ float DetectionByTracker::optimizeUnderSegmentedObject(
     std::vector<pcl::PointCloud<pcl::PointXYZ>> divided_clusters;
     cluster.setTolerance(cluster_range);
     cluster.setVoxelLeafSize(voxel_size);
-    cluster.cluster(pcl_cluster, divided_clusters);
+    cluster.cluster(under_segmented_cluster, divided_clusters);
 
     // find highest iou object in divided clusters
     float highest_iou_in_current_iter = 0.0f;
     tier4_perception_msgs::msg::DetectedObjectWithFeature highest_iou_object_in_current_iter;
     highest_iou_object_in_current_iter.object.classification = target_object.classification;
+    const auto target_polygon = perception_utils::toMatchingPolygon2d(target_object);
     for (const auto & divided_cluster : divided_clusters) {
       bool is_shape_estimated = shape_estimator_->estimateShapeAndPose(
         label, divided_cluster,
@@ -351,12 +419,13 @@ float DetectionByTracker::optimizeUnderSegmentedObject(
       if (!is_shape_estimated) {
         continue;
       }
-      const float iou =
-        perception_utils::get2dIoU(highest_iou_object_in_current_iter.object, target_object);
+      const float iou = perception_utils::get2dIoU(
+        perception_utils::toMatchingPolygon2d(highest_iou_object_in_current_iter.object),
+        target_polygon);
       if (highest_iou_in_current_iter < iou) {
         highest_iou_in_current_iter = iou;
         setClusterInObjectWithFeature(
-          under_segmented_cluster.header, divided_cluster, highest_iou_object_in_current_iter);
+          cluster_header, divided_cluster, highest_iou_object_in_current_iter);
       }
     }
 
@@ -382,6 +451,7 @@ float DetectionByTracker::optimizeUnderSegmentedObject(
 void DetectionByTracker::mergeOverSegmentedObjects(
   const autoware_auto_perception_msgs::msg::DetectedObjects & tracked_objects,
   const tier4_perception_msgs::msg::DetectedObjectsWithFeature & in_cluster_objects,
+  const perception_utils::CentroidGrid & cluster_grid, PclClusters & pcl_clusters,
   autoware_auto_perception_msgs::msg::DetectedObjects & out_no_found_tracked_objects,
   tier4_perception_msgs::msg::DetectedObjectsWithFeature & out_objects)
 {
@@ -389,6 +459,7 @@ void DetectionByTracker::mergeOverSegmentedObjects(
   out_objects.header = in_cluster_objects.header;
   out_no_found_tracked_objects.header = tracked_objects.header;
 
+  std::vector<size_t> candidates;
   for (const auto & tracked_object : tracked_objects.objects) {
     const auto & label = tracked_object.classification.front().label;
     if (ignore_unknown_tracker_ && (label == Label::UNKNOWN)) continue;
@@ -400,8 +471,15 @@ void DetectionByTracker::mergeOverSegmentedObjects(
     autoware_auto_perception_msgs::msg::DetectedObject extended_tracked_object = tracked_object;
     extended_tracked_object.shape = extendShape(tracked_object.shape, /*scale*/ 1.1);
 
+    const auto extended_tracked_polygon =
+      perception_utils::toMatchingPolygon2d(extended_tracked_object);
+
     pcl::PointCloud<pcl::PointXYZ> pcl_merged_cluster;
-    for (const auto & initial_object : in_cluster_objects.feature_objects) {
+    const auto & tracked_position = tracked_object.kinematics.pose_with_covariance.pose.position;
+    cluster_grid.queryCandidates(
+      tracked_position.x, tracked_position.y, max_search_range, candidates);
+    for (const size_t cluster_idx : candidates) {
+      const auto & initial_object = in_cluster_objects.feature_objects.at(cluster_idx);
       const float distance = tier4_autoware_utils::calcDistance2d(
         tracked_object.kinematics.pose_with_covariance.pose,
         initial_object.object.kinematics.pose_with_covariance.pose);
@@ -411,14 +489,12 @@ void DetectionByTracker::mergeOverSegmentedObjects(
       }
 
       // If there is an initial object in the tracker, it will be merged.
-      const float precision =
-        perception_utils::get2dPrecision(initial_object.object, extended_tracked_object);
+      const float precision = perception_utils::get2dPrecision(
+        perception_utils::toMatchingPolygon2d(initial_object.object), extended_tracked_polygon);
       if (precision < precision_threshold) {
         continue;
       }
-      pcl::PointCloud<pcl::PointXYZ> pcl_cluster;
-      pcl::fromROSMsg(initial_object.feature.cluster, pcl_cluster);
-      pcl_merged_cluster += pcl_cluster;
+      pcl_merged_cluster += *getPclCluster(in_cluster_objects, cluster_idx, pcl_clusters);
     }
 
     if (pcl_merged_cluster.points.empty()) {  // if clusters aren't found
@@ -80,9 +80,15 @@ private:
   lanelet::ConstLanelets getIntersectedLanelets(
     const tier4_autoware_utils::LinearRing2d & convex_hull,
     const lanelet::ConstLanelets & road_lanelets_);
-  pcl::PointCloud<pcl::PointXYZ>::Ptr getLaneFilteredPointCloud(
+  pcl::PointCloud<pcl::PointXYZ>::Ptr getTiledLaneFilteredPointCloud(
     const lanelet::ConstLanelets & joint_lanelets,
     const pcl::PointCloud<pcl::PointXYZ>::Ptr & cloud);
+  pcl::PointCloud<pcl::PointXYZ> getLaneFilteredPointCloud(
+    const lanelet::ConstLanelets & joint_lanelets, const pcl::PointCloud<pcl::PointXYZ> & cloud,
+    const pcl::PointXYZ & tile_origin);
+  std::size_t getLaneFilterTileHash(
+    const lanelet::ConstLanelets & tile_lanelets,
+    const pcl::PointCloud<pcl::PointXYZ> & tile_cloud);
   bool checkPointWithinLanelets(
     const pcl::PointXYZ & point, const lanelet::ConstLanelets & joint_lanelets);
   void inpaintElevationMap(const float radius);
@@ -108,6 +114,9 @@ private:
     float voxel_size_z_;
     float lane_margin_;
     float lane_height_diff_thresh_;
+    // the lane filter is run and cached per square tile of this size [m]
+    double tile_size_;
+    int num_threads_;
     lanelet::ConstLanelets road_lanelets_;
     bool use_lane_filter_;
   };
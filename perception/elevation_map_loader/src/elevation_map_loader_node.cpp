@@ -23,6 +23,7 @@
 
 #include <grid_map_msgs/msg/grid_map.hpp>
 
+#include <boost/functional/hash.hpp>
 #include <boost/geometry/algorithms/convex_hull.hpp>
 #include <boost/geometry/algorithms/intersects.hpp>
 #include <boost/iostreams/device/mapped_file.hpp>
@@ -34,8 +35,15 @@
 #include <pcl_conversions/pcl_conversions.h>
 #include <sensor_msgs/msg/point_cloud2.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <filesystem>
+#include <fstream>
+#include <limits>
+#include <map>
 #include <memory>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -46,6 +54,52 @@
 #include <Eigen/Geometry>
 #include <rosbag2_storage_default_plugins/sqlite/sqlite_statement_wrapper.hpp>
 
+namespace
+{
+// A lane filtered tile is stored as its number of points followed by their xyz coordinates.
+bool saveLaneFilteredTile(const std::string & path, const pcl::PointCloud<pcl::PointXYZ> & cloud)
+{
+  // write next to the target and rename, so that a killed node never leaves a truncated tile
+  const std::string tmp_path = path + ".tmp";
+  {
+    std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!ofs) return false;
+    const std::uint64_t num_points = cloud.points.size();
+    ofs.write(reinterpret_cast<const char *>(&num_points), sizeof(num_points));
+    for (const auto & p : cloud.points) {
+      const float xyz[3] = {p.x, p.y, p.z};
+      ofs.write(reinterpret_cast<const char *>(xyz), sizeof(xyz));
+    }
+    if (!ofs) return false;
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tmp_path, path, ec);
+  return !ec;
+}
+
+bool loadLaneFilteredTile(const std::string & path, pcl::PointCloud<pcl::PointXYZ> & cloud)
+{
+  std::ifstream ifs(path, std::ios::binary);
+  if (!ifs) return false;
+  std::uint64_t num_points = 0;
+  ifs.read(reinterpret_cast<char *>(&num_points), sizeof(num_points));
+  std::error_code ec;
+  const auto file_size = std::filesystem::file_size(path, ec);
+  if (!ifs || ec || file_size != sizeof(num_points) + num_points * 3 * sizeof(float)) {
+    return false;
+  }
+
+  cloud.points.resize(num_points);
+  for (auto & p : cloud.points) {
+    float xyz[3];
+    ifs.read(reinterpret_cast<char *>(xyz), sizeof(xyz));
+    p = pcl::PointXYZ(xyz[0], xyz[1], xyz[2]);
+  }
+  return static_cast<bool>(ifs);
+}
+}  // namespace
+
 ElevationMapLoaderNode::ElevationMapLoaderNode(const rclcpp::NodeOptions & options)
 : Node("elevation_map_loader", options)
 {
@@ -66,6 +120,11 @@ ElevationMapLoaderNode::ElevationMapLoaderNode(const rclcpp::NodeOptions & optio
   lane_filter_.voxel_size_x_ = declare_parameter("lane_filter_voxel_size_x", 0.04);
   lane_filter_.voxel_size_y_ = declare_parameter("lane_filter_voxel_size_y", 0.04);
   lane_filter_.voxel_size_z_ = declare_parameter("lane_filter_voxel_size_z", 0.04);
+  lane_filter_.tile_size_ = declare_parameter("lane_filter_tile_size", 50.0);
+  if (!(lane_filter_.tile_size_ > 0.0)) {
+    throw std::invalid_argument("lane_filter_tile_size must be positive");
+  }
+  lane_filter_.num_threads_ = std::max(declare_parameter("lane_filter_num_threads", 1), 1);
 
   rclcpp::QoS durable_qos{1};
   durable_qos.transient_local();
@@ -184,7 +243,7 @@ void ElevationMapLoaderNode::createElevationMap()
     lanelet::ConstLanelets intersected_lanelets =
       getIntersectedLanelets(convex_hull, lane_filter_.road_lanelets_);
     pcl::PointCloud<pcl::PointXYZ>::Ptr lane_filtered_map_pcl_ptr =
-      getLaneFilteredPointCloud(intersected_lanelets, data_manager_.map_pcl_ptr_);
+      getTiledLaneFilteredPointCloud(intersected_lanelets, data_manager_.map_pcl_ptr_);
     grid_map_pcl_loader->setInputCloud(lane_filtered_map_pcl_ptr);
   } else {
     grid_map_pcl_loader->setInputCloud(data_manager_.map_pcl_ptr_);
@@ -316,24 +375,143 @@ float ElevationMapLoaderNode::calculateDistancePointFromPlane(
   return distance;
 }
 
-pcl::PointCloud<pcl::PointXYZ>::Ptr ElevationMapLoaderNode::getLaneFilteredPointCloud(
+std::size_t ElevationMapLoaderNode::getLaneFilterTileHash(
+  const lanelet::ConstLanelets & tile_lanelets, const pcl::PointCloud<pcl::PointXYZ> & tile_cloud)
+{
+  std::size_t seed = 0;
+  boost::hash_combine(seed, lane_filter_.voxel_size_x_);
+  boost::hash_combine(seed, lane_filter_.voxel_size_y_);
+  boost::hash_combine(seed, lane_filter_.lane_margin_);
+  boost::hash_combine(seed, lane_filter_.lane_height_diff_thresh_);
+  boost::hash_combine(seed, lane_filter_.tile_size_);
+  boost::hash_combine(seed, tile_cloud.points.size());
+  for (const auto & p : tile_cloud.points) {
+    boost::hash_combine(seed, p.x);
+    boost::hash_combine(seed, p.y);
+    boost::hash_combine(seed, p.z);
+  }
+  for (const auto & lanelet : tile_lanelets) {
+    boost::hash_combine(seed, lanelet.id());
+    for (const auto & p : lanelet.polygon2d().basicPolygon()) {
+      boost::hash_combine(seed, p.x());
+      boost::hash_combine(seed, p.y());
+    }
+    for (const auto & p : lanelet.centerline3d()) {
+      boost::hash_combine(seed, p.x());
+      boost::hash_combine(seed, p.y());
+      boost::hash_combine(seed, p.z());
+    }
+  }
+  return seed;
+}
+
+pcl::PointCloud<pcl::PointXYZ>::Ptr ElevationMapLoaderNode::getTiledLaneFilteredPointCloud(
   const lanelet::ConstLanelets & intersected_lanelets,
   const pcl::PointCloud<pcl::PointXYZ>::Ptr & cloud)
+{
+  const auto start = std::chrono::high_resolution_clock::now();
+  const double tile_size = lane_filter_.tile_size_;
+
+  // split the map into square tiles, ordered so that the filtered cloud is deterministic
+  std::map<std::pair<int, int>, pcl::PointCloud<pcl::PointXYZ>> tile_clouds;
+  for (const auto & p : cloud->points) {
+    if (std::isnan(p.x) || std::isnan(p.y) || std::isnan(p.z)) {
+      continue;
+    }
+    const int tile_x = static_cast<int>(std::floor(p.x / tile_size));
+    const int tile_y = static_cast<int>(std::floor(p.y / tile_size));
+    tile_clouds[std::make_pair(tile_x, tile_y)].points.push_back(p);
+  }
+  std::vector<std::pair<int, int>> tile_indices;
+  tile_indices.reserve(tile_clouds.size());
+  for (const auto & tile : tile_clouds) {
+    tile_indices.push_back(tile.first);
+  }
+
+  // the centerlines are computed lazily by lanelet2, which is not thread safe
+  for (const auto & lanelet : intersected_lanelets) {
+    lanelet.centerline3d();
+  }
+
+  const auto tile_directory =
+    std::filesystem::path(elevation_map_directory_) / "lane_filtered_tiles";
+  std::error_code ec;
+  std::filesystem::create_directories(tile_directory, ec);
+
+  std::vector<pcl::PointCloud<pcl::PointXYZ>> filtered_tile_clouds(tile_indices.size());
+  std::vector<char> is_tile_reused(tile_indices.size(), 0);
+#pragma omp parallel for num_threads(lane_filter_.num_threads_) schedule(dynamic)
+  for (std::size_t i = 0; i < tile_indices.size(); ++i) {
+    const auto & tile_cloud = tile_clouds.at(tile_indices[i]);
+    const pcl::PointXYZ tile_origin(
+      tile_indices[i].first * tile_size, tile_indices[i].second * tile_size, 0.0);
+
+    // only the lanelets which a point of the tile can be within the margin of
+    const double margin = std::max(lane_filter_.lane_margin_, 0.0f);
+    const tier4_autoware_utils::Box2d tile_box(
+      tier4_autoware_utils::Point2d(tile_origin.x - margin, tile_origin.y - margin),
+      tier4_autoware_utils::Point2d(
+        tile_origin.x + tile_size + margin, tile_origin.y + tile_size + margin));
+    lanelet::ConstLanelets tile_lanelets;
+    for (const auto & lanelet : intersected_lanelets) {
+      if (boost::geometry::intersects(tile_box, lanelet.polygon2d().basicPolygon())) {
+        tile_lanelets.push_back(lanelet);
+      }
+    }
+
+    std::stringstream tile_name;
+    tile_name << std::hex << getLaneFilterTileHash(tile_lanelets, tile_cloud);
+    const std::string tile_path = (tile_directory / tile_name.str()).string();
+    if (loadLaneFilteredTile(tile_path, filtered_tile_clouds[i])) {
+      is_tile_reused[i] = 1;
+      continue;
+    }
+    filtered_tile_clouds[i] = getLaneFilteredPointCloud(tile_lanelets, tile_cloud, tile_origin);
+    saveLaneFilteredTile(tile_path, filtered_tile_clouds[i]);
+  }
+
+  pcl::PointCloud<pcl::PointXYZ>::Ptr filtered_cloud(new pcl::PointCloud<pcl::PointXYZ>);
+  filtered_cloud->header = cloud->header;
+  for (const auto & filtered_tile_cloud : filtered_tile_clouds) {
+    filtered_cloud->points.insert(
+      filtered_cloud->points.end(), filtered_tile_cloud.points.begin(),
+      filtered_tile_cloud.points.end());
+  }
+  filtered_cloud->width = filtered_cloud->points.size();
+  filtered_cloud->height = 1;
+
+  RCLCPP_INFO(
+    this->get_logger(), "Lane filter reused %zu of %zu tiles",
+    static_cast<std::size_t>(std::count(is_tile_reused.begin(), is_tile_reused.end(), 1)),
+    is_tile_reused.size());
+  grid_map::grid_map_pcl::printTimeElapsedToRosInfoStream(
+    start, "Finish filtering pointcloud map with lanelets. Total time: ", this->get_logger());
+  return filtered_cloud;
+}
+
+pcl::PointCloud<pcl::PointXYZ> ElevationMapLoaderNode::getLaneFilteredPointCloud(
+  const lanelet::ConstLanelets & intersected_lanelets,
+  const pcl::PointCloud<pcl::PointXYZ> & cloud, const pcl::PointXYZ & tile_origin)
 {
   pcl::PointCloud<pcl::PointXYZ> filtered_cloud;
-  filtered_cloud.header = cloud->header;
+  if (cloud.points.empty()) {
+    return filtered_cloud;
+  }
 
   pcl::PointCloud<pcl::PointXYZ>::Ptr centralized_cloud(new pcl::PointCloud<pcl::PointXYZ>);
-  centralized_cloud->reserve(cloud->size());
+  centralized_cloud->reserve(cloud.size());
 
   // The coordinates of the point cloud are too large, resulting in calculation errors,
-  // so offset them to the center.
+  // so offset them to the origin of the tile, which puts the voxel borders on the tile borders.
   // https://github.com/PointCloudLibrary/pcl/issues/4895
-  Eigen::Vector4f centroid;
-  pcl::compute3DCentroid(*cloud, centroid);
-  for (const auto & p : cloud->points) {
+  // The lowest point is the z origin, so that a voxel is a whole column of the tile.
+  Eigen::Vector3f offset(tile_origin.x, tile_origin.y, std::numeric_limits<float>::max());
+  for (const auto & p : cloud.points) {
+    offset[2] = std::min(offset[2], p.z);
+  }
+  for (const auto & p : cloud.points) {
     centralized_cloud->points.push_back(
-      pcl::PointXYZ(p.x - centroid[0], p.y - centroid[1], p.z - centroid[2]));
+      pcl::PointXYZ(p.x - offset[0], p.y - offset[1], p.z - offset[2]));
   }
 
   pcl::PointCloud<pcl::PointXYZ>::Ptr downsampled_cloud(new pcl::PointCloud<pcl::PointXYZ>);
@@ -345,30 +523,25 @@ pcl::PointCloud<pcl::PointXYZ>::Ptr ElevationMapLoaderNode::getLaneFilteredPoint
 
   std::unordered_map<size_t, pcl::PointCloud<pcl::PointXYZ>> downsampled2original_map;
   for (const auto & p : centralized_cloud->points) {
-    if (std::isnan(p.x) || std::isnan(p.y) || std::isnan(p.z)) {
-      continue;
-    }
     const size_t index = voxel_grid.getCentroidIndex(p);
     downsampled2original_map[index].points.push_back(p);
   }
 
   for (auto & point : downsampled_cloud->points) {
     if (checkPointWithinLanelets(
-          pcl::PointXYZ(point.x + centroid[0], point.y + centroid[1], point.z + centroid[2]),
+          pcl::PointXYZ(point.x + offset[0], point.y + offset[1], point.z + offset[2]),
           intersected_lanelets)) {
       const size_t index = voxel_grid.getCentroidIndex(point);
       for (auto & original_point : downsampled2original_map[index].points) {
-        original_point.x += centroid[0];
-        original_point.y += centroid[1];
-        original_point.z += centroid[2];
+        original_point.x += offset[0];
+        original_point.y += offset[1];
+        original_point.z += offset[2];
         filtered_cloud.points.push_back(original_point);
       }
     }
   }
 
-  pcl::PointCloud<pcl::PointXYZ>::Ptr filtered_cloud_ptr;
-  filtered_cloud_ptr = pcl::make_shared<pcl::PointCloud<pcl::PointXYZ>>(filtered_cloud);
-  return filtered_cloud_ptr;
+  return filtered_cloud;
 }
 
 pcl::PointCloud<pcl::PointXYZ>::Ptr ElevationMapLoaderNode::createPointcloudFromElevationMap()
@@ -0,0 +1,62 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cuda_utils/cuda_unique_ptr.hpp>
+#include <cuda_utils/stream_unique_ptr.hpp>
+
+#include <cuda_runtime_api.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace euclidean_cluster
+{
+/** \brief Euclidean connected components on the device.
+ * Points are sorted by cell of size tolerance, each point is linked to the points within
+ * tolerance in its 27 neighboring cells with a lock-free union-find, so the components are the
+ * same as the ones of the region growing in pcl::EuclideanClusterExtraction.
+ */
+class CudaConnectedComponents
+{
+public:
+  CudaConnectedComponents();
+
+  /** \brief Pinned host buffer of at least num_points points to be filled before label(). */
+  float4 * inputHost(std::size_t num_points);
+
+  /** \brief Label the points written in inputHost().
+   * \return per point label, the same for all the points of a component and -1 for the
+   * non-finite points, valid until the next call
+   */
+  const std::int32_t * label(std::size_t num_points, float tolerance);
+
+private:
+  void reserve(std::size_t num_points);
+
+  cuda_utils::StreamUniquePtr stream_;
+
+  std::size_t capacity_{0};
+
+  cuda_utils::CudaUniquePtr<float4[]> points_d_;
+  cuda_utils::CudaUniquePtr<unsigned long long[]> keys_d_;  // NOLINT
+  cuda_utils::CudaUniquePtr<std::int32_t[]> order_d_;
+  cuda_utils::CudaUniquePtr<std::int32_t[]> parents_d_;
+  cuda_utils::CudaUniquePtr<std::int32_t[]> labels_d_;
+
+  cuda_utils::CudaUniquePtrHost<float4[]> points_h_;
+  cuda_utils::CudaUniquePtrHost<std::int32_t[]> labels_h_;
+};
+}  // namespace euclidean_cluster
@@ -0,0 +1,55 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "euclidean_cluster/cuda_connected_components.hpp"
+#include "euclidean_cluster/euclidean_cluster.hpp"
+#include "euclidean_cluster/voxel_grid_based_euclidean_cluster.hpp"
+
+#include <vector>
+
+namespace euclidean_cluster
+{
+// Same clusters as EuclideanCluster, with the connected components computed on the device
+class CudaEuclideanCluster : public EuclideanCluster
+{
+public:
+  using EuclideanCluster::EuclideanCluster;
+
+protected:
+  void extractClusterIndices(
+    const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & pointcloud,
+    std::vector<pcl::PointIndices> & cluster_indices) override;
+
+private:
+  CudaConnectedComponents connected_components_;
+};
+
+// Same clusters as VoxelGridBasedEuclideanCluster, with the voxels clustered on the device
+class CudaVoxelGridBasedEuclideanCluster : public VoxelGridBasedEuclideanCluster
+{
+public:
+  using VoxelGridBasedEuclideanCluster::VoxelGridBasedEuclideanCluster;
+
+protected:
+  void extractVoxelClusterIndices(
+    const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & voxel_pointcloud,
+    std::vector<pcl::PointIndices> & cluster_indices) override;
+
+private:
+  CudaConnectedComponents connected_components_;
+};
+
+}  // namespace euclidean_cluster
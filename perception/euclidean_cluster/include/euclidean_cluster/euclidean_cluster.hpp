@@ -17,6 +17,7 @@
 #include "euclidean_cluster/euclidean_cluster_interface.hpp"
 #include "euclidean_cluster/utils.hpp"
 
+#include <pcl/PointIndices.h>
 #include <pcl/point_types.h>
 
 #include <vector>
@@ -34,7 +35,12 @@ public:
     std::vector<pcl::PointCloud<pcl::PointXYZ>> & clusters) override;
   void setTolerance(float tolerance) { tolerance_ = tolerance; }
 
-private:
+protected:
+  // extract the indices of the valid clusters, sorted by decreasing size
+  virtual void extractClusterIndices(
+    const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & pointcloud,
+    std::vector<pcl::PointIndices> & cluster_indices);
+
   float tolerance_;
 };
 
@@ -17,6 +17,7 @@
 #include "euclidean_cluster/euclidean_cluster_interface.hpp"
 #include "euclidean_cluster/utils.hpp"
 
+#include <pcl/PointIndices.h>
 #include <pcl/filters/voxel_grid.h>
 #include <pcl/point_types.h>
 
@@ -42,7 +43,12 @@ public:
     min_points_number_per_voxel_ = min_points_number_per_voxel;
   }
 
-private:
+protected:
+  // extract the indices of the clusters of voxels, sorted by decreasing size
+  virtual void extractVoxelClusterIndices(
+    const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & voxel_pointcloud,
+    std::vector<pcl::PointIndices> & cluster_indices);
+
   pcl::VoxelGrid<pcl::PointXYZ> voxel_grid_;
   float tolerance_;
   float voxel_leaf_size_;
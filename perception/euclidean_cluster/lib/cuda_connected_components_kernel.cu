@@ -0,0 +1,234 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "euclidean_cluster/cuda_connected_components.hpp"
+
+#include <thrust/execution_policy.h>
+#include <thrust/sort.h>
+
+namespace
+{
+const std::size_t THREADS_PER_BLOCK = 256;
+const unsigned long long INVALID_KEY = ~0ULL;  // NOLINT
+// 21 bits per axis, cell indices are biased so that negative coordinates stay positive
+const int KEY_AXIS_BITS = 21;
+const int KEY_AXIS_BIAS = 1 << (KEY_AXIS_BITS - 1);
+const unsigned long long KEY_AXIS_MASK = (1ULL << KEY_AXIS_BITS) - 1ULL;  // NOLINT
+
+std::size_t divup(const std::size_t a, const std::size_t b)
+{
+  return (a + b - 1) / b;
+}
+
+std::size_t nextPowerOfTwo(const std::size_t n)
+{
+  std::size_t p = 1;
+  while (p < n) {
+    p <<= 1;
+  }
+  return p;
+}
+}  // namespace
+
+namespace euclidean_cluster
+{
+__device__ inline unsigned long long packCellKey(  // NOLINT
+  const int ix, const int iy, const int iz)
+{
+  return ((static_cast<unsigned long long>(ix) & KEY_AXIS_MASK) << (2 * KEY_AXIS_BITS)) |  // NOLINT
+         ((static_cast<unsigned long long>(iy) & KEY_AXIS_MASK) << KEY_AXIS_BITS) |  // NOLINT
+         (static_cast<unsigned long long>(iz) & KEY_AXIS_MASK);  // NOLINT
+}
+
+__device__ inline std::size_t lowerBound(
+  const unsigned long long * keys, const std::size_t size, const unsigned long long key)  // NOLINT
+{
+  std::size_t first = 0;
+  std::size_t count = size;
+  while (count > 0) {
+    const std::size_t step = count / 2;
+    if (keys[first + step] < key) {
+      first += step + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+  return first;
+}
+
+// every link points to a smaller index, so concurrent path halving only shortens the paths
+__device__ inline std::int32_t findRoot(volatile std::int32_t * parents, std::int32_t x)
+{
+  std::int32_t next = parents[x];
+  while (x != next) {
+    const std::int32_t grand = parents[next];
+    if (next != grand) parents[x] = grand;
+    x = next;
+    next = grand;
+  }
+  return x;
+}
+
+__device__ inline void unite(std::int32_t * parents, std::int32_t a, std::int32_t b)
+{
+  while (true) {
+    a = findRoot(parents, a);
+    b = findRoot(parents, b);
+    if (a == b) return;
+    if (a > b) {
+      const std::int32_t tmp = a;
+      a = b;
+      b = tmp;
+    }
+    // hook the larger root under the smaller one, retry if another thread hooked it first
+    if (atomicCAS(&parents[b], b, a) == b) return;
+  }
+}
+
+__global__ void computeCellKeys_kernel(
+  const float4 * points, const std::size_t num_points, const float inverse_cell_size,
+  unsigned long long * keys, std::int32_t * order)  // NOLINT
+{
+  const std::size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= num_points) return;
+
+  order[idx] = static_cast<std::int32_t>(idx);
+  const float4 p = points[idx];
+  if (!isfinite(p.x) || !isfinite(p.y) || !isfinite(p.z)) {
+    keys[idx] = INVALID_KEY;
+    return;
+  }
+  keys[idx] = packCellKey(
+    static_cast<int>(floorf(p.x * inverse_cell_size)) + KEY_AXIS_BIAS,
+    static_cast<int>(floorf(p.y * inverse_cell_size)) + KEY_AXIS_BIAS,
+    static_cast<int>(floorf(p.z * inverse_cell_size)) + KEY_AXIS_BIAS);
+}
+
+__global__ void initParents_kernel(std::int32_t * parents, const std::size_t num_points)
+{
+  const std::size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= num_points) return;
+  parents[idx] = static_cast<std::int32_t>(idx);
+}
+
+// parents are indexed by sorted position, each pair of points is tested once
+__global__ void linkNeighbors_kernel(
+  const float4 * points, const unsigned long long * sorted_keys,  // NOLINT
+  const std::int32_t * order, const std::size_t num_points, const float tolerance_sq,
+  std::int32_t * parents)
+{
+  const std::size_t s = blockIdx.x * blockDim.x + threadIdx.x;
+  if (s >= num_points) return;
+
+  const unsigned long long key = sorted_keys[s];  // NOLINT
+  if (key == INVALID_KEY) return;
+
+  const float4 p = points[order[s]];
+  const int ix = static_cast<int>((key >> (2 * KEY_AXIS_BITS)) & KEY_AXIS_MASK);
+  const int iy = static_cast<int>((key >> KEY_AXIS_BITS) & KEY_AXIS_MASK);
+  const int iz = static_cast<int>(key & KEY_AXIS_MASK);
+
+  for (int dx = -1; dx <= 1; ++dx) {
+    for (int dy = -1; dy <= 1; ++dy) {
+      for (int dz = -1; dz <= 1; ++dz) {
+        // pairs across cells are tested from the cell with the smaller key
+        const unsigned long long neighbor_key = packCellKey(ix + dx, iy + dy, iz + dz);  // NOLINT
+        if (neighbor_key < key) continue;
+
+        const std::size_t begin =
+          neighbor_key == key ? s + 1 : lowerBound(sorted_keys, num_points, neighbor_key);
+        for (std::size_t t = begin; t < num_points && sorted_keys[t] == neighbor_key; ++t) {
+          const float4 q = points[order[t]];
+          const float distance_x = p.x - q.x;
+          const float distance_y = p.y - q.y;
+          const float distance_z = p.z - q.z;
+          const float distance_sq =
+            distance_x * distance_x + distance_y * distance_y + distance_z * distance_z;
+          if (distance_sq <= tolerance_sq) {
+            unite(parents, static_cast<std::int32_t>(s), static_cast<std::int32_t>(t));
+          }
+        }
+      }
+    }
+  }
+}
+
+__global__ void writeLabels_kernel(
+  const unsigned long long * sorted_keys, const std::int32_t * order,  // NOLINT
+  const std::size_t num_points, std::int32_t * parents, std::int32_t * labels)
+{
+  const std::size_t s = blockIdx.x * blockDim.x + threadIdx.x;
+  if (s >= num_points) return;
+
+  labels[order[s]] =
+    sorted_keys[s] == INVALID_KEY ? -1 : findRoot(parents, static_cast<std::int32_t>(s));
+}
+
+CudaConnectedComponents::CudaConnectedComponents()
+: stream_(cuda_utils::makeCudaStream(cudaStreamNonBlocking))
+{
+}
+
+void CudaConnectedComponents::reserve(const std::size_t num_points)
+{
+  if (num_points > capacity_) {
+    capacity_ = nextPowerOfTwo(num_points);
+    points_d_ = cuda_utils::make_unique<float4[]>(capacity_);
+    keys_d_ = cuda_utils::make_unique<unsigned long long[]>(capacity_);  // NOLINT
+    order_d_ = cuda_utils::make_unique<std::int32_t[]>(capacity_);
+    parents_d_ = cuda_utils::make_unique<std::int32_t[]>(capacity_);
+    labels_d_ = cuda_utils::make_unique<std::int32_t[]>(capacity_);
+    points_h_ = cuda_utils::make_unique_host<float4[]>(capacity_, cudaHostAllocDefault);
+    labels_h_ = cuda_utils::make_unique_host<std::int32_t[]>(capacity_, cudaHostAllocDefault);
+  }
+}
+
+float4 * CudaConnectedComponents::inputHost(const std::size_t num_points)
+{
+  reserve(num_points);
+  return points_h_.get();
+}
+
+const std::int32_t * CudaConnectedComponents::label(
+  const std::size_t num_points, const float tolerance)
+{
+  if (num_points == 0) return labels_h_.get();
+
+  reserve(num_points);
+  CHECK_CUDA_ERROR(cudaMemcpyAsync(
+    points_d_.get(), points_h_.get(), num_points * sizeof(float4), cudaMemcpyHostToDevice,
+    *stream_));
+
+  const std::size_t blocks = divup(num_points, THREADS_PER_BLOCK);
+  computeCellKeys_kernel<<<blocks, THREADS_PER_BLOCK, 0, *stream_>>>(
+    points_d_.get(), num_points, 1.0f / tolerance, keys_d_.get(), order_d_.get());
+  thrust::sort_by_key(
+    thrust::cuda::par.on(*stream_), keys_d_.get(), keys_d_.get() + num_points, order_d_.get());
+
+  initParents_kernel<<<blocks, THREADS_PER_BLOCK, 0, *stream_>>>(parents_d_.get(), num_points);
+  linkNeighbors_kernel<<<blocks, THREADS_PER_BLOCK, 0, *stream_>>>(
+    points_d_.get(), keys_d_.get(), order_d_.get(), num_points, tolerance * tolerance,
+    parents_d_.get());
+  writeLabels_kernel<<<blocks, THREADS_PER_BLOCK, 0, *stream_>>>(
+    keys_d_.get(), order_d_.get(), num_points, parents_d_.get(), labels_d_.get());
+  CHECK_CUDA_ERROR(cudaGetLastError());
+
+  CHECK_CUDA_ERROR(cudaMemcpyAsync(
+    labels_h_.get(), labels_d_.get(), num_points * sizeof(std::int32_t), cudaMemcpyDeviceToHost,
+    *stream_));
+  CHECK_CUDA_ERROR(cudaStreamSynchronize(*stream_));
+  return labels_h_.get();
+}
+}  // namespace euclidean_cluster
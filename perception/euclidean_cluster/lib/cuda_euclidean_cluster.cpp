@@ -0,0 +1,86 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "euclidean_cluster/cuda_euclidean_cluster.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Group the labels like pcl::EuclideanClusterExtraction does: clusters are seeded in increasing
+// point index, the indices of a cluster are sorted and the clusters are sorted by decreasing size
+void groupLabels(
+  const std::int32_t * labels, const std::size_t num_points, const int min_cluster_size,
+  const int max_cluster_size, std::vector<pcl::PointIndices> & cluster_indices)
+{
+  std::vector<pcl::PointIndices> components;
+  std::unordered_map</* label */ std::int32_t, /* component index */ std::size_t> label_map;
+  for (std::size_t i = 0; i < num_points; ++i) {
+    if (labels[i] < 0) continue;
+    const auto [iter, inserted] = label_map.emplace(labels[i], components.size());
+    if (inserted) components.emplace_back();
+    components.at(iter->second).indices.push_back(static_cast<int>(i));
+  }
+
+  cluster_indices.clear();
+  for (auto & component : components) {
+    const int size = static_cast<int>(component.indices.size());
+    if (min_cluster_size <= size && size <= max_cluster_size) {
+      cluster_indices.push_back(std::move(component));
+    }
+  }
+  std::stable_sort(
+    cluster_indices.begin(), cluster_indices.end(),
+    [](const pcl::PointIndices & a, const pcl::PointIndices & b) {
+      return a.indices.size() > b.indices.size();
+    });
+}
+
+const std::int32_t * labelPointCloud(
+  const pcl::PointCloud<pcl::PointXYZ> & pointcloud, const float tolerance,
+  euclidean_cluster::CudaConnectedComponents & connected_components)
+{
+  float4 * points = connected_components.inputHost(pointcloud.size());
+  for (std::size_t i = 0; i < pointcloud.size(); ++i) {
+    const auto & point = pointcloud.points.at(i);
+    points[i] = make_float4(point.x, point.y, point.z, 0.0f);
+  }
+  return connected_components.label(pointcloud.size(), tolerance);
+}
+}  // namespace
+
+namespace euclidean_cluster
+{
+void CudaEuclideanCluster::extractClusterIndices(
+  const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & pointcloud,
+  std::vector<pcl::PointIndices> & cluster_indices)
+{
+  const std::int32_t * labels = labelPointCloud(*pointcloud, tolerance_, connected_components_);
+  groupLabels(labels, pointcloud->size(), min_cluster_size_, max_cluster_size_, cluster_indices);
+}
+
+void CudaVoxelGridBasedEuclideanCluster::extractVoxelClusterIndices(
+  const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & voxel_pointcloud,
+  std::vector<pcl::PointIndices> & cluster_indices)
+{
+  const std::int32_t * labels =
+    labelPointCloud(*voxel_pointcloud, tolerance_, connected_components_);
+  groupLabels(labels, voxel_pointcloud->size(), 1, max_cluster_size_, cluster_indices);
+}
+
+}  // namespace euclidean_cluster
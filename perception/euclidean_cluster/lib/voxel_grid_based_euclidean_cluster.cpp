@@ -63,19 +63,9 @@ bool VoxelGridBasedEuclideanCluster::cluster(
     pointcloud_2d_ptr->push_back(point2d);
   }
 
-  // create tree
-  pcl::search::KdTree<pcl::PointXYZ>::Ptr tree(new pcl::search::KdTree<pcl::PointXYZ>);
-  tree->setInputCloud(pointcloud_2d_ptr);
-
   // clustering
   std::vector<pcl::PointIndices> cluster_indices;
-  pcl::EuclideanClusterExtraction<pcl::PointXYZ> pcl_euclidean_cluster;
-  pcl_euclidean_cluster.setClusterTolerance(tolerance_);
-  pcl_euclidean_cluster.setMinClusterSize(1);
-  pcl_euclidean_cluster.setMaxClusterSize(max_cluster_size_);
-  pcl_euclidean_cluster.setSearchMethod(tree);
-  pcl_euclidean_cluster.setInputCloud(pointcloud_2d_ptr);
-  pcl_euclidean_cluster.extract(cluster_indices);
+  extractVoxelClusterIndices(pointcloud_2d_ptr, cluster_indices);
 
   // create map to search cluster index from voxel grid index
   std::unordered_map</* voxel grid index */ int, /* cluster index */ int> map;
@@ -114,4 +104,22 @@ bool VoxelGridBasedEuclideanCluster::cluster(
   return true;
 }
 
+void VoxelGridBasedEuclideanCluster::extractVoxelClusterIndices(
+  const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & voxel_pointcloud,
+  std::vector<pcl::PointIndices> & cluster_indices)
+{
+  // create tree
+  pcl::search::KdTree<pcl::PointXYZ>::Ptr tree(new pcl::search::KdTree<pcl::PointXYZ>);
+  tree->setInputCloud(voxel_pointcloud);
+
+  // clustering
+  pcl::EuclideanClusterExtraction<pcl::PointXYZ> pcl_euclidean_cluster;
+  pcl_euclidean_cluster.setClusterTolerance(tolerance_);
+  pcl_euclidean_cluster.setMinClusterSize(1);
+  pcl_euclidean_cluster.setMaxClusterSize(max_cluster_size_);
+  pcl_euclidean_cluster.setSearchMethod(tree);
+  pcl_euclidean_cluster.setInputCloud(voxel_pointcloud);
+  pcl_euclidean_cluster.extract(cluster_indices);
+}
+
 }  // namespace euclidean_cluster
@@ -0,0 +1,120 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "euclidean_cluster/cuda_euclidean_cluster.hpp"
+
+#include <cuda_runtime_api.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+namespace
+{
+pcl::PointCloud<pcl::PointXYZ>::Ptr createRandomCloud(const size_t num_points, const int seed)
+{
+  std::mt19937 engine(seed);
+  std::uniform_real_distribution<float> center(-30.0f, 30.0f);
+  std::normal_distribution<float> spread(0.0f, 0.8f);
+
+  // points around a few centers, so that there are clusters of several sizes
+  pcl::PointCloud<pcl::PointXYZ>::Ptr cloud(new pcl::PointCloud<pcl::PointXYZ>);
+  std::vector<pcl::PointXYZ> centers(20);
+  for (auto & c : centers) {
+    c = pcl::PointXYZ(center(engine), center(engine), 0.5f * center(engine));
+  }
+  for (size_t i = 0; i < num_points; ++i) {
+    const auto & c = centers.at(i % centers.size());
+    cloud->push_back(
+      pcl::PointXYZ(c.x + spread(engine), c.y + spread(engine), c.z + 0.3f * spread(engine)));
+  }
+  return cloud;
+}
+
+void expectSameClusters(
+  const std::vector<pcl::PointCloud<pcl::PointXYZ>> & expected,
+  const std::vector<pcl::PointCloud<pcl::PointXYZ>> & actual)
+{
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    ASSERT_EQ(actual.at(i).size(), expected.at(i).size());
+    for (size_t j = 0; j < expected.at(i).size(); ++j) {
+      EXPECT_EQ(actual.at(i).at(j).x, expected.at(i).at(j).x);
+      EXPECT_EQ(actual.at(i).at(j).y, expected.at(i).at(j).y);
+      EXPECT_EQ(actual.at(i).at(j).z, expected.at(i).at(j).z);
+    }
+  }
+}
+
+bool hasCudaDevice()
+{
+  int num_devices = 0;
+  return cudaGetDeviceCount(&num_devices) == cudaSuccess && num_devices > 0;
+}
+}  // namespace
+
+TEST(CudaEuclideanClusterTest, sameClustersAsCpu)
+{
+  if (!hasCudaDevice()) {
+    GTEST_SKIP() << "no CUDA device";
+  }
+
+  for (const bool use_height : {false, true}) {
+    euclidean_cluster::EuclideanCluster cpu_cluster(use_height, 3, 1000, 0.7f);
+    euclidean_cluster::CudaEuclideanCluster gpu_cluster(use_height, 3, 1000, 0.7f);
+    for (int seed = 0; seed < 5; ++seed) {
+      const auto cloud = createRandomCloud(3000, seed);
+      std::vector<pcl::PointCloud<pcl::PointXYZ>> cpu_clusters;
+      std::vector<pcl::PointCloud<pcl::PointXYZ>> gpu_clusters;
+      ASSERT_TRUE(cpu_cluster.cluster(cloud, cpu_clusters));
+      ASSERT_TRUE(gpu_cluster.cluster(cloud, gpu_clusters));
+      expectSameClusters(cpu_clusters, gpu_clusters);
+    }
+  }
+}
+
+TEST(CudaEuclideanClusterTest, voxelGridBasedSameClustersAsCpu)
+{
+  if (!hasCudaDevice()) {
+    GTEST_SKIP() << "no CUDA device";
+  }
+
+  for (const bool use_height : {false, true}) {
+    euclidean_cluster::VoxelGridBasedEuclideanCluster cpu_cluster(
+      use_height, 3, 1000, 0.7f, 0.3f, 1);
+    euclidean_cluster::CudaVoxelGridBasedEuclideanCluster gpu_cluster(
+      use_height, 3, 1000, 0.7f, 0.3f, 1);
+    for (int seed = 0; seed < 5; ++seed) {
+      const auto cloud = createRandomCloud(3000, seed);
+      std::vector<pcl::PointCloud<pcl::PointXYZ>> cpu_clusters;
+      std::vector<pcl::PointCloud<pcl::PointXYZ>> gpu_clusters;
+      ASSERT_TRUE(cpu_cluster.cluster(cloud, cpu_clusters));
+      ASSERT_TRUE(gpu_cluster.cluster(cloud, gpu_clusters));
+      expectSameClusters(cpu_clusters, gpu_clusters);
+    }
+  }
+}
+
+TEST(CudaEuclideanClusterTest, emptyCloud)
+{
+  if (!hasCudaDevice()) {
+    GTEST_SKIP() << "no CUDA device";
+  }
+
+  const pcl::PointCloud<pcl::PointXYZ>::Ptr cloud(new pcl::PointCloud<pcl::PointXYZ>);
+  euclidean_cluster::CudaEuclideanCluster gpu_cluster(true, 1, 1000, 0.7f);
+  std::vector<pcl::PointCloud<pcl::PointXYZ>> gpu_clusters;
+  ASSERT_TRUE(gpu_cluster.cluster(cloud, gpu_clusters));
+  EXPECT_TRUE(gpu_clusters.empty());
+}
@@ -37,6 +37,7 @@ using autoware_auto_perception_msgs::msg::DetectedObjects;
 using autoware_auto_perception_msgs::msg::ObjectClassification;
 using nav_msgs::msg::Odometry;
 using sensor_msgs::msg::PointCloud2;
+using tier4_autoware_utils::Box2d;
 using tier4_autoware_utils::LinearRing2d;
 using tier4_autoware_utils::Point2d;
 
@@ -98,8 +99,6 @@ private:
   double estimateAbsoluteVelocity(
     const double relative_velocity, Odometry::ConstSharedPtr odometry);
   bool isFrontVehicle(const DetectedObject & object, const LinearRing2d & front_area);
-  bool isWithinVehicle(
-    const DetectedObject & object, const pcl::PointXYZ & point, const Point2d & front_size);
 };
 
 }  // namespace front_vehicle_velocity_estimator
@@ -16,6 +16,8 @@
 
 #include <boost/geometry.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <numeric>
 #include <utility>
@@ -33,10 +35,6 @@ FrontVehicleVelocityEstimator::Output FrontVehicleVelocityEstimator::update(
   LinearRing2d front_area = createBoxArea(front_size);
   objects_with_front_vehicle = filterFrontVehicle(input.objects, front_area);
 
-  // Get nearest neighbor pointcloud
-  pcl::PointXYZ nearest_neighbor_point =
-    getNearestNeighborPoint(objects_with_front_vehicle.front_vehicle, input.pointcloud, front_size);
-
   // Set objects output
   output_.objects = *(objects_with_front_vehicle.objects_without_front_vehicle);
 
@@ -45,6 +43,10 @@ FrontVehicleVelocityEstimator::Output FrontVehicleVelocityEstimator::update(
     return output_;
   }
 
+  // Get nearest neighbor pointcloud
+  pcl::PointXYZ nearest_neighbor_point =
+    getNearestNeighborPoint(objects_with_front_vehicle.front_vehicle, input.pointcloud, front_size);
+
   // Estimate relative velocity
   double now_relative_velocity =
     estimateRelativeVelocity(nearest_neighbor_point, input.pointcloud->header.stamp);
@@ -164,49 +166,73 @@ FrontVehicleVelocityEstimator::filterFrontVehicle(
   return output;
 }
 
+// Find the point with the minimum x within the object and the front area, in a single pass over
+// the raw buffer
 pcl::PointXYZ FrontVehicleVelocityEstimator::getNearestNeighborPoint(
   const DetectedObject & object, PointCloud2::ConstSharedPtr pointcloud, const Point2d & front_size)
 {
-  pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_msg(new pcl::PointCloud<pcl::PointXYZ>);
-  pcl::fromROSMsg(*pointcloud, *pcl_msg);
+  const LinearRing2d object_ring_2d = createObjectArea(object);
+  Box2d object_box;
+  boost::geometry::envelope(object_ring_2d, object_box);
+  const double min_x = std::max(0.0, object_box.min_corner().x());
+  const double max_x = std::min(front_size.x(), object_box.max_corner().x());
+  const double min_y = std::max(-front_size.y(), object_box.min_corner().y());
+  const double max_y = std::min(front_size.y(), object_box.max_corner().y());
 
   // Initialize
   pcl::PointXYZ nearest_neighbor_point;
   bool is_initialized = false;
 
-  for (const auto & point : *pcl_msg) {
-    if (isWithinVehicle(object, point, front_size)) {
-      if (!is_initialized) {
-        nearest_neighbor_point = point;
-      } else if (point.x < nearest_neighbor_point.x) {
-        nearest_neighbor_point = point;
-      }
+  const auto update_nearest_neighbor_point = [&](const float x, const float y, const float z) {
+    // negated comparisons so that NaN is culled as well
+    if (!(z >= param_.threshold_pointcloud_z_low && z <= param_.threshold_pointcloud_z_high)) {
+      return;
+    }
+    if (!(x >= min_x && x <= max_x && y >= min_y && y <= max_y)) {
+      return;
+    }
+    if (is_initialized && !(x < nearest_neighbor_point.x)) {
+      return;
+    }
+    if (!boost::geometry::within(Point2d{x, y}, object_ring_2d)) {
+      return;
+    }
+    nearest_neighbor_point.x = x;
+    nearest_neighbor_point.y = y;
+    nearest_neighbor_point.z = z;
+    is_initialized = true;
+  };
+
+  const int x_index = pcl::getFieldIndex(*pointcloud, "x");
+  const int y_index = pcl::getFieldIndex(*pointcloud, "y");
+  const int z_index = pcl::getFieldIndex(*pointcloud, "z");
+  const auto is_float32 = [&pointcloud](const int index) {
+    return index >= 0 &&
+           pointcloud->fields[index].datatype == sensor_msgs::msg::PointField::FLOAT32;
+  };
+  if (!is_float32(x_index) || !is_float32(y_index) || !is_float32(z_index)) {
+    pcl::PointCloud<pcl::PointXYZ> pcl_msg;
+    pcl::fromROSMsg(*pointcloud, pcl_msg);
+    for (const auto & point : pcl_msg) {
+      update_nearest_neighbor_point(point.x, point.y, point.z);
     }
+    return nearest_neighbor_point;
   }
-  return nearest_neighbor_point;
-}
 
-bool FrontVehicleVelocityEstimator::isWithinVehicle(
-  const DetectedObject & object, const pcl::PointXYZ & point, const Point2d & front_size)
-{
-  LinearRing2d object_ring_2d = createObjectArea(object);
-  Point2d point_{point.x, point.y};
-  if (point.z < param_.threshold_pointcloud_z_low) {
-    return false;
-  } else if (point.z > param_.threshold_pointcloud_z_high) {
-    return false;
-  } else if (point.x < 0) {
-    return false;
-  } else if (point.x > front_size.x()) {
-    return false;
-  } else if (point.y < -front_size.y()) {
-    return false;
-  } else if (point.y > front_size.y()) {
-    return false;
-  } else if (!boost::geometry::within(point_, object_ring_2d)) {
-    return false;
+  const uint32_t x_offset = pointcloud->fields[x_index].offset;
+  const uint32_t y_offset = pointcloud->fields[y_index].offset;
+  const uint32_t z_offset = pointcloud->fields[z_index].offset;
+  for (uint32_t row = 0; row < pointcloud->height; ++row) {
+    const uint8_t * point_data = &pointcloud->data[static_cast<size_t>(row) * pointcloud->row_step];
+    for (uint32_t col = 0; col < pointcloud->width; ++col, point_data += pointcloud->point_step) {
+      float x, y, z;
+      std::memcpy(&x, point_data + x_offset, sizeof(float));
+      std::memcpy(&y, point_data + y_offset, sizeof(float));
+      std::memcpy(&z, point_data + z_offset, sizeof(float));
+      update_nearest_neighbor_point(x, y, z);
+    }
   }
-  return true;
+  return nearest_neighbor_point;
 }
 
 double FrontVehicleVelocityEstimator::estimateRelativeVelocity(
@@ -20,8 +20,8 @@
 #include <geometry_msgs/msg/pose_array.hpp>
 #include <sensor_msgs/msg/point_cloud2.hpp>
 
-#include <pcl/filters/extract_indices.h>
 #include <pcl/filters/voxel_grid.h>
+#include <pcl/sample_consensus/sac_model_plane.h>
 #include <pcl/segmentation/sac_segmentation.h>
 #include <pcl_conversions/pcl_conversions.h>
 #include <tf2/transform_datatypes.h>
@@ -54,6 +54,43 @@ struct RGB
   double b = 0.0;
 };
 
+/**
+ * @brief Ground plane of the previous frames, reused instead of running RANSAC while it keeps at
+ * least kMinInlierRatio of the inlier ratio it had when RANSAC found it. The reference ratio is
+ * not updated by the reused planes, so that it does not decay from frame to frame.
+ */
+class PreviousPlane
+{
+public:
+  static constexpr double kMinInlierRatio = 0.9;
+
+  void reset() { valid_ = false; }
+  bool valid() const { return valid_; }
+  const Eigen::VectorXf & coefficients() const { return coefficients_; }
+
+  // plane found by RANSAC, its inlier ratio becomes the reference
+  void setFromRansac(const Eigen::VectorXf & coefficients, const double inlier_ratio)
+  {
+    valid_ = true;
+    coefficients_ = coefficients;
+    ransac_inlier_ratio_ = inlier_ratio;
+  }
+
+  // plane refined from the previous one, the reference of the last RANSAC plane is kept
+  void setRefined(const Eigen::VectorXf & coefficients) { coefficients_ = coefficients; }
+
+  // whether the previous plane, refined on a new frame with this inlier ratio, still fits
+  bool fits(const double inlier_ratio) const
+  {
+    return valid_ && inlier_ratio >= ransac_inlier_ratio_ * kMinInlierRatio;
+  }
+
+private:
+  bool valid_ = false;
+  Eigen::VectorXf coefficients_;
+  double ransac_inlier_ratio_ = 0.0;
+};
+
 class RANSACGroundFilterComponent : public pointcloud_preprocessor::Filter
 {
   using PointType = pcl::PointXYZ;
@@ -62,6 +99,11 @@ protected:
   void filter(
     const PointCloud2ConstPtr & input, const IndicesPtr & indices, PointCloud2 & output) override;
 
+  // Reads, transforms and classifies the raw buffer in one pass, see filterFused()
+  void faster_filter(
+    const PointCloud2ConstPtr & input, const IndicesPtr & indices, PointCloud2 & output,
+    const TransformInfo & transform_info) override;
+
 private:
   rclcpp::Publisher<geometry_msgs::msg::PoseArray>::SharedPtr debug_pose_array_pub_;
   rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr debug_ground_cloud_pub_;
@@ -79,40 +121,61 @@ private:
   double voxel_size_z_ = 0.1;
   bool debug_ = false;
   bool is_initialized_debug_message_ = false;
+  bool reuse_previous_plane_ = false;
   Eigen::Vector3d unit_vec_ = Eigen::Vector3d::UnitZ();
 
+  // workspaces reused across frames
+  pcl::PointCloud<PointType>::Ptr sensor_cloud_ptr_{new pcl::PointCloud<PointType>};
+  pcl::PointCloud<PointType>::Ptr downsampled_cloud_ptr_{new pcl::PointCloud<PointType>};
+  pcl::VoxelGrid<PointType> voxel_filter_;
+  pcl::SACSegmentation<PointType> segmentation_;
+  pcl::PointIndices::Ptr inliers_{new pcl::PointIndices};
+  pcl::ModelCoefficients::Ptr coefficients_{new pcl::ModelCoefficients};
+
+  // plane of the previous frame, tried before running RANSAC when reuse_previous_plane_ is set
+  PreviousPlane previous_plane_;
+
   /*!
-   * Output transformed PointCloud from in_cloud_ptr->header.frame_id to in_target_frame
-   * @param[in] in_target_frame Coordinate system to perform transform
-   * @param[in] in_cloud_ptr PointCloud to perform transform
-   * @param[out] out_cloud_ptr Resulting transformed PointCloud
+   * Get the matrix transforming the input from its frame to base_frame_
+   * @param[in] input PointCloud in its original frame
+   * @param[in] transform_info Transform to tf_input_frame_, reused when it is base_frame_
+   * @param[out] transform Resulting matrix
    * @retval true transform succeeded
    * @retval false transform failed
    */
-  bool transformPointCloud(
-    const std::string & in_target_frame, const PointCloud2ConstPtr & in_cloud_ptr,
-    const PointCloud2::SharedPtr & out_cloud_ptr);
+  bool getTransformToBase(
+    const PointCloud2 & input, const TransformInfo & transform_info, Eigen::Matrix4f & transform);
 
   /*!
-   * Returns the resulting complementary PointCloud, one with the points kept and the other removed
-   * as indicated in the indices
-   * @param in_cloud_ptr Input PointCloud to which the extraction will be performed
-   * @param in_indices Indices of the points to be both removed and kept
-   * @param out_only_indices_cloud_ptr Resulting PointCloud with the indices kept
-   * @param out_removed_indices_cloud_ptr Resulting PointCloud with the indices removed
+   * Copy the x/y/z of the input into output while applying transform
+   * @param[in] input PointCloud with float32 x/y/z fields
+   * @param[in] transform Transform applied to every finite point
+   * @param[out] output Resulting PointCloud, resized to the number of input points
    */
-  void extractPointsIndices(
-    const pcl::PointCloud<PointType>::Ptr in_cloud_ptr, const pcl::PointIndices & in_indices,
-    pcl::PointCloud<PointType>::Ptr out_only_indices_cloud_ptr,
-    pcl::PointCloud<PointType>::Ptr out_removed_indices_cloud_ptr);
+  void readTransformedCloud(
+    const PointCloud2 & input, const Eigen::Matrix4f & transform,
+    pcl::PointCloud<PointType> & output) const;
 
   Eigen::Affine3d getPlaneAffine(
-    const pcl::PointCloud<PointType> segment_ground_cloud, const Eigen::Vector3d & plane_normal);
+    const pcl::PointCloud<PointType> & cloud, const pcl::PointIndices & inliers,
+    const Eigen::Vector3d & plane_normal);
 
   void applyRANSAC(
     const pcl::PointCloud<PointType>::Ptr & input, pcl::PointIndices::Ptr & output_inliers,
     pcl::ModelCoefficients::Ptr & output_coefficients);
 
+  /*!
+   * Refine the previous frame's plane on input, skipping RANSAC when it still fits
+   * @retval true the previous plane still fits, see PreviousPlane::fits()
+   * @retval false there is no previous plane or it no longer fits
+   */
+  bool refinePreviousPlane(
+    const pcl::PointCloud<PointType>::Ptr & input, pcl::PointIndices & output_inliers,
+    pcl::ModelCoefficients & output_coefficients);
+
+  void filterFused(
+    const PointCloud2ConstPtr & input, const TransformInfo & transform_info, PointCloud2 & output);
+
   void publishDebugMessage(
     const geometry_msgs::msg::PoseArray & debug_pose_array,
     const pcl::PointCloud<PointType> & ground_cloud, const std_msgs::msg::Header & header);
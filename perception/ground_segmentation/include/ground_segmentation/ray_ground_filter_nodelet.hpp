@@ -47,7 +47,6 @@
 
 #include <sensor_msgs/msg/point_cloud2.hpp>
 
-#include <pcl/filters/extract_indices.h>
 #include <pcl/filters/voxel_grid.h>
 #include <pcl_conversions/pcl_conversions.h>
 #include <tf2/transform_datatypes.h>
@@ -65,7 +64,6 @@
 #include <vector>
 // #include <pcl_ros/point_cloud.h>
 
-#include "ground_segmentation/gencolors.hpp"
 #include "pointcloud_preprocessor/filter.hpp"
 
 #include <opencv2/core.hpp>
@@ -86,24 +84,27 @@ class RayGroundFilterComponent : public pointcloud_preprocessor::Filter
 {
   typedef pcl::PointXYZ PointType_;
 
-  struct PointXYZRTColor
+  struct PointXYZRT
   {
     pcl::PointXYZ point;
 
-    size_t ring;  // ring number if available
-
     float radius;  // cylindrical coords on XY Plane
-    float theta;   // angle deg on XY plane
 
     size_t radial_div;  // index of the radial division to which this point belongs to
+  };
+  typedef std::vector<PointXYZRT> PointCloudXYZRT;
 
-    size_t red;    // Red component  [0-255]
-    size_t green;  // Green Component[0-255]
-    size_t blue;   // Blue component [0-255]
-
-    size_t original_index;  // index of this point in the source pointcloud
+  /*!
+   * Points of all the radial divisions in one flat array: the indices of the points of division i,
+   * ordered by radius, are ordered_indices[ray_offsets[i]] to ordered_indices[ray_offsets[i + 1]]
+   */
+  struct RadialLayout
+  {
+    std::vector<size_t> ray_offsets;
+    std::vector<size_t> ordered_indices;
+    std::vector<size_t> bucket_ordered_indices;  // scratch of the radius pass
+    std::vector<size_t> counts;                  // scratch of both counting passes
   };
-  typedef std::vector<PointXYZRTColor> PointCloudXYZRTColor;
 
 protected:
   void filter(
@@ -121,6 +122,7 @@ private:
     reclass_distance_threshold_;  // distance between points at which re classification will occur
 
   size_t radial_dividers_num_;
+  int num_threads_;  // threads of the per point and per radial division loops
 
   size_t grid_width_;
   size_t grid_height_;
@@ -136,11 +138,14 @@ private:
   Polygon vehicle_footprint_;
   bool use_vehicle_footprint_;
 
-  std::vector<cv::Scalar> colors_;
-  const size_t color_num_ = 10;                          // different number of color to generate
   pcl::PointCloud<PointType_>::Ptr previous_cloud_ptr_;  // holds the previous groundless result of
                                                          // ground classification
 
+  // workspaces reused across frames
+  PointCloudXYZRT organized_points_;
+  RadialLayout radial_layout_;
+  std::vector<uint8_t> is_ground_;
+
   /*!
    * Output transformed PointCloud from in_cloud_ptr->header.frame_id to in_target_frame
    * @param[in] in_target_frame Coordinate system to perform transform
@@ -151,44 +156,25 @@ private:
    */
 
   /*!
-   *
+   * Organizes the points in radial divisions ordered by radius, with two counting sort passes
+   * (by radius bucket, then by division) instead of a comparison sort
    * @param[in] in_cloud Input Point Cloud to be organized in radial segments
-   * @param[out] out_organized_points Custom Point Cloud filled with XYZRTZColor data
-   * @param[out] out_radial_divided_indices Indices of the points in the original cloud for each
-   * radial segment
-   * @param[out] out_radial_ordered_clouds Vector of Points Clouds, each element will contain the
-   * points ordered
+   * @param[out] out_organized_points Custom Point Cloud filled with XYZRT data, in input order
+   * @param[out] out_radial_layout Indices of the points ordered by radial division and radius
    */
-  void ConvertXYZIToRTZColor(
-    const pcl::PointCloud<PointType_>::Ptr in_cloud, PointCloudXYZRTColor & out_organized_points,
-    std::vector<pcl::PointIndices> & out_radial_divided_indices,
-    std::vector<PointCloudXYZRTColor> & out_radial_ordered_clouds);
+  void ConvertXYZIToRTZ(
+    const pcl::PointCloud<PointType_> & in_cloud, PointCloudXYZRT & out_organized_points,
+    RadialLayout & out_radial_layout);
 
   /*!
-   * Classifies Points in the PointCloud as Ground and Not Ground
-   * @param in_radial_ordered_clouds Vector of an Ordered PointsCloud ordered by radial distance
-   * from the origin
-   * @param out_ground_indices Returns the indices of the points classified as ground in the
-   * original PointCloud
-   * @param out_no_ground_indices Returns the indices of the points classified as not ground in the
-   * original PointCloud
+   * Classifies Points in the PointCloud as Ground and Not Ground, the radial divisions in parallel
+   * @param in_organized_points Custom Point Cloud filled with XYZRT data, in input order
+   * @param in_radial_layout Indices of the points ordered by radial division and radius
+   * @param out_is_ground Returns whether each point of the original PointCloud is ground
    */
   void ClassifyPointCloud(
-    std::vector<PointCloudXYZRTColor> & in_radial_ordered_clouds,
-    pcl::PointIndices & out_ground_indices, pcl::PointIndices & out_no_ground_indices);
-
-  /*!
-   * Returns the resulting complementary PointCloud, one with the points kept and the other removed
-   * as indicated in the indices
-   * @param in_cloud_ptr Input PointCloud to which the extraction will be performed
-   * @param in_indices Indices of the points to be both removed and kept
-   * @param out_only_indices_cloud_ptr Resulting PointCloud with the indices kept
-   * @param out_removed_indices_cloud_ptr Resulting PointCloud with the indices removed
-   */
-  void ExtractPointsIndices(
-    const pcl::PointCloud<PointType_>::Ptr in_cloud_ptr, const pcl::PointIndices & in_indices,
-    pcl::PointCloud<PointType_>::Ptr out_only_indices_cloud_ptr,
-    pcl::PointCloud<PointType_>::Ptr out_removed_indices_cloud_ptr);
+    const PointCloudXYZRT & in_organized_points, const RadialLayout & in_radial_layout,
+    std::vector<uint8_t> & out_is_ground);
 
   boost::optional<float> calcPointVehicleIntersection(const Point & point);
 
@@ -165,6 +165,8 @@ private:
   float grid_mode_switch_radius_;           // non linear grid size switching distance
   double global_slope_max_angle_rad_;       // radians
   double local_slope_max_angle_rad_;        // radians
+  double global_slope_max_ratio_;           // tan(global_slope_max_angle_rad_)
+  double local_slope_max_ratio_;            // tan(local_slope_max_angle_rad_)
   double radial_divider_angle_rad_;         // distance in rads between dividers
   double split_points_distance_tolerance_;  // distance in meters between concentric divisions
   double                                    // minimum height threshold regardless the slope,
@@ -172,8 +174,12 @@ private:
   bool use_virtual_ground_point_;
   bool use_recheck_ground_cluster_;  // to enable recheck ground cluster
   size_t radial_dividers_num_;
+  int num_threads_;  // number of threads classifying the radial divisions
   VehicleInfo vehicle_info_;
 
+  // radial buckets reused across frames to avoid reallocating them for every pointcloud
+  std::vector<PointCloudRefVector> radial_ordered_points_;
+
   /*!
    * Output transformed PointCloud from in_cloud_ptr->header.frame_id to in_target_frame
    * @param[in] in_target_frame Coordinate system to perform transform
@@ -195,11 +201,26 @@ private:
   void convertPointcloudGridScan(
     const pcl::PointCloud<pcl::PointXYZ>::Ptr in_cloud,
     std::vector<PointCloudRefVector> & out_radial_ordered_points_manager);
+  /*!
+   * Resize the radial buckets to the number of radial divisions and empty them
+   * @param radial_ordered_points Radial buckets, their capacity is kept
+   */
+  void resetRadialOrderedPoints(std::vector<PointCloudRefVector> & radial_ordered_points) const;
+  /*!
+   * Order the points of each radial bucket by radius, skipping the buckets already ordered
+   * @param radial_ordered_points Radial buckets to be ordered
+   */
+  void sortRadialOrderedPoints(std::vector<PointCloudRefVector> & radial_ordered_points) const;
   /*!
    * Output ground center of front wheels as the virtual ground point
    * @param[out] point Virtual ground origin point
    */
-  void calcVirtualGroundOrigin(pcl::PointXYZ & point);
+  void calcVirtualGroundOrigin(pcl::PointXYZ & point) const;
+
+  /*!
+   * Update the tangents of the slope thresholds, so that slopes are compared without atan
+   */
+  void updateSlopeThresholds();
 
   /*!
    * Classifies Points in the PointCloud as Ground and Not Ground
@@ -210,17 +231,33 @@ private:
    */
 
   void initializeFirstGndGrids(
-    const float h, const float r, const uint16_t id, std::vector<GridCenter> & gnd_grids);
+    const float h, const float r, const uint16_t id, std::vector<GridCenter> & gnd_grids) const;
 
-  void checkContinuousGndGrid(PointRef & p, const std::vector<GridCenter> & gnd_grids_list);
-  void checkDiscontinuousGndGrid(PointRef & p, const std::vector<GridCenter> & gnd_grids_list);
-  void checkBreakGndGrid(PointRef & p, const std::vector<GridCenter> & gnd_grids_list);
+  void checkContinuousGndGrid(PointRef & p, const std::vector<GridCenter> & gnd_grids_list) const;
+  void checkDiscontinuousGndGrid(
+    PointRef & p, const std::vector<GridCenter> & gnd_grids_list) const;
+  void checkBreakGndGrid(PointRef & p, const std::vector<GridCenter> & gnd_grids_list) const;
   void classifyPointCloud(
     std::vector<PointCloudRefVector> & in_radial_ordered_clouds,
     pcl::PointIndices & out_no_ground_indices);
   void classifyPointCloudGridScan(
     std::vector<PointCloudRefVector> & in_radial_ordered_clouds,
     pcl::PointIndices & out_no_ground_indices);
+  /*!
+   * Classifies the points of a single radial division, rays are independent so that they can be
+   * classified in parallel
+   * @param in_ray Points of the radial division ordered by radial distance from the origin
+   * @param out_no_ground_indices Returns the indices of the points of this radial division
+   *     classified as not ground in the original PointCloud
+   */
+  void classifyRay(PointCloudRefVector & in_ray, pcl::PointIndices & out_no_ground_indices) const;
+  void classifyRayGridScan(
+    PointCloudRefVector & in_ray, pcl::PointIndices & out_no_ground_indices) const;
+  /*!
+   * Concatenates the per ray indices in ray order
+   */
+  static void mergeIndices(
+    const std::vector<pcl::PointIndices> & in_indices_list, pcl::PointIndices & out_indices);
   /*!
    * Re-classifies point of ground cluster based on their height
    * @param gnd_cluster Input ground cluster for re-checking
@@ -229,7 +266,7 @@ private:
    */
   void recheckGroundCluster(
     PointsCentroid & gnd_cluster, const float non_ground_threshold,
-    pcl::PointIndices & non_ground_indices);
+    pcl::PointIndices & non_ground_indices) const;
   /*!
    * Returns the resulting complementary PointCloud, one with the points kept
    * and the other removed as indicated in the indices
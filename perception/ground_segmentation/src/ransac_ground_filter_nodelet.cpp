@@ -14,10 +14,13 @@
 
 #include "ground_segmentation/ransac_ground_filter_nodelet.hpp"
 
-#include <pcl_ros/transforms.hpp>
+#include <sensor_msgs/point_cloud2_iterator.hpp>
 
 #include <pcl/common/centroid.h>
+#include <pcl/common/io.h>
+#include <pcl/common/transforms.h>
 
+#include <cstring>
 #include <limits>
 #include <random>
 #include <string>
@@ -97,6 +100,7 @@ RANSACGroundFilterComponent::RANSACGroundFilterComponent(const rclcpp::NodeOptio
   voxel_size_z_ = declare_parameter("voxel_size_z", 0.04);
   height_threshold_ = declare_parameter("height_threshold", 0.01);
   debug_ = declare_parameter("debug", false);
+  reuse_previous_plane_ = declare_parameter("reuse_previous_plane", false);
 
   if (unit_axis_ == "x") {
     unit_vec_ = Eigen::Vector3d::UnitX();
@@ -154,53 +158,79 @@ void RANSACGroundFilterComponent::publishDebugMessage(
   debug_ground_cloud_pub_->publish(*ground_cloud_msg_ptr);
 }
 
-bool RANSACGroundFilterComponent::transformPointCloud(
-  const std::string & in_target_frame, const PointCloud2ConstPtr & in_cloud_ptr,
-  const PointCloud2::SharedPtr & out_cloud_ptr)
+bool RANSACGroundFilterComponent::getTransformToBase(
+  const PointCloud2 & input, const TransformInfo & transform_info, Eigen::Matrix4f & transform)
 {
-  if (in_target_frame == in_cloud_ptr->header.frame_id) {
-    *out_cloud_ptr = *in_cloud_ptr;
+  if (input.header.frame_id == base_frame_) {
+    transform = Eigen::Matrix4f::Identity();
+    return true;
+  }
+  if (transform_info.need_transform && tf_input_frame_ == base_frame_) {
+    transform = transform_info.eigen_transform;
     return true;
   }
 
   geometry_msgs::msg::TransformStamped transform_stamped;
   try {
     transform_stamped = tf_buffer_->lookupTransform(
-      in_target_frame, in_cloud_ptr->header.frame_id, in_cloud_ptr->header.stamp,
-      rclcpp::Duration::from_seconds(1.0));
+      base_frame_, input.header.frame_id, input.header.stamp, rclcpp::Duration::from_seconds(1.0));
   } catch (tf2::TransformException & ex) {
     RCLCPP_WARN(this->get_logger(), "%s", ex.what());
     return false;
   }
-  // tf2::doTransform(*in_cloud_ptr, *out_cloud_ptr, transform_stamped);
-  Eigen::Matrix4f mat = tf2::transformToEigen(transform_stamped.transform).matrix().cast<float>();
-  pcl_ros::transformPointCloud(mat, *in_cloud_ptr, *out_cloud_ptr);
-  out_cloud_ptr->header.frame_id = in_target_frame;
+  transform = tf2::transformToEigen(transform_stamped.transform).matrix().cast<float>();
   return true;
 }
 
-void RANSACGroundFilterComponent::extractPointsIndices(
-  const pcl::PointCloud<PointType>::Ptr in_cloud_ptr, const pcl::PointIndices & in_indices,
-  pcl::PointCloud<PointType>::Ptr out_only_indices_cloud_ptr,
-  pcl::PointCloud<PointType>::Ptr out_removed_indices_cloud_ptr)
+void RANSACGroundFilterComponent::readTransformedCloud(
+  const PointCloud2 & input, const Eigen::Matrix4f & transform,
+  pcl::PointCloud<PointType> & output) const
 {
-  pcl::ExtractIndices<PointType> extract_ground;
-  extract_ground.setInputCloud(in_cloud_ptr);
-  extract_ground.setIndices(pcl::make_shared<pcl::PointIndices>(in_indices));
-
-  extract_ground.setNegative(false);  // true removes the indices, false leaves only the indices
-  extract_ground.filter(*out_only_indices_cloud_ptr);
+  const int x_index = pcl::getFieldIndex(input, "x");
+  const int y_index = pcl::getFieldIndex(input, "y");
+  const int z_index = pcl::getFieldIndex(input, "z");
+  const auto is_float32 = [&input](const int index) {
+    return index >= 0 && input.fields[index].datatype == sensor_msgs::msg::PointField::FLOAT32;
+  };
+  if (!is_float32(x_index) || !is_float32(y_index) || !is_float32(z_index)) {
+    pcl::fromROSMsg(input, output);
+    pcl::transformPointCloud(output, output, transform);
+    return;
+  }
 
-  extract_ground.setNegative(true);  // true removes the indices, false leaves only the indices
-  extract_ground.filter(*out_removed_indices_cloud_ptr);
+  const uint32_t x_offset = input.fields[x_index].offset;
+  const uint32_t y_offset = input.fields[y_index].offset;
+  const uint32_t z_offset = input.fields[z_index].offset;
+  output.resize(static_cast<size_t>(input.width) * input.height);
+  size_t index = 0;
+  for (uint32_t row = 0; row < input.height; ++row) {
+    const uint8_t * point_data = &input.data[static_cast<size_t>(row) * input.row_step];
+    for (uint32_t col = 0; col < input.width; ++col, point_data += input.point_step) {
+      Eigen::Vector4f point(0, 0, 0, 1);
+      std::memcpy(&point[0], point_data + x_offset, sizeof(float));
+      std::memcpy(&point[1], point_data + y_offset, sizeof(float));
+      std::memcpy(&point[2], point_data + z_offset, sizeof(float));
+      if (point.allFinite()) {
+        point = transform * point;
+      }
+      auto & p = output.points[index++];
+      p.x = point[0];
+      p.y = point[1];
+      p.z = point[2];
+    }
+  }
+  output.width = input.width * input.height;
+  output.height = 1;
+  output.is_dense = input.is_dense;
 }
 
 Eigen::Affine3d RANSACGroundFilterComponent::getPlaneAffine(
-  const pcl::PointCloud<PointType> segment_ground_cloud, const Eigen::Vector3d & plane_normal)
+  const pcl::PointCloud<PointType> & cloud, const pcl::PointIndices & inliers,
+  const Eigen::Vector3d & plane_normal)
 {
   pcl::CentroidPoint<pcl::PointXYZ> centroid;
-  for (const auto p : segment_ground_cloud.points) {
-    centroid.add(p);
+  for (const auto index : inliers.indices) {
+    centroid.add(cloud.points[index]);
   }
   pcl::PointXYZ centroid_point;
   centroid.get(centroid_point);
@@ -216,15 +246,39 @@ void RANSACGroundFilterComponent::applyRANSAC(
   const pcl::PointCloud<PointType>::Ptr & input, pcl::PointIndices::Ptr & output_inliers,
   pcl::ModelCoefficients::Ptr & output_coefficients)
 {
-  pcl::SACSegmentation<PointType> seg;
-  seg.setOptimizeCoefficients(true);
-  seg.setRadiusLimits(0.3, std::numeric_limits<double>::max());
-  seg.setMethodType(pcl::SAC_RANSAC);
-  seg.setDistanceThreshold(outlier_threshold_);
-  seg.setInputCloud(input);
-  seg.setMaxIterations(max_iterations_);
-  seg.setModelType(pcl::SACMODEL_PLANE);
-  seg.segment(*output_inliers, *output_coefficients);
+  segmentation_.setOptimizeCoefficients(true);
+  segmentation_.setRadiusLimits(0.3, std::numeric_limits<double>::max());
+  segmentation_.setMethodType(pcl::SAC_RANSAC);
+  segmentation_.setDistanceThreshold(outlier_threshold_);
+  segmentation_.setInputCloud(input);
+  segmentation_.setMaxIterations(max_iterations_);
+  segmentation_.setModelType(pcl::SACMODEL_PLANE);
+  segmentation_.segment(*output_inliers, *output_coefficients);
+}
+
+bool RANSACGroundFilterComponent::refinePreviousPlane(
+  const pcl::PointCloud<PointType>::Ptr & input, pcl::PointIndices & output_inliers,
+  pcl::ModelCoefficients & output_coefficients)
+{
+  if (!previous_plane_.valid() || input->points.empty()) {
+    return false;
+  }
+
+  pcl::SampleConsensusModelPlane<PointType> model(input);
+  model.selectWithinDistance(
+    previous_plane_.coefficients(), outlier_threshold_, output_inliers.indices);
+  const double inlier_ratio =
+    static_cast<double>(output_inliers.indices.size()) / input->points.size();
+  if (output_inliers.indices.size() < 3 || !previous_plane_.fits(inlier_ratio)) {
+    return false;
+  }
+
+  Eigen::VectorXf refined_coefficients;
+  model.optimizeModelCoefficients(
+    output_inliers.indices, previous_plane_.coefficients(), refined_coefficients);
+  model.selectWithinDistance(refined_coefficients, outlier_threshold_, output_inliers.indices);
+  output_coefficients.values.assign(refined_coefficients.data(), refined_coefficients.data() + 4);
+  return true;
 }
 
 void RANSACGroundFilterComponent::filter(
@@ -232,90 +286,115 @@ void RANSACGroundFilterComponent::filter(
   PointCloud2 & output)
 {
   std::scoped_lock lock(mutex_);
-  sensor_msgs::msg::PointCloud2::SharedPtr input_transformed_ptr(new sensor_msgs::msg::PointCloud2);
-  if (!transformPointCloud(base_frame_, input, input_transformed_ptr)) {
+  filterFused(input, TransformInfo(), output);
+}
+
+void RANSACGroundFilterComponent::faster_filter(
+  const PointCloud2ConstPtr & input, [[maybe_unused]] const IndicesPtr & indices,
+  PointCloud2 & output, const TransformInfo & transform_info)
+{
+  std::scoped_lock lock(mutex_);
+  filterFused(input, transform_info, output);
+}
+
+void RANSACGroundFilterComponent::filterFused(
+  const PointCloud2ConstPtr & input, const TransformInfo & transform_info, PointCloud2 & output)
+{
+  Eigen::Matrix4f base_transform;
+  if (!getTransformToBase(*input, transform_info, base_transform)) {
     RCLCPP_ERROR_STREAM_THROTTLE(
       this->get_logger(), *this->get_clock(), std::chrono::milliseconds(1000).count(),
       "Failed transform from " << base_frame_ << " to " << input->header.frame_id);
     return;
   }
-  pcl::PointCloud<PointType>::Ptr current_sensor_cloud_ptr(new pcl::PointCloud<PointType>);
-  pcl::fromROSMsg(*input_transformed_ptr, *current_sensor_cloud_ptr);
+  readTransformedCloud(*input, base_transform, *sensor_cloud_ptr_);
+
+  const auto output_input = [&]() {
+    previous_plane_.reset();
+    copyPointsIf(*input, transform_info, output, [](size_t, const Eigen::Vector4f &) {
+      return true;
+    });
+  };
 
   // downsample pointcloud to reduce ransac calculation cost
-  pcl::PointCloud<PointType>::Ptr downsampled_cloud(new pcl::PointCloud<PointType>);
-  downsampled_cloud->points.reserve(current_sensor_cloud_ptr->points.size());
-  pcl::VoxelGrid<PointType> filter;
-  filter.setInputCloud(current_sensor_cloud_ptr);
-  filter.setLeafSize(voxel_size_x_, voxel_size_y_, voxel_size_z_);
-  filter.filter(*downsampled_cloud);
-
-  // apply ransac
-  pcl::PointIndices::Ptr inliers(new pcl::PointIndices);
-  pcl::ModelCoefficients::Ptr coefficients(new pcl::ModelCoefficients);
-  applyRANSAC(downsampled_cloud, inliers, coefficients);
-
-  if (coefficients->values.empty()) {
+  voxel_filter_.setInputCloud(sensor_cloud_ptr_);
+  voxel_filter_.setLeafSize(voxel_size_x_, voxel_size_y_, voxel_size_z_);
+  voxel_filter_.filter(*downsampled_cloud_ptr_);
+
+  // apply ransac, unless the plane of the previous frame still fits
+  coefficients_->values.clear();
+  const bool is_previous_plane_reused =
+    reuse_previous_plane_ && refinePreviousPlane(downsampled_cloud_ptr_, *inliers_, *coefficients_);
+  if (!is_previous_plane_reused) {
+    applyRANSAC(downsampled_cloud_ptr_, inliers_, coefficients_);
+  }
+
+  if (coefficients_->values.empty()) {
     RCLCPP_WARN_THROTTLE(
       this->get_logger(), *this->get_clock(), std::chrono::milliseconds(1000).count(),
       "failed to find a plane");
-    output = *input;
+    output_input();
     return;
   }
 
   // filter too tilt plane to avoid mis-fitting (e.g. fitting to wall plane)
   Eigen::Vector3d plane_normal(
-    coefficients->values[0], coefficients->values[1], coefficients->values[2]);
+    coefficients_->values[0], coefficients_->values[1], coefficients_->values[2]);
   {
     const auto plane_slope = std::abs(
       std::acos(plane_normal.dot(unit_vec_) / (plane_normal.norm() * unit_vec_.norm())) * 180 /
       M_PI);
     if (plane_slope > plane_slope_threshold_) {
-      output = *input;
+      output_input();
       return;
     }
   }
 
-  // extract pointcloud from indices
-  pcl::PointCloud<PointType>::Ptr segment_ground_cloud_ptr(new pcl::PointCloud<PointType>);
-  pcl::PointCloud<PointType>::Ptr segment_no_ground_cloud_ptr(new pcl::PointCloud<PointType>);
-  extractPointsIndices(
-    downsampled_cloud, *inliers, segment_ground_cloud_ptr, segment_no_ground_cloud_ptr);
-  const Eigen::Affine3d plane_affine = getPlaneAffine(*segment_ground_cloud_ptr, plane_normal);
-  pcl::PointCloud<PointType>::Ptr no_ground_cloud_ptr(new pcl::PointCloud<PointType>);
+  const Eigen::VectorXf plane_coefficients =
+    Eigen::Map<const Eigen::Vector4f>(coefficients_->values.data());
+  if (is_previous_plane_reused) {
+    previous_plane_.setRefined(plane_coefficients);
+  } else {
+    previous_plane_.setFromRansac(
+      plane_coefficients,
+      static_cast<double>(inliers_->indices.size()) / downsampled_cloud_ptr_->points.size());
+  }
+
+  // the height in the plane frame is the signed distance to the plane through the inlier centroid
+  const Eigen::Affine3d plane_affine =
+    getPlaneAffine(*downsampled_cloud_ptr_, *inliers_, plane_normal);
+  const Eigen::Vector3f normal = plane_normal.normalized().cast<float>();
+  const float offset = -normal.dot(plane_affine.translation().cast<float>());
+  const float height_threshold = static_cast<float>(height_threshold_);
 
   // use not downsampled pointcloud for extract pointcloud that higher than height threshold
-  for (const auto & p : current_sensor_cloud_ptr->points) {
-    const Eigen::Vector3d transformed_point =
-      plane_affine.inverse() * Eigen::Vector3d(p.x, p.y, p.z);
-    if (std::abs(transformed_point.z()) > height_threshold_) {
-      no_ground_cloud_ptr->points.push_back(p);
+  sensor_msgs::PointCloud2Modifier modifier(output);
+  modifier.setPointCloud2FieldsByString(1, "xyz");
+  modifier.resize(sensor_cloud_ptr_->points.size());
+  uint8_t * output_data = output.data.data();
+  size_t output_size = 0;
+  for (const auto & p : sensor_cloud_ptr_->points) {
+    const Eigen::Vector3f point(p.x, p.y, p.z);
+    if (std::abs(normal.dot(point) + offset) > height_threshold) {
+      std::memcpy(output_data, point.data(), 3 * sizeof(float));
+      output_data += output.point_step;
+      ++output_size;
     }
   }
-
-  sensor_msgs::msg::PointCloud2::SharedPtr no_ground_cloud_msg_ptr(
-    new sensor_msgs::msg::PointCloud2);
-  pcl::toROSMsg(*no_ground_cloud_ptr, *no_ground_cloud_msg_ptr);
-  no_ground_cloud_msg_ptr->header = input->header;
-  sensor_msgs::msg::PointCloud2::SharedPtr no_ground_cloud_transformed_msg_ptr(
-    new sensor_msgs::msg::PointCloud2);
-  if (!transformPointCloud(
-        base_frame_, no_ground_cloud_msg_ptr, no_ground_cloud_transformed_msg_ptr)) {
-    RCLCPP_ERROR_STREAM_THROTTLE(
-      this->get_logger(), *this->get_clock(), std::chrono::milliseconds(1000).count(),
-      "Failed transform from " << base_frame_ << " to "
-                               << no_ground_cloud_msg_ptr->header.frame_id);
-    return;
-  }
-  output = *no_ground_cloud_transformed_msg_ptr;
+  modifier.resize(output_size);
+  output.header.stamp = input->header.stamp;
+  output.header.frame_id = base_frame_;
+  output.is_dense = true;
 
   // output debug plane coords and ground pointcloud when debug flag is set
   if (debug_) {
+    pcl::PointCloud<PointType> segment_ground_cloud;
+    pcl::copyPointCloud(*downsampled_cloud_ptr_, *inliers_, segment_ground_cloud);
     const geometry_msgs::msg::Pose debug_pose = getDebugPose(plane_affine);
     geometry_msgs::msg::PoseArray debug_pose_array;
     debug_pose_array.header.frame_id = base_frame_;
     debug_pose_array.poses.push_back(debug_pose);
-    publishDebugMessage(debug_pose_array, *segment_ground_cloud_ptr, input->header);
+    publishDebugMessage(debug_pose_array, segment_ground_cloud, input->header);
   }
 }
 
@@ -357,6 +436,10 @@ rcl_interfaces::msg::SetParametersResult RANSACGroundFilterComponent::paramCallb
   if (get_param(p, "debug", debug_)) {
     RCLCPP_DEBUG(get_logger(), "Setting debug to: %d.", debug_);
   }
+  if (get_param(p, "reuse_previous_plane", reuse_previous_plane_)) {
+    previous_plane_.reset();
+    RCLCPP_DEBUG(get_logger(), "Setting reuse_previous_plane to: %d.", reuse_previous_plane_);
+  }
 
   if (debug_) {
     setDebugPublisher();
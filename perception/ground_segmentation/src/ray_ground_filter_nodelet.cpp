@@ -31,6 +31,9 @@
 
 #include "ground_segmentation/ray_ground_filter_nodelet.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
 #include <string>
 #include <vector>
 
@@ -46,7 +49,6 @@ RayGroundFilterComponent::RayGroundFilterComponent(const rclcpp::NodeOptions & o
     grid_width_ = 1000;
     grid_height_ = 1000;
     grid_precision_ = 0.2;
-    ray_ground_filter::generateColors(colors_, color_num_);
 
     min_x_ = declare_parameter("min_x", -0.01);
     max_x_ = declare_parameter("max_x", 0.01);
@@ -64,6 +66,7 @@ RayGroundFilterComponent::RayGroundFilterComponent(const rclcpp::NodeOptions & o
     min_height_threshold_ = declare_parameter("min_height_threshold", 0.15);
     concentric_divider_distance_ = declare_parameter("concentric_divider_distance", 0.0);
     reclass_distance_threshold_ = declare_parameter("reclass_distance_threshold", 0.1);
+    num_threads_ = std::max(declare_parameter("num_threads", 4), 1);
   }
 
   using std::placeholders::_1;
@@ -71,57 +74,87 @@ RayGroundFilterComponent::RayGroundFilterComponent(const rclcpp::NodeOptions & o
     std::bind(&RayGroundFilterComponent::paramCallback, this, _1));
 }
 
-void RayGroundFilterComponent::ConvertXYZIToRTZColor(
-  const pcl::PointCloud<PointType_>::Ptr in_cloud, PointCloudXYZRTColor & out_organized_points,
-  std::vector<pcl::PointIndices> & out_radial_divided_indices,
-  std::vector<PointCloudXYZRTColor> & out_radial_ordered_clouds)
+void RayGroundFilterComponent::ConvertXYZIToRTZ(
+  const pcl::PointCloud<PointType_> & in_cloud, PointCloudXYZRT & out_organized_points,
+  RadialLayout & out_radial_layout)
 {
-  out_organized_points.resize(in_cloud->points.size());
-  out_radial_divided_indices.clear();
-  out_radial_divided_indices.resize(radial_dividers_num_);
-  out_radial_ordered_clouds.resize(radial_dividers_num_);
-
-  for (size_t i = 0; i < in_cloud->points.size(); i++) {
-    PointXYZRTColor new_point;
-    auto radius = static_cast<float>(sqrt(
-      in_cloud->points[i].x * in_cloud->points[i].x +
-      in_cloud->points[i].y * in_cloud->points[i].y));
-    auto theta =
-      static_cast<float>(atan2(in_cloud->points[i].y, in_cloud->points[i].x)) * 180 / M_PI;
+  const size_t num_points = in_cloud.points.size();
+  out_organized_points.resize(num_points);
+
+  float max_radius = 0.f;
+#pragma omp parallel for num_threads(num_threads_) reduction(max : max_radius)
+  for (size_t i = 0; i < num_points; i++) {
+    const auto & p = in_cloud.points[i];
+    auto & new_point = out_organized_points[i];
+    new_point.point = p;
+    if (!std::isfinite(p.x) || !std::isfinite(p.y) || !std::isfinite(p.z)) {
+      // not part of any radial division
+      new_point.radius = 0.f;
+      new_point.radial_div = radial_dividers_num_;
+      continue;
+    }
+
+    new_point.radius = static_cast<float>(sqrt(p.x * p.x + p.y * p.y));
+    auto theta = static_cast<float>(atan2(p.y, p.x)) * 180 / M_PI;
     if (theta < 0) {
       theta += 360;
     }
     if (theta >= 360) {
       theta -= 360;
     }
-    auto radial_div = static_cast<size_t>(floor(theta / radial_divider_angle_));
-
-    new_point.point.x = in_cloud->points[i].x;
-    new_point.point.y = in_cloud->points[i].y;
-    new_point.point.z = in_cloud->points[i].z;
-    // new_point.ring = in_cloud->points[i].ring;
-    new_point.radius = radius;
-    new_point.theta = theta;
-    new_point.radial_div = radial_div;
-    new_point.red = static_cast<size_t>(colors_[new_point.radial_div % color_num_].val[0]);
-    new_point.green = static_cast<size_t>(colors_[new_point.radial_div % color_num_].val[1]);
-    new_point.blue = static_cast<size_t>(colors_[new_point.radial_div % color_num_].val[2]);
-    new_point.original_index = i;
-
-    out_organized_points[i] = new_point;
-
-    // radial divisions
-    out_radial_divided_indices[radial_div].indices.push_back(i);
-
-    out_radial_ordered_clouds[radial_div].push_back(new_point);
-  }  // end for
-
-  // order radial points on each division
-#pragma omp for
+    new_point.radial_div =
+      std::min(static_cast<size_t>(floor(theta / radial_divider_angle_)), radial_dividers_num_ - 1);
+    max_radius = std::max(max_radius, new_point.radius);
+  }
+
+  auto & counts = out_radial_layout.counts;
+
+  // first pass: stable counting sort by radius bucket, with about one point per bucket
+  const size_t num_buckets = std::max<size_t>(num_points, 1);
+  const float bucket_scale = max_radius > 0.f ? (num_buckets - 1) / max_radius : 0.f;
+  const auto radius_bucket = [&](const size_t i) {
+    return std::min(
+      static_cast<size_t>(out_organized_points[i].radius * bucket_scale), num_buckets - 1);
+  };
+  counts.assign(num_buckets + 1, 0);
+  for (size_t i = 0; i < num_points; i++) {
+    counts[radius_bucket(i) + 1]++;
+  }
+  std::partial_sum(counts.begin(), counts.end(), counts.begin());
+  auto & bucket_ordered_indices = out_radial_layout.bucket_ordered_indices;
+  bucket_ordered_indices.resize(num_points);
+  for (size_t i = 0; i < num_points; i++) {
+    bucket_ordered_indices[counts[radius_bucket(i)]++] = i;
+  }
+
+  // second pass: stable counting sort by radial division, the invalid points go last
+  counts.assign(radial_dividers_num_ + 2, 0);
+  for (const auto & p : out_organized_points) {
+    counts[p.radial_div + 1]++;
+  }
+  std::partial_sum(counts.begin(), counts.end(), counts.begin());
+  out_radial_layout.ray_offsets.assign(counts.begin(), counts.begin() + radial_dividers_num_ + 1);
+  auto & ordered_indices = out_radial_layout.ordered_indices;
+  ordered_indices.resize(num_points);
+  for (const size_t i : bucket_ordered_indices) {
+    ordered_indices[counts[out_organized_points[i].radial_div]++] = i;
+  }
+
+  // points sharing a bucket may still be out of order, which insertion sort fixes in linear time
+  const auto & ray_offsets = out_radial_layout.ray_offsets;
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic)
   for (size_t i = 0; i < radial_dividers_num_; i++) {
-    std::sort(
-      out_radial_ordered_clouds[i].begin(), out_radial_ordered_clouds[i].end(),
-      [](const PointXYZRTColor & a, const PointXYZRTColor & b) { return a.radius < b.radius; });
+    const auto begin = ordered_indices.begin() + ray_offsets[i];
+    const auto end = ordered_indices.begin() + ray_offsets[i + 1];
+    for (auto it = begin; it != end; ++it) {
+      const size_t index = *it;
+      const float radius = out_organized_points[index].radius;
+      auto hole = it;
+      for (; hole != begin && out_organized_points[*(hole - 1)].radius > radius; --hole) {
+        *hole = *(hole - 1);
+      }
+      *hole = index;
+    }
   }
 }
 
@@ -150,29 +183,37 @@ void RayGroundFilterComponent::setVehicleFootprint(
 }
 
 void RayGroundFilterComponent::ClassifyPointCloud(
-  std::vector<PointCloudXYZRTColor> & in_radial_ordered_clouds,
-  pcl::PointIndices & out_ground_indices, pcl::PointIndices & out_no_ground_indices)
+  const PointCloudXYZRT & in_organized_points, const RadialLayout & in_radial_layout,
+  std::vector<uint8_t> & out_is_ground)
 {
-  out_ground_indices.indices.clear();
-  out_no_ground_indices.indices.clear();
-#pragma omp for
-  for (size_t i = 0; i < in_radial_ordered_clouds.size();
-       i++)  // sweep through each radial division
+  out_is_ground.assign(in_organized_points.size(), 0);
+  const auto & ray_offsets = in_radial_layout.ray_offsets;
+  const auto & ordered_indices = in_radial_layout.ordered_indices;
+  const size_t num_rays = ray_offsets.size() - 1;
+  const float tan_initial_max_slope = tan(DEG2RAD(initial_max_slope_));
+  const float tan_local_max_slope = tan(DEG2RAD(local_max_slope_));
+  const float tan_general_max_slope = tan(DEG2RAD(general_max_slope_));
+
+  // each radial division writes the flags of its own points only
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic)
+  for (size_t i = 0; i < num_rays; i++)  // sweep through each radial division
   {
     float prev_radius = 0.f;
     float prev_height = 0.f;
     bool prev_ground = false;
     bool current_ground = false;
-    for (size_t j = 0; j < in_radial_ordered_clouds[i].size();
+    for (size_t j = ray_offsets[i]; j < ray_offsets[i + 1];
          j++)  // loop through each point in the radial div
     {
-      double local_max_slope = local_max_slope_;
-      if (j == 0) {
-        local_max_slope = initial_max_slope_;
+      const size_t index = ordered_indices[j];
+      const PointXYZRT & current_point = in_organized_points[index];
+      float tan_max_slope = tan_local_max_slope;
+      if (j == ray_offsets[i]) {
+        tan_max_slope = tan_initial_max_slope;
         if (use_vehicle_footprint_) {
           // calc intersection of vehicle footprint and initial point vector
-          const auto radius = calcPointVehicleIntersection(
-            Point{in_radial_ordered_clouds[i][j].point.x, in_radial_ordered_clouds[i][j].point.y});
+          const auto radius =
+            calcPointVehicleIntersection(Point{current_point.point.x, current_point.point.y});
           if (radius) {
             prev_radius = *radius;
           } else {
@@ -185,11 +226,10 @@ void RayGroundFilterComponent::ClassifyPointCloud(
         }
       }
 
-      float points_distance = in_radial_ordered_clouds[i][j].radius - prev_radius;
-      float height_threshold = tan(DEG2RAD(local_max_slope)) * points_distance;
-      float current_height = in_radial_ordered_clouds[i][j].point.z;
-      float general_height_threshold =
-        tan(DEG2RAD(general_max_slope_)) * in_radial_ordered_clouds[i][j].radius;
+      float points_distance = current_point.radius - prev_radius;
+      float height_threshold = tan_max_slope * points_distance;
+      float current_height = current_point.point.z;
+      float general_height_threshold = tan_general_max_slope * current_point.radius;
 
       // for points which are very close causing the height threshold to be tiny,
       // set a minimum value
@@ -230,16 +270,11 @@ void RayGroundFilterComponent::ClassifyPointCloud(
         }
       }  // end larger than concentric_divider
 
-      if (current_ground) {
-        out_ground_indices.indices.push_back(in_radial_ordered_clouds[i][j].original_index);
-        prev_ground = true;
-      } else {
-        out_no_ground_indices.indices.push_back(in_radial_ordered_clouds[i][j].original_index);
-        prev_ground = false;
-      }
+      out_is_ground[index] = current_ground;
+      prev_ground = current_ground;
 
-      prev_radius = in_radial_ordered_clouds[i][j].radius;
-      prev_height = in_radial_ordered_clouds[i][j].point.z;
+      prev_radius = current_point.radius;
+      prev_height = current_point.point.z;
     }
   }
 }
@@ -257,22 +292,6 @@ void RayGroundFilterComponent::ClassifyPointCloud(
 //   return (true);
 // }
 
-void RayGroundFilterComponent::ExtractPointsIndices(
-  const pcl::PointCloud<PointType_>::Ptr in_cloud_ptr, const pcl::PointIndices & in_indices,
-  pcl::PointCloud<PointType_>::Ptr out_only_indices_cloud_ptr,
-  pcl::PointCloud<PointType_>::Ptr out_removed_indices_cloud_ptr)
-{
-  pcl::ExtractIndices<PointType_> extract_ground;
-  extract_ground.setInputCloud(in_cloud_ptr);
-  extract_ground.setIndices(pcl::make_shared<pcl::PointIndices>(in_indices));
-
-  extract_ground.setNegative(false);  // true removes the indices, false leaves only the indices
-  extract_ground.filter(*out_only_indices_cloud_ptr);
-
-  extract_ground.setNegative(true);  // true removes the indices, false leaves only the indices
-  extract_ground.filter(*out_removed_indices_cloud_ptr);
-}
-
 void RayGroundFilterComponent::filter(
   const PointCloud2::ConstSharedPtr & input, [[maybe_unused]] const IndicesPtr & indices,
   PointCloud2 & output)
@@ -282,32 +301,25 @@ void RayGroundFilterComponent::filter(
   pcl::PointCloud<PointType_>::Ptr current_sensor_cloud_ptr(new pcl::PointCloud<PointType_>);
   pcl::fromROSMsg(*input, *current_sensor_cloud_ptr);
 
-  PointCloudXYZRTColor organized_points;
-  std::vector<pcl::PointIndices> radial_division_indices;
-  std::vector<PointCloudXYZRTColor> radial_ordered_clouds;
-
   radial_dividers_num_ = ceil(360 / radial_divider_angle_);
 
-  ConvertXYZIToRTZColor(
-    current_sensor_cloud_ptr, organized_points, radial_division_indices, radial_ordered_clouds);
+  ConvertXYZIToRTZ(*current_sensor_cloud_ptr, organized_points_, radial_layout_);
 
-  pcl::PointIndices ground_indices, no_ground_indices;
+  ClassifyPointCloud(organized_points_, radial_layout_, is_ground_);
 
-  ClassifyPointCloud(radial_ordered_clouds, ground_indices, no_ground_indices);
-
-  pcl::PointCloud<PointType_>::Ptr ground_cloud_ptr(new pcl::PointCloud<PointType_>);
-  pcl::PointCloud<PointType_>::Ptr no_ground_cloud_ptr(new pcl::PointCloud<PointType_>);
-  pcl::PointCloud<pcl::PointXYZRGB>::Ptr radials_cloud_ptr(new pcl::PointCloud<pcl::PointXYZRGB>);
-
-  ExtractPointsIndices(
-    current_sensor_cloud_ptr, ground_indices, ground_cloud_ptr, no_ground_cloud_ptr);
-
-  sensor_msgs::msg::PointCloud2::SharedPtr no_ground_cloud_msg_ptr(
-    new sensor_msgs::msg::PointCloud2);
-  pcl::toROSMsg(*no_ground_cloud_ptr, *no_ground_cloud_msg_ptr);
-  no_ground_cloud_msg_ptr->header = input->header;
+  pcl::PointCloud<PointType_> no_ground_cloud;
+  no_ground_cloud.points.reserve(current_sensor_cloud_ptr->points.size());
+  for (size_t i = 0; i < current_sensor_cloud_ptr->points.size(); i++) {
+    if (!is_ground_[i]) {
+      no_ground_cloud.points.push_back(current_sensor_cloud_ptr->points[i]);
+    }
+  }
+  no_ground_cloud.width = no_ground_cloud.points.size();
+  no_ground_cloud.height = 1;
+  no_ground_cloud.is_dense = current_sensor_cloud_ptr->is_dense;
 
-  output = *no_ground_cloud_msg_ptr;
+  pcl::toROSMsg(no_ground_cloud, output);
+  output.header = input->header;
 }
 
 rcl_interfaces::msg::SetParametersResult RayGroundFilterComponent::paramCallback(
@@ -356,6 +368,10 @@ rcl_interfaces::msg::SetParametersResult RayGroundFilterComponent::paramCallback
   if (get_param(p, "use_vehicle_footprint", use_vehicle_footprint_)) {
     RCLCPP_DEBUG(get_logger(), "Setting use_vehicle_footprint to: %d.", use_vehicle_footprint_);
   }
+  if (get_param(p, "num_threads", num_threads_)) {
+    num_threads_ = std::max(num_threads_, 1);
+    RCLCPP_DEBUG(get_logger(), "Setting num_threads to: %d.", num_threads_);
+  }
 
   rcl_interfaces::msg::SetParametersResult result;
   result.successful = true;
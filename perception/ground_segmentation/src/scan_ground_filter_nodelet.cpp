@@ -19,6 +19,7 @@
 #include <tier4_autoware_utils/math/unit_conversion.hpp>
 #include <vehicle_info_util/vehicle_info_util.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -55,6 +56,7 @@ ScanGroundFilterComponent::ScanGroundFilterComponent(const rclcpp::NodeOptions &
     split_height_distance_ = declare_parameter("split_height_distance", 0.2);
     use_virtual_ground_point_ = declare_parameter("use_virtual_ground_point", true);
     use_recheck_ground_cluster_ = declare_parameter("use_recheck_ground_cluster", true);
+    num_threads_ = std::max(static_cast<int>(declare_parameter("num_threads", 1)), 1);
     radial_dividers_num_ = std::ceil(2.0 * M_PI / radial_divider_angle_rad_);
     vehicle_info_ = VehicleInfoUtil(*this).getVehicleInfo();
 
@@ -62,6 +64,7 @@ ScanGroundFilterComponent::ScanGroundFilterComponent(const rclcpp::NodeOptions &
       grid_mode_switch_radius_ / grid_size_m_;  // changing the mode of grid division
     virtual_lidar_z_ = vehicle_info_.vehicle_height_m;
     grid_mode_switch_angle_rad_ = std::atan2(grid_mode_switch_radius_, virtual_lidar_z_);
+    updateSlopeThresholds();
   }
 
   using std::placeholders::_1;
@@ -79,11 +82,36 @@ ScanGroundFilterComponent::ScanGroundFilterComponent(const rclcpp::NodeOptions &
   }
 }
 
+void ScanGroundFilterComponent::resetRadialOrderedPoints(
+  std::vector<PointCloudRefVector> & radial_ordered_points) const
+{
+  // the buckets are kept across frames, clearing them keeps their capacity
+  radial_ordered_points.resize(radial_dividers_num_);
+  for (auto & ray : radial_ordered_points) {
+    ray.clear();
+  }
+}
+
+void ScanGroundFilterComponent::sortRadialOrderedPoints(
+  std::vector<PointCloudRefVector> & radial_ordered_points) const
+{
+  const auto compare = [](const PointRef & a, const PointRef & b) { return a.radius < b.radius; };
+
+  // sort by distance, skipped for the rays which the sensor already delivers in range order
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic)
+  for (size_t i = 0; i < radial_ordered_points.size(); ++i) {
+    auto & ray = radial_ordered_points[i];
+    if (!std::is_sorted(ray.begin(), ray.end(), compare)) {
+      std::sort(ray.begin(), ray.end(), compare);
+    }
+  }
+}
+
 void ScanGroundFilterComponent::convertPointcloudGridScan(
   const pcl::PointCloud<pcl::PointXYZ>::Ptr in_cloud,
   std::vector<PointCloudRefVector> & out_radial_ordered_points)
 {
-  out_radial_ordered_points.resize(radial_dividers_num_);
+  resetRadialOrderedPoints(out_radial_ordered_points);
   PointRef current_point;
   uint16_t back_steps_num = 1;
 
@@ -129,18 +157,13 @@ void ScanGroundFilterComponent::convertPointcloudGridScan(
     out_radial_ordered_points[radial_div].emplace_back(current_point);
   }
 
-  // sort by distance
-  for (size_t i = 0; i < radial_dividers_num_; ++i) {
-    std::sort(
-      out_radial_ordered_points[i].begin(), out_radial_ordered_points[i].end(),
-      [](const PointRef & a, const PointRef & b) { return a.radius < b.radius; });
-  }
+  sortRadialOrderedPoints(out_radial_ordered_points);
 }
 void ScanGroundFilterComponent::convertPointcloud(
   const pcl::PointCloud<pcl::PointXYZ>::Ptr in_cloud,
   std::vector<PointCloudRefVector> & out_radial_ordered_points)
 {
-  out_radial_ordered_points.resize(radial_dividers_num_);
+  resetRadialOrderedPoints(out_radial_ordered_points);
   PointRef current_point;
 
   for (size_t i = 0; i < in_cloud->points.size(); ++i) {
@@ -160,15 +183,31 @@ void ScanGroundFilterComponent::convertPointcloud(
     out_radial_ordered_points[radial_div].emplace_back(current_point);
   }
 
-  // sort by distance
-  for (size_t i = 0; i < radial_dividers_num_; ++i) {
-    std::sort(
-      out_radial_ordered_points[i].begin(), out_radial_ordered_points[i].end(),
-      [](const PointRef & a, const PointRef & b) { return a.radius < b.radius; });
+  sortRadialOrderedPoints(out_radial_ordered_points);
+}
+
+void ScanGroundFilterComponent::updateSlopeThresholds()
+{
+  global_slope_max_ratio_ = std::tan(global_slope_max_angle_rad_);
+  local_slope_max_ratio_ = std::tan(local_slope_max_angle_rad_);
+}
+
+void ScanGroundFilterComponent::mergeIndices(
+  const std::vector<pcl::PointIndices> & in_indices_list, pcl::PointIndices & out_indices)
+{
+  size_t num_indices = 0;
+  for (const auto & in_indices : in_indices_list) {
+    num_indices += in_indices.indices.size();
+  }
+  out_indices.indices.clear();
+  out_indices.indices.reserve(num_indices);
+  for (const auto & in_indices : in_indices_list) {
+    out_indices.indices.insert(
+      out_indices.indices.end(), in_indices.indices.begin(), in_indices.indices.end());
   }
 }
 
-void ScanGroundFilterComponent::calcVirtualGroundOrigin(pcl::PointXYZ & point)
+void ScanGroundFilterComponent::calcVirtualGroundOrigin(pcl::PointXYZ & point) const
 {
   point.x = vehicle_info_.wheel_base_m;
   point.y = 0;
@@ -176,7 +215,7 @@ void ScanGroundFilterComponent::calcVirtualGroundOrigin(pcl::PointXYZ & point)
 }
 
 void ScanGroundFilterComponent::initializeFirstGndGrids(
-  const float h, const float r, const uint16_t id, std::vector<GridCenter> & gnd_grids)
+  const float h, const float r, const uint16_t id, std::vector<GridCenter> & gnd_grids) const
 {
   GridCenter curr_gnd_grid;
   for (int ind_grid = id - 1 - gnd_grid_buffer_size_; ind_grid < id - 1; ++ind_grid) {
@@ -195,10 +234,12 @@ void ScanGroundFilterComponent::initializeFirstGndGrids(
 }
 
 void ScanGroundFilterComponent::checkContinuousGndGrid(
-  PointRef & p, const std::vector<GridCenter> & gnd_grids_list)
+  PointRef & p, const std::vector<GridCenter> & gnd_grids_list) const
 {
+  // slopes are compared as tangents, tan(atan(x)) == x and atan is monotonic
+  static const float gnd_z_local_slope_ratio = std::tan(DEG2RAD(5.0));
   float next_gnd_z = 0.0f;
-  float curr_gnd_slope_rad = 0.0f;
+  float curr_gnd_slope_ratio = 0.0f;
   float gnd_buff_z_mean = 0.0f;
   float gnd_buff_z_max = 0.0f;
   float gnd_buff_radius = 0.0f;
@@ -217,62 +258,61 @@ void ScanGroundFilterComponent::checkContinuousGndGrid(
   float tmp_delta_mean_z = gnd_grids_list.back().avg_height - gnd_buff_z_mean;
   float tmp_delta_radius = gnd_grids_list.back().radius - gnd_buff_radius;
 
-  curr_gnd_slope_rad = std::atan(tmp_delta_mean_z / tmp_delta_radius);
-  curr_gnd_slope_rad = curr_gnd_slope_rad < -global_slope_max_angle_rad_
-                         ? -global_slope_max_angle_rad_
-                         : curr_gnd_slope_rad;
-  curr_gnd_slope_rad = curr_gnd_slope_rad > global_slope_max_angle_rad_
-                         ? global_slope_max_angle_rad_
-                         : curr_gnd_slope_rad;
+  curr_gnd_slope_ratio = tmp_delta_mean_z / tmp_delta_radius;
+  curr_gnd_slope_ratio = curr_gnd_slope_ratio < -global_slope_max_ratio_
+                           ? -global_slope_max_ratio_
+                           : curr_gnd_slope_ratio;
+  curr_gnd_slope_ratio = curr_gnd_slope_ratio > global_slope_max_ratio_ ? global_slope_max_ratio_
+                                                                        : curr_gnd_slope_ratio;
 
-  next_gnd_z = std::tan(curr_gnd_slope_rad) * (p.radius - gnd_buff_radius) + gnd_buff_z_mean;
+  next_gnd_z = curr_gnd_slope_ratio * (p.radius - gnd_buff_radius) + gnd_buff_z_mean;
 
-  float gnd_z_local_thresh = std::tan(DEG2RAD(5.0)) * (p.radius - gnd_grids_list.back().radius);
+  float gnd_z_local_thresh = gnd_z_local_slope_ratio * (p.radius - gnd_grids_list.back().radius);
 
   tmp_delta_mean_z = p.orig_point->z - (gnd_grids_list.end() - 2)->avg_height;
   tmp_delta_radius = p.radius - (gnd_grids_list.end() - 2)->radius;
-  float local_slope = std::atan(tmp_delta_mean_z / tmp_delta_radius);
+  float local_slope_ratio = tmp_delta_mean_z / tmp_delta_radius;
   if (
     abs(p.orig_point->z - next_gnd_z) <= non_ground_height_threshold_ + gnd_z_local_thresh ||
-    abs(local_slope) <= local_slope_max_angle_rad_) {
+    std::abs(local_slope_ratio) <= local_slope_max_ratio_) {
     p.point_state = PointLabel::GROUND;
   } else if (p.orig_point->z - next_gnd_z > non_ground_height_threshold_ + gnd_z_local_thresh) {
     p.point_state = PointLabel::NON_GROUND;
   }
 }
 void ScanGroundFilterComponent::checkDiscontinuousGndGrid(
-  PointRef & p, const std::vector<GridCenter> & gnd_grids_list)
+  PointRef & p, const std::vector<GridCenter> & gnd_grids_list) const
 {
   float tmp_delta_max_z = p.orig_point->z - gnd_grids_list.back().max_height;
   float tmp_delta_avg_z = p.orig_point->z - gnd_grids_list.back().avg_height;
   float tmp_delta_radius = p.radius - gnd_grids_list.back().radius;
-  float local_slope = std::atan(tmp_delta_avg_z / tmp_delta_radius);
+  float local_slope_ratio = tmp_delta_avg_z / tmp_delta_radius;
 
   if (
-    abs(local_slope) < local_slope_max_angle_rad_ ||
+    std::abs(local_slope_ratio) < local_slope_max_ratio_ ||
     abs(tmp_delta_avg_z) < non_ground_height_threshold_ ||
     abs(tmp_delta_max_z) < non_ground_height_threshold_) {
     p.point_state = PointLabel::GROUND;
-  } else if (local_slope > global_slope_max_angle_rad_) {
+  } else if (local_slope_ratio > global_slope_max_ratio_) {
     p.point_state = PointLabel::NON_GROUND;
   }
 }
 
 void ScanGroundFilterComponent::checkBreakGndGrid(
-  PointRef & p, const std::vector<GridCenter> & gnd_grids_list)
+  PointRef & p, const std::vector<GridCenter> & gnd_grids_list) const
 {
   float tmp_delta_avg_z = p.orig_point->z - gnd_grids_list.back().avg_height;
   float tmp_delta_radius = p.radius - gnd_grids_list.back().radius;
-  float local_slope = std::atan(tmp_delta_avg_z / tmp_delta_radius);
-  if (abs(local_slope) < global_slope_max_angle_rad_) {
+  float local_slope_ratio = tmp_delta_avg_z / tmp_delta_radius;
+  if (std::abs(local_slope_ratio) < global_slope_max_ratio_) {
     p.point_state = PointLabel::GROUND;
-  } else if (local_slope > global_slope_max_angle_rad_) {
+  } else if (local_slope_ratio > global_slope_max_ratio_) {
     p.point_state = PointLabel::NON_GROUND;
   }
 }
 void ScanGroundFilterComponent::recheckGroundCluster(
   PointsCentroid & gnd_cluster, const float non_ground_threshold,
-  pcl::PointIndices & non_ground_indices)
+  pcl::PointIndices & non_ground_indices) const
 {
   const float min_gnd_height = gnd_cluster.getMinHeight();
   pcl::PointIndices gnd_indices = gnd_cluster.getIndices();
@@ -287,129 +327,137 @@ void ScanGroundFilterComponent::classifyPointCloudGridScan(
   std::vector<PointCloudRefVector> & in_radial_ordered_clouds,
   pcl::PointIndices & out_no_ground_indices)
 {
-  out_no_ground_indices.indices.clear();
+  // each ray is classified into its own buffer, merged in ray order to keep the serial output
+  std::vector<pcl::PointIndices> ray_no_ground_indices(in_radial_ordered_clouds.size());
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic)
   for (size_t i = 0; i < in_radial_ordered_clouds.size(); ++i) {
-    PointsCentroid ground_cluster;
-    ground_cluster.initialize();
-    std::vector<GridCenter> gnd_grids;
-    GridCenter curr_gnd_grid;
+    classifyRayGridScan(in_radial_ordered_clouds[i], ray_no_ground_indices[i]);
+  }
+  mergeIndices(ray_no_ground_indices, out_no_ground_indices);
+}
+
+void ScanGroundFilterComponent::classifyRayGridScan(
+  PointCloudRefVector & in_ray, pcl::PointIndices & out_no_ground_indices) const
+{
+  PointsCentroid ground_cluster;
+  ground_cluster.initialize();
+  std::vector<GridCenter> gnd_grids;
+  GridCenter curr_gnd_grid;
+
+  // check empty ray
+  if (in_ray.size() == 0) {
+    return;
+  }
 
-    // check empty ray
-    if (in_radial_ordered_clouds[i].size() == 0) {
+  // check the first point in ray
+  auto * p = &in_ray[0];
+  PointRef * prev_p;
+  prev_p = &in_ray[0];  // for checking the distance to prev point
+
+  bool initialized_first_gnd_grid = false;
+  bool prev_list_init = false;
+
+  for (size_t j = 0; j < in_ray.size(); ++j) {
+    p = &in_ray[j];
+    float global_slope_ratio_p = p->orig_point->z / p->radius;
+    float non_ground_height_threshold_local = non_ground_height_threshold_;
+    if (p->orig_point->x < low_priority_region_x_) {
+      non_ground_height_threshold_local =
+        non_ground_height_threshold_ * abs(p->orig_point->x / low_priority_region_x_);
+    }
+    // classify first grid's point cloud
+    if (
+      !initialized_first_gnd_grid && global_slope_ratio_p >= global_slope_max_ratio_ &&
+      p->orig_point->z > non_ground_height_threshold_local) {
+      out_no_ground_indices.indices.push_back(p->orig_index);
+      p->point_state = PointLabel::NON_GROUND;
+      prev_p = p;
       continue;
     }
 
-    // check the first point in ray
-    auto * p = &in_radial_ordered_clouds[i][0];
-    PointRef * prev_p;
-    prev_p = &in_radial_ordered_clouds[i][0];  // for checking the distance to prev point
-
-    bool initialized_first_gnd_grid = false;
-    bool prev_list_init = false;
-
-    for (size_t j = 0; j < in_radial_ordered_clouds[i].size(); ++j) {
-      p = &in_radial_ordered_clouds[i][j];
-      float global_slope_p = std::atan(p->orig_point->z / p->radius);
-      float non_ground_height_threshold_local = non_ground_height_threshold_;
-      if (p->orig_point->x < low_priority_region_x_) {
-        non_ground_height_threshold_local =
-          non_ground_height_threshold_ * abs(p->orig_point->x / low_priority_region_x_);
-      }
-      // classify first grid's point cloud
-      if (
-        !initialized_first_gnd_grid && global_slope_p >= global_slope_max_angle_rad_ &&
-        p->orig_point->z > non_ground_height_threshold_local) {
-        out_no_ground_indices.indices.push_back(p->orig_index);
-        p->point_state = PointLabel::NON_GROUND;
-        prev_p = p;
-        continue;
-      }
-
-      if (
-        !initialized_first_gnd_grid && abs(global_slope_p) < global_slope_max_angle_rad_ &&
-        abs(p->orig_point->z) < non_ground_height_threshold_local) {
-        ground_cluster.addPoint(p->radius, p->orig_point->z, p->orig_index);
-        p->point_state = PointLabel::GROUND;
-        initialized_first_gnd_grid = static_cast<bool>(p->grid_id - prev_p->grid_id);
-        prev_p = p;
-        continue;
-      }
+    if (
+      !initialized_first_gnd_grid && std::abs(global_slope_ratio_p) < global_slope_max_ratio_ &&
+      abs(p->orig_point->z) < non_ground_height_threshold_local) {
+      ground_cluster.addPoint(p->radius, p->orig_point->z, p->orig_index);
+      p->point_state = PointLabel::GROUND;
+      initialized_first_gnd_grid = static_cast<bool>(p->grid_id - prev_p->grid_id);
+      prev_p = p;
+      continue;
+    }
 
-      if (!initialized_first_gnd_grid) {
-        prev_p = p;
-        continue;
-      }
+    if (!initialized_first_gnd_grid) {
+      prev_p = p;
+      continue;
+    }
 
-      // initialize lists of previous gnd grids
-      if (prev_list_init == false && initialized_first_gnd_grid == true) {
-        float h = ground_cluster.getAverageHeight();
-        float r = ground_cluster.getAverageRadius();
-        initializeFirstGndGrids(h, r, p->grid_id, gnd_grids);
-        prev_list_init = true;
-      }
+    // initialize lists of previous gnd grids
+    if (prev_list_init == false && initialized_first_gnd_grid == true) {
+      float h = ground_cluster.getAverageHeight();
+      float r = ground_cluster.getAverageRadius();
+      initializeFirstGndGrids(h, r, p->grid_id, gnd_grids);
+      prev_list_init = true;
+    }
 
-      if (prev_list_init == false && initialized_first_gnd_grid == false) {
-        // assume first gnd grid is zero
-        initializeFirstGndGrids(0.0f, p->radius, p->grid_id, gnd_grids);
-        prev_list_init = true;
-      }
+    if (prev_list_init == false && initialized_first_gnd_grid == false) {
+      // assume first gnd grid is zero
+      initializeFirstGndGrids(0.0f, p->radius, p->grid_id, gnd_grids);
+      prev_list_init = true;
+    }
 
-      // move to new grid
-      if (p->grid_id > prev_p->grid_id && ground_cluster.getAverageRadius() > 0.0) {
-        // check if the prev grid have ground point cloud
-        if (use_recheck_ground_cluster_) {
-          recheckGroundCluster(ground_cluster, non_ground_height_threshold_, out_no_ground_indices);
-        }
-        curr_gnd_grid.radius = ground_cluster.getAverageRadius();
-        curr_gnd_grid.avg_height = ground_cluster.getAverageHeight();
-        curr_gnd_grid.max_height = ground_cluster.getMaxHeight();
-        curr_gnd_grid.grid_id = prev_p->grid_id;
-        gnd_grids.push_back(curr_gnd_grid);
-        ground_cluster.initialize();
-      }
-      // classify
-      if (p->orig_point->z - gnd_grids.back().avg_height > detection_range_z_max_) {
-        p->point_state = PointLabel::OUT_OF_RANGE;
-        prev_p = p;
-        continue;
-      }
-      float points_xy_distance = std::hypot(
-        p->orig_point->x - prev_p->orig_point->x, p->orig_point->y - prev_p->orig_point->y);
-      if (
-        prev_p->point_state == PointLabel::NON_GROUND &&
-        points_xy_distance < split_points_distance_tolerance_ &&
-        p->orig_point->z > prev_p->orig_point->z) {
-        p->point_state = PointLabel::NON_GROUND;
-        out_no_ground_indices.indices.push_back(p->orig_index);
-        prev_p = p;
-        continue;
+    // move to new grid
+    if (p->grid_id > prev_p->grid_id && ground_cluster.getAverageRadius() > 0.0) {
+      // check if the prev grid have ground point cloud
+      if (use_recheck_ground_cluster_) {
+        recheckGroundCluster(ground_cluster, non_ground_height_threshold_, out_no_ground_indices);
       }
+      curr_gnd_grid.radius = ground_cluster.getAverageRadius();
+      curr_gnd_grid.avg_height = ground_cluster.getAverageHeight();
+      curr_gnd_grid.max_height = ground_cluster.getMaxHeight();
+      curr_gnd_grid.grid_id = prev_p->grid_id;
+      gnd_grids.push_back(curr_gnd_grid);
+      ground_cluster.initialize();
+    }
+    // classify
+    if (p->orig_point->z - gnd_grids.back().avg_height > detection_range_z_max_) {
+      p->point_state = PointLabel::OUT_OF_RANGE;
+      prev_p = p;
+      continue;
+    }
+    float points_xy_distance = std::hypot(
+      p->orig_point->x - prev_p->orig_point->x, p->orig_point->y - prev_p->orig_point->y);
+    if (
+      prev_p->point_state == PointLabel::NON_GROUND &&
+      points_xy_distance < split_points_distance_tolerance_ &&
+      p->orig_point->z > prev_p->orig_point->z) {
+      p->point_state = PointLabel::NON_GROUND;
+      out_no_ground_indices.indices.push_back(p->orig_index);
+      prev_p = p;
+      continue;
+    }
 
-      if (global_slope_p > global_slope_max_angle_rad_) {
-        out_no_ground_indices.indices.push_back(p->orig_index);
-        prev_p = p;
-        continue;
-      }
-      // gnd grid is continuous, the last gnd grid is close
-      uint16_t next_gnd_grid_id_thresh = (gnd_grids.end() - gnd_grid_buffer_size_)->grid_id +
-                                         gnd_grid_buffer_size_ + gnd_grid_continual_thresh_;
-      if (
-        p->grid_id < next_gnd_grid_id_thresh &&
-        p->radius - gnd_grids.back().radius < gnd_grid_continual_thresh_ * p->grid_size) {
-        checkContinuousGndGrid(*p, gnd_grids);
-
-      } else if (p->radius - gnd_grids.back().radius < gnd_grid_continual_thresh_ * p->grid_size) {
-        checkDiscontinuousGndGrid(*p, gnd_grids);
-      } else {
-        checkBreakGndGrid(*p, gnd_grids);
-      }
-      if (p->point_state == PointLabel::NON_GROUND) {
-        out_no_ground_indices.indices.push_back(p->orig_index);
-      } else if (p->point_state == PointLabel::GROUND) {
-        ground_cluster.addPoint(p->radius, p->orig_point->z, p->orig_index);
-      }
+    if (global_slope_ratio_p > global_slope_max_ratio_) {
+      out_no_ground_indices.indices.push_back(p->orig_index);
       prev_p = p;
+      continue;
     }
+    // gnd grid is continuous, the last gnd grid is close
+    uint16_t next_gnd_grid_id_thresh = (gnd_grids.end() - gnd_grid_buffer_size_)->grid_id +
+                                       gnd_grid_buffer_size_ + gnd_grid_continual_thresh_;
+    if (
+      p->grid_id < next_gnd_grid_id_thresh &&
+      p->radius - gnd_grids.back().radius < gnd_grid_continual_thresh_ * p->grid_size) {
+      checkContinuousGndGrid(*p, gnd_grids);
+    } else if (p->radius - gnd_grids.back().radius < gnd_grid_continual_thresh_ * p->grid_size) {
+      checkDiscontinuousGndGrid(*p, gnd_grids);
+    } else {
+      checkBreakGndGrid(*p, gnd_grids);
+    }
+    if (p->point_state == PointLabel::NON_GROUND) {
+      out_no_ground_indices.indices.push_back(p->orig_index);
+    } else if (p->point_state == PointLabel::GROUND) {
+      ground_cluster.addPoint(p->radius, p->orig_point->z, p->orig_index);
+    }
+    prev_p = p;
   }
 }
 
@@ -417,113 +465,121 @@ void ScanGroundFilterComponent::classifyPointCloud(
   std::vector<PointCloudRefVector> & in_radial_ordered_clouds,
   pcl::PointIndices & out_no_ground_indices)
 {
-  out_no_ground_indices.indices.clear();
 
+  // point classification algorithm
+  // sweep through each radial division, merged in ray order to keep the serial output
+  std::vector<pcl::PointIndices> ray_no_ground_indices(in_radial_ordered_clouds.size());
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic)
+  for (size_t i = 0; i < in_radial_ordered_clouds.size(); ++i) {
+    classifyRay(in_radial_ordered_clouds[i], ray_no_ground_indices[i]);
+  }
+  mergeIndices(ray_no_ground_indices, out_no_ground_indices);
+}
+
+void ScanGroundFilterComponent::classifyRay(
+  PointCloudRefVector & in_ray, pcl::PointIndices & out_no_ground_indices) const
+{
   const pcl::PointXYZ init_ground_point(0, 0, 0);
   pcl::PointXYZ virtual_ground_point(0, 0, 0);
   calcVirtualGroundOrigin(virtual_ground_point);
 
-  // point classification algorithm
-  // sweep through each radial division
-  for (size_t i = 0; i < in_radial_ordered_clouds.size(); ++i) {
-    float prev_gnd_radius = 0.0f;
-    float prev_gnd_slope = 0.0f;
-    float points_distance = 0.0f;
-    PointsCentroid ground_cluster, non_ground_cluster;
-    float local_slope = 0.0f;
-    PointLabel prev_point_label = PointLabel::INIT;
-    pcl::PointXYZ prev_gnd_point(0, 0, 0);
-    // loop through each point in the radial div
-    for (size_t j = 0; j < in_radial_ordered_clouds[i].size(); ++j) {
-      const float global_slope_max_angle = global_slope_max_angle_rad_;
-      const float local_slope_max_angle = local_slope_max_angle_rad_;
-      auto * p = &in_radial_ordered_clouds[i][j];
-      auto * p_prev = &in_radial_ordered_clouds[i][j - 1];
-
-      if (j == 0) {
-        bool is_front_side = (p->orig_point->x > virtual_ground_point.x);
-        if (use_virtual_ground_point_ && is_front_side) {
-          prev_gnd_point = virtual_ground_point;
-        } else {
-          prev_gnd_point = init_ground_point;
-        }
-        prev_gnd_radius = std::hypot(prev_gnd_point.x, prev_gnd_point.y);
-        prev_gnd_slope = 0.0f;
-        ground_cluster.initialize();
-        non_ground_cluster.initialize();
-        points_distance = calcDistance3d(*p->orig_point, prev_gnd_point);
+  float prev_gnd_radius = 0.0f;
+  float prev_gnd_slope = 0.0f;
+  float points_distance = 0.0f;
+  PointsCentroid ground_cluster, non_ground_cluster;
+  float local_slope = 0.0f;
+  PointLabel prev_point_label = PointLabel::INIT;
+  pcl::PointXYZ prev_gnd_point(0, 0, 0);
+  // loop through each point in the radial div
+  for (size_t j = 0; j < in_ray.size(); ++j) {
+    const float global_slope_max_angle = global_slope_max_angle_rad_;
+    const float local_slope_max_angle = local_slope_max_angle_rad_;
+    auto * p = &in_ray[j];
+    auto * p_prev = &in_ray[j - 1];
+
+    if (j == 0) {
+      bool is_front_side = (p->orig_point->x > virtual_ground_point.x);
+      if (use_virtual_ground_point_ && is_front_side) {
+        prev_gnd_point = virtual_ground_point;
       } else {
-        points_distance = calcDistance3d(*p->orig_point, *p_prev->orig_point);
+        prev_gnd_point = init_ground_point;
       }
+      prev_gnd_radius = std::hypot(prev_gnd_point.x, prev_gnd_point.y);
+      prev_gnd_slope = 0.0f;
+      ground_cluster.initialize();
+      non_ground_cluster.initialize();
+      points_distance = calcDistance3d(*p->orig_point, prev_gnd_point);
+    } else {
+      points_distance = calcDistance3d(*p->orig_point, *p_prev->orig_point);
+    }
 
-      float radius_distance_from_gnd = p->radius - prev_gnd_radius;
-      float height_from_gnd = p->orig_point->z - prev_gnd_point.z;
-      float height_from_obj = p->orig_point->z - non_ground_cluster.getAverageHeight();
-      bool calculate_slope = false;
-      bool is_point_close_to_prev =
-        (points_distance <
-         (p->radius * radial_divider_angle_rad_ + split_points_distance_tolerance_));
-
-      float global_slope = std::atan2(p->orig_point->z, p->radius);
-      // check points which is far enough from previous point
-      if (global_slope > global_slope_max_angle) {
+    float radius_distance_from_gnd = p->radius - prev_gnd_radius;
+    float height_from_gnd = p->orig_point->z - prev_gnd_point.z;
+    float height_from_obj = p->orig_point->z - non_ground_cluster.getAverageHeight();
+    bool calculate_slope = false;
+    bool is_point_close_to_prev =
+      (points_distance <
+       (p->radius * radial_divider_angle_rad_ + split_points_distance_tolerance_));
+
+    float global_slope = std::atan2(p->orig_point->z, p->radius);
+    // check points which is far enough from previous point
+    if (global_slope > global_slope_max_angle) {
+      p->point_state = PointLabel::NON_GROUND;
+      calculate_slope = false;
+    } else if (
+      (prev_point_label == PointLabel::NON_GROUND) &&
+      (std::abs(height_from_obj) >= split_height_distance_)) {
+      calculate_slope = true;
+    } else if (is_point_close_to_prev && std::abs(height_from_gnd) < split_height_distance_) {
+      // close to the previous point, set point follow label
+      p->point_state = PointLabel::POINT_FOLLOW;
+      calculate_slope = false;
+    } else {
+      calculate_slope = true;
+    }
+    if (is_point_close_to_prev) {
+      height_from_gnd = p->orig_point->z - ground_cluster.getAverageHeight();
+      radius_distance_from_gnd = p->radius - ground_cluster.getAverageRadius();
+    }
+    if (calculate_slope) {
+      // far from the previous point
+      local_slope = std::atan2(height_from_gnd, radius_distance_from_gnd);
+      if (local_slope - prev_gnd_slope > local_slope_max_angle) {
+        // the point is outside of the local slope threshold
         p->point_state = PointLabel::NON_GROUND;
-        calculate_slope = false;
-      } else if (
-        (prev_point_label == PointLabel::NON_GROUND) &&
-        (std::abs(height_from_obj) >= split_height_distance_)) {
-        calculate_slope = true;
-      } else if (is_point_close_to_prev && std::abs(height_from_gnd) < split_height_distance_) {
-        // close to the previous point, set point follow label
-        p->point_state = PointLabel::POINT_FOLLOW;
-        calculate_slope = false;
       } else {
-        calculate_slope = true;
-      }
-      if (is_point_close_to_prev) {
-        height_from_gnd = p->orig_point->z - ground_cluster.getAverageHeight();
-        radius_distance_from_gnd = p->radius - ground_cluster.getAverageRadius();
-      }
-      if (calculate_slope) {
-        // far from the previous point
-        local_slope = std::atan2(height_from_gnd, radius_distance_from_gnd);
-        if (local_slope - prev_gnd_slope > local_slope_max_angle) {
-          // the point is outside of the local slope threshold
-          p->point_state = PointLabel::NON_GROUND;
-        } else {
-          p->point_state = PointLabel::GROUND;
-        }
-      }
-
-      if (p->point_state == PointLabel::GROUND) {
-        ground_cluster.initialize();
-        non_ground_cluster.initialize();
-      }
-      if (p->point_state == PointLabel::NON_GROUND) {
-        out_no_ground_indices.indices.push_back(p->orig_index);
-      } else if (  // NOLINT
-        (prev_point_label == PointLabel::NON_GROUND) &&
-        (p->point_state == PointLabel::POINT_FOLLOW)) {
-        p->point_state = PointLabel::NON_GROUND;
-        out_no_ground_indices.indices.push_back(p->orig_index);
-      } else if (  // NOLINT
-        (prev_point_label == PointLabel::GROUND) && (p->point_state == PointLabel::POINT_FOLLOW)) {
         p->point_state = PointLabel::GROUND;
-      } else {
       }
+    }
 
-      // update the ground state
-      prev_point_label = p->point_state;
-      if (p->point_state == PointLabel::GROUND) {
-        prev_gnd_radius = p->radius;
-        prev_gnd_point = pcl::PointXYZ(p->orig_point->x, p->orig_point->y, p->orig_point->z);
-        ground_cluster.addPoint(p->radius, p->orig_point->z);
-        prev_gnd_slope = ground_cluster.getAverageSlope();
-      }
-      // update the non ground state
-      if (p->point_state == PointLabel::NON_GROUND) {
-        non_ground_cluster.addPoint(p->radius, p->orig_point->z);
-      }
+    if (p->point_state == PointLabel::GROUND) {
+      ground_cluster.initialize();
+      non_ground_cluster.initialize();
+    }
+    if (p->point_state == PointLabel::NON_GROUND) {
+      out_no_ground_indices.indices.push_back(p->orig_index);
+    } else if (  // NOLINT
+      (prev_point_label == PointLabel::NON_GROUND) &&
+      (p->point_state == PointLabel::POINT_FOLLOW)) {
+      p->point_state = PointLabel::NON_GROUND;
+      out_no_ground_indices.indices.push_back(p->orig_index);
+    } else if (  // NOLINT
+      (prev_point_label == PointLabel::GROUND) && (p->point_state == PointLabel::POINT_FOLLOW)) {
+      p->point_state = PointLabel::GROUND;
+    } else {
+    }
+
+    // update the ground state
+    prev_point_label = p->point_state;
+    if (p->point_state == PointLabel::GROUND) {
+      prev_gnd_radius = p->radius;
+      prev_gnd_point = pcl::PointXYZ(p->orig_point->x, p->orig_point->y, p->orig_point->z);
+      ground_cluster.addPoint(p->radius, p->orig_point->z);
+      prev_gnd_slope = ground_cluster.getAverageSlope();
+    }
+    // update the non ground state
+    if (p->point_state == PointLabel::NON_GROUND) {
+      non_ground_cluster.addPoint(p->radius, p->orig_point->z);
     }
   }
 }
@@ -546,18 +602,16 @@ void ScanGroundFilterComponent::filter(
   pcl::PointCloud<pcl::PointXYZ>::Ptr current_sensor_cloud_ptr(new pcl::PointCloud<pcl::PointXYZ>);
   pcl::fromROSMsg(*input, *current_sensor_cloud_ptr);
 
-  std::vector<PointCloudRefVector> radial_ordered_points;
-
   pcl::PointIndices no_ground_indices;
   pcl::PointCloud<pcl::PointXYZ>::Ptr no_ground_cloud_ptr(new pcl::PointCloud<pcl::PointXYZ>);
   no_ground_cloud_ptr->points.reserve(current_sensor_cloud_ptr->points.size());
 
   if (elevation_grid_mode_) {
-    convertPointcloudGridScan(current_sensor_cloud_ptr, radial_ordered_points);
-    classifyPointCloudGridScan(radial_ordered_points, no_ground_indices);
+    convertPointcloudGridScan(current_sensor_cloud_ptr, radial_ordered_points_);
+    classifyPointCloudGridScan(radial_ordered_points_, no_ground_indices);
   } else {
-    convertPointcloud(current_sensor_cloud_ptr, radial_ordered_points);
-    classifyPointCloud(radial_ordered_points, no_ground_indices);
+    convertPointcloud(current_sensor_cloud_ptr, radial_ordered_points_);
+    classifyPointCloud(radial_ordered_points_, no_ground_indices);
   }
 
   extractObjectPoints(current_sensor_cloud_ptr, no_ground_indices, no_ground_cloud_ptr);
@@ -584,12 +638,14 @@ rcl_interfaces::msg::SetParametersResult ScanGroundFilterComponent::onParameter(
   double global_slope_max_angle_deg{get_parameter("global_slope_max_angle_deg").as_double()};
   if (get_param(p, "global_slope_max_angle_deg", global_slope_max_angle_deg)) {
     global_slope_max_angle_rad_ = deg2rad(global_slope_max_angle_deg);
+    updateSlopeThresholds();
     RCLCPP_DEBUG(
       get_logger(), "Setting global_slope_max_angle_rad to: %f.", global_slope_max_angle_rad_);
   }
   double local_slope_max_angle_deg{get_parameter("local_slope_max_angle_deg").as_double()};
   if (get_param(p, "local_slope_max_angle_deg", local_slope_max_angle_deg)) {
     local_slope_max_angle_rad_ = deg2rad(local_slope_max_angle_deg);
+    updateSlopeThresholds();
     RCLCPP_DEBUG(
       get_logger(), "Setting local_slope_max_angle_rad to: %f.", local_slope_max_angle_rad_);
   }
@@ -619,6 +675,10 @@ rcl_interfaces::msg::SetParametersResult ScanGroundFilterComponent::onParameter(
       get_logger(),
       "Setting use_recheck_ground_cluster to: " << std::boolalpha << use_recheck_ground_cluster_);
   }
+  if (get_param(p, "num_threads", num_threads_)) {
+    num_threads_ = std::max(num_threads_, 1);
+    RCLCPP_DEBUG(get_logger(), "Setting num_threads to: %d.", num_threads_);
+  }
   rcl_interfaces::msg::SetParametersResult result;
   result.successful = true;
   result.reason = "success";
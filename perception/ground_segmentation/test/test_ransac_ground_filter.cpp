@@ -0,0 +1,75 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ground_segmentation/ransac_ground_filter_nodelet.hpp"
+
+#include <gtest/gtest.h>
+
+using ground_segmentation::PreviousPlane;
+
+namespace
+{
+Eigen::VectorXf createPlane(const float height)
+{
+  Eigen::VectorXf coefficients(4);
+  coefficients << 0.0F, 0.0F, 1.0F, -height;
+  return coefficients;
+}
+}  // namespace
+
+TEST(PreviousPlane, NoPlane)
+{
+  PreviousPlane previous_plane;
+  EXPECT_FALSE(previous_plane.valid());
+  EXPECT_FALSE(previous_plane.fits(1.0));
+}
+
+TEST(PreviousPlane, FitsAgainstRansacInlierRatio)
+{
+  PreviousPlane previous_plane;
+  previous_plane.setFromRansac(createPlane(0.0F), 0.8);
+  EXPECT_TRUE(previous_plane.valid());
+  EXPECT_TRUE(previous_plane.fits(0.8));
+  EXPECT_TRUE(previous_plane.fits(0.73));
+  EXPECT_FALSE(previous_plane.fits(0.71));
+
+  previous_plane.reset();
+  EXPECT_FALSE(previous_plane.valid());
+  EXPECT_FALSE(previous_plane.fits(0.8));
+}
+
+TEST(PreviousPlane, ReferenceDoesNotDecayWhenReused)
+{
+  PreviousPlane previous_plane;
+  previous_plane.setFromRansac(createPlane(0.0F), 0.8);
+
+  // each reused frame keeps 91% of the previous one, which must not lower the reference
+  double inlier_ratio = 0.8;
+  for (int i = 1; i <= 10; ++i) {
+    inlier_ratio *= 0.91;
+    if (!previous_plane.fits(inlier_ratio)) {
+      break;
+    }
+    previous_plane.setRefined(createPlane(0.01F * i));
+  }
+  EXPECT_FALSE(previous_plane.fits(inlier_ratio));
+  EXPECT_FALSE(previous_plane.fits(0.71));
+  EXPECT_TRUE(previous_plane.fits(0.73));
+  EXPECT_FLOAT_EQ(previous_plane.coefficients()[3], -0.01F);
+
+  // a new RANSAC plane resets the reference
+  previous_plane.setFromRansac(createPlane(0.5F), 0.5);
+  EXPECT_TRUE(previous_plane.fits(0.46));
+  EXPECT_FLOAT_EQ(previous_plane.coefficients()[3], -0.5F);
+}
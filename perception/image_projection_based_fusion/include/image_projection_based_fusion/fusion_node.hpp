@@ -16,6 +16,7 @@
 #define IMAGE_PROJECTION_BASED_FUSION__FUSION_NODE_HPP_
 
 #include <image_projection_based_fusion/debugger.hpp>
+#include <image_projection_based_fusion/utils/stamped_ring_buffer.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <tier4_autoware_utils/ros/debug_publisher.hpp>
 #include <tier4_autoware_utils/system/stop_watch.hpp>
@@ -81,11 +82,26 @@ protected:
     const DetectedObjectsWithFeature & input_roi_msg,
     const sensor_msgs::msg::CameraInfo & camera_info, Msg & output_msg) = 0;
 
+  struct MatchedRoi
+  {
+    std::size_t image_id;
+    DetectedObjectsWithFeature::ConstSharedPtr roi_msg;
+  };
+
+  // fuse the rois of several cameras matched with input_msg, in the order of matched_rois.
+  // By default, fuseOnSingleImage is called for one camera after another; a fusion may instead
+  // project the cameras concurrently with num_threads_, as long as the result is the same.
+  virtual void fuseOnImages(
+    const Msg & input_msg, const std::vector<MatchedRoi> & matched_rois, Msg & output_msg);
+
   // set args if you need
   virtual void postprocess(Msg & output_msg);
 
   virtual void publish(const Msg & output_msg);
 
+  // the preprocessed copy of input_msg to fuse the rois into
+  typename Msg::SharedPtr makeOutputMsg(const Msg & input_msg);
+
   void timer_callback();
   void setPeriod(const int64_t new_period);
 
@@ -100,6 +116,7 @@ protected:
   rclcpp::TimerBase::SharedPtr timer_;
   double timeout_ms_{};
   double match_threshold_ms_{};
+  int num_threads_{1};
 
   /** \brief A vector of subscriber. */
   typename rclcpp::Subscription<Msg>::SharedPtr sub_;
@@ -112,7 +129,8 @@ protected:
   // cache for fusion
   std::vector<bool> is_fused_;
   std::pair<int64_t, typename Msg::SharedPtr> sub_std_pair_;
-  std::vector<std::map<int64_t, DetectedObjectsWithFeature::ConstSharedPtr>> roi_stdmap_;
+  // the rois not fused yet of each camera, ordered by stamp
+  std::vector<StampedRingBuffer<DetectedObjectsWithFeature::ConstSharedPtr>> roi_buffers_;
   std::mutex mutex_;
 
   // output publisher
@@ -120,7 +138,7 @@ protected:
 
   // debugger
   std::shared_ptr<Debugger> debugger_;
-  virtual bool out_of_scope(const ObjType & obj) = 0;
+  virtual bool out_of_scope(const ObjType & obj) const = 0;
   // cspell: ignore minx, maxx, miny, maxy, minz, maxz
   float filter_scope_minx_;
   float filter_scope_maxx_;
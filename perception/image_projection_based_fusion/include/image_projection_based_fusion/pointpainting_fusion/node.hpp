@@ -23,9 +23,11 @@
 #include <lidar_centerpoint/centerpoint_trt.hpp>
 #include <lidar_centerpoint/detection_class_remapper.hpp>
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace image_projection_based_fusion
@@ -46,6 +48,33 @@ protected:
     const sensor_msgs::msg::CameraInfo & camera_info,
     sensor_msgs::msg::PointCloud2 & painted_pointcloud_msg) override;
 
+  void fuseOnImages(
+    const sensor_msgs::msg::PointCloud2 & input_pointcloud_msg,
+    const std::vector<MatchedRoi> & matched_rois,
+    sensor_msgs::msg::PointCloud2 & painted_pointcloud_msg) override;
+
+  // the points the rois of a camera paint, computed without modifying the pointcloud
+  struct FusionResult
+  {
+    enum : std::uint8_t { CAR = 1, PEDESTRIAN = 2, BICYCLE = 4 };
+
+    bool is_valid{false};
+    // the index of a point and the classes painted on it
+    std::vector<std::pair<std::size_t, std::uint8_t>> painted_points;
+    std::vector<sensor_msgs::msg::RegionOfInterest> debug_image_rois;
+    std::vector<Eigen::Vector2d> debug_image_points;
+  };
+
+  FusionResult projectOnSingleImage(
+    const sensor_msgs::msg::PointCloud2 & painted_pointcloud_msg, const std::size_t image_id,
+    const DetectedObjectsWithFeature & input_roi_msg,
+    const sensor_msgs::msg::CameraInfo & camera_info) const;
+
+  void applyFusionResult(
+    const FusionResult & result, const std::size_t image_id,
+    const DetectedObjectsWithFeature & input_roi_msg,
+    sensor_msgs::msg::PointCloud2 & painted_pointcloud_msg);
+
   void postprocess(sensor_msgs::msg::PointCloud2 & painted_pointcloud_msg) override;
 
   rclcpp::Publisher<DetectedObjects>::SharedPtr obj_pub_ptr_;
@@ -61,7 +90,7 @@ protected:
 
   std::unique_ptr<image_projection_based_fusion::PointPaintingTRT> detector_ptr_{nullptr};
 
-  bool out_of_scope(const DetectedObjects & obj);
+  bool out_of_scope(const DetectedObjects & obj) const override;
 };
 }  // namespace image_projection_based_fusion
 #endif  // IMAGE_PROJECTION_BASED_FUSION__POINTPAINTING_FUSION__NODE_HPP_
@@ -18,6 +18,8 @@
 #include "image_projection_based_fusion/fusion_node.hpp"
 
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace image_projection_based_fusion
 {
@@ -38,6 +40,32 @@ protected:
     const sensor_msgs::msg::CameraInfo & camera_info,
     DetectedObjectsWithFeature & output_cluster_msg) override;
 
+  void fuseOnImages(
+    const DetectedObjectsWithFeature & input_cluster_msg,
+    const std::vector<MatchedRoi> & matched_rois,
+    DetectedObjectsWithFeature & output_cluster_msg) override;
+
+  // what the rois of a camera give to the clusters, computed without modifying the node
+  struct FusionResult
+  {
+    bool is_valid{false};
+    // the index of a cluster and the roi whose label it takes, in the order of the rois
+    std::vector<std::pair<std::size_t, const DetectedObjectWithFeature *>> matched_objects;
+    std::vector<sensor_msgs::msg::RegionOfInterest> debug_image_rois;
+    std::vector<sensor_msgs::msg::RegionOfInterest> debug_pointcloud_rois;
+    std::vector<Eigen::Vector2d> debug_image_points;
+  };
+
+  FusionResult projectOnSingleImage(
+    const DetectedObjectsWithFeature & input_cluster_msg,
+    const DetectedObjectsWithFeature & input_roi_msg,
+    const sensor_msgs::msg::CameraInfo & camera_info) const;
+
+  void applyFusionResult(
+    const FusionResult & result, const std::size_t image_id,
+    const DetectedObjectsWithFeature & input_roi_msg,
+    DetectedObjectsWithFeature & output_cluster_msg);
+
   bool use_iou_x_{false};
   bool use_iou_y_{false};
   bool use_iou_{false};
@@ -46,8 +74,8 @@ protected:
   bool remove_unknown_;
   float trust_distance_;
 
-  bool filter_by_distance(const DetectedObjectWithFeature & obj);
-  bool out_of_scope(const DetectedObjectWithFeature & obj);
+  bool filter_by_distance(const DetectedObjectWithFeature & obj) const;
+  bool out_of_scope(const DetectedObjectWithFeature & obj) const override;
   // bool CheckUnknown(const DetectedObjectsWithFeature & obj);
 };
 
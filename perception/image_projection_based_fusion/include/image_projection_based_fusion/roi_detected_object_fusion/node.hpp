@@ -20,6 +20,7 @@
 
 #include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace image_projection_based_fusion
@@ -40,19 +41,42 @@ protected:
     const DetectedObjectsWithFeature & input_roi_msg,
     const sensor_msgs::msg::CameraInfo & camera_info, DetectedObjects & output_object_msg) override;
 
+  void fuseOnImages(
+    const DetectedObjects & input_object_msg, const std::vector<MatchedRoi> & matched_rois,
+    DetectedObjects & output_object_msg) override;
+
+  // what the rois of a camera decide for the objects, computed without modifying the node
+  struct FusionResult
+  {
+    bool is_valid{false};
+    // the index of an object and whether it is fused, otherwise ignored
+    std::vector<std::pair<std::size_t, bool>> object_flags;
+    std::vector<RegionOfInterest> debug_obstacle_rois;
+    std::vector<Eigen::Vector2d> debug_obstacle_points;
+  };
+
+  FusionResult projectOnSingleImage(
+    const DetectedObjects & input_object_msg, const DetectedObjectsWithFeature & input_roi_msg,
+    const sensor_msgs::msg::CameraInfo & camera_info) const;
+
+  void applyFusionResult(
+    const FusionResult & result, const std::size_t image_id,
+    const DetectedObjectsWithFeature & input_roi_msg);
+
   std::map<std::size_t, RegionOfInterest> generateDetectedObjectRoIs(
     const std::vector<DetectedObject> & input_objects, const double image_width,
     const double image_height, const Eigen::Affine3d & object2camera_affine,
-    const Eigen::Matrix4d & camera_projection);
+    const Eigen::Matrix4d & camera_projection, FusionResult & result) const;
 
   void fuseObjectsOnImage(
     const std::vector<DetectedObject> & objects,
     const std::vector<DetectedObjectWithFeature> & image_rois,
-    const std::map<std::size_t, sensor_msgs::msg::RegionOfInterest> & object_roi_map);
+    const std::map<std::size_t, sensor_msgs::msg::RegionOfInterest> & object_roi_map,
+    FusionResult & result) const;
 
   void publish(const DetectedObjects & output_msg) override;
 
-  bool out_of_scope(const DetectedObject & obj);
+  bool out_of_scope(const DetectedObject & obj) const override;
 
 private:
   struct
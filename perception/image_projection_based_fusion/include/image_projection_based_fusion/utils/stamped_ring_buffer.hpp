@@ -0,0 +1,139 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef IMAGE_PROJECTION_BASED_FUSION__UTILS__STAMPED_RING_BUFFER_HPP_
+#define IMAGE_PROJECTION_BASED_FUSION__UTILS__STAMPED_RING_BUFFER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace image_projection_based_fusion
+{
+// A fixed size buffer of values ordered by their stamp [ns]. When it is full, pushing a value
+// drops the oldest one. The values usually arrive in order, so that pushing is O(1), and the
+// nearest value to a stamp is found by a binary search.
+template <class T>
+class StampedRingBuffer
+{
+public:
+  explicit StampedRingBuffer(const std::size_t capacity = 1)
+  : stamps_(capacity > 0 ? capacity : 1), values_(capacity > 0 ? capacity : 1)
+  {
+  }
+
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  void clear() { popFront(size_); }
+
+  // a value with the stamp of a kept one replaces it
+  void push(const int64_t stamp, T value)
+  {
+    const std::size_t same = lowerBound(stamp);
+    if (same < size_ && stampAt(same) == stamp) {
+      valueAt(same) = std::move(value);
+      return;
+    }
+    if (size_ == stamps_.size()) {
+      if (stamp < stampAt(0)) {
+        return;  // older than everything kept
+      }
+      popFront(1);
+    }
+    std::size_t i = size_;
+    ++size_;
+    // shift the newer values, only for a value arriving out of order
+    for (; i > 0 && stamp < stampAt(i - 1); --i) {
+      stampAt(i) = stampAt(i - 1);
+      valueAt(i) = std::move(valueAt(i - 1));
+    }
+    stampAt(i) = stamp;
+    valueAt(i) = std::move(value);
+  }
+
+  // drop the values older than stamp
+  void eraseOlderThan(const int64_t stamp) { popFront(lowerBound(stamp)); }
+
+  // take the value whose stamp is the nearest to stamp, within threshold, the newer on ties
+  std::optional<std::pair<int64_t, T>> takeNearest(const int64_t stamp, const int64_t threshold)
+  {
+    const std::size_t upper = lowerBound(stamp);
+    std::optional<std::size_t> nearest;
+    int64_t min_interval = threshold;
+    if (upper > 0 && stamp - stampAt(upper - 1) <= min_interval) {
+      nearest = upper - 1;
+      min_interval = stamp - stampAt(upper - 1);
+    }
+    if (upper < size_ && stampAt(upper) - stamp <= min_interval) {
+      nearest = upper;
+    }
+    if (!nearest) {
+      return std::nullopt;
+    }
+    std::pair<int64_t, T> taken{stampAt(*nearest), std::move(valueAt(*nearest))};
+    erase(*nearest);
+    return taken;
+  }
+
+private:
+  std::size_t toIndex(const std::size_t i) const { return (head_ + i) % stamps_.size(); }
+  int64_t & stampAt(const std::size_t i) { return stamps_[toIndex(i)]; }
+  T & valueAt(const std::size_t i) { return values_[toIndex(i)]; }
+
+  // the first position whose stamp is not less than stamp
+  std::size_t lowerBound(const int64_t stamp)
+  {
+    std::size_t first = 0;
+    std::size_t count = size_;
+    while (count > 0) {
+      const std::size_t step = count / 2;
+      if (stampAt(first + step) < stamp) {
+        first += step + 1;
+        count -= step + 1;
+      } else {
+        count = step;
+      }
+    }
+    return first;
+  }
+
+  void popFront(const std::size_t count)
+  {
+    for (std::size_t i = 0; i < count; ++i) {
+      valueAt(i) = T{};  // release what the value holds
+    }
+    head_ = toIndex(count);
+    size_ -= count;
+  }
+
+  void erase(const std::size_t i)
+  {
+    for (std::size_t j = i; j + 1 < size_; ++j) {
+      stampAt(j) = stampAt(j + 1);
+      valueAt(j) = std::move(valueAt(j + 1));
+    }
+    valueAt(size_ - 1) = T{};
+    --size_;
+  }
+
+  std::vector<int64_t> stamps_;
+  std::vector<T> values_;
+  std::size_t head_{0};
+  std::size_t size_{0};
+};
+}  // namespace image_projection_based_fusion
+
+#endif  // IMAGE_PROJECTION_BASED_FUSION__UTILS__STAMPED_RING_BUFFER_HPP_
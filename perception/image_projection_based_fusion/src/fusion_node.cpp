@@ -23,6 +23,7 @@
 
 #include <boost/optional.hpp>
 
+#include <algorithm>
 #include <cmath>
 
 #ifdef ROS_DISTRO_GALACTIC
@@ -37,6 +38,11 @@
 #include <typeinfo>
 namespace image_projection_based_fusion
 {
+namespace
+{
+// more than the rois of a camera arriving within timeout_ms at any usual frame rate
+constexpr std::size_t ROI_BUFFER_SIZE = 32;
+}  // namespace
 
 template <class Msg, class ObjType>
 FusionNode<Msg, ObjType>::FusionNode(
@@ -59,6 +65,7 @@ FusionNode<Msg, ObjType>::FusionNode(
   // Set parameters
   match_threshold_ms_ = declare_parameter<double>("match_threshold_ms");
   timeout_ms_ = declare_parameter<double>("timeout_ms");
+  num_threads_ = std::max(1, static_cast<int>(declare_parameter("num_threads", 1)));
 
   input_offset_ms_ = declare_parameter("input_offset_ms", std::vector<double>{});
   if (!input_offset_ms_.empty() && rois_number_ != input_offset_ms_.size()) {
@@ -76,7 +83,8 @@ FusionNode<Msg, ObjType>::FusionNode(
 
   // sub rois
   rois_subs_.resize(rois_number_);
-  roi_stdmap_.resize(rois_number_);
+  roi_buffers_.assign(
+    rois_number_, StampedRingBuffer<DetectedObjectsWithFeature::ConstSharedPtr>(ROI_BUFFER_SIZE));
   is_fused_.resize(rois_number_, false);
   for (std::size_t roi_i = 0; roi_i < rois_number_; ++roi_i) {
     std::function<void(const DetectedObjectsWithFeature::ConstSharedPtr msg)> roi_callback =
@@ -154,67 +162,51 @@ void FusionNode<Msg, Obj>::subCallback(const typename Msg::ConstSharedPtr input_
 
   stop_watch_ptr_->toc("processing_time", true);
 
-  typename Msg::SharedPtr output_msg = std::make_shared<Msg>(*input_msg);
-
-  preprocess(*output_msg);
-
   int64_t timestamp_nsec =
-    (*output_msg).header.stamp.sec * (int64_t)1e9 + (*output_msg).header.stamp.nanosec;
+    (*input_msg).header.stamp.sec * (int64_t)1e9 + (*input_msg).header.stamp.nanosec;
+  const int64_t match_threshold_nsec = match_threshold_ms_ * (int64_t)1e6;
 
   // if matching rois exist, fuseOnSingle
+  std::vector<MatchedRoi> matched_rois;
   for (std::size_t roi_i = 0; roi_i < rois_number_; ++roi_i) {
     if (camera_info_map_.find(roi_i) == camera_info_map_.end()) {
       RCLCPP_WARN(this->get_logger(), "no camera info. id is %zu", roi_i);
       continue;
     }
 
-    if ((roi_stdmap_.at(roi_i)).size() > 0) {
-      int64_t min_interval = 1e9;
-      int64_t matched_stamp = -1;
-      std::list<int64_t> outdate_stamps;
-
-      for (const auto & [k, v] : roi_stdmap_.at(roi_i)) {
-        int64_t new_stamp = timestamp_nsec + input_offset_ms_.at(roi_i) * (int64_t)1e6;
-        int64_t interval = abs(int64_t(k) - new_stamp);
-
-        if (interval <= min_interval && interval <= match_threshold_ms_ * (int64_t)1e6) {
-          min_interval = interval;
-          matched_stamp = k;
-        } else if (int64_t(k) < new_stamp && interval > match_threshold_ms_ * (int64_t)1e6) {
-          outdate_stamps.push_back(int64_t(k));
-        }
-      }
-
-      // remove outdated stamps
-      for (auto stamp : outdate_stamps) {
-        (roi_stdmap_.at(roi_i)).erase(stamp);
-      }
+    auto & roi_buffer = roi_buffers_.at(roi_i);
+    if (roi_buffer.empty()) {
+      continue;
+    }
+    const int64_t new_stamp = timestamp_nsec + input_offset_ms_.at(roi_i) * (int64_t)1e6;
 
-      // fuseOnSingle
-      if (matched_stamp != -1) {
-        if (debugger_) {
-          debugger_->clear();
-        }
+    // remove outdated stamps
+    roi_buffer.eraseOlderThan(new_stamp - match_threshold_nsec);
 
-        fuseOnSingleImage(
-          *input_msg, roi_i, *((roi_stdmap_.at(roi_i))[matched_stamp]), camera_info_map_.at(roi_i),
-          *output_msg);
-        (roi_stdmap_.at(roi_i)).erase(matched_stamp);
-        is_fused_.at(roi_i) = true;
+    const auto matched_roi = roi_buffer.takeNearest(new_stamp, match_threshold_nsec);
+    if (!matched_roi) {
+      continue;
+    }
+    matched_rois.push_back(MatchedRoi{roi_i, matched_roi->second});
+    is_fused_.at(roi_i) = true;
 
-        // add timestamp interval for debug
-        if (debug_publisher_) {
-          double timestamp_interval_ms = (matched_stamp - timestamp_nsec) / 1e6;
-          debug_publisher_->publish<tier4_debug_msgs::msg::Float64Stamped>(
-            "debug/roi" + std::to_string(roi_i) + "/timestamp_interval_ms", timestamp_interval_ms);
-          debug_publisher_->publish<tier4_debug_msgs::msg::Float64Stamped>(
-            "debug/roi" + std::to_string(roi_i) + "/timestamp_interval_offset_ms",
-            timestamp_interval_ms - input_offset_ms_.at(roi_i));
-        }
-      }
+    // add timestamp interval for debug
+    if (debug_publisher_) {
+      double timestamp_interval_ms = (matched_roi->first - timestamp_nsec) / 1e6;
+      debug_publisher_->publish<tier4_debug_msgs::msg::Float64Stamped>(
+        "debug/roi" + std::to_string(roi_i) + "/timestamp_interval_ms", timestamp_interval_ms);
+      debug_publisher_->publish<tier4_debug_msgs::msg::Float64Stamped>(
+        "debug/roi" + std::to_string(roi_i) + "/timestamp_interval_offset_ms",
+        timestamp_interval_ms - input_offset_ms_.at(roi_i));
     }
   }
 
+  // the input is only copied once the matching is done
+  typename Msg::SharedPtr output_msg = makeOutputMsg(*input_msg);
+  if (!matched_rois.empty()) {
+    fuseOnImages(*input_msg, matched_rois, *output_msg);
+  }
+
   // if all camera fused, postprocess; else, publish the old Msg(if exists) and cache the current
   // Msg
   if (std::count(is_fused_.begin(), is_fused_.end(), true) == static_cast<int>(rois_number_)) {
@@ -270,7 +262,7 @@ void FusionNode<Msg, Obj>::roiCallback(
     if (interval < match_threshold_ms_ * (int64_t)1e6 && is_fused_.at(roi_i) == false) {
       if (camera_info_map_.find(roi_i) == camera_info_map_.end()) {
         RCLCPP_WARN(this->get_logger(), "no camera info. id is %zu", roi_i);
-        (roi_stdmap_.at(roi_i))[timestamp_nsec] = input_roi_msg;
+        roi_buffers_.at(roi_i).push(timestamp_nsec, input_roi_msg);
         return;
       }
       if (debugger_) {
@@ -309,7 +301,29 @@ void FusionNode<Msg, Obj>::roiCallback(
     }
   }
   // store roi msg if not matched
-  (roi_stdmap_.at(roi_i))[timestamp_nsec] = input_roi_msg;
+  roi_buffers_.at(roi_i).push(timestamp_nsec, input_roi_msg);
+}
+
+template <class Msg, class Obj>
+void FusionNode<Msg, Obj>::fuseOnImages(
+  const Msg & input_msg, const std::vector<MatchedRoi> & matched_rois, Msg & output_msg)
+{
+  for (const auto & matched_roi : matched_rois) {
+    if (debugger_) {
+      debugger_->clear();
+    }
+    fuseOnSingleImage(
+      input_msg, matched_roi.image_id, *matched_roi.roi_msg,
+      camera_info_map_.at(matched_roi.image_id), output_msg);
+  }
+}
+
+template <class Msg, class Obj>
+typename Msg::SharedPtr FusionNode<Msg, Obj>::makeOutputMsg(const Msg & input_msg)
+{
+  auto output_msg = std::make_shared<Msg>(input_msg);
+  preprocess(*output_msg);
+  return output_msg;
 }
 
 template <class Msg, class Obj>
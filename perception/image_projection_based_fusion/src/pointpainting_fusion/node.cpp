@@ -143,13 +143,41 @@ void PointPaintingFusionNode::preprocess(sensor_msgs::msg::PointCloud2 & painted
 
 void PointPaintingFusionNode::fuseOnSingleImage(
   __attribute__((unused)) const sensor_msgs::msg::PointCloud2 & input_pointcloud_msg,
-  __attribute__((unused)) const std::size_t image_id,
-  const DetectedObjectsWithFeature & input_roi_msg,
+  const std::size_t image_id, const DetectedObjectsWithFeature & input_roi_msg,
   const sensor_msgs::msg::CameraInfo & camera_info,
   sensor_msgs::msg::PointCloud2 & painted_pointcloud_msg)
 {
-  std::vector<sensor_msgs::msg::RegionOfInterest> debug_image_rois;
-  std::vector<Eigen::Vector2d> debug_image_points;
+  applyFusionResult(
+    projectOnSingleImage(painted_pointcloud_msg, image_id, input_roi_msg, camera_info), image_id,
+    input_roi_msg, painted_pointcloud_msg);
+}
+
+void PointPaintingFusionNode::fuseOnImages(
+  __attribute__((unused)) const sensor_msgs::msg::PointCloud2 & input_pointcloud_msg,
+  const std::vector<MatchedRoi> & matched_rois,
+  sensor_msgs::msg::PointCloud2 & painted_pointcloud_msg)
+{
+  // the projections of the cameras only read the points, which are painted afterwards in order
+  std::vector<FusionResult> results(matched_rois.size());
+#pragma omp parallel for num_threads(num_threads_)
+  for (std::size_t i = 0; i < matched_rois.size(); ++i) {
+    const auto image_id = matched_rois.at(i).image_id;
+    results.at(i) = projectOnSingleImage(
+      painted_pointcloud_msg, image_id, *matched_rois.at(i).roi_msg, camera_info_map_.at(image_id));
+  }
+  for (std::size_t i = 0; i < matched_rois.size(); ++i) {
+    applyFusionResult(
+      results.at(i), matched_rois.at(i).image_id, *matched_rois.at(i).roi_msg,
+      painted_pointcloud_msg);
+  }
+}
+
+PointPaintingFusionNode::FusionResult PointPaintingFusionNode::projectOnSingleImage(
+  const sensor_msgs::msg::PointCloud2 & painted_pointcloud_msg, const std::size_t image_id,
+  const DetectedObjectsWithFeature & input_roi_msg,
+  const sensor_msgs::msg::CameraInfo & camera_info) const
+{
+  FusionResult result;
 
   // get transform from cluster frame id to camera optical frame id
   geometry_msgs::msg::TransformStamped transform_stamped;
@@ -158,10 +186,11 @@ void PointPaintingFusionNode::fuseOnSingleImage(
       tf_buffer_, /*target*/ camera_info.header.frame_id,
       /*source*/ painted_pointcloud_msg.header.frame_id, camera_info.header.stamp);
     if (!transform_stamped_optional) {
-      return;
+      return result;
     }
     transform_stamped = transform_stamped_optional.value();
   }
+  result.is_valid = true;
 
   // projection matrix
   Eigen::Matrix4d camera_projection;
@@ -175,13 +204,10 @@ void PointPaintingFusionNode::fuseOnSingleImage(
   tf2::doTransform(painted_pointcloud_msg, transformed_pointcloud, transform_stamped);
 
   // iterate points
-  sensor_msgs::PointCloud2Iterator<float> iter_car(painted_pointcloud_msg, "CAR");
-  sensor_msgs::PointCloud2Iterator<float> iter_ped(painted_pointcloud_msg, "PEDESTRIAN");
-  sensor_msgs::PointCloud2Iterator<float> iter_bic(painted_pointcloud_msg, "BICYCLE");
-
+  std::size_t point_index = 0;
   for (sensor_msgs::PointCloud2ConstIterator<float> iter_x(transformed_pointcloud, "x"),
        iter_y(transformed_pointcloud, "y"), iter_z(transformed_pointcloud, "z");
-       iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z, ++iter_car, ++iter_ped, ++iter_bic) {
+       iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z, ++point_index) {
     // filter the points outside of the horizontal field of view
     if (
       *iter_z <= 0.0 || (*iter_x / *iter_z) > tan_h_.at(image_id) ||
@@ -195,6 +221,7 @@ void PointPaintingFusionNode::fuseOnSingleImage(
       projected_point.x() / projected_point.z(), projected_point.y() / projected_point.z());
 
     // iterate 2d bbox
+    std::uint8_t painted_classes = 0;
     for (const auto & feature_object : input_roi_msg.feature_objects) {
       sensor_msgs::msg::RegionOfInterest roi = feature_object.feature.roi;
       // paint current point if it is inside bbox
@@ -207,40 +234,63 @@ void PointPaintingFusionNode::fuseOnSingleImage(
           autoware_auto_perception_msgs::msg::ObjectClassification::UNKNOWN) {
         switch (feature_object.object.classification.front().label) {
           case autoware_auto_perception_msgs::msg::ObjectClassification::CAR:
-            *iter_car = 1.0;
-            break;
           case autoware_auto_perception_msgs::msg::ObjectClassification::TRUCK:
-            *iter_car = 1.0;
-            break;
           case autoware_auto_perception_msgs::msg::ObjectClassification::TRAILER:
-            *iter_car = 1.0;
-            break;
           case autoware_auto_perception_msgs::msg::ObjectClassification::BUS:
-            *iter_car = 1.0;
+            painted_classes |= FusionResult::CAR;
             break;
           case autoware_auto_perception_msgs::msg::ObjectClassification::PEDESTRIAN:
-            *iter_ped = 1.0;
+            painted_classes |= FusionResult::PEDESTRIAN;
             break;
           case autoware_auto_perception_msgs::msg::ObjectClassification::BICYCLE:
-            *iter_bic = 1.0;
-            break;
           case autoware_auto_perception_msgs::msg::ObjectClassification::MOTORCYCLE:
-            *iter_bic = 1.0;
+            painted_classes |= FusionResult::BICYCLE;
             break;
         }
       }
       if (debugger_) {
-        debug_image_points.push_back(normalized_projected_point);
+        result.debug_image_points.push_back(normalized_projected_point);
       }
     }
+    if (painted_classes != 0) {
+      result.painted_points.emplace_back(point_index, painted_classes);
+    }
   }
   for (const auto & feature_object : input_roi_msg.feature_objects) {
-    debug_image_rois.push_back(feature_object.feature.roi);
+    result.debug_image_rois.push_back(feature_object.feature.roi);
+  }
+  return result;
+}
+
+void PointPaintingFusionNode::applyFusionResult(
+  const FusionResult & result, const std::size_t image_id,
+  const DetectedObjectsWithFeature & input_roi_msg,
+  sensor_msgs::msg::PointCloud2 & painted_pointcloud_msg)
+{
+  if (!result.is_valid) {
+    return;
+  }
+  if (!result.painted_points.empty()) {
+    sensor_msgs::PointCloud2Iterator<float> iter_car(painted_pointcloud_msg, "CAR");
+    sensor_msgs::PointCloud2Iterator<float> iter_ped(painted_pointcloud_msg, "PEDESTRIAN");
+    sensor_msgs::PointCloud2Iterator<float> iter_bic(painted_pointcloud_msg, "BICYCLE");
+    for (const auto & [point_index, painted_classes] : result.painted_points) {
+      const auto i = static_cast<int>(point_index);
+      if (painted_classes & FusionResult::CAR) {
+        *(iter_car + i) = 1.0;
+      }
+      if (painted_classes & FusionResult::PEDESTRIAN) {
+        *(iter_ped + i) = 1.0;
+      }
+      if (painted_classes & FusionResult::BICYCLE) {
+        *(iter_bic + i) = 1.0;
+      }
+    }
   }
 
   if (debugger_) {
-    debugger_->image_rois_ = debug_image_rois;
-    debugger_->obstacle_points_ = debug_image_points;
+    debugger_->image_rois_ = result.debug_image_rois;
+    debugger_->obstacle_points_ = result.debug_image_points;
     debugger_->publishImage(image_id, input_roi_msg.header.stamp);
   }
 }
@@ -267,7 +317,8 @@ void PointPaintingFusionNode::postprocess(sensor_msgs::msg::PointCloud2 & painte
   obj_pub_ptr_->publish(output_obj_msg);
 }
 
-bool PointPaintingFusionNode::out_of_scope(__attribute__((unused)) const DetectedObjects & obj)
+bool PointPaintingFusionNode::out_of_scope(
+  __attribute__((unused)) const DetectedObjects & obj) const
 {
   return false;
 }
@@ -79,9 +79,35 @@ void RoiClusterFusionNode::fuseOnSingleImage(
   const DetectedObjectsWithFeature & input_roi_msg,
   const sensor_msgs::msg::CameraInfo & camera_info, DetectedObjectsWithFeature & output_cluster_msg)
 {
-  std::vector<sensor_msgs::msg::RegionOfInterest> debug_image_rois;
-  std::vector<sensor_msgs::msg::RegionOfInterest> debug_pointcloud_rois;
-  std::vector<Eigen::Vector2d> debug_image_points;
+  applyFusionResult(
+    projectOnSingleImage(input_cluster_msg, input_roi_msg, camera_info), image_id, input_roi_msg,
+    output_cluster_msg);
+}
+
+void RoiClusterFusionNode::fuseOnImages(
+  const DetectedObjectsWithFeature & input_cluster_msg,
+  const std::vector<MatchedRoi> & matched_rois, DetectedObjectsWithFeature & output_cluster_msg)
+{
+  // the projections of the cameras are independent, only the labels are set in order
+  std::vector<FusionResult> results(matched_rois.size());
+#pragma omp parallel for num_threads(num_threads_)
+  for (std::size_t i = 0; i < matched_rois.size(); ++i) {
+    results.at(i) = projectOnSingleImage(
+      input_cluster_msg, *matched_rois.at(i).roi_msg,
+      camera_info_map_.at(matched_rois.at(i).image_id));
+  }
+  for (std::size_t i = 0; i < matched_rois.size(); ++i) {
+    applyFusionResult(
+      results.at(i), matched_rois.at(i).image_id, *matched_rois.at(i).roi_msg, output_cluster_msg);
+  }
+}
+
+RoiClusterFusionNode::FusionResult RoiClusterFusionNode::projectOnSingleImage(
+  const DetectedObjectsWithFeature & input_cluster_msg,
+  const DetectedObjectsWithFeature & input_roi_msg,
+  const sensor_msgs::msg::CameraInfo & camera_info) const
+{
+  FusionResult result;
 
   Eigen::Matrix4d projection;
   projection << camera_info.p.at(0), camera_info.p.at(1), camera_info.p.at(2), camera_info.p.at(3),
@@ -95,10 +121,11 @@ void RoiClusterFusionNode::fuseOnSingleImage(
       tf_buffer_, /*target*/ camera_info.header.frame_id,
       /*source*/ input_cluster_msg.header.frame_id, camera_info.header.stamp);
     if (!transform_stamped_optional) {
-      return;
+      return result;
     }
     transform_stamped = transform_stamped_optional.value();
   }
+  result.is_valid = true;
 
   std::map<std::size_t, RegionOfInterest> m_cluster_roi;
   for (std::size_t i = 0; i < input_cluster_msg.feature_objects.size(); ++i) {
@@ -146,7 +173,7 @@ void RoiClusterFusionNode::fuseOnSingleImage(
         max_x = std::max(static_cast<int>(normalized_projected_point.x()), max_x);
         max_y = std::max(static_cast<int>(normalized_projected_point.y()), max_y);
         projected_points.push_back(normalized_projected_point);
-        debug_image_points.push_back(normalized_projected_point);
+        result.debug_image_points.push_back(normalized_projected_point);
       }
     }
     if (projected_points.empty()) {
@@ -160,7 +187,7 @@ void RoiClusterFusionNode::fuseOnSingleImage(
     roi.width = max_x - min_x;
     roi.height = max_y - min_y;
     m_cluster_roi.insert(std::make_pair(i, roi));
-    debug_pointcloud_rois.push_back(roi);
+    result.debug_pointcloud_rois.push_back(roi);
   }
 
   for (const auto & feature_obj : input_roi_msg.feature_objects) {
@@ -184,25 +211,39 @@ void RoiClusterFusionNode::fuseOnSingleImage(
     }
     if (
       iou_threshold_ < max_iou &&
-      output_cluster_msg.feature_objects.at(index).object.existence_probability <=
-        feature_obj.object.existence_probability &&
       feature_obj.object.classification.front().label !=
         autoware_auto_perception_msgs::msg::ObjectClassification::UNKNOWN) {
-      output_cluster_msg.feature_objects.at(index).object.classification =
-        feature_obj.object.classification;
+      result.matched_objects.emplace_back(index, &feature_obj);
+    }
+    result.debug_image_rois.push_back(feature_obj.feature.roi);
+  }
+
+  return result;
+}
+
+void RoiClusterFusionNode::applyFusionResult(
+  const FusionResult & result, const std::size_t image_id,
+  const DetectedObjectsWithFeature & input_roi_msg, DetectedObjectsWithFeature & output_cluster_msg)
+{
+  if (!result.is_valid) {
+    return;
+  }
+  for (const auto & [index, feature_obj] : result.matched_objects) {
+    auto & output_object = output_cluster_msg.feature_objects.at(index).object;
+    if (output_object.existence_probability <= feature_obj->object.existence_probability) {
+      output_object.classification = feature_obj->object.classification;
     }
-    debug_image_rois.push_back(feature_obj.feature.roi);
   }
 
   if (debugger_) {
-    debugger_->image_rois_ = debug_image_rois;
-    debugger_->obstacle_rois_ = debug_pointcloud_rois;
-    debugger_->obstacle_points_ = debug_image_points;
+    debugger_->image_rois_ = result.debug_image_rois;
+    debugger_->obstacle_rois_ = result.debug_pointcloud_rois;
+    debugger_->obstacle_points_ = result.debug_image_points;
     debugger_->publishImage(image_id, input_roi_msg.header.stamp);
   }
 }
 
-bool RoiClusterFusionNode::out_of_scope(const DetectedObjectWithFeature & obj)
+bool RoiClusterFusionNode::out_of_scope(const DetectedObjectWithFeature & obj) const
 {
   auto cluster = obj.feature.cluster;
   bool is_out = false;
@@ -232,7 +273,7 @@ bool RoiClusterFusionNode::out_of_scope(const DetectedObjectWithFeature & obj)
   return is_out;
 }
 
-bool RoiClusterFusionNode::filter_by_distance(const DetectedObjectWithFeature & obj)
+bool RoiClusterFusionNode::filter_by_distance(const DetectedObjectWithFeature & obj) const
 {
   const auto & position = obj.object.kinematics.pose_with_covariance.pose.position;
   const auto square_distance = position.x * position.x + position.y + position.y;
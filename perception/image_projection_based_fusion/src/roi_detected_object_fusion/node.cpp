@@ -55,16 +55,44 @@ void RoiDetectedObjectFusionNode::fuseOnSingleImage(
   const sensor_msgs::msg::CameraInfo & camera_info,
   DetectedObjects & output_object_msg __attribute__((unused)))
 {
+  applyFusionResult(
+    projectOnSingleImage(input_object_msg, input_roi_msg, camera_info), image_id, input_roi_msg);
+}
+
+void RoiDetectedObjectFusionNode::fuseOnImages(
+  const DetectedObjects & input_object_msg, const std::vector<MatchedRoi> & matched_rois,
+  DetectedObjects & output_object_msg __attribute__((unused)))
+{
+  // the projections of the cameras are independent, only the flags are set in order
+  std::vector<FusionResult> results(matched_rois.size());
+#pragma omp parallel for num_threads(num_threads_)
+  for (std::size_t i = 0; i < matched_rois.size(); ++i) {
+    results.at(i) = projectOnSingleImage(
+      input_object_msg, *matched_rois.at(i).roi_msg,
+      camera_info_map_.at(matched_rois.at(i).image_id));
+  }
+  for (std::size_t i = 0; i < matched_rois.size(); ++i) {
+    applyFusionResult(results.at(i), matched_rois.at(i).image_id, *matched_rois.at(i).roi_msg);
+  }
+}
+
+RoiDetectedObjectFusionNode::FusionResult RoiDetectedObjectFusionNode::projectOnSingleImage(
+  const DetectedObjects & input_object_msg, const DetectedObjectsWithFeature & input_roi_msg,
+  const sensor_msgs::msg::CameraInfo & camera_info) const
+{
+  FusionResult result;
+
   Eigen::Affine3d object2camera_affine;
   {
     const auto transform_stamped_optional = getTransformStamped(
       tf_buffer_, /*target*/ camera_info.header.frame_id,
       /*source*/ input_object_msg.header.frame_id, input_object_msg.header.stamp);
     if (!transform_stamped_optional) {
-      return;
+      return result;
     }
     object2camera_affine = transformToEigen(transform_stamped_optional.value().transform);
   }
+  result.is_valid = true;
 
   Eigen::Matrix4d camera_projection;
   camera_projection << camera_info.p.at(0), camera_info.p.at(1), camera_info.p.at(2),
@@ -74,14 +102,39 @@ void RoiDetectedObjectFusionNode::fuseOnSingleImage(
 
   const auto object_roi_map = generateDetectedObjectRoIs(
     input_object_msg.objects, static_cast<double>(camera_info.width),
-    static_cast<double>(camera_info.height), object2camera_affine, camera_projection);
-  fuseObjectsOnImage(input_object_msg.objects, input_roi_msg.feature_objects, object_roi_map);
+    static_cast<double>(camera_info.height), object2camera_affine, camera_projection, result);
+  fuseObjectsOnImage(
+    input_object_msg.objects, input_roi_msg.feature_objects, object_roi_map, result);
+  return result;
+}
+
+void RoiDetectedObjectFusionNode::applyFusionResult(
+  const FusionResult & result, const std::size_t image_id,
+  const DetectedObjectsWithFeature & input_roi_msg)
+{
+  if (!result.is_valid) {
+    return;
+  }
+  for (const auto & [obj_i, is_fused] : result.object_flags) {
+    // an object fused on another image stays fused
+    if (fused_object_flags_.at(obj_i)) {
+      continue;
+    }
+    if (is_fused) {
+      fused_object_flags_.at(obj_i) = true;
+    } else {
+      ignored_object_flags_.at(obj_i) = true;
+    }
+  }
 
   if (debugger_) {
+    debugger_->image_rois_.clear();
     debugger_->image_rois_.reserve(input_roi_msg.feature_objects.size());
     for (std::size_t roi_i = 0; roi_i < input_roi_msg.feature_objects.size(); ++roi_i) {
       debugger_->image_rois_.push_back(input_roi_msg.feature_objects.at(roi_i).feature.roi);
     }
+    debugger_->obstacle_rois_ = result.debug_obstacle_rois;
+    debugger_->obstacle_points_ = result.debug_obstacle_points;
     debugger_->publishImage(image_id, input_roi_msg.header.stamp);
   }
 }
@@ -89,7 +142,7 @@ void RoiDetectedObjectFusionNode::fuseOnSingleImage(
 std::map<std::size_t, RegionOfInterest> RoiDetectedObjectFusionNode::generateDetectedObjectRoIs(
   const std::vector<DetectedObject> & input_objects, const double image_width,
   const double image_height, const Eigen::Affine3d & object2camera_affine,
-  const Eigen::Matrix4d & camera_projection)
+  const Eigen::Matrix4d & camera_projection, FusionResult & result) const
 {
   std::map<std::size_t, RegionOfInterest> object_roi_map;
   for (std::size_t obj_i = 0; obj_i < input_objects.size(); ++obj_i) {
@@ -138,7 +191,7 @@ std::map<std::size_t, RegionOfInterest> RoiDetectedObjectFusionNode::generateDet
         point_on_image_cnt++;
 
         if (debugger_) {
-          debugger_->obstacle_points_.push_back(proj_point);
+          result.debug_obstacle_points.push_back(proj_point);
         }
       }
     }
@@ -160,7 +213,7 @@ std::map<std::size_t, RegionOfInterest> RoiDetectedObjectFusionNode::generateDet
     object_roi_map.insert(std::make_pair(obj_i, roi));
 
     if (debugger_) {
-      debugger_->obstacle_rois_.push_back(roi);
+      result.debug_obstacle_rois.push_back(roi);
     }
   }
 
@@ -170,7 +223,8 @@ std::map<std::size_t, RegionOfInterest> RoiDetectedObjectFusionNode::generateDet
 void RoiDetectedObjectFusionNode::fuseObjectsOnImage(
   const std::vector<DetectedObject> & objects __attribute__((unused)),
   const std::vector<DetectedObjectWithFeature> & image_rois,
-  const std::map<std::size_t, sensor_msgs::msg::RegionOfInterest> & object_roi_map)
+  const std::map<std::size_t, sensor_msgs::msg::RegionOfInterest> & object_roi_map,
+  FusionResult & result) const
 {
   for (const auto & object_pair : object_roi_map) {
     const auto & obj_i = object_pair.first;
@@ -189,23 +243,19 @@ void RoiDetectedObjectFusionNode::fuseObjectsOnImage(
       }
     }
 
+    bool is_fused = false;
     if (max_iou > fusion_params_.min_iou_threshold) {
       if (fusion_params_.use_roi_probability) {
-        if (roi_prob > fusion_params_.roi_probability_threshold) {
-          fused_object_flags_.at(obj_i) = true;
-        } else {
-          ignored_object_flags_.at(obj_i) = true;
-        }
+        is_fused = roi_prob > fusion_params_.roi_probability_threshold;
       } else {
-        fused_object_flags_.at(obj_i) = true;
+        is_fused = true;
       }
-    } else {
-      ignored_object_flags_.at(obj_i) = true;
     }
+    result.object_flags.emplace_back(obj_i, is_fused);
   }
 }
 
-bool RoiDetectedObjectFusionNode::out_of_scope(const DetectedObject & obj)
+bool RoiDetectedObjectFusionNode::out_of_scope(const DetectedObject & obj) const
 {
   bool is_out = true;
   auto pose = obj.kinematics.pose_with_covariance.pose;
@@ -46,7 +46,6 @@
 #ifndef LIDAR_APOLLO_INSTANCE_SEGMENTATION__CLUSTER2D_HPP_
 #define LIDAR_APOLLO_INSTANCE_SEGMENTATION__CLUSTER2D_HPP_
 
-#include "disjoint_set.hpp"
 #include "util.hpp"
 
 #include <std_msgs/msg/header.hpp>
@@ -89,7 +88,7 @@ struct Obstacle
 class Cluster2D
 {
 public:
-  Cluster2D(const int rows, const int cols, const float range);
+  Cluster2D(const int rows, const int cols, const float range, const int num_threads = 1);
 
   ~Cluster2D() {}
 
@@ -124,29 +123,22 @@ private:
   pcl::PointCloud<pcl::PointXYZI>::Ptr pc_ptr_;
   const std::vector<int> * valid_indices_in_pc_ = nullptr;
 
-  struct Node
-  {
-    Node * center_node;
-    Node * parent;
-    char node_rank;
-    char traversed;
-    bool is_center;
-    bool is_object;
-    int point_num;
-    int obstacle_id;
-
-    Node()
-    {
-      center_node = nullptr;
-      parent = nullptr;
-      node_rank = 0;
-      traversed = 0;
-      is_center = false;
-      is_object = false;
-      point_num = 0;
-      obstacle_id = -1;
-    }
-  };
+  int num_threads_;
+
+  // grids of rows_ * cols_ cells, reused from a frame to the next
+  std::vector<int> point_num_;
+  std::vector<int> center_grid_;
+  std::vector<char> is_object_;
+  // 0 not visited yet, 1 visited, 2 on the path being traversed
+  std::vector<char> traversed_;
+  std::vector<char> is_center_;
+  // the center on the cycle which the cell leads to
+  std::vector<int> cycle_root_;
+  // union-find over the center cells, whose root is the first cell of each set
+  std::vector<int> center_parent_;
+  std::vector<int> root_obstacle_id_;
+  std::vector<int> centers_;
+  std::vector<int> traverse_path_;
 
   inline bool IsValidRowCol(int row, int col) const { return IsValidRow(row) && IsValidCol(col); }
 
@@ -156,7 +148,10 @@ private:
 
   inline int RowCol2Grid(int row, int col) const { return row * cols_ + col; }
 
-  void traverse(Node * x);
+  void traverse(int grid);
+  void uniteCenters(const int row_begin, const int row_end);
+  int findCenterRoot(int grid);
+  void uniteCenterRoots(int grid1, int grid2);
 };
 
 #endif  // LIDAR_APOLLO_INSTANCE_SEGMENTATION__CLUSTER2D_HPP_
@@ -21,6 +21,7 @@
 #include <pcl/point_types.h>
 
 #include <memory>
+#include <vector>
 
 class FeatureGenerator
 {
@@ -30,11 +31,18 @@ private:
   bool use_intensity_feature_;
   bool use_constant_feature_;
   std::shared_ptr<FeatureMapInterface> map_ptr_;
+  int num_threads_;
+  // the cell of each point, -1 for the points out of the map
+  std::vector<int> point_cells_;
+  // the indices of the points in the map, sorted by band of cells and in their order in the cloud
+  std::vector<size_t> band_points_;
+  // the first element of each band in band_points_, followed by the number of points in the map
+  std::vector<size_t> band_offsets_;
 
 public:
   FeatureGenerator(
     const int width, const int height, const int range, const bool use_intensity_feature,
-    const bool use_constant_feature);
+    const bool use_constant_feature, const int num_threads = 1);
   ~FeatureGenerator() {}
 
   std::shared_ptr<FeatureMapInterface> generate(
@@ -56,6 +56,8 @@
 #include <tf2_geometry_msgs/tf2_geometry_msgs.hpp>
 #endif
 
+#include <algorithm>
+
 geometry_msgs::msg::Quaternion getQuaternionFromRPY(const double r, const double p, const double y)
 {
   tf2::Quaternion q;
@@ -63,7 +65,13 @@ geometry_msgs::msg::Quaternion getQuaternionFromRPY(const double r, const double
   return tf2::toMsg(q);
 }
 
-Cluster2D::Cluster2D(const int rows, const int cols, const float range)
+namespace
+{
+// the grid is united by tiles of rows, which are then merged along their borders
+constexpr int TILE_ROWS = 32;
+}  // namespace
+
+Cluster2D::Cluster2D(const int rows, const int cols, const float range, const int num_threads)
 {
   rows_ = rows;
   cols_ = cols;
@@ -76,28 +84,84 @@ Cluster2D::Cluster2D(const int rows, const int cols, const float range)
   id_img_.assign(siz_, -1);
   pc_ptr_.reset();
   valid_indices_in_pc_ = nullptr;
+  num_threads_ = std::max(num_threads, 1);
+
+  point_num_.assign(siz_, 0);
+  center_grid_.assign(siz_, 0);
+  is_object_.assign(siz_, false);
+  traversed_.assign(siz_, 0);
+  is_center_.assign(siz_, false);
+  cycle_root_.assign(siz_, 0);
+  center_parent_.assign(siz_, 0);
+  root_obstacle_id_.assign(siz_, -1);
 }
 
-void Cluster2D::traverse(Node * x)
+void Cluster2D::traverse(int grid)
 {
-  std::vector<Node *> p;
-  p.clear();
+  traverse_path_.clear();
 
-  while (x->traversed == 0) {
-    p.push_back(x);
-    x->traversed = 2;
-    x = x->center_node;
+  while (traversed_[grid] == 0) {
+    traverse_path_.push_back(grid);
+    traversed_[grid] = 2;
+    grid = center_grid_[grid];
   }
-  if (x->traversed == 2) {
-    for (int i = static_cast<int>(p.size()) - 1; i >= 0 && p[i] != x; i--) {
-      p[i]->is_center = true;
+  if (traversed_[grid] == 2) {
+    // the path closed a cycle, whose cells are centers
+    for (auto it = traverse_path_.rbegin(); it != traverse_path_.rend() && *it != grid; ++it) {
+      is_center_[*it] = true;
+      centers_.push_back(*it);
     }
-    x->is_center = true;
+    is_center_[grid] = true;
+    centers_.push_back(grid);
+    cycle_root_[grid] = grid;
+  }
+  const int root = cycle_root_[grid];
+  for (const int path_grid : traverse_path_) {
+    traversed_[path_grid] = 1;
+    cycle_root_[path_grid] = root;
+  }
+}
+
+int Cluster2D::findCenterRoot(int grid)
+{
+  // path halving
+  while (center_parent_[grid] != grid) {
+    center_parent_[grid] = center_parent_[center_parent_[grid]];
+    grid = center_parent_[grid];
+  }
+  return grid;
+}
+
+void Cluster2D::uniteCenterRoots(int grid1, int grid2)
+{
+  grid1 = findCenterRoot(grid1);
+  grid2 = findCenterRoot(grid2);
+  if (grid1 < grid2) {
+    center_parent_[grid2] = grid1;
+  } else if (grid2 < grid1) {
+    center_parent_[grid1] = grid2;
+  }
+}
+
+void Cluster2D::uniteCenters(const int row_begin, const int row_end)
+{
+  // only the cells of the rows are touched, so that tiles can be united concurrently
+  for (int grid = RowCol2Grid(row_begin, 0); grid < RowCol2Grid(row_end, 0); ++grid) {
+    center_parent_[grid] = grid;
   }
-  for (size_t i = 0; i < p.size(); i++) {
-    Node * y = p[i];
-    y->traversed = 1;
-    y->parent = x->parent;
+  for (int row = row_begin; row < row_end; ++row) {
+    for (int col = 0; col < cols_; ++col) {
+      const int grid = RowCol2Grid(row, col);
+      if (!is_center_[grid]) {
+        continue;
+      }
+      if (col + 1 < cols_ && is_center_[grid + 1]) {
+        uniteCenterRoots(grid, grid + 1);
+      }
+      if (row + 1 < row_end && is_center_[grid + cols_]) {
+        uniteCenterRoots(grid, grid + cols_);
+      }
+    }
   }
 }
 
@@ -112,10 +176,9 @@ void Cluster2D::cluster(
 
   pc_ptr_ = pc_ptr;
 
-  std::vector<std::vector<Node>> nodes(rows_, std::vector<Node>(cols_, Node()));
-
   valid_indices_in_pc_ = &(valid_indices.indices);
   point2grid_.assign(valid_indices_in_pc_->size(), -1);
+  std::fill(point_num_.begin(), point_num_.end(), 0);
 
   for (size_t i = 0; i < valid_indices_in_pc_->size(); ++i) {
     int point_id = valid_indices_in_pc_->at(i);
@@ -127,71 +190,67 @@ void Cluster2D::cluster(
     int pos_y = F2I(point.x, range_, inv_res_y_);  // row
     if (IsValidRowCol(pos_y, pos_x)) {
       point2grid_[i] = RowCol2Grid(pos_y, pos_x);
-      nodes[pos_y][pos_x].point_num++;
+      point_num_[point2grid_[i]]++;
     }
   }
 
+#pragma omp parallel for num_threads(num_threads_)
   for (int row = 0; row < rows_; ++row) {
     for (int col = 0; col < cols_; ++col) {
       int grid = RowCol2Grid(row, col);
-      Node * node = &nodes[row][col];
-      DisjointSetMakeSet(node);
-      node->is_object = (use_all_grids_for_clustering || nodes[row][col].point_num > 0) &&
-                        (*(category_pt_data + grid) >= objectness_thresh);
+      is_object_[grid] = (use_all_grids_for_clustering || point_num_[grid] > 0) &&
+                         (*(category_pt_data + grid) >= objectness_thresh);
       int center_row = std::round(row + instance_pt_x_data[grid] * scale_);
       int center_col = std::round(col + instance_pt_y_data[grid] * scale_);
       center_row = std::min(std::max(center_row, 0), rows_ - 1);
       center_col = std::min(std::max(center_col, 0), cols_ - 1);
-      node->center_node = &nodes[center_row][center_col];
+      center_grid_[grid] = RowCol2Grid(center_row, center_col);
+      traversed_[grid] = 0;
+      is_center_[grid] = false;
+      root_obstacle_id_[grid] = -1;
     }
   }
 
-  for (int row = 0; row < rows_; ++row) {
-    for (int col = 0; col < cols_; ++col) {
-      Node * node = &nodes[row][col];
-      if (node->is_object && node->traversed == 0) {
-        traverse(node);
-      }
+  centers_.clear();
+  for (int grid = 0; grid < siz_; ++grid) {
+    if (is_object_[grid] && traversed_[grid] == 0) {
+      traverse(grid);
     }
   }
 
-  for (int row = 0; row < rows_; ++row) {
+  // unite the adjacent centers by tiles, then along the borders of the tiles, and the centers
+  // on a same cycle
+  const int num_tiles = (rows_ + TILE_ROWS - 1) / TILE_ROWS;
+#pragma omp parallel for num_threads(num_threads_)
+  for (int tile = 0; tile < num_tiles; ++tile) {
+    uniteCenters(tile * TILE_ROWS, std::min((tile + 1) * TILE_ROWS, rows_));
+  }
+  for (int row = TILE_ROWS; row < rows_; row += TILE_ROWS) {
     for (int col = 0; col < cols_; ++col) {
-      Node * node = &nodes[row][col];
-      if (!node->is_center) {
-        continue;
-      }
-      for (int row2 = row - 1; row2 <= row + 1; ++row2) {
-        for (int col2 = col - 1; col2 <= col + 1; ++col2) {
-          if ((row2 == row || col2 == col) && IsValidRowCol(row2, col2)) {
-            Node * node2 = &nodes[row2][col2];
-            if (node2->is_center) {
-              DisjointSetUnion(node, node2);
-            }
-          }
-        }
+      const int grid = RowCol2Grid(row, col);
+      if (is_center_[grid] && is_center_[grid - cols_]) {
+        uniteCenterRoots(grid, grid - cols_);
       }
     }
   }
+  for (const int grid : centers_) {
+    uniteCenterRoots(grid, cycle_root_[grid]);
+  }
 
   int count_obstacles = 0;
   obstacles_.clear();
-  id_img_.assign(siz_, -1);
-  for (int row = 0; row < rows_; ++row) {
-    for (int col = 0; col < cols_; ++col) {
-      Node * node = &nodes[row][col];
-      if (!node->is_object) {
-        continue;
-      }
-      Node * root = DisjointSetFind(node);
-      if (root->obstacle_id < 0) {
-        root->obstacle_id = count_obstacles++;
-        obstacles_.push_back(Obstacle());
-      }
-      int grid = RowCol2Grid(row, col);
-      id_img_[grid] = root->obstacle_id;
-      obstacles_[root->obstacle_id].grids.push_back(grid);
+  std::fill(id_img_.begin(), id_img_.end(), -1);
+  for (int grid = 0; grid < siz_; ++grid) {
+    if (!is_object_[grid]) {
+      continue;
+    }
+    const int root = findCenterRoot(cycle_root_[grid]);
+    if (root_obstacle_id_[root] < 0) {
+      root_obstacle_id_[root] = count_obstacles++;
+      obstacles_.push_back(Obstacle());
     }
+    id_img_[grid] = root_obstacle_id_[root];
+    obstacles_[root_obstacle_id_[root]].grids.push_back(grid);
   }
   filter(inferred_data);
   classify(inferred_data);
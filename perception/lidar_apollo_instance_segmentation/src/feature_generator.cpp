@@ -16,6 +16,10 @@
 
 #include "lidar_apollo_instance_segmentation/log_table.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
 namespace
 {
 inline float normalizeIntensity(float intensity) { return intensity / 255.0f; }
@@ -23,11 +27,12 @@ inline float normalizeIntensity(float intensity) { return intensity / 255.0f; }
 
 FeatureGenerator::FeatureGenerator(
   const int width, const int height, const int range, const bool use_intensity_feature,
-  const bool use_constant_feature)
+  const bool use_constant_feature, const int num_threads)
 : min_height_(-5.0),
   max_height_(5.0),
   use_intensity_feature_(use_intensity_feature),
-  use_constant_feature_(use_constant_feature)
+  use_constant_feature_(use_constant_feature),
+  num_threads_(std::max(num_threads, 1))
 {
   // select feature map type
   if (use_constant_feature && use_intensity_feature) {
@@ -53,32 +58,68 @@ std::shared_ptr<FeatureMapInterface> FeatureGenerator::generate(
   const float inv_res_x = 0.5 * map_ptr_->width / map_ptr_->range;
   const float inv_res_y = 0.5 * map_ptr_->height / map_ptr_->range;
 
-  for (size_t i = 0; i < pc_ptr->points.size(); ++i) {
-    if (pc_ptr->points[i].z <= min_height_ || max_height_ <= pc_ptr->points[i].z) {
+  const auto & points = pc_ptr->points;
+  point_cells_.resize(points.size());
+#pragma omp parallel for num_threads(num_threads_)
+  for (size_t i = 0; i < points.size(); ++i) {
+    point_cells_[i] = -1;
+    if (points[i].z <= min_height_ || max_height_ <= points[i].z) {
       continue;
     }
 
-    const int pos_x = std::floor((map_ptr_->range - pc_ptr->points[i].y) * inv_res_x);  // x on grid
-    const int pos_y = std::floor((map_ptr_->range - pc_ptr->points[i].x) * inv_res_y);  // y on grid
+    const int pos_x = std::floor((map_ptr_->range - points[i].y) * inv_res_x);  // x on grid
+    const int pos_y = std::floor((map_ptr_->range - points[i].x) * inv_res_y);  // y on grid
     if (pos_x < 0 || map_ptr_->width <= pos_x || pos_y < 0 || map_ptr_->height <= pos_y) {
       continue;
     }
 
-    const int idx = pos_y * map_ptr_->width + pos_x;
+    point_cells_[i] = pos_y * map_ptr_->width + pos_x;
+  }
 
-    if (map_ptr_->max_height_data[idx] < pc_ptr->points[i].z) {
-      map_ptr_->max_height_data[idx] = pc_ptr->points[i].z;
-      if (map_ptr_->top_intensity_data != nullptr) {
-        map_ptr_->top_intensity_data[idx] = normalizeIntensity(pc_ptr->points[i].intensity);
-      }
+  // each band of cells takes its points in order, so that the map does not depend on the number
+  // of threads; the points are denser around the sensor, hence more bands than threads.
+  // the points are counting-sorted by band once, a stable sort keeps their order in each band
+  const int num_bands = num_threads_ > 1 ? 4 * num_threads_ : 1;
+  const auto toBand = [&](const int idx) {
+    return static_cast<size_t>(static_cast<int64_t>(idx) * num_bands / size);
+  };
+  band_offsets_.assign(num_bands + 1, 0);
+  for (const int idx : point_cells_) {
+    if (0 <= idx) {
+      ++band_offsets_[toBand(idx) + 1];
+    }
+  }
+  for (int band = 0; band < num_bands; ++band) {
+    band_offsets_[band + 1] += band_offsets_[band];
+  }
+  band_points_.resize(band_offsets_.back());
+  std::vector<size_t> band_ends(band_offsets_.begin(), band_offsets_.end() - 1);
+  for (size_t i = 0; i < points.size(); ++i) {
+    if (0 <= point_cells_[i]) {
+      band_points_[band_ends[toBand(point_cells_[i])]++] = i;
     }
-    map_ptr_->mean_height_data[idx] += static_cast<float>(pc_ptr->points[i].z);
-    if (map_ptr_->mean_intensity_data != nullptr) {
-      map_ptr_->mean_intensity_data[idx] += normalizeIntensity(pc_ptr->points[i].intensity);
+  }
+
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic)
+  for (int band = 0; band < num_bands; ++band) {
+    for (size_t k = band_offsets_[band]; k < band_offsets_[band + 1]; ++k) {
+      const size_t i = band_points_[k];
+      const int idx = point_cells_[i];
+      if (map_ptr_->max_height_data[idx] < points[i].z) {
+        map_ptr_->max_height_data[idx] = points[i].z;
+        if (map_ptr_->top_intensity_data != nullptr) {
+          map_ptr_->top_intensity_data[idx] = normalizeIntensity(points[i].intensity);
+        }
+      }
+      map_ptr_->mean_height_data[idx] += static_cast<float>(points[i].z);
+      if (map_ptr_->mean_intensity_data != nullptr) {
+        map_ptr_->mean_intensity_data[idx] += normalizeIntensity(points[i].intensity);
+      }
+      map_ptr_->count_data[idx] += 1.0f;
     }
-    map_ptr_->count_data[idx] += 1.0f;
   }
 
+#pragma omp parallel for num_threads(num_threads_)
   for (int i = 0; i < size; ++i) {
     if (map_ptr_->count_data[i] < epsilon) {
       map_ptr_->max_height_data[i] = 0.0f;
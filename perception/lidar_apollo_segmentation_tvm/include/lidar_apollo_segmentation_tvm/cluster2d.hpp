@@ -16,7 +16,6 @@
 #define LIDAR_APOLLO_SEGMENTATION_TVM__CLUSTER2D_HPP_
 
 #include <common/types.hpp>
-#include <lidar_apollo_segmentation_tvm/disjoint_set.hpp>
 #include <lidar_apollo_segmentation_tvm/util.hpp>
 #include <lidar_apollo_segmentation_tvm/visibility_control.hpp>
 
@@ -78,7 +77,8 @@ public:
   /// \param[in] rows The number of rows in the cluster.
   /// \param[in] cols The number of columns in the cluster.
   /// \param[in] range Scaling factor.
-  explicit Cluster2D(int32_t rows, int32_t cols, float32_t range);
+  /// \param[in] num_threads The number of threads clustering the grid.
+  explicit Cluster2D(int32_t rows, int32_t cols, float32_t range, int32_t num_threads = 1);
 
   /// \brief Construct a directed graph and search the connected components for candidate object
   ///        clusters.
@@ -123,6 +123,7 @@ private:
   const float32_t scale_;
   const float32_t inv_res_x_;
   const float32_t inv_res_y_;
+  const int32_t num_threads_;
   std::vector<int32_t> point2grid_;
   std::vector<Obstacle> obstacles_;
   std::vector<int32_t> id_img_;
@@ -130,30 +131,21 @@ private:
   pcl::PointCloud<pcl::PointXYZI>::ConstPtr pc_ptr_;
   const std::vector<int32_t> * valid_indices_in_pc_ = nullptr;
 
-  /// \brief Node of a directed graph.
-  struct Node
-  {
-    Node * center_node;
-    Node * parent;
-    char8_t node_rank;
-    char8_t traversed;
-    bool8_t is_center;
-    bool8_t is_object;
-    int32_t point_num;
-    int32_t obstacle_id;
-
-    Node()
-    {
-      center_node = nullptr;
-      parent = nullptr;
-      node_rank = 0;
-      traversed = 0;
-      is_center = false;
-      is_object = false;
-      point_num = 0;
-      obstacle_id = -1;
-    }
-  };
+  /// \brief Grids of rows_ * cols_ cells, reused from a frame to the next.
+  std::vector<int32_t> point_num_;
+  std::vector<int32_t> center_grid_;
+  std::vector<char8_t> is_object_;
+  /// \brief 0 for the cells not visited yet, 1 for the visited ones, 2 for the ones on the path
+  ///        being traversed.
+  std::vector<char8_t> traversed_;
+  std::vector<char8_t> is_center_;
+  /// \brief The center on the cycle which a cell leads to.
+  std::vector<int32_t> cycle_root_;
+  /// \brief Union-find over the center cells, whose root is the first cell of each set.
+  std::vector<int32_t> center_parent_;
+  std::vector<int32_t> root_obstacle_id_;
+  std::vector<int32_t> centers_;
+  std::vector<int32_t> traverse_path_;
 
   /// \brief Check whether a signed row and column values are valid array indices.
   inline bool IsValidRowCol(int32_t row, int32_t col) const
@@ -170,9 +162,20 @@ private:
   /// \brief Transform a row and column coordinate to a linear grid index.
   inline int32_t RowCol2Grid(int32_t row, int32_t col) const { return row * cols_ + col; }
 
-  /// \brief Traverse the directed graph until visiting a node.
-  /// \param[in] x Node to visit.
-  void traverse(Node * x) const;
+  /// \brief Traverse the directed graph until visiting a cell.
+  /// \param[in] grid Cell to visit.
+  void traverse(int32_t grid);
+
+  /// \brief Unite the adjacent centers of rows, touching only the cells of the rows.
+  /// \param[in] row_begin First row.
+  /// \param[in] row_end Row past the last one.
+  void uniteCenters(int32_t row_begin, int32_t row_end);
+
+  /// \brief Find the root of the set of a center, halving the path to it.
+  int32_t findCenterRoot(int32_t grid);
+
+  /// \brief Unite the sets of two centers.
+  void uniteCenterRoots(int32_t grid1, int32_t grid2);
 };
 }  // namespace lidar_apollo_segmentation_tvm
 }  // namespace perception
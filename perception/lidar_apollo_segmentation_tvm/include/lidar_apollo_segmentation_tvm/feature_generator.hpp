@@ -26,6 +26,7 @@
 #include <pcl/point_types.h>
 
 #include <memory>
+#include <vector>
 
 namespace autoware
 {
@@ -45,6 +46,9 @@ private:
   const float32_t min_height_;
   const float32_t max_height_;
   std::shared_ptr<FeatureMapInterface> map_ptr_;
+  const int32_t num_threads_;
+  /// \brief The cell of each point, -1 for the points out of the map.
+  std::vector<int32_t> point_cells_;
 
 public:
   /// \brief Constructor
@@ -55,9 +59,11 @@ public:
   /// \param[in] use_constant_feature Enable input channel constant feature.
   /// \param[in] min_height The minimum height.
   /// \param[in] max_height The maximum height.
+  /// \param[in] num_threads The number of threads generating the FeatureMap.
   explicit FeatureGenerator(
     int32_t width, int32_t height, int32_t range, bool8_t use_intensity_feature,
-    bool8_t use_constant_feature, float32_t min_height, float32_t max_height);
+    bool8_t use_constant_feature, float32_t min_height, float32_t max_height,
+    int32_t num_threads = 1);
 
   /// \brief Generate a FeatureMap based on the configured features of this object.
   /// \param[in] pc_ptr Pointcloud used to populate the generated FeatureMap.
@@ -64,10 +64,11 @@ public:
   /// \param[in] use_constant_feature Enable input channel constant feature.
   /// \param[in] min_height The minimum height.
   /// \param[in] max_height The maximum height.
+  /// \param[in] num_threads The number of threads generating the feature map.
   explicit ApolloLidarSegmentationPreProcessor(
     const tvm_utility::pipeline::InferenceEngineTVMConfig & config, int32_t range,
     bool8_t use_intensity_feature, bool8_t use_constant_feature, float32_t min_height,
-    float32_t max_height);
+    float32_t max_height, int32_t num_threads = 1);
 
   /// \brief Transfer the input data to a TVM array.
   /// \param[in] pc_ptr Input pointcloud.
@@ -100,11 +101,12 @@ public:
   /// \param[in] height_thresh If it is non-negative, the points that are higher than the predicted
   ///                          object height by height_thresh are filtered out.
   /// \param[in] min_pts_num The candidate clusters with less than min_pts_num points are removed.
+  /// \param[in] num_threads The number of threads clustering the grid.
   explicit ApolloLidarSegmentationPostProcessor(
     const tvm_utility::pipeline::InferenceEngineTVMConfig & config,
     const pcl::PointCloud<pcl::PointXYZI>::ConstPtr & pc_ptr, int32_t range,
     float32_t objectness_thresh, float32_t score_threshold, float32_t height_thresh,
-    int32_t min_pts_num);
+    int32_t min_pts_num, int32_t num_threads = 1);
 
   /// \brief Copy the inference result.
   /// \param[in] input The result of the inference engine.
@@ -144,10 +146,13 @@ public:
   /// \param[in] height_thresh If it is non-negative, the points that are higher than the predicted
   ///                          object height by height_thresh are filtered out in the
   ///                          post-processing step.
+  /// \param[in] num_threads The number of threads generating the feature map and clustering the
+  ///                        grid.
   explicit ApolloLidarSegmentation(
     int32_t range, float32_t score_threshold, bool8_t use_intensity_feature,
     bool8_t use_constant_feature, float32_t z_offset, float32_t min_height, float32_t max_height,
-    float32_t objectness_thresh, int32_t min_pts_num, float32_t height_thresh);
+    float32_t objectness_thresh, int32_t min_pts_num, float32_t height_thresh,
+    int32_t num_threads = 1);
 
   /// \brief Detect obstacles.
   /// \param[in] input Input pointcloud.
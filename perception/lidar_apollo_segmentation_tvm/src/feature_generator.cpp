@@ -16,6 +16,7 @@
 #include <lidar_apollo_segmentation_tvm/feature_generator.hpp>
 #include <lidar_apollo_segmentation_tvm/log_table.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -37,11 +38,12 @@ inline float32_t normalizeIntensity(float32_t intensity) { return intensity / 25
 FeatureGenerator::FeatureGenerator(
   const int32_t width, const int32_t height, const int32_t range,
   const bool8_t use_intensity_feature, const bool8_t use_constant_feature,
-  const float32_t min_height, const float32_t max_height)
+  const float32_t min_height, const float32_t max_height, const int32_t num_threads)
 : use_intensity_feature_(use_intensity_feature),
   use_constant_feature_(use_constant_feature),
   min_height_(min_height),
-  max_height_(max_height)
+  max_height_(max_height),
+  num_threads_(std::max(num_threads, 1))
 {
   // select feature map type
   if (use_constant_feature && use_intensity_feature) {
@@ -67,36 +69,56 @@ std::shared_ptr<FeatureMapInterface> FeatureGenerator::generate(
   const float32_t inv_res_x = 0.5f * map_ptr_->width / map_ptr_->range;
   const float32_t inv_res_y = 0.5f * map_ptr_->height / map_ptr_->range;
 
-  for (size_t i = 0; i < pc_ptr->points.size(); ++i) {
-    if (pc_ptr->points[i].z <= min_height_ || max_height_ <= pc_ptr->points[i].z) {
+  const auto & points = pc_ptr->points;
+  point_cells_.resize(points.size());
+#pragma omp parallel for num_threads(num_threads_)
+  for (size_t i = 0; i < points.size(); ++i) {
+    point_cells_[i] = -1;
+    if (points[i].z <= min_height_ || max_height_ <= points[i].z) {
       continue;
     }
 
     // x on grid
     const int32_t pos_x = static_cast<int32_t>(
-      std::floor((static_cast<float32_t>(map_ptr_->range) - pc_ptr->points[i].y) * inv_res_x));
+      std::floor((static_cast<float32_t>(map_ptr_->range) - points[i].y) * inv_res_x));
     // y on grid
     const int32_t pos_y = static_cast<int32_t>(
-      std::floor((static_cast<float32_t>(map_ptr_->range) - pc_ptr->points[i].x) * inv_res_y));
+      std::floor((static_cast<float32_t>(map_ptr_->range) - points[i].x) * inv_res_y));
     if (pos_x < 0 || map_ptr_->width <= pos_x || pos_y < 0 || map_ptr_->height <= pos_y) {
       continue;
     }
 
-    const int32_t idx = pos_y * map_ptr_->width + pos_x;
+    point_cells_[i] = pos_y * map_ptr_->width + pos_x;
+  }
 
-    if (map_ptr_->max_height_data[idx] < pc_ptr->points[i].z) {
-      map_ptr_->max_height_data[idx] = pc_ptr->points[i].z;
-      if (map_ptr_->top_intensity_data != nullptr) {
-        map_ptr_->top_intensity_data[idx] = normalizeIntensity(pc_ptr->points[i].intensity);
+  // each band of cells scans the points in order, so that the map does not depend on the number
+  // of threads; the points are denser around the sensor, hence more bands than threads
+  const int32_t num_bands = num_threads_ > 1 ? 4 * num_threads_ : 1;
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic)
+  for (int32_t band = 0; band < num_bands; ++band) {
+    const int32_t cell_begin = size * band / num_bands;
+    const int32_t cell_end = size * (band + 1) / num_bands;
+    for (size_t i = 0; i < points.size(); ++i) {
+      const int32_t idx = point_cells_[i];
+      if (idx < cell_begin || cell_end <= idx) {
+        continue;
       }
+
+      if (map_ptr_->max_height_data[idx] < points[i].z) {
+        map_ptr_->max_height_data[idx] = points[i].z;
+        if (map_ptr_->top_intensity_data != nullptr) {
+          map_ptr_->top_intensity_data[idx] = normalizeIntensity(points[i].intensity);
+        }
+      }
+      map_ptr_->mean_height_data[idx] += points[i].z;
+      if (map_ptr_->mean_intensity_data != nullptr) {
+        map_ptr_->mean_intensity_data[idx] += normalizeIntensity(points[i].intensity);
+      }
+      map_ptr_->count_data[idx] += 1.0f;
     }
-    map_ptr_->mean_height_data[idx] += pc_ptr->points[i].z;
-    if (map_ptr_->mean_intensity_data != nullptr) {
-      map_ptr_->mean_intensity_data[idx] += normalizeIntensity(pc_ptr->points[i].intensity);
-    }
-    map_ptr_->count_data[idx] += 1.0f;
   }
 
+#pragma omp parallel for num_threads(num_threads_)
   for (int32_t i = 0; i < size; ++i) {
     if (static_cast<float64_t>(map_ptr_->count_data[i]) < epsilon) {
       map_ptr_->max_height_data[i] = 0.0f;
@@ -35,14 +35,14 @@ namespace lidar_apollo_segmentation_tvm
 ApolloLidarSegmentationPreProcessor::ApolloLidarSegmentationPreProcessor(
   const tvm_utility::pipeline::InferenceEngineTVMConfig & config, int32_t range,
   bool8_t use_intensity_feature, bool8_t use_constant_feature, float32_t min_height,
-  float32_t max_height)
+  float32_t max_height, int32_t num_threads)
 : input_channels(config.network_inputs[0].node_shape[1]),
   input_width(config.network_inputs[0].node_shape[2]),
   input_height(config.network_inputs[0].node_shape[3]),
   input_datatype_bytes(config.network_inputs[0].tvm_dtype_bits / 8),
   feature_generator(std::make_shared<FeatureGenerator>(
     input_width, input_height, range, use_intensity_feature, use_constant_feature, min_height,
-    max_height))
+    max_height, num_threads))
 {
   // Allocate input variable
   std::vector<int64_t> shape_x{1, input_channels, input_width, input_height};
@@ -77,7 +77,7 @@ ApolloLidarSegmentationPostProcessor::ApolloLidarSegmentationPostProcessor(
   const tvm_utility::pipeline::InferenceEngineTVMConfig & config,
   const pcl::PointCloud<pcl::PointXYZI>::ConstPtr & pc_ptr, int32_t range,
   float32_t objectness_thresh, float32_t score_threshold, float32_t height_thresh,
-  int32_t min_pts_num)
+  int32_t min_pts_num, int32_t num_threads)
 : output_channels(config.network_outputs[0].node_shape[1]),
   output_width(config.network_outputs[0].node_shape[2]),
   output_height(config.network_outputs[0].node_shape[3]),
@@ -87,7 +87,7 @@ ApolloLidarSegmentationPostProcessor::ApolloLidarSegmentationPostProcessor(
   height_thresh_(height_thresh),
   min_pts_num_(min_pts_num),
   pc_ptr_(pc_ptr),
-  cluster2d_(std::make_shared<Cluster2D>(output_width, output_height, range))
+  cluster2d_(std::make_shared<Cluster2D>(output_width, output_height, range, num_threads))
 {
 }
 
@@ -111,7 +111,8 @@ std::shared_ptr<DetectedObjectsWithFeature> ApolloLidarSegmentationPostProcessor
 ApolloLidarSegmentation::ApolloLidarSegmentation(
   int32_t range, float32_t score_threshold, bool8_t use_intensity_feature,
   bool8_t use_constant_feature, float32_t z_offset, float32_t min_height, float32_t max_height,
-  float32_t objectness_thresh, int32_t min_pts_num, float32_t height_thresh)
+  float32_t objectness_thresh, int32_t min_pts_num, float32_t height_thresh,
+  int32_t num_threads)
 : range_(range),
   score_threshold_(score_threshold),
   z_offset_(z_offset),
@@ -120,11 +121,12 @@ ApolloLidarSegmentation::ApolloLidarSegmentation(
   height_thresh_(height_thresh),
   pcl_pointcloud_ptr_(new pcl::PointCloud<pcl::PointXYZI>),
   PreP(std::make_shared<PrePT>(
-    config, range, use_intensity_feature, use_constant_feature, min_height, max_height)),
+    config, range, use_intensity_feature, use_constant_feature, min_height, max_height,
+    num_threads)),
   IE(std::make_shared<IET>(config, "lidar_apollo_segmentation_tvm")),
   PostP(std::make_shared<PostPT>(
     config, pcl_pointcloud_ptr_, range, objectness_thresh, score_threshold, height_thresh,
-    min_pts_num)),
+    min_pts_num, num_threads)),
   pipeline(
     std::make_shared<tvm_utility::pipeline::Pipeline<PrePT, IET, PostPT>>(*PreP, *IE, *PostP))
 {
@@ -49,7 +49,8 @@ ApolloLidarSegmentationNode::ApolloLidarSegmentationNode(const rclcpp::NodeOptio
     declare_parameter("max_height", rclcpp::ParameterValue{5.0}).get<float32_t>(),
     declare_parameter("objectness_thresh", rclcpp::ParameterValue{0.5}).get<float32_t>(),
     declare_parameter("min_pts_num", rclcpp::ParameterValue{3}).get<int32_t>(),
-    declare_parameter("height_thresh", rclcpp::ParameterValue{0.5}).get<float32_t>())}
+    declare_parameter("height_thresh", rclcpp::ParameterValue{0.5}).get<float32_t>(),
+    declare_parameter("num_threads", rclcpp::ParameterValue{1}).get<int32_t>())}
 {
   // Log unexpected versions of the neural network.
   auto version_status = m_detector_ptr->version_check();
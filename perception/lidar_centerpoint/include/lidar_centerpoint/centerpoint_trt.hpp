@@ -19,6 +19,7 @@
 #include <lidar_centerpoint/network/network_trt.hpp>
 #include <lidar_centerpoint/postprocess/postprocess_kernel.hpp>
 #include <lidar_centerpoint/preprocess/voxel_generator.hpp>
+#include <lidar_centerpoint/preprocess/voxel_generator_cuda.hpp>
 
 #include <sensor_msgs/msg/point_cloud2.hpp>
 
@@ -55,9 +56,11 @@ private:
 class CenterPointTRT
 {
 public:
+  // With use_gpu_preprocess, the point clouds are voxelized on the device instead of the host.
   explicit CenterPointTRT(
     const NetworkParam & encoder_param, const NetworkParam & head_param,
-    const DensificationParam & densification_param, const CenterPointConfig & config);
+    const DensificationParam & densification_param, const CenterPointConfig & config,
+    const bool use_gpu_preprocess = false);
 
   ~CenterPointTRT();
 
@@ -76,6 +79,7 @@ protected:
   void postProcess(std::vector<Box3D> & det_boxes3d);
 
   std::unique_ptr<VoxelGeneratorTemplate> vg_ptr_{nullptr};
+  std::unique_ptr<VoxelGeneratorCUDA> vg_cuda_ptr_{nullptr};
   std::unique_ptr<VoxelEncoderTRT> encoder_trt_ptr_{nullptr};
   std::unique_ptr<HeadTRT> head_trt_ptr_{nullptr};
   std::unique_ptr<PostProcessCUDA> post_proc_ptr_{nullptr};
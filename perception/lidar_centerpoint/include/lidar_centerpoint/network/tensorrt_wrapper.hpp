@@ -58,9 +58,8 @@ private:
 
   bool createContext();
 
-  tensorrt_common::TrtUniquePtr<nvinfer1::IRuntime> runtime_{nullptr};
   tensorrt_common::TrtUniquePtr<nvinfer1::IHostMemory> plan_{nullptr};
-  tensorrt_common::TrtUniquePtr<nvinfer1::ICudaEngine> engine_{nullptr};
+  std::shared_ptr<nvinfer1::ICudaEngine> engine_{nullptr};
 };
 
 }  // namespace centerpoint
@@ -23,9 +23,10 @@
 #include <tf2_sensor_msgs/tf2_sensor_msgs.hpp>
 #endif
 
-#include <list>
+#include <cstddef>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace centerpoint
 {
@@ -52,34 +53,39 @@ struct PointCloudWithTransform
   Eigen::Affine3f affine_past2world;
 };
 
+// Keeps the current point cloud and the past ones in a ring of pointcloud_cache_size slots. A
+// point cloud is copied into the slot of the oldest one, reusing its storage, so that no memory
+// is allocated once the ring is full.
 class PointCloudDensification
 {
 public:
-  explicit PointCloudDensification(const DensificationParam & param);
+  // without cache_points, only the headers are kept, for a user which keeps the points itself
+  explicit PointCloudDensification(const DensificationParam & param, bool cache_points = true);
 
   bool enqueuePointCloud(
     const sensor_msgs::msg::PointCloud2 & input_pointcloud_msg, const tf2_ros::Buffer & tf_buffer);
 
   double getCurrentTimestamp() const { return current_timestamp_; }
   Eigen::Affine3f getAffineWorldToCurrent() const { return affine_world2current_; }
-  std::list<PointCloudWithTransform>::iterator getPointCloudCacheIter()
+  // the number of cached point clouds
+  std::size_t getCacheSize() const { return cache_size_; }
+  // the i-th cached point cloud, from the current one (i = 0) to the oldest one
+  const PointCloudWithTransform & getPointCloudCache(const std::size_t i) const
   {
-    return pointcloud_cache_.begin();
-  }
-  bool isCacheEnd(std::list<PointCloudWithTransform>::iterator iter)
-  {
-    return iter == pointcloud_cache_.end();
+    return pointcloud_cache_[(cache_head_ + i) % pointcloud_cache_.size()];
   }
   unsigned int pointcloud_cache_size() const { return param_.pointcloud_cache_size(); }
 
 private:
   void enqueue(const sensor_msgs::msg::PointCloud2 & msg, const Eigen::Affine3f & affine);
-  void dequeue();
 
   DensificationParam param_;
+  bool cache_points_{true};
   double current_timestamp_{0.0};
   Eigen::Affine3f affine_world2current_;
-  std::list<PointCloudWithTransform> pointcloud_cache_;
+  std::vector<PointCloudWithTransform> pointcloud_cache_;
+  std::size_t cache_head_{0};
+  std::size_t cache_size_{0};
 };
 
 }  // namespace centerpoint
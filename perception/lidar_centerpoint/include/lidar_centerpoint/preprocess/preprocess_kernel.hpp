@@ -15,11 +15,36 @@
 #ifndef LIDAR_CENTERPOINT__PREPROCESS__PREPROCESS_KERNEL_HPP_
 #define LIDAR_CENTERPOINT__PREPROCESS__PREPROCESS_KERNEL_HPP_
 
+#include <lidar_centerpoint/centerpoint_config.hpp>
+
 #include <cuda.h>
 #include <cuda_runtime_api.h>
 
+#include <cstdint>
+
 namespace centerpoint
 {
+// row-major 3x4 affine transform taking the points to the current frame
+struct PointTransform
+{
+  float matrix[12];
+};
+
+// Voxelize the points [begin, end) of a raw PointCloud2 buffer on the device, appending to the
+// voxels generated since cell_to_voxel was cleared to -1 and num_voxels to 0. A voxel is assigned
+// to each grid cell the first time a point falls in it, while there are less than max_voxel_size.
+// num_points_per_voxel keeps counting past max_point_in_voxel_size until clampNumPointsPerVoxel.
+cudaError_t generateVoxels_launch(
+  const std::uint8_t * points, const std::size_t begin, const std::size_t end,
+  const std::size_t point_step, const std::size_t x_offset, const std::size_t y_offset,
+  const std::size_t z_offset, const PointTransform & transform, const float time_lag,
+  const CenterPointConfig & config, int * cell_to_voxel, unsigned int * num_voxels,
+  int * coordinates, float * voxels, float * num_points_per_voxel, cudaStream_t stream);
+
+cudaError_t clampNumPointsPerVoxel_launch(
+  const std::size_t max_voxel_size, const std::size_t max_point_in_voxel_size,
+  float * num_points_per_voxel, cudaStream_t stream);
+
 cudaError_t generateFeatures_launch(
   const float * voxel_features, const float * voxel_num_points, const int * coords,
   const std::size_t num_voxels, const std::size_t max_voxel_size, const float voxel_size_x,
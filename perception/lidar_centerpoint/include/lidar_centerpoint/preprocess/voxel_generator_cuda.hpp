@@ -0,0 +1,88 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIDAR_CENTERPOINT__PREPROCESS__VOXEL_GENERATOR_CUDA_HPP_
+#define LIDAR_CENTERPOINT__PREPROCESS__VOXEL_GENERATOR_CUDA_HPP_
+
+#include <lidar_centerpoint/centerpoint_config.hpp>
+#include <lidar_centerpoint/cuda_utils.hpp>
+#include <lidar_centerpoint/preprocess/pointcloud_densification.hpp>
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <cuda_runtime_api.h>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace centerpoint
+{
+// Voxelizes the densified point clouds on the device. Each point cloud is uploaded once, when it
+// is enqueued, and stays on the device while it is in the densification cache. The upload goes
+// through two pinned staging buffers on its own stream, so that copying a chunk overlaps the
+// voxelization of the previous one.
+class VoxelGeneratorCUDA
+{
+public:
+  explicit VoxelGeneratorCUDA(const DensificationParam & param, const CenterPointConfig & config);
+
+  ~VoxelGeneratorCUDA();
+
+  bool enqueuePointCloud(
+    const sensor_msgs::msg::PointCloud2 & input_pointcloud_msg, const tf2_ros::Buffer & tf_buffer);
+
+  // current_pointcloud_msg is the point cloud last enqueued, uploaded during the voxelization
+  // voxels (float): (max_voxel_size * max_point_in_voxel_size * point_feature_size)
+  // coordinates (int): (max_voxel_size * point_dim_size)
+  // num_points_per_voxel (float): (max_voxel_size)
+  // are device buffers written on stream, which is synchronized before returning
+  std::size_t pointsToVoxels(
+    const sensor_msgs::msg::PointCloud2 & current_pointcloud_msg, float * voxels, int * coordinates,
+    float * num_points_per_voxel, cudaStream_t stream);
+
+private:
+  struct DevicePointCloud
+  {
+    cuda::unique_ptr<std::uint8_t[]> data{nullptr};
+    std::size_t capacity{0};
+    std::size_t num_points{0};
+    std::size_t point_step{0};
+    std::size_t x_offset{0};
+    std::size_t y_offset{0};
+    std::size_t z_offset{0};
+    bool is_uploaded{false};
+  };
+
+  // keeps the headers and the transforms, the points only stay on the device
+  std::unique_ptr<PointCloudDensification> pd_ptr_{nullptr};
+  // a ring in the same order as the densification cache, the current point cloud at the head
+  std::vector<DevicePointCloud> device_cache_;
+  std::size_t device_cache_head_{0};
+
+  CenterPointConfig config_;
+  std::size_t grid_size_{0};
+  cuda::unique_ptr<int[]> cell_to_voxel_d_{nullptr};
+  cuda::unique_ptr<unsigned int> num_voxels_d_{nullptr};
+  cuda::unique_ptr_host<unsigned int> num_voxels_h_{nullptr};
+
+  cudaStream_t copy_stream_{nullptr};
+  std::array<cuda::unique_ptr_host<std::uint8_t[]>, 2> staging_buffers_;
+  std::array<cudaEvent_t, 2> copy_done_events_{};
+};
+
+}  // namespace centerpoint
+
+#endif  // LIDAR_CENTERPOINT__PREPROCESS__VOXEL_GENERATOR_CUDA_HPP_
@@ -19,6 +19,7 @@
 #include <lidar_centerpoint/preprocess/preprocess_kernel.hpp>
 #include <tier4_autoware_utils/math/constants.hpp>
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -28,10 +29,14 @@ namespace centerpoint
 {
 CenterPointTRT::CenterPointTRT(
   const NetworkParam & encoder_param, const NetworkParam & head_param,
-  const DensificationParam & densification_param, const CenterPointConfig & config)
+  const DensificationParam & densification_param, const CenterPointConfig & config,
+  const bool use_gpu_preprocess)
 : config_(config)
 {
   vg_ptr_ = std::make_unique<VoxelGenerator>(densification_param, config_);
+  if (use_gpu_preprocess) {
+    vg_cuda_ptr_ = std::make_unique<VoxelGeneratorCUDA>(densification_param, config_);
+  }
   post_proc_ptr_ = std::make_unique<PostProcessCUDA>(config_);
 
   // encoder
@@ -56,7 +61,11 @@ CenterPointTRT::CenterPointTRT(
 
   initPtr();
 
-  cudaStreamCreate(&stream_);
+  // the detection of the lidar goes first when the GPU is shared with the camera networks
+  int least_priority{0};
+  int greatest_priority{0};
+  cudaDeviceGetStreamPriorityRange(&least_priority, &greatest_priority);
+  cudaStreamCreateWithPriority(&stream_, cudaStreamDefault, greatest_priority);
 }
 
 CenterPointTRT::~CenterPointTRT()
@@ -79,10 +88,12 @@ void CenterPointTRT::initPtr()
     config_.grid_size_x_ * config_.grid_size_y_ * config_.encoder_out_feature_size_;
   const auto grid_xy_size = config_.down_grid_size_x_ * config_.down_grid_size_y_;
 
-  // host
-  voxels_.resize(voxels_size);
-  coordinates_.resize(coordinates_size);
-  num_points_per_voxel_.resize(config_.max_voxel_size_);
+  // host, only used when voxelizing on the host
+  if (!vg_cuda_ptr_) {
+    voxels_.resize(voxels_size, 0);
+    coordinates_.resize(coordinates_size, -1);
+    num_points_per_voxel_.resize(config_.max_voxel_size_, 0);
+  }
 
   // device
   voxels_d_ = cuda::make_unique<float[]>(voxels_size);
@@ -103,9 +114,13 @@ bool CenterPointTRT::detect(
   const sensor_msgs::msg::PointCloud2 & input_pointcloud_msg, const tf2_ros::Buffer & tf_buffer,
   std::vector<Box3D> & det_boxes3d)
 {
-  std::fill(voxels_.begin(), voxels_.end(), 0);
-  std::fill(coordinates_.begin(), coordinates_.end(), -1);
-  std::fill(num_points_per_voxel_.begin(), num_points_per_voxel_.end(), 0);
+  if (!vg_cuda_ptr_ && num_voxels_ > 0) {
+    // only the voxels of the last frame were written to
+    const auto num_voxel_points = num_voxels_ * config_.max_point_in_voxel_size_;
+    std::fill_n(voxels_.begin(), num_voxel_points * config_.point_feature_size_, 0);
+    std::fill_n(coordinates_.begin(), num_voxels_ * config_.point_dim_size_, -1);
+    std::fill_n(num_points_per_voxel_.begin(), num_voxels_, 0);
+  }
   CHECK_CUDA_ERROR(cudaMemsetAsync(
     encoder_in_features_d_.get(), 0, encoder_in_feature_size_ * sizeof(float), stream_));
   CHECK_CUDA_ERROR(
@@ -127,28 +142,42 @@ bool CenterPointTRT::detect(
 bool CenterPointTRT::preprocess(
   const sensor_msgs::msg::PointCloud2 & input_pointcloud_msg, const tf2_ros::Buffer & tf_buffer)
 {
-  bool is_success = vg_ptr_->enqueuePointCloud(input_pointcloud_msg, tf_buffer);
-  if (!is_success) {
-    return false;
+  if (vg_cuda_ptr_) {
+    bool is_success = vg_cuda_ptr_->enqueuePointCloud(input_pointcloud_msg, tf_buffer);
+    if (!is_success) {
+      return false;
+    }
+    num_voxels_ = vg_cuda_ptr_->pointsToVoxels(
+      input_pointcloud_msg, voxels_d_.get(), coordinates_d_.get(), num_points_per_voxel_d_.get(),
+      stream_);
+    if (num_voxels_ == 0) {
+      return false;
+    }
+  } else {
+    bool is_success = vg_ptr_->enqueuePointCloud(input_pointcloud_msg, tf_buffer);
+    if (!is_success) {
+      return false;
+    }
+    num_voxels_ = vg_ptr_->pointsToVoxels(voxels_, coordinates_, num_points_per_voxel_);
+    if (num_voxels_ == 0) {
+      return false;
+    }
+
+    const auto voxels_size =
+      num_voxels_ * config_.max_point_in_voxel_size_ * config_.point_feature_size_;
+    const auto coordinates_size = num_voxels_ * config_.point_dim_size_;
+    // memcpy from host to device (not copy empty voxels). The host buffers can be reused as soon
+    // as these return, so the stream is not synchronized.
+    CHECK_CUDA_ERROR(cudaMemcpyAsync(
+      voxels_d_.get(), voxels_.data(), voxels_size * sizeof(float), cudaMemcpyHostToDevice,
+      stream_));
+    CHECK_CUDA_ERROR(cudaMemcpyAsync(
+      coordinates_d_.get(), coordinates_.data(), coordinates_size * sizeof(int),
+      cudaMemcpyHostToDevice, stream_));
+    CHECK_CUDA_ERROR(cudaMemcpyAsync(
+      num_points_per_voxel_d_.get(), num_points_per_voxel_.data(), num_voxels_ * sizeof(float),
+      cudaMemcpyHostToDevice, stream_));
   }
-  num_voxels_ = vg_ptr_->pointsToVoxels(voxels_, coordinates_, num_points_per_voxel_);
-  if (num_voxels_ == 0) {
-    return false;
-  }
-
-  const auto voxels_size =
-    num_voxels_ * config_.max_point_in_voxel_size_ * config_.point_feature_size_;
-  const auto coordinates_size = num_voxels_ * config_.point_dim_size_;
-  // memcpy from host to device (not copy empty voxels)
-  CHECK_CUDA_ERROR(cudaMemcpyAsync(
-    voxels_d_.get(), voxels_.data(), voxels_size * sizeof(float), cudaMemcpyHostToDevice));
-  CHECK_CUDA_ERROR(cudaMemcpyAsync(
-    coordinates_d_.get(), coordinates_.data(), coordinates_size * sizeof(int),
-    cudaMemcpyHostToDevice));
-  CHECK_CUDA_ERROR(cudaMemcpyAsync(
-    num_points_per_voxel_d_.get(), num_points_per_voxel_.data(), num_voxels_ * sizeof(float),
-    cudaMemcpyHostToDevice));
-  CHECK_CUDA_ERROR(cudaStreamSynchronize(stream_));
 
   CHECK_CUDA_ERROR(generateFeatures_launch(
     voxels_d_.get(), num_points_per_voxel_d_.get(), coordinates_d_.get(), num_voxels_,
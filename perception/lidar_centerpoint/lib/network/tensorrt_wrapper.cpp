@@ -14,6 +14,8 @@
 
 #include "lidar_centerpoint/network/tensorrt_wrapper.hpp"
 
+#include <tensorrt_common/engine_cache.hpp>
+
 #include <NvOnnxParser.h>
 
 #include <fstream>
@@ -27,7 +29,6 @@ TensorRTWrapper::TensorRTWrapper(const CenterPointConfig & config) : config_(con
 TensorRTWrapper::~TensorRTWrapper()
 {
   context_.reset();
-  runtime_.reset();
   plan_.reset();
   engine_.reset();
 }
@@ -35,12 +36,8 @@ TensorRTWrapper::~TensorRTWrapper()
 bool TensorRTWrapper::init(
   const std::string & onnx_path, const std::string & engine_path, const std::string & precision)
 {
-  runtime_ =
-    tensorrt_common::TrtUniquePtr<nvinfer1::IRuntime>(nvinfer1::createInferRuntime(logger_));
-  if (!runtime_) {
-    std::cout << "Fail to create runtime" << std::endl;
-    return false;
-  }
+  // another node of this process may be building the same engine
+  const auto build_lock = tensorrt_common::EngineCache::getInstance().lockBuild(engine_path);
 
   bool success;
   std::ifstream engine_file(engine_path);
@@ -128,8 +125,9 @@ bool TensorRTWrapper::parseONNX(
     std::cout << "Fail to create serialized network" << std::endl;
     return false;
   }
-  engine_ = tensorrt_common::TrtUniquePtr<nvinfer1::ICudaEngine>(
-    runtime_->deserializeCudaEngine(plan_->data(), plan_->size()));
+  auto & engine_cache = tensorrt_common::EngineCache::getInstance();
+  engine_ = engine_cache.add(
+    engine_path, engine_cache.getRuntime().deserializeCudaEngine(plan_->data(), plan_->size()));
   if (!engine_) {
     std::cout << "Fail to create engine" << std::endl;
     return false;
@@ -148,12 +146,12 @@ bool TensorRTWrapper::saveEngine(const std::string & engine_path)
 
 bool TensorRTWrapper::loadEngine(const std::string & engine_path)
 {
-  std::ifstream engine_file(engine_path);
-  std::stringstream engine_buffer;
-  engine_buffer << engine_file.rdbuf();
-  std::string engine_str = engine_buffer.str();
-  engine_ = tensorrt_common::TrtUniquePtr<nvinfer1::ICudaEngine>(runtime_->deserializeCudaEngine(
-    reinterpret_cast<const void *>(engine_str.data()), engine_str.size()));
+  // shared with the other nodes of this process loading the same engine file
+  engine_ = tensorrt_common::EngineCache::getInstance().load(engine_path);
+  if (!engine_) {
+    std::cout << "Fail to load engine from " << engine_path << std::endl;
+    return false;
+  }
   std::cout << "Loaded engine from " << engine_path << std::endl;
   return true;
 }
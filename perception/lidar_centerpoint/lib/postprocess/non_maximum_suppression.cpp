@@ -60,6 +60,14 @@ Eigen::MatrixXd NonMaximumSuppression::generateIoUMatrix(
   // NOTE: row = target objects to be suppressed, col = source objects to be compared
   Eigen::MatrixXd triangular_matrix =
     Eigen::MatrixXd::Zero(input_objects.size(), input_objects.size());
+  std::vector<perception_utils::MatchingPolygon2d> polygons;
+  if (params_.nms_type_ == NMS_TYPE::IoU_BEV) {
+    polygons.reserve(input_objects.size());
+    for (const auto & object : input_objects) {
+      polygons.push_back(perception_utils::toMatchingPolygon2d(object));
+    }
+  }
+
   for (std::size_t target_i = 0; target_i < input_objects.size(); ++target_i) {
     for (std::size_t source_i = 0; source_i < target_i; ++source_i) {
       const auto & target_obj = input_objects.at(target_i);
@@ -69,7 +77,7 @@ Eigen::MatrixXd NonMaximumSuppression::generateIoUMatrix(
       }
 
       if (params_.nms_type_ == NMS_TYPE::IoU_BEV) {
-        const double iou = perception_utils::get2dIoU(target_obj, source_obj);
+        const double iou = perception_utils::get2dIoU(polygons.at(target_i), polygons.at(source_i));
         triangular_matrix(target_i, source_i) = iou;
         // NOTE: If the target object has any objects with iou > iou_threshold, it
         // will be suppressed regardless of later results.
@@ -25,6 +25,7 @@
 #include <tf2_eigen/tf2_eigen.hpp>
 #endif
 
+#include <algorithm>
 #include <string>
 #include <utility>
 
@@ -56,7 +57,11 @@ Eigen::Affine3f transformToEigen(const geometry_msgs::msg::Transform & t)
 
 namespace centerpoint
 {
-PointCloudDensification::PointCloudDensification(const DensificationParam & param) : param_(param)
+PointCloudDensification::PointCloudDensification(
+  const DensificationParam & param, const bool cache_points)
+: param_(param),
+  cache_points_(cache_points),
+  pointcloud_cache_(std::max(param.pointcloud_cache_size(), 1u))
 {
 }
 
@@ -78,8 +83,6 @@ bool PointCloudDensification::enqueuePointCloud(
     enqueue(pointcloud_msg, Eigen::Affine3f::Identity());
   }
 
-  dequeue();
-
   return true;
 }
 
@@ -88,15 +91,17 @@ void PointCloudDensification::enqueue(
 {
   affine_world2current_ = affine_world2current;
   current_timestamp_ = rclcpp::Time(msg.header.stamp).seconds();
-  PointCloudWithTransform pointcloud = {msg, affine_world2current.inverse()};
-  pointcloud_cache_.push_front(pointcloud);
-}
 
-void PointCloudDensification::dequeue()
-{
-  if (pointcloud_cache_.size() > param_.pointcloud_cache_size()) {
-    pointcloud_cache_.pop_back();
+  // the current point cloud takes the slot of the oldest one once the ring is full
+  cache_head_ = (cache_head_ + pointcloud_cache_.size() - 1) % pointcloud_cache_.size();
+  cache_size_ = std::min(cache_size_ + 1, pointcloud_cache_.size());
+  auto & pointcloud = pointcloud_cache_[cache_head_];
+  if (cache_points_) {
+    pointcloud.pointcloud_msg = msg;
+  } else {
+    pointcloud.pointcloud_msg.header = msg.header;
   }
+  pointcloud.affine_past2world = affine_world2current.inverse();
 }
 
 }  // namespace centerpoint
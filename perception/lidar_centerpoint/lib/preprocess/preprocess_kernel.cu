@@ -37,6 +37,9 @@ namespace
 const std::size_t MAX_POINT_IN_VOXEL_SIZE = 32;  // the same as max_point_in_voxel_size_ in config
 const std::size_t WARPS_PER_BLOCK = 4;
 const std::size_t ENCODER_IN_FEATURE_SIZE = 9;  // the same as encoder_in_feature_size_ in config
+const std::size_t THREADS_PER_BLOCK = 256;
+const int EMPTY_CELL = -1;
+const int CLAIMED_CELL = -2;  // a voxel is being assigned, or none was left for the cell
 }  // namespace
 
 namespace centerpoint
@@ -157,4 +160,166 @@ cudaError_t generateFeatures_launch(
   return cudaGetLastError();
 }
 
+struct VoxelGridParam
+{
+  float range_min_x;
+  float range_min_y;
+  float range_min_z;
+  float recip_voxel_size_x;
+  float recip_voxel_size_y;
+  float recip_voxel_size_z;
+  int grid_size_x;
+  int grid_size_y;
+  int grid_size_z;
+};
+
+__device__ bool pointToCell(
+  const std::uint8_t * point, const std::size_t x_offset, const std::size_t y_offset,
+  const std::size_t z_offset, const PointTransform & transform, const VoxelGridParam & grid,
+  float3 & point_current, int3 & coord_zyx, int & cell_idx)
+{
+  const float x = *reinterpret_cast<const float *>(point + x_offset);
+  const float y = *reinterpret_cast<const float *>(point + y_offset);
+  const float z = *reinterpret_cast<const float *>(point + z_offset);
+  const float * m = transform.matrix;
+  point_current.x = m[0] * x + m[1] * y + m[2] * z + m[3];
+  point_current.y = m[4] * x + m[5] * y + m[6] * z + m[7];
+  point_current.z = m[8] * x + m[9] * y + m[10] * z + m[11];
+
+  // truncated toward zero as in VoxelGenerator::pointsToVoxels
+  const int cx = static_cast<int>((point_current.x - grid.range_min_x) * grid.recip_voxel_size_x);
+  const int cy = static_cast<int>((point_current.y - grid.range_min_y) * grid.recip_voxel_size_y);
+  const int cz = static_cast<int>((point_current.z - grid.range_min_z) * grid.recip_voxel_size_z);
+  if (
+    cx < 0 || cx >= grid.grid_size_x || cy < 0 || cy >= grid.grid_size_y || cz < 0 ||
+    cz >= grid.grid_size_z) {
+    return false;
+  }
+  coord_zyx = make_int3(cz, cy, cx);
+  cell_idx = (cz * grid.grid_size_y + cy) * grid.grid_size_x + cx;
+  return true;
+}
+
+__global__ void assignVoxels_kernel(
+  const std::uint8_t * points, const std::size_t begin, const std::size_t end,
+  const std::size_t point_step, const std::size_t x_offset, const std::size_t y_offset,
+  const std::size_t z_offset, const PointTransform transform, const VoxelGridParam grid,
+  const std::size_t max_voxel_size, int * cell_to_voxel, unsigned int * num_voxels,
+  int * coordinates)
+{
+  const std::size_t point_idx = begin + blockIdx.x * blockDim.x + threadIdx.x;
+  if (point_idx >= end) return;
+
+  float3 point_current;
+  int3 coord_zyx;
+  int cell_idx;
+  if (!pointToCell(
+        points + point_idx * point_step, x_offset, y_offset, z_offset, transform, grid,
+        point_current, coord_zyx, cell_idx)) {
+    return;
+  }
+
+  // the first point of a cell assigns its voxel
+  if (atomicCAS(&cell_to_voxel[cell_idx], EMPTY_CELL, CLAIMED_CELL) != EMPTY_CELL) return;
+  const unsigned int voxel_idx = atomicAdd(num_voxels, 1u);
+  if (voxel_idx >= max_voxel_size) return;
+  reinterpret_cast<int3 *>(coordinates)[voxel_idx] = coord_zyx;
+  cell_to_voxel[cell_idx] = static_cast<int>(voxel_idx);
+}
+
+__global__ void fillVoxels_kernel(
+  const std::uint8_t * points, const std::size_t begin, const std::size_t end,
+  const std::size_t point_step, const std::size_t x_offset, const std::size_t y_offset,
+  const std::size_t z_offset, const PointTransform transform, const float time_lag,
+  const VoxelGridParam grid, const std::size_t max_point_in_voxel_size,
+  const std::size_t point_feature_size, const int * cell_to_voxel, float * voxels,
+  float * num_points_per_voxel)
+{
+  const std::size_t point_idx = begin + blockIdx.x * blockDim.x + threadIdx.x;
+  if (point_idx >= end) return;
+
+  float3 point_current;
+  int3 coord_zyx;
+  int cell_idx;
+  if (!pointToCell(
+        points + point_idx * point_step, x_offset, y_offset, z_offset, transform, grid,
+        point_current, coord_zyx, cell_idx)) {
+    return;
+  }
+
+  const int voxel_idx = cell_to_voxel[cell_idx];
+  if (voxel_idx < 0) return;
+  const auto point_cnt =
+    static_cast<std::size_t>(atomicAdd(&num_points_per_voxel[voxel_idx], 1.0f));
+  if (point_cnt >= max_point_in_voxel_size) return;
+
+  float * voxel_point =
+    voxels + (voxel_idx * max_point_in_voxel_size + point_cnt) * point_feature_size;
+  voxel_point[0] = point_current.x;
+  voxel_point[1] = point_current.y;
+  voxel_point[2] = point_current.z;
+  voxel_point[3] = time_lag;
+  for (std::size_t fi = 4; fi < point_feature_size; fi++) {
+    voxel_point[fi] = 0.0f;
+  }
+}
+
+__global__ void clampNumPointsPerVoxel_kernel(
+  const std::size_t max_voxel_size, const float max_point_in_voxel_size,
+  float * num_points_per_voxel)
+{
+  const std::size_t voxel_idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (voxel_idx >= max_voxel_size) return;
+  num_points_per_voxel[voxel_idx] =
+    fminf(num_points_per_voxel[voxel_idx], max_point_in_voxel_size);
+}
+
+cudaError_t generateVoxels_launch(
+  const std::uint8_t * points, const std::size_t begin, const std::size_t end,
+  const std::size_t point_step, const std::size_t x_offset, const std::size_t y_offset,
+  const std::size_t z_offset, const PointTransform & transform, const float time_lag,
+  const CenterPointConfig & config, int * cell_to_voxel, unsigned int * num_voxels,
+  int * coordinates, float * voxels, float * num_points_per_voxel, cudaStream_t stream)
+{
+  if (begin >= end) {
+    return cudaSuccess;
+  }
+
+  VoxelGridParam grid;
+  grid.range_min_x = config.range_min_x_;
+  grid.range_min_y = config.range_min_y_;
+  grid.range_min_z = config.range_min_z_;
+  grid.recip_voxel_size_x = 1 / config.voxel_size_x_;
+  grid.recip_voxel_size_y = 1 / config.voxel_size_y_;
+  grid.recip_voxel_size_z = 1 / config.voxel_size_z_;
+  grid.grid_size_x = static_cast<int>(config.grid_size_x_);
+  grid.grid_size_y = static_cast<int>(config.grid_size_y_);
+  grid.grid_size_z = static_cast<int>(config.grid_size_z_);
+
+  // every voxel has to be assigned before points are written to them
+  dim3 blocks(divup(end - begin, THREADS_PER_BLOCK));
+  dim3 threads(THREADS_PER_BLOCK);
+  assignVoxels_kernel<<<blocks, threads, 0, stream>>>(
+    points, begin, end, point_step, x_offset, y_offset, z_offset, transform, grid,
+    config.max_voxel_size_, cell_to_voxel, num_voxels, coordinates);
+  fillVoxels_kernel<<<blocks, threads, 0, stream>>>(
+    points, begin, end, point_step, x_offset, y_offset, z_offset, transform, time_lag, grid,
+    config.max_point_in_voxel_size_, config.point_feature_size_, cell_to_voxel, voxels,
+    num_points_per_voxel);
+
+  return cudaGetLastError();
+}
+
+cudaError_t clampNumPointsPerVoxel_launch(
+  const std::size_t max_voxel_size, const std::size_t max_point_in_voxel_size,
+  float * num_points_per_voxel, cudaStream_t stream)
+{
+  dim3 blocks(divup(max_voxel_size, THREADS_PER_BLOCK));
+  dim3 threads(THREADS_PER_BLOCK);
+  clampNumPointsPerVoxel_kernel<<<blocks, threads, 0, stream>>>(
+    max_voxel_size, static_cast<float>(max_point_in_voxel_size), num_points_per_voxel);
+
+  return cudaGetLastError();
+}
+
 }  // namespace centerpoint
@@ -0,0 +1,178 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lidar_centerpoint/preprocess/voxel_generator_cuda.hpp"
+
+#include <lidar_centerpoint/preprocess/preprocess_kernel.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace
+{
+const std::size_t STAGING_BUFFER_SIZE = 1 << 20;  // bytes
+
+std::size_t getFieldOffset(const sensor_msgs::msg::PointCloud2 & msg, const std::string & name)
+{
+  for (const auto & field : msg.fields) {
+    if (field.name == name) {
+      return field.offset;
+    }
+  }
+  throw std::runtime_error("Field " + name + " does not exist");
+}
+}  // namespace
+
+namespace centerpoint
+{
+VoxelGeneratorCUDA::VoxelGeneratorCUDA(
+  const DensificationParam & param, const CenterPointConfig & config)
+: config_(config)
+{
+  pd_ptr_ = std::make_unique<PointCloudDensification>(param, /*cache_points=*/false);
+  device_cache_.resize(std::max(param.pointcloud_cache_size(), 1u));
+
+  grid_size_ = config_.grid_size_z_ * config_.grid_size_y_ * config_.grid_size_x_;
+  cell_to_voxel_d_ = cuda::make_unique<int[]>(grid_size_);
+  num_voxels_d_ = cuda::make_unique<unsigned int>();
+  num_voxels_h_ = cuda::make_unique_host<unsigned int>();
+
+  CHECK_CUDA_ERROR(cudaStreamCreate(&copy_stream_));
+  for (std::size_t i = 0; i < staging_buffers_.size(); ++i) {
+    staging_buffers_[i] = cuda::make_unique_host<std::uint8_t[]>(STAGING_BUFFER_SIZE);
+    CHECK_CUDA_ERROR(cudaEventCreateWithFlags(&copy_done_events_[i], cudaEventDisableTiming));
+  }
+}
+
+VoxelGeneratorCUDA::~VoxelGeneratorCUDA()
+{
+  if (copy_stream_) {
+    cudaStreamSynchronize(copy_stream_);
+    cudaStreamDestroy(copy_stream_);
+  }
+  for (auto & event : copy_done_events_) {
+    if (event) {
+      cudaEventDestroy(event);
+    }
+  }
+}
+
+bool VoxelGeneratorCUDA::enqueuePointCloud(
+  const sensor_msgs::msg::PointCloud2 & input_pointcloud_msg, const tf2_ros::Buffer & tf_buffer)
+{
+  if (!pd_ptr_->enqueuePointCloud(input_pointcloud_msg, tf_buffer)) {
+    return false;
+  }
+
+  // reuse the device buffer of the point cloud leaving the cache
+  device_cache_head_ = (device_cache_head_ + device_cache_.size() - 1) % device_cache_.size();
+  auto & cloud = device_cache_[device_cache_head_];
+
+  cloud.num_points =
+    static_cast<std::size_t>(input_pointcloud_msg.width) * input_pointcloud_msg.height;
+  cloud.point_step = input_pointcloud_msg.point_step;
+  cloud.x_offset = getFieldOffset(input_pointcloud_msg, "x");
+  cloud.y_offset = getFieldOffset(input_pointcloud_msg, "y");
+  cloud.z_offset = getFieldOffset(input_pointcloud_msg, "z");
+  cloud.is_uploaded = false;
+  const std::size_t data_size = cloud.num_points * cloud.point_step;
+  if (cloud.capacity < data_size) {
+    cloud.data = cuda::make_unique<std::uint8_t[]>(data_size);
+    cloud.capacity = data_size;
+  }
+
+  return true;
+}
+
+std::size_t VoxelGeneratorCUDA::pointsToVoxels(
+  const sensor_msgs::msg::PointCloud2 & current_pointcloud_msg, float * voxels, int * coordinates,
+  float * num_points_per_voxel, cudaStream_t stream)
+{
+  CHECK_CUDA_ERROR(cudaMemsetAsync(cell_to_voxel_d_.get(), 0xff, grid_size_ * sizeof(int), stream));
+  CHECK_CUDA_ERROR(cudaMemsetAsync(num_voxels_d_.get(), 0, sizeof(unsigned int), stream));
+  CHECK_CUDA_ERROR(cudaMemsetAsync(
+    num_points_per_voxel, 0, config_.max_voxel_size_ * sizeof(float), stream));
+
+  for (std::size_t cache_idx = 0; cache_idx < pd_ptr_->getCacheSize(); ++cache_idx) {
+    const auto & pc_cache = pd_ptr_->getPointCloudCache(cache_idx);
+    const auto & pc_msg = pc_cache.pointcloud_msg;
+    const Eigen::Affine3f affine_past2current =
+      pd_ptr_->pointcloud_cache_size() > 1
+        ? pd_ptr_->getAffineWorldToCurrent() * pc_cache.affine_past2world
+        : Eigen::Affine3f::Identity();
+    const float time_lag = static_cast<float>(
+      pd_ptr_->getCurrentTimestamp() - rclcpp::Time(pc_msg.header.stamp).seconds());
+
+    PointTransform transform;
+    for (int row = 0; row < 3; ++row) {
+      for (int col = 0; col < 4; ++col) {
+        transform.matrix[row * 4 + col] = affine_past2current.matrix()(row, col);
+      }
+    }
+
+    auto & cloud = device_cache_[(device_cache_head_ + cache_idx) % device_cache_.size()];
+    const auto generate_voxels = [&](const std::size_t begin, const std::size_t end) {
+      CHECK_CUDA_ERROR(generateVoxels_launch(
+        cloud.data.get(), begin, end, cloud.point_step, cloud.x_offset, cloud.y_offset,
+        cloud.z_offset, transform, time_lag, config_, cell_to_voxel_d_.get(), num_voxels_d_.get(),
+        coordinates, voxels, num_points_per_voxel, stream));
+    };
+
+    if (cloud.is_uploaded) {
+      generate_voxels(0, cloud.num_points);
+      continue;
+    }
+
+    // only the current point cloud is not on the device yet; upload it by chunks, each
+    // voxelized as soon as it is on the device
+    if (cloud.point_step > STAGING_BUFFER_SIZE) {
+      throw std::runtime_error("point_step is larger than the staging buffer");
+    }
+    const std::size_t points_per_chunk =
+      STAGING_BUFFER_SIZE / std::max<std::size_t>(cloud.point_step, 1);
+    std::size_t chunk_idx = 0;
+    for (std::size_t begin = 0; begin < cloud.num_points; begin += points_per_chunk, ++chunk_idx) {
+      const std::size_t end = std::min(begin + points_per_chunk, cloud.num_points);
+      const std::size_t offset = begin * cloud.point_step;
+      const std::size_t size = (end - begin) * cloud.point_step;
+      auto & staging_buffer = staging_buffers_[chunk_idx % staging_buffers_.size()];
+      auto & copy_done_event = copy_done_events_[chunk_idx % copy_done_events_.size()];
+
+      // wait until the copy of the chunk before last has released the staging buffer
+      CHECK_CUDA_ERROR(cudaEventSynchronize(copy_done_event));
+      std::memcpy(staging_buffer.get(), current_pointcloud_msg.data.data() + offset, size);
+      CHECK_CUDA_ERROR(cudaMemcpyAsync(
+        cloud.data.get() + offset, staging_buffer.get(), size, cudaMemcpyHostToDevice,
+        copy_stream_));
+      CHECK_CUDA_ERROR(cudaEventRecord(copy_done_event, copy_stream_));
+      CHECK_CUDA_ERROR(cudaStreamWaitEvent(stream, copy_done_event, 0));
+      generate_voxels(begin, end);
+    }
+    cloud.is_uploaded = true;
+  }
+
+  CHECK_CUDA_ERROR(clampNumPointsPerVoxel_launch(
+    config_.max_voxel_size_, config_.max_point_in_voxel_size_, num_points_per_voxel, stream));
+  CHECK_CUDA_ERROR(cudaMemcpyAsync(
+    num_voxels_h_.get(), num_voxels_d_.get(), sizeof(unsigned int), cudaMemcpyDeviceToHost,
+    stream));
+  CHECK_CUDA_ERROR(cudaStreamSynchronize(stream));
+
+  return std::min<std::size_t>(*num_voxels_h_, config_.max_voxel_size_);
+}
+
+}  // namespace centerpoint
@@ -49,6 +49,7 @@ LidarCenterPointNode::LidarCenterPointNode(const rclcpp::NodeOptions & node_opti
   const int densification_num_past_frames =
     this->declare_parameter("densification_num_past_frames", 1);
   const std::string trt_precision = this->declare_parameter("trt_precision", "fp16");
+  const bool use_gpu_preprocess = this->declare_parameter("use_gpu_preprocess", false);
   const std::string encoder_onnx_path = this->declare_parameter<std::string>("encoder_onnx_path");
   const std::string encoder_engine_path =
     this->declare_parameter<std::string>("encoder_engine_path");
@@ -103,8 +104,8 @@ LidarCenterPointNode::LidarCenterPointNode(const rclcpp::NodeOptions & node_opti
     class_names_.size(), point_feature_size, max_voxel_size, point_cloud_range, voxel_size,
     downsample_factor, encoder_in_feature_size, score_threshold, circle_nms_dist_threshold,
     yaw_norm_thresholds);
-  detector_ptr_ =
-    std::make_unique<CenterPointTRT>(encoder_param, head_param, densification_param, config);
+  detector_ptr_ = std::make_unique<CenterPointTRT>(
+    encoder_param, head_param, densification_param, config, use_gpu_preprocess);
 
   pointcloud_sub_ = this->create_subscription<sensor_msgs::msg::PointCloud2>(
     "~/input/pointcloud", rclcpp::SensorDataQoS{}.keep_last(1),
@@ -25,9 +25,10 @@
 #include <tf2_sensor_msgs/tf2_sensor_msgs.hpp>
 #endif
 
-#include <list>
+#include <cstddef>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace autoware
 {
@@ -58,6 +59,8 @@ struct PointCloudWithTransform
   Eigen::Affine3f affine_past2world;
 };
 
+// Keeps the current point cloud and the past ones in a ring of pointcloud_cache_size slots, the
+// current one first. Enqueueing a point cloud overwrites the oldest slot instead of allocating.
 class LIDAR_CENTERPOINT_TVM_LOCAL PointCloudDensification
 {
 public:
@@ -68,23 +71,22 @@ public:
 
   double getCurrentTimestamp() const { return current_timestamp_; }
   Eigen::Affine3f getAffineWorldToCurrent() const { return affine_world2current_; }
-  std::list<PointCloudWithTransform>::iterator getPointCloudCacheIter()
+  std::size_t getCacheSize() const { return cache_size_; }
+  // i = 0 is the current point cloud, i = getCacheSize() - 1 the oldest one
+  const PointCloudWithTransform & getPointCloudCache(const std::size_t i) const
   {
-    return pointcloud_cache_.begin();
-  }
-  bool isCacheEnd(std::list<PointCloudWithTransform>::iterator iter)
-  {
-    return iter == pointcloud_cache_.end();
+    return pointcloud_cache_[(cache_head_ + i) % pointcloud_cache_.size()];
   }
 
 private:
   void enqueue(const sensor_msgs::msg::PointCloud2 & msg, const Eigen::Affine3f & affine);
-  void dequeue();
 
   DensificationParam param_;
   double current_timestamp_{0.0};
   Eigen::Affine3f affine_world2current_;
-  std::list<PointCloudWithTransform> pointcloud_cache_;
+  std::vector<PointCloudWithTransform> pointcloud_cache_;
+  std::size_t cache_head_{0};
+  std::size_t cache_size_{0};
 };
 
 }  // namespace lidar_centerpoint_tvm
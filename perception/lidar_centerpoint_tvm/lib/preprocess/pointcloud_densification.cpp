@@ -25,6 +25,7 @@
 #include <tf2_eigen/tf2_eigen.hpp>
 #endif
 
+#include <algorithm>
 #include <string>
 #include <utility>
 
@@ -68,7 +69,8 @@ namespace perception
 namespace lidar_centerpoint_tvm
 {
 
-PointCloudDensification::PointCloudDensification(const DensificationParam & param) : param_(param)
+PointCloudDensification::PointCloudDensification(const DensificationParam & param)
+: param_(param), pointcloud_cache_(std::max<uint32_t>(param.pointcloud_cache_size(), 1))
 {
 }
 
@@ -85,7 +87,6 @@ bool PointCloudDensification::enqueuePointCloud(
   auto affine_world2current = transformToEigen(transform_world2current.get());
 
   enqueue(pointcloud_msg, affine_world2current);
-  dequeue();
 
   return true;
 }
@@ -95,15 +96,13 @@ void PointCloudDensification::enqueue(
 {
   affine_world2current_ = affine_world2current;
   current_timestamp_ = rclcpp::Time(msg.header.stamp).seconds();
-  PointCloudWithTransform pointcloud = {msg, affine_world2current.inverse()};
-  pointcloud_cache_.push_front(pointcloud);
-}
 
-void PointCloudDensification::dequeue()
-{
-  if (pointcloud_cache_.size() > param_.pointcloud_cache_size()) {
-    pointcloud_cache_.pop_back();
-  }
+  // the current point cloud takes the slot of the oldest one once the ring is full
+  cache_head_ = (cache_head_ + pointcloud_cache_.size() - 1) % pointcloud_cache_.size();
+  cache_size_ = std::min(cache_size_ + 1, pointcloud_cache_.size());
+  auto & pointcloud = pointcloud_cache_[cache_head_];
+  pointcloud.pointcloud_msg = msg;
+  pointcloud.affine_past2world = affine_world2current.inverse();
 }
 
 }  // namespace lidar_centerpoint_tvm
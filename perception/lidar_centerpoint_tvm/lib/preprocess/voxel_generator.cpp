@@ -70,11 +70,10 @@ std::size_t VoxelGenerator::pointsToVoxels(
   int32_t c, coord_idx, voxel_idx;
   Eigen::Vector3f point_current, point_past;
 
-  for (auto pc_cache_iter = pd_ptr_->getPointCloudCacheIter(); !pd_ptr_->isCacheEnd(pc_cache_iter);
-       pc_cache_iter++) {
-    auto pc_msg = pc_cache_iter->pointcloud_msg;
-    auto affine_past2current =
-      pd_ptr_->getAffineWorldToCurrent() * pc_cache_iter->affine_past2world;
+  for (std::size_t cache_idx = 0; cache_idx < pd_ptr_->getCacheSize(); ++cache_idx) {
+    const auto & pc_cache = pd_ptr_->getPointCloudCache(cache_idx);
+    const auto & pc_msg = pc_cache.pointcloud_msg;
+    auto affine_past2current = pd_ptr_->getAffineWorldToCurrent() * pc_cache.affine_past2world;
     float timelag = static_cast<float>(
       pd_ptr_->getCurrentTimestamp() - rclcpp::Time(pc_msg.header.stamp).seconds());
 
@@ -0,0 +1,85 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MAP_BASED_PREDICTION__LRU_CACHE_HPP_
+#define MAP_BASED_PREDICTION__LRU_CACHE_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace map_based_prediction
+{
+// A map of a bounded size, which forgets the least recently used value when it is full.
+// find() does not change the recency, so that it can be called from several threads at once.
+template <class Key, class Value, class Hash = std::hash<Key>>
+class LruCache
+{
+public:
+  explicit LruCache(const std::size_t capacity) : capacity_(capacity > 0 ? capacity : 1) {}
+
+  std::size_t size() const { return index_.size(); }
+
+  void clear()
+  {
+    index_.clear();
+    entries_.clear();
+  }
+
+  // nullptr when the key is not cached
+  const Value * find(const Key & key) const
+  {
+    const auto it = index_.find(key);
+    return it == index_.end() ? nullptr : &it->second->second;
+  }
+
+  // nullptr when the key is not cached, otherwise the value becomes the most recent one
+  const Value * get(const Key & key)
+  {
+    const auto it = index_.find(key);
+    if (it == index_.end()) {
+      return nullptr;
+    }
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return &it->second->second;
+  }
+
+  // the value becomes the most recent one
+  void put(const Key & key, Value value)
+  {
+    const auto it = index_.find(key);
+    if (it != index_.end()) {
+      it->second->second = std::move(value);
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return;
+    }
+    if (index_.size() == capacity_) {
+      index_.erase(entries_.back().first);
+      entries_.pop_back();
+    }
+    entries_.emplace_front(key, std::move(value));
+    index_.emplace(key, entries_.begin());
+  }
+
+private:
+  std::size_t capacity_;
+  // the most recent first
+  std::list<std::pair<Key, Value>> entries_;
+  std::unordered_map<Key, typename std::list<std::pair<Key, Value>>::iterator, Hash> index_;
+};
+}  // namespace map_based_prediction
+
+#endif  // MAP_BASED_PREDICTION__LRU_CACHE_HPP_
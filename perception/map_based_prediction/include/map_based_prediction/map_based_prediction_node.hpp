@@ -15,6 +15,7 @@
 #ifndef MAP_BASED_PREDICTION__MAP_BASED_PREDICTION_NODE_HPP_
 #define MAP_BASED_PREDICTION__MAP_BASED_PREDICTION_NODE_HPP_
 
+#include "map_based_prediction/lru_cache.hpp"
 #include "map_based_prediction/path_generator.hpp"
 
 #include <lanelet2_extension/utility/message_conversion.hpp>
@@ -40,8 +41,13 @@
 #include <lanelet2_routing/RoutingGraph.h>
 #include <lanelet2_traffic_rules/TrafficRulesFactory.h>
 
+#include <boost/functional/hash.hpp>
+#include <boost/optional.hpp>
+
+#include <cstddef>
 #include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -83,10 +89,20 @@ struct LaneletData
   float probability;
 };
 
+// The lanelets found around an object, reused while no other lanelet can contain it
+struct LaneletCandidates
+{
+  // position of the object at the search
+  lanelet::BasicPoint2d search_point{lanelet::BasicPoint2d::Zero()};
+  // every lanelet which is not a candidate is at least this far from search_point
+  double valid_radius{-1.0};
+  lanelet::Lanelets lanelets;
+};
+
 struct PredictedRefPath
 {
   float probability;
-  PosePath path;
+  std::shared_ptr<const ReferencePath> path;
   Maneuver maneuver;
 };
 
@@ -118,6 +134,19 @@ private:
   // Object History
   std::unordered_map<std::string, std::deque<ObjectData>> objects_history_;
 
+  // Lanelet candidates of the objects, keyed by the object id
+  static constexpr std::size_t LANELET_CANDIDATES_CACHE_SIZE = 256;
+  LruCache<std::string, LaneletCandidates> lanelet_candidates_cache_{
+    LANELET_CANDIDATES_CACHE_SIZE};
+
+  // Reference paths of the lanelet sequences of the map, shared by all the objects
+  static constexpr std::size_t REFERENCE_PATHS_CACHE_SIZE = 256;
+  LruCache<
+    std::vector<lanelet::Id>, std::shared_ptr<const ReferencePath>,
+    boost::hash<std::vector<lanelet::Id>>>
+    reference_paths_cache_{REFERENCE_PATHS_CACHE_SIZE};
+  std::mutex reference_paths_cache_mutex_;
+
   // Lanelet Map Pointers
   std::shared_ptr<lanelet::LaneletMap> lanelet_map_ptr_;
   std::shared_ptr<lanelet::routing::RoutingGraph> routing_graph_ptr_;
@@ -149,6 +178,7 @@ private:
   double time_threshold_to_bound_;
   double cutoff_freq_of_velocity_lpf_;
   double reference_path_resolution_;
+  int num_threads_;
 
   // Stop watch
   StopWatch<std::chrono::milliseconds> stop_watch_;
@@ -164,12 +194,17 @@ private:
 
   PredictedObject getPredictedObjectAsCrosswalkUser(const TrackedObject & object);
 
+  boost::optional<PredictedObject> getPredictedObjectAsRoadUser(
+    const TrackedObject & object, const LaneletsData & current_lanelets,
+    const double objects_detected_time, boost::optional<Maneuver> & debug_maneuver);
+
   void removeOldObjectsHistory(const double current_time);
 
-  LaneletsData getCurrentLanelets(const TrackedObject & object);
+  LaneletsData getCurrentLanelets(
+    const TrackedObject & object, LaneletCandidates & lanelet_candidates) const;
   bool checkCloseLaneletCondition(
     const std::pair<double, lanelet::Lanelet> & lanelet, const TrackedObject & object,
-    const lanelet::BasicPoint2d & search_point);
+    const lanelet::BasicPoint2d & search_point) const;
   float calculateLocalLikelihood(
     const lanelet::Lanelet & current_lanelet, const TrackedObject & object) const;
   void updateObjectData(TrackedObject & object);
@@ -200,14 +235,16 @@ private:
     const TrackedObject & object, const lanelet::routing::LaneletPaths & candidate_paths,
     const float path_probability, const ManeuverProbability & maneuver_probability,
     const Maneuver & maneuver, std::vector<PredictedRefPath> & reference_paths);
-  std::vector<PosePath> convertPathType(const lanelet::routing::LaneletPaths & paths);
+  std::vector<std::shared_ptr<const ReferencePath>> convertPathType(
+    const lanelet::routing::LaneletPaths & paths);
+  PosePath convertLaneletPath(const lanelet::routing::LaneletPath & path) const;
 
   void updateFuturePossibleLanelets(
     const TrackedObject & object, const lanelet::routing::LaneletPaths & paths);
 
   bool isDuplicated(
     const std::pair<double, lanelet::ConstLanelet> & target_lanelet,
-    const LaneletsData & lanelets_data);
+    const LaneletsData & lanelets_data) const;
   bool isDuplicated(
     const PredictedPath & predicted_path, const std::vector<PredictedPath> & predicted_paths);
 
@@ -16,6 +16,7 @@
 #define MAP_BASED_PREDICTION__PATH_GENERATOR_HPP_
 
 #include <Eigen/Eigen>
+#include <interpolation/spline_interpolation.hpp>
 #include <rclcpp/rclcpp.hpp>
 
 #include <autoware_auto_perception_msgs/msg/predicted_objects.hpp>
@@ -53,6 +54,22 @@ using EntryPoint = std::pair<Eigen::Vector2d /*in*/, Eigen::Vector2d /*out*/>;
 using FrenetPath = std::vector<FrenetPoint>;
 using PosePath = std::vector<geometry_msgs::msg::Pose>;
 
+// A reference path with the splines of its coordinates along its 2d arc length, which are built
+// once and shared by all the objects following the path
+struct ReferencePath
+{
+  ReferencePath() = default;
+  explicit ReferencePath(PosePath pose_path);
+
+  PosePath path;
+  std::vector<double> arc_lengths;
+  // false when the path is too short or has duplicated points, then interpolated at each query
+  bool has_splines{false};
+  interpolation::SplineInterpolation spline_x;
+  interpolation::SplineInterpolation spline_y;
+  interpolation::SplineInterpolation spline_z;
+};
+
 class PathGenerator
 {
 public:
@@ -67,7 +84,7 @@ public:
   PredictedPath generatePathForOffLaneVehicle(const TrackedObject & object);
 
   PredictedPath generatePathForOnLaneVehicle(
-    const TrackedObject & object, const PosePath & ref_paths);
+    const TrackedObject & object, const ReferencePath & ref_path);
 
   PredictedPath generatePathForCrosswalkUser(
     const TrackedObject & object, const EntryPoint & reachable_crosswalk) const;
@@ -81,10 +98,17 @@ private:
   double sampling_time_interval_;
   double min_crosswalk_user_velocity_;
 
+  // Sampling times of the Frenet paths and their powers, shared by all the paths
+  std::vector<double> sampling_times_;
+  std::vector<double> sampling_times_pow3_;
+  std::vector<double> sampling_times_pow4_;
+  std::vector<double> sampling_times_pow5_;
+
   // Member functions
   PredictedPath generateStraightPath(const TrackedObject & object) const;
 
-  PredictedPath generatePolynomialPath(const TrackedObject & object, const PosePath & ref_path);
+  PredictedPath generatePolynomialPath(
+    const TrackedObject & object, const ReferencePath & ref_path);
 
   FrenetPath generateFrenetPath(
     const FrenetPoint & current_point, const FrenetPoint & target_point, const double max_length);
@@ -94,7 +118,7 @@ private:
     const FrenetPoint & current_point, const FrenetPoint & target_point, const double T);
 
   PosePath interpolateReferencePath(
-    const PosePath & base_path, const FrenetPath & frenet_predicted_path);
+    const ReferencePath & base_path, const FrenetPath & frenet_predicted_path);
 
   PredictedPath convertToPredictedPath(
     const TrackedObject & object, const FrenetPath & frenet_predicted_path,
@@ -35,6 +35,7 @@
 #include <chrono>
 #include <cmath>
 #include <limits>
+#include <unordered_set>
 
 namespace map_based_prediction
 {
@@ -387,6 +388,14 @@ bool hasPotentialToReach(
   return false;
 }
 
+bool isRoadUser(const TrackedObject & object)
+{
+  const auto & label = object.classification.front().label;
+  return label == ObjectClassification::CAR || label == ObjectClassification::BUS ||
+         label == ObjectClassification::TRAILER || label == ObjectClassification::MOTORCYCLE ||
+         label == ObjectClassification::TRUCK;
+}
+
 MapBasedPredictionNode::MapBasedPredictionNode(const rclcpp::NodeOptions & node_options)
 : Node("map_based_prediction", node_options), debug_accumulated_time_(0.0)
 {
@@ -411,6 +420,7 @@ MapBasedPredictionNode::MapBasedPredictionNode(const rclcpp::NodeOptions & node_
   cutoff_freq_of_velocity_lpf_ =
     declare_parameter("cutoff_freq_of_velocity_for_lane_change_detection", 0.1);  // 0.1Hz
   reference_path_resolution_ = declare_parameter("reference_path_resolution", 0.5);
+  num_threads_ = std::max(declare_parameter("num_threads", 1), 1);
 
   path_generator_ = std::make_shared<PathGenerator>(
     prediction_time_horizon_, prediction_sampling_time_interval_, min_crosswalk_user_velocity_);
@@ -463,6 +473,19 @@ void MapBasedPredictionNode::mapCallback(const HADMapBin::ConstSharedPtr msg)
   const auto walkways = lanelet::utils::query::walkwayLanelets(all_lanelets);
   crosswalks_.insert(crosswalks_.end(), crosswalks.begin(), crosswalks.end());
   crosswalks_.insert(crosswalks_.end(), walkways.begin(), walkways.end());
+
+  // the candidates and the reference paths are made of lanelets of the previous map
+  lanelet_candidates_cache_.clear();
+  {
+    std::lock_guard<std::mutex> lock(reference_paths_cache_mutex_);
+    reference_paths_cache_.clear();
+  }
+
+  // Lanelet2 computes a centerline the first time it is read, so do it here rather than from the
+  // threads predicting the objects
+  for (const auto & lanelet : all_lanelets) {
+    lanelet.centerline();
+  }
 }
 
 void MapBasedPredictionNode::objectsCallback(const TrackedObjects::ConstSharedPtr in_objects)
@@ -501,9 +524,25 @@ void MapBasedPredictionNode::objectsCallback(const TrackedObjects::ConstSharedPt
   // result debug
   visualization_msgs::msg::MarkerArray debug_markers;
 
-  for (const auto & object : in_objects->objects) {
-    std::string object_id = tier4_autoware_utils::toHexString(object.object_id);
-    TrackedObject transformed_object = object;
+  // Transform the objects and search the lanelets of the road users. Each object only reads its
+  // own history, so that the objects are processed in parallel.
+  const auto & objects = in_objects->objects;
+  std::vector<std::string> object_ids(objects.size());
+  std::vector<TrackedObject> transformed_objects(objects.size());
+  std::vector<LaneletsData> current_lanelets(objects.size());
+  std::vector<LaneletCandidates> lanelet_candidates(objects.size());
+  for (size_t i = 0; i < objects.size(); ++i) {
+    object_ids[i] = tier4_autoware_utils::toHexString(objects[i].object_id);
+    if (const auto cached = lanelet_candidates_cache_.find(object_ids[i])) {
+      lanelet_candidates[i] = *cached;
+    }
+  }
+
+#pragma omp parallel for num_threads(num_threads_)
+  for (size_t i = 0; i < objects.size(); ++i) {
+    const auto & object = objects[i];
+    TrackedObject & transformed_object = transformed_objects[i];
+    transformed_object = object;
 
     // transform object frame if it's based on map frame
     if (in_objects->header.frame_id != "map") {
@@ -514,120 +553,42 @@ void MapBasedPredictionNode::objectsCallback(const TrackedObjects::ConstSharedPt
       transformed_object.kinematics.pose_with_covariance.pose = pose_in_map.pose;
     }
 
-    const auto & label = transformed_object.classification.front().label;
-
-    // For crosswalk user
-    if (label == ObjectClassification::PEDESTRIAN || label == ObjectClassification::BICYCLE) {
-      const auto predicted_object = getPredictedObjectAsCrosswalkUser(transformed_object);
-      output.objects.push_back(predicted_object);
-      // For road user
-    } else if (
-      label == ObjectClassification::CAR || label == ObjectClassification::BUS ||
-      label == ObjectClassification::TRAILER || label == ObjectClassification::MOTORCYCLE ||
-      label == ObjectClassification::TRUCK) {
+    if (isRoadUser(transformed_object)) {
       // Update object yaw and velocity
       updateObjectData(transformed_object);
 
       // Get Closest Lanelet
-      const auto current_lanelets = getCurrentLanelets(transformed_object);
-
-      // Update Objects History
-      updateObjectsHistory(output.header, transformed_object, current_lanelets);
-
-      // For off lane obstacles
-      if (current_lanelets.empty()) {
-        PredictedPath predicted_path =
-          path_generator_->generatePathForOffLaneVehicle(transformed_object);
-        predicted_path.confidence = 1.0;
-        if (predicted_path.path.empty()) {
-          continue;
-        }
-
-        auto predicted_object = convertToPredictedObject(transformed_object);
-        predicted_object.kinematics.predicted_paths.push_back(predicted_path);
-        output.objects.push_back(predicted_object);
-        continue;
-      }
-
-      // For too-slow vehicle
-      if (
-        std::fabs(transformed_object.kinematics.twist_with_covariance.twist.linear.x) <
-        min_velocity_for_map_based_prediction_) {
-        PredictedPath predicted_path =
-          path_generator_->generatePathForLowSpeedVehicle(transformed_object);
-        predicted_path.confidence = 1.0;
-        if (predicted_path.path.empty()) {
-          continue;
-        }
-
-        auto predicted_object = convertToPredictedObject(transformed_object);
-        predicted_object.kinematics.predicted_paths.push_back(predicted_path);
-        output.objects.push_back(predicted_object);
-        continue;
-      }
-
-      // Get Predicted Reference Path for Each Maneuver and current lanelets
-      // return: <probability, paths>
-      const auto ref_paths =
-        getPredictedReferencePath(transformed_object, current_lanelets, objects_detected_time);
-
-      // If predicted reference path is empty, assume this object is out of the lane
-      if (ref_paths.empty()) {
-        PredictedPath predicted_path =
-          path_generator_->generatePathForLowSpeedVehicle(transformed_object);
-        predicted_path.confidence = 1.0;
-        if (predicted_path.path.empty()) {
-          continue;
-        }
-
-        auto predicted_object = convertToPredictedObject(transformed_object);
-        predicted_object.kinematics.predicted_paths.push_back(predicted_path);
-        output.objects.push_back(predicted_object);
-        continue;
-      }
-
-      // Get Debug Marker for On Lane Vehicles
-      const auto max_prob_path = std::max_element(
-        ref_paths.begin(), ref_paths.end(),
-        [](const PredictedRefPath & a, const PredictedRefPath & b) {
-          return a.probability < b.probability;
-        });
-      const auto debug_marker =
-        getDebugMarker(object, max_prob_path->maneuver, debug_markers.markers.size());
-      debug_markers.markers.push_back(debug_marker);
-
-      // Generate Predicted Path
-      std::vector<PredictedPath> predicted_paths;
-      for (const auto & ref_path : ref_paths) {
-        PredictedPath predicted_path =
-          path_generator_->generatePathForOnLaneVehicle(transformed_object, ref_path.path);
-        if (predicted_path.path.empty()) {
-          continue;
-        }
-        predicted_path.confidence = ref_path.probability;
-
-        predicted_paths.push_back(predicted_path);
-      }
+      current_lanelets[i] = getCurrentLanelets(transformed_object, lanelet_candidates[i]);
+    }
+  }
 
-      // Normalize Path Confidence and output the predicted object
-      {
-        float sum_confidence = 0.0;
-        for (const auto & predicted_path : predicted_paths) {
-          sum_confidence += predicted_path.confidence;
-        }
-        const float min_sum_confidence_value = 1e-3;
-        sum_confidence = std::max(sum_confidence, min_sum_confidence_value);
+  // Update Objects History
+  std::unordered_set<std::string> unique_object_ids;
+  for (size_t i = 0; i < objects.size(); ++i) {
+    unique_object_ids.insert(object_ids[i]);
+    if (isRoadUser(transformed_objects[i])) {
+      updateObjectsHistory(output.header, transformed_objects[i], current_lanelets[i]);
+      lanelet_candidates_cache_.put(object_ids[i], std::move(lanelet_candidates[i]));
+    }
+  }
 
-        for (auto & predicted_path : predicted_paths) {
-          predicted_path.confidence = predicted_path.confidence / sum_confidence;
-        }
+  // Predict the paths. The prediction of an object updates its own history, so that objects
+  // sharing an id, which a tracker does not output, are predicted one after another.
+  const int num_threads = unique_object_ids.size() == objects.size() ? num_threads_ : 1;
+  std::vector<boost::optional<PredictedObject>> predicted_objects(objects.size());
+  std::vector<boost::optional<Maneuver>> debug_maneuvers(objects.size());
+#pragma omp parallel for num_threads(num_threads)
+  for (size_t i = 0; i < objects.size(); ++i) {
+    const auto & transformed_object = transformed_objects[i];
+    const auto & label = transformed_object.classification.front().label;
 
-        auto predicted_object = convertToPredictedObject(transformed_object);
-        for (const auto & predicted_path : predicted_paths) {
-          predicted_object.kinematics.predicted_paths.push_back(predicted_path);
-        }
-        output.objects.push_back(predicted_object);
-      }
+    // For crosswalk user
+    if (label == ObjectClassification::PEDESTRIAN || label == ObjectClassification::BICYCLE) {
+      predicted_objects[i] = getPredictedObjectAsCrosswalkUser(transformed_object);
+      // For road user
+    } else if (isRoadUser(transformed_object)) {
+      predicted_objects[i] = getPredictedObjectAsRoadUser(
+        transformed_object, current_lanelets[i], objects_detected_time, debug_maneuvers[i]);
       // For unknown object
     } else {
       auto predicted_object = convertToPredictedObject(transformed_object);
@@ -636,7 +597,20 @@ void MapBasedPredictionNode::objectsCallback(const TrackedObjects::ConstSharedPt
       predicted_path.confidence = 1.0;
 
       predicted_object.kinematics.predicted_paths.push_back(predicted_path);
-      output.objects.push_back(predicted_object);
+      predicted_objects[i] = predicted_object;
+    }
+  }
+
+  // Gather the results in the order of the input
+  for (size_t i = 0; i < objects.size(); ++i) {
+    if (predicted_objects[i]) {
+      output.objects.push_back(std::move(*predicted_objects[i]));
+    }
+    // Get Debug Marker for On Lane Vehicles
+    if (debug_maneuvers[i]) {
+      const auto debug_marker =
+        getDebugMarker(objects[i], *debug_maneuvers[i], debug_markers.markers.size());
+      debug_markers.markers.push_back(debug_marker);
     }
   }
 
@@ -754,6 +728,96 @@ PredictedObject MapBasedPredictionNode::getPredictedObjectAsCrosswalkUser(
   return predicted_object;
 }
 
+boost::optional<PredictedObject> MapBasedPredictionNode::getPredictedObjectAsRoadUser(
+  const TrackedObject & object, const LaneletsData & current_lanelets,
+  const double objects_detected_time, boost::optional<Maneuver> & debug_maneuver)
+{
+  // For off lane obstacles
+  if (current_lanelets.empty()) {
+    PredictedPath predicted_path = path_generator_->generatePathForOffLaneVehicle(object);
+    predicted_path.confidence = 1.0;
+    if (predicted_path.path.empty()) {
+      return boost::none;
+    }
+
+    auto predicted_object = convertToPredictedObject(object);
+    predicted_object.kinematics.predicted_paths.push_back(predicted_path);
+    return predicted_object;
+  }
+
+  // For too-slow vehicle
+  if (
+    std::fabs(object.kinematics.twist_with_covariance.twist.linear.x) <
+    min_velocity_for_map_based_prediction_) {
+    PredictedPath predicted_path = path_generator_->generatePathForLowSpeedVehicle(object);
+    predicted_path.confidence = 1.0;
+    if (predicted_path.path.empty()) {
+      return boost::none;
+    }
+
+    auto predicted_object = convertToPredictedObject(object);
+    predicted_object.kinematics.predicted_paths.push_back(predicted_path);
+    return predicted_object;
+  }
+
+  // Get Predicted Reference Path for Each Maneuver and current lanelets
+  // return: <probability, paths>
+  const auto ref_paths =
+    getPredictedReferencePath(object, current_lanelets, objects_detected_time);
+
+  // If predicted reference path is empty, assume this object is out of the lane
+  if (ref_paths.empty()) {
+    PredictedPath predicted_path = path_generator_->generatePathForLowSpeedVehicle(object);
+    predicted_path.confidence = 1.0;
+    if (predicted_path.path.empty()) {
+      return boost::none;
+    }
+
+    auto predicted_object = convertToPredictedObject(object);
+    predicted_object.kinematics.predicted_paths.push_back(predicted_path);
+    return predicted_object;
+  }
+
+  // Maneuver of the debug marker
+  const auto max_prob_path = std::max_element(
+    ref_paths.begin(), ref_paths.end(),
+    [](const PredictedRefPath & a, const PredictedRefPath & b) {
+      return a.probability < b.probability;
+    });
+  debug_maneuver = max_prob_path->maneuver;
+
+  // Generate Predicted Path
+  std::vector<PredictedPath> predicted_paths;
+  for (const auto & ref_path : ref_paths) {
+    PredictedPath predicted_path =
+      path_generator_->generatePathForOnLaneVehicle(object, *ref_path.path);
+    if (predicted_path.path.empty()) {
+      continue;
+    }
+    predicted_path.confidence = ref_path.probability;
+
+    predicted_paths.push_back(predicted_path);
+  }
+
+  // Normalize Path Confidence and output the predicted object
+  float sum_confidence = 0.0;
+  for (const auto & predicted_path : predicted_paths) {
+    sum_confidence += predicted_path.confidence;
+  }
+  const float min_sum_confidence_value = 1e-3;
+  sum_confidence = std::max(sum_confidence, min_sum_confidence_value);
+
+  for (auto & predicted_path : predicted_paths) {
+    predicted_path.confidence = predicted_path.confidence / sum_confidence;
+  }
+
+  auto predicted_object = convertToPredictedObject(object);
+  for (const auto & predicted_path : predicted_paths) {
+    predicted_object.kinematics.predicted_paths.push_back(predicted_path);
+  }
+  return predicted_object;
+}
+
 void MapBasedPredictionNode::updateObjectData(TrackedObject & object)
 {
   if (
@@ -834,7 +898,8 @@ void MapBasedPredictionNode::removeOldObjectsHistory(const double current_time)
   }
 }
 
-LaneletsData MapBasedPredictionNode::getCurrentLanelets(const TrackedObject & object)
+LaneletsData MapBasedPredictionNode::getCurrentLanelets(
+  const TrackedObject & object, LaneletCandidates & lanelet_candidates) const
 {
   // obstacle point
   lanelet::BasicPoint2d search_point(
@@ -842,8 +907,32 @@ LaneletsData MapBasedPredictionNode::getCurrentLanelets(const TrackedObject & ob
     object.kinematics.pose_with_covariance.pose.position.y);
 
   // nearest lanelet
-  std::vector<std::pair<double, lanelet::Lanelet>> surrounding_lanelets =
-    lanelet::geometry::findNearest(lanelet_map_ptr_->laneletLayer, search_point, 10);
+  constexpr size_t num_nearest_lanelets = 10;
+  std::vector<std::pair<double, lanelet::Lanelet>> surrounding_lanelets;
+  const double moved_distance = (search_point - lanelet_candidates.search_point).norm();
+  if (moved_distance < lanelet_candidates.valid_radius) {
+    // The other lanelets are farther than valid_radius - moved_distance > 0, so that they cannot
+    // contain the object, which the close lanelet condition requires.
+    for (const auto & lanelet : lanelet_candidates.lanelets) {
+      surrounding_lanelets.emplace_back(
+        lanelet::geometry::distance2d(lanelet, search_point), lanelet);
+    }
+    std::stable_sort(
+      surrounding_lanelets.begin(), surrounding_lanelets.end(),
+      [](const auto & a, const auto & b) { return a.first < b.first; });
+  } else {
+    surrounding_lanelets = lanelet::geometry::findNearest(
+      lanelet_map_ptr_->laneletLayer, search_point, num_nearest_lanelets);
+
+    lanelet_candidates.search_point = search_point;
+    lanelet_candidates.valid_radius = surrounding_lanelets.size() < num_nearest_lanelets
+                                        ? std::numeric_limits<double>::max()
+                                        : surrounding_lanelets.back().first;
+    lanelet_candidates.lanelets.clear();
+    for (const auto & lanelet : surrounding_lanelets) {
+      lanelet_candidates.lanelets.push_back(lanelet.second);
+    }
+  }
 
   // No Closest Lanelets
   if (surrounding_lanelets.empty()) {
@@ -871,7 +960,7 @@ LaneletsData MapBasedPredictionNode::getCurrentLanelets(const TrackedObject & ob
 
 bool MapBasedPredictionNode::checkCloseLaneletCondition(
   const std::pair<double, lanelet::Lanelet> & lanelet, const TrackedObject & object,
-  const lanelet::BasicPoint2d & search_point)
+  const lanelet::BasicPoint2d & search_point) const
 {
   // Step1. If we only have one point in the centerline, we will ignore the lanelet
   if (lanelet.second.centerline().size() <= 1) {
@@ -1290,42 +1379,49 @@ ManeuverProbability MapBasedPredictionNode::calculateManeuverProbability(
   return maneuver_prob;
 }
 
-std::vector<PosePath> MapBasedPredictionNode::convertPathType(
+std::vector<std::shared_ptr<const ReferencePath>> MapBasedPredictionNode::convertPathType(
   const lanelet::routing::LaneletPaths & paths)
 {
-  std::vector<PosePath> converted_paths;
+  std::vector<std::shared_ptr<const ReferencePath>> converted_paths;
   for (const auto & path : paths) {
-    PosePath converted_path;
-
-    // Insert Positions. Note that we start inserting points from previous lanelet
-    if (!path.empty()) {
-      lanelet::ConstLanelets prev_lanelets = routing_graph_ptr_->previous(path.front());
-      if (!prev_lanelets.empty()) {
-        lanelet::ConstLanelet prev_lanelet = prev_lanelets.front();
-        bool init_flag = true;
-        geometry_msgs::msg::Pose prev_p;
-        for (const auto & lanelet_p : prev_lanelet.centerline()) {
-          geometry_msgs::msg::Pose current_p;
-          current_p.position = lanelet::utils::conversion::toGeomMsgPt(lanelet_p);
-          if (init_flag) {
-            init_flag = false;
-            prev_p = current_p;
-            continue;
-          }
-
-          const double lane_yaw = std::atan2(
-            current_p.position.y - prev_p.position.y, current_p.position.x - prev_p.position.x);
-          current_p.orientation = tier4_autoware_utils::createQuaternionFromYaw(lane_yaw);
-          converted_path.push_back(current_p);
-          prev_p = current_p;
-        }
+    std::vector<lanelet::Id> lanelet_ids;
+    for (const auto & lanelet : path) {
+      lanelet_ids.push_back(lanelet.id());
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(reference_paths_cache_mutex_);
+      if (const auto cached_path = reference_paths_cache_.get(lanelet_ids)) {
+        converted_paths.push_back(*cached_path);
+        continue;
       }
     }
 
-    for (const auto & lanelet : path) {
+    // built out of the lock, a path missed by several threads at once is only built twice
+    const auto converted_path = std::make_shared<const ReferencePath>(convertLaneletPath(path));
+    {
+      std::lock_guard<std::mutex> lock(reference_paths_cache_mutex_);
+      reference_paths_cache_.put(lanelet_ids, converted_path);
+    }
+    converted_paths.push_back(converted_path);
+  }
+
+  return converted_paths;
+}
+
+PosePath MapBasedPredictionNode::convertLaneletPath(
+  const lanelet::routing::LaneletPath & path) const
+{
+  PosePath converted_path;
+
+  // Insert Positions. Note that we start inserting points from previous lanelet
+  if (!path.empty()) {
+    lanelet::ConstLanelets prev_lanelets = routing_graph_ptr_->previous(path.front());
+    if (!prev_lanelets.empty()) {
+      lanelet::ConstLanelet prev_lanelet = prev_lanelets.front();
       bool init_flag = true;
       geometry_msgs::msg::Pose prev_p;
-      for (const auto & lanelet_p : lanelet.centerline()) {
+      for (const auto & lanelet_p : prev_lanelet.centerline()) {
         geometry_msgs::msg::Pose current_p;
         current_p.position = lanelet::utils::conversion::toGeomMsgPt(lanelet_p);
         if (init_flag) {
@@ -1334,16 +1430,6 @@ std::vector<PosePath> MapBasedPredictionNode::convertPathType(
           continue;
         }
 
-        // Prevent from inserting same points
-        if (!converted_path.empty()) {
-          const auto last_p = converted_path.back();
-          const double tmp_dist = tier4_autoware_utils::calcDistance2d(last_p, current_p);
-          if (tmp_dist < 1e-6) {
-            prev_p = current_p;
-            continue;
-          }
-        }
-
         const double lane_yaw = std::atan2(
           current_p.position.y - prev_p.position.y, current_p.position.x - prev_p.position.x);
         current_p.orientation = tier4_autoware_utils::createQuaternionFromYaw(lane_yaw);
@@ -1351,19 +1437,45 @@ std::vector<PosePath> MapBasedPredictionNode::convertPathType(
         prev_p = current_p;
       }
     }
+  }
+
+  for (const auto & lanelet : path) {
+    bool init_flag = true;
+    geometry_msgs::msg::Pose prev_p;
+    for (const auto & lanelet_p : lanelet.centerline()) {
+      geometry_msgs::msg::Pose current_p;
+      current_p.position = lanelet::utils::conversion::toGeomMsgPt(lanelet_p);
+      if (init_flag) {
+        init_flag = false;
+        prev_p = current_p;
+        continue;
+      }
 
-    // Resample Path
-    const auto resampled_converted_path =
-      motion_utils::resamplePoseVector(converted_path, reference_path_resolution_);
-    converted_paths.push_back(resampled_converted_path);
+      // Prevent from inserting same points
+      if (!converted_path.empty()) {
+        const auto last_p = converted_path.back();
+        const double tmp_dist = tier4_autoware_utils::calcDistance2d(last_p, current_p);
+        if (tmp_dist < 1e-6) {
+          prev_p = current_p;
+          continue;
+        }
+      }
+
+      const double lane_yaw = std::atan2(
+        current_p.position.y - prev_p.position.y, current_p.position.x - prev_p.position.x);
+      current_p.orientation = tier4_autoware_utils::createQuaternionFromYaw(lane_yaw);
+      converted_path.push_back(current_p);
+      prev_p = current_p;
+    }
   }
 
-  return converted_paths;
+  // Resample Path
+  return motion_utils::resamplePoseVector(converted_path, reference_path_resolution_);
 }
 
 bool MapBasedPredictionNode::isDuplicated(
   const std::pair<double, lanelet::ConstLanelet> & target_lanelet,
-  const LaneletsData & lanelets_data)
+  const LaneletsData & lanelets_data) const
 {
   const double CLOSE_LANELET_THRESHOLD = 0.1;
   for (const auto & lanelet_data : lanelets_data) {
@@ -19,9 +19,38 @@
 #include <tier4_autoware_utils/tier4_autoware_utils.hpp>
 
 #include <algorithm>
+#include <cmath>
+#include <utility>
 
 namespace map_based_prediction
 {
+ReferencePath::ReferencePath(PosePath pose_path) : path(std::move(pose_path))
+{
+  arc_lengths.assign(path.size(), 0.0);
+  bool is_increasing = path.size() >= 2;
+  for (size_t i = 1; i < path.size(); ++i) {
+    arc_lengths.at(i) =
+      arc_lengths.at(i - 1) + tier4_autoware_utils::calcDistance2d(path.at(i - 1), path.at(i));
+    is_increasing = is_increasing && arc_lengths.at(i - 1) < arc_lengths.at(i);
+  }
+  if (!is_increasing) {
+    return;
+  }
+
+  std::vector<double> x(path.size());
+  std::vector<double> y(path.size());
+  std::vector<double> z(path.size());
+  for (size_t i = 0; i < path.size(); ++i) {
+    x.at(i) = path.at(i).position.x;
+    y.at(i) = path.at(i).position.y;
+    z.at(i) = path.at(i).position.z;
+  }
+  spline_x = interpolation::SplineInterpolation(arc_lengths, x);
+  spline_y = interpolation::SplineInterpolation(arc_lengths, y);
+  spline_z = interpolation::SplineInterpolation(arc_lengths, z);
+  has_splines = true;
+}
+
 PathGenerator::PathGenerator(
   const double time_horizon, const double sampling_time_interval,
   const double min_crosswalk_user_velocity)
@@ -29,6 +58,12 @@ PathGenerator::PathGenerator(
   sampling_time_interval_(sampling_time_interval),
   min_crosswalk_user_velocity_(min_crosswalk_user_velocity)
 {
+  for (double t = 0.0; t <= time_horizon_; t += sampling_time_interval_) {
+    sampling_times_.push_back(t);
+    sampling_times_pow3_.push_back(std::pow(t, 3));
+    sampling_times_pow4_.push_back(std::pow(t, 4));
+    sampling_times_pow5_.push_back(std::pow(t, 5));
+  }
 }
 
 PredictedPath PathGenerator::generatePathForNonVehicleObject(const TrackedObject & object)
@@ -147,13 +182,13 @@ PredictedPath PathGenerator::generatePathForOffLaneVehicle(const TrackedObject &
 }
 
 PredictedPath PathGenerator::generatePathForOnLaneVehicle(
-  const TrackedObject & object, const PosePath & ref_paths)
+  const TrackedObject & object, const ReferencePath & ref_path)
 {
-  if (ref_paths.size() < 2) {
+  if (ref_path.path.size() < 2) {
     return generateStraightPath(object);
   }
 
-  return generatePolynomialPath(object, ref_paths);
+  return generatePolynomialPath(object, ref_path);
 }
 
 PredictedPath PathGenerator::generateStraightPath(const TrackedObject & object) const
@@ -176,11 +211,11 @@ PredictedPath PathGenerator::generateStraightPath(const TrackedObject & object)
 }
 
 PredictedPath PathGenerator::generatePolynomialPath(
-  const TrackedObject & object, const PosePath & ref_path)
+  const TrackedObject & object, const ReferencePath & ref_path)
 {
   // Get current Frenet Point
-  const double ref_path_len = motion_utils::calcArcLength(ref_path);
-  const auto current_point = getFrenetPoint(object, ref_path);
+  const double ref_path_len = motion_utils::calcArcLength(ref_path.path);
+  const auto current_point = getFrenetPoint(object, ref_path.path);
 
   // Step1. Set Target Frenet Point
   // Note that we do not set position s,
@@ -217,23 +252,41 @@ FrenetPath PathGenerator::generateFrenetPath(
   const Eigen::Vector3d lat_coeff = calcLatCoefficients(current_point, target_point, duration);
   const Eigen::Vector2d lon_coeff = calcLonCoefficients(current_point, target_point, duration);
 
-  path.reserve(static_cast<size_t>(duration / sampling_time_interval_));
-  for (double t = 0.0; t <= duration; t += sampling_time_interval_) {
-    const double d_next = current_point.d + current_point.d_vel * t + 0 * 2 * std::pow(t, 2) +
-                          lat_coeff(0) * std::pow(t, 3) + lat_coeff(1) * std::pow(t, 4) +
-                          lat_coeff(2) * std::pow(t, 5);
-    const double s_next = current_point.s + current_point.s_vel * t + 2 * 0 * std::pow(t, 2) +
-                          lon_coeff(0) * std::pow(t, 3) + lon_coeff(1) * std::pow(t, 4);
-    if (s_next > max_length) {
+  // Evaluate the polynomials on the precomputed powers of the sampling times, in loops over
+  // contiguous arrays which the compiler vectorizes
+  const size_t num_samples = sampling_times_.size();
+  const double d0 = current_point.d;
+  const double d1 = current_point.d_vel;
+  const double d3 = lat_coeff(0);
+  const double d4 = lat_coeff(1);
+  const double d5 = lat_coeff(2);
+  const double s0 = current_point.s;
+  const double s1 = current_point.s_vel;
+  const double s3 = lon_coeff(0);
+  const double s4 = lon_coeff(1);
+  std::vector<double> d_next(num_samples);
+  std::vector<double> s_next(num_samples);
+  for (size_t i = 0; i < num_samples; ++i) {
+    d_next[i] = d0 + d1 * sampling_times_[i] + d3 * sampling_times_pow3_[i] +
+                d4 * sampling_times_pow4_[i] + d5 * sampling_times_pow5_[i];
+  }
+  for (size_t i = 0; i < num_samples; ++i) {
+    s_next[i] = s0 + s1 * sampling_times_[i] + s3 * sampling_times_pow3_[i] +
+                s4 * sampling_times_pow4_[i];
+  }
+
+  path.reserve(num_samples);
+  for (size_t i = 0; i < num_samples; ++i) {
+    if (s_next[i] > max_length) {
       break;
     }
 
     // We assume the object is traveling at a constant speed along s direction
     FrenetPoint point;
-    point.s = std::max(s_next, 0.0);
+    point.s = std::max(s_next[i], 0.0);
     point.s_vel = current_point.s_vel;
     point.s_acc = current_point.s_acc;
-    point.d = d_next;
+    point.d = d_next[i];
     point.d_vel = current_point.d_vel;
     point.d_acc = current_point.d_acc;
     path.push_back(point);
@@ -287,29 +340,15 @@ Eigen::Vector2d PathGenerator::calcLonCoefficients(
 }
 
 PosePath PathGenerator::interpolateReferencePath(
-  const PosePath & base_path, const FrenetPath & frenet_predicted_path)
+  const ReferencePath & base_path, const FrenetPath & frenet_predicted_path)
 {
   PosePath interpolated_path;
   const size_t interpolate_num = frenet_predicted_path.size();
   if (interpolate_num < 2) {
-    interpolated_path.emplace_back(base_path.front());
+    interpolated_path.emplace_back(base_path.path.front());
     return interpolated_path;
   }
 
-  std::vector<double> base_path_x(base_path.size());
-  std::vector<double> base_path_y(base_path.size());
-  std::vector<double> base_path_z(base_path.size());
-  std::vector<double> base_path_s(base_path.size(), 0.0);
-  for (size_t i = 0; i < base_path.size(); ++i) {
-    base_path_x.at(i) = base_path.at(i).position.x;
-    base_path_y.at(i) = base_path.at(i).position.y;
-    base_path_z.at(i) = base_path.at(i).position.z;
-    if (i > 0) {
-      base_path_s.at(i) = base_path_s.at(i - 1) + tier4_autoware_utils::calcDistance2d(
-                                                    base_path.at(i - 1), base_path.at(i));
-    }
-  }
-
   std::vector<double> resampled_s(frenet_predicted_path.size());
   for (size_t i = 0; i < frenet_predicted_path.size(); ++i) {
     resampled_s.at(i) = frenet_predicted_path.at(i).s;
@@ -319,12 +358,20 @@ PosePath PathGenerator::interpolateReferencePath(
   }
 
   // Spline Interpolation
-  std::vector<double> spline_ref_path_x =
-    interpolation::spline(base_path_s, base_path_x, resampled_s);
-  std::vector<double> spline_ref_path_y =
-    interpolation::spline(base_path_s, base_path_y, resampled_s);
-  std::vector<double> spline_ref_path_z =
-    interpolation::spline(base_path_s, base_path_z, resampled_s);
+  const auto interpolate = [&](const interpolation::SplineInterpolation & spline, auto get_value) {
+    if (base_path.has_splines) {
+      return spline.getSplineInterpolatedValues(resampled_s);
+    }
+    std::vector<double> values(base_path.path.size());
+    std::transform(base_path.path.begin(), base_path.path.end(), values.begin(), get_value);
+    return interpolation::spline(base_path.arc_lengths, values, resampled_s);
+  };
+  const std::vector<double> spline_ref_path_x =
+    interpolate(base_path.spline_x, [](const auto & pose) { return pose.position.x; });
+  const std::vector<double> spline_ref_path_y =
+    interpolate(base_path.spline_y, [](const auto & pose) { return pose.position.y; });
+  const std::vector<double> spline_ref_path_z =
+    interpolate(base_path.spline_z, [](const auto & pose) { return pose.position.z; });
 
   interpolated_path.resize(interpolate_num);
   for (size_t i = 0; i < interpolate_num - 1; ++i) {
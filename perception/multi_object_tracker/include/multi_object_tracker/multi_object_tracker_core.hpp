@@ -41,9 +41,9 @@
 #include <tf2_ros/buffer.h>
 #include <tf2_ros/transform_listener.h>
 
-#include <list>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <string>
 #include <vector>
 
@@ -69,17 +69,21 @@ private:
   void onTimer();
 
   std::string world_frame_id_;  // tracking frame
-  std::list<std::shared_ptr<Tracker>> list_tracker_;
+  int num_threads_;             // threads predicting the trackers
+  // Trackers are allocated from pooled blocks recycled by size, declared before the trackers so
+  // that it outlives them. The handles are kept contiguous in creation order.
+  std::pmr::unsynchronized_pool_resource tracker_memory_pool_;
+  std::vector<std::shared_ptr<Tracker>> trackers_;
   std::unique_ptr<DataAssociation> data_association_;
 
   void checkTrackerLifeCycle(
-    std::list<std::shared_ptr<Tracker>> & list_tracker, const rclcpp::Time & time,
+    std::vector<std::shared_ptr<Tracker>> & trackers, const rclcpp::Time & time,
     const geometry_msgs::msg::Transform & self_transform);
   void sanitizeTracker(
-    std::list<std::shared_ptr<Tracker>> & list_tracker, const rclcpp::Time & time);
+    std::vector<std::shared_ptr<Tracker>> & trackers, const rclcpp::Time & time);
   std::shared_ptr<Tracker> createNewTracker(
     const autoware_auto_perception_msgs::msg::DetectedObject & object, const rclcpp::Time & time,
-    const geometry_msgs::msg::Transform & self_transform) const;
+    const geometry_msgs::msg::Transform & self_transform);
 
   void publish(const rclcpp::Time & time) const;
   inline bool shouldTrackerPublish(const std::shared_ptr<const Tracker> tracker) const;
@@ -19,7 +19,8 @@
 #include "perception_utils/perception_utils.hpp"
 
 #include <algorithm>
-#include <list>
+#include <cmath>
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -48,12 +49,9 @@ Eigen::Matrix2d getXYCovariance(const geometry_msgs::msg::PoseWithCovariance & p
 }
 
 double getFormedYawAngle(
-  const geometry_msgs::msg::Quaternion & measurement_quat,
-  const geometry_msgs::msg::Quaternion & tracker_quat, const bool distinguish_front_or_back = true)
+  const double measurement_yaw, const double tracker_yaw,
+  const bool distinguish_front_or_back = true)
 {
-  const double measurement_yaw =
-    tier4_autoware_utils::normalizeRadian(tf2::getYaw(measurement_quat));
-  const double tracker_yaw = tier4_autoware_utils::normalizeRadian(tf2::getYaw(tracker_quat));
   const double angle_range = distinguish_front_or_back ? M_PI : M_PI_2;
   const double angle_step = distinguish_front_or_back ? 2.0 * M_PI : M_PI;
   // Fixed measurement_yaw to be in the range of +-90 or 180 degrees of X_t(IDX::YAW)
@@ -66,6 +64,11 @@ double getFormedYawAngle(
   }
   return std::fabs(measurement_fixed_yaw - tracker_yaw);
 }
+
+double getNormalizedYaw(const geometry_msgs::msg::Quaternion & quat)
+{
+  return tier4_autoware_utils::normalizeRadian(tf2::getYaw(quat));
+}
 }  // namespace
 
 DataAssociation::DataAssociation(
@@ -111,6 +114,16 @@ DataAssociation::DataAssociation(
     min_iou_matrix_ = min_iou_matrix_tmp.transpose();
   }
 
+  // largest distance gate among the assignable label pairs, the cell size of the tracker grid
+  max_dist_upper_bound_ = 0.0;
+  for (int row = 0; row < can_assign_matrix_.rows(); ++row) {
+    for (int col = 0; col < can_assign_matrix_.cols(); ++col) {
+      if (can_assign_matrix_(row, col)) {
+        max_dist_upper_bound_ = std::max(max_dist_upper_bound_, max_dist_matrix_(row, col));
+      }
+    }
+  }
+
   gnn_solver_ptr_ = std::make_unique<gnn_solver::MuSSP>();
 }
 
@@ -148,76 +161,105 @@ void DataAssociation::assign(
 
 Eigen::MatrixXd DataAssociation::calcScoreMatrix(
   const autoware_auto_perception_msgs::msg::DetectedObjects & measurements,
-  const std::list<std::shared_ptr<Tracker>> & trackers)
+  const std::vector<std::shared_ptr<Tracker>> & trackers)
 {
   Eigen::MatrixXd score_matrix =
     Eigen::MatrixXd::Zero(trackers.size(), measurements.objects.size());
-  size_t tracker_idx = 0;
-  for (auto tracker_itr = trackers.begin(); tracker_itr != trackers.end();
-       ++tracker_itr, ++tracker_idx) {
-    const std::uint8_t tracker_label = (*tracker_itr)->getHighestProbLabel();
-
-    for (size_t measurement_idx = 0; measurement_idx < measurements.objects.size();
-         ++measurement_idx) {
-      const autoware_auto_perception_msgs::msg::DetectedObject & measurement_object =
-        measurements.objects.at(measurement_idx);
-      const std::uint8_t measurement_label =
-        perception_utils::getHighestProbLabel(measurement_object.classification);
-
-      double score = 0.0;
-      if (can_assign_matrix_(tracker_label, measurement_label)) {
-        autoware_auto_perception_msgs::msg::TrackedObject tracked_object;
-        (*tracker_itr)->getTrackedObject(measurements.header.stamp, tracked_object);
-
-        const double max_dist = max_dist_matrix_(tracker_label, measurement_label);
-        const double dist = tier4_autoware_utils::calcDistance2d(
-          measurement_object.kinematics.pose_with_covariance.pose.position,
-          tracked_object.kinematics.pose_with_covariance.pose.position);
-
-        bool passed_gate = true;
-        // dist gate
-        if (passed_gate) {
-          if (max_dist < dist) passed_gate = false;
-        }
-        // area gate
-        if (passed_gate) {
-          const double max_area = max_area_matrix_(tracker_label, measurement_label);
-          const double min_area = min_area_matrix_(tracker_label, measurement_label);
-          const double area = tier4_autoware_utils::getArea(measurement_object.shape);
-          if (area < min_area || max_area < area) passed_gate = false;
-        }
-        // angle gate
-        if (passed_gate) {
-          const double max_rad = max_rad_matrix_(tracker_label, measurement_label);
-          const double angle = getFormedYawAngle(
-            measurement_object.kinematics.pose_with_covariance.pose.orientation,
-            tracked_object.kinematics.pose_with_covariance.pose.orientation, false);
-          if (std::fabs(max_rad) < M_PI && std::fabs(max_rad) < std::fabs(angle))
-            passed_gate = false;
-        }
-        // mahalanobis dist gate
-        if (passed_gate) {
-          const double mahalanobis_dist = getMahalanobisDistance(
-            measurement_object.kinematics.pose_with_covariance.pose.position,
-            tracked_object.kinematics.pose_with_covariance.pose.position,
-            getXYCovariance(tracked_object.kinematics.pose_with_covariance));
-          if (2.448 /*95%*/ <= mahalanobis_dist) passed_gate = false;
-        }
-        // 2d iou gate
-        if (passed_gate) {
-          const double min_iou = min_iou_matrix_(tracker_label, measurement_label);
-          const double min_union_iou_area = 1e-2;
-          const double iou =
-            perception_utils::get2dIoU(measurement_object, tracked_object, min_union_iou_area);
-          if (iou < min_iou) passed_gate = false;
-        }
-
-        // all gate is passed
-        if (passed_gate) {
-          score = (max_dist - std::min(dist, max_dist)) / max_dist;
-          if (score < score_threshold_) score = 0.0;
-        }
+
+  // predict every tracker once, the gates read its state from flat arrays
+  const size_t num_trackers = trackers.size();
+  std::vector<autoware_auto_perception_msgs::msg::TrackedObject> tracked_objects(num_trackers);
+  std::vector<std::uint8_t> tracker_labels(num_trackers);
+  std::vector<double> tracker_xs(num_trackers);
+  std::vector<double> tracker_ys(num_trackers);
+  std::vector<double> tracker_yaws(num_trackers);
+  std::vector<Eigen::Matrix2d> tracker_inverse_covariances(num_trackers);
+  std::vector<perception_utils::MatchingPolygon2d> tracker_polygons;
+  tracker_polygons.reserve(num_trackers);
+  {
+    size_t tracker_idx = 0;
+    for (auto tracker_itr = trackers.begin(); tracker_itr != trackers.end();
+         ++tracker_itr, ++tracker_idx) {
+      auto & tracked_object = tracked_objects.at(tracker_idx);
+      (*tracker_itr)->getTrackedObject(measurements.header.stamp, tracked_object);
+      const auto & pose_with_covariance = tracked_object.kinematics.pose_with_covariance;
+      tracker_labels.at(tracker_idx) = (*tracker_itr)->getHighestProbLabel();
+      tracker_xs.at(tracker_idx) = pose_with_covariance.pose.position.x;
+      tracker_ys.at(tracker_idx) = pose_with_covariance.pose.position.y;
+      tracker_yaws.at(tracker_idx) = getNormalizedYaw(pose_with_covariance.pose.orientation);
+      tracker_inverse_covariances.at(tracker_idx) =
+        getXYCovariance(pose_with_covariance).inverse();
+      tracker_polygons.push_back(perception_utils::toMatchingPolygon2d(tracked_object));
+    }
+  }
+
+  // without a finite bound on the distance gate, every pair is a candidate
+  perception_utils::CentroidGrid tracker_grid;
+  tracker_grid.build(tracker_xs, tracker_ys, max_dist_upper_bound_);
+  std::vector<size_t> candidates;
+
+  for (size_t measurement_idx = 0; measurement_idx < measurements.objects.size();
+       ++measurement_idx) {
+    const autoware_auto_perception_msgs::msg::DetectedObject & measurement_object =
+      measurements.objects.at(measurement_idx);
+    const std::uint8_t measurement_label =
+      perception_utils::getHighestProbLabel(measurement_object.classification);
+    const auto & measurement_pose = measurement_object.kinematics.pose_with_covariance.pose;
+    const double measurement_x = measurement_pose.position.x;
+    const double measurement_y = measurement_pose.position.y;
+    const double area = tier4_autoware_utils::getArea(measurement_object.shape);
+    const double measurement_yaw = getNormalizedYaw(measurement_pose.orientation);
+    const auto measurement_polygon = perception_utils::toMatchingPolygon2d(measurement_object);
+
+    tracker_grid.queryCandidates(measurement_x, measurement_y, max_dist_upper_bound_, candidates);
+
+    for (const size_t tracker_idx : candidates) {
+      const std::uint8_t tracker_label = tracker_labels.at(tracker_idx);
+      if (!can_assign_matrix_(tracker_label, measurement_label)) {
+        continue;
+      }
+
+      // dist gate
+      const double max_dist = max_dist_matrix_(tracker_label, measurement_label);
+      const double dist = std::hypot(
+        measurement_x - tracker_xs.at(tracker_idx), measurement_y - tracker_ys.at(tracker_idx));
+      if (max_dist < dist) {
+        continue;
       }
+      // area gate
+      {
+        const double max_area = max_area_matrix_(tracker_label, measurement_label);
+        const double min_area = min_area_matrix_(tracker_label, measurement_label);
+        if (area < min_area || max_area < area) continue;
+      }
+      // angle gate
+      {
+        const double max_rad = max_rad_matrix_(tracker_label, measurement_label);
+        const double angle =
+          getFormedYawAngle(measurement_yaw, tracker_yaws.at(tracker_idx), false);
+        if (std::fabs(max_rad) < M_PI && std::fabs(max_rad) < std::fabs(angle)) continue;
+      }
+      // mahalanobis dist gate
+      {
+        Eigen::Vector2d diff;
+        diff << measurement_x - tracker_xs.at(tracker_idx),
+          measurement_y - tracker_ys.at(tracker_idx);
+        const double mahalanobis_squared =
+          (diff.transpose() * tracker_inverse_covariances.at(tracker_idx) * diff)(0);
+        if (2.448 /*95%*/ <= std::sqrt(mahalanobis_squared)) continue;
+      }
+      // 2d iou gate
+      {
+        const double min_iou = min_iou_matrix_(tracker_label, measurement_label);
+        const double min_union_iou_area = 1e-2;
+        const double iou = perception_utils::get2dIoU(
+          measurement_polygon, tracker_polygons.at(tracker_idx), min_union_iou_area);
+        if (iou < min_iou) continue;
+      }
+
+      // all gate is passed
+      double score = (max_dist - std::min(dist, max_dist)) / max_dist;
+      if (score < score_threshold_) score = 0.0;
       score_matrix(tracker_idx, measurement_idx) = score;
     }
   }
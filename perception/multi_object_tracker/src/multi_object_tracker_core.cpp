@@ -19,8 +19,8 @@
 #include <tf2_ros/create_timer_interface.h>
 #include <tf2_ros/create_timer_ros.h>
 
-#include <iterator>
-#include <list>
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -29,6 +29,7 @@
 
 #define EIGEN_MPL2_ONLY
 #include "multi_object_tracker/multi_object_tracker_core.hpp"
+
 #include "multi_object_tracker/utils/utils.hpp"
 #include "perception_utils/perception_utils.hpp"
 
@@ -63,6 +64,15 @@ boost::optional<geometry_msgs::msg::Transform> getTransformAnonymous(
   }
 }
 
+template <class TrackerType>
+std::shared_ptr<Tracker> makeTracker(
+  std::pmr::memory_resource * memory_pool, const rclcpp::Time & time,
+  const autoware_auto_perception_msgs::msg::DetectedObject & object,
+  const geometry_msgs::msg::Transform & self_transform)
+{
+  return std::allocate_shared<TrackerType>(
+    std::pmr::polymorphic_allocator<TrackerType>(memory_pool), time, object, self_transform);
+}
 }  // namespace
 
 MultiObjectTracker::MultiObjectTracker(const rclcpp::NodeOptions & node_options)
@@ -81,6 +91,7 @@ MultiObjectTracker::MultiObjectTracker(const rclcpp::NodeOptions & node_options)
   double publish_rate = declare_parameter<double>("publish_rate", 30.0);
   world_frame_id_ = declare_parameter<std::string>("world_frame_id", "world");
   bool enable_delay_compensation{declare_parameter("enable_delay_compensation", false)};
+  num_threads_ = std::max(declare_parameter<int>("num_threads", 1), 1);
 
   auto cti = std::make_shared<tf2_ros::CreateTimerROS>(
     this->get_node_base_interface(), this->get_node_timers_interface());
@@ -140,34 +151,33 @@ void MultiObjectTracker::onMeasurement(
   }
   /* tracker prediction */
   rclcpp::Time measurement_time = input_objects_msg->header.stamp;
-  for (auto itr = list_tracker_.begin(); itr != list_tracker_.end(); ++itr) {
-    (*itr)->predict(measurement_time);
+#pragma omp parallel for num_threads(num_threads_)
+  for (size_t tracker_idx = 0; tracker_idx < trackers_.size(); ++tracker_idx) {
+    trackers_.at(tracker_idx)->predict(measurement_time);
   }
 
   /* global nearest neighbor */
   std::unordered_map<int, int> direct_assignment, reverse_assignment;
   Eigen::MatrixXd score_matrix = data_association_->calcScoreMatrix(
-    transformed_objects, list_tracker_);  // row : tracker, col : measurement
+    transformed_objects, trackers_);  // row : tracker, col : measurement
   data_association_->assign(score_matrix, direct_assignment, reverse_assignment);
 
   /* tracker measurement update */
-  int tracker_idx = 0;
-  for (auto tracker_itr = list_tracker_.begin(); tracker_itr != list_tracker_.end();
-       ++tracker_itr, ++tracker_idx) {
+  for (size_t tracker_idx = 0; tracker_idx < trackers_.size(); ++tracker_idx) {
+    const auto & tracker = trackers_.at(tracker_idx);
     if (direct_assignment.find(tracker_idx) != direct_assignment.end()) {  // found
-      (*(tracker_itr))
-        ->updateWithMeasurement(
-          transformed_objects.objects.at(direct_assignment.find(tracker_idx)->second),
-          measurement_time, *self_transform);
+      tracker->updateWithMeasurement(
+        transformed_objects.objects.at(direct_assignment.find(tracker_idx)->second),
+        measurement_time, *self_transform);
     } else {  // not found
-      (*(tracker_itr))->updateWithoutMeasurement();
+      tracker->updateWithoutMeasurement();
     }
   }
 
   /* life cycle check */
-  checkTrackerLifeCycle(list_tracker_, measurement_time, *self_transform);
+  checkTrackerLifeCycle(trackers_, measurement_time, *self_transform);
   /* sanitize trackers */
-  sanitizeTracker(list_tracker_, measurement_time);
+  sanitizeTracker(trackers_, measurement_time);
 
   /* new tracker */
   for (size_t i = 0; i < transformed_objects.objects.size(); ++i) {
@@ -176,7 +186,7 @@ void MultiObjectTracker::onMeasurement(
     }
     std::shared_ptr<Tracker> tracker =
       createNewTracker(transformed_objects.objects.at(i), measurement_time, *self_transform);
-    if (tracker) list_tracker_.push_back(tracker);
+    if (tracker) trackers_.push_back(tracker);
   }
 
   if (publish_timer_ == nullptr) {
@@ -186,29 +196,31 @@ void MultiObjectTracker::onMeasurement(
 
 std::shared_ptr<Tracker> MultiObjectTracker::createNewTracker(
   const autoware_auto_perception_msgs::msg::DetectedObject & object, const rclcpp::Time & time,
-  const geometry_msgs::msg::Transform & self_transform) const
+  const geometry_msgs::msg::Transform & self_transform)
 {
   const std::uint8_t label = perception_utils::getHighestProbLabel(object.classification);
   if (tracker_map_.count(label) != 0) {
     const auto tracker = tracker_map_.at(label);
 
     if (tracker == "bicycle_tracker") {
-      return std::make_shared<BicycleTracker>(time, object, self_transform);
+      return makeTracker<BicycleTracker>(&tracker_memory_pool_, time, object, self_transform);
     } else if (tracker == "big_vehicle_tracker") {
-      return std::make_shared<BigVehicleTracker>(time, object, self_transform);
+      return makeTracker<BigVehicleTracker>(&tracker_memory_pool_, time, object, self_transform);
     } else if (tracker == "multi_vehicle_tracker") {
-      return std::make_shared<MultipleVehicleTracker>(time, object, self_transform);
+      return makeTracker<MultipleVehicleTracker>(
+        &tracker_memory_pool_, time, object, self_transform);
     } else if (tracker == "normal_vehicle_tracker") {
-      return std::make_shared<NormalVehicleTracker>(time, object, self_transform);
+      return makeTracker<NormalVehicleTracker>(&tracker_memory_pool_, time, object, self_transform);
     } else if (tracker == "pass_through_tracker") {
-      return std::make_shared<PassThroughTracker>(time, object, self_transform);
+      return makeTracker<PassThroughTracker>(&tracker_memory_pool_, time, object, self_transform);
     } else if (tracker == "pedestrian_and_bicycle_tracker") {
-      return std::make_shared<PedestrianAndBicycleTracker>(time, object, self_transform);
+      return makeTracker<PedestrianAndBicycleTracker>(
+        &tracker_memory_pool_, time, object, self_transform);
     } else if (tracker == "pedestrian_tracker") {
-      return std::make_shared<PedestrianTracker>(time, object, self_transform);
+      return makeTracker<PedestrianTracker>(&tracker_memory_pool_, time, object, self_transform);
     }
   }
-  return std::make_shared<UnknownTracker>(time, object, self_transform);
+  return makeTracker<UnknownTracker>(&tracker_memory_pool_, time, object, self_transform);
 }
 
 void MultiObjectTracker::onTimer()
@@ -221,58 +233,74 @@ void MultiObjectTracker::onTimer()
   }
 
   /* life cycle check */
-  checkTrackerLifeCycle(list_tracker_, current_time, *self_transform);
+  checkTrackerLifeCycle(trackers_, current_time, *self_transform);
   /* sanitize trackers */
-  sanitizeTracker(list_tracker_, current_time);
+  sanitizeTracker(trackers_, current_time);
 
   // Publish
   publish(current_time);
 }
 
 void MultiObjectTracker::checkTrackerLifeCycle(
-  std::list<std::shared_ptr<Tracker>> & list_tracker, const rclcpp::Time & time,
+  std::vector<std::shared_ptr<Tracker>> & trackers, const rclcpp::Time & time,
   [[maybe_unused]] const geometry_msgs::msg::Transform & self_transform)
 {
   /* params */
   constexpr float max_elapsed_time = 1.0;
 
   /* delete tracker */
-  for (auto itr = list_tracker.begin(); itr != list_tracker.end(); ++itr) {
-    const bool is_old = max_elapsed_time < (*itr)->getElapsedTimeFromLastUpdate(time);
-    if (is_old) {
-      auto erase_itr = itr;
-      --itr;
-      list_tracker.erase(erase_itr);
-    }
-  }
+  const auto is_old = [&time](const std::shared_ptr<Tracker> & tracker) {
+    return max_elapsed_time < tracker->getElapsedTimeFromLastUpdate(time);
+  };
+  trackers.erase(std::remove_if(trackers.begin(), trackers.end(), is_old), trackers.end());
 }
 
 void MultiObjectTracker::sanitizeTracker(
-  std::list<std::shared_ptr<Tracker>> & list_tracker, const rclcpp::Time & time)
+  std::vector<std::shared_ptr<Tracker>> & trackers, const rclcpp::Time & time)
 {
   constexpr float min_iou = 0.1;
   constexpr float min_iou_for_unknown_object = 0.001;
   constexpr double distance_threshold = 5.0;
+
+  const size_t num_trackers = trackers.size();
+  std::vector<autoware_auto_perception_msgs::msg::TrackedObject> objects(num_trackers);
+  std::vector<double> xs(num_trackers);
+  std::vector<double> ys(num_trackers);
+  for (size_t i = 0; i < num_trackers; ++i) {
+    trackers.at(i)->getTrackedObject(time, objects.at(i));
+    xs.at(i) = objects.at(i).kinematics.pose_with_covariance.pose.position.x;
+    ys.at(i) = objects.at(i).kinematics.pose_with_covariance.pose.position.y;
+  }
+  // only the trackers within distance_threshold can collide
+  perception_utils::CentroidGrid tracker_grid;
+  tracker_grid.build(xs, ys, distance_threshold);
+
   /* delete collision tracker */
-  for (auto itr1 = list_tracker.begin(); itr1 != list_tracker.end(); ++itr1) {
-    autoware_auto_perception_msgs::msg::TrackedObject object1;
-    (*itr1)->getTrackedObject(time, object1);
-    for (auto itr2 = std::next(itr1); itr2 != list_tracker.end(); ++itr2) {
-      autoware_auto_perception_msgs::msg::TrackedObject object2;
-      (*itr2)->getTrackedObject(time, object2);
-      const double distance = std::hypot(
-        object1.kinematics.pose_with_covariance.pose.position.x -
-          object2.kinematics.pose_with_covariance.pose.position.x,
-        object1.kinematics.pose_with_covariance.pose.position.y -
-          object2.kinematics.pose_with_covariance.pose.position.y);
+  std::vector<bool> is_deleted(num_trackers, false);
+  std::vector<size_t> candidates;
+  for (size_t idx1 = 0; idx1 < num_trackers; ++idx1) {
+    if (is_deleted.at(idx1)) {
+      continue;
+    }
+    tracker_grid.queryCandidates(xs.at(idx1), ys.at(idx1), distance_threshold, candidates);
+
+    const auto & object1 = objects.at(idx1);
+    for (const size_t idx2 : candidates) {
+      if (idx2 <= idx1 || is_deleted.at(idx2)) {
+        continue;
+      }
+      const auto & object2 = objects.at(idx2);
+      const double distance = std::hypot(xs.at(idx1) - xs.at(idx2), ys.at(idx1) - ys.at(idx2));
       if (distance_threshold < distance) {
         continue;
       }
 
+      const auto & tracker1 = trackers.at(idx1);
+      const auto & tracker2 = trackers.at(idx2);
       const double min_union_iou_area = 1e-2;
       const auto iou = perception_utils::get2dIoU(object1, object2, min_union_iou_area);
-      const auto & label1 = (*itr1)->getHighestProbLabel();
-      const auto & label2 = (*itr2)->getHighestProbLabel();
+      const auto & label1 = tracker1->getHighestProbLabel();
+      const auto & label2 = tracker2->getHighestProbLabel();
       bool should_delete_tracker1 = false;
       bool should_delete_tracker2 = false;
 
@@ -281,7 +309,7 @@ void MultiObjectTracker::sanitizeTracker(
       if (label1 == Label::UNKNOWN || label2 == Label::UNKNOWN) {
         if (min_iou_for_unknown_object < iou) {
           if (label1 == Label::UNKNOWN && label2 == Label::UNKNOWN) {
-            if ((*itr1)->getTotalMeasurementCount() < (*itr2)->getTotalMeasurementCount()) {
+            if (tracker1->getTotalMeasurementCount() < tracker2->getTotalMeasurementCount()) {
               should_delete_tracker1 = true;
             } else {
               should_delete_tracker2 = true;
@@ -294,7 +322,7 @@ void MultiObjectTracker::sanitizeTracker(
         }
       } else {  // If neither is UNKNOWN, delete the one with lower IOU.
         if (min_iou < iou) {
-          if ((*itr1)->getTotalMeasurementCount() < (*itr2)->getTotalMeasurementCount()) {
+          if (tracker1->getTotalMeasurementCount() < tracker2->getTotalMeasurementCount()) {
             should_delete_tracker1 = true;
           } else {
             should_delete_tracker2 = true;
@@ -303,15 +331,21 @@ void MultiObjectTracker::sanitizeTracker(
       }
 
       if (should_delete_tracker1) {
-        itr1 = list_tracker.erase(itr1);
-        --itr1;
+        is_deleted.at(idx1) = true;
         break;
       } else if (should_delete_tracker2) {
-        itr2 = list_tracker.erase(itr2);
-        --itr2;
+        is_deleted.at(idx2) = true;
       }
     }
   }
+
+  size_t num_kept = 0;
+  for (size_t i = 0; i < num_trackers; ++i) {
+    if (!is_deleted.at(i)) {
+      trackers.at(num_kept++) = std::move(trackers.at(i));
+    }
+  }
+  trackers.resize(num_kept);
 }
 
 inline bool MultiObjectTracker::shouldTrackerPublish(
@@ -335,7 +369,7 @@ void MultiObjectTracker::publish(const rclcpp::Time & time) const
   autoware_auto_perception_msgs::msg::TrackedObjects output_msg;
   output_msg.header.frame_id = world_frame_id_;
   output_msg.header.stamp = time;
-  for (auto itr = list_tracker_.begin(); itr != list_tracker_.end(); ++itr) {
+  for (auto itr = trackers_.begin(); itr != trackers_.end(); ++itr) {
     if (!shouldTrackerPublish(*itr)) {
       continue;
     }
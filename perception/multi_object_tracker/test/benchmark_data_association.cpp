@@ -0,0 +1,139 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "multi_object_tracker/data_association/data_association.hpp"
+#include "multi_object_tracker/tracker/model/pass_through_tracker.hpp"
+
+#include <tier4_autoware_utils/ros/message_snapshot.hpp>
+#include <tier4_autoware_utils/system/benchmark.hpp>
+
+#include <autoware_auto_perception_msgs/msg/detected_objects.hpp>
+#include <autoware_auto_perception_msgs/msg/object_classification.hpp>
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using autoware_auto_perception_msgs::msg::DetectedObject;
+using autoware_auto_perception_msgs::msg::DetectedObjects;
+using autoware_auto_perception_msgs::msg::ObjectClassification;
+
+namespace
+{
+// objects of all the classes spread over a 200 m x 200 m area, the same for every run
+DetectedObjects generateObjects(const size_t num_objects, const unsigned int seed)
+{
+  std::mt19937 engine(seed);
+  std::uniform_real_distribution<double> position_dist(-100.0, 100.0);
+  std::uniform_real_distribution<double> yaw_dist(-M_PI, M_PI);
+  std::uniform_int_distribution<int> label_dist(
+    ObjectClassification::UNKNOWN, ObjectClassification::PEDESTRIAN);
+
+  DetectedObjects objects;
+  objects.header.frame_id = "map";
+  for (size_t i = 0; i < num_objects; ++i) {
+    DetectedObject object;
+    ObjectClassification classification;
+    classification.label = label_dist(engine);
+    classification.probability = 1.0;
+    object.classification.push_back(classification);
+    object.existence_probability = 1.0;
+
+    auto & pose = object.kinematics.pose_with_covariance.pose;
+    pose.position.x = position_dist(engine);
+    pose.position.y = position_dist(engine);
+    const double yaw = yaw_dist(engine);
+    pose.orientation.z = std::sin(yaw / 2.0);
+    pose.orientation.w = std::cos(yaw / 2.0);
+
+    object.shape.type = autoware_auto_perception_msgs::msg::Shape::BOUNDING_BOX;
+    const bool is_vehicle = classification.label != ObjectClassification::PEDESTRIAN &&
+                            classification.label != ObjectClassification::BICYCLE &&
+                            classification.label != ObjectClassification::MOTORCYCLE;
+    object.shape.dimensions.x = is_vehicle ? 4.5 : 0.8;
+    object.shape.dimensions.y = is_vehicle ? 1.8 : 0.8;
+    object.shape.dimensions.z = 1.5;
+    objects.objects.push_back(object);
+  }
+  return objects;
+}
+
+// the measurements of the next frame: the same objects slightly moved
+DetectedObjects jitterObjects(const DetectedObjects & objects, const unsigned int seed)
+{
+  std::mt19937 engine(seed);
+  std::normal_distribution<double> noise_dist(0.0, 0.3);
+
+  auto jittered_objects = objects;
+  for (auto & object : jittered_objects.objects) {
+    auto & position = object.kinematics.pose_with_covariance.pose.position;
+    position.x += noise_dist(engine);
+    position.y += noise_dist(engine);
+  }
+  return jittered_objects;
+}
+}  // namespace
+
+// Benchmark of the data association of multi_object_tracker.
+//   --previous <snapshot> --current <snapshot>
+//     DetectedObjects snapshots of two consecutive frames (see tier4_autoware_utils), the
+//     trackers are made from the previous frame. Synthetic objects are used when omitted.
+//   --num_objects <n>  number of synthetic objects (default 200)
+int main(int argc, char ** argv)
+{
+  tier4_autoware_utils::BenchmarkRunner runner(argc, argv, "multi_object_tracker");
+
+  DetectedObjects previous_objects;
+  DetectedObjects current_objects;
+  const auto previous_path = runner.getArgument("previous");
+  const auto current_path = runner.getArgument("current");
+  if (previous_path && current_path) {
+    previous_objects = tier4_autoware_utils::readMessageSnapshot<DetectedObjects>(*previous_path);
+    current_objects = tier4_autoware_utils::readMessageSnapshot<DetectedObjects>(*current_path);
+  } else {
+    const auto num_objects = std::stoul(runner.getArgument("num_objects").value_or("200"));
+    previous_objects = generateObjects(num_objects, 0);
+    current_objects = jitterObjects(previous_objects, 1);
+  }
+
+  const rclcpp::Time time(previous_objects.header.stamp);
+  std::vector<std::shared_ptr<Tracker>> trackers;
+  for (const auto & object : previous_objects.objects) {
+    trackers.push_back(
+      std::make_shared<PassThroughTracker>(time, object, geometry_msgs::msg::Transform()));
+  }
+
+  // every class may be assigned to every class to cover the worst case of the gating
+  constexpr size_t num_labels = 8;
+  constexpr size_t num_elements = num_labels * num_labels;
+  DataAssociation data_association(
+    std::vector<int>(num_elements, 1), std::vector<double>(num_elements, 5.0),
+    std::vector<double>(num_elements, 100.0), std::vector<double>(num_elements, 0.0),
+    std::vector<double>(num_elements, 3.15), std::vector<double>(num_elements, 0.1));
+
+  Eigen::MatrixXd score_matrix;
+  runner.run("calc_score_matrix", [&]() {
+    score_matrix = data_association.calcScoreMatrix(current_objects, trackers);
+  });
+  runner.run("assign", [&]() {
+    std::unordered_map<int, int> direct_assignment;
+    std::unordered_map<int, int> reverse_assignment;
+    data_association.assign(score_matrix, direct_assignment, reverse_assignment);
+  });
+
+  return runner.finish();
+}
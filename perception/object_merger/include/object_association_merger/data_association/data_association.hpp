@@ -29,6 +29,7 @@
 
 #include <Eigen/Core>
 #include <Eigen/Geometry>
+#include <perception_utils/centroid_grid.hpp>
 
 #include <autoware_auto_perception_msgs/msg/detected_objects.hpp>
 
@@ -39,8 +40,13 @@ private:
   Eigen::MatrixXd max_dist_matrix_;
   Eigen::MatrixXd max_rad_matrix_;
   Eigen::MatrixXd min_iou_matrix_;
+  // largest max_dist_matrix_ value that can be assigned to each label of objects1, negative if the
+  // label can't be assigned at all
+  std::vector<double> max_gate_dist_;
   const double score_threshold_;
   std::unique_ptr<gnn_solver::GnnSolverInterface> gnn_solver_ptr_;
+  perception_utils::CentroidGrid objects0_grid_;
+  std::vector<size_t> candidate_indices_;
 
 public:
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
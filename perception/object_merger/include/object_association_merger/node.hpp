@@ -78,7 +78,10 @@ private:
     double recall_threshold;
     double generalized_iou_threshold;
     std::map<int /*class label*/, double /*distance_threshold*/> distance_threshold_map;
+    double max_distance_threshold;
   } overlapped_judge_param_;
+  perception_utils::CentroidGrid known_object_grid_;
+  std::vector<size_t> candidate_indices_;
 };
 }  // namespace object_association
 
@@ -19,6 +19,8 @@
 #include "perception_utils/perception_utils.hpp"
 #include "tier4_autoware_utils/geometry/geometry.hpp"
 
+#include <boost/optional.hpp>
+
 #include <algorithm>
 #include <list>
 #include <memory>
@@ -76,6 +78,19 @@ DataAssociation::DataAssociation(
       min_iou_vector.data(), min_iou_label_num, min_iou_label_num);
     min_iou_matrix_ = min_iou_matrix_tmp.transpose();
   }
+  {
+    max_gate_dist_.assign(max_dist_matrix_.rows(), -1.0);
+    const int num_labels1 = std::min(can_assign_matrix_.rows(), max_dist_matrix_.rows());
+    const int num_labels0 = std::min(can_assign_matrix_.cols(), max_dist_matrix_.cols());
+    for (int label1 = 0; label1 < num_labels1; ++label1) {
+      for (int label0 = 0; label0 < num_labels0; ++label0) {
+        if (can_assign_matrix_(label1, label0)) {
+          max_gate_dist_.at(label1) =
+            std::max(max_gate_dist_.at(label1), max_dist_matrix_(label1, label0));
+        }
+      }
+    }
+  }
 
   gnn_solver_ptr_ = std::make_unique<gnn_solver::MuSSP>();
 }
@@ -118,17 +133,46 @@ Eigen::MatrixXd DataAssociation::calcScoreMatrix(
 {
   Eigen::MatrixXd score_matrix =
     Eigen::MatrixXd::Zero(objects1.objects.size(), objects0.objects.size());
+  if (objects0.objects.empty() || objects1.objects.empty() || max_gate_dist_.empty()) {
+    return score_matrix;
+  }
+
+  // only the objects0 within the distance gate of an object1 are scored, the others keep 0
+  const double cell_size = *std::max_element(max_gate_dist_.begin(), max_gate_dist_.end());
+  if (cell_size < 0.0) {
+    return score_matrix;
+  }
+  objects0_grid_.build(objects0.objects, cell_size);
+
+  std::vector<std::uint8_t> labels0;
+  labels0.reserve(objects0.objects.size());
+  for (const auto & object0 : objects0.objects) {
+    labels0.push_back(perception_utils::getHighestProbLabel(object0.classification));
+  }
+  // the footprints are prepared on first use, most objects are never within a gate
+  std::vector<boost::optional<perception_utils::MatchingPolygon2d>> polygons0(
+    objects0.objects.size());
+
   for (size_t objects1_idx = 0; objects1_idx < objects1.objects.size(); ++objects1_idx) {
     const autoware_auto_perception_msgs::msg::DetectedObject & object1 =
       objects1.objects.at(objects1_idx);
     const std::uint8_t object1_label =
       perception_utils::getHighestProbLabel(object1.classification);
+    if (max_gate_dist_.size() <= object1_label || max_gate_dist_.at(object1_label) < 0.0) {
+      continue;
+    }
+    const auto & position1 = object1.kinematics.pose_with_covariance.pose.position;
+    objects0_grid_.query(
+      position1.x, position1.y, max_gate_dist_.at(object1_label), candidate_indices_);
+    if (candidate_indices_.empty()) {
+      continue;
+    }
+    const auto polygon1 = perception_utils::toMatchingPolygon2d(object1);
 
-    for (size_t objects0_idx = 0; objects0_idx < objects0.objects.size(); ++objects0_idx) {
+    for (const size_t objects0_idx : candidate_indices_) {
       const autoware_auto_perception_msgs::msg::DetectedObject & object0 =
         objects0.objects.at(objects0_idx);
-      const std::uint8_t object0_label =
-        perception_utils::getHighestProbLabel(object0.classification);
+      const std::uint8_t object0_label = labels0.at(objects0_idx);
 
       double score = 0.0;
       if (can_assign_matrix_(object1_label, object0_label)) {
@@ -155,7 +199,9 @@ Eigen::MatrixXd DataAssociation::calcScoreMatrix(
         if (passed_gate) {
           const double min_iou = min_iou_matrix_(object1_label, object0_label);
           const double min_union_iou_area = 1e-2;
-          const double iou = perception_utils::get2dIoU(object0, object1, min_union_iou_area);
+          auto & polygon0 = polygons0.at(objects0_idx);
+          if (!polygon0) polygon0 = perception_utils::toMatchingPolygon2d(object0);
+          const double iou = perception_utils::get2dIoU(*polygon0, polygon1, min_union_iou_area);
           if (iou < min_iou) passed_gate = false;
         }
 
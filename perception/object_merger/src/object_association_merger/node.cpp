@@ -20,6 +20,7 @@
 
 #include <boost/optional.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <unordered_map>
 
@@ -34,8 +35,10 @@ namespace
 bool isUnknownObjectOverlapped(
   const autoware_auto_perception_msgs::msg::DetectedObject & unknown_object,
   const autoware_auto_perception_msgs::msg::DetectedObject & known_object,
-  const double precision_threshold, const double recall_threshold,
-  std::map<int, double> distance_threshold_map, const double generalized_iou_threshold)
+  const perception_utils::MatchingPolygon2d & unknown_polygon,
+  const perception_utils::MatchingPolygon2d & known_polygon, const double precision_threshold,
+  const double recall_threshold, const std::map<int, double> & distance_threshold_map,
+  const double generalized_iou_threshold)
 {
   const double distance_threshold =
     distance_threshold_map.at(perception_utils::getHighestProbLabel(known_object.classification));
@@ -44,9 +47,10 @@ bool isUnknownObjectOverlapped(
     unknown_object.kinematics.pose_with_covariance.pose,
     known_object.kinematics.pose_with_covariance.pose);
   if (sq_distance_threshold < sq_distance) return false;
-  const auto precision = perception_utils::get2dPrecision(unknown_object, known_object);
-  const auto recall = perception_utils::get2dRecall(unknown_object, known_object);
-  const auto generalized_iou = perception_utils::get2dGeneralizedIoU(unknown_object, known_object);
+  const auto precision = perception_utils::get2dPrecision(unknown_polygon, known_polygon);
+  const auto recall = perception_utils::get2dRecall(unknown_polygon, known_polygon);
+  const auto generalized_iou =
+    perception_utils::get2dGeneralizedIoU(unknown_polygon, known_polygon);
   return precision > precision_threshold || recall > recall_threshold ||
          generalized_iou > generalized_iou_threshold;
 }
@@ -103,6 +107,11 @@ ObjectAssociationMergerNode::ObjectAssociationMergerNode(const rclcpp::NodeOptio
    */
   overlapped_judge_param_.distance_threshold_map =
     convertListToClassMap(declare_parameter<std::vector<double>>("distance_threshold_list"));
+  overlapped_judge_param_.max_distance_threshold = 0.0;
+  for (const auto & [label, distance_threshold] : overlapped_judge_param_.distance_threshold_map) {
+    overlapped_judge_param_.max_distance_threshold =
+      std::max(overlapped_judge_param_.max_distance_threshold, distance_threshold);
+  }
 
   const auto tmp = this->declare_parameter<std::vector<int64_t>>("can_assign_matrix");
   const std::vector<int> can_assign_matrix(tmp.begin(), tmp.end());
@@ -188,16 +197,31 @@ void ObjectAssociationMergerNode::objectsCallback(
     }
     output_msg.objects.clear();
     output_msg.objects = known_objects;
+
+    // only the known objects within the largest distance threshold of an unknown object are judged
+    known_object_grid_.build(known_objects, overlapped_judge_param_.max_distance_threshold);
+    std::vector<boost::optional<perception_utils::MatchingPolygon2d>> known_polygons(
+      known_objects.size());
     for (const auto & unknown_object : unknown_objects) {
+      const auto & position = unknown_object.kinematics.pose_with_covariance.pose.position;
+      known_object_grid_.query(
+        position.x, position.y, overlapped_judge_param_.max_distance_threshold, candidate_indices_);
       bool is_overlapped = false;
-      for (const auto & known_object : known_objects) {
-        if (isUnknownObjectOverlapped(
-              unknown_object, known_object, overlapped_judge_param_.precision_threshold,
-              overlapped_judge_param_.recall_threshold,
-              overlapped_judge_param_.distance_threshold_map,
-              overlapped_judge_param_.generalized_iou_threshold)) {
-          is_overlapped = true;
-          break;
+      if (!candidate_indices_.empty()) {
+        const auto unknown_polygon = perception_utils::toMatchingPolygon2d(unknown_object);
+        for (const size_t known_object_idx : candidate_indices_) {
+          const auto & known_object = known_objects.at(known_object_idx);
+          auto & known_polygon = known_polygons.at(known_object_idx);
+          if (!known_polygon) known_polygon = perception_utils::toMatchingPolygon2d(known_object);
+          if (isUnknownObjectOverlapped(
+                unknown_object, known_object, unknown_polygon, *known_polygon,
+                overlapped_judge_param_.precision_threshold,
+                overlapped_judge_param_.recall_threshold,
+                overlapped_judge_param_.distance_threshold_map,
+                overlapped_judge_param_.generalized_iou_threshold)) {
+            is_overlapped = true;
+            break;
+          }
         }
       }
       if (!is_overlapped) {
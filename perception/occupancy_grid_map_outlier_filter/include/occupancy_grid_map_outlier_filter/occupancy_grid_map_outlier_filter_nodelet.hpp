@@ -31,13 +31,13 @@
 #include <message_filters/synchronizer.h>
 #include <pcl/filters/extract_indices.h>
 #include <pcl/filters/radius_outlier_removal.h>
-#include <pcl/search/kdtree.h>
 #include <tf2_ros/buffer.h>
 #include <tf2_ros/message_filter.h>
 #include <tf2_ros/transform_listener.h>
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace occupancy_grid_map_outlier_filter
 {
@@ -59,12 +59,30 @@ public:
     PclPointCloud & output, PclPointCloud & outlier);
 
 private:
+  // bucket xy_points_ by square cells, instead of building a kd-tree
+  void buildGrid();
+  size_t getCell(const pcl::PointXY & point) const;
+  // the number of points within search_radius_ of xy_points_[index], itself included,
+  // counted up to max_count
+  int countNeighbors(const size_t index, const int max_count) const;
+
   float search_radius_;
   float min_points_and_distance_ratio_;
   int min_points_;
   int max_points_;
   long unsigned int max_filter_points_nb_;
-  pcl::search::Search<pcl::PointXY>::Ptr kd_tree_;
+
+  // the grid, whose buffers are reused from a frame to the next
+  std::vector<pcl::PointXY> xy_points_;
+  std::vector<pcl::PointXY> sorted_points_;
+  std::vector<size_t> point_cells_;
+  std::vector<size_t> cell_begins_;
+  std::vector<size_t> cell_ends_;
+  float cell_size_{1.0f};
+  float grid_min_x_{0.0f};
+  float grid_min_y_{0.0f};
+  int grid_width_{0};
+  int grid_height_{0};
 };
 
 class OccupancyGridMapOutlierFilterComponent : public rclcpp::Node
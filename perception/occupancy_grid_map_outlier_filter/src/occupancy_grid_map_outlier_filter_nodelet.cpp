@@ -29,6 +29,7 @@
 #endif
 
 #include <algorithm>
+#include <cmath>
 #include <memory>
 #include <string>
 #include <utility>
@@ -74,28 +75,39 @@ geometry_msgs::msg::PoseStamped getPoseStamped(
   return tier4_autoware_utils::transform2pose(tf_stamped);
 }
 
-boost::optional<char> getCost(
-  const nav_msgs::msg::OccupancyGrid & map, const double & x, const double & y)
+// the cell lookup of getCost() with the map geometry computed once for all the points
+class CostLookup
 {
-  const auto & map_position = map.info.origin.position;
-  const auto & map_resolution = map.info.resolution;
-  const double map_height_m = map.info.height /* cell size */ * map_resolution;
-  const double map_width_m = map.info.width /* cell size */ * map_resolution;
-  const double map_min_x = map_position.x;
-  const double map_max_x = map_position.x + map_width_m;
-  const double map_min_y = map_position.y;
-  const double map_max_y = map_position.y + map_height_m;
-
-  if (map_min_x < x && x < map_max_x && map_min_y < y && y < map_max_y) {
-    unsigned int map_cell_x{};
-    unsigned int map_cell_y{};
-    map_cell_x = std::floor((x - map_position.x) / map_resolution);
-    map_cell_y = std::floor((y - map_position.y) / map_resolution);
-    size_t index = map_cell_y * map.info.width + map_cell_x;
-    return map.data.at(index);
+public:
+  explicit CostLookup(const nav_msgs::msg::OccupancyGrid & map)
+  : map_(map),
+    map_min_x_(map.info.origin.position.x),
+    map_min_y_(map.info.origin.position.y),
+    map_max_x_(map_min_x_ + map.info.width /* cell size */ * map.info.resolution),
+    map_max_y_(map_min_y_ + map.info.height /* cell size */ * map.info.resolution),
+    map_resolution_(map.info.resolution)
+  {
   }
-  return boost::none;
-}
+
+  boost::optional<char> getCost(const double x, const double y) const
+  {
+    if (map_min_x_ < x && x < map_max_x_ && map_min_y_ < y && y < map_max_y_) {
+      const unsigned int map_cell_x = std::floor((x - map_min_x_) / map_resolution_);
+      const unsigned int map_cell_y = std::floor((y - map_min_y_) / map_resolution_);
+      const size_t index = map_cell_y * map_.info.width + map_cell_x;
+      return map_.data.at(index);
+    }
+    return boost::none;
+  }
+
+private:
+  const nav_msgs::msg::OccupancyGrid & map_;
+  const double map_min_x_;
+  const double map_min_y_;
+  const double map_max_x_;
+  const double map_max_y_;
+  const double map_resolution_;
+};
 
 }  // namespace
 
@@ -110,31 +122,103 @@ RadiusSearch2dfilter::RadiusSearch2dfilter(rclcpp::Node & node)
   max_points_ = node.declare_parameter("radius_search_2d_filter.max_points", 70);
   max_filter_points_nb_ =
     node.declare_parameter("radius_search_2d_filter.max_filter_points_nb", 15000);
-  kd_tree_ = pcl::make_shared<pcl::search::KdTree<pcl::PointXY>>(false);
+}
+
+void RadiusSearch2dfilter::buildGrid()
+{
+  grid_width_ = 0;
+  grid_height_ = 0;
+  cell_begins_.assign(1, 0);
+  if (xy_points_.empty()) {
+    sorted_points_.clear();
+    return;
+  }
+
+  float max_x = xy_points_.front().x;
+  float max_y = xy_points_.front().y;
+  grid_min_x_ = max_x;
+  grid_min_y_ = max_y;
+  for (const auto & p : xy_points_) {
+    grid_min_x_ = std::min(grid_min_x_, p.x);
+    grid_min_y_ = std::min(grid_min_y_, p.y);
+    max_x = std::max(max_x, p.x);
+    max_y = std::max(max_y, p.y);
+  }
+  // the cells are not smaller than the radius, so that the neighbors are in the 3x3 cells around,
+  // and grow when a few far points would make the grid too large
+  constexpr double max_cells = 1 << 22;
+  cell_size_ = std::max(
+    search_radius_,
+    static_cast<float>(std::sqrt((max_x - grid_min_x_) * (max_y - grid_min_y_) / max_cells)));
+  grid_width_ = static_cast<int>((max_x - grid_min_x_) / cell_size_) + 1;
+  grid_height_ = static_cast<int>((max_y - grid_min_y_) / cell_size_) + 1;
+
+  // counting sort of the points by their cell
+  point_cells_.resize(xy_points_.size());
+  cell_begins_.assign(static_cast<size_t>(grid_width_) * grid_height_ + 1, 0);
+  for (size_t i = 0; i < xy_points_.size(); ++i) {
+    point_cells_[i] = getCell(xy_points_[i]);
+    ++cell_begins_[point_cells_[i] + 1];
+  }
+  for (size_t cell = 1; cell < cell_begins_.size(); ++cell) {
+    cell_begins_[cell] += cell_begins_[cell - 1];
+  }
+  cell_ends_.assign(cell_begins_.begin(), cell_begins_.end() - 1);
+  sorted_points_.resize(xy_points_.size());
+  for (size_t i = 0; i < xy_points_.size(); ++i) {
+    sorted_points_[cell_ends_[point_cells_[i]]++] = xy_points_[i];
+  }
+}
+
+size_t RadiusSearch2dfilter::getCell(const pcl::PointXY & point) const
+{
+  const int cell_x = std::min(
+    static_cast<int>((point.x - grid_min_x_) / cell_size_), grid_width_ - 1);
+  const int cell_y = std::min(
+    static_cast<int>((point.y - grid_min_y_) / cell_size_), grid_height_ - 1);
+  return static_cast<size_t>(cell_y) * grid_width_ + cell_x;
+}
+
+int RadiusSearch2dfilter::countNeighbors(const size_t index, const int max_count) const
+{
+  const pcl::PointXY & point = xy_points_[index];
+  const int cell_x = static_cast<int>(point_cells_[index] % grid_width_);
+  const int cell_y = static_cast<int>(point_cells_[index] / grid_width_);
+  const float squared_radius = search_radius_ * search_radius_;
+  int count = 0;
+  for (int y = std::max(cell_y - 1, 0); y <= std::min(cell_y + 1, grid_height_ - 1); ++y) {
+    for (int x = std::max(cell_x - 1, 0); x <= std::min(cell_x + 1, grid_width_ - 1); ++x) {
+      const size_t cell = static_cast<size_t>(y) * grid_width_ + x;
+      for (size_t i = cell_begins_[cell]; i < cell_begins_[cell + 1]; ++i) {
+        const float dx = sorted_points_[i].x - point.x;
+        const float dy = sorted_points_[i].y - point.y;
+        if (dx * dx + dy * dy <= squared_radius && ++count >= max_count) {
+          return count;
+        }
+      }
+    }
+  }
+  return count;
 }
 
 void RadiusSearch2dfilter::filter(
   const PclPointCloud & input, const Pose & pose, PclPointCloud & output, PclPointCloud & outlier)
 {
   const auto & xyz_cloud = input;
-  pcl::PointCloud<pcl::PointXY>::Ptr xy_cloud(new pcl::PointCloud<pcl::PointXY>);
-  xy_cloud->points.resize(xyz_cloud.points.size());
+  xy_points_.resize(xyz_cloud.points.size());
   for (size_t i = 0; i < xyz_cloud.points.size(); ++i) {
-    xy_cloud->points[i].x = xyz_cloud.points[i].x;
-    xy_cloud->points[i].y = xyz_cloud.points[i].y;
+    xy_points_[i].x = xyz_cloud.points[i].x;
+    xy_points_[i].y = xyz_cloud.points[i].y;
   }
 
-  std::vector<int> k_indices(xy_cloud->points.size());
-  std::vector<float> k_dists(xy_cloud->points.size());
-  kd_tree_->setInputCloud(xy_cloud);
-  for (size_t i = 0; i < xy_cloud->points.size(); ++i) {
+  buildGrid();
+  for (size_t i = 0; i < xy_points_.size(); ++i) {
     const float distance =
-      std::hypot(xy_cloud->points[i].x - pose.position.x, xy_cloud->points[i].y - pose.position.y);
+      std::hypot(xy_points_[i].x - pose.position.x, xy_points_[i].y - pose.position.y);
     const int min_points_threshold = std::min(
       std::max(static_cast<int>(min_points_and_distance_ratio_ / distance + 0.5f), min_points_),
       max_points_);
-    const int points_num =
-      kd_tree_->radiusSearch(i, search_radius_, k_indices, k_dists, min_points_threshold);
+    const int points_num = countNeighbors(i, min_points_threshold);
 
     if (min_points_threshold <= points_num) {
       output.points.push_back(xyz_cloud.points.at(i));
@@ -158,28 +242,24 @@ void RadiusSearch2dfilter::filter(
     return;
   }
 
-  pcl::PointCloud<pcl::PointXY>::Ptr xy_cloud(new pcl::PointCloud<pcl::PointXY>);
-  xy_cloud->points.resize(low_conf_xyz_cloud.points.size() + high_conf_xyz_cloud.points.size());
+  xy_points_.resize(low_conf_xyz_cloud.points.size() + high_conf_xyz_cloud.points.size());
   for (size_t i = 0; i < low_conf_xyz_cloud.points.size(); ++i) {
-    xy_cloud->points[i].x = low_conf_xyz_cloud.points[i].x;
-    xy_cloud->points[i].y = low_conf_xyz_cloud.points[i].y;
+    xy_points_[i].x = low_conf_xyz_cloud.points[i].x;
+    xy_points_[i].y = low_conf_xyz_cloud.points[i].y;
   }
-  for (size_t i = low_conf_xyz_cloud.points.size(); i < xy_cloud->points.size(); ++i) {
-    xy_cloud->points[i].x = high_conf_xyz_cloud.points[i - low_conf_xyz_cloud.points.size()].x;
-    xy_cloud->points[i].y = high_conf_xyz_cloud.points[i - low_conf_xyz_cloud.points.size()].y;
+  for (size_t i = low_conf_xyz_cloud.points.size(); i < xy_points_.size(); ++i) {
+    xy_points_[i].x = high_conf_xyz_cloud.points[i - low_conf_xyz_cloud.points.size()].x;
+    xy_points_[i].y = high_conf_xyz_cloud.points[i - low_conf_xyz_cloud.points.size()].y;
   }
 
-  std::vector<int> k_indices(xy_cloud->points.size());
-  std::vector<float> k_dists(xy_cloud->points.size());
-  kd_tree_->setInputCloud(xy_cloud);
+  buildGrid();
   for (size_t i = 0; i < low_conf_xyz_cloud.points.size(); ++i) {
     const float distance =
-      std::hypot(xy_cloud->points[i].x - pose.position.x, xy_cloud->points[i].y - pose.position.y);
+      std::hypot(xy_points_[i].x - pose.position.x, xy_points_[i].y - pose.position.y);
     const int min_points_threshold = std::min(
       std::max(static_cast<int>(min_points_and_distance_ratio_ / distance + 0.5f), min_points_),
       max_points_);
-    const int points_num =
-      kd_tree_->radiusSearch(i, search_radius_, k_indices, k_dists, min_points_threshold);
+    const int points_num = countNeighbors(i, min_points_threshold);
 
     if (min_points_threshold <= points_num) {
       output.points.push_back(low_conf_xyz_cloud.points.at(i));
@@ -325,10 +405,11 @@ void OccupancyGridMapOutlierFilterComponent::filterByOccupancyGridMap(
   const OccupancyGrid & occupancy_grid_map, const PointCloud2 & pointcloud,
   PclPointCloud & high_confidence, PclPointCloud & low_confidence, PclPointCloud & out_ogm)
 {
+  const CostLookup cost_lookup(occupancy_grid_map);
   for (sensor_msgs::PointCloud2ConstIterator<float> x(pointcloud, "x"), y(pointcloud, "y"),
        z(pointcloud, "z");
        x != x.end(); ++x, ++y, ++z) {
-    const auto cost = getCost(occupancy_grid_map, *x, *y);
+    const auto cost = cost_lookup.getCost(*x, *y);
     if (cost) {
       if (cost_threshold_ < *cost) {
         high_confidence.push_back(pcl::PointXYZ(*x, *y, *z));
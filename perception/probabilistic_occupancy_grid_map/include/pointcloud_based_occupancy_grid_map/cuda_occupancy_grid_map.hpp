@@ -0,0 +1,120 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINTCLOUD_BASED_OCCUPANCY_GRID_MAP__CUDA_OCCUPANCY_GRID_MAP_HPP_
+#define POINTCLOUD_BASED_OCCUPANCY_GRID_MAP__CUDA_OCCUPANCY_GRID_MAP_HPP_
+
+#include <cuda_utils/cuda_unique_ptr.hpp>
+#include <cuda_utils/stream_unique_ptr.hpp>
+
+#include <cuda_runtime_api.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace costmap_2d
+{
+struct CudaTransform
+{
+  float matrix[16];  // row-major homogeneous transform
+};
+
+/**
+ * @brief OccupancyGridMap::updateWithPointCloud() and OccupancyGridMapBBFUpdater::update() on
+ * the device
+ *
+ * Points are binned by a sort on (angle bin, range) keys and every bin is raytraced by its own
+ * thread. The single frame map and the accumulated map stay on the device, only the
+ * nav_msgs/OccupancyGrid data is copied back.
+ */
+class CudaOccupancyGridMap
+{
+public:
+  CudaOccupancyGridMap(
+    const unsigned int cells_size_x, const unsigned int cells_size_y, const float resolution);
+
+  // pinned host buffers of (x, y, z, -) to be filled before updateWithPointCloud()
+  float4 * rawPointsHost(std::size_t num_points);
+  float4 * obstaclePointsHost(std::size_t num_points);
+
+  /**
+   * @brief build the single frame map and optionally fuse it in the accumulated map
+   *
+   * @param map2robot transform of the input points to the map frame
+   * @param scan2map transform of the map frame to the scan origin frame
+   * @param single_frame_origin_x lower left corner of the single frame map, aligned to the grid
+   * @param update_bayes_filter false to output the single frame map (single frame mode)
+   */
+  void updateWithPointCloud(
+    std::size_t num_raw_points, std::size_t num_obstacle_points, const CudaTransform & map2robot,
+    const CudaTransform & scan2map, double scan_origin_x, double scan_origin_y,
+    double single_frame_origin_x, double single_frame_origin_y, bool update_bayes_filter);
+
+  // nav_msgs/OccupancyGrid data of the last updated map, valid until the next update
+  const std::int8_t * occupancyGridHost() const { return occupancy_grid_h_.get(); }
+  // cost values of the last updated map, for consumers on the same device
+  const std::uint8_t * costmapDevice() const { return output_costmap_d_; }
+
+  unsigned int getSizeInCellsX() const { return size_x_; }
+  unsigned int getSizeInCellsY() const { return size_y_; }
+  double getResolution() const { return resolution_; }
+  double getSizeInMetersX() const { return (size_x_ - 1 + 0.5) * resolution_; }
+  double getSizeInMetersY() const { return (size_y_ - 1 + 0.5) * resolution_; }
+  double getOriginX() const { return output_origin_x_; }
+  double getOriginY() const { return output_origin_y_; }
+
+private:
+  struct DeviceAngleBins
+  {
+    std::size_t capacity{0};
+    cuda_utils::CudaUniquePtrHost<float4[]> points_h;
+    cuda_utils::CudaUniquePtr<float4[]> points_d;
+    cuda_utils::CudaUniquePtr<unsigned long long[]> keys_d;  // NOLINT
+    cuda_utils::CudaUniquePtr<std::int32_t[]> order_d;
+    cuda_utils::CudaUniquePtr<float4[]> binned_points_d;  // (wx, wy, range, -)
+    cuda_utils::CudaUniquePtr<float4[]> sorted_points_d;
+    cuda_utils::CudaUniquePtr<std::uint32_t[]> offsets_d;
+  };
+
+  static void reserve(DeviceAngleBins & angle_bins, std::size_t num_points);
+  void binPoints(
+    DeviceAngleBins & angle_bins, std::size_t num_points, const CudaTransform & map2robot,
+    const CudaTransform & scan2map);
+  void updateAccumulatedOrigin(double new_origin_x, double new_origin_y);
+
+  cuda_utils::StreamUniquePtr stream_;
+
+  unsigned int size_x_;
+  unsigned int size_y_;
+  double resolution_;
+
+  DeviceAngleBins raw_angle_bins_;
+  DeviceAngleBins obstacle_angle_bins_;
+
+  cuda_utils::CudaUniquePtr<std::uint8_t[]> single_frame_costmap_d_;
+  cuda_utils::CudaUniquePtr<std::uint8_t[]> accumulated_costmap_d_;
+  cuda_utils::CudaUniquePtr<std::uint8_t[]> shifted_costmap_d_;
+  cuda_utils::CudaUniquePtr<std::int8_t[]> cost_translation_table_d_;
+  cuda_utils::CudaUniquePtr<std::int8_t[]> occupancy_grid_d_;
+  cuda_utils::CudaUniquePtrHost<std::int8_t[]> occupancy_grid_h_;
+  const std::uint8_t * output_costmap_d_{nullptr};
+
+  double accumulated_origin_x_{0.0};
+  double accumulated_origin_y_{0.0};
+  double output_origin_x_{0.0};
+  double output_origin_y_{0.0};
+};
+}  // namespace costmap_2d
+
+#endif  // POINTCLOUD_BASED_OCCUPANCY_GRID_MAP__CUDA_OCCUPANCY_GRID_MAP_HPP_
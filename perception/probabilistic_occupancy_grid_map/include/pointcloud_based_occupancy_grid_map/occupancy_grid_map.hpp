@@ -59,6 +59,9 @@
 #include <sensor_msgs/msg/laser_scan.hpp>
 #include <sensor_msgs/msg/point_cloud2.hpp>
 
+#include <cstdint>
+#include <vector>
+
 namespace costmap_2d
 {
 using geometry_msgs::msg::Pose;
@@ -68,7 +71,8 @@ class OccupancyGridMap : public nav2_costmap_2d::Costmap2D
 {
 public:
   OccupancyGridMap(
-    const unsigned int cells_size_x, const unsigned int cells_size_y, const float resolution);
+    const unsigned int cells_size_x, const unsigned int cells_size_y, const float resolution,
+    const int num_threads = 1);
 
   void updateWithPointCloud(
     const PointCloud2 & raw_pointcloud, const PointCloud2 & obstacle_pointcloud,
@@ -76,6 +80,9 @@ public:
 
   void updateOrigin(double new_origin_x, double new_origin_y) override;
 
+  // clear the map and place its origin as updateOrigin() would on a newly constructed map
+  void resetMapsWithOrigin(double new_origin_x, double new_origin_y);
+
   void setCellValue(const double wx, const double wy, const unsigned char cost);
 
   void raytrace(
@@ -83,8 +90,34 @@ public:
     const unsigned char cost);
 
 private:
+  struct BinInfo
+  {
+    double range;
+    double wx;
+    double wy;
+  };
+
+  // points of the angle bin i are points[offsets[i]] to points[offsets[i + 1] - 1], by range.
+  // The buffers keep their capacity, so that binning a frame does not allocate once warmed up.
+  struct AngleBins
+  {
+    std::vector<BinInfo> points;
+    std::vector<std::size_t> offsets;
+    std::vector<BinInfo> unsorted_points;
+    std::vector<std::uint32_t> bin_indices;
+    std::vector<std::size_t> cursors;
+  };
+
+  void binPointCloud(
+    const PointCloud2 & pointcloud, const Pose & robot_pose, const Pose & scan2map_pose,
+    AngleBins & angle_bins) const;
+
   bool worldToMap(double wx, double wy, unsigned int & mx, unsigned int & my) const;
 
+  int num_threads_;
+  AngleBins raw_angle_bins_;
+  AngleBins obstacle_angle_bins_;
+
   rclcpp::Logger logger_{rclcpp::get_logger("pointcloud_based_occupancy_grid_map")};
   rclcpp::Clock clock_{RCL_ROS_TIME};
 };
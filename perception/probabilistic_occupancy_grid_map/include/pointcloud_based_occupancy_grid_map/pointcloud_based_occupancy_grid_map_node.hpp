@@ -19,6 +19,10 @@
 #include "updater/occupancy_grid_map_binary_bayes_filter_updater.hpp"
 #include "updater/occupancy_grid_map_updater_interface.hpp"
 
+#ifdef PROBABILISTIC_OCCUPANCY_GRID_MAP_WITH_CUDA
+#include "pointcloud_based_occupancy_grid_map/cuda_occupancy_grid_map.hpp"
+#endif
+
 #include <builtin_interfaces/msg/time.hpp>
 #include <laser_geometry/laser_geometry.hpp>
 #include <rclcpp/rclcpp.hpp>
@@ -62,6 +66,12 @@ private:
   OccupancyGrid::UniquePtr OccupancyGridMapToMsgPtr(
     const std::string & frame_id, const Time & stamp, const float & robot_pose_z,
     const Costmap2D & occupancy_grid_map);
+#ifdef PROBABILISTIC_OCCUPANCY_GRID_MAP_WITH_CUDA
+  OccupancyGrid::UniquePtr updateWithCuda(
+    const PointCloud2 & raw_pointcloud, const PointCloud2 & obstacle_pointcloud,
+    const geometry_msgs::msg::Pose & robot_pose, const geometry_msgs::msg::Pose & gridmap_origin,
+    const geometry_msgs::msg::Pose & scan_origin, const Time & stamp);
+#endif
 
 private:
   rclcpp::Publisher<OccupancyGrid>::SharedPtr occupancy_grid_map_pub_;
@@ -78,6 +88,11 @@ private:
   std::shared_ptr<Sync> sync_ptr_;
 
   std::shared_ptr<OccupancyGridMapUpdaterInterface> occupancy_grid_map_updater_ptr_;
+  // reused across frames to keep the map and angle bin buffers allocated
+  std::unique_ptr<costmap_2d::OccupancyGridMap> single_frame_occupancy_grid_map_ptr_;
+#ifdef PROBABILISTIC_OCCUPANCY_GRID_MAP_WITH_CUDA
+  std::unique_ptr<costmap_2d::CudaOccupancyGridMap> cuda_occupancy_grid_map_ptr_;
+#endif
 
   // ROS Parameters
   std::string map_frame_;
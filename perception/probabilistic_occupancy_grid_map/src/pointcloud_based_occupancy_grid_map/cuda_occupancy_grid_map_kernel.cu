@@ -0,0 +1,575 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pointcloud_based_occupancy_grid_map/cuda_occupancy_grid_map.hpp"
+
+#include "cost_value.hpp"
+
+#include <cuda_utils/cuda_check_error.hpp>
+
+#include <thrust/execution_policy.h>
+#include <thrust/sort.h>
+
+#include <cmath>
+#include <utility>
+
+namespace
+{
+const std::size_t THREADS_PER_BLOCK = 256;
+
+// same angle bins as OccupancyGridMap::updateWithPointCloud()
+constexpr double deg2rad(const double deg)
+{
+  return deg * M_PI / 180.0;
+}
+constexpr double MIN_ANGLE = deg2rad(-180.0);
+constexpr double MAX_ANGLE = deg2rad(180.0);
+constexpr double ANGLE_INCREMENT = deg2rad(0.1);
+const std::uint32_t ANGLE_BIN_SIZE =
+  ((MAX_ANGLE - MIN_ANGLE) / ANGLE_INCREMENT) + std::uint32_t(1 /*margin*/);
+constexpr float DISTANCE_MARGIN = 1.0f;
+constexpr unsigned int CELL_RAYTRACE_RANGE = 10000;
+
+std::size_t divup(const std::size_t a, const std::size_t b)
+{
+  return (a + b - 1) / b;
+}
+
+std::size_t nextPowerOfTwo(const std::size_t n)
+{
+  std::size_t p = 1;
+  while (p < n) {
+    p <<= 1;
+  }
+  return p;
+}
+}  // namespace
+
+namespace costmap_2d
+{
+struct GridGeometry
+{
+  double origin_x;
+  double origin_y;
+  double resolution;
+  unsigned int size_x;
+  unsigned int size_y;
+};
+
+__device__ inline float4 transformPoint(const CudaTransform & t, const float4 & p)
+{
+  return make_float4(
+    t.matrix[0] * p.x + t.matrix[1] * p.y + t.matrix[2] * p.z + t.matrix[3],
+    t.matrix[4] * p.x + t.matrix[5] * p.y + t.matrix[6] * p.z + t.matrix[7],
+    t.matrix[8] * p.x + t.matrix[9] * p.y + t.matrix[10] * p.z + t.matrix[11], 1.0f);
+}
+
+__device__ inline bool worldToMap(
+  const GridGeometry & grid, const double wx, const double wy, unsigned int & mx,
+  unsigned int & my)
+{
+  if (wx < grid.origin_x || wy < grid.origin_y) {
+    return false;
+  }
+  mx = static_cast<int>(floor((wx - grid.origin_x) / grid.resolution));
+  my = static_cast<int>(floor((wy - grid.origin_y) / grid.resolution));
+  return mx < grid.size_x && my < grid.size_y;
+}
+
+__device__ inline void setCellValue(
+  const GridGeometry & grid, std::uint8_t * costmap, const double wx, const double wy,
+  const std::uint8_t cost)
+{
+  unsigned int mx{};
+  unsigned int my{};
+  if (!worldToMap(grid, wx, wy, mx, my)) {
+    return;
+  }
+  costmap[my * grid.size_x + mx] = cost;
+}
+
+// OccupancyGridMap::raytrace() followed by nav2_costmap_2d::Costmap2D::raytraceLine()
+__device__ void raytrace(
+  const GridGeometry & grid, std::uint8_t * costmap, const double source_x,
+  const double source_y, const double target_x, const double target_y, const std::uint8_t cost)
+{
+  unsigned int x0{};
+  unsigned int y0{};
+  const double ox{source_x};
+  const double oy{source_y};
+  if (!worldToMap(grid, ox, oy, x0, y0)) {
+    return;
+  }
+
+  const double map_end_x = grid.origin_x + grid.size_x * grid.resolution;
+  const double map_end_y = grid.origin_y + grid.size_y * grid.resolution;
+
+  double wx = target_x;
+  double wy = target_y;
+  const double a = wx - ox;
+  const double b = wy - oy;
+  if (wx < grid.origin_x) {
+    const double t = (grid.origin_x - ox) / a;
+    wx = grid.origin_x;
+    wy = oy + b * t;
+  }
+  if (wy < grid.origin_y) {
+    const double t = (grid.origin_y - oy) / b;
+    wx = ox + a * t;
+    wy = grid.origin_y;
+  }
+  if (wx > map_end_x) {
+    const double t = (map_end_x - ox) / a;
+    wx = map_end_x - .001;
+    wy = oy + b * t;
+  }
+  if (wy > map_end_y) {
+    const double t = (map_end_y - oy) / b;
+    wx = ox + a * t;
+    wy = map_end_y - .001;
+  }
+
+  unsigned int x1{};
+  unsigned int y1{};
+  if (!worldToMap(grid, wx, wy, x1, y1)) {
+    return;
+  }
+
+  const int dx = x1 - x0;
+  const int dy = y1 - y0;
+  const unsigned int abs_dx = abs(dx);
+  const unsigned int abs_dy = abs(dy);
+  const int offset_dx = dx > 0 ? 1 : -1;
+  const int offset_dy = (dy > 0 ? 1 : -1) * static_cast<int>(grid.size_x);
+  const double dist = hypot(static_cast<double>(dx), static_cast<double>(dy));
+  const double scale = dist == 0.0 ? 1.0 : fmin(1.0, CELL_RAYTRACE_RANGE / dist);
+
+  // bresenham2D with a as the major axis
+  const bool x_major = abs_dx >= abs_dy;
+  const unsigned int abs_da = x_major ? abs_dx : abs_dy;
+  const unsigned int abs_db = x_major ? abs_dy : abs_dx;
+  const int offset_a = x_major ? offset_dx : offset_dy;
+  const int offset_b = x_major ? offset_dy : offset_dx;
+  int error_b = abs_da / 2;
+  unsigned int offset = y0 * grid.size_x + x0;
+  const unsigned int end = min(static_cast<unsigned int>(scale * abs_da), abs_da);
+  for (unsigned int i = 0; i < end; ++i) {
+    costmap[offset] = cost;
+    offset += offset_a;
+    error_b += abs_db;
+    if (static_cast<unsigned int>(error_b) >= abs_da) {
+      offset += offset_b;
+      error_b -= abs_da;
+    }
+  }
+  costmap[offset] = cost;
+}
+
+__global__ void binPoints_kernel(
+  const float4 * points, const std::size_t num_points, const CudaTransform map2robot,
+  const CudaTransform scan2map, unsigned long long * keys, std::int32_t * order,  // NOLINT
+  float4 * binned_points)
+{
+  const std::size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= num_points) return;
+
+  const float4 map_point = transformPoint(map2robot, points[idx]);
+  const float4 scan_point = transformPoint(scan2map, map_point);
+  const double angle = atan2(scan_point.y, scan_point.x);
+  const auto angle_bin_index = static_cast<std::uint32_t>((angle - MIN_ANGLE) / ANGLE_INCREMENT);
+  const float range = static_cast<float>(
+    hypot(static_cast<double>(scan_point.y), static_cast<double>(scan_point.x)));
+
+  // ranges are positive, so their bit patterns sort like their values
+  keys[idx] = (static_cast<unsigned long long>(angle_bin_index) << 32) |  // NOLINT
+              __float_as_uint(range);
+  order[idx] = static_cast<std::int32_t>(idx);
+  binned_points[idx] = make_float4(map_point.x, map_point.y, range, 0.0f);
+}
+
+__global__ void gatherPoints_kernel(
+  const float4 * binned_points, const std::int32_t * order, const std::size_t num_points,
+  float4 * sorted_points)
+{
+  const std::size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= num_points) return;
+  sorted_points[idx] = binned_points[order[idx]];
+}
+
+__global__ void binOffsets_kernel(
+  const unsigned long long * keys, const std::size_t num_points,  // NOLINT
+  const std::uint32_t num_bins, std::uint32_t * offsets)
+{
+  const std::uint32_t bin_index = blockIdx.x * blockDim.x + threadIdx.x;
+  if (bin_index > num_bins) return;
+
+  const unsigned long long key = static_cast<unsigned long long>(bin_index) << 32;  // NOLINT
+  std::size_t first = 0;
+  std::size_t count = num_points;
+  while (count > 0) {
+    const std::size_t step = count / 2;
+    if (keys[first + step] < key) {
+      first += step + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+  offsets[bin_index] = static_cast<std::uint32_t>(first);
+}
+
+// First step: Initialize cells to the final point with freespace
+__global__ void traceFreeSpace_kernel(
+  const float4 * raw_points, const std::uint32_t * raw_offsets, const float4 * obstacle_points,
+  const std::uint32_t * obstacle_offsets, const std::uint32_t num_bins, const double scan_origin_x,
+  const double scan_origin_y, const GridGeometry grid, std::uint8_t * costmap)
+{
+  const std::uint32_t bin_index = blockIdx.x * blockDim.x + threadIdx.x;
+  if (bin_index >= num_bins) return;
+
+  const std::uint32_t raw_begin = raw_offsets[bin_index];
+  const std::uint32_t raw_end = raw_offsets[bin_index + 1];
+  const std::uint32_t obstacle_begin = obstacle_offsets[bin_index];
+  const std::uint32_t obstacle_end = obstacle_offsets[bin_index + 1];
+
+  float4 end_distance;
+  if (raw_begin == raw_end && obstacle_begin == obstacle_end) {
+    return;
+  } else if (raw_begin == raw_end) {
+    end_distance = obstacle_points[obstacle_end - 1];
+  } else if (obstacle_begin == obstacle_end) {
+    end_distance = raw_points[raw_end - 1];
+  } else {
+    end_distance =
+      obstacle_points[obstacle_end - 1].z + DISTANCE_MARGIN < raw_points[raw_end - 1].z
+        ? raw_points[raw_end - 1]
+        : obstacle_points[obstacle_end - 1];
+  }
+  raytrace(
+    grid, costmap, scan_origin_x, scan_origin_y, end_distance.x, end_distance.y,
+    occupancy_cost_value::FREE_SPACE);
+}
+
+// Second step: Add unknown cell. The free cells at the raw points behind the obstacles are
+// written by a second launch, so that the result does not depend on the order of the bins.
+__global__ void traceUnknown_kernel(
+  const float4 * raw_points, const std::uint32_t * raw_offsets, const float4 * obstacle_points,
+  const std::uint32_t * obstacle_offsets, const std::uint32_t num_bins,
+  const bool write_free_targets, const GridGeometry grid, std::uint8_t * costmap)
+{
+  const std::uint32_t bin_index = blockIdx.x * blockDim.x + threadIdx.x;
+  if (bin_index >= num_bins) return;
+
+  const std::uint32_t raw_end = raw_offsets[bin_index + 1];
+  const std::uint32_t obstacle_end = obstacle_offsets[bin_index + 1];
+  std::uint32_t raw_index = raw_offsets[bin_index];
+  for (std::uint32_t dist_index = obstacle_offsets[bin_index]; dist_index < obstacle_end;
+       ++dist_index) {
+    const float4 source = obstacle_points[dist_index];
+
+    // Calculate next raw point from obstacle point
+    while (raw_index != raw_end && raw_points[raw_index].z < source.z + DISTANCE_MARGIN) {
+      ++raw_index;
+    }
+
+    // There is no point far than the obstacle point.
+    const bool no_freespace_point = (raw_index == raw_end);
+
+    if (dist_index + 1 == obstacle_end) {
+      if (!no_freespace_point) {
+        const float4 target = raw_points[raw_index];
+        if (write_free_targets) {
+          setCellValue(grid, costmap, target.x, target.y, occupancy_cost_value::FREE_SPACE);
+        } else {
+          raytrace(
+            grid, costmap, source.x, source.y, target.x, target.y,
+            occupancy_cost_value::NO_INFORMATION);
+        }
+      }
+      continue;
+    }
+
+    const float4 next_obstacle_point = obstacle_points[dist_index + 1];
+    const float next_obstacle_point_distance = fabsf(next_obstacle_point.z - source.z);
+    if (next_obstacle_point_distance <= DISTANCE_MARGIN) {
+      continue;
+    }
+
+    const bool trace_to_raw_point =
+      !no_freespace_point &&
+      fabsf(source.z - raw_points[raw_index].z) < next_obstacle_point_distance;
+    if (trace_to_raw_point) {
+      const float4 target = raw_points[raw_index];
+      if (write_free_targets) {
+        setCellValue(grid, costmap, target.x, target.y, occupancy_cost_value::FREE_SPACE);
+      } else {
+        raytrace(
+          grid, costmap, source.x, source.y, target.x, target.y,
+          occupancy_cost_value::NO_INFORMATION);
+      }
+    } else if (!write_free_targets) {
+      raytrace(
+        grid, costmap, source.x, source.y, next_obstacle_point.x, next_obstacle_point.y,
+        occupancy_cost_value::NO_INFORMATION);
+    }
+  }
+}
+
+// Third step: Overwrite occupied cell
+__global__ void traceOccupied_kernel(
+  const float4 * obstacle_points, const std::uint32_t * obstacle_offsets,
+  const std::uint32_t num_bins, const GridGeometry grid, std::uint8_t * costmap)
+{
+  const std::uint32_t bin_index = blockIdx.x * blockDim.x + threadIdx.x;
+  if (bin_index >= num_bins) return;
+
+  const std::uint32_t obstacle_end = obstacle_offsets[bin_index + 1];
+  for (std::uint32_t dist_index = obstacle_offsets[bin_index]; dist_index < obstacle_end;
+       ++dist_index) {
+    const float4 source = obstacle_points[dist_index];
+    setCellValue(grid, costmap, source.x, source.y, occupancy_cost_value::LETHAL_OBSTACLE);
+
+    if (dist_index + 1 == obstacle_end) {
+      continue;
+    }
+
+    const float4 target = obstacle_points[dist_index + 1];
+    if (fabsf(target.z - source.z) <= DISTANCE_MARGIN) {
+      raytrace(
+        grid, costmap, source.x, source.y, target.x, target.y,
+        occupancy_cost_value::LETHAL_OBSTACLE);
+    }
+  }
+}
+
+// window copy of nav2_costmap_2d::Costmap2D::updateOrigin()
+__global__ void shiftCostmap_kernel(
+  const std::uint8_t * costmap, const unsigned int size_x, const unsigned int size_y,
+  const int cell_ox, const int cell_oy, std::uint8_t * shifted_costmap)
+{
+  const unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= size_x * size_y) return;
+
+  const int x = static_cast<int>(idx % size_x) + cell_ox;
+  const int y = static_cast<int>(idx / size_x) + cell_oy;
+  const bool inside =
+    0 <= x && x < static_cast<int>(size_x) && 0 <= y && y < static_cast<int>(size_y);
+  shifted_costmap[idx] = inside ? costmap[y * size_x + x] : occupancy_cost_value::NO_INFORMATION;
+}
+
+// OccupancyGridMapBBFUpdater::applyBBF() on every cell
+__global__ void applyBBF_kernel(
+  const std::uint8_t * single_frame_costmap, const std::size_t num_cells, const float occ_occ,
+  const float free_occ, const float free_free, const float occ_free, std::uint8_t * costmap)
+{
+  const std::size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= num_cells) return;
+
+  const std::uint8_t z = single_frame_costmap[idx];
+  constexpr float cost2p = 1.f / 255.f;
+  const float po = costmap[idx] * cost2p;
+  float pz{};
+  float not_pz{};
+  float po_hat{};
+  if (z == occupancy_cost_value::LETHAL_OBSTACLE) {
+    pz = occ_occ;
+    not_pz = free_occ;
+    po_hat = ((po * pz) / ((po * pz) + ((1.f - po) * not_pz)));
+  } else if (z == occupancy_cost_value::FREE_SPACE) {
+    pz = 1.f - free_free;
+    not_pz = 1.f - occ_free;
+    po_hat = ((po * pz) / ((po * pz) + ((1.f - po) * not_pz)));
+  } else if (z == occupancy_cost_value::NO_INFORMATION) {
+    constexpr float inv_v_ratio = 1.f / 10.f;
+    po_hat = ((po + (0.5f * inv_v_ratio)) / ((1.f * inv_v_ratio) + 1.f));
+  }
+  costmap[idx] = min(max(static_cast<std::uint8_t>(po_hat * 255.f + 0.5f), 1), 254);
+}
+
+__global__ void translateCost_kernel(
+  const std::uint8_t * costmap, const std::size_t num_cells, const std::int8_t * table,
+  std::int8_t * occupancy_grid)
+{
+  const std::size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= num_cells) return;
+  occupancy_grid[idx] = table[costmap[idx]];
+}
+
+CudaOccupancyGridMap::CudaOccupancyGridMap(
+  const unsigned int cells_size_x, const unsigned int cells_size_y, const float resolution)
+: stream_(cuda_utils::makeCudaStream(cudaStreamNonBlocking)),
+  size_x_(cells_size_x),
+  size_y_(cells_size_y),
+  resolution_(resolution)
+{
+  const std::size_t num_cells = static_cast<std::size_t>(size_x_) * size_y_;
+  single_frame_costmap_d_ = cuda_utils::make_unique<std::uint8_t[]>(num_cells);
+  accumulated_costmap_d_ = cuda_utils::make_unique<std::uint8_t[]>(num_cells);
+  shifted_costmap_d_ = cuda_utils::make_unique<std::uint8_t[]>(num_cells);
+  occupancy_grid_d_ = cuda_utils::make_unique<std::int8_t[]>(num_cells);
+  occupancy_grid_h_ = cuda_utils::make_unique_host<std::int8_t[]>(num_cells, cudaHostAllocDefault);
+  cost_translation_table_d_ = cuda_utils::make_unique<std::int8_t[]>(256);
+
+  CHECK_CUDA_ERROR(cudaMemsetAsync(
+    accumulated_costmap_d_.get(), occupancy_cost_value::NO_INFORMATION, num_cells, *stream_));
+  CHECK_CUDA_ERROR(cudaMemcpyAsync(
+    cost_translation_table_d_.get(), occupancy_cost_value::cost_translation_table.data, 256,
+    cudaMemcpyHostToDevice, *stream_));
+  CHECK_CUDA_ERROR(cudaStreamSynchronize(*stream_));
+}
+
+void CudaOccupancyGridMap::reserve(DeviceAngleBins & angle_bins, const std::size_t num_points)
+{
+  if (!angle_bins.offsets_d) {
+    angle_bins.offsets_d = cuda_utils::make_unique<std::uint32_t[]>(ANGLE_BIN_SIZE + 1);
+  }
+  if (num_points > angle_bins.capacity) {
+    angle_bins.capacity = nextPowerOfTwo(num_points);
+    angle_bins.points_h =
+      cuda_utils::make_unique_host<float4[]>(angle_bins.capacity, cudaHostAllocDefault);
+    angle_bins.points_d = cuda_utils::make_unique<float4[]>(angle_bins.capacity);
+    angle_bins.keys_d = cuda_utils::make_unique<unsigned long long[]>(  // NOLINT
+      angle_bins.capacity);
+    angle_bins.order_d = cuda_utils::make_unique<std::int32_t[]>(angle_bins.capacity);
+    angle_bins.binned_points_d = cuda_utils::make_unique<float4[]>(angle_bins.capacity);
+    angle_bins.sorted_points_d = cuda_utils::make_unique<float4[]>(angle_bins.capacity);
+  }
+}
+
+float4 * CudaOccupancyGridMap::rawPointsHost(const std::size_t num_points)
+{
+  reserve(raw_angle_bins_, num_points);
+  return raw_angle_bins_.points_h.get();
+}
+
+float4 * CudaOccupancyGridMap::obstaclePointsHost(const std::size_t num_points)
+{
+  reserve(obstacle_angle_bins_, num_points);
+  return obstacle_angle_bins_.points_h.get();
+}
+
+void CudaOccupancyGridMap::binPoints(
+  DeviceAngleBins & angle_bins, const std::size_t num_points, const CudaTransform & map2robot,
+  const CudaTransform & scan2map)
+{
+  reserve(angle_bins, num_points);
+  if (num_points > 0) {
+    CHECK_CUDA_ERROR(cudaMemcpyAsync(
+      angle_bins.points_d.get(), angle_bins.points_h.get(), num_points * sizeof(float4),
+      cudaMemcpyHostToDevice, *stream_));
+
+    const std::size_t blocks = divup(num_points, THREADS_PER_BLOCK);
+    binPoints_kernel<<<blocks, THREADS_PER_BLOCK, 0, *stream_>>>(
+      angle_bins.points_d.get(), num_points, map2robot, scan2map, angle_bins.keys_d.get(),
+      angle_bins.order_d.get(), angle_bins.binned_points_d.get());
+    thrust::sort_by_key(
+      thrust::cuda::par.on(*stream_), angle_bins.keys_d.get(),
+      angle_bins.keys_d.get() + num_points, angle_bins.order_d.get());
+    gatherPoints_kernel<<<blocks, THREADS_PER_BLOCK, 0, *stream_>>>(
+      angle_bins.binned_points_d.get(), angle_bins.order_d.get(), num_points,
+      angle_bins.sorted_points_d.get());
+  }
+  binOffsets_kernel<<<divup(ANGLE_BIN_SIZE + 1, THREADS_PER_BLOCK), THREADS_PER_BLOCK, 0,
+                      *stream_>>>(
+    angle_bins.keys_d.get(), num_points, ANGLE_BIN_SIZE, angle_bins.offsets_d.get());
+}
+
+void CudaOccupancyGridMap::updateAccumulatedOrigin(double new_origin_x, double new_origin_y)
+{
+  // same grid alignment as nav2_costmap_2d::Costmap2D::updateOrigin()
+  const int cell_ox =
+    static_cast<int>(std::floor((new_origin_x - accumulated_origin_x_) / resolution_));
+  const int cell_oy =
+    static_cast<int>(std::floor((new_origin_y - accumulated_origin_y_) / resolution_));
+  accumulated_origin_x_ += cell_ox * resolution_;
+  accumulated_origin_y_ += cell_oy * resolution_;
+  if (cell_ox == 0 && cell_oy == 0) {
+    return;
+  }
+
+  const std::size_t num_cells = static_cast<std::size_t>(size_x_) * size_y_;
+  shiftCostmap_kernel<<<divup(num_cells, THREADS_PER_BLOCK), THREADS_PER_BLOCK, 0, *stream_>>>(
+    accumulated_costmap_d_.get(), size_x_, size_y_, cell_ox, cell_oy, shifted_costmap_d_.get());
+  std::swap(accumulated_costmap_d_, shifted_costmap_d_);
+}
+
+void CudaOccupancyGridMap::updateWithPointCloud(
+  const std::size_t num_raw_points, const std::size_t num_obstacle_points,
+  const CudaTransform & map2robot, const CudaTransform & scan2map, const double scan_origin_x,
+  const double scan_origin_y, const double single_frame_origin_x,
+  const double single_frame_origin_y, const bool update_bayes_filter)
+{
+  const std::size_t num_cells = static_cast<std::size_t>(size_x_) * size_y_;
+  const std::size_t cell_blocks = divup(num_cells, THREADS_PER_BLOCK);
+  const std::size_t bin_blocks = divup(ANGLE_BIN_SIZE, THREADS_PER_BLOCK);
+
+  binPoints(raw_angle_bins_, num_raw_points, map2robot, scan2map);
+  binPoints(obstacle_angle_bins_, num_obstacle_points, map2robot, scan2map);
+
+  // same origin as OccupancyGridMap::resetMapsWithOrigin()
+  GridGeometry grid;
+  grid.origin_x = std::floor(single_frame_origin_x / resolution_) * resolution_;
+  grid.origin_y = std::floor(single_frame_origin_y / resolution_) * resolution_;
+  grid.resolution = resolution_;
+  grid.size_x = size_x_;
+  grid.size_y = size_y_;
+
+  std::uint8_t * single_frame_costmap = single_frame_costmap_d_.get();
+  CHECK_CUDA_ERROR(cudaMemsetAsync(
+    single_frame_costmap, occupancy_cost_value::NO_INFORMATION, num_cells, *stream_));
+
+  const float4 * raw_points = raw_angle_bins_.sorted_points_d.get();
+  const std::uint32_t * raw_offsets = raw_angle_bins_.offsets_d.get();
+  const float4 * obstacle_points = obstacle_angle_bins_.sorted_points_d.get();
+  const std::uint32_t * obstacle_offsets = obstacle_angle_bins_.offsets_d.get();
+  traceFreeSpace_kernel<<<bin_blocks, THREADS_PER_BLOCK, 0, *stream_>>>(
+    raw_points, raw_offsets, obstacle_points, obstacle_offsets, ANGLE_BIN_SIZE, scan_origin_x,
+    scan_origin_y, grid, single_frame_costmap);
+  traceUnknown_kernel<<<bin_blocks, THREADS_PER_BLOCK, 0, *stream_>>>(
+    raw_points, raw_offsets, obstacle_points, obstacle_offsets, ANGLE_BIN_SIZE, false, grid,
+    single_frame_costmap);
+  traceUnknown_kernel<<<bin_blocks, THREADS_PER_BLOCK, 0, *stream_>>>(
+    raw_points, raw_offsets, obstacle_points, obstacle_offsets, ANGLE_BIN_SIZE, true, grid,
+    single_frame_costmap);
+  traceOccupied_kernel<<<bin_blocks, THREADS_PER_BLOCK, 0, *stream_>>>(
+    obstacle_points, obstacle_offsets, ANGLE_BIN_SIZE, grid, single_frame_costmap);
+
+  if (update_bayes_filter) {
+    // same probabilities as OccupancyGridMapBBFUpdater
+    const float occ_occ = 0.95;
+    const float free_occ = 1.0 - occ_occ;
+    const float free_free = 0.8;
+    const float occ_free = 1.0 - free_free;
+    updateAccumulatedOrigin(grid.origin_x, grid.origin_y);
+    applyBBF_kernel<<<cell_blocks, THREADS_PER_BLOCK, 0, *stream_>>>(
+      single_frame_costmap, num_cells, occ_occ, free_occ, free_free, occ_free,
+      accumulated_costmap_d_.get());
+    output_costmap_d_ = accumulated_costmap_d_.get();
+    output_origin_x_ = accumulated_origin_x_;
+    output_origin_y_ = accumulated_origin_y_;
+  } else {
+    output_costmap_d_ = single_frame_costmap;
+    output_origin_x_ = grid.origin_x;
+    output_origin_y_ = grid.origin_y;
+  }
+  CHECK_CUDA_ERROR(cudaGetLastError());
+
+  translateCost_kernel<<<cell_blocks, THREADS_PER_BLOCK, 0, *stream_>>>(
+    output_costmap_d_, num_cells, cost_translation_table_d_.get(), occupancy_grid_d_.get());
+  CHECK_CUDA_ERROR(cudaMemcpyAsync(
+    occupancy_grid_h_.get(), occupancy_grid_d_.get(), num_cells, cudaMemcpyDeviceToHost,
+    *stream_));
+  CHECK_CUDA_ERROR(cudaStreamSynchronize(*stream_));
+}
+}  // namespace costmap_2d
@@ -69,13 +69,26 @@
 #endif
 
 #include <algorithm>
+#include <cmath>
+
+namespace
+{
+constexpr double min_angle = tier4_autoware_utils::deg2rad(-180.0);
+constexpr double max_angle = tier4_autoware_utils::deg2rad(180.0);
+constexpr double angle_increment = tier4_autoware_utils::deg2rad(0.1);
+const std::size_t angle_bin_size =
+  ((max_angle - min_angle) / angle_increment) + std::size_t(1 /*margin*/);
+}  // namespace
+
 namespace costmap_2d
 {
 using sensor_msgs::PointCloud2ConstIterator;
 
 OccupancyGridMap::OccupancyGridMap(
-  const unsigned int cells_size_x, const unsigned int cells_size_y, const float resolution)
-: Costmap2D(cells_size_x, cells_size_y, resolution, 0.f, 0.f, occupancy_cost_value::NO_INFORMATION)
+  const unsigned int cells_size_x, const unsigned int cells_size_y, const float resolution,
+  const int num_threads)
+: Costmap2D(cells_size_x, cells_size_y, resolution, 0.f, 0.f, occupancy_cost_value::NO_INFORMATION),
+  num_threads_(std::max(num_threads, 1))
 {
 }
 
@@ -146,6 +159,74 @@ void OccupancyGridMap::updateOrigin(double new_origin_x, double new_origin_y)
   delete[] local_map;
 }
 
+void OccupancyGridMap::resetMapsWithOrigin(double new_origin_x, double new_origin_y)
+{
+  resetMaps();
+  origin_x_ = std::floor(new_origin_x / resolution_) * resolution_;
+  origin_y_ = std::floor(new_origin_y / resolution_) * resolution_;
+}
+
+/**
+ * @brief sort a point cloud into angle bins in a single pass
+ *
+ * The points are transformed to the map frame (wx, wy) and then to the scan frame (angle, range)
+ * with the same float arithmetic as two utils::transformPointcloud() calls, and counting-sorted
+ * into flat storage.
+ */
+void OccupancyGridMap::binPointCloud(
+  const PointCloud2 & pointcloud, const Pose & robot_pose, const Pose & scan2map_pose,
+  AngleBins & angle_bins) const
+{
+  const Eigen::Matrix4f map2robot =
+    tf2::transformToEigen(tier4_autoware_utils::pose2transform(robot_pose)).matrix().cast<float>();
+  const Eigen::Matrix4f scan2map =
+    tf2::transformToEigen(tier4_autoware_utils::pose2transform(scan2map_pose))
+      .matrix()
+      .cast<float>();
+
+  const std::size_t num_points = pointcloud.width * pointcloud.height;
+  angle_bins.unsorted_points.clear();
+  angle_bins.bin_indices.clear();
+  angle_bins.unsorted_points.reserve(num_points);
+  angle_bins.bin_indices.reserve(num_points);
+  angle_bins.offsets.assign(angle_bin_size + 1, 0);
+
+  for (PointCloud2ConstIterator<float> iter_x(pointcloud, "x"), iter_y(pointcloud, "y"),
+       iter_z(pointcloud, "z");
+       iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
+    if (!std::isfinite(*iter_x) || !std::isfinite(*iter_y) || !std::isfinite(*iter_z)) {
+      continue;
+    }
+    const Eigen::Vector4f map_point = map2robot * Eigen::Vector4f(*iter_x, *iter_y, *iter_z, 1.0f);
+    const Eigen::Vector4f scan_point = scan2map * map_point;
+    const double angle = atan2(scan_point.y(), scan_point.x());
+    const std::uint32_t angle_bin_index = (angle - min_angle) / angle_increment;
+    angle_bins.unsorted_points.push_back(
+      BinInfo{std::hypot(scan_point.y(), scan_point.x()), map_point.x(), map_point.y()});
+    angle_bins.bin_indices.push_back(angle_bin_index);
+    ++angle_bins.offsets.at(angle_bin_index + 1);
+  }
+
+  for (std::size_t bin_index = 0; bin_index < angle_bin_size; ++bin_index) {
+    angle_bins.offsets[bin_index + 1] += angle_bins.offsets[bin_index];
+  }
+  angle_bins.cursors.assign(angle_bins.offsets.begin(), angle_bins.offsets.end() - 1);
+  angle_bins.points.resize(angle_bins.unsorted_points.size());
+  for (std::size_t i = 0; i < angle_bins.unsorted_points.size(); ++i) {
+    angle_bins.points[angle_bins.cursors[angle_bins.bin_indices[i]]++] =
+      angle_bins.unsorted_points[i];
+  }
+
+  // Sort by distance
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic)
+  for (std::size_t bin_index = 0; bin_index < angle_bin_size; ++bin_index) {
+    std::sort(
+      angle_bins.points.begin() + angle_bins.offsets[bin_index],
+      angle_bins.points.begin() + angle_bins.offsets[bin_index + 1],
+      [](const BinInfo & a, const BinInfo & b) { return a.range < b.range; });
+  }
+}
+
 /**
  * @brief update Gridmap with PointCloud
  *
@@ -158,87 +239,41 @@ void OccupancyGridMap::updateWithPointCloud(
   const PointCloud2 & raw_pointcloud, const PointCloud2 & obstacle_pointcloud,
   const Pose & robot_pose, const Pose & scan_origin)
 {
-  constexpr double min_angle = tier4_autoware_utils::deg2rad(-180.0);
-  constexpr double max_angle = tier4_autoware_utils::deg2rad(180.0);
-  constexpr double angle_increment = tier4_autoware_utils::deg2rad(0.1);
-  const size_t angle_bin_size = ((max_angle - min_angle) / angle_increment) + size_t(1 /*margin*/);
-
-  // Transform from base_link to map frame
-  PointCloud2 map_raw_pointcloud, map_obstacle_pointcloud;  // point cloud in map frame
-  utils::transformPointcloud(raw_pointcloud, robot_pose, map_raw_pointcloud);
-  utils::transformPointcloud(obstacle_pointcloud, robot_pose, map_obstacle_pointcloud);
-
-  // Transform from map frame to scan frame
-  PointCloud2 scan_raw_pointcloud, scan_obstacle_pointcloud;      // point cloud in scan frame
+  // Create angle bins
   const auto scan2map_pose = utils::getInversePose(scan_origin);  // scan -> map transform pose
-  utils::transformPointcloud(map_raw_pointcloud, scan2map_pose, scan_raw_pointcloud);
-  utils::transformPointcloud(map_obstacle_pointcloud, scan2map_pose, scan_obstacle_pointcloud);
+  binPointCloud(raw_pointcloud, robot_pose, scan2map_pose, raw_angle_bins_);
+  binPointCloud(obstacle_pointcloud, robot_pose, scan2map_pose, obstacle_angle_bins_);
 
-  // Create angle bins
-  struct BinInfo
-  {
-    BinInfo() = default;
-    BinInfo(const double _range, const double _wx, const double _wy)
-    : range(_range), wx(_wx), wy(_wy)
-    {
-    }
-    double range;
-    double wx;
-    double wy;
-  };
-  std::vector</*angle bin*/ std::vector<BinInfo>> obstacle_pointcloud_angle_bins;
-  std::vector</*angle bin*/ std::vector<BinInfo>> raw_pointcloud_angle_bins;
-  obstacle_pointcloud_angle_bins.resize(angle_bin_size);
-  raw_pointcloud_angle_bins.resize(angle_bin_size);
-  for (PointCloud2ConstIterator<float> iter_x(scan_raw_pointcloud, "x"),
-       iter_y(scan_raw_pointcloud, "y"), iter_wx(map_raw_pointcloud, "x"),
-       iter_wy(map_raw_pointcloud, "y");
-       iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_wx, ++iter_wy) {
-    const double angle = atan2(*iter_y, *iter_x);
-    const int angle_bin_index = (angle - min_angle) / angle_increment;
-    raw_pointcloud_angle_bins.at(angle_bin_index)
-      .push_back(BinInfo(std::hypot(*iter_y, *iter_x), *iter_wx, *iter_wy));
-  }
-  for (PointCloud2ConstIterator<float> iter_x(scan_obstacle_pointcloud, "x"),
-       iter_y(scan_obstacle_pointcloud, "y"), iter_wx(map_obstacle_pointcloud, "x"),
-       iter_wy(map_obstacle_pointcloud, "y");
-       iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_wx, ++iter_wy) {
-    const double angle = atan2(*iter_y, *iter_x);
-    int angle_bin_index = (angle - min_angle) / angle_increment;
-    obstacle_pointcloud_angle_bins.at(angle_bin_index)
-      .push_back(BinInfo(std::hypot(*iter_y, *iter_x), *iter_wx, *iter_wy));
-  }
+  const auto & raw_points = raw_angle_bins_.points;
+  const auto & raw_offsets = raw_angle_bins_.offsets;
+  const auto & obstacle_points = obstacle_angle_bins_.points;
+  const auto & obstacle_offsets = obstacle_angle_bins_.offsets;
 
-  // Sort by distance
-  for (auto & obstacle_pointcloud_angle_bin : obstacle_pointcloud_angle_bins) {
-    std::sort(
-      obstacle_pointcloud_angle_bin.begin(), obstacle_pointcloud_angle_bin.end(),
-      [](auto a, auto b) { return a.range < b.range; });
-  }
-  for (auto & raw_pointcloud_angle_bin : raw_pointcloud_angle_bins) {
-    std::sort(raw_pointcloud_angle_bin.begin(), raw_pointcloud_angle_bin.end(), [](auto a, auto b) {
-      return a.range < b.range;
-    });
-  }
+  // First and third steps write a single cost value, so the rays of different bins can be traced
+  // in parallel: where they cross the same cells the result does not depend on the order.
+  // Second step writes both unknown and free cells and keeps the bin order.
 
   // First step: Initialize cells to the final point with freespace
   constexpr double distance_margin = 1.0;
-  for (size_t bin_index = 0; bin_index < obstacle_pointcloud_angle_bins.size(); ++bin_index) {
-    auto & obstacle_pointcloud_angle_bin = obstacle_pointcloud_angle_bins.at(bin_index);
-    auto & raw_pointcloud_angle_bin = raw_pointcloud_angle_bins.at(bin_index);
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic)
+  for (std::size_t bin_index = 0; bin_index < angle_bin_size; ++bin_index) {
+    const std::size_t raw_begin = raw_offsets[bin_index];
+    const std::size_t raw_end = raw_offsets[bin_index + 1];
+    const std::size_t obstacle_begin = obstacle_offsets[bin_index];
+    const std::size_t obstacle_end = obstacle_offsets[bin_index + 1];
 
     BinInfo end_distance;
-    if (raw_pointcloud_angle_bin.empty() && obstacle_pointcloud_angle_bin.empty()) {
+    if (raw_begin == raw_end && obstacle_begin == obstacle_end) {
       continue;
-    } else if (raw_pointcloud_angle_bin.empty()) {
-      end_distance = obstacle_pointcloud_angle_bin.back();
-    } else if (obstacle_pointcloud_angle_bin.empty()) {
-      end_distance = raw_pointcloud_angle_bin.back();
+    } else if (raw_begin == raw_end) {
+      end_distance = obstacle_points[obstacle_end - 1];
+    } else if (obstacle_begin == obstacle_end) {
+      end_distance = raw_points[raw_end - 1];
     } else {
-      end_distance = obstacle_pointcloud_angle_bin.back().range + distance_margin <
-                         raw_pointcloud_angle_bin.back().range
-                       ? raw_pointcloud_angle_bin.back()
-                       : obstacle_pointcloud_angle_bin.back();
+      end_distance =
+        obstacle_points[obstacle_end - 1].range + distance_margin < raw_points[raw_end - 1].range
+          ? raw_points[raw_end - 1]
+          : obstacle_points[obstacle_end - 1];
     }
     raytrace(
       scan_origin.position.x, scan_origin.position.y, end_distance.wx, end_distance.wy,
@@ -246,28 +281,28 @@ void OccupancyGridMap::updateWithPointCloud(
   }
 
   // Second step: Add uknown cell
-  for (size_t bin_index = 0; bin_index < obstacle_pointcloud_angle_bins.size(); ++bin_index) {
-    auto & obstacle_pointcloud_angle_bin = obstacle_pointcloud_angle_bins.at(bin_index);
-    auto & raw_pointcloud_angle_bin = raw_pointcloud_angle_bins.at(bin_index);
-    auto raw_distance_iter = raw_pointcloud_angle_bin.begin();
-    for (size_t dist_index = 0; dist_index < obstacle_pointcloud_angle_bin.size(); ++dist_index) {
+  for (std::size_t bin_index = 0; bin_index < angle_bin_size; ++bin_index) {
+    const std::size_t raw_end = raw_offsets[bin_index + 1];
+    const std::size_t obstacle_end = obstacle_offsets[bin_index + 1];
+    std::size_t raw_index = raw_offsets[bin_index];
+    for (std::size_t dist_index = obstacle_offsets[bin_index]; dist_index < obstacle_end;
+         ++dist_index) {
+      const auto & source = obstacle_points[dist_index];
+
       // Calculate next raw point from obstacle point
-      while (raw_distance_iter != raw_pointcloud_angle_bin.end()) {
-        if (
-          raw_distance_iter->range <
-          obstacle_pointcloud_angle_bin.at(dist_index).range + distance_margin)
-          raw_distance_iter++;
+      while (raw_index != raw_end) {
+        if (raw_points[raw_index].range < source.range + distance_margin)
+          raw_index++;
         else
           break;
       }
 
       // There is no point far than the obstacle point.
-      const bool no_freespace_point = (raw_distance_iter == raw_pointcloud_angle_bin.end());
+      const bool no_freespace_point = (raw_index == raw_end);
 
-      if (dist_index + 1 == obstacle_pointcloud_angle_bin.size()) {
-        const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
+      if (dist_index + 1 == obstacle_end) {
         if (!no_freespace_point) {
-          const auto & target = *raw_distance_iter;
+          const auto & target = raw_points[raw_index];
           raytrace(
             source.wx, source.wy, target.wx, target.wy, occupancy_cost_value::NO_INFORMATION);
           setCellValue(target.wx, target.wy, occupancy_cost_value::FREE_SPACE);
@@ -275,29 +310,24 @@ void OccupancyGridMap::updateWithPointCloud(
         continue;
       }
 
-      auto next_obstacle_point_distance = std::abs(
-        obstacle_pointcloud_angle_bin.at(dist_index + 1).range -
-        obstacle_pointcloud_angle_bin.at(dist_index).range);
+      const auto & next_obstacle_point = obstacle_points[dist_index + 1];
+      auto next_obstacle_point_distance = std::abs(next_obstacle_point.range - source.range);
       if (next_obstacle_point_distance <= distance_margin) {
         continue;
       } else if (no_freespace_point) {
-        const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
-        const auto & target = obstacle_pointcloud_angle_bin.at(dist_index + 1);
+        const auto & target = next_obstacle_point;
         raytrace(source.wx, source.wy, target.wx, target.wy, occupancy_cost_value::NO_INFORMATION);
         continue;
       }
 
-      auto next_raw_distance =
-        std::abs(obstacle_pointcloud_angle_bin.at(dist_index).range - raw_distance_iter->range);
+      auto next_raw_distance = std::abs(source.range - raw_points[raw_index].range);
       if (next_raw_distance < next_obstacle_point_distance) {
-        const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
-        const auto & target = *raw_distance_iter;
+        const auto & target = raw_points[raw_index];
         raytrace(source.wx, source.wy, target.wx, target.wy, occupancy_cost_value::NO_INFORMATION);
         setCellValue(target.wx, target.wy, occupancy_cost_value::FREE_SPACE);
         continue;
       } else {
-        const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
-        const auto & target = obstacle_pointcloud_angle_bin.at(dist_index + 1);
+        const auto & target = next_obstacle_point;
         raytrace(source.wx, source.wy, target.wx, target.wy, occupancy_cost_value::NO_INFORMATION);
         continue;
       }
@@ -305,22 +335,21 @@ void OccupancyGridMap::updateWithPointCloud(
   }
 
   // Third step: Overwrite occupied cell
-  for (size_t bin_index = 0; bin_index < obstacle_pointcloud_angle_bins.size(); ++bin_index) {
-    auto & obstacle_pointcloud_angle_bin = obstacle_pointcloud_angle_bins.at(bin_index);
-    for (size_t dist_index = 0; dist_index < obstacle_pointcloud_angle_bin.size(); ++dist_index) {
-      const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic)
+  for (std::size_t bin_index = 0; bin_index < angle_bin_size; ++bin_index) {
+    const std::size_t obstacle_end = obstacle_offsets[bin_index + 1];
+    for (std::size_t dist_index = obstacle_offsets[bin_index]; dist_index < obstacle_end;
+         ++dist_index) {
+      const auto & source = obstacle_points[dist_index];
       setCellValue(source.wx, source.wy, occupancy_cost_value::LETHAL_OBSTACLE);
 
-      if (dist_index + 1 == obstacle_pointcloud_angle_bin.size()) {
+      if (dist_index + 1 == obstacle_end) {
         continue;
       }
 
-      auto next_obstacle_point_distance = std::abs(
-        obstacle_pointcloud_angle_bin.at(dist_index + 1).range -
-        obstacle_pointcloud_angle_bin.at(dist_index).range);
+      const auto & target = obstacle_points[dist_index + 1];
+      auto next_obstacle_point_distance = std::abs(target.range - source.range);
       if (next_obstacle_point_distance <= distance_margin) {
-        const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
-        const auto & target = obstacle_pointcloud_angle_bin.at(dist_index + 1);
         raytrace(source.wx, source.wy, target.wx, target.wy, occupancy_cost_value::LETHAL_OBSTACLE);
         continue;
       }
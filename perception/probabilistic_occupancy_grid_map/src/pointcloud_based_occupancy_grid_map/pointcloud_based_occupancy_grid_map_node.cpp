@@ -34,8 +34,10 @@
 #endif
 
 #include <algorithm>
+#include <cmath>
 #include <memory>
 #include <string>
+#include <utility>
 
 namespace occupancy_grid_map
 {
@@ -61,6 +63,7 @@ PointcloudBasedOccupancyGridMapNode::PointcloudBasedOccupancyGridMapNode(
     declare_parameter("filter_obstacle_pointcloud_by_raw_pointcloud", false);
   const double map_length{declare_parameter("map_length", 100.0)};
   const double map_resolution{declare_parameter("map_resolution", 0.5)};
+  const int num_threads{static_cast<int>(declare_parameter("num_threads", 1))};
 
   /* Subscriber and publisher */
   obstacle_pointcloud_sub_.subscribe(
@@ -77,6 +80,21 @@ PointcloudBasedOccupancyGridMapNode::PointcloudBasedOccupancyGridMapNode(
   /* Occupancy grid */
   occupancy_grid_map_updater_ptr_ = std::make_shared<OccupancyGridMapBBFUpdater>(
     map_length / map_resolution, map_length / map_resolution, map_resolution);
+  single_frame_occupancy_grid_map_ptr_ = std::make_unique<OccupancyGridMap>(
+    occupancy_grid_map_updater_ptr_->getSizeInCellsX(),
+    occupancy_grid_map_updater_ptr_->getSizeInCellsY(),
+    occupancy_grid_map_updater_ptr_->getResolution(), num_threads);
+
+  if (declare_parameter("use_gpu", false)) {
+#ifdef PROBABILISTIC_OCCUPANCY_GRID_MAP_WITH_CUDA
+    cuda_occupancy_grid_map_ptr_ = std::make_unique<costmap_2d::CudaOccupancyGridMap>(
+      occupancy_grid_map_updater_ptr_->getSizeInCellsX(),
+      occupancy_grid_map_updater_ptr_->getSizeInCellsY(),
+      occupancy_grid_map_updater_ptr_->getResolution());
+#else
+    RCLCPP_WARN(get_logger(), "built without CUDA, falling back to the CPU occupancy grid map");
+#endif
+  }
 
   // initialize debug tool
   {
@@ -142,32 +160,40 @@ void PointcloudBasedOccupancyGridMapNode::onPointcloudWithObstacleAndRaw(
     return;
   }
 
-  // Create single frame occupancy grid map
-  OccupancyGridMap single_frame_occupancy_grid_map(
-    occupancy_grid_map_updater_ptr_->getSizeInCellsX(),
-    occupancy_grid_map_updater_ptr_->getSizeInCellsY(),
-    occupancy_grid_map_updater_ptr_->getResolution());
-  single_frame_occupancy_grid_map.updateOrigin(
-    gridmap_origin.position.x - single_frame_occupancy_grid_map.getSizeInMetersX() / 2,
-    gridmap_origin.position.y - single_frame_occupancy_grid_map.getSizeInMetersY() / 2);
-  single_frame_occupancy_grid_map.updateWithPointCloud(
-    filtered_raw_pc, filtered_obstacle_pc_common, robot_pose, scan_origin);
-
-  if (enable_single_frame_mode_) {
-    // publish
-    occupancy_grid_map_pub_->publish(OccupancyGridMapToMsgPtr(
-      map_frame_, input_raw_msg->header.stamp, robot_pose.position.z,
-      single_frame_occupancy_grid_map));  // (todo) robot_pose may be altered with gridmap_origin
-  } else {
-    // Update with bayes filter
-    occupancy_grid_map_updater_ptr_->update(single_frame_occupancy_grid_map);
+  OccupancyGrid::UniquePtr occupancy_grid_msg_ptr;
+#ifdef PROBABILISTIC_OCCUPANCY_GRID_MAP_WITH_CUDA
+  if (cuda_occupancy_grid_map_ptr_) {
+    occupancy_grid_msg_ptr = updateWithCuda(
+      filtered_raw_pc, filtered_obstacle_pc_common, robot_pose, gridmap_origin, scan_origin,
+      input_raw_msg->header.stamp);
+  }
+#endif
+  if (!occupancy_grid_msg_ptr) {
+    // Create single frame occupancy grid map
+    OccupancyGridMap & single_frame_occupancy_grid_map = *single_frame_occupancy_grid_map_ptr_;
+    single_frame_occupancy_grid_map.resetMapsWithOrigin(
+      gridmap_origin.position.x - single_frame_occupancy_grid_map.getSizeInMetersX() / 2,
+      gridmap_origin.position.y - single_frame_occupancy_grid_map.getSizeInMetersY() / 2);
+    single_frame_occupancy_grid_map.updateWithPointCloud(
+      filtered_raw_pc, filtered_obstacle_pc_common, robot_pose, scan_origin);
 
-    // publish
-    occupancy_grid_map_pub_->publish(OccupancyGridMapToMsgPtr(
-      map_frame_, input_raw_msg->header.stamp, robot_pose.position.z,
-      *occupancy_grid_map_updater_ptr_));
+    if (enable_single_frame_mode_) {
+      occupancy_grid_msg_ptr = OccupancyGridMapToMsgPtr(
+        map_frame_, input_raw_msg->header.stamp, robot_pose.position.z,
+        single_frame_occupancy_grid_map);  // (todo) robot_pose may be altered with gridmap_origin
+    } else {
+      // Update with bayes filter
+      occupancy_grid_map_updater_ptr_->update(single_frame_occupancy_grid_map);
+
+      occupancy_grid_msg_ptr = OccupancyGridMapToMsgPtr(
+        map_frame_, input_raw_msg->header.stamp, robot_pose.position.z,
+        *occupancy_grid_map_updater_ptr_);
+    }
   }
 
+  // publish
+  occupancy_grid_map_pub_->publish(std::move(occupancy_grid_msg_ptr));
+
   if (debug_publisher_ptr_ && stop_watch_ptr_) {
     const double cyclic_time_ms = stop_watch_ptr_->toc("cyclic_time", true);
     const double processing_time_ms = stop_watch_ptr_->toc("processing_time", true);
@@ -208,6 +234,66 @@ OccupancyGrid::UniquePtr PointcloudBasedOccupancyGridMapNode::OccupancyGridMapTo
   return msg_ptr;
 }
 
+#ifdef PROBABILISTIC_OCCUPANCY_GRID_MAP_WITH_CUDA
+OccupancyGrid::UniquePtr PointcloudBasedOccupancyGridMapNode::updateWithCuda(
+  const PointCloud2 & raw_pointcloud, const PointCloud2 & obstacle_pointcloud,
+  const Pose & robot_pose, const Pose & gridmap_origin, const Pose & scan_origin,
+  const Time & stamp)
+{
+  auto & cuda_map = *cuda_occupancy_grid_map_ptr_;
+
+  const auto copy_points = [](const PointCloud2 & pointcloud, float4 * points) {
+    std::size_t num_points = 0;
+    for (sensor_msgs::PointCloud2ConstIterator<float> iter_x(pointcloud, "x"),
+         iter_y(pointcloud, "y"), iter_z(pointcloud, "z");
+         iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
+      if (std::isfinite(*iter_x) && std::isfinite(*iter_y) && std::isfinite(*iter_z)) {
+        points[num_points++] = float4{*iter_x, *iter_y, *iter_z, 0.0f};
+      }
+    }
+    return num_points;
+  };
+  const std::size_t num_raw_points = copy_points(
+    raw_pointcloud, cuda_map.rawPointsHost(raw_pointcloud.width * raw_pointcloud.height));
+  const std::size_t num_obstacle_points = copy_points(
+    obstacle_pointcloud,
+    cuda_map.obstaclePointsHost(obstacle_pointcloud.width * obstacle_pointcloud.height));
+
+  const auto to_cuda_transform = [](const Pose & pose) {
+    const Eigen::Matrix4f matrix =
+      tf2::transformToEigen(tier4_autoware_utils::pose2transform(pose)).matrix().cast<float>();
+    costmap_2d::CudaTransform transform;
+    for (int row = 0; row < 4; ++row) {
+      for (int col = 0; col < 4; ++col) {
+        transform.matrix[row * 4 + col] = matrix(row, col);
+      }
+    }
+    return transform;
+  };
+  cuda_map.updateWithPointCloud(
+    num_raw_points, num_obstacle_points, to_cuda_transform(robot_pose),
+    to_cuda_transform(utils::getInversePose(scan_origin)), scan_origin.position.x,
+    scan_origin.position.y, gridmap_origin.position.x - cuda_map.getSizeInMetersX() / 2,
+    gridmap_origin.position.y - cuda_map.getSizeInMetersY() / 2, !enable_single_frame_mode_);
+
+  auto msg_ptr = std::make_unique<OccupancyGrid>();
+  msg_ptr->header.frame_id = map_frame_;
+  msg_ptr->header.stamp = stamp;
+  msg_ptr->info.resolution = cuda_map.getResolution();
+  msg_ptr->info.width = cuda_map.getSizeInCellsX();
+  msg_ptr->info.height = cuda_map.getSizeInCellsY();
+  msg_ptr->info.origin.position.x = cuda_map.getOriginX();
+  msg_ptr->info.origin.position.y = cuda_map.getOriginY();
+  msg_ptr->info.origin.position.z = robot_pose.position.z;
+  msg_ptr->info.origin.orientation.w = 1.0;
+
+  // the costs are translated on the device already
+  const std::int8_t * data = cuda_map.occupancyGridHost();
+  msg_ptr->data.assign(data, data + msg_ptr->info.width * msg_ptr->info.height);
+  return msg_ptr;
+}
+#endif
+
 }  // namespace occupancy_grid_map
 
 #include <rclcpp_components/register_node_macro.hpp>
@@ -15,6 +15,7 @@
 #ifndef RADAR_FUSION_TO_DETECTED_OBJECT_HPP_
 #define RADAR_FUSION_TO_DETECTED_OBJECT_HPP_
 
+#include "perception_utils/centroid_grid.hpp"
 #include "rclcpp/logger.hpp"
 #include "tier4_autoware_utils/tier4_autoware_utils.hpp"
 
@@ -93,15 +94,24 @@ public:
 private:
   rclcpp::Logger logger_;
   Param param_{};
-  std::shared_ptr<std::vector<RadarInput>> filterRadarWithinObject(
-    const DetectedObject & object, const std::shared_ptr<std::vector<RadarInput>> & radars);
+  // Radar returns bucketed in a 2d grid every frame
+  perception_utils::CentroidGrid radar_grid_{};
+  std::vector<double> radar_xs_{};
+  std::vector<double> radar_ys_{};
+  std::vector<size_t> median_indices_{};
+
+  void buildRadarGrid(const std::vector<RadarInput> & radars);
+  void filterRadarWithinObject(
+    const DetectedObject & object, const std::vector<RadarInput> & radars,
+    std::vector<size_t> & radar_indices);
   // TODO(Satoshi Tanaka): Implement
   // std::vector<DetectedObject> splitObject(
-  //   const DetectedObject & object, const std::shared_ptr<std::vector<RadarInput>> & radars);
+  //   const DetectedObject & object, const std::vector<RadarInput> & radars,
+  //   const std::vector<size_t> & radar_indices);
   TwistWithCovariance estimateTwist(
-    const DetectedObject & object, std::shared_ptr<std::vector<RadarInput>> & radars);
-  bool isQualified(
-    const DetectedObject & object, std::shared_ptr<std::vector<RadarInput>> & radars);
+    const DetectedObject & object, const std::vector<RadarInput> & radars,
+    const std::vector<size_t> & radar_indices);
+  bool isQualified(const DetectedObject & object, const std::vector<size_t> & radar_indices);
   TwistWithCovariance convertDopplerToTwist(
     const DetectedObject & object, const TwistWithCovariance & twist_with_covariance);
   bool isYawCorrect(
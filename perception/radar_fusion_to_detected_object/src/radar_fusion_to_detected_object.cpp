@@ -18,12 +18,20 @@
 #include <boost/geometry.hpp>
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <numeric>
 #include <string>
 #include <vector>
 
+namespace
+{
+// about the size of a car, so that an object box with margin covers a few cells
+constexpr double kRadarGridCellSize = 4.0;
+}  // namespace
+
 namespace radar_fusion_to_detected_object
 {
 using autoware_auto_perception_msgs::msg::DetectedObject;
@@ -78,32 +86,37 @@ RadarFusionToDetectedObject::Output RadarFusionToDetectedObject::update(
     return output;
   }
 
+  static const std::vector<RadarInput> empty_radars{};
+  const auto & radars = input.radars ? *input.radars : empty_radars;
+  buildRadarGrid(radars);
+
+  std::vector<size_t> radars_within_object{};
+  std::vector<size_t> radars_within_split_object{};
   for (auto & object : input.objects->objects) {
     // Link between 3d bounding box and radar data
-    std::shared_ptr<std::vector<RadarInput>> radars_within_object =
-      filterRadarWithinObject(object, input.radars);
+    filterRadarWithinObject(object, radars, radars_within_object);
 
     // TODO(Satoshi Tanaka): Implement
     // Split the object going in a different direction
-    // std::vector<DetectedObject> split_objects = splitObject(object, radars_within_object);
+    // std::vector<DetectedObject> split_objects =
+    //   splitObject(object, radars, radars_within_object);
     std::vector<DetectedObject> split_objects;
     split_objects.emplace_back(object);
 
     for (auto & split_object : split_objects) {
       // set radars within objects
-      std::shared_ptr<std::vector<RadarInput>> radars_within_split_object;
       if (split_objects.size() == 1) {
         // If object is not split, radar data within object is same
-        radars_within_split_object = radars_within_object;
+        radars_within_split_object.swap(radars_within_object);
       } else {
         // If object is split, then filter radar again
-        radars_within_split_object = filterRadarWithinObject(split_object, radars_within_object);
+        filterRadarWithinObject(split_object, radars, radars_within_split_object);
       }
 
       // Estimate twist of object
-      if (!radars_within_split_object || !(*radars_within_split_object).empty()) {
+      if (!radars_within_split_object.empty()) {
         TwistWithCovariance twist_with_covariance =
-          estimateTwist(split_object, radars_within_split_object);
+          estimateTwist(split_object, radars, radars_within_split_object);
 
         if (isYawCorrect(split_object, twist_with_covariance, param_.threshold_yaw_diff)) {
           split_object.kinematics.twist_with_covariance = twist_with_covariance;
@@ -162,28 +175,49 @@ bool RadarFusionToDetectedObject::isYawCorrect(
   }
 }
 
-// Choose radar pointcloud/objects within 3D bounding box from lidar-base detection with margin
-// space from bird's-eye view.
-std::shared_ptr<std::vector<RadarFusionToDetectedObject::RadarInput>>
-RadarFusionToDetectedObject::filterRadarWithinObject(
-  const DetectedObject & object,
-  const std::shared_ptr<std::vector<RadarFusionToDetectedObject::RadarInput>> & radars)
+// Bucket the radar pointcloud/objects in a 2d grid, so that each object only checks the returns of
+// the cells under its box. The returns with a non-finite position are left out of the grid.
+void RadarFusionToDetectedObject::buildRadarGrid(const std::vector<RadarInput> & radars)
 {
-  std::vector<RadarInput> outputs{};
+  radar_xs_.clear();
+  radar_ys_.clear();
+  for (const auto & radar : radars) {
+    radar_xs_.push_back(radar.pose_with_covariance.pose.position.x);
+    radar_ys_.push_back(radar.pose_with_covariance.pose.position.y);
+  }
+  radar_grid_.build(radar_xs_, radar_ys_, kRadarGridCellSize);
+}
 
+// Choose radar pointcloud/objects within 3D bounding box from lidar-base detection with margin
+// space from bird's-eye view. The indices are in the same order as the radars.
+void RadarFusionToDetectedObject::filterRadarWithinObject(
+  const DetectedObject & object, const std::vector<RadarInput> & radars,
+  std::vector<size_t> & radar_indices)
+{
   tier4_autoware_utils::Point2d object_size{object.shape.dimensions.x, object.shape.dimensions.y};
   LinearRing2d object_box = createObject2dWithMargin(object_size, param_.bounding_box_margin);
   object_box = tier4_autoware_utils::transformVector(
     object_box, tier4_autoware_utils::pose2transform(object.kinematics.pose_with_covariance.pose));
 
-  for (const auto & radar : (*radars)) {
-    Point2d radar_point{
-      radar.pose_with_covariance.pose.position.x, radar.pose_with_covariance.pose.position.y};
-    if (boost::geometry::within(radar_point, object_box)) {
-      outputs.emplace_back(radar);
-    }
+  // returns in the cells under the bounding box of the object box
+  double box_min_x = std::numeric_limits<double>::max();
+  double box_min_y = std::numeric_limits<double>::max();
+  double box_max_x = std::numeric_limits<double>::lowest();
+  double box_max_y = std::numeric_limits<double>::lowest();
+  for (const auto & point : object_box) {
+    box_min_x = std::min(box_min_x, point.x());
+    box_min_y = std::min(box_min_y, point.y());
+    box_max_x = std::max(box_max_x, point.x());
+    box_max_y = std::max(box_max_y, point.y());
   }
-  return std::make_shared<std::vector<RadarFusionToDetectedObject::RadarInput>>(outputs);
+  radar_grid_.queryBox(box_min_x, box_min_y, box_max_x, box_max_y, radar_indices);
+
+  const auto is_outside = [&](const size_t index) {
+    const auto & position = radars[index].pose_with_covariance.pose.position;
+    return !boost::geometry::within(Point2d{position.x, position.y}, object_box);
+  };
+  radar_indices.erase(
+    std::remove_if(radar_indices.begin(), radar_indices.end(), is_outside), radar_indices.end());
 }
 
 // TODO(Satoshi Tanaka): Implementation
@@ -196,81 +230,83 @@ RadarFusionToDetectedObject::filterRadarWithinObject(
 
 // Estimate twist from chosen radar pointcloud/objects using twist and target value
 // (Target value is amplitude if using radar pointcloud. Target value is probability if using radar
-// objects).
+// objects). All the estimates but the median are gathered in a single pass.
 TwistWithCovariance RadarFusionToDetectedObject::estimateTwist(
-  const DetectedObject & object, std::shared_ptr<std::vector<RadarInput>> & radars)
+  const DetectedObject & object, const std::vector<RadarInput> & radars,
+  const std::vector<size_t> & radar_indices)
 {
-  if (!radars || (*radars).empty()) {
+  if (radar_indices.empty()) {
     TwistWithCovariance output{};
     return output;
   }
 
+  const auto & object_position = object.kinematics.pose_with_covariance.pose.position;
+  double min_squared_distance = std::numeric_limits<double>::max();
+  size_t min_distance_index = radar_indices.front();
+  size_t top_target_value_index = radar_indices.front();
+  Eigen::Vector2d sum_twist(0.0, 0.0);
+  Eigen::Vector2d sum_weighted_twist(0.0, 0.0);
+  double sum_target_value = 0.0;
+  for (const size_t index : radar_indices) {
+    const auto & radar = radars[index];
+    const double squared_distance = tier4_autoware_utils::calcSquaredDistance2d(
+      radar.pose_with_covariance.pose.position, object_position);
+    if (squared_distance < min_squared_distance) {
+      min_squared_distance = squared_distance;
+      min_distance_index = index;
+    }
+    if (radars[top_target_value_index].target_value < radar.target_value) {
+      top_target_value_index = index;
+    }
+    const Eigen::Vector2d twist = toVector2d(radar.twist_with_covariance);
+    sum_twist += twist;
+    sum_weighted_twist += twist * radar.target_value;
+    sum_target_value += radar.target_value;
+  }
+
   // calculate twist for radar data with min distance
   Eigen::Vector2d vec_min_distance(0.0, 0.0);
   if (param_.velocity_weight_min_distance > 0.0) {
-    auto comp_func = [&](const RadarInput & a, const RadarInput & b) {
-      return tier4_autoware_utils::calcSquaredDistance2d(
-               a.pose_with_covariance.pose.position,
-               object.kinematics.pose_with_covariance.pose.position) <
-             tier4_autoware_utils::calcSquaredDistance2d(
-               b.pose_with_covariance.pose.position,
-               object.kinematics.pose_with_covariance.pose.position);
-    };
-    auto iter = std::min_element(std::begin(*radars), std::end(*radars), comp_func);
-    TwistWithCovariance twist_min_distance = iter->twist_with_covariance;
-    vec_min_distance = toVector2d(twist_min_distance);
+    vec_min_distance = toVector2d(radars[min_distance_index].twist_with_covariance);
   }
 
   // calculate twist for radar data with median twist
   Eigen::Vector2d vec_median(0.0, 0.0);
   if (param_.velocity_weight_median > 0.0) {
-    auto ascending_func = [&](const RadarInput & a, const RadarInput & b) {
-      return getTwistNorm(a.twist_with_covariance.twist) <
-             getTwistNorm(b.twist_with_covariance.twist);
+    auto ascending_func = [&](const size_t a, const size_t b) {
+      return getTwistNorm(radars[a].twist_with_covariance.twist) <
+             getTwistNorm(radars[b].twist_with_covariance.twist);
     };
-    std::sort((*radars).begin(), (*radars).end(), ascending_func);
-
-    if ((*radars).size() % 2 == 1) {
-      int median_index = ((*radars).size() - 1) / 2;
-      vec_median = toVector2d((*radars).at(median_index).twist_with_covariance);
-    } else {
-      int median_index = (*radars).size() / 2;
-      Eigen::Vector2d v1 = toVector2d((*radars).at(median_index - 1).twist_with_covariance);
-      Eigen::Vector2d v2 = toVector2d((*radars).at(median_index).twist_with_covariance);
-      vec_median = (v1 + v2) / 2.0;
+    median_indices_.assign(radar_indices.begin(), radar_indices.end());
+    const auto median_iter = median_indices_.begin() + median_indices_.size() / 2;
+    std::nth_element(median_indices_.begin(), median_iter, median_indices_.end(), ascending_func);
+
+    vec_median = toVector2d(radars[*median_iter].twist_with_covariance);
+    if (median_indices_.size() % 2 == 0) {
+      const auto lower_iter =
+        std::max_element(median_indices_.begin(), median_iter, ascending_func);
+      vec_median = (toVector2d(radars[*lower_iter].twist_with_covariance) + vec_median) / 2.0;
     }
   }
 
   // calculate twist for radar data with average twist
   Eigen::Vector2d vec_average(0.0, 0.0);
   if (param_.velocity_weight_average > 0.0) {
-    for (const auto & radar : (*radars)) {
-      vec_average += toVector2d(radar.twist_with_covariance);
-    }
-    vec_average /= (*radars).size();
+    vec_average = sum_twist / radar_indices.size();
   }
 
   // calculate twist for radar data with top target value
   Eigen::Vector2d vec_top_target_value(0.0, 0.0);
-  auto comp_func = [](const RadarInput & a, const RadarInput & b) {
-    return a.target_value < b.target_value;
-  };
-  auto iter = std::max_element(std::begin((*radars)), std::end((*radars)), comp_func);
   if (param_.velocity_weight_target_value_top > 0.0) {
-    vec_top_target_value = toVector2d(iter->twist_with_covariance);
+    vec_top_target_value = toVector2d(radars[top_target_value_index].twist_with_covariance);
   }
   // Get covariance values
-  auto twist_covariance = iter->twist_with_covariance.covariance;
+  auto twist_covariance = radars[top_target_value_index].twist_with_covariance.covariance;
 
   // calculate twist for radar data with target_value * average
   Eigen::Vector2d vec_target_value_average(0.0, 0.0);
-  double sum_target_value = 0.0;
   if (param_.velocity_weight_target_value_average > 0.0) {
-    for (const auto & radar : (*radars)) {
-      vec_target_value_average += (toVector2d(radar.twist_with_covariance) * radar.target_value);
-      sum_target_value += radar.target_value;
-    }
-    vec_target_value_average /= sum_target_value;
+    vec_target_value_average = sum_weighted_twist / sum_target_value;
   }
 
   Eigen::Vector2d sum_vec = vec_min_distance * param_.velocity_weight_min_distance +
@@ -291,12 +327,12 @@ TwistWithCovariance RadarFusionToDetectedObject::estimateTwist(
 
 // Judge whether low confidence objects that do not have some radar points/objects or not.
 bool RadarFusionToDetectedObject::isQualified(
-  const DetectedObject & object, std::shared_ptr<std::vector<RadarInput>> & radars)
+  const DetectedObject & object, const std::vector<size_t> & radar_indices)
 {
   if (object.classification[0].probability > param_.threshold_probability) {
     return true;
   } else {
-    if (!radars || !(*radars).empty()) {
+    if (!radar_indices.empty()) {
       return true;
     } else {
       return false;
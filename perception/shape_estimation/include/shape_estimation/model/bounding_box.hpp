@@ -27,11 +27,16 @@ private:
     const pcl::PointCloud<pcl::PointXYZ> & cluster, const float min_angle, const float max_angle,
     autoware_auto_perception_msgs::msg::Shape & shape_output,
     geometry_msgs::msg::Pose & pose_output);
+  void projectPoints(const float cos_theta, const float sin_theta);
   float calcClosenessCriterion(const std::vector<float> & C_1, const std::vector<float> & C_2);
-  float optimize(
-    const pcl::PointCloud<pcl::PointXYZ> & cluster, const float min_angle, const float max_angle);
-  float boostOptimize(
-    const pcl::PointCloud<pcl::PointXYZ> & cluster, const float min_angle, const float max_angle);
+  float optimize(const float min_angle, const float max_angle);
+  float boostOptimize(const float min_angle, const float max_angle);
+
+  // xy of the points of the cluster, and their projections on the axes of the last angle
+  std::vector<float> points_x_;
+  std::vector<float> points_y_;
+  std::vector<float> projections_1_;
+  std::vector<float> projections_2_;
 
 public:
   BoundingBoxShapeModel();
@@ -87,12 +87,21 @@ bool BoundingBoxShapeModel::fitLShape(
    * Authors : Xio Zhang, Wenda Xu, Chiyu Dong and John M. Dolan
    */
 
+  // the points are kept as arrays of coordinates, and projected into buffers reused for all the
+  // angles, so that the loops over the points are vectorized
+  points_x_.resize(cluster.size());
+  points_y_.resize(cluster.size());
+  for (size_t i = 0; i < cluster.size(); ++i) {
+    points_x_[i] = cluster[i].x;
+    points_y_[i] = cluster[i].y;
+  }
+
   // Paper : Algo.2 Search-Based Rectangle Fitting
   double theta_star;
   if (use_boost_bbox_optimizer_) {
-    theta_star = boostOptimize(cluster, min_angle, max_angle);
+    theta_star = boostOptimize(min_angle, max_angle);
   } else {
-    theta_star = optimize(cluster, min_angle, max_angle);
+    theta_star = optimize(min_angle, max_angle);
   }
 
   const float sin_theta_star = std::sin(theta_star);
@@ -102,18 +111,19 @@ bool BoundingBoxShapeModel::fitLShape(
   Eigen::Vector2f e_2_star;
   e_1_star << cos_theta_star, sin_theta_star;
   e_2_star << -sin_theta_star, cos_theta_star;
-  std::vector<float> C_1_star;  // col.11, Algo.2
-  std::vector<float> C_2_star;  // col.11, Algo.2
-  for (const auto & point : cluster) {
-    C_1_star.push_back(point.x * e_1_star.x() + point.y * e_1_star.y());
-    C_2_star.push_back(point.x * e_2_star.x() + point.y * e_2_star.y());
-  }
+  projectPoints(cos_theta_star, sin_theta_star);  // col.11, Algo.2
+  const auto & C_1_star = projections_1_;
+  const auto & C_2_star = projections_2_;
 
   // col.12, Algo.2
-  const float min_C_1_star = *std::min_element(C_1_star.begin(), C_1_star.end());
-  const float max_C_1_star = *std::max_element(C_1_star.begin(), C_1_star.end());
-  const float min_C_2_star = *std::min_element(C_2_star.begin(), C_2_star.end());
-  const float max_C_2_star = *std::max_element(C_2_star.begin(), C_2_star.end());
+  const auto [min_C_1_star_it, max_C_1_star_it] =
+    std::minmax_element(C_1_star.begin(), C_1_star.end());
+  const auto [min_C_2_star_it, max_C_2_star_it] =
+    std::minmax_element(C_2_star.begin(), C_2_star.end());
+  const float min_C_1_star = *min_C_1_star_it;
+  const float max_C_1_star = *max_C_1_star_it;
+  const float min_C_2_star = *min_C_2_star_it;
+  const float max_C_2_star = *max_C_2_star_it;
 
   const float a_1 = cos_theta_star;
   const float b_1 = sin_theta_star;
@@ -162,86 +172,73 @@ bool BoundingBoxShapeModel::fitLShape(
   return true;
 }
 
+void BoundingBoxShapeModel::projectPoints(const float cos_theta, const float sin_theta)
+{
+  const size_t num_points = points_x_.size();
+  projections_1_.resize(num_points);
+  projections_2_.resize(num_points);
+  const float * x = points_x_.data();
+  const float * y = points_y_.data();
+  float * c_1 = projections_1_.data();
+  float * c_2 = projections_2_.data();
+  for (size_t i = 0; i < num_points; ++i) {
+    c_1[i] = x[i] * cos_theta + y[i] * sin_theta;   // col.5, Algo.2
+    c_2[i] = x[i] * -sin_theta + y[i] * cos_theta;  // col.6, Algo.2
+  }
+}
+
 float BoundingBoxShapeModel::calcClosenessCriterion(
   const std::vector<float> & C_1, const std::vector<float> & C_2)
 {
   // Paper : Algo.4 Closeness Criterion
-  const float min_c_1 = *std::min_element(C_1.begin(), C_1.end());  // col.2, Algo.4
-  const float max_c_1 = *std::max_element(C_1.begin(), C_1.end());  // col.2, Algo.4
-  const float min_c_2 = *std::min_element(C_2.begin(), C_2.end());  // col.3, Algo.4
-  const float max_c_2 = *std::max_element(C_2.begin(), C_2.end());  // col.3, Algo.4
-
-  std::vector<float> D_1;  // col.4, Algo.4
-  for (const auto & c_1_element : C_1) {
-    const float v = std::min(max_c_1 - c_1_element, c_1_element - min_c_1);
-    D_1.push_back(v * v);
-  }
+  const auto [min_c_1_it, max_c_1_it] = std::minmax_element(C_1.begin(), C_1.end());
+  const auto [min_c_2_it, max_c_2_it] = std::minmax_element(C_2.begin(), C_2.end());
+  const float min_c_1 = *min_c_1_it;  // col.2, Algo.4
+  const float max_c_1 = *max_c_1_it;  // col.2, Algo.4
+  const float min_c_2 = *min_c_2_it;  // col.3, Algo.4
+  const float max_c_2 = *max_c_2_it;  // col.3, Algo.4
 
-  std::vector<float> D_2;  // col.5, Algo.4
-  for (const auto & c_2_element : C_2) {
-    const float v = std::min(max_c_2 - c_2_element, c_2_element - min_c_2);
-    D_2.push_back(v * v);
-  }
   constexpr float d_min = 0.1 * 0.1;
   constexpr float d_max = 0.4 * 0.4;
   float beta = 0;  // col.6, Algo.4
-  for (size_t i = 0; i < D_1.size(); ++i) {
-    if (d_max < std::min(D_1.at(i), D_2.at(i))) {
+  for (size_t i = 0; i < C_1.size(); ++i) {
+    const float v_1 = std::min(max_c_1 - C_1[i], C_1[i] - min_c_1);
+    const float v_2 = std::min(max_c_2 - C_2[i], C_2[i] - min_c_2);
+    const float d_1 = v_1 * v_1;  // col.4, Algo.4
+    const float d_2 = v_2 * v_2;  // col.5, Algo.4
+    if (d_max < std::min(d_1, d_2)) {
       continue;
     }
-    const float d = std::max(std::min(D_1.at(i), D_2.at(i)), d_min);
+    const float d = std::max(std::min(d_1, d_2), d_min);
     beta += 1.0 / d;
   }
   return beta;
 }
 
-float BoundingBoxShapeModel::optimize(
-  const pcl::PointCloud<pcl::PointXYZ> & cluster, const float min_angle, const float max_angle)
+float BoundingBoxShapeModel::optimize(const float min_angle, const float max_angle)
 {
-  std::vector<std::pair<float /*theta*/, float /*q*/>> Q;
-  constexpr float angle_resolution = M_PI / 180.0;
-  for (float theta = min_angle; theta <= max_angle + epsilon; theta += angle_resolution) {
-    Eigen::Vector2f e_1;
-    e_1 << std::cos(theta), std::sin(theta);  // col.3, Algo.2
-    Eigen::Vector2f e_2;
-    e_2 << -std::sin(theta), std::cos(theta);  // col.4, Algo.2
-    std::vector<float> C_1;                    // col.5, Algo.2
-    std::vector<float> C_2;                    // col.6, Algo.2
-    for (const auto & point : cluster) {
-      C_1.push_back(point.x * e_1.x() + point.y * e_1.y());
-      C_2.push_back(point.x * e_2.x() + point.y * e_2.y());
-    }
-    float q = calcClosenessCriterion(C_1, C_2);  // col.7, Algo.2
-    Q.push_back(std::make_pair(theta, q));       // col.8, Algo.2
-  }
-
   float theta_star{0.0};  // col.10, Algo.2
   float max_q = 0.0;
-  for (size_t i = 0; i < Q.size(); ++i) {
-    if (max_q < Q.at(i).second || i == 0) {
-      max_q = Q.at(i).second;
-      theta_star = Q.at(i).first;
+  bool is_first = true;
+  constexpr float angle_resolution = M_PI / 180.0;
+  for (float theta = min_angle; theta <= max_angle + epsilon; theta += angle_resolution) {
+    projectPoints(std::cos(theta), std::sin(theta));                         // col.3-6, Algo.2
+    const float q = calcClosenessCriterion(projections_1_, projections_2_);  // col.7, Algo.2
+    if (max_q < q || is_first) {
+      max_q = q;
+      theta_star = theta;
+      is_first = false;
     }
   }
 
   return theta_star;
 }
 
-float BoundingBoxShapeModel::boostOptimize(
-  const pcl::PointCloud<pcl::PointXYZ> & cluster, const float min_angle, const float max_angle)
+float BoundingBoxShapeModel::boostOptimize(const float min_angle, const float max_angle)
 {
   auto closeness_func = [&](float theta) {
-    Eigen::Vector2f e_1;
-    e_1 << std::cos(theta), std::sin(theta);  // col.3, Algo.2
-    Eigen::Vector2f e_2;
-    e_2 << -std::sin(theta), std::cos(theta);  // col.4, Algo.2
-    std::vector<float> C_1;                    // col.5, Algo.2
-    std::vector<float> C_2;                    // col.6, Algo.2
-    for (const auto & point : cluster) {
-      C_1.push_back(point.x * e_1.x() + point.y * e_1.y());
-      C_2.push_back(point.x * e_2.x() + point.y * e_2.y());
-    }
-    float q = calcClosenessCriterion(C_1, C_2);
+    projectPoints(std::cos(theta), std::sin(theta));  // col.3-6, Algo.2
+    float q = calcClosenessCriterion(projections_1_, projections_2_);
     return -q;
   };
 
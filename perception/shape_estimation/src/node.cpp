@@ -29,8 +29,10 @@
 #include <tf2_geometry_msgs/tf2_geometry_msgs.hpp>
 #endif
 
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <vector>
 
 using Label = autoware_auto_perception_msgs::msg::ObjectClassification;
 
@@ -48,6 +50,7 @@ ShapeEstimationNode::ShapeEstimationNode(const rclcpp::NodeOptions & node_option
   use_vehicle_reference_shape_size_ = declare_parameter("use_vehicle_reference_shape_size", true);
   bool use_boost_bbox_optimizer = declare_parameter("use_boost_bbox_optimizer", false);
   RCLCPP_INFO(this->get_logger(), "using boost shape estimation : %d", use_boost_bbox_optimizer);
+  num_threads_ = std::max(declare_parameter("num_threads", 1), 1);
   estimator_ =
     std::make_unique<ShapeEstimator>(use_corrector, use_filter, use_boost_bbox_optimizer);
 }
@@ -63,11 +66,16 @@ void ShapeEstimationNode::callback(const DetectedObjectsWithFeature::ConstShared
   DetectedObjectsWithFeature output_msg;
   output_msg.header = input_msg->header;
 
-  // Estimate shape for each object and pack msg
-  for (const auto & feature_object : input_msg->feature_objects) {
-    const auto & object = feature_object.object;
+  // Estimate shape for each object, independently of the others
+  const auto & feature_objects = input_msg->feature_objects;
+  std::vector<uint8_t> is_estimated(feature_objects.size(), false);
+  std::vector<autoware_auto_perception_msgs::msg::Shape> shapes(feature_objects.size());
+  std::vector<geometry_msgs::msg::Pose> poses(feature_objects.size());
+#pragma omp parallel for num_threads(num_threads_)
+  for (size_t i = 0; i < feature_objects.size(); ++i) {
+    const auto & object = feature_objects[i].object;
     const auto & label = object.classification.front().label;
-    const auto & feature = feature_object.feature;
+    const auto & feature = feature_objects[i].feature;
     const bool is_vehicle = Label::CAR == label || Label::TRUCK == label || Label::BUS == label ||
                             Label::TRAILER == label;
 
@@ -81,8 +89,6 @@ void ShapeEstimationNode::callback(const DetectedObjectsWithFeature::ConstShared
     }
 
     // estimate shape and pose
-    autoware_auto_perception_msgs::msg::Shape shape;
-    geometry_msgs::msg::Pose pose;
     boost::optional<ReferenceYawInfo> ref_yaw_info = boost::none;
     boost::optional<ReferenceShapeSizeInfo> ref_shape_size_info = boost::none;
     if (use_vehicle_reference_yaw_ && is_vehicle) {
@@ -93,17 +99,19 @@ void ShapeEstimationNode::callback(const DetectedObjectsWithFeature::ConstShared
     if (use_vehicle_reference_shape_size_ && is_vehicle) {
       ref_shape_size_info = ReferenceShapeSizeInfo{object.shape, ReferenceShapeSizeInfo::Mode::Min};
     }
-    const bool estimated_success = estimator_->estimateShapeAndPose(
-      label, *cluster, ref_yaw_info, ref_shape_size_info, shape, pose);
-
     // If the shape estimation fails, ignore it.
-    if (!estimated_success) {
+    is_estimated[i] = estimator_->estimateShapeAndPose(
+      label, *cluster, ref_yaw_info, ref_shape_size_info, shapes[i], poses[i]);
+  }
+
+  // Pack msg in the order of the input
+  for (size_t i = 0; i < feature_objects.size(); ++i) {
+    if (!is_estimated[i]) {
       continue;
     }
-
-    output_msg.feature_objects.push_back(feature_object);
-    output_msg.feature_objects.back().object.shape = shape;
-    output_msg.feature_objects.back().object.kinematics.pose_with_covariance.pose = pose;
+    output_msg.feature_objects.push_back(feature_objects[i]);
+    output_msg.feature_objects.back().object.shape = shapes[i];
+    output_msg.feature_objects.back().object.kinematics.pose_with_covariance.pose = poses[i];
   }
 
   // Publish
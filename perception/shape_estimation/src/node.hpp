@@ -38,6 +38,7 @@ private:
   std::unique_ptr<ShapeEstimator> estimator_;
   bool use_vehicle_reference_yaw_;
   bool use_vehicle_reference_shape_size_;
+  int num_threads_;
 
 public:
   explicit ShapeEstimationNode(const rclcpp::NodeOptions & node_options);
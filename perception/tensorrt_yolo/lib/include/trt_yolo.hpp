@@ -129,9 +129,8 @@ public:
   int getInputSize() const;
 
 private:
-  unique_ptr<nvinfer1::IRuntime> runtime_ = nullptr;
   unique_ptr<nvinfer1::IHostMemory> plan_ = nullptr;
-  unique_ptr<nvinfer1::ICudaEngine> engine_ = nullptr;
+  std::shared_ptr<nvinfer1::ICudaEngine> engine_ = nullptr;
   unique_ptr<nvinfer1::IExecutionContext> context_ = nullptr;
   cudaStream_t stream_ = nullptr;
   cuda::unique_ptr<float[]> input_d_ = nullptr;
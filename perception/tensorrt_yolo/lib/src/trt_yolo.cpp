@@ -39,6 +39,7 @@
 #include <mish_plugin.hpp>
 #include <nms_plugin.hpp>
 #include <trt_yolo.hpp>
+#include <tensorrt_common/engine_cache.hpp>
 #include <yolo_layer_plugin.hpp>
 
 #include <NvOnnxParser.h>
@@ -56,18 +57,8 @@ namespace yolo
 {
 void Net::load(const std::string & path)
 {
-  std::ifstream file(path, std::ios::in | std::ios::binary);
-  file.seekg(0, file.end);
-  size_t size = file.tellg();
-  file.seekg(0, file.beg);
-
-  char * buffer = new char[size];
-  file.read(buffer, size);
-  file.close();
-  if (runtime_) {
-    engine_ = unique_ptr<nvinfer1::ICudaEngine>(runtime_->deserializeCudaEngine(buffer, size));
-  }
-  delete[] buffer;
+  // shared with the other nodes of this process loading the same engine file
+  engine_ = tensorrt_common::EngineCache::getInstance().load(path);
 }
 
 bool Net::prepare()
@@ -113,10 +104,8 @@ std::vector<float> Net::preprocess(
   return result;
 }
 
-Net::Net(const std::string & path, bool verbose)
+Net::Net(const std::string & path, [[maybe_unused]] bool verbose)
 {
-  Logger logger(verbose);
-  runtime_ = unique_ptr<nvinfer1::IRuntime>(nvinfer1::createInferRuntime(logger));
   load(path);
   if (!prepare()) {
     std::cout << "Fail to prepare engine" << std::endl;
@@ -138,11 +127,6 @@ Net::Net(
   const std::string & calibration_table, bool verbose, size_t workspace_size)
 {
   Logger logger(verbose);
-  runtime_ = unique_ptr<nvinfer1::IRuntime>(nvinfer1::createInferRuntime(logger));
-  if (!runtime_) {
-    std::cout << "Fail to create runtime" << std::endl;
-    return;
-  }
   bool fp16 = precision.compare("FP16") == 0;
   bool int8 = precision.compare("INT8") == 0;
 
@@ -261,8 +245,7 @@ Net::Net(
     std::cout << "Fail to create serialized network" << std::endl;
     return;
   }
-  engine_ = unique_ptr<nvinfer1::ICudaEngine>(
-    runtime_->deserializeCudaEngine(plan_->data(), plan_->size()));
+  engine_ = tensorrt_common::EngineCache::getInstance().deserialize(plan_->data(), plan_->size());
   if (!prepare()) {
     std::cout << "Fail to create engine" << std::endl;
     return;
@@ -274,6 +257,7 @@ void Net::save(const std::string & path) const
   std::cout << "Writing to " << path << "..." << std::endl;
   std::ofstream file(path, std::ios::out | std::ios::binary);
   file.write(reinterpret_cast<const char *>(plan_->data()), plan_->size());
+  tensorrt_common::EngineCache::getInstance().add(path, engine_);
 }
 
 void Net::infer(std::vector<void *> & buffers, const int batch_size)
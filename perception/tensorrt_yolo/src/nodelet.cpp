@@ -14,6 +14,8 @@
 
 #include "tensorrt_yolo/nodelet.hpp"
 
+#include <tensorrt_common/engine_cache.hpp>
+
 #include <autoware_auto_perception_msgs/msg/object_classification.hpp>
 
 #include <glob.h>
@@ -74,6 +76,8 @@ TensorrtYoloNodelet::TensorrtYoloNodelet(const rclcpp::NodeOptions & options)
   if (!readLabelFile(label_file, &labels_)) {
     RCLCPP_ERROR(this->get_logger(), "Could not find label file");
   }
+  // another node of this process may be building the same engine
+  auto build_lock = tensorrt_common::EngineCache::getInstance().lockBuild(engine_file);
   std::ifstream fs(engine_file);
   const auto calibration_images = getFilePath(calib_image_directory);
   if (fs.is_open()) {
@@ -95,6 +99,7 @@ TensorrtYoloNodelet::TensorrtYoloNodelet(const rclcpp::NodeOptions & options)
       new yolo::Net(onnx_file, mode, 1, yolo_config_, calibration_images, calib_cache_file));
     net_ptr_->save(engine_file);
   }
+  build_lock.unlock();
   RCLCPP_INFO(this->get_logger(), "Inference engine prepared.");
 
   using std::chrono_literals::operator""ms;
@@ -0,0 +1,62 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORRT_YOLOX__LABEL_MAP_HPP_
+#define TENSORRT_YOLOX__LABEL_MAP_HPP_
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <map>
+#include <string>
+
+namespace tensorrt_yolox
+{
+using LabelMap = std::map<int, std::string>;
+
+// read the labels, one per line in the order of the class ids, in upper case
+inline bool readLabelFile(const std::string & label_path, LabelMap & label_map)
+{
+  std::ifstream label_file(label_path);
+  if (!label_file.is_open()) {
+    return false;
+  }
+  int label_index{};
+  std::string label;
+  while (getline(label_file, label)) {
+    std::transform(
+      label.begin(), label.end(), label.begin(), [](auto c) { return std::toupper(c); });
+    label_map.insert({label_index, label});
+    ++label_index;
+  }
+  return true;
+}
+
+// map the labels to the object classifications of autoware
+inline void replaceLabelMap(LabelMap & label_map)
+{
+  for (std::size_t i = 0; i < label_map.size(); ++i) {
+    auto & label = label_map[i];
+    if (label == "PERSON") {
+      label = "PEDESTRIAN";
+    } else if (
+      label != "CAR" && label != "PEDESTRIAN" && label != "BUS" && label != "TRUCK" &&
+      label != "BICYCLE" && label != "MOTORCYCLE") {
+      label = "UNKNOWN";
+    }
+  }
+}
+}  // namespace tensorrt_yolox
+
+#endif  // TENSORRT_YOLOX__LABEL_MAP_HPP_
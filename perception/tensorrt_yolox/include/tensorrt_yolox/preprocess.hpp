@@ -0,0 +1,33 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORRT_YOLOX__PREPROCESS_HPP_
+#define TENSORRT_YOLOX__PREPROCESS_HPP_
+
+#include <cuda_runtime_api.h>
+
+#include <cstdint>
+
+namespace tensorrt_yolox
+{
+// Letterbox a BGR8 image on the device into a planar float input of the network, as the CPU
+// preprocessing does: the image is resized by bicubic interpolation to scaled_width x
+// scaled_height, the rest of the input is padded with 114, and the channels are split.
+cudaError_t letterboxToChw_launch(
+  const std::uint8_t * src, const int src_width, const int src_height, const int src_step,
+  const int scaled_width, const int scaled_height, float * dst, const int dst_width,
+  const int dst_height, cudaStream_t stream);
+}  // namespace tensorrt_yolox
+
+#endif  // TENSORRT_YOLOX__PREPROCESS_HPP_
@@ -59,14 +59,20 @@ public:
     const float score_threshold = 0.3, const float nms_threshold = 0.7,
     const std::string & cache_dir = "",
     const tensorrt_common::BatchConfig & batch_config = {1, 1, 1},
-    const size_t max_workspace_size = (1 << 30));
+    const size_t max_workspace_size = (1 << 30), const bool use_gpu_preprocess = false,
+    const bool use_cuda_graph = false);
 
   bool doInference(const std::vector<cv::Mat> & images, ObjectArrays & objects);
 
 private:
   void preprocess(const std::vector<cv::Mat> & images);
-  bool feedforward(const std::vector<cv::Mat> & images, ObjectArrays & objects);
-  bool feedforwardAndDecode(const std::vector<cv::Mat> & images, ObjectArrays & objects);
+  // letterbox the images on the device, straight into input_d_
+  void preprocessGpu(const std::vector<cv::Mat> & images);
+  // upload the CPU preprocessed images, infer and download the outputs, asynchronously on stream
+  bool launchInference(const size_t batch_size, cudaStream_t stream);
+  // build the objects from the downloaded outputs
+  void readObjects(const std::vector<cv::Mat> & images, ObjectArrays & objects) const;
+  void readAndDecodeObjects(const std::vector<cv::Mat> & images, ObjectArrays & objects) const;
   void decodeOutputs(float * prob, ObjectArray & objects, float scale, cv::Size & img_size) const;
   void generateGridsAndStride(
     const int target_w, const int target_h, std::vector<int> & strides,
@@ -95,12 +101,26 @@ private:
 
   std::unique_ptr<tensorrt_common::TrtCommon> trt_common_;
 
-  std::vector<float> input_h_;
+  int max_batch_size_;
+  size_t input_size_;
+  bool use_gpu_preprocess_;
+  bool use_cuda_graph_;
+  // pinned, so that the uploads are asynchronous
+  CudaUniquePtrHost<float[]> input_h_;
   CudaUniquePtr<float[]> input_d_;
+  // raw images to letterbox on the device, grown on demand
+  size_t image_buf_size_{0};
+  CudaUniquePtrHost<uint8_t[]> image_buf_h_;
+  CudaUniquePtr<uint8_t[]> image_buf_d_;
   CudaUniquePtr<int32_t[]> out_num_detections_d_;
   CudaUniquePtr<float[]> out_boxes_d_;
   CudaUniquePtr<float[]> out_scores_d_;
   CudaUniquePtr<int32_t[]> out_classes_d_;
+  // pinned and allocated once, so that the downloads can be captured in a CUDA graph
+  CudaUniquePtrHost<int32_t[]> out_num_detections_h_;
+  CudaUniquePtrHost<float[]> out_boxes_h_;
+  CudaUniquePtrHost<float[]> out_scores_h_;
+  CudaUniquePtrHost<int32_t[]> out_classes_h_;
 
   bool needs_output_decode_;
   size_t out_elem_num_;
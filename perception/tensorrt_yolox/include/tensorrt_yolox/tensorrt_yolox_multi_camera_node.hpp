@@ -0,0 +1,74 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORRT_YOLOX__TENSORRT_YOLOX_MULTI_CAMERA_NODE_HPP_
+#define TENSORRT_YOLOX__TENSORRT_YOLOX_MULTI_CAMERA_NODE_HPP_
+
+#include <image_transport/image_transport.hpp>
+#include <opencv2/opencv.hpp>
+#include <rclcpp/rclcpp.hpp>
+#include <tensorrt_yolox/label_map.hpp>
+#include <tensorrt_yolox/tensorrt_yolox.hpp>
+
+#include <sensor_msgs/msg/image.hpp>
+#include <tier4_perception_msgs/msg/detected_objects_with_feature.hpp>
+
+#include <cv_bridge/cv_bridge.h>
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace tensorrt_yolox
+{
+// Runs YOLOX on the images of several cameras in a single batch.
+//
+// The latest image of every camera is kept until a batch is run, which happens as soon as every
+// camera has an image, or when the oldest kept image has waited batch_time_window, in which case
+// only the cameras with an image are in the batch.
+class TrtYoloXMultiCameraNode : public rclcpp::Node
+{
+public:
+  explicit TrtYoloXMultiCameraNode(const rclcpp::NodeOptions & node_options);
+
+private:
+  struct PendingImage
+  {
+    sensor_msgs::msg::Image::ConstSharedPtr msg;
+    rclcpp::Time arrival_time;
+  };
+
+  void onImage(const sensor_msgs::msg::Image::ConstSharedPtr msg, const std::size_t camera_id);
+  void onTimer();
+  void runBatch();
+
+  std::vector<image_transport::Publisher> image_pubs_;
+  std::vector<rclcpp::Publisher<tier4_perception_msgs::msg::DetectedObjectsWithFeature>::SharedPtr>
+    objects_pubs_;
+  std::vector<image_transport::Subscriber> image_subs_;
+  rclcpp::TimerBase::SharedPtr timer_;
+
+  std::vector<std::optional<PendingImage>> pending_images_;
+  rclcpp::Duration batch_time_window_{0, 0};
+  bool publish_image_{false};
+
+  LabelMap label_map_;
+  std::unique_ptr<tensorrt_yolox::TrtYoloX> trt_yolox_;
+};
+
+}  // namespace tensorrt_yolox
+
+#endif  // TENSORRT_YOLOX__TENSORRT_YOLOX_MULTI_CAMERA_NODE_HPP_
@@ -18,6 +18,7 @@
 #include <image_transport/image_transport.hpp>
 #include <opencv2/opencv.hpp>
 #include <rclcpp/rclcpp.hpp>
+#include <tensorrt_yolox/label_map.hpp>
 #include <tensorrt_yolox/tensorrt_yolox.hpp>
 
 #include <sensor_msgs/msg/image.hpp>
@@ -35,8 +36,6 @@
 
 namespace tensorrt_yolox
 {
-using LabelMap = std::map<int, std::string>;
-
 class TrtYoloXNode : public rclcpp::Node
 {
 public:
@@ -45,8 +44,6 @@ public:
 private:
   void onConnect();
   void onImage(const sensor_msgs::msg::Image::ConstSharedPtr msg);
-  bool readLabelFile(const std::string & label_path);
-  void replaceLabelMap();
 
   image_transport::Publisher image_pub_;
   rclcpp::Publisher<tier4_perception_msgs::msg::DetectedObjectsWithFeature>::SharedPtr objects_pub_;
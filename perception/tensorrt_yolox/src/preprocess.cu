@@ -0,0 +1,98 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorrt_yolox/preprocess.hpp"
+
+namespace
+{
+const std::size_t THREADS_PER_BLOCK_X = 32;
+const std::size_t THREADS_PER_BLOCK_Y = 8;
+constexpr float PADDING_VALUE = 114.0f;
+// the coefficient of the bicubic kernel used by cv::INTER_CUBIC
+constexpr float CUBIC_A = -0.75f;
+
+__device__ void cubicCoefficients(const float t, float coefficients[4])
+{
+  const float t1 = t + 1;
+  coefficients[0] = ((CUBIC_A * t1 - 5 * CUBIC_A) * t1 + 8 * CUBIC_A) * t1 - 4 * CUBIC_A;
+  coefficients[1] = ((CUBIC_A + 2) * t - (CUBIC_A + 3)) * t * t + 1;
+  coefficients[2] = ((CUBIC_A + 2) * (1 - t) - (CUBIC_A + 3)) * (1 - t) * (1 - t) + 1;
+  coefficients[3] = 1.0f - coefficients[0] - coefficients[1] - coefficients[2];
+}
+
+__global__ void letterboxToChw_kernel(
+  const std::uint8_t * src, const int src_width, const int src_height, const int src_step,
+  const int scaled_width, const int scaled_height, float * dst, const int dst_width,
+  const int dst_height)
+{
+  const int x = blockIdx.x * blockDim.x + threadIdx.x;
+  const int y = blockIdx.y * blockDim.y + threadIdx.y;
+  if (x >= dst_width || y >= dst_height) return;
+
+  const std::size_t plane_size = static_cast<std::size_t>(dst_width) * dst_height;
+  const std::size_t dst_idx = static_cast<std::size_t>(y) * dst_width + x;
+  if (x >= scaled_width || y >= scaled_height) {
+    for (int c = 0; c < 3; ++c) {
+      dst[c * plane_size + dst_idx] = PADDING_VALUE;
+    }
+    return;
+  }
+
+  // same sampling positions and border replication as cv::resize
+  const float fx = (x + 0.5f) * src_width / scaled_width - 0.5f;
+  const float fy = (y + 0.5f) * src_height / scaled_height - 0.5f;
+  const int sx = static_cast<int>(floorf(fx));
+  const int sy = static_cast<int>(floorf(fy));
+  float coefficients_x[4];
+  float coefficients_y[4];
+  cubicCoefficients(fx - sx, coefficients_x);
+  cubicCoefficients(fy - sy, coefficients_y);
+
+  float values[3] = {0.0f, 0.0f, 0.0f};
+  for (int j = 0; j < 4; ++j) {
+    const int row = min(max(sy - 1 + j, 0), src_height - 1);
+    const std::uint8_t * src_row = src + static_cast<std::size_t>(row) * src_step;
+    for (int i = 0; i < 4; ++i) {
+      const int col = min(max(sx - 1 + i, 0), src_width - 1);
+      const float weight = coefficients_x[i] * coefficients_y[j];
+      for (int c = 0; c < 3; ++c) {
+        values[c] += weight * src_row[col * 3 + c];
+      }
+    }
+  }
+
+  // the CPU path resizes into an 8-bit image, so round and saturate alike
+  for (int c = 0; c < 3; ++c) {
+    dst[c * plane_size + dst_idx] = fminf(fmaxf(rintf(values[c]), 0.0f), 255.0f);
+  }
+}
+}  // namespace
+
+namespace tensorrt_yolox
+{
+cudaError_t letterboxToChw_launch(
+  const std::uint8_t * src, const int src_width, const int src_height, const int src_step,
+  const int scaled_width, const int scaled_height, float * dst, const int dst_width,
+  const int dst_height, cudaStream_t stream)
+{
+  dim3 threads(THREADS_PER_BLOCK_X, THREADS_PER_BLOCK_Y);
+  dim3 blocks(
+    (dst_width + THREADS_PER_BLOCK_X - 1) / THREADS_PER_BLOCK_X,
+    (dst_height + THREADS_PER_BLOCK_Y - 1) / THREADS_PER_BLOCK_Y);
+  letterboxToChw_kernel<<<blocks, threads, 0, stream>>>(
+    src, src_width, src_height, src_step, scaled_width, scaled_height, dst, dst_width,
+    dst_height);
+  return cudaGetLastError();
+}
+}  // namespace tensorrt_yolox
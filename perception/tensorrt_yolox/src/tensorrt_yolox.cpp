@@ -17,7 +17,12 @@
 
 #include <tensorrt_yolox/tensorrt_yolox.hpp>
 
+#ifdef TENSORRT_YOLOX_WITH_CUDA_PREPROCESS
+#include <tensorrt_yolox/preprocess.hpp>
+#endif
+
 #include <algorithm>
+#include <cstring>
 #include <functional>
 #include <memory>
 #include <numeric>
@@ -31,8 +36,16 @@ TrtYoloX::TrtYoloX(
   const std::string & model_path, const std::string & precision, const int num_class,
   const float score_threshold, const float nms_threshold,
   [[maybe_unused]] const std::string & cache_dir, const tensorrt_common::BatchConfig & batch_config,
-  const size_t max_workspace_size)
+  const size_t max_workspace_size, const bool use_gpu_preprocess, const bool use_cuda_graph)
+: max_batch_size_(batch_config[2]),
+  use_gpu_preprocess_(use_gpu_preprocess),
+  use_cuda_graph_(use_cuda_graph)
 {
+#ifndef TENSORRT_YOLOX_WITH_CUDA_PREPROCESS
+  // built without CUDA preprocessing, the images are preprocessed on the CPU
+  use_gpu_preprocess_ = false;
+#endif
+
   trt_common_ = std::make_unique<tensorrt_common::TrtCommon>(
     model_path, precision, nullptr, batch_config, max_workspace_size);
   trt_common_->setup();
@@ -69,6 +82,9 @@ TrtYoloX::TrtYoloX(
   const auto input_dims = trt_common_->getBindingDimensions(0);
   const auto input_size =
     std::accumulate(input_dims.d + 1, input_dims.d + input_dims.nbDims, 1, std::multiplies<int>());
+  input_size_ = input_size;
+  input_h_ = cuda_utils::make_unique_host<float[]>(
+    batch_config[2] * input_size, cudaHostAllocPortable);
   if (needs_output_decode_) {
     const auto output_dims = trt_common_->getBindingDimensions(1);
     input_d_ = cuda_utils::make_unique<float[]>(batch_config[2] * input_size);
@@ -85,6 +101,14 @@ TrtYoloX::TrtYoloX(
     out_boxes_d_ = cuda_utils::make_unique<float[]>(batch_config[2] * max_detections_ * 4);
     out_scores_d_ = cuda_utils::make_unique<float[]>(batch_config[2] * max_detections_);
     out_classes_d_ = cuda_utils::make_unique<int32_t[]>(batch_config[2] * max_detections_);
+    out_num_detections_h_ =
+      cuda_utils::make_unique_host<int32_t[]>(batch_config[2], cudaHostAllocPortable);
+    out_boxes_h_ = cuda_utils::make_unique_host<float[]>(
+      batch_config[2] * max_detections_ * 4, cudaHostAllocPortable);
+    out_scores_h_ = cuda_utils::make_unique_host<float[]>(
+      batch_config[2] * max_detections_, cudaHostAllocPortable);
+    out_classes_h_ = cuda_utils::make_unique_host<int32_t[]>(
+      batch_config[2] * max_detections_, cudaHostAllocPortable);
   }
 }
 
@@ -112,10 +136,56 @@ void TrtYoloX::preprocess(const std::vector<cv::Mat> & images)
   const auto chw_images =
     cv::dnn::blobFromImages(dst_images, 1.0, cv::Size(), cv::Scalar(), false, false, CV_32F);
 
-  const auto data_length = chw_images.total();
-  input_h_.reserve(data_length);
-  const auto flat = chw_images.reshape(1, data_length);
-  input_h_ = chw_images.isContinuous() ? flat : flat.clone();
+  // blobFromImages outputs a continuous blob
+  std::memcpy(input_h_.get(), chw_images.ptr<float>(), chw_images.total() * sizeof(float));
+}
+
+void TrtYoloX::preprocessGpu([[maybe_unused]] const std::vector<cv::Mat> & images)
+{
+#ifdef TENSORRT_YOLOX_WITH_CUDA_PREPROCESS
+  const auto batch_size = images.size();
+  auto input_dims = trt_common_->getBindingDimensions(0);
+  input_dims.d[0] = batch_size;
+  trt_common_->setBindingDimensions(0, input_dims);
+  const int input_height = input_dims.d[2];
+  const int input_width = input_dims.d[3];
+
+  size_t total_image_size = 0;
+  for (const auto & image : images) {
+    total_image_size += image.total() * image.elemSize();
+  }
+  if (image_buf_size_ < total_image_size) {
+    image_buf_h_ = cuda_utils::make_unique_host<uint8_t[]>(total_image_size, cudaHostAllocPortable);
+    image_buf_d_ = cuda_utils::make_unique<uint8_t[]>(total_image_size);
+    image_buf_size_ = total_image_size;
+  }
+
+  // pack the images in the pinned buffer and upload them at once
+  size_t offset = 0;
+  for (const auto & image : images) {
+    const size_t row_size = image.cols * image.elemSize();
+    for (int row = 0; row < image.rows; ++row) {
+      std::memcpy(image_buf_h_.get() + offset + row * row_size, image.ptr(row), row_size);
+    }
+    offset += image.rows * row_size;
+  }
+  CHECK_CUDA_ERROR(cudaMemcpyAsync(
+    image_buf_d_.get(), image_buf_h_.get(), total_image_size, cudaMemcpyHostToDevice, *stream_));
+
+  scales_.clear();
+  offset = 0;
+  for (size_t i = 0; i < batch_size; ++i) {
+    const auto & image = images[i];
+    const float scale = std::min(
+      static_cast<float>(input_width) / image.cols, static_cast<float>(input_height) / image.rows);
+    scales_.emplace_back(scale);
+    CHECK_CUDA_ERROR(letterboxToChw_launch(
+      image_buf_d_.get() + offset, image.cols, image.rows, image.cols * image.elemSize(),
+      static_cast<int>(image.cols * scale), static_cast<int>(image.rows * scale),
+      input_d_.get() + i * input_size_, input_width, input_height, *stream_));
+    offset += image.total() * image.elemSize();
+  }
+#endif
 }
 
 bool TrtYoloX::doInference(const std::vector<cv::Mat> & images, ObjectArrays & objects)
@@ -124,47 +194,85 @@ bool TrtYoloX::doInference(const std::vector<cv::Mat> & images, ObjectArrays & o
     return false;
   }
 
-  preprocess(images);
+  if (images.empty() || static_cast<int>(images.size()) > max_batch_size_) {
+    return false;
+  }
 
-  CHECK_CUDA_ERROR(cudaMemcpy(
-    input_d_.get(), input_h_.data(), input_h_.size() * sizeof(float), cudaMemcpyHostToDevice));
+  if (use_gpu_preprocess_) {
+    preprocessGpu(images);
+  } else {
+    preprocess(images);
+  }
+
+  // the sequence from the upload to the download only depends on the batch size, so it can be
+  // replayed as a CUDA graph
+  const auto launch = [this, batch_size = images.size()](cudaStream_t stream) {
+    return launchInference(batch_size, stream);
+  };
+  if (use_cuda_graph_) {
+    trt_common_->launchWithCudaGraph(*stream_, launch);
+  } else {
+    launch(*stream_);
+  }
+  cudaStreamSynchronize(*stream_);
 
   if (needs_output_decode_) {
-    return feedforwardAndDecode(images, objects);
+    readAndDecodeObjects(images, objects);
   } else {
-    return feedforward(images, objects);
+    readObjects(images, objects);
   }
+  return true;
 }
 
-// This method is assumed to be called when specified YOLOX model contains
-// EfficientNMS_TRT module.
-bool TrtYoloX::feedforward(const std::vector<cv::Mat> & images, ObjectArrays & objects)
+bool TrtYoloX::launchInference(const size_t batch_size, cudaStream_t stream)
 {
+  if (!use_gpu_preprocess_) {
+    CHECK_CUDA_ERROR(cudaMemcpyAsync(
+      input_d_.get(), input_h_.get(), batch_size * input_size_ * sizeof(float),
+      cudaMemcpyHostToDevice, stream));
+  }
+
+  if (needs_output_decode_) {
+    std::vector<void *> buffers = {input_d_.get(), out_prob_d_.get()};
+    const bool is_enqueued = trt_common_->enqueueV2(buffers.data(), stream, nullptr);
+
+    CHECK_CUDA_ERROR(cudaMemcpyAsync(
+      out_prob_h_.get(), out_prob_d_.get(), sizeof(float) * out_elem_num_, cudaMemcpyDeviceToHost,
+      stream));
+    return is_enqueued;
+  }
+
+  // the model contains EfficientNMS_TRT module
   std::vector<void *> buffers = {
     input_d_.get(), out_num_detections_d_.get(), out_boxes_d_.get(), out_scores_d_.get(),
     out_classes_d_.get()};
-
-  trt_common_->enqueueV2(buffers.data(), *stream_, nullptr);
-
-  const auto batch_size = images.size();
-  auto out_num_detections = std::make_unique<int32_t[]>(batch_size);
-  auto out_boxes = std::make_unique<float[]>(4 * batch_size * max_detections_);
-  auto out_scores = std::make_unique<float[]>(batch_size * max_detections_);
-  auto out_classes = std::make_unique<int32_t[]>(batch_size * max_detections_);
+  const bool is_enqueued = trt_common_->enqueueV2(buffers.data(), stream, nullptr);
 
   CHECK_CUDA_ERROR(cudaMemcpyAsync(
-    out_num_detections.get(), out_num_detections_d_.get(), sizeof(int32_t) * batch_size,
-    cudaMemcpyDeviceToHost, *stream_));
+    out_num_detections_h_.get(), out_num_detections_d_.get(), sizeof(int32_t) * batch_size,
+    cudaMemcpyDeviceToHost, stream));
   CHECK_CUDA_ERROR(cudaMemcpyAsync(
-    out_boxes.get(), out_boxes_d_.get(), sizeof(float) * 4 * batch_size * max_detections_,
-    cudaMemcpyDeviceToHost, *stream_));
+    out_boxes_h_.get(), out_boxes_d_.get(), sizeof(float) * 4 * batch_size * max_detections_,
+    cudaMemcpyDeviceToHost, stream));
   CHECK_CUDA_ERROR(cudaMemcpyAsync(
-    out_scores.get(), out_scores_d_.get(), sizeof(float) * batch_size * max_detections_,
-    cudaMemcpyDeviceToHost, *stream_));
+    out_scores_h_.get(), out_scores_d_.get(), sizeof(float) * batch_size * max_detections_,
+    cudaMemcpyDeviceToHost, stream));
   CHECK_CUDA_ERROR(cudaMemcpyAsync(
-    out_classes.get(), out_classes_d_.get(), sizeof(int32_t) * batch_size * max_detections_,
-    cudaMemcpyDeviceToHost, *stream_));
-  cudaStreamSynchronize(*stream_);
+    out_classes_h_.get(), out_classes_d_.get(), sizeof(int32_t) * batch_size * max_detections_,
+    cudaMemcpyDeviceToHost, stream));
+  return is_enqueued;
+}
+
+// This method is assumed to be called when specified YOLOX model contains
+// EfficientNMS_TRT module.
+void TrtYoloX::readObjects(const std::vector<cv::Mat> & images, ObjectArrays & objects) const
+{
+  const auto batch_size = images.size();
+  const auto & out_num_detections = out_num_detections_h_;
+  const auto & out_boxes = out_boxes_h_;
+  const auto & out_scores = out_scores_h_;
+  const auto & out_classes = out_classes_h_;
+
   objects.clear();
   for (size_t i = 0; i < batch_size; ++i) {
     const size_t num_detection = static_cast<size_t>(out_num_detections[i]);
@@ -185,23 +293,14 @@ bool TrtYoloX::feedforward(const std::vector<cv::Mat> & images, ObjectArrays & o
     }
     objects.emplace_back(object_array);
   }
-  return true;
 }
 
-bool TrtYoloX::feedforwardAndDecode(const std::vector<cv::Mat> & images, ObjectArrays & objects)
+void TrtYoloX::readAndDecodeObjects(
+  const std::vector<cv::Mat> & images, ObjectArrays & objects) const
 {
-  std::vector<void *> buffers = {input_d_.get(), out_prob_d_.get()};
-
-  trt_common_->enqueueV2(buffers.data(), *stream_, nullptr);
-
   const auto batch_size = images.size();
 
-  CHECK_CUDA_ERROR(cudaMemcpyAsync(
-    out_prob_h_.get(), out_prob_d_.get(), sizeof(float) * out_elem_num_, cudaMemcpyDeviceToHost,
-    *stream_));
-  cudaStreamSynchronize(*stream_);
   objects.clear();
-
   for (size_t i = 0; i < batch_size; ++i) {
     auto image_size = images[i].size();
     float * batch_prob = out_prob_h_.get() + (i * out_elem_num_per_batch_);
@@ -209,7 +308,6 @@ bool TrtYoloX::feedforwardAndDecode(const std::vector<cv::Mat> & images, ObjectA
     decodeOutputs(batch_prob, object_array, scales_[i], image_size);
     objects.emplace_back(object_array);
   }
-  return true;
 }
 
 void TrtYoloX::decodeOutputs(
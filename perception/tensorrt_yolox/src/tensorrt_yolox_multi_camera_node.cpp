@@ -0,0 +1,188 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorrt_yolox/tensorrt_yolox_multi_camera_node.hpp"
+
+#include "perception_utils/object_classification.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace tensorrt_yolox
+{
+TrtYoloXMultiCameraNode::TrtYoloXMultiCameraNode(const rclcpp::NodeOptions & node_options)
+: Node("tensorrt_yolox_multi_camera", node_options)
+{
+  using std::chrono_literals::operator""ms;
+
+  std::string model_path = declare_parameter("model_path", "");
+  std::string label_path = declare_parameter("label_path", "");
+  std::string precision = declare_parameter("precision", "fp32");
+  // Objects with a score lower than this value will be ignored.
+  // This threshold will be ignored if specified model contains EfficientNMS_TRT module in it
+  float score_threshold = declare_parameter("score_threshold", 0.3);
+  // Detection results will be ignored if IoU over this value.
+  // This threshold will be ignored if specified model contains EfficientNMS_TRT module in it
+  float nms_threshold = declare_parameter("nms_threshold", 0.7);
+  const bool use_gpu_preprocess = declare_parameter("use_gpu_preprocess", false);
+  const bool use_cuda_graph = declare_parameter("use_cuda_graph", false);
+  const int num_cameras = declare_parameter("num_cameras", 2);
+  batch_time_window_ = rclcpp::Duration::from_seconds(declare_parameter("batch_time_window", 0.05));
+  publish_image_ = declare_parameter("publish_image", false);
+
+  if (num_cameras < 1) {
+    RCLCPP_ERROR(this->get_logger(), "num_cameras must be positive. [%d]", num_cameras);
+    rclcpp::shutdown();
+    return;
+  }
+  if (!readLabelFile(label_path, label_map_)) {
+    RCLCPP_ERROR(this->get_logger(), "Could not open label file. [%s]", label_path.c_str());
+    rclcpp::shutdown();
+  }
+  replaceLabelMap(label_map_);
+  // the model must have a dynamic batch dimension for batches of more than one image
+  trt_yolox_ = std::make_unique<tensorrt_yolox::TrtYoloX>(
+    model_path, precision, label_map_.size(), score_threshold, nms_threshold, "",
+    tensorrt_common::BatchConfig{1, num_cameras, num_cameras}, (1 << 30), use_gpu_preprocess,
+    use_cuda_graph);
+
+  if (declare_parameter("build_only", false)) {
+    RCLCPP_INFO(this->get_logger(), "TensorRT engine file is built and exit.");
+    rclcpp::shutdown();
+    return;
+  }
+
+  pending_images_.resize(num_cameras);
+  for (int i = 0; i < num_cameras; ++i) {
+    const auto id = std::to_string(i);
+    objects_pubs_.push_back(
+      this->create_publisher<tier4_perception_msgs::msg::DetectedObjectsWithFeature>(
+        "~/out/objects" + id, 1));
+    if (publish_image_) {
+      image_pubs_.push_back(image_transport::create_publisher(this, "~/out/image" + id));
+    }
+    image_subs_.push_back(image_transport::create_subscription(
+      this, "~/in/image" + id,
+      [this, i](const sensor_msgs::msg::Image::ConstSharedPtr msg) { onImage(msg, i); }, "raw",
+      rmw_qos_profile_sensor_data));
+  }
+
+  timer_ = rclcpp::create_timer(
+    this, get_clock(), 10ms, std::bind(&TrtYoloXMultiCameraNode::onTimer, this));
+}
+
+void TrtYoloXMultiCameraNode::onImage(
+  const sensor_msgs::msg::Image::ConstSharedPtr msg, const std::size_t camera_id)
+{
+  // a camera faster than the others only keeps its latest image
+  pending_images_.at(camera_id) = PendingImage{msg, this->now()};
+  const bool is_complete = std::all_of(
+    pending_images_.begin(), pending_images_.end(),
+    [](const auto & pending_image) { return pending_image.has_value(); });
+  if (is_complete) {
+    runBatch();
+  }
+}
+
+void TrtYoloXMultiCameraNode::onTimer()
+{
+  std::optional<rclcpp::Time> oldest_arrival_time;
+  for (const auto & pending_image : pending_images_) {
+    if (!pending_image) {
+      continue;
+    }
+    if (!oldest_arrival_time || pending_image->arrival_time < *oldest_arrival_time) {
+      oldest_arrival_time = pending_image->arrival_time;
+    }
+  }
+  if (oldest_arrival_time && this->now() - *oldest_arrival_time >= batch_time_window_) {
+    runBatch();
+  }
+}
+
+void TrtYoloXMultiCameraNode::runBatch()
+{
+  std::vector<std::size_t> camera_ids;
+  std::vector<sensor_msgs::msg::Image::ConstSharedPtr> msgs;
+  std::vector<cv_bridge::CvImagePtr> in_image_ptrs;
+  for (std::size_t i = 0; i < pending_images_.size(); ++i) {
+    if (!pending_images_[i]) {
+      continue;
+    }
+    const auto msg = std::move(pending_images_[i]->msg);
+    pending_images_[i].reset();
+    try {
+      in_image_ptrs.push_back(cv_bridge::toCvCopy(msg, sensor_msgs::image_encodings::BGR8));
+    } catch (cv_bridge::Exception & e) {
+      RCLCPP_ERROR(this->get_logger(), "cv_bridge exception: %s", e.what());
+      continue;
+    }
+    camera_ids.push_back(i);
+    msgs.push_back(msg);
+  }
+  if (in_image_ptrs.empty()) {
+    return;
+  }
+
+  std::vector<cv::Mat> images;
+  images.reserve(in_image_ptrs.size());
+  for (const auto & in_image_ptr : in_image_ptrs) {
+    images.push_back(in_image_ptr->image);
+  }
+  tensorrt_yolox::ObjectArrays objects;
+  if (!trt_yolox_->doInference(images, objects)) {
+    RCLCPP_WARN(this->get_logger(), "Fail to inference");
+    return;
+  }
+
+  for (std::size_t b = 0; b < camera_ids.size(); ++b) {
+    tier4_perception_msgs::msg::DetectedObjectsWithFeature out_objects;
+    auto & image = in_image_ptrs[b]->image;
+    for (const auto & yolox_object : objects.at(b)) {
+      tier4_perception_msgs::msg::DetectedObjectWithFeature object;
+      object.feature.roi.x_offset = yolox_object.x_offset;
+      object.feature.roi.y_offset = yolox_object.y_offset;
+      object.feature.roi.width = yolox_object.width;
+      object.feature.roi.height = yolox_object.height;
+      object.object.existence_probability = yolox_object.score;
+      object.object.classification =
+        perception_utils::toObjectClassifications(label_map_[yolox_object.type], 1.0f);
+      out_objects.feature_objects.push_back(object);
+      if (publish_image_) {
+        const auto left = std::max(0, static_cast<int>(object.feature.roi.x_offset));
+        const auto top = std::max(0, static_cast<int>(object.feature.roi.y_offset));
+        const auto right = std::min(
+          static_cast<int>(object.feature.roi.x_offset + object.feature.roi.width), image.cols);
+        const auto bottom = std::min(
+          static_cast<int>(object.feature.roi.y_offset + object.feature.roi.height), image.rows);
+        cv::rectangle(
+          image, cv::Point(left, top), cv::Point(right, bottom), cv::Scalar(0, 0, 255), 3, 8, 0);
+      }
+    }
+    if (publish_image_) {
+      image_pubs_.at(camera_ids[b]).publish(in_image_ptrs[b]->toImageMsg());
+    }
+
+    out_objects.header = msgs[b]->header;
+    objects_pubs_.at(camera_ids[b])->publish(out_objects);
+  }
+}
+
+}  // namespace tensorrt_yolox
+
+#include "rclcpp_components/register_node_macro.hpp"
+RCLCPP_COMPONENTS_REGISTER_NODE(tensorrt_yolox::TrtYoloXMultiCameraNode)
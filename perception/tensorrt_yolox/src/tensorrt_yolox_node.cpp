@@ -42,13 +42,17 @@ TrtYoloXNode::TrtYoloXNode(const rclcpp::NodeOptions & node_options)
   // This threshold will be ignored if specified model contains EfficientNMS_TRT module in it
   float nms_threshold = declare_parameter("nms_threshold", 0.7);
 
-  if (!readLabelFile(label_path)) {
-    RCLCPP_ERROR(this->get_logger(), "Could not find label file");
+  const bool use_gpu_preprocess = declare_parameter("use_gpu_preprocess", false);
+  const bool use_cuda_graph = declare_parameter("use_cuda_graph", false);
+
+  if (!readLabelFile(label_path, label_map_)) {
+    RCLCPP_ERROR(this->get_logger(), "Could not open label file. [%s]", label_path.c_str());
     rclcpp::shutdown();
   }
-  replaceLabelMap();
+  replaceLabelMap(label_map_);
   trt_yolox_ = std::make_unique<tensorrt_yolox::TrtYoloX>(
-    model_path, precision, label_map_.size(), score_threshold, nms_threshold);
+    model_path, precision, label_map_.size(), score_threshold, nms_threshold, "",
+    tensorrt_common::BatchConfig{1, 1, 1}, (1 << 30), use_gpu_preprocess, use_cuda_graph);
 
   timer_ =
     rclcpp::create_timer(this, get_clock(), 100ms, std::bind(&TrtYoloXNode::onConnect, this));
@@ -123,38 +127,6 @@ void TrtYoloXNode::onImage(const sensor_msgs::msg::Image::ConstSharedPtr msg)
   objects_pub_->publish(out_objects);
 }
 
-bool TrtYoloXNode::readLabelFile(const std::string & label_path)
-{
-  std::ifstream label_file(label_path);
-  if (!label_file.is_open()) {
-    RCLCPP_ERROR(this->get_logger(), "Could not open label file. [%s]", label_path.c_str());
-    return false;
-  }
-  int label_index{};
-  std::string label;
-  while (getline(label_file, label)) {
-    std::transform(
-      label.begin(), label.end(), label.begin(), [](auto c) { return std::toupper(c); });
-    label_map_.insert({label_index, label});
-    ++label_index;
-  }
-  return true;
-}
-
-void TrtYoloXNode::replaceLabelMap()
-{
-  for (std::size_t i = 0; i < label_map_.size(); ++i) {
-    auto & label = label_map_[i];
-    if (label == "PERSON") {
-      label = "PEDESTRIAN";
-    } else if (
-      label != "CAR" && label != "PEDESTRIAN" && label != "BUS" && label != "TRUCK" &&
-      label != "BICYCLE" && label != "MOTORCYCLE") {
-      label = "UNKNOWN";
-    }
-  }
-}
-
 }  // namespace tensorrt_yolox
 
 #include "rclcpp_components/register_node_macro.hpp"
@@ -0,0 +1,97 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cuda_utils/cuda_check_error.hpp"
+#include "cuda_utils/cuda_unique_ptr.hpp"
+
+#include <opencv2/core.hpp>
+#include <opencv2/dnn.hpp>
+#include <opencv2/imgproc.hpp>
+#include <tensorrt_yolox/preprocess.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+constexpr int INPUT_WIDTH = 160;
+constexpr int INPUT_HEIGHT = 96;
+
+// same as TrtYoloX::preprocess
+std::vector<float> letterboxOnCpu(const cv::Mat & image)
+{
+  const float scale = std::min(
+    static_cast<float>(INPUT_WIDTH) / image.cols, static_cast<float>(INPUT_HEIGHT) / image.rows);
+  cv::Mat dst_image;
+  cv::resize(
+    image, dst_image, cv::Size(image.cols * scale, image.rows * scale), 0, 0, cv::INTER_CUBIC);
+  cv::copyMakeBorder(
+    dst_image, dst_image, 0, INPUT_HEIGHT - dst_image.rows, 0, INPUT_WIDTH - dst_image.cols,
+    cv::BORDER_CONSTANT, {114, 114, 114});
+  const auto blob =
+    cv::dnn::blobFromImages({dst_image}, 1.0, cv::Size(), cv::Scalar(), false, false, CV_32F);
+  return std::vector<float>(blob.ptr<float>(), blob.ptr<float>() + blob.total());
+}
+
+std::vector<float> letterboxOnGpu(const cv::Mat & image)
+{
+  const float scale = std::min(
+    static_cast<float>(INPUT_WIDTH) / image.cols, static_cast<float>(INPUT_HEIGHT) / image.rows);
+  const size_t image_size = image.total() * image.elemSize();
+  const size_t input_size = 3 * INPUT_WIDTH * INPUT_HEIGHT;
+  auto image_d = cuda_utils::make_unique<std::uint8_t[]>(image_size);
+  auto input_d = cuda_utils::make_unique<float[]>(input_size);
+  CHECK_CUDA_ERROR(cudaMemcpy(image_d.get(), image.data, image_size, cudaMemcpyHostToDevice));
+  CHECK_CUDA_ERROR(tensorrt_yolox::letterboxToChw_launch(
+    image_d.get(), image.cols, image.rows, image.cols * image.elemSize(),
+    static_cast<int>(image.cols * scale), static_cast<int>(image.rows * scale), input_d.get(),
+    INPUT_WIDTH, INPUT_HEIGHT, nullptr));
+  std::vector<float> input(input_size);
+  CHECK_CUDA_ERROR(
+    cudaMemcpy(input.data(), input_d.get(), input_size * sizeof(float), cudaMemcpyDeviceToHost));
+  return input;
+}
+
+bool hasCudaDevice()
+{
+  int num_devices = 0;
+  return cudaGetDeviceCount(&num_devices) == cudaSuccess && num_devices > 0;
+}
+}  // namespace
+
+TEST(PreprocessTest, letterboxSameAsCpu)
+{
+  if (!hasCudaDevice()) {
+    GTEST_SKIP() << "no CUDA device";
+  }
+
+  cv::RNG rng(0);
+  // wider, taller, larger and smaller than the input, and the size of the input
+  const std::vector<cv::Size> sizes = {{320, 120}, {100, 200}, {640, 480}, {37, 23}, {160, 96}};
+  for (const auto & size : sizes) {
+    cv::Mat image(size, CV_8UC3);
+    rng.fill(image, cv::RNG::UNIFORM, 0, 256);
+
+    const auto expected = letterboxOnCpu(image);
+    const auto actual = letterboxOnGpu(image);
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      // OpenCV interpolates 8-bit images in fixed point, which may round the other way
+      ASSERT_NEAR(actual.at(i), expected.at(i), 1.0f) << size << ", index: " << i;
+    }
+  }
+}
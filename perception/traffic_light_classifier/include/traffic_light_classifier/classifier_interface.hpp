@@ -30,6 +30,19 @@ public:
   virtual bool getTrafficSignal(
     const cv::Mat & input_image,
     autoware_auto_perception_msgs::msg::TrafficSignal & traffic_signal) = 0;
+
+  // classify the images of a frame together, the lights of each are added to its traffic signal
+  virtual bool getTrafficSignals(
+    const std::vector<cv::Mat> & input_images,
+    std::vector<autoware_auto_perception_msgs::msg::TrafficSignal> & traffic_signals)
+  {
+    for (std::size_t i = 0; i < input_images.size(); ++i) {
+      if (!getTrafficSignal(input_images.at(i), traffic_signals.at(i))) {
+        return false;
+      }
+    }
+    return true;
+  }
 };
 }  // namespace traffic_light
 
@@ -43,9 +43,12 @@ public:
   bool getTrafficSignal(
     const cv::Mat & input_image,
     autoware_auto_perception_msgs::msg::TrafficSignal & traffic_signal) override;
+  bool getTrafficSignals(
+    const std::vector<cv::Mat> & input_images,
+    std::vector<autoware_auto_perception_msgs::msg::TrafficSignal> & traffic_signals) override;
 
 private:
-  void preProcess(cv::Mat & image, std::vector<float> & tensor, bool normalize = true);
+  void preProcess(cv::Mat & image, float * tensor, bool normalize = true);
   bool postProcess(
     std::vector<float> & output_data_host,
     autoware_auto_perception_msgs::msg::TrafficSignal & traffic_signal, bool apply_softmax = false);
@@ -99,6 +102,11 @@ private:
   rclcpp::Node * node_ptr_;
 
   std::shared_ptr<Tn::TrtCommon> trt_;
+  // sized for a whole batch once, instead of for every image
+  std::vector<float> input_data_host_;
+  std::vector<float> output_data_host_;
+  Tn::UniquePtr<float[]> input_data_device_;
+  Tn::UniquePtr<float[]> output_data_device_;
   image_transport::Publisher image_pub_;
   std::vector<std::string> labels_;
   std::vector<double> mean_;
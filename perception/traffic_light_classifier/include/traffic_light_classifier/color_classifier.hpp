@@ -26,6 +26,7 @@
 
 #include <cv_bridge/cv_bridge.h>
 
+#include <cstdint>
 #include <vector>
 
 namespace traffic_light
@@ -62,10 +63,29 @@ public:
     const cv::Mat & input_image,
     autoware_auto_perception_msgs::msg::TrafficSignal & traffic_signal) override;
 
+  bool getTrafficSignals(
+    const std::vector<cv::Mat> & input_images,
+    std::vector<autoware_auto_perception_msgs::msg::TrafficSignal> & traffic_signals) override;
+
 private:
+  bool classify(
+    const cv::Mat & input_image,
+    autoware_auto_perception_msgs::msg::TrafficSignal & traffic_signal) const;
+  // count the pixels of each color through the color table with the noise filter fused
+  void countColorPixels(
+    const cv::Mat & input_image, int & green_pixel_num, int & yellow_pixel_num,
+    int & red_pixel_num) const;
+  autoware_auto_perception_msgs::msg::TrafficLight createTrafficLight(
+    const int green_pixel_num, const int yellow_pixel_num, const int red_pixel_num,
+    const int pixel_num) const;
   bool filterHSV(
     const cv::Mat & input_image, cv::Mat & green_image, cv::Mat & yellow_image,
     cv::Mat & red_image);
+  void updateColorTable();
+  uint8_t lookUpColor(const uint8_t * pixel) const
+  {
+    return color_table_[(pixel[0] << 16) | (pixel[1] << 8) | pixel[2]];
+  }
   rcl_interfaces::msg::SetParametersResult parametersCallback(
     const std::vector<rclcpp::Parameter> & parameters);
 
@@ -75,6 +95,12 @@ private:
     Sat = 1,
     Val = 2,
   };
+  // bits of the color table entries, the HSV ranges of the colors may overlap
+  enum Color : uint8_t {
+    Green = 1,
+    Yellow = 2,
+    Red = 4,
+  };
   image_transport::Publisher image_pub_;
 
   rclcpp::node_interfaces::OnSetParametersCallbackHandle::SharedPtr set_param_res_;
@@ -87,6 +113,10 @@ private:
   cv::Scalar max_hsv_yellow_;
   cv::Scalar min_hsv_red_;
   cv::Scalar max_hsv_red_;
+  // colors of each 24 bit pixel value, rebuilt when the HSV ranges change
+  std::vector<uint8_t> color_table_;
+
+  friend class ColorClassifierTest;  // for test code
 };
 
 }  // namespace traffic_light
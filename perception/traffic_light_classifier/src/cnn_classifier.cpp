@@ -19,6 +19,7 @@
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -44,11 +45,20 @@ CNNClassifier::CNNClassifier(rclcpp::Node * node_ptr) : node_ptr_(node_ptr)
   std::string input_name = node_ptr_->declare_parameter("input_name", std::string("input_0"));
   std::string output_name = node_ptr_->declare_parameter("output_name", std::string("output_0"));
   apply_softmax_ = node_ptr_->declare_parameter("apply_softmax", true);
+  const int max_batch_size = node_ptr_->declare_parameter("max_batch_size", 8);
 
   readLabelfile(label_file_path, labels_);
 
-  trt_ = std::make_shared<Tn::TrtCommon>(model_file_path, precision, input_name, output_name);
+  trt_ = std::make_shared<Tn::TrtCommon>(
+    model_file_path, precision, input_name, output_name, max_batch_size);
   trt_->setup();
+  if (trt_->isInitialized()) {
+    const std::size_t batch_size = trt_->getMaxBatchSize();
+    input_data_host_.assign(batch_size * trt_->getNumInput(), 0.0f);
+    output_data_host_.resize(batch_size * trt_->getNumOutput());
+    input_data_device_ = Tn::make_unique<float[]>(input_data_host_.size());
+    output_data_device_ = Tn::make_unique<float[]>(output_data_host_.size());
+  }
 
   if (node_ptr_->declare_parameter("build_only", false)) {
     RCLCPP_INFO(node_ptr_->get_logger(), "TensorRT engine is built and shutdown node.");
@@ -58,43 +68,66 @@ CNNClassifier::CNNClassifier(rclcpp::Node * node_ptr) : node_ptr_(node_ptr)
 
 bool CNNClassifier::getTrafficSignal(
   const cv::Mat & input_image, autoware_auto_perception_msgs::msg::TrafficSignal & traffic_signal)
+{
+  std::vector<autoware_auto_perception_msgs::msg::TrafficSignal> traffic_signals{traffic_signal};
+  if (!getTrafficSignals({input_image}, traffic_signals)) {
+    return false;
+  }
+  traffic_signal = traffic_signals.front();
+  return true;
+}
+
+bool CNNClassifier::getTrafficSignals(
+  const std::vector<cv::Mat> & input_images,
+  std::vector<autoware_auto_perception_msgs::msg::TrafficSignal> & traffic_signals)
 {
   if (!trt_->isInitialized()) {
     RCLCPP_WARN(node_ptr_->get_logger(), "failed to init tensorrt");
     return false;
   }
 
-  int num_input = trt_->getNumInput();
-  int num_output = trt_->getNumOutput();
-
-  std::vector<float> input_data_host(num_input);
-
-  cv::Mat image = input_image.clone();
-  preProcess(image, input_data_host, true);
+  const std::size_t num_input = trt_->getNumInput();
+  const std::size_t num_output = trt_->getNumOutput();
+  const std::size_t max_batch_size = trt_->getMaxBatchSize();
 
-  auto input_data_device = Tn::make_unique<float[]>(num_input);
-  cudaMemcpy(
-    input_data_device.get(), input_data_host.data(), num_input * sizeof(float),
-    cudaMemcpyHostToDevice);
-
-  auto output_data_device = Tn::make_unique<float[]>(num_output);
-
-  // do inference
-  std::vector<void *> bindings = {input_data_device.get(), output_data_device.get()};
-
-  trt_->context_->executeV2(bindings.data());
-
-  std::vector<float> output_data_host(num_output);
-  cudaMemcpy(
-    output_data_host.data(), output_data_device.get(), num_output * sizeof(float),
-    cudaMemcpyDeviceToHost);
-
-  postProcess(output_data_host, traffic_signal, apply_softmax_);
+  for (std::size_t batch_begin = 0; batch_begin < input_images.size();
+       batch_begin += max_batch_size) {
+    const std::size_t batch_size = std::min(max_batch_size, input_images.size() - batch_begin);
+    if (!trt_->setBatchSize(batch_size)) {
+      RCLCPP_WARN(node_ptr_->get_logger(), "failed to set the batch size of tensorrt");
+      return false;
+    }
 
-  /* debug */
-  if (0 < image_pub_.getNumSubscribers()) {
-    cv::Mat debug_image = input_image.clone();
-    outputDebugImage(debug_image, traffic_signal);
+    for (std::size_t i = 0; i < batch_size; ++i) {
+      cv::Mat image = input_images.at(batch_begin + i).clone();
+      preProcess(image, input_data_host_.data() + i * num_input, true);
+    }
+    cudaMemcpy(
+      input_data_device_.get(), input_data_host_.data(), batch_size * num_input * sizeof(float),
+      cudaMemcpyHostToDevice);
+
+    // do inference
+    std::vector<void *> bindings = {input_data_device_.get(), output_data_device_.get()};
+
+    trt_->context_->executeV2(bindings.data());
+
+    cudaMemcpy(
+      output_data_host_.data(), output_data_device_.get(),
+      batch_size * num_output * sizeof(float), cudaMemcpyDeviceToHost);
+
+    for (std::size_t i = 0; i < batch_size; ++i) {
+      std::vector<float> output_data(
+        output_data_host_.begin() + i * num_output,
+        output_data_host_.begin() + (i + 1) * num_output);
+      auto & traffic_signal = traffic_signals.at(batch_begin + i);
+      postProcess(output_data, traffic_signal, apply_softmax_);
+
+      /* debug */
+      if (0 < image_pub_.getNumSubscribers()) {
+        cv::Mat debug_image = input_images.at(batch_begin + i).clone();
+        outputDebugImage(debug_image, traffic_signal);
+      }
+    }
   }
 
   return true;
@@ -132,7 +165,7 @@ void CNNClassifier::outputDebugImage(
   image_pub_.publish(debug_image_msg);
 }
 
-void CNNClassifier::preProcess(cv::Mat & image, std::vector<float> & input_tensor, bool normalize)
+void CNNClassifier::preProcess(cv::Mat & image, float * input_tensor, bool normalize)
 {
   /* normalize */
   /* ((channel[0] / 255) - mean[0]) / std[0] */
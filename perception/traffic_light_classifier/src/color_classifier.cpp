@@ -13,9 +13,11 @@
 // limitations under the License.
 #include "traffic_light_classifier/color_classifier.hpp"
 
+#include <opencv2/core/utility.hpp>
 #include <opencv2/imgproc/imgproc_c.h>
 
 #include <algorithm>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -46,6 +48,8 @@ ColorClassifier::ColorClassifier(rclcpp::Node * node_ptr) : node_ptr_(node_ptr)
   hsv_config_.red_max_s = node_ptr_->declare_parameter("red_max_s", 255);
   hsv_config_.red_max_v = node_ptr_->declare_parameter("red_max_v", 255);
 
+  updateColorTable();
+
   // set parameter callback
   set_param_res_ = node_ptr_->add_on_set_parameters_callback(
     std::bind(&ColorClassifier::parametersCallback, this, _1));
@@ -54,6 +58,10 @@ ColorClassifier::ColorClassifier(rclcpp::Node * node_ptr) : node_ptr_(node_ptr)
 bool ColorClassifier::getTrafficSignal(
   const cv::Mat & input_image, autoware_auto_perception_msgs::msg::TrafficSignal & traffic_signal)
 {
+  if (image_pub_.getNumSubscribers() == 0) {
+    return classify(input_image, traffic_signal);
+  }
+
   cv::Mat green_image;
   cv::Mat yellow_image;
   cv::Mat red_image;
@@ -146,55 +154,199 @@ bool ColorClassifier::getTrafficSignal(
   const int green_pixel_num = cv::countNonZero(green_filtered_bin_image);
   const int yellow_pixel_num = cv::countNonZero(yellow_filtered_bin_image);
   const int red_pixel_num = cv::countNonZero(red_filtered_bin_image);
-  const double green_ratio =
-    static_cast<double>(green_pixel_num) /
-    static_cast<double>(green_filtered_bin_image.rows * green_filtered_bin_image.cols);
+  traffic_signal.lights.push_back(createTrafficLight(
+    green_pixel_num, yellow_pixel_num, red_pixel_num, input_image.rows * input_image.cols));
+  return true;
+}
+
+bool ColorClassifier::getTrafficSignals(
+  const std::vector<cv::Mat> & input_images,
+  std::vector<autoware_auto_perception_msgs::msg::TrafficSignal> & traffic_signals)
+{
+  // the debug image is published per image, so it keeps the sequential path
+  if (0 < image_pub_.getNumSubscribers()) {
+    return ClassifierInterface::getTrafficSignals(input_images, traffic_signals);
+  }
+
+  // each image only adds to its own traffic signal, so the images are classified in parallel
+  std::vector<char> results(input_images.size(), true);
+  cv::parallel_for_(cv::Range(0, static_cast<int>(input_images.size())), [&](const cv::Range & r) {
+    for (int i = r.start; i < r.end; ++i) {
+      results.at(i) = classify(input_images.at(i), traffic_signals.at(i));
+    }
+  });
+  return std::all_of(results.begin(), results.end(), [](const char result) { return result; });
+}
+
+bool ColorClassifier::classify(
+  const cv::Mat & input_image,
+  autoware_auto_perception_msgs::msg::TrafficSignal & traffic_signal) const
+{
+  if (input_image.type() != CV_8UC3) {
+    RCLCPP_ERROR(node_ptr_->get_logger(), "input image is not a 3 channel 8 bit image");
+    return false;
+  }
+
+  int green_pixel_num = 0;
+  int yellow_pixel_num = 0;
+  int red_pixel_num = 0;
+  countColorPixels(input_image, green_pixel_num, yellow_pixel_num, red_pixel_num);
+  traffic_signal.lights.push_back(createTrafficLight(
+    green_pixel_num, yellow_pixel_num, red_pixel_num, input_image.rows * input_image.cols));
+  return true;
+}
+
+void ColorClassifier::countColorPixels(
+  const cv::Mat & input_image, int & green_pixel_num, int & yellow_pixel_num,
+  int & red_pixel_num) const
+{
+  // classify each pixel once through the color table. The colors are bits of one mask, so the
+  // erosion with the cross element and the dilation with the 3x3 rectangle below are the AND and
+  // the OR of the masks around each pixel, and they run for all the colors at once. Clamping the
+  // neighbors to the image is the same as ignoring those outside of it, as cv::erode and
+  // cv::dilate do by default.
+  const int rows = input_image.rows;
+  const int cols = input_image.cols;
+  cv::Mat1b colors(rows, cols);
+  for (int r = 0; r < rows; ++r) {
+    const uint8_t * src = input_image.ptr<uint8_t>(r);
+    uint8_t * dst = colors.ptr<uint8_t>(r);
+    for (int c = 0; c < cols; ++c) {
+      dst[c] = lookUpColor(src + 3 * c);
+    }
+  }
+
+  // erode and take the horizontal half of the dilation row by row
+  cv::Mat1b dilated_rows(rows, cols);
+  std::vector<uint8_t> eroded_row_buffer(cols);
+  uint8_t * eroded_row = eroded_row_buffer.data();
+  for (int r = 0; r < rows; ++r) {
+    const uint8_t * prev = colors.ptr<uint8_t>(std::max(r - 1, 0));
+    const uint8_t * curr = colors.ptr<uint8_t>(r);
+    const uint8_t * next = colors.ptr<uint8_t>(std::min(r + 1, rows - 1));
+    for (int c = 0; c < cols; ++c) {
+      eroded_row[c] = curr[c] & prev[c] & next[c] & curr[std::max(c - 1, 0)] &
+                         curr[std::min(c + 1, cols - 1)];
+    }
+    uint8_t * dst = dilated_rows.ptr<uint8_t>(r);
+    for (int c = 0; c < cols; ++c) {
+      dst[c] = eroded_row[std::max(c - 1, 0)] | eroded_row[c] |
+               eroded_row[std::min(c + 1, cols - 1)];
+    }
+  }
+
+  // finish the dilation vertically and count the pixels of each color
+  green_pixel_num = 0;
+  yellow_pixel_num = 0;
+  red_pixel_num = 0;
+  for (int r = 0; r < rows; ++r) {
+    const uint8_t * prev = dilated_rows.ptr<uint8_t>(std::max(r - 1, 0));
+    const uint8_t * curr = dilated_rows.ptr<uint8_t>(r);
+    const uint8_t * next = dilated_rows.ptr<uint8_t>(std::min(r + 1, rows - 1));
+    for (int c = 0; c < cols; ++c) {
+      const uint8_t dilated = prev[c] | curr[c] | next[c];
+      green_pixel_num += (dilated & Green) ? 1 : 0;
+      yellow_pixel_num += (dilated & Yellow) ? 1 : 0;
+      red_pixel_num += (dilated & Red) ? 1 : 0;
+    }
+  }
+}
+
+autoware_auto_perception_msgs::msg::TrafficLight ColorClassifier::createTrafficLight(
+  const int green_pixel_num, const int yellow_pixel_num, const int red_pixel_num,
+  const int pixel_num) const
+{
+  const double green_ratio = static_cast<double>(green_pixel_num) / static_cast<double>(pixel_num);
   const double yellow_ratio =
-    static_cast<double>(yellow_pixel_num) /
-    static_cast<double>(yellow_filtered_bin_image.rows * yellow_filtered_bin_image.cols);
-  const double red_ratio =
-    static_cast<double>(red_pixel_num) /
-    static_cast<double>(red_filtered_bin_image.rows * red_filtered_bin_image.cols);
+    static_cast<double>(yellow_pixel_num) / static_cast<double>(pixel_num);
+  const double red_ratio = static_cast<double>(red_pixel_num) / static_cast<double>(pixel_num);
 
   if (yellow_ratio < green_ratio && red_ratio < green_ratio) {
     autoware_auto_perception_msgs::msg::TrafficLight light;
     light.color = autoware_auto_perception_msgs::msg::TrafficLight::GREEN;
     light.confidence = std::min(1.0, static_cast<double>(green_pixel_num) / (20.0 * 20.0));
-    traffic_signal.lights.push_back(light);
+    return light;
   } else if (green_ratio < yellow_ratio && red_ratio < yellow_ratio) {
     autoware_auto_perception_msgs::msg::TrafficLight light;
     light.color = autoware_auto_perception_msgs::msg::TrafficLight::AMBER;
     light.confidence = std::min(1.0, static_cast<double>(yellow_pixel_num) / (20.0 * 20.0));
-    traffic_signal.lights.push_back(light);
+    return light;
   } else if (green_ratio < red_ratio && yellow_ratio < red_ratio) {
     autoware_auto_perception_msgs::msg::TrafficLight light;
     light.color = ::autoware_auto_perception_msgs::msg::TrafficLight::RED;
     light.confidence = std::min(1.0, static_cast<double>(red_pixel_num) / (20.0 * 20.0));
-    traffic_signal.lights.push_back(light);
+    return light;
   } else {
     autoware_auto_perception_msgs::msg::TrafficLight light;
     light.color = ::autoware_auto_perception_msgs::msg::TrafficLight::UNKNOWN;
     light.confidence = 0.0;
-    traffic_signal.lights.push_back(light);
+    return light;
   }
-  return true;
 }
 
 bool ColorClassifier::filterHSV(
   const cv::Mat & input_image, cv::Mat & green_image, cv::Mat & yellow_image, cv::Mat & red_image)
 {
-  cv::Mat hsv_image;
-  cv::cvtColor(input_image, hsv_image, cv::COLOR_BGR2HSV);
-  try {
-    cv::inRange(hsv_image, min_hsv_green_, max_hsv_green_, green_image);
-    cv::inRange(hsv_image, min_hsv_yellow_, max_hsv_yellow_, yellow_image);
-    cv::inRange(hsv_image, min_hsv_red_, max_hsv_red_, red_image);
-  } catch (cv::Exception & e) {
-    RCLCPP_ERROR(node_ptr_->get_logger(), "failed to filter image by hsv value : %s", e.what());
+  if (input_image.type() != CV_8UC3) {
+    RCLCPP_ERROR(node_ptr_->get_logger(), "input image is not a 3 channel 8 bit image");
     return false;
   }
+  green_image.create(input_image.size(), CV_8UC1);
+  yellow_image.create(input_image.size(), CV_8UC1);
+  red_image.create(input_image.size(), CV_8UC1);
+  for (int r = 0; r < input_image.rows; ++r) {
+    const uint8_t * src = input_image.ptr<uint8_t>(r);
+    for (int c = 0; c < input_image.cols; ++c) {
+      const uint8_t color = lookUpColor(src + 3 * c);
+      green_image.at<uint8_t>(r, c) = (color & Green) ? 255 : 0;
+      yellow_image.at<uint8_t>(r, c) = (color & Yellow) ? 255 : 0;
+      red_image.at<uint8_t>(r, c) = (color & Red) ? 255 : 0;
+    }
+  }
   return true;
 }
+
+void ColorClassifier::updateColorTable()
+{
+  min_hsv_green_ =
+    cv::Scalar(hsv_config_.green_min_h, hsv_config_.green_min_s, hsv_config_.green_min_v);
+  max_hsv_green_ =
+    cv::Scalar(hsv_config_.green_max_h, hsv_config_.green_max_s, hsv_config_.green_max_v);
+  min_hsv_yellow_ =
+    cv::Scalar(hsv_config_.yellow_min_h, hsv_config_.yellow_min_s, hsv_config_.yellow_min_v);
+  max_hsv_yellow_ =
+    cv::Scalar(hsv_config_.yellow_max_h, hsv_config_.yellow_max_s, hsv_config_.yellow_max_v);
+  min_hsv_red_ = cv::Scalar(hsv_config_.red_min_h, hsv_config_.red_min_s, hsv_config_.red_min_v);
+  max_hsv_red_ = cv::Scalar(hsv_config_.red_max_h, hsv_config_.red_max_s, hsv_config_.red_max_v);
+
+  // run every 24 bit color through the same conversion and range checks as an image would go,
+  // one 256x256 plane of the first channel at a time
+  color_table_.resize(1 << 24);
+  cv::Mat plane(256, 256, CV_8UC3);
+  cv::Mat hsv_plane;
+  cv::Mat green_plane;
+  cv::Mat yellow_plane;
+  cv::Mat red_plane;
+  for (int c0 = 0; c0 < 256; ++c0) {
+    for (int c1 = 0; c1 < 256; ++c1) {
+      auto * row = plane.ptr<cv::Vec3b>(c1);
+      for (int c2 = 0; c2 < 256; ++c2) {
+        row[c2] = cv::Vec3b(c0, c1, c2);
+      }
+    }
+    cv::cvtColor(plane, hsv_plane, cv::COLOR_BGR2HSV);
+    cv::inRange(hsv_plane, min_hsv_green_, max_hsv_green_, green_plane);
+    cv::inRange(hsv_plane, min_hsv_yellow_, max_hsv_yellow_, yellow_plane);
+    cv::inRange(hsv_plane, min_hsv_red_, max_hsv_red_, red_plane);
+
+    uint8_t * table = color_table_.data() + (c0 << 16);
+    for (int i = 0; i < 256 * 256; ++i) {
+      table[i] = (green_plane.data[i] ? Green : 0) | (yellow_plane.data[i] ? Yellow : 0) |
+                 (red_plane.data[i] ? Red : 0);
+    }
+  }
+}
+
 rcl_interfaces::msg::SetParametersResult ColorClassifier::parametersCallback(
   const std::vector<rclcpp::Parameter> & parameters)
 {
@@ -228,16 +380,7 @@ rcl_interfaces::msg::SetParametersResult ColorClassifier::parametersCallback(
   update_param("red_max_s", hsv_config_.red_max_s);
   update_param("red_max_v", hsv_config_.red_max_v);
 
-  min_hsv_green_ =
-    cv::Scalar(hsv_config_.green_min_h, hsv_config_.green_min_s, hsv_config_.green_min_v);
-  max_hsv_green_ =
-    cv::Scalar(hsv_config_.green_max_h, hsv_config_.green_max_s, hsv_config_.green_max_v);
-  min_hsv_yellow_ =
-    cv::Scalar(hsv_config_.yellow_min_h, hsv_config_.yellow_min_s, hsv_config_.yellow_min_v);
-  max_hsv_yellow_ =
-    cv::Scalar(hsv_config_.yellow_max_h, hsv_config_.yellow_max_s, hsv_config_.yellow_max_v);
-  min_hsv_red_ = cv::Scalar(hsv_config_.red_min_h, hsv_config_.red_min_s, hsv_config_.red_min_v);
-  max_hsv_red_ = cv::Scalar(hsv_config_.red_max_h, hsv_config_.red_max_s, hsv_config_.red_max_v);
+  updateColorTable();
 
   rcl_interfaces::msg::SetParametersResult result;
   result.successful = true;
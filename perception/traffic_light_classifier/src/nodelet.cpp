@@ -80,30 +80,33 @@ void TrafficLightClassifierNodelet::imageRoiCallback(
     return;
   }
 
-  cv_bridge::CvImagePtr cv_ptr;
+  // the ROIs are cropped from the message buffer when the image is already rgb8
+  cv_bridge::CvImageConstPtr cv_ptr;
   try {
-    cv_ptr = cv_bridge::toCvCopy(input_image_msg, sensor_msgs::image_encodings::RGB8);
+    cv_ptr = cv_bridge::toCvShare(input_image_msg, sensor_msgs::image_encodings::RGB8);
   } catch (cv_bridge::Exception & e) {
     RCLCPP_ERROR(
       this->get_logger(), "Could not convert from '%s' to 'rgb8'.",
       input_image_msg->encoding.c_str());
+    return;
   }
 
   autoware_auto_perception_msgs::msg::TrafficSignalArray output_msg;
 
+  std::vector<cv::Mat> clipped_images;
   for (size_t i = 0; i < input_rois_msg->rois.size(); ++i) {
     const sensor_msgs::msg::RegionOfInterest & roi = input_rois_msg->rois.at(i).roi;
-    cv::Mat clipped_image(
+    clipped_images.emplace_back(
       cv_ptr->image, cv::Rect(roi.x_offset, roi.y_offset, roi.width, roi.height));
 
     autoware_auto_perception_msgs::msg::TrafficSignal traffic_signal;
     traffic_signal.map_primitive_id = input_rois_msg->rois.at(i).id;
-    if (!classifier_ptr_->getTrafficSignal(clipped_image, traffic_signal)) {
-      RCLCPP_ERROR(this->get_logger(), "failed classify image, abort callback");
-      return;
-    }
     output_msg.signals.push_back(traffic_signal);
   }
+  if (!classifier_ptr_->getTrafficSignals(clipped_images, output_msg.signals)) {
+    RCLCPP_ERROR(this->get_logger(), "failed classify image, abort callback");
+    return;
+  }
 
   output_msg.header = input_image_msg->header;
   traffic_signal_array_pub_->publish(output_msg);
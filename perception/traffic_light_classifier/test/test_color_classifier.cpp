@@ -0,0 +1,185 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "traffic_light_classifier/color_classifier.hpp"
+
+#include <opencv2/imgproc/imgproc.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace traffic_light
+{
+class ColorClassifierTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    rclcpp::init(0, nullptr);
+    node_ = std::make_shared<rclcpp::Node>("color_classifier_test_node");
+    classifier_ = std::make_unique<ColorClassifier>(node_.get());
+  }
+
+  void TearDown() override
+  {
+    classifier_.reset();
+    node_.reset();
+    rclcpp::shutdown();
+  }
+
+  // the per-color OpenCV calls the fused pass of the classifier replaced
+  void countColorPixelsByOpenCV(
+    const cv::Mat & input_image, int & green_pixel_num, int & yellow_pixel_num,
+    int & red_pixel_num) const
+  {
+    cv::Mat hsv_image;
+    cv::cvtColor(input_image, hsv_image, cv::COLOR_BGR2HSV);
+    const cv::Mat element4 = (cv::Mat_<uchar>(3, 3) << 0, 1, 0, 1, 1, 1, 0, 1, 0);
+    const auto count = [&](const cv::Scalar & min_hsv, const cv::Scalar & max_hsv) {
+      cv::Mat image;
+      cv::inRange(hsv_image, min_hsv, max_hsv, image);
+      cv::erode(image, image, element4, cv::Point(-1, -1), 1);
+      cv::dilate(image, image, cv::Mat(), cv::Point(-1, -1), 1);
+      return cv::countNonZero(image);
+    };
+    green_pixel_num = count(classifier_->min_hsv_green_, classifier_->max_hsv_green_);
+    yellow_pixel_num = count(classifier_->min_hsv_yellow_, classifier_->max_hsv_yellow_);
+    red_pixel_num = count(classifier_->min_hsv_red_, classifier_->max_hsv_red_);
+  }
+
+  void countColorPixels(
+    const cv::Mat & input_image, int & green_pixel_num, int & yellow_pixel_num,
+    int & red_pixel_num) const
+  {
+    classifier_->countColorPixels(input_image, green_pixel_num, yellow_pixel_num, red_pixel_num);
+  }
+
+  bool classify(
+    const cv::Mat & input_image,
+    autoware_auto_perception_msgs::msg::TrafficSignal & traffic_signal) const
+  {
+    return classifier_->classify(input_image, traffic_signal);
+  }
+
+  autoware_auto_perception_msgs::msg::TrafficLight createTrafficLight(
+    const int green_pixel_num, const int yellow_pixel_num, const int red_pixel_num,
+    const int pixel_num) const
+  {
+    return classifier_->createTrafficLight(
+      green_pixel_num, yellow_pixel_num, red_pixel_num, pixel_num);
+  }
+
+  // a color drawn from the HSV range, converted back to BGR
+  cv::Vec3b sampleColor(cv::RNG & rng, const cv::Scalar & min_hsv, const cv::Scalar & max_hsv) const
+  {
+    cv::Mat hsv(1, 1, CV_8UC3);
+    for (int i = 0; i < 3; ++i) {
+      const int value = rng.uniform(static_cast<int>(min_hsv[i]), static_cast<int>(max_hsv[i]) + 1);
+      hsv.at<cv::Vec3b>(0, 0)[i] = static_cast<uchar>(value);
+    }
+    cv::Mat bgr;
+    cv::cvtColor(hsv, bgr, cv::COLOR_HSV2BGR);
+    return bgr.at<cv::Vec3b>(0, 0);
+  }
+
+  // random noise with rectangles of the traffic light colors and of random colors
+  cv::Mat createScene(cv::RNG & rng, const int size) const
+  {
+    cv::Mat scene(size, size, CV_8UC3);
+    rng.fill(scene, cv::RNG::UNIFORM, 0, 256);
+    const std::vector<std::pair<cv::Scalar, cv::Scalar>> hsv_ranges{
+      {classifier_->min_hsv_green_, classifier_->max_hsv_green_},
+      {classifier_->min_hsv_yellow_, classifier_->max_hsv_yellow_},
+      {classifier_->min_hsv_red_, classifier_->max_hsv_red_}};
+    for (int i = 0; i < 12; ++i) {
+      const int x = rng.uniform(0, size);
+      const int y = rng.uniform(0, size);
+      const cv::Rect rect(x, y, rng.uniform(1, size - x + 1), rng.uniform(1, size - y + 1));
+      cv::Vec3b color(rng.uniform(0, 256), rng.uniform(0, 256), rng.uniform(0, 256));
+      if (i % 4 != 3) {
+        const auto & hsv_range = hsv_ranges.at(i % 4);
+        color = sampleColor(rng, hsv_range.first, hsv_range.second);
+      }
+      scene(rect).setTo(cv::Scalar(color[0], color[1], color[2]));
+    }
+    return scene;
+  }
+
+  rclcpp::Node::SharedPtr node_;
+  std::unique_ptr<ColorClassifier> classifier_;
+};
+}  // namespace traffic_light
+
+using traffic_light::ColorClassifierTest;
+
+TEST_F(ColorClassifierTest, classifyRandomROIs)
+{
+  constexpr int scene_size = 48;
+  cv::RNG rng(0);
+  const cv::Mat scene = createScene(rng, scene_size);
+
+  int total_pixel_num = 0;
+  for (int i = 0; i < 500; ++i) {
+    // the ROIs are views of the scene, i.e. not continuous, and include 1 pixel wide, 1 pixel
+    // tall and 1 pixel images
+    int width = rng.uniform(1, scene_size + 1);
+    int height = rng.uniform(1, scene_size + 1);
+    if (i % 5 == 1) {
+      width = 1;
+    } else if (i % 5 == 2) {
+      height = 1;
+    } else if (i % 25 == 3) {
+      width = 1;
+      height = 1;
+    }
+    const cv::Rect rect(
+      rng.uniform(0, scene_size - width + 1), rng.uniform(0, scene_size - height + 1), width,
+      height);
+    const cv::Mat roi = scene(rect);
+
+    int expected_green = 0;
+    int expected_yellow = 0;
+    int expected_red = 0;
+    countColorPixelsByOpenCV(roi, expected_green, expected_yellow, expected_red);
+    int green = -1;
+    int yellow = -1;
+    int red = -1;
+    countColorPixels(roi, green, yellow, red);
+    EXPECT_EQ(green, expected_green) << "roi: " << rect;
+    EXPECT_EQ(yellow, expected_yellow) << "roi: " << rect;
+    EXPECT_EQ(red, expected_red) << "roi: " << rect;
+    total_pixel_num += expected_green + expected_yellow + expected_red;
+
+    autoware_auto_perception_msgs::msg::TrafficSignal traffic_signal;
+    ASSERT_TRUE(classify(roi, traffic_signal));
+    ASSERT_EQ(traffic_signal.lights.size(), 1u);
+    const auto expected_light =
+      createTrafficLight(expected_green, expected_yellow, expected_red, width * height);
+    EXPECT_EQ(traffic_signal.lights.front().color, expected_light.color) << "roi: " << rect;
+    EXPECT_FLOAT_EQ(traffic_signal.lights.front().confidence, expected_light.confidence);
+  }
+  // the scene has pixels of the traffic light colors left after the noise filter
+  EXPECT_GT(total_pixel_num, 0);
+}
+
+TEST_F(ColorClassifierTest, classifyInvalidImage)
+{
+  autoware_auto_perception_msgs::msg::TrafficSignal traffic_signal;
+  EXPECT_FALSE(classify(cv::Mat(4, 4, CV_8UC1, cv::Scalar(0)), traffic_signal));
+  EXPECT_TRUE(traffic_signal.lights.empty());
+}
@@ -14,6 +14,8 @@
 
 #include <trt_common.hpp>
 
+#include <tensorrt_common/engine_cache.hpp>
+
 #if (defined(_MSC_VER) or (defined(__GNUC__) and (7 <= __GNUC_MAJOR__)))
 #include <filesystem>
 namespace fs = ::std::filesystem;
@@ -38,14 +40,16 @@ void check_error(const ::cudaError_t e, decltype(__FILE__) f, decltype(__LINE__)
 }
 
 TrtCommon::TrtCommon(
-  std::string model_path, std::string precision, std::string input_name, std::string output_name)
+  std::string model_path, std::string precision, std::string input_name, std::string output_name,
+  int max_batch_size)
 : model_file_path_(model_path),
   precision_(precision),
   input_name_(input_name),
   output_name_(output_name),
+  max_batch_size_(max_batch_size),
+  is_dynamic_batch_(false),
   is_initialized_(false)
 {
-  runtime_ = UniquePtr<nvinfer1::IRuntime>(nvinfer1::createInferRuntime(logger_));
 }
 
 void TrtCommon::setup()
@@ -59,6 +63,9 @@ void TrtCommon::setup()
     } else if (extension == ".onnx") {
       fs::path cache_engine_path{model_file_path_};
       cache_engine_path.replace_extension("engine");
+      // another node of this process may be building the same engine
+      const auto build_lock =
+        tensorrt_common::EngineCache::getInstance().lockBuild(cache_engine_path.string());
       if (fs::exists(cache_engine_path)) {
         loadEngine(cache_engine_path.string());
       } else {
@@ -74,6 +81,10 @@ void TrtCommon::setup()
     is_initialized_ = false;
     return;
   }
+  if (!engine_) {
+    is_initialized_ = false;
+    return;
+  }
 
   context_ = UniquePtr<nvinfer1::IExecutionContext>(engine_->createExecutionContext());
 
@@ -86,18 +97,26 @@ void TrtCommon::setup()
   output_dims_ = engine_->getBindingDimensions(engine_->getBindingIndex(output_name_.c_str()));
 #endif
 
+  // a cached engine keeps the batch size it was built with
+  is_dynamic_batch_ = input_dims_.d[0] < 0;
+  if (is_dynamic_batch_) {
+    max_batch_size_ =
+      engine_
+        ->getProfileDimensions(
+          engine_->getBindingIndex(input_name_.c_str()), 0, nvinfer1::OptProfileSelector::kMAX)
+        .d[0];
+  } else {
+    max_batch_size_ = input_dims_.d[0];
+  }
+
   is_initialized_ = true;
 }
 
 bool TrtCommon::loadEngine(std::string engine_file_path)
 {
-  std::ifstream engine_file(engine_file_path);
-  std::stringstream engine_buffer;
-  engine_buffer << engine_file.rdbuf();
-  std::string engine_str = engine_buffer.str();
-  engine_ = UniquePtr<nvinfer1::ICudaEngine>(runtime_->deserializeCudaEngine(
-    reinterpret_cast<const void *>(engine_str.data()), engine_str.size()));
-  return true;
+  // shared with the other nodes of this process loading the same engine file
+  engine_ = tensorrt_common::EngineCache::getInstance().load(engine_file_path);
+  return engine_ != nullptr;
 }
 
 bool TrtCommon::buildEngineFromOnnx(std::string onnx_file_path, std::string output_engine_file_path)
@@ -114,6 +133,19 @@ bool TrtCommon::buildEngineFromOnnx(std::string onnx_file_path, std::string outp
     return false;
   }
 
+  // a model taking any number of images is built for up to max_batch_size_ of them
+  const auto input = network->getInput(0);
+  nvinfer1::Dims input_dims = input->getDimensions();
+  if (input_dims.d[0] < 0) {
+    auto profile = builder->createOptimizationProfile();
+    input_dims.d[0] = 1;
+    profile->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kMIN, input_dims);
+    input_dims.d[0] = max_batch_size_;
+    profile->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kOPT, input_dims);
+    profile->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kMAX, input_dims);
+    config->addOptimizationProfile(profile);
+  }
+
 #if (NV_TENSORRT_MAJOR * 1000) + (NV_TENSORRT_MINOR * 100) + NV_TENSOR_PATCH >= 8400
   config->setMemoryPoolLimit(nvinfer1::MemoryPoolType::kWORKSPACE, 16 << 20);
 #else
@@ -132,8 +164,8 @@ bool TrtCommon::buildEngineFromOnnx(std::string onnx_file_path, std::string outp
   if (!plan) {
     return false;
   }
-  engine_ =
-    UniquePtr<nvinfer1::ICudaEngine>(runtime_->deserializeCudaEngine(plan->data(), plan->size()));
+  auto & engine_cache = tensorrt_common::EngineCache::getInstance();
+  engine_ = engine_cache.deserialize(plan->data(), plan->size());
   if (!engine_) {
     return false;
   }
@@ -146,6 +178,7 @@ bool TrtCommon::buildEngineFromOnnx(std::string onnx_file_path, std::string outp
   }
   file.write((const char *)plan->data(), plan->size());
   file.close();
+  engine_cache.add(output_engine_file_path, engine_);
 
   return true;
 }
@@ -155,13 +188,28 @@ bool TrtCommon::isInitialized() { return is_initialized_; }
 int TrtCommon::getNumInput()
 {
   return std::accumulate(
-    input_dims_.d, input_dims_.d + input_dims_.nbDims, 1, std::multiplies<int>());
+    input_dims_.d + 1, input_dims_.d + input_dims_.nbDims, 1, std::multiplies<int>());
 }
 
 int TrtCommon::getNumOutput()
 {
   return std::accumulate(
-    output_dims_.d, output_dims_.d + output_dims_.nbDims, 1, std::multiplies<int>());
+    output_dims_.d + 1, output_dims_.d + output_dims_.nbDims, 1, std::multiplies<int>());
+}
+
+int TrtCommon::getMaxBatchSize() { return max_batch_size_; }
+
+bool TrtCommon::setBatchSize(int batch_size)
+{
+  if (batch_size < 1 || max_batch_size_ < batch_size) {
+    return false;
+  }
+  if (!is_dynamic_batch_) {
+    return true;
+  }
+  nvinfer1::Dims input_dims = input_dims_;
+  input_dims.d[0] = batch_size;
+  return context_->setBindingDimensions(engine_->getBindingIndex(input_name_.c_str()), input_dims);
 }
 
 }  // namespace Tn
@@ -109,7 +109,8 @@ class TrtCommon
 {
 public:
   TrtCommon(
-    std::string model_path, std::string precision, std::string input_name, std::string output_name);
+    std::string model_path, std::string precision, std::string input_name, std::string output_name,
+    int max_batch_size = 1);
   ~TrtCommon() {}
 
   bool loadEngine(std::string engine_file_path);
@@ -117,16 +118,21 @@ public:
   void setup();
 
   bool isInitialized();
+  // the sizes of one image of a batch
   int getNumInput();
   int getNumOutput();
+  // the number of images an execution can take
+  int getMaxBatchSize();
+  // the engine of a model with a dynamic batch size is executed on batch_size images,
+  // the one of a model with a fixed batch size always takes getMaxBatchSize() images
+  bool setBatchSize(int batch_size);
 
   UniquePtr<nvinfer1::IExecutionContext> context_;
 
 private:
   Logger logger_;
   std::string model_file_path_;
-  UniquePtr<nvinfer1::IRuntime> runtime_;
-  UniquePtr<nvinfer1::ICudaEngine> engine_;
+  std::shared_ptr<nvinfer1::ICudaEngine> engine_;
 
   nvinfer1::Dims input_dims_;
   nvinfer1::Dims output_dims_;
@@ -134,6 +140,8 @@ private:
   std::string precision_;
   std::string input_name_;
   std::string output_name_;
+  int max_batch_size_;
+  bool is_dynamic_batch_;
   bool is_initialized_;
 };
 
@@ -36,6 +36,7 @@
 #include <lanelet2_extension/regulatory_elements/autoware_traffic_light.hpp>
 #include <lanelet2_extension/utility/query.hpp>
 #include <rclcpp/rclcpp.hpp>
+#include <tier4_autoware_utils/geometry/boost_geometry.hpp>
 
 #include <autoware_auto_mapping_msgs/msg/had_map_bin.hpp>
 #include <autoware_auto_perception_msgs/msg/traffic_light_roi_array.hpp>
@@ -48,11 +49,15 @@
 #include <lanelet2_core/LaneletMap.h>
 #include <lanelet2_routing/RoutingGraph.h>
 #include <lanelet2_traffic_rules/TrafficRulesFactory.h>
+#include <tf2/LinearMath/Transform.h>
 #include <tf2_ros/buffer.h>
 #include <tf2_ros/transform_listener.h>
 
+#include <boost/geometry/index/rtree.hpp>
+
 #include <memory>
 #include <set>
+#include <utility>
 #include <vector>
 
 namespace traffic_light
@@ -94,8 +99,20 @@ private:
 
   using TrafficLightSet = std::set<lanelet::ConstLineString3d, IdLessThan>;
 
-  std::shared_ptr<TrafficLightSet> all_traffic_lights_ptr_;
-  std::shared_ptr<TrafficLightSet> route_traffic_lights_ptr_;
+  // The real traffic lights of a set in the id order, with what the visibility check needs of
+  // them, and an rtree of their central points to query the ones around a camera.
+  struct TrafficLightIndex
+  {
+    using Value = std::pair<tier4_autoware_utils::Point2d, std::size_t>;
+
+    std::vector<lanelet::ConstLineString3d> traffic_lights;
+    std::vector<geometry_msgs::msg::Point> central_points;
+    std::vector<double> yaws;
+    boost::geometry::index::rtree<Value, boost::geometry::index::rstar<16>> rtree;
+  };
+
+  std::shared_ptr<TrafficLightIndex> all_traffic_lights_ptr_;
+  std::shared_ptr<TrafficLightIndex> route_traffic_lights_ptr_;
 
   lanelet::LaneletMapPtr lanelet_map_ptr_;
   lanelet::traffic_rules::TrafficRulesPtr traffic_rules_ptr_;
@@ -105,8 +122,11 @@ private:
   void mapCallback(const autoware_auto_mapping_msgs::msg::HADMapBin::ConstSharedPtr input_msg);
   void cameraInfoCallback(const sensor_msgs::msg::CameraInfo::ConstSharedPtr input_msg);
   void routeCallback(const autoware_planning_msgs::msg::LaneletRoute::ConstSharedPtr input_msg);
+  static std::shared_ptr<TrafficLightIndex> createTrafficLightIndex(
+    const TrafficLightSet & traffic_lights);
   void getVisibleTrafficLights(
-    const TrafficLightSet & all_traffic_lights, const geometry_msgs::msg::Pose & camera_pose,
+    const TrafficLightIndex & traffic_light_index, const geometry_msgs::msg::Pose & camera_pose,
+    const tf2::Transform & tf_camera2map,
     const image_geometry::PinholeCameraModel & pinhole_camera_model,
     std::vector<lanelet::ConstLineString3d> & visible_traffic_lights);
   bool isInDistanceRange(
@@ -118,7 +138,7 @@ private:
     const image_geometry::PinholeCameraModel & pinhole_camera_model,
     const geometry_msgs::msg::Point & point) const;
   bool getTrafficLightRoi(
-    const geometry_msgs::msg::Pose & camera_pose,
+    const tf2::Transform & tf_camera2map,
     const image_geometry::PinholeCameraModel & pinhole_camera_model,
     const lanelet::ConstLineString3d traffic_light, const Config & config,
     autoware_auto_perception_msgs::msg::TrafficLightRoi & tl_roi);
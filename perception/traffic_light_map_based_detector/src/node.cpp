@@ -50,6 +50,7 @@
 #include <tf2/LinearMath/Transform.h>
 
 #include <algorithm>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <vector>
@@ -146,6 +147,14 @@ void MapBasedDetector::cameraInfoCallback(
       get_logger(), *get_clock(), 5000, "cannot get transform from map frame to camera frame");
     return;
   }
+  const auto & camera_orientation = camera_pose_stamped.pose.orientation;
+  const auto & camera_position = camera_pose_stamped.pose.position;
+  const tf2::Transform tf_camera2map =
+    tf2::Transform(
+      tf2::Quaternion(
+        camera_orientation.x, camera_orientation.y, camera_orientation.z, camera_orientation.w),
+      tf2::Vector3(camera_position.x, camera_position.y, camera_position.z))
+      .inverse();
 
   /*
    * visible_traffic_lights : for each traffic light in map check if in range and in view angle of
@@ -155,12 +164,12 @@ void MapBasedDetector::cameraInfoCallback(
   // If get a route, use only traffic lights on the route.
   if (route_traffic_lights_ptr_ != nullptr) {
     getVisibleTrafficLights(
-      *route_traffic_lights_ptr_, camera_pose_stamped.pose, pinhole_camera_model,
+      *route_traffic_lights_ptr_, camera_pose_stamped.pose, tf_camera2map, pinhole_camera_model,
       visible_traffic_lights);
     // If don't get a route, use the traffic lights around ego vehicle.
   } else if (all_traffic_lights_ptr_ != nullptr) {
     getVisibleTrafficLights(
-      *all_traffic_lights_ptr_, camera_pose_stamped.pose, pinhole_camera_model,
+      *all_traffic_lights_ptr_, camera_pose_stamped.pose, tf_camera2map, pinhole_camera_model,
       visible_traffic_lights);
     // This shouldn't run.
   } else {
@@ -173,8 +182,7 @@ void MapBasedDetector::cameraInfoCallback(
    */
   for (const auto & traffic_light : visible_traffic_lights) {
     autoware_auto_perception_msgs::msg::TrafficLightRoi tl_roi;
-    if (!getTrafficLightRoi(
-          camera_pose_stamped.pose, pinhole_camera_model, traffic_light, config_, tl_roi)) {
+    if (!getTrafficLightRoi(tf_camera2map, pinhole_camera_model, traffic_light, config_, tl_roi)) {
       continue;
     }
     output_msg.rois.push_back(tl_roi);
@@ -184,7 +192,7 @@ void MapBasedDetector::cameraInfoCallback(
 }
 
 bool MapBasedDetector::getTrafficLightRoi(
-  const geometry_msgs::msg::Pose & camera_pose,
+  const tf2::Transform & tf_camera2map,
   const image_geometry::PinholeCameraModel & pinhole_camera_model,
   const lanelet::ConstLineString3d traffic_light, const Config & config,
   autoware_auto_perception_msgs::msg::TrafficLightRoi & tl_roi)
@@ -193,11 +201,6 @@ bool MapBasedDetector::getTrafficLightRoi(
   const auto & tl_left_down_point = traffic_light.front();
   const auto & tl_right_down_point = traffic_light.back();
 
-  tf2::Transform tf_map2camera(
-    tf2::Quaternion(
-      camera_pose.orientation.x, camera_pose.orientation.y, camera_pose.orientation.z,
-      camera_pose.orientation.w),
-    tf2::Vector3(camera_pose.position.x, camera_pose.position.y, camera_pose.position.z));
   // id
   tl_roi.id = traffic_light.id();
 
@@ -208,7 +211,7 @@ bool MapBasedDetector::getTrafficLightRoi(
       tf2::Vector3(
         tl_left_down_point.x(), tl_left_down_point.y(), tl_left_down_point.z() + tl_height));
     tf2::Transform tf_camera2tl;
-    tf_camera2tl = tf_map2camera.inverse() * tf_map2tl;
+    tf_camera2tl = tf_camera2map * tf_map2tl;
     // max vibration
     const double max_vibration_x =
       std::sin(config.max_vibration_yaw * 0.5) * tf_camera2tl.getOrigin().z() +
@@ -237,7 +240,7 @@ bool MapBasedDetector::getTrafficLightRoi(
       tf2::Quaternion(0, 0, 0, 1),
       tf2::Vector3(tl_right_down_point.x(), tl_right_down_point.y(), tl_right_down_point.z()));
     tf2::Transform tf_camera2tl;
-    tf_camera2tl = tf_map2camera.inverse() * tf_map2tl;
+    tf_camera2tl = tf_camera2map * tf_map2tl;
     // max vibration
     const double max_vibration_x =
       std::sin(config.max_vibration_yaw * 0.5) * tf_camera2tl.getOrigin().z() +
@@ -274,7 +277,7 @@ void MapBasedDetector::mapCallback(
   lanelet::ConstLanelets all_lanelets = lanelet::utils::query::laneletLayer(lanelet_map_ptr_);
   std::vector<lanelet::AutowareTrafficLightConstPtr> all_lanelet_traffic_lights =
     lanelet::utils::query::autowareTrafficLights(all_lanelets);
-  all_traffic_lights_ptr_ = std::make_shared<MapBasedDetector::TrafficLightSet>();
+  MapBasedDetector::TrafficLightSet all_traffic_lights;
   for (auto tl_itr = all_lanelet_traffic_lights.begin(); tl_itr != all_lanelet_traffic_lights.end();
        ++tl_itr) {
     lanelet::AutowareTrafficLightConstPtr tl = *tl_itr;
@@ -284,9 +287,10 @@ void MapBasedDetector::mapCallback(
       if (!lsp.isLineString()) {  // traffic lights must be linestrings
         continue;
       }
-      all_traffic_lights_ptr_->insert(static_cast<lanelet::ConstLineString3d>(lsp));
+      all_traffic_lights.insert(static_cast<lanelet::ConstLineString3d>(lsp));
     }
   }
+  all_traffic_lights_ptr_ = createTrafficLightIndex(all_traffic_lights);
 }
 
 void MapBasedDetector::routeCallback(
@@ -309,7 +313,7 @@ void MapBasedDetector::routeCallback(
   }
   std::vector<lanelet::AutowareTrafficLightConstPtr> route_lanelet_traffic_lights =
     lanelet::utils::query::autowareTrafficLights(route_lanelets);
-  route_traffic_lights_ptr_ = std::make_shared<MapBasedDetector::TrafficLightSet>();
+  MapBasedDetector::TrafficLightSet route_traffic_lights;
   for (auto tl_itr = route_lanelet_traffic_lights.begin();
        tl_itr != route_lanelet_traffic_lights.end(); ++tl_itr) {
     lanelet::AutowareTrafficLightConstPtr tl = *tl_itr;
@@ -319,18 +323,18 @@ void MapBasedDetector::routeCallback(
       if (!lsp.isLineString()) {  // traffic lights must be linestrings
         continue;
       }
-      route_traffic_lights_ptr_->insert(static_cast<lanelet::ConstLineString3d>(lsp));
+      route_traffic_lights.insert(static_cast<lanelet::ConstLineString3d>(lsp));
     }
   }
+  route_traffic_lights_ptr_ = createTrafficLightIndex(route_traffic_lights);
 }
 
-void MapBasedDetector::getVisibleTrafficLights(
-  const MapBasedDetector::TrafficLightSet & all_traffic_lights,
-  const geometry_msgs::msg::Pose & camera_pose,
-  const image_geometry::PinholeCameraModel & pinhole_camera_model,
-  std::vector<lanelet::ConstLineString3d> & visible_traffic_lights)
+std::shared_ptr<MapBasedDetector::TrafficLightIndex> MapBasedDetector::createTrafficLightIndex(
+  const MapBasedDetector::TrafficLightSet & traffic_lights)
 {
-  for (const auto & traffic_light : all_traffic_lights) {
+  auto traffic_light_index = std::make_shared<TrafficLightIndex>();
+  std::vector<TrafficLightIndex::Value> rtree_values;
+  for (const auto & traffic_light : traffic_lights) {
     // some "Traffic Light" are actually not traffic lights
     if (
       traffic_light.hasAttribute("subtype") == false ||
@@ -341,47 +345,79 @@ void MapBasedDetector::getVisibleTrafficLights(
     const auto & tl_right_down_point = traffic_light.back();
     const double tl_height = traffic_light.attributeOr("height", 0.0);
 
-    // check distance range
     geometry_msgs::msg::Point tl_central_point;
     tl_central_point.x = (tl_right_down_point.x() + tl_left_down_point.x()) / 2.0;
     tl_central_point.y = (tl_right_down_point.y() + tl_left_down_point.y()) / 2.0;
     tl_central_point.z = (tl_right_down_point.z() + tl_left_down_point.z() + tl_height) / 2.0;
-    constexpr double max_distance_range = 200.0;
-    if (!isInDistanceRange(tl_central_point, camera_pose.position, max_distance_range)) {
-      continue;
-    }
-
-    // check angle range
     const double tl_yaw = tier4_autoware_utils::normalizeRadian(
       std::atan2(
         tl_right_down_point.y() - tl_left_down_point.y(),
         tl_right_down_point.x() - tl_left_down_point.x()) +
       M_PI_2);
-    constexpr double max_angle_range = tier4_autoware_utils::deg2rad(40.0);
 
-    // get direction of z axis
-    tf2::Vector3 camera_z_dir(0, 0, 1);
-    tf2::Matrix3x3 camera_rotation_matrix(tf2::Quaternion(
-      camera_pose.orientation.x, camera_pose.orientation.y, camera_pose.orientation.z,
-      camera_pose.orientation.w));
-    camera_z_dir = camera_rotation_matrix * camera_z_dir;
-    double camera_yaw = std::atan2(camera_z_dir.y(), camera_z_dir.x());
-    camera_yaw = tier4_autoware_utils::normalizeRadian(camera_yaw);
-    if (!isInAngleRange(tl_yaw, camera_yaw, max_angle_range)) {
+    rtree_values.emplace_back(
+      tier4_autoware_utils::Point2d(tl_central_point.x, tl_central_point.y),
+      traffic_light_index->traffic_lights.size());
+    traffic_light_index->traffic_lights.push_back(traffic_light);
+    traffic_light_index->central_points.push_back(tl_central_point);
+    traffic_light_index->yaws.push_back(tl_yaw);
+  }
+  // packing construction
+  traffic_light_index->rtree = decltype(traffic_light_index->rtree)(rtree_values);
+  return traffic_light_index;
+}
+
+void MapBasedDetector::getVisibleTrafficLights(
+  const MapBasedDetector::TrafficLightIndex & traffic_light_index,
+  const geometry_msgs::msg::Pose & camera_pose, const tf2::Transform & tf_camera2map,
+  const image_geometry::PinholeCameraModel & pinhole_camera_model,
+  std::vector<lanelet::ConstLineString3d> & visible_traffic_lights)
+{
+  // get direction of z axis
+  tf2::Vector3 camera_z_dir(0, 0, 1);
+  tf2::Matrix3x3 camera_rotation_matrix(tf2::Quaternion(
+    camera_pose.orientation.x, camera_pose.orientation.y, camera_pose.orientation.z,
+    camera_pose.orientation.w));
+  camera_z_dir = camera_rotation_matrix * camera_z_dir;
+  double camera_yaw = std::atan2(camera_z_dir.y(), camera_z_dir.x());
+  camera_yaw = tier4_autoware_utils::normalizeRadian(camera_yaw);
+
+  // only the traffic lights in the square around the camera can be in the distance range
+  constexpr double max_distance_range = 200.0;
+  const tier4_autoware_utils::Box2d search_box(
+    tier4_autoware_utils::Point2d(
+      camera_pose.position.x - max_distance_range, camera_pose.position.y - max_distance_range),
+    tier4_autoware_utils::Point2d(
+      camera_pose.position.x + max_distance_range, camera_pose.position.y + max_distance_range));
+  std::vector<TrafficLightIndex::Value> candidates;
+  traffic_light_index.rtree.query(
+    boost::geometry::index::intersects(search_box), std::back_inserter(candidates));
+  // keep the id order of the traffic lights
+  std::sort(candidates.begin(), candidates.end(), [](const auto & a, const auto & b) {
+    return a.second < b.second;
+  });
+
+  for (const auto & candidate : candidates) {
+    const std::size_t i = candidate.second;
+    const auto & tl_central_point = traffic_light_index.central_points[i];
+
+    // check distance range
+    if (!isInDistanceRange(tl_central_point, camera_pose.position, max_distance_range)) {
+      continue;
+    }
+
+    // check angle range
+    constexpr double max_angle_range = tier4_autoware_utils::deg2rad(40.0);
+    if (!isInAngleRange(traffic_light_index.yaws[i], camera_yaw, max_angle_range)) {
       continue;
     }
 
     // check within image frame
-    tf2::Transform tf_map2camera(
-      tf2::Quaternion(
-        camera_pose.orientation.x, camera_pose.orientation.y, camera_pose.orientation.z,
-        camera_pose.orientation.w),
-      tf2::Vector3(camera_pose.position.x, camera_pose.position.y, camera_pose.position.z));
     tf2::Transform tf_map2tl(
       tf2::Quaternion(0, 0, 0, 1),
       tf2::Vector3(tl_central_point.x, tl_central_point.y, tl_central_point.z));
     tf2::Transform tf_camera2tl;
-    tf_camera2tl = tf_map2camera.inverse() * tf_map2tl;
+    tf_camera2tl = tf_camera2map * tf_map2tl;
 
     geometry_msgs::msg::Point camera2tl_point;
     camera2tl_point.x = tf_camera2tl.getOrigin().x();
@@ -390,7 +426,7 @@ void MapBasedDetector::getVisibleTrafficLights(
     if (!isInImageFrame(pinhole_camera_model, camera2tl_point)) {
       continue;
     }
-    visible_traffic_lights.push_back(traffic_light);
+    visible_traffic_lights.push_back(traffic_light_index.traffic_lights[i]);
   }
 }
 
@@ -436,6 +472,15 @@ void MapBasedDetector::publishVisibleTrafficLights(
   const rclcpp::Publisher<visualization_msgs::msg::MarkerArray>::SharedPtr pub)
 {
   visualization_msgs::msg::MarkerArray output_msg;
+  const tf2::Transform tf_camera2map =
+    tf2::Transform(
+      tf2::Quaternion(
+        camera_pose_stamped.pose.orientation.x, camera_pose_stamped.pose.orientation.y,
+        camera_pose_stamped.pose.orientation.z, camera_pose_stamped.pose.orientation.w),
+      tf2::Vector3(
+        camera_pose_stamped.pose.position.x, camera_pose_stamped.pose.position.y,
+        camera_pose_stamped.pose.position.z))
+      .inverse();
   for (const auto & traffic_light : visible_traffic_lights) {
     const auto & tl_left_down_point = traffic_light.front();
     const auto & tl_right_down_point = traffic_light.back();
@@ -449,18 +494,11 @@ void MapBasedDetector::publishVisibleTrafficLights(
 
     visualization_msgs::msg::Marker marker;
 
-    tf2::Transform tf_map2camera(
-      tf2::Quaternion(
-        camera_pose_stamped.pose.orientation.x, camera_pose_stamped.pose.orientation.y,
-        camera_pose_stamped.pose.orientation.z, camera_pose_stamped.pose.orientation.w),
-      tf2::Vector3(
-        camera_pose_stamped.pose.position.x, camera_pose_stamped.pose.position.y,
-        camera_pose_stamped.pose.position.z));
     tf2::Transform tf_map2tl(
       tf2::Quaternion(0, 0, 0, 1),
       tf2::Vector3(tl_central_point.x, tl_central_point.y, tl_central_point.z));
     tf2::Transform tf_camera2tl;
-    tf_camera2tl = tf_map2camera.inverse() * tf_map2tl;
+    tf_camera2tl = tf_camera2map * tf_map2tl;
 
     marker.header = camera_pose_stamped.header;
     marker.id = id;
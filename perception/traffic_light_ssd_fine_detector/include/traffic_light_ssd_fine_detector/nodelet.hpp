@@ -15,12 +15,14 @@
 #ifndef TRAFFIC_LIGHT_SSD_FINE_DETECTOR__NODELET_HPP_
 #define TRAFFIC_LIGHT_SSD_FINE_DETECTOR__NODELET_HPP_
 
+#include <cuda_utils.hpp>
 #include <image_transport/image_transport.hpp>
 #include <image_transport/subscriber_filter.hpp>
 #include <opencv2/core/core.hpp>
 #include <opencv2/highgui/highgui.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <trt_ssd.hpp>
+#include <trt_ssd_preprocess.hpp>
 
 #include <autoware_auto_perception_msgs/msg/traffic_light_roi_array.hpp>
 #include <sensor_msgs/image_encodings.hpp>
@@ -58,11 +60,18 @@ public:
       traffic_light_roi_msg);
 
 private:
-  bool cvMat2CnnInput(
-    const std::vector<cv::Mat> & in_imgs, const int num_rois, std::vector<float> & data);
+  // crop, resize and normalize the ROIs on the device and run all the batches before waiting
+  bool detect(
+    const sensor_msgs::msg::Image::ConstSharedPtr image_msg, const std::vector<cv::Point> & lts,
+    const std::vector<cv::Size> & roi_sizes, std::vector<Detection> & detections);
+  // copy the image to the device asynchronously, through a pinned buffer
+  bool uploadImage(const sensor_msgs::msg::Image::ConstSharedPtr image_msg);
+  // grow the buffers holding values for every ROI of a frame
+  void reserveRois(const size_t num_rois);
   bool cnnOutput2BoxDetection(
     const float * scores, const float * boxes, const int tlr_id,
-    const std::vector<cv::Mat> & in_imgs, const int num_rois, std::vector<Detection> & detections);
+    const std::vector<cv::Size> & roi_sizes, const int num_rois,
+    std::vector<Detection> & detections);
   bool rosMsg2CvMat(const sensor_msgs::msg::Image::ConstSharedPtr image_msg, cv::Mat & image);
   bool fitInFrame(cv::Point & lt, cv::Point & rb, const cv::Size & size);
   void cvRect2TlRoiMsg(
@@ -105,6 +114,27 @@ private:
 
   std::vector<float> mean_;
   std::vector<float> std_;
+  ssd::Normalization normalization_;
+
+  // network bindings, allocated once for the max batch size
+  cuda::unique_ptr<float[]> data_d_;
+  cuda::unique_ptr<float[]> scores_d_;
+  cuda::unique_ptr<float[]> boxes_d_;
+  std::vector<void *> buffers_;
+
+  // image of the current frame, grown on demand
+  cuda::host_unique_ptr<uint8_t[]> image_h_;
+  cuda::unique_ptr<uint8_t[]> image_d_;
+  size_t image_capacity_{0};
+  int image_step_{0};
+  bool image_is_bgr_{false};
+
+  // ROIs and outputs of all the batches of a frame, grown on demand
+  cuda::host_unique_ptr<ssd::CropRoi[]> rois_h_;
+  cuda::unique_ptr<ssd::CropRoi[]> rois_d_;
+  cuda::host_unique_ptr<float[]> scores_h_;
+  cuda::host_unique_ptr<float[]> boxes_h_;
+  size_t roi_capacity_{0};
 
   std::unique_ptr<ssd::Net> net_ptr_;
 };  // TrafficLightSSDFineDetectorNodelet
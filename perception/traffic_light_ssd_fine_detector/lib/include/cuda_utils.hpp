@@ -32,7 +32,7 @@
 
 namespace cuda
 {
-void check_error(const ::cudaError_t e, decltype(__FILE__) f, decltype(__LINE__) n)
+inline void check_error(const ::cudaError_t e, decltype(__FILE__) f, decltype(__LINE__) n)
 {
   if (e != ::cudaSuccess) {
     std::stringstream s;
@@ -70,6 +70,26 @@ cuda::unique_ptr<T> make_unique()
   CHECK_CUDA_ERROR(::cudaMalloc(reinterpret_cast<void **>(&p), sizeof(T)));
   return cuda::unique_ptr<T>{p};
 }
+
+struct host_deleter
+{
+  void operator()(void * p) const { CHECK_CUDA_ERROR(::cudaFreeHost(p)); }
+};
+template <typename T>
+using host_unique_ptr = std::unique_ptr<T, host_deleter>;
+
+// Pinned host memory, which asynchronous copies require
+// auto array = cuda::make_host_unique<float[]>(n);
+// ::cudaMemcpyAsync(array.get(), src_array, sizeof(float)*n, ::cudaMemcpyDeviceToHost, stream);
+template <typename T>
+typename std::enable_if<std::is_array<T>::value, cuda::host_unique_ptr<T>>::type make_host_unique(
+  const std::size_t n)
+{
+  using U = typename std::remove_extent<T>::type;
+  U * p;
+  CHECK_CUDA_ERROR(::cudaMallocHost(reinterpret_cast<void **>(&p), sizeof(U) * n));
+  return cuda::host_unique_ptr<T>{p};
+}
 }  // namespace cuda
 
 #endif  // CUDA_UTILS_HPP_
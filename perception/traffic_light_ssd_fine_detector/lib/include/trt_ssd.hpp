@@ -74,6 +74,12 @@ public:
   // Infer using pre-allocated GPU buffers {data, scores, boxes}
   void infer(std::vector<void *> & buffers, const int batch_size);
 
+  // Enqueue the inference on getStream() without waiting for it
+  void enqueue(std::vector<void *> & buffers, const int batch_size);
+
+  // Get the stream the inference runs on
+  cudaStream_t getStream() const { return stream_; }
+
   // Get (c, h, w) size of the fixed input
   std::vector<int> getInputSize();
 
@@ -86,9 +92,8 @@ public:
   int getMaxDetections();
 
 private:
-  unique_ptr<nvinfer1::IRuntime> runtime_ = nullptr;
   unique_ptr<nvinfer1::IHostMemory> plan_ = nullptr;
-  unique_ptr<nvinfer1::ICudaEngine> engine_ = nullptr;
+  std::shared_ptr<nvinfer1::ICudaEngine> engine_ = nullptr;
   unique_ptr<nvinfer1::IExecutionContext> context_ = nullptr;
   cudaStream_t stream_ = nullptr;
 
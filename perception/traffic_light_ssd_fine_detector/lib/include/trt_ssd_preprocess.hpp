@@ -0,0 +1,47 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef TRT_SSD_PREPROCESS_HPP_
+#define TRT_SSD_PREPROCESS_HPP_
+
+#include <cuda_runtime_api.h>
+
+#include <cstdint>
+
+namespace ssd
+{
+struct CropRoi
+{
+  int x;
+  int y;
+  int width;
+  int height;
+};
+
+struct Normalization
+{
+  float mean[3];
+  float std[3];
+};
+
+// Crop every ROI, which must lie within the image, out of an 8-bit 3-channel image on the device,
+// resize it bilinearly to dst_width x dst_height and write it to dst as the planar input of the
+// network, in the layout of the former CPU preprocessing: the planes are in BGR order and
+// normalized as (value / 255 - mean[c]) / std[c]. is_bgr tells the channel order of src.
+cudaError_t cropResizeNormalize_launch(
+  const std::uint8_t * src, const int src_step, const bool is_bgr, const CropRoi * rois,
+  const int num_rois, float * dst, const int dst_width, const int dst_height,
+  const Normalization normalization, cudaStream_t stream);
+}  // namespace ssd
+
+#endif  // TRT_SSD_PREPROCESS_HPP_
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <tensorrt_common/engine_cache.hpp>
 #include <trt_ssd.hpp>
 
 #include <NvOnnxConfig.h>
@@ -27,18 +28,8 @@ namespace ssd
 {
 void Net::load(const std::string & path)
 {
-  std::ifstream file(path, std::ios::in | std::ios::binary);
-  file.seekg(0, file.end);
-  size_t size = file.tellg();
-  file.seekg(0, file.beg);
-
-  char * buffer = new char[size];
-  file.read(buffer, size);
-  file.close();
-  if (runtime_) {
-    engine_ = unique_ptr<nvinfer1::ICudaEngine>(runtime_->deserializeCudaEngine(buffer, size));
-  }
-  delete[] buffer;
+  // shared with the other nodes of this process loading the same engine file
+  engine_ = tensorrt_common::EngineCache::getInstance().load(path);
 }
 
 void Net::prepare()
@@ -49,10 +40,8 @@ void Net::prepare()
   cudaStreamCreate(&stream_);
 }
 
-Net::Net(const std::string & path, bool verbose)
+Net::Net(const std::string & path, [[maybe_unused]] bool verbose)
 {
-  Logger logger(verbose);
-  runtime_ = unique_ptr<nvinfer1::IRuntime>(nvinfer1::createInferRuntime(logger));
   load(path);
   prepare();
 }
@@ -69,11 +58,6 @@ Net::Net(
   bool verbose, size_t workspace_size)
 {
   Logger logger(verbose);
-  runtime_ = unique_ptr<nvinfer1::IRuntime>(nvinfer1::createInferRuntime(logger));
-  if (!runtime_) {
-    std::cout << "Fail to create runtime" << std::endl;
-    return;
-  }
   bool fp16 = precision.compare("FP16") == 0;
   bool int8 = precision.compare("INT8") == 0;
 
@@ -144,8 +128,7 @@ Net::Net(
     std::cout << "Fail to create serialized network" << std::endl;
     return;
   }
-  engine_ = unique_ptr<nvinfer1::ICudaEngine>(
-    runtime_->deserializeCudaEngine(plan_->data(), plan_->size()));
+  engine_ = tensorrt_common::EngineCache::getInstance().deserialize(plan_->data(), plan_->size());
   if (!engine_) {
     std::cout << "Fail to create engine" << std::endl;
     return;
@@ -155,6 +138,7 @@ Net::Net(
     std::cout << "Fail to create context" << std::endl;
     return;
   }
+  cudaStreamCreate(&stream_);
 }
 
 void Net::save(const std::string & path)
@@ -162,9 +146,16 @@ void Net::save(const std::string & path)
   std::cout << "Writing to " << path << "..." << std::endl;
   std::ofstream file(path, std::ios::out | std::ios::binary);
   file.write(reinterpret_cast<const char *>(plan_->data()), plan_->size());
+  tensorrt_common::EngineCache::getInstance().add(path, engine_);
 }
 
 void Net::infer(std::vector<void *> & buffers, const int batch_size)
+{
+  enqueue(buffers, batch_size);
+  cudaStreamSynchronize(stream_);
+}
+
+void Net::enqueue(std::vector<void *> & buffers, const int batch_size)
 {
   if (!context_) {
     throw std::runtime_error("Fail to create context");
@@ -173,7 +164,6 @@ void Net::infer(std::vector<void *> & buffers, const int batch_size)
   context_->setBindingDimensions(
     0, nvinfer1::Dims4(batch_size, input_dims.d[1], input_dims.d[2], input_dims.d[3]));
   context_->enqueueV2(buffers.data(), stream_, nullptr);
-  cudaStreamSynchronize(stream_);
 }
 
 std::vector<int> Net::getInputSize()
@@ -0,0 +1,89 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "trt_ssd_preprocess.hpp"
+
+namespace
+{
+const std::size_t THREADS_PER_BLOCK_X = 32;
+const std::size_t THREADS_PER_BLOCK_Y = 8;
+
+__global__ void cropResizeNormalize_kernel(
+  const std::uint8_t * src, const int src_step, const bool is_bgr, const ssd::CropRoi * rois,
+  float * dst, const int dst_width, const int dst_height, const ssd::Normalization normalization)
+{
+  const int x = blockIdx.x * blockDim.x + threadIdx.x;
+  const int y = blockIdx.y * blockDim.y + threadIdx.y;
+  const int n = blockIdx.z;
+  if (x >= dst_width || y >= dst_height) return;
+
+  // same sampling positions and border handling as cv::resize with cv::INTER_LINEAR
+  const ssd::CropRoi roi = rois[n];
+  const float fx = (x + 0.5f) * roi.width / dst_width - 0.5f;
+  const float fy = (y + 0.5f) * roi.height / dst_height - 0.5f;
+  int sx = static_cast<int>(floorf(fx));
+  int sy = static_cast<int>(floorf(fy));
+  float u = fx - sx;
+  float v = fy - sy;
+  if (sx < 0) {
+    sx = 0;
+    u = 0.0f;
+  }
+  if (sx >= roi.width - 1) {
+    sx = roi.width - 1;
+    u = 0.0f;
+  }
+  if (sy < 0) {
+    sy = 0;
+    v = 0.0f;
+  }
+  if (sy >= roi.height - 1) {
+    sy = roi.height - 1;
+    v = 0.0f;
+  }
+  const int sx1 = min(sx + 1, roi.width - 1);
+  const int sy1 = min(sy + 1, roi.height - 1);
+
+  const std::uint8_t * row0 = src + static_cast<std::size_t>(roi.y + sy) * src_step + roi.x * 3;
+  const std::uint8_t * row1 = src + static_cast<std::size_t>(roi.y + sy1) * src_step + roi.x * 3;
+  const std::size_t plane_size = static_cast<std::size_t>(dst_width) * dst_height;
+  float * dst_pixel = dst + n * 3 * plane_size + static_cast<std::size_t>(y) * dst_width + x;
+  for (int c = 0; c < 3; ++c) {
+    // the planes of the network are in BGR order
+    const int src_c = is_bgr ? c : 2 - c;
+    const float top = row0[sx * 3 + src_c] * (1.0f - u) + row0[sx1 * 3 + src_c] * u;
+    const float bottom = row1[sx * 3 + src_c] * (1.0f - u) + row1[sx1 * 3 + src_c] * u;
+    // the CPU path resizes into an 8-bit image, so round alike
+    const float value = rintf(top * (1.0f - v) + bottom * v);
+    dst_pixel[c * plane_size] = (value / 255.0f - normalization.mean[c]) / normalization.std[c];
+  }
+}
+}  // namespace
+
+namespace ssd
+{
+cudaError_t cropResizeNormalize_launch(
+  const std::uint8_t * src, const int src_step, const bool is_bgr, const CropRoi * rois,
+  const int num_rois, float * dst, const int dst_width, const int dst_height,
+  const Normalization normalization, cudaStream_t stream)
+{
+  if (num_rois == 0) return cudaSuccess;
+  dim3 threads(THREADS_PER_BLOCK_X, THREADS_PER_BLOCK_Y);
+  dim3 blocks(
+    (dst_width + THREADS_PER_BLOCK_X - 1) / THREADS_PER_BLOCK_X,
+    (dst_height + THREADS_PER_BLOCK_Y - 1) / THREADS_PER_BLOCK_Y, num_rois);
+  cropResizeNormalize_kernel<<<blocks, threads, 0, stream>>>(
+    src, src_step, is_bgr, rois, dst, dst_width, dst_height, normalization);
+  return cudaGetLastError();
+}
+}  // namespace ssd
@@ -15,6 +15,7 @@
 #include "traffic_light_ssd_fine_detector/nodelet.hpp"
 
 #include <cuda_utils.hpp>
+#include <tensorrt_common/engine_cache.hpp>
 
 #if (defined(_MSC_VER) or (defined(__GNUC__) and (7 <= __GNUC_MAJOR__)))
 #include <filesystem>
@@ -24,6 +25,8 @@ namespace fs = ::std::filesystem;
 namespace fs = ::std::experimental::filesystem;
 #endif
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
@@ -58,6 +61,8 @@ TrafficLightSSDFineDetectorNodelet::TrafficLightSSDFineDetectorNodelet(
     }
   }
 
+  // another node of this process may be building the same engine
+  auto build_lock = tensorrt_common::EngineCache::getInstance().lockBuild(engine_path.string());
   if (fs::exists(engine_path)) {
     RCLCPP_INFO(this->get_logger(), "Found %s", engine_path.string().c_str());
     net_ptr_.reset(new ssd::Net(engine_path, false));
@@ -78,6 +83,7 @@ TrafficLightSSDFineDetectorNodelet::TrafficLightSSDFineDetectorNodelet(
     net_ptr_.reset(new ssd::Net(onnx_file, mode, max_batch_size));
     net_ptr_->save(engine_path);
   }
+  build_lock.unlock();
   channel_ = net_ptr_->getInputSize()[0];
   width_ = net_ptr_->getInputSize()[1];
   height_ = net_ptr_->getInputSize()[2];
@@ -88,6 +94,16 @@ TrafficLightSSDFineDetectorNodelet::TrafficLightSSDFineDetectorNodelet(
   score_thresh_ = this->declare_parameter<double>("score_thresh", 0.7);
   mean_ = toFloatVector(this->declare_parameter("mean", std::vector<double>({0.5, 0.5, 0.5})));
   std_ = toFloatVector(this->declare_parameter("std", std::vector<double>({0.5, 0.5, 0.5})));
+  for (int c = 0; c < 3; ++c) {
+    normalization_.mean[c] = mean_.at(c);
+    normalization_.std[c] = std_.at(c);
+  }
+
+  const int max_batch = net_ptr_->getMaxBatchSize();
+  data_d_ = cuda::make_unique<float[]>(max_batch * channel_ * width_ * height_);
+  scores_d_ = cuda::make_unique<float[]>(max_batch * detection_per_class_ * class_num_);
+  boxes_d_ = cuda::make_unique<float[]>(max_batch * detection_per_class_ * 4);
+  buffers_ = {data_d_.get(), scores_d_.get(), boxes_d_.get()};
 
   using std::chrono_literals::operator""ms;
   timer_ = rclcpp::create_timer(
@@ -137,80 +153,37 @@ void TrafficLightSSDFineDetectorNodelet::callback(
   using std::chrono::high_resolution_clock;
   using std::chrono::milliseconds;
   const auto exe_start_time = high_resolution_clock::now();
-  cv::Mat original_image;
   autoware_auto_perception_msgs::msg::TrafficLightRoiArray out_rois;
 
-  rosMsg2CvMat(in_image_msg, original_image);
-  int num_rois = in_roi_msg->rois.size();
-  int batch_count = 0;
-  const int batch_size = net_ptr_->getMaxBatchSize();
-  while (num_rois != 0) {
-    const int num_infer = (num_rois / batch_size > 0) ? batch_size : num_rois % batch_size;
-    auto data_d = cuda::make_unique<float[]>(num_infer * channel_ * width_ * height_);
-    auto scores_d = cuda::make_unique<float[]>(num_infer * detection_per_class_ * class_num_);
-    auto boxes_d = cuda::make_unique<float[]>(num_infer * detection_per_class_ * 4);
-    std::vector<void *> buffers = {data_d.get(), scores_d.get(), boxes_d.get()};
-    std::vector<cv::Point> lts, rbs;
-    std::vector<cv::Mat> cropped_imgs;
-
-    for (int i = 0; i < num_infer; ++i) {
-      int roi_index = i + batch_count * batch_size;
-      lts.push_back(cv::Point(
-        in_roi_msg->rois.at(roi_index).roi.x_offset, in_roi_msg->rois.at(roi_index).roi.y_offset));
-      rbs.push_back(cv::Point(
-        in_roi_msg->rois.at(roi_index).roi.x_offset + in_roi_msg->rois.at(roi_index).roi.width,
-        in_roi_msg->rois.at(roi_index).roi.y_offset + in_roi_msg->rois.at(roi_index).roi.height));
-      fitInFrame(lts.at(i), rbs.at(i), cv::Size(original_image.size()));
-      cropped_imgs.push_back(cv::Mat(original_image, cv::Rect(lts.at(i), rbs.at(i))));
-    }
-
-    std::vector<float> data(num_infer * channel_ * width_ * height_);
-    if (!cvMat2CnnInput(cropped_imgs, num_infer, data)) {
-      RCLCPP_ERROR(this->get_logger(), "Fail to preprocess image");
-      return;
-    }
-
-    cudaMemcpy(data_d.get(), data.data(), data.size() * sizeof(float), cudaMemcpyHostToDevice);
-
-    try {
-      net_ptr_->infer(buffers, num_infer);
-    } catch (std::exception & e) {
-      RCLCPP_ERROR(this->get_logger(), "%s", e.what());
-      return;
-    }
+  const cv::Size image_size(in_image_msg->width, in_image_msg->height);
+  const int num_rois = in_roi_msg->rois.size();
+  std::vector<cv::Point> lts;
+  std::vector<cv::Size> roi_sizes;
+  for (const auto & roi : in_roi_msg->rois) {
+    cv::Point lt(roi.roi.x_offset, roi.roi.y_offset);
+    cv::Point rb(roi.roi.x_offset + roi.roi.width, roi.roi.y_offset + roi.roi.height);
+    fitInFrame(lt, rb, image_size);
+    lts.push_back(lt);
+    roi_sizes.emplace_back(rb.x - lt.x, rb.y - lt.y);
+  }
 
-    auto scores = std::make_unique<float[]>(num_infer * detection_per_class_ * class_num_);
-    auto boxes = std::make_unique<float[]>(num_infer * detection_per_class_ * 4);
-    cudaMemcpy(
-      scores.get(), scores_d.get(), sizeof(float) * num_infer * detection_per_class_ * class_num_,
-      cudaMemcpyDeviceToHost);
-    cudaMemcpy(
-      boxes.get(), boxes_d.get(), sizeof(float) * num_infer * detection_per_class_ * 4,
-      cudaMemcpyDeviceToHost);
-    // Get Output
-    std::vector<Detection> detections;
-    if (!cnnOutput2BoxDetection(
-          scores.get(), boxes.get(), tlr_id_, cropped_imgs, num_infer, detections)) {
-      RCLCPP_ERROR(this->get_logger(), "Fail to postprocess image");
-      return;
-    }
+  std::vector<Detection> detections;
+  if (num_rois > 0 && !detect(in_image_msg, lts, roi_sizes, detections)) {
+    return;
+  }
 
-    for (int i = 0; i < num_infer; ++i) {
-      if (detections.at(i).prob > score_thresh_) {
-        cv::Point lt_roi =
-          cv::Point(lts.at(i).x + detections.at(i).x, lts.at(i).y + detections.at(i).y);
-        cv::Point rb_roi = cv::Point(
-          lts.at(i).x + detections.at(i).x + detections.at(i).w,
-          lts.at(i).y + detections.at(i).y + detections.at(i).h);
-        fitInFrame(lt_roi, rb_roi, cv::Size(original_image.size()));
-        autoware_auto_perception_msgs::msg::TrafficLightRoi tl_roi;
-        cvRect2TlRoiMsg(
-          cv::Rect(lt_roi, rb_roi), in_roi_msg->rois.at(i + batch_count * batch_size).id, tl_roi);
-        out_rois.rois.push_back(tl_roi);
-      }
+  for (int i = 0; i < num_rois; ++i) {
+    if (detections.at(i).prob > score_thresh_) {
+      cv::Point lt_roi =
+        cv::Point(lts.at(i).x + detections.at(i).x, lts.at(i).y + detections.at(i).y);
+      cv::Point rb_roi = cv::Point(
+        lts.at(i).x + detections.at(i).x + detections.at(i).w,
+        lts.at(i).y + detections.at(i).y + detections.at(i).h);
+      fitInFrame(lt_roi, rb_roi, image_size);
+      autoware_auto_perception_msgs::msg::TrafficLightRoi tl_roi;
+      cvRect2TlRoiMsg(cv::Rect(lt_roi, rb_roi), in_roi_msg->rois.at(i).id, tl_roi);
+      out_rois.rois.push_back(tl_roi);
     }
-    num_rois -= num_infer;
-    ++batch_count;
   }
   out_rois.header = in_roi_msg->header;
   output_roi_pub_->publish(out_rois);
@@ -223,39 +196,100 @@ void TrafficLightSSDFineDetectorNodelet::callback(
   exe_time_pub_->publish(exe_time_msg);
 }
 
-bool TrafficLightSSDFineDetectorNodelet::cvMat2CnnInput(
-  const std::vector<cv::Mat> & in_imgs, const int num_rois, std::vector<float> & data)
+bool TrafficLightSSDFineDetectorNodelet::detect(
+  const sensor_msgs::msg::Image::ConstSharedPtr image_msg, const std::vector<cv::Point> & lts,
+  const std::vector<cv::Size> & roi_sizes, std::vector<Detection> & detections)
 {
-  for (int i = 0; i < num_rois; ++i) {
-    // cv::Mat rgb;
-    // cv::cvtColor(in_imgs.at(i), rgb, CV_BGR2RGB);
-    cv::Mat resized;
-    cv::resize(in_imgs.at(i), resized, cv::Size(width_, height_));
-
-    cv::Mat pixels;
-    resized.convertTo(pixels, CV_32FC3, 1.0 / 255, 0);
-    std::vector<float> img;
-    if (pixels.isContinuous()) {
-      img.assign(
-        reinterpret_cast<const float *>(pixels.datastart),
-        reinterpret_cast<const float *>(pixels.dataend));
-    } else {
+  // crop, resize and normalize the ROIs on the device, and run all the batches before waiting
+  const int num_rois = lts.size();
+  const int batch_size = net_ptr_->getMaxBatchSize();
+  const size_t score_size = detection_per_class_ * class_num_;
+  const size_t box_size = detection_per_class_ * 4;
+  try {
+    reserveRois(num_rois);
+    if (!uploadImage(image_msg)) {
       return false;
     }
+    for (int i = 0; i < num_rois; ++i) {
+      rois_h_[i] = {lts[i].x, lts[i].y, roi_sizes[i].width, roi_sizes[i].height};
+    }
+    cudaStream_t stream = net_ptr_->getStream();
+    CHECK_CUDA_ERROR(cudaMemcpyAsync(
+      rois_d_.get(), rois_h_.get(), sizeof(ssd::CropRoi) * num_rois, cudaMemcpyHostToDevice,
+      stream));
+
+    for (int offset = 0; offset < num_rois; offset += batch_size) {
+      const int num_infer = std::min(batch_size, num_rois - offset);
+      CHECK_CUDA_ERROR(ssd::cropResizeNormalize_launch(
+        image_d_.get(), image_step_, image_is_bgr_, rois_d_.get() + offset, num_infer,
+        data_d_.get(), width_, height_, normalization_, stream));
+      net_ptr_->enqueue(buffers_, num_infer);
+      CHECK_CUDA_ERROR(cudaMemcpyAsync(
+        scores_h_.get() + offset * score_size, scores_d_.get(),
+        sizeof(float) * num_infer * score_size, cudaMemcpyDeviceToHost, stream));
+      CHECK_CUDA_ERROR(cudaMemcpyAsync(
+        boxes_h_.get() + offset * box_size, boxes_d_.get(), sizeof(float) * num_infer * box_size,
+        cudaMemcpyDeviceToHost, stream));
+    }
+    CHECK_CUDA_ERROR(cudaStreamSynchronize(stream));
+  } catch (std::exception & e) {
+    RCLCPP_ERROR(this->get_logger(), "%s", e.what());
+    return false;
+  }
 
-    for (int c = 0; c < channel_; ++c) {
-      for (int j = 0, hw = width_ * height_; j < hw; ++j) {
-        data[i * channel_ * width_ * height_ + c * hw + j] =
-          (img[channel_ * j + 2 - c] - mean_[c]) / std_[c];
-      }
+  // Get Output
+  if (!cnnOutput2BoxDetection(
+        scores_h_.get(), boxes_h_.get(), tlr_id_, roi_sizes, num_rois, detections)) {
+    RCLCPP_ERROR(this->get_logger(), "Fail to postprocess image");
+    return false;
+  }
+  return true;
+}
+
+bool TrafficLightSSDFineDetectorNodelet::uploadImage(
+  const sensor_msgs::msg::Image::ConstSharedPtr image_msg)
+{
+  // rgb8 and bgr8 images are uploaded as they are, the kernel reads either channel order
+  cv::Mat converted_image;
+  const uint8_t * data = image_msg->data.data();
+  size_t step = image_msg->step;
+  image_is_bgr_ = image_msg->encoding == sensor_msgs::image_encodings::BGR8;
+  if (!image_is_bgr_ && image_msg->encoding != sensor_msgs::image_encodings::RGB8) {
+    if (!rosMsg2CvMat(image_msg, converted_image)) {
+      return false;
     }
+    data = converted_image.data;
+    step = converted_image.step;
+  }
+  image_step_ = static_cast<int>(step);
+
+  const size_t image_size = step * image_msg->height;
+  if (image_capacity_ < image_size) {
+    image_h_ = cuda::make_host_unique<uint8_t[]>(image_size);
+    image_d_ = cuda::make_unique<uint8_t[]>(image_size);
+    image_capacity_ = image_size;
   }
+  std::memcpy(image_h_.get(), data, image_size);
+  CHECK_CUDA_ERROR(cudaMemcpyAsync(
+    image_d_.get(), image_h_.get(), image_size, cudaMemcpyHostToDevice, net_ptr_->getStream()));
   return true;
 }
 
+void TrafficLightSSDFineDetectorNodelet::reserveRois(const size_t num_rois)
+{
+  if (num_rois <= roi_capacity_) {
+    return;
+  }
+  rois_h_ = cuda::make_host_unique<ssd::CropRoi[]>(num_rois);
+  rois_d_ = cuda::make_unique<ssd::CropRoi[]>(num_rois);
+  scores_h_ = cuda::make_host_unique<float[]>(num_rois * detection_per_class_ * class_num_);
+  boxes_h_ = cuda::make_host_unique<float[]>(num_rois * detection_per_class_ * 4);
+  roi_capacity_ = num_rois;
+}
+
 bool TrafficLightSSDFineDetectorNodelet::cnnOutput2BoxDetection(
-  const float * scores, const float * boxes, const int tlr_id, const std::vector<cv::Mat> & in_imgs,
-  const int num_rois, std::vector<Detection> & detections)
+  const float * scores, const float * boxes, const int tlr_id,
+  const std::vector<cv::Size> & roi_sizes, const int num_rois, std::vector<Detection> & detections)
 {
   if (tlr_id > class_num_ - 1) {
     return false;
@@ -270,11 +304,11 @@ bool TrafficLightSSDFineDetectorNodelet::cnnOutput2BoxDetection(
     size_t index = std::distance(tlr_scores.begin(), iter);
     size_t box_index = i * detection_per_class_ * 4 + index * 4;
     cv::Point lt, rb;
-    lt.x = boxes[box_index] * in_imgs.at(i).cols;
-    lt.y = boxes[box_index + 1] * in_imgs.at(i).rows;
-    rb.x = boxes[box_index + 2] * in_imgs.at(i).cols;
-    rb.y = boxes[box_index + 3] * in_imgs.at(i).rows;
-    fitInFrame(lt, rb, cv::Size(in_imgs.at(i).cols, in_imgs.at(i).rows));
+    lt.x = boxes[box_index] * roi_sizes.at(i).width;
+    lt.y = boxes[box_index + 1] * roi_sizes.at(i).height;
+    rb.x = boxes[box_index + 2] * roi_sizes.at(i).width;
+    rb.y = boxes[box_index + 3] * roi_sizes.at(i).height;
+    fitInFrame(lt, rb, roi_sizes.at(i));
     det.x = lt.x;
     det.y = lt.y;
     det.w = rb.x - lt.x;
@@ -144,7 +144,9 @@ private:
 
   HADMapBin::ConstSharedPtr map_ptr_{nullptr};
   LaneletRoute::ConstSharedPtr route_ptr_{nullptr};
-  bool has_received_map_{false};
+  // the route handler of the last received map, set up by onMap() until the next run() takes it
+  std::shared_ptr<RouteHandler> received_route_handler_{nullptr};
+  std::shared_ptr<const drivable_area_expansion::UncrossableLines> received_uncrossable_lines_{};
   bool has_received_route_{false};
 
   TurnSignalDecider turn_signal_decider_;
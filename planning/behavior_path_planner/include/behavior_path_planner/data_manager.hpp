@@ -16,7 +16,9 @@
 #define BEHAVIOR_PATH_PLANNER__DATA_MANAGER_HPP_
 
 #include "behavior_path_planner/parameters.hpp"
+#include "behavior_path_planner/util/drivable_area_expansion/map_utils.hpp"
 #include "behavior_path_planner/util/drivable_area_expansion/parameters.hpp"
+#include "behavior_path_planner/util/footprint_cache/footprint_cache.hpp"
 
 #include <rclcpp/rclcpp.hpp>
 #include <route_handler/route_handler.hpp>
@@ -124,6 +126,8 @@ struct PlannerData
   Odometry::ConstSharedPtr self_odometry{};
   AccelWithCovarianceStamped::ConstSharedPtr self_acceleration{};
   PredictedObjects::ConstSharedPtr dynamic_object{};
+  // the footprints of dynamic_object, created for each planning cycle
+  std::shared_ptr<PredictedObjectFootprintCache> predicted_object_footprints{};
   OccupancyGrid::ConstSharedPtr occupancy_grid{};
   OccupancyGrid::ConstSharedPtr costmap{};
   LateralOffset::ConstSharedPtr lateral_offset{};
@@ -134,6 +138,8 @@ struct PlannerData
   std::shared_ptr<RouteHandler> route_handler{std::make_shared<RouteHandler>()};
   BehaviorPathPlannerParameters parameters{};
   drivable_area_expansion::DrivableAreaExpansionParameters drivable_area_expansion_parameters{};
+  // the uncrossable lines of the map used by the drivable area expansion, created for each map
+  std::shared_ptr<const drivable_area_expansion::UncrossableLines> uncrossable_lines{};
 
   template <class T>
   size_t findEgoIndex(const std::vector<T> & points) const
@@ -28,6 +28,7 @@ struct ModuleConfigParameters
 struct BehaviorPathPlannerParameters
 {
   bool verbose;
+  int planner_manager_num_threads;
 
   ModuleConfigParameters config_avoidance;
   ModuleConfigParameters config_pull_out;
@@ -20,9 +20,11 @@
 #include "behavior_path_planner/util/lane_following/module_data.hpp"
 
 #include <rclcpp/rclcpp.hpp>
+#include <tier4_autoware_utils/ros/debug_publisher.hpp>
 
 #include <autoware_auto_planning_msgs/msg/path_with_lane_id.hpp>
 #include <diagnostic_msgs/msg/diagnostic_status.hpp>
+#include <tier4_debug_msgs/msg/float64_stamped.hpp>
 #include <unique_identifier_msgs/msg/uuid.hpp>
 
 #include <algorithm>
@@ -36,7 +38,9 @@ namespace behavior_path_planner
 {
 
 using autoware_auto_planning_msgs::msg::PathWithLaneId;
+using tier4_autoware_utils::DebugPublisher;
 using tier4_autoware_utils::StopWatch;
+using tier4_debug_msgs::msg::Float64Stamped;
 using SceneModulePtr = std::shared_ptr<SceneModuleInterface>;
 using SceneModuleManagerPtr = std::shared_ptr<SceneModuleManagerInterface>;
 
@@ -57,7 +61,7 @@ class PlannerManager
 public:
   PlannerManager(
     rclcpp::Node & node, const std::shared_ptr<LaneFollowingParameters> & parameters,
-    const bool verbose);
+    const bool verbose, const int num_threads = 1);
 
   BehaviorModuleOutput run(const std::shared_ptr<PlannerData> & data);
 
@@ -124,6 +128,8 @@ public:
 
   void print() const;
 
+  void publishProcessingTime();
+
 private:
   BehaviorModuleOutput run(
     const SceneModulePtr & module_ptr, const std::shared_ptr<PlannerData> & planner_data,
@@ -203,7 +209,12 @@ private:
 
   mutable std::unordered_map<std::string, double> processing_time_;
 
+  std::unique_ptr<DebugPublisher> processing_time_publisher_;
+
   bool verbose_{false};
+
+  // threads checking the execution requests of the modules, they are checked serially if 1
+  int num_threads_{1};
 };
 }  // namespace behavior_path_planner
 
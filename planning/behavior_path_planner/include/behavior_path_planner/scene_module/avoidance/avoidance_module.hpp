@@ -221,6 +221,11 @@ private:
 
   void fillObjectMovingTime(ObjectData & object_data) const;
 
+  ObjectLaneletData * getObjectLaneletData(
+    const PredictedObject & object, ObjectLaneletDataMap & object_lanelet_data) const;
+
+  void fillObjectBoundaryDistance(ObjectLaneletData & object_lanelet_data) const;
+
   void compensateDetectionLost(
     ObjectDataArray & target_objects, ObjectDataArray & other_objects) const;
 
@@ -488,6 +493,13 @@ private:
    * avoidance module misc data
    */
   mutable ObjectDataArray stopped_objects_;
+
+  // buffers for merging the shift lines
+  mutable ShiftLineData shift_line_data_;
+
+  // map related data of the objects in the previous cycle, and the map they are computed on
+  mutable ObjectLaneletDataMap object_lanelet_data_;
+  mutable std::weak_ptr<const lanelet::LaneletMap> object_lanelet_data_map_;
 };
 
 }  // namespace behavior_path_planner
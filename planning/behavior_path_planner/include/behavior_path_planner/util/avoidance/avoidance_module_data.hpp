@@ -29,6 +29,7 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace behavior_path_planner
@@ -336,6 +337,27 @@ struct ObjectData  // avoidance target
 };
 using ObjectDataArray = std::vector<ObjectData>;
 
+struct ObjectLaneletData  // map related data of an object, reused while the object stays still
+{
+  // object pose for which the data is computed
+  Pose pose;
+
+  // the closest lanelet in the whole map
+  lanelet::ConstLanelet closest_lanelet;
+
+  // distances from the nearest point on the centerline of the closest lanelet to the left and
+  // right boundary of the road
+  // NOTE: These are computed only for the objects in the ego lane.
+  bool has_boundary_distance{false};
+  double center_to_left_boundary{0.0};
+  double center_to_right_boundary{0.0};
+
+  // whether the most left and right road lanelet are road shoulders
+  bool is_left_road_shoulder{false};
+  bool is_right_road_shoulder{false};
+};
+using ObjectLaneletDataMap = std::unordered_map<std::string, ObjectLaneletData>;
+
 /*
  * Shift point with additional info for avoidance planning
  */
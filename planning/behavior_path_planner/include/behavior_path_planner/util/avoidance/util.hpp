@@ -69,6 +69,18 @@ std::vector<size_t> concatParentIds(
 
 double lerpShiftLengthOnArc(double arc, const AvoidLine & al);
 
+/**
+ * @brief merge the shift lines into the total shift length on the path points.
+ * @param arcs arclength from ego of the path points, in the ascending order.
+ * @param store_history store the shift length of each line for debug.
+ * @details the cost is linear in the number of the path points plus the points covered by the
+ *          shift lines, and the buffers of the shift line data are reused.
+ */
+void fillTotalShiftLine(
+  const AvoidLineArray & avoid_lines, const std::vector<double> & arcs,
+  const size_t ego_closest_index, const double current_shift, const bool store_history,
+  ShiftLineData & shift_line_data);
+
 void clipByMinStartIdx(const AvoidLineArray & shift_lines, PathWithLaneId & path);
 
 void fillLongitudinalAndLengthByClosestFootprint(
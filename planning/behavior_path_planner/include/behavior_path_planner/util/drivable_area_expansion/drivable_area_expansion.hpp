@@ -15,6 +15,7 @@
 #ifndef BEHAVIOR_PATH_PLANNER__UTIL__DRIVABLE_AREA_EXPANSION__DRIVABLE_AREA_EXPANSION_HPP_
 #define BEHAVIOR_PATH_PLANNER__UTIL__DRIVABLE_AREA_EXPANSION__DRIVABLE_AREA_EXPANSION_HPP_
 
+#include "behavior_path_planner/util/drivable_area_expansion/map_utils.hpp"
 #include "behavior_path_planner/util/drivable_area_expansion/parameters.hpp"
 #include "behavior_path_planner/util/drivable_area_expansion/types.hpp"
 
@@ -35,6 +36,19 @@ void expandDrivableArea(
   const PredictedObjects & dynamic_objects, const route_handler::RouteHandler & route_handler,
   const lanelet::ConstLanelets & path_lanes);
 
+/// @brief Expand the drivable area based on the projected ego footprint along the path
+/// @details uses the uncrossable segments prepared for the map instead of extracting them again
+/// @param[in] path path whose drivable area will be expanded
+/// @param[in] params expansion parameters
+/// @param[in] dynamic_objects dynamic objects
+/// @param[in] route_handler route handler
+/// @param[in] path_lanes lanelets of the path
+/// @param[in] uncrossable_segments rtree of the segments of the uncrossable linestrings
+void expandDrivableArea(
+  PathWithLaneId & path, const DrivableAreaExpansionParameters & params,
+  const PredictedObjects & dynamic_objects, const route_handler::RouteHandler & route_handler,
+  const lanelet::ConstLanelets & path_lanes, const SegmentRtree & uncrossable_segments);
+
 /// @brief Create a polygon combining the drivable area of a path and some expansion polygons
 /// @param[in] path path and its drivable area
 /// @param[in] expansion_polygons polygons to add to the drivable area
@@ -15,6 +15,7 @@
 #ifndef BEHAVIOR_PATH_PLANNER__UTIL__DRIVABLE_AREA_EXPANSION__EXPANSION_HPP_
 #define BEHAVIOR_PATH_PLANNER__UTIL__DRIVABLE_AREA_EXPANSION__EXPANSION_HPP_
 
+#include "behavior_path_planner/util/drivable_area_expansion/map_utils.hpp"
 #include "behavior_path_planner/util/drivable_area_expansion/parameters.hpp"
 #include "behavior_path_planner/util/drivable_area_expansion/types.hpp"
 
@@ -27,16 +28,16 @@
 
 namespace drivable_area_expansion
 {
-/// @brief Calculate the distance limit required for the polygon to not cross the limit lines
-/// @details Calculate the minimum distance from base_ls to an intersection of limit_lines and
-/// expansion_polygon
+/// @brief Calculate the distance limit required for the polygon to not cross the limit segments
+/// @details Calculate the minimum distance from base_ls to an intersection of the limit segments
+/// and expansion_polygon. Only the segments intersecting the polygon are checked
 /// @param[in] base_ls base linestring from which the distance is calculated
 /// @param[in] expansion_polygon polygon to consider
-/// @param[in] limit_lines lines we do not want to cross
+/// @param[in] limit_segments rtree of the segments we do not want to cross
 /// @return distance limit
 double calculateDistanceLimit(
   const linestring_t & base_ls, const polygon_t & expansion_polygon,
-  const multilinestring_t & limit_lines);
+  const SegmentRtree & limit_segments);
 
 /// @brief Calculate the distance limit required for the polygon to not cross the limit polygons.
 /// @details Calculate the minimum distance from base_ls to an intersection of limit_polygons and
@@ -61,12 +62,12 @@ polygon_t createExpansionPolygon(
 /// @param[in] path path and its drivable area
 /// @param[in] path_footprints polygons of the ego footprint projected along the path
 /// @param[in] predicted_paths polygons of the dynamic objects' predicted paths
-/// @param[in] uncrossable_lines lines that should not be crossed by the expanded drivable area
+/// @param[in] uncrossable_segments segments that should not be crossed by the expanded area
 /// @param[in] params expansion parameters
 /// @return expansion polygons
 multipolygon_t createExpansionPolygons(
   const PathWithLaneId & path, const multipolygon_t & path_footprints,
-  const multipolygon_t & predicted_paths, const multilinestring_t & uncrossable_lines,
+  const multipolygon_t & predicted_paths, const SegmentRtree & uncrossable_segments,
   const DrivableAreaExpansionParameters & params);
 
 /// @brief Create polygons for the area where the drivable area should be expanded
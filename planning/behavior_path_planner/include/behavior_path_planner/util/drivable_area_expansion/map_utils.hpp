@@ -19,16 +19,30 @@
 
 #include <lanelet2_core/LaneletMap.h>
 
+#include <boost/geometry/index/rtree.hpp>
+
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace drivable_area_expansion
 {
-/// @brief Extract uncrossable linestrings from the lanelet map
+namespace bgi = boost::geometry::index;
+using SegmentRtree = bgi::rtree<segment_t, bgi::rstar<16>>;
+
+/// @brief Segments of the uncrossable linestrings of a lanelet map stored in an rtree
+struct UncrossableLines
+{
+  std::vector<std::string> types;  // linestring types used to select the segments
+  SegmentRtree segments;
+};
+
+/// @brief Create the rtree of the uncrossable linestrings segments of the lanelet map
+/// @details meant to be built once per map as querying it is much cheaper than using all lines
 /// @param[in] lanelet_map lanelet map
 /// @param[in] uncrossable_types types that cannot be crossed
-/// @return the uncrossable linestrings
-multilinestring_t extractUncrossableLines(
+/// @return the uncrossable linestrings segments and the types used to select them
+std::shared_ptr<const UncrossableLines> createUncrossableLines(
   const lanelet::LaneletMap & lanelet_map, const std::vector<std::string> & uncrossable_types);
 
 /// @brief Determine if the given linestring has one of the given types
@@ -35,6 +35,7 @@ using polygon_t = tier4_autoware_utils::Polygon2d;
 using ring_t = tier4_autoware_utils::LinearRing2d;
 using multipolygon_t = tier4_autoware_utils::MultiPolygon2d;
 using segment_t = tier4_autoware_utils::Segment2d;
+using box_t = tier4_autoware_utils::Box2d;
 using linestring_t = tier4_autoware_utils::LineString2d;
 using multilinestring_t = tier4_autoware_utils::MultiLineString2d;
 
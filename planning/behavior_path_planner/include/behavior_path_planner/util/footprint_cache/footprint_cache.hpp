@@ -0,0 +1,74 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef BEHAVIOR_PATH_PLANNER__UTIL__FOOTPRINT_CACHE__FOOTPRINT_CACHE_HPP_
+#define BEHAVIOR_PATH_PLANNER__UTIL__FOOTPRINT_CACHE__FOOTPRINT_CACHE_HPP_
+
+#include <tier4_autoware_utils/geometry/boost_geometry.hpp>
+
+#include <autoware_auto_perception_msgs/msg/predicted_objects.hpp>
+#include <geometry_msgs/msg/pose.hpp>
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace behavior_path_planner
+{
+using autoware_auto_perception_msgs::msg::PredictedObjects;
+using autoware_auto_perception_msgs::msg::PredictedPath;
+using geometry_msgs::msg::Pose;
+
+struct PredictedObjectFootprint
+{
+  Pose pose{};
+  tier4_autoware_utils::Polygon2d polygon{};
+  std::string failed_reason{};  // empty when the pose is interpolated on the path
+};
+
+// The expected footprints of the predicted objects of one planning cycle. Each one is interpolated
+// on the first query, and then shared by the safety checks of all the candidate paths and modules.
+class PredictedObjectFootprintCache
+{
+public:
+  explicit PredictedObjectFootprintCache(const PredictedObjects::ConstSharedPtr objects)
+  : objects_(objects)
+  {
+  }
+
+  PredictedObjects::ConstSharedPtr objects() const { return objects_; }
+
+  // util::getPredictedPathFromObj() of objects()->objects.at(object_index), the functions are
+  // safe to call from several threads
+  const std::vector<PredictedPath> & getPredictedPaths(
+    const size_t object_index, const bool use_all_predicted_path);
+
+  // the footprint at time of objects()->objects.at(object_index), along its path_index-th path
+  const PredictedObjectFootprint & getFootprint(
+    const size_t object_index, const bool use_all_predicted_path, const size_t path_index,
+    const double time);
+
+private:
+  PredictedObjects::ConstSharedPtr objects_;
+
+  std::mutex mutex_;
+  std::map<std::pair<size_t, bool>, std::vector<PredictedPath>> predicted_paths_;
+  std::map<std::tuple<size_t, bool, size_t, double>, PredictedObjectFootprint> footprints_;
+};
+}  // namespace behavior_path_planner
+
+#endif  // BEHAVIOR_PATH_PLANNER__UTIL__FOOTPRINT_CACHE__FOOTPRINT_CACHE_HPP_
@@ -35,6 +35,7 @@ struct LaneChangeParameters
   double prediction_time_resolution{0.5};
   double maximum_deceleration{1.0};
   int lane_change_sampling_num{10};
+  int lane_change_num_threads{1};
 
   // collision check
   bool enable_collision_check_at_prepare_phase{true};
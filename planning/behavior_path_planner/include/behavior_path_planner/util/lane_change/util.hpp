@@ -17,6 +17,7 @@
 
 #include "behavior_path_planner/marker_util/lane_change/debug.hpp"
 #include "behavior_path_planner/parameters.hpp"
+#include "behavior_path_planner/util/footprint_cache/footprint_cache.hpp"
 #include "behavior_path_planner/util/lane_change/lane_change_module_data.hpp"
 #include "behavior_path_planner/util/lane_change/lane_change_path.hpp"
 #include "behavior_path_planner/utilities.hpp"
@@ -73,7 +74,8 @@ std::pair<bool, bool> getLaneChangePaths(
   const PredictedObjects::ConstSharedPtr dynamic_objects,
   const BehaviorPathPlannerParameters & common_parameter, const LaneChangeParameters & parameter,
   const double check_distance, LaneChangePaths * candidate_paths,
-  std::unordered_map<std::string, CollisionCheckDebug> * debug_data);
+  std::unordered_map<std::string, CollisionCheckDebug> * debug_data,
+  const std::shared_ptr<PredictedObjectFootprintCache> & footprint_cache = nullptr);
 
 std::pair<bool, bool> getLaneChangePaths(
   const PathWithLaneId & original_path, const RouteHandler & route_handler,
@@ -81,7 +83,8 @@ std::pair<bool, bool> getLaneChangePaths(
   const Pose & pose, const Twist & twist, const PredictedObjects::ConstSharedPtr dynamic_objects,
   const BehaviorPathPlannerParameters & common_parameter, const LaneChangeParameters & parameter,
   const double check_distance, LaneChangePaths * candidate_paths,
-  std::unordered_map<std::string, CollisionCheckDebug> * debug_data);
+  std::unordered_map<std::string, CollisionCheckDebug> * debug_data,
+  const std::shared_ptr<PredictedObjectFootprintCache> & footprint_cache = nullptr);
 
 bool isLaneChangePathSafe(
   const LaneChangePath & lane_change_path, const PredictedObjects::ConstSharedPtr dynamic_objects,
@@ -91,7 +94,8 @@ bool isLaneChangePathSafe(
   const behavior_path_planner::LaneChangeParameters & lane_change_parameters,
   const double front_decel, const double rear_decel, Pose & ego_pose_before_collision,
   std::unordered_map<std::string, CollisionCheckDebug> & debug_data,
-  const double acceleration = 0.0);
+  const double acceleration = 0.0,
+  const std::shared_ptr<PredictedObjectFootprintCache> & footprint_cache = nullptr);
 
 bool hasEnoughDistance(
   const LaneChangePath & path, const lanelet::ConstLanelets & current_lanes,
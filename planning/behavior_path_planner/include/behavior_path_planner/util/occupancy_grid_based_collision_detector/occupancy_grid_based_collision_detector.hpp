@@ -48,6 +48,14 @@ struct IndexXY
   int y;
 };
 
+// a circle of the footprint decomposition, the center is relative to the base pose [m]
+struct FootprintCircle
+{
+  double x;
+  double y;
+  double radius;
+};
+
 IndexXYT pose2index(
   const nav_msgs::msg::OccupancyGrid & costmap, const geometry_msgs::msg::Pose & pose_local,
   const int theta_size);
@@ -76,6 +84,9 @@ struct OccupancyGridMapParam
   // costmap configs
   int theta_size;          // discretized angle table size [-]
   int obstacle_threshold;  // obstacle threshold on grid [-]
+
+  // check the footprint as circles against the distance to the nearest obstacle instead of cells
+  bool use_distance_field{false};
 };
 
 struct PlannerWaypoint
@@ -97,19 +108,25 @@ public:
   void setParam(const OccupancyGridMapParam & param) { param_ = param; };
   OccupancyGridMapParam getParam() const { return param_; };
   void setMap(const nav_msgs::msg::OccupancyGrid & costmap);
-  nav_msgs::msg::OccupancyGrid getMap() const { return costmap_; };
+  const nav_msgs::msg::OccupancyGrid & getMap() const { return costmap_; };
   void setVehicleShape(const VehicleShape & vehicle_shape) { param_.vehicle_shape = vehicle_shape; }
   bool hasObstacleOnPath(
     const geometry_msgs::msg::PoseArray & path, const bool check_out_of_range) const;
   bool hasObstacleOnPath(
     const autoware_auto_planning_msgs::msg::PathWithLaneId & path,
     const bool check_out_of_range) const;
+  bool hasObstacleOnPoses(
+    const std::vector<geometry_msgs::msg::Pose> & poses, const bool check_out_of_range) const;
   const PlannerWaypoints & getWaypoints() const { return waypoints_; }
   bool detectCollision(const IndexXYT & base_index, const bool check_out_of_range) const;
   virtual ~OccupancyGridBasedCollisionDetector() {}
 
 protected:
   void computeCollisionIndexes(int theta_index, std::vector<IndexXY> & indexes);
+  void computeFootprintCircles(int theta_index, std::vector<FootprintCircle> & circles) const;
+  void computeDistanceField();
+  bool detectCollisionWithDistanceField(
+    const IndexXYT & base_index, const bool check_out_of_range) const;
   inline bool isOutOfRange(const IndexXYT & index) const
   {
     if (index.x < 0 || static_cast<int>(costmap_.info.width) <= index.x) {
@@ -139,6 +156,12 @@ protected:
   // is_obstacle's table
   std::vector<std::vector<bool>> is_obstacle_table_;
 
+  // footprint circles cache for each theta index
+  std::vector<std::vector<FootprintCircle>> footprint_circles_table_;
+
+  // distance from each cell to the nearest obstacle cell, row major [m]
+  std::vector<float> distance_field_;
+
   // pose in costmap frame
   geometry_msgs::msg::Pose start_pose_;
   geometry_msgs::msg::Pose goal_pose_;
@@ -114,6 +114,9 @@ public:
 
   /**
    * @brief  Generate a shifted path according to the given reference path and shift points.
+   * @details The last generated path is cached. When only some shift points are changed or added
+   *          since then, the shift is calculated again from the first changed one, and only the
+   *          points whose shift length is changed are moved and oriented again.
    * @return False if the path is empty or shift points have conflicts.
    */
   bool generate(
@@ -175,6 +178,24 @@ private:
   // Clock
   mutable rclcpp::Clock clock_{RCL_ROS_TIME};
 
+  // The last generated path and how it was generated.
+  struct ShiftedPathCache
+  {
+    bool is_valid{false};
+    PathWithLaneId reference_path{};
+    ShiftLineArray shift_lines{};
+    double base_offset{0.0};
+    double velocity{0.0};
+    double acc_limit{0.0};
+    bool offset_back{true};
+    SHIFT_TYPE type{SHIFT_TYPE::SPLINE};
+    ShiftedPath shifted_path{};
+
+    // shift length with the base offset only, and after applying each shift point
+    std::vector<std::vector<double>> shift_length_history{};
+  };
+  mutable ShiftedPathCache cache_;
+
   std::pair<std::vector<double>, std::vector<double>> calcBaseLengths(
     const double arclength, const double shift_length, const bool offset_back) const;
 
@@ -192,17 +213,26 @@ private:
   void sortShiftLinesAlongPath(ShiftLineArray & shift_lines) const;
 
   /**
-   * @brief Generate shifted path from reference_path_ and shift_lines_ with linear shifting.
+   * @brief Calculate shift length from reference_path_ and shift_lines_ with linear shifting.
+   * @details The shift points after the ones in the shift length history are applied, and the
+   *          shift length after each of them is appended to the history.
    */
-  void applyLinearShifter(ShiftedPath * shifted_path) const;
+  void applyLinearShifter(std::vector<std::vector<double>> & shift_length_history) const;
 
   /**
-   * @brief Generate shifted path from reference_path_ and shift_lines_ with spline_based shifting.
+   * @brief Calculate shift length from reference_path_ and shift_lines_ with spline_based shifting.
    * @details Calculate the shift so that the horizontal jerk remains constant. This is achieved by
    *          dividing the shift interval into four parts and apply a cubic spline to them.
    *          The resultant shifting shape is closed to the Clothoid curve.
+   *          The shift points are applied from the end of the history as applyLinearShifter().
+   */
+  void applySplineShifter(
+    std::vector<std::vector<double>> & shift_length_history, const bool offset_back) const;
+
+  /**
+   * @brief Check if the last generated path is for the same reference path and parameters.
    */
-  void applySplineShifter(ShiftedPath * shifted_path, const bool offset_back) const;
+  bool isCacheAvailable(const bool offset_back, const SHIFT_TYPE type) const;
 
   ////////////////////////////////////////
   // Helper Functions
@@ -215,6 +245,9 @@ private:
 
   void addLateralOffsetOnIndexPoint(ShiftedPath * path, double offset, size_t index) const;
 
+  void addShiftLengthOnIndexPoint(
+    std::vector<double> & shift_length, double offset, size_t index) const;
+
   void shiftBaseLength(ShiftedPath * path, double offset) const;
 
   void setBaseOffset(const double val)
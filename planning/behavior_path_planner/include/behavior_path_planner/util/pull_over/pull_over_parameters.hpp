@@ -49,15 +49,19 @@ struct PullOverParameters
   double max_lateral_offset;
   double lateral_offset_interval;
   double ignore_distance_from_lane_start;
+  int goal_search_num_threads;
   // occupancy grid map
   bool use_occupancy_grid;
   bool use_occupancy_grid_for_longitudinal_margin;
   double occupancy_grid_collision_check_margin;
   int theta_size;
   int obstacle_threshold;
+  bool use_occupancy_grid_distance_field;
   // object recognition
   bool use_object_recognition;
   double object_recognition_collision_check_margin;
+  // lane parking path generation
+  int lane_parking_num_threads;
   // shift path
   bool enable_shift_parking;
   int pull_over_sampling_num;
@@ -45,6 +45,7 @@
 #include <tf2_geometry_msgs/tf2_geometry_msgs.hpp>
 #endif
 
+#include <functional>
 #include <limits>
 #include <memory>
 #include <string>
@@ -515,6 +516,16 @@ bool isSafeInLaneletCollisionCheck(
   const double prepare_phase_ignore_target_speed_thresh, const double front_decel,
   const double rear_decel, Pose & ego_pose_before_collision, CollisionCheckDebug & debug);
 
+// with the footprints of the target object at the check durations given by getObjectFootprint
+bool isSafeInLaneletCollisionCheck(
+  const std::vector<std::pair<Pose, tier4_autoware_utils::Polygon2d>> & interpolated_ego,
+  const Twist & ego_current_twist, const std::vector<double> & check_duration,
+  const double prepare_duration, const PredictedObject & target_object,
+  const std::function<const PredictedObjectFootprint &(const double)> & getObjectFootprint,
+  const BehaviorPathPlannerParameters & common_parameters,
+  const double prepare_phase_ignore_target_speed_thresh, const double front_decel,
+  const double rear_decel, Pose & ego_pose_before_collision, CollisionCheckDebug & debug);
+
 bool isSafeInFreeSpaceCollisionCheck(
   const std::vector<std::pair<Pose, tier4_autoware_utils::Polygon2d>> & interpolated_ego,
   const Twist & ego_current_twist, const std::vector<double> & check_duration,
@@ -534,6 +545,11 @@ double calcLaneChangeBuffer(
 
 lanelet::ConstLanelets getLaneletsFromPath(
   const PathWithLaneId & path, const std::shared_ptr<route_handler::RouteHandler> & route_handler);
+
+// the centerline of a lanelet is computed and cached on its first access, which is not thread-safe.
+// the lanelets of the route handler map are cached when it is built, the other lanelets read by
+// several threads are cached with this before the threads start.
+void cacheCenterlines(const lanelet::ConstLanelets & lanelets);
 }  // namespace behavior_path_planner::util
 
 #endif  // BEHAVIOR_PATH_PLANNER__UTILITIES_HPP_
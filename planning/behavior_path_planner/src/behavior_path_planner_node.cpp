@@ -23,6 +23,7 @@
 
 #include <tier4_planning_msgs/msg/path_change_module_id.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -201,8 +202,8 @@ BehaviorPathPlannerNode::BehaviorPathPlannerNode(const rclcpp::NodeOptions & nod
     mutex_bt_.lock();
 
     const auto & p = planner_data_->parameters;
-    planner_manager_ =
-      std::make_shared<PlannerManager>(*this, lane_following_param_ptr_, p.verbose);
+    planner_manager_ = std::make_shared<PlannerManager>(
+      *this, lane_following_param_ptr_, p.verbose, p.planner_manager_num_threads);
 
     if (p.config_pull_out.enable_module) {
       auto manager = std::make_shared<PullOutModuleManager>(
@@ -300,6 +301,7 @@ BehaviorPathPlannerParameters BehaviorPathPlannerNode::getCommonParam()
   BehaviorPathPlannerParameters p{};
 
   p.verbose = declare_parameter<bool>("verbose");
+  p.planner_manager_num_threads = declare_parameter<int>("planner_manager_num_threads");
 
   {
     const std::string ns = "pull_out.";
@@ -649,6 +651,7 @@ LaneChangeParameters BehaviorPathPlannerNode::getLaneChangeParam()
   p.prediction_time_resolution = declare_parameter<double>(parameter("prediction_time_resolution"));
   p.maximum_deceleration = declare_parameter<double>(parameter("maximum_deceleration"));
   p.lane_change_sampling_num = declare_parameter<int>(parameter("lane_change_sampling_num"));
+  p.lane_change_num_threads = declare_parameter<int>(parameter("lane_change_num_threads"), 1);
 
   // collision check
   p.enable_collision_check_at_prepare_phase =
@@ -736,6 +739,8 @@ PullOverParameters BehaviorPathPlannerNode::getPullOverParam()
     p.lateral_offset_interval = declare_parameter<double>(ns + "lateral_offset_interval");
     p.ignore_distance_from_lane_start =
       declare_parameter<double>(ns + "ignore_distance_from_lane_start");
+    p.goal_search_num_threads =
+      std::max(declare_parameter<int>(ns + "goal_search_num_threads", 1), 1);
     // occupancy grid map
     p.use_occupancy_grid = declare_parameter<bool>(ns + "use_occupancy_grid");
     p.use_occupancy_grid_for_longitudinal_margin =
@@ -744,10 +749,15 @@ PullOverParameters BehaviorPathPlannerNode::getPullOverParam()
       declare_parameter<double>(ns + "occupancy_grid_collision_check_margin");
     p.theta_size = declare_parameter<int>(ns + "theta_size");
     p.obstacle_threshold = declare_parameter<int>(ns + "obstacle_threshold");
+    p.use_occupancy_grid_distance_field =
+      declare_parameter<bool>(ns + "use_occupancy_grid_distance_field", false);
     // object recognition
     p.use_object_recognition = declare_parameter<bool>(ns + "use_object_recognition");
     p.object_recognition_collision_check_margin =
       declare_parameter<double>(ns + "object_recognition_collision_check_margin");
+    // lane parking path generation
+    p.lane_parking_num_threads =
+      std::max(declare_parameter<int>(ns + "lane_parking_num_threads", 1), 1);
     // shift path
     p.enable_shift_parking = declare_parameter<bool>(ns + "enable_shift_parking");
     p.pull_over_sampling_num = declare_parameter<int>(ns + "pull_over_sampling_num");
@@ -864,6 +874,7 @@ PullOverParameters BehaviorPathPlannerNode::getPullOverParam()
     p.rrt_star_parameters.max_planning_time = declare_parameter<double>(ns + "max_planning_time");
     p.rrt_star_parameters.neighbor_radius = declare_parameter<double>(ns + "neighbor_radius");
     p.rrt_star_parameters.margin = declare_parameter<double>(ns + "margin");
+    p.rrt_star_parameters.num_threads = declare_parameter<int>(ns + "num_threads");
   }
 
   return p;
@@ -979,14 +990,28 @@ std::shared_ptr<PlannerData> BehaviorPathPlannerNode::createLatestPlannerData()
 {
   const std::lock_guard<std::mutex> lock(mutex_pd_);
 
+  // on the handler in use, since the one built for a new map may already have the route
+  const bool is_first_time = !(planner_data_->route_handler->isHandlerReady());
+
   // update map
-  if (has_received_map_) {
-    planner_data_->route_handler->setMap(*map_ptr_);
-    has_received_map_ = false;
+  if (received_route_handler_) {
+    planner_data_->route_handler = received_route_handler_;
+    planner_data_->uncrossable_lines = received_uncrossable_lines_;
+    received_route_handler_ = nullptr;
+    received_uncrossable_lines_ = nullptr;
+  }
+
+  // the uncrossable linestring types may have been changed by a parameter update
+  const auto & uncrossable_types =
+    planner_data_->drivable_area_expansion_parameters.avoid_linestring_types;
+  if (
+    planner_data_->uncrossable_lines &&
+    planner_data_->uncrossable_lines->types != uncrossable_types) {
+    planner_data_->uncrossable_lines = drivable_area_expansion::createUncrossableLines(
+      *planner_data_->route_handler->getLaneletMapPtr(), uncrossable_types);
   }
 
   // update route
-  const bool is_first_time = !(planner_data_->route_handler->isHandlerReady());
   if (has_received_route_) {
     planner_data_->route_handler->setRoute(*route_ptr_);
     // Reset behavior tree when new route is received,
@@ -1003,7 +1028,10 @@ std::shared_ptr<PlannerData> BehaviorPathPlannerNode::createLatestPlannerData()
     has_received_route_ = false;
   }
 
-  return std::make_shared<PlannerData>(*planner_data_);
+  const auto planner_data = std::make_shared<PlannerData>(*planner_data_);
+  planner_data->predicted_object_footprints =
+    std::make_shared<PredictedObjectFootprintCache>(planner_data->dynamic_object);
+  return planner_data;
 }
 
 void BehaviorPathPlannerNode::run()
@@ -1041,7 +1069,10 @@ void BehaviorPathPlannerNode::run()
   const auto path = getPath(output, planner_data);
 
   // update planner data
-  planner_data_->prev_output_path = path;
+  {
+    const std::lock_guard<std::mutex> lock(mutex_pd_);
+    planner_data_->prev_output_path = path;
+  }
 
   // compute turn signal
   computeTurnSignal(planner_data, *path, output);
@@ -1082,6 +1113,7 @@ void BehaviorPathPlannerNode::run()
 
 #ifndef USE_OLD_ARCHITECTURE
   planner_manager_->print();
+  planner_manager_->publishProcessingTime();
   planner_manager_->publishDebugMarker();
 #endif
 
@@ -1371,9 +1403,25 @@ void BehaviorPathPlannerNode::onCostMap(const OccupancyGrid::ConstSharedPtr msg)
 }
 void BehaviorPathPlannerNode::onMap(const HADMapBin::ConstSharedPtr msg)
 {
+  // build the route handler here, out of the planning thread, which only takes it over
+  LaneletRoute::ConstSharedPtr route_ptr;
+  std::vector<std::string> uncrossable_types;
+  {
+    const std::lock_guard<std::mutex> lock(mutex_pd_);
+    route_ptr = route_ptr_;
+    uncrossable_types = planner_data_->drivable_area_expansion_parameters.avoid_linestring_types;
+  }
+  auto route_handler = std::make_shared<RouteHandler>(*msg);
+  if (route_ptr) {
+    route_handler->setRoute(*route_ptr);
+  }
+  const auto uncrossable_lines = drivable_area_expansion::createUncrossableLines(
+    *route_handler->getLaneletMapPtr(), uncrossable_types);
+
   const std::lock_guard<std::mutex> lock(mutex_pd_);
   map_ptr_ = msg;
-  has_received_map_ = true;
+  received_route_handler_ = route_handler;
+  received_uncrossable_lines_ = uncrossable_lines;
 }
 void BehaviorPathPlannerNode::onRoute(const LaneletRoute::ConstSharedPtr msg)
 {
@@ -23,17 +23,20 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace behavior_path_planner
 {
 
 PlannerManager::PlannerManager(
   rclcpp::Node & node, const std::shared_ptr<LaneFollowingParameters> & parameters,
-  const bool verbose)
+  const bool verbose, const int num_threads)
 : parameters_{parameters},
   logger_(node.get_logger().get_child("planner_manager")),
   clock_(*node.get_clock()),
-  verbose_{verbose}
+  processing_time_publisher_{std::make_unique<DebugPublisher>(&node, "~/debug/planner_manager")},
+  verbose_{verbose},
+  num_threads_{std::max(num_threads, 1)}
 {
   processing_time_.emplace("total_time", 0.0);
 }
@@ -105,8 +108,6 @@ BehaviorModuleOutput PlannerManager::run(const std::shared_ptr<PlannerData> & da
 boost::optional<SceneModulePtr> PlannerManager::getCandidateModule(
   const BehaviorModuleOutput & previous_module_output) const
 {
-  std::vector<std::pair<SceneModuleManagerPtr, SceneModulePtr>> request_modules{};
-
   const auto block_simultaneous_execution = [this]() {
     for (const auto & module_ptr : approved_module_ptrs_) {
       const auto itr = std::find_if(
@@ -122,6 +123,16 @@ boost::optional<SceneModulePtr> PlannerManager::getCandidateModule(
     return false;
   }();
 
+  // modules to push back as request modules, in the order of the managers. the execution request
+  // of the new modules is checked after all of them are picked up since they are independent.
+  struct RequestCandidate
+  {
+    SceneModuleManagerPtr manager_ptr;
+    SceneModulePtr module_ptr;
+    bool check_execution_request;
+  };
+  std::vector<RequestCandidate> request_candidates{};
+
   // pickup execution requested modules
   for (const auto & manager_ptr : manager_ptrs_) {
     stop_watch_.tic(manager_ptr->getModuleName());
@@ -153,10 +164,7 @@ boost::optional<SceneModulePtr> PlannerManager::getCandidateModule(
 
       // the module requests it to be launch. -> CAN LAUNCH THE MODULE. PUSH BACK AS REQUEST
       // MODULES.
-      const auto new_module_ptr = manager_ptr->getNewModule();
-      if (manager_ptr->isExecutionRequested(new_module_ptr, previous_module_output)) {
-        request_modules.emplace_back(manager_ptr, new_module_ptr);
-      }
+      request_candidates.push_back({manager_ptr, manager_ptr->getNewModule(), true});
 
       toc();
       continue;
@@ -172,8 +180,8 @@ boost::optional<SceneModulePtr> PlannerManager::getCandidateModule(
         manager_ptrs_.begin(), manager_ptrs_.end(),
         [&name](const auto & m) { return m->getModuleName() == name; });
       if (itr == manager_ptrs_.end()) {
-        request_modules.clear();
-        request_modules.emplace_back(*itr, candidate_module_opt_.get());
+        request_candidates.clear();
+        request_candidates.push_back({*itr, candidate_module_opt_.get(), false});
         toc();
         break;
       }
@@ -184,7 +192,7 @@ boost::optional<SceneModulePtr> PlannerManager::getCandidateModule(
       // the module launched as candidate and is running now. the module hasn't thrown any approval
       // yet. -> PUSH BACK AS REQUEST MODULES.
       if (candidate_module_opt_.get()->getCurrentStatus() == ModuleStatus::RUNNING) {
-        request_modules.emplace_back(manager_ptr, candidate_module_opt_.get());
+        request_candidates.push_back({manager_ptr, candidate_module_opt_.get(), false});
       } else {
         // TODO(Satoshi OTA) this line is no longer needed? think later.
         manager_ptr->deleteModules(candidate_module_opt_.get());
@@ -202,14 +210,36 @@ boost::optional<SceneModulePtr> PlannerManager::getCandidateModule(
     }
 
     // the module requests it to be launch. -> CAN LAUNCH THE MODULE. PUSH BACK AS REQUEST MODULES.
-    const auto new_module_ptr = manager_ptr->getNewModule();
-    if (!manager_ptr->isExecutionRequested(new_module_ptr, previous_module_output)) {
-      toc();
+    request_candidates.push_back({manager_ptr, manager_ptr->getNewModule(), true});
+
+    toc();
+  }
+
+  // each module only reads the planner data and the previous module output to decide whether it
+  // requests the execution, so the modules of different managers can be checked concurrently.
+  // the lanelets they read are those of the route handler map, whose centerlines are cached, and
+  // those kept by the module itself.
+  std::vector<char> is_execution_requested(request_candidates.size(), true);
+  std::vector<double> check_time(request_candidates.size(), 0.0);
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic)
+  for (size_t i = 0; i < request_candidates.size(); ++i) {
+    const auto & candidate = request_candidates.at(i);
+    if (!candidate.check_execution_request) {
       continue;
     }
+    StopWatch<std::chrono::milliseconds> stop_watch;
+    is_execution_requested.at(i) =
+      candidate.manager_ptr->isExecutionRequested(candidate.module_ptr, previous_module_output);
+    check_time.at(i) = stop_watch.toc(true);
+  }
 
-    toc();
-    request_modules.emplace_back(manager_ptr, new_module_ptr);
+  std::vector<std::pair<SceneModuleManagerPtr, SceneModulePtr>> request_modules{};
+  for (size_t i = 0; i < request_candidates.size(); ++i) {
+    const auto & candidate = request_candidates.at(i);
+    processing_time_.at(candidate.manager_ptr->getModuleName()) += check_time.at(i);
+    if (is_execution_requested.at(i)) {
+      request_modules.emplace_back(candidate.manager_ptr, candidate.module_ptr);
+    }
   }
 
   // select one module to run as candidate module.
@@ -455,4 +485,11 @@ void PlannerManager::print() const
   RCLCPP_INFO_STREAM(logger_, string_stream.str());
 }
 
+void PlannerManager::publishProcessingTime()
+{
+  for (const auto & t : processing_time_) {
+    processing_time_publisher_->publish<Float64Stamped>(t.first + "/processing_time_ms", t.second);
+  }
+}
+
 }  // namespace behavior_path_planner
@@ -297,6 +297,13 @@ void AvoidanceModule::fillAvoidanceTargetObjects(
       ? calcSignedArcLength(path_points, ego_pos, rh->getGoalPose().position)
       : std::numeric_limits<double>::max();
 
+  // the map related data of the objects is computed again only when the map changed
+  if (object_lanelet_data_map_.lock() != rh->getLaneletMapPtr()) {
+    object_lanelet_data_.clear();
+    object_lanelet_data_map_ = rh->getLaneletMapPtr();
+  }
+  ObjectLaneletDataMap object_lanelet_data;
+
   lanelet::ConstLineStrings3d debug_linestring;
   debug_linestring.clear();
   // for filtered objects
@@ -475,12 +482,11 @@ void AvoidanceModule::fillAvoidanceTargetObjects(
       continue;
     }
 
-    lanelet::ConstLanelet object_closest_lanelet;
-    const auto lanelet_map = rh->getLaneletMapPtr();
-    if (!lanelet::utils::query::getClosestLanelet(
-          lanelet::utils::query::laneletLayer(lanelet_map), object_pose, &object_closest_lanelet)) {
+    const auto object_lanelet = getObjectLaneletData(object, object_lanelet_data);
+    if (!object_lanelet) {
       continue;
     }
+    const auto & object_closest_lanelet = object_lanelet->closest_lanelet;
 
     lanelet::BasicPoint2d object_centroid(object_data.centroid.x(), object_data.centroid.y());
 
@@ -507,10 +513,7 @@ void AvoidanceModule::fillAvoidanceTargetObjects(
         continue;
       }
 
-      const auto centerline_pose =
-        lanelet::utils::getClosestCenterPose(object_closest_lanelet, object_pose.position);
-      lanelet::BasicPoint3d centerline_point(
-        centerline_pose.position.x, centerline_pose.position.y, centerline_pose.position.z);
+      fillObjectBoundaryDistance(*object_lanelet);
 
       // ============================================ <- most_left_lanelet.leftBound()
       // y              road shoulder
@@ -522,37 +525,17 @@ void AvoidanceModule::fillAvoidanceTargetObjects(
       // +: object position
       // o: nearest point on centerline
 
+      const auto arc_coordinates = toArcCoordinates(
+        to2D(object_closest_lanelet.centerline().basicLineString()), object_centroid);
+
       bool is_left_side_parked_vehicle = false;
       {
-        auto [object_shiftable_distance, sub_type] = [&]() {
-          const auto most_left_road_lanelet = rh->getMostLeftLanelet(object_closest_lanelet);
-          const auto most_left_lanelet_candidates =
-            rh->getLaneletMapPtr()->laneletLayer.findUsages(most_left_road_lanelet.leftBound());
-
-          lanelet::ConstLanelet most_left_lanelet = most_left_road_lanelet;
-          const lanelet::Attribute sub_type =
-            most_left_lanelet.attribute(lanelet::AttributeName::Subtype);
-
-          for (const auto & ll : most_left_lanelet_candidates) {
-            const lanelet::Attribute sub_type = ll.attribute(lanelet::AttributeName::Subtype);
-            if (sub_type.value() == "road_shoulder") {
-              most_left_lanelet = ll;
-            }
-          }
-
-          const auto center_to_left_boundary = distance2d(
-            to2D(most_left_lanelet.leftBound().basicLineString()), to2D(centerline_point));
-
-          return std::make_pair(
-            center_to_left_boundary - 0.5 * object.shape.dimensions.y, sub_type);
-        }();
-
-        if (sub_type.value() != "road_shoulder") {
+        auto object_shiftable_distance =
+          object_lanelet->center_to_left_boundary - 0.5 * object.shape.dimensions.y;
+        if (!object_lanelet->is_left_road_shoulder) {
           object_shiftable_distance += parameters_->object_check_min_road_shoulder_width;
         }
 
-        const auto arc_coordinates = toArcCoordinates(
-          to2D(object_closest_lanelet.centerline().basicLineString()), object_centroid);
         object_data.shiftable_ratio = arc_coordinates.distance / object_shiftable_distance;
 
         is_left_side_parked_vehicle =
@@ -561,35 +544,12 @@ void AvoidanceModule::fillAvoidanceTargetObjects(
 
       bool is_right_side_parked_vehicle = false;
       {
-        auto [object_shiftable_distance, sub_type] = [&]() {
-          const auto most_right_road_lanelet = rh->getMostRightLanelet(object_closest_lanelet);
-          const auto most_right_lanelet_candidates =
-            rh->getLaneletMapPtr()->laneletLayer.findUsages(most_right_road_lanelet.rightBound());
-
-          lanelet::ConstLanelet most_right_lanelet = most_right_road_lanelet;
-          const lanelet::Attribute sub_type =
-            most_right_lanelet.attribute(lanelet::AttributeName::Subtype);
-
-          for (const auto & ll : most_right_lanelet_candidates) {
-            const lanelet::Attribute sub_type = ll.attribute(lanelet::AttributeName::Subtype);
-            if (sub_type.value() == "road_shoulder") {
-              most_right_lanelet = ll;
-            }
-          }
-
-          const auto center_to_right_boundary = distance2d(
-            to2D(most_right_lanelet.rightBound().basicLineString()), to2D(centerline_point));
-
-          return std::make_pair(
-            center_to_right_boundary - 0.5 * object.shape.dimensions.y, sub_type);
-        }();
-
-        if (sub_type.value() != "road_shoulder") {
+        auto object_shiftable_distance =
+          object_lanelet->center_to_right_boundary - 0.5 * object.shape.dimensions.y;
+        if (!object_lanelet->is_right_road_shoulder) {
           object_shiftable_distance += parameters_->object_check_min_road_shoulder_width;
         }
 
-        const auto arc_coordinates = toArcCoordinates(
-          to2D(object_closest_lanelet.centerline().basicLineString()), object_centroid);
         object_data.shiftable_ratio = -1.0 * arc_coordinates.distance / object_shiftable_distance;
 
         is_right_side_parked_vehicle =
@@ -611,6 +571,9 @@ void AvoidanceModule::fillAvoidanceTargetObjects(
     data.target_objects.push_back(object_data);
   }
 
+  // keep the data of the objects checked in this cycle only
+  object_lanelet_data_ = std::move(object_lanelet_data);
+
   // debug
   {
     updateAvoidanceDebugData(avoidance_debug_msg_array);
@@ -694,6 +657,100 @@ void AvoidanceModule::fillObjectMovingTime(ObjectData & object_data) const
   }
 }
 
+ObjectLaneletData * AvoidanceModule::getObjectLaneletData(
+  const PredictedObject & object, ObjectLaneletDataMap & object_lanelet_data) const
+{
+  // NOTE: The closest lanelet can be different only when the object moves more than these.
+  constexpr double distance_tolerance = 0.1;
+  constexpr double yaw_tolerance = 0.05;
+
+  const auto & object_pose = object.kinematics.initial_pose_with_covariance.pose;
+  const auto id = util::getUuidStr(object);
+
+  const auto prev = object_lanelet_data_.find(id);
+  if (prev != object_lanelet_data_.end()) {
+    const auto & prev_pose = prev->second.pose;
+    const auto yaw_diff = tier4_autoware_utils::normalizeRadian(
+      tf2::getYaw(object_pose.orientation) - tf2::getYaw(prev_pose.orientation));
+    if (
+      calcDistance2d(prev_pose, object_pose) < distance_tolerance &&
+      std::abs(yaw_diff) < yaw_tolerance) {
+      return &(object_lanelet_data[id] = prev->second);
+    }
+  }
+
+  ObjectLaneletData data;
+  data.pose = object_pose;
+  const auto lanelet_map = planner_data_->route_handler->getLaneletMapPtr();
+  if (!lanelet::utils::query::getClosestLanelet(
+        lanelet::utils::query::laneletLayer(lanelet_map), object_pose, &data.closest_lanelet)) {
+    return nullptr;
+  }
+
+  return &(object_lanelet_data[id] = data);
+}
+
+void AvoidanceModule::fillObjectBoundaryDistance(ObjectLaneletData & object_lanelet_data) const
+{
+  using lanelet::geometry::distance2d;
+  using lanelet::utils::to2D;
+
+  if (object_lanelet_data.has_boundary_distance) {
+    return;
+  }
+
+  const auto & rh = planner_data_->route_handler;
+  const auto & object_closest_lanelet = object_lanelet_data.closest_lanelet;
+  const auto centerline_pose = lanelet::utils::getClosestCenterPose(
+    object_closest_lanelet, object_lanelet_data.pose.position);
+  lanelet::BasicPoint3d centerline_point(
+    centerline_pose.position.x, centerline_pose.position.y, centerline_pose.position.z);
+
+  {
+    const auto most_left_road_lanelet = rh->getMostLeftLanelet(object_closest_lanelet);
+    const auto most_left_lanelet_candidates =
+      rh->getLaneletMapPtr()->laneletLayer.findUsages(most_left_road_lanelet.leftBound());
+
+    lanelet::ConstLanelet most_left_lanelet = most_left_road_lanelet;
+    const lanelet::Attribute sub_type =
+      most_left_lanelet.attribute(lanelet::AttributeName::Subtype);
+
+    for (const auto & ll : most_left_lanelet_candidates) {
+      const lanelet::Attribute sub_type = ll.attribute(lanelet::AttributeName::Subtype);
+      if (sub_type.value() == "road_shoulder") {
+        most_left_lanelet = ll;
+      }
+    }
+
+    object_lanelet_data.center_to_left_boundary = distance2d(
+      to2D(most_left_lanelet.leftBound().basicLineString()), to2D(centerline_point));
+    object_lanelet_data.is_left_road_shoulder = sub_type.value() == "road_shoulder";
+  }
+
+  {
+    const auto most_right_road_lanelet = rh->getMostRightLanelet(object_closest_lanelet);
+    const auto most_right_lanelet_candidates =
+      rh->getLaneletMapPtr()->laneletLayer.findUsages(most_right_road_lanelet.rightBound());
+
+    lanelet::ConstLanelet most_right_lanelet = most_right_road_lanelet;
+    const lanelet::Attribute sub_type =
+      most_right_lanelet.attribute(lanelet::AttributeName::Subtype);
+
+    for (const auto & ll : most_right_lanelet_candidates) {
+      const lanelet::Attribute sub_type = ll.attribute(lanelet::AttributeName::Subtype);
+      if (sub_type.value() == "road_shoulder") {
+        most_right_lanelet = ll;
+      }
+    }
+
+    object_lanelet_data.center_to_right_boundary = distance2d(
+      to2D(most_right_lanelet.rightBound().basicLineString()), to2D(centerline_point));
+    object_lanelet_data.is_right_road_shoulder = sub_type.value() == "road_shoulder";
+  }
+
+  object_lanelet_data.has_boundary_distance = true;
+}
+
 void AvoidanceModule::fillShiftLine(AvoidancePlanningData & data, DebugData & debug) const
 {
   constexpr double AVOIDING_SHIFT_THR = 0.1;
@@ -1318,76 +1375,10 @@ AvoidLineArray AvoidanceModule::combineRawShiftLinesWithUniqueCheck(
 void AvoidanceModule::generateTotalShiftLine(
   const AvoidLineArray & avoid_lines, ShiftLineData & shift_line_data) const
 {
-  const auto & path = avoidance_data_.reference_path;
-  const auto & arcs = avoidance_data_.arclength_from_ego;
-  const auto N = path.points.size();
-
-  auto & sl = shift_line_data;
-
-  sl.shift_line = std::vector<double>(N, 0.0);
-  sl.shift_line_grad = std::vector<double>(N, 0.0);
-
-  sl.pos_shift_line = std::vector<double>(N, 0.0);
-  sl.neg_shift_line = std::vector<double>(N, 0.0);
-
-  sl.pos_shift_line_grad = std::vector<double>(N, 0.0);
-  sl.neg_shift_line_grad = std::vector<double>(N, 0.0);
-
-  // debug
-  sl.shift_line_history = std::vector<std::vector<double>>(avoid_lines.size(), sl.shift_line);
-
-  // take minmax for same directional shift length
-  for (size_t j = 0; j < avoid_lines.size(); ++j) {
-    const auto & al = avoid_lines.at(j);
-    for (size_t i = 0; i < N; ++i) {
-      // calc current interpolated shift
-      const auto i_shift = lerpShiftLengthOnArc(arcs.at(i), al);
-
-      // update maximum shift for positive direction
-      if (i_shift > sl.pos_shift_line.at(i)) {
-        sl.pos_shift_line.at(i) = i_shift;
-        sl.pos_shift_line_grad.at(i) = al.getGradient();
-      }
-
-      // update minumum shift for negative direction
-      if (i_shift < sl.neg_shift_line.at(i)) {
-        sl.neg_shift_line.at(i) = i_shift;
-        sl.neg_shift_line_grad.at(i) = al.getGradient();
-      }
-
-      // store for debug print
-      sl.shift_line_history.at(j).at(i) = i_shift;
-    }
-  }
-
-  // Merge shift length of opposite directions.
-  for (size_t i = 0; i < N; ++i) {
-    sl.shift_line.at(i) = sl.pos_shift_line.at(i) + sl.neg_shift_line.at(i);
-    sl.shift_line_grad.at(i) = sl.pos_shift_line_grad.at(i) + sl.neg_shift_line_grad.at(i);
-  }
-
-  // overwrite shift with current_ego_shift until ego pose.
-  const auto current_shift = getCurrentLinearShift();
-  for (size_t i = 0; i <= avoidance_data_.ego_closest_path_index; ++i) {
-    sl.shift_line.at(i) = current_shift;
-    sl.shift_line_grad.at(i) = 0.0;
-  }
-
-  // If the shift point does not have an associated object,
-  // use previous value.
-  for (size_t i = 1; i < N; ++i) {
-    bool has_object = false;
-    for (const auto & al : avoid_lines) {
-      if (al.start_idx <= i && i <= al.end_idx) {
-        has_object = true;
-        break;
-      }
-    }
-    if (!has_object) {
-      sl.shift_line.at(i) = sl.shift_line.at(i - 1);
-    }
-  }
-  sl.shift_line_history.push_back(sl.shift_line);
+  // the history of each shift line is used only for the debug print
+  fillTotalShiftLine(
+    avoid_lines, avoidance_data_.arclength_from_ego, avoidance_data_.ego_closest_path_index,
+    getCurrentLinearShift(), parameters_->print_debug_info, shift_line_data);
 }
 
 AvoidLineArray AvoidanceModule::extractShiftLinesFromLine(ShiftLineData & shift_line_data) const
@@ -1422,8 +1413,8 @@ AvoidLineArray AvoidanceModule::extractShiftLinesFromLine(ShiftLineData & shift_
 
   // calculate forward and backward gradient of the shift length.
   // This will be used for grad-change-point check.
-  sl.forward_grad = std::vector<double>(N, 0.0);
-  sl.backward_grad = std::vector<double>(N, 0.0);
+  sl.forward_grad.assign(N, 0.0);
+  sl.backward_grad.assign(N, 0.0);
   for (size_t i = 0; i < N - 1; ++i) {
     sl.forward_grad.at(i) = getFwdGrad(i);
     sl.backward_grad.at(i) = getBwdGrad(i);
@@ -1473,7 +1464,8 @@ AvoidLineArray AvoidanceModule::mergeShiftLines(
   const AvoidLineArray & raw_shift_lines, DebugData & debug) const
 {
   // Generate shift line by merging raw_shift_lines.
-  ShiftLineData shift_line_data;
+  // NOTE: The buffers of the shift line data are reused over the cycles.
+  auto & shift_line_data = shift_line_data_;
   generateTotalShiftLine(raw_shift_lines, shift_line_data);
 
   // Re-generate shift points by detecting gradient-change point of the shift line.
@@ -1495,7 +1487,7 @@ AvoidLineArray AvoidanceModule::mergeShiftLines(
   }
 
   // debug print
-  {
+  if (parameters_->print_debug_info) {
     const auto & arc = avoidance_data_.arclength_from_ego;
     const auto & closest = avoidance_data_.ego_closest_path_index;
     const auto & sl = shift_line_data.shift_line;
@@ -1529,7 +1521,8 @@ std::vector<size_t> AvoidanceModule::calcParentIds(
 {
   // Get the ID of the original AP whose transition area overlaps with the given AP,
   // and set it to the parent id.
-  std::set<uint64_t> ids;
+  using Uuid = decltype(child.object.object.object_id.uuid);
+  std::set<Uuid> overlapped_object_ids;
   for (const auto & al : parent_candidates) {
     const auto p_s = al.start_longitudinal;
     const auto p_e = al.end_longitudinal;
@@ -1539,19 +1532,22 @@ std::vector<size_t> AvoidanceModule::calcParentIds(
       continue;
     }
 
-    // Id the shift is overlapped, insert the shift point. Additionally, the shift which refers
-    // to the same object id (created by the same object) will be set.
-    //
-    // Why? : think that there are two shifts, avoiding and .
-    // If you register only the avoiding shift, the return-to-center shift will not be generated
-    // when you get too close to or over the obstacle. The return-shift can be handled with
-    // addReturnShift(), but it maybe reasonable to register the return-to-center shift for the
-    // object at the same time as registering the avoidance shift to remove the complexity of the
-    // addReturnShift().
-    for (const auto & al_local : parent_candidates) {
-      if (al_local.object.object.object_id == al.object.object.object_id) {
-        ids.insert(al_local.id);
-      }
+    overlapped_object_ids.insert(al.object.object.object_id.uuid);
+  }
+
+  // Id the shift is overlapped, insert the shift point. Additionally, the shift which refers
+  // to the same object id (created by the same object) will be set.
+  //
+  // Why? : think that there are two shifts, avoiding and .
+  // If you register only the avoiding shift, the return-to-center shift will not be generated
+  // when you get too close to or over the obstacle. The return-shift can be handled with
+  // addReturnShift(), but it maybe reasonable to register the return-to-center shift for the
+  // object at the same time as registering the avoidance shift to remove the complexity of the
+  // addReturnShift().
+  std::set<uint64_t> ids;
+  for (const auto & al : parent_candidates) {
+    if (overlapped_object_ids.count(al.object.object.object_id.uuid) != 0) {
+      ids.insert(al.id);
     }
   }
   return std::vector<size_t>(ids.begin(), ids.end());
@@ -1743,7 +1739,6 @@ void AvoidanceModule::trimSimilarGradShiftLine(
       DEBUG_PRINT("use this point. has_large_length_change = %d", has_large_length_change);
     } else {
       avoid_lines.back() = combined_al;  // Update the last points by merging the current point
-      being_merged_points.push_back(al_prev);
       DEBUG_PRINT("trim! has_large_length_change = %d", has_large_length_change);
     }
   }
@@ -375,7 +375,7 @@ std::pair<bool, bool> ExternalRequestLaneChangeModule::getSafePath(
   const auto [found_valid_path, found_safe_path] = lane_change_utils::getLaneChangePaths(
     *route_handler, current_lanes, lane_change_lanes, current_pose, current_twist,
     planner_data_->dynamic_object, common_parameters, *parameters_, check_distance, &valid_paths,
-    &object_debug_);
+    &object_debug_, planner_data_->predicted_object_footprints);
   debug_valid_path_ = valid_paths;
 
   if (parameters_->publish_debug_marker) {
@@ -678,7 +678,7 @@ bool ExternalRequestLaneChangeModule::isApprovedPathSafe(Pose & ego_pose_before_
     path, dynamic_objects, dynamic_object_indices, current_pose, current_seg_idx, current_twist,
     common_parameters, *parameters_, common_parameters.expected_front_deceleration_for_abort,
     common_parameters.expected_rear_deceleration_for_abort, ego_pose_before_collision, debug_data,
-    status_.lane_change_path.acceleration);
+    status_.lane_change_path.acceleration, planner_data_->predicted_object_footprints);
 }
 
 void ExternalRequestLaneChangeModule::updateOutputTurnSignal(BehaviorModuleOutput & output)
@@ -464,12 +464,12 @@ std::pair<bool, bool> LaneChangeModule::getSafePath(
   const auto [found_valid_path, found_safe_path] = lane_change_utils::getLaneChangePaths(
     *route_handler, current_lanes, lane_change_lanes, current_pose, current_twist,
     planner_data_->dynamic_object, common_parameters, *parameters_, check_distance, &valid_paths,
-    &object_debug_);
+    &object_debug_, planner_data_->predicted_object_footprints);
 #else
   const auto [found_valid_path, found_safe_path] = lane_change_utils::getLaneChangePaths(
     *getPreviousModuleOutput().path, *route_handler, current_lanes, lane_change_lanes, current_pose,
     current_twist, planner_data_->dynamic_object, common_parameters, *parameters_, check_distance,
-    &valid_paths, &object_debug_);
+    &valid_paths, &object_debug_, planner_data_->predicted_object_footprints);
 #endif
   debug_valid_path_ = valid_paths;
 
@@ -780,7 +780,7 @@ bool LaneChangeModule::isApprovedPathSafe(Pose & ego_pose_before_collision) cons
     path, dynamic_objects, dynamic_object_indices, current_pose, current_seg_idx, current_twist,
     common_parameters, *parameters_, common_parameters.expected_front_deceleration_for_abort,
     common_parameters.expected_rear_deceleration_for_abort, ego_pose_before_collision, debug_data,
-    status_.lane_change_path.acceleration);
+    status_.lane_change_path.acceleration, planner_data_->predicted_object_footprints);
 }
 
 void LaneChangeModule::updateOutputTurnSignal(BehaviorModuleOutput & output)
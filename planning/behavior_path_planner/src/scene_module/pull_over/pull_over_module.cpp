@@ -166,12 +166,29 @@ void PullOverModule::onTimer()
   std::vector<PullOverPath> path_candidates{};
   std::optional<Pose> closest_start_pose{};
   double min_start_arc_length = std::numeric_limits<double>::max();
-  const auto planCandidatePaths = [&](
-                                    const std::shared_ptr<PullOverPlannerBase> & planner,
-                                    const GoalCandidate & goal_candidate) {
+
+  // each planner plans for all the goal candidates on its own thread, since a planner keeps its
+  // state while planning. the planners share the road and shoulder lanes, whose centerlines are
+  // cached first
+  util::cacheCenterlines(current_lanes);
+  util::cacheCenterlines(pull_over_utils::getPullOverLanes(*planner_data_->route_handler));
+  std::vector<std::vector<boost::optional<PullOverPath>>> planned_paths(
+    pull_over_planners_.size(), std::vector<boost::optional<PullOverPath>>(goal_candidates.size()));
+#pragma omp parallel for num_threads(parameters_->lane_parking_num_threads) schedule(dynamic)
+  for (size_t planner_idx = 0; planner_idx < pull_over_planners_.size(); ++planner_idx) {
+    const auto & planner = pull_over_planners_.at(planner_idx);
     planner->setPlannerData(planner_data_);
-    auto pull_over_path = planner->plan(goal_candidate.goal_pose);
-    pull_over_path->goal_id = goal_candidate.id;
+    for (size_t goal_idx = 0; goal_idx < goal_candidates.size(); ++goal_idx) {
+      auto & pull_over_path = planned_paths.at(planner_idx).at(goal_idx);
+      pull_over_path = planner->plan(goal_candidates.at(goal_idx).goal_pose);
+      if (pull_over_path) {
+        pull_over_path->goal_id = goal_candidates.at(goal_idx).id;
+      }
+    }
+  }
+
+  const auto addCandidatePath = [&](const size_t planner_idx, const size_t goal_idx) {
+    const auto & pull_over_path = planned_paths.at(planner_idx).at(goal_idx);
     if (pull_over_path) {
       path_candidates.push_back(*pull_over_path);
       // calculate closest pull over start pose for stop path
@@ -185,17 +202,17 @@ void PullOverModule::onTimer()
     }
   };
 
-  // plan candidate paths and set them to the member variable
+  // set the candidate paths in the order of the priority
   if (parameters_->search_priority == "efficient_path") {
-    for (const auto & planner : pull_over_planners_) {
-      for (const auto & goal_candidate : goal_candidates) {
-        planCandidatePaths(planner, goal_candidate);
+    for (size_t planner_idx = 0; planner_idx < pull_over_planners_.size(); ++planner_idx) {
+      for (size_t goal_idx = 0; goal_idx < goal_candidates.size(); ++goal_idx) {
+        addCandidatePath(planner_idx, goal_idx);
       }
     }
   } else if (parameters_->search_priority == "close_goal") {
-    for (const auto & goal_candidate : goal_candidates) {
-      for (const auto & planner : pull_over_planners_) {
-        planCandidatePaths(planner, goal_candidate);
+    for (size_t goal_idx = 0; goal_idx < goal_candidates.size(); ++goal_idx) {
+      for (size_t planner_idx = 0; planner_idx < pull_over_planners_.size(); ++planner_idx) {
+        addCandidatePath(planner_idx, goal_idx);
       }
     }
   } else {
@@ -285,6 +302,7 @@ void PullOverModule::onEntry()
       planner_data_->parameters.base_link2rear + margin;
     occupancy_grid_map_param.theta_size = parameters_->theta_size;
     occupancy_grid_map_param.obstacle_threshold = parameters_->obstacle_threshold;
+    occupancy_grid_map_param.use_distance_field = parameters_->use_occupancy_grid_distance_field;
     occupancy_grid_map_->setParam(occupancy_grid_map_param);
   }
 
@@ -446,10 +464,10 @@ bool PullOverModule::planFreespacePath()
     }
     freespace_planner_->setPlannerData(planner_data_);
     auto freespace_path = freespace_planner_->plan(goal_candidate.goal_pose);
-    freespace_path->goal_id = goal_candidate.id;
     if (!freespace_path) {
       continue;
     }
+    freespace_path->goal_id = goal_candidate.id;
     mutex_.lock();
     status_.pull_over_path = std::make_shared<PullOverPath>(*freespace_path);
     status_.current_path_idx = 0;
@@ -604,6 +604,96 @@ double lerpShiftLengthOnArc(double arc, const AvoidLine & ap)
   return 0.0;
 }
 
+void fillTotalShiftLine(
+  const AvoidLineArray & avoid_lines, const std::vector<double> & arcs,
+  const size_t ego_closest_index, const double current_shift, const bool store_history,
+  ShiftLineData & shift_line_data)
+{
+  const auto N = arcs.size();
+
+  auto & sl = shift_line_data;
+
+  sl.shift_line.assign(N, 0.0);
+  sl.shift_line_grad.assign(N, 0.0);
+
+  sl.pos_shift_line.assign(N, 0.0);
+  sl.neg_shift_line.assign(N, 0.0);
+
+  sl.pos_shift_line_grad.assign(N, 0.0);
+  sl.neg_shift_line_grad.assign(N, 0.0);
+
+  // debug
+  sl.shift_line_history.clear();
+  if (store_history) {
+    sl.shift_line_history.assign(avoid_lines.size(), sl.shift_line);
+  }
+
+  // the number of the shift lines covering the point increases by this from the previous point
+  std::vector<int> num_covering_lines_diff(N + 1, 0);
+
+  // take minmax for same directional shift length
+  for (size_t j = 0; j < avoid_lines.size(); ++j) {
+    const auto & al = avoid_lines.at(j);
+
+    // the interpolated shift is zero out of [start_longitudinal, end_longitudinal)
+    const auto begin = std::lower_bound(arcs.begin(), arcs.end(), al.start_longitudinal);
+    const auto end = std::lower_bound(begin, arcs.end(), al.end_longitudinal);
+    for (auto i = static_cast<size_t>(begin - arcs.begin());
+         i < static_cast<size_t>(end - arcs.begin()); ++i) {
+      // calc current interpolated shift
+      const auto i_shift = lerpShiftLengthOnArc(arcs.at(i), al);
+
+      // update maximum shift for positive direction
+      if (i_shift > sl.pos_shift_line.at(i)) {
+        sl.pos_shift_line.at(i) = i_shift;
+        sl.pos_shift_line_grad.at(i) = al.getGradient();
+      }
+
+      // update minumum shift for negative direction
+      if (i_shift < sl.neg_shift_line.at(i)) {
+        sl.neg_shift_line.at(i) = i_shift;
+        sl.neg_shift_line_grad.at(i) = al.getGradient();
+      }
+
+      // store for debug print
+      if (store_history) {
+        sl.shift_line_history.at(j).at(i) = i_shift;
+      }
+    }
+
+    if (al.start_idx <= al.end_idx && al.start_idx < N) {
+      num_covering_lines_diff.at(al.start_idx)++;
+      num_covering_lines_diff.at(std::min(al.end_idx, N - 1) + 1)--;
+    }
+  }
+
+  // Merge shift length of opposite directions.
+  for (size_t i = 0; i < N; ++i) {
+    sl.shift_line.at(i) = sl.pos_shift_line.at(i) + sl.neg_shift_line.at(i);
+    sl.shift_line_grad.at(i) = sl.pos_shift_line_grad.at(i) + sl.neg_shift_line_grad.at(i);
+  }
+
+  // overwrite shift with current_ego_shift until ego pose.
+  for (size_t i = 0; i <= ego_closest_index; ++i) {
+    sl.shift_line.at(i) = current_shift;
+    sl.shift_line_grad.at(i) = 0.0;
+  }
+
+  // If the shift point does not have an associated object,
+  // use previous value.
+  int num_covering_lines = N > 0 ? num_covering_lines_diff.front() : 0;
+  for (size_t i = 1; i < N; ++i) {
+    num_covering_lines += num_covering_lines_diff.at(i);
+    if (num_covering_lines == 0) {
+      sl.shift_line.at(i) = sl.shift_line.at(i - 1);
+    }
+  }
+
+  if (store_history) {
+    sl.shift_line_history.push_back(sl.shift_line);
+  }
+}
+
 void clipByMinStartIdx(const AvoidLineArray & shift_lines, PathWithLaneId & path)
 {
   if (path.points.empty()) {
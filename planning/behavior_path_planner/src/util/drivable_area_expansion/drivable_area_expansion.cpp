@@ -31,14 +31,24 @@ void expandDrivableArea(
   const lanelet::ConstLanelets & path_lanes)
 {
   const auto uncrossable_lines =
-    extractUncrossableLines(*route_handler.getLaneletMapPtr(), params.avoid_linestring_types);
+    createUncrossableLines(*route_handler.getLaneletMapPtr(), params.avoid_linestring_types);
+  expandDrivableArea(
+    path, params, dynamic_objects, route_handler, path_lanes, uncrossable_lines->segments);
+}
+
+void expandDrivableArea(
+  PathWithLaneId & path, const DrivableAreaExpansionParameters & params,
+  const PredictedObjects & dynamic_objects, const route_handler::RouteHandler & route_handler,
+  const lanelet::ConstLanelets & path_lanes, const SegmentRtree & uncrossable_segments)
+{
   const auto path_footprints = createPathFootprints(path, params);
   const auto predicted_paths = createObjectFootprints(dynamic_objects, params);
   const auto expansion_polygons =
     params.expansion_method == "lanelet"
       ? createExpansionLaneletPolygons(
           path_lanes, route_handler, path_footprints, predicted_paths, params)
-      : createExpansionPolygons(path, path_footprints, predicted_paths, uncrossable_lines, params);
+      : createExpansionPolygons(
+          path, path_footprints, predicted_paths, uncrossable_segments, params);
   const auto expanded_drivable_area = createExpandedDrivableAreaPolygon(path, expansion_polygons);
   updateDrivableAreaBounds(path, expanded_drivable_area);
 }
@@ -59,13 +69,18 @@ polygon_t createExpandedDrivableAreaPolygon(
 
   multipolygon_t unions;
   auto expanded_da_poly = original_da_poly;
+  auto expanded_da_box = boost::geometry::return_envelope<box_t>(expanded_da_poly);
   for (const auto & p : expansion_polygons) {
+    const auto box = boost::geometry::return_envelope<box_t>(p);
+    // a polygon disjoint from the drivable area would not produce a single polygon union
+    if (boost::geometry::disjoint(expanded_da_box, box)) continue;
     unions.clear();
     boost::geometry::union_(expanded_da_poly, p, unions);
     if (unions.size() != 1)  // union of overlapping polygons should produce a single polygon
       continue;
     else
       expanded_da_poly = unions[0];
+    boost::geometry::expand(expanded_da_box, box);
   }
   return expanded_da_poly;
 }
@@ -22,17 +22,23 @@ namespace drivable_area_expansion
 
 double calculateDistanceLimit(
   const linestring_t & base_ls, const polygon_t & expansion_polygon,
-  const multilinestring_t & limit_lines)
+  const SegmentRtree & limit_segments)
 {
   auto dist_limit = std::numeric_limits<double>::max();
-  boost::geometry::for_each_point(limit_lines, [&](const auto & point) {
-    if (boost::geometry::within(point, expansion_polygon))
-      dist_limit = std::min(dist_limit, boost::geometry::distance(point, base_ls));
-  });
+  std::vector<segment_t> candidates;
+  limit_segments.query(bgi::intersects(expansion_polygon), std::back_inserter(candidates));
   multipoint_t intersections;
-  boost::geometry::intersection(expansion_polygon, limit_lines, intersections);
-  for (const auto & p : intersections)
-    dist_limit = std::min(dist_limit, boost::geometry::distance(p, base_ls));
+  for (const auto & candidate : candidates) {
+    // need conversion to a linestring to use the 'intersection' function
+    const auto ls = linestring_t{candidate.first, candidate.second};
+    for (const auto & p : ls)
+      if (boost::geometry::within(p, expansion_polygon))
+        dist_limit = std::min(dist_limit, boost::geometry::distance(p, base_ls));
+    intersections.clear();
+    boost::geometry::intersection(expansion_polygon, ls, intersections);
+    for (const auto & p : intersections)
+      dist_limit = std::min(dist_limit, boost::geometry::distance(p, base_ls));
+  }
   return dist_limit;
 }
 
@@ -41,7 +47,11 @@ double calculateDistanceLimit(
   const multipolygon_t & limit_polygons)
 {
   auto dist_limit = std::numeric_limits<double>::max();
+  const auto expansion_box = boost::geometry::return_envelope<box_t>(expansion_polygon);
   for (const auto & polygon : limit_polygons) {
+    // polygons with disjoint envelopes have no point within nor intersection with the expansion
+    if (boost::geometry::disjoint(expansion_box, boost::geometry::return_envelope<box_t>(polygon)))
+      continue;
     for (const auto & p : polygon.outer()) {
       if (boost::geometry::within(p, expansion_polygon)) {
         dist_limit = std::min(dist_limit, boost::geometry::distance(p, base_ls));
@@ -103,11 +113,11 @@ std::array<double, 3> calculate_arc_length_range_and_distance(
 
 polygon_t create_compensation_polygon(
   const linestring_t & base_ls, const double compensation_dist, const bool is_left,
-  const multilinestring_t uncrossable_lines, const multipolygon_t & predicted_paths)
+  const SegmentRtree & uncrossable_segments, const multipolygon_t & predicted_paths)
 {
   polygon_t compensation_polygon = createExpansionPolygon(base_ls, compensation_dist, !is_left);
   double dist_limit = std::min(
-    compensation_dist, calculateDistanceLimit(base_ls, compensation_polygon, uncrossable_lines));
+    compensation_dist, calculateDistanceLimit(base_ls, compensation_polygon, uncrossable_segments));
   if (!predicted_paths.empty())
     dist_limit =
       std::min(dist_limit, calculateDistanceLimit(base_ls, compensation_polygon, predicted_paths));
@@ -118,7 +128,7 @@ polygon_t create_compensation_polygon(
 
 multipolygon_t createExpansionPolygons(
   const PathWithLaneId & path, const multipolygon_t & path_footprints,
-  const multipolygon_t & predicted_paths, const multilinestring_t & uncrossable_lines,
+  const multipolygon_t & predicted_paths, const SegmentRtree & uncrossable_segments,
   const DrivableAreaExpansionParameters & params)
 {
   linestring_t path_ls;
@@ -148,14 +158,14 @@ multipolygon_t createExpansionPolygons(
         auto expansion_polygon = createExpansionPolygon(base_ls, expansion_dist, is_left);
         auto limited_dist = expansion_dist;
         const auto uncrossable_dist_limit =
-          calculateDistanceLimit(base_ls, expansion_polygon, uncrossable_lines);
+          calculateDistanceLimit(base_ls, expansion_polygon, uncrossable_segments);
         if (uncrossable_dist_limit < limited_dist) {
           limited_dist = uncrossable_dist_limit;
           if (params.compensate_uncrossable_lines) {
             const auto compensation_dist =
               footprint_dist - limited_dist + params.compensate_extra_dist;
             expansion_polygons.push_back(create_compensation_polygon(
-              base_ls, compensation_dist, is_left, uncrossable_lines, predicted_paths));
+              base_ls, compensation_dist, is_left, uncrossable_segments, predicted_paths));
           }
         }
         limited_dist = std::min(
@@ -26,19 +26,21 @@
 
 namespace drivable_area_expansion
 {
-multilinestring_t extractUncrossableLines(
+std::shared_ptr<const UncrossableLines> createUncrossableLines(
   const lanelet::LaneletMap & lanelet_map, const std::vector<std::string> & uncrossable_types)
 {
-  multilinestring_t lines;
-  linestring_t line;
+  std::vector<segment_t> segments;
   for (const auto & ls : lanelet_map.lineStringLayer) {
     if (hasTypes(ls, uncrossable_types)) {
-      line.clear();
-      for (const auto & p : ls) line.push_back(point_t{p.x(), p.y()});
-      lines.push_back(line);
+      for (size_t i = 0; i + 1 < ls.size(); ++i)
+        segments.emplace_back(point_t{ls[i].x(), ls[i].y()}, point_t{ls[i + 1].x(), ls[i + 1].y()});
     }
   }
-  return lines;
+  auto uncrossable_lines = std::make_shared<UncrossableLines>();
+  uncrossable_lines->types = uncrossable_types;
+  // the packing constructor builds a better balanced tree than successive insertions
+  uncrossable_lines->segments = SegmentRtree(segments);
+  return uncrossable_lines;
 }
 
 bool hasTypes(const lanelet::ConstLineString3d & ls, const std::vector<std::string> & types)
@@ -0,0 +1,65 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "behavior_path_planner/util/footprint_cache/footprint_cache.hpp"
+
+#include "behavior_path_planner/utilities.hpp"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace behavior_path_planner
+{
+const std::vector<PredictedPath> & PredictedObjectFootprintCache::getPredictedPaths(
+  const size_t object_index, const bool use_all_predicted_path)
+{
+  const std::lock_guard<std::mutex> lock(mutex_);
+  const auto key = std::make_pair(object_index, use_all_predicted_path);
+  auto paths = predicted_paths_.find(key);
+  if (paths == predicted_paths_.end()) {
+    paths = predicted_paths_
+              .emplace(
+                key, util::getPredictedPathFromObj(
+                       objects_->objects.at(object_index), use_all_predicted_path))
+              .first;
+  }
+  return paths->second;
+}
+
+const PredictedObjectFootprint & PredictedObjectFootprintCache::getFootprint(
+  const size_t object_index, const bool use_all_predicted_path, const size_t path_index,
+  const double time)
+{
+  const auto key = std::make_tuple(object_index, use_all_predicted_path, path_index, time);
+  {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    const auto footprint = footprints_.find(key);
+    if (footprint != footprints_.end()) {
+      return footprint->second;
+    }
+  }
+
+  // interpolate out of the lock, the elements of std::map stay where they are
+  const auto & object = objects_->objects.at(object_index);
+  const auto & path = getPredictedPaths(object_index, use_all_predicted_path).at(path_index);
+  PredictedObjectFootprint footprint;
+  footprint.pose = object.kinematics.initial_pose_with_covariance.pose;
+  util::getObjectExpectedPoseAndConvertToPolygon(
+    path, object, footprint.polygon, time, footprint.pose, footprint.failed_reason);
+
+  const std::lock_guard<std::mutex> lock(mutex_);
+  return footprints_.emplace(key, std::move(footprint)).first->second;
+}
+}  // namespace behavior_path_planner
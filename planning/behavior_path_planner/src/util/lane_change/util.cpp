@@ -33,7 +33,10 @@
 #include <algorithm>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace
@@ -261,7 +264,8 @@ std::pair<bool, bool> getLaneChangePaths(
   const PredictedObjects::ConstSharedPtr dynamic_objects,
   const BehaviorPathPlannerParameters & common_parameter, const LaneChangeParameters & parameter,
   const double check_distance, LaneChangePaths * candidate_paths,
-  std::unordered_map<std::string, CollisionCheckDebug> * debug_data)
+  std::unordered_map<std::string, CollisionCheckDebug> * debug_data,
+  const std::shared_ptr<PredictedObjectFootprintCache> & footprint_cache)
 #else
 std::pair<bool, bool> getLaneChangePaths(
   const PathWithLaneId & original_path, const RouteHandler & route_handler,
@@ -269,7 +273,8 @@ std::pair<bool, bool> getLaneChangePaths(
   const Pose & pose, const Twist & twist, const PredictedObjects::ConstSharedPtr dynamic_objects,
   const BehaviorPathPlannerParameters & common_parameter, const LaneChangeParameters & parameter,
   const double check_distance, LaneChangePaths * candidate_paths,
-  std::unordered_map<std::string, CollisionCheckDebug> * debug_data)
+  std::unordered_map<std::string, CollisionCheckDebug> * debug_data,
+  const std::shared_ptr<PredictedObjectFootprintCache> & footprint_cache)
 #endif
 {
   debug_data->clear();
@@ -328,7 +333,8 @@ std::pair<bool, bool> getLaneChangePaths(
 
   LaneChangeTargetObjectIndices dynamic_object_indices;
 
-  candidate_paths->reserve(lane_change_sampling_num);
+  // the sampled accelerations, from no deceleration to the maximum one
+  std::vector<double> accelerations;
   for (double acceleration = 0.0; acceleration >= -maximum_deceleration;
        acceleration -= acceleration_resolution) {
     const double prepare_speed = current_velocity + acceleration * prepare_duration;
@@ -346,6 +352,15 @@ std::pair<bool, bool> getLaneChangePaths(
     if (prepare_distance < target_distance) {
       break;
     }
+    accelerations.push_back(acceleration);
+  }
+
+  // a valid candidate path for an acceleration, if any
+  const auto generateCandidatePath = [&](const double acceleration) {
+    const double prepare_speed = current_velocity + acceleration * prepare_duration;
+    const double prepare_distance = std::max(
+      current_velocity * prepare_duration + 0.5 * acceleration * std::pow(prepare_duration, 2),
+      minimum_prepare_distance);
 
 #ifdef USE_OLD_ARCHITECTURE
     const auto prepare_segment = getPrepareSegment(
@@ -357,6 +372,13 @@ std::pair<bool, bool> getLaneChangePaths(
       std::max(prepare_speed, minimum_lane_change_velocity));
 #endif
 
+    if (prepare_segment.points.empty()) {
+      RCLCPP_ERROR_STREAM(
+        rclcpp::get_logger("behavior_path_planner").get_child("lane_change").get_child("util"),
+        "reference path is empty!! something wrong...");
+      return std::optional<LaneChangePath>{};
+    }
+
     const auto estimated_shift_length = lanelet::utils::getLateralDistanceToClosestLanelet(
       target_lanelets, prepare_segment.points.front().point.pose);
 
@@ -370,11 +392,11 @@ std::pair<bool, bool> getLaneChangePaths(
       route_handler, target_lanelets, forward_path_length, arc_position_from_target.length,
       target_lane_length, lc_dist, lane_changing_speed, required_total_min_distance);
 
-    if (prepare_segment.points.empty() || lane_changing_segment.points.empty()) {
+    if (lane_changing_segment.points.empty()) {
       RCLCPP_ERROR_STREAM(
         rclcpp::get_logger("behavior_path_planner").get_child("lane_change").get_child("util"),
         "reference path is empty!! something wrong...");
-      continue;
+      return std::optional<LaneChangePath>{};
     }
 
     const auto & lane_changing_start_pose = prepare_segment.points.back().point.pose;
@@ -388,7 +410,7 @@ std::pair<bool, bool> getLaneChangePaths(
       is_goal_in_route);
 
     if (target_lane_reference_path.points.empty()) {
-      continue;
+      return std::optional<LaneChangePath>{};
     }
 
     const auto shift_line = getLaneChangingShiftLine(
@@ -402,7 +424,7 @@ std::pair<bool, bool> getLaneChangePaths(
       parameter);
 
     if (!candidate_path) {
-      continue;
+      return std::optional<LaneChangePath>{};
     }
 
     const auto is_valid = hasEnoughDistance(
@@ -410,31 +432,92 @@ std::pair<bool, bool> getLaneChangePaths(
       common_parameter.minimum_lane_change_length);
 
     if (!is_valid) {
-      continue;
+      return std::optional<LaneChangePath>{};
     }
+    return candidate_path;
+  };
 
-    if (candidate_paths->empty()) {
-      // only compute dynamic object indices once
-      const auto backward_lanes = lane_change_utils::getExtendedTargetLanesForCollisionCheck(
-        route_handler, target_lanelets.front(), pose, check_distance);
-      dynamic_object_indices = filterObjectIndices(
-        {*candidate_path}, *dynamic_objects, backward_lanes, pose,
-        common_parameter.forward_path_length, lateral_buffer, ignore_unknown);
-    }
-    candidate_paths->push_back(*candidate_path);
+  // only compute dynamic object indices once, for the first valid candidate path
+  const auto filterDynamicObjectIndices = [&](const LaneChangePath & candidate_path) {
+    const auto backward_lanes = lane_change_utils::getExtendedTargetLanesForCollisionCheck(
+      route_handler, target_lanelets.front(), pose, check_distance);
+    return filterObjectIndices(
+      {candidate_path}, *dynamic_objects, backward_lanes, pose,
+      common_parameter.forward_path_length, lateral_buffer, ignore_unknown);
+  };
 
+  const auto isSafe = [&](
+                        const LaneChangePath & candidate_path, Pose & ego_pose_before_collision,
+                        std::unordered_map<std::string, CollisionCheckDebug> & debug_data) {
     const auto current_seg_idx = motion_utils::findFirstNearestSegmentIndexWithSoftConstraints(
-      candidate_path->path.points, pose, common_parameter.ego_nearest_dist_threshold,
+      candidate_path.path.points, pose, common_parameter.ego_nearest_dist_threshold,
       common_parameter.ego_nearest_yaw_threshold);
 
-    const auto is_safe = isLaneChangePathSafe(
-      *candidate_path, dynamic_objects, dynamic_object_indices, pose, current_seg_idx, twist,
+    return isLaneChangePathSafe(
+      candidate_path, dynamic_objects, dynamic_object_indices, pose, current_seg_idx, twist,
       common_parameter, parameter, common_parameter.expected_front_deceleration,
-      common_parameter.expected_rear_deceleration, ego_pose_before_collision, *debug_data,
-      acceleration);
+      common_parameter.expected_rear_deceleration, ego_pose_before_collision, debug_data,
+      candidate_path.acceleration, footprint_cache);
+  };
 
-    if (is_valid && is_safe) {
-      return {true, true};
+  candidate_paths->reserve(lane_change_sampling_num);
+  if (parameter.lane_change_num_threads <= 1) {
+    // generate and check the candidate paths one by one, until a safe one is found
+    for (const auto acceleration : accelerations) {
+      const auto candidate_path = generateCandidatePath(acceleration);
+      if (!candidate_path) {
+        continue;
+      }
+
+      if (candidate_paths->empty()) {
+        dynamic_object_indices = filterDynamicObjectIndices(*candidate_path);
+      }
+      candidate_paths->push_back(*candidate_path);
+
+      if (isSafe(*candidate_path, ego_pose_before_collision, *debug_data)) {
+        return {true, true};
+      }
+    }
+  } else {
+    // generate and check all the candidate paths on the threads, then take them in the order of
+    // the accelerations until the first safe one, which gives the same result as the serial mode
+    util::cacheCenterlines(original_lanelets);
+    util::cacheCenterlines(target_lanelets);
+    std::vector<std::optional<LaneChangePath>> sampled_paths(accelerations.size());
+#pragma omp parallel for num_threads(parameter.lane_change_num_threads) schedule(dynamic)
+    for (size_t i = 0; i < accelerations.size(); ++i) {
+      sampled_paths.at(i) = generateCandidatePath(accelerations.at(i));
+    }
+
+    std::vector<LaneChangePath> valid_paths;
+    for (auto & sampled_path : sampled_paths) {
+      if (sampled_path) {
+        valid_paths.push_back(std::move(*sampled_path));
+      }
+    }
+    if (valid_paths.empty()) {
+      return {false, false};
+    }
+    dynamic_object_indices = filterDynamicObjectIndices(valid_paths.front());
+
+    std::vector<char> is_safe(valid_paths.size(), false);
+    std::vector<std::unordered_map<std::string, CollisionCheckDebug>> path_debug_data(
+      valid_paths.size());
+    std::vector<Pose> ego_poses_before_collision(valid_paths.size(), ego_pose_before_collision);
+#pragma omp parallel for num_threads(parameter.lane_change_num_threads) schedule(dynamic)
+    for (size_t i = 0; i < valid_paths.size(); ++i) {
+      is_safe.at(i) =
+        isSafe(valid_paths.at(i), ego_poses_before_collision.at(i), path_debug_data.at(i));
+    }
+
+    for (size_t i = 0; i < valid_paths.size(); ++i) {
+      for (auto & [key, debug] : path_debug_data.at(i)) {
+        (*debug_data)[key] = std::move(debug);
+      }
+      candidate_paths->push_back(std::move(valid_paths.at(i)));
+      if (is_safe.at(i)) {
+        return {true, true};
+      }
     }
   }
 
@@ -492,7 +575,8 @@ bool isLaneChangePathSafe(
   const BehaviorPathPlannerParameters & common_parameters,
   const LaneChangeParameters & lane_change_parameters, const double front_decel,
   const double rear_decel, Pose & ego_pose_before_collision,
-  std::unordered_map<std::string, CollisionCheckDebug> & debug_data, const double acceleration)
+  std::unordered_map<std::string, CollisionCheckDebug> & debug_data, const double acceleration,
+  const std::shared_ptr<PredictedObjectFootprintCache> & footprint_cache)
 {
   if (dynamic_objects == nullptr) {
     return true;
@@ -567,11 +651,34 @@ bool isLaneChangePathSafe(
     }
   }
 
+  // share the object footprints with the other checks of the cycle when they are of its objects
+  const bool use_footprint_cache =
+    footprint_cache && footprint_cache->objects() == dynamic_objects;
+  const auto & use_all_predicted_path = lane_change_parameters.use_all_predicted_path;
+
   for (const auto & i : in_lane_object_indices) {
     const auto & obj = dynamic_objects->objects.at(i);
     auto current_debug_data = assignDebugData(obj);
-    const auto predicted_paths =
-      util::getPredictedPathFromObj(obj, lane_change_parameters.use_all_predicted_path);
+    if (use_footprint_cache) {
+      const auto & predicted_paths = footprint_cache->getPredictedPaths(i, use_all_predicted_path);
+      for (size_t path_index = 0; path_index < predicted_paths.size(); ++path_index) {
+        const auto getObjectFootprint = [&](const double time) -> const auto & {
+          return footprint_cache->getFootprint(i, use_all_predicted_path, path_index, time);
+        };
+        if (!util::isSafeInLaneletCollisionCheck(
+              interpolated_ego, current_twist, check_durations, lane_change_path.duration.prepare,
+              obj, getObjectFootprint, common_parameters,
+              lane_change_parameters.prepare_phase_ignore_target_speed_thresh, front_decel,
+              rear_decel, ego_pose_before_collision, current_debug_data.second)) {
+          appendDebugInfo(current_debug_data, false);
+          return false;
+        }
+      }
+      appendDebugInfo(current_debug_data, true);
+      continue;
+    }
+
+    const auto predicted_paths = util::getPredictedPathFromObj(obj, use_all_predicted_path);
     for (const auto & obj_path : predicted_paths) {
       if (!util::isSafeInLaneletCollisionCheck(
             interpolated_ego, current_twist, check_durations, lane_change_path.duration.prepare,
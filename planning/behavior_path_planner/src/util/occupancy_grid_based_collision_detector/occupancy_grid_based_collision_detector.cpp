@@ -17,6 +17,9 @@
 #include <tier4_autoware_utils/geometry/geometry.hpp>
 #include <tier4_autoware_utils/tier4_autoware_utils.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <vector>
 
 namespace behavior_path_planner
@@ -25,6 +28,59 @@ using tier4_autoware_utils::createQuaternionFromYaw;
 using tier4_autoware_utils::normalizeRadian;
 using tier4_autoware_utils::transformPose;
 
+namespace
+{
+constexpr double inf = std::numeric_limits<double>::infinity();
+
+// squared euclidean distance transform of a sampled function on a line
+// (P. Felzenszwalb and D. Huttenlocher, "Distance Transforms of Sampled Functions")
+void distanceTransform1d(
+  const std::vector<double> & f, std::vector<double> & d, std::vector<int> & v,
+  std::vector<double> & z)
+{
+  const int n = static_cast<int>(f.size());
+  const auto intersection = [&](const int q, const int p) {
+    return ((f[q] + q * q) - (f[p] + p * p)) / (2.0 * (q - p));
+  };
+
+  // lower envelope of the parabolas rooted at the finite samples
+  int k = -1;
+  for (int q = 0; q < n; ++q) {
+    if (f[q] == inf) {
+      continue;
+    }
+    if (k < 0) {
+      k = 0;
+      v[0] = q;
+      z[0] = -inf;
+      z[1] = inf;
+      continue;
+    }
+    double s = intersection(q, v[k]);
+    while (s <= z[k]) {
+      --k;
+      s = intersection(q, v[k]);
+    }
+    ++k;
+    v[k] = q;
+    z[k] = s;
+    z[k + 1] = inf;
+  }
+
+  if (k < 0) {
+    std::fill(d.begin(), d.end(), inf);
+    return;
+  }
+  k = 0;
+  for (int q = 0; q < n; ++q) {
+    while (z[k + 1] < q) {
+      ++k;
+    }
+    d[q] = (q - v[k]) * (q - v[k]) + f[v[k]];
+  }
+}
+}  // namespace
+
 int discretizeAngle(const double theta, const int theta_size)
 {
   const double one_angle_range = 2.0 * M_PI / theta_size;
@@ -101,8 +157,23 @@ void OccupancyGridBasedCollisionDetector::setMap(const nav_msgs::msg::OccupancyG
   }
   is_obstacle_table_ = is_obstacle_table;
 
-  // construct collision indexes table
   coll_indexes_table_.clear();
+  footprint_circles_table_.clear();
+  distance_field_.clear();
+
+  if (param_.use_distance_field) {
+    computeDistanceField();
+
+    // construct footprint circles table
+    for (int i = 0; i < param_.theta_size; i++) {
+      std::vector<FootprintCircle> circles;
+      computeFootprintCircles(i, circles);
+      footprint_circles_table_.push_back(circles);
+    }
+    return;
+  }
+
+  // construct collision indexes table
   for (int i = 0; i < param_.theta_size; i++) {
     std::vector<IndexXY> indexes_2d;
     computeCollisionIndexes(i, indexes_2d);
@@ -110,6 +181,103 @@ void OccupancyGridBasedCollisionDetector::setMap(const nav_msgs::msg::OccupancyG
   }
 }
 
+void OccupancyGridBasedCollisionDetector::computeDistanceField()
+{
+  const int height = static_cast<int>(costmap_.info.height);
+  const int width = static_cast<int>(costmap_.info.width);
+  const double resolution = costmap_.info.resolution;
+
+  // squared distance in cells, separable into a column and a row pass
+  std::vector<double> squared_distance(height * width);
+  std::vector<int> v(std::max(height, width));
+  std::vector<double> z(std::max(height, width) + 1);
+
+  std::vector<double> column(height);
+  std::vector<double> column_distance(height);
+  for (int j = 0; j < width; j++) {
+    for (int i = 0; i < height; i++) {
+      column[i] = is_obstacle_table_[i][j] ? 0.0 : inf;
+    }
+    distanceTransform1d(column, column_distance, v, z);
+    for (int i = 0; i < height; i++) {
+      squared_distance[i * width + j] = column_distance[i];
+    }
+  }
+
+  std::vector<double> row(width);
+  std::vector<double> row_distance(width);
+  distance_field_.resize(height * width);
+  for (int i = 0; i < height; i++) {
+    std::copy_n(squared_distance.begin() + i * width, width, row.begin());
+    distanceTransform1d(row, row_distance, v, z);
+    for (int j = 0; j < width; j++) {
+      distance_field_[i * width + j] = static_cast<float>(std::sqrt(row_distance[j]) * resolution);
+    }
+  }
+}
+
+void OccupancyGridBasedCollisionDetector::computeFootprintCircles(
+  int theta_index, std::vector<FootprintCircle> & circles) const
+{
+  IndexXYT base_index{0, 0, theta_index};
+  const VehicleShape & vehicle_shape = param_.vehicle_shape;
+
+  const double back = -1.0 * vehicle_shape.base2back;
+  const double half_width = vehicle_shape.width / 2.0;
+  const double resolution = costmap_.info.resolution;
+
+  // cover the rectangle with circles on its center line,
+  // sticking out of the sides of the rectangle by one cell at most
+  const double max_half_segment =
+    std::sqrt(std::pow(half_width + resolution, 2) - std::pow(half_width, 2));
+  const int num_circles =
+    std::max(1, static_cast<int>(std::ceil(vehicle_shape.length / (2.0 * max_half_segment))));
+  const double segment = vehicle_shape.length / num_circles;
+  const double radius = std::hypot(segment / 2.0, half_width);
+
+  const auto base_pose = index2pose(costmap_, base_index, param_.theta_size);
+  const auto base_theta = tf2::getYaw(base_pose.orientation);
+
+  for (int i = 0; i < num_circles; i++) {
+    const double x = back + (i + 0.5) * segment;
+    circles.push_back({std::cos(base_theta) * x, std::sin(base_theta) * x, radius});
+  }
+}
+
+bool OccupancyGridBasedCollisionDetector::detectCollisionWithDistanceField(
+  const IndexXYT & base_index, const bool check_out_of_range) const
+{
+  const double resolution = costmap_.info.resolution;
+  const int width = static_cast<int>(costmap_.info.width);
+  const double map_width = width * resolution;
+  const double map_height = costmap_.info.height * resolution;
+
+  // the distance is between the cell centers, so that the circle center and the obstacle can be
+  // half a cell diagonal apart from them respectively
+  const double margin = resolution * std::sqrt(2.0);
+
+  const double base_x = base_index.x * resolution;
+  const double base_y = base_index.y * resolution;
+  for (const auto & circle : footprint_circles_table_[base_index.theta]) {
+    const double x = base_x + circle.x;
+    const double y = base_y + circle.y;
+    const IndexXYT index{
+      static_cast<int>(std::floor(x / resolution)), static_cast<int>(std::floor(y / resolution)),
+      0};
+    if (isOutOfRange(index)) {
+      return check_out_of_range;
+    }
+    if (check_out_of_range) {
+      const double distance_to_edge = std::min({x, map_width - x, y, map_height - y});
+      if (distance_to_edge < circle.radius) return true;
+    }
+    if (distance_field_[index.y * width + index.x] < circle.radius + margin) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void OccupancyGridBasedCollisionDetector::computeCollisionIndexes(
   int theta_index, std::vector<IndexXY> & indexes_2d)
 {
@@ -155,11 +323,14 @@ void OccupancyGridBasedCollisionDetector::computeCollisionIndexes(
 bool OccupancyGridBasedCollisionDetector::detectCollision(
   const IndexXYT & base_index, const bool check_out_of_range) const
 {
-  if (coll_indexes_table_.empty()) {
+  if (coll_indexes_table_.empty() && footprint_circles_table_.empty()) {
     std::cerr << "[occupancy_grid_based_collision_detector] setMap has not yet been done."
               << std::endl;
     return false;
   }
+  if (param_.use_distance_field) {
+    return detectCollisionWithDistanceField(base_index, check_out_of_range);
+  }
   const auto & coll_indexes_2d = coll_indexes_table_[base_index.theta];
   for (const auto & coll_index_2d : coll_indexes_2d) {
     int idx_theta = 0;  // whatever. Yaw is nothing to do with collision detection between grids.
@@ -180,24 +351,33 @@ bool OccupancyGridBasedCollisionDetector::detectCollision(
 bool OccupancyGridBasedCollisionDetector::hasObstacleOnPath(
   const geometry_msgs::msg::PoseArray & path, const bool check_out_of_range) const
 {
-  for (const auto & pose : path.poses) {
-    const auto pose_local = global2local(costmap_, pose);
-    const auto index = pose2index(costmap_, pose_local, param_.theta_size);
-
-    if (detectCollision(index, check_out_of_range)) {
-      return true;
-    }
-  }
-
-  return false;
+  return hasObstacleOnPoses(path.poses, check_out_of_range);
 }
 
 bool OccupancyGridBasedCollisionDetector::hasObstacleOnPath(
   const autoware_auto_planning_msgs::msg::PathWithLaneId & path,
   const bool check_out_of_range) const
 {
+  std::vector<geometry_msgs::msg::Pose> poses;
+  poses.reserve(path.points.size());
   for (const auto & p : path.points) {
-    const auto pose_local = global2local(costmap_, p.point.pose);
+    poses.push_back(p.point.pose);
+  }
+  return hasObstacleOnPoses(poses, check_out_of_range);
+}
+
+bool OccupancyGridBasedCollisionDetector::hasObstacleOnPoses(
+  const std::vector<geometry_msgs::msg::Pose> & poses, const bool check_out_of_range) const
+{
+  // transform all the poses into the costmap frame with the same transform
+  tf2::Transform tf_origin;
+  tf2::convert(costmap_.info.origin, tf_origin);
+
+  geometry_msgs::msg::TransformStamped transform;
+  transform.transform = tf2::toMsg(tf_origin.inverse());
+
+  for (const auto & pose : poses) {
+    const auto pose_local = transformPose(pose, transform);
     const auto index = pose2index(costmap_, pose_local, param_.theta_size);
 
     if (detectCollision(index, check_out_of_range)) {
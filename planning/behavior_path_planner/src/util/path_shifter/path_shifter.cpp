@@ -21,6 +21,7 @@
 #include <lanelet2_extension/utility/utilities.hpp>
 #include <tier4_autoware_utils/tier4_autoware_utils.hpp>
 
+#include <algorithm>
 #include <limits>
 #include <string>
 #include <utility>
@@ -131,12 +132,105 @@ bool PathShifter::generate(
     }
   }
 
-  // Calculate shifted path
-  type == SHIFT_TYPE::SPLINE ? applySplineShifter(shifted_path, offset_back)
-                             : applyLinearShifter(shifted_path);
+  // Find the first shift point changed since the last generation.
+  const bool use_cache = isCacheAvailable(offset_back, type);
+  size_t first_changed_idx = 0;
+  if (use_cache) {
+    const auto is_same_shift_line = [](const ShiftLine & a, const ShiftLine & b) {
+      return a.start_idx == b.start_idx && a.end_idx == b.end_idx &&
+             a.end_shift_length == b.end_shift_length;
+    };
+    const auto num_common_lines = std::min(shift_lines_.size(), cache_.shift_lines.size());
+    while (first_changed_idx < num_common_lines &&
+           is_same_shift_line(
+             shift_lines_.at(first_changed_idx), cache_.shift_lines.at(first_changed_idx))) {
+      ++first_changed_idx;
+    }
+    if (
+      first_changed_idx == shift_lines_.size() &&
+      first_changed_idx == cache_.shift_lines.size()) {
+      *shifted_path = cache_.shifted_path;
+      return true;
+    }
+  }
+
+  // Calculate shift length, from the one before the first changed shift point.
+  std::vector<std::vector<double>> shift_length_history;
+  if (use_cache) {
+    shift_length_history.assign(
+      cache_.shift_length_history.begin(),
+      cache_.shift_length_history.begin() + first_changed_idx + 1);
+  } else {
+    std::vector<double> base_shift_length(reference_path_.points.size(), 0.0);
+    constexpr double BASE_OFFSET_THR = 1.0e-4;
+    if (std::abs(base_offset_) > BASE_OFFSET_THR) {
+      for (size_t i = 0; i < base_shift_length.size(); ++i) {
+        addShiftLengthOnIndexPoint(base_shift_length, base_offset_, i);
+      }
+    }
+    shift_length_history.push_back(std::move(base_shift_length));
+  }
+  type == SHIFT_TYPE::SPLINE ? applySplineShifter(shift_length_history, offset_back)
+                             : applyLinearShifter(shift_length_history);
+
+  // Calculate shifted path, only for the points whose shift length is changed.
+  const auto & shift_length = shift_length_history.back();
+  const auto N = reference_path_.points.size();
+  std::vector<bool> is_shifted(N, true);
+  if (use_cache) {
+    for (size_t i = 0; i < N; ++i) {
+      is_shifted.at(i) = shift_length.at(i) != cache_.shifted_path.shift_length.at(i);
+    }
+  }
+  shifted_path->path = use_cache ? cache_.shifted_path.path : reference_path_;
+  shifted_path->shift_length = shift_length;
+  for (size_t i = 0; i < N; ++i) {
+    if (!is_shifted.at(i)) {
+      continue;
+    }
+    const auto & reference_pose = reference_path_.points.at(i).point.pose;
+    auto & p = shifted_path->path.points.at(i).point.pose;
+    const double yaw = tf2::getYaw(reference_pose.orientation);
+    p = reference_pose;
+    p.position.x -= std::sin(yaw) * shift_length.at(i);
+    p.position.y += std::cos(yaw) * shift_length.at(i);
+  }
 
   const bool is_driving_forward = true;
-  insertOrientation(shifted_path->path.points, is_driving_forward);
+  if (!use_cache) {
+    insertOrientation(shifted_path->path.points, is_driving_forward);
+  } else {
+    // the orientation depends on the point and the next one.
+    auto & points = shifted_path->path.points;
+    for (size_t i = 0; i + 1 < N; ++i) {
+      if (!is_shifted.at(i) && !is_shifted.at(i + 1)) {
+        continue;
+      }
+      const auto & src_point = points.at(i).point.pose.position;
+      const auto & dst_point = points.at(i + 1).point.pose.position;
+      const double pitch = tier4_autoware_utils::calcElevationAngle(src_point, dst_point);
+      const double yaw = tier4_autoware_utils::calcAzimuthAngle(src_point, dst_point);
+      points.at(i).point.pose.orientation =
+        tier4_autoware_utils::createQuaternionFromRPY(0.0, pitch, yaw);
+      if (i == N - 2) {
+        // Terminal orientation is same as the point before it
+        points.at(i + 1).point.pose.orientation = points.at(i).point.pose.orientation;
+      }
+    }
+  }
+
+  if (!use_cache) {
+    cache_.reference_path = reference_path_;
+    cache_.base_offset = base_offset_;
+    cache_.velocity = velocity_;
+    cache_.acc_limit = acc_limit_;
+    cache_.offset_back = offset_back;
+    cache_.type = type;
+  }
+  cache_.is_valid = true;
+  cache_.shift_lines = shift_lines_;
+  cache_.shifted_path = *shifted_path;
+  cache_.shift_length_history = std::move(shift_length_history);
 
   // DEBUG
   RCLCPP_DEBUG_STREAM_THROTTLE(
@@ -146,23 +240,24 @@ bool PathShifter::generate(
   return true;
 }
 
-void PathShifter::applyLinearShifter(ShiftedPath * shifted_path) const
+void PathShifter::applyLinearShifter(std::vector<std::vector<double>> & shift_length_history) const
 {
   const auto arclength_arr = util::calcPathArcLengthArray(reference_path_);
 
-  shiftBaseLength(shifted_path, base_offset_);
-
   constexpr double epsilon = 1.0e-8;  // to avoid 0 division
 
-  // For all shift_lines_,
-  for (const auto & shift_line : shift_lines_) {
-    const auto current_shift = shifted_path->shift_length.at(shift_line.end_idx);
+  // For all shift_lines_ not applied yet,
+  for (size_t j = shift_length_history.size() - 1; j < shift_lines_.size(); ++j) {
+    const auto & shift_line = shift_lines_.at(j);
+    auto shift_length = shift_length_history.back();
+
+    const auto current_shift = shift_length.at(shift_line.end_idx);
     const auto delta_shift = shift_line.end_shift_length - current_shift;
     const auto shifting_arclength = std::max(
       arclength_arr.at(shift_line.end_idx) - arclength_arr.at(shift_line.start_idx), epsilon);
 
     // For all path.points,
-    for (size_t i = 0; i < shifted_path->path.points.size(); ++i) {
+    for (size_t i = 0; i < shift_length.size(); ++i) {
       // Set shift length.
       double ith_shift_length;
       if (i < shift_line.start_idx) {
@@ -175,24 +270,28 @@ void PathShifter::applyLinearShifter(ShiftedPath * shifted_path) const
       }
 
       // Apply shifting.
-      addLateralOffsetOnIndexPoint(shifted_path, ith_shift_length, i);
+      addShiftLengthOnIndexPoint(shift_length, ith_shift_length, i);
     }
+
+    shift_length_history.push_back(std::move(shift_length));
   }
 }
 
-void PathShifter::applySplineShifter(ShiftedPath * shifted_path, const bool offset_back) const
+void PathShifter::applySplineShifter(
+  std::vector<std::vector<double>> & shift_length_history, const bool offset_back) const
 {
   const auto arclength_arr = util::calcPathArcLengthArray(reference_path_);
 
-  shiftBaseLength(shifted_path, base_offset_);
-
   constexpr double epsilon = 1.0e-8;  // to avoid 0 division
 
-  // For all shift_lines,
-  for (const auto & shift_line : shift_lines_) {
+  // For all shift_lines not applied yet,
+  for (size_t j = shift_length_history.size() - 1; j < shift_lines_.size(); ++j) {
+    const auto & shift_line = shift_lines_.at(j);
+    auto shift_length = shift_length_history.back();
+
     // calc delta shift at the sp.end_idx so that the sp.end_idx on the path will have
     // the desired shift length.
-    const auto current_shift = shifted_path->shift_length.at(shift_line.end_idx);
+    const auto current_shift = shift_length.at(shift_line.end_idx);
     const auto delta_shift = shift_line.end_shift_length - current_shift;
 
     RCLCPP_DEBUG(
@@ -231,25 +330,34 @@ void PathShifter::applySplineShifter(ShiftedPath * shifted_path, const bool offs
     {
       size_t i = shift_line.start_idx + 1;
       for (const auto & itr : query_length) {
-        addLateralOffsetOnIndexPoint(shifted_path, itr, i);
+        addShiftLengthOnIndexPoint(shift_length, itr, i);
         ++i;
       }
     }
 
     if (offset_back == true) {
       // Apply shifting after shift
-      for (size_t i = shift_line.end_idx; i < shifted_path->path.points.size(); ++i) {
-        addLateralOffsetOnIndexPoint(shifted_path, delta_shift, i);
+      for (size_t i = shift_line.end_idx; i < shift_length.size(); ++i) {
+        addShiftLengthOnIndexPoint(shift_length, delta_shift, i);
       }
     } else {
       // Apply shifting before shift
       for (size_t i = 0; i < shift_line.start_idx + 1; ++i) {
-        addLateralOffsetOnIndexPoint(shifted_path, query_length.front(), i);
+        addShiftLengthOnIndexPoint(shift_length, query_length.front(), i);
       }
     }
+
+    shift_length_history.push_back(std::move(shift_length));
   }
 }
 
+bool PathShifter::isCacheAvailable(const bool offset_back, const SHIFT_TYPE type) const
+{
+  return cache_.is_valid && cache_.offset_back == offset_back && cache_.type == type &&
+         cache_.base_offset == base_offset_ && cache_.velocity == velocity_ &&
+         cache_.acc_limit == acc_limit_ && cache_.reference_path == reference_path_;
+}
+
 std::pair<std::vector<double>, std::vector<double>> PathShifter::getBaseLengthsWithoutAccelLimit(
   const double arclength, const double shift_length, const bool offset_back) const
 {
@@ -463,6 +571,16 @@ void PathShifter::addLateralOffsetOnIndexPoint(
   path->shift_length.at(index) += offset;
 }
 
+void PathShifter::addShiftLengthOnIndexPoint(
+  std::vector<double> & shift_length, double offset, size_t index) const
+{
+  if (fabs(offset) < 1.0e-8) {
+    return;
+  }
+
+  shift_length.at(index) += offset;
+}
+
 void PathShifter::shiftBaseLength(ShiftedPath * path, double offset) const
 {
   constexpr double BASE_OFFSET_THR = 1.0e-4;
@@ -66,10 +66,17 @@ GoalCandidates GoalSearcher::search(const Pose & original_goal_pose)
   const auto [shoulder_lane_objects, others] =
     util::separateObjectsByLanelets(*(planner_data_->dynamic_object), pull_over_lanes);
 
-  std::vector<Pose> original_search_poses{};  // for search area visualizing
-  size_t goal_id = 0;
-  for (const auto & p : center_line_path.points) {
-    const Pose & center_pose = p.point.pose;
+  // the no stopping areas depend only on the map, get them once for all the candidates
+  const auto no_stopping_area_polygons = getNoStoppingAreaPolygons(pull_over_lanes);
+
+  // search the goal candidates of each center line point on the threads, then gather them in the
+  // order of the points
+  const auto & center_line_points = center_line_path.points;
+  std::vector<boost::optional<Pose>> original_search_pose_of_points(center_line_points.size());
+  std::vector<GoalCandidates> goal_candidates_of_points(center_line_points.size());
+#pragma omp parallel for num_threads(parameters_.goal_search_num_threads) schedule(dynamic)
+  for (size_t i = 0; i < center_line_points.size(); ++i) {
+    const Pose & center_pose = center_line_points.at(i).point.pose;
 
     // ignore goal_pose near lane start
     const double distance_from_lane_start =
@@ -84,7 +91,7 @@ GoalCandidates GoalSearcher::search(const Pose & original_goal_pose)
 
     const double offset_from_center_line = distance_from_left_bound.value() + margin_from_boundary;
     const Pose original_search_pose = calcOffsetPose(center_pose, 0, -offset_from_center_line, 0);
-    original_search_poses.push_back(original_search_pose);  // for createAreaPolygon
+    original_search_pose_of_points.at(i) = original_search_pose;  // for createAreaPolygon
     Pose search_pose{};
     // search goal_pose in lateral direction
     double lateral_offset = 0.0;
@@ -95,7 +102,7 @@ GoalCandidates GoalSearcher::search(const Pose & original_goal_pose)
       const auto transformed_vehicle_footprint =
         transformVector(vehicle_footprint_, tier4_autoware_utils::pose2transform(search_pose));
 
-      if (isInAreas(transformed_vehicle_footprint, getNoStoppingAreaPolygons(pull_over_lanes))) {
+      if (isInAreas(transformed_vehicle_footprint, no_stopping_area_polygons)) {
         continue;
       }
 
@@ -106,11 +113,22 @@ GoalCandidates GoalSearcher::search(const Pose & original_goal_pose)
       GoalCandidate goal_candidate{};
       goal_candidate.goal_pose = search_pose;
       goal_candidate.lateral_offset = lateral_offset;
-      goal_candidate.id = goal_id;
-      goal_id++;
       // use longitudinal_distance as distance_from_original_goal
       goal_candidate.distance_from_original_goal = std::abs(motion_utils::calcSignedArcLength(
         center_line_path.points, original_goal_pose.position, search_pose.position));
+      goal_candidates_of_points.at(i).push_back(goal_candidate);
+    }
+  }
+
+  std::vector<Pose> original_search_poses{};  // for search area visualizing
+  size_t goal_id = 0;
+  for (size_t i = 0; i < center_line_points.size(); ++i) {
+    if (original_search_pose_of_points.at(i)) {
+      original_search_poses.push_back(*original_search_pose_of_points.at(i));
+    }
+    for (auto & goal_candidate : goal_candidates_of_points.at(i)) {
+      goal_candidate.id = goal_id;
+      goal_id++;
       goal_candidates.push_back(goal_candidate);
     }
   }
@@ -124,8 +142,14 @@ GoalCandidates GoalSearcher::search(const Pose & original_goal_pose)
 
 void GoalSearcher::update(GoalCandidates & goal_candidates) const
 {
-  // update is_safe
-  for (auto & goal_candidate : goal_candidates) {
+  const auto pull_over_lanes = pull_over_utils::getPullOverLanes(*(planner_data_->route_handler));
+  const auto [shoulder_lane_objects, others] =
+    util::separateObjectsByLanelets(*(planner_data_->dynamic_object), pull_over_lanes);
+
+  // update is_safe, only the collision with the objects changes after the search
+#pragma omp parallel for num_threads(parameters_.goal_search_num_threads) schedule(dynamic)
+  for (size_t i = 0; i < goal_candidates.size(); ++i) {
+    auto & goal_candidate = goal_candidates.at(i);
     const Pose goal_pose = goal_candidate.goal_pose;
 
     // check collision with footprint
@@ -135,9 +159,6 @@ void GoalSearcher::update(GoalCandidates & goal_candidates) const
     }
 
     // check margin with pull over lane objects
-    const auto pull_over_lanes = pull_over_utils::getPullOverLanes(*(planner_data_->route_handler));
-    const auto [shoulder_lane_objects, others] =
-      util::separateObjectsByLanelets(*(planner_data_->dynamic_object), pull_over_lanes);
     constexpr bool filter_inside = true;
     const auto target_objects = pull_over_utils::filterObjectsByLateralDistance(
       goal_pose, planner_data_->parameters.vehicle_width, shoulder_lane_objects,
@@ -181,25 +202,10 @@ bool GoalSearcher::checkCollisionWithLongitudinalDistance(
     const double offset = std::max(
       parameters_.longitudinal_margin - parameters_.occupancy_grid_collision_check_margin, 0.0);
 
-    // check forward collision
-    const Pose ego_pose_moved_forward = calcOffsetPose(ego_pose, offset, 0, 0);
-    const Pose forward_pose_grid_coords =
-      global2local(occupancy_grid_map_->getMap(), ego_pose_moved_forward);
-    const auto forward_idx = pose2index(
-      occupancy_grid_map_->getMap(), forward_pose_grid_coords,
-      occupancy_grid_map_->getParam().theta_size);
-    if (occupancy_grid_map_->detectCollision(forward_idx, check_out_of_range)) {
-      return true;
-    }
-
-    // check backward collision
-    const Pose ego_pose_moved_backward = calcOffsetPose(ego_pose, -offset, 0, 0);
-    const Pose backward_pose_grid_coords =
-      global2local(occupancy_grid_map_->getMap(), ego_pose_moved_backward);
-    const auto backward_idx = pose2index(
-      occupancy_grid_map_->getMap(), backward_pose_grid_coords,
-      occupancy_grid_map_->getParam().theta_size);
-    if (occupancy_grid_map_->detectCollision(backward_idx, check_out_of_range)) {
+    // check forward and backward collision
+    const std::vector<Pose> ego_poses_moved{
+      calcOffsetPose(ego_pose, offset, 0, 0), calcOffsetPose(ego_pose, -offset, 0, 0)};
+    if (occupancy_grid_map_->hasObstacleOnPoses(ego_poses_moved, check_out_of_range)) {
       return true;
     }
   }
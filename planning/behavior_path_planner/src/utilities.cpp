@@ -497,13 +497,41 @@ std::pair<std::vector<size_t>, std::vector<size_t>> separateObjectIndicesByLanel
     return {};
   }
 
+  using tier4_autoware_utils::Box2d;
+
+  // create the lanelet polygons and their bounding boxes once for all the objects
+  std::vector<Polygon2d> lanelet_polygons;
+  std::vector<Box2d> lanelet_boxes;
+  lanelet_polygons.reserve(target_lanelets.size());
+  lanelet_boxes.reserve(target_lanelets.size());
+  for (const auto & llt : target_lanelets) {
+    const auto polygon2d = llt.polygon2d().basicPolygon();
+    if (polygon2d.empty()) {
+      // no lanelet polygon
+      continue;
+    }
+    Polygon2d lanelet_polygon;
+    for (const auto & lanelet_point : polygon2d) {
+      lanelet_polygon.outer().emplace_back(lanelet_point.x(), lanelet_point.y());
+    }
+    lanelet_polygon.outer().push_back(lanelet_polygon.outer().front());
+    lanelet_boxes.push_back(boost::geometry::return_envelope<Box2d>(lanelet_polygon));
+    lanelet_polygons.push_back(std::move(lanelet_polygon));
+  }
+
+  // the objects out of the box of all the lanelets do not intersect any of them
+  Box2d lanelets_box;
+  boost::geometry::assign_inverse(lanelets_box);
+  for (const auto & lanelet_box : lanelet_boxes) {
+    boost::geometry::expand(lanelets_box, lanelet_box);
+  }
+
   std::vector<size_t> target_indices;
   std::vector<size_t> other_indices;
 
   for (size_t i = 0; i < objects.objects.size(); i++) {
     // create object polygon
     const auto & obj = objects.objects.at(i);
-    // create object polygon
     Polygon2d obj_polygon;
     if (!util::calcObjectPolygon(obj, &obj_polygon)) {
       RCLCPP_ERROR_STREAM(
@@ -514,23 +542,18 @@ std::pair<std::vector<size_t>, std::vector<size_t>> separateObjectIndicesByLanel
 
     bool is_filtered_object = false;
 
-    for (const auto & llt : target_lanelets) {
-      // create lanelet polygon
-      const auto polygon2d = llt.polygon2d().basicPolygon();
-      if (polygon2d.empty()) {
-        // no lanelet polygon
-        continue;
-      }
-      Polygon2d lanelet_polygon;
-      for (const auto & lanelet_point : polygon2d) {
-        lanelet_polygon.outer().emplace_back(lanelet_point.x(), lanelet_point.y());
-      }
-      lanelet_polygon.outer().push_back(lanelet_polygon.outer().front());
-      // check the object does not intersect the lanelet
-      if (!boost::geometry::disjoint(lanelet_polygon, obj_polygon)) {
-        target_indices.push_back(i);
-        is_filtered_object = true;
-        break;
+    const auto obj_box = boost::geometry::return_envelope<Box2d>(obj_polygon);
+    if (!lanelet_polygons.empty() && boost::geometry::intersects(lanelets_box, obj_box)) {
+      for (size_t j = 0; j < lanelet_polygons.size(); j++) {
+        if (boost::geometry::disjoint(lanelet_boxes.at(j), obj_box)) {
+          continue;
+        }
+        // check the object does not intersect the lanelet
+        if (!boost::geometry::disjoint(lanelet_polygons.at(j), obj_polygon)) {
+          target_indices.push_back(i);
+          is_filtered_object = true;
+          break;
+        }
       }
     }
 
@@ -1219,10 +1242,17 @@ void generateDrivableArea(
     path.right_bound.push_back(right_goal_point);
   }
   const auto & expansion_params = planner_data->drivable_area_expansion_parameters;
+  const auto & uncrossable_lines = planner_data->uncrossable_lines;
   if (expansion_params.enabled) {
-    drivable_area_expansion::expandDrivableArea(
-      path, expansion_params, *planner_data->dynamic_object, *planner_data->route_handler,
-      transformed_lanes);
+    if (uncrossable_lines && uncrossable_lines->types == expansion_params.avoid_linestring_types) {
+      drivable_area_expansion::expandDrivableArea(
+        path, expansion_params, *planner_data->dynamic_object, *planner_data->route_handler,
+        transformed_lanes, uncrossable_lines->segments);
+    } else {
+      drivable_area_expansion::expandDrivableArea(
+        path, expansion_params, *planner_data->dynamic_object, *planner_data->route_handler,
+        transformed_lanes);
+    }
   }
 }
 
@@ -2500,10 +2530,33 @@ bool isSafeInLaneletCollisionCheck(
   const PredictedPath & target_object_path, const BehaviorPathPlannerParameters & common_parameters,
   const double prepare_phase_ignore_target_speed_thresh, const double front_decel,
   const double rear_decel, Pose & ego_pose_before_collision, CollisionCheckDebug & debug)
+{
+  PredictedObjectFootprint footprint;
+  footprint.pose = target_object.kinematics.initial_pose_with_covariance.pose;
+  const auto getObjectFootprint = [&](const double current_time) -> const auto & {
+    footprint.failed_reason.clear();
+    util::getObjectExpectedPoseAndConvertToPolygon(
+      target_object_path, target_object, footprint.polygon, current_time, footprint.pose,
+      footprint.failed_reason);
+    return footprint;
+  };
+  return isSafeInLaneletCollisionCheck(
+    interpolated_ego, ego_current_twist, check_duration, prepare_duration, target_object,
+    getObjectFootprint, common_parameters, prepare_phase_ignore_target_speed_thresh, front_decel,
+    rear_decel, ego_pose_before_collision, debug);
+}
+
+bool isSafeInLaneletCollisionCheck(
+  const std::vector<std::pair<Pose, tier4_autoware_utils::Polygon2d>> & interpolated_ego,
+  const Twist & ego_current_twist, const std::vector<double> & check_duration,
+  const double prepare_duration, const PredictedObject & target_object,
+  const std::function<const PredictedObjectFootprint &(const double)> & getObjectFootprint,
+  const BehaviorPathPlannerParameters & common_parameters,
+  const double prepare_phase_ignore_target_speed_thresh, const double front_decel,
+  const double rear_decel, Pose & ego_pose_before_collision, CollisionCheckDebug & debug)
 {
   debug.lerped_path.reserve(check_duration.size());
 
-  Pose expected_obj_pose = target_object.kinematics.initial_pose_with_covariance.pose;
   const auto & object_twist = target_object.kinematics.initial_twist_with_covariance.twist;
   const auto object_speed = object_twist.linear.x;
   const auto ignore_check_at_time = [&](const double current_time) {
@@ -2519,10 +2572,12 @@ bool isSafeInLaneletCollisionCheck(
       continue;
     }
 
-    tier4_autoware_utils::Polygon2d obj_polygon;
-    [[maybe_unused]] const auto get_obj_info = util::getObjectExpectedPoseAndConvertToPolygon(
-      target_object_path, target_object, obj_polygon, current_time, expected_obj_pose,
-      debug.failed_reason);
+    const auto & obj_footprint = getObjectFootprint(current_time);
+    if (!obj_footprint.failed_reason.empty()) {
+      debug.failed_reason = obj_footprint.failed_reason;
+    }
+    const auto & obj_polygon = obj_footprint.polygon;
+    auto expected_obj_pose = obj_footprint.pose;
     const auto & ego_info = interpolated_ego.at(i);
     auto expected_ego_pose = ego_info.first;
     const auto & ego_polygon = ego_info.second;
@@ -2691,4 +2746,11 @@ lanelet::ConstLanelets getLaneletsFromPath(
 
   return lanelets;
 }
+
+void cacheCenterlines(const lanelet::ConstLanelets & lanelets)
+{
+  for (const auto & lanelet : lanelets) {
+    lanelet.centerline();
+  }
+}
 }  // namespace behavior_path_planner::util
@@ -17,6 +17,14 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
 using behavior_path_planner::isOnRight;
 using behavior_path_planner::isSameDirectionShift;
 using behavior_path_planner::ObjectData;
@@ -40,3 +48,128 @@ TEST(BehaviorPathPlanningAvoidanceUtilsTest, shiftLengthDirectionTest)
   ASSERT_TRUE(isSameDirectionShift(isOnRight(left_obj), zero_shift_length));
   ASSERT_FALSE(isSameDirectionShift(isOnRight(right_obj), zero_shift_length));
 }
+
+namespace
+{
+using behavior_path_planner::AvoidLine;
+using behavior_path_planner::AvoidLineArray;
+using behavior_path_planner::ShiftLineData;
+
+// evenly spaced path points and randomly placed shift lines of the given number of objects
+std::pair<std::vector<double>, AvoidLineArray> createShiftLines(
+  const size_t num_points, const size_t num_objects, const unsigned int seed)
+{
+  constexpr double interval = 0.5;
+  std::vector<double> arcs(num_points);
+  for (size_t i = 0; i < num_points; ++i) {
+    arcs.at(i) = (static_cast<double>(i) - 10.0) * interval;
+  }
+
+  std::mt19937 engine(seed);
+  std::uniform_real_distribution<double> start_dist(arcs.front(), arcs.back());
+  std::uniform_real_distribution<double> length_dist(0.0, 30.0);
+  std::uniform_real_distribution<double> shift_dist(-3.0, 3.0);
+
+  AvoidLineArray avoid_lines;
+  for (size_t i = 0; i < num_objects; ++i) {
+    // an avoidance shift and the return shift for each object
+    AvoidLine avoid_line;
+    avoid_line.start_longitudinal = start_dist(engine);
+    avoid_line.end_longitudinal = avoid_line.start_longitudinal + length_dist(engine);
+    avoid_line.end_shift_length = shift_dist(engine);
+    AvoidLine return_line;
+    return_line.start_longitudinal = avoid_line.end_longitudinal + length_dist(engine);
+    return_line.end_longitudinal = return_line.start_longitudinal + length_dist(engine);
+    return_line.start_shift_length = avoid_line.end_shift_length;
+    for (auto * line : {&avoid_line, &return_line}) {
+      line->start_idx =
+        static_cast<size_t>(std::max(line->start_longitudinal / interval + 10.0, 0.0));
+      line->end_idx = static_cast<size_t>(std::max(line->end_longitudinal / interval + 10.0, 0.0));
+      avoid_lines.push_back(*line);
+    }
+  }
+  return {arcs, avoid_lines};
+}
+
+// merge the shift lines point by point, for every shift line
+std::vector<double> calcTotalShiftLineNaive(
+  const AvoidLineArray & avoid_lines, const std::vector<double> & arcs,
+  const size_t ego_closest_index, const double current_shift)
+{
+  const auto N = arcs.size();
+  std::vector<double> pos_shift_line(N, 0.0);
+  std::vector<double> neg_shift_line(N, 0.0);
+  for (const auto & al : avoid_lines) {
+    for (size_t i = 0; i < N; ++i) {
+      const auto i_shift = behavior_path_planner::lerpShiftLengthOnArc(arcs.at(i), al);
+      pos_shift_line.at(i) = std::max(pos_shift_line.at(i), i_shift);
+      neg_shift_line.at(i) = std::min(neg_shift_line.at(i), i_shift);
+    }
+  }
+
+  std::vector<double> shift_line(N);
+  for (size_t i = 0; i < N; ++i) {
+    shift_line.at(i) = i <= ego_closest_index ? current_shift
+                                              : pos_shift_line.at(i) + neg_shift_line.at(i);
+  }
+  for (size_t i = 1; i < N; ++i) {
+    const bool has_object =
+      std::any_of(avoid_lines.begin(), avoid_lines.end(), [&](const auto & al) {
+        return al.start_idx <= i && i <= al.end_idx;
+      });
+    if (!has_object) {
+      shift_line.at(i) = shift_line.at(i - 1);
+    }
+  }
+  return shift_line;
+}
+}  // namespace
+
+TEST(BehaviorPathPlanningAvoidanceUtilsTest, totalShiftLineTest)
+{
+  using behavior_path_planner::fillTotalShiftLine;
+
+  constexpr size_t ego_closest_index = 10;
+  constexpr double current_shift = 0.5;
+
+  ShiftLineData shift_line_data;
+  for (unsigned int seed = 0; seed < 20; ++seed) {
+    const auto [arcs, avoid_lines] = createShiftLines(400, seed % 8, seed);
+    fillTotalShiftLine(
+      avoid_lines, arcs, ego_closest_index, current_shift, true, shift_line_data);
+
+    const auto expected =
+      calcTotalShiftLineNaive(avoid_lines, arcs, ego_closest_index, current_shift);
+    ASSERT_EQ(shift_line_data.shift_line.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_DOUBLE_EQ(shift_line_data.shift_line.at(i), expected.at(i));
+    }
+    EXPECT_EQ(shift_line_data.shift_line_history.size(), avoid_lines.size() + 1);
+  }
+}
+
+TEST(BehaviorPathPlanningAvoidanceUtilsTest, totalShiftLineBenchmark)
+{
+  using behavior_path_planner::fillTotalShiftLine;
+
+  constexpr size_t num_points = 2000;
+  constexpr size_t num_iterations = 20;
+
+  ShiftLineData shift_line_data;
+  for (const size_t num_objects : {1, 4, 16, 64, 256}) {
+    const auto [arcs, avoid_lines] = createShiftLines(num_points, num_objects, 0);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_iterations; ++i) {
+      fillTotalShiftLine(avoid_lines, arcs, 0, 0.0, false, shift_line_data);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    const double elapsed_us =
+      std::chrono::duration<double, std::micro>(end - start).count() / num_iterations;
+    std::cout << "objects: " << num_objects << ", total shift line: " << elapsed_us << " [us]"
+              << std::endl;
+    RecordProperty(
+      "total_shift_line_us_" + std::to_string(num_objects), std::to_string(elapsed_us));
+  }
+}
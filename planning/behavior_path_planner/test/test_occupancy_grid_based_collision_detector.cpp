@@ -0,0 +1,109 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "behavior_path_planner/util/occupancy_grid_based_collision_detector/occupancy_grid_based_collision_detector.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+using behavior_path_planner::OccupancyGridBasedCollisionDetector;
+using behavior_path_planner::OccupancyGridMapParam;
+
+namespace
+{
+class DistanceFieldCollisionDetector : public OccupancyGridBasedCollisionDetector
+{
+public:
+  float getDistance(const int x, const int y) const
+  {
+    return distance_field_.at(y * costmap_.info.width + x);
+  }
+};
+
+OccupancyGridMapParam createParam()
+{
+  OccupancyGridMapParam param;
+  param.vehicle_shape = {4.0, 2.0, 1.0};
+  param.theta_size = 8;
+  param.obstacle_threshold = 50;
+  param.use_distance_field = true;
+  return param;
+}
+
+nav_msgs::msg::OccupancyGrid createCostmap(const int width, const int height)
+{
+  nav_msgs::msg::OccupancyGrid costmap;
+  costmap.info.width = width;
+  costmap.info.height = height;
+  costmap.info.resolution = 0.5;
+  costmap.info.origin.orientation.w = 1.0;
+  costmap.data.assign(width * height, 0);
+  return costmap;
+}
+}  // namespace
+
+TEST(OccupancyGridBasedCollisionDetector, DistanceFieldSameAsBruteForce)
+{
+  constexpr int width = 17;
+  constexpr int height = 13;
+  auto costmap = createCostmap(width, height);
+
+  std::mt19937 engine(0);
+  std::uniform_int_distribution<int> cost(0, 99);
+  for (auto & cell : costmap.data) {
+    // about a tenth of the cells are obstacles
+    cell = cost(engine) < 90 ? 0 : 100;
+  }
+  // unknown cells are obstacles too
+  costmap.data.at(3 * width + 5) = -1;
+
+  DistanceFieldCollisionDetector detector;
+  detector.setParam(createParam());
+  detector.setMap(costmap);
+
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      double expected = std::numeric_limits<double>::infinity();
+      for (int obstacle_y = 0; obstacle_y < height; ++obstacle_y) {
+        for (int obstacle_x = 0; obstacle_x < width; ++obstacle_x) {
+          const int cell = costmap.data.at(obstacle_y * width + obstacle_x);
+          if (cell < 0 || 50 <= cell) {
+            const double distance = std::hypot(obstacle_x - x, obstacle_y - y);
+            expected = std::min(expected, distance * costmap.info.resolution);
+          }
+        }
+      }
+      EXPECT_NEAR(detector.getDistance(x, y), expected, 1e-4) << "x: " << x << ", y: " << y;
+    }
+  }
+}
+
+TEST(OccupancyGridBasedCollisionDetector, DistanceFieldWithoutObstacle)
+{
+  auto costmap = createCostmap(5, 4);
+
+  DistanceFieldCollisionDetector detector;
+  detector.setParam(createParam());
+  detector.setMap(costmap);
+
+  for (int y = 0; y < 4; ++y) {
+    for (int x = 0; x < 5; ++x) {
+      EXPECT_TRUE(std::isinf(detector.getDistance(x, y)));
+    }
+  }
+}
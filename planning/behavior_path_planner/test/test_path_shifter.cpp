@@ -0,0 +1,168 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "behavior_path_planner/util/path_shifter/path_shifter.hpp"
+#include "input.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using behavior_path_planner::PathShifter;
+using behavior_path_planner::PathWithLaneId;
+using behavior_path_planner::SHIFT_TYPE;
+using behavior_path_planner::ShiftedPath;
+using behavior_path_planner::ShiftLine;
+
+namespace
+{
+constexpr double epsilon = 1e-9;
+
+ShiftLine createShiftLine(
+  const PathWithLaneId & path, const size_t start_idx, const size_t end_idx,
+  const double end_shift_length)
+{
+  ShiftLine line;
+  line.start = path.points.at(start_idx).point.pose;
+  line.end = path.points.at(end_idx).point.pose;
+  line.end_shift_length = end_shift_length;
+  return line;
+}
+
+// the shifted path of a path shifter without the cache of an earlier generation
+ShiftedPath generateWithoutCache(
+  const PathWithLaneId & path, const std::vector<ShiftLine> & lines, const bool offset_back,
+  const SHIFT_TYPE type)
+{
+  PathShifter path_shifter;
+  path_shifter.setPath(path);
+  path_shifter.setShiftLines(lines);
+  ShiftedPath shifted_path;
+  EXPECT_TRUE(path_shifter.generate(&shifted_path, offset_back, type));
+  return shifted_path;
+}
+
+void expectSameShiftedPath(const ShiftedPath & expected, const ShiftedPath & actual)
+{
+  ASSERT_EQ(actual.path.points.size(), expected.path.points.size());
+  ASSERT_EQ(actual.shift_length.size(), expected.shift_length.size());
+  for (size_t i = 0; i < expected.path.points.size(); ++i) {
+    const auto & expected_pose = expected.path.points.at(i).point.pose;
+    const auto & actual_pose = actual.path.points.at(i).point.pose;
+    EXPECT_NEAR(actual_pose.position.x, expected_pose.position.x, epsilon);
+    EXPECT_NEAR(actual_pose.position.y, expected_pose.position.y, epsilon);
+    EXPECT_NEAR(actual_pose.orientation.z, expected_pose.orientation.z, epsilon);
+    EXPECT_NEAR(actual_pose.orientation.w, expected_pose.orientation.w, epsilon);
+    EXPECT_NEAR(actual.shift_length.at(i), expected.shift_length.at(i), epsilon);
+  }
+}
+}  // namespace
+
+TEST(BehaviorPathPlanningPathShifterTest, cachedShiftSameAsUncached)
+{
+  const auto path = behavior_path_planner::generateStraightSamplePathWithLaneId(0.0, 1.0, 60);
+
+  for (const auto type : {SHIFT_TYPE::LINEAR, SHIFT_TYPE::SPLINE}) {
+    for (const bool offset_back : {true, false}) {
+      PathShifter path_shifter;
+      path_shifter.setPath(path);
+      std::vector<ShiftLine> lines = {createShiftLine(path, 5, 15, 1.0)};
+      path_shifter.setShiftLines(lines);
+      ShiftedPath shifted_path;
+      ASSERT_TRUE(path_shifter.generate(&shifted_path, offset_back, type));
+      expectSameShiftedPath(generateWithoutCache(path, lines, offset_back, type), shifted_path);
+
+      // Same shift lines
+      ASSERT_TRUE(path_shifter.generate(&shifted_path, offset_back, type));
+      expectSameShiftedPath(generateWithoutCache(path, lines, offset_back, type), shifted_path);
+
+      // Shift lines added
+      lines.push_back(createShiftLine(path, 20, 30, -0.5));
+      lines.push_back(createShiftLine(path, 35, 45, 2.0));
+      path_shifter.setShiftLines(lines);
+      ASSERT_TRUE(path_shifter.generate(&shifted_path, offset_back, type));
+      expectSameShiftedPath(generateWithoutCache(path, lines, offset_back, type), shifted_path);
+
+      // Shift length of the line in the middle changed
+      lines.at(1).end_shift_length = 0.5;
+      path_shifter.setShiftLines(lines);
+      ASSERT_TRUE(path_shifter.generate(&shifted_path, offset_back, type));
+      expectSameShiftedPath(generateWithoutCache(path, lines, offset_back, type), shifted_path);
+
+      // End of the line in the middle changed
+      lines.at(1) = createShiftLine(path, 20, 32, 0.5);
+      path_shifter.setShiftLines(lines);
+      ASSERT_TRUE(path_shifter.generate(&shifted_path, offset_back, type));
+      expectSameShiftedPath(generateWithoutCache(path, lines, offset_back, type), shifted_path);
+
+      // Shift line removed
+      lines.pop_back();
+      path_shifter.setShiftLines(lines);
+      ASSERT_TRUE(path_shifter.generate(&shifted_path, offset_back, type));
+      expectSameShiftedPath(generateWithoutCache(path, lines, offset_back, type), shifted_path);
+    }
+  }
+}
+
+TEST(BehaviorPathPlanningPathShifterTest, cacheInvalidatedByReferencePath)
+{
+  const auto straight_path =
+    behavior_path_planner::generateStraightSamplePathWithLaneId(0.0, 1.0, 60);
+  const auto diagonal_path =
+    behavior_path_planner::generateDiagonalSamplePathWithLaneId(0.0, 1.0, 60);
+
+  PathShifter path_shifter;
+  path_shifter.setPath(straight_path);
+  path_shifter.setShiftLines({createShiftLine(straight_path, 5, 15, 1.0)});
+  ShiftedPath shifted_path;
+  ASSERT_TRUE(path_shifter.generate(&shifted_path));
+
+  // Same shift lines on another reference path
+  const std::vector<ShiftLine> lines = {createShiftLine(diagonal_path, 5, 15, 1.0)};
+  path_shifter.setPath(diagonal_path);
+  path_shifter.setShiftLines(lines);
+  ASSERT_TRUE(path_shifter.generate(&shifted_path));
+  expectSameShiftedPath(
+    generateWithoutCache(diagonal_path, lines, true, SHIFT_TYPE::SPLINE), shifted_path);
+}
+
+TEST(BehaviorPathPlanningPathShifterTest, cacheInvalidatedByShiftParameters)
+{
+  const auto path = behavior_path_planner::generateStraightSamplePathWithLaneId(0.0, 1.0, 60);
+  const std::vector<ShiftLine> lines = {
+    createShiftLine(path, 5, 15, 1.0), createShiftLine(path, 20, 30, -0.5)};
+
+  PathShifter path_shifter;
+  path_shifter.setPath(path);
+  path_shifter.setShiftLines(lines);
+  ShiftedPath shifted_path;
+  ASSERT_TRUE(path_shifter.generate(&shifted_path));
+
+  // Other shift type
+  ASSERT_TRUE(path_shifter.generate(&shifted_path, true, SHIFT_TYPE::LINEAR));
+  expectSameShiftedPath(generateWithoutCache(path, lines, true, SHIFT_TYPE::LINEAR), shifted_path);
+
+  // Lateral acceleration limit
+  path_shifter.setVelocity(10.0);
+  path_shifter.setLateralAccelerationLimit(0.1);
+  ASSERT_TRUE(path_shifter.generate(&shifted_path));
+  PathShifter uncached_path_shifter;
+  uncached_path_shifter.setPath(path);
+  uncached_path_shifter.setShiftLines(lines);
+  uncached_path_shifter.setVelocity(10.0);
+  uncached_path_shifter.setLateralAccelerationLimit(0.1);
+  ShiftedPath uncached_shifted_path;
+  ASSERT_TRUE(uncached_path_shifter.generate(&uncached_shifted_path));
+  expectSameShiftedPath(uncached_shifted_path, shifted_path);
+}
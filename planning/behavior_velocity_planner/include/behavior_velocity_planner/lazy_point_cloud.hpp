@@ -0,0 +1,53 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef BEHAVIOR_VELOCITY_PLANNER__LAZY_POINT_CLOUD_HPP_
+#define BEHAVIOR_VELOCITY_PLANNER__LAZY_POINT_CLOUD_HPP_
+
+#include <geometry_msgs/msg/transform.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+#include <mutex>
+
+namespace behavior_velocity_planner
+{
+/**
+ * @brief pointcloud message converted to the map frame only when a scene module first asks for
+ *        its points. The converted cloud is shared by the modules until the next message.
+ */
+class LazyPointCloud
+{
+public:
+  LazyPointCloud(
+    const sensor_msgs::msg::PointCloud2::ConstSharedPtr & msg,
+    const geometry_msgs::msg::Transform & transform)
+  : msg_(msg), transform_(transform)
+  {
+  }
+
+  // thread safe, the modules may run in parallel
+  const pcl::PointCloud<pcl::PointXYZ> & get() const;
+
+private:
+  sensor_msgs::msg::PointCloud2::ConstSharedPtr msg_;
+  geometry_msgs::msg::Transform transform_;  // from the frame of msg_ to map
+  mutable std::once_flag converted_;
+  mutable pcl::PointCloud<pcl::PointXYZ> transformed_;
+};
+}  // namespace behavior_velocity_planner
+
+#endif  // BEHAVIOR_VELOCITY_PLANNER__LAZY_POINT_CLOUD_HPP_
@@ -111,7 +111,8 @@ private:
   BehaviorVelocityPlannerManager planner_manager_;
   bool is_driving_forward_{true};
   HADMapBin::ConstSharedPtr map_ptr_{nullptr};
-  bool has_received_map_;
+  // the route handler of the last received map, set up by onLaneletMap() until onTrigger() takes it
+  std::shared_ptr<route_handler::RouteHandler> received_route_handler_{nullptr};
 
   // mutex for planner_data_
   std::mutex mutex_;
@@ -30,6 +30,7 @@
 #include <lanelet2_traffic_rules/TrafficRulesFactory.h>
 #include <tf2_ros/transform_listener.h>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -42,6 +43,13 @@ public:
   void launchSceneModule(
     const std::shared_ptr<SceneModuleManagerInterface> & scene_module_manager_ptr);
 
+  /**
+   * @brief set the number of threads the scene module managers are run with. With more than one
+   *        thread, every manager plans on its own copy of the input path and the planned paths
+   *        are merged afterwards in the launch order of the managers.
+   */
+  void setNumThreads(const size_t num_threads) { num_threads_ = std::max<size_t>(num_threads, 1); }
+
   autoware_auto_planning_msgs::msg::PathWithLaneId planPathVelocity(
     const std::shared_ptr<const PlannerData> & planner_data,
     const autoware_auto_planning_msgs::msg::PathWithLaneId & input_path_msg);
@@ -51,6 +59,11 @@ public:
 private:
   std::vector<std::shared_ptr<SceneModuleManagerInterface>> scene_manager_ptrs_;
   diagnostic_msgs::msg::DiagnosticStatus stop_reason_diag_;
+  size_t num_threads_{1};
+
+  autoware_auto_planning_msgs::msg::PathWithLaneId planPathVelocityInParallel(
+    const std::shared_ptr<const PlannerData> & planner_data,
+    const autoware_auto_planning_msgs::msg::PathWithLaneId & input_path_msg);
 };
 }  // namespace behavior_velocity_planner
 
@@ -32,6 +32,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace behavior_velocity_planner
 {
@@ -149,12 +150,16 @@ private:
   /**
    * @brief Check if at least one of object's predicted position is in area
    * @param object Dynamic object
+   * @param predicted_path_sizes number of points to check in each predicted path
    * @param area Area defined by polygon
+   * @param area_box bounding box of the area
+   * @param ego_yaw yaw of ego vehicle
    * @return True when at least one of object's predicted position is in area
    */
   bool isPredictedPathInArea(
     const autoware_auto_perception_msgs::msg::PredictedObject & object,
-    const lanelet::CompoundPolygon3d & area, geometry_msgs::msg::Pose ego_pose) const;
+    const std::vector<size_t> & predicted_path_sizes, const Polygon2d & area,
+    const tier4_autoware_utils::Box2d & area_box, const double ego_yaw) const;
 
   /**
    * @brief Generate a stop line and insert it into the path.
@@ -204,15 +209,6 @@ private:
     lanelet::LaneletMapConstPtr lanelet_map_ptr,
     lanelet::routing::RoutingGraphPtr routing_graph_ptr, const int lane_id);
 
-  /**
-   * @brief Modify objects predicted path. remove path point if the time exceeds timer_thr.
-   * @param objects_ptr target objects
-   * @param time_thr    time threshold to cut path
-   */
-  void cutPredictPathWithDuration(
-    autoware_auto_perception_msgs::msg::PredictedObjects * objects_ptr,
-    const double time_thr) const;
-
   StateMachine state_machine_;  //! for state
 
   // Debug
@@ -17,6 +17,7 @@
 
 #include <lanelet2_extension/utility/query.hpp>
 #include <lanelet2_extension/utility/utilities.hpp>
+#include <motion_utils/trajectory/indexed_trajectory.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <scene_module/crosswalk/util.hpp>
 #include <scene_module/scene_module_interface.hpp>
@@ -113,8 +114,10 @@ private:
   boost::optional<std::pair<double, geometry_msgs::msg::Point>> getStopLine(
     const PathWithLaneId & ego_path, bool & exist_stopline_in_map) const;
 
+  // ego_path is given with its arc length table and the segment of the ego position
   std::vector<CollisionPoint> getCollisionPoints(
-    const PathWithLaneId & ego_path, const PredictedObject & object,
+    const motion_utils::IndexedTrajectory<std::vector<PathPointWithLaneId>> & ego_path,
+    const size_t ego_seg_idx, const PredictedObject & object,
     const boost::geometry::model::polygon<boost::geometry::model::d2::point_xy<double>> &
       attention_area,
     const std::pair<double, double> & crosswalk_attention_range);
@@ -119,7 +119,11 @@ private:
   bool is_go_out_;
   // Parameter
   PlannerParam planner_param_;
-  std::optional<util::IntersectionLanelets> intersection_lanelets_;
+  // objective lanelets built on launch, for the traffic light arrow being off and on
+  util::IntersectionLanelets intersection_lanelets_;
+  util::IntersectionLanelets intersection_lanelets_with_arrow_;
+  // arrow state the first conflicting/detection areas were last searched with
+  std::optional<bool> first_areas_tl_arrow_solid_on_;
   // for an intersection lane l1, its associative lanes are those that share same parent lanelet and
   // have same turn_direction
   const std::set<int> assoc_ids_;
@@ -129,8 +133,8 @@ private:
    * actual collision check algorithm inside this function)
    * @param lanelet_map_ptr  lanelet map
    * @param path             ego-car lane
-   * @param detection_area_lanelet_ids  angle check is performed for obstacles using this lanelet
-   * ids
+   * @param intersection_lanelets  angle check is performed for obstacles using the attention and
+   * adjacent lanelets
    * @param intersection_area associated intersection_area if exists
    * @param objects_ptr      target objects
    * @param closest_idx      ego-car position index on the lane
@@ -139,8 +143,7 @@ private:
   bool checkCollision(
     lanelet::LaneletMapConstPtr lanelet_map_ptr,
     const autoware_auto_planning_msgs::msg::PathWithLaneId & path,
-    const lanelet::ConstLanelets & detection_area_lanelets,
-    const lanelet::ConstLanelets & adjacent_lanelets,
+    const util::IntersectionLanelets & intersection_lanelets,
     const std::optional<Polygon2d> & intersection_area, const lanelet::ConstLanelet & ego_lane,
     const lanelet::ConstLanelets & ego_lane_with_next_lane,
     const autoware_auto_perception_msgs::msg::PredictedObjects::ConstSharedPtr objects_ptr,
@@ -219,12 +222,15 @@ private:
    * @brief Whether the given pose belongs to any target lanelet or not
    * @param pose pose to be checked
    * @param target_lanelet_ids id list of target lanelets
+   * @param target_polygons 2d polygons of target lanelets
+   * @param target_boxes bounding boxes of target_polygons
    * @param thresh_angle angle threshold considered to belong to a lanelet
    * @return true if the given pose belongs to any target lanelet
    */
   bool checkAngleForTargetLanelets(
     const geometry_msgs::msg::Pose & pose, const lanelet::ConstLanelets & target_lanelet_ids,
-    const double margin = 0);
+    const std::vector<lanelet::BasicPolygon2d> & target_polygons,
+    const std::vector<lanelet::BoundingBox2d> & target_boxes, const double margin = 0);
 
   /**
    * @brief Get path polygon of intersection part and next lane part
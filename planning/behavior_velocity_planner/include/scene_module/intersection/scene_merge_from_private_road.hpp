@@ -97,7 +97,8 @@ private:
 
   // Parameter
   PlannerParam planner_param_;
-  std::optional<util::IntersectionLanelets> intersection_lanelets_;
+  util::IntersectionLanelets intersection_lanelets_;  //! built on launch
+  bool is_first_areas_searched_ = false;
 
   StateMachine state_machine_;  //! for state
 
@@ -53,15 +53,21 @@ std::optional<size_t> getDuplicatedPointIdx(
   const geometry_msgs::msg::Point & point);
 
 /**
- * @brief get objective polygons for detection area
+ * @brief get objective polygons for detection area. they only depend on the map and the lane, so
+ * the first areas intersecting the path are left empty (see updateFirstObjectiveAreas)
  */
 IntersectionLanelets getObjectiveLanelets(
   lanelet::LaneletMapConstPtr lanelet_map_ptr, lanelet::routing::RoutingGraphPtr routing_graph_ptr,
-  const int lane_id, const std::set<int> & assoc_ids,
-  const autoware_auto_planning_msgs::msg::PathWithLaneId & path,
-  const std::pair<size_t, size_t> lane_interval, const double detection_area_length,
+  const int lane_id, const std::set<int> & assoc_ids, const double detection_area_length,
   const bool tl_arrow_solid_on = false);
 
+/**
+ * @brief find the first conflicting/detection area polygons intersecting the path
+ */
+void updateFirstObjectiveAreas(
+  const autoware_auto_planning_msgs::msg::PathWithLaneId & path,
+  const std::pair<size_t, size_t> lane_interval, IntersectionLanelets * intersection_lanelets);
+
 /**
  * @brief Generate a stop line and insert it into the path. If the stop line is defined in the map,
  * read it from the map; otherwise, generate a stop line at a position where it will not collide.
@@ -127,6 +133,10 @@ std::vector<lanelet::CompoundPolygon3d> getPolygon3dFromLanelets(
 std::vector<lanelet::CompoundPolygon3d> getPolygon3dFromLanelets(
   const lanelet::ConstLanelets & ll_vec);
 
+void getPolygon2dFromLanelets(
+  const lanelet::ConstLanelets & ll_vec, std::vector<lanelet::BasicPolygon2d> * polygons,
+  std::vector<lanelet::BoundingBox2d> * boxes);
+
 std::vector<int> getLaneletIdsFromLaneletsVec(const std::vector<lanelet::ConstLanelets> & ll_vec);
 
 lanelet::ConstLanelet generateOffsetLanelet(
@@ -15,8 +15,10 @@
 #ifndef SCENE_MODULE__INTERSECTION__UTIL_TYPE_HPP_
 #define SCENE_MODULE__INTERSECTION__UTIL_TYPE_HPP_
 
+#include <lanelet2_core/primitives/BoundingBox.h>
 #include <lanelet2_core/primitives/CompoundPolygon.h>
 #include <lanelet2_core/primitives/Lanelet.h>
+#include <lanelet2_core/primitives/Polygon.h>
 
 #include <optional>
 #include <vector>
@@ -32,6 +34,11 @@ struct IntersectionLanelets
   std::vector<lanelet::CompoundPolygon3d> attention_area;
   std::vector<lanelet::CompoundPolygon3d> conflicting_area;
   std::vector<lanelet::CompoundPolygon3d> adjacent_area;
+  // 2d polygons and bounding boxes of the attention/adjacent lanelets for the object-in-area tests
+  std::vector<lanelet::BasicPolygon2d> attention_polygons;
+  std::vector<lanelet::BoundingBox2d> attention_boxes;
+  std::vector<lanelet::BasicPolygon2d> adjacent_polygons;
+  std::vector<lanelet::BoundingBox2d> adjacent_boxes;
   // the first area intersecting with the path
   // even if lane change/re-routing happened on the intersection, these areas area are supposed to
   // be invariant under the 'associative' lanes.
@@ -167,6 +167,8 @@ private:
 
   // Key Feature
   const lanelet::autoware::NoStoppingArea & no_stopping_area_reg_elem_;
+  lanelet::BasicPolygons2d no_stopping_area_polygons_;  //! 2D no stopping areas of the reg elem
+  std::vector<lanelet::BoundingBox2d> no_stopping_area_boxes_;
   std::shared_ptr<const rclcpp::Time> last_obstacle_found_time_;
 
   // Parameter
@@ -91,13 +91,55 @@ struct GridParam
   int occupied_min;    // minimum value of an occupied cell in the occupancy grid
 };
 
+/**
+ * @brief bit-packed masks of the occupied and unknown cells of the "layer" of a grid map.
+ *        Built once per cycle, it takes the cells whose center is inside a polygon from
+ *        grid_map_utils::PolygonIterator as row spans and tests 64 cells of a span per operation.
+ */
+class OcclusionRaster
+{
+public:
+  // the grid map must outlive the raster
+  explicit OcclusionRaster(const grid_map::GridMap & grid);
+
+  //!< @brief Return true if a cell whose center is inside the polygon is occupied
+  bool hasOccupiedCell(const Polygon2d & polygon) const;
+  //!< @brief Return the positions of the unknown cells whose center is inside the polygon
+  std::vector<grid_map::Position> findUnknownCells(const Polygon2d & polygon) const;
+
+private:
+  using Word = uint64_t;
+  static constexpr int word_bits = 64;
+
+  // range of columns of a row, indexed from the start index of the grid map
+  struct Span
+  {
+    int row;
+    int from_col;
+    int to_col;
+  };
+
+  std::vector<Span> calcSpans(const Polygon2d & polygon) const;
+  bool hasCell(const std::vector<Word> & mask, const Span & span) const;
+
+  const grid_map::GridMap & grid_;
+  grid_map::Index start_index_;
+  grid_map::Position origin_;  // position of the cell at the start index
+  double resolution_;
+  int rows_;
+  int cols_;
+  int words_per_row_;
+  std::vector<Word> occupied_;
+  std::vector<Word> unknown_;
+};
+
 //!< @brief Find all occlusion spots inside the given lanelet
 void findOcclusionSpots(
-  std::vector<grid_map::Position> & occlusion_spot_positions, const grid_map::GridMap & grid,
+  std::vector<grid_map::Position> & occlusion_spot_positions, const OcclusionRaster & raster,
   const Polygon2d & polygon, const double min_size);
 //!< @brief Return true if the path between the two given points is free of occupied cells
 bool isCollisionFree(
-  const grid_map::GridMap & grid, const grid_map::Position & p1, const grid_map::Position & p2,
+  const OcclusionRaster & raster, const grid_map::Position & p1, const grid_map::Position & p2,
   const double radius);
 boost::optional<Polygon2d> generateOccupiedPolygon(
   const Polygon2d & occupancy_poly, const Polygons2d & stuck_vehicle_foot_prints,
@@ -119,6 +119,7 @@ struct DynamicObstacleParam
   float max_prediction_time;  // [sec]
   float time_step;            // [sec]
   float points_interval;      // [m]
+  int num_threads;            // threads to group the points with the path segments
 };
 
 struct PlannerParam
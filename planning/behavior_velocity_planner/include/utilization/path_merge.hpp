@@ -0,0 +1,53 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UTILIZATION__PATH_MERGE_HPP_
+#define UTILIZATION__PATH_MERGE_HPP_
+
+#include <autoware_auto_planning_msgs/msg/path_with_lane_id.hpp>
+
+#include <boost/optional.hpp>
+
+#include <vector>
+
+namespace behavior_velocity_planner
+{
+// tolerance of the arc length to regard points of the planned paths as the same point
+constexpr double merge_epsilon = 1e-3;
+
+struct PlannedPath
+{
+  autoware_auto_planning_msgs::msg::PathWithLaneId path;
+  std::vector<double> arc_lengths;
+  boost::optional<int> first_stop_path_point_index;
+};
+
+std::vector<double> calcArcLengths(const autoware_auto_planning_msgs::msg::PathWithLaneId & path);
+
+/**
+ * @brief merge the paths planned by the managers on copies of the input path. The scene modules
+ *        only insert points and lower velocities, so the merged path has the points of the input
+ *        path and the points inserted by every manager, and the minimum velocity they planned.
+ */
+autoware_auto_planning_msgs::msg::PathWithLaneId mergePlannedPaths(
+  const autoware_auto_planning_msgs::msg::PathWithLaneId & input_path,
+  const std::vector<PlannedPath> & planned_paths, std::vector<double> * merged_arc_lengths);
+
+/**
+ * @brief find the index of the merged path point at the given arc length
+ */
+int findMergedIndex(const std::vector<double> & merged_arc_lengths, const double arc_length);
+}  // namespace behavior_velocity_planner
+
+#endif  // UTILIZATION__PATH_MERGE_HPP_
@@ -0,0 +1,40 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "behavior_velocity_planner/lazy_point_cloud.hpp"
+
+#include <pcl/common/transforms.h>
+#include <pcl_conversions/pcl_conversions.h>
+
+#ifdef ROS_DISTRO_GALACTIC
+#include <tf2_eigen/tf2_eigen.h>
+#else
+#include <tf2_eigen/tf2_eigen.hpp>
+#endif
+
+namespace behavior_velocity_planner
+{
+const pcl::PointCloud<pcl::PointXYZ> & LazyPointCloud::get() const
+{
+  std::call_once(converted_, [this]() {
+    pcl::PointCloud<pcl::PointXYZ> pc;
+    pcl::fromROSMsg(*msg_, pc);
+    if (!pc.empty()) {
+      const Eigen::Affine3f affine = tf2::transformToEigen(transform_).cast<float>();
+      pcl::transformPointCloud(pc, transformed_, affine);
+    }
+  });
+  return transformed_;
+}
+}  // namespace behavior_velocity_planner
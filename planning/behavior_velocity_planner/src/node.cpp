@@ -22,13 +22,6 @@
 #include <visualization_msgs/msg/marker_array.hpp>
 
 #include <lanelet2_routing/Route.h>
-#include <pcl/common/transforms.h>
-
-#ifdef ROS_DISTRO_GALACTIC
-#include <tf2_eigen/tf2_eigen.h>
-#else
-#include <tf2_eigen/tf2_eigen.hpp>
-#endif
 
 #include <functional>
 #include <memory>
@@ -160,6 +153,7 @@ BehaviorVelocityPlannerNode::BehaviorVelocityPlannerNode(const rclcpp::NodeOptio
     this->declare_parameter<double>("ego_nearest_yaw_threshold");
 
   // Initialize PlannerManager
+  planner_manager_.setNumThreads(this->declare_parameter("scene_module_num_threads", 1));
   if (this->declare_parameter("launch_crosswalk", true)) {
     planner_manager_.launchSceneModule(std::make_shared<CrosswalkModuleManager>(*this));
     planner_manager_.launchSceneModule(std::make_shared<WalkwayModuleManager>(*this));
@@ -267,18 +261,13 @@ void BehaviorVelocityPlannerNode::onNoGroundPointCloud(
     return;
   }
 
-  pcl::PointCloud<pcl::PointXYZ> pc;
-  pcl::fromROSMsg(*msg, pc);
-
-  Eigen::Affine3f affine = tf2::transformToEigen(transform.transform).cast<float>();
-  pcl::PointCloud<pcl::PointXYZ>::Ptr pc_transformed(new pcl::PointCloud<pcl::PointXYZ>);
-  if (!pc.empty()) {
-    pcl::transformPointCloud(pc, *pc_transformed, affine);
-  }
+  // the conversion is deferred until a scene module needs the points
+  const auto no_ground_pointcloud =
+    std::make_shared<const LazyPointCloud>(msg, transform.transform);
 
   {
     std::lock_guard<std::mutex> lock(mutex_);
-    planner_data_.no_ground_pointcloud = pc_transformed;
+    planner_data_.no_ground_pointcloud = no_ground_pointcloud;
   }
 }
 
@@ -334,10 +323,13 @@ void BehaviorVelocityPlannerNode::onParam()
 void BehaviorVelocityPlannerNode::onLaneletMap(
   const autoware_auto_mapping_msgs::msg::HADMapBin::ConstSharedPtr msg)
 {
+  // build the route handler here, out of the planning thread, which only takes it over
+  auto route_handler = std::make_shared<route_handler::RouteHandler>(*msg);
+
   std::lock_guard<std::mutex> lock(mutex_);
 
   map_ptr_ = msg;
-  has_received_map_ = true;
+  received_route_handler_ = route_handler;
 }
 
 void BehaviorVelocityPlannerNode::onTrafficSignals(
@@ -402,9 +394,9 @@ void BehaviorVelocityPlannerNode::onTrigger(
   }
 
   // Load map and check route handler
-  if (has_received_map_) {
-    planner_data_.route_handler_ = std::make_shared<route_handler::RouteHandler>(*map_ptr_);
-    has_received_map_ = false;
+  if (received_route_handler_) {
+    planner_data_.route_handler_ = received_route_handler_;
+    received_route_handler_ = nullptr;
   }
   if (!planner_data_.route_handler_) {
     RCLCPP_INFO_THROTTLE(
@@ -14,10 +14,13 @@
 
 #include "behavior_velocity_planner/planner_manager.hpp"
 
+#include <utilization/path_merge.hpp>
+
 #include <boost/format.hpp>
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace behavior_velocity_planner
 {
@@ -59,6 +62,10 @@ autoware_auto_planning_msgs::msg::PathWithLaneId BehaviorVelocityPlannerManager:
   const std::shared_ptr<const PlannerData> & planner_data,
   const autoware_auto_planning_msgs::msg::PathWithLaneId & input_path_msg)
 {
+  if (num_threads_ > 1 && !input_path_msg.points.empty()) {
+    return planPathVelocityInParallel(planner_data, input_path_msg);
+  }
+
   autoware_auto_planning_msgs::msg::PathWithLaneId output_path_msg = input_path_msg;
 
   int first_stop_path_point_index = static_cast<int>(output_path_msg.points.size() - 1);
@@ -83,6 +90,52 @@ autoware_auto_planning_msgs::msg::PathWithLaneId BehaviorVelocityPlannerManager:
   return output_path_msg;
 }
 
+autoware_auto_planning_msgs::msg::PathWithLaneId
+BehaviorVelocityPlannerManager::planPathVelocityInParallel(
+  const std::shared_ptr<const PlannerData> & planner_data,
+  const autoware_auto_planning_msgs::msg::PathWithLaneId & input_path_msg)
+{
+  // decide: every manager plans on its own copy of the input path
+  std::vector<PlannedPath> planned_paths(scene_manager_ptrs_.size());
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic)
+  for (size_t i = 0; i < scene_manager_ptrs_.size(); ++i) {
+    const auto & scene_manager_ptr = scene_manager_ptrs_.at(i);
+    auto & planned_path = planned_paths.at(i);
+    planned_path.path = input_path_msg;
+    scene_manager_ptr->updateSceneModuleInstances(planner_data, input_path_msg);
+    scene_manager_ptr->plan(&planned_path.path);
+    planned_path.arc_lengths = calcArcLengths(planned_path.path);
+    planned_path.first_stop_path_point_index = scene_manager_ptr->getFirstStopPathPointIndex();
+  }
+
+  // apply: merge the planned paths in the launch order of the managers
+  std::vector<double> merged_arc_lengths;
+  const auto output_path_msg =
+    mergePlannedPaths(input_path_msg, planned_paths, &merged_arc_lengths);
+
+  int first_stop_path_point_index = static_cast<int>(output_path_msg.points.size() - 1);
+  std::string stop_reason_msg("path_end");
+
+  for (size_t i = 0; i < scene_manager_ptrs_.size(); ++i) {
+    const auto & planned_path = planned_paths.at(i);
+    const auto & index = planned_path.first_stop_path_point_index;
+    if (!index || *index < 0 || static_cast<size_t>(*index) >= planned_path.arc_lengths.size()) {
+      continue;
+    }
+    const int merged_index =
+      findMergedIndex(merged_arc_lengths, planned_path.arc_lengths.at(*index));
+    if (merged_index < first_stop_path_point_index) {
+      first_stop_path_point_index = merged_index;
+      stop_reason_msg = scene_manager_ptrs_.at(i)->getModuleName();
+    }
+  }
+
+  stop_reason_diag_ = makeStopReasonDiag(
+    stop_reason_msg, output_path_msg.points[first_stop_path_point_index].point.pose);
+
+  return output_path_msg;
+}
+
 diagnostic_msgs::msg::DiagnosticStatus BehaviorVelocityPlannerManager::getStopReasonDiag() const
 {
   return stop_reason_diag_;
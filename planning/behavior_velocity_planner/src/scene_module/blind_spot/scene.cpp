@@ -35,9 +35,39 @@
 namespace behavior_velocity_planner
 {
 namespace bg = boost::geometry;
+using tier4_autoware_utils::Box2d;
 
 namespace
 {
+Polygon2d toPolygon2d(const lanelet::CompoundPolygon3d & poly)
+{
+  Polygon2d polygon;
+  for (const auto & p : poly) {
+    polygon.outer().emplace_back(p.x(), p.y());
+  }
+  bg::correct(polygon);
+  return polygon;
+}
+
+/**
+ * @brief Count the leading points of the predicted path whose predicted time is less than time_thr
+ * from now. The predicted time increases along the path, so those points form its prefix.
+ */
+size_t calcPredictedPathSizeWithinDuration(
+  const autoware_auto_perception_msgs::msg::PredictedPath & predicted_path,
+  const rclcpp::Time & objects_stamp, const rclcpp::Time & current_time, const double time_thr)
+{
+  size_t size = 0;
+  for (; size < predicted_path.path.size(); ++size) {
+    const auto predicted_time =
+      objects_stamp + rclcpp::Duration(predicted_path.time_step) * static_cast<double>(size);
+    if ((predicted_time - current_time).seconds() >= time_thr) {
+      break;
+    }
+  }
+  return size;
+}
+
 geometry_msgs::msg::Polygon toGeomPoly(const lanelet::CompoundPolygon3d & poly)
 {
   geometry_msgs::msg::Polygon geom_poly;
@@ -204,15 +234,23 @@ boost::optional<int> BlindSpotModule::getFirstPointConflictingLanelets(
   using lanelet::utils::to2D;
   using lanelet::utils::toHybrid;
 
+  // the vehicle edges are shared by all the lanelets
+  std::vector<lanelet::LineString2d> vehicle_edges;
+  vehicle_edges.reserve(path.points.size());
+  for (const auto & path_point : path.points) {
+    vehicle_edges.push_back(getVehicleEdge(
+      path_point.point.pose, planner_data_->vehicle_info_.vehicle_width_m,
+      planner_data_->vehicle_info_.max_longitudinal_offset_m));
+  }
+
   int first_idx_conflicting_lanelets = path.points.size() - 1;
   bool is_conflict = false;
   for (const auto & ll : lanelets) {
-    const auto line = (turn_direction_ == TurnDirection::LEFT) ? ll.leftBound() : ll.rightBound();
-    for (size_t i = 0; i < path.points.size(); ++i) {
-      const auto vehicle_edge = getVehicleEdge(
-        path.points.at(i).point.pose, planner_data_->vehicle_info_.vehicle_width_m,
-        planner_data_->vehicle_info_.max_longitudinal_offset_m);
-      if (bg::intersects(toHybrid(to2D(line)), toHybrid(vehicle_edge))) {
+    const auto line =
+      to2D((turn_direction_ == TurnDirection::LEFT) ? ll.leftBound() : ll.rightBound());
+    const auto hybrid_line = toHybrid(line);
+    for (size_t i = 0; i < vehicle_edges.size(); ++i) {
+      if (bg::intersects(hybrid_line, toHybrid(vehicle_edges.at(i)))) {
         first_idx_conflicting_lanelets =
           std::min(first_idx_conflicting_lanelets, static_cast<int>(i));
         is_conflict = true;
@@ -292,29 +330,6 @@ bool BlindSpotModule::generateStopLine(
   return true;
 }
 
-void BlindSpotModule::cutPredictPathWithDuration(
-  autoware_auto_perception_msgs::msg::PredictedObjects * objects_ptr, const double time_thr) const
-{
-  const rclcpp::Time current_time = clock_->now();
-
-  for (auto & object : objects_ptr->objects) {                         // each objects
-    for (auto & predicted_path : object.kinematics.predicted_paths) {  // each predicted paths
-      const auto origin_path = predicted_path;
-      predicted_path.path.clear();
-
-      for (size_t k = 0; k < origin_path.path.size(); ++k) {  // each path points
-        const auto & predicted_pose = origin_path.path.at(k);
-        const auto predicted_time =
-          rclcpp::Time(objects_ptr->header.stamp) +
-          rclcpp::Duration(origin_path.time_step) * static_cast<double>(k);
-        if ((predicted_time - current_time).seconds() < time_thr) {
-          predicted_path.path.push_back(predicted_pose);
-        }
-      }
-    }
-  }
-}
-
 int BlindSpotModule::insertPoint(
   const int insert_idx_ip, const autoware_auto_planning_msgs::msg::PathWithLaneId path_ip,
   autoware_auto_planning_msgs::msg::PathWithLaneId * inout_path) const
@@ -381,24 +396,54 @@ bool BlindSpotModule::checkObstacleInBlindSpot(
     debug_data_.detection_area_for_blind_spot = toGeomPoly(areas_opt.get().detection_area);
     debug_data_.conflict_area_for_blind_spot = toGeomPoly(areas_opt.get().conflict_area);
 
-    autoware_auto_perception_msgs::msg::PredictedObjects objects = *objects_ptr;
-    cutPredictPathWithDuration(&objects, planner_param_.max_future_movement_time);
+    // the areas are converted once per cycle and their bounds are used to cull objects
+    const auto detection_area = toPolygon2d(areas_opt.get().detection_area);
+    const auto conflict_area = toPolygon2d(areas_opt.get().conflict_area);
+    const auto detection_area_box = bg::return_envelope<Box2d>(detection_area);
+    const auto conflict_area_box = bg::return_envelope<Box2d>(conflict_area);
+    const auto ego_yaw = tf2::getYaw(planner_data_->current_odometry->pose.orientation);
+
+    const rclcpp::Time objects_stamp = objects_ptr->header.stamp;
+    const rclcpp::Time current_time = clock_->now();
 
     // check objects in blind spot areas
     bool obstacle_detected = false;
-    for (const auto & object : objects.objects) {
+    std::vector<size_t> predicted_path_sizes;
+    for (const auto & object : objects_ptr->objects) {
       if (!isTargetObjectType(object)) {
         continue;
       }
 
-      bool exist_in_detection_area = bg::within(
-        to_bg2d(object.kinematics.initial_pose_with_covariance.pose.position),
-        lanelet::utils::to2D(areas_opt.get().detection_area));
-      bool exist_in_conflict_area = isPredictedPathInArea(
-        object, areas_opt.get().conflict_area, planner_data_->current_odometry->pose);
+      // predicted paths are viewed up to max_future_movement_time instead of being copied
+      const auto & position = object.kinematics.initial_pose_with_covariance.pose.position;
+      Box2d object_box(to_bg2d(position), to_bg2d(position));
+      predicted_path_sizes.clear();
+      for (const auto & predicted_path : object.kinematics.predicted_paths) {
+        predicted_path_sizes.push_back(calcPredictedPathSizeWithinDuration(
+          predicted_path, objects_stamp, current_time, planner_param_.max_future_movement_time));
+        for (size_t i = 0; i < predicted_path_sizes.back(); ++i) {
+          bg::expand(object_box, to_bg2d(predicted_path.path.at(i).position));
+        }
+      }
+      if (
+        bg::disjoint(object_box, detection_area_box) &&
+        bg::disjoint(object_box, conflict_area_box)) {
+        continue;
+      }
+
+      const bool exist_in_detection_area =
+        bg::within(to_bg2d(position), detection_area_box) &&
+        bg::within(to_bg2d(position), detection_area);
+      const bool exist_in_conflict_area = isPredictedPathInArea(
+        object, predicted_path_sizes, conflict_area, conflict_area_box, ego_yaw);
       if (exist_in_detection_area || exist_in_conflict_area) {
         obstacle_detected = true;
-        debug_data_.conflicting_targets.objects.push_back(object);
+        auto conflicting_target = object;
+        for (size_t i = 0; i < predicted_path_sizes.size(); ++i) {
+          conflicting_target.kinematics.predicted_paths.at(i).path.resize(
+            predicted_path_sizes.at(i));
+        }
+        debug_data_.conflicting_targets.objects.push_back(std::move(conflicting_target));
       }
     }
     return obstacle_detected;
@@ -409,24 +454,27 @@ bool BlindSpotModule::checkObstacleInBlindSpot(
 
 bool BlindSpotModule::isPredictedPathInArea(
   const autoware_auto_perception_msgs::msg::PredictedObject & object,
-  const lanelet::CompoundPolygon3d & area, geometry_msgs::msg::Pose ego_pose) const
+  const std::vector<size_t> & predicted_path_sizes, const Polygon2d & area,
+  const Box2d & area_box, const double ego_yaw) const
 {
-  const auto area_2d = lanelet::utils::to2D(area);
-  const auto ego_yaw = tf2::getYaw(ego_pose.orientation);
   const auto threshold_yaw_diff = planner_param_.threshold_yaw_diff;
   // NOTE: iterating all paths including those of low confidence
-  return std::any_of(
-    object.kinematics.predicted_paths.begin(), object.kinematics.predicted_paths.end(),
-    [&area_2d, &ego_yaw, &threshold_yaw_diff](const auto & path) {
-      return std::any_of(
-        path.path.begin(), path.path.end(),
-        [&area_2d, &ego_yaw, &threshold_yaw_diff](const auto & point) {
-          const auto is_in_area = bg::within(to_bg2d(point.position), area_2d);
-          const auto match_yaw =
-            std::fabs(ego_yaw - tf2::getYaw(point.orientation)) < threshold_yaw_diff;
-          return is_in_area && match_yaw;
-        });
-    });
+  for (size_t i = 0; i < object.kinematics.predicted_paths.size(); ++i) {
+    const auto & path = object.kinematics.predicted_paths.at(i).path;
+    for (size_t j = 0; j < predicted_path_sizes.at(i); ++j) {
+      const auto & point = path.at(j);
+      const auto match_yaw =
+        std::fabs(ego_yaw - tf2::getYaw(point.orientation)) < threshold_yaw_diff;
+      if (!match_yaw) {
+        continue;
+      }
+      const auto p = to_bg2d(point.position);
+      if (bg::within(p, area_box) && bg::within(p, area)) {
+        return true;
+      }
+    }
+  }
+  return false;
 }
 
 lanelet::ConstLanelet BlindSpotModule::generateHalfLanelet(
@@ -13,13 +13,16 @@
 // limitations under the License.
 
 #include <autoware_auto_tf2/tf2_autoware_auto_msgs.hpp>
+#include <motion_utils/trajectory/indexed_trajectory.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <scene_module/crosswalk/scene_crosswalk.hpp>
 #include <tier4_autoware_utils/tier4_autoware_utils.hpp>
 #include <utilization/path_utilization.hpp>
 #include <utilization/util.hpp>
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <vector>
 
 namespace behavior_velocity_planner
@@ -317,14 +320,15 @@ boost::optional<geometry_msgs::msg::Point> CrosswalkModule::findNearestStopPoint
 
   const auto ego_polygon = createVehiclePolygon(planner_data_->vehicle_info_);
 
+  const motion_utils::IndexedTrajectory indexed_path(sparse_resample_path.points);
+  const size_t ego_seg_idx = findNearestSegmentIndex(sparse_resample_path.points, ego_pos);
+
   Polygon attention_area;
   for (size_t j = 0; j < sparse_resample_path.points.size() - 1; ++j) {
     const auto & p_ego_front = sparse_resample_path.points.at(j).point.pose;
     const auto & p_ego_back = sparse_resample_path.points.at(j + 1).point.pose;
-    const auto front_length =
-      calcSignedArcLength(sparse_resample_path.points, ego_pos, p_ego_front.position);
-    const auto back_length =
-      calcSignedArcLength(sparse_resample_path.points, ego_pos, p_ego_back.position);
+    const auto front_length = indexed_path.calcSignedArcLength(ego_pos, ego_seg_idx, j);
+    const auto back_length = indexed_path.calcSignedArcLength(ego_pos, ego_seg_idx, j + 1);
 
     if (back_length < crosswalk_attention_range.first) {
       continue;
@@ -364,7 +368,7 @@ boost::optional<geometry_msgs::msg::Point> CrosswalkModule::findNearestStopPoint
     }
 
     for (auto & cp : getCollisionPoints(
-           sparse_resample_path, object, attention_area, crosswalk_attention_range)) {
+           indexed_path, ego_seg_idx, object, attention_area, crosswalk_attention_range)) {
       const auto is_ignore_object = ignore_objects_.count(obj_uuid) != 0;
       if (is_ignore_object) {
         cp.state = CollisionPointState::IGNORE;
@@ -387,7 +391,9 @@ boost::optional<geometry_msgs::msg::Point> CrosswalkModule::findNearestStopPoint
       stop_factor.stop_factor_points.push_back(obj_pos);
 
       const auto dist_ego2cp =
-        calcSignedArcLength(sparse_resample_path.points, ego_pos, cp.collision_point) -
+        indexed_path.calcSignedArcLength(
+          ego_pos, ego_seg_idx, cp.collision_point,
+          findNearestSegmentIndex(sparse_resample_path.points, cp.collision_point)) -
         planner_param_.stop_margin;
 
       if (dist_ego2cp < minimum_stop_dist) {
@@ -636,7 +642,8 @@ void CrosswalkModule::clampAttentionRangeByNeighborCrosswalks(
 }
 
 std::vector<CollisionPoint> CrosswalkModule::getCollisionPoints(
-  const PathWithLaneId & ego_path, const PredictedObject & object, const Polygon & attention_area,
+  const motion_utils::IndexedTrajectory<std::vector<PathPointWithLaneId>> & ego_path,
+  const size_t ego_seg_idx, const PredictedObject & object, const Polygon & attention_area,
   const std::pair<double, double> & crosswalk_attention_range)
 {
   stop_watch_.tic(__func__);
@@ -651,10 +658,34 @@ std::vector<CollisionPoint> CrosswalkModule::getCollisionPoints(
   const auto obj_polygon =
     createObjectPolygon(object.shape.dimensions.x, object.shape.dimensions.y);
 
+  // the steps whose bounding box misses the one of the attention area are skipped before any
+  // polygon is built. The box of a step is the one of the circles bounding the object polygon at
+  // both ends of the step.
+  bg::model::box<Point> attention_area_box{};
+  bg::envelope(attention_area, attention_area_box);
+  double obj_radius = 0.0;
+  for (const auto & p : obj_polygon.points) {
+    obj_radius = std::max(obj_radius, std::hypot(p.x, p.y));
+  }
+  const auto misses_attention_area = [&](const auto & p_front, const auto & p_back) {
+    const auto & front = p_front.position;
+    const auto & back = p_back.position;
+    return std::max(front.x, back.x) + obj_radius < attention_area_box.min_corner().x() ||
+           std::min(front.x, back.x) - obj_radius > attention_area_box.max_corner().x() ||
+           std::max(front.y, back.y) + obj_radius < attention_area_box.min_corner().y() ||
+           std::min(front.y, back.y) - obj_radius > attention_area_box.max_corner().y();
+  };
+
   for (const auto & obj_path : object.kinematics.predicted_paths) {
+    if (attention_area.outer().empty()) {
+      break;
+    }
     for (size_t i = 0; i < obj_path.path.size() - 1; ++i) {
-      const auto p_obj_front = obj_path.path.at(i);
-      const auto p_obj_back = obj_path.path.at(i + 1);
+      const auto & p_obj_front = obj_path.path.at(i);
+      const auto & p_obj_back = obj_path.path.at(i + 1);
+      if (misses_attention_area(p_obj_front, p_obj_back)) {
+        continue;
+      }
       const auto obj_one_step_polygon = createOneStepPolygon(p_obj_front, p_obj_back, obj_polygon);
 
       std::vector<Point> tmp_intersects{};
@@ -675,7 +706,8 @@ std::vector<CollisionPoint> CrosswalkModule::getCollisionPoints(
       geometry_msgs::msg::Point nearest_collision_point{};
       for (const auto & p : tmp_intersects) {
         geometry_msgs::msg::Point cp = createPoint(p.x(), p.y(), ego_pos.z);
-        const auto dist_ego2cp = calcSignedArcLength(ego_path.points, ego_pos, cp);
+        const auto dist_ego2cp = ego_path.calcSignedArcLength(
+          ego_pos, ego_seg_idx, cp, findNearestSegmentIndex(ego_path.points(), cp));
 
         if (dist_ego2cp < minimum_stop_dist) {
           minimum_stop_dist = dist_ego2cp;
@@ -683,8 +715,7 @@ std::vector<CollisionPoint> CrosswalkModule::getCollisionPoints(
         }
       }
 
-      const auto dist_ego2cp =
-        calcSignedArcLength(ego_path.points, ego_pos, nearest_collision_point);
+      const auto dist_ego2cp = minimum_stop_dist;
       constexpr double eps = 1e-3;
       const auto dist_obj2cp =
         calcArcLength(obj_path.path) < eps
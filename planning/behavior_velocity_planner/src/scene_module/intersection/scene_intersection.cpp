@@ -69,6 +69,16 @@ IntersectionModule::IntersectionModule(
   has_traffic_light_ =
     !(assigned_lanelet.regulatoryElementsAs<const lanelet::TrafficLight>().empty());
   state_machine_.setMarginTime(planner_param_.state_transit_margin_time);
+
+  /* the objective lanelets only depend on the map, so build them once for each arrow state */
+  const auto lanelet_map_ptr = planner_data->route_handler_->getLaneletMapPtr();
+  const auto routing_graph_ptr = planner_data->route_handler_->getRoutingGraphPtr();
+  intersection_lanelets_ = util::getObjectiveLanelets(
+    lanelet_map_ptr, routing_graph_ptr, lane_id_, assoc_ids_, planner_param_.detection_area_length,
+    false);
+  intersection_lanelets_with_arrow_ = util::getObjectiveLanelets(
+    lanelet_map_ptr, routing_graph_ptr, lane_id_, assoc_ids_, planner_param_.detection_area_length,
+    true);
 }
 
 bool IntersectionModule::modifyPathVelocity(PathWithLaneId * path, StopReason * stop_reason)
@@ -92,7 +102,6 @@ bool IntersectionModule::modifyPathVelocity(PathWithLaneId * path, StopReason *
 
   /* get lanelet map */
   const auto lanelet_map_ptr = planner_data_->route_handler_->getLaneletMapPtr();
-  const auto routing_graph_ptr = planner_data_->route_handler_->getRoutingGraphPtr();
   const auto & assigned_lanelet =
     planner_data_->route_handler_->getLaneletMapPtr()->laneletLayer.get(lane_id_);
   const std::string turn_direction = assigned_lanelet.attributeOr("turn_direction", "else");
@@ -121,20 +130,17 @@ bool IntersectionModule::modifyPathVelocity(PathWithLaneId * path, StopReason *
   /* dynamically change detection area based on tl_arrow_solid_on */
   const bool tl_arrow_solid_on =
     util::isTrafficLightArrowActivated(assigned_lanelet, planner_data_->traffic_light_id_map);
-  if (
-    !intersection_lanelets_ ||
-    intersection_lanelets_.value().tl_arrow_solid_on != tl_arrow_solid_on) {
-    intersection_lanelets_ = util::getObjectiveLanelets(
-      lanelet_map_ptr, routing_graph_ptr, lane_id_, assoc_ids_, path_ip, lane_interval_ip,
-      planner_param_.detection_area_length, tl_arrow_solid_on);
+  auto & intersection_lanelets =
+    tl_arrow_solid_on ? intersection_lanelets_with_arrow_ : intersection_lanelets_;
+  if (!first_areas_tl_arrow_solid_on_ || *first_areas_tl_arrow_solid_on_ != tl_arrow_solid_on) {
+    util::updateFirstObjectiveAreas(path_ip, lane_interval_ip, &intersection_lanelets);
+    first_areas_tl_arrow_solid_on_ = tl_arrow_solid_on;
   }
-  const auto & detection_lanelets = intersection_lanelets_.value().attention;
-  const auto & adjacent_lanelets = intersection_lanelets_.value().adjacent;
-  const auto & detection_area = intersection_lanelets_.value().attention_area;
-  const auto & first_conflicting_area = intersection_lanelets_.value().first_conflicting_area;
-  const auto & first_detection_area = intersection_lanelets_.value().first_detection_area;
+  const auto & detection_area = intersection_lanelets.attention_area;
+  const auto & first_conflicting_area = intersection_lanelets.first_conflicting_area;
+  const auto & first_detection_area = intersection_lanelets.first_detection_area;
   debug_data_.detection_area = detection_area;
-  debug_data_.adjacent_area = intersection_lanelets_.value().adjacent_area;
+  debug_data_.adjacent_area = intersection_lanelets.adjacent_area;
 
   /* get intersection area */
   const auto intersection_area = util::getIntersectionArea(assigned_lanelet, lanelet_map_ptr);
@@ -215,7 +221,7 @@ bool IntersectionModule::modifyPathVelocity(PathWithLaneId * path, StopReason *
   const double time_delay =
     is_go_out_ ? 0.0 : (planner_param_.state_transit_margin_time - state_machine_.getDuration());
   const bool has_collision = checkCollision(
-    lanelet_map_ptr, *path, detection_lanelets, adjacent_lanelets, intersection_area, ego_lane,
+    lanelet_map_ptr, *path, intersection_lanelets, intersection_area, ego_lane,
     ego_lane_with_next_lane, objects_ptr, closest_idx, time_delay);
 
   /* calculate final stop lines */
@@ -327,8 +333,7 @@ void IntersectionModule::cutPredictPathWithDuration(
 bool IntersectionModule::checkCollision(
   lanelet::LaneletMapConstPtr lanelet_map_ptr,
   const autoware_auto_planning_msgs::msg::PathWithLaneId & path,
-  const lanelet::ConstLanelets & detection_area_lanelets,
-  const lanelet::ConstLanelets & adjacent_lanelets,
+  const util::IntersectionLanelets & intersection_lanelets,
   const std::optional<Polygon2d> & intersection_area, const lanelet::ConstLanelet & ego_lane,
   const lanelet::ConstLanelets & ego_lane_with_next_lane,
   const autoware_auto_perception_msgs::msg::PredictedObjects::ConstSharedPtr objects_ptr,
@@ -349,7 +354,8 @@ bool IntersectionModule::checkCollision(
     // check direction of objects
     const auto object_direction = getObjectPoseWithVelocityDirection(object.kinematics);
     const auto is_in_adjacent_lanelets = checkAngleForTargetLanelets(
-      object_direction, adjacent_lanelets, planner_param_.detection_area_margin);
+      object_direction, intersection_lanelets.adjacent, intersection_lanelets.adjacent_polygons,
+      intersection_lanelets.adjacent_boxes, planner_param_.detection_area_margin);
     if (is_in_adjacent_lanelets) {
       continue;
     }
@@ -361,12 +367,15 @@ bool IntersectionModule::checkCollision(
       if (is_in_intersection_area) {
         target_objects.objects.push_back(object);
       } else if (checkAngleForTargetLanelets(
-                   object_direction, detection_area_lanelets,
+                   object_direction, intersection_lanelets.attention,
+                   intersection_lanelets.attention_polygons, intersection_lanelets.attention_boxes,
                    planner_param_.detection_area_margin)) {
         target_objects.objects.push_back(object);
       }
     } else if (checkAngleForTargetLanelets(
-                 object_direction, detection_area_lanelets, planner_param_.detection_area_margin)) {
+                 object_direction, intersection_lanelets.attention,
+                 intersection_lanelets.attention_polygons, intersection_lanelets.attention_boxes,
+                 planner_param_.detection_area_margin)) {
       // intersection_area is not available, use detection_area_with_margin as before
       target_objects.objects.push_back(object);
     }
@@ -652,12 +661,20 @@ bool IntersectionModule::isTargetExternalInputStatus(const int target_status)
 
 bool IntersectionModule::checkAngleForTargetLanelets(
   const geometry_msgs::msg::Pose & pose, const lanelet::ConstLanelets & target_lanelets,
-  const double margin)
+  const std::vector<lanelet::BasicPolygon2d> & target_polygons,
+  const std::vector<lanelet::BoundingBox2d> & target_boxes, const double margin)
 {
-  for (const auto & ll : target_lanelets) {
-    if (!lanelet::utils::isInLanelet(pose, ll, margin)) {
+  // same as lanelet::utils::isInLanelet() with the polygons and their boxes built on launch
+  constexpr double eps = 1.0e-9;
+  const lanelet::BasicPoint2d p(pose.position.x, pose.position.y);
+  for (size_t i = 0; i < target_lanelets.size(); ++i) {
+    if (target_boxes.at(i).exteriorDistance(p) >= margin + eps) {
+      continue;
+    }
+    if (!(bg::distance(p, target_polygons.at(i)) < margin + eps)) {
       continue;
     }
+    const auto & ll = target_lanelets.at(i);
     const double ll_angle = lanelet::utils::getLaneletAngle(ll, pose.position);
     const double pose_angle = tf2::getYaw(pose.orientation);
     const double angle_diff = tier4_autoware_utils::normalizeRadian(ll_angle - pose_angle);
@@ -34,14 +34,19 @@ namespace bg = boost::geometry;
 
 MergeFromPrivateRoadModule::MergeFromPrivateRoadModule(
   const int64_t module_id, const int64_t lane_id,
-  [[maybe_unused]] std::shared_ptr<const PlannerData> planner_data,
-  const PlannerParam & planner_param, const std::set<int> & assoc_ids, const rclcpp::Logger logger,
+  std::shared_ptr<const PlannerData> planner_data, const PlannerParam & planner_param,
+  const std::set<int> & assoc_ids, const rclcpp::Logger logger,
   const rclcpp::Clock::SharedPtr clock)
 : SceneModuleInterface(module_id, logger, clock), lane_id_(lane_id), assoc_ids_(assoc_ids)
 {
   velocity_factor_.init(VelocityFactor::MERGE);
   planner_param_ = planner_param;
   state_machine_.setState(StateMachine::State::STOP);
+
+  intersection_lanelets_ = util::getObjectiveLanelets(
+    planner_data->route_handler_->getLaneletMapPtr(),
+    planner_data->route_handler_->getRoutingGraphPtr(), lane_id_, {} /* not used here */,
+    planner_param_.detection_area_length, false /* tl_arrow_solid on does not matter here*/);
 }
 
 bool MergeFromPrivateRoadModule::modifyPathVelocity(PathWithLaneId * path, StopReason * stop_reason)
@@ -59,10 +64,6 @@ bool MergeFromPrivateRoadModule::modifyPathVelocity(PathWithLaneId * path, StopR
   /* get current pose */
   geometry_msgs::msg::Pose current_pose = planner_data_->current_odometry->pose;
 
-  /* get lanelet map */
-  const auto lanelet_map_ptr = planner_data_->route_handler_->getLaneletMapPtr();
-  const auto routing_graph_ptr = planner_data_->route_handler_->getRoutingGraphPtr();
-
   /* spline interpolation */
   constexpr double interval = 0.2;
   autoware_auto_planning_msgs::msg::PathWithLaneId path_ip;
@@ -84,13 +85,11 @@ bool MergeFromPrivateRoadModule::modifyPathVelocity(PathWithLaneId * path, StopR
   const auto lane_interval_ip = lane_interval_ip_opt.value();
 
   /* get detection area */
-  if (!intersection_lanelets_.has_value()) {
-    intersection_lanelets_ = util::getObjectiveLanelets(
-      lanelet_map_ptr, routing_graph_ptr, lane_id_, {} /* not used here */, path_ip,
-      lane_interval_ip, planner_param_.detection_area_length,
-      false /* tl_arrow_solid on does not matter here*/);
+  if (!is_first_areas_searched_) {
+    util::updateFirstObjectiveAreas(path_ip, lane_interval_ip, &intersection_lanelets_);
+    is_first_areas_searched_ = true;
   }
-  const auto & first_conflicting_area = intersection_lanelets_.value().first_conflicting_area;
+  const auto & first_conflicting_area = intersection_lanelets_.first_conflicting_area;
 
   /* set stop-line and stop-judgement-line for base_link */
   const auto stop_lines_idx_opt =
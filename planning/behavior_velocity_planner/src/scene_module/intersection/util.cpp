@@ -385,9 +385,7 @@ bool getStopLineIndexFromMap(
 
 IntersectionLanelets getObjectiveLanelets(
   lanelet::LaneletMapConstPtr lanelet_map_ptr, lanelet::routing::RoutingGraphPtr routing_graph_ptr,
-  const int lane_id, const std::set<int> & assoc_ids,
-  const autoware_auto_planning_msgs::msg::PathWithLaneId & path,
-  const std::pair<size_t, size_t> lane_interval, const double detection_area_length,
+  const int lane_id, const std::set<int> & assoc_ids, const double detection_area_length,
   const bool tl_arrow_solid_on)
 {
   const auto & assigned_lanelet = lanelet_map_ptr->laneletLayer.get(lane_id);
@@ -493,8 +491,21 @@ IntersectionLanelets getObjectiveLanelets(
   result.attention_area = getPolygon3dFromLanelets(result.attention);
   result.conflicting_area = getPolygon3dFromLanelets(result.conflicting);
   result.adjacent_area = getPolygon3dFromLanelets(result.adjacent);
+  // polygon2d
+  getPolygon2dFromLanelets(result.attention, &result.attention_polygons, &result.attention_boxes);
+  getPolygon2dFromLanelets(result.adjacent, &result.adjacent_polygons, &result.adjacent_boxes);
+  result.tl_arrow_solid_on = tl_arrow_solid_on;
+
+  return result;
+}
 
-  // find the first conflicting/detection area polygon intersecting the path
+void updateFirstObjectiveAreas(
+  const autoware_auto_planning_msgs::msg::PathWithLaneId & path,
+  const std::pair<size_t, size_t> lane_interval, IntersectionLanelets * intersection_lanelets)
+{
+  auto & result = *intersection_lanelets;
+  result.first_conflicting_area = std::nullopt;
+  result.first_detection_area = std::nullopt;
   {
     auto first = util::getFirstPointInsidePolygons(path, lane_interval, result.conflicting_area);
     if (first) {
@@ -507,8 +518,6 @@ IntersectionLanelets getObjectiveLanelets(
       result.first_detection_area = first.value().second;
     }
   }
-
-  return result;
 }
 
 std::vector<lanelet::CompoundPolygon3d> getPolygon3dFromLanelets(
@@ -534,6 +543,24 @@ std::vector<lanelet::CompoundPolygon3d> getPolygon3dFromLanelets(
   return polys;
 }
 
+void getPolygon2dFromLanelets(
+  const lanelet::ConstLanelets & ll_vec, std::vector<lanelet::BasicPolygon2d> * polygons,
+  std::vector<lanelet::BoundingBox2d> * boxes)
+{
+  polygons->clear();
+  boxes->clear();
+  polygons->reserve(ll_vec.size());
+  boxes->reserve(ll_vec.size());
+  for (auto && ll : ll_vec) {
+    polygons->push_back(ll.polygon2d().basicPolygon());
+    lanelet::BoundingBox2d box;
+    for (const auto & p : polygons->back()) {
+      box.extend(p);
+    }
+    boxes->push_back(box);
+  }
+}
+
 std::vector<int> getLaneletIdsFromLanelets(lanelet::ConstLanelets ll)
 {
   std::vector<int> id_list;
@@ -38,6 +38,25 @@
 namespace behavior_velocity_planner
 {
 namespace bg = boost::geometry;
+using tier4_autoware_utils::Box2d;
+
+namespace
+{
+lanelet::BoundingBox2d calcSegmentBox(
+  const geometry_msgs::msg::Point & p0, const geometry_msgs::msg::Point & p1)
+{
+  lanelet::BoundingBox2d box(lanelet::BasicPoint2d(p0.x, p0.y));
+  box.extend(lanelet::BasicPoint2d(p1.x, p1.y));
+  return box;
+}
+
+lanelet::BoundingBox2d toBoundingBox2d(const Box2d & box)
+{
+  return lanelet::BoundingBox2d(
+    lanelet::BasicPoint2d(box.min_corner().x(), box.min_corner().y()),
+    lanelet::BasicPoint2d(box.max_corner().x(), box.max_corner().y()));
+}
+}  // namespace
 
 NoStoppingAreaModule::NoStoppingAreaModule(
   const int64_t module_id, const int64_t lane_id,
@@ -52,6 +71,15 @@ NoStoppingAreaModule::NoStoppingAreaModule(
   velocity_factor_.init(VelocityFactor::NO_STOPPING_AREA);
   state_machine_.setState(StateMachine::State::GO);
   state_machine_.setMarginTime(planner_param_.state_clear_time);
+
+  for (const auto & no_stopping_area : no_stopping_area_reg_elem_.noStoppingAreas()) {
+    no_stopping_area_polygons_.push_back(lanelet::utils::to2D(no_stopping_area).basicPolygon());
+    lanelet::BoundingBox2d box;
+    for (const auto & p : no_stopping_area_polygons_.back()) {
+      box.extend(p);
+    }
+    no_stopping_area_boxes_.push_back(box);
+  }
 }
 
 boost::optional<LineString2d> NoStoppingAreaModule::getStopLineGeometry2d(
@@ -77,12 +105,15 @@ boost::optional<LineString2d> NoStoppingAreaModule::getStopLineGeometry2d(
      *        ---------------
      **/
 
-    for (const auto & no_stopping_area : no_stopping_area_reg_elem_.noStoppingAreas()) {
-      const auto & area_poly = lanelet::utils::to2D(no_stopping_area).basicPolygon();
-      lanelet::BasicLineString2d path_line;
+    for (size_t area_idx = 0; area_idx < no_stopping_area_polygons_.size(); ++area_idx) {
+      const auto & area_poly = no_stopping_area_polygons_.at(area_idx);
+      const auto & area_box = no_stopping_area_boxes_.at(area_idx);
       for (size_t i = 0; i < path.points.size() - 1; ++i) {
         const auto p0 = path.points.at(i).point.pose.position;
         const auto p1 = path.points.at(i + 1).point.pose.position;
+        if (!area_box.intersects(calcSegmentBox(p0, p1))) {
+          continue;
+        }
         const LineString2d line{{p0.x, p0.y}, {p1.x, p1.y}};
         std::vector<Point2d> collision_points;
         bg::intersection(area_poly, line, collision_points);
@@ -222,6 +253,7 @@ bool NoStoppingAreaModule::checkStuckVehiclesInNoStoppingArea(
   const autoware_auto_perception_msgs::msg::PredictedObjects::ConstSharedPtr &
     predicted_obj_arr_ptr)
 {
+  const auto poly_box = bg::return_envelope<Box2d>(poly);
   // stuck points by predicted objects
   for (const auto & object : predicted_obj_arr_ptr->objects) {
     if (!isTargetStuckVehicleType(object)) {
@@ -233,6 +265,9 @@ bool NoStoppingAreaModule::checkStuckVehiclesInNoStoppingArea(
     }
     // check if the footprint is in the stuck detect area
     const Polygon2d obj_footprint = tier4_autoware_utils::toPolygon2d(object);
+    if (bg::disjoint(bg::return_envelope<Box2d>(obj_footprint), poly_box)) {
+      continue;
+    }
     const bool is_in_stuck_area = !bg::disjoint(obj_footprint, poly);
     if (is_in_stuck_area) {
       RCLCPP_DEBUG(logger_, "stuck vehicle found.");
@@ -252,6 +287,7 @@ bool NoStoppingAreaModule::checkStopLinesInNoStoppingArea(
   const autoware_auto_planning_msgs::msg::PathWithLaneId & path, const Polygon2d & poly)
 {
   const double stop_vel = std::numeric_limits<float>::min();
+  const auto poly_box = toBoundingBox2d(bg::return_envelope<Box2d>(poly));
   // stuck points by stop line
   for (size_t i = 0; i < path.points.size() - 1; ++i) {
     const auto p0 = path.points.at(i).point.pose.position;
@@ -261,6 +297,9 @@ bool NoStoppingAreaModule::checkStopLinesInNoStoppingArea(
     if (v0 > stop_vel && v1 > stop_vel) {
       continue;
     }
+    if (!poly_box.intersects(calcSegmentBox(p0, p1))) {
+      continue;
+    }
     const LineString2d line{{p0.x, p0.y}, {p1.x, p1.y}};
     std::vector<Point2d> collision_points;
     bg::intersection(poly, line, collision_points);
@@ -303,14 +342,19 @@ Polygon2d NoStoppingAreaModule::generateEgoNoStoppingAreaLanePolygon(
   size_t ego_area_start_idx = closest_idx + num_ignore_nearest;
   size_t ego_area_end_idx = ego_area_start_idx;
   // return if area size is not intentional
-  if (no_stopping_area_reg_elem_.noStoppingAreas().size() != 1) {
+  if (no_stopping_area_polygons_.size() != 1) {
     return ego_area;
   }
-  const auto no_stopping_area = no_stopping_area_reg_elem_.noStoppingAreas().front();
+  const auto & no_stopping_area = no_stopping_area_polygons_.front();
+  const auto & no_stopping_area_box = no_stopping_area_boxes_.front();
+  const auto is_in_no_stopping_area = [&](const geometry_msgs::msg::Point & p) {
+    return no_stopping_area_box.contains(lanelet::BasicPoint2d(p.x, p.y)) &&
+           bg::within(Point2d{p.x, p.y}, no_stopping_area);
+  };
   for (size_t i = closest_idx + num_ignore_nearest; i < pp.size() - 1; ++i) {
     dist_from_start_sum += tier4_autoware_utils::calcDistance2d(pp.at(i), pp.at(i - 1));
     const auto & p = pp.at(i).point.pose.position;
-    if (bg::within(Point2d{p.x, p.y}, lanelet::utils::to2D(no_stopping_area).basicPolygon())) {
+    if (is_in_no_stopping_area(p)) {
       is_in_area = true;
       break;
     }
@@ -331,7 +375,7 @@ Polygon2d NoStoppingAreaModule::generateEgoNoStoppingAreaLanePolygon(
   for (size_t i = ego_area_start_idx; i < pp.size() - 1; ++i) {
     dist_from_start_sum += tier4_autoware_utils::calcDistance2d(pp.at(i), pp.at(i - 1));
     const auto & p = pp.at(i).point.pose.position;
-    if (!bg::within(Point2d{p.x, p.y}, lanelet::utils::to2D(no_stopping_area).basicPolygon())) {
+    if (!is_in_no_stopping_area(p)) {
       dist_from_area_sum += tier4_autoware_utils::calcDistance2d(pp.at(i), pp.at(i - 1));
     }
     if (dist_from_start_sum > extra_dist || dist_from_area_sum > margin) {
@@ -15,7 +15,10 @@
 #include <scene_module/occlusion_spot/grid_utils.hpp>
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 namespace behavior_velocity_planner
@@ -41,84 +44,125 @@ Polygon2d pointsToPoly(const Point2d p0, const Point2d p1, const double radius)
   return line_poly;
 }
 
-std::vector<std::pair<grid_map::Position, grid_map::Position>> pointsToRays(
-  const grid_map::Position p0, const grid_map::Position p1, const double radius)
+OcclusionRaster::OcclusionRaster(const grid_map::GridMap & grid)
+: grid_(grid), start_index_(grid.getStartIndex())
 {
-  using grid_map::Position;
-  std::vector<std::pair<Position, Position>> lines;
-  const double angle = atan2(p0.y() - p1.y(), p0.x() - p1.x());
-  const double r = radius;
-  lines.emplace_back(std::make_pair(p0, p1));
-  lines.emplace_back(std::make_pair(
-    Position(p0.x() + r * sin(angle), p0.y() - r * cos(angle)),
-    Position(p1.x() + r * sin(angle), p1.y() - r * cos(angle))));
-  lines.emplace_back(std::make_pair(
-    Position(p1.x() - r * sin(angle), p1.y() + r * cos(angle)),
-    Position(p0.x() - r * sin(angle), p0.y() + r * cos(angle))));
-  return lines;
+  const grid_map::Matrix & grid_data = grid["layer"];
+  grid.getPosition(start_index_, origin_);
+  resolution_ = grid.getResolution();
+  rows_ = grid.getSize()(0);
+  cols_ = grid.getSize()(1);
+  words_per_row_ = (cols_ + word_bits - 1) / word_bits;
+  occupied_.assign(static_cast<size_t>(rows_) * words_per_row_, 0);
+  unknown_.assign(static_cast<size_t>(rows_) * words_per_row_, 0);
+  for (int row = 0; row < rows_; ++row) {
+    const int data_row = (start_index_(0) + row) % rows_;
+    for (int col = 0; col < cols_; ++col) {
+      const int data_col = (start_index_(1) + col) % cols_;
+      const auto value = grid_data(data_row, data_col);
+      const size_t word_idx = static_cast<size_t>(row) * words_per_row_ + col / word_bits;
+      const Word bit = Word{1} << (col % word_bits);
+      if (value == occlusion_cost_value::OCCUPIED) {
+        occupied_[word_idx] |= bit;
+      } else if (value == occlusion_cost_value::UNKNOWN) {
+        unknown_[word_idx] |= bit;
+      }
+    }
+  }
 }
 
-void findOcclusionSpots(
-  std::vector<grid_map::Position> & occlusion_spot_positions, const grid_map::GridMap & grid,
-  const Polygon2d & polygon, [[maybe_unused]] double min_size)
+// the cells of grid_map_utils::PolygonIterator, a row after the other with increasing columns
+std::vector<OcclusionRaster::Span> OcclusionRaster::calcSpans(const Polygon2d & polygon) const
 {
-  const grid_map::Matrix & grid_data = grid["layer"];
   grid_map::Polygon grid_polygon;
   for (const auto & point : polygon.outer()) {
     grid_polygon.addVertex({point.x(), point.y()});
   }
-  for (grid_map_utils::PolygonIterator iterator(grid, grid_polygon); !iterator.isPastEnd();
+  std::vector<Span> spans;
+  for (grid_map_utils::PolygonIterator iterator(grid_, grid_polygon); !iterator.isPastEnd();
        ++iterator) {
     const grid_map::Index & index = *iterator;
-    if (grid_data(index.x(), index.y()) == grid_utils::occlusion_cost_value::UNKNOWN) {
-      grid_map::Position occlusion_spot_position;
-      if (grid.getPosition(index, occlusion_spot_position)) {
-        occlusion_spot_positions.emplace_back(occlusion_spot_position);
-      }
+    const int row = (index.x() - start_index_.x() + rows_) % rows_;
+    const int col = (index.y() - start_index_.y() + cols_) % cols_;
+    if (!spans.empty() && spans.back().row == row && spans.back().to_col + 1 == col) {
+      spans.back().to_col = col;
+    } else {
+      spans.push_back({row, col, col});
     }
   }
+  return spans;
 }
 
-bool isCollisionFree(
-  const grid_map::GridMap & grid, const grid_map::Position & p1, const grid_map::Position & p2,
-  const double radius)
+bool OcclusionRaster::hasCell(const std::vector<Word> & mask, const Span & span) const
 {
-  const grid_map::Matrix & grid_data = grid["layer"];
-  bool polys = true;
-  try {
-    if (polys) {
-      Point2d occlusion_p = {p1.x(), p1.y()};
-      Point2d collision_p = {p2.x(), p2.y()};
-      Polygon2d polygon = pointsToPoly(occlusion_p, collision_p, radius);
-      grid_map::Polygon grid_polygon;
-      for (const auto & point : polygon.outer()) {
-        grid_polygon.addVertex({point.x(), point.y()});
-      }
-      for (grid_map_utils::PolygonIterator iterator(grid, grid_polygon); !iterator.isPastEnd();
-           ++iterator) {
-        const grid_map::Index & index = *iterator;
-        if (grid_data(index.x(), index.y()) == grid_utils::occlusion_cost_value::OCCUPIED) {
-          return false;
+  const size_t row_offset = static_cast<size_t>(span.row) * words_per_row_;
+  const int from_word = span.from_col / word_bits;
+  const int to_word = span.to_col / word_bits;
+  for (int w = from_word; w <= to_word; ++w) {
+    Word word = mask[row_offset + w];
+    if (w == from_word) {
+      word &= ~Word{0} << (span.from_col % word_bits);
+    }
+    if (w == to_word) {
+      word &= ~Word{0} >> (word_bits - 1 - span.to_col % word_bits);
+    }
+    if (word != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool OcclusionRaster::hasOccupiedCell(const Polygon2d & polygon) const
+{
+  for (const auto & span : calcSpans(polygon)) {
+    if (hasCell(occupied_, span)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::vector<grid_map::Position> OcclusionRaster::findUnknownCells(const Polygon2d & polygon) const
+{
+  std::vector<grid_map::Position> positions;
+  for (const auto & span : calcSpans(polygon)) {
+    const size_t row_offset = static_cast<size_t>(span.row) * words_per_row_;
+    for (int w = span.from_col / word_bits; w <= span.to_col / word_bits; ++w) {
+      // visit only the set bits of the word
+      for (Word word = unknown_[row_offset + w]; word != 0; word &= word - 1) {
+        const int col = w * word_bits + __builtin_ctzll(word);
+        if (col < span.from_col) {
+          continue;
         }
-      }
-    } else {
-      std::vector<std::pair<grid_map::Position, grid_map::Position>> lines =
-        pointsToRays(p1, p2, radius);
-      for (const auto & p : lines) {
-        for (grid_map::LineIterator iterator(grid, p.first, p.second); !iterator.isPastEnd();
-             ++iterator) {
-          const grid_map::Index & index = *iterator;
-          if (grid_data(index.x(), index.y()) == grid_utils::occlusion_cost_value::OCCUPIED) {
-            return false;
-          }
+        if (col > span.to_col) {
+          break;
         }
+        positions.emplace_back(
+          origin_.x() - resolution_ * span.row, origin_.y() - resolution_ * col);
       }
-    }  // polys or not
-  } catch (const std::invalid_argument & e) {
-    std::cerr << e.what() << std::endl;
-    return false;
+    }
   }
-  return true;
+  return positions;
+}
+
+void findOcclusionSpots(
+  std::vector<grid_map::Position> & occlusion_spot_positions, const OcclusionRaster & raster,
+  const Polygon2d & polygon, [[maybe_unused]] double min_size)
+{
+  const auto unknown_cells = raster.findUnknownCells(polygon);
+  occlusion_spot_positions.insert(
+    occlusion_spot_positions.end(), unknown_cells.begin(), unknown_cells.end());
+}
+
+bool isCollisionFree(
+  const OcclusionRaster & raster, const grid_map::Position & p1, const grid_map::Position & p2,
+  const double radius)
+{
+  const Point2d occlusion_p = {p1.x(), p1.y()};
+  const Point2d collision_p = {p2.x(), p2.y()};
+  const Polygon2d polygon = pointsToPoly(occlusion_p, collision_p, radius);
+  return !raster.hasOccupiedCell(polygon);
 }
 
 boost::optional<Polygon2d> generateOcclusionPolygon(
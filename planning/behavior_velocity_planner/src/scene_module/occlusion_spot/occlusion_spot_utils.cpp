@@ -381,10 +381,12 @@ bool generatePossibleCollisionsFromGridMap(
   }
   double distance_lower_bound = std::numeric_limits<double>::max();
   const Polygons2d & da_polygons = debug_data.detection_area_polygons;
+  // scan the grid map once for all the detection area slices
+  const grid_utils::OcclusionRaster raster(grid);
   for (const Polygon2d & detection_area_slice : da_polygons) {
     std::vector<grid_map::Position> occlusion_spot_positions;
     grid_utils::findOcclusionSpots(
-      occlusion_spot_positions, grid, detection_area_slice,
+      occlusion_spot_positions, raster, detection_area_slice,
       param.detection_area.min_occlusion_spot_size);
     if (param.is_show_occlusion) {
       for (const auto & op : occlusion_spot_positions) {
@@ -397,7 +399,7 @@ bool generatePossibleCollisionsFromGridMap(
     // for each partition find nearest occlusion spot from polygon's origin
     const Point2d base_point = detection_area_slice.outer().at(0);
     const auto pc = generateOneNotableCollisionFromOcclusionSpot(
-      grid, occlusion_spot_positions, offset_from_start_to_ego, base_point, path_lanelet, param,
+      raster, occlusion_spot_positions, offset_from_start_to_ego, base_point, path_lanelet, param,
       debug_data);
     if (pc == boost::none) continue;
     const double lateral_distance = std::abs(pc.get().arc_lane_dist_at_collision.distance);
@@ -417,7 +419,8 @@ bool isBlockedByPartition(const LineString2d & direction, const BasicPolygons2d
 }
 
 boost::optional<PossibleCollisionInfo> generateOneNotableCollisionFromOcclusionSpot(
-  const grid_map::GridMap & grid, const std::vector<grid_map::Position> & occlusion_spot_positions,
+  const grid_utils::OcclusionRaster & raster,
+  const std::vector<grid_map::Position> & occlusion_spot_positions,
   const double offset_from_start_to_ego, const Point2d base_point,
   const lanelet::ConstLanelet & path_lanelet, const PlannerParam & param, DebugData & debug_data)
 {
@@ -459,7 +462,7 @@ boost::optional<PossibleCollisionInfo> generateOneNotableCollisionFromOcclusionS
     }
     if (is_obstacle_blocked_by_partition) continue;
     bool collision_free_at_intersection = grid_utils::isCollisionFree(
-      grid, occlusion_spot_position, grid_map::Position(ip.x, ip.y), param.pedestrian_radius);
+      raster, occlusion_spot_position, grid_map::Position(ip.x, ip.y), param.pedestrian_radius);
     if (!collision_free_at_intersection) continue;
     distance_lower_bound = dist;
     candidate = pc;
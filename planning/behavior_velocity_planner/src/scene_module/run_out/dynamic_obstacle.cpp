@@ -16,6 +16,11 @@
 
 #include <pcl/filters/voxel_grid.h>
 
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
 namespace behavior_velocity_planner
 {
 namespace
@@ -56,33 +61,11 @@ std::vector<geometry_msgs::msg::Pose> createPredictedPath(
 pcl::PointCloud<pcl::PointXYZ> applyVoxelGridFilter(
   const pcl::PointCloud<pcl::PointXYZ> & input_points)
 {
-  auto no_height_points = input_points;
-  for (auto & p : no_height_points) {
-    p.z = 0.0;
-  }
-
-  pcl::VoxelGrid<pcl::PointXYZ> filter;
-  filter.setInputCloud(pcl::make_shared<pcl::PointCloud<pcl::PointXYZ>>(no_height_points));
-  filter.setLeafSize(0.05f, 0.05f, 100000.0f);
-
-  pcl::PointCloud<pcl::PointXYZ> output_points;
-  filter.filter(output_points);
-  output_points.header = input_points.header;
-
-  return output_points;
-}
-
-pcl::PointCloud<pcl::PointXYZ> applyVoxelGridFilter(
-  const sensor_msgs::msg::PointCloud2 & input_points)
-{
-  if (input_points.data.empty()) {
-    return pcl::PointCloud<pcl::PointXYZ>();
+  if (input_points.empty()) {
+    return input_points;
   }
 
-  pcl::PointCloud<pcl::PointXYZ> input_points_pcl;
-  pcl::fromROSMsg(input_points, input_points_pcl);
-
-  auto no_height_points = input_points_pcl;
+  auto no_height_points = input_points;
   for (auto & p : no_height_points) {
     p.z = 0.0;
   }
@@ -93,6 +76,7 @@ pcl::PointCloud<pcl::PointXYZ> applyVoxelGridFilter(
 
   pcl::PointCloud<pcl::PointXYZ> output_points;
   filter.filter(output_points);
+  output_points.header = input_points.header;
 
   return output_points;
 }
@@ -106,8 +90,92 @@ bool isAheadOf(
   return is_ahead;
 }
 
+/**
+ * @brief 2D grid hash of the points of a pointcloud, built once per message so that the points in
+ *        an area are found by visiting only the cells overlapping it
+ */
+class PointCloudGridHash
+{
+public:
+  PointCloudGridHash(const pcl::PointCloud<pcl::PointXYZ> & points, const double cell_size)
+  : points_(points), cell_size_(cell_size)
+  {
+    for (size_t i = 0; i < points.size(); ++i) {
+      const auto ix = toCellIndex(points.at(i).x);
+      const auto iy = toCellIndex(points.at(i).y);
+      auto & cell = cells_[toKey(ix, iy)];
+      cell.ix = ix;
+      cell.iy = iy;
+      cell.point_indices.push_back(i);
+    }
+  }
+
+  const pcl::PointCloud<pcl::PointXYZ> & points() const { return points_; }
+
+  // indices of the points in the cells overlapping the box, in ascending order
+  std::vector<size_t> queryCandidates(const tier4_autoware_utils::Box2d & box) const
+  {
+    const auto min_ix = toCellIndex(box.min_corner().x());
+    const auto min_iy = toCellIndex(box.min_corner().y());
+    const auto max_ix = toCellIndex(box.max_corner().x());
+    const auto max_iy = toCellIndex(box.max_corner().y());
+
+    std::vector<size_t> indices;
+    const auto append = [&](const Cell & cell) {
+      indices.insert(indices.end(), cell.point_indices.begin(), cell.point_indices.end());
+    };
+    // visit the occupied cells instead when the box covers more cells than are occupied
+    const double num_box_cells =
+      static_cast<double>(max_ix - min_ix + 1) * static_cast<double>(max_iy - min_iy + 1);
+    if (num_box_cells > static_cast<double>(cells_.size())) {
+      for (const auto & key_and_cell : cells_) {
+        const auto & cell = key_and_cell.second;
+        if (min_ix <= cell.ix && cell.ix <= max_ix && min_iy <= cell.iy && cell.iy <= max_iy) {
+          append(cell);
+        }
+      }
+    } else {
+      for (auto ix = min_ix; ix <= max_ix; ++ix) {
+        for (auto iy = min_iy; iy <= max_iy; ++iy) {
+          const auto it = cells_.find(toKey(ix, iy));
+          if (it != cells_.end()) {
+            append(it->second);
+          }
+        }
+      }
+    }
+    std::sort(indices.begin(), indices.end());
+    return indices;
+  }
+
+private:
+  struct Cell
+  {
+    int64_t ix;
+    int64_t iy;
+    std::vector<size_t> point_indices;
+  };
+
+  int64_t toCellIndex(const double v) const
+  {
+    return static_cast<int64_t>(std::floor(v / cell_size_));
+  }
+
+  static int64_t toKey(const int64_t ix, const int64_t iy)
+  {
+    return (ix << 32) ^ (iy & 0xffffffff);
+  }
+
+  const pcl::PointCloud<pcl::PointXYZ> & points_;
+  const double cell_size_;
+  std::unordered_map<int64_t, Cell> cells_;
+};
+
+// [m] cell size of the grid hash of the obstacle points
+constexpr double grid_hash_cell_size = 1.0;
+
 pcl::PointCloud<pcl::PointXYZ> extractObstaclePointsWithinPolygon(
-  const pcl::PointCloud<pcl::PointXYZ> & input_points, const Polygons2d & polys)
+  const PointCloudGridHash & input_points, const Polygons2d & polys)
 {
   namespace bg = boost::geometry;
 
@@ -120,10 +188,11 @@ pcl::PointCloud<pcl::PointXYZ> extractObstaclePointsWithinPolygon(
   }
 
   pcl::PointCloud<pcl::PointXYZ> output_points;
-  output_points.header = input_points.header;
+  output_points.header = input_points.points().header;
   for (const auto & poly : polys) {
     const auto bounding_box = bg::return_envelope<tier4_autoware_utils::Box2d>(poly);
-    for (const auto & p : input_points) {
+    for (const auto idx : input_points.queryCandidates(bounding_box)) {
+      const auto & p = input_points.points().at(idx);
       Point2d point(p.x, p.y);
 
       // filter with bounding box to reduce calculation time
@@ -144,13 +213,14 @@ pcl::PointCloud<pcl::PointXYZ> extractObstaclePointsWithinPolygon(
 
 // group points with its nearest segment of path points
 std::vector<pcl::PointCloud<pcl::PointXYZ>> groupPointsWithNearestSegmentIndex(
-  const pcl::PointCloud<pcl::PointXYZ> & input_points, const PathPointsWithLaneId & path_points)
+  const pcl::PointCloud<pcl::PointXYZ> & input_points, const PathPointsWithLaneId & path_points,
+  const int num_threads)
 {
   // assign nearest segment index to each point
-  std::vector<pcl::PointCloud<pcl::PointXYZ>> points_with_index;
-  points_with_index.resize(path_points.size());
-
-  for (const auto & p : input_points.points) {
+  std::vector<size_t> nearest_indices(input_points.size());
+#pragma omp parallel for num_threads(num_threads)
+  for (size_t i = 0; i < input_points.size(); ++i) {
+    const auto & p = input_points.points.at(i);
     const auto ros_point = tier4_autoware_utils::createPoint(p.x, p.y, p.z);
     const size_t nearest_seg_idx = motion_utils::findNearestSegmentIndex(path_points, ros_point);
 
@@ -158,11 +228,17 @@ std::vector<pcl::PointCloud<pcl::PointXYZ>> groupPointsWithNearestSegmentIndex(
     if (
       nearest_seg_idx == path_points.size() - 2 &&
       isAheadOf(ros_point, path_points.back().point.pose)) {
-      points_with_index.back().push_back(p);
+      nearest_indices.at(i) = path_points.size() - 1;
       continue;
     }
 
-    points_with_index.at(nearest_seg_idx).push_back(p);
+    nearest_indices.at(i) = nearest_seg_idx;
+  }
+
+  std::vector<pcl::PointCloud<pcl::PointXYZ>> points_with_index;
+  points_with_index.resize(path_points.size());
+  for (size_t i = 0; i < input_points.size(); ++i) {
+    points_with_index.at(nearest_indices.at(i)).push_back(input_points.points.at(i));
   }
 
   return points_with_index;
@@ -187,16 +263,24 @@ pcl::PointXYZ calculateLateralNearestPoint(
 
 pcl::PointCloud<pcl::PointXYZ> selectLateralNearestPoints(
   const std::vector<pcl::PointCloud<pcl::PointXYZ>> & points_with_index,
-  const PathPointsWithLaneId & path_points)
+  const PathPointsWithLaneId & path_points, const int num_threads)
 {
-  pcl::PointCloud<pcl::PointXYZ> lateral_nearest_points;
+  std::vector<boost::optional<pcl::PointXYZ>> nearest_points(points_with_index.size());
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic)
   for (size_t idx = 0; idx < points_with_index.size(); idx++) {
     if (points_with_index.at(idx).points.empty()) {
       continue;
     }
 
-    lateral_nearest_points.push_back(
-      calculateLateralNearestPoint(points_with_index.at(idx), path_points.at(idx).point.pose));
+    nearest_points.at(idx) =
+      calculateLateralNearestPoint(points_with_index.at(idx), path_points.at(idx).point.pose);
+  }
+
+  pcl::PointCloud<pcl::PointXYZ> lateral_nearest_points;
+  for (const auto & nearest_point : nearest_points) {
+    if (nearest_point) {
+      lateral_nearest_points.push_back(*nearest_point);
+    }
   }
 
   return lateral_nearest_points;
@@ -206,7 +290,7 @@ pcl::PointCloud<pcl::PointXYZ> selectLateralNearestPoints(
 // path is interpolated with given interval
 pcl::PointCloud<pcl::PointXYZ> extractLateralNearestPoints(
   const pcl::PointCloud<pcl::PointXYZ> & input_points, const PathWithLaneId & path,
-  const float interval)
+  const float interval, const int num_threads)
 {
   // interpolate path points with given interval
   PathWithLaneId interpolated_path;
@@ -217,11 +301,11 @@ pcl::PointCloud<pcl::PointXYZ> extractLateralNearestPoints(
 
   // divide points into groups according to nearest segment index
   const auto points_with_index =
-    groupPointsWithNearestSegmentIndex(input_points, interpolated_path.points);
+    groupPointsWithNearestSegmentIndex(input_points, interpolated_path.points, num_threads);
 
   // select the lateral nearest point for each group
   const auto lateral_nearest_points =
-    selectLateralNearestPoints(points_with_index, interpolated_path.points);
+    selectLateralNearestPoints(points_with_index, interpolated_path.points, num_threads);
 
   return lateral_nearest_points;
 }
@@ -257,19 +341,13 @@ pcl::PointCloud<pcl::PointXYZ> transformPointCloud(
   return pointcloud_pcl_transformed;
 }
 
-PointCloud2 concatPointCloud(
+pcl::PointCloud<pcl::PointXYZ> concatPointCloud(
   const pcl::PointCloud<pcl::PointXYZ> & cloud1, const pcl::PointCloud<pcl::PointXYZ> & cloud2)
 {
-  // convert to ROS pointcloud to concatenate points
-  PointCloud2 cloud1_ros;
-  PointCloud2 cloud2_ros;
-  pcl::toROSMsg(cloud1, cloud1_ros);
-  pcl::toROSMsg(cloud2, cloud2_ros);
-
-  // concatenate two clouds
-  PointCloud2 concat_points;
-  pcl::concatenatePointCloud(cloud1_ros, cloud2_ros, concat_points);
-  concat_points.header = cloud1_ros.header;
+  // concatenate the pcl points directly, without converting them to ROS pointclouds
+  pcl::PointCloud<pcl::PointXYZ> concat_points = cloud1;
+  concat_points += cloud2;
+  concat_points.header = cloud1.header;
 
   return concat_points;
 }
@@ -448,12 +526,13 @@ void DynamicObstacleCreatorForPoints::onCompareMapFilteredPointCloud(
   mutex_.unlock();
 
   // filter obstacle points within detection area polygon
+  const PointCloudGridHash grid_hash_points(voxel_grid_filtered_points, grid_hash_cell_size);
   const auto detection_area_filtered_points =
-    extractObstaclePointsWithinPolygon(voxel_grid_filtered_points, detection_area_polygon);
+    extractObstaclePointsWithinPolygon(grid_hash_points, detection_area_polygon);
 
   // filter points that have lateral nearest distance
-  const auto lateral_nearest_points =
-    extractLateralNearestPoints(detection_area_filtered_points, path, param_.points_interval);
+  const auto lateral_nearest_points = extractLateralNearestPoints(
+    detection_area_filtered_points, path, param_.points_interval, param_.num_threads);
 
   std::lock_guard<std::mutex> lock(mutex_);
   obstacle_points_map_filtered_ = lateral_nearest_points;
@@ -498,10 +577,14 @@ void DynamicObstacleCreatorForPoints::onSynchronizedPointCloud(
   mutex_.unlock();
 
   // filter obstacle points within detection area polygon
-  const auto detection_area_filtered_compare_map_points = extractObstaclePointsWithinPolygon(
-    voxel_grid_filtered_compare_map_points, mandatory_detection_area);
+  const PointCloudGridHash grid_hash_compare_map_points(
+    voxel_grid_filtered_compare_map_points, grid_hash_cell_size);
+  const PointCloudGridHash grid_hash_vector_map_points(
+    voxel_grid_filtered_vector_map_points, grid_hash_cell_size);
+  const auto detection_area_filtered_compare_map_points =
+    extractObstaclePointsWithinPolygon(grid_hash_compare_map_points, mandatory_detection_area);
   const auto detection_area_filtered_vector_map_points =
-    extractObstaclePointsWithinPolygon(voxel_grid_filtered_vector_map_points, detection_area);
+    extractObstaclePointsWithinPolygon(grid_hash_vector_map_points, detection_area);
 
   // concatenate two filtered pointclouds
   const auto concat_points = concatPointCloud(
@@ -511,11 +594,12 @@ void DynamicObstacleCreatorForPoints::onSynchronizedPointCloud(
   const auto concat_points_no_overlap = applyVoxelGridFilter(concat_points);
 
   // filter points that have lateral nearest distance
-  const auto lateral_nearest_points =
-    extractLateralNearestPoints(concat_points_no_overlap, path, param_.points_interval);
+  const auto lateral_nearest_points = extractLateralNearestPoints(
+    concat_points_no_overlap, path, param_.points_interval, param_.num_threads);
 
   // publish filtered pointcloud for debug
-  debug_ptr_->publishFilteredPointCloud(lateral_nearest_points, concat_points.header);
+  debug_ptr_->publishFilteredPointCloud(
+    lateral_nearest_points, pcl_conversions::fromPCL(concat_points.header));
 
   std::lock_guard<std::mutex> lock(mutex_);
   obstacle_points_map_filtered_ = lateral_nearest_points;
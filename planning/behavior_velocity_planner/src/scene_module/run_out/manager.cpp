@@ -14,6 +14,8 @@
 
 #include "scene_module/run_out/manager.hpp"
 
+#include <algorithm>
+
 namespace behavior_velocity_planner
 {
 namespace
@@ -88,6 +90,7 @@ RunOutModuleManager::RunOutModuleManager(rclcpp::Node & node)
     p.max_prediction_time = node.declare_parameter(ns_do + ".max_prediction_time", 10.0);
     p.time_step = node.declare_parameter(ns_do + ".time_step", 0.5);
     p.points_interval = node.declare_parameter(ns_do + ".points_interval", 0.1);
+    p.num_threads = std::max(node.declare_parameter(ns_do + ".num_threads", 1), 1);
   }
 
   {
@@ -18,9 +18,57 @@
 #include "utilization/trajectory_utils.hpp"
 #include "utilization/util.hpp"
 
+#include <boost/geometry/index/rtree.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <utility>
+#include <vector>
+
 namespace behavior_velocity_planner
 {
 namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+
+namespace
+{
+// bounding box of all the poses the obstacle can take along its predicted path within its shape.
+// the ranged shape at any travel time is within the shape size of the path points.
+boost::optional<tier4_autoware_utils::Box2d> calcObstacleSweptBox(const DynamicObstacle & obstacle)
+{
+  double margin = 0.0;
+  switch (obstacle.shape.type) {
+    case Shape::CYLINDER:
+      margin = std::hypot(obstacle.shape.dimensions.x / 2.0, obstacle.shape.dimensions.x / 2.0);
+      break;
+    case Shape::BOUNDING_BOX:
+      margin = std::hypot(obstacle.shape.dimensions.x / 2.0, obstacle.shape.dimensions.y / 2.0);
+      break;
+    default:
+      // the collision with other shapes is not checked
+      return {};
+  }
+  // absorb the rounding errors of the pose calculation
+  constexpr double epsilon = 1e-3;
+  margin += epsilon;
+
+  const auto predicted_path = run_out_utils::getHighestConfidencePath(obstacle.predicted_paths);
+  if (predicted_path.empty()) {
+    return {};
+  }
+  tier4_autoware_utils::Box2d box;
+  bg::assign_inverse(box);
+  for (const auto & pose : predicted_path) {
+    bg::expand(box, tier4_autoware_utils::Point2d(pose.position.x, pose.position.y));
+  }
+  box.min_corner().x() -= margin;
+  box.min_corner().y() -= margin;
+  box.max_corner().x() += margin;
+  box.max_corner().y() += margin;
+  return box;
+}
+}  // namespace
 
 RunOutModule::RunOutModule(
   const int64_t module_id, const std::shared_ptr<const PlannerData> & planner_data,
@@ -134,8 +182,15 @@ boost::optional<DynamicObstacle> RunOutModule::detectCollision(
     return {};
   }
 
-  // detect collision with obstacles from the nearest path point to the end
+  // sample the vehicle footprints from the nearest path point to the end in time order
   // ignore the travel time from current pose to nearest path point?
+  struct VehicleFootprint
+  {
+    geometry_msgs::msg::Pose pose;
+    float travel_time;
+    std::vector<geometry_msgs::msg::Point> polygon;
+  };
+  std::vector<VehicleFootprint> footprints;
   float travel_time = 0.0;
   float dist_sum = 0.0;
   for (size_t idx = 1; idx < path.points.size(); idx++) {
@@ -155,18 +210,70 @@ boost::optional<DynamicObstacle> RunOutModule::detectCollision(
     }
     dist_sum = 0.0;
 
-    const auto vehicle_poly = createVehiclePolygon(p2.pose);
+    footprints.push_back({p2.pose, travel_time, createVehiclePolygon(p2.pose)});
+  }
 
-    debug_ptr_->pushPredictedVehiclePolygons(vehicle_poly);
-    debug_ptr_->pushTravelTimeTexts(travel_time, p2.pose, /* lateral_offset */ 3.0);
+  // index the bounding boxes of the footprints to cull the obstacles that can reach none of them
+  std::vector<std::pair<tier4_autoware_utils::Box2d, size_t>> footprint_boxes;
+  footprint_boxes.reserve(footprints.size());
+  for (size_t i = 0; i < footprints.size(); ++i) {
+    footprint_boxes.emplace_back(
+      bg::return_envelope<tier4_autoware_utils::Box2d>(
+        run_out_utils::createBoostPolyFromMsg(footprints.at(i).polygon)),
+      i);
+  }
+  const bgi::rtree<std::pair<tier4_autoware_utils::Box2d, size_t>, bgi::rstar<16>>
+    footprint_rtree(footprint_boxes);
+
+  std::vector<std::vector<size_t>> candidate_obstacle_indices(footprints.size());
+  for (size_t i = 0; i < dynamic_obstacles.size(); ++i) {
+    // detect only pedestrian and bicycle
+    const auto classification =
+      run_out_utils::getHighestProbLabel(dynamic_obstacles.at(i).classifications);
+    if (
+      classification != ObjectClassification::PEDESTRIAN &&
+      classification != ObjectClassification::BICYCLE) {
+      continue;
+    }
+
+    const auto swept_box = calcObstacleSweptBox(dynamic_obstacles.at(i));
+    if (!swept_box) {
+      continue;
+    }
+    std::vector<std::pair<tier4_autoware_utils::Box2d, size_t>> hits;
+    footprint_rtree.query(bgi::intersects(*swept_box), std::back_inserter(hits));
+    for (const auto & hit : hits) {
+      candidate_obstacle_indices.at(hit.second).push_back(i);
+    }
+  }
+
+  for (size_t i = 0; i < footprints.size(); ++i) {
+    const auto & footprint = footprints.at(i);
+
+    debug_ptr_->pushPredictedVehiclePolygons(footprint.polygon);
+    debug_ptr_->pushTravelTimeTexts(
+      footprint.travel_time, footprint.pose, /* lateral_offset */ 3.0);
+
+    auto & obstacle_indices = candidate_obstacle_indices.at(i);
+    if (obstacle_indices.empty()) {
+      continue;
+    }
+    // keep the order of the input obstacles
+    std::sort(obstacle_indices.begin(), obstacle_indices.end());
+    std::vector<DynamicObstacle> candidate_obstacles;
+    candidate_obstacles.reserve(obstacle_indices.size());
+    for (const auto idx : obstacle_indices) {
+      candidate_obstacles.push_back(dynamic_obstacles.at(idx));
+    }
 
     auto obstacles_collision =
-      checkCollisionWithObstacles(dynamic_obstacles, vehicle_poly, travel_time);
+      checkCollisionWithObstacles(candidate_obstacles, footprint.polygon, footprint.travel_time);
     if (obstacles_collision.empty()) {
       continue;
     }
 
-    const auto obstacle_selected = findNearestCollisionObstacle(path, p2.pose, obstacles_collision);
+    const auto obstacle_selected =
+      findNearestCollisionObstacle(path, footprint.pose, obstacles_collision);
     if (!obstacle_selected) {
       continue;
     }
@@ -0,0 +1,114 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <tier4_autoware_utils/tier4_autoware_utils.hpp>
+#include <utilization/path_merge.hpp>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace behavior_velocity_planner
+{
+namespace
+{
+using autoware_auto_planning_msgs::msg::PathPointWithLaneId;
+using autoware_auto_planning_msgs::msg::PathWithLaneId;
+
+bool isSamePosition(const PathPointWithLaneId & a, const PathPointWithLaneId & b)
+{
+  const auto & p_a = a.point.pose.position;
+  const auto & p_b = b.point.pose.position;
+  return p_a.x == p_b.x && p_a.y == p_b.y && p_a.z == p_b.z;
+}
+
+// the velocity of a path point holds until the next point
+float getVelocityAt(const PlannedPath & planned_path, const double arc_length)
+{
+  const auto & arc_lengths = planned_path.arc_lengths;
+  const auto it =
+    std::upper_bound(arc_lengths.begin(), arc_lengths.end(), arc_length + merge_epsilon);
+  const size_t idx = it == arc_lengths.begin() ? 0 : std::distance(arc_lengths.begin(), it) - 1;
+  return planned_path.path.points.at(idx).point.longitudinal_velocity_mps;
+}
+}  // namespace
+
+std::vector<double> calcArcLengths(const PathWithLaneId & path)
+{
+  std::vector<double> arc_lengths(path.points.size(), 0.0);
+  for (size_t i = 1; i < path.points.size(); ++i) {
+    arc_lengths.at(i) = arc_lengths.at(i - 1) + tier4_autoware_utils::calcDistance2d(
+                                                  path.points.at(i - 1), path.points.at(i));
+  }
+  return arc_lengths;
+}
+
+PathWithLaneId mergePlannedPaths(
+  const PathWithLaneId & input_path, const std::vector<PlannedPath> & planned_paths,
+  std::vector<double> * merged_arc_lengths)
+{
+  std::vector<std::pair<double, PathPointWithLaneId>> points;
+  const auto input_arc_lengths = calcArcLengths(input_path);
+  for (size_t i = 0; i < input_path.points.size(); ++i) {
+    points.emplace_back(input_arc_lengths.at(i), input_path.points.at(i));
+  }
+  for (const auto & planned_path : planned_paths) {
+    size_t input_idx = 0;
+    for (size_t i = 0; i < planned_path.path.points.size(); ++i) {
+      const auto & point = planned_path.path.points.at(i);
+      if (
+        input_idx < input_path.points.size() &&
+        isSamePosition(point, input_path.points.at(input_idx))) {
+        ++input_idx;
+        continue;
+      }
+      points.emplace_back(planned_path.arc_lengths.at(i), point);
+    }
+  }
+  // stable to prefer the input points, then the points of the managers launched first
+  std::stable_sort(points.begin(), points.end(), [](const auto & a, const auto & b) {
+    return a.first < b.first;
+  });
+
+  PathWithLaneId merged_path = input_path;
+  merged_path.points.clear();
+  merged_arc_lengths->clear();
+  for (const auto & [arc_length, point] : points) {
+    if (!merged_arc_lengths->empty() && arc_length - merged_arc_lengths->back() < merge_epsilon) {
+      continue;
+    }
+    merged_path.points.push_back(point);
+    merged_arc_lengths->push_back(arc_length);
+  }
+
+  for (size_t i = 0; i < merged_path.points.size(); ++i) {
+    auto & velocity = merged_path.points.at(i).point.longitudinal_velocity_mps;
+    for (const auto & planned_path : planned_paths) {
+      if (planned_path.path.points.empty()) {
+        continue;
+      }
+      velocity = std::min(velocity, getVelocityAt(planned_path, merged_arc_lengths->at(i)));
+    }
+  }
+  return merged_path;
+}
+
+int findMergedIndex(const std::vector<double> & merged_arc_lengths, const double arc_length)
+{
+  const auto it = std::lower_bound(
+    merged_arc_lengths.begin(), merged_arc_lengths.end(), arc_length - merge_epsilon);
+  const auto idx = static_cast<int>(std::distance(merged_arc_lengths.begin(), it));
+  return std::min(idx, static_cast<int>(merged_arc_lengths.size()) - 1);
+}
+}  // namespace behavior_velocity_planner
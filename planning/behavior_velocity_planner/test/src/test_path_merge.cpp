@@ -0,0 +1,125 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "utilization/path_merge.hpp"
+#include "utils.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <vector>
+
+using autoware_auto_planning_msgs::msg::PathPointWithLaneId;
+using autoware_auto_planning_msgs::msg::PathWithLaneId;
+using behavior_velocity_planner::PlannedPath;
+
+namespace
+{
+PlannedPath createPlannedPath(const PathWithLaneId & path)
+{
+  PlannedPath planned_path;
+  planned_path.path = path;
+  planned_path.arc_lengths = behavior_velocity_planner::calcArcLengths(path);
+  return planned_path;
+}
+
+// insert a point at x between the points of the straight path along the x axis
+PathWithLaneId insertPoint(const PathWithLaneId & path, const double x, const int64_t lane_id)
+{
+  PathWithLaneId inserted_path = path;
+  auto it = inserted_path.points.begin();
+  while (it != inserted_path.points.end() && it->point.pose.position.x < x) {
+    ++it;
+  }
+  PathPointWithLaneId point = *std::prev(it);
+  point.point.pose.position.x = x;
+  point.lane_ids = {lane_id};
+  inserted_path.points.insert(it, point);
+  return inserted_path;
+}
+
+void setVelocityFrom(PathWithLaneId & path, const double x, const float velocity)
+{
+  for (auto & point : path.points) {
+    if (point.point.pose.position.x >= x) {
+      point.point.longitudinal_velocity_mps = velocity;
+    }
+  }
+}
+}  // namespace
+
+TEST(mergePlannedPaths, noPlannedPath)
+{
+  auto input_path = test::generatePath(0.0, 0.0, 4.0, 0.0, 5);
+  test::addConstantVelocity(input_path, 10.0);
+
+  std::vector<double> merged_arc_lengths;
+  const auto merged_path =
+    behavior_velocity_planner::mergePlannedPaths(input_path, {}, &merged_arc_lengths);
+  ASSERT_EQ(merged_path.points.size(), input_path.points.size());
+  ASSERT_EQ(merged_arc_lengths.size(), input_path.points.size());
+  for (size_t i = 0; i < merged_path.points.size(); ++i) {
+    EXPECT_DOUBLE_EQ(merged_path.points.at(i).point.pose.position.x, static_cast<double>(i));
+    EXPECT_FLOAT_EQ(merged_path.points.at(i).point.longitudinal_velocity_mps, 10.0F);
+    EXPECT_DOUBLE_EQ(merged_arc_lengths.at(i), static_cast<double>(i));
+  }
+}
+
+TEST(mergePlannedPaths, insertedPointsAndMinimumVelocity)
+{
+  auto input_path = test::generatePath(0.0, 0.0, 4.0, 0.0, 5);
+  test::addConstantVelocity(input_path, 10.0);
+
+  // the first manager inserts a stop point at 2.5
+  auto stop_path = insertPoint(input_path, 2.5, 1);
+  setVelocityFrom(stop_path, 2.5, 0.0);
+  // the second manager slows down from 1.0 without inserting any point
+  auto slow_down_path = input_path;
+  setVelocityFrom(slow_down_path, 1.0, 3.0);
+  // the third manager inserts a point at the same position as the stop point
+  auto same_point_path = insertPoint(input_path, 2.5 + 1e-4, 3);
+  setVelocityFrom(same_point_path, 3.5, 5.0);
+
+  const std::vector<PlannedPath> planned_paths{
+    createPlannedPath(stop_path), createPlannedPath(slow_down_path),
+    createPlannedPath(same_point_path)};
+  std::vector<double> merged_arc_lengths;
+  const auto merged_path =
+    behavior_velocity_planner::mergePlannedPaths(input_path, planned_paths, &merged_arc_lengths);
+
+  const std::vector<double> expected_xs{0.0, 1.0, 2.0, 2.5, 3.0, 4.0};
+  const std::vector<float> expected_velocities{10.0F, 3.0F, 3.0F, 0.0F, 0.0F, 0.0F};
+  ASSERT_EQ(merged_path.points.size(), expected_xs.size());
+  ASSERT_EQ(merged_arc_lengths.size(), expected_xs.size());
+  for (size_t i = 0; i < expected_xs.size(); ++i) {
+    const auto & point = merged_path.points.at(i).point;
+    EXPECT_DOUBLE_EQ(point.pose.position.x, expected_xs.at(i));
+    EXPECT_DOUBLE_EQ(merged_arc_lengths.at(i), expected_xs.at(i));
+    EXPECT_FLOAT_EQ(point.longitudinal_velocity_mps, expected_velocities.at(i)) << "i: " << i;
+  }
+  // the point of the manager launched first is kept
+  ASSERT_EQ(merged_path.points.at(3).lane_ids.size(), 1U);
+  EXPECT_EQ(merged_path.points.at(3).lane_ids.front(), 1);
+}
+
+TEST(mergePlannedPaths, findMergedIndex)
+{
+  using behavior_velocity_planner::findMergedIndex;
+  const std::vector<double> merged_arc_lengths{0.0, 1.0, 2.0, 2.5, 3.0, 4.0};
+  EXPECT_EQ(findMergedIndex(merged_arc_lengths, 0.0), 0);
+  EXPECT_EQ(findMergedIndex(merged_arc_lengths, 2.5), 3);
+  EXPECT_EQ(findMergedIndex(merged_arc_lengths, 2.5 - 1e-4), 3);
+  EXPECT_EQ(findMergedIndex(merged_arc_lengths, 2.7), 4);
+  EXPECT_EQ(findMergedIndex(merged_arc_lengths, 10.0), 5);
+}
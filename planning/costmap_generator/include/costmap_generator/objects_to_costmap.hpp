@@ -56,6 +56,8 @@
 #include <autoware_auto_perception_msgs/msg/predicted_objects.hpp>
 
 #include <string>
+#include <utility>
+#include <vector>
 
 class ObjectsToCostmap
 {
@@ -73,11 +75,16 @@ public:
     const double size_of_expansion_kernel,
     const autoware_auto_perception_msgs::msg::PredictedObjects::ConstSharedPtr in_objects);
 
+  /// \brief set the number of threads used to rasterize the objects
+  /// \param[in] num_threads: number of threads, each one rasterizing into its own layer
+  void setNumThreads(const int num_threads);
+
 private:
   const int NUMBER_OF_POINTS;
   const int NUMBER_OF_DIMENSIONS;
   const std::string OBJECTS_COSTMAP_LAYER_;
   const std::string BLURRED_OBJECTS_COSTMAP_LAYER_;
+  int num_threads_{1};
 
   /// \brief make 4 rectangle points from centroid position and orientation
   /// \param[in] in_object: subscribed one of PredictedObjects
@@ -116,12 +123,12 @@ private:
 
   /// \brief set cost in polygon by using DynamicObject's score
   /// \param[in] polygon: 4 rectangle points in polygon format
-  /// \param[in] gridmap_layer_name: target gridmap layer name for calculated cost
   /// \param[in] score: set score as a cost for costmap
-  /// \param[in] objects_costmap: update cost in this objects_costmap[gridmap_layer_name]
+  /// \param[in] objects_costmap: gridmap defining the geometry of the layer
+  /// \param[in] layer: update cost in this layer, only visiting the cells of the polygon
   void setCostInPolygon(
-    const grid_map::Polygon & polygon, const std::string & gridmap_layer_name, const float score,
-    grid_map::GridMap & objects_costmap);
+    const grid_map::Polygon & polygon, const float score, const grid_map::GridMap & objects_costmap,
+    grid_map::Matrix & layer);
 };
 
 #endif  // COSTMAP_GENERATOR__OBJECTS_TO_COSTMAP_HPP_
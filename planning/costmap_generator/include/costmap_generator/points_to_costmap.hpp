@@ -70,6 +70,10 @@ public:
     const std::string & gridmap_layer_name,
     const pcl::PointCloud<pcl::PointXYZ> & in_sensor_points);
 
+  /// \brief set the number of threads used to fill the costmap
+  /// \param[in] num_threads: number of threads, each one filling a band of grid rows
+  void setNumThreads(const int num_threads);
+
 private:
   double grid_length_x_;
   double grid_length_y_;
@@ -78,6 +82,11 @@ private:
   double grid_position_y_;
   double y_cell_size_;
   double x_cell_size_;
+  int num_threads_{1};
+
+  // per-cell statistics in row-major order (x index major), reused across calls
+  std::vector<int> cell_point_counts_;
+  std::vector<int> cell_valid_point_counts_;  // points within the height thresholds
 
   /// \brief initialize gridmap parameters
   /// \param[in] gridmap: gridmap object to be initialized
@@ -94,26 +103,23 @@ private:
   grid_map::Index fetchGridIndexFromPoint(const pcl::PointXYZ & point);
 
   /// \brief Assign pointcloud to appropriate cell in gridmap
+  /// \param[in] maximum_height_thres: Maximum height threshold for pointcloud data
+  /// \param[in] minimum_height_thres: Minimum height threshold for pointcloud data
   /// \param[in] in_sensor_points: subscribed pointcloud
-  /// \param[out] grid-x-length x grid-y-length size grid stuffed with point's height in
-  /// corresponding grid cell
-  std::vector<std::vector<std::vector<double>>> assignPoints2GridCell(
+  /// \details count the points and the points within the height thresholds of each grid cell
+  void assignPoints2GridCell(
+    const double maximum_height_thres, const double minimum_height_thres,
     const pcl::PointCloud<pcl::PointXYZ> & in_sensor_points);
 
-  /// \brief calculate costmap from subscribed pointcloud
-  /// \param[in] maximum_height_thres: Maximum height threshold for pointcloud data
-  /// \param[in] minimum_height_thres: Minimum height threshold for pointcloud data
+  /// \brief calculate costmap from the per-cell statistics of the subscribed pointcloud
   /// \param[in] grid_min_value: Minimum cost for costmap
   /// \param[in] grid_max_value: Maximum cost fot costmap
   /// \param[in] gridmap: costmap based on gridmap
   /// \param[in] gridmap_layer_name: gridmap layer name for gridmap
-  /// \param[in] grid_vec: grid-x-length x grid-y-length size grid stuffed with point's height in
-  /// corresponding grid cell \param[out] calculated costmap in grid_map::Matrix format
+  /// \param[out] calculated costmap in grid_map::Matrix format
   grid_map::Matrix calculateCostmap(
-    const double maximum_height_thres, const double minimum_lidar_height_thres,
     const double grid_min_value, const double grid_max_value, const grid_map::GridMap & gridmap,
-    const std::string & gridmap_layer_name,
-    const std::vector<std::vector<std::vector<double>>> grid_vec);
+    const std::string & gridmap_layer_name);
 };
 
 #endif  // COSTMAP_GENERATOR__POINTS_TO_COSTMAP_HPP_
@@ -181,6 +181,10 @@ CostmapGenerator::CostmapGenerator(const rclcpp::NodeOptions & node_options)
   use_parkinglot_ = this->declare_parameter<bool>("use_parkinglot", true);
   expand_polygon_size_ = this->declare_parameter<double>("expand_polygon_size", 1.0);
   size_of_expansion_kernel_ = this->declare_parameter<int>("size_of_expansion_kernel", 9);
+  points2costmap_.setNumThreads(
+    static_cast<int>(this->declare_parameter<int>("points_to_costmap_num_threads", 1)));
+  objects2costmap_.setNumThreads(
+    static_cast<int>(this->declare_parameter<int>("objects_to_costmap_num_threads", 1)));
 
   // Wait for first tf
   // We want to do this before creating subscriptions
@@ -440,20 +444,11 @@ grid_map::Matrix CostmapGenerator::generatePrimitivesCostmap()
 grid_map::Matrix CostmapGenerator::generateCombinedCostmap()
 {
   // assuming combined_costmap is calculated by element wise max operation
-  grid_map::GridMap combined_costmap = costmap_;
-
-  combined_costmap[LayerName::combined].setConstant(grid_min_value_);
-
-  combined_costmap[LayerName::combined] =
-    combined_costmap[LayerName::combined].cwiseMax(combined_costmap[LayerName::points]);
-
-  combined_costmap[LayerName::combined] =
-    combined_costmap[LayerName::combined].cwiseMax(combined_costmap[LayerName::primitives]);
-
-  combined_costmap[LayerName::combined] =
-    combined_costmap[LayerName::combined].cwiseMax(combined_costmap[LayerName::objects]);
-
-  return combined_costmap[LayerName::combined];
+  // NOTE: evaluated as a single expression to visit each cell once without copying the gridmap
+  return costmap_[LayerName::points]
+    .cwiseMax(costmap_[LayerName::primitives])
+    .cwiseMax(costmap_[LayerName::objects])
+    .cwiseMax(static_cast<float>(grid_min_value_));
 }
 
 void CostmapGenerator::publishCostmap(const grid_map::GridMap & costmap)
@@ -44,10 +44,15 @@
 
 #include "costmap_generator/objects_to_costmap.hpp"
 
+#include <grid_map_utils/polygon_iterator.hpp>
+
 #include <tf2/utils.h>
 
+#include <algorithm>
 #include <cmath>
 #include <string>
+#include <utility>
+#include <vector>
 
 // Constructor
 ObjectsToCostmap::ObjectsToCostmap()
@@ -143,13 +148,14 @@ grid_map::Polygon ObjectsToCostmap::makePolygonFromObjectConvexHull(
 }
 
 void ObjectsToCostmap::setCostInPolygon(
-  const grid_map::Polygon & polygon, const std::string & gridmap_layer_name, const float score,
-  grid_map::GridMap & objects_costmap)
+  const grid_map::Polygon & polygon, const float score, const grid_map::GridMap & objects_costmap,
+  grid_map::Matrix & layer)
 {
-  for (grid_map::PolygonIterator itr(objects_costmap, polygon); !itr.isPastEnd(); ++itr) {
-    const float current_score = objects_costmap.at(gridmap_layer_name, *itr);
+  // scanline iteration over the rows of the polygon's bounding box
+  for (grid_map_utils::PolygonIterator itr(objects_costmap, polygon); !itr.isPastEnd(); ++itr) {
+    float & current_score = layer((*itr)(0), (*itr)(1));
     if (score > current_score) {
-      objects_costmap.at(gridmap_layer_name, *itr) = score;
+      current_score = score;
     }
   }
 }
@@ -159,10 +165,15 @@ grid_map::Matrix ObjectsToCostmap::makeCostmapFromObjects(
   const double size_of_expansion_kernel,
   const autoware_auto_perception_msgs::msg::PredictedObjects::ConstSharedPtr in_objects)
 {
-  grid_map::GridMap objects_costmap = costmap;
+  // only the geometry of the input costmap is needed, not its layers
+  grid_map::GridMap objects_costmap;
+  objects_costmap.setFrameId(costmap.getFrameId());
+  objects_costmap.setGeometry(costmap.getLength(), costmap.getResolution(), costmap.getPosition());
+  objects_costmap.setStartIndex(costmap.getStartIndex());
   objects_costmap.add(OBJECTS_COSTMAP_LAYER_, 0);
-  objects_costmap.add(BLURRED_OBJECTS_COSTMAP_LAYER_, 0);
 
+  std::vector<std::pair<grid_map::Polygon, float>> polygons_with_score;
+  polygons_with_score.reserve(in_objects->objects.size());
   for (const auto & object : in_objects->objects) {
     grid_map::Polygon polygon;
     if (object.shape.type == autoware_auto_perception_msgs::msg::Shape::POLYGON) {
@@ -176,12 +187,33 @@ grid_map::Matrix ObjectsToCostmap::makeCostmapFromObjects(
     const auto highest_probability_label = *std::max_element(
       object.classification.begin(), object.classification.end(),
       [](const auto & c1, const auto & c2) { return c1.probability < c2.probability; });
-    const double highest_probability = static_cast<double>(highest_probability_label.probability);
-    setCostInPolygon(polygon, OBJECTS_COSTMAP_LAYER_, highest_probability, objects_costmap);
-    setCostInPolygon(polygon, BLURRED_OBJECTS_COSTMAP_LAYER_, highest_probability, objects_costmap);
+    polygons_with_score.emplace_back(polygon, highest_probability_label.probability);
+  }
+
+  auto & objects_layer = objects_costmap[OBJECTS_COSTMAP_LAYER_];
+  const int num_polygons = static_cast<int>(polygons_with_score.size());
+  if (num_threads_ <= 1) {
+    for (const auto & [polygon, score] : polygons_with_score) {
+      setCostInPolygon(polygon, score, objects_costmap, objects_layer);
+    }
+  } else {
+    // each thread rasterizes its objects into its own layer, then the layers are max-reduced
+#pragma omp parallel num_threads(num_threads_)
+    {
+      grid_map::Matrix thread_layer =
+        grid_map::Matrix::Zero(objects_layer.rows(), objects_layer.cols());
+#pragma omp for schedule(dynamic) nowait
+      for (int i = 0; i < num_polygons; ++i) {
+        const auto & [polygon, score] = polygons_with_score[i];
+        setCostInPolygon(polygon, score, objects_costmap, thread_layer);
+      }
+#pragma omp critical
+      objects_layer = objects_layer.cwiseMax(thread_layer);
+    }
   }
 
   // Applying mean filter to expanded gridmap
+  objects_costmap.add(BLURRED_OBJECTS_COSTMAP_LAYER_, objects_costmap[OBJECTS_COSTMAP_LAYER_]);
   const grid_map::SlidingWindowIterator::EdgeHandling edge_handling =
     grid_map::SlidingWindowIterator::EdgeHandling::CROP;
   for (grid_map::SlidingWindowIterator iterator(
@@ -196,3 +228,8 @@ grid_map::Matrix ObjectsToCostmap::makeCostmapFromObjects(
 
   return objects_costmap[OBJECTS_COSTMAP_LAYER_];
 }
+
+void ObjectsToCostmap::setNumThreads(const int num_threads)
+{
+  num_threads_ = std::max(num_threads, 1);
+}
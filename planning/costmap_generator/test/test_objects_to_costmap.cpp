@@ -134,3 +134,42 @@ TEST_F(ObjectsToCostMapTest, TestMakeCostmapFromObjects)
     }
   }
 }
+
+TEST_F(ObjectsToCostMapTest, TestMakeCostmapFromObjects_multiThreads)
+{
+  auto objs = std::make_shared<autoware_auto_perception_msgs::msg::PredictedObjects>();
+  for (int i = 0; i < 8; ++i) {
+    autoware_auto_perception_msgs::msg::PredictedObject object;
+    object.classification.push_back(autoware_auto_perception_msgs::msg::ObjectClassification{});
+    object.classification.at(0).label = LABEL::CAR;
+    object.classification.at(0).probability = 0.1 * (i + 1);
+    // overlapping objects with different scores
+    object.kinematics.initial_pose_with_covariance.pose.position.x = -6.2 + 1.7 * i;
+    object.kinematics.initial_pose_with_covariance.pose.position.y = 0.3 * i;
+    object.kinematics.initial_pose_with_covariance.pose.orientation.w = 1;
+    object.shape.type = autoware_auto_perception_msgs::msg::Shape::BOUNDING_BOX;
+    object.shape.dimensions.x = 4.1;
+    object.shape.dimensions.y = 2.1;
+    objs->objects.push_back(object);
+  }
+
+  grid_map::GridMap gridmap = construct_gridmap();
+  const double expand_polygon_size = 0.0;
+  const double size_of_expansion_kernel = 1;
+
+  ObjectsToCostmap single_thread_objects_to_costmap;
+  const grid_map::Matrix single_thread_costmap =
+    single_thread_objects_to_costmap.makeCostmapFromObjects(
+      gridmap, expand_polygon_size, size_of_expansion_kernel, objs);
+
+  ObjectsToCostmap multi_thread_objects_to_costmap;
+  multi_thread_objects_to_costmap.setNumThreads(3);
+  const grid_map::Matrix multi_thread_costmap =
+    multi_thread_objects_to_costmap.makeCostmapFromObjects(
+      gridmap, expand_polygon_size, size_of_expansion_kernel, objs);
+
+  ASSERT_EQ(single_thread_costmap.rows(), multi_thread_costmap.rows());
+  ASSERT_EQ(single_thread_costmap.cols(), multi_thread_costmap.cols());
+  EXPECT_TRUE(single_thread_costmap.isApprox(multi_thread_costmap));
+  EXPECT_FLOAT_EQ(single_thread_costmap.maxCoeff(), 0.8f);
+}
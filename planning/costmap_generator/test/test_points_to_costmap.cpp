@@ -216,3 +216,54 @@ TEST_F(PointsToCostmapTest, TestMakeCostmapFromPoints_invalidPoints_outOfGrid)
 
   EXPECT_EQ(nonempty_grid_cell_num, 0);
 }
+
+TEST_F(PointsToCostmapTest, TestMakeCostmapFromPoints_reuseAcrossCalls)
+{
+  pointcloud in_sensor_points;
+  in_sensor_points.width = 2;
+  in_sensor_points.height = 1;
+  in_sensor_points.is_dense = false;
+  in_sensor_points.resize(in_sensor_points.width * in_sensor_points.height);
+
+  // one point above the maximum height and one valid point in the same cell
+  in_sensor_points.points[0].x = 1.1;
+  in_sensor_points.points[0].y = 1.1;
+  in_sensor_points.points[0].z = 8;
+
+  in_sensor_points.points[1].x = 1.2;
+  in_sensor_points.points[1].y = 1.2;
+  in_sensor_points.points[1].z = 2;
+
+  grid_map::GridMap gridmap = construct_gridmap();
+
+  PointsToCostmap point2costmap;
+  point2costmap.setNumThreads(2);
+  const double maximum_height_thres = 5.0;
+  const double minimum_lidar_height_thres = 0.0;
+  const double grid_min_value = 0.0;
+  const double grid_max_value = 1.0;
+  const std::string gridmap_layer_name = "points";
+  const auto count_max_cells = [&](const grid_map::Matrix & costmap_data) {
+    int nonempty_grid_cell_num = 0;
+    for (int i = 0; i < costmap_data.rows(); i++) {
+      for (int j = 0; j < costmap_data.cols(); j++) {
+        if (costmap_data(i, j) == grid_max_value) {
+          nonempty_grid_cell_num += 1;
+        }
+      }
+    }
+    return nonempty_grid_cell_num;
+  };
+
+  grid_map::Matrix costmap_data = point2costmap.makeCostmapFromPoints(
+    maximum_height_thres, minimum_lidar_height_thres, grid_min_value, grid_max_value, gridmap,
+    gridmap_layer_name, in_sensor_points);
+  EXPECT_EQ(count_max_cells(costmap_data), 1);
+
+  // the cell statistics of the previous call must not remain
+  in_sensor_points.points[1].z = 6;
+  costmap_data = point2costmap.makeCostmapFromPoints(
+    maximum_height_thres, minimum_lidar_height_thres, grid_min_value, grid_max_value, gridmap,
+    gridmap_layer_name, in_sensor_points);
+  EXPECT_EQ(count_max_cells(costmap_data), 0);
+}
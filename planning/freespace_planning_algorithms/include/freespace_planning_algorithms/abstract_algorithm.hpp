@@ -42,6 +42,14 @@ struct IndexXY
   int y;
 };
 
+// contiguous grids from x_min to x_max (inclusive) on the row y
+struct IndexRowXY
+{
+  int y;
+  int x_min;
+  int x_max;
+};
+
 IndexXYT pose2index(
   const nav_msgs::msg::OccupancyGrid & costmap, const geometry_msgs::msg::Pose & pose_local,
   const int theta_size);
@@ -141,7 +149,9 @@ protected:
   void computeCollisionIndexes(
     int theta_index, std::vector<IndexXY> & indexes,
     std::vector<IndexXY> & vertex_indexes_2d) const;
+  void computeObstacleGridDistance();
   bool detectCollision(const IndexXYT & base_index) const;
+  bool hasObstacleInRow(const int y, const int x_min, const int x_max) const;
   inline bool isOutOfRange(const IndexXYT & index) const
   {
     if (index.x < 0 || static_cast<int>(costmap_.info.width) <= index.x) {
@@ -157,7 +167,8 @@ protected:
     // NOTE: Accessing by .at() instead makes 1.2 times slower here.
     // Also, boundary check is already done in isOutOfRange before calling this function.
     // So, basically .at() is not necessary.
-    return is_obstacle_table_[index.y][index.x];
+    const size_t word_index = index.y * obstacle_mask_row_words_ + (index.x >> 6);
+    return (obstacle_mask_[word_index] >> (index.x & 63)) & 1ULL;
   }
 
   PlannerCommonParam planner_common_param_;
@@ -169,11 +180,21 @@ protected:
   // collision indexes cache
   std::vector<std::vector<IndexXY>> coll_indexes_table_;
 
+  // collision indexes cache merged into the rows of contiguous grids
+  std::vector<std::vector<IndexRowXY>> coll_rows_table_;
+
+  // Chebyshev radius [grid] of the collision indexes
+  std::vector<int> coll_radius_table_;
+
   // vehicle vertex indexes cache
   std::vector<std::vector<IndexXY>> vertex_indexes_table_;
 
-  // is_obstacle's table
-  std::vector<std::vector<bool>> is_obstacle_table_;
+  // is_obstacle's table packed in bits, whose rows are aligned to 64 bits
+  std::vector<uint64_t> obstacle_mask_;
+  size_t obstacle_mask_row_words_ = 0;
+
+  // Chebyshev distance [grid] from each grid to the nearest obstacle grid
+  std::vector<int> obstacle_grid_distance_;
 
   // pose in costmap frame
   geometry_msgs::msg::Pose start_pose_;
@@ -24,6 +24,7 @@
 #include <std_msgs/msg/header.hpp>
 
 #include <cmath>
+#include <deque>
 #include <functional>
 #include <iostream>
 #include <queue>
@@ -142,13 +143,26 @@ private:
   void setPath(const AstarNode & goal);
   bool setStartNode();
   bool setGoalNode();
-  double estimateCost(const geometry_msgs::msg::Pose & pose) const;
+  double estimateCost(const geometry_msgs::msg::Pose & pose);
+  double calcReedsSheppHeuristic(const geometry_msgs::msg::Pose & pose);
+  double calcObstacleDistanceHeuristic(const geometry_msgs::msg::Pose & pose) const;
+  void updateObstacleDistanceTable(const IndexXYT & goal_index);
   bool isGoal(const AstarNode & node) const;
   geometry_msgs::msg::Pose node2pose(const AstarNode & node) const;
 
   AstarNode * getNodeRef(const IndexXYT & index)
   {
-    return &(graph_.emplace(getKey(index), AstarNode()).first->second);
+    auto & node = graph_[getKey(index)];
+    if (node == nullptr) {
+      // reuse the nodes allocated by the previous plans
+      if (node_pool_size_ == node_pool_.size()) {
+        node_pool_.emplace_back();
+      } else {
+        node_pool_[node_pool_size_] = AstarNode();
+      }
+      node = &node_pool_[node_pool_size_++];
+    }
+    return node;
   }
 
   // Algorithm specific param
@@ -156,7 +170,21 @@ private:
 
   // hybrid astar variables
   TransitionTable transition_table_;
-  std::unordered_map<uint, AstarNode> graph_;
+  std::unordered_map<uint, AstarNode *> graph_;
+
+  // node pool, whose first node_pool_size_ nodes are used in the current plan
+  // NOTE: std::deque does not invalidate the pointers to the nodes when it grows
+  std::deque<AstarNode> node_pool_;
+  size_t node_pool_size_ = 0;
+
+  // 2D distance from each grid to the goal grid avoiding obstacles, computed by Dijkstra
+  std::vector<double> obstacle_distance_table_;
+  IndexXYT obstacle_distance_goal_index_{};
+  bool is_obstacle_distance_table_valid_ = false;
+
+  // Reeds-Shepp distance to the goal, keyed by the discretized pose relative to the goal
+  std::unordered_map<uint64_t, double> reeds_shepp_distance_cache_;
+  double reeds_shepp_cache_resolution_ = 0.0;
 
   std::priority_queue<AstarNode *, std::vector<AstarNode *>, NodeComparison> openlist_;
 
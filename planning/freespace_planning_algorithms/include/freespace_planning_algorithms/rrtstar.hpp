@@ -32,6 +32,7 @@ struct RRTStarParam
   double max_planning_time;  // if enable_update is true, update is done before time elapsed [msec]
   double neighbor_radius;    // neighbor radius [m]
   double margin;             // [m]
+  int num_threads;           // threads to sample and collision-check the extensions [-]
 };
 
 class RRTStar : public AbstractPlanningAlgorithm
@@ -51,7 +52,8 @@ public:
         node.declare_parameter("rrtstar.use_informed_sampling", true),
         node.declare_parameter("rrtstar.max_planning_time", 150.0),
         node.declare_parameter("rrtstar.neighbor_radius", 8.0),
-        node.declare_parameter("rrtstar.margin", 0.1)})
+        node.declare_parameter("rrtstar.margin", 0.1),
+        static_cast<int>(node.declare_parameter("rrtstar.num_threads", 1))})
   {
   }
 
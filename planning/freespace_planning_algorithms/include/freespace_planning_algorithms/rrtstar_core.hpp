@@ -24,11 +24,13 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <functional>
 #include <iostream>
 #include <limits>
 #include <memory>
 #include <random>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace rrtstar_core
@@ -77,6 +79,7 @@ public:
 
   bool isValidPose(const Pose & pose) const { return isInside(pose) && is_obstacle_free_(pose); }
   double getReedsSheppRadius() const { return rsspace_.rho_; }
+  void setRandomSeed(const unsigned int seed) { rand_gen_.seed(seed); }
 
 private:
   bool isInside(const Pose & p) const;
@@ -130,6 +133,10 @@ public:
     CSpace cspace);
   bool isSolutionFound() const { return (reached_nodes_.size() > 0); }
   void extend();
+  // Extend the tree until is_terminated returns true. When num_threads is more than 1,
+  // num_threads - 1 worker threads sample and collision-check the extensions, and this thread
+  // commits them to the tree one by one.
+  void extendInParallel(const size_t num_threads, const std::function<bool()> & is_terminated);
   void deleteNodeUsingBranchAndBound();
   std::vector<Pose> sampleSolutionWaypoints() const;
   void dumpState(std::string filename) const;
@@ -137,6 +144,12 @@ public:
   std::vector<NodeConstSharedPtr> getNodes() const;
 
 private:
+  Pose sampleRandomPose(CSpace & cspace) const;
+  void commitExtension(const Pose & x_new, const NodeConstSharedPtr & node_nearest);
+  uint64_t getGridKey(const int index_x, const int index_y) const;
+  int getGridIndex(const double v) const { return static_cast<int>(std::floor(v / mu_)); }
+  void addNodeToGrid(const NodeSharedPtr & node);
+  void rebuildGrid();
   NodeConstSharedPtr findNearestNode(const Pose & x_rand) const;
   std::vector<NodeConstSharedPtr> findNeighborNodes(const Pose & pose) const;
   NodeSharedPtr addNewNode(const Pose & pose, NodeSharedPtr node_parent);
@@ -153,6 +166,13 @@ private:
   std::vector<NodeSharedPtr> nodes_;
   std::vector<NodeSharedPtr> reached_nodes_;
   // std::vector<Node> nodes_;
+
+  // nodes_ registered to the x-y grid whose cell size is mu_
+  // NOTE: the euclidean distance is a lower bound of the reeds-shepp distance, so the nearest and
+  //       neighbor queries only look at the cells which can be closer than the current bound.
+  std::unordered_map<uint64_t, std::vector<NodeSharedPtr>> node_grid_;
+  std::array<int, 4> grid_bounds_;  // min_x, max_x, min_y, max_y indices of the cells
+
   const double mu_;
   const double collision_check_resolution_;
   const bool is_informed_;
@@ -16,6 +16,8 @@
 
 #include <tier4_autoware_utils/tier4_autoware_utils.hpp>
 
+#include <algorithm>
+#include <limits>
 #include <vector>
 
 namespace freespace_planning_algorithms
@@ -108,26 +110,94 @@ void AbstractPlanningAlgorithm::setMap(const nav_msgs::msg::OccupancyGrid & cost
   const auto width = costmap_.info.width;
 
   // Initialize status
-  std::vector<std::vector<bool>> is_obstacle_table;
-  is_obstacle_table.resize(height);
+  obstacle_mask_row_words_ = (width + 63) / 64;
+  obstacle_mask_.assign(height * obstacle_mask_row_words_, 0);
   for (uint32_t i = 0; i < height; i++) {
-    is_obstacle_table.at(i).resize(width);
     for (uint32_t j = 0; j < width; j++) {
       const int cost = costmap_.data[i * width + j];
 
       if (cost < 0 || planner_common_param_.obstacle_threshold <= cost) {
-        is_obstacle_table[i][j] = true;
+        obstacle_mask_[i * obstacle_mask_row_words_ + (j >> 6)] |= 1ULL << (j & 63);
       }
     }
   }
-  is_obstacle_table_ = is_obstacle_table;
+  computeObstacleGridDistance();
 
   // construct collision indexes table
+  coll_indexes_table_.clear();
+  vertex_indexes_table_.clear();
+  coll_rows_table_.clear();
+  coll_radius_table_.clear();
   for (int i = 0; i < planner_common_param_.theta_size; i++) {
     std::vector<IndexXY> indexes_2d, vertex_indexes_2d;
     computeCollisionIndexes(i, indexes_2d, vertex_indexes_2d);
+
+    // merge the indexes into the rows of contiguous grids
+    auto sorted_indexes_2d = indexes_2d;
+    std::sort(
+      sorted_indexes_2d.begin(), sorted_indexes_2d.end(),
+      [](const IndexXY & left, const IndexXY & right) {
+        return left.y != right.y ? left.y < right.y : left.x < right.x;
+      });
+    std::vector<IndexRowXY> rows;
+    int radius = 0;
+    for (const auto & index_2d : sorted_indexes_2d) {
+      if (!rows.empty() && rows.back().y == index_2d.y && rows.back().x_max + 1 == index_2d.x) {
+        rows.back().x_max = index_2d.x;
+      } else {
+        rows.push_back(IndexRowXY{index_2d.y, index_2d.x, index_2d.x});
+      }
+      radius = std::max({radius, std::abs(index_2d.x), std::abs(index_2d.y)});
+    }
+
     coll_indexes_table_.push_back(indexes_2d);
     vertex_indexes_table_.push_back(vertex_indexes_2d);
+    coll_rows_table_.push_back(rows);
+    coll_radius_table_.push_back(radius);
+  }
+}
+
+void AbstractPlanningAlgorithm::computeObstacleGridDistance()
+{
+  const int height = static_cast<int>(costmap_.info.height);
+  const int width = static_cast<int>(costmap_.info.width);
+  constexpr int max_distance = std::numeric_limits<int>::max() / 2;
+
+  // Chebyshev distance transform by forward and backward raster scans
+  obstacle_grid_distance_.assign(height * width, max_distance);
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      int & distance = obstacle_grid_distance_[y * width + x];
+      if (isObs(IndexXYT{x, y, 0})) {
+        distance = 0;
+        continue;
+      }
+      if (0 < x) {
+        distance = std::min(distance, obstacle_grid_distance_[y * width + x - 1] + 1);
+      }
+      if (0 < y) {
+        for (int dx = -1; dx <= 1; dx++) {
+          if (0 <= x + dx && x + dx < width) {
+            distance = std::min(distance, obstacle_grid_distance_[(y - 1) * width + x + dx] + 1);
+          }
+        }
+      }
+    }
+  }
+  for (int y = height - 1; 0 <= y; y--) {
+    for (int x = width - 1; 0 <= x; x--) {
+      int & distance = obstacle_grid_distance_[y * width + x];
+      if (x < width - 1) {
+        distance = std::min(distance, obstacle_grid_distance_[y * width + x + 1] + 1);
+      }
+      if (y < height - 1) {
+        for (int dx = -1; dx <= 1; dx++) {
+          if (0 <= x + dx && x + dx < width) {
+            distance = std::min(distance, obstacle_grid_distance_[(y + 1) * width + x + dx] + 1);
+          }
+        }
+      }
+    }
   }
 }
 
@@ -215,15 +285,23 @@ bool AbstractPlanningAlgorithm::detectCollision(const IndexXYT & base_index) con
     }
   }
 
-  const auto & coll_indexes_2d = coll_indexes_table_[base_index.theta];
-  for (const auto & coll_index_2d : coll_indexes_2d) {
-    int idx_theta = 0;  // whatever. Yaw is nothing to do with collision detection between grids.
-    IndexXYT coll_index{coll_index_2d.x, coll_index_2d.y, idx_theta};
-    // must slide to current base position
-    coll_index.x += base_index.x;
-    coll_index.y += base_index.y;
+  if (isOutOfRange(base_index)) {
+    return true;
+  }
 
-    if (isObs(coll_index)) {
+  // No obstacle grid can be in the footprint when the nearest one is out of its radius.
+  const int obstacle_grid_distance =
+    obstacle_grid_distance_[base_index.y * costmap_.info.width + base_index.x];
+  if (coll_radius_table_[base_index.theta] < obstacle_grid_distance) {
+    return false;
+  }
+
+  const auto & coll_rows = coll_rows_table_[base_index.theta];
+  for (const auto & coll_row : coll_rows) {
+    // must slide to current base position
+    if (hasObstacleInRow(
+          coll_row.y + base_index.y, coll_row.x_min + base_index.x,
+          coll_row.x_max + base_index.x)) {
       return true;
     }
   }
@@ -231,6 +309,39 @@ bool AbstractPlanningAlgorithm::detectCollision(const IndexXYT & base_index) con
   return false;
 }
 
+bool AbstractPlanningAlgorithm::hasObstacleInRow(
+  const int y, const int x_min, const int x_max) const
+{
+  // NOTE: grids out of the costmap are not regarded as obstacles, which are checked by vertexes
+  const int width = static_cast<int>(costmap_.info.width);
+  if (y < 0 || static_cast<int>(costmap_.info.height) <= y) {
+    return false;
+  }
+  const int clamped_x_min = std::max(x_min, 0);
+  const int clamped_x_max = std::min(x_max, width - 1);
+  if (clamped_x_max < clamped_x_min) {
+    return false;
+  }
+
+  // check 64 grids at once with AND of the row mask and the footprint mask
+  const uint64_t * row_mask = &obstacle_mask_[y * obstacle_mask_row_words_];
+  const int first_word = clamped_x_min >> 6;
+  const int last_word = clamped_x_max >> 6;
+  for (int w = first_word; w <= last_word; w++) {
+    uint64_t footprint_mask = ~0ULL;
+    if (w == first_word) {
+      footprint_mask &= ~0ULL << (clamped_x_min & 63);
+    }
+    if (w == last_word) {
+      footprint_mask &= ~0ULL >> (63 - (clamped_x_max & 63));
+    }
+    if (row_mask[w] & footprint_mask) {
+      return true;
+    }
+  }
+  return false;
+}
+
 bool AbstractPlanningAlgorithm::hasObstacleOnTrajectory(
   const geometry_msgs::msg::PoseArray & trajectory) const
 {
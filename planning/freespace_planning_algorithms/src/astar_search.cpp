@@ -24,10 +24,21 @@
 #include <tf2_geometry_msgs/tf2_geometry_msgs.hpp>
 #endif
 
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <limits>
+#include <utility>
 #include <vector>
 
 namespace freespace_planning_algorithms
 {
+namespace
+{
+// NOTE: the cache is cleared when it grows beyond this size to bound its memory
+constexpr size_t max_reeds_shepp_cache_size = 1000000;
+}  // namespace
+
 double calcReedsSheppDistance(
   const geometry_msgs::msg::Pose & p1, const geometry_msgs::msg::Pose & p2, double radius)
 {
@@ -133,6 +144,15 @@ void AstarSearch::setMap(const nav_msgs::msg::OccupancyGrid & costmap)
 
   x_scale_ = costmap_.info.height;
   graph_.reserve(100000);
+
+  // the obstacle distance to the goal depends on the map
+  is_obstacle_distance_table_valid_ = false;
+
+  // the relative poses are discretized by the map resolution
+  if (reeds_shepp_cache_resolution_ != costmap_.info.resolution) {
+    reeds_shepp_distance_cache_.clear();
+    reeds_shepp_cache_resolution_ = costmap_.info.resolution;
+  }
 }
 
 bool AstarSearch::makePlan(
@@ -141,11 +161,14 @@ bool AstarSearch::makePlan(
   start_pose_ = global2local(costmap_, start_pose);
   goal_pose_ = global2local(costmap_, goal_pose);
 
-  if (!setStartNode()) {
+  // the nodes of the previous plan are not valid for the new start and goal
+  clearNodes();
+
+  if (!setGoalNode()) {
     return false;
   }
 
-  if (!setGoalNode()) {
+  if (!setStartNode()) {
     return false;
   }
 
@@ -158,7 +181,10 @@ void AstarSearch::clearNodes()
   // point to deleted node.
   openlist_ = std::priority_queue<AstarNode *, std::vector<AstarNode *>, NodeComparison>();
 
-  graph_ = std::unordered_map<uint, AstarNode>();
+  // NOTE: the buckets of graph_ and the nodes in node_pool_ are kept for the next plan
+  graph_.clear();
+  node_pool_size_ = 0;
+  goal_node_ = nullptr;
 }
 
 bool AstarSearch::setStartNode()
@@ -194,24 +220,131 @@ bool AstarSearch::setGoalNode()
     return false;
   }
 
+  // the obstacle distance table is reused while the goal grid and the map are the same
+  const bool is_same_goal_index = obstacle_distance_goal_index_.x == index.x &&
+                                  obstacle_distance_goal_index_.y == index.y;
+  if (!is_obstacle_distance_table_valid_ || !is_same_goal_index) {
+    updateObstacleDistanceTable(index);
+  }
+
   return true;
 }
 
-double AstarSearch::estimateCost(const geometry_msgs::msg::Pose & pose) const
+void AstarSearch::updateObstacleDistanceTable(const IndexXYT & goal_index)
+{
+  const int width = static_cast<int>(costmap_.info.width);
+  const int height = static_cast<int>(costmap_.info.height);
+  const double resolution = costmap_.info.resolution;
+
+  obstacle_distance_table_.assign(width * height, std::numeric_limits<double>::infinity());
+  obstacle_distance_goal_index_ = goal_index;
+  is_obstacle_distance_table_valid_ = true;
+  if (isOutOfRange(goal_index)) {
+    return;
+  }
+
+  // Dijkstra on 8-connected grids from the goal grid
+  using DistanceIndex = std::pair<double, int>;
+  std::priority_queue<DistanceIndex, std::vector<DistanceIndex>, std::greater<DistanceIndex>>
+    queue;
+  const int goal_idx = goal_index.y * width + goal_index.x;
+  obstacle_distance_table_.at(goal_idx) = 0.0;
+  queue.emplace(0.0, goal_idx);
+
+  constexpr std::array<std::array<int, 2>, 8> neighbors{
+    {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}}};
+  while (!queue.empty()) {
+    const auto [distance, idx] = queue.top();
+    queue.pop();
+    if (obstacle_distance_table_[idx] < distance) {
+      continue;
+    }
+
+    const int x = idx % width;
+    const int y = idx / width;
+    for (const auto & neighbor : neighbors) {
+      const IndexXYT next_index{x + neighbor[0], y + neighbor[1], 0};
+      if (isOutOfRange(next_index) || isObs(next_index)) {
+        continue;
+      }
+
+      const bool is_diagonal = neighbor[0] != 0 && neighbor[1] != 0;
+      const double next_distance = distance + (is_diagonal ? M_SQRT2 : 1.0) * resolution;
+      const int next_idx = next_index.y * width + next_index.x;
+      if (next_distance < obstacle_distance_table_[next_idx]) {
+        obstacle_distance_table_[next_idx] = next_distance;
+        queue.emplace(next_distance, next_idx);
+      }
+    }
+  }
+}
+
+double AstarSearch::calcObstacleDistanceHeuristic(const geometry_msgs::msg::Pose & pose) const
+{
+  const auto index = pose2index(costmap_, pose, planner_common_param_.theta_size);
+  if (isOutOfRange(index)) {
+    return 0.0;
+  }
+
+  // NOTE: a grid unreachable on the 8-connected grids may be reached by a transition jumping over
+  //       a thin obstacle, so it is not pruned here
+  const double distance = obstacle_distance_table_[index.y * costmap_.info.width + index.x];
+  return std::isfinite(distance) ? distance : 0.0;
+}
+
+double AstarSearch::calcReedsSheppHeuristic(const geometry_msgs::msg::Pose & pose)
+{
+  // discretize the pose relative to the goal by the map resolution and the theta size
+  const double goal_yaw = tf2::getYaw(goal_pose_.orientation);
+  const double dx = pose.position.x - goal_pose_.position.x;
+  const double dy = pose.position.y - goal_pose_.position.y;
+  const double resolution = costmap_.info.resolution;
+  const int index_x =
+    static_cast<int>(std::round((std::cos(goal_yaw) * dx + std::sin(goal_yaw) * dy) / resolution));
+  const int index_y =
+    static_cast<int>(std::round((-std::sin(goal_yaw) * dx + std::cos(goal_yaw) * dy) / resolution));
+  const int index_theta =
+    discretizeAngle(tf2::getYaw(pose.orientation) - goal_yaw, planner_common_param_.theta_size);
+
+  const auto to_key_bits = [](const int index) {
+    return static_cast<uint64_t>(static_cast<uint32_t>(index)) & 0xFFFFFF;
+  };
+  const uint64_t key =
+    (to_key_bits(index_x) << 40) | (to_key_bits(index_y) << 16) | to_key_bits(index_theta);
+  const auto itr = reeds_shepp_distance_cache_.find(key);
+  if (itr != reeds_shepp_distance_cache_.end()) {
+    return itr->second;
+  }
+
+  const double radius =
+    (planner_common_param_.minimum_turning_radius + planner_common_param_.maximum_turning_radius) *
+    0.5;
+  const auto rs_space = ReedsSheppStateSpace(radius);
+  const double dtheta = 2.0 * M_PI / planner_common_param_.theta_size;
+  const ReedsSheppStateSpace::StateXYT relative_pose{
+    index_x * resolution, index_y * resolution, index_theta * dtheta};
+  const double distance = rs_space.distance(relative_pose, ReedsSheppStateSpace::StateXYT{0, 0, 0});
+
+  if (max_reeds_shepp_cache_size <= reeds_shepp_distance_cache_.size()) {
+    reeds_shepp_distance_cache_.clear();
+  }
+  reeds_shepp_distance_cache_.emplace(key, distance);
+  return distance;
+}
+
+double AstarSearch::estimateCost(const geometry_msgs::msg::Pose & pose)
 {
   double total_cost = 0.0;
   // Temporarily, until reeds_shepp gets stable.
   if (use_reeds_shepp_) {
-    const double radius = (planner_common_param_.minimum_turning_radius +
-                           planner_common_param_.maximum_turning_radius) *
-                          0.5;
-    total_cost +=
-      calcReedsSheppDistance(pose, goal_pose_, radius) * astar_param_.distance_heuristic_weight;
+    total_cost += calcReedsSheppHeuristic(pose);
   } else {
-    total_cost += tier4_autoware_utils::calcDistance2d(pose, goal_pose_) *
-                  astar_param_.distance_heuristic_weight;
+    total_cost += tier4_autoware_utils::calcDistance2d(pose, goal_pose_);
   }
-  return total_cost;
+
+  // the shortest path avoiding obstacles is not shorter than both of the distances
+  total_cost = std::max(total_cost, calcObstacleDistanceHeuristic(pose));
+  return total_cost * astar_param_.distance_heuristic_weight;
 }
 
 bool AstarSearch::search()
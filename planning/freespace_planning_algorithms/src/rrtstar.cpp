@@ -14,6 +14,8 @@
 
 #include "freespace_planning_algorithms/rrtstar.hpp"
 
+#include <algorithm>
+
 namespace
 {
 
@@ -83,27 +85,29 @@ bool RRTStar::makePlan(
   auto algo = rrtstar_core::RRTStar(
     x_start, x_goal, rrtstar_param_.neighbor_radius, collision_check_resolution, is_informed,
     cspace);
-  while (true) {
+  const auto is_terminated = [&]() {
     const rclcpp::Time now = rclcpp::Clock(RCL_ROS_TIME).now();
     const double msec = (now - begin).seconds() * 1000.0;
 
     if (msec > planner_common_param_.time_limit) {
       // break regardless of solution find or not
-      break;
+      return true;
     }
 
     if (algo.isSolutionFound()) {
       if (!rrtstar_param_.enable_update) {
-        break;
+        return true;
       } else {
         if (msec > rrtstar_param_.max_planning_time) {
-          break;
+          return true;
         }
       }
     }
 
-    algo.extend();
-  }
+    return false;
+  };
+  const size_t num_threads = static_cast<size_t>(std::max(rrtstar_param_.num_threads, 1));
+  algo.extendInParallel(num_threads, is_terminated);
 
   if (!algo.isSolutionFound()) {
     return false;
@@ -16,11 +16,18 @@
 
 #include <nlohmann/json.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <queue>
+#include <shared_mutex>
 #include <stack>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -138,18 +145,22 @@ RRTStar::RRTStar(
   node_goal_ = std::make_shared<Node>(Node{x_goal, boost::none, 0.0});
   node_start_ = std::make_shared<Node>(Node{x_start, 0.0});
   nodes_.push_back(node_start_);
+  rebuildGrid();
 }
 
-void RRTStar::extend()
+Pose RRTStar::sampleRandomPose(CSpace & cspace) const
 {
-  // Determine new node
-  Pose x_rand;
   if (isSolutionFound() && is_informed_) {
-    x_rand = cspace_.ellipticInformedSampling(
+    return cspace.ellipticInformedSampling(
       *node_goal_->cost_from_start, node_start_->pose, node_goal_->pose);
-  } else {
-    x_rand = cspace_.uniformSampling();
   }
+  return cspace.uniformSampling();
+}
+
+void RRTStar::extend()
+{
+  // Determine new node
+  const Pose x_rand = sampleRandomPose(cspace_);
 
   const auto node_nearest = findNearestNode(x_rand);
 
@@ -160,6 +171,102 @@ void RRTStar::extend()
     return;
   }
 
+  commitExtension(x_new, node_nearest);
+}
+
+void RRTStar::extendInParallel(
+  const size_t num_threads, const std::function<bool()> & is_terminated)
+{
+  if (num_threads <= 1) {
+    while (!is_terminated()) {
+      extend();
+    }
+    return;
+  }
+
+  struct Extension
+  {
+    Pose x_new;
+    NodeConstSharedPtr node_nearest;
+  };
+  const size_t max_queue_size = 4 * num_threads;
+
+  // NOTE: the workers read the tree under the shared lock, and only this thread modifies it
+  //       under the exclusive lock. Poses of the nodes are never modified after they are added.
+  std::shared_mutex tree_mutex;
+  std::mutex queue_mutex;
+  std::condition_variable queue_cv;
+  std::deque<Extension> extension_queue;
+  bool is_stopped = false;
+
+  const auto propose_extensions = [&](CSpace cspace) {
+    while (true) {
+      Pose x_rand;
+      NodeConstSharedPtr node_nearest;
+      {
+        std::shared_lock<std::shared_mutex> tree_lock(tree_mutex);
+        x_rand = sampleRandomPose(cspace);
+        node_nearest = findNearestNode(x_rand);
+      }
+
+      const Pose x_new = cspace.interpolate_child2parent(node_nearest->pose, x_rand, mu_);
+      const bool is_valid =
+        cspace.isValidPath_child2parent(x_new, node_nearest->pose, collision_check_resolution_);
+
+      std::unique_lock<std::mutex> queue_lock(queue_mutex);
+      if (is_valid) {
+        queue_cv.wait(
+          queue_lock, [&] { return is_stopped || extension_queue.size() < max_queue_size; });
+        if (!is_stopped) {
+          extension_queue.push_back(Extension{x_new, node_nearest});
+        }
+      }
+      if (is_stopped) {
+        return;
+      }
+    }
+  };
+
+  // each worker samples with its own random generator
+  std::random_device device;
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < num_threads - 1; ++i) {
+    auto cspace = cspace_;
+    cspace.setRandomSeed(device());
+    workers.emplace_back(propose_extensions, cspace);
+  }
+
+  while (!is_terminated()) {
+    std::deque<Extension> extensions;
+    {
+      std::unique_lock<std::mutex> queue_lock(queue_mutex);
+      queue_cv.wait_for(
+        queue_lock, std::chrono::milliseconds(1), [&] { return !extension_queue.empty(); });
+      extensions.swap(extension_queue);
+    }
+    queue_cv.notify_all();
+
+    std::unique_lock<std::shared_mutex> tree_lock(tree_mutex);
+    for (const auto & extension : extensions) {
+      if (is_terminated()) {
+        break;
+      }
+      commitExtension(extension.x_new, extension.node_nearest);
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> queue_lock(queue_mutex);
+    is_stopped = true;
+  }
+  queue_cv.notify_all();
+  for (auto & worker : workers) {
+    worker.join();
+  }
+}
+
+void RRTStar::commitExtension(const Pose & x_new, const NodeConstSharedPtr & node_nearest)
+{
   const auto & neighbor_nodes = findNeighborNodes(x_new);
 
   const auto & node_best_parent = getBestParentNode(x_new, node_nearest, neighbor_nodes);
@@ -257,6 +364,36 @@ void RRTStar::deleteNodeUsingBranchAndBound()
   for (const size_t delete_idx : delete_indices_vec) {
     nodes_.erase(nodes_.begin() + delete_idx);
   }
+  rebuildGrid();
+}
+
+uint64_t RRTStar::getGridKey(const int index_x, const int index_y) const
+{
+  return (static_cast<uint64_t>(static_cast<uint32_t>(index_x)) << 32) |
+         static_cast<uint64_t>(static_cast<uint32_t>(index_y));
+}
+
+void RRTStar::addNodeToGrid(const NodeSharedPtr & node)
+{
+  const int index_x = getGridIndex(node->pose.x);
+  const int index_y = getGridIndex(node->pose.y);
+  node_grid_[getGridKey(index_x, index_y)].push_back(node);
+
+  grid_bounds_[0] = std::min(grid_bounds_[0], index_x);
+  grid_bounds_[1] = std::max(grid_bounds_[1], index_x);
+  grid_bounds_[2] = std::min(grid_bounds_[2], index_y);
+  grid_bounds_[3] = std::max(grid_bounds_[3], index_y);
+}
+
+void RRTStar::rebuildGrid()
+{
+  node_grid_.clear();
+  grid_bounds_ = {
+    std::numeric_limits<int>::max(), std::numeric_limits<int>::lowest(),
+    std::numeric_limits<int>::max(), std::numeric_limits<int>::lowest()};
+  for (const auto & node : nodes_) {
+    addNodeToGrid(node);
+  }
 }
 
 std::vector<Pose> RRTStar::sampleSolutionWaypoints() const
@@ -332,14 +469,45 @@ NodeConstSharedPtr RRTStar::findNearestNode(const Pose & x_rand) const
 {
   double dist_min = inf;
   NodeConstSharedPtr node_nearest;
-  for (const auto & node : nodes_) {
-    if (cspace_.distanceLowerBound(node->pose, x_rand) < dist_min) {
-      const double dist_real = cspace_.distance(node->pose, x_rand);
-      if (dist_real < dist_min) {
-        dist_min = dist_real;
-        node_nearest = node;
+  const auto search_cell = [&](const int index_x, const int index_y) {
+    const auto itr = node_grid_.find(getGridKey(index_x, index_y));
+    if (itr == node_grid_.end()) {
+      return;
+    }
+    for (const auto & node : itr->second) {
+      if (cspace_.distanceLowerBound(node->pose, x_rand) < dist_min) {
+        const double dist_real = cspace_.distance(node->pose, x_rand);
+        if (dist_real < dist_min) {
+          dist_min = dist_real;
+          node_nearest = node;
+        }
       }
     }
+  };
+
+  // search the rings of cells around x_rand from the inside
+  const int index_x = getGridIndex(x_rand.x);
+  const int index_y = getGridIndex(x_rand.y);
+  const int max_ring = std::max(
+    {index_x - grid_bounds_[0], grid_bounds_[1] - index_x, index_y - grid_bounds_[2],
+     grid_bounds_[3] - index_y});
+  for (int ring = 0; ring <= max_ring; ++ring) {
+    // the nodes in the ring are farther than (ring - 1) * mu_ from x_rand
+    if (dist_min <= (ring - 1) * mu_) {
+      break;
+    }
+    if (ring == 0) {
+      search_cell(index_x, index_y);
+      continue;
+    }
+    for (int d = -ring; d <= ring; ++d) {
+      search_cell(index_x + d, index_y - ring);
+      search_cell(index_x + d, index_y + ring);
+    }
+    for (int d = -ring + 1; d <= ring - 1; ++d) {
+      search_cell(index_x - ring, index_y + d);
+      search_cell(index_x + ring, index_y + d);
+    }
   }
   return node_nearest;
 }
@@ -359,12 +527,23 @@ std::vector<NodeConstSharedPtr> RRTStar::findNeighborNodes(const Pose & x_new) c
 
   const double radius_neighbor = mu_;
 
+  // NOTE: the cell size of the grid is radius_neighbor, so the neighbors are in the 3x3 cells
+  const int index_x = getGridIndex(x_new.x);
+  const int index_y = getGridIndex(x_new.y);
   std::vector<NodeConstSharedPtr> nodes;
-  for (auto & node : nodes_) {
-    if (cspace_.distanceLowerBound(node->pose, x_new) > radius_neighbor) continue;
-    const bool is_neighbor = (cspace_.distance(node->pose, x_new) < radius_neighbor);
-    if (is_neighbor) {
-      nodes.push_back(node);
+  for (int dx = -1; dx <= 1; ++dx) {
+    for (int dy = -1; dy <= 1; ++dy) {
+      const auto itr = node_grid_.find(getGridKey(index_x + dx, index_y + dy));
+      if (itr == node_grid_.end()) {
+        continue;
+      }
+      for (const auto & node : itr->second) {
+        if (cspace_.distanceLowerBound(node->pose, x_new) > radius_neighbor) continue;
+        const bool is_neighbor = (cspace_.distance(node->pose, x_new) < radius_neighbor);
+        if (is_neighbor) {
+          nodes.push_back(node);
+        }
+      }
     }
   }
   return nodes;
@@ -377,6 +556,7 @@ NodeSharedPtr RRTStar::addNewNode(const Pose & pose, NodeSharedPtr node_parent)
   auto node_new =
     std::make_shared<Node>(Node{pose, cost_from_start, boost::none, cost_to_parent, node_parent});
   nodes_.push_back(node_new);
+  addNodeToGrid(node_new);
   node_parent->childs.push_back(node_new);
   return node_new;
 }
@@ -226,7 +226,9 @@ std::unique_ptr<fpa::AbstractPlanningAlgorithm> configure_rrtstar(bool informed,
   const double mu = 12.0;
   const double margin = 0.2;
   const double max_planning_time = 200;
-  const auto rrtstar_param = fpa::RRTStarParam{update, informed, max_planning_time, mu, margin};
+  const int num_threads = 1;
+  const auto rrtstar_param =
+    fpa::RRTStarParam{update, informed, max_planning_time, mu, margin, num_threads};
   auto algo = std::make_unique<fpa::RRTStar>(planner_common_param, vehicle_shape, rrtstar_param);
   return algo;
 }
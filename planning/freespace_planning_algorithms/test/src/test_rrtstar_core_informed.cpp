@@ -16,6 +16,7 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
 #include <iostream>
 #include <stack>
 
@@ -106,6 +107,40 @@ TEST(RRTStarCore, WithInformedOption)
   }
 }
 
+TEST(RRTStarCore, InParallel)
+{
+  const rrtstar_core::Pose x_start{0.1, 0.1, 0};
+  const rrtstar_core::Pose x_goal{0.8, 0.8, 0.};
+
+  const rrtstar_core::Pose x_lo{0, 0, -6.28};
+  const rrtstar_core::Pose x_hi{1., 1., +6.28};
+
+  auto is_collision_free = [](const rrtstar_core::Pose & p) {
+    const double radius_squared = (p.x - 0.5) * (p.x - 0.5) + (p.y - 0.5) * (p.y - 0.5);
+    return radius_squared > 0.09;
+  };
+  const auto resolution = 0.01;
+  const auto cspace = rrtstar_core::CSpace(x_lo, x_hi, 0.1, is_collision_free);
+  auto algo = rrtstar_core::RRTStar(x_start, x_goal, 0.2, resolution, true, cspace);
+
+  const auto begin = std::chrono::steady_clock::now();
+  algo.extendInParallel(4, [&begin]() {
+    return std::chrono::steady_clock::now() - begin > std::chrono::milliseconds(1000);
+  });
+  EXPECT_TRUE(algo.isSolutionFound());
+  EXPECT_TRUE(checkAllNodeConnected(algo));
+
+  // check solution trajectory
+  const auto waypoints = algo.sampleSolutionWaypoints();
+  bool is_feasible = true;
+  for (const auto & p : waypoints) {
+    if (!cspace.isValidPose(p)) {
+      is_feasible = false;
+    }
+  }
+  EXPECT_TRUE(is_feasible);
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
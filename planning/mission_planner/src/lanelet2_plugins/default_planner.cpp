@@ -29,7 +29,9 @@
 #include <lanelet2_routing/RoutingCost.h>
 #include <tf2/utils.h>
 
+#include <future>
 #include <limits>
+#include <utility>
 #include <vector>
 
 namespace
@@ -59,32 +61,12 @@ bool is_in_lane(const lanelet::ConstLanelet & lanelet, const lanelet::ConstPoint
   return distance < th_distance;
 }
 
-bool is_in_parking_space(
-  const lanelet::ConstLineStrings3d & parking_spaces, const lanelet::ConstPoint3d & point)
+bool is_in_polygons(
+  const std::vector<lanelet::BasicPolygon2d> & polygons, const lanelet::ConstPoint3d & point)
 {
-  for (const auto & parking_space : parking_spaces) {
-    lanelet::ConstPolygon3d parking_space_polygon;
-    if (!lanelet::utils::lineStringWithWidthToPolygon(parking_space, &parking_space_polygon)) {
-      continue;
-    }
-
-    const double distance = boost::geometry::distance(
-      lanelet::utils::to2D(parking_space_polygon).basicPolygon(),
-      lanelet::utils::to2D(point).basicPoint());
-    constexpr double th_distance = std::numeric_limits<double>::epsilon();
-    if (distance < th_distance) {
-      return true;
-    }
-  }
-  return false;
-}
-
-bool is_in_parking_lot(
-  const lanelet::ConstPolygons3d & parking_lots, const lanelet::ConstPoint3d & point)
-{
-  for (const auto & parking_lot : parking_lots) {
-    const double distance = boost::geometry::distance(
-      lanelet::utils::to2D(parking_lot).basicPolygon(), lanelet::utils::to2D(point).basicPoint());
+  const auto point_2d = lanelet::utils::to2D(point).basicPoint();
+  for (const auto & polygon : polygons) {
+    const double distance = boost::geometry::distance(polygon, point_2d);
     constexpr double th_distance = std::numeric_limits<double>::epsilon();
     if (distance < th_distance) {
       return true;
@@ -109,14 +91,18 @@ geometry_msgs::msg::Pose get_closest_centerline_pose(
   lanelet::Lanelet closest_lanelet;
   lanelet::utils::query::getClosestLanelet(road_lanelets, point, &closest_lanelet);
 
+  // the lanelet shares its data with the map of the route handler, so the refined centerline is
+  // set to a local lanelet with the same bounds
   const auto refined_center_line = lanelet::utils::generateFineCenterline(closest_lanelet, 1.0);
-  closest_lanelet.setCenterline(refined_center_line);
+  lanelet::Lanelet refined_lanelet(
+    lanelet::InvalId, closest_lanelet.leftBound(), closest_lanelet.rightBound());
+  refined_lanelet.setCenterline(refined_center_line);
 
-  const double lane_yaw = lanelet::utils::getLaneletAngle(closest_lanelet, point.position);
+  const double lane_yaw = lanelet::utils::getLaneletAngle(refined_lanelet, point.position);
 
   const auto nearest_idx =
-    motion_utils::findNearestIndex(convertCenterlineToPoints(closest_lanelet), point.position);
-  const auto nearest_point = closest_lanelet.centerline()[nearest_idx];
+    motion_utils::findNearestIndex(convertCenterlineToPoints(refined_lanelet), point.position);
+  const auto nearest_point = refined_lanelet.centerline()[nearest_idx];
 
   // shift nearest point on its local y axis so that vehicle's right and left edges
   // would have approx the same clearance from road border
@@ -167,13 +153,28 @@ bool DefaultPlanner::ready() const { return is_graph_ready_; }
 
 void DefaultPlanner::map_callback(const HADMapBin::ConstSharedPtr msg)
 {
+  // the route handler shares the map and routing graph with the other nodes of the process
   route_handler_.setMap(*msg);
-  lanelet_map_ptr_ = std::make_shared<lanelet::LaneletMap>();
-  lanelet::utils::conversion::fromBinMsg(
-    *msg, lanelet_map_ptr_, &traffic_rules_ptr_, &routing_graph_ptr_);
+  lanelet_map_ptr_ = route_handler_.getLaneletMapPtr();
+  traffic_rules_ptr_ = route_handler_.getTrafficRulesPtr();
+  routing_graph_ptr_ = route_handler_.getRoutingGraphPtr();
   lanelet::ConstLanelets all_lanelets = lanelet::utils::query::laneletLayer(lanelet_map_ptr_);
   road_lanelets_ = lanelet::utils::query::roadLanelets(all_lanelets);
   shoulder_lanelets_ = lanelet::utils::query::shoulderLanelets(all_lanelets);
+
+  parking_lot_polygons_.clear();
+  for (const auto & parking_lot : lanelet::utils::query::getAllParkingLots(lanelet_map_ptr_)) {
+    parking_lot_polygons_.push_back(lanelet::utils::to2D(parking_lot).basicPolygon());
+  }
+  parking_space_polygons_.clear();
+  for (const auto & parking_space : lanelet::utils::query::getAllParkingSpaces(lanelet_map_ptr_)) {
+    lanelet::ConstPolygon3d parking_space_polygon;
+    if (lanelet::utils::lineStringWithWidthToPolygon(parking_space, &parking_space_polygon)) {
+      parking_space_polygons_.push_back(lanelet::utils::to2D(parking_space_polygon).basicPolygon());
+    }
+  }
+  combined_lanelet_cache_.clear();
+
   is_graph_ready_ = true;
 }
 
@@ -256,17 +257,35 @@ visualization_msgs::msg::MarkerArray DefaultPlanner::visualize_debug_footprint(
   return msg;
 }
 
+const DefaultPlanner::CombinedLanelet & DefaultPlanner::get_combined_lanelet(
+  const CombinedLaneletKey & key, const lanelet::ConstLanelets & lanelets)
+{
+  // the cache only grows with the number of different routes and goals since the last map update
+  constexpr size_t max_cache_size = 1000;
+  const auto itr = combined_lanelet_cache_.find(key);
+  if (itr != combined_lanelet_cache_.end()) {
+    return itr->second;
+  }
+  if (max_cache_size <= combined_lanelet_cache_.size()) {
+    combined_lanelet_cache_.clear();
+  }
+
+  CombinedLanelet combined;
+  combined.lanelet = combine_lanelets(lanelets);
+  combined.polygon = combined.lanelet.polygon2d().basicPolygon();
+  return combined_lanelet_cache_.emplace(key, std::move(combined)).first->second;
+}
+
 bool DefaultPlanner::check_goal_footprint(
-  const lanelet::ConstLanelet & current_lanelet,
-  const lanelet::ConstLanelet & combined_prev_lanelet,
+  const lanelet::ConstLanelet & current_lanelet, const CombinedLaneletKey & combined_prev_key,
+  const CombinedLanelet & combined_prev_lanelet,
   const tier4_autoware_utils::Polygon2d & goal_footprint, double & next_lane_length,
   const double search_margin)
 {
   std::vector<tier4_autoware_utils::Point2d> points_intersection;
 
   // check if goal footprint is in current lane
-  boost::geometry::intersection(
-    goal_footprint, combined_prev_lanelet.polygon2d().basicPolygon(), points_intersection);
+  boost::geometry::intersection(goal_footprint, combined_prev_lanelet.polygon, points_intersection);
   if (points_intersection.empty()) {
     return true;
   }
@@ -276,21 +295,25 @@ bool DefaultPlanner::check_goal_footprint(
   for (const auto & next_lane : routing_graph_ptr_->following(current_lanelet)) {
     next_lane_length += lanelet::utils::getLaneletLength2d(next_lane);
     lanelet::ConstLanelets lanelets;
-    lanelets.push_back(combined_prev_lanelet);
+    lanelets.push_back(combined_prev_lanelet.lanelet);
     lanelets.push_back(next_lane);
-    lanelet::ConstLanelet combined_lanelets = combine_lanelets(lanelets);
+    CombinedLaneletKey combined_key = combined_prev_key;
+    combined_key.push_back(lanelet::InvalId);
+    combined_key.push_back(next_lane.id());
+    // copy since the cache may be cleared by the recursive call
+    const CombinedLanelet combined_lanelets = get_combined_lanelet(combined_key, lanelets);
 
     // if next lanelet length longer than vehicle longitudinal offset
     if (vehicle_info_.max_longitudinal_offset_m + search_margin < next_lane_length) {
       next_lane_length -= lanelet::utils::getLaneletLength2d(next_lane);
-      boost::geometry::intersection(
-        goal_footprint, combined_lanelets.polygon2d().basicPolygon(), points_intersection);
+      boost::geometry::intersection(goal_footprint, combined_lanelets.polygon, points_intersection);
       if (points_intersection.empty()) {
         return true;
       }
       points_intersection.clear();
     } else {  // if next lanelet length shorter than vehicle longitudinal offset -> recursive call
-      if (!check_goal_footprint(next_lane, combined_lanelets, goal_footprint, next_lane_length)) {
+      if (!check_goal_footprint(
+            next_lane, combined_key, combined_lanelets, goal_footprint, next_lane_length)) {
         next_lane_length -= lanelet::utils::getLaneletLength2d(next_lane);
         continue;
       } else {
@@ -337,15 +360,20 @@ bool DefaultPlanner::is_goal_valid(
 
   double next_lane_length = 0.0;
   // combine calculated route lanelets
-  lanelet::ConstLanelet combined_prev_lanelet = combine_lanelets(path_lanelets);
+  CombinedLaneletKey combined_prev_key;
+  combined_prev_key.reserve(path_lanelets.size());
+  for (const auto & path_lanelet : path_lanelets) {
+    combined_prev_key.push_back(path_lanelet.id());
+  }
+  const CombinedLanelet combined_prev_lanelet =
+    get_combined_lanelet(combined_prev_key, path_lanelets);
 
   // check if goal footprint exceeds lane when the goal isn't in parking_lot
   if (
     !check_goal_footprint(
-      closest_lanelet, combined_prev_lanelet, polygon_footprint, next_lane_length) &&
-    !is_in_parking_lot(
-      lanelet::utils::query::getAllParkingLots(lanelet_map_ptr_),
-      lanelet::utils::conversion::toLaneletPoint(goal.position))) {
+      closest_lanelet, combined_prev_key, combined_prev_lanelet, polygon_footprint,
+      next_lane_length) &&
+    !is_in_polygons(parking_lot_polygons_, goal_lanelet_pt)) {
     RCLCPP_WARN(logger, "Goal's footprint exceeds lane!");
     return false;
   }
@@ -362,14 +390,12 @@ bool DefaultPlanner::is_goal_valid(
   }
 
   // check if goal is in parking space
-  const auto parking_spaces = lanelet::utils::query::getAllParkingSpaces(lanelet_map_ptr_);
-  if (is_in_parking_space(parking_spaces, goal_lanelet_pt)) {
+  if (is_in_polygons(parking_space_polygons_, goal_lanelet_pt)) {
     return true;
   }
 
   // check if goal is in parking lot
-  const auto parking_lots = lanelet::utils::query::getAllParkingLots(lanelet_map_ptr_);
-  if (is_in_parking_lot(parking_lots, goal_lanelet_pt)) {
+  if (is_in_polygons(parking_lot_polygons_, goal_lanelet_pt)) {
     return true;
   }
 
@@ -392,15 +418,30 @@ PlannerPlugin::LaneletRoute DefaultPlanner::plan(const RoutePoints & points)
   LaneletRoute route_msg;
   RouteSections route_sections;
 
-  lanelet::ConstLanelets all_route_lanelets;
+  // search the sections between the check points concurrently since they are independent
+  std::vector<std::future<std::pair<bool, lanelet::ConstLanelets>>> section_futures;
   for (std::size_t i = 1; i < points.size(); i++) {
-    const auto start_check_point = points.at(i - 1);
-    const auto goal_check_point = points.at(i);
-    lanelet::ConstLanelets path_lanelets;
-    if (!route_handler_.planPathLaneletsBetweenCheckpoints(
-          start_check_point, goal_check_point, &path_lanelets)) {
+    const auto launch_policy = points.size() == 2 ? std::launch::deferred : std::launch::async;
+    section_futures.push_back(std::async(launch_policy, [this, &points, i]() {
+      lanelet::ConstLanelets path_lanelets;
+      const bool is_found = route_handler_.planPathLaneletsBetweenCheckpoints(
+        points.at(i - 1), points.at(i), &path_lanelets);
+      return std::make_pair(is_found, path_lanelets);
+    }));
+  }
+
+  // the route handler is updated only after all the searches are finished
+  std::vector<lanelet::ConstLanelets> section_lanelets;
+  for (auto & section_future : section_futures) {
+    const auto [is_found, path_lanelets] = section_future.get();
+    if (!is_found) {
       return route_msg;
     }
+    section_lanelets.push_back(path_lanelets);
+  }
+
+  lanelet::ConstLanelets all_route_lanelets;
+  for (const auto & path_lanelets : section_lanelets) {
     for (const auto & lane : path_lanelets) {
       all_route_lanelets.push_back(lane);
     }
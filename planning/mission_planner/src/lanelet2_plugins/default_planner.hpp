@@ -27,6 +27,7 @@
 #include <lanelet2_routing/RoutingGraph.h>
 #include <lanelet2_traffic_rules/TrafficRulesFactory.h>
 
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -61,6 +62,20 @@ private:
   lanelet::ConstLanelets shoulder_lanelets_;
   route_handler::RouteHandler route_handler_;
 
+  // polygons of parking lots and parking spaces, extracted once per map
+  std::vector<lanelet::BasicPolygon2d> parking_lot_polygons_;
+  std::vector<lanelet::BasicPolygon2d> parking_space_polygons_;
+
+  // Combined lanelets used by the goal footprint check. The key is the sequence of the combined
+  // lanelet IDs, where lanelet::InvalId separates the lanelets combined with a combined lanelet.
+  struct CombinedLanelet
+  {
+    lanelet::ConstLanelet lanelet;
+    lanelet::BasicPolygon2d polygon;
+  };
+  using CombinedLaneletKey = std::vector<lanelet::Id>;
+  std::map<CombinedLaneletKey, CombinedLanelet> combined_lanelet_cache_;
+
   DefaultPlannerParameters param_;
 
   rclcpp::Node * node_;
@@ -69,9 +84,11 @@ private:
 
   void initialize_common(rclcpp::Node * node);
   void map_callback(const HADMapBin::ConstSharedPtr msg);
+  const CombinedLanelet & get_combined_lanelet(
+    const CombinedLaneletKey & key, const lanelet::ConstLanelets & lanelets);
   bool check_goal_footprint(
-    const lanelet::ConstLanelet & current_lanelet,
-    const lanelet::ConstLanelet & combined_prev_lanelet,
+    const lanelet::ConstLanelet & current_lanelet, const CombinedLaneletKey & combined_prev_key,
+    const CombinedLanelet & combined_prev_lanelet,
     const tier4_autoware_utils::Polygon2d & goal_footprint, double & next_lane_length,
     const double search_margin = 2.0);
   bool is_goal_valid(const geometry_msgs::msg::Pose & goal, lanelet::ConstLanelets path_lanelets);
@@ -93,6 +93,16 @@ private:
 
   bool is_reverse_;
 
+  // state to reuse the previous output while the input trajectory is unchanged
+  struct PrevSolveState
+  {
+    size_t input_hash{0};                 // content hash of the input trajectory
+    bool is_reverse{false};               // driving direction of the input trajectory
+    double external_velocity_limit{0.0};  // external velocity limit used for the solve
+    Pose ego_pose{};                      // ego pose at the solve
+  };
+  boost::optional<PrevSolveState> prev_solve_state_{};
+
   enum class AlgorithmType {
     INVALID = 0,
     JERK_FILTERED = 1,
@@ -126,6 +136,10 @@ private:
     double ego_nearest_dist_threshold;    // for ego's closest index calculation
     double ego_nearest_yaw_threshold;     // for ego's closest index calculation
 
+    bool enable_reuse_unchanged_input;    // reuse the previous output for the same input
+    double reuse_max_velocity_deviation;  // re-solve if the speed error exceeds this [m/s]
+    double reuse_max_travel_distance;     // re-solve after ego travels this distance [m]
+
     resampling::ResampleParam post_resample_param;
     AlgorithmType algorithm_type;  // Option : JerkFiltered, Linf, L2
   } node_param_{};
@@ -179,6 +193,10 @@ private:
 
   TrajectoryPoints calcTrajectoryVelocity(const TrajectoryPoints & traj_input) const;
 
+  bool isPrevOutputReusable(const size_t input_hash) const;
+
+  TrajectoryPoints advancePrevOutput() const;
+
   bool smoothVelocity(
     const TrajectoryPoints & input, const size_t input_closest,
     TrajectoryPoints & traj_smoothed) const;
@@ -59,6 +59,12 @@ private:
   autoware::common::osqp::OSQPInterface qp_solver_;
   rclcpp::Logger logger_{rclcpp::get_logger("smoother").get_child("jerk_filtered_smoother")};
 
+  // previous QP data for the workspace reuse and warm start
+  size_t prev_num_points_{0};
+  std::vector<double> prev_primal_variables_;
+  std::vector<double> prev_dual_variables_;
+  TrajectoryPoints prev_opt_resampled_trajectory_;
+
   TrajectoryPoints forwardJerkFilter(
     const double v0, const double a0, const double a_max, const double a_stop, const double j_max,
     const TrajectoryPoints & input) const;
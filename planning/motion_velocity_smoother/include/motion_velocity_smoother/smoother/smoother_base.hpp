@@ -88,8 +88,12 @@ public:
   void setParam(const BaseParam & param);
   BaseParam getBaseParam() const;
 
+  // when disabled, apply() leaves debug_trajectories empty instead of building them
+  void setDebugTrajectoriesEnabled(const bool enable);
+
 protected:
   BaseParam base_param_;
+  bool enable_debug_trajectories_{true};
 };
 }  // namespace motion_velocity_smoother
 
@@ -23,6 +23,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <functional>
 #include <limits>
 #include <map>
 #include <memory>
@@ -33,6 +34,33 @@
 // clang-format on
 namespace motion_velocity_smoother
 {
+namespace
+{
+template <class T>
+bool hasSubscriber(const typename rclcpp::Publisher<T>::SharedPtr & pub)
+{
+  return pub &&
+         (pub->get_subscription_count() + pub->get_intra_process_subscription_count()) > 0;
+}
+
+size_t calcTrajectoryHash(const TrajectoryPoints & points)
+{
+  size_t seed = points.size();
+  const auto hash_combine = [&seed](const double v) {
+    seed ^= std::hash<double>{}(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  };
+  for (const auto & p : points) {
+    hash_combine(p.pose.position.x);
+    hash_combine(p.pose.position.y);
+    hash_combine(p.pose.position.z);
+    hash_combine(p.pose.orientation.z);
+    hash_combine(p.pose.orientation.w);
+    hash_combine(p.longitudinal_velocity_mps);
+  }
+  return seed;
+}
+}  // namespace
+
 MotionVelocitySmootherNode::MotionVelocitySmootherNode(const rclcpp::NodeOptions & node_options)
 : Node("motion_velocity_smoother", node_options)
 {
@@ -233,6 +261,9 @@ rcl_interfaces::msg::SetParametersResult MotionVelocitySmootherNode::onParameter
       throw std::domain_error("[MotionVelocitySmootherNode] invalid algorithm");
   }
 
+  // the previous output was planned with the old parameters
+  prev_solve_state_ = boost::none;
+
   rcl_interfaces::msg::SetParametersResult result{};
   result.successful = true;
   result.reason = "success";
@@ -268,6 +299,11 @@ void MotionVelocitySmootherNode::initCommonParam()
   p.post_resample_param.sparse_resample_dt = declare_parameter<double>("post_sparse_resample_dt");
   p.post_resample_param.sparse_min_interval_distance =
     declare_parameter<double>("post_sparse_min_interval_distance");
+  p.enable_reuse_unchanged_input = declare_parameter<bool>("reuse_unchanged_input.enable");
+  p.reuse_max_velocity_deviation =
+    declare_parameter<double>("reuse_unchanged_input.max_velocity_deviation");
+  p.reuse_max_travel_distance =
+    declare_parameter<double>("reuse_unchanged_input.max_travel_distance");
   p.algorithm_type = getAlgorithmType(declare_parameter<std::string>("algorithm_type"));
 }
 
@@ -424,12 +460,24 @@ void MotionVelocitySmootherNode::onCurrentTrajectory(const Trajectory::ConstShar
     flipVelocity(input_points);
   }
 
-  const auto output = calcTrajectoryVelocity(input_points);
+  // Skip the whole smoothing while the input is unchanged and ego follows the previous output
+  const size_t input_hash =
+    node_param_.enable_reuse_unchanged_input ? calcTrajectoryHash(input_points) : 0;
+  const bool reuse_prev_output = isPrevOutputReusable(input_hash);
+
+  const auto output =
+    reuse_prev_output ? advancePrevOutput() : calcTrajectoryVelocity(input_points);
   if (output.empty()) {
     RCLCPP_WARN(get_logger(), "Output Point is empty");
     return;
   }
 
+  if (node_param_.enable_reuse_unchanged_input && !reuse_prev_output) {
+    prev_solve_state_ = PrevSolveState{
+      input_hash, is_reverse_, external_velocity_limit_.velocity,
+      current_odometry_ptr_->pose.pose};
+  }
+
   // Note that output velocity is resampled by linear interpolation
   auto output_resampled = resampling::resampleTrajectory(
     output, current_odometry_ptr_->twist.twist.linear.x, current_odometry_ptr_->pose.pose,
@@ -462,6 +510,57 @@ void MotionVelocitySmootherNode::onCurrentTrajectory(const Trajectory::ConstShar
   RCLCPP_DEBUG(get_logger(), "========================== run() end ==========================\n\n");
 }
 
+bool MotionVelocitySmootherNode::isPrevOutputReusable(const size_t input_hash) const
+{
+  if (!node_param_.enable_reuse_unchanged_input || !prev_solve_state_) {
+    return false;
+  }
+  if (prev_output_.empty() || !current_closest_point_from_prev_output_) {
+    return false;
+  }
+
+  // input trajectory and external velocity limit
+  constexpr double eps = 1.0E-04;
+  const auto & prev = *prev_solve_state_;
+  if (prev.input_hash != input_hash || prev.is_reverse != is_reverse_) {
+    return false;
+  }
+  if (std::fabs(prev.external_velocity_limit - external_velocity_limit_.velocity) > eps) {
+    return false;
+  }
+
+  // ego velocity tracking (engaging is decided every cycle in calcInitialMotion)
+  const double vehicle_speed = std::fabs(current_odometry_ptr_->twist.twist.linear.x);
+  const double desired_vel =
+    std::fabs(current_closest_point_from_prev_output_->longitudinal_velocity_mps);
+  if (vehicle_speed < node_param_.engage_velocity * node_param_.engage_exit_ratio) {
+    return false;
+  }
+  if (std::fabs(vehicle_speed - desired_vel) > node_param_.reuse_max_velocity_deviation) {
+    return false;
+  }
+
+  // ego pose deviation and travel distance from the last solve
+  const auto & ego_pose = current_odometry_ptr_->pose.pose;
+  const auto ego_seg_idx = motion_utils::findNearestSegmentIndex(
+    prev_output_, ego_pose, node_param_.ego_nearest_dist_threshold,
+    node_param_.ego_nearest_yaw_threshold);
+  if (!ego_seg_idx) {
+    return false;
+  }
+  const double travel_dist =
+    motion_utils::calcSignedArcLength(prev_output_, prev.ego_pose.position, ego_pose.position);
+  return std::fabs(travel_dist) < node_param_.reuse_max_travel_distance;
+}
+
+TrajectoryPoints MotionVelocitySmootherNode::advancePrevOutput() const
+{
+  // the optimized profile is fixed in space, so only the part far behind ego is dropped
+  const size_t ego_idx = findNearestIndexFromEgo(prev_output_);
+  return trajectory_utils::extractPathAroundIndex(
+    prev_output_, ego_idx, std::numeric_limits<double>::max(), node_param_.extract_behind_dist);
+}
+
 void MotionVelocitySmootherNode::updateDataForExternalVelocityLimit()
 {
   if (prev_output_.empty()) {
@@ -494,7 +593,7 @@ TrajectoryPoints MotionVelocitySmootherNode::calcTrajectoryVelocity(
   }
 
   // Debug
-  if (publish_debug_trajs_) {
+  if (publish_debug_trajs_ && hasSubscriber<Trajectory>(pub_trajectory_raw_)) {
     auto tmp = traj_extracted;
     if (is_reverse_) flipVelocity(tmp);
     pub_trajectory_raw_->publish(toTrajectoryMsg(tmp));
@@ -510,7 +609,7 @@ TrajectoryPoints MotionVelocitySmootherNode::calcTrajectoryVelocity(
   applyStopApproachingVelocity(traj_extracted);
 
   // Debug
-  if (publish_debug_trajs_) {
+  if (publish_debug_trajs_ && hasSubscriber<Trajectory>(pub_trajectory_vel_lim_)) {
     auto tmp = traj_extracted;
     if (is_reverse_) flipVelocity(tmp);
     pub_trajectory_vel_lim_->publish(toTrajectoryMsg(traj_extracted));
@@ -567,6 +666,14 @@ bool MotionVelocitySmootherNode::smoothVelocity(
   clipped.insert(
     clipped.end(), traj_resampled.begin() + traj_resampled_closest, traj_resampled.end());
 
+  // Skip building the smoother internal trajectories when nobody listens to them
+  const bool publish_smoother_debug_trajs =
+    publish_debug_trajs_ && (hasSubscriber<Trajectory>(pub_forward_filtered_trajectory_) ||
+                             hasSubscriber<Trajectory>(pub_backward_filtered_trajectory_) ||
+                             hasSubscriber<Trajectory>(pub_merged_filtered_trajectory_) ||
+                             hasSubscriber<Float32Stamped>(pub_closest_merged_velocity_));
+  smoother_->setDebugTrajectoriesEnabled(publish_smoother_debug_trajs);
+
   std::vector<TrajectoryPoints> debug_trajectories;
   if (!smoother_->apply(
         initial_motion.vel, initial_motion.acc, clipped, traj_smoothed, debug_trajectories)) {
@@ -593,22 +700,24 @@ bool MotionVelocitySmootherNode::smoothVelocity(
 
   RCLCPP_DEBUG(get_logger(), "smoothVelocity : traj_smoothed.size() = %lu", traj_smoothed.size());
   if (publish_debug_trajs_) {
-    {
+    if (hasSubscriber<Trajectory>(pub_trajectory_latacc_filtered_)) {
       auto tmp = traj_lateral_acc_filtered;
       if (is_reverse_) flipVelocity(tmp);
       pub_trajectory_latacc_filtered_->publish(toTrajectoryMsg(tmp));
     }
-    {
+    if (hasSubscriber<Trajectory>(pub_trajectory_resampled_)) {
       auto tmp = traj_resampled;
       if (is_reverse_) flipVelocity(tmp);
       pub_trajectory_resampled_->publish(toTrajectoryMsg(tmp));
     }
-    {
+    if (hasSubscriber<Trajectory>(pub_trajectory_steering_rate_limited_)) {
       auto tmp = traj_steering_rate_limited;
       if (is_reverse_) flipVelocity(tmp);
       pub_trajectory_steering_rate_limited_->publish(toTrajectoryMsg(tmp));
     }
+  }
 
+  if (publish_smoother_debug_trajs) {
     if (!debug_trajectories.empty()) {
       for (auto & debug_trajectory : debug_trajectories) {
         debug_trajectory.insert(
@@ -15,6 +15,7 @@
 #include "motion_velocity_smoother/resample.hpp"
 
 #include "motion_utils/resample/resample.hpp"
+#include "motion_utils/trajectory/indexed_trajectory.hpp"
 #include "motion_utils/trajectory/tmp_conversion.hpp"
 
 #include <algorithm>
@@ -29,18 +30,20 @@ TrajectoryPoints resampleTrajectory(
   const geometry_msgs::msg::Pose & current_pose, const double nearest_dist_threshold,
   const double nearest_yaw_threshold, const ResampleParam & param, const bool use_zoh_for_v)
 {
+  const motion_utils::IndexedTrajectory indexed_input(input);
+
   // Arc length from the initial point to the closest point
   const size_t current_seg_idx = motion_utils::findFirstNearestSegmentIndexWithSoftConstraints(
     input, current_pose, nearest_dist_threshold, nearest_yaw_threshold);
-  const double negative_front_arclength_value = motion_utils::calcSignedArcLength(
-    input, current_pose.position, current_seg_idx, input.at(0).pose.position, 0);
+  const double negative_front_arclength_value = indexed_input.calcSignedArcLength(
+    current_pose.position, current_seg_idx, input.at(0).pose.position, 0);
   const auto front_arclength_value = std::fabs(negative_front_arclength_value);
 
   const auto dist_to_closest_stop_point =
-    motion_utils::calcDistanceToForwardStopPoint(input, current_pose);
+    indexed_input.calcDistanceToForwardStopPoint(current_pose);
 
   // Get the resample size from the closest point
-  const double trajectory_length = motion_utils::calcArcLength(input);
+  const double trajectory_length = indexed_input.calcArcLength();
   const double Nt = param.resample_time / std::max(param.dense_resample_dt, 0.001);
   const double ds_nominal =
     std::max(v_current * param.dense_resample_dt, param.dense_min_interval_distance);
@@ -147,10 +150,12 @@ TrajectoryPoints resampleTrajectory(
   const double nearest_dist_threshold, const double nearest_yaw_threshold,
   const ResampleParam & param, const double nominal_ds, const bool use_zoh_for_v)
 {
+  const motion_utils::IndexedTrajectory indexed_input(input);
+
   // input arclength
-  const double trajectory_length = motion_utils::calcArcLength(input);
+  const double trajectory_length = indexed_input.calcArcLength();
   const auto dist_to_closest_stop_point =
-    motion_utils::calcDistanceToForwardStopPoint(input, current_pose);
+    indexed_input.calcDistanceToForwardStopPoint(current_pose);
 
   // distance to stop point
   double stop_arclength_value = param.max_trajectory_length;
@@ -170,9 +175,8 @@ TrajectoryPoints resampleTrajectory(
   // Arc length from the initial point to the closest point
   const size_t current_seg_idx = motion_utils::findFirstNearestSegmentIndexWithSoftConstraints(
     input, current_pose, nearest_dist_threshold, nearest_yaw_threshold);
-  const double negative_front_arclength_value = motion_utils::calcSignedArcLength(
-    input, current_pose.position, current_seg_idx, input.at(0).pose.position,
-    static_cast<size_t>(0));
+  const double negative_front_arclength_value = indexed_input.calcSignedArcLength(
+    current_pose.position, current_seg_idx, input.at(0).pose.position, static_cast<size_t>(0));
   const auto front_arclength_value = std::fabs(negative_front_arclength_value);
   for (double s = 0.0; s <= front_arclength_value; s += nominal_ds) {
     out_arclength.push_back(s);
@@ -15,6 +15,7 @@
 #include "motion_velocity_smoother/smoother/jerk_filtered_smoother.hpp"
 
 #include "eigen3/Eigen/Core"
+#include "eigen3/Eigen/SparseCore"
 #include "motion_velocity_smoother/trajectory_utils.hpp"
 
 #include <algorithm>
@@ -28,6 +29,29 @@
 
 namespace motion_velocity_smoother
 {
+namespace
+{
+// shift each block of the variables forward by shift_idx, and resize it holding the last value
+std::vector<double> shiftBlockVariables(
+  const std::vector<double> & prev_variables, const std::vector<size_t> & prev_block_sizes,
+  const std::vector<size_t> & block_sizes, const size_t shift_idx)
+{
+  std::vector<double> variables;
+  variables.reserve(std::accumulate(block_sizes.begin(), block_sizes.end(), size_t{0}));
+
+  size_t prev_block_start_idx = 0;
+  for (size_t block_idx = 0; block_idx < block_sizes.size(); ++block_idx) {
+    const size_t prev_block_size = prev_block_sizes.at(block_idx);
+    for (size_t i = 0; i < block_sizes.at(block_idx); ++i) {
+      const size_t prev_idx = std::min(i + shift_idx, prev_block_size - 1);
+      variables.push_back(prev_variables.at(prev_block_start_idx + prev_idx));
+    }
+    prev_block_start_idx += prev_block_size;
+  }
+  return variables;
+}
+}  // namespace
+
 JerkFilteredSmoother::JerkFilteredSmoother(rclcpp::Node & node) : SmootherBase(node)
 {
   auto & p = smoother_param_;
@@ -66,10 +90,10 @@ bool JerkFilteredSmoother::apply(
     // No need to do optimization
     output.front().longitudinal_velocity_mps = v0;
     output.front().acceleration_mps2 = a0;
-    debug_trajectories.resize(3);
-    debug_trajectories[0] = output;
-    debug_trajectories[1] = output;
-    debug_trajectories[2] = output;
+    debug_trajectories.clear();
+    if (enable_debug_trajectories_) {
+      debug_trajectories.assign(3, output);
+    }
     return true;
   }
 
@@ -106,10 +130,13 @@ bool JerkFilteredSmoother::apply(
   auto opt_resampled_trajectory = resample(filtered);
 
   // Set debug trajectories
-  debug_trajectories.resize(3);
-  debug_trajectories[0] = resample(forward_filtered);
-  debug_trajectories[1] = resample(backward_filtered);
-  debug_trajectories[2] = resample(filtered);
+  debug_trajectories.clear();
+  if (enable_debug_trajectories_) {
+    debug_trajectories.resize(3);
+    debug_trajectories[0] = resample(forward_filtered);
+    debug_trajectories[1] = resample(backward_filtered);
+    debug_trajectories[2] = opt_resampled_trajectory;
+  }
 
   // Ensure terminal velocity is zero
   opt_resampled_trajectory.back().longitudinal_velocity_mps = 0.0;
@@ -119,9 +146,9 @@ bool JerkFilteredSmoother::apply(
     // No need to do optimization
     output.front().longitudinal_velocity_mps = v0;
     output.front().acceleration_mps2 = a0;
-    debug_trajectories[0] = output;
-    debug_trajectories[1] = output;
-    debug_trajectories[2] = output;
+    if (enable_debug_trajectories_) {
+      debug_trajectories.assign(3, output);
+    }
     return true;
   }
 
@@ -172,12 +199,17 @@ bool JerkFilteredSmoother::apply(
   const uint32_t l_constraints = 4 * N + 1;
 
   // the matrix size depends on constraint numbers.
-  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(l_constraints, l_variables);
+  // NOTE: P and A are assembled from triplets whose positions depend only on N, so that the
+  //       sparsity pattern is kept and the QP workspace can be updated in place.
+  std::vector<Eigen::Triplet<double>> A_triplets;
+  A_triplets.reserve(2 * N + 2 * N + 3 * (N - 1) + 3 * (N - 1) + 2);
 
   std::vector<double> lower_bound(l_constraints, 0.0);
   std::vector<double> upper_bound(l_constraints, 0.0);
 
-  Eigen::MatrixXd P = Eigen::MatrixXd::Zero(l_variables, l_variables);
+  // NOTE: only the upper triangular part of P is set.
+  std::vector<Eigen::Triplet<double>> P_triplets;
+  P_triplets.reserve(3 * (N - 1) + 3 * N);
   std::vector<double> q(l_variables, 0.0);
 
   /**************************************************************/
@@ -192,10 +224,10 @@ bool JerkFilteredSmoother::apply(
     const double ref_vel = 0.5 * (v_max_arr.at(i) + v_max_arr.at(i + 1));
     const double interval_dist = std::max(interval_dist_arr.at(i), 0.0001);
     const double w_x_ds_inv = (1.0 / interval_dist) * ref_vel;
-    P(IDX_A0 + i, IDX_A0 + i) += smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
-    P(IDX_A0 + i, IDX_A0 + i + 1) -= smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
-    P(IDX_A0 + i + 1, IDX_A0 + i) -= smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
-    P(IDX_A0 + i + 1, IDX_A0 + i + 1) += smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
+    const double jerk_weight = smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
+    P_triplets.emplace_back(IDX_A0 + i, IDX_A0 + i, jerk_weight);
+    P_triplets.emplace_back(IDX_A0 + i, IDX_A0 + i + 1, -jerk_weight);
+    P_triplets.emplace_back(IDX_A0 + i + 1, IDX_A0 + i + 1, jerk_weight);
   }
 
   // |v_max_i^2 - b_i|/v_max^2 -> minimize (-bi) * ds / v_max^2
@@ -208,9 +240,9 @@ bool JerkFilteredSmoother::apply(
       }
       q.at(IDX_B0 + i) += v_weight_term;
     }
-    P(IDX_DELTA0 + i, IDX_DELTA0 + i) += over_v_weight;  // over velocity cost
-    P(IDX_SIGMA0 + i, IDX_SIGMA0 + i) += over_a_weight;  // over acceleration cost
-    P(IDX_GAMMA0 + i, IDX_GAMMA0 + i) += over_j_weight;  // over jerk cost
+    P_triplets.emplace_back(IDX_DELTA0 + i, IDX_DELTA0 + i, over_v_weight);  // over velocity cost
+    P_triplets.emplace_back(IDX_SIGMA0 + i, IDX_SIGMA0 + i, over_a_weight);  // over accel cost
+    P_triplets.emplace_back(IDX_GAMMA0 + i, IDX_GAMMA0 + i, over_j_weight);  // over jerk cost
   }
 
   /**************************************************************/
@@ -231,16 +263,16 @@ bool JerkFilteredSmoother::apply(
 
   // Soft Constraint Velocity Limit: 0 < b - delta < v_max^2
   for (size_t i = 0; i < N; ++i, ++constr_idx) {
-    A(constr_idx, IDX_B0 + i) = 1.0;       // b_i
-    A(constr_idx, IDX_DELTA0 + i) = -1.0;  // -delta_i
+    A_triplets.emplace_back(constr_idx, IDX_B0 + i, 1.0);       // b_i
+    A_triplets.emplace_back(constr_idx, IDX_DELTA0 + i, -1.0);  // -delta_i
     upper_bound[constr_idx] = v_max_arr.at(i) * v_max_arr.at(i);
     lower_bound[constr_idx] = 0.0;
   }
 
   // Soft Constraint Acceleration Limit: a_min < a - sigma < a_max
   for (size_t i = 0; i < N; ++i, ++constr_idx) {
-    A(constr_idx, IDX_A0 + i) = 1.0;       // a_i
-    A(constr_idx, IDX_SIGMA0 + i) = -1.0;  // -sigma_i
+    A_triplets.emplace_back(constr_idx, IDX_A0 + i, 1.0);       // a_i
+    A_triplets.emplace_back(constr_idx, IDX_SIGMA0 + i, -1.0);  // -sigma_i
 
     constexpr double stop_vel = 1e-3;
     if (v_max_arr.at(i) < stop_vel) {
@@ -258,39 +290,93 @@ bool JerkFilteredSmoother::apply(
   for (size_t i = 0; i < N - 1; ++i, ++constr_idx) {
     const double ref_vel = 0.5 * (v_max_arr.at(i) + v_max_arr.at(i + 1));
     const double ds = interval_dist_arr.at(i);
-    A(constr_idx, IDX_A0 + i) = -ref_vel;     // -a[i] * ref_vel
-    A(constr_idx, IDX_A0 + i + 1) = ref_vel;  //  a[i+1] * ref_vel
-    A(constr_idx, IDX_GAMMA0 + i) = -ds;      // -gamma[i] * ds
-    upper_bound[constr_idx] = j_max * ds;     //  jerk_max * ds
-    lower_bound[constr_idx] = j_min * ds;     //  jerk_min * ds
+    A_triplets.emplace_back(constr_idx, IDX_A0 + i, -ref_vel);     // -a[i] * ref_vel
+    A_triplets.emplace_back(constr_idx, IDX_A0 + i + 1, ref_vel);  //  a[i+1] * ref_vel
+    A_triplets.emplace_back(constr_idx, IDX_GAMMA0 + i, -ds);      // -gamma[i] * ds
+    upper_bound[constr_idx] = j_max * ds;                          //  jerk_max * ds
+    lower_bound[constr_idx] = j_min * ds;                          //  jerk_min * ds
   }
 
   // b' = 2a ... (b(i+1) - b(i)) / ds = 2a(i)
   for (size_t i = 0; i < N - 1; ++i, ++constr_idx) {
-    A(constr_idx, IDX_B0 + i) = -1.0;                            // b(i)
-    A(constr_idx, IDX_B0 + i + 1) = 1.0;                         // b(i+1)
-    A(constr_idx, IDX_A0 + i) = -2.0 * interval_dist_arr.at(i);  // a(i) * ds
+    A_triplets.emplace_back(constr_idx, IDX_B0 + i, -1.0);                            // b(i)
+    A_triplets.emplace_back(constr_idx, IDX_B0 + i + 1, 1.0);                         // b(i+1)
+    A_triplets.emplace_back(constr_idx, IDX_A0 + i, -2.0 * interval_dist_arr.at(i));  // a(i) * ds
     upper_bound[constr_idx] = 0.0;
     lower_bound[constr_idx] = 0.0;
   }
 
   // initial condition
   {
-    A(constr_idx, IDX_B0) = 1.0;  // b0
+    A_triplets.emplace_back(constr_idx, IDX_B0, 1.0);  // b0
     upper_bound[constr_idx] = v0 * v0;
     lower_bound[constr_idx] = v0 * v0;
     ++constr_idx;
 
-    A(constr_idx, IDX_A0) = 1.0;  // a0
+    A_triplets.emplace_back(constr_idx, IDX_A0, 1.0);  // a0
     upper_bound[constr_idx] = a0;
     lower_bound[constr_idx] = a0;
     ++constr_idx;
   }
 
+  Eigen::SparseMatrix<double> P(l_variables, l_variables);
+  P.setFromTriplets(P_triplets.begin(), P_triplets.end());
+  Eigen::SparseMatrix<double> A(l_constraints, l_variables);
+  A.setFromTriplets(A_triplets.begin(), A_triplets.end());
+  const auto P_csc = autoware::common::osqp::calCSCMatrix(P);
+  const auto A_csc = autoware::common::osqp::calCSCMatrix(A);
+
+  // keep the QP workspace while the problem size is same, and update only the values
+  if (prev_num_points_ == N) {
+    qp_solver_.updateCscP(P_csc);
+    qp_solver_.updateQ(q);
+    qp_solver_.updateCscA(A_csc);
+    qp_solver_.updateBounds(lower_bound, upper_bound);
+  } else {
+    const auto exit_flag = qp_solver_.initializeProblem(P_csc, A_csc, q, lower_bound, upper_bound);
+    if (exit_flag != 0) {
+      RCLCPP_WARN(logger_, "failed to initialize the QP workspace.");
+      prev_num_points_ = 0;
+      return false;
+    }
+  }
+
+  // warm start with the previous solution shifted by the ego's progress
+  if (!prev_primal_variables_.empty()) {
+    const size_t prev_N = prev_num_points_ == N ? N : prev_primal_variables_.size() / 5;
+    const size_t shift_idx = motion_utils::findNearestIndex(
+      prev_opt_resampled_trajectory_, initial_traj_pose.position);
+    const auto primal_variables = shiftBlockVariables(
+      prev_primal_variables_, {prev_N, prev_N, prev_N, prev_N, prev_N}, {N, N, N, N, N},
+      shift_idx);
+    // NOTE: the last three constraints (initial conditions and an empty row) are not shifted.
+    auto dual_variables = shiftBlockVariables(
+      prev_dual_variables_, {prev_N, prev_N, prev_N - 1, prev_N - 1}, {N, N, N - 1, N - 1},
+      shift_idx);
+    dual_variables.insert(
+      dual_variables.end(), prev_dual_variables_.end() - 3, prev_dual_variables_.end());
+    qp_solver_.setWarmStart(primal_variables, dual_variables);
+  }
+
   // execute optimization
-  const auto result = qp_solver_.optimize(P, A, q, lower_bound, upper_bound);
+  const auto result = qp_solver_.optimize();
   const std::vector<double> optval = std::get<0>(result);
 
+  const int status_val = std::get<3>(result);
+  if (status_val != 1) {
+    // do not warm start from a failed solution, neither the stored one nor the one in the workspace
+    prev_num_points_ = 0;
+    prev_primal_variables_.clear();
+    prev_dual_variables_.clear();
+    prev_opt_resampled_trajectory_.clear();
+  } else {
+    prev_num_points_ = N;
+    prev_primal_variables_ = optval;
+    prev_dual_variables_ = std::get<1>(result);
+    prev_opt_resampled_trajectory_ =
+      TrajectoryPoints{opt_resampled_trajectory.begin(), opt_resampled_trajectory.begin() + N};
+  }
+
   const auto tf1 = std::chrono::system_clock::now();
   const double dt_ms1 =
     std::chrono::duration_cast<std::chrono::nanoseconds>(tf1 - ts).count() * 1.0e-6;
@@ -62,6 +62,11 @@ void SmootherBase::setParam(const BaseParam & param) { base_param_ = param; }
 
 SmootherBase::BaseParam SmootherBase::getBaseParam() const { return base_param_; }
 
+void SmootherBase::setDebugTrajectoriesEnabled(const bool enable)
+{
+  enable_debug_trajectories_ = enable;
+}
+
 double SmootherBase::getMaxAccel() const { return base_param_.max_accel; }
 
 double SmootherBase::getMinDecel() const { return base_param_.min_decel; }
@@ -37,6 +37,11 @@ public:
 
   std::optional<std::vector<autoware_auto_planning_msgs::msg::TrajectoryPoint>> getEBTrajectory(
     const PlannerData & planner_data);
+  // smooth only the trajectory after start_pose, keeping the previous one before start_pose
+  std::optional<std::vector<autoware_auto_planning_msgs::msg::TrajectoryPoint>>
+  getPartialEBTrajectory(
+    const PlannerData & planner_data, const geometry_msgs::msg::Pose & start_pose,
+    const double fixed_length);
 
   void initialize(const bool enable_debug_info, const TrajectoryParam & traj_param);
   void resetPreviousData();
@@ -110,6 +115,10 @@ private:
   std::unique_ptr<autoware::common::osqp::OSQPInterface> osqp_solver_ptr_;
   std::shared_ptr<std::vector<TrajectoryPoint>> prev_eb_traj_points_ptr_{nullptr};
 
+  std::optional<std::vector<TrajectoryPoint>> smoothTrajectory(
+    const PlannerData & planner_data, const geometry_msgs::msg::Pose & start_pose,
+    const double forward_traj_length, const double backward_traj_length);
+
   std::vector<TrajectoryPoint> insertFixedPoint(
     const std::vector<TrajectoryPoint> & traj_point) const;
 
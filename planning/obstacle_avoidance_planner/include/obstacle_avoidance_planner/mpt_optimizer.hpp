@@ -110,6 +110,10 @@ public:
 
   std::optional<std::vector<TrajectoryPoint>> getModelPredictiveTrajectory(
     const PlannerData & planner_data, const std::vector<TrajectoryPoint> & smoothed_points);
+  // optimize only the trajectory after start_pose, keeping the previous one before start_pose
+  std::optional<std::vector<TrajectoryPoint>> getPartialModelPredictiveTrajectory(
+    const PlannerData & planner_data, const std::vector<TrajectoryPoint> & smoothed_points,
+    const geometry_msgs::msg::Pose & start_pose, const double fixed_length);
 
   void initialize(const bool enable_debug_info, const TrajectoryParam & traj_param);
   void resetPreviousData();
@@ -127,13 +131,13 @@ private:
 
   struct ObjectiveMatrix
   {
-    Eigen::MatrixXd hessian;
+    Eigen::SparseMatrix<double> hessian;  // upper triangular part
     Eigen::VectorXd gradient;
   };
 
   struct ConstraintMatrix
   {
-    Eigen::MatrixXd linear;
+    Eigen::SparseMatrix<double> linear;
     Eigen::VectorXd lower_bound;
     Eigen::VectorXd upper_bound;
   };
@@ -232,12 +236,22 @@ private:
   // previous data
   int prev_mat_n_ = 0;
   int prev_mat_m_ = 0;
+  autoware::common::osqp::CSC_Matrix prev_P_csc_;
+  autoware::common::osqp::CSC_Matrix prev_A_csc_;
   std::shared_ptr<std::vector<ReferencePoint>> prev_ref_points_ptr_{nullptr};
 
   void updateVehicleCircles();
 
+  std::optional<std::pair<std::vector<ReferencePoint>, std::vector<TrajectoryPoint>>>
+  calcModelPredictiveTrajectory(
+    const PlannerData & planner_data, const std::vector<TrajectoryPoint> & smoothed_points,
+    const geometry_msgs::msg::Pose & start_pose, const int num_points,
+    const double backward_traj_length);
+
   std::vector<ReferencePoint> calcReferencePoints(
-    const PlannerData & planner_data, const std::vector<TrajectoryPoint> & smoothed_points) const;
+    const PlannerData & planner_data, const std::vector<TrajectoryPoint> & smoothed_points,
+    const geometry_msgs::msg::Pose & start_pose, const int num_points,
+    const double backward_traj_length) const;
   void updateCurvature(
     std::vector<ReferencePoint> & ref_points,
     const SplineInterpolationPoints2d & ref_points_spline) const;
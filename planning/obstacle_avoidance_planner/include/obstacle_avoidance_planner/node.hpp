@@ -120,6 +120,8 @@ protected:  // for the static_centerline_optimizer package
 
   // functions in generateOptimizedTrajectory
   std::vector<TrajectoryPoint> optimizeTrajectory(const PlannerData & planner_data);
+  std::vector<TrajectoryPoint> optimizeTrajectoryPartially(
+    const PlannerData & planner_data, const double fixed_length);
   std::vector<TrajectoryPoint> getPrevOptimizedTrajectory(
     const std::vector<TrajectoryPoint> & traj_points) const;
   void applyInputVelocity(
@@ -22,6 +22,7 @@
 #include <rclcpp/rclcpp.hpp>
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace obstacle_avoidance_planner
@@ -34,7 +35,11 @@ public:
 
   bool isResetRequired(const PlannerData & planner_data);
 
-  bool isReplanRequired(const rclcpp::Time & current_time);
+  bool isReplanRequired(const PlannerData & planner_data, const rclcpp::Time & current_time);
+
+  // return the length from ego of the previous trajectory to keep when only the far part of the
+  // path or drivable area changed after the previous replan
+  std::optional<double> calcPartialReplanFixedLength(const PlannerData & planner_data);
 
 private:
   EgoNearestParam ego_nearest_param_;
@@ -47,16 +52,25 @@ private:
   // previous variable for isReplanRequired
   std::shared_ptr<rclcpp::Time> prev_replanned_time_ptr_{nullptr};
 
+  // previous variable for calcPartialReplanFixedLength
+  std::shared_ptr<PlannerData> prev_replanned_planner_data_ptr_{nullptr};
+
   // algorithm parameters
   double max_path_shape_around_ego_lat_dist_;
   double max_ego_moving_dist_;
   double max_goal_moving_dist_;
   double max_delta_time_sec_;
+  bool enable_partial_replan_;
+  double partial_replan_max_lat_dist_;
+  double partial_replan_margin_length_;
+  double partial_replan_min_fixed_length_;
 
   bool isPathAroundEgoChanged(
     const PlannerData & planner_data, const std::vector<TrajectoryPoint> & prev_traj_points) const;
   bool isPathGoalChanged(
     const PlannerData & planner_data, const std::vector<TrajectoryPoint> & prev_traj_points) const;
+  std::optional<double> calcChangedLength(
+    const PlannerData & planner_data, const PlannerData & prev_planner_data) const;
 };
 }  // namespace obstacle_avoidance_planner
 
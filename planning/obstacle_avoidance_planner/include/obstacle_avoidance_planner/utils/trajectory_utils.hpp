@@ -276,6 +276,26 @@ std::optional<size_t> updateFrontPointForFix(
   return front_point_idx_for_fix;
 }
 
+// keep the previous points behind the front of points, and append points to them
+template <typename T>
+std::vector<T> concatenateToPrevPoints(
+  const std::vector<T> & prev_points, const std::vector<T> & points,
+  const EgoNearestParam & ego_nearest_param)
+{
+  const size_t front_seg_idx = trajectory_utils::findEgoSegmentIndex(
+    prev_points, tier4_autoware_utils::getPose(points.front()), ego_nearest_param);
+
+  // NOTE: The previous point on the front of points is removed to avoid overlap.
+  constexpr double epsilon = 1e-3;
+  const bool is_front_overlapped =
+    tier4_autoware_utils::calcDistance2d(prev_points.at(front_seg_idx), points.front()) < epsilon;
+  const size_t prev_end_idx = is_front_overlapped ? front_seg_idx : front_seg_idx + 1;
+
+  std::vector<T> concatenated_points{prev_points.begin(), prev_points.begin() + prev_end_idx};
+  concatenated_points.insert(concatenated_points.end(), points.begin(), points.end());
+  return concatenated_points;
+}
+
 void insertStopPoint(
   std::vector<TrajectoryPoint> & traj_points, const geometry_msgs::msg::Pose & input_stop_pose,
   const size_t stop_seg_idx);
@@ -177,14 +177,76 @@ EBPathSmoother::getEBTrajectory(const PlannerData & planner_data)
 
   const auto & p = planner_data;
 
-  // 1. crop trajectory
   const double forward_traj_length = eb_param_.num_points * eb_param_.delta_arc_length;
   const double backward_traj_length = traj_param_.output_backward_traj_length;
 
-  const size_t ego_seg_idx =
-    trajectory_utils::findEgoSegmentIndex(p.traj_points, p.ego_pose, ego_nearest_param_);
+  const auto eb_traj_points =
+    smoothTrajectory(p, p.ego_pose, forward_traj_length, backward_traj_length);
+  if (!eb_traj_points) {
+    return std::nullopt;
+  }
+
+  prev_eb_traj_points_ptr_ = std::make_shared<std::vector<TrajectoryPoint>>(*eb_traj_points);
+
+  // publish eb trajectory
+  const auto eb_traj = trajectory_utils::createTrajectory(p.header, *eb_traj_points);
+  debug_eb_traj_pub_->publish(eb_traj);
+
+  time_keeper_ptr_->toc(__func__, "      ");
+  return *eb_traj_points;
+}
+
+std::optional<std::vector<autoware_auto_planning_msgs::msg::TrajectoryPoint>>
+EBPathSmoother::getPartialEBTrajectory(
+  const PlannerData & planner_data, const geometry_msgs::msg::Pose & start_pose,
+  const double fixed_length)
+{
+  time_keeper_ptr_->tic(__func__);
+
+  const auto & p = planner_data;
+
+  if (!prev_eb_traj_points_ptr_) {
+    return std::nullopt;
+  }
+
+  // NOTE: The trajectory before start_pose is kept as it is. Only the remained horizon is smoothed.
+  const double forward_traj_length =
+    eb_param_.num_points * eb_param_.delta_arc_length - fixed_length;
+  if (forward_traj_length < eb_param_.delta_arc_length) {
+    return std::nullopt;
+  }
+
+  const auto partial_eb_traj_points = smoothTrajectory(p, start_pose, forward_traj_length, 0.0);
+  if (!partial_eb_traj_points) {
+    return std::nullopt;
+  }
+
+  const auto eb_traj_points = trajectory_utils::concatenateToPrevPoints(
+    *prev_eb_traj_points_ptr_, *partial_eb_traj_points, ego_nearest_param_);
+  prev_eb_traj_points_ptr_ = std::make_shared<std::vector<TrajectoryPoint>>(eb_traj_points);
+
+  // publish eb trajectory
+  const auto eb_traj = trajectory_utils::createTrajectory(p.header, eb_traj_points);
+  debug_eb_traj_pub_->publish(eb_traj);
+
+  time_keeper_ptr_->toc(__func__, "      ");
+  return *partial_eb_traj_points;
+}
+
+std::optional<std::vector<TrajectoryPoint>> EBPathSmoother::smoothTrajectory(
+  const PlannerData & planner_data, const geometry_msgs::msg::Pose & start_pose,
+  const double forward_traj_length, const double backward_traj_length)
+{
+  time_keeper_ptr_->tic(__func__);
+
+  const auto & p = planner_data;
+
+  // 1. crop trajectory
+  const size_t start_seg_idx =
+    trajectory_utils::findEgoSegmentIndex(p.traj_points, start_pose, ego_nearest_param_);
   const auto cropped_traj_points = trajectory_utils::cropPoints(
-    p.traj_points, p.ego_pose.position, ego_seg_idx, forward_traj_length, -backward_traj_length);
+    p.traj_points, start_pose.position, start_seg_idx, forward_traj_length,
+    -backward_traj_length);
 
   // check if goal is contained in cropped_traj_points
   const bool is_goal_contained =
@@ -230,14 +292,8 @@ EBPathSmoother::getEBTrajectory(const PlannerData & planner_data)
     return std::nullopt;
   }
 
-  prev_eb_traj_points_ptr_ = std::make_shared<std::vector<TrajectoryPoint>>(*eb_traj_points);
-
-  // 8. publish eb trajectory
-  const auto eb_traj = trajectory_utils::createTrajectory(p.header, *eb_traj_points);
-  debug_eb_traj_pub_->publish(eb_traj);
-
-  time_keeper_ptr_->toc(__func__, "      ");
-  return *eb_traj_points;
+  time_keeper_ptr_->toc(__func__, "        ");
+  return eb_traj_points;
 }
 
 std::vector<TrajectoryPoint> EBPathSmoother::insertFixedPoint(
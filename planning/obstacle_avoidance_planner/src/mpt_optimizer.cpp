@@ -26,6 +26,7 @@
 #include <limits>
 #include <optional>
 #include <tuple>
+#include <utility>
 
 namespace obstacle_avoidance_planner
 {
@@ -179,6 +180,14 @@ double calcLateralDistToBounds(
 
   return closest_dist_to_bound;
 }
+
+bool isSameSparsityPattern(
+  const autoware::common::osqp::CSC_Matrix & csc_mat,
+  const autoware::common::osqp::CSC_Matrix & prev_csc_mat)
+{
+  return csc_mat.m_col_idxs == prev_csc_mat.m_col_idxs &&
+         csc_mat.m_row_idxs == prev_csc_mat.m_row_idxs;
+}
 }  // namespace
 
 MPTOptimizer::MPTParam::MPTParam(
@@ -473,11 +482,79 @@ std::optional<std::vector<TrajectoryPoint>> MPTOptimizer::getModelPredictiveTraj
 {
   time_keeper_ptr_->tic(__func__);
 
+  const auto & p = planner_data;
+
+  const auto mpt_result = calcModelPredictiveTrajectory(
+    planner_data, smoothed_points, p.ego_pose, mpt_param_.num_points,
+    traj_param_.output_backward_traj_length);
+  if (!mpt_result) {
+    return std::nullopt;
+  }
+  const auto & [ref_points, mpt_traj_points] = *mpt_result;
+
+  // publish trajectories for debug
+  publishDebugTrajectories(p.header, ref_points, mpt_traj_points);
+
+  time_keeper_ptr_->toc(__func__, "      ");
+
+  debug_data_ptr_->ref_points = ref_points;
+  prev_ref_points_ptr_ = std::make_shared<std::vector<ReferencePoint>>(ref_points);
+
+  return mpt_traj_points;
+}
+
+std::optional<std::vector<TrajectoryPoint>> MPTOptimizer::getPartialModelPredictiveTrajectory(
+  const PlannerData & planner_data, const std::vector<TrajectoryPoint> & smoothed_points,
+  const geometry_msgs::msg::Pose & start_pose, const double fixed_length)
+{
+  time_keeper_ptr_->tic(__func__);
+
+  const auto & p = planner_data;
+
+  if (!prev_ref_points_ptr_) {
+    return std::nullopt;
+  }
+
+  // NOTE: The trajectory before start_pose is kept as it is. Only the remained horizon is optimized
+  //       with the kinematic state on start_pose fixed to the previous one.
+  const int fixed_num_points = static_cast<int>(fixed_length / mpt_param_.delta_arc_length);
+  const int num_points = mpt_param_.num_points - fixed_num_points;
+  if (num_points < 2) {
+    return std::nullopt;
+  }
+
+  const auto mpt_result =
+    calcModelPredictiveTrajectory(planner_data, smoothed_points, start_pose, num_points, 0.0);
+  if (!mpt_result) {
+    return std::nullopt;
+  }
+  const auto & [partial_ref_points, mpt_traj_points] = *mpt_result;
+
+  // publish trajectories for debug
+  publishDebugTrajectories(p.header, partial_ref_points, mpt_traj_points);
+
+  time_keeper_ptr_->toc(__func__, "      ");
+
+  const auto ref_points = trajectory_utils::concatenateToPrevPoints(
+    *prev_ref_points_ptr_, partial_ref_points, ego_nearest_param_);
+  debug_data_ptr_->ref_points = ref_points;
+  prev_ref_points_ptr_ = std::make_shared<std::vector<ReferencePoint>>(ref_points);
+
+  return mpt_traj_points;
+}
+
+std::optional<std::pair<std::vector<ReferencePoint>, std::vector<TrajectoryPoint>>>
+MPTOptimizer::calcModelPredictiveTrajectory(
+  const PlannerData & planner_data, const std::vector<TrajectoryPoint> & smoothed_points,
+  const geometry_msgs::msg::Pose & start_pose, const int num_points,
+  const double backward_traj_length)
+{
   const auto & p = planner_data;
   const auto & traj_points = p.traj_points;
 
   // 1. calculate reference points
-  auto ref_points = calcReferencePoints(planner_data, smoothed_points);
+  auto ref_points = calcReferencePoints(
+    planner_data, smoothed_points, start_pose, num_points, backward_traj_length);
   if (ref_points.size() < 2) {
     RCLCPP_INFO_EXPRESSION(
       logger_, enable_debug_info_, "return std::nullopt since ref_points size is less than 2.");
@@ -511,26 +588,17 @@ std::optional<std::vector<TrajectoryPoint>> MPTOptimizer::getModelPredictiveTraj
     return std::nullopt;
   }
 
-  // 8. publish trajectories for debug
-  publishDebugTrajectories(p.header, ref_points, *mpt_traj_points);
-
-  time_keeper_ptr_->toc(__func__, "      ");
-
-  debug_data_ptr_->ref_points = ref_points;
-  prev_ref_points_ptr_ = std::make_shared<std::vector<ReferencePoint>>(ref_points);
-
-  return *mpt_traj_points;
+  return std::make_pair(ref_points, *mpt_traj_points);
 }
 
 std::vector<ReferencePoint> MPTOptimizer::calcReferencePoints(
-  const PlannerData & planner_data, const std::vector<TrajectoryPoint> & smoothed_points) const
+  const PlannerData & planner_data, const std::vector<TrajectoryPoint> & smoothed_points,
+  const geometry_msgs::msg::Pose & start_pose, const int num_points,
+  const double backward_traj_length) const
 {
   time_keeper_ptr_->tic(__func__);
 
-  const auto & p = planner_data;
-
-  const double forward_traj_length = mpt_param_.num_points * mpt_param_.delta_arc_length;
-  const double backward_traj_length = traj_param_.output_backward_traj_length;
+  const double forward_traj_length = num_points * mpt_param_.delta_arc_length;
 
   // 1. resample and convert smoothed points type from trajectory points to reference points
   time_keeper_ptr_->tic("resampleReferencePoints");
@@ -546,13 +614,13 @@ std::vector<ReferencePoint> MPTOptimizer::calcReferencePoints(
   // NOTE: Margin is added to calculate orientation, curvature, etc precisely.
   //       Start point may change. Spline calculation is required.
   constexpr double tmp_margin = 10.0;
-  size_t ego_seg_idx =
-    trajectory_utils::findEgoSegmentIndex(ref_points, p.ego_pose, ego_nearest_param_);
+  size_t start_seg_idx =
+    trajectory_utils::findEgoSegmentIndex(ref_points, start_pose, ego_nearest_param_);
   ref_points = trajectory_utils::cropPoints(
-    ref_points, p.ego_pose.position, ego_seg_idx, forward_traj_length + tmp_margin,
+    ref_points, start_pose.position, start_seg_idx, forward_traj_length + tmp_margin,
     -backward_traj_length - tmp_margin);
   SplineInterpolationPoints2d ref_points_spline(ref_points);
-  ego_seg_idx = trajectory_utils::findEgoSegmentIndex(ref_points, p.ego_pose, ego_nearest_param_);
+  start_seg_idx = trajectory_utils::findEgoSegmentIndex(ref_points, start_pose, ego_nearest_param_);
 
   // 3. calculate orientation and curvature
   updateOrientation(ref_points, ref_points_spline);
@@ -561,10 +629,9 @@ std::vector<ReferencePoint> MPTOptimizer::calcReferencePoints(
   // 4. crop backward
   // NOTE: Start point may change. Spline calculation is required.
   ref_points = trajectory_utils::cropPoints(
-    ref_points, p.ego_pose.position, ego_seg_idx, forward_traj_length + tmp_margin,
+    ref_points, start_pose.position, start_seg_idx, forward_traj_length + tmp_margin,
     -backward_traj_length);
   ref_points_spline = SplineInterpolationPoints2d(ref_points);
-  ego_seg_idx = trajectory_utils::findEgoSegmentIndex(ref_points, p.ego_pose, ego_nearest_param_);
 
   // 5. update fixed points, and resample
   // NOTE: This must be after backward cropping.
@@ -574,7 +641,7 @@ std::vector<ReferencePoint> MPTOptimizer::calcReferencePoints(
 
   // 6. update bounds
   // NOTE: After this, resample must not be called since bounds are not interpolated.
-  updateBounds(ref_points, p.left_bound, p.right_bound);
+  updateBounds(ref_points, planner_data.left_bound, planner_data.right_bound);
   updateVehicleBounds(ref_points, ref_points_spline);
 
   // 7. update delta arc length
@@ -585,10 +652,8 @@ std::vector<ReferencePoint> MPTOptimizer::calcReferencePoints(
   updateExtraPoints(ref_points);
 
   // 9. crop forward
-  // ref_points = trajectory_utils::cropForwardPoints(
-  //   ref_points, p.ego_pose.position, ego_seg_idx, forward_traj_length);
-  if (static_cast<size_t>(mpt_param_.num_points) < ref_points.size()) {
-    ref_points.resize(mpt_param_.num_points);
+  if (static_cast<size_t>(num_points) < ref_points.size()) {
+    ref_points.resize(num_points);
   }
 
   time_keeper_ptr_->toc(__func__, "        ");
@@ -975,16 +1040,22 @@ MPTOptimizer::ObjectiveMatrix MPTOptimizer::calcObjectiveMatrix(
 
   const Eigen::MatrixXd B = sparse_T_mat * mpt_mat.B;
   const Eigen::MatrixXd QB = val_mat.Q * B;
-  const Eigen::MatrixXd R = val_mat.R;
+  const Eigen::MatrixXd H = B.transpose() * QB + val_mat.R;
 
   // calculate H, and extend it for slack variables
   // NOTE: min J(v) = min (v'Hv + v'g)
-  Eigen::MatrixXd H = Eigen::MatrixXd::Zero(D_v, D_v);
-  H.triangularView<Eigen::Upper>() = B.transpose() * QB + R;
-  H.triangularView<Eigen::Lower>() = H.transpose();
-
-  Eigen::MatrixXd extended_H = Eigen::MatrixXd::Zero(D_v + N_ref * N_slack, D_v + N_ref * N_slack);
-  extended_H.block(0, 0, D_v, D_v) = H;
+  //       Only the upper triangular part is stored. The whole triangle of the first D_v columns
+  //       is stored even if the value is zero so that the sparsity pattern does not depend on the
+  //       values. The columns of the slack variables are empty.
+  std::vector<Eigen::Triplet<double>> H_triplet_vec;
+  H_triplet_vec.reserve(D_v * (D_v + 1) / 2);
+  for (size_t j = 0; j < D_v; ++j) {
+    for (size_t i = 0; i <= j; ++i) {
+      H_triplet_vec.push_back(Eigen::Triplet<double>(i, j, H(i, j)));
+    }
+  }
+  Eigen::SparseMatrix<double> extended_H(D_v + N_ref * N_slack, D_v + N_ref * N_slack);
+  extended_H.setFromTriplets(H_triplet_vec.begin(), H_triplet_vec.end());
 
   // calculate g, and extend it for slack variables
   Eigen::VectorXd g = (sparse_T_mat * mpt_mat.W + T_vec).transpose() * QB;
@@ -1058,7 +1129,12 @@ MPTOptimizer::ConstraintMatrix MPTOptimizer::calcConstraintMatrix(
     return D_v;  // initial state + steer angles
   }();
 
-  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(A_rows, A_cols);
+  // NOTE: The i-th state depends only on the initial state and the first i steer angles. All the
+  //       elements in this range are stored even if the value is zero so that the sparsity
+  //       pattern of A does not depend on the values.
+  const auto calc_dependent_cols = [&](const size_t i) { return D_x + i * D_u; };
+
+  std::vector<Eigen::Triplet<double>> A_triplet_vec;
   Eigen::VectorXd lb = Eigen::VectorXd::Constant(A_rows, -autoware::common::osqp::INF);
   Eigen::VectorXd ub = Eigen::VectorXd::Constant(A_rows, autoware::common::osqp::INF);
   size_t A_rows_end = 0;
@@ -1092,37 +1168,32 @@ MPTOptimizer::ConstraintMatrix MPTOptimizer::calcConstraintMatrix(
 
     // soft constraints
     if (mpt_param_.soft_constraint) {
-      size_t A_offset_cols = D_v;
       const size_t A_blk_rows = 3 * N_ref;
 
       // A := [C * B | O | ... | O | I | O | ...
       //      -C * B | O | ... | O | I | O | ...
       //          O    | O | ... | O | I | O | ... ]
-      Eigen::MatrixXd A_blk = Eigen::MatrixXd::Zero(A_blk_rows, A_cols);
-      A_blk.block(0, 0, N_ref, D_v) = CB;
-      A_blk.block(N_ref, 0, N_ref, D_v) = -CB;
-
-      size_t local_A_offset_cols = A_offset_cols;
+      size_t local_A_offset_cols = D_v;
       if (!mpt_param_.l_inf_norm) {
         local_A_offset_cols += N_ref * l_idx;
       }
-      A_blk.block(0, local_A_offset_cols, N_ref, N_ref) = Eigen::MatrixXd::Identity(N_ref, N_ref);
-      A_blk.block(N_ref, local_A_offset_cols, N_ref, N_ref) =
-        Eigen::MatrixXd::Identity(N_ref, N_ref);
-      A_blk.block(2 * N_ref, local_A_offset_cols, N_ref, N_ref) =
-        Eigen::MatrixXd::Identity(N_ref, N_ref);
+      for (size_t i = 0; i < N_ref; ++i) {
+        for (size_t j = 0; j < calc_dependent_cols(i); ++j) {
+          A_triplet_vec.push_back(Eigen::Triplet<double>(A_rows_end + i, j, CB(i, j)));
+          A_triplet_vec.push_back(Eigen::Triplet<double>(A_rows_end + N_ref + i, j, -CB(i, j)));
+        }
+        for (size_t k = 0; k < 3; ++k) {
+          A_triplet_vec.push_back(
+            Eigen::Triplet<double>(A_rows_end + k * N_ref + i, local_A_offset_cols + i, 1.0));
+        }
+      }
 
       // lb := [lower_bound - CW
       //        CW - upper_bound
       //               O        ]
-      Eigen::VectorXd lb_blk = Eigen::VectorXd::Zero(A_blk_rows);
-      lb_blk.segment(0, N_ref) = -CW + part_lb;
-      lb_blk.segment(N_ref, N_ref) = CW - part_ub;
-
-      A_offset_cols += N_ref * N_slack;
-
-      A.block(A_rows_end, 0, A_blk_rows, A_cols) = A_blk;
-      lb.segment(A_rows_end, A_blk_rows) = lb_blk;
+      lb.segment(A_rows_end, N_ref) = -CW + part_lb;
+      lb.segment(A_rows_end + N_ref, N_ref) = CW - part_ub;
+      lb.segment(A_rows_end + 2 * N_ref, N_ref) = Eigen::VectorXd::Zero(N_ref);
 
       A_rows_end += A_blk_rows;
     }
@@ -1131,10 +1202,13 @@ MPTOptimizer::ConstraintMatrix MPTOptimizer::calcConstraintMatrix(
     if (mpt_param_.hard_constraint) {
       const size_t A_blk_rows = N_ref;
 
-      Eigen::MatrixXd A_blk = Eigen::MatrixXd::Zero(A_blk_rows, A_cols);
-      A_blk.block(0, 0, N_ref, N_ref) = CB;
+      // NOTE: only the first N_ref columns of CB are used.
+      for (size_t i = 0; i < N_ref; ++i) {
+        for (size_t j = 0; j < std::min(calc_dependent_cols(i), N_ref); ++j) {
+          A_triplet_vec.push_back(Eigen::Triplet<double>(A_rows_end + i, j, CB(i, j)));
+        }
+      }
 
-      A.block(A_rows_end, 0, A_blk_rows, A_cols) = A_blk;
       lb.segment(A_rows_end, A_blk_rows) = part_lb - CW;
       ub.segment(A_rows_end, A_blk_rows) = part_ub - CW;
 
@@ -1145,7 +1219,12 @@ MPTOptimizer::ConstraintMatrix MPTOptimizer::calcConstraintMatrix(
   // fixed points constraint
   // X = B v + w where point is fixed
   for (const size_t i : fixed_points_indices) {
-    A.block(A_rows_end, 0, D_x, D_v) = mpt_mat.B.block(i * D_x, 0, D_x, D_v);
+    for (size_t k = 0; k < D_x; ++k) {
+      for (size_t j = 0; j < calc_dependent_cols(i); ++j) {
+        A_triplet_vec.push_back(
+          Eigen::Triplet<double>(A_rows_end + k, j, mpt_mat.B(i * D_x + k, j)));
+      }
+    }
 
     lb.segment(A_rows_end, D_x) =
       ref_points[i].fixed_kinematic_state->toEigenVector() - mpt_mat.W.segment(i * D_x, D_x);
@@ -1157,7 +1236,9 @@ MPTOptimizer::ConstraintMatrix MPTOptimizer::calcConstraintMatrix(
 
   // steer limit
   if (mpt_param_.steer_limit_constraint) {
-    A.block(A_rows_end, D_x, N_u, N_u) = Eigen::MatrixXd::Identity(N_u, N_u);
+    for (size_t i = 0; i < N_u; ++i) {
+      A_triplet_vec.push_back(Eigen::Triplet<double>(A_rows_end + i, D_x + i, 1.0));
+    }
 
     // TODO(murooka) use curvature by stabling optimization
     // Currently, when using curvature, the optimization result is weird with sample_map.
@@ -1174,6 +1255,9 @@ MPTOptimizer::ConstraintMatrix MPTOptimizer::calcConstraintMatrix(
     A_rows_end += N_u;
   }
 
+  Eigen::SparseMatrix<double> A(A_rows, A_cols);
+  A.setFromTriplets(A_triplet_vec.begin(), A_triplet_vec.end());
+
   ConstraintMatrix constraint_matrix;
   constraint_matrix.linear = A;
   constraint_matrix.lower_bound = lb;
@@ -1229,8 +1313,8 @@ std::optional<Eigen::VectorXd> MPTOptimizer::calcOptimizedSteerAngles(
     updateMatrixForManualWarmStart(obj_mat, const_mat, u0);
 
   // calculate matrices for qp
-  const Eigen::MatrixXd & H = updated_obj_mat.hessian;
-  const Eigen::MatrixXd & A = updated_const_mat.linear;
+  const Eigen::SparseMatrix<double> & H = updated_obj_mat.hessian;
+  const Eigen::SparseMatrix<double> & A = updated_const_mat.linear;
   const auto f = toStdVector(updated_obj_mat.gradient);
   const auto upper_bound = toStdVector(updated_const_mat.upper_bound);
   const auto lower_bound = toStdVector(updated_const_mat.lower_bound);
@@ -1238,10 +1322,13 @@ std::optional<Eigen::VectorXd> MPTOptimizer::calcOptimizedSteerAngles(
   // initialize or update solver according to warm start
   time_keeper_ptr_->tic("initOsqp");
 
-  const autoware::common::osqp::CSC_Matrix P_csc =
-    autoware::common::osqp::calCSCMatrixTrapezoidal(H);
-  const autoware::common::osqp::CSC_Matrix A_csc = autoware::common::osqp::calCSCMatrix(A);
-  if (mpt_param_.enable_warm_start && prev_mat_n_ == H.rows() && prev_mat_m_ == A.rows()) {
+  // NOTE: H and A are assembled with a fixed structure, so their CSC matrices share the sparsity
+  //       pattern with the previous ones unless the problem structure changes.
+  autoware::common::osqp::CSC_Matrix P_csc = autoware::common::osqp::calCSCMatrix(H);
+  autoware::common::osqp::CSC_Matrix A_csc = autoware::common::osqp::calCSCMatrix(A);
+  if (
+    mpt_param_.enable_warm_start && prev_mat_n_ == H.rows() && prev_mat_m_ == A.rows() &&
+    isSameSparsityPattern(P_csc, prev_P_csc_) && isSameSparsityPattern(A_csc, prev_A_csc_)) {
     RCLCPP_INFO_EXPRESSION(logger_, enable_debug_info_, "warm start");
     osqp_solver_ptr_->updateCscP(P_csc);
     osqp_solver_ptr_->updateQ(f);
@@ -1255,6 +1342,8 @@ std::optional<Eigen::VectorXd> MPTOptimizer::calcOptimizedSteerAngles(
   }
   prev_mat_n_ = H.rows();
   prev_mat_m_ = A.rows();
+  prev_P_csc_ = std::move(P_csc);
+  prev_A_csc_ = std::move(A_csc);
 
   time_keeper_ptr_->toc("initOsqp", "          ");
 
@@ -1339,8 +1428,8 @@ MPTOptimizer::updateMatrixForManualWarmStart(
     return {obj_mat, const_mat};
   }
 
-  const Eigen::MatrixXd & H = obj_mat.hessian;
-  const Eigen::MatrixXd & A = const_mat.linear;
+  const Eigen::SparseMatrix<double> & H = obj_mat.hessian;
+  const Eigen::SparseMatrix<double> & A = const_mat.linear;
 
   auto updated_obj_mat = obj_mat;
   auto updated_const_mat = const_mat;
@@ -1350,7 +1439,7 @@ MPTOptimizer::updateMatrixForManualWarmStart(
   Eigen::VectorXd & lb = updated_const_mat.lower_bound;
 
   // update gradient
-  f += H * *u0;
+  f += H.selfadjointView<Eigen::Upper>() * *u0;
 
   // update upper_bound and lower_bound
   const Eigen::VectorXd A_times_u0 = A * *u0;
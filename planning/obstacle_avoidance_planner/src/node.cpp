@@ -320,8 +320,13 @@ std::vector<TrajectoryPoint> ObstacleAvoidancePlanner::optimizeTrajectory(
     resetPreviousData();
   } else {
     // check replan when not resetting previous optimization
-    const bool is_replan_required = replan_checker_ptr_->isReplanRequired(now());
+    const bool is_replan_required = replan_checker_ptr_->isReplanRequired(planner_data, now());
     if (!is_replan_required) {
+      // replan only the changed part when the far part of the path or drivable area changed
+      const auto fixed_length = replan_checker_ptr_->calcPartialReplanFixedLength(planner_data);
+      if (fixed_length && !enable_skip_optimization_) {
+        return optimizeTrajectoryPartially(planner_data, *fixed_length);
+      }
       return getPrevOptimizedTrajectory(p.traj_points);
     }
   }
@@ -351,6 +356,50 @@ std::vector<TrajectoryPoint> ObstacleAvoidancePlanner::optimizeTrajectory(
   return *mpt_traj;
 }
 
+std::vector<TrajectoryPoint> ObstacleAvoidancePlanner::optimizeTrajectoryPartially(
+  const PlannerData & planner_data, const double fixed_length)
+{
+  time_keeper_ptr_->tic(__func__);
+  const auto & p = planner_data;
+
+  if (!prev_optimized_traj_points_ptr_) {
+    return p.traj_points;
+  }
+  const auto & prev_traj_points = *prev_optimized_traj_points_ptr_;
+
+  // 1. calculate start pose of the partial optimization on the previous trajectory
+  const size_t ego_seg_idx =
+    trajectory_utils::findEgoSegmentIndex(prev_traj_points, p.ego_pose, ego_nearest_param_);
+  const auto start_idx = trajectory_utils::getPointIndexAfter(
+    prev_traj_points, p.ego_pose.position, ego_seg_idx, fixed_length);
+  if (!start_idx || prev_traj_points.size() < *start_idx + 2) {
+    return prev_traj_points;
+  }
+  const auto & start_pose = prev_traj_points.at(*start_idx).pose;
+
+  // 2. smooth trajectory after start pose with elastic band
+  const auto eb_traj = enable_smoothing_ ? eb_path_smoother_ptr_->getPartialEBTrajectory(
+                                             planner_data, start_pose, fixed_length)
+                                         : p.traj_points;
+  if (!eb_traj) {
+    return prev_traj_points;
+  }
+
+  // 3. optimize trajectory after start pose with model predictive trajectory
+  const auto mpt_traj = mpt_optimizer_ptr_->getPartialModelPredictiveTrajectory(
+    planner_data, *eb_traj, start_pose, fixed_length);
+  if (!mpt_traj) {
+    return prev_traj_points;
+  }
+
+  // 4. concatenate the fixed previous trajectory and the optimized one, and make prev trajectories
+  prev_optimized_traj_points_ptr_ = std::make_shared<std::vector<TrajectoryPoint>>(
+    trajectory_utils::concatenateToPrevPoints(prev_traj_points, *mpt_traj, ego_nearest_param_));
+
+  time_keeper_ptr_->toc(__func__, "    ");
+  return *prev_optimized_traj_points_ptr_;
+}
+
 std::vector<TrajectoryPoint> ObstacleAvoidancePlanner::getPrevOptimizedTrajectory(
   const std::vector<TrajectoryPoint> & traj_points) const
 {
@@ -18,10 +18,56 @@
 #include "obstacle_avoidance_planner/utils/trajectory_utils.hpp"
 #include "tier4_autoware_utils/tier4_autoware_utils.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
 #include <vector>
 
 namespace obstacle_avoidance_planner
 {
+namespace
+{
+// NOTE: std::nullopt is returned when the point is ahead of or behind the polyline.
+template <class T>
+std::optional<double> calcDistanceToPolyline(
+  const std::vector<T> & polyline, const geometry_msgs::msg::Point & p)
+{
+  if (polyline.size() < 2) {
+    return std::nullopt;
+  }
+
+  double min_dist = std::numeric_limits<double>::max();
+  bool is_outside = false;
+  for (size_t i = 0; i + 1 < polyline.size(); ++i) {
+    const auto & p_front = tier4_autoware_utils::getPoint(polyline.at(i));
+    const auto & p_back = tier4_autoware_utils::getPoint(polyline.at(i + 1));
+
+    const double seg_x = p_back.x - p_front.x;
+    const double seg_y = p_back.y - p_front.y;
+    const double squared_seg_length = seg_x * seg_x + seg_y * seg_y;
+    if (squared_seg_length < 1e-6) {
+      continue;
+    }
+
+    const double raw_ratio =
+      ((p.x - p_front.x) * seg_x + (p.y - p_front.y) * seg_y) / squared_seg_length;
+    const double ratio = std::clamp(raw_ratio, 0.0, 1.0);
+    const double dist =
+      std::hypot(p_front.x + ratio * seg_x - p.x, p_front.y + ratio * seg_y - p.y);
+    if (dist < min_dist) {
+      min_dist = dist;
+      is_outside = (i == 0 && raw_ratio < 0.0) || (i + 2 == polyline.size() && 1.0 < raw_ratio);
+    }
+  }
+
+  if (is_outside || min_dist == std::numeric_limits<double>::max()) {
+    return std::nullopt;
+  }
+  return min_dist;
+}
+}  // namespace
+
 ReplanChecker::ReplanChecker(rclcpp::Node * node, const EgoNearestParam & ego_nearest_param)
 : ego_nearest_param_(ego_nearest_param), logger_(node->get_logger().get_child("replan_checker"))
 {
@@ -30,6 +76,15 @@ ReplanChecker::ReplanChecker(rclcpp::Node * node, const EgoNearestParam & ego_ne
   max_ego_moving_dist_ = node->declare_parameter<double>("replan.max_ego_moving_dist");
   max_goal_moving_dist_ = node->declare_parameter<double>("replan.max_goal_moving_dist");
   max_delta_time_sec_ = node->declare_parameter<double>("replan.max_delta_time_sec");
+
+  // partial replan
+  enable_partial_replan_ = node->declare_parameter<bool>("replan.partial_replan.enable");
+  partial_replan_max_lat_dist_ =
+    node->declare_parameter<double>("replan.partial_replan.max_lat_dist");
+  partial_replan_margin_length_ =
+    node->declare_parameter<double>("replan.partial_replan.margin_length");
+  partial_replan_min_fixed_length_ =
+    node->declare_parameter<double>("replan.partial_replan.min_fixed_length");
 }
 
 void ReplanChecker::onParam(const std::vector<rclcpp::Parameter> & parameters)
@@ -41,6 +96,15 @@ void ReplanChecker::onParam(const std::vector<rclcpp::Parameter> & parameters)
   updateParam<double>(parameters, "replan.max_ego_moving_dist", max_ego_moving_dist_);
   updateParam<double>(parameters, "replan.max_goal_moving_dist", max_goal_moving_dist_);
   updateParam<double>(parameters, "replan.max_delta_time_sec", max_delta_time_sec_);
+
+  // partial replan
+  updateParam<bool>(parameters, "replan.partial_replan.enable", enable_partial_replan_);
+  updateParam<double>(
+    parameters, "replan.partial_replan.max_lat_dist", partial_replan_max_lat_dist_);
+  updateParam<double>(
+    parameters, "replan.partial_replan.margin_length", partial_replan_margin_length_);
+  updateParam<double>(
+    parameters, "replan.partial_replan.min_fixed_length", partial_replan_min_fixed_length_);
 }
 
 bool ReplanChecker::isResetRequired(const PlannerData & planner_data)
@@ -83,10 +147,16 @@ bool ReplanChecker::isResetRequired(const PlannerData & planner_data)
   prev_traj_points_ptr_ = std::make_shared<std::vector<TrajectoryPoint>>(p.traj_points);
   prev_ego_pose_ptr_ = std::make_shared<geometry_msgs::msg::Pose>(p.ego_pose);
 
+  // NOTE: resetting the optimization always replans
+  if (reset_required) {
+    prev_replanned_planner_data_ptr_ = std::make_shared<PlannerData>(p);
+  }
+
   return reset_required;
 }
 
-bool ReplanChecker::isReplanRequired(const rclcpp::Time & current_time)
+bool ReplanChecker::isReplanRequired(
+  const PlannerData & planner_data, const rclcpp::Time & current_time)
 {
   const bool replan_required = [&]() {
     // guard for invalid variables
@@ -106,11 +176,41 @@ bool ReplanChecker::isReplanRequired(const rclcpp::Time & current_time)
   // update previous information required in this function
   if (replan_required) {
     prev_replanned_time_ptr_ = std::make_shared<rclcpp::Time>(current_time);
+    prev_replanned_planner_data_ptr_ = std::make_shared<PlannerData>(planner_data);
   }
 
   return replan_required;
 }
 
+std::optional<double> ReplanChecker::calcPartialReplanFixedLength(
+  const PlannerData & planner_data)
+{
+  if (!enable_partial_replan_ || !prev_replanned_planner_data_ptr_) {
+    return std::nullopt;
+  }
+
+  const auto changed_length = calcChangedLength(planner_data, *prev_replanned_planner_data_ptr_);
+  if (!changed_length) {
+    return std::nullopt;
+  }
+
+  // NOTE: When the change is close to ego, the previous trajectory is reused until the next
+  //       replan as before.
+  const double fixed_length = *changed_length - partial_replan_margin_length_;
+  if (fixed_length < partial_replan_min_fixed_length_) {
+    return std::nullopt;
+  }
+
+  RCLCPP_INFO(
+    logger_, "Replan partially since path or drivable area changed %f [m] ahead.",
+    *changed_length);
+
+  // update previous information required in this function
+  prev_replanned_planner_data_ptr_ = std::make_shared<PlannerData>(planner_data);
+
+  return fixed_length;
+}
+
 bool ReplanChecker::isPathAroundEgoChanged(
   const PlannerData & planner_data, const std::vector<TrajectoryPoint> & prev_traj_points) const
 {
@@ -155,4 +255,46 @@ bool ReplanChecker::isPathGoalChanged(
 
   return true;
 }
+
+std::optional<double> ReplanChecker::calcChangedLength(
+  const PlannerData & planner_data, const PlannerData & prev_planner_data) const
+{
+  const auto & p = planner_data;
+  const auto & prev_p = prev_planner_data;
+
+  std::optional<double> changed_length;
+  const auto update_changed_length = [&](const double length) {
+    if (0.0 <= length && (!changed_length || length < *changed_length)) {
+      changed_length = length;
+    }
+  };
+
+  // path shape changes
+  const size_t ego_seg_idx =
+    trajectory_utils::findEgoSegmentIndex(p.traj_points, p.ego_pose, ego_nearest_param_);
+  for (size_t i = ego_seg_idx + 1; i < p.traj_points.size(); ++i) {
+    const auto & point = p.traj_points.at(i).pose.position;
+    const auto dist = calcDistanceToPolyline(prev_p.traj_points, point);
+    if (dist && partial_replan_max_lat_dist_ < *dist) {
+      update_changed_length(
+        motion_utils::calcSignedArcLength(p.traj_points, p.ego_pose.position, i));
+      break;
+    }
+  }
+
+  // drivable area changes
+  for (const auto & [bound, prev_bound] :
+       {std::make_pair(&p.left_bound, &prev_p.left_bound),
+        std::make_pair(&p.right_bound, &prev_p.right_bound)}) {
+    for (const auto & bound_point : *bound) {
+      const auto dist = calcDistanceToPolyline(*prev_bound, bound_point);
+      if (dist && partial_replan_max_lat_dist_ < *dist) {
+        update_changed_length(
+          motion_utils::calcSignedArcLength(p.traj_points, p.ego_pose.position, bound_point));
+      }
+    }
+  }
+
+  return changed_length;
+}
 }  // namespace obstacle_avoidance_planner
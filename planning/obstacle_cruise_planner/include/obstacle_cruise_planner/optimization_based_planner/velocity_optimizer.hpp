@@ -15,6 +15,7 @@
 #define OBSTACLE_CRUISE_PLANNER__OPTIMIZATION_BASED_PLANNER__VELOCITY_OPTIMIZER_HPP_
 
 #include "obstacle_cruise_planner/optimization_based_planner/s_boundary.hpp"
+#include "osqp_interface/csc_matrix_conv.hpp"
 #include "osqp_interface/osqp_interface.hpp"
 
 #include <vector>
@@ -70,6 +71,14 @@ private:
 
   // QPSolver
   autoware::common::osqp::OSQPInterface qp_solver_;
+
+  // The workspace is kept while the sparsity of the problem does not change so that OSQP only
+  // updates the values and warm starts from the previous solution.
+  bool is_qp_initialized_{false};
+  autoware::common::osqp::CSC_Matrix prev_P_csc_;
+  autoware::common::osqp::CSC_Matrix prev_A_csc_;
+  std::vector<double> prev_primal_;
+  std::vector<double> prev_dual_;
 };
 
 #endif  // OBSTACLE_CRUISE_PLANNER__OPTIMIZATION_BASED_PLANNER__VELOCITY_OPTIMIZER_HPP_
@@ -20,36 +20,43 @@
 #include "vehicle_info_util/vehicle_info_util.hpp"
 
 #include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
 #include <boost/optional.hpp>
 
 #include <limits>
+#include <utility>
 #include <vector>
 
 namespace polygon_utils
 {
 namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+using tier4_autoware_utils::Box2d;
 using tier4_autoware_utils::Point2d;
 using tier4_autoware_utils::Polygon2d;
 
+// envelopes of the trajectory polygons with their index
+using PolygonRtree = bgi::rtree<std::pair<Box2d, size_t>, bgi::rstar<16>>;
+
 boost::optional<size_t> getCollisionIndex(
   const Trajectory & traj, const std::vector<Polygon2d> & traj_polygons,
-  const geometry_msgs::msg::PoseStamped & obj_pose, const Shape & shape,
-  std::vector<geometry_msgs::msg::PointStamped> & collision_points,
+  const PolygonRtree & traj_polygons_rtree, const geometry_msgs::msg::PoseStamped & obj_pose,
+  const Shape & shape, std::vector<geometry_msgs::msg::PointStamped> & collision_points,
   const double max_dist = std::numeric_limits<double>::max());
 
 std::vector<geometry_msgs::msg::PointStamped> getCollisionPoints(
   const Trajectory & traj, const std::vector<Polygon2d> & traj_polygons,
-  const std_msgs::msg::Header & obj_header, const PredictedPath & predicted_path,
-  const Shape & shape, const rclcpp::Time & current_time,
+  const PolygonRtree & traj_polygons_rtree, const std_msgs::msg::Header & obj_header,
+  const PredictedPath & predicted_path, const Shape & shape, const rclcpp::Time & current_time,
   const double vehicle_max_longitudinal_offset, const bool is_driving_forward,
   std::vector<size_t> & collision_index, const double max_dist = std::numeric_limits<double>::max(),
   const double max_prediction_time_for_collision_check = std::numeric_limits<double>::max());
 
 std::vector<geometry_msgs::msg::PointStamped> willCollideWithSurroundObstacle(
   const Trajectory & traj, const std::vector<Polygon2d> & traj_polygons,
-  const std_msgs::msg::Header & obj_header, const PredictedPath & predicted_path,
-  const Shape & shape, const rclcpp::Time & current_time, const double max_dist,
-  const double ego_obstacle_overlap_time_threshold,
+  const PolygonRtree & traj_polygons_rtree, const std_msgs::msg::Header & obj_header,
+  const PredictedPath & predicted_path, const Shape & shape, const rclcpp::Time & current_time,
+  const double max_dist, const double ego_obstacle_overlap_time_threshold,
   const double max_prediction_time_for_collision_check, std::vector<size_t> & collision_index,
   const double vehicle_max_longitudinal_offset, const bool is_driving_forward);
 
@@ -57,6 +64,8 @@ std::vector<Polygon2d> createOneStepPolygons(
   const Trajectory & traj, const vehicle_info_util::VehicleInfo & vehicle_info,
   const double expand_width);
 
+PolygonRtree createPolygonRtree(const std::vector<Polygon2d> & polygons);
+
 geometry_msgs::msg::PointStamped calcNearestCollisionPoint(
   const size_t & first_within_idx,
   const std::vector<geometry_msgs::msg::PointStamped> & collision_points,
@@ -621,6 +621,8 @@ std::vector<TargetObstacle> ObstacleCruisePlannerNode::filterObstacles(
   const auto extended_traj_polygons = polygon_utils::createOneStepPolygons(
     extended_traj, vehicle_info_, obstacle_filtering_param_.detection_area_expand_width);
   debug_data.detection_polygons = extended_traj_polygons;
+  const auto extended_traj_polygons_rtree =
+    polygon_utils::createPolygonRtree(extended_traj_polygons);
 
   std::vector<TargetObstacle> target_obstacles;
   for (const auto & predicted_object : predicted_objects.objects) {
@@ -677,8 +679,8 @@ std::vector<TargetObstacle> ObstacleCruisePlannerNode::filterObstacles(
     // calculate current collision points
     std::vector<geometry_msgs::msg::PointStamped> closest_collision_points;
     const auto first_within_idx = polygon_utils::getCollisionIndex(
-      extended_traj, extended_traj_polygons, current_object_pose, predicted_object.shape,
-      closest_collision_points);
+      extended_traj, extended_traj_polygons, extended_traj_polygons_rtree, current_object_pose,
+      predicted_object.shape, closest_collision_points);
 
     // precise detection area filtering with polygons
     std::vector<geometry_msgs::msg::PointStamped> collision_points;
@@ -686,9 +688,9 @@ std::vector<TargetObstacle> ObstacleCruisePlannerNode::filterObstacles(
     if (first_within_idx) {  // obstacles inside the trajectory
       // calculate nearest collision point
       collision_points = polygon_utils::getCollisionPoints(
-        extended_traj, extended_traj_polygons, predicted_objects.header, resampled_predicted_path,
-        predicted_object.shape, current_time, vehicle_info_.max_longitudinal_offset_m,
-        is_driving_forward, collision_index);
+        extended_traj, extended_traj_polygons, extended_traj_polygons_rtree,
+        predicted_objects.header, resampled_predicted_path, predicted_object.shape, current_time,
+        vehicle_info_.max_longitudinal_offset_m, is_driving_forward, collision_index);
 
       const bool is_angle_aligned = isAngleAlignedWithTrajectory(
         extended_traj, current_object_pose.pose,
@@ -745,8 +747,8 @@ std::vector<TargetObstacle> ObstacleCruisePlannerNode::filterObstacles(
 
       std::vector<size_t> collision_index;
       collision_points = polygon_utils::willCollideWithSurroundObstacle(
-        extended_traj, extended_traj_polygons, predicted_objects.header, resampled_predicted_path,
-        predicted_object.shape, current_time,
+        extended_traj, extended_traj_polygons, extended_traj_polygons_rtree,
+        predicted_objects.header, resampled_predicted_path, predicted_object.shape, current_time,
         vehicle_info_.vehicle_width_m + obstacle_filtering_param_.rough_detection_area_expand_width,
         obstacle_filtering_param_.ego_obstacle_overlap_time_threshold,
         obstacle_filtering_param_.max_prediction_time_for_collision_check, collision_index,
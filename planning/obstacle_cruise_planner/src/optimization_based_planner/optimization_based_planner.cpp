@@ -18,6 +18,7 @@
 #include "interpolation/spline_interpolation.hpp"
 #include "interpolation/zero_order_hold.hpp"
 #include "motion_utils/resample/resample.hpp"
+#include "motion_utils/trajectory/indexed_trajectory.hpp"
 #include "motion_utils/trajectory/interpolation.hpp"
 #include "motion_utils/trajectory/trajectory.hpp"
 #include "obstacle_cruise_planner/utils.hpp"
@@ -167,8 +168,9 @@ Trajectory OptimizationBasedPlanner::generateCruiseTrajectory(
   const auto optimized_result = velocity_optimizer_ptr_->optimize(data);
 
   // Publish Debug trajectories
+  const motion_utils::IndexedTrajectory indexed_traj_points(planner_data.traj.points);
   const double traj_front_to_vehicle_offset =
-    motion_utils::calcSignedArcLength(planner_data.traj.points, 0, closest_idx);
+    indexed_traj_points.calcSignedArcLength(0, closest_idx);
   publishDebugTrajectory(
     planner_data, traj_front_to_vehicle_offset, time_vec, *s_boundaries, optimized_result);
 
@@ -210,8 +212,7 @@ Trajectory OptimizationBasedPlanner::generateCruiseTrajectory(
       break;
     }
   }
-  const auto traj_stop_dist =
-    motion_utils::calcDistanceToForwardStopPoint(planner_data.traj.points, closest_idx);
+  const auto traj_stop_dist = indexed_traj_points.calcDistanceToForwardStopPoint(closest_idx);
   if (traj_stop_dist) {
     closest_stop_dist = std::min(*traj_stop_dist + traj_front_to_vehicle_offset, closest_stop_dist);
   }
@@ -220,8 +221,8 @@ Trajectory OptimizationBasedPlanner::generateCruiseTrajectory(
   size_t break_id = planner_data.traj.points.size();
   std::vector<double> resampled_opt_position;
   for (size_t i = closest_idx; i < planner_data.traj.points.size(); ++i) {
-    const double query_s = std::max(
-      motion_utils::calcSignedArcLength(planner_data.traj.points, 0, i), opt_position.front());
+    const double query_s =
+      std::max(indexed_traj_points.calcSignedArcLength(0, i), opt_position.front());
     if (query_s > opt_position.back()) {
       break_id = i;
       break;
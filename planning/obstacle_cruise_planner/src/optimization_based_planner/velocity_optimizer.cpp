@@ -17,6 +17,16 @@
 #include <eigen3/Eigen/Core>
 
 #include <iostream>
+#include <utility>
+
+namespace
+{
+bool hasSameSparsity(
+  const autoware::common::osqp::CSC_Matrix & m1, const autoware::common::osqp::CSC_Matrix & m2)
+{
+  return m1.m_row_idxs == m2.m_row_idxs && m1.m_col_idxs == m2.m_col_idxs;
+}
+}  // namespace
 
 VelocityOptimizer::VelocityOptimizer(
   const double max_s_weight, const double max_v_weight, const double over_s_safety_weight,
@@ -244,12 +254,45 @@ VelocityOptimizer::OptimizationResult VelocityOptimizer::optimize(const Optimiza
   }
 
   // execute optimization
-  const auto result = qp_solver_.optimize(P, A, q, lower_bound, upper_bound);
+  auto P_csc = autoware::common::osqp::calCSCMatrixTrapezoidal(P);
+  auto A_csc = autoware::common::osqp::calCSCMatrix(A);
+  if (
+    is_qp_initialized_ && hasSameSparsity(P_csc, prev_P_csc_) &&
+    hasSameSparsity(A_csc, prev_A_csc_)) {
+    // the workspace keeps the previous solution as the initial guess
+    qp_solver_.updateCscP(P_csc);
+    qp_solver_.updateCscA(A_csc);
+    qp_solver_.updateQ(q);
+    qp_solver_.updateBounds(lower_bound, upper_bound);
+  } else {
+    const auto exit_flag = qp_solver_.initializeProblem(P_csc, A_csc, q, lower_bound, upper_bound);
+    if (exit_flag != 0) {
+      std::cerr << "failed to initialize the QP workspace" << std::endl;
+      is_qp_initialized_ = false;
+      return OptimizationResult{};
+    }
+    if (
+      prev_primal_.size() == static_cast<size_t>(l_variables) &&
+      prev_dual_.size() == static_cast<size_t>(l_constraints)) {
+      qp_solver_.setWarmStart(prev_primal_, prev_dual_);
+    }
+    prev_P_csc_ = std::move(P_csc);
+    prev_A_csc_ = std::move(A_csc);
+    is_qp_initialized_ = true;
+  }
+  const auto result = qp_solver_.optimize();
   const std::vector<double> optval = std::get<0>(result);
 
   const int status_val = std::get<3>(result);
   if (status_val != 1) {
     std::cerr << "optimization failed : " << qp_solver_.getStatusMessage().c_str() << std::endl;
+    // do not warm start from a failed solution
+    is_qp_initialized_ = false;
+    prev_primal_.clear();
+    prev_dual_.clear();
+  } else {
+    prev_primal_ = optval;
+    prev_dual_ = std::get<1>(result);
   }
 
   std::vector<double> opt_time = time_vec;
@@ -17,6 +17,9 @@
 #include "motion_utils/trajectory/trajectory.hpp"
 #include "tier4_autoware_utils/geometry/boost_polygon_utils.hpp"
 
+#include <algorithm>
+#include <iterator>
+
 namespace
 {
 namespace bg = boost::geometry;
@@ -89,11 +92,22 @@ namespace polygon_utils
 {
 boost::optional<size_t> getCollisionIndex(
   const Trajectory & traj, const std::vector<Polygon2d> & traj_polygons,
-  const geometry_msgs::msg::PoseStamped & obj_pose, const Shape & shape,
-  std::vector<geometry_msgs::msg::PointStamped> & collision_geom_points, const double max_dist)
+  const PolygonRtree & traj_polygons_rtree, const geometry_msgs::msg::PoseStamped & obj_pose,
+  const Shape & shape, std::vector<geometry_msgs::msg::PointStamped> & collision_geom_points,
+  const double max_dist)
 {
   const auto obj_polygon = tier4_autoware_utils::toPolygon2d(obj_pose.pose, shape);
-  for (size_t i = 0; i < traj_polygons.size(); ++i) {
+
+  // only the polygons whose envelope intersects the object can collide with it
+  std::vector<std::pair<Box2d, size_t>> candidates;
+  traj_polygons_rtree.query(
+    bgi::intersects(bg::return_envelope<Box2d>(obj_polygon)), std::back_inserter(candidates));
+  std::sort(candidates.begin(), candidates.end(), [](const auto & c1, const auto & c2) {
+    return c1.second < c2.second;
+  });
+
+  for (const auto & candidate : candidates) {
+    const size_t i = candidate.second;
     const double approximated_dist =
       tier4_autoware_utils::calcDistance2d(traj.points.at(i).pose, obj_pose.pose);
     if (approximated_dist > max_dist) {
@@ -128,8 +142,8 @@ boost::optional<size_t> getCollisionIndex(
 
 std::vector<geometry_msgs::msg::PointStamped> getCollisionPoints(
   const Trajectory & traj, const std::vector<Polygon2d> & traj_polygons,
-  const std_msgs::msg::Header & obj_header, const PredictedPath & predicted_path,
-  const Shape & shape, const rclcpp::Time & current_time,
+  const PolygonRtree & traj_polygons_rtree, const std_msgs::msg::Header & obj_header,
+  const PredictedPath & predicted_path, const Shape & shape, const rclcpp::Time & current_time,
   const double vehicle_max_longitudinal_offset, const bool is_driving_forward,
   std::vector<size_t> & collision_index, const double max_dist,
   const double max_prediction_time_for_collision_check)
@@ -155,8 +169,9 @@ std::vector<geometry_msgs::msg::PointStamped> getCollisionPoints(
     obj_pose.pose = predicted_path.path.at(i);
 
     std::vector<geometry_msgs::msg::PointStamped> current_collision_points;
-    const auto collision_idx =
-      getCollisionIndex(traj, traj_polygons, obj_pose, shape, current_collision_points, max_dist);
+    const auto collision_idx = getCollisionIndex(
+      traj, traj_polygons, traj_polygons_rtree, obj_pose, shape, current_collision_points,
+      max_dist);
     if (collision_idx) {
       const auto nearest_collision_point = calcNearestCollisionPoint(
         *collision_idx, current_collision_points, traj, vehicle_max_longitudinal_offset,
@@ -171,14 +186,14 @@ std::vector<geometry_msgs::msg::PointStamped> getCollisionPoints(
 
 std::vector<geometry_msgs::msg::PointStamped> willCollideWithSurroundObstacle(
   const Trajectory & traj, const std::vector<Polygon2d> & traj_polygons,
-  const std_msgs::msg::Header & obj_header, const PredictedPath & predicted_path,
-  const Shape & shape, const rclcpp::Time & current_time, const double max_dist,
-  const double ego_obstacle_overlap_time_threshold,
+  const PolygonRtree & traj_polygons_rtree, const std_msgs::msg::Header & obj_header,
+  const PredictedPath & predicted_path, const Shape & shape, const rclcpp::Time & current_time,
+  const double max_dist, const double ego_obstacle_overlap_time_threshold,
   const double max_prediction_time_for_collision_check, std::vector<size_t> & collision_index,
   const double vehicle_max_longitudinal_offset, const bool is_driving_forward)
 {
   const auto collision_points = getCollisionPoints(
-    traj, traj_polygons, obj_header, predicted_path, shape, current_time,
+    traj, traj_polygons, traj_polygons_rtree, obj_header, predicted_path, shape, current_time,
     vehicle_max_longitudinal_offset, is_driving_forward, collision_index, max_dist,
     max_prediction_time_for_collision_check);
 
@@ -217,6 +232,16 @@ std::vector<Polygon2d> createOneStepPolygons(
   return polygons;
 }
 
+PolygonRtree createPolygonRtree(const std::vector<Polygon2d> & polygons)
+{
+  std::vector<std::pair<Box2d, size_t>> envelopes;
+  envelopes.reserve(polygons.size());
+  for (size_t i = 0; i < polygons.size(); ++i) {
+    envelopes.emplace_back(bg::return_envelope<Box2d>(polygons.at(i)), i);
+  }
+  return PolygonRtree(envelopes);
+}
+
 geometry_msgs::msg::PointStamped calcNearestCollisionPoint(
   const size_t & first_within_idx,
   const std::vector<geometry_msgs::msg::PointStamped> & collision_points,
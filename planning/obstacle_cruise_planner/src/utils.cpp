@@ -41,10 +41,11 @@ boost::optional<geometry_msgs::msg::Pose> calcForwardPose(
     return {};
   }
 
+  const motion_utils::IndexedTrajectory indexed_traj_points(traj.points);
   size_t search_idx = start_idx;
   double length_to_search_idx = 0.0;
   for (; search_idx < traj.points.size(); ++search_idx) {
-    length_to_search_idx = motion_utils::calcSignedArcLength(traj.points, start_idx, search_idx);
+    length_to_search_idx = indexed_traj_points.calcSignedArcLength(start_idx, search_idx);
     if (length_to_search_idx > target_length) {
       break;
     } else if (search_idx == traj.points.size() - 1) {
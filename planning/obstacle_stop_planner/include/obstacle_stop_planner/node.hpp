@@ -184,10 +184,13 @@ private:
     const VehicleInfo & vehicle_info, const double current_acc, const double current_vel,
     const StopParam & stop_param);
 
+  // NOTE: center_point_indices[i] is the sorted indices of output points near the vehicle center
+  //       on trajectory[i]
   bool searchPointcloudNearTrajectory(
     const TrajectoryPoints & trajectory, const PointCloud2::ConstSharedPtr & input_points_ptr,
-    PointCloud::Ptr output_points_ptr, const Header & trajectory_header,
-    const VehicleInfo & vehicle_info, const StopParam & stop_param);
+    PointCloud::Ptr output_points_ptr, std::vector<std::vector<size_t>> & center_point_indices,
+    const Header & trajectory_header, const VehicleInfo & vehicle_info,
+    const StopParam & stop_param);
 
   StopPoint createTargetPoint(
     const int idx, const double margin, const TrajectoryPoints & base_trajectory,
@@ -138,6 +138,10 @@ bool withinPolyhedron(
   const Point2d & next_point, PointCloud::Ptr candidate_points_ptr,
   PointCloud::Ptr within_points_ptr, double z_min, double z_max);
 
+PointCloud::Ptr extractStepCandidatePoints(
+  const PointCloud & candidate_points, const std::vector<size_t> & prev_point_indices,
+  const std::vector<size_t> & next_point_indices);
+
 bool convexHull(
   const std::vector<cv::Point2d> & pointcloud, std::vector<cv::Point2d> & polygon_points);
 
@@ -17,6 +17,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -362,9 +363,10 @@ void ObstacleStopPlannerNode::searchObstacle(
   // search candidate obstacle pointcloud
   PointCloud::Ptr slow_down_pointcloud_ptr(new PointCloud);
   PointCloud::Ptr obstacle_candidate_pointcloud_ptr(new PointCloud);
+  std::vector<std::vector<size_t>> center_point_indices;
   if (!searchPointcloudNearTrajectory(
         decimate_trajectory, obstacle_ros_pointcloud_ptr, obstacle_candidate_pointcloud_ptr,
-        trajectory_header, vehicle_info, stop_param)) {
+        center_point_indices, trajectory_header, vehicle_info, stop_param)) {
     return;
   }
 
@@ -384,6 +386,11 @@ void ObstacleStopPlannerNode::searchObstacle(
     const auto next_center_pose = getVehicleCenterFromBase(p_back, vehicle_info);
     const Point2d next_center_point(next_center_pose.position.x, next_center_pose.position.y);
 
+    // only the candidate points near the centers of this step can be within its polygon
+    const auto step_candidate_pointcloud_ptr = extractStepCandidatePoints(
+      *obstacle_candidate_pointcloud_ptr, center_point_indices.at(i),
+      center_point_indices.at(i + 1));
+
     if (node_param_.enable_slow_down) {
       std::vector<cv::Point2d> one_step_move_slow_down_range_polygon;
       // create one step polygon for slow_down range
@@ -396,12 +403,12 @@ void ObstacleStopPlannerNode::searchObstacle(
       if (node_param_.enable_z_axis_obstacle_filtering) {
         planner_data.found_slow_down_points = withinPolyhedron(
           one_step_move_slow_down_range_polygon, slow_down_param_.slow_down_search_radius,
-          prev_center_point, next_center_point, obstacle_candidate_pointcloud_ptr,
+          prev_center_point, next_center_point, step_candidate_pointcloud_ptr,
           slow_down_pointcloud_ptr, z_axis_min, z_axis_max);
       } else {
         planner_data.found_slow_down_points = withinPolygon(
           one_step_move_slow_down_range_polygon, slow_down_param_.slow_down_search_radius,
-          prev_center_point, next_center_point, obstacle_candidate_pointcloud_ptr,
+          prev_center_point, next_center_point, step_candidate_pointcloud_ptr,
           slow_down_pointcloud_ptr);
       }
       const auto found_first_slow_down_points =
@@ -424,7 +431,7 @@ void ObstacleStopPlannerNode::searchObstacle(
       }
 
     } else {
-      slow_down_pointcloud_ptr = obstacle_candidate_pointcloud_ptr;
+      slow_down_pointcloud_ptr = step_candidate_pointcloud_ptr;
     }
 
     {
@@ -1534,8 +1541,9 @@ TrajectoryPoints ObstacleStopPlannerNode::trimTrajectoryWithIndexFromSelfPose(
 
 bool ObstacleStopPlannerNode::searchPointcloudNearTrajectory(
   const TrajectoryPoints & trajectory, const PointCloud2::ConstSharedPtr & input_points_ptr,
-  PointCloud::Ptr output_points_ptr, const Header & trajectory_header,
-  const VehicleInfo & vehicle_info, const StopParam & stop_param)
+  PointCloud::Ptr output_points_ptr, std::vector<std::vector<size_t>> & center_point_indices,
+  const Header & trajectory_header, const VehicleInfo & vehicle_info,
+  const StopParam & stop_param)
 {
   // transform pointcloud
   TransformStamped transform_stamped{};
@@ -1564,21 +1572,51 @@ bool ObstacleStopPlannerNode::searchPointcloudNearTrajectory(
                                  ? slow_down_param_.slow_down_search_radius
                                  : stop_param.stop_search_radius;
   const double squared_radius = search_radius * search_radius;
+
+  // register the vehicle centers to grid cells whose size is the search radius, so that only
+  // the centers in the 3x3 cells around a point can be within the radius
+  const auto to_cell_index = [&](const double v) {
+    return static_cast<int64_t>(std::floor(v / search_radius));
+  };
+  const auto to_cell_key = [](const int64_t ix, const int64_t iy) {
+    return (static_cast<uint64_t>(ix) << 32) ^ (static_cast<uint64_t>(iy) & 0xFFFFFFFF);
+  };
   std::vector<geometry_msgs::msg::Point> center_points;
+  std::unordered_map<uint64_t, std::vector<size_t>> center_grid;
   center_points.reserve(trajectory.size());
   for (const auto & trajectory_point : trajectory) {
-    center_points.push_back(getVehicleCenterFromBase(trajectory_point.pose, vehicle_info).position);
+    const auto center_point =
+      getVehicleCenterFromBase(trajectory_point.pose, vehicle_info).position;
+    center_grid[to_cell_key(to_cell_index(center_point.x), to_cell_index(center_point.y))]
+      .push_back(center_points.size());
+    center_points.push_back(center_point);
   }
+
+  center_point_indices.assign(trajectory.size(), std::vector<size_t>{});
   for (const auto & point : transformed_points_ptr->points) {
-    for (const auto & center_point : center_points) {
-      const double x = center_point.x - point.x;
-      const double y = center_point.y - point.y;
-      const double squared_distance = x * x + y * y;
-      if (squared_distance < squared_radius) {
-        output_points_ptr->points.push_back(point);
-        break;
+    const int64_t ix = to_cell_index(point.x);
+    const int64_t iy = to_cell_index(point.y);
+    bool is_near_trajectory = false;
+    for (int64_t dx = -1; dx <= 1; ++dx) {
+      for (int64_t dy = -1; dy <= 1; ++dy) {
+        const auto itr = center_grid.find(to_cell_key(ix + dx, iy + dy));
+        if (itr == center_grid.end()) {
+          continue;
+        }
+        for (const auto center_idx : itr->second) {
+          const double x = center_points.at(center_idx).x - point.x;
+          const double y = center_points.at(center_idx).y - point.y;
+          const double squared_distance = x * x + y * y;
+          if (squared_distance < squared_radius) {
+            center_point_indices.at(center_idx).push_back(output_points_ptr->points.size());
+            is_near_trajectory = true;
+          }
+        }
       }
     }
+    if (is_near_trajectory) {
+      output_points_ptr->points.push_back(point);
+    }
   }
   return true;
 }
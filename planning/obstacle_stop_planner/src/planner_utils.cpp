@@ -23,6 +23,9 @@
 
 #include <pcl_conversions/pcl_conversions.h>
 
+#include <algorithm>
+#include <iterator>
+
 namespace motion_planning
 {
 
@@ -475,6 +478,26 @@ bool withinPolyhedron(
   return find_within_points;
 }
 
+PointCloud::Ptr extractStepCandidatePoints(
+  const PointCloud & candidate_points, const std::vector<size_t> & prev_point_indices,
+  const std::vector<size_t> & next_point_indices)
+{
+  // NOTE: both indices are sorted, and a point near the two centers is extracted only once
+  std::vector<size_t> step_point_indices;
+  step_point_indices.reserve(prev_point_indices.size() + next_point_indices.size());
+  std::set_union(
+    prev_point_indices.begin(), prev_point_indices.end(), next_point_indices.begin(),
+    next_point_indices.end(), std::back_inserter(step_point_indices));
+
+  PointCloud::Ptr step_points_ptr(new PointCloud);
+  step_points_ptr->header = candidate_points.header;
+  step_points_ptr->points.reserve(step_point_indices.size());
+  for (const auto idx : step_point_indices) {
+    step_points_ptr->points.push_back(candidate_points.points.at(idx));
+  }
+  return step_points_ptr;
+}
+
 bool convexHull(
   const std::vector<cv::Point2d> & pointcloud, std::vector<cv::Point2d> & polygon_points)
 {
@@ -82,6 +82,11 @@ std::vector<polygon_t> createFootprintPolygons(
 /// @return polygon footprint of the trajectory
 polygon_t createTrajectoryFootprint(const Trajectory & trajectory, const Float lateral_offset);
 
+/// @brief create the bounding box of the projection footprints
+/// @param[in] footprints projection footprints
+/// @return the bounding box covering all footprints
+box_t createBoundingBox(const std::vector<polygon_t> & footprints);
+
 /// @brief create a polygon of the safety envelope
 /// @details the safety envelope is the area covered by forward projections at each trajectory
 /// point
@@ -108,6 +113,7 @@ std::vector<multilinestring_t> createProjectedLines(
   const Trajectory & trajectory, ProjectionParameters & params);
 
 /// @brief limit the velocity of the given trajectory
+/// @details the collision distances are calculated with projection_params.nb_threads threads
 /// @param[in] trajectory input trajectory
 /// @param[in] collision_checker object used to retrieve collision points
 /// @param[in] projections forward projection lines at each trajectory point
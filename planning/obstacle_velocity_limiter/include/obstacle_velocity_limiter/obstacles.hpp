@@ -111,11 +111,35 @@ struct ObstacleTree<multilinestring_t>
   }
 };
 
+/// @brief bitmap of the cells occupied by obstacles
+/// @details collision points are approximated by the center of the occupied cells
+struct ObstacleRaster
+{
+  point_t origin;  // minimum corner of the raster
+  double resolution;
+  size_t width{};
+  size_t height{};
+  std::vector<uint8_t> cells;  // row major, non-zero if occupied
+
+  /// @brief rasterize the obstacles that are inside the given bounds
+  /// @param [in] obstacles obstacles to rasterize
+  /// @param [in] bounds area covered by the raster
+  /// @param [in] resolution [m] size of a cell
+  ObstacleRaster(const Obstacles & obstacles, const box_t & bounds, const double resolution);
+
+  [[nodiscard]] std::vector<point_t> intersections(const polygon_t & polygon) const;
+
+private:
+  void markCell(const double x, const double y);
+  void markSegment(const point_t & p1, const point_t & p2);
+};
+
 struct CollisionChecker
 {
   const Obstacles obstacles;
   std::unique_ptr<ObstacleTree<multipoint_t>> point_obstacle_tree_ptr;
   std::unique_ptr<ObstacleTree<multilinestring_t>> line_obstacle_tree_ptr;
+  std::unique_ptr<ObstacleRaster> obstacle_raster_ptr;
 
   explicit CollisionChecker(
     Obstacles obs, const size_t rtree_min_points, const size_t rtree_min_segments)
@@ -130,8 +154,15 @@ struct CollisionChecker
       point_obstacle_tree_ptr = std::make_unique<ObstacleTree<multipoint_t>>(obstacles.points);
   }
 
+  explicit CollisionChecker(Obstacles obs, const box_t & raster_bounds, const double resolution)
+  : obstacles(std::move(obs)),
+    obstacle_raster_ptr(std::make_unique<ObstacleRaster>(obstacles, raster_bounds, resolution))
+  {
+  }
+
   [[nodiscard]] std::vector<point_t> intersections(const polygon_t & polygon) const
   {
+    if (obstacle_raster_ptr) return obstacle_raster_ptr->intersections(polygon);
     std::vector<point_t> result;
     if (line_obstacle_tree_ptr) {
       result = line_obstacle_tree_ptr->intersections(polygon);
@@ -39,6 +39,7 @@ struct ObstacleParameters
   static constexpr auto IGNORE_DIST_PARAM = "obstacles.ignore_extra_distance";
   static constexpr auto RTREE_SEGMENTS_PARAM = "obstacles.rtree_min_segments";
   static constexpr auto RTREE_POINTS_PARAM = "obstacles.rtree_min_points";
+  static constexpr auto RASTER_RESOLUTION_PARAM = "obstacles.raster_resolution";
 
   // cspell: ignore OCCUPANCYGRID
   enum { POINTCLOUD, OCCUPANCYGRID, STATIC_ONLY } dynamic_source = OCCUPANCYGRID;
@@ -51,6 +52,7 @@ struct ObstacleParameters
   Float ignore_extra_distance;
   size_t rtree_min_points{};
   size_t rtree_min_segments{};
+  double raster_resolution{};  // [m] a value of 0 disables the raster collision checking
 
   ObstacleParameters() = default;
   explicit ObstacleParameters(rclcpp::Node & node)
@@ -67,6 +69,7 @@ struct ObstacleParameters
     updateRtreeMinPoints(node, static_cast<int>(node.declare_parameter<int>(RTREE_POINTS_PARAM)));
     updateRtreeMinSegments(
       node, static_cast<int>(node.declare_parameter<int>(RTREE_SEGMENTS_PARAM)));
+    updateRasterResolution(node, node.declare_parameter<double>(RASTER_RESOLUTION_PARAM));
   }
 
   bool updateType(rclcpp::Node & node, const std::string & type)
@@ -108,6 +111,17 @@ struct ObstacleParameters
     rtree_min_segments = static_cast<size_t>(size);
     return true;
   }
+
+  bool updateRasterResolution(rclcpp::Node & node, const double resolution)
+  {
+    if (resolution < 0.0) {
+      RCLCPP_WARN(
+        node.get_logger(), "Raster resolution must be positive or 0. %f was given.", resolution);
+      return false;
+    }
+    raster_resolution = resolution;
+    return true;
+  }
 };
 
 struct ProjectionParameters
@@ -117,6 +131,7 @@ struct ProjectionParameters
   static constexpr auto STEER_OFFSET_PARAM = "simulation.steering_offset";
   static constexpr auto DISTANCE_METHOD_PARAM = "simulation.distance_method";
   static constexpr auto DURATION_PARAM = "min_ttc";
+  static constexpr auto NB_THREADS_PARAM = "simulation.nb_threads";
 
   enum { PARTICLE, BICYCLE } model = PARTICLE;
   enum { EXACT, APPROXIMATION } distance_method = EXACT;
@@ -129,6 +144,8 @@ struct ProjectionParameters
   double wheel_base{};
   double steering_angle{};
   double steering_angle_offset{};
+  // number of threads used to calculate the collision distance of the trajectory points
+  int nb_threads = 1;
 
   ProjectionParameters() = default;
   explicit ProjectionParameters(rclcpp::Node & node)
@@ -138,6 +155,7 @@ struct ProjectionParameters
     updateNbPoints(node, node.declare_parameter<int>(NBPOINTS_PARAM));
     steering_angle_offset = node.declare_parameter<double>(STEER_OFFSET_PARAM);
     duration = node.declare_parameter<double>(DURATION_PARAM);
+    updateNbThreads(node, static_cast<int>(node.declare_parameter<int>(NB_THREADS_PARAM)));
   }
 
   bool updateModel(rclcpp::Node & node, const std::string & model_str)
@@ -182,6 +200,17 @@ struct ProjectionParameters
     return true;
   }
 
+  bool updateNbThreads(rclcpp::Node & node, const int threads)
+  {
+    if (threads < 1) {
+      RCLCPP_WARN(
+        node.get_logger(), "Cannot use less than 1 thread. Using value %d instead.", nb_threads);
+      return false;
+    }
+    nb_threads = threads;
+    return true;
+  }
+
   void update(const TrajectoryPoint & point)
   {
     velocity = point.longitudinal_velocity_mps;
@@ -40,6 +40,7 @@ using multipolygon_t = tier4_autoware_utils::MultiPolygon2d;
 using segment_t = tier4_autoware_utils::Segment2d;
 using linestring_t = tier4_autoware_utils::LineString2d;
 using multilinestring_t = tier4_autoware_utils::MultiLineString2d;
+using box_t = tier4_autoware_utils::Box2d;
 
 struct ObstacleMasks
 {
@@ -22,6 +22,9 @@
 #include <boost/geometry.hpp>
 #include <boost/geometry/algorithms/correct.hpp>
 
+#include <optional>
+#include <vector>
+
 namespace obstacle_velocity_limiter
 {
 
@@ -60,6 +63,15 @@ polygon_t createTrajectoryFootprint(const Trajectory & trajectory, const Float l
   return generateFootprint(ls, lateral_offset);
 }
 
+box_t createBoundingBox(const std::vector<polygon_t> & footprints)
+{
+  box_t bounding_box;
+  boost::geometry::assign_inverse(bounding_box);
+  for (const auto & footprint : footprints)
+    boost::geometry::expand(bounding_box, boost::geometry::return_envelope<box_t>(footprint));
+  return bounding_box;
+}
+
 polygon_t createEnvelopePolygon(
   const Trajectory & trajectory, const size_t start_idx, ProjectionParameters & projection_params)
 {
@@ -117,6 +129,18 @@ void limitVelocity(
   const std::vector<multilinestring_t> & projections, const std::vector<polygon_t> & footprints,
   ProjectionParameters & projection_params, const VelocityParameters & velocity_params)
 {
+  // The collision distances only depend on the input trajectory and can be calculated in parallel
+  std::vector<std::optional<double>> distances(trajectory.points.size());
+#pragma omp parallel for num_threads(projection_params.nb_threads) schedule(dynamic)
+  for (size_t i = 0; i < trajectory.points.size(); ++i) {
+    // First linestring is used to calculate distance
+    if (projections[i].empty()) continue;
+    auto point_projection_params = projection_params;
+    point_projection_params.update(trajectory.points[i]);
+    distances[i] = distanceToClosestCollision(
+      projections[i][0], footprints[i], collision_checker, point_projection_params);
+  }
+
   Float time = 0.0;
   for (size_t i = 0; i < trajectory.points.size(); ++i) {
     auto & trajectory_point = trajectory.points[i];
@@ -126,11 +150,7 @@ void limitVelocity(
         tier4_autoware_utils::calcDistance2d(prev_point, trajectory_point) /
         prev_point.longitudinal_velocity_mps);
     }
-    // First linestring is used to calculate distance
-    if (projections[i].empty()) continue;
-    projection_params.update(trajectory_point);
-    const auto dist_to_collision = distanceToClosestCollision(
-      projections[i][0], footprints[i], collision_checker, projection_params);
+    const auto & dist_to_collision = distances[i];
     if (dist_to_collision) {
       const auto min_feasible_velocity =
         velocity_params.current_ego_velocity - velocity_params.max_deceleration * time;
@@ -145,6 +145,11 @@ rcl_interfaces::msg::SetParametersResult ObstacleVelocityLimiterNode::onParamete
       obstacle_params_.updateRtreeMinPoints(*this, static_cast<int>(parameter.as_int()));
     } else if (parameter.get_name() == ObstacleParameters::RTREE_SEGMENTS_PARAM) {
       obstacle_params_.updateRtreeMinSegments(*this, static_cast<int>(parameter.as_int()));
+    } else if (parameter.get_name() == ObstacleParameters::RASTER_RESOLUTION_PARAM) {
+      if (!obstacle_params_.updateRasterResolution(*this, parameter.as_double())) {
+        result.successful = false;
+        result.reason = "raster resolution must be positive or 0";
+      }
       // Projection parameters
     } else if (parameter.get_name() == ProjectionParameters::MODEL_PARAM) {
       if (!projection_params_.updateModel(*this, parameter.as_string())) {
@@ -156,6 +161,11 @@ rcl_interfaces::msg::SetParametersResult ObstacleVelocityLimiterNode::onParamete
         result.successful = false;
         result.reason = "number of points for projections must be at least 2";
       }
+    } else if (parameter.get_name() == ProjectionParameters::NB_THREADS_PARAM) {
+      if (!projection_params_.updateNbThreads(*this, static_cast<int>(parameter.as_int()))) {
+        result.successful = false;
+        result.reason = "number of threads must be at least 1";
+      }
     } else if (parameter.get_name() == ProjectionParameters::STEER_OFFSET_PARAM) {
       projection_params_.steering_angle_offset = parameter.as_double();
     } else if (parameter.get_name() == ProjectionParameters::DISTANCE_METHOD_PARAM) {
@@ -203,11 +213,15 @@ void ObstacleVelocityLimiterNode::onTrajectory(const Trajectory::ConstSharedPtr
       obstacles, *occupancy_grid_ptr_, *pointcloud_ptr_, obstacle_masks, transform_listener_,
       original_traj.header.frame_id, obstacle_params_);
   }
+  const auto collision_checker =
+    obstacle_params_.raster_resolution > 0.0
+      ? CollisionChecker(
+          obstacles, createBoundingBox(footprint_polygons), obstacle_params_.raster_resolution)
+      : CollisionChecker(
+          obstacles, obstacle_params_.rtree_min_points, obstacle_params_.rtree_min_segments);
   limitVelocity(
-    downsampled_traj,
-    CollisionChecker(
-      obstacles, obstacle_params_.rtree_min_points, obstacle_params_.rtree_min_segments),
-    projected_linestrings, footprint_polygons, projection_params_, velocity_params_);
+    downsampled_traj, collision_checker, projected_linestrings, footprint_polygons,
+    projection_params_, velocity_params_);
   auto safe_trajectory = copyDownsampledVelocity(
     downsampled_traj, original_traj, start_idx, preprocessing_params_.downsample_factor);
   safe_trajectory.header.stamp = now();
@@ -27,6 +27,9 @@
 #endif
 #include <tf2/utils.h>
 
+#include <algorithm>
+#include <cmath>
+
 namespace obstacle_velocity_limiter
 {
 polygon_t createObjectPolygon(
@@ -74,6 +77,92 @@ multipolygon_t createObjectPolygons(
   return polygons;
 }
 
+ObstacleRaster::ObstacleRaster(
+  const Obstacles & obstacles, const box_t & bounds, const double resolution)
+: origin(bounds.min_corner()), resolution(resolution)
+{
+  const auto & max_corner = bounds.max_corner();
+  if (resolution <= 0.0 || max_corner.x() < origin.x() || max_corner.y() < origin.y()) return;
+  width = static_cast<size_t>((max_corner.x() - origin.x()) / resolution) + 1;
+  height = static_cast<size_t>((max_corner.y() - origin.y()) / resolution) + 1;
+  cells.assign(width * height, 0);
+
+  for (const auto & point : obstacles.points) markCell(point.x(), point.y());
+  for (const auto & line : obstacles.lines)
+    for (size_t i = 0; i + 1 < line.size(); ++i) markSegment(line[i], line[i + 1]);
+}
+
+void ObstacleRaster::markCell(const double x, const double y)
+{
+  const auto dx = (x - origin.x()) / resolution;
+  const auto dy = (y - origin.y()) / resolution;
+  if (dx < 0.0 || dy < 0.0) return;
+  const auto i = static_cast<size_t>(dx);
+  const auto j = static_cast<size_t>(dy);
+  if (i < width && j < height) cells[j * width + i] = 1;
+}
+
+void ObstacleRaster::markSegment(const point_t & p1, const point_t & p2)
+{
+  // clip the segment to the raster bounds (Liang-Barsky) to only sample the relevant part
+  const auto min_x = origin.x();
+  const auto min_y = origin.y();
+  const auto max_x = origin.x() + static_cast<double>(width) * resolution;
+  const auto max_y = origin.y() + static_cast<double>(height) * resolution;
+  const auto d = p2 - p1;
+  double t_min = 0.0;
+  double t_max = 1.0;
+  const auto clip = [&](const double p, const double q) {
+    if (p == 0.0) return q >= 0.0;
+    const auto t = q / p;
+    if (p < 0.0)
+      t_min = std::max(t_min, t);
+    else
+      t_max = std::min(t_max, t);
+    return t_min <= t_max;
+  };
+  if (
+    !clip(-d.x(), p1.x() - min_x) || !clip(d.x(), max_x - p1.x()) ||
+    !clip(-d.y(), p1.y() - min_y) || !clip(d.y(), max_y - p1.y()))
+    return;
+  // sample at half the resolution to not skip any traversed cell
+  const auto length = std::hypot(d.x(), d.y()) * (t_max - t_min);
+  const auto nb_samples = static_cast<size_t>(std::ceil(2.0 * length / resolution));
+  for (size_t k = 0; k <= nb_samples; ++k) {
+    const auto ratio =
+      nb_samples == 0 ? 0.0 : static_cast<double>(k) / static_cast<double>(nb_samples);
+    const auto t = t_min + (t_max - t_min) * ratio;
+    markCell(p1.x() + t * d.x(), p1.y() + t * d.y());
+  }
+}
+
+std::vector<point_t> ObstacleRaster::intersections(const polygon_t & polygon) const
+{
+  std::vector<point_t> result;
+  if (cells.empty()) return result;
+  box_t envelope;
+  boost::geometry::envelope(polygon, envelope);
+  const auto to_index = [&](const double v, const double o, const size_t size) {
+    return static_cast<size_t>(std::clamp(
+      std::floor((v - o) / resolution), 0.0, static_cast<double>(size) - 1.0));
+  };
+  const auto i_min = to_index(envelope.min_corner().x(), origin.x(), width);
+  const auto i_max = to_index(envelope.max_corner().x(), origin.x(), width);
+  const auto j_min = to_index(envelope.min_corner().y(), origin.y(), height);
+  const auto j_max = to_index(envelope.max_corner().y(), origin.y(), height);
+  for (auto j = j_min; j <= j_max; ++j) {
+    const auto * row = &cells[j * width];
+    for (auto i = i_min; i <= i_max; ++i) {
+      if (row[i] == 0) continue;
+      const point_t center(
+        origin.x() + (static_cast<double>(i) + 0.5) * resolution,
+        origin.y() + (static_cast<double>(j) + 0.5) * resolution);
+      if (boost::geometry::covered_by(center, polygon)) result.push_back(center);
+    }
+  }
+  return result;
+}
+
 void addSensorObstacles(
   Obstacles & obstacles, const OccupancyGrid & occupancy_grid, const PointCloud & pointcloud,
   const ObstacleMasks & masks, tier4_autoware_utils::TransformListener & transform_listener,
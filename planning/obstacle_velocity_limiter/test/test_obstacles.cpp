@@ -16,6 +16,7 @@
 #include "obstacle_velocity_limiter/types.hpp"
 // cspell: ignore multipolygon, multilinestring
 
+#include <boost/geometry/algorithms/correct.hpp>
 #include <boost/geometry/io/wkt/write.hpp>
 
 #include <gtest/gtest.h>
@@ -76,3 +77,45 @@ TEST(TestObstacles, ObstacleTreeLines)
       std::cout << boost::geometry::wkt(point) << std::endl;
   */
 }
+
+TEST(TestObstacles, ObstacleRaster)
+{
+  using obstacle_velocity_limiter::box_t;
+  using obstacle_velocity_limiter::CollisionChecker;
+  using obstacle_velocity_limiter::Obstacles;
+  using obstacle_velocity_limiter::point_t;
+  using obstacle_velocity_limiter::polygon_t;
+
+  Obstacles obstacles;
+  obstacles.points = {point_t(0.25, 0.25), point_t(2.25, 2.25), point_t(20.0, 20.0)};
+  obstacles.lines = {{point_t(-5.0, -1.25), point_t(5.0, -1.25)}};
+  const CollisionChecker checker(obstacles, box_t(point_t(-2.0, -2.0), point_t(4.0, 4.0)), 0.5);
+  ASSERT_TRUE(checker.obstacle_raster_ptr);
+
+  polygon_t query;
+  query.outer() = {{-1, -1}, {-1, 1}, {1, 1}, {1, -1}, {-1, -1}};
+  boost::geometry::correct(query);
+  auto result = checker.intersections(query);
+  ASSERT_EQ(result.size(), 1lu);
+  EXPECT_DOUBLE_EQ(result[0].x(), 0.25);
+  EXPECT_DOUBLE_EQ(result[0].y(), 0.25);
+
+  // the line is rasterized only inside of the raster bounds
+  query.outer() = {{-10, -2}, {-10, -1}, {10, -1}, {10, -2}, {-10, -2}};
+  boost::geometry::correct(query);
+  result = checker.intersections(query);
+  EXPECT_EQ(result.size(), 13lu);
+  for (const auto & p : result) {
+    EXPECT_DOUBLE_EQ(p.y(), -1.25);
+    EXPECT_GE(p.x(), -2.0);
+    EXPECT_LE(p.x(), 4.5);
+  }
+
+  // points outside of the raster bounds are ignored
+  query.outer() = {{1, 1}, {1, 30}, {30, 30}, {30, 1}, {1, 1}};
+  boost::geometry::correct(query);
+  result = checker.intersections(query);
+  ASSERT_EQ(result.size(), 1lu);
+  EXPECT_DOUBLE_EQ(result[0].x(), 2.25);
+  EXPECT_DOUBLE_EQ(result[0].y(), 2.25);
+}
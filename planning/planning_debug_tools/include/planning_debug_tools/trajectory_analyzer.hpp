@@ -28,10 +28,14 @@
 #include "nav_msgs/msg/odometry.hpp"
 #include "tier4_debug_msgs/msg/float64_multi_array_stamped.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace planning_debug_tools
@@ -42,6 +46,12 @@ using autoware_auto_planning_msgs::msg::Trajectory;
 using nav_msgs::msg::Odometry;
 using planning_debug_tools::msg::TrajectoryDebugInfo;
 
+struct TrajectoryAnalyzerParam
+{
+  double decimation_interval;   // [m] minimum arc length between output points, 0 keeps all
+  bool publish_only_on_change;  // skip the publication when the output did not change
+};
+
 template <typename T>
 class TrajectoryAnalyzer
 {
@@ -50,8 +60,9 @@ class TrajectoryAnalyzer
   using T_ConstSharedPtr = typename T::ConstSharedPtr;
 
 public:
-  TrajectoryAnalyzer(rclcpp::Node * node, const std::string & sub_name)
-  : node_(node), name_(sub_name)
+  TrajectoryAnalyzer(
+    rclcpp::Node * node, const std::string & sub_name, const TrajectoryAnalyzerParam & param)
+  : node_(node), name_(sub_name), param_(param)
   {
     const auto pub_name = sub_name + "/debug_info";
     pub_ = node->create_publisher<TrajectoryDebugInfo>(pub_name, 1);
@@ -70,8 +81,9 @@ public:
   auto operator=(TrajectoryAnalyzer &&) -> TrajectoryAnalyzer & = delete;       // move assignment
 
 public:
-  std::shared_ptr<rclcpp::Node> node_;
+  rclcpp::Node * node_;
   std::string name_;
+  TrajectoryAnalyzerParam param_;
   PublisherType pub_;
   SubscriberType sub_;
   Odometry::ConstSharedPtr ego_kinematics_;
@@ -81,27 +93,113 @@ public:
   {
     if (!ego_kinematics_) return;
     if (points.size() < 3) return;
-
-    const auto & ego_p = ego_kinematics_->pose.pose.position;
+    if (pub_->get_subscription_count() + pub_->get_intra_process_subscription_count() == 0) {
+      return;
+    }
 
     TrajectoryDebugInfo data;
     data.stamp = node_->now();
-    data.size = points.size();
-    data.curvature = motion_utils::calcCurvature(points);
-    const auto arclength_offset = motion_utils::calcSignedArcLength(points, 0, ego_p);
-    data.arclength = calcPathArcLengthArray(points, -arclength_offset);
-    data.velocity = getVelocityArray(points);
-    data.acceleration = getAccelerationArray(points);
-    data.yaw = getYawArray(points);
-
-    if (
-      data.size != data.arclength.size() || data.size != data.velocity.size() ||
-      data.size != data.yaw.size()) {
-      RCLCPP_ERROR(node_->get_logger(), "computation failed.");
+    calcDebugInfo(points, ego_kinematics_->pose.pose.position, data);
+
+    if (param_.publish_only_on_change && isSameDebugInfo(data, prev_data_)) {
       return;
     }
 
     pub_->publish(data);
+    if (param_.publish_only_on_change) {
+      prev_data_ = std::move(data);
+    }
+  }
+
+private:
+  TrajectoryDebugInfo prev_data_;
+  std::vector<double> segment_lengths_;
+  std::vector<double> arclengths_;
+
+  // All the fields in one pass: the segment lengths are shared by the arc length, the curvature
+  // (Menger curvature as motion_utils::calcCurvature) and the acceleration.
+  template <typename P>
+  void calcDebugInfo(
+    const P & points, const geometry_msgs::msg::Point & ego_p, TrajectoryDebugInfo & data)
+  {
+    const size_t n = points.size();
+    segment_lengths_.resize(n - 1);
+    arclengths_.resize(n);
+    arclengths_.front() = 0.0;
+    for (size_t i = 0; i + 1 < n; ++i) {
+      segment_lengths_.at(i) = calcDistance2d(getPoint(points.at(i)), getPoint(points.at(i + 1)));
+      arclengths_.at(i + 1) = arclengths_.at(i) + segment_lengths_.at(i);
+    }
+
+    // same as motion_utils::calcSignedArcLength(points, 0, ego_p)
+    const size_t ego_seg_idx = motion_utils::findNearestSegmentIndex(points, ego_p);
+    const double arclength_offset =
+      arclengths_.at(ego_seg_idx) +
+      motion_utils::calcLongitudinalOffsetToSegment(points, ego_seg_idx, ego_p);
+
+    const auto calcSegmentAcceleration = [&](const size_t i) {
+      const double ds = segment_lengths_.at(i);
+      if (ds == 0.0) return 0.0;
+      const double prev_vel = getVelocity(points.at(i));
+      const double next_vel = getVelocity(points.at(i + 1));
+      return (next_vel * next_vel - prev_vel * prev_vel) / 2.0 / ds;
+    };
+    const auto calcCurvatureAt = [&](size_t i) {
+      i = std::clamp<size_t>(i, 1, n - 2);
+      const auto & p1 = getPoint(points.at(i - 1));
+      const auto & p2 = getPoint(points.at(i));
+      const auto & p3 = getPoint(points.at(i + 1));
+      const double denominator =
+        segment_lengths_.at(i - 1) * segment_lengths_.at(i) * calcDistance2d(p1, p3);
+      if (std::fabs(denominator) < 1e-10) return 0.0;
+      return 2.0 * ((p2.x - p1.x) * (p3.y - p1.y) - (p2.y - p1.y) * (p3.x - p1.x)) / denominator;
+    };
+
+    data.arclength.clear();
+    data.curvature.clear();
+    data.velocity.clear();
+    data.acceleration.clear();
+    data.yaw.clear();
+    double last_arclength = -std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < n; ++i) {
+      const bool is_end = i == 0 || i == n - 1;
+      if (!is_end && arclengths_.at(i) - last_arclength < param_.decimation_interval) {
+        continue;
+      }
+      last_arclength = arclengths_.at(i);
+
+      data.arclength.push_back(arclengths_.at(i) - arclength_offset);
+      data.curvature.push_back(calcCurvatureAt(i));
+      data.velocity.push_back(getVelocity(points.at(i)));
+      data.yaw.push_back(getYaw(points.at(i)));
+      // Ignore the last two acceleration values which are negative infinity since the path end
+      // velocity is always 0 by motion_velocity_smoother. NOTE: Path end velocity affects the last
+      // two acceleration values.
+      if (i == 0) {
+        data.acceleration.push_back(calcSegmentAcceleration(0));
+      } else if (i + 2 >= n) {
+        data.acceleration.push_back(0.0);
+      } else {
+        data.acceleration.push_back(
+          (calcSegmentAcceleration(i - 1) + calcSegmentAcceleration(i)) / 2.0);
+      }
+    }
+    data.size = data.arclength.size();
+  }
+
+  static bool isSameDebugInfo(const TrajectoryDebugInfo & a, const TrajectoryDebugInfo & b)
+  {
+    constexpr double epsilon = 1e-3;
+    const auto isSame = [&](const std::vector<double> & va, const std::vector<double> & vb) {
+      if (va.size() != vb.size()) return false;
+      for (size_t i = 0; i < va.size(); ++i) {
+        if (std::abs(va.at(i) - vb.at(i)) > epsilon) return false;
+      }
+      return true;
+    };
+    return a.size == b.size && isSame(a.arclength, b.arclength) &&
+           isSame(a.curvature, b.curvature) && isSame(a.velocity, b.velocity) &&
+           isSame(a.acceleration, b.acceleration) && isSame(a.yaw, b.yaw);
   }
 };
 
@@ -25,18 +25,23 @@ TrajectoryAnalyzerNode::TrajectoryAnalyzerNode(const rclcpp::NodeOptions & optio
     declare_parameter<TopicNames>("path_with_lane_id_topics", TopicNames{});
   const auto trajectory_topics = declare_parameter<TopicNames>("trajectory_topics", TopicNames{});
 
+  TrajectoryAnalyzerParam param;
+  param.decimation_interval = declare_parameter<double>("decimation_interval", 0.0);
+  param.publish_only_on_change = declare_parameter<bool>("publish_only_on_change", false);
+
   for (const auto & s : path_topics) {
-    path_analyzers_.push_back(std::make_shared<TrajectoryAnalyzer<Path>>(this, s));
+    path_analyzers_.push_back(std::make_shared<TrajectoryAnalyzer<Path>>(this, s, param));
     RCLCPP_INFO(get_logger(), "path_topics: %s", s.c_str());
   }
   for (const auto & s : path_with_lane_id_topics) {
     path_with_lane_id_analyzers_.push_back(
-      std::make_shared<TrajectoryAnalyzer<PathWithLaneId>>(this, s));
+      std::make_shared<TrajectoryAnalyzer<PathWithLaneId>>(this, s, param));
     RCLCPP_INFO(get_logger(), "path_with_lane_id_topics: %s", s.c_str());
   }
 
   for (const auto & s : trajectory_topics) {
-    trajectory_analyzers_.push_back(std::make_shared<TrajectoryAnalyzer<Trajectory>>(this, s));
+    trajectory_analyzers_.push_back(
+      std::make_shared<TrajectoryAnalyzer<Trajectory>>(this, s, param));
     RCLCPP_INFO(get_logger(), "trajectory_topics: %s", s.c_str());
   }
 
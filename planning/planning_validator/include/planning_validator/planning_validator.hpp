@@ -28,6 +28,7 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 
 namespace planning_validator
 {
@@ -71,6 +72,21 @@ public:
   bool checkValidVelocityDeviation(const Trajectory & trajectory);
   bool checkValidDistanceDeviation(const Trajectory & trajectory);
 
+  // Evaluate the metrics computed in advance, e.g. by calcTrajectoryMetrics().
+  bool checkValidInterval(const Trajectory & trajectory, const std::pair<double, size_t> & metric);
+  bool checkValidRelativeAngle(
+    const Trajectory & trajectory, const std::pair<double, size_t> & metric);
+  bool checkValidCurvature(const Trajectory & trajectory, const std::pair<double, size_t> & metric);
+  bool checkValidLateralAcceleration(
+    const Trajectory & trajectory, const std::pair<double, size_t> & metric);
+  bool checkValidMaxLongitudinalAcceleration(
+    const Trajectory & trajectory, const std::pair<double, size_t> & metric);
+  bool checkValidMinLongitudinalAcceleration(
+    const Trajectory & trajectory, const std::pair<double, size_t> & metric);
+  bool checkValidSteering(const Trajectory & trajectory, const std::pair<double, size_t> & metric);
+  bool checkValidSteeringRate(
+    const Trajectory & trajectory, const std::pair<double, size_t> & metric);
+
 private:
   void setupDiag();
 
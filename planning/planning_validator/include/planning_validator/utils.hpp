@@ -60,6 +60,25 @@ std::pair<double, size_t> calcMaxSteeringAngles(
 std::pair<double, size_t> calcMaxSteeringRates(
   const Trajectory & trajectory, const double wheelbase);
 
+// Metrics of all the trajectory checks, computed in a single pass over the trajectory.
+// The metrics on the resampled trajectory are indexed on `resampled`.
+struct TrajectoryMetrics
+{
+  std::pair<double, size_t> max_interval_distance{0.0, 0};
+  std::pair<double, size_t> max_lateral_acc{0.0, 0};
+  std::pair<double, size_t> max_longitudinal_acc{0.0, 0};
+  std::pair<double, size_t> min_longitudinal_acc{0.0, 0};
+
+  Trajectory resampled;
+  std::pair<double, size_t> max_relative_angle{0.0, 0};
+  std::pair<double, size_t> max_curvature{0.0, 0};
+  std::pair<double, size_t> max_steering{0.0, 0};
+  std::pair<double, size_t> max_steering_rate{0.0, 0};
+};
+
+TrajectoryMetrics calcTrajectoryMetrics(
+  const Trajectory & trajectory, const double min_interval, const double wheelbase);
+
 bool checkFinite(const TrajectoryPoint & point);
 
 void shiftPose(geometry_msgs::msg::Pose & pose, double longitudinal);
@@ -243,23 +243,27 @@ void PlanningValidator::validate(const Trajectory & trajectory)
 
   auto & s = validation_status_;
 
+  // use resampled trajectory for the relative angle, curvature and steering metrics because they
+  // can not be evaluated for closed points.
+  // Note: all the metrics are computed in a single pass.
+  constexpr auto min_interval = 1.0;
+  const auto metrics = calcTrajectoryMetrics(trajectory, min_interval, vehicle_info_.wheel_base_m);
+  const auto & resampled = metrics.resampled;
+
   s.is_valid_finite_value = checkValidFiniteValue(trajectory);
-  s.is_valid_interval = checkValidInterval(trajectory);
-  s.is_valid_lateral_acc = checkValidLateralAcceleration(trajectory);
-  s.is_valid_longitudinal_max_acc = checkValidMaxLongitudinalAcceleration(trajectory);
-  s.is_valid_longitudinal_min_acc = checkValidMinLongitudinalAcceleration(trajectory);
+  s.is_valid_interval = checkValidInterval(trajectory, metrics.max_interval_distance);
+  s.is_valid_lateral_acc = checkValidLateralAcceleration(trajectory, metrics.max_lateral_acc);
+  s.is_valid_longitudinal_max_acc =
+    checkValidMaxLongitudinalAcceleration(trajectory, metrics.max_longitudinal_acc);
+  s.is_valid_longitudinal_min_acc =
+    checkValidMinLongitudinalAcceleration(trajectory, metrics.min_longitudinal_acc);
   s.is_valid_velocity_deviation = checkValidVelocityDeviation(trajectory);
   s.is_valid_distance_deviation = checkValidDistanceDeviation(trajectory);
 
-  // use resampled trajectory because the following metrics can not be evaluated for closed points.
-  // Note: do not interpolate to keep original trajectory shape.
-  constexpr auto min_interval = 1.0;
-  const auto resampled = resampleTrajectory(trajectory, min_interval);
-
-  s.is_valid_relative_angle = checkValidRelativeAngle(resampled);
-  s.is_valid_curvature = checkValidCurvature(resampled);
-  s.is_valid_steering = checkValidSteering(resampled);
-  s.is_valid_steering_rate = checkValidSteeringRate(resampled);
+  s.is_valid_relative_angle = checkValidRelativeAngle(resampled, metrics.max_relative_angle);
+  s.is_valid_curvature = checkValidCurvature(resampled, metrics.max_curvature);
+  s.is_valid_steering = checkValidSteering(resampled, metrics.max_steering);
+  s.is_valid_steering_rate = checkValidSteeringRate(resampled, metrics.max_steering_rate);
 
   s.invalid_count = isAllValid(s) ? 0 : s.invalid_count + 1;
 }
@@ -274,7 +278,13 @@ bool PlanningValidator::checkValidFiniteValue(const Trajectory & trajectory)
 
 bool PlanningValidator::checkValidInterval(const Trajectory & trajectory)
 {
-  const auto [max_interval_distance, i] = calcMaxIntervalDistance(trajectory);
+  return checkValidInterval(trajectory, calcMaxIntervalDistance(trajectory));
+}
+
+bool PlanningValidator::checkValidInterval(
+  const Trajectory & trajectory, const std::pair<double, size_t> & metric)
+{
+  const auto & [max_interval_distance, i] = metric;
   validation_status_.max_interval_distance = max_interval_distance;
 
   if (max_interval_distance > validation_params_.interval_threshold) {
@@ -291,7 +301,13 @@ bool PlanningValidator::checkValidInterval(const Trajectory & trajectory)
 
 bool PlanningValidator::checkValidRelativeAngle(const Trajectory & trajectory)
 {
-  const auto [max_relative_angle, i] = calcMaxRelativeAngles(trajectory);
+  return checkValidRelativeAngle(trajectory, calcMaxRelativeAngles(trajectory));
+}
+
+bool PlanningValidator::checkValidRelativeAngle(
+  const Trajectory & trajectory, const std::pair<double, size_t> & metric)
+{
+  const auto & [max_relative_angle, i] = metric;
   validation_status_.max_relative_angle = max_relative_angle;
 
   if (max_relative_angle > validation_params_.relative_angle_threshold) {
@@ -308,7 +324,13 @@ bool PlanningValidator::checkValidRelativeAngle(const Trajectory & trajectory)
 
 bool PlanningValidator::checkValidCurvature(const Trajectory & trajectory)
 {
-  const auto [max_curvature, i] = calcMaxCurvature(trajectory);
+  return checkValidCurvature(trajectory, calcMaxCurvature(trajectory));
+}
+
+bool PlanningValidator::checkValidCurvature(
+  const Trajectory & trajectory, const std::pair<double, size_t> & metric)
+{
+  const auto & [max_curvature, i] = metric;
   validation_status_.max_curvature = max_curvature;
   if (max_curvature > validation_params_.curvature_threshold) {
     const auto & p = trajectory.points;
@@ -324,7 +346,13 @@ bool PlanningValidator::checkValidCurvature(const Trajectory & trajectory)
 
 bool PlanningValidator::checkValidLateralAcceleration(const Trajectory & trajectory)
 {
-  const auto [max_lateral_acc, i] = calcMaxLateralAcceleration(trajectory);
+  return checkValidLateralAcceleration(trajectory, calcMaxLateralAcceleration(trajectory));
+}
+
+bool PlanningValidator::checkValidLateralAcceleration(
+  const Trajectory & trajectory, const std::pair<double, size_t> & metric)
+{
+  const auto & [max_lateral_acc, i] = metric;
   validation_status_.max_lateral_acc = max_lateral_acc;
   if (max_lateral_acc > validation_params_.lateral_acc_threshold) {
     debug_pose_publisher_->pushPoseMarker(trajectory.points.at(i), "lateral_acceleration");
@@ -335,7 +363,13 @@ bool PlanningValidator::checkValidLateralAcceleration(const Trajectory & traject
 
 bool PlanningValidator::checkValidMinLongitudinalAcceleration(const Trajectory & trajectory)
 {
-  const auto [min_longitudinal_acc, i] = getMinLongitudinalAcc(trajectory);
+  return checkValidMinLongitudinalAcceleration(trajectory, getMinLongitudinalAcc(trajectory));
+}
+
+bool PlanningValidator::checkValidMinLongitudinalAcceleration(
+  const Trajectory & trajectory, const std::pair<double, size_t> & metric)
+{
+  const auto & [min_longitudinal_acc, i] = metric;
   validation_status_.min_longitudinal_acc = min_longitudinal_acc;
 
   if (min_longitudinal_acc < validation_params_.longitudinal_min_acc_threshold) {
@@ -347,7 +381,13 @@ bool PlanningValidator::checkValidMinLongitudinalAcceleration(const Trajectory &
 
 bool PlanningValidator::checkValidMaxLongitudinalAcceleration(const Trajectory & trajectory)
 {
-  const auto [max_longitudinal_acc, i] = getMaxLongitudinalAcc(trajectory);
+  return checkValidMaxLongitudinalAcceleration(trajectory, getMaxLongitudinalAcc(trajectory));
+}
+
+bool PlanningValidator::checkValidMaxLongitudinalAcceleration(
+  const Trajectory & trajectory, const std::pair<double, size_t> & metric)
+{
+  const auto & [max_longitudinal_acc, i] = metric;
   validation_status_.max_longitudinal_acc = max_longitudinal_acc;
 
   if (max_longitudinal_acc > validation_params_.longitudinal_max_acc_threshold) {
@@ -359,7 +399,14 @@ bool PlanningValidator::checkValidMaxLongitudinalAcceleration(const Trajectory &
 
 bool PlanningValidator::checkValidSteering(const Trajectory & trajectory)
 {
-  const auto [max_steering, i] = calcMaxSteeringAngles(trajectory, vehicle_info_.wheel_base_m);
+  return checkValidSteering(
+    trajectory, calcMaxSteeringAngles(trajectory, vehicle_info_.wheel_base_m));
+}
+
+bool PlanningValidator::checkValidSteering(
+  const Trajectory & trajectory, const std::pair<double, size_t> & metric)
+{
+  const auto & [max_steering, i] = metric;
   validation_status_.max_steering = max_steering;
 
   if (max_steering > validation_params_.steering_threshold) {
@@ -371,7 +418,14 @@ bool PlanningValidator::checkValidSteering(const Trajectory & trajectory)
 
 bool PlanningValidator::checkValidSteeringRate(const Trajectory & trajectory)
 {
-  const auto [max_steering_rate, i] = calcMaxSteeringRates(trajectory, vehicle_info_.wheel_base_m);
+  return checkValidSteeringRate(
+    trajectory, calcMaxSteeringRates(trajectory, vehicle_info_.wheel_base_m));
+}
+
+bool PlanningValidator::checkValidSteeringRate(
+  const Trajectory & trajectory, const std::pair<double, size_t> & metric)
+{
+  const auto & [max_steering_rate, i] = metric;
   validation_status_.max_steering_rate = max_steering_rate;
 
   if (max_steering_rate > validation_params_.steering_rate_threshold) {
@@ -44,6 +44,16 @@ void takeSmaller(double & v_min, size_t & i_min, double v, size_t i)
     i_min = i;
   }
 }
+double calcCurvatureOrZero(
+  const TrajectoryPoint & p1, const TrajectoryPoint & p2, const TrajectoryPoint & p3)
+{
+  try {
+    return tier4_autoware_utils::calcCurvature(getPoint(p1), getPoint(p2), getPoint(p3));
+  } catch (...) {
+    // maybe distance is too close
+    return 0.0;
+  }
+}
 }  // namespace
 
 std::pair<double, size_t> getMaxValAndIdx(const std::vector<double> & v)
@@ -269,6 +279,104 @@ std::pair<double, size_t> calcMaxSteeringRates(
   return {max_steering_rate, max_index};
 }
 
+TrajectoryMetrics calcTrajectoryMetrics(
+  const Trajectory & trajectory, const double min_interval, const double wheelbase)
+{
+  TrajectoryMetrics m;
+  auto & resampled = m.resampled.points;
+  m.resampled.header = trajectory.header;
+
+  if (trajectory.points.empty()) {
+    return m;
+  }
+
+  const auto & points = trajectory.points;
+
+  // steering angle of the previous resampled point, zero at both ends as in calcSteeringAngles()
+  double prev_steering = 0.0;
+
+  // accumulates the metrics of the resampled window (n-3, n-2, n-1) where n is the resampled size
+  const auto update_resampled_metrics = [&]() {
+    const size_t i = resampled.size() - 3;
+    const auto & p1 = resampled.at(i);
+    const auto & p2 = resampled.at(i + 1);
+    const auto & p3 = resampled.at(i + 2);
+
+    const auto angle_a = tier4_autoware_utils::calcAzimuthAngle(getPoint(p1), getPoint(p2));
+    const auto angle_b = tier4_autoware_utils::calcAzimuthAngle(getPoint(p2), getPoint(p3));
+    const auto relative_angle = std::abs(tier4_autoware_utils::normalizeRadian(angle_b - angle_a));
+    takeBigger(m.max_relative_angle.first, m.max_relative_angle.second, relative_angle, i);
+
+    double k = 0.0;
+    try {
+      k = tier4_autoware_utils::calcCurvature(getPoint(p1), getPoint(p2), getPoint(p3));
+      takeBigger(m.max_curvature.first, m.max_curvature.second, std::abs(k), i + 1);
+    } catch (...) {
+      // maybe distance is too close
+    }
+
+    const auto steering = std::atan(k * wheelbase);
+    takeBigger(m.max_steering.first, m.max_steering.second, std::abs(steering), i + 1);
+    return steering;
+  };
+
+  // steering rate on the resampled segment (i, i + 1)
+  const auto update_steering_rate = [&](const size_t i, const double steer_next) {
+    const auto & p_prev = resampled.at(i);
+    const auto & p_next = resampled.at(i + 1);
+    const auto delta_s = calcDistance2d(p_prev, p_next);
+    const auto v = 0.5 * (p_next.longitudinal_velocity_mps + p_prev.longitudinal_velocity_mps);
+    const auto dt = delta_s / std::max(v, 1.0e-5);
+    const auto steer_rate = (steer_next - prev_steering) / dt;
+    takeBigger(m.max_steering_rate.first, m.max_steering_rate.second, steer_rate, i);
+    prev_steering = steer_next;
+  };
+
+  const auto update_longitudinal_acc = [&](const TrajectoryPoint & p, const size_t i) {
+    auto & max_acc = m.max_longitudinal_acc;
+    auto & min_acc = m.min_longitudinal_acc;
+    takeBigger(max_acc.first, max_acc.second, p.acceleration_mps2, i);
+    takeSmaller(min_acc.first, min_acc.second, p.acceleration_mps2, i);
+  };
+
+  resampled.push_back(points.front());
+  update_longitudinal_acc(points.front(), 0);
+
+  for (size_t i = 1; i < points.size(); ++i) {
+    const auto & prev = points.at(i - 1);
+    const auto & curr = points.at(i);
+
+    const auto d = calcDistance2d(curr, prev);
+    takeBigger(m.max_interval_distance.first, m.max_interval_distance.second, std::abs(d), i);
+
+    update_longitudinal_acc(curr, i);
+
+    // lateral acceleration at the previous point, which is zero at both ends
+    if (2 <= i) {
+      const auto k = calcCurvatureOrZero(points.at(i - 2), prev, curr);
+      const auto v = prev.longitudinal_velocity_mps;
+      const auto lat_acc = v * v * k;
+      takeBigger(m.max_lateral_acc.first, m.max_lateral_acc.second, std::abs(lat_acc), i - 1);
+    }
+
+    // Note: do not interpolate to keep original trajectory shape.
+    if (calcDistance2d(resampled.back(), curr) > min_interval) {
+      resampled.push_back(curr);
+      if (3 <= resampled.size()) {
+        const auto steering = update_resampled_metrics();
+        update_steering_rate(resampled.size() - 3, steering);
+      }
+    }
+  }
+
+  // the last resampled segment ends with a zero steering angle
+  if (2 <= resampled.size()) {
+    update_steering_rate(resampled.size() - 2, 0.0);
+  }
+
+  return m;
+}
+
 bool checkFinite(const TrajectoryPoint & point)
 {
   const auto & p = point.pose.position;
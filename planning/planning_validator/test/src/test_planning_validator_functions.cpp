@@ -14,10 +14,12 @@
 
 #include "planning_validator/debug_marker.hpp"
 #include "planning_validator/planning_validator.hpp"
+#include "planning_validator/utils.hpp"
 #include "test_planning_validator_helper.hpp"
 
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <string>
 
 using autoware_auto_planning_msgs::msg::Trajectory;
@@ -159,3 +161,36 @@ TEST(PlanningValidatorTestSuite, checkValidRelativeAngleFunction)
     ASSERT_FALSE(validator->checkValidRelativeAngle(invalid_traj));
   }
 }
+
+TEST(PlanningValidatorTestSuite, calcTrajectoryMetricsFunction)
+{
+  using planning_validator::calcTrajectoryMetrics;
+  using planning_validator::resampleTrajectory;
+
+  /**
+   * zigzag trajectory with some closed points which are removed by the resampling
+   **/
+  Trajectory traj = generateTrajectory(0.6);
+  for (size_t i = 0; i < traj.points.size(); ++i) {
+    auto & p = traj.points.at(i);
+    p.pose.position.y = 0.3 * std::sin(static_cast<double>(i));
+    p.longitudinal_velocity_mps = 1.0 + 0.5 * static_cast<double>(i % 4);
+    p.acceleration_mps2 = static_cast<double>(i % 5) - 2.0;
+  }
+
+  constexpr auto min_interval = 1.0;
+  constexpr auto wheelbase = 2.7;
+  const auto metrics = calcTrajectoryMetrics(traj, min_interval, wheelbase);
+  const auto resampled = resampleTrajectory(traj, min_interval);
+
+  ASSERT_EQ(metrics.resampled.points.size(), resampled.points.size());
+  EXPECT_EQ(metrics.max_interval_distance, planning_validator::calcMaxIntervalDistance(traj));
+  EXPECT_EQ(metrics.max_lateral_acc, planning_validator::calcMaxLateralAcceleration(traj));
+  EXPECT_EQ(metrics.max_longitudinal_acc, planning_validator::getMaxLongitudinalAcc(traj));
+  EXPECT_EQ(metrics.min_longitudinal_acc, planning_validator::getMinLongitudinalAcc(traj));
+  EXPECT_EQ(metrics.max_relative_angle, planning_validator::calcMaxRelativeAngles(resampled));
+  EXPECT_EQ(metrics.max_curvature, planning_validator::calcMaxCurvature(resampled));
+  EXPECT_EQ(metrics.max_steering, planning_validator::calcMaxSteeringAngles(resampled, wheelbase));
+  EXPECT_EQ(
+    metrics.max_steering_rate, planning_validator::calcMaxSteeringRates(resampled, wheelbase));
+}
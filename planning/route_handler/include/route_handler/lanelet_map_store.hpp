@@ -0,0 +1,91 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROUTE_HANDLER__LANELET_MAP_STORE_HPP_
+#define ROUTE_HANDLER__LANELET_MAP_STORE_HPP_
+
+#include <autoware_auto_mapping_msgs/msg/had_map_bin.hpp>
+
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_routing/RoutingGraph.h>
+#include <lanelet2_routing/RoutingGraphContainer.h>
+#include <lanelet2_traffic_rules/TrafficRules.h>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace route_handler
+{
+using autoware_auto_mapping_msgs::msg::HADMapBin;
+
+/**
+ * @brief The lanelet map of a HADMapBin message and the routing graphs built on it.
+ * @note it is shared by all the RouteHandler of the process loaded with the same message, so the
+ * map and the graphs must not be modified.
+ */
+struct LaneletMapData
+{
+  lanelet::LaneletMapPtr lanelet_map_ptr;
+  lanelet::traffic_rules::TrafficRulesPtr traffic_rules_ptr;
+  lanelet::routing::RoutingGraphPtr routing_graph_ptr;
+  std::shared_ptr<const lanelet::routing::RoutingGraphContainer> overall_graphs_ptr;
+  lanelet::ConstLanelets road_lanelets;
+  lanelet::ConstLanelets shoulder_lanelets;
+};
+
+/**
+ * @brief Process-wide store of the lanelet maps, keyed by a hash of the HADMapBin message.
+ * The composable nodes of one container receive the same map message, so only the first one to
+ * request it deserializes it and builds the routing graphs. The others wait for it and share the
+ * result. A map is released when no one holds its data anymore.
+ */
+class LaneletMapStore
+{
+public:
+  /**
+   * @brief get the map data of the message, building it if it is not in the store yet
+   * @note thread safe, concurrent requests of the same map build it only once
+   */
+  static std::shared_ptr<const LaneletMapData> get(const HADMapBin & map_msg);
+
+  /**
+   * @brief build the map data of the message without using the store
+   */
+  static std::shared_ptr<LaneletMapData> build(const HADMapBin & map_msg);
+
+private:
+  using Key = std::pair<size_t, size_t>;  // hash and size of the map binary
+
+  struct KeyHash
+  {
+    size_t operator()(const Key & key) const { return key.first ^ (key.second << 1); }
+  };
+
+  struct Slot
+  {
+    std::mutex mutex;  // held while the map is built
+    std::weak_ptr<const LaneletMapData> data;
+  };
+
+  static Key createKey(const HADMapBin & map_msg);
+
+  static std::mutex mutex_;  // mutex for slots_
+  static std::unordered_map<Key, std::shared_ptr<Slot>, KeyHash> slots_;
+};
+}  // namespace route_handler
+
+#endif  // ROUTE_HANDLER__LANELET_MAP_STORE_HPP_
@@ -0,0 +1,80 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROUTE_HANDLER__LANELET_SEQUENCE_CACHE_HPP_
+#define ROUTE_HANDLER__LANELET_SEQUENCE_CACHE_HPP_
+
+#include <lanelet2_core/LaneletMap.h>
+
+#include <boost/optional.hpp>
+
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <tuple>
+
+namespace route_handler
+{
+/**
+ * @brief Memoized lanelet sequences of one route, keyed by the start lanelet, the sequence
+ * direction and its minimum length. The sequences only depend on the route and the map, so the
+ * cache must be replaced when one of them changes.
+ * @note safe for concurrent readers and writers
+ */
+class LaneletSequenceCache
+{
+public:
+  enum class Type { AFTER = 0, UP_TO, SHOULDER_AFTER, SHOULDER_UP_TO };
+
+  boost::optional<lanelet::ConstLanelets> get(
+    const Type type, const lanelet::ConstLanelet & lanelet, const double min_length) const
+  {
+    const std::shared_lock<std::shared_mutex> lock(mutex_);
+    const auto itr = sequences_.find(createKey(type, lanelet, min_length));
+    if (itr == sequences_.end()) {
+      return boost::none;
+    }
+    return itr->second;
+  }
+
+  void set(
+    const Type type, const lanelet::ConstLanelet & lanelet, const double min_length,
+    const lanelet::ConstLanelets & sequence)
+  {
+    const std::unique_lock<std::shared_mutex> lock(mutex_);
+    // the lengths asked for by the callers are usually a few constants, this only bounds the
+    // memory used when they are not
+    if (sequences_.size() >= max_size) {
+      sequences_.clear();
+    }
+    sequences_.emplace(createKey(type, lanelet, min_length), sequence);
+  }
+
+private:
+  using Key = std::tuple<Type, lanelet::Id, bool, double>;
+
+  static constexpr size_t max_size{1000};
+
+  static Key createKey(
+    const Type type, const lanelet::ConstLanelet & lanelet, const double min_length)
+  {
+    return {type, lanelet.id(), lanelet.inverted(), min_length};
+  }
+
+  mutable std::shared_mutex mutex_;
+  std::map<Key, lanelet::ConstLanelets> sequences_;
+};
+}  // namespace route_handler
+
+#endif  // ROUTE_HANDLER__LANELET_SEQUENCE_CACHE_HPP_
@@ -15,6 +15,9 @@
 #ifndef ROUTE_HANDLER__ROUTE_HANDLER_HPP_
 #define ROUTE_HANDLER__ROUTE_HANDLER_HPP_
 
+#include "route_handler/lanelet_map_store.hpp"
+#include "route_handler/lanelet_sequence_cache.hpp"
+
 #include <lanelet2_extension/utility/query.hpp>
 #include <motion_utils/motion_utils.hpp>
 #include <rclcpp/rclcpp.hpp>
@@ -36,8 +39,11 @@
 #include <lanelet2_routing/RoutingGraphContainer.h>
 #include <lanelet2_traffic_rules/TrafficRulesFactory.h>
 
+#include <boost/geometry/index/rtree.hpp>
+
 #include <limits>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace route_handler
@@ -62,10 +68,12 @@ class RouteHandler
 {
 public:
   RouteHandler() = default;
-  explicit RouteHandler(const HADMapBin & map_msg);
+  explicit RouteHandler(const HADMapBin & map_msg, const bool use_shared_map = true);
 
   // non-const methods
-  void setMap(const HADMapBin & map_msg);
+  // the map and routing graphs are shared with the other handlers of the process loaded with the
+  // same map unless use_shared_map is false, in which case the handler may modify its own map
+  void setMap(const HADMapBin & map_msg, const bool use_shared_map = true);
   void setRoute(const LaneletRoute & route_msg);
   void setRouteLanelets(const lanelet::ConstLanelets & path_lanelets);
 
@@ -314,17 +322,25 @@ public:
 
 private:
   // MUST
+  std::shared_ptr<const LaneletMapData> map_data_ptr_;
   lanelet::routing::RoutingGraphPtr routing_graph_ptr_;
   lanelet::traffic_rules::TrafficRulesPtr traffic_rules_ptr_;
   std::shared_ptr<const lanelet::routing::RoutingGraphContainer> overall_graphs_ptr_;
   lanelet::LaneletMapPtr lanelet_map_ptr_;
   lanelet::ConstLanelets road_lanelets_;
   lanelet::ConstLanelets route_lanelets_;
+  // bounding boxes of route_lanelets_ with their index
+  using LaneletBox = std::pair<tier4_autoware_utils::Box2d, size_t>;
+  boost::geometry::index::rtree<LaneletBox, boost::geometry::index::rstar<16>>
+    route_lanelets_rtree_;
   lanelet::ConstLanelets preferred_lanelets_;
   lanelet::ConstLanelets start_lanelets_;
   lanelet::ConstLanelets goal_lanelets_;
   lanelet::ConstLanelets shoulder_lanelets_;
   LaneletRoute route_msg_;
+  // shared by the copies of the handler until one of them changes its route or map
+  std::shared_ptr<LaneletSequenceCache> lanelet_sequence_cache_{
+    std::make_shared<LaneletSequenceCache>()};
 
   rclcpp::Logger logger_{rclcpp::get_logger("route_handler")};
 
@@ -334,6 +350,7 @@ private:
 
   // non-const methods
   void setLaneletsFromRouteMsg();
+  void updateRouteLaneletsRtree();
 
   // const methods
   // for routing
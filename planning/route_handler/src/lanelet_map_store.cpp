@@ -0,0 +1,114 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "route_handler/lanelet_map_store.hpp"
+
+#include <lanelet2_extension/utility/message_conversion.hpp>
+#include <lanelet2_extension/utility/query.hpp>
+
+#include <lanelet2_traffic_rules/TrafficRulesFactory.h>
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <string_view>
+
+namespace route_handler
+{
+std::mutex LaneletMapStore::mutex_;
+std::unordered_map<
+  LaneletMapStore::Key, std::shared_ptr<LaneletMapStore::Slot>, LaneletMapStore::KeyHash>
+  LaneletMapStore::slots_;
+
+std::shared_ptr<const LaneletMapData> LaneletMapStore::get(const HADMapBin & map_msg)
+{
+  const auto key = createKey(map_msg);
+
+  std::shared_ptr<Slot> slot;
+  {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    // release the slots of the maps no one uses anymore
+    for (auto itr = slots_.begin(); itr != slots_.end();) {
+      if (itr->second.use_count() == 1 && itr->second->mutex.try_lock()) {
+        const bool is_expired = itr->second->data.expired();
+        itr->second->mutex.unlock();
+        if (is_expired) {
+          itr = slots_.erase(itr);
+          continue;
+        }
+      }
+      ++itr;
+    }
+    auto & slot_ptr = slots_[key];
+    if (!slot_ptr) {
+      slot_ptr = std::make_shared<Slot>();
+    }
+    slot = slot_ptr;
+  }
+
+  // only the slot of this map is locked while it is built, so other maps can be requested
+  const std::lock_guard<std::mutex> lock(slot->mutex);
+  if (const auto data = slot->data.lock()) {
+    return data;
+  }
+  std::shared_ptr<const LaneletMapData> data = build(map_msg);
+  slot->data = data;
+  return data;
+}
+
+std::shared_ptr<LaneletMapData> LaneletMapStore::build(const HADMapBin & map_msg)
+{
+  auto data = std::make_shared<LaneletMapData>();
+  data->lanelet_map_ptr = std::make_shared<lanelet::LaneletMap>();
+  lanelet::utils::conversion::fromBinMsg(map_msg, data->lanelet_map_ptr);
+  const auto & lanelet_map = *data->lanelet_map_ptr;
+
+  lanelet::ConstLanelets all_lanelets = lanelet::utils::query::laneletLayer(data->lanelet_map_ptr);
+  data->road_lanelets = lanelet::utils::query::roadLanelets(all_lanelets);
+  data->shoulder_lanelets = lanelet::utils::query::shoulderLanelets(all_lanelets);
+  // the centerlines are computed and cached on the first access, do it before the graphs are built
+  // concurrently and the map is shared
+  for (const auto & lanelet : all_lanelets) {
+    lanelet.centerline();
+  }
+
+  // the vehicle graph is both the routing graph and the first graph of the overall graphs (the
+  // message conversion would build a second, identical one). it is built at the same time as the
+  // pedestrian graph.
+  data->traffic_rules_ptr = lanelet::traffic_rules::TrafficRulesFactory::create(
+    lanelet::Locations::Germany, lanelet::Participants::Vehicle);
+  const auto pedestrian_rules = lanelet::traffic_rules::TrafficRulesFactory::create(
+    lanelet::Locations::Germany, lanelet::Participants::Pedestrian);
+  auto pedestrian_graph_future =
+    std::async(std::launch::async, [&lanelet_map, &pedestrian_rules]() {
+      return lanelet::routing::RoutingGraphConstPtr(
+        lanelet::routing::RoutingGraph::build(lanelet_map, *pedestrian_rules));
+    });
+  data->routing_graph_ptr =
+    lanelet::routing::RoutingGraph::build(lanelet_map, *data->traffic_rules_ptr);
+  const lanelet::routing::RoutingGraphConstPtr pedestrian_graph = pedestrian_graph_future.get();
+  const lanelet::routing::RoutingGraphContainer overall_graphs(
+    {data->routing_graph_ptr, pedestrian_graph});
+  data->overall_graphs_ptr =
+    std::make_shared<const lanelet::routing::RoutingGraphContainer>(overall_graphs);
+  return data;
+}
+
+LaneletMapStore::Key LaneletMapStore::createKey(const HADMapBin & map_msg)
+{
+  const std::string_view bin(
+    reinterpret_cast<const char *>(map_msg.data.data()), map_msg.data.size());
+  return {std::hash<std::string_view>{}(bin), map_msg.data.size()};
+}
+}  // namespace route_handler
@@ -26,6 +26,7 @@
 #include <tf2/utils.h>
 
 #include <algorithm>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <string>
@@ -123,28 +124,25 @@ std::string toString(const geometry_msgs::msg::Pose & pose)
 
 namespace route_handler
 {
-RouteHandler::RouteHandler(const HADMapBin & map_msg) { setMap(map_msg); }
-
-void RouteHandler::setMap(const HADMapBin & map_msg)
-{
-  lanelet_map_ptr_ = std::make_shared<lanelet::LaneletMap>();
-  lanelet::utils::conversion::fromBinMsg(
-    map_msg, lanelet_map_ptr_, &traffic_rules_ptr_, &routing_graph_ptr_);
-
-  const auto traffic_rules = lanelet::traffic_rules::TrafficRulesFactory::create(
-    lanelet::Locations::Germany, lanelet::Participants::Vehicle);
-  const auto pedestrian_rules = lanelet::traffic_rules::TrafficRulesFactory::create(
-    lanelet::Locations::Germany, lanelet::Participants::Pedestrian);
-  const lanelet::routing::RoutingGraphConstPtr vehicle_graph =
-    lanelet::routing::RoutingGraph::build(*lanelet_map_ptr_, *traffic_rules);
-  const lanelet::routing::RoutingGraphConstPtr pedestrian_graph =
-    lanelet::routing::RoutingGraph::build(*lanelet_map_ptr_, *pedestrian_rules);
-  const lanelet::routing::RoutingGraphContainer overall_graphs({vehicle_graph, pedestrian_graph});
-  overall_graphs_ptr_ =
-    std::make_shared<const lanelet::routing::RoutingGraphContainer>(overall_graphs);
-  lanelet::ConstLanelets all_lanelets = lanelet::utils::query::laneletLayer(lanelet_map_ptr_);
-  road_lanelets_ = lanelet::utils::query::roadLanelets(all_lanelets);
-  shoulder_lanelets_ = lanelet::utils::query::shoulderLanelets(all_lanelets);
+RouteHandler::RouteHandler(const HADMapBin & map_msg, const bool use_shared_map)
+{
+  setMap(map_msg, use_shared_map);
+}
+
+void RouteHandler::setMap(const HADMapBin & map_msg, const bool use_shared_map)
+{
+  if (use_shared_map) {
+    map_data_ptr_ = LaneletMapStore::get(map_msg);
+  } else {
+    map_data_ptr_ = LaneletMapStore::build(map_msg);
+  }
+  lanelet_map_ptr_ = map_data_ptr_->lanelet_map_ptr;
+  traffic_rules_ptr_ = map_data_ptr_->traffic_rules_ptr;
+  routing_graph_ptr_ = map_data_ptr_->routing_graph_ptr;
+  overall_graphs_ptr_ = map_data_ptr_->overall_graphs_ptr;
+  road_lanelets_ = map_data_ptr_->road_lanelets;
+  shoulder_lanelets_ = map_data_ptr_->shoulder_lanelets;
+  lanelet_sequence_cache_ = std::make_shared<LaneletSequenceCache>();
 
   is_map_msg_ready_ = true;
   is_handler_ready_ = false;
@@ -184,6 +182,7 @@ bool RouteHandler::isHandlerReady() const { return is_handler_ready_; }
 
 void RouteHandler::setRouteLanelets(const lanelet::ConstLanelets & path_lanelets)
 {
+  lanelet_sequence_cache_ = std::make_shared<LaneletSequenceCache>();
   if (!path_lanelets.empty()) {
     const auto & first_lanelet = path_lanelets.front();
     start_lanelets_ = lanelet::utils::query::getAllNeighbors(routing_graph_ptr_, first_lanelet);
@@ -279,6 +278,7 @@ void RouteHandler::setRouteLanelets(const lanelet::ConstLanelets & path_lanelets
   for (const auto & id : route_lanelets_id) {
     route_lanelets_.push_back(lanelet_map_ptr_->laneletLayer.get(id));
   }
+  updateRouteLaneletsRtree();
   is_handler_ready_ = true;
 }
 
@@ -287,7 +287,9 @@ void RouteHandler::setLaneletsFromRouteMsg()
   if (!is_route_msg_ready_ || !is_map_msg_ready_) {
     return;
   }
+  lanelet_sequence_cache_ = std::make_shared<LaneletSequenceCache>();
   route_lanelets_.clear();
+  route_lanelets_rtree_.clear();
   preferred_lanelets_.clear();
   const bool is_route_valid = lanelet::utils::route::isRouteValid(route_msg_, lanelet_map_ptr_);
   if (!is_route_valid) {
@@ -326,9 +328,25 @@ void RouteHandler::setLaneletsFromRouteMsg()
       start_lanelets_.push_back(llt);
     }
   }
+  updateRouteLaneletsRtree();
   is_handler_ready_ = true;
 }
 
+void RouteHandler::updateRouteLaneletsRtree()
+{
+  std::vector<LaneletBox> boxes;
+  boxes.reserve(route_lanelets_.size());
+  for (size_t i = 0; i < route_lanelets_.size(); ++i) {
+    const auto bbox = lanelet::geometry::boundingBox2d(route_lanelets_.at(i));
+    boxes.emplace_back(
+      tier4_autoware_utils::Box2d{
+        {bbox.min().x(), bbox.min().y()}, {bbox.max().x(), bbox.max().y()}},
+      i);
+  }
+  // the packing constructor builds a better balanced tree than successive insertions
+  route_lanelets_rtree_ = decltype(route_lanelets_rtree_)(boxes);
+}
+
 lanelet::ConstPolygon3d RouteHandler::getIntersectionAreaById(const lanelet::Id id) const
 {
   return lanelet_map_ptr_->polygonLayer.get(id);
@@ -442,6 +460,11 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequenceAfter(
     return lanelet_sequence_forward;
   }
 
+  if (const auto sequence = lanelet_sequence_cache_->get(
+        LaneletSequenceCache::Type::AFTER, lanelet, min_length)) {
+    return sequence.get();
+  }
+
   double length = 0;
   lanelet::ConstLanelet current_lanelet = lanelet;
   while (rclcpp::ok() && length < min_length) {
@@ -455,6 +478,8 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequenceAfter(
       static_cast<double>(boost::geometry::length(next_lanelet.centerline().basicLineString()));
   }
 
+  lanelet_sequence_cache_->set(
+    LaneletSequenceCache::Type::AFTER, lanelet, min_length, lanelet_sequence_forward);
   return lanelet_sequence_forward;
 }
 
@@ -466,6 +491,11 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequenceUpTo(
     return lanelet_sequence_backward;
   }
 
+  if (const auto sequence = lanelet_sequence_cache_->get(
+        LaneletSequenceCache::Type::UP_TO, lanelet, min_length)) {
+    return sequence.get();
+  }
+
   lanelet::ConstLanelet current_lanelet = lanelet;
   double length = 0;
   while (rclcpp::ok() && length < min_length) {
@@ -505,6 +535,8 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequenceUpTo(
   }
 
   std::reverse(lanelet_sequence_backward.begin(), lanelet_sequence_backward.end());
+  lanelet_sequence_cache_->set(
+    LaneletSequenceCache::Type::UP_TO, lanelet, min_length, lanelet_sequence_backward);
   return lanelet_sequence_backward;
 }
 
@@ -602,6 +634,11 @@ lanelet::ConstLanelets RouteHandler::getShoulderLaneletSequenceAfter(
     return lanelet_sequence_forward;
   }
 
+  if (const auto sequence = lanelet_sequence_cache_->get(
+        LaneletSequenceCache::Type::SHOULDER_AFTER, lanelet, min_length)) {
+    return sequence.get();
+  }
+
   double length = 0;
   lanelet::ConstLanelet current_lanelet = lanelet;
   while (rclcpp::ok() && length < min_length) {
@@ -615,6 +652,8 @@ lanelet::ConstLanelets RouteHandler::getShoulderLaneletSequenceAfter(
       static_cast<double>(boost::geometry::length(next_lanelet.centerline().basicLineString()));
   }
 
+  lanelet_sequence_cache_->set(
+    LaneletSequenceCache::Type::SHOULDER_AFTER, lanelet, min_length, lanelet_sequence_forward);
   return lanelet_sequence_forward;
 }
 
@@ -638,6 +677,11 @@ lanelet::ConstLanelets RouteHandler::getShoulderLaneletSequenceUpTo(
     return lanelet_sequence_backward;
   }
 
+  if (const auto sequence = lanelet_sequence_cache_->get(
+        LaneletSequenceCache::Type::SHOULDER_UP_TO, lanelet, min_length)) {
+    return sequence.get();
+  }
+
   double length = 0;
   lanelet::ConstLanelet current_lanelet = lanelet;
   while (rclcpp::ok() && length < min_length) {
@@ -652,6 +696,8 @@ lanelet::ConstLanelets RouteHandler::getShoulderLaneletSequenceUpTo(
       static_cast<double>(boost::geometry::length(prev_lanelet.centerline().basicLineString()));
   }
 
+  lanelet_sequence_cache_->set(
+    LaneletSequenceCache::Type::SHOULDER_UP_TO, lanelet, min_length, lanelet_sequence_backward);
   return lanelet_sequence_backward;
 }
 
@@ -693,7 +739,41 @@ lanelet::ConstLanelets RouteHandler::getShoulderLaneletSequence(
 bool RouteHandler::getClosestLaneletWithinRoute(
   const Pose & search_pose, lanelet::ConstLanelet * closest_lanelet) const
 {
-  return lanelet::utils::query::getClosestLanelet(route_lanelets_, search_pose, closest_lanelet);
+  if (route_lanelets_rtree_.empty()) {
+    return lanelet::utils::query::getClosestLanelet(route_lanelets_, search_pose, closest_lanelet);
+  }
+
+  namespace bgi = boost::geometry::index;
+  const auto & p = search_pose.position;
+
+  // the distance to the lanelet with the nearest bounding box bounds the distance to the closest
+  // lanelet, whose bounding box is then also within that distance of the search point
+  std::vector<LaneletBox> nearest;
+  route_lanelets_rtree_.query(
+    bgi::nearest(tier4_autoware_utils::Point2d{p.x, p.y}, 1), std::back_inserter(nearest));
+  const auto & nearest_lanelet = route_lanelets_.at(nearest.front().second);
+  // margin so that the lanelets at the same distance are kept for the yaw comparison
+  constexpr double margin = 1e-3;
+  const double max_dist =
+    boost::geometry::distance(
+      nearest_lanelet.polygon2d().basicPolygon(), lanelet::BasicPoint2d{p.x, p.y}) +
+    margin;
+
+  std::vector<LaneletBox> candidates;
+  const tier4_autoware_utils::Box2d search_box{
+    {p.x - max_dist, p.y - max_dist}, {p.x + max_dist, p.y + max_dist}};
+  route_lanelets_rtree_.query(bgi::intersects(search_box), std::back_inserter(candidates));
+
+  // keep the order of route_lanelets_ so that ties are resolved as without the rtree
+  std::sort(candidates.begin(), candidates.end(), [](const auto & a, const auto & b) {
+    return a.second < b.second;
+  });
+  lanelet::ConstLanelets candidate_lanelets;
+  candidate_lanelets.reserve(candidates.size());
+  for (const auto & candidate : candidates) {
+    candidate_lanelets.push_back(route_lanelets_.at(candidate.second));
+  }
+  return lanelet::utils::query::getClosestLanelet(candidate_lanelets, search_pose, closest_lanelet);
 }
 
 bool RouteHandler::getNextLaneletWithinRoute(
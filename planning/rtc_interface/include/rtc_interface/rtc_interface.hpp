@@ -27,8 +27,11 @@
 #include "tier4_rtc_msgs/srv/cooperate_commands.hpp"
 #include <unique_identifier_msgs/msg/uuid.hpp>
 
+#include <array>
+#include <cstdint>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace rtc_interface
@@ -43,6 +46,11 @@ using tier4_rtc_msgs::srv::AutoMode;
 using tier4_rtc_msgs::srv::CooperateCommands;
 using unique_identifier_msgs::msg::UUID;
 
+struct UUIDHash
+{
+  size_t operator()(const std::array<uint8_t, 16> & uuid) const;
+};
+
 class RTCInterface
 {
 public:
@@ -68,6 +76,7 @@ private:
     const std::vector<CooperateCommand> & commands);
   void updateCooperateCommandStatus(const std::vector<CooperateCommand> & commands);
   void removeStoredCommand(const UUID & uuid);
+  std::vector<CooperateStatus>::iterator findCooperateStatus(const UUID & uuid);
   rclcpp::Logger getLogger() const;
   bool isLocked() const;
 
@@ -80,10 +89,17 @@ private:
   rclcpp::Logger logger_;
   Module module_;
   CooperateStatusArray registered_status_;
+  // index of each status in registered_status_.statuses
+  std::unordered_map<std::array<uint8_t, 16>, size_t, UUIDHash> status_indices_;
   std::vector<CooperateCommand> stored_commands_;
   bool is_auto_mode_init_;
   bool is_locked_;
 
+  // statuses are published only when they or their commands have changed, and periodically
+  bool is_status_changed_;
+  rclcpp::Time last_publish_stamp_;
+  double keep_alive_period_ = 1.0;
+
   std::string cooperate_status_namespace_ = "/planning/cooperate_status";
   std::string cooperate_commands_namespace_ = "/planning/cooperate_commands";
   std::string enable_auto_mode_namespace_ = "/planning/enable_auto_mode/internal";
@@ -14,6 +14,8 @@
 
 #include "rtc_interface/rtc_interface.hpp"
 
+#include <cstring>
+
 namespace
 {
 using tier4_rtc_msgs::msg::Module;
@@ -72,10 +74,21 @@ Module getModuleType(const std::string & module_name)
 
 namespace rtc_interface
 {
+size_t UUIDHash::operator()(const std::array<uint8_t, 16> & uuid) const
+{
+  // uuids are random, so folding the bytes is enough
+  uint64_t upper;
+  uint64_t lower;
+  std::memcpy(&upper, uuid.data(), sizeof(upper));
+  std::memcpy(&lower, uuid.data() + sizeof(upper), sizeof(lower));
+  return std::hash<uint64_t>{}(upper ^ lower);
+}
+
 RTCInterface::RTCInterface(rclcpp::Node * node, const std::string & name)
 : logger_{node->get_logger().get_child("RTCInterface[" + name + "]")},
   is_auto_mode_init_{false},
-  is_locked_{false}
+  is_locked_{false},
+  is_status_changed_{true}
 {
   using std::placeholders::_1;
   using std::placeholders::_2;
@@ -102,8 +115,17 @@ RTCInterface::RTCInterface(rclcpp::Node * node, const std::string & name)
 void RTCInterface::publishCooperateStatus(const rclcpp::Time & stamp)
 {
   std::lock_guard<std::mutex> lock(mutex_);
+  if (!is_status_changed_) {
+    const double elapsed_time = (stamp - last_publish_stamp_).seconds();
+    if (0.0 <= elapsed_time && elapsed_time < keep_alive_period_) {
+      return;
+    }
+  }
+
   registered_status_.stamp = stamp;
   pub_statuses_->publish(registered_status_);
+  is_status_changed_ = false;
+  last_publish_stamp_ = stamp;
 }
 
 void RTCInterface::onCooperateCommandService(
@@ -132,10 +154,7 @@ std::vector<CooperateResponse> RTCInterface::validateCooperateCommands(
     response.uuid = command.uuid;
     response.module = command.module;
 
-    const auto itr = std::find_if(
-      registered_status_.statuses.begin(), registered_status_.statuses.end(),
-      [command](auto & s) { return s.uuid == command.uuid; });
-    if (itr != registered_status_.statuses.end()) {
+    if (status_indices_.count(command.uuid.uuid) != 0) {
       response.success = true;
     } else {
       RCLCPP_WARN_STREAM(
@@ -152,12 +171,13 @@ std::vector<CooperateResponse> RTCInterface::validateCooperateCommands(
 void RTCInterface::updateCooperateCommandStatus(const std::vector<CooperateCommand> & commands)
 {
   for (const auto & command : commands) {
-    const auto itr = std::find_if(
-      registered_status_.statuses.begin(), registered_status_.statuses.end(),
-      [command](auto & s) { return s.uuid == command.uuid; });
+    const auto itr = findCooperateStatus(command.uuid);
 
     // Update command if the command has been already received
     if (itr != registered_status_.statuses.end()) {
+      if (itr->command_status != command.command || itr->auto_mode) {
+        is_status_changed_ = true;
+      }
       itr->command_status = command.command;
       itr->auto_mode = false;
     }
@@ -170,6 +190,9 @@ void RTCInterface::onAutoModeService(
   std::lock_guard<std::mutex> lock(mutex_);
   is_auto_mode_init_ = request->enable;
   for (auto & status : registered_status_.statuses) {
+    if (status.auto_mode != request->enable) {
+      is_status_changed_ = true;
+    }
     status.auto_mode = request->enable;
   }
   response->success = true;
@@ -181,9 +204,7 @@ void RTCInterface::updateCooperateStatus(
 {
   std::lock_guard<std::mutex> lock(mutex_);
   // Find registered status which has same uuid
-  auto itr = std::find_if(
-    registered_status_.statuses.begin(), registered_status_.statuses.end(),
-    [uuid](auto & s) { return s.uuid == uuid; });
+  auto itr = findCooperateStatus(uuid);
 
   // If there is no registered status, add it
   if (itr == registered_status_.statuses.end()) {
@@ -196,11 +217,17 @@ void RTCInterface::updateCooperateStatus(
     status.start_distance = start_distance;
     status.finish_distance = finish_distance;
     status.auto_mode = is_auto_mode_init_;
+    status_indices_.emplace(uuid.uuid, registered_status_.statuses.size());
     registered_status_.statuses.push_back(status);
+    is_status_changed_ = true;
     return;
   }
 
-  // If the registered status is found, update status
+  // If the registered status is found, update status. Only the distances are left to the
+  // periodic publication since they change every cycle.
+  if (itr->safe != safe) {
+    is_status_changed_ = true;
+  }
   itr->stamp = stamp;
   itr->safe = safe;
   itr->start_distance = start_distance;
@@ -212,12 +239,17 @@ void RTCInterface::removeCooperateStatus(const UUID & uuid)
   std::lock_guard<std::mutex> lock(mutex_);
   removeStoredCommand(uuid);
   // Find registered status which has same uuid and erase it
-  const auto itr = std::find_if(
-    registered_status_.statuses.begin(), registered_status_.statuses.end(),
-    [uuid](auto & s) { return s.uuid == uuid; });
+  const auto itr = findCooperateStatus(uuid);
 
   if (itr != registered_status_.statuses.end()) {
-    registered_status_.statuses.erase(itr);
+    // keep the order of the statuses and shift the indices after the erased one
+    const auto erased_itr = registered_status_.statuses.erase(itr);
+    status_indices_.erase(uuid.uuid);
+    for (auto status_itr = erased_itr; status_itr != registered_status_.statuses.end();
+         ++status_itr) {
+      --status_indices_.at(status_itr->uuid.uuid);
+    }
+    is_status_changed_ = true;
     return;
   }
 
@@ -241,16 +273,27 @@ void RTCInterface::removeStoredCommand(const UUID & uuid)
 void RTCInterface::clearCooperateStatus()
 {
   std::lock_guard<std::mutex> lock(mutex_);
+  if (!registered_status_.statuses.empty()) {
+    is_status_changed_ = true;
+  }
   registered_status_.statuses.clear();
+  status_indices_.clear();
   stored_commands_.clear();
 }
 
+std::vector<CooperateStatus>::iterator RTCInterface::findCooperateStatus(const UUID & uuid)
+{
+  const auto index_itr = status_indices_.find(uuid.uuid);
+  if (index_itr == status_indices_.end()) {
+    return registered_status_.statuses.end();
+  }
+  return registered_status_.statuses.begin() + index_itr->second;
+}
+
 bool RTCInterface::isActivated(const UUID & uuid)
 {
   std::lock_guard<std::mutex> lock(mutex_);
-  const auto itr = std::find_if(
-    registered_status_.statuses.begin(), registered_status_.statuses.end(),
-    [uuid](auto & s) { return s.uuid == uuid; });
+  const auto itr = findCooperateStatus(uuid);
 
   if (itr != registered_status_.statuses.end()) {
     if (itr->auto_mode) {
@@ -268,10 +311,7 @@ bool RTCInterface::isActivated(const UUID & uuid)
 bool RTCInterface::isRegistered(const UUID & uuid)
 {
   std::lock_guard<std::mutex> lock(mutex_);
-  const auto itr = std::find_if(
-    registered_status_.statuses.begin(), registered_status_.statuses.end(),
-    [uuid](auto & s) { return s.uuid == uuid; });
-  return itr != registered_status_.statuses.end();
+  return status_indices_.count(uuid.uuid) != 0;
 }
 
 void RTCInterface::lockCommandUpdate() { is_locked_ = true; }
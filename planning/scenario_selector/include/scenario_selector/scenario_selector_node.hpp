@@ -20,6 +20,7 @@
 #include <autoware_auto_mapping_msgs/msg/had_map_bin.hpp>
 #include <autoware_auto_planning_msgs/msg/trajectory.hpp>
 #include <autoware_planning_msgs/msg/lanelet_route.hpp>
+#include <geometry_msgs/msg/pose_stamped.hpp>
 #include <geometry_msgs/msg/twist_stamped.hpp>
 #include <nav_msgs/msg/odometry.hpp>
 #include <std_msgs/msg/bool.hpp>
@@ -35,12 +36,11 @@
 #endif
 #include <route_handler/route_handler.hpp>
 
-#include <tf2_ros/buffer.h>
-#include <tf2_ros/transform_listener.h>
-
 #include <deque>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 class ScenarioSelectorNode : public rclcpp::Node
 {
@@ -54,22 +54,18 @@ public:
 
   bool isDataReady();
   void onTimer();
-  void onLaneDrivingTrajectory(
-    const autoware_auto_planning_msgs::msg::Trajectory::ConstSharedPtr msg);
-  void onParkingTrajectory(const autoware_auto_planning_msgs::msg::Trajectory::ConstSharedPtr msg);
-  void publishTrajectory(const autoware_auto_planning_msgs::msg::Trajectory::ConstSharedPtr msg);
+  void onLaneDrivingTrajectory(autoware_auto_planning_msgs::msg::Trajectory::UniquePtr msg);
+  void onParkingTrajectory(autoware_auto_planning_msgs::msg::Trajectory::UniquePtr msg);
+  void publishTrajectory(autoware_auto_planning_msgs::msg::Trajectory::UniquePtr msg);
 
   void updateCurrentScenario();
   std::string selectScenarioByPosition();
-  autoware_auto_planning_msgs::msg::Trajectory::ConstSharedPtr getScenarioTrajectory(
+  std::optional<geometry_msgs::msg::Pose> getScenarioTrajectoryEndPose(
     const std::string & scenario);
 
 private:
   rclcpp::TimerBase::SharedPtr timer_;
 
-  tf2_ros::Buffer tf_buffer_;
-  tf2_ros::TransformListener tf_listener_;
-
   rclcpp::Subscription<autoware_auto_mapping_msgs::msg::HADMapBin>::SharedPtr sub_lanelet_map_;
   rclcpp::Subscription<autoware_planning_msgs::msg::LaneletRoute>::SharedPtr sub_route_;
   rclcpp::Subscription<nav_msgs::msg::Odometry>::SharedPtr sub_odom_;
@@ -81,9 +77,11 @@ private:
   rclcpp::Publisher<autoware_auto_planning_msgs::msg::Trajectory>::SharedPtr pub_trajectory_;
   rclcpp::Publisher<tier4_planning_msgs::msg::Scenario>::SharedPtr pub_scenario_;
 
-  autoware_auto_planning_msgs::msg::Trajectory::ConstSharedPtr lane_driving_trajectory_;
-  autoware_auto_planning_msgs::msg::Trajectory::ConstSharedPtr parking_trajectory_;
+  // only the end poses are kept since the trajectories themselves are moved to the output
+  std::optional<geometry_msgs::msg::Pose> lane_driving_trajectory_end_pose_;
+  std::optional<geometry_msgs::msg::Pose> parking_trajectory_end_pose_;
   autoware_planning_msgs::msg::LaneletRoute::ConstSharedPtr route_;
+  std::optional<bool> is_goal_in_lane_;
   geometry_msgs::msg::PoseStamped::ConstSharedPtr current_pose_;
   geometry_msgs::msg::TwistStamped::ConstSharedPtr twist_;
 
@@ -94,6 +92,8 @@ private:
   std::shared_ptr<lanelet::routing::RoutingGraph> routing_graph_ptr_;
   std::shared_ptr<lanelet::traffic_rules::TrafficRules> traffic_rules_ptr_;
   std::shared_ptr<route_handler::RouteHandler> route_handler_;
+  lanelet::ConstPolygons3d parking_lots_;
+  std::vector<lanelet::BoundingBox2d> parking_lot_boxes_;
 
   // Parameters
   double update_rate_;
@@ -25,6 +25,7 @@
 
 #include <deque>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -37,15 +38,31 @@ void onData(const T & data, T * buffer)
   *buffer = data;
 }
 
+lanelet::BoundingBox2d calcBoundingBox2d(const lanelet::ConstPolygon3d & polygon)
+{
+  lanelet::BoundingBox2d box;
+  for (const auto & point : polygon) {
+    box.extend(lanelet::BasicPoint2d(point.x(), point.y()));
+  }
+  return box;
+}
+
 std::shared_ptr<lanelet::ConstPolygon3d> findNearestParkinglot(
-  const std::shared_ptr<lanelet::LaneletMap> & lanelet_map_ptr,
+  const lanelet::ConstPolygons3d & parking_lots,
+  const std::vector<lanelet::BoundingBox2d> & parking_lot_boxes,
   const lanelet::BasicPoint2d & current_position)
 {
-  const auto all_parking_lots = lanelet::utils::query::getAllParkingLots(lanelet_map_ptr);
+  // only the parking lots whose bounding boxes contain the position can be linked
+  lanelet::ConstPolygons3d candidate_parking_lots;
+  for (size_t i = 0; i < parking_lots.size(); ++i) {
+    if (parking_lot_boxes.at(i).contains(current_position)) {
+      candidate_parking_lots.push_back(parking_lots.at(i));
+    }
+  }
 
   const auto linked_parking_lot = std::make_shared<lanelet::ConstPolygon3d>();
   const auto result = lanelet::utils::query::getLinkedParkingLot(
-    current_position, all_parking_lots, linked_parking_lot.get());
+    current_position, candidate_parking_lots, linked_parking_lot.get());
 
   if (result) {
     return linked_parking_lot;
@@ -54,28 +71,6 @@ std::shared_ptr<lanelet::ConstPolygon3d> findNearestParkinglot(
   }
 }
 
-geometry_msgs::msg::PoseStamped::ConstSharedPtr getCurrentPose(
-  const tf2_ros::Buffer & tf_buffer, const rclcpp::Logger & logger)
-{
-  geometry_msgs::msg::TransformStamped tf_current_pose;
-
-  try {
-    tf_current_pose = tf_buffer.lookupTransform("map", "base_link", tf2::TimePointZero);
-  } catch (tf2::TransformException & ex) {
-    RCLCPP_ERROR(logger, "%s", ex.what());
-    return nullptr;
-  }
-
-  geometry_msgs::msg::PoseStamped::SharedPtr p(new geometry_msgs::msg::PoseStamped());
-  p->header = tf_current_pose.header;
-  p->pose.orientation = tf_current_pose.transform.rotation;
-  p->pose.position.x = tf_current_pose.transform.translation.x;
-  p->pose.position.y = tf_current_pose.transform.translation.y;
-  p->pose.position.z = tf_current_pose.transform.translation.z;
-
-  return geometry_msgs::msg::PoseStamped::ConstSharedPtr(p);
-}
-
 bool isInLane(
   const std::shared_ptr<lanelet::LaneletMap> & lanelet_map_ptr,
   const geometry_msgs::msg::Point & current_pos)
@@ -96,14 +91,15 @@ bool isInLane(
 }
 
 bool isInParkingLot(
-  const std::shared_ptr<lanelet::LaneletMap> & lanelet_map_ptr,
+  const lanelet::ConstPolygons3d & parking_lots,
+  const std::vector<lanelet::BoundingBox2d> & parking_lot_boxes,
   const geometry_msgs::msg::Pose & current_pose)
 {
   const auto & p = current_pose.position;
   const lanelet::Point3d search_point(lanelet::InvalId, p.x, p.y, p.z);
 
   const auto nearest_parking_lot =
-    findNearestParkinglot(lanelet_map_ptr, search_point.basicPoint2d());
+    findNearestParkinglot(parking_lots, parking_lot_boxes, search_point.basicPoint2d());
 
   if (!nearest_parking_lot) {
     return false;
@@ -113,21 +109,30 @@ bool isInParkingLot(
 }
 
 bool isNearTrajectoryEnd(
-  const autoware_auto_planning_msgs::msg::Trajectory::ConstSharedPtr trajectory,
+  const std::optional<geometry_msgs::msg::Pose> & trajectory_end_pose,
   const geometry_msgs::msg::Pose & current_pose, const double th_dist)
 {
-  if (!trajectory || trajectory->points.empty()) {
+  if (!trajectory_end_pose) {
     return false;
   }
 
   const auto & p1 = current_pose.position;
-  const auto & p2 = trajectory->points.back().pose.position;
+  const auto & p2 = trajectory_end_pose->position;
 
   const auto dist = std::hypot(p1.x - p2.x, p1.y - p2.y);
 
   return dist < th_dist;
 }
 
+std::optional<geometry_msgs::msg::Pose> getTrajectoryEndPose(
+  const autoware_auto_planning_msgs::msg::Trajectory & trajectory)
+{
+  if (trajectory.points.empty()) {
+    return {};
+  }
+  return trajectory.points.back().pose;
+}
+
 bool isStopped(
   const std::deque<geometry_msgs::msg::TwistStamped::ConstSharedPtr> & twist_buffer,
   const double th_stopped_velocity_mps)
@@ -142,24 +147,28 @@ bool isStopped(
 
 }  // namespace
 
-autoware_auto_planning_msgs::msg::Trajectory::ConstSharedPtr
-ScenarioSelectorNode::getScenarioTrajectory(const std::string & scenario)
+std::optional<geometry_msgs::msg::Pose> ScenarioSelectorNode::getScenarioTrajectoryEndPose(
+  const std::string & scenario)
 {
   if (scenario == tier4_planning_msgs::msg::Scenario::LANEDRIVING) {
-    return lane_driving_trajectory_;
+    return lane_driving_trajectory_end_pose_;
   }
   if (scenario == tier4_planning_msgs::msg::Scenario::PARKING) {
-    return parking_trajectory_;
+    return parking_trajectory_end_pose_;
   }
   RCLCPP_ERROR_STREAM(this->get_logger(), "invalid scenario argument: " << scenario);
-  return lane_driving_trajectory_;
+  return lane_driving_trajectory_end_pose_;
 }
 
 std::string ScenarioSelectorNode::selectScenarioByPosition()
 {
   const auto is_in_lane = isInLane(lanelet_map_ptr_, current_pose_->pose.position);
-  const auto is_goal_in_lane = isInLane(lanelet_map_ptr_, route_->goal_pose.position);
-  const auto is_in_parking_lot = isInParkingLot(lanelet_map_ptr_, current_pose_->pose);
+  if (!is_goal_in_lane_) {
+    is_goal_in_lane_ = isInLane(lanelet_map_ptr_, route_->goal_pose.position);
+  }
+  const auto is_goal_in_lane = *is_goal_in_lane_;
+  const auto is_in_parking_lot =
+    isInParkingLot(parking_lots_, parking_lot_boxes_, current_pose_->pose);
 
   if (current_scenario_ == tier4_planning_msgs::msg::Scenario::EMPTY) {
     if (is_in_lane && is_goal_in_lane) {
@@ -191,9 +200,9 @@ void ScenarioSelectorNode::updateCurrentScenario()
 {
   const auto prev_scenario = current_scenario_;
 
-  const auto scenario_trajectory = getScenarioTrajectory(current_scenario_);
+  const auto scenario_trajectory_end_pose = getScenarioTrajectoryEndPose(current_scenario_);
   const auto is_near_trajectory_end =
-    isNearTrajectoryEnd(scenario_trajectory, current_pose_->pose, th_arrived_distance_m_);
+    isNearTrajectoryEnd(scenario_trajectory_end_pose, current_pose_->pose, th_arrived_distance_m_);
 
   const auto is_stopped = isStopped(twist_buffer_, th_stopped_velocity_mps_);
 
@@ -210,21 +219,36 @@ void ScenarioSelectorNode::updateCurrentScenario()
 void ScenarioSelectorNode::onMap(
   const autoware_auto_mapping_msgs::msg::HADMapBin::ConstSharedPtr msg)
 {
-  lanelet_map_ptr_ = std::make_shared<lanelet::LaneletMap>();
-  lanelet::utils::conversion::fromBinMsg(
-    *msg, lanelet_map_ptr_, &traffic_rules_ptr_, &routing_graph_ptr_);
+  // the route handler shares the map and routing graph with the other nodes of the process
   route_handler_ = std::make_shared<route_handler::RouteHandler>(*msg);
+  lanelet_map_ptr_ = route_handler_->getLaneletMapPtr();
+  traffic_rules_ptr_ = route_handler_->getTrafficRulesPtr();
+  routing_graph_ptr_ = route_handler_->getRoutingGraphPtr();
+
+  // parking lots are searched on every scenario decision, so they are collected once here
+  parking_lots_ = lanelet::utils::query::getAllParkingLots(lanelet_map_ptr_);
+  parking_lot_boxes_.clear();
+  for (const auto & parking_lot : parking_lots_) {
+    parking_lot_boxes_.push_back(calcBoundingBox2d(parking_lot));
+  }
+  is_goal_in_lane_.reset();
 }
 
 void ScenarioSelectorNode::onRoute(
   const autoware_planning_msgs::msg::LaneletRoute::ConstSharedPtr msg)
 {
   route_ = msg;
+  is_goal_in_lane_.reset();
   current_scenario_ = tier4_planning_msgs::msg::Scenario::EMPTY;
 }
 
 void ScenarioSelectorNode::onOdom(const nav_msgs::msg::Odometry::ConstSharedPtr msg)
 {
+  auto pose = std::make_shared<geometry_msgs::msg::PoseStamped>();
+  pose->header = msg->header;
+  pose->pose = msg->pose.pose;
+  current_pose_ = pose;
+
   auto twist = std::make_shared<geometry_msgs::msg::TwistStamped>();
   twist->header = msg->header;
   twist->twist = msg->twist.twist;
@@ -285,8 +309,6 @@ bool ScenarioSelectorNode::isDataReady()
 
 void ScenarioSelectorNode::onTimer()
 {
-  current_pose_ = getCurrentPose(tf_buffer_, this->get_logger());
-
   if (!isDataReady()) {
     return;
   }
@@ -308,36 +330,38 @@ void ScenarioSelectorNode::onTimer()
 }
 
 void ScenarioSelectorNode::onLaneDrivingTrajectory(
-  const autoware_auto_planning_msgs::msg::Trajectory::ConstSharedPtr msg)
+  autoware_auto_planning_msgs::msg::Trajectory::UniquePtr msg)
 {
-  lane_driving_trajectory_ = msg;
+  lane_driving_trajectory_end_pose_ = getTrajectoryEndPose(*msg);
 
   if (current_scenario_ != tier4_planning_msgs::msg::Scenario::LANEDRIVING) {
     return;
   }
 
-  publishTrajectory(msg);
+  publishTrajectory(std::move(msg));
 }
 
 void ScenarioSelectorNode::onParkingTrajectory(
-  const autoware_auto_planning_msgs::msg::Trajectory::ConstSharedPtr msg)
+  autoware_auto_planning_msgs::msg::Trajectory::UniquePtr msg)
 {
-  parking_trajectory_ = msg;
+  parking_trajectory_end_pose_ = getTrajectoryEndPose(*msg);
 
   if (current_scenario_ != tier4_planning_msgs::msg::Scenario::PARKING) {
     return;
   }
 
-  publishTrajectory(msg);
+  publishTrajectory(std::move(msg));
 }
 
 void ScenarioSelectorNode::publishTrajectory(
-  const autoware_auto_planning_msgs::msg::Trajectory::ConstSharedPtr msg)
+  autoware_auto_planning_msgs::msg::Trajectory::UniquePtr msg)
 {
   const auto now = this->now();
   const auto delay_sec = (now - msg->header.stamp).seconds();
   if (delay_sec <= th_max_message_delay_sec_) {
-    pub_trajectory_->publish(*msg);
+    // the trajectory is moved to the publisher, which passes it on without a copy when the
+    // subscriber is in the same process
+    pub_trajectory_->publish(std::move(msg));
   } else {
     RCLCPP_WARN_THROTTLE(
       this->get_logger(), *this->get_clock(), std::chrono::milliseconds(1000).count(),
@@ -348,8 +372,6 @@ void ScenarioSelectorNode::publishTrajectory(
 
 ScenarioSelectorNode::ScenarioSelectorNode(const rclcpp::NodeOptions & node_options)
 : Node("scenario_selector", node_options),
-  tf_buffer_(this->get_clock()),
-  tf_listener_(tf_buffer_),
   current_scenario_(tier4_planning_msgs::msg::Scenario::EMPTY),
   update_rate_(this->declare_parameter<double>("update_rate", 10.0)),
   th_max_message_delay_sec_(this->declare_parameter<double>("th_max_message_delay_sec", 1.0)),
@@ -392,17 +414,6 @@ ScenarioSelectorNode::ScenarioSelectorNode(const rclcpp::NodeOptions & node_opti
 
   timer_ = rclcpp::create_timer(
     this, get_clock(), period_ns, std::bind(&ScenarioSelectorNode::onTimer, this));
-
-  // Wait for first tf
-  while (rclcpp::ok()) {
-    try {
-      tf_buffer_.lookupTransform("map", "base_link", tf2::TimePointZero);
-      break;
-    } catch (tf2::TransformException & ex) {
-      RCLCPP_DEBUG(this->get_logger(), "waiting for initial pose...");
-      rclcpp::sleep_for(std::chrono::milliseconds(100));
-    }
-  }
 }
 
 #include <rclcpp_components/register_node_macro.hpp>
@@ -22,6 +22,9 @@
 #include "static_centerline_optimizer/type_alias.hpp"
 #include "vehicle_info_util/vehicle_info_util.hpp"
 
+#include <mission_planner/mission_planner_plugin.hpp>
+#include <pluginlib/class_loader.hpp>
+
 #include <memory>
 #include <string>
 #include <vector>
@@ -39,6 +42,10 @@ public:
   void run();
 
 private:
+  // process all the start/goal lanelet id pairs in the file with the map loaded once
+  void run_batch(
+    const std::string & batch_route_file_path, const std::string & lanelet2_output_file_path);
+
   // load map
   void load_map(const std::string & lanelet2_input_file_path);
   void on_load_map(
@@ -51,12 +58,14 @@ private:
 
   // plan path
   std::vector<TrajectoryPoint> plan_path(const std::vector<unsigned int> & route_lane_ids);
+  PathWithLaneId get_raw_path_with_lane_id(const std::vector<unsigned int> & route_lane_ids) const;
   void on_plan_path(
     const PlanPath::Request::SharedPtr request, const PlanPath::Response::SharedPtr response);
 
-  void evaluate(
+  // return the minimum distance to the route bounds, and append markers of unsafe footprints
+  double evaluate(
     const std::vector<unsigned int> & route_lane_ids,
-    const std::vector<TrajectoryPoint> & optimized_traj_points);
+    const std::vector<TrajectoryPoint> & optimized_traj_points, MarkerArray & marker_array) const;
   void save_map(
     const std::string & lanelet2_output_file_path, const std::vector<unsigned int> & route_lane_ids,
     const std::vector<TrajectoryPoint> & optimized_traj_points);
@@ -64,6 +73,11 @@ private:
   HADMapBin::ConstSharedPtr map_bin_ptr_{nullptr};
   std::shared_ptr<RouteHandler> route_handler_ptr_{nullptr};
 
+  // mission planner initialized with the loaded map, shared by all the routes
+  pluginlib::ClassLoader<mission_planner::PlannerPlugin> plugin_loader_;
+  std::shared_ptr<rclcpp::Node> mission_planner_node_{nullptr};
+  std::shared_ptr<mission_planner::PlannerPlugin> mission_planner_{nullptr};
+
   // publisher
   rclcpp::Publisher<HADMapBin>::SharedPtr pub_map_bin_{nullptr};
   rclcpp::Publisher<PathWithLaneId>::SharedPtr pub_raw_path_with_lane_id_{nullptr};
@@ -79,6 +93,13 @@ private:
   // callback group for service
   rclcpp::CallbackGroup::SharedPtr callback_group_;
 
+  // parameters
+  double ego_nearest_dist_threshold_;
+  double ego_nearest_yaw_threshold_;
+  std::vector<double> marker_color_dist_thresh_;
+  std::vector<std::string> marker_color_;
+  int batch_thread_num_;
+
   // vehicle info
   vehicle_info_util::VehicleInfo vehicle_info_;
 };
@@ -24,23 +24,32 @@
 #include "static_centerline_optimizer/type_alias.hpp"
 #include "static_centerline_optimizer/utils.hpp"
 
-#include <mission_planner/mission_planner_plugin.hpp>
-#include <pluginlib/class_loader.hpp>
+#include <boost/geometry/index/rtree.hpp>
 
 #include <lanelet2_core/LaneletMap.h>
 #include <lanelet2_io/Io.h>
 #include <lanelet2_projection/UTM.h>
 
+#include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <limits>
 #include <memory>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 namespace static_centerline_optimizer
 {
 namespace
 {
+using tier4_autoware_utils::Box2d;
+using tier4_autoware_utils::Segment2d;
+namespace bgi = boost::geometry::index;
+using BoundSegmentRtree = bgi::rtree<Segment2d, bgi::rstar<16>>;
+
 Path convert_to_path(const PathWithLaneId & path_with_lane_id)
 {
   Path path;
@@ -152,6 +161,55 @@ std::array<double, 3> convertHexStringToDecimal(const std::string & hex_str_colo
   return std::array<double, 3>{r / 255.0, g / 255.0, b / 255.0};
 }
 
+BoundSegmentRtree create_bound_segment_rtree(const lanelet::ConstLanelets & lanelets)
+{
+  // each bound is concatenated over the lanelets, including the segments joining two lanelets
+  std::vector<Segment2d> segments;
+  const auto append_bound_segments = [&](const auto & get_bound) {
+    boost::optional<Point2d> prev_point;
+    for (const auto & lanelet : lanelets) {
+      for (const auto & point : get_bound(lanelet)) {
+        const Point2d current_point(point.x(), point.y());
+        if (prev_point) {
+          segments.emplace_back(*prev_point, current_point);
+        }
+        prev_point = current_point;
+      }
+    }
+  };
+  append_bound_segments([](const auto & lanelet) { return lanelet.rightBound(); });
+  append_bound_segments([](const auto & lanelet) { return lanelet.leftBound(); });
+
+  return BoundSegmentRtree(segments);
+}
+
+double calc_distance_to_bounds(
+  const LinearRing2d & footprint_poly, const BoundSegmentRtree & bound_segment_rtree,
+  const double search_dist)
+{
+  // A segment farther than dist from the footprint's envelope is farther than dist from the
+  // footprint, so the minimum is exact once it is within the searched distance.
+  const auto envelope = boost::geometry::return_envelope<Box2d>(footprint_poly);
+  double dist = search_dist;
+  std::vector<Segment2d> candidate_segments;
+  while (true) {
+    const Box2d search_box(
+      Point2d(envelope.min_corner().x() - dist, envelope.min_corner().y() - dist),
+      Point2d(envelope.max_corner().x() + dist, envelope.max_corner().y() + dist));
+    candidate_segments.clear();
+    bound_segment_rtree.query(bgi::intersects(search_box), std::back_inserter(candidate_segments));
+
+    double min_dist = std::numeric_limits<double>::max();
+    for (const auto & segment : candidate_segments) {
+      min_dist = std::min(min_dist, boost::geometry::distance(footprint_poly, segment));
+    }
+    if (min_dist <= dist || candidate_segments.size() == bound_segment_rtree.size()) {
+      return min_dist;
+    }
+    dist = candidate_segments.empty() ? std::max(2.0 * dist, 1.0) : min_dist;
+  }
+}
+
 std::vector<unsigned int> check_lanelet_connection(
   const RouteHandler & route_handler, const lanelet::ConstLanelets & route_lanelets)
 {
@@ -175,7 +233,8 @@ std::vector<unsigned int> check_lanelet_connection(
 
 StaticCenterlineOptimizerNode::StaticCenterlineOptimizerNode(
   const rclcpp::NodeOptions & node_options)
-: Node("static_centerline_optimizer", node_options)
+: Node("static_centerline_optimizer", node_options),
+  plugin_loader_("mission_planner", "mission_planner::PlannerPlugin")
 {
   // publishers
   pub_map_bin_ = create_publisher<HADMapBin>("lanelet2_map_topic", create_transient_local_qos());
@@ -210,6 +269,13 @@ StaticCenterlineOptimizerNode::StaticCenterlineOptimizerNode(
       std::placeholders::_2),
     rmw_qos_profile_services_default, callback_group_);
 
+  // parameters
+  ego_nearest_dist_threshold_ = declare_parameter<double>("ego_nearest_dist_threshold");
+  ego_nearest_yaw_threshold_ = declare_parameter<double>("ego_nearest_yaw_threshold");
+  marker_color_dist_thresh_ = declare_parameter<std::vector<double>>("marker_color_dist_thresh");
+  marker_color_ = declare_parameter<std::vector<std::string>>("marker_color");
+  batch_thread_num_ = declare_parameter<int>("batch_thread_num");
+
   // vehicle info
   vehicle_info_ = vehicle_info_util::VehicleInfoUtil(*this).getVehicleInfo();
 }
@@ -220,17 +286,142 @@ void StaticCenterlineOptimizerNode::run()
   const auto lanelet2_input_file_path = declare_parameter<std::string>("lanelet2_input_file_path");
   const auto lanelet2_output_file_path =
     declare_parameter<std::string>("lanelet2_output_file_path");
-  const int start_lanelet_id = declare_parameter<int>("start_lanelet_id");
-  const int end_lanelet_id = declare_parameter<int>("end_lanelet_id");
+  const auto batch_route_file_path = declare_parameter<std::string>("batch_route_file_path", "");
 
   // process
   load_map(lanelet2_input_file_path);
+  if (!batch_route_file_path.empty()) {
+    run_batch(batch_route_file_path, lanelet2_output_file_path);
+    return;
+  }
+
+  const int start_lanelet_id = declare_parameter<int>("start_lanelet_id");
+  const int end_lanelet_id = declare_parameter<int>("end_lanelet_id");
   const auto route_lane_ids = plan_route(start_lanelet_id, end_lanelet_id);
   const auto optimized_traj_points = plan_path(route_lane_ids);
-  evaluate(route_lane_ids, optimized_traj_points);
+
+  MarkerArray marker_array;
+  const double min_dist = evaluate(route_lane_ids, optimized_traj_points, marker_array);
+  pub_debug_unsafe_footprints_->publish(marker_array);
+  RCLCPP_INFO(get_logger(), "Minimum distance to road is %f [m]", min_dist);
+
   save_map(lanelet2_output_file_path, route_lane_ids, optimized_traj_points);
 }
 
+void StaticCenterlineOptimizerNode::run_batch(
+  const std::string & batch_route_file_path, const std::string & lanelet2_output_file_path)
+{
+  if (!route_handler_ptr_ || !mission_planner_) {
+    RCLCPP_ERROR(get_logger(), "Map or route handler is not ready.");
+    return;
+  }
+
+  // read start/end lanelet id pairs, one pair per line
+  std::ifstream route_reader(batch_route_file_path);
+  if (!route_reader) {
+    RCLCPP_ERROR(get_logger(), "Failed to open %s", batch_route_file_path.c_str());
+    return;
+  }
+  std::vector<std::pair<int, int>> start_end_lanelet_ids;
+  std::string line;
+  while (std::getline(route_reader, line)) {
+    if (line.empty() || line.front() == '#') {
+      continue;
+    }
+    std::istringstream line_stream(line);
+    int start_lanelet_id;
+    int end_lanelet_id;
+    if (!(line_stream >> start_lanelet_id >> end_lanelet_id)) {
+      RCLCPP_ERROR(get_logger(), "Skipped an invalid line: %s", line.c_str());
+      continue;
+    }
+    start_end_lanelet_ids.emplace_back(start_lanelet_id, end_lanelet_id);
+  }
+  RCLCPP_INFO(get_logger(), "Read %lu routes.", start_end_lanelet_ids.size());
+
+  // plan routes and raw paths sequentially since the mission planner is shared
+  std::vector<std::pair<int, int>> planned_start_end_lanelet_ids;
+  std::vector<std::vector<unsigned int>> route_lane_ids_vec;
+  std::vector<Path> raw_paths;
+  for (const auto & [start_lanelet_id, end_lanelet_id] : start_end_lanelet_ids) {
+    auto route_lane_ids = plan_route(start_lanelet_id, end_lanelet_id);
+    if (route_lane_ids.empty()) {
+      RCLCPP_ERROR(
+        get_logger(), "Route planning from %d to %d failed.", start_lanelet_id, end_lanelet_id);
+      continue;
+    }
+    raw_paths.push_back(convert_to_path(get_raw_path_with_lane_id(route_lane_ids)));
+    route_lane_ids_vec.push_back(std::move(route_lane_ids));
+    planned_start_end_lanelet_ids.emplace_back(start_lanelet_id, end_lanelet_id);
+  }
+  const size_t route_num = route_lane_ids_vec.size();
+  if (route_num == 0) {
+    return;
+  }
+
+  // optimize and evaluate the centerlines in parallel with one optimizer per thread. The
+  // optimizers are created on this thread beforehand since they are nodes.
+  const size_t thread_num = std::min(
+    route_num, batch_thread_num_ > 0 ? static_cast<size_t>(batch_thread_num_)
+                                     : std::max(std::thread::hardware_concurrency(), 1u));
+  std::vector<std::unique_ptr<SuccessiveTrajectoryOptimizer>> optimizers;
+  for (size_t i = 0; i < thread_num; ++i) {
+    optimizers.push_back(std::make_unique<SuccessiveTrajectoryOptimizer>(create_node_options()));
+  }
+
+  std::vector<std::vector<TrajectoryPoint>> optimized_traj_points_vec(route_num);
+  std::vector<MarkerArray> marker_arrays(route_num);
+  std::vector<double> min_dists(route_num);
+  std::atomic<size_t> next_route_idx{0};
+  const auto process_routes = [&](SuccessiveTrajectoryOptimizer & optimizer) {
+    for (size_t i = next_route_idx++; i < route_num; i = next_route_idx++) {
+      const auto optimized_traj = optimizer.on_centerline(raw_paths.at(i));
+      optimized_traj_points_vec.at(i) = motion_utils::convertToTrajectoryPointArray(optimized_traj);
+      min_dists.at(i) =
+        evaluate(route_lane_ids_vec.at(i), optimized_traj_points_vec.at(i), marker_arrays.at(i));
+    }
+  };
+  std::vector<std::thread> threads;
+  for (const auto & optimizer : optimizers) {
+    threads.emplace_back(process_routes, std::ref(*optimizer));
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  RCLCPP_INFO(get_logger(), "Optimized %lu routes with %lu threads.", route_num, thread_num);
+
+  // update centerlines in map in the order of the file, and merge the markers with unique ids
+  MarkerArray marker_array;
+  size_t marker_id_offset = 0;
+  for (size_t i = 0; i < route_num; ++i) {
+    const auto & [start_lanelet_id, end_lanelet_id] = planned_start_end_lanelet_ids.at(i);
+    const auto & optimized_traj_points = optimized_traj_points_vec.at(i);
+    if (optimized_traj_points.empty()) {
+      RCLCPP_ERROR(
+        get_logger(), "Path planning from %d to %d failed.", start_lanelet_id, end_lanelet_id);
+      continue;
+    }
+    RCLCPP_INFO(
+      get_logger(), "Minimum distance to road from %d to %d is %f [m]", start_lanelet_id,
+      end_lanelet_id, min_dists.at(i));
+
+    for (auto & marker : marker_arrays.at(i).markers) {
+      marker.id += marker_id_offset;
+      marker_array.markers.push_back(marker);
+    }
+    marker_id_offset += optimized_traj_points.size();
+
+    const auto & route_lane_ids = route_lane_ids_vec.at(i);
+    const auto route_lanelets = get_lanelets_from_ids(*route_handler_ptr_, route_lane_ids);
+    utils::update_centerline(*route_handler_ptr_, route_lanelets, optimized_traj_points);
+  }
+  pub_debug_unsafe_footprints_->publish(marker_array);
+
+  // save map with all the modified center lines
+  lanelet::write(lanelet2_output_file_path, *route_handler_ptr_->getLaneletMapPtr());
+  RCLCPP_INFO(get_logger(), "Saved map.");
+}
+
 void StaticCenterlineOptimizerNode::load_map(const std::string & lanelet2_input_file_path)
 {
   // load map by the map_loader package
@@ -260,9 +451,15 @@ void StaticCenterlineOptimizerNode::load_map(const std::string & lanelet2_input_
   pub_map_bin_->publish(*map_bin_ptr_);
   RCLCPP_INFO(get_logger(), "Published map.");
 
-  // create route_handler
+  // create route_handler, with its own map since the optimized centerlines are added to it
   route_handler_ptr_ = std::make_shared<RouteHandler>();
-  route_handler_ptr_->setMap(*map_bin_ptr_);
+  route_handler_ptr_->setMap(*map_bin_ptr_, false);
+
+  // initialize mission_planner plugin with the map
+  mission_planner_ =
+    plugin_loader_.createSharedInstance("mission_planner::lanelet2::DefaultPlanner");
+  mission_planner_node_ = std::make_shared<rclcpp::Node>("po");
+  mission_planner_->initialize(mission_planner_node_.get(), map_bin_ptr_);
 }
 
 void StaticCenterlineOptimizerNode::on_load_map(
@@ -289,7 +486,7 @@ void StaticCenterlineOptimizerNode::on_load_map(
 std::vector<unsigned int> StaticCenterlineOptimizerNode::plan_route(
   const int start_lanelet_id, const int end_lanelet_id)
 {
-  if (!map_bin_ptr_ || !route_handler_ptr_) {
+  if (!map_bin_ptr_ || !route_handler_ptr_ || !mission_planner_) {
     RCLCPP_ERROR(get_logger(), "Map or route handler is not ready. Return empty lane ids.");
     return std::vector<unsigned int>{};
   }
@@ -303,22 +500,7 @@ std::vector<unsigned int> StaticCenterlineOptimizerNode::plan_route(
   RCLCPP_INFO(get_logger(), "Calculated check points.");
 
   // plan route by the mission_planner package
-  const auto route = [&]() {
-    // create mission_planner plugin
-    auto plugin_loader = pluginlib::ClassLoader<mission_planner::PlannerPlugin>(
-      "mission_planner", "mission_planner::PlannerPlugin");
-    auto mission_planner =
-      plugin_loader.createSharedInstance("mission_planner::lanelet2::DefaultPlanner");
-
-    // initialize mission_planner
-    auto node = rclcpp::Node("po");
-    mission_planner->initialize(&node, map_bin_ptr_);
-
-    // plan route
-    const auto route = mission_planner->plan(check_points);
-
-    return route;
-  }();
+  const auto route = mission_planner_->plan(check_points);
   RCLCPP_INFO(get_logger(), "Planned route.");
 
   // get lanelets
@@ -367,21 +549,7 @@ std::vector<TrajectoryPoint> StaticCenterlineOptimizerNode::plan_path(
     return std::vector<TrajectoryPoint>{};
   }
 
-  const auto route_lanelets = get_lanelets_from_ids(*route_handler_ptr_, route_lane_ids);
-
-  // optimize centerline inside the lane
-  const auto start_center_pose =
-    utils::get_center_pose(*route_handler_ptr_, route_lane_ids.front());
-
-  // ego nearest search parameters
-  const double ego_nearest_dist_threshold = declare_parameter<double>("ego_nearest_dist_threshold");
-  const double ego_nearest_yaw_threshold = declare_parameter<double>("ego_nearest_yaw_threshold");
-
-  // extract path with lane id from lanelets
-  const auto raw_path_with_lane_id = utils::get_path_with_lane_id(
-    *route_handler_ptr_, route_lanelets, start_center_pose, ego_nearest_dist_threshold,
-    ego_nearest_yaw_threshold);
-
+  const auto raw_path_with_lane_id = get_raw_path_with_lane_id(route_lane_ids);
   pub_raw_path_with_lane_id_->publish(raw_path_with_lane_id);
   RCLCPP_INFO(get_logger(), "Calculated raw path with lane id and published.");
 
@@ -401,6 +569,21 @@ std::vector<TrajectoryPoint> StaticCenterlineOptimizerNode::plan_path(
   return optimized_traj_points;
 }
 
+PathWithLaneId StaticCenterlineOptimizerNode::get_raw_path_with_lane_id(
+  const std::vector<unsigned int> & route_lane_ids) const
+{
+  const auto route_lanelets = get_lanelets_from_ids(*route_handler_ptr_, route_lane_ids);
+
+  // optimize centerline inside the lane
+  const auto start_center_pose =
+    utils::get_center_pose(*route_handler_ptr_, route_lane_ids.front());
+
+  // extract path with lane id from lanelets
+  return utils::get_path_with_lane_id(
+    *route_handler_ptr_, route_lanelets, start_center_pose, ego_nearest_dist_threshold_,
+    ego_nearest_yaw_threshold_);
+}
+
 void StaticCenterlineOptimizerNode::on_plan_path(
   const PlanPath::Request::SharedPtr request, const PlanPath::Response::SharedPtr response)
 {
@@ -469,47 +652,38 @@ void StaticCenterlineOptimizerNode::on_plan_path(
   response->message = "";
 }
 
-void StaticCenterlineOptimizerNode::evaluate(
+double StaticCenterlineOptimizerNode::evaluate(
   const std::vector<unsigned int> & route_lane_ids,
-  const std::vector<TrajectoryPoint> & optimized_traj_points)
+  const std::vector<TrajectoryPoint> & optimized_traj_points, MarkerArray & marker_array) const
 {
   const auto route_lanelets = get_lanelets_from_ids(*route_handler_ptr_, route_lane_ids);
 
-  const auto dist_thresh_vec = declare_parameter<std::vector<double>>("marker_color_dist_thresh");
-  const auto marker_color_vec = declare_parameter<std::vector<std::string>>("marker_color");
   const auto get_marker_color = [&](const double dist) -> boost::optional<std::array<double, 3>> {
-    for (size_t i = 0; i < dist_thresh_vec.size(); ++i) {
-      const double dist_thresh = dist_thresh_vec.at(i);
+    for (size_t i = 0; i < marker_color_dist_thresh_.size(); ++i) {
+      const double dist_thresh = marker_color_dist_thresh_.at(i);
       if (dist < dist_thresh) {
-        return convertHexStringToDecimal(marker_color_vec.at(i));
+        return convertHexStringToDecimal(marker_color_.at(i));
       }
     }
     return boost::none;
   };
 
-  // create right/left bound
-  LineString2d right_bound;
-  LineString2d left_bound;
-  for (const auto & lanelet : route_lanelets) {
-    for (const auto & point : lanelet.rightBound()) {
-      boost::geometry::append(right_bound, Point2d(point.x(), point.y()));
-    }
-    for (const auto & point : lanelet.leftBound()) {
-      boost::geometry::append(left_bound, Point2d(point.x(), point.y()));
-    }
-  }
+  // index segments of right/left bound, searched around each footprint up to the marker threshold
+  const auto bound_segment_rtree = create_bound_segment_rtree(route_lanelets);
+  const double search_dist =
+    marker_color_dist_thresh_.empty()
+      ? 0.0
+      : *std::max_element(marker_color_dist_thresh_.begin(), marker_color_dist_thresh_.end());
 
   // calculate the distance between footprint and right/left bounds
-  MarkerArray marker_array;
   double min_dist = std::numeric_limits<double>::max();
   for (size_t i = 0; i < optimized_traj_points.size(); ++i) {
     const auto & traj_point = optimized_traj_points.at(i);
 
     const auto footprint_poly = create_vehicle_footprint(traj_point.pose, vehicle_info_);
 
-    const double dist_to_right = boost::geometry::distance(footprint_poly, right_bound);
-    const double dist_to_left = boost::geometry::distance(footprint_poly, left_bound);
-    const double min_dist_to_bound = std::min(dist_to_right, dist_to_left);
+    const double min_dist_to_bound =
+      calc_distance_to_bounds(footprint_poly, bound_segment_rtree, search_dist);
 
     if (min_dist_to_bound < min_dist) {
       min_dist = min_dist_to_bound;
@@ -533,9 +707,7 @@ void StaticCenterlineOptimizerNode::evaluate(
     }
   }
 
-  pub_debug_unsafe_footprints_->publish(marker_array);
-
-  RCLCPP_INFO(get_logger(), "Minimum distance to road is %f [m]", min_dist);
+  return min_dist;
 }
 
 void StaticCenterlineOptimizerNode::save_map(
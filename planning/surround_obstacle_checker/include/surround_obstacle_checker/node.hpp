@@ -121,6 +121,10 @@ private:
   sensor_msgs::msg::PointCloud2::ConstSharedPtr pointcloud_ptr_;
   PredictedObjects::ConstSharedPtr object_ptr_;
 
+  // nearest obstacle of the last pointcloud, reused until a new pointcloud arrives
+  mutable sensor_msgs::msg::PointCloud2::ConstSharedPtr checked_pointcloud_ptr_;
+  mutable boost::optional<Obstacle> nearest_pointcloud_obstacle_;
+
   // State Machine
   State state_ = State::PASS;
   std::shared_ptr<const rclcpp::Time> last_obstacle_found_time_;
@@ -23,9 +23,7 @@
 #include <boost/geometry/geometries/linestring.hpp>
 #include <boost/geometry/geometries/point_xy.hpp>
 
-#include <pcl/common/transforms.h>
-#include <pcl/point_cloud.h>
-#include <pcl_conversions/pcl_conversions.h>
+#include <sensor_msgs/point_cloud2_iterator.hpp>
 #ifdef ROS_DISTRO_GALACTIC
 #include <tf2_eigen/tf2_eigen.h>
 #else
@@ -333,35 +331,58 @@ boost::optional<Obstacle> SurroundObstacleCheckerNode::getNearestObstacle() cons
 
 boost::optional<Obstacle> SurroundObstacleCheckerNode::getNearestObstacleByPointCloud() const
 {
+  // the result only depends on the pointcloud and its transform at the pointcloud stamp
+  if (pointcloud_ptr_ == checked_pointcloud_ptr_) {
+    return nearest_pointcloud_obstacle_;
+  }
+
   const auto transform_stamped =
     getTransform("base_link", pointcloud_ptr_->header.frame_id, pointcloud_ptr_->header.stamp, 0.5);
 
-  geometry_msgs::msg::Point nearest_point;
-  auto minimum_distance = std::numeric_limits<double>::max();
-
   if (!transform_stamped) {
     return {};
   }
 
-  Eigen::Affine3f isometry = tf2::transformToEigen(transform_stamped.get().transform).cast<float>();
-  pcl::PointCloud<pcl::PointXYZ> transformed_pointcloud;
-  pcl::fromROSMsg(*pointcloud_ptr_, transformed_pointcloud);
-  pcl::transformPointCloud(transformed_pointcloud, transformed_pointcloud, isometry);
+  const Eigen::Affine3f isometry =
+    tf2::transformToEigen(transform_stamped.get().transform).cast<float>();
 
   const auto ego_polygon = createSelfPolygon(vehicle_info_);
 
-  for (const auto & p : transformed_pointcloud) {
-    Point2d boost_point(p.x, p.y);
+  // points farther than both check distances from the ego footprint do not affect the state, so
+  // they are culled with the bounding box of the footprint before computing the exact distance
+  const double check_margin =
+    std::max(node_param_.surround_check_distance, node_param_.surround_check_recover_distance);
+  bg::model::box<Point2d> ego_box;
+  bg::envelope(ego_polygon, ego_box);
+  const auto min_x = static_cast<float>(ego_box.min_corner().x() - check_margin);
+  const auto min_y = static_cast<float>(ego_box.min_corner().y() - check_margin);
+  const auto max_x = static_cast<float>(ego_box.max_corner().x() + check_margin);
+  const auto max_y = static_cast<float>(ego_box.max_corner().y() + check_margin);
+
+  boost::optional<Obstacle> nearest_obstacle{boost::none};
+
+  sensor_msgs::PointCloud2ConstIterator<float> iter_x(*pointcloud_ptr_, "x");
+  sensor_msgs::PointCloud2ConstIterator<float> iter_y(*pointcloud_ptr_, "y");
+  sensor_msgs::PointCloud2ConstIterator<float> iter_z(*pointcloud_ptr_, "z");
+  for (; iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
+    const Eigen::Vector3f p = isometry * Eigen::Vector3f(*iter_x, *iter_y, *iter_z);
+
+    // also rejects non-finite points
+    if (!(min_x <= p.x() && p.x() <= max_x && min_y <= p.y() && p.y() <= max_y)) {
+      continue;
+    }
 
-    const auto distance_to_object = bg::distance(ego_polygon, boost_point);
+    const auto distance_to_object = bg::distance(ego_polygon, Point2d(p.x(), p.y()));
 
-    if (distance_to_object < minimum_distance) {
-      nearest_point = createPoint(p.x, p.y, p.z);
-      minimum_distance = distance_to_object;
+    if (!nearest_obstacle || distance_to_object < nearest_obstacle.get().first) {
+      nearest_obstacle = std::make_pair(distance_to_object, createPoint(p.x(), p.y(), p.z()));
     }
   }
 
-  return std::make_pair(minimum_distance, nearest_point);
+  checked_pointcloud_ptr_ = pointcloud_ptr_;
+  nearest_pointcloud_obstacle_ = nearest_obstacle;
+
+  return nearest_obstacle;
 }
 
 boost::optional<Obstacle> SurroundObstacleCheckerNode::getNearestObstacleByDynamicObject() const
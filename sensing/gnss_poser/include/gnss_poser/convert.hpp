@@ -47,7 +47,8 @@ double EllipsoidHeight2OrthometricHeight(
 {
   double OrthometricHeight{0.0};
   try {
-    GeographicLib::Geoid egm2008("egm2008-1");
+    // loading the geoid model reads its grid from disk, so it is done once and kept
+    static const GeographicLib::Geoid egm2008("egm2008-1");
     OrthometricHeight = egm2008.ConvertHeight(
       nav_sat_fix_msg.latitude, nav_sat_fix_msg.longitude, nav_sat_fix_msg.altitude,
       GeographicLib::Geoid::ELLIPSOIDTOGEOID);
@@ -59,14 +60,12 @@ double EllipsoidHeight2OrthometricHeight(
 }
 GNSSStat NavSatFix2LocalCartesianWGS84(
   const sensor_msgs::msg::NavSatFix & nav_sat_fix_msg,
-  sensor_msgs::msg::NavSatFix nav_sat_fix_origin_, const rclcpp::Logger & logger)
+  const GeographicLib::LocalCartesian & localCartesian_origin, const rclcpp::Logger & logger)
 {
   GNSSStat local_cartesian;
   local_cartesian.coordinate_system = CoordinateSystem::LOCAL_CARTESIAN_WGS84;
 
   try {
-    GeographicLib::LocalCartesian localCartesian_origin(
-      nav_sat_fix_origin_.latitude, nav_sat_fix_origin_.longitude, nav_sat_fix_origin_.altitude);
     localCartesian_origin.Forward(
       nav_sat_fix_msg.latitude, nav_sat_fix_msg.longitude, nav_sat_fix_msg.altitude,
       local_cartesian.x, local_cartesian.y, local_cartesian.z);
@@ -79,6 +78,14 @@ GNSSStat NavSatFix2LocalCartesianWGS84(
   }
   return local_cartesian;
 }
+GNSSStat NavSatFix2LocalCartesianWGS84(
+  const sensor_msgs::msg::NavSatFix & nav_sat_fix_msg,
+  sensor_msgs::msg::NavSatFix nav_sat_fix_origin_, const rclcpp::Logger & logger)
+{
+  const GeographicLib::LocalCartesian localCartesian_origin(
+    nav_sat_fix_origin_.latitude, nav_sat_fix_origin_.longitude, nav_sat_fix_origin_.altitude);
+  return NavSatFix2LocalCartesianWGS84(nav_sat_fix_msg, localCartesian_origin, logger);
+}
 GNSSStat NavSatFix2UTM(
   const sensor_msgs::msg::NavSatFix & nav_sat_fix_msg, const rclcpp::Logger & logger)
 {
@@ -100,20 +107,14 @@ GNSSStat NavSatFix2UTM(
   }
   return utm;
 }
+// utm_origin: origin of the local coordinate system in global frame, from NavSatFix2UTM
 GNSSStat NavSatFix2LocalCartesianUTM(
-  const sensor_msgs::msg::NavSatFix & nav_sat_fix_msg,
-  sensor_msgs::msg::NavSatFix nav_sat_fix_origin, const rclcpp::Logger & logger)
+  const sensor_msgs::msg::NavSatFix & nav_sat_fix_msg, const GNSSStat & utm_origin,
+  const rclcpp::Logger & logger)
 {
   GNSSStat utm_local;
   utm_local.coordinate_system = CoordinateSystem::UTM;
   try {
-    // origin of the local coordinate system in global frame
-    GNSSStat utm_origin;
-    utm_origin.coordinate_system = CoordinateSystem::UTM;
-    GeographicLib::UTMUPS::Forward(
-      nav_sat_fix_origin.latitude, nav_sat_fix_origin.longitude, utm_origin.zone,
-      utm_origin.east_north_up, utm_origin.x, utm_origin.y);
-    utm_origin.z = EllipsoidHeight2OrthometricHeight(nav_sat_fix_origin, logger);
     // individual coordinates of global coordinate system
     double global_x = 0.0;
     double global_y = 0.0;
@@ -133,6 +134,13 @@ GNSSStat NavSatFix2LocalCartesianUTM(
   }
   return utm_local;
 }
+GNSSStat NavSatFix2LocalCartesianUTM(
+  const sensor_msgs::msg::NavSatFix & nav_sat_fix_msg,
+  sensor_msgs::msg::NavSatFix nav_sat_fix_origin, const rclcpp::Logger & logger)
+{
+  const auto utm_origin = NavSatFix2UTM(nav_sat_fix_origin, logger);
+  return NavSatFix2LocalCartesianUTM(nav_sat_fix_msg, utm_origin, logger);
+}
 GNSSStat UTM2MGRS(
   const GNSSStat & utm, const MGRSPrecision & precision, const rclcpp::Logger & logger)
 {
@@ -38,7 +38,9 @@
 #include <tf2_ros/transform_broadcaster.h>
 #include <tf2_ros/transform_listener.h>
 
+#include <optional>
 #include <string>
+#include <vector>
 
 namespace gnss_poser
 {
@@ -57,8 +59,8 @@ private:
   GNSSStat convert(
     const sensor_msgs::msg::NavSatFix & nav_sat_fix_msg, CoordinateSystem coordinate_system);
   geometry_msgs::msg::Point getPosition(const GNSSStat & gnss_stat);
-  geometry_msgs::msg::Point getMedianPosition(
-    const boost::circular_buffer<geometry_msgs::msg::Point> & position_buffer);
+  void updatePositionBuffer(const geometry_msgs::msg::Point & position);
+  geometry_msgs::msg::Point getMedianPosition() const;
   geometry_msgs::msg::Quaternion getQuaternionByHeading(const int heading);
   geometry_msgs::msg::Quaternion getQuaternionByPositionDifference(
     const geometry_msgs::msg::Point & point, const geometry_msgs::msg::Point & prev_point);
@@ -93,9 +95,19 @@ private:
   std::string map_frame_;
 
   sensor_msgs::msg::NavSatFix nav_sat_fix_origin_;
+  // projections of nav_sat_fix_origin_, computed once
+  GNSSStat utm_origin_;
+  GeographicLib::LocalCartesian local_cartesian_origin_;
   bool use_gnss_ins_orientation_;
 
   boost::circular_buffer<geometry_msgs::msg::Point> position_buffer_;
+  // coordinates of the positions in position_buffer_, sorted for each axis
+  std::vector<double> sorted_x_;
+  std::vector<double> sorted_y_;
+  std::vector<double> sorted_z_;
+
+  // static transform from base_link to gnss_antenna, kept once it has been looked up
+  std::optional<tf2::Transform> tf_gnss_antenna2base_link_;
 
   int plane_zone_;
 
@@ -43,9 +43,17 @@ GNSSPoser::GNSSPoser(const rclcpp::NodeOptions & node_options)
   nav_sat_fix_origin_.latitude = declare_parameter("latitude", 0.0);
   nav_sat_fix_origin_.longitude = declare_parameter("longitude", 0.0);
   nav_sat_fix_origin_.altitude = declare_parameter("altitude", 0.0);
+  local_cartesian_origin_.Reset(
+    nav_sat_fix_origin_.latitude, nav_sat_fix_origin_.longitude, nav_sat_fix_origin_.altitude);
+  if (coordinate_system_ == CoordinateSystem::LOCAL_CARTESIAN_UTM) {
+    utm_origin_ = NavSatFix2UTM(nav_sat_fix_origin_, this->get_logger());
+  }
 
   int buff_epoch = declare_parameter("buff_epoch", 1);
   position_buffer_.set_capacity(buff_epoch);
+  sorted_x_.reserve(buff_epoch);
+  sorted_y_.reserve(buff_epoch);
+  sorted_z_.reserve(buff_epoch);
 
   nav_sat_fix_sub_ = create_subscription<sensor_msgs::msg::NavSatFix>(
     "fix", rclcpp::QoS{1}, std::bind(&GNSSPoser::callbackNavSatFix, this, std::placeholders::_1));
@@ -84,14 +92,14 @@ void GNSSPoser::callbackNavSatFix(
   const auto position = getPosition(gnss_stat);
 
   // calc median position
-  position_buffer_.push_front(position);
+  updatePositionBuffer(position);
   if (!position_buffer_.full()) {
     RCLCPP_WARN_STREAM_THROTTLE(
       this->get_logger(), *this->get_clock(), std::chrono::milliseconds(1000).count(),
       "Buffering Position. Output Skipped.");
     return;
   }
-  const auto median_position = getMedianPosition(position_buffer_);
+  const auto median_position = getMedianPosition();
 
   // calc gnss antenna orientation
   geometry_msgs::msg::Quaternion orientation;
@@ -113,11 +121,20 @@ void GNSSPoser::callbackNavSatFix(
   tf2::fromMsg(gnss_antenna_pose, tf_map2gnss_antenna);
 
   // get TF from base_link to gnss_antenna
-  auto tf_gnss_antenna2base_link_msg_ptr = std::make_shared<geometry_msgs::msg::TransformStamped>();
-  getStaticTransform(
-    gnss_frame_, base_frame_, tf_gnss_antenna2base_link_msg_ptr, nav_sat_fix_msg_ptr->header.stamp);
   tf2::Transform tf_gnss_antenna2base_link{};
-  tf2::fromMsg(tf_gnss_antenna2base_link_msg_ptr->transform, tf_gnss_antenna2base_link);
+  if (tf_gnss_antenna2base_link_) {
+    tf_gnss_antenna2base_link = *tf_gnss_antenna2base_link_;
+  } else {
+    auto tf_gnss_antenna2base_link_msg_ptr =
+      std::make_shared<geometry_msgs::msg::TransformStamped>();
+    const bool is_found = getStaticTransform(
+      gnss_frame_, base_frame_, tf_gnss_antenna2base_link_msg_ptr,
+      nav_sat_fix_msg_ptr->header.stamp);
+    tf2::fromMsg(tf_gnss_antenna2base_link_msg_ptr->transform, tf_gnss_antenna2base_link);
+    if (is_found) {
+      tf_gnss_antenna2base_link_ = tf_gnss_antenna2base_link;
+    }
+  }
 
   // transform pose from gnss_antenna(in map frame) to base_link(in map frame)
   tf2::Transform tf_map2base_link{};
@@ -185,15 +202,14 @@ GNSSStat GNSSPoser::convert(
   if (coordinate_system == CoordinateSystem::UTM) {
     gnss_stat = NavSatFix2UTM(nav_sat_fix_msg, this->get_logger());
   } else if (coordinate_system == CoordinateSystem::LOCAL_CARTESIAN_UTM) {
-    gnss_stat =
-      NavSatFix2LocalCartesianUTM(nav_sat_fix_msg, nav_sat_fix_origin_, this->get_logger());
+    gnss_stat = NavSatFix2LocalCartesianUTM(nav_sat_fix_msg, utm_origin_, this->get_logger());
   } else if (coordinate_system == CoordinateSystem::MGRS) {
     gnss_stat = NavSatFix2MGRS(nav_sat_fix_msg, MGRSPrecision::_100MICRO_METER, this->get_logger());
   } else if (coordinate_system == CoordinateSystem::PLANE) {
     gnss_stat = NavSatFix2PLANE(nav_sat_fix_msg, plane_zone_, this->get_logger());
   } else if (coordinate_system == CoordinateSystem::LOCAL_CARTESIAN_WGS84) {
     gnss_stat =
-      NavSatFix2LocalCartesianWGS84(nav_sat_fix_msg, nav_sat_fix_origin_, this->get_logger());
+      NavSatFix2LocalCartesianWGS84(nav_sat_fix_msg, local_cartesian_origin_, this->get_logger());
   } else {
     RCLCPP_ERROR_STREAM_THROTTLE(
       this->get_logger(), *this->get_clock(), std::chrono::milliseconds(1000).count(),
@@ -211,31 +227,41 @@ geometry_msgs::msg::Point GNSSPoser::getPosition(const GNSSStat & gnss_stat)
   return point;
 }
 
-geometry_msgs::msg::Point GNSSPoser::getMedianPosition(
-  const boost::circular_buffer<geometry_msgs::msg::Point> & position_buffer)
+void GNSSPoser::updatePositionBuffer(const geometry_msgs::msg::Point & position)
 {
-  auto getMedian = [](std::vector<double> array) {
-    std::sort(std::begin(array), std::end(array));
-    const size_t median_index = array.size() / 2;
-    double median = (array.size() % 2)
-                      ? (array.at(median_index))
-                      : ((array.at(median_index) + array.at(median_index - 1)) / 2);
-    return median;
+  auto replaceSorted = [](std::vector<double> & array, const bool erase, const double erased,
+                          const double inserted) {
+    if (erase) {
+      array.erase(std::lower_bound(array.begin(), array.end(), erased));
+    }
+    array.insert(std::upper_bound(array.begin(), array.end(), inserted), inserted);
   };
 
-  std::vector<double> array_x;
-  std::vector<double> array_y;
-  std::vector<double> array_z;
-  for (const auto & position : position_buffer) {
-    array_x.push_back(position.x);
-    array_y.push_back(position.y);
-    array_z.push_back(position.z);
-  }
+  // the oldest position at the back is dropped by push_front once the buffer is full
+  const bool is_full = position_buffer_.full();
+  const geometry_msgs::msg::Point oldest = is_full ? position_buffer_.back() : position;
+  position_buffer_.push_front(position);
+
+  replaceSorted(sorted_x_, is_full, oldest.x, position.x);
+  replaceSorted(sorted_y_, is_full, oldest.y, position.y);
+  replaceSorted(sorted_z_, is_full, oldest.z, position.z);
+}
+
+geometry_msgs::msg::Point GNSSPoser::getMedianPosition() const
+{
+  auto getMedian = [](const std::vector<double> & sorted_array) {
+    const size_t median_index = sorted_array.size() / 2;
+    double median =
+      (sorted_array.size() % 2)
+        ? (sorted_array.at(median_index))
+        : ((sorted_array.at(median_index) + sorted_array.at(median_index - 1)) / 2);
+    return median;
+  };
 
   geometry_msgs::msg::Point median_point;
-  median_point.x = getMedian(array_x);
-  median_point.y = getMedian(array_y);
-  median_point.z = getMedian(array_z);
+  median_point.x = getMedian(sorted_x_);
+  median_point.y = getMedian(sorted_y_);
+  median_point.z = getMedian(sorted_z_);
   return median_point;
 }
 
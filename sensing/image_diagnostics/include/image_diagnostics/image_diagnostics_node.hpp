@@ -22,6 +22,7 @@
 #include <rclcpp/rclcpp.hpp>
 
 #include <sensor_msgs/msg/image.hpp>
+#include <std_msgs/msg/header.hpp>
 #include <tier4_debug_msgs/msg/float32_multi_array_stamped.hpp>
 #include <tier4_debug_msgs/msg/float32_stamped.hpp>
 #include <tier4_debug_msgs/msg/int32_stamped.hpp>
@@ -30,6 +31,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 namespace image_diagnostics
 {
 using diagnostic_updater::DiagnosticStatusWrapper;
@@ -65,6 +67,9 @@ struct ImageParam
   int dark_intensity_thresh = 10;
   float lowVis_freq_thresh = 4.0f;
   int backlight_intensity_thresh = 230;
+
+  // maximum number of frames skipped between two checks while the diagnostic status is stable
+  int max_frame_skip = 0;
 };
 
 enum Image_State : uint8_t { NORMAL = 0, DARK, BLOCKAGE, LOW_VIS, BACKLIGHT };
@@ -73,15 +78,37 @@ std::unordered_map<std::string, cv::Scalar> state_color_map_ = {
   {"BLOCKAGE", cv::Scalar(0, 0, 200)},    {"LOW_VIS", cv::Scalar(0, 200, 200)},
   {"BACKLIGHT", cv::Scalar(200, 0, 200)}, {"BORDER", cv::Scalar(255, 255, 255)}};
 
+// buffers of the frequency analysis of one image block, reused across frames
+struct BlockWorkspace
+{
+  cv::Mat block;
+  cv::Mat spectrum;
+  cv::Mat real_part;
+};
+
 class ImageDiagNode : public rclcpp::Node
 {
 private:
   void ImageChecker(const sensor_msgs::msg::Image::ConstSharedPtr input_image_msg);
+  void publishDebugImages(
+    const std_msgs::msg::Header & header, const std::vector<int> & region_state_vec,
+    const int block_size_h, const int block_size_v);
   void shiftImage(cv::Mat & img);
   void onImageDiagChecker(DiagnosticStatusWrapper & stat);
   ImageParam params_;
   Updater updater_{this};
 
+  // images reused across frames
+  cv::Mat img_gray_;
+  cv::Mat img_gray_32b_;
+  cv::Mat img_gray_blockage_bin_;
+  cv::Mat img_dft_;
+  cv::Mat diag_block_image_;
+  std::vector<BlockWorkspace> block_workspaces_;
+
+  int frame_skip_ = 0;
+  int frames_to_skip_ = 0;
+
 public:
   explicit ImageDiagNode(const rclcpp::NodeOptions & node_options);
 
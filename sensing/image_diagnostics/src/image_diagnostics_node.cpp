@@ -14,8 +14,14 @@
 
 #include "image_diagnostics/image_diagnostics_node.hpp"
 
+#include <opencv2/core/utility.hpp>
+
 #include <std_msgs/msg/header.hpp>
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 namespace image_diagnostics
 {
 using image_diagnostics::Image_State;
@@ -38,6 +44,8 @@ ImageDiagNode::ImageDiagNode(const rclcpp::NodeOptions & node_options)
     std::string(this->get_namespace()) + ": Image_Diagnostics", this,
     &ImageDiagNode::onImageDiagChecker);
   updater_.setPeriod(0.1);
+
+  params_.max_frame_skip = declare_parameter("max_frame_skip", 0);
 }
 
 void ImageDiagNode::onImageDiagChecker(DiagnosticStatusWrapper & stat)
@@ -73,70 +81,66 @@ void ImageDiagNode::onImageDiagChecker(DiagnosticStatusWrapper & stat)
 
 void ImageDiagNode::ImageChecker(const sensor_msgs::msg::Image::ConstSharedPtr input_image_msg)
 {
-  cv::Mat img_gray;
-  cv::Mat img_gray_32b;
-  cv::Mat img_gray_blockage_bin;
-  cv::Mat tmp;
+  if (frames_to_skip_ > 0) {
+    --frames_to_skip_;
+    return;
+  }
+
+  const bool publish_debug_images = gray_image_pub_.getNumSubscribers() > 0 ||
+                                    dft_image_pub_.getNumSubscribers() > 0 ||
+                                    block_diag_image_pub_.getNumSubscribers() > 0;
 
-  img_gray = cv_bridge::toCvCopy(input_image_msg, sensor_msgs::image_encodings::MONO8)->image;
+  const cv::Mat img_input =
+    cv_bridge::toCvShare(input_image_msg, sensor_msgs::image_encodings::MONO8)->image;
 
   cv::Size size;
   size.height = params_.image_resize_height;
-  size.width = static_cast<int>((img_gray.cols * size.height) / img_gray.rows);
-  cv::resize(img_gray, img_gray, size);
-  int block_size_h = std::floor(img_gray.cols / params_.number_block_horizontal);
-  int block_size_v = std::floor(img_gray.rows / params_.number_block_vertical);
+  size.width = static_cast<int>((img_input.cols * size.height) / img_input.rows);
+  cv::resize(img_input, img_gray_, size);
+  int block_size_h = std::floor(img_gray_.cols / params_.number_block_horizontal);
+  int block_size_v = std::floor(img_gray_.rows / params_.number_block_vertical);
   int region_pix_count = block_size_h * block_size_v;
 
-  int block_size_h_dft = cv::getOptimalDFTSize(block_size_h);
-  int block_size_v_dft = cv::getOptimalDFTSize(block_size_v);
-
-  std::vector<int> region_average_vec;
-  std::vector<float> region_blockage_ratio_vec;
-  std::vector<float> region_freq_sum_vec;
   cv::threshold(
-    img_gray, img_gray_blockage_bin, params_.blockage_intensity_thresh, 255, cv::THRESH_BINARY);
-  img_gray.convertTo(img_gray_32b, CV_32FC1);
-  cv::Mat imgDCT(size, CV_32FC1);
-  imgDCT.setTo(0.0);
-  float region_freq_average = 0.0;
-  cv::Mat imgDFT(size, CV_32FC1);
-  imgDFT.setTo(0.0);
-  // calculate the features of each small block in image
-  for (int v = 0; v < params_.number_block_vertical; v++) {
-    for (int h = 0; h < params_.number_block_horizontal; h++) {
-      int x = h * block_size_h;
-      int y = v * block_size_v;
-      cv::Rect roi(x, y, block_size_h, block_size_v);
-      int intensity_average = static_cast<int>(cv::mean(img_gray(roi))[0]);
-      int blockage_pix_num = cv::countNonZero(img_gray_blockage_bin(roi));
-      float roi_blockage_ratio =
+    img_gray_, img_gray_blockage_bin_, params_.blockage_intensity_thresh, 255, cv::THRESH_BINARY);
+  img_gray_.convertTo(img_gray_32b_, CV_32FC1);
+  if (publish_debug_images) {
+    img_dft_.create(size, CV_32FC1);
+    img_dft_.setTo(0.0);
+  }
+
+  const int num_blocks = params_.number_block_horizontal * params_.number_block_vertical;
+  std::vector<int> region_average_vec(num_blocks);
+  std::vector<float> region_blockage_ratio_vec(num_blocks);
+  std::vector<float> region_freq_sum_vec(num_blocks);
+  block_workspaces_.resize(num_blocks);
+  // calculate the features of each small block in image, the blocks are independent
+  cv::parallel_for_(cv::Range(0, num_blocks), [&](const cv::Range & range) {
+    for (int region = range.start; region < range.end; ++region) {
+      const int x = (region % params_.number_block_horizontal) * block_size_h;
+      const int y = (region / params_.number_block_horizontal) * block_size_v;
+      const cv::Rect roi(x, y, block_size_h, block_size_v);
+      auto & workspace = block_workspaces_.at(region);
+
+      region_average_vec[region] = static_cast<int>(cv::mean(img_gray_(roi))[0]);
+      const int blockage_pix_num = cv::countNonZero(img_gray_blockage_bin_(roi));
+      region_blockage_ratio_vec[region] =
         (static_cast<float>(region_pix_count) - static_cast<float>(blockage_pix_num)) /
         static_cast<float>(region_pix_count);
-      cv::copyMakeBorder(
-        img_gray_32b(roi), img_gray_32b(roi), 0, block_size_v_dft - img_gray_32b(roi).rows, 0,
-        block_size_h_dft - img_gray_32b(roi).cols, cv::BORDER_CONSTANT, cv::Scalar::all(0));
-      std::vector<cv::Mat> channelImg{
-        img_gray_32b(roi), cv::Mat::zeros(img_gray_32b(roi).size(), CV_32FC1)};
-      cv::Mat srcComp, freqComp;
-      cv::merge(channelImg, srcComp);
-      cv::dft(srcComp, freqComp);
-      shiftImage(freqComp);
-      cv::split(freqComp, channelImg);
-      cv::Rect original_roi(0, 0, block_size_h, block_size_v);
-      channelImg[0](original_roi)
-        .copyTo(imgDFT(cv::Rect(roi.x, roi.y, block_size_h, block_size_v)));
-
-      cv::Mat rect_tmp = img_gray_32b(roi);
-      channelImg[0](original_roi).copyTo(rect_tmp);
-      cv::log(rect_tmp, rect_tmp);
-      region_freq_average = cv::mean(rect_tmp)[0];
-
-      region_average_vec.push_back(intensity_average);
-      region_blockage_ratio_vec.push_back(roi_blockage_ratio);
-      region_freq_sum_vec.push_back(region_freq_average);
+
+      // real part of the centered spectrum of the block
+      img_gray_32b_(roi).copyTo(workspace.block);
+      cv::dft(workspace.block, workspace.spectrum, cv::DFT_COMPLEX_OUTPUT);
+      cv::extractChannel(workspace.spectrum, workspace.real_part, 0);
+      shiftImage(workspace.real_part);
+      if (publish_debug_images) {
+        workspace.real_part.copyTo(img_dft_(roi));
+      }
+
+      cv::log(workspace.real_part, workspace.real_part);
+      region_freq_sum_vec[region] = cv::mean(workspace.real_part)[0];
     }
-  }
+  });
 
   std::vector<int> region_state_vec;
   int region_state;
@@ -161,7 +165,59 @@ void ImageDiagNode::ImageChecker(const sensor_msgs::msg::Image::ConstSharedPtr i
     region_state_vec.push_back(region_state);
   }
 
-  cv::Mat diag_block_image(size, CV_8UC3);
+  if (publish_debug_images) {
+    publishDebugImages(input_image_msg->header, region_state_vec, block_size_h, block_size_v);
+  }
+
+  const int previous_diagnostic_status = params_.diagnostic_status;
+
+  // summary image status based on all blocks state
+  params_.num_of_regions_normal =
+    std::count(region_state_vec.begin(), region_state_vec.end(), Image_State::NORMAL);
+  params_.num_of_regions_dark =
+    std::count(region_state_vec.begin(), region_state_vec.end(), Image_State::DARK);
+  params_.num_of_regions_blockage =
+    std::count(region_state_vec.begin(), region_state_vec.end(), Image_State::BLOCKAGE);
+  params_.num_of_regions_low_visibility =
+    std::count(region_state_vec.begin(), region_state_vec.end(), Image_State::LOW_VIS);
+  params_.num_of_regions_backlight =
+    std::count(region_state_vec.begin(), region_state_vec.end(), Image_State::BACKLIGHT);
+
+  // diagnose whole image status
+  if (
+    (params_.num_of_regions_dark > params_.dark_regions_num_error_thresh) ||
+    (params_.num_of_regions_blockage > params_.blockage_region_num_error_thresh) ||
+    (params_.num_of_regions_low_visibility > params_.lowVis_region_num_error_thresh) ||
+    (params_.num_of_regions_backlight > params_.backlight_region_num_error_thresh)) {
+    params_.diagnostic_status = 2;
+  } else if (
+    (params_.num_of_regions_dark > params_.dark_regions_num_warn_thresh) ||
+    (params_.num_of_regions_blockage > params_.blockage_region_num_warn_thresh) ||
+    (params_.num_of_regions_low_visibility > params_.lowVis_region_num_warn_thresh) ||
+    (params_.num_of_regions_backlight > params_.backlight_region_num_warn_thresh)) {
+    params_.diagnostic_status = 1;
+  } else {
+    params_.diagnostic_status = 0;
+  }
+  tier4_debug_msgs::msg::Int32Stamped image_state_out;
+  image_state_out.data = params_.diagnostic_status;
+  image_state_pub_->publish(image_state_out);
+
+  // check less and less often while the status does not change, and every frame once it does
+  if (params_.diagnostic_status == previous_diagnostic_status) {
+    frame_skip_ = std::min(frame_skip_ + 1, params_.max_frame_skip);
+  } else {
+    frame_skip_ = 0;
+  }
+  frames_to_skip_ = frame_skip_;
+}
+
+void ImageDiagNode::publishDebugImages(
+  const std_msgs::msg::Header & header, const std::vector<int> & region_state_vec,
+  const int block_size_h, const int block_size_v)
+{
+  const cv::Size size = img_gray_.size();
+  diag_block_image_.create(size, CV_8UC3);
   int j = 0;
   // colorize image block state
   for (int v = 0; v < params_.number_block_vertical; v++) {
@@ -170,23 +226,23 @@ void ImageDiagNode::ImageChecker(const sensor_msgs::msg::Image::ConstSharedPtr i
       int y = v * block_size_v;
       if (region_state_vec[j] == Image_State::DARK) {
         cv::rectangle(
-          diag_block_image, cv::Point(x, y), cv::Point(x + block_size_h, y + block_size_v),
+          diag_block_image_, cv::Point(x, y), cv::Point(x + block_size_h, y + block_size_v),
           state_color_map_["DARK"], -1, cv::LINE_AA);
       } else if (region_state_vec[j] == Image_State::BLOCKAGE) {
         cv::rectangle(
-          diag_block_image, cv::Point(x, y), cv::Point(x + block_size_h, y + block_size_v),
+          diag_block_image_, cv::Point(x, y), cv::Point(x + block_size_h, y + block_size_v),
           state_color_map_["BLOCKAGE"], -1, cv::LINE_AA);
       } else if (region_state_vec[j] == Image_State::LOW_VIS) {
         cv::rectangle(
-          diag_block_image, cv::Point(x, y), cv::Point(x + block_size_h, y + block_size_v),
+          diag_block_image_, cv::Point(x, y), cv::Point(x + block_size_h, y + block_size_v),
           state_color_map_["BACKLIGHT"], -1, cv::LINE_AA);
       } else if (region_state_vec[j] == Image_State::BACKLIGHT) {
         cv::rectangle(
-          diag_block_image, cv::Point(x, y), cv::Point(x + block_size_h, y + block_size_v),
+          diag_block_image_, cv::Point(x, y), cv::Point(x + block_size_h, y + block_size_v),
           state_color_map_["BACKLIGHT"], -1, cv::LINE_AA);
       } else if (region_state_vec[j] == Image_State::NORMAL) {
         cv::rectangle(
-          diag_block_image, cv::Point(x, y), cv::Point(x + block_size_h, y + block_size_v),
+          diag_block_image_, cv::Point(x, y), cv::Point(x + block_size_h, y + block_size_v),
           state_color_map_["NORMAL"], -1, cv::LINE_AA);
       }
       j = j + 1;
@@ -195,61 +251,25 @@ void ImageDiagNode::ImageChecker(const sensor_msgs::msg::Image::ConstSharedPtr i
   // draw boundary of blocks
   for (int v = 1; v < params_.number_block_vertical; v++) {
     cv::line(
-      diag_block_image, cv::Point(0, v * block_size_v), cv::Point(size.width, v * block_size_v),
+      diag_block_image_, cv::Point(0, v * block_size_v), cv::Point(size.width, v * block_size_v),
       state_color_map_["BORDER"], 1, cv::LINE_AA, 0);
   }
   for (int h = 1; h < params_.number_block_horizontal; h++) {
     cv::line(
-      diag_block_image, cv::Point(h * block_size_h, 0), cv::Point(h * block_size_h, size.height),
+      diag_block_image_, cv::Point(h * block_size_h, 0), cv::Point(h * block_size_h, size.height),
       state_color_map_["BORDER"], 1, cv::LINE_AA, 0);
   }
 
-  // summary image status based on all blocks state
-  params_.num_of_regions_normal =
-    std::count(region_state_vec.begin(), region_state_vec.end(), Image_State::NORMAL);
-  params_.num_of_regions_dark =
-    std::count(region_state_vec.begin(), region_state_vec.end(), Image_State::DARK);
-  params_.num_of_regions_blockage =
-    std::count(region_state_vec.begin(), region_state_vec.end(), Image_State::BLOCKAGE);
-  params_.num_of_regions_low_visibility =
-    std::count(region_state_vec.begin(), region_state_vec.end(), Image_State::LOW_VIS);
-  params_.num_of_regions_backlight =
-    std::count(region_state_vec.begin(), region_state_vec.end(), Image_State::BACKLIGHT);
-
-  // diagnose whole image status
-  if (
-    (params_.num_of_regions_dark > params_.dark_regions_num_error_thresh) ||
-    (params_.num_of_regions_blockage > params_.blockage_region_num_error_thresh) ||
-    (params_.num_of_regions_low_visibility > params_.lowVis_region_num_error_thresh) ||
-    (params_.num_of_regions_backlight > params_.backlight_region_num_error_thresh)) {
-    params_.diagnostic_status = 2;
-  } else if (
-    (params_.num_of_regions_dark > params_.dark_regions_num_warn_thresh) ||
-    (params_.num_of_regions_blockage > params_.blockage_region_num_warn_thresh) ||
-    (params_.num_of_regions_low_visibility > params_.lowVis_region_num_warn_thresh) ||
-    (params_.num_of_regions_backlight > params_.backlight_region_num_warn_thresh)) {
-    params_.diagnostic_status = 1;
-  } else {
-    params_.diagnostic_status = 0;
-  }
-  tier4_debug_msgs::msg::Int32Stamped image_state_out;
-  image_state_out.data = params_.diagnostic_status;
-  image_state_pub_->publish(image_state_out);
-
-  img_gray.convertTo(img_gray, CV_8UC1);
-  imgDFT.convertTo(imgDFT, CV_8UC1);
+  cv::Mat img_dft_8u;
+  img_dft_.convertTo(img_dft_8u, CV_8UC1);
 
   // publish topics
   sensor_msgs::msg::Image::SharedPtr gray_image_msg =
-    cv_bridge::CvImage(std_msgs::msg::Header(), "mono8", img_gray).toImageMsg();
+    cv_bridge::CvImage(header, "mono8", img_gray_).toImageMsg();
   sensor_msgs::msg::Image::SharedPtr dft_image_msg =
-    cv_bridge::CvImage(std_msgs::msg::Header(), "mono8", imgDFT).toImageMsg();
+    cv_bridge::CvImage(header, "mono8", img_dft_8u).toImageMsg();
   sensor_msgs::msg::Image::SharedPtr block_diag_image_msg =
-    cv_bridge::CvImage(std_msgs::msg::Header(), "bgr8", diag_block_image).toImageMsg();
-
-  gray_image_msg->header = input_image_msg->header;
-  dft_image_msg->header = input_image_msg->header;
-  block_diag_image_msg->header = input_image_msg->header;
+    cv_bridge::CvImage(header, "bgr8", diag_block_image_).toImageMsg();
 
   gray_image_pub_.publish(gray_image_msg);
   dft_image_pub_.publish(dft_image_msg);
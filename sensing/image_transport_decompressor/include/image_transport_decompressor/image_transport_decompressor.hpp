@@ -15,11 +15,17 @@
 #ifndef IMAGE_TRANSPORT_DECOMPRESSOR__IMAGE_TRANSPORT_DECOMPRESSOR_HPP_
 #define IMAGE_TRANSPORT_DECOMPRESSOR__IMAGE_TRANSPORT_DECOMPRESSOR_HPP_
 
+#ifdef ENABLE_NVJPEG
+#include "image_transport_decompressor/nvjpeg_decoder.hpp"
+#endif
+
 #include <rclcpp/rclcpp.hpp>
 
 #include <sensor_msgs/msg/compressed_image.hpp>
 #include <sensor_msgs/msg/image.hpp>
 
+#include <opencv2/core/core.hpp>
+
 #include <memory>
 #include <string>
 #include <utility>
@@ -34,10 +40,22 @@ public:
 private:
   void onCompressedImage(
     const sensor_msgs::msg::CompressedImage::ConstSharedPtr input_compressed_image_msg);
+#ifdef ENABLE_NVJPEG
+  bool decodeOnGpu(
+    const sensor_msgs::msg::CompressedImage & compressed_image, sensor_msgs::msg::Image & image);
+#endif
 
   rclcpp::Subscription<sensor_msgs::msg::CompressedImage>::SharedPtr compressed_image_sub_;
   rclcpp::Publisher<sensor_msgs::msg::Image>::SharedPtr raw_image_pub_;
   std::string encoding_;
+
+  // decoding buffer reused across frames while the image size does not change
+  cv::Mat decoded_image_;
+
+#ifdef ENABLE_NVJPEG
+  // decoder of the 8-bit color JPEG streams, null when use_nvjpeg is false
+  std::unique_ptr<NvJpegDecoder> nvjpeg_decoder_;
+#endif
 };
 
 }  // namespace image_preprocessor
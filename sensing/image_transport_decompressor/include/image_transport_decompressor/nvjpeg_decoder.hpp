@@ -0,0 +1,54 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef IMAGE_TRANSPORT_DECOMPRESSOR__NVJPEG_DECODER_HPP_
+#define IMAGE_TRANSPORT_DECOMPRESSOR__NVJPEG_DECODER_HPP_
+
+#include <sensor_msgs/msg/image.hpp>
+
+#include <cuda_runtime_api.h>
+#include <nvjpeg.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace image_preprocessor
+{
+// decodes JPEG streams on the GPU with nvJPEG, into a device buffer reused across frames
+class NvJpegDecoder
+{
+public:
+  NvJpegDecoder();
+  ~NvJpegDecoder();
+  NvJpegDecoder(const NvJpegDecoder &) = delete;
+  NvJpegDecoder & operator=(const NvJpegDecoder &) = delete;
+
+  bool isInitialized() const { return is_initialized_; }
+
+  // decode the stream into the 8-bit interleaved data of the image, with its channels in the RGB
+  // order if rgb_order and in the BGR order otherwise. false if the stream could not be decoded
+  bool decode(
+    const std::vector<uint8_t> & data, const bool rgb_order, sensor_msgs::msg::Image & image);
+
+private:
+  nvjpegHandle_t handle_{nullptr};
+  nvjpegJpegState_t state_{nullptr};
+  cudaStream_t stream_{nullptr};
+  unsigned char * device_buffer_{nullptr};
+  size_t device_buffer_size_{0};
+  bool is_initialized_{false};
+};
+}  // namespace image_preprocessor
+
+#endif  // IMAGE_TRANSPORT_DECOMPRESSOR__NVJPEG_DECODER_HPP_
@@ -53,8 +53,6 @@
 
 #include <sensor_msgs/image_encodings.hpp>
 
-#include <cv_bridge/cv_bridge.h>
-
 #include <limits>
 #include <memory>
 #include <string>
@@ -72,33 +70,90 @@ ImageTransportDecompressor::ImageTransportDecompressor(const rclcpp::NodeOptions
     std::bind(&ImageTransportDecompressor::onCompressedImage, this, std::placeholders::_1));
   raw_image_pub_ =
     create_publisher<sensor_msgs::msg::Image>("~/output/raw_image", rclcpp::SensorDataQoS());
+
+  const bool use_nvjpeg = declare_parameter("use_nvjpeg", false);
+#ifdef ENABLE_NVJPEG
+  if (use_nvjpeg) {
+    nvjpeg_decoder_ = std::make_unique<NvJpegDecoder>();
+    if (!nvjpeg_decoder_->isInitialized()) {
+      RCLCPP_WARN(get_logger(), "Failed to initialize nvJPEG, images are decoded on the CPU");
+      nvjpeg_decoder_.reset();
+    }
+  }
+#else
+  if (use_nvjpeg) {
+    RCLCPP_WARN(get_logger(), "Built without nvJPEG, images are decoded on the CPU");
+  }
+#endif
+}
+
+#ifdef ENABLE_NVJPEG
+bool ImageTransportDecompressor::decodeOnGpu(
+  const sensor_msgs::msg::CompressedImage & compressed_image, sensor_msgs::msg::Image & image)
+{
+  // only the JPEG streams of rgb8 and bgr8 images, the other ones are decoded on the CPU
+  const size_t split_pos = compressed_image.format.find(';');
+  if (
+    split_pos == std::string::npos ||
+    compressed_image.format.find("jpeg", split_pos) == std::string::npos) {
+    return false;
+  }
+  std::string image_encoding = compressed_image.format.substr(0, split_pos);
+  if (encoding_ == std::string("rgb8") || encoding_ == std::string("bgr8")) {
+    image_encoding = encoding_;
+  }
+  const bool is_rgb8 = image_encoding == sensor_msgs::image_encodings::RGB8;
+  if (!is_rgb8 && image_encoding != sensor_msgs::image_encodings::BGR8) {
+    return false;
+  }
+
+  // the channels of a stream not compressed from bgr are swapped, as in the CPU path
+  const bool compressed_bgr_image =
+    compressed_image.format.find("compressed bgr", split_pos) != std::string::npos;
+  if (!nvjpeg_decoder_->decode(compressed_image.data, is_rgb8 == compressed_bgr_image, image)) {
+    return false;
+  }
+  image.encoding = image_encoding;
+  return true;
 }
+#endif
 
 void ImageTransportDecompressor::onCompressedImage(
   const sensor_msgs::msg::CompressedImage::ConstSharedPtr input_compressed_image_msg)
 {
-  cv_bridge::CvImagePtr cv_ptr(new cv_bridge::CvImage);
+  auto image_ptr = std::make_unique<sensor_msgs::msg::Image>();
   // Copy message header
-  cv_ptr->header = input_compressed_image_msg->header;
+  image_ptr->header = input_compressed_image_msg->header;
+
+  // color conversion applied while copying the decoded image into the output message
+  int color_conversion = -1;
+
+#ifdef ENABLE_NVJPEG
+  // decoded straight into the encoding of the message, falling back to the CPU on failure
+  if (nvjpeg_decoder_ && decodeOnGpu(*input_compressed_image_msg, *image_ptr)) {
+    raw_image_pub_->publish(std::move(image_ptr));
+    return;
+  }
+#endif
 
   // Decode color/mono image
   try {
-    cv_ptr->image = cv::imdecode(cv::Mat(input_compressed_image_msg->data), cv::IMREAD_COLOR);
+    cv::imdecode(cv::Mat(input_compressed_image_msg->data), cv::IMREAD_COLOR, &decoded_image_);
 
     // Assign image encoding string
     const size_t split_pos = input_compressed_image_msg->format.find(';');
     if (split_pos == std::string::npos) {
       // Older version of compressed_image_transport does not signal image format
-      switch (cv_ptr->image.channels()) {
+      switch (decoded_image_.channels()) {
         case 1:
-          cv_ptr->encoding = sensor_msgs::image_encodings::MONO8;
+          image_ptr->encoding = sensor_msgs::image_encodings::MONO8;
           break;
         case 3:
-          cv_ptr->encoding = sensor_msgs::image_encodings::BGR8;
+          image_ptr->encoding = sensor_msgs::image_encodings::BGR8;
           break;
         default:
           RCLCPP_ERROR(
-            get_logger(), "Unsupported number of channels: %i", cv_ptr->image.channels());
+            get_logger(), "Unsupported number of channels: %i", decoded_image_.channels());
           break;
       }
     } else {
@@ -113,7 +168,7 @@ void ImageTransportDecompressor::onCompressedImage(
         image_encoding = input_compressed_image_msg->format.substr(0, split_pos);
       }
 
-      cv_ptr->encoding = image_encoding;
+      image_ptr->encoding = image_encoding;
 
       if (sensor_msgs::image_encodings::isColor(image_encoding)) {
         std::string compressed_encoding = input_compressed_image_msg->format.substr(split_pos);
@@ -126,54 +181,74 @@ void ImageTransportDecompressor::onCompressedImage(
           if (
             (image_encoding == sensor_msgs::image_encodings::RGB8) ||
             (image_encoding == sensor_msgs::image_encodings::RGB16)) {
-            cv::cvtColor(cv_ptr->image, cv_ptr->image, CV_BGR2RGB);
+            color_conversion = CV_BGR2RGB;
           }
 
           if (
             (image_encoding == sensor_msgs::image_encodings::RGBA8) ||
             (image_encoding == sensor_msgs::image_encodings::RGBA16)) {
-            cv::cvtColor(cv_ptr->image, cv_ptr->image, CV_BGR2RGBA);
+            color_conversion = CV_BGR2RGBA;
           }
 
           if (
             (image_encoding == sensor_msgs::image_encodings::BGRA8) ||
             (image_encoding == sensor_msgs::image_encodings::BGRA16)) {
-            cv::cvtColor(cv_ptr->image, cv_ptr->image, CV_BGR2BGRA);
+            color_conversion = CV_BGR2BGRA;
           }
         } else {
           // if necessary convert colors from rgb to bgr
           if (
             (image_encoding == sensor_msgs::image_encodings::BGR8) ||
             (image_encoding == sensor_msgs::image_encodings::BGR16)) {
-            cv::cvtColor(cv_ptr->image, cv_ptr->image, CV_RGB2BGR);
+            color_conversion = CV_RGB2BGR;
           }
 
           if (
             (image_encoding == sensor_msgs::image_encodings::BGRA8) ||
             (image_encoding == sensor_msgs::image_encodings::BGRA16)) {
-            cv::cvtColor(cv_ptr->image, cv_ptr->image, CV_RGB2BGRA);
+            color_conversion = CV_RGB2BGRA;
           }
 
           if (
             (image_encoding == sensor_msgs::image_encodings::RGBA8) ||
             (image_encoding == sensor_msgs::image_encodings::RGBA16)) {
-            cv::cvtColor(cv_ptr->image, cv_ptr->image, CV_RGB2RGBA);
+            color_conversion = CV_RGB2RGBA;
           }
         }
       }
     }
+
+    const int rows = decoded_image_.rows;
+    const int cols = decoded_image_.cols;
+    if ((rows <= 0) || (cols <= 0)) {
+      return;
+    }
+
+    // Write the decoded image straight into the message data, converting colors on the way,
+    // instead of converting in place and copying the result into the message afterwards
+    const bool has_alpha = (color_conversion == CV_BGR2RGBA) ||
+                           (color_conversion == CV_BGR2BGRA) ||
+                           (color_conversion == CV_RGB2BGRA) || (color_conversion == CV_RGB2RGBA);
+    const int channels = has_alpha ? 4 : decoded_image_.channels();
+    const int type = CV_MAKETYPE(decoded_image_.depth(), channels);
+    image_ptr->height = rows;
+    image_ptr->width = cols;
+    image_ptr->is_bigendian = 0;
+    image_ptr->step = cols * CV_ELEM_SIZE(type);
+    image_ptr->data.resize(static_cast<size_t>(image_ptr->step) * rows);
+    cv::Mat output_image(rows, cols, type, image_ptr->data.data(), image_ptr->step);
+    if (color_conversion < 0) {
+      decoded_image_.copyTo(output_image);
+    } else {
+      cv::cvtColor(decoded_image_, output_image, color_conversion);
+    }
   } catch (cv::Exception & e) {
     RCLCPP_ERROR(get_logger(), "%s", e.what());
+    return;
   }
 
-  size_t rows = cv_ptr->image.rows;
-  size_t cols = cv_ptr->image.cols;
-
-  if ((rows > 0) && (cols > 0)) {
-    // Publish message to user callback
-    auto image_ptr = std::make_unique<sensor_msgs::msg::Image>(*cv_ptr->toImageMsg());
-    raw_image_pub_->publish(std::move(image_ptr));
-  }
+  // Publish message to user callback
+  raw_image_pub_->publish(std::move(image_ptr));
 }
 }  // namespace image_preprocessor
 
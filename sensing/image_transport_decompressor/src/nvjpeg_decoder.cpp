@@ -0,0 +1,97 @@
+// Copyright 2023 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "image_transport_decompressor/nvjpeg_decoder.hpp"
+
+#include <vector>
+
+namespace image_preprocessor
+{
+NvJpegDecoder::NvJpegDecoder()
+{
+  is_initialized_ = nvjpegCreateSimple(&handle_) == NVJPEG_STATUS_SUCCESS &&
+                    nvjpegJpegStateCreate(handle_, &state_) == NVJPEG_STATUS_SUCCESS &&
+                    cudaStreamCreateWithFlags(&stream_, cudaStreamNonBlocking) == cudaSuccess;
+}
+
+NvJpegDecoder::~NvJpegDecoder()
+{
+  if (device_buffer_) {
+    cudaFree(device_buffer_);
+  }
+  if (stream_) {
+    cudaStreamDestroy(stream_);
+  }
+  if (state_) {
+    nvjpegJpegStateDestroy(state_);
+  }
+  if (handle_) {
+    nvjpegDestroy(handle_);
+  }
+}
+
+bool NvJpegDecoder::decode(
+  const std::vector<uint8_t> & data, const bool rgb_order, sensor_msgs::msg::Image & image)
+{
+  int num_components{0};
+  nvjpegChromaSubsampling_t subsampling;
+  int widths[NVJPEG_MAX_COMPONENT];
+  int heights[NVJPEG_MAX_COMPONENT];
+  if (
+    nvjpegGetImageInfo(
+      handle_, data.data(), data.size(), &num_components, &subsampling, widths, heights) !=
+    NVJPEG_STATUS_SUCCESS) {
+    return false;
+  }
+  if (widths[0] <= 0 || heights[0] <= 0) {
+    return false;
+  }
+
+  const size_t width = static_cast<size_t>(widths[0]);
+  const size_t height = static_cast<size_t>(heights[0]);
+  const size_t step = width * 3;
+  const size_t size = step * height;
+  if (device_buffer_size_ < size) {
+    if (device_buffer_) {
+      cudaFree(device_buffer_);
+      device_buffer_ = nullptr;
+      device_buffer_size_ = 0;
+    }
+    if (cudaMalloc(reinterpret_cast<void **>(&device_buffer_), size) != cudaSuccess) {
+      device_buffer_ = nullptr;
+      return false;
+    }
+    device_buffer_size_ = size;
+  }
+
+  // the interleaved output is in the channel order of the message, so no conversion is needed
+  nvjpegImage_t output{};
+  output.channel[0] = device_buffer_;
+  output.pitch[0] = step;
+  const auto output_format = rgb_order ? NVJPEG_OUTPUT_RGBI : NVJPEG_OUTPUT_BGRI;
+  if (
+    nvjpegDecode(handle_, state_, data.data(), data.size(), output_format, &output, stream_) !=
+    NVJPEG_STATUS_SUCCESS) {
+    return false;
+  }
+
+  image.height = height;
+  image.width = width;
+  image.is_bigendian = 0;
+  image.step = step;
+  image.data.resize(size);
+  cudaMemcpyAsync(image.data.data(), device_buffer_, size, cudaMemcpyDeviceToHost, stream_);
+  return cudaStreamSynchronize(stream_) == cudaSuccess;
+}
+}  // namespace image_preprocessor
@@ -15,6 +15,7 @@
 #ifndef POINTCLOUD_PREPROCESSOR__BLOCKAGE_DIAG__BLOCKAGE_DIAG_NODELET_HPP_
 #define POINTCLOUD_PREPROCESSOR__BLOCKAGE_DIAG__BLOCKAGE_DIAG_NODELET_HPP_
 
+#include "pointcloud_preprocessor/blockage_diag/ring_bitset.hpp"
 #include "pointcloud_preprocessor/filter.hpp"
 
 #include <diagnostic_updater/diagnostic_updater.hpp>
@@ -29,6 +30,8 @@
 
 #include <cv_bridge/cv_bridge.h>
 
+#include <boost/circular_buffer.hpp>
+
 #include <string>
 #include <vector>
 
@@ -71,6 +74,10 @@ private:
   std::string lidar_model_;
   uint buffering_frames_ = 100;
   uint buffering_interval_ = 5;
+  uint frame_count_ = 0;
+  boost::circular_buffer<RingBitset> no_return_mask_buffer_;
+  double debug_image_interval_;
+  rclcpp::Time last_debug_image_time_;
 
 public:
   PCL_MAKE_ALIGNED_OPERATOR_NEW
@@ -0,0 +1,213 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINTCLOUD_PREPROCESSOR__BLOCKAGE_DIAG__RING_BITSET_HPP_
+#define POINTCLOUD_PREPROCESSOR__BLOCKAGE_DIAG__RING_BITSET_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+namespace pointcloud_preprocessor
+{
+// A binary image of rows (LiDAR rings) by columns (azimuth bins), one bit per pixel, packed in
+// 64 bit words per row. The morphology matches the one of OpenCV with a rectangle kernel and the
+// default border values, i.e. the pixels out of the image do not erode nor dilate it.
+class RingBitset
+{
+public:
+  RingBitset() = default;
+  RingBitset(const std::size_t rows, const std::size_t cols, const bool value = false)
+  : rows_(rows),
+    cols_(cols),
+    words_per_row_((cols + 63) / 64),
+    words_(rows * words_per_row_, value ? ~std::uint64_t{0} : 0)
+  {
+    clearPadding();
+  }
+
+  std::size_t rows() const { return rows_; }
+  std::size_t cols() const { return cols_; }
+
+  bool get(const std::size_t row, const std::size_t col) const
+  {
+    return (words_[row * words_per_row_ + col / 64] >> (col % 64)) & 1;
+  }
+  void set(const std::size_t row, const std::size_t col)
+  {
+    words_[row * words_per_row_ + col / 64] |= std::uint64_t{1} << (col % 64);
+  }
+
+  void invert()
+  {
+    for (auto & word : words_) {
+      word = ~word;
+    }
+    clearPadding();
+  }
+
+  RingBitset & operator&=(const RingBitset & other)
+  {
+    for (std::size_t i = 0; i < words_.size(); ++i) {
+      words_[i] &= other.words_[i];
+    }
+    return *this;
+  }
+  RingBitset & operator|=(const RingBitset & other)
+  {
+    for (std::size_t i = 0; i < words_.size(); ++i) {
+      words_[i] |= other.words_[i];
+    }
+    return *this;
+  }
+  // keep the pixels which are not set in other
+  RingBitset & andNot(const RingBitset & other)
+  {
+    for (std::size_t i = 0; i < words_.size(); ++i) {
+      words_[i] &= ~other.words_[i];
+    }
+    return *this;
+  }
+
+  // erosion and dilation by a (2 * radius + 1) square
+  void erode(const std::size_t radius) { morph(radius, true); }
+  void dilate(const std::size_t radius) { morph(radius, false); }
+
+  // the number of set pixels in the rows [row_begin, row_end)
+  std::size_t count(const std::size_t row_begin, const std::size_t row_end) const
+  {
+    std::size_t num = 0;
+    for (std::size_t i = row_begin * words_per_row_; i < row_end * words_per_row_; ++i) {
+      num += __builtin_popcountll(words_[i]);
+    }
+    return num;
+  }
+
+  // the first and the past the last column having a set pixel in the rows [row_begin, row_end),
+  // {0, 0} when there is none, like the bounding rectangle of cv::boundingRect
+  std::pair<std::size_t, std::size_t> columnExtent(
+    const std::size_t row_begin, const std::size_t row_end) const
+  {
+    std::vector<std::uint64_t> columns(words_per_row_, 0);
+    for (std::size_t row = row_begin; row < row_end; ++row) {
+      for (std::size_t w = 0; w < words_per_row_; ++w) {
+        columns[w] |= words_[row * words_per_row_ + w];
+      }
+    }
+    std::size_t first = 0;
+    while (first < words_per_row_ && columns[first] == 0) {
+      ++first;
+    }
+    if (first == words_per_row_) {
+      return {0, 0};
+    }
+    std::size_t last = words_per_row_ - 1;
+    while (columns[last] == 0) {
+      --last;
+    }
+    return {
+      first * 64 + __builtin_ctzll(columns[first]),
+      last * 64 + 64 - __builtin_clzll(columns[last])};
+  }
+
+private:
+  void clearPadding()
+  {
+    if (cols_ % 64 == 0) {
+      return;
+    }
+    const std::uint64_t mask = (std::uint64_t{1} << (cols_ % 64)) - 1;
+    for (std::size_t row = 0; row < rows_; ++row) {
+      words_[row * words_per_row_ + words_per_row_ - 1] &= mask;
+    }
+  }
+
+  // a row shifted so that pixel col takes the value of pixel col + offset,
+  // the pixels shifted in from out of the row take outside
+  void shiftRow(
+    const std::uint64_t * row, const long offset, const bool outside, std::uint64_t * out) const
+  {
+    const long num_words = static_cast<long>(words_per_row_);
+    const long word_offset = offset >= 0 ? offset / 64 : -((-offset + 63) / 64);
+    const int bit_offset = static_cast<int>(offset - word_offset * 64);
+    const auto word_at = [&](const long w) { return 0 <= w && w < num_words ? row[w] : 0; };
+    for (long w = 0; w < num_words; ++w) {
+      const std::uint64_t low = word_at(w + word_offset);
+      const std::uint64_t high = word_at(w + word_offset + 1);
+      out[w] = bit_offset == 0 ? low : (low >> bit_offset) | (high << (64 - bit_offset));
+    }
+    if (!outside) {
+      return;
+    }
+    // the columns [first, last) came from out of the row
+    const std::size_t distance = std::min(static_cast<std::size_t>(std::abs(offset)), cols_);
+    const std::size_t first = offset > 0 ? cols_ - distance : 0;
+    const std::size_t last = offset > 0 ? cols_ : distance;
+    for (std::size_t col = first; col < last; ++col) {
+      out[col / 64] |= std::uint64_t{1} << (col % 64);
+    }
+  }
+
+  // the square kernel is separable into a row and a column pass
+  void morph(const std::size_t radius, const bool is_erosion)
+  {
+    if (radius == 0 || rows_ == 0 || cols_ == 0) {
+      return;
+    }
+    std::vector<std::uint64_t> horizontal(words_.size());
+    std::vector<std::uint64_t> shifted(words_per_row_);
+    for (std::size_t row = 0; row < rows_; ++row) {
+      const std::uint64_t * src = &words_[row * words_per_row_];
+      std::uint64_t * dst = &horizontal[row * words_per_row_];
+      for (std::size_t w = 0; w < words_per_row_; ++w) {
+        dst[w] = src[w];
+      }
+      for (long offset = -static_cast<long>(radius); offset <= static_cast<long>(radius);
+           ++offset) {
+        if (offset == 0) {
+          continue;
+        }
+        shiftRow(src, offset, is_erosion, shifted.data());
+        for (std::size_t w = 0; w < words_per_row_; ++w) {
+          dst[w] = is_erosion ? (dst[w] & shifted[w]) : (dst[w] | shifted[w]);
+        }
+      }
+    }
+    for (std::size_t row = 0; row < rows_; ++row) {
+      const std::size_t row_begin = row >= radius ? row - radius : 0;
+      const std::size_t row_end = std::min(row + radius + 1, rows_);
+      std::uint64_t * dst = &words_[row * words_per_row_];
+      for (std::size_t w = 0; w < words_per_row_; ++w) {
+        std::uint64_t word = horizontal[row_begin * words_per_row_ + w];
+        for (std::size_t r = row_begin + 1; r < row_end; ++r) {
+          const std::uint64_t other = horizontal[r * words_per_row_ + w];
+          word = is_erosion ? (word & other) : (word | other);
+        }
+        dst[w] = word;
+      }
+    }
+    clearPadding();
+  }
+
+  std::size_t rows_{0};
+  std::size_t cols_{0};
+  std::size_t words_per_row_{0};
+  std::vector<std::uint64_t> words_;
+};
+}  // namespace pointcloud_preprocessor
+
+#endif  // POINTCLOUD_PREPROCESSOR__BLOCKAGE_DIAG__RING_BITSET_HPP_
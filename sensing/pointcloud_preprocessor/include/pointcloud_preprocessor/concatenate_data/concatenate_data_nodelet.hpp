@@ -63,6 +63,7 @@
 // ROS includes
 #include "autoware_point_types/types.hpp"
 
+#include <Eigen/Core>
 #include <diagnostic_updater/diagnostic_updater.hpp>
 #include <point_cloud_msg_wrapper/point_cloud_msg_wrapper.hpp>
 #include <tier4_autoware_utils/ros/debug_publisher.hpp>
@@ -150,14 +151,15 @@ private:
   std::vector<double> input_offset_;
   std::map<std::string, double> offset_map_;
 
-  void transformPointCloud(const PointCloud2::ConstSharedPtr & in, PointCloud2::SharedPtr & out);
-  void combineClouds(
-    const PointCloud2::ConstSharedPtr & in1, const PointCloud2::ConstSharedPtr & in2,
-    PointCloud2::SharedPtr & out);
+  /** \brief Look up the transform from the cloud frame to output_frame_ at the cloud stamp. */
+  bool getTransformToOutputFrame(const PointCloud2 & cloud, Eigen::Matrix4f & transform);
+  /** \brief Ego motion from old_stamp to new_stamp integrated from the twist queue. */
+  Eigen::Matrix4f computeTransformToAdjustForOldTimestamp(
+    const rclcpp::Time & old_stamp, const rclcpp::Time & new_stamp);
   void publish();
 
   void convertToXYZICloud(
-    const sensor_msgs::msg::PointCloud2::SharedPtr & input_ptr,
+    const sensor_msgs::msg::PointCloud2::ConstSharedPtr & input_ptr,
     sensor_msgs::msg::PointCloud2::SharedPtr & output_ptr);
   void setPeriod(const int64_t new_period);
   void cloud_callback(
@@ -41,7 +41,9 @@
 
 #include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace pointcloud_preprocessor
 {
@@ -53,6 +55,10 @@ class DistortionCorrectorComponent : public rclcpp::Node
 public:
   explicit DistortionCorrectorComponent(const rclcpp::NodeOptions & options);
 
+  /** \brief Undistort the points in place using the twist/IMU received so far. Used when the
+   * corrector runs as a stage of another node. */
+  bool undistortPointCloud(PointCloud2 & points);
+
 private:
   void onPointCloud(PointCloud2::UniquePtr points_msg);
   void onTwistWithCovarianceStamped(
@@ -75,9 +81,24 @@ private:
   tf2_ros::Buffer tf2_buffer_{get_clock()};
   tf2_ros::TransformListener tf2_listener_{tf2_buffer_};
 
+  // guards the queues when undistortPointCloud() is called from another node's thread
+  std::mutex mutex_;
   std::deque<geometry_msgs::msg::TwistStamped> twist_queue_;
   std::deque<geometry_msgs::msg::Vector3Stamped> angular_velocity_queue_;
 
+  // Per-scan structure-of-arrays work buffers, kept across callbacks to avoid reallocation.
+  // Pass 1 integrates the ego pose (yaw and odometry translation) for every point, pass 2 applies
+  // the resulting transforms over contiguous x/y/z lanes so the compiler can vectorize it.
+  std::vector<float> x_buf_;
+  std::vector<float> y_buf_;
+  std::vector<float> z_buf_;
+  std::vector<float> cos_theta_buf_;
+  std::vector<float> sin_theta_buf_;
+  std::vector<float> odom_x_buf_;
+  std::vector<float> odom_y_buf_;
+  std::vector<double> twist_stamps_;
+  std::vector<double> imu_stamps_;
+
   std::string base_link_frame_ = "base_link";
   std::string time_stamp_field_name_;
   bool use_imu_;
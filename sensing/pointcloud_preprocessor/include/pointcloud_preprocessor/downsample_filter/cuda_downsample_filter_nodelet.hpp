@@ -0,0 +1,74 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINTCLOUD_PREPROCESSOR__DOWNSAMPLE_FILTER__CUDA_DOWNSAMPLE_FILTER_NODELET_HPP_
+#define POINTCLOUD_PREPROCESSOR__DOWNSAMPLE_FILTER__CUDA_DOWNSAMPLE_FILTER_NODELET_HPP_
+
+#include "pointcloud_preprocessor/downsample_filter/cuda_voxel_grid_downsample.hpp"
+#include "pointcloud_preprocessor/filter.hpp"
+
+#include <string>
+#include <vector>
+
+namespace pointcloud_preprocessor
+{
+class CudaVoxelGridDownsampleFilterComponent : public pointcloud_preprocessor::Filter
+{
+protected:
+  CudaVoxelGridDownsampleFilterComponent(
+    const std::string & filter_name, const rclcpp::NodeOptions & options,
+    CudaVoxelGridDownsample::Mode mode);
+
+  void filter(
+    const PointCloud2ConstPtr & input, const IndicesPtr & indices, PointCloud2 & output) override;
+
+  // The transform to the input frame is applied on the device while points are hashed
+  void faster_filter(
+    const PointCloud2ConstPtr & input, const IndicesPtr & indices, PointCloud2 & output,
+    const TransformInfo & transform_info) override;
+
+private:
+  void downsample(
+    const PointCloud2 & input, const TransformInfo & transform_info, const std::string & frame_id,
+    PointCloud2 & output);
+
+  double voxel_size_x_;
+  double voxel_size_y_;
+  double voxel_size_z_;
+
+  CudaVoxelGridDownsample::Mode mode_;
+  CudaVoxelGridDownsample downsampler_;
+
+  /** \brief Parameter service callback result : needed to be hold */
+  OnSetParametersCallbackHandle::SharedPtr set_param_res_;
+
+  /** \brief Parameter service callback */
+  rcl_interfaces::msg::SetParametersResult paramCallback(const std::vector<rclcpp::Parameter> & p);
+
+public:
+  PCL_MAKE_ALIGNED_OPERATOR_NEW
+  explicit CudaVoxelGridDownsampleFilterComponent(const rclcpp::NodeOptions & options);
+};
+
+class CudaApproximateDownsampleFilterComponent : public CudaVoxelGridDownsampleFilterComponent
+{
+public:
+  PCL_MAKE_ALIGNED_OPERATOR_NEW
+  explicit CudaApproximateDownsampleFilterComponent(const rclcpp::NodeOptions & options);
+};
+}  // namespace pointcloud_preprocessor
+
+// clang-format off
+#endif  // POINTCLOUD_PREPROCESSOR__DOWNSAMPLE_FILTER__CUDA_DOWNSAMPLE_FILTER_NODELET_HPP_
+// clang-format on
@@ -0,0 +1,99 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINTCLOUD_PREPROCESSOR__DOWNSAMPLE_FILTER__CUDA_VOXEL_GRID_DOWNSAMPLE_HPP_
+#define POINTCLOUD_PREPROCESSOR__DOWNSAMPLE_FILTER__CUDA_VOXEL_GRID_DOWNSAMPLE_HPP_
+
+#include <cuda_utils/cuda_unique_ptr.hpp>
+#include <cuda_utils/stream_unique_ptr.hpp>
+
+#include <cuda_runtime_api.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace pointcloud_preprocessor
+{
+struct CudaVoxelGridParam
+{
+  float voxel_size_x;
+  float voxel_size_y;
+  float voxel_size_z;
+  // row-major 4x4 transform applied to every point before hashing
+  float transform[16];
+  bool need_transform;
+};
+
+/** \brief Voxel grid downsampling on the device.
+ * Points are hashed by voxel into an open addressing table; each occupied voxel is replaced by the
+ * centroid of its points (pcl::VoxelGrid) or by the point nearest to that centroid
+ * (pcl::VoxelGridNearestCentroid). The result is kept on the device so that GPU consumers in the
+ * same process can take it directly, and mirrored into pinned host memory on request.
+ */
+class CudaVoxelGridDownsample
+{
+public:
+  enum class Mode { Centroid, NearestCentroid };
+
+  CudaVoxelGridDownsample();
+
+  /** \brief Downsample a raw PointCloud2 buffer on the host.
+   * \return the number of output points, readable through outputHost() after the call
+   */
+  std::size_t downsampleHost(
+    const std::uint8_t * data, std::size_t num_points, std::size_t point_step,
+    std::size_t x_offset, std::size_t y_offset, std::size_t z_offset,
+    const CudaVoxelGridParam & param, Mode mode);
+
+  /** \brief Downsample a raw PointCloud2 buffer which already lives on the device.
+   * The call is asynchronous on stream() except for the read back of the output size.
+   * \return the number of output points, readable through outputDevice()
+   */
+  std::size_t downsampleDevice(
+    const std::uint8_t * data_d, std::size_t num_points, std::size_t point_step,
+    std::size_t x_offset, std::size_t y_offset, std::size_t z_offset,
+    const CudaVoxelGridParam & param, Mode mode);
+
+  /** \brief Output points as (x, y, z, unused) on the device. */
+  const float4 * outputDevice() const { return output_d_.get(); }
+
+  /** \brief Output points as (x, y, z, unused) in pinned host memory. */
+  const float4 * outputHost() const { return output_h_.get(); }
+
+  cudaStream_t stream() const { return *stream_; }
+
+private:
+  void reserve(std::size_t num_points);
+
+  cuda_utils::StreamUniquePtr stream_;
+
+  std::size_t points_capacity_{0};
+  std::size_t data_capacity_{0};
+  std::size_t table_size_{0};
+
+  cuda_utils::CudaUniquePtr<std::uint8_t[]> data_d_;
+  cuda_utils::CudaUniquePtr<float4[]> points_d_;
+  cuda_utils::CudaUniquePtr<std::uint32_t[]> point_slots_d_;
+  cuda_utils::CudaUniquePtr<unsigned long long[]> table_keys_d_;  // NOLINT
+  cuda_utils::CudaUniquePtr<float4[]> table_sums_d_;
+  cuda_utils::CudaUniquePtr<unsigned long long[]> table_nearest_d_;  // NOLINT
+  cuda_utils::CudaUniquePtr<float4[]> output_d_;
+  cuda_utils::CudaUniquePtr<std::uint32_t> num_output_d_;
+
+  cuda_utils::CudaUniquePtrHost<float4[]> output_h_;
+  cuda_utils::CudaUniquePtrHost<std::uint32_t> num_output_h_;
+};
+}  // namespace pointcloud_preprocessor
+
+#endif  // POINTCLOUD_PREPROCESSOR__DOWNSAMPLE_FILTER__CUDA_VOXEL_GRID_DOWNSAMPLE_HPP_
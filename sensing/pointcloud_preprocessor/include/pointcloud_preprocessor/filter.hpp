@@ -52,6 +52,7 @@
 #ifndef POINTCLOUD_PREPROCESSOR__FILTER_HPP_
 #define POINTCLOUD_PREPROCESSOR__FILTER_HPP_
 
+#include <cstring>
 #include <memory>
 #include <string>
 #include <vector>
@@ -77,6 +78,8 @@
 #include <tf2_ros/create_timer_ros.h>
 #include <tf2_ros/transform_listener.h>
 
+#include <diagnostic_updater/diagnostic_updater.hpp>
+
 // Include tier4 autoware utils
 #include <tier4_autoware_utils/ros/debug_publisher.hpp>
 #include <tier4_autoware_utils/system/stop_watch.hpp>
@@ -133,6 +136,15 @@ public:
     const std::string & filter_name = "pointcloud_preprocessor_filter",
     const rclcpp::NodeOptions & options = rclcpp::NodeOptions());
 
+  /** \brief Run this filter on an already received cloud without going through the subscriber,
+   * including the input/output frame handling done by the input callbacks. Used to chain several
+   * filters inside one node.
+   * \param input the input point cloud dataset.
+   * \param output the resultant filtered PointCloud2 (replaced on success)
+   * \return false if the input is invalid or a transform is not available
+   */
+  bool runFilter(const PointCloud2ConstPtr & input, std::unique_ptr<PointCloud2> & output);
+
 protected:
   struct TransformInfo
   {
@@ -197,12 +209,68 @@ protected:
   virtual void filter(
     const PointCloud2ConstPtr & input, const IndicesPtr & indices, PointCloud2 & output) = 0;
 
-  // TODO(sykwer): Temporary Implementation: Remove this interface when all the filter nodes conform
-  // to new API. It's not pure virtual function so that a child class does not have to implement
-  // this function.
+  /** \brief Filter method called by the input callback. The input is given in its original frame
+   * together with the transform to the input frame, so that a child can apply the transform while
+   * it traverses the points instead of copying the cloud first. Children without a native
+   * implementation fall back to filter(), which is reported on diagnostics.
+   * \param input the input point cloud dataset in its original frame.
+   * \param indices a pointer to the vector of point indices to use.
+   * \param output the resultant filtered PointCloud2 in the input frame
+   * \param transform_info the transform from the original frame to the input frame
+   */
   virtual void faster_filter(
     const PointCloud2ConstPtr & input, const IndicesPtr & indices, PointCloud2 & output,
-    const TransformInfo & transform_info);  // != 0
+    const TransformInfo & transform_info);
+
+  /** \brief Copy the points for which keep(index, point) returns true into output, with x/y/z
+   * transformed by transform_info. Helper for the native faster_filter() implementations.
+   * \param keep predicate called with the point index and the transformed point
+   */
+  template <typename Predicate>
+  void copyPointsIf(
+    const PointCloud2 & input, const TransformInfo & transform_info, PointCloud2 & output,
+    Predicate && keep)
+  {
+    const int x_offset = input.fields[pcl::getFieldIndex(input, "x")].offset;
+    const int y_offset = input.fields[pcl::getFieldIndex(input, "y")].offset;
+    const int z_offset = input.fields[pcl::getFieldIndex(input, "z")].offset;
+
+    output.data.resize(input.data.size());
+    size_t output_size = 0;
+    size_t index = 0;
+    for (size_t global_offset = 0; global_offset + input.point_step <= input.data.size();
+         global_offset += input.point_step, ++index) {
+      Eigen::Vector4f point(
+        *reinterpret_cast<const float *>(&input.data[global_offset + x_offset]),
+        *reinterpret_cast<const float *>(&input.data[global_offset + y_offset]),
+        *reinterpret_cast<const float *>(&input.data[global_offset + z_offset]), 1);
+      if (transform_info.need_transform && point.allFinite()) {
+        point = transform_info.eigen_transform * point;
+      }
+      if (!keep(index, point)) {
+        continue;
+      }
+
+      memcpy(&output.data[output_size], &input.data[global_offset], input.point_step);
+      if (transform_info.need_transform) {
+        *reinterpret_cast<float *>(&output.data[output_size + x_offset]) = point[0];
+        *reinterpret_cast<float *>(&output.data[output_size + y_offset]) = point[1];
+        *reinterpret_cast<float *>(&output.data[output_size + z_offset]) = point[2];
+      }
+      output_size += input.point_step;
+    }
+    output.data.resize(output_size);
+
+    // Note that `input.header.frame_id` is data before converted when `need_transform == true`
+    output.header.frame_id = !tf_input_frame_.empty() ? tf_input_frame_ : tf_input_orig_frame_;
+    output.height = 1;
+    output.fields = input.fields;
+    output.is_bigendian = input.is_bigendian;
+    output.point_step = input.point_step;
+    output.is_dense = input.is_dense;
+    output.width = static_cast<uint32_t>(output.data.size() / output.height / output.point_step);
+    output.row_step = static_cast<uint32_t>(output.data.size() / output.height);
+  }
 
   /** \brief Lazy transport subscribe routine. */
   virtual void subscribe(const std::string & filter_name);
@@ -211,12 +279,6 @@ protected:
   /** \brief Lazy transport unsubscribe routine. */
   virtual void unsubscribe();
 
-  /** \brief Call the child filter () method, optionally transform the result, and publish it.
-   * \param input the input point cloud dataset.
-   * \param indices a pointer to the vector of point indices to use.
-   */
-  void computePublish(const PointCloud2ConstPtr & input, const IndicesPtr & indices);
-
   //////////////////////
   // from PCLNodelet //
   //////////////////////
@@ -292,6 +354,9 @@ private:
   /** \brief PointCloud2 + Indices data callback. */
   void input_indices_callback(const PointCloud2ConstPtr cloud, const PointIndicesConstPtr indices);
 
+  /** \brief Reports filters running through the faster_filter() fallback, created on first use. */
+  std::unique_ptr<diagnostic_updater::Updater> legacy_path_updater_;
+
   /** \brief Get a matrix for conversion from the original frame to the target frame */
   bool calculate_transform_matrix(
     const std::string & target_frame, const sensor_msgs::msg::PointCloud2 & from,
@@ -303,11 +368,6 @@ private:
 
   bool convert_output_costly(std::unique_ptr<PointCloud2> & output);
 
-  // TODO(sykwer): Temporary Implementation: Remove this interface when all the filter nodes conform
-  // to new API.
-  void faster_input_indices_callback(
-    const PointCloud2ConstPtr cloud, const PointIndicesConstPtr indices);
-
   void setupTF();
 };
 }  // namespace pointcloud_preprocessor
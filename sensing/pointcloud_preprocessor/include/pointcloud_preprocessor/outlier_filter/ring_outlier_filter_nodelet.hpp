@@ -44,17 +44,26 @@ private:
   /** \brief Parameter service callback */
   rcl_interfaces::msg::SetParametersResult paramCallback(const std::vector<rclcpp::Parameter> & p);
 
+  /** \brief Input point offsets ordered by ring, reused across callbacks. */
+  std::vector<std::size_t> ring_sorted_offsets_;
+  /** \brief Start of each ring's run in ring_sorted_offsets_ (counting-sort buckets). */
+  std::vector<std::size_t> ring_bucket_begin_;
+  std::vector<std::size_t> ring_bucket_cursor_;
+
+  /** \brief Sort the input point offsets by ring into ring_sorted_offsets_, keeping scan order. */
+  void bucketByRing(const PointCloud2 & input, const std::size_t ring_offset);
+
   bool isCluster(
-    sensor_msgs::msg::PointCloud2::SharedPtr & input_ptr,
-    const std::vector<std::size_t> & tmp_indices)
+    const unsigned char * data, const std::size_t front_offset, const std::size_t back_offset,
+    const std::size_t num_points) const
   {
-    PointXYZI * front_pt = reinterpret_cast<PointXYZI *>(&input_ptr->data[tmp_indices.front()]);
-    PointXYZI * back_pt = reinterpret_cast<PointXYZI *>(&input_ptr->data[tmp_indices.back()]);
+    const auto * front_pt = reinterpret_cast<const PointXYZI *>(data + front_offset);
+    const auto * back_pt = reinterpret_cast<const PointXYZI *>(data + back_offset);
 
     const auto x_diff = front_pt->x - back_pt->x;
     const auto y_diff = front_pt->y - back_pt->y;
     const auto z_diff = front_pt->z - back_pt->z;
-    return static_cast<int>(tmp_indices.size()) > num_points_threshold_ ||
+    return static_cast<int>(num_points) > num_points_threshold_ ||
            (x_diff * x_diff) + (y_diff * y_diff) + (z_diff * z_diff) >=
              object_length_threshold_ * object_length_threshold_;
   }
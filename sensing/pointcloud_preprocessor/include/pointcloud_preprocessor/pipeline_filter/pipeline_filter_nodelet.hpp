@@ -0,0 +1,69 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINTCLOUD_PREPROCESSOR__PIPELINE_FILTER__PIPELINE_FILTER_NODELET_HPP_
+#define POINTCLOUD_PREPROCESSOR__PIPELINE_FILTER__PIPELINE_FILTER_NODELET_HPP_
+
+#include "pointcloud_preprocessor/distortion_corrector/distortion_corrector.hpp"
+#include "pointcloud_preprocessor/filter.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace pointcloud_preprocessor
+{
+/** \brief @b PipelineFilterComponent runs an ordered list of preprocessing stages on every input
+ * cloud inside one node. The intermediate clouds are handed from stage to stage in memory instead
+ * of being serialized, published and deserialized by a separate node for each stage.
+ */
+class PipelineFilterComponent : public pointcloud_preprocessor::Filter
+{
+protected:
+  void filter(
+    const PointCloud2ConstPtr & input, const IndicesPtr & indices, PointCloud2 & output) override;
+
+private:
+  struct Stage
+  {
+    std::string name;
+    /** \brief Set for stages derived from pointcloud_preprocessor::Filter. */
+    std::shared_ptr<Filter> filter;
+    /** \brief Set for the distortion corrector stage, which undistorts in place. */
+    std::shared_ptr<DistortionCorrectorComponent> distortion_corrector;
+    /** \brief Optional tap publishing the output of this stage. */
+    rclcpp::Publisher<PointCloud2>::SharedPtr debug_pub;
+  };
+
+  std::vector<Stage> stages_;
+
+  /** \brief Spins the stage nodes for their own subscriptions (twist, imu) and parameters. */
+  rclcpp::Executor::SharedPtr stage_executor_;
+  std::thread stage_executor_thread_;
+
+  rclcpp::NodeOptions createStageOptions(
+    const rclcpp::NodeOptions & options, const std::string & stage_name) const;
+  Stage createStage(const rclcpp::NodeOptions & options, const std::string & stage_name);
+
+public:
+  PCL_MAKE_ALIGNED_OPERATOR_NEW
+  explicit PipelineFilterComponent(const rclcpp::NodeOptions & options);
+  ~PipelineFilterComponent() override;
+};
+}  // namespace pointcloud_preprocessor
+
+#endif  // POINTCLOUD_PREPROCESSOR__PIPELINE_FILTER__PIPELINE_FILTER_NODELET_HPP_
@@ -19,6 +19,9 @@
 
 #include <boost/circular_buffer.hpp>
 
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
 #include <vector>
 
 namespace pointcloud_preprocessor
@@ -36,8 +39,15 @@ protected:
   rcl_interfaces::msg::SetParametersResult paramCallback(const std::vector<rclcpp::Parameter> & p);
 
 private:
+  /** \brief Input pointcloud converted on arrival, reused while it is in the accumulation time */
+  struct AccumulatedPointCloud
+  {
+    rclcpp::Time stamp;
+    pcl::PointCloud<pcl::PointXYZ>::ConstPtr points;
+  };
+
   double accumulation_time_sec_;
-  boost::circular_buffer<PointCloud2ConstPtr> pointcloud_buffer_;
+  boost::circular_buffer<AccumulatedPointCloud> pointcloud_buffer_;
 
 public:
   PCL_MAKE_ALIGNED_OPERATOR_NEW
@@ -35,6 +35,10 @@ protected:
   virtual void filter(
     const PointCloud2ConstPtr & input, const IndicesPtr & indices, PointCloud2 & output);
 
+  void faster_filter(
+    const PointCloud2ConstPtr & input, const IndicesPtr & indices, PointCloud2 & output,
+    const TransformInfo & transform_info) override;
+
   void publishRemovedPolygon();
 
   void update_polygon(const geometry_msgs::msg::Polygon::ConstSharedPtr & polygon_in);
@@ -23,6 +23,8 @@
 #include <autoware_auto_mapping_msgs/msg/had_map_bin.hpp>
 #include <sensor_msgs/msg/point_cloud2.hpp>
 
+#include <boost/geometry/index/rtree.hpp>
+
 #include <pcl/common/centroid.h>
 #include <pcl/filters/voxel_grid.h>
 #include <pcl_conversions/pcl_conversions.h>
@@ -38,8 +40,10 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
+using tier4_autoware_utils::Box2d;
 using tier4_autoware_utils::LinearRing2d;
 using tier4_autoware_utils::MultiPoint2d;
 using tier4_autoware_utils::Point2d;
@@ -65,9 +69,14 @@ private:
 
   lanelet::LaneletMapPtr lanelet_map_ptr_;
   lanelet::ConstLanelets road_lanelets_;
+  // polygons of the road lanelets with an rtree of their envelopes, built once on map load
+  std::vector<lanelet::BasicPolygon2d> road_polygons_;
+  boost::geometry::index::rtree<std::pair<Box2d, size_t>, boost::geometry::index::rstar<16>>
+    road_polygons_rtree_;
 
   float voxel_size_x_;
   float voxel_size_y_;
+  double mask_resolution_;
 
   void pointcloudCallback(const PointCloud2ConstPtr msg);
 
@@ -79,14 +88,14 @@ private:
 
   LinearRing2d getConvexHull(const pcl::PointCloud<pcl::PointXYZ>::Ptr & input_cloud);
 
-  lanelet::ConstLanelets getIntersectedLanelets(
-    const LinearRing2d & convex_hull, const lanelet::ConstLanelets & road_lanelets_);
+  // indices in road_polygons_ of the road lanelets intersecting the convex hull
+  std::vector<size_t> getIntersectedLanelets(const LinearRing2d & convex_hull);
 
   pcl::PointCloud<pcl::PointXYZ> getLaneFilteredPointCloud(
-    const lanelet::ConstLanelets & joint_lanelets,
+    const std::vector<size_t> & intersected_lanelets,
     const pcl::PointCloud<pcl::PointXYZ>::Ptr & cloud);
 
-  bool pointWithinLanelets(const Point2d & point, const lanelet::ConstLanelets & joint_lanelets);
+  bool pointWithinLanelets(const Point2d & point, const std::vector<bool> & is_intersected);
 
   /** \brief Parameter service callback result : needed to be hold */
   OnSetParametersCallbackHandle::SharedPtr set_param_res_;
@@ -37,6 +37,10 @@ private:
     const PointCloud2ConstPtr & input, [[maybe_unused]] const IndicesPtr & indices,
     PointCloud2 & output) override;
 
+  void faster_filter(
+    const PointCloud2ConstPtr & input, [[maybe_unused]] const IndicesPtr & indices,
+    PointCloud2 & output, const TransformInfo & transform_info) override;
+
   rclcpp::Subscription<autoware_auto_mapping_msgs::msg::HADMapBin>::SharedPtr map_sub_;
   lanelet::ConstPolygons3d polygon_lanelets_;
 
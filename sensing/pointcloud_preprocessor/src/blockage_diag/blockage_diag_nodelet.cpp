@@ -16,8 +16,6 @@
 
 #include "autoware_point_types/types.hpp"
 
-#include <boost/circular_buffer.hpp>
-
 #include <algorithm>
 
 namespace pointcloud_preprocessor
@@ -40,7 +38,10 @@ BlockageDiagComponent::BlockageDiagComponent(const rclcpp::NodeOptions & options
       static_cast<uint>(declare_parameter("blockage_count_threshold", 50));
     buffering_frames_ = static_cast<uint>(declare_parameter("buffering_frames", 100));
     buffering_interval_ = static_cast<uint>(declare_parameter("buffering_interval", 5));
+    debug_image_interval_ = declare_parameter("debug_image_interval", 1.0);
   }
+  no_return_mask_buffer_.set_capacity(buffering_frames_);
+  last_debug_image_time_ = this->now();
 
   updater_.setHardwareID("blockage_diag");
   updater_.add(
@@ -114,8 +115,6 @@ void BlockageDiagComponent::filter(
   uint vertical_bins = vertical_bins_;
   pcl::PointCloud<PointXYZIRADRT>::Ptr pcl_input(new pcl::PointCloud<PointXYZIRADRT>);
   pcl::fromROSMsg(*input, *pcl_input);
-  cv::Mat lidar_depth_map(cv::Size(horizontal_bins, vertical_bins), CV_16UC1, cv::Scalar(0));
-  cv::Mat lidar_depth_map_8u(cv::Size(horizontal_bins, vertical_bins), CV_8UC1, cv::Scalar(0));
   if (pcl_input->points.empty()) {
     ground_blockage_ratio_ = 1.0f;
     sky_blockage_ratio_ = 1.0f;
@@ -130,80 +129,88 @@ void BlockageDiagComponent::filter(
     sky_blockage_range_deg_[0] = angle_range_deg_[0];
     sky_blockage_range_deg_[1] = angle_range_deg_[1];
   } else {
+    // the debug images are the only full resolution images, so render them at a throttled rate
+    const bool publish_debug_image =
+      (lidar_depth_map_pub_.getNumSubscribers() > 0 ||
+       blockage_mask_pub_.getNumSubscribers() > 0) &&
+      (this->now() - last_debug_image_time_).seconds() >= debug_image_interval_;
+    cv::Mat lidar_depth_map;
+    if (publish_debug_image) {
+      lidar_depth_map = cv::Mat(cv::Size(horizontal_bins, vertical_bins), CV_16UC1, cv::Scalar(0));
+    }
+
+    RingBitset no_return_mask(vertical_bins, horizontal_bins);
     for (const auto & p : pcl_input->points) {
       if ((p.azimuth / 100.0 > angle_range_deg_[0]) && (p.azimuth / 100.0 < angle_range_deg_[1])) {
+        const uint col = static_cast<uint>((p.azimuth / 100.0 - angle_range_deg_[0]));
+        uint row = 0;
         if (lidar_model_ == "Pandar40P") {
-          lidar_depth_map.at<uint16_t>(
-            p.ring, static_cast<uint>((p.azimuth / 100.0 - angle_range_deg_[0]))) +=
-            static_cast<uint16_t>(6250.0 / p.distance);  // make image clearly
-          lidar_depth_map_8u.at<uint8_t>(
-            p.ring, static_cast<uint>((p.azimuth / 100.0 - angle_range_deg_[0]))) = 255;
+          row = p.ring;
         } else if (lidar_model_ == "PandarQT") {
-          lidar_depth_map.at<uint16_t>(
-            vertical_bins - p.ring - 1,
-            static_cast<uint>((p.azimuth / 100.0 - angle_range_deg_[0]))) +=
-            static_cast<uint16_t>(6250.0 / p.distance);
-          lidar_depth_map_8u.at<uint8_t>(
-            vertical_bins - p.ring - 1,
-            static_cast<uint>((p.azimuth / 100.0 - angle_range_deg_[0]))) = 255;
+          row = vertical_bins - p.ring - 1;
+        } else {
+          continue;
+        }
+        if (row >= vertical_bins || col >= horizontal_bins) {
+          continue;
+        }
+        no_return_mask.set(row, col);
+        if (publish_debug_image) {
+          // make image clearly
+          lidar_depth_map.at<uint16_t>(row, col) += static_cast<uint16_t>(6250.0 / p.distance);
         }
       }
     }
-    lidar_depth_map.convertTo(lidar_depth_map, CV_8UC1, 1.0 / 100.0);
-    cv::Mat no_return_mask;
-    cv::inRange(lidar_depth_map_8u, 0, 1, no_return_mask);
-
-    cv::Mat erosion_dst;
-    cv::Mat element = cv::getStructuringElement(
-      cv::MORPH_RECT, cv::Size(2 * erode_kernel_ + 1, 2 * erode_kernel_ + 1),
-      cv::Point(erode_kernel_, erode_kernel_));
-    cv::erode(no_return_mask, erosion_dst, element);
-    cv::dilate(erosion_dst, no_return_mask, element);
+    no_return_mask.invert();
+    no_return_mask.erode(erode_kernel_);
+    no_return_mask.dilate(erode_kernel_);
 
-    static boost::circular_buffer<cv::Mat> no_return_mask_buffer(buffering_frames_);
-
-    cv::Mat no_return_mask_result(cv::Size(horizontal_bins, vertical_bins), CV_8UC1, cv::Scalar(0));
-    cv::Mat time_series_blockage_mask(
-      cv::Size(horizontal_bins, vertical_bins), CV_8UC1, cv::Scalar(0));
-    cv::Mat no_return_mask_binarized(
-      cv::Size(horizontal_bins, vertical_bins), CV_8UC1, cv::Scalar(0));
+    if (
+      !no_return_mask_buffer_.empty() &&
+      (no_return_mask_buffer_.front().rows() != vertical_bins ||
+       no_return_mask_buffer_.front().cols() != horizontal_bins)) {
+      no_return_mask_buffer_.clear();
+    }
 
-    static uint frame_count;
-    frame_count++;
+    RingBitset no_return_mask_result(vertical_bins, horizontal_bins);
+    frame_count_++;
     if (buffering_interval_ != 0) {
-      no_return_mask_binarized = no_return_mask / 255;
-      if (frame_count == buffering_interval_) {
-        no_return_mask_buffer.push_back(no_return_mask_binarized);
-        frame_count = 0;
+      if (frame_count_ == buffering_interval_) {
+        no_return_mask_buffer_.push_back(no_return_mask);
+        frame_count_ = 0;
       }
-      for (const auto & binary_mask : no_return_mask_buffer) {
-        time_series_blockage_mask += binary_mask;
+      // the pixels having no return in all of the buffered masks but at most one
+      if (!no_return_mask_buffer_.empty()) {
+        RingBitset in_all(vertical_bins, horizontal_bins, true);
+        RingBitset in_all_but_one(vertical_bins, horizontal_bins);
+        for (const auto & binary_mask : no_return_mask_buffer_) {
+          RingBitset missed_once = in_all;
+          missed_once.andNot(binary_mask);
+          in_all_but_one &= binary_mask;
+          in_all_but_one |= missed_once;
+          in_all &= binary_mask;
+        }
+        no_return_mask_result = in_all;
+        no_return_mask_result |= in_all_but_one;
       }
-      cv::inRange(
-        time_series_blockage_mask, no_return_mask_buffer.size() - 1, no_return_mask_buffer.size(),
-        no_return_mask_result);
     } else {
-      no_return_mask.copyTo(no_return_mask_result);
+      no_return_mask_result = no_return_mask;
     }
-    cv::Mat ground_no_return_mask;
-    cv::Mat sky_no_return_mask;
-    no_return_mask_result(cv::Rect(0, 0, horizontal_bins, horizontal_ring_id_))
-      .copyTo(sky_no_return_mask);
-    no_return_mask_result(
-      cv::Rect(0, horizontal_ring_id_, horizontal_bins, vertical_bins - horizontal_ring_id_))
-      .copyTo(ground_no_return_mask);
+
+    const uint horizontal_ring_id = std::min(horizontal_ring_id_, vertical_bins);
     ground_blockage_ratio_ =
-      static_cast<float>(cv::countNonZero(ground_no_return_mask)) /
-      static_cast<float>(horizontal_bins * (vertical_bins - horizontal_ring_id_));
-    sky_blockage_ratio_ = static_cast<float>(cv::countNonZero(sky_no_return_mask)) /
-                          static_cast<float>(horizontal_bins * horizontal_ring_id_);
+      static_cast<float>(no_return_mask_result.count(horizontal_ring_id, vertical_bins)) /
+      static_cast<float>(horizontal_bins * (vertical_bins - horizontal_ring_id));
+    sky_blockage_ratio_ = static_cast<float>(no_return_mask_result.count(0, horizontal_ring_id)) /
+                          static_cast<float>(horizontal_bins * horizontal_ring_id);
 
     if (ground_blockage_ratio_ > blockage_ratio_threshold_) {
-      cv::Rect ground_blockage_bb = cv::boundingRect(ground_no_return_mask);
+      const auto ground_blockage_extent =
+        no_return_mask_result.columnExtent(horizontal_ring_id, vertical_bins);
       ground_blockage_range_deg_[0] =
-        static_cast<float>(ground_blockage_bb.x) + angle_range_deg_[0];
+        static_cast<float>(ground_blockage_extent.first) + angle_range_deg_[0];
       ground_blockage_range_deg_[1] =
-        static_cast<float>(ground_blockage_bb.x + ground_blockage_bb.width) + angle_range_deg_[0];
+        static_cast<float>(ground_blockage_extent.second) + angle_range_deg_[0];
 
       if (ground_blockage_count_ <= 2 * blockage_count_threshold_) {
         ground_blockage_count_ += 1;
@@ -213,10 +220,11 @@ void BlockageDiagComponent::filter(
     }
 
     if (sky_blockage_ratio_ > blockage_ratio_threshold_) {
-      cv::Rect sky_blockage_bx = cv::boundingRect(sky_no_return_mask);
-      sky_blockage_range_deg_[0] = static_cast<float>(sky_blockage_bx.x) + angle_range_deg_[0];
+      const auto sky_blockage_extent = no_return_mask_result.columnExtent(0, horizontal_ring_id);
+      sky_blockage_range_deg_[0] =
+        static_cast<float>(sky_blockage_extent.first) + angle_range_deg_[0];
       sky_blockage_range_deg_[1] =
-        static_cast<float>(sky_blockage_bx.x + sky_blockage_bx.width) + angle_range_deg_[0];
+        static_cast<float>(sky_blockage_extent.second) + angle_range_deg_[0];
       if (sky_blockage_count_ <= 2 * blockage_count_threshold_) {
         sky_blockage_count_ += 1;
       }
@@ -224,19 +232,33 @@ void BlockageDiagComponent::filter(
       sky_blockage_count_ = 0;
     }
 
-    cv::Mat lidar_depth_colorized;
-    cv::applyColorMap(lidar_depth_map, lidar_depth_colorized, cv::COLORMAP_JET);
-    sensor_msgs::msg::Image::SharedPtr lidar_depth_msg =
-      cv_bridge::CvImage(std_msgs::msg::Header(), "bgr8", lidar_depth_colorized).toImageMsg();
-    lidar_depth_msg->header = input->header;
-    lidar_depth_map_pub_.publish(lidar_depth_msg);
+    if (publish_debug_image) {
+      last_debug_image_time_ = this->now();
 
-    cv::Mat blockage_mask_colorized;
-    cv::applyColorMap(no_return_mask_result, blockage_mask_colorized, cv::COLORMAP_JET);
-    sensor_msgs::msg::Image::SharedPtr blockage_mask_msg =
-      cv_bridge::CvImage(std_msgs::msg::Header(), "bgr8", blockage_mask_colorized).toImageMsg();
-    blockage_mask_msg->header = input->header;
-    blockage_mask_pub_.publish(blockage_mask_msg);
+      lidar_depth_map.convertTo(lidar_depth_map, CV_8UC1, 1.0 / 100.0);
+      cv::Mat lidar_depth_colorized;
+      cv::applyColorMap(lidar_depth_map, lidar_depth_colorized, cv::COLORMAP_JET);
+      sensor_msgs::msg::Image::SharedPtr lidar_depth_msg =
+        cv_bridge::CvImage(std_msgs::msg::Header(), "bgr8", lidar_depth_colorized).toImageMsg();
+      lidar_depth_msg->header = input->header;
+      lidar_depth_map_pub_.publish(lidar_depth_msg);
+
+      cv::Mat blockage_mask(cv::Size(horizontal_bins, vertical_bins), CV_8UC1, cv::Scalar(0));
+      for (uint row = 0; row < vertical_bins; ++row) {
+        for (uint col = 0; col < horizontal_bins; ++col) {
+          if (no_return_mask_result.get(row, col)) {
+            blockage_mask.at<uint8_t>(row, col) = 255;
+          }
+        }
+      }
+      cv::Mat blockage_mask_colorized;
+      cv::applyColorMap(blockage_mask, blockage_mask_colorized, cv::COLORMAP_JET);
+      sensor_msgs::msg::Image::SharedPtr blockage_mask_msg =
+        cv_bridge::CvImage(std_msgs::msg::Header(), "bgr8", blockage_mask_colorized)
+          .toImageMsg();
+      blockage_mask_msg->header = input->header;
+      blockage_mask_pub_.publish(blockage_mask_msg);
+    }
   }
 
   tier4_debug_msgs::msg::Float32Stamped ground_blockage_ratio_msg;
@@ -279,11 +301,16 @@ rcl_interfaces::msg::SetParametersResult BlockageDiagComponent::paramCallback(
       angle_range_deg_[1]);
   }
   if (get_param(p, "buffering_frames", buffering_frames_)) {
+    no_return_mask_buffer_.set_capacity(buffering_frames_);
     RCLCPP_DEBUG(get_logger(), "Setting new buffering_frames to: %d.", buffering_frames_);
   }
   if (get_param(p, "buffering_interval", buffering_interval_)) {
     RCLCPP_DEBUG(get_logger(), "Setting new buffering_interval to: %d.", buffering_interval_);
   }
+  if (get_param(p, "debug_image_interval", debug_image_interval_)) {
+    RCLCPP_DEBUG(
+      get_logger(), "Setting new debug_image_interval to: %f.", debug_image_interval_);
+  }
   rcl_interfaces::msg::SetParametersResult result;
   result.successful = true;
   result.reason = "success";
@@ -51,12 +51,18 @@
 
 #include "pointcloud_preprocessor/concatenate_data/concatenate_data_nodelet.hpp"
 
-#include <pcl_ros/transforms.hpp>
-
 #include <pcl_conversions/pcl_conversions.h>
+#include <tf2_ros/buffer_interface.h>
+
+#ifdef ROS_DISTRO_GALACTIC
+#include <tf2_eigen/tf2_eigen.h>
+#else
+#include <tf2_eigen/tf2_eigen.hpp>
+#endif
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -183,35 +189,36 @@ PointCloudConcatenateDataSynchronizerComponent::PointCloudConcatenateDataSynchro
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////
-void PointCloudConcatenateDataSynchronizerComponent::transformPointCloud(
-  const PointCloud2::ConstSharedPtr & in, PointCloud2::SharedPtr & out)
+bool PointCloudConcatenateDataSynchronizerComponent::getTransformToOutputFrame(
+  const PointCloud2 & cloud, Eigen::Matrix4f & transform)
 {
-  // Transform the point clouds into the specified output frame
-  if (output_frame_ != in->header.frame_id) {
-    // TODO(YamatoAndo): use TF2
-    if (!pcl_ros::transformPointCloud(output_frame_, *in, *out, *tf2_buffer_)) {
-      RCLCPP_ERROR(
-        this->get_logger(),
-        "[transformPointCloud] Error converting first input dataset from %s to %s.",
-        in->header.frame_id.c_str(), output_frame_.c_str());
-      return;
-    }
-  } else {
-    out = std::make_shared<PointCloud2>(*in);
+  if (output_frame_ == cloud.header.frame_id) {
+    transform = Eigen::Matrix4f::Identity();
+    return true;
   }
+
+  geometry_msgs::msg::TransformStamped transform_stamped;
+  try {
+    transform_stamped = tf2_buffer_->lookupTransform(
+      output_frame_, cloud.header.frame_id, tf2_ros::fromMsg(cloud.header.stamp));
+  } catch (tf2::TransformException & ex) {
+    RCLCPP_ERROR(
+      this->get_logger(), "[getTransformToOutputFrame] Error converting dataset from %s to %s: %s",
+      cloud.header.frame_id.c_str(), output_frame_.c_str(), ex.what());
+    return false;
+  }
+  transform = tf2::transformToEigen(transform_stamped.transform).matrix().cast<float>();
+  return true;
 }
 
-void PointCloudConcatenateDataSynchronizerComponent::combineClouds(
-  const PointCloud2::ConstSharedPtr & in1, const PointCloud2::ConstSharedPtr & in2,
-  PointCloud2::SharedPtr & out)
+Eigen::Matrix4f
+PointCloudConcatenateDataSynchronizerComponent::computeTransformToAdjustForOldTimestamp(
+  const rclcpp::Time & old_stamp, const rclcpp::Time & new_stamp)
 {
-  if (twist_ptr_queue_.empty()) {
-    pcl::concatenatePointCloud(*in1, *in2, *out);
-    out->header.stamp = std::min(rclcpp::Time(in1->header.stamp), rclcpp::Time(in2->header.stamp));
-    return;
+  if (twist_ptr_queue_.empty() || old_stamp == new_stamp) {
+    return Eigen::Matrix4f::Identity();
   }
 
-  const auto old_stamp = std::min(rclcpp::Time(in1->header.stamp), rclcpp::Time(in2->header.stamp));
   auto old_twist_ptr_it = std::lower_bound(
     std::begin(twist_ptr_queue_), std::end(twist_ptr_queue_), old_stamp,
     [](const geometry_msgs::msg::TwistStamped::ConstSharedPtr & x_ptr, const rclcpp::Time & t) {
@@ -220,7 +227,6 @@ void PointCloudConcatenateDataSynchronizerComponent::combineClouds(
   old_twist_ptr_it =
     old_twist_ptr_it == twist_ptr_queue_.end() ? (twist_ptr_queue_.end() - 1) : old_twist_ptr_it;
 
-  const auto new_stamp = std::max(rclcpp::Time(in1->header.stamp), rclcpp::Time(in2->header.stamp));
   auto new_twist_ptr_it = std::lower_bound(
     std::begin(twist_ptr_queue_), std::end(twist_ptr_queue_), new_stamp,
     [](const geometry_msgs::msg::TwistStamped::ConstSharedPtr & x_ptr, const rclcpp::Time & t) {
@@ -257,51 +263,69 @@ void PointCloudConcatenateDataSynchronizerComponent::combineClouds(
   Eigen::AngleAxisf rotation_y(0, Eigen::Vector3f::UnitY());
   Eigen::AngleAxisf rotation_z(yaw, Eigen::Vector3f::UnitZ());
   Eigen::Translation3f translation(x, y, 0);
-  Eigen::Matrix4f rotation_matrix = (translation * rotation_z * rotation_y * rotation_x).matrix();
-
   // TODO(YamatoAndo): if output_frame_ is not base_link, we must transform
-
-  if (rclcpp::Time(in1->header.stamp) > rclcpp::Time(in2->header.stamp)) {
-    sensor_msgs::msg::PointCloud2::SharedPtr in1_t(new sensor_msgs::msg::PointCloud2());
-    pcl_ros::transformPointCloud(rotation_matrix, *in1, *in1_t);
-    pcl::concatenatePointCloud(*in1_t, *in2, *out);
-    out->header.stamp = in2->header.stamp;
-  } else {
-    sensor_msgs::msg::PointCloud2::SharedPtr in2_t(new sensor_msgs::msg::PointCloud2());
-    pcl_ros::transformPointCloud(rotation_matrix, *in2, *in2_t);
-    pcl::concatenatePointCloud(*in1, *in2_t, *out);
-    out->header.stamp = in1->header.stamp;
-  }
+  return (translation * rotation_z * rotation_y * rotation_x).matrix();
 }
 
 void PointCloudConcatenateDataSynchronizerComponent::publish()
 {
   stop_watch_ptr_->toc("processing_time", true);
-  sensor_msgs::msg::PointCloud2::SharedPtr concat_cloud_ptr_ = nullptr;
   not_subscribed_topic_names_.clear();
 
+  // Every input has already been converted to PointXYZI in cloud_callback, so the output layout is
+  // known in advance. Size the output once and write every transformed point straight into it
+  // instead of concatenating pairwise through intermediate clouds.
+  std::vector<std::pair<PointCloud2::ConstSharedPtr, Eigen::Matrix4f>> clouds;
+  clouds.reserve(cloud_stdmap_.size());
+  std::optional<rclcpp::Time> oldest_stamp;
+  std::size_t num_points = 0;
   for (const auto & e : cloud_stdmap_) {
-    if (e.second != nullptr) {
-      sensor_msgs::msg::PointCloud2::SharedPtr transformed_cloud_ptr(
-        new sensor_msgs::msg::PointCloud2());
-      transformPointCloud(e.second, transformed_cloud_ptr);
-      if (concat_cloud_ptr_ == nullptr) {
-        concat_cloud_ptr_ = transformed_cloud_ptr;
-      } else {
-        PointCloudConcatenateDataSynchronizerComponent::combineClouds(
-          concat_cloud_ptr_, transformed_cloud_ptr, concat_cloud_ptr_);
-      }
-
-    } else {
+    if (e.second == nullptr) {
       not_subscribed_topic_names_.insert(e.first);
+      continue;
     }
+    Eigen::Matrix4f transform;
+    if (!getTransformToOutputFrame(*e.second, transform)) {
+      continue;
+    }
+    const rclcpp::Time stamp(e.second->header.stamp);
+    if (!oldest_stamp || stamp < *oldest_stamp) {
+      oldest_stamp = stamp;
+    }
+    num_points += e.second->width * e.second->height;
+    clouds.emplace_back(e.second, transform);
   }
 
-  if (concat_cloud_ptr_) {
-    auto output = std::make_unique<sensor_msgs::msg::PointCloud2>(*concat_cloud_ptr_);
+  if (!clouds.empty()) {
+    auto output = std::make_unique<sensor_msgs::msg::PointCloud2>();
+    PointCloud2Modifier<PointXYZI> output_modifier{*output, output_frame_};
+    output_modifier.resize(num_points);
+    output->header.stamp = *oldest_stamp;
+
+    auto * out_pt = reinterpret_cast<PointXYZI *>(output->data.data());
+    for (auto & [cloud, transform] : clouds) {
+      // compensate ego motion between the oldest cloud and this cloud in the output frame
+      transform = computeTransformToAdjustForOldTimestamp(
+                    *oldest_stamp, rclcpp::Time(cloud->header.stamp)) *
+                  transform;
+      const Eigen::Matrix3f rotation = transform.topLeftCorner<3, 3>();
+      const Eigen::Vector3f translation = transform.topRightCorner<3, 1>();
+
+      const std::size_t cloud_size = cloud->width * cloud->height;
+      const auto * in_pt = reinterpret_cast<const PointXYZI *>(cloud->data.data());
+      for (std::size_t i = 0; i < cloud_size; ++i, ++in_pt, ++out_pt) {
+        const Eigen::Vector3f p =
+          rotation * Eigen::Vector3f(in_pt->x, in_pt->y, in_pt->z) + translation;
+        out_pt->x = p.x();
+        out_pt->y = p.y();
+        out_pt->z = p.z();
+        out_pt->intensity = in_pt->intensity;
+      }
+    }
     pub_output_->publish(std::move(output));
   } else {
-    RCLCPP_WARN(this->get_logger(), "concat_cloud_ptr_ is nullptr, skipping pointcloud publish.");
+    RCLCPP_WARN(
+      this->get_logger(), "No input pointcloud to concatenate, skipping pointcloud publish.");
   }
 
   updater_.force_update();
@@ -323,7 +347,7 @@ void PointCloudConcatenateDataSynchronizerComponent::publish()
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void PointCloudConcatenateDataSynchronizerComponent::convertToXYZICloud(
-  const sensor_msgs::msg::PointCloud2::SharedPtr & input_ptr,
+  const sensor_msgs::msg::PointCloud2::ConstSharedPtr & input_ptr,
   sensor_msgs::msg::PointCloud2::SharedPtr & output_ptr)
 {
   output_ptr->header = input_ptr->header;
@@ -334,12 +358,12 @@ void PointCloudConcatenateDataSynchronizerComponent::convertToXYZICloud(
     input_ptr->fields.begin(), input_ptr->fields.end(),
     [](auto & field) { return field.name == "intensity"; });
 
-  sensor_msgs::PointCloud2Iterator<float> it_x(*input_ptr, "x");
-  sensor_msgs::PointCloud2Iterator<float> it_y(*input_ptr, "y");
-  sensor_msgs::PointCloud2Iterator<float> it_z(*input_ptr, "z");
+  sensor_msgs::PointCloud2ConstIterator<float> it_x(*input_ptr, "x");
+  sensor_msgs::PointCloud2ConstIterator<float> it_y(*input_ptr, "y");
+  sensor_msgs::PointCloud2ConstIterator<float> it_z(*input_ptr, "z");
 
   if (has_intensity) {
-    sensor_msgs::PointCloud2Iterator<float> it_i(*input_ptr, "intensity");
+    sensor_msgs::PointCloud2ConstIterator<float> it_i(*input_ptr, "intensity");
     for (; it_x != it_x.end(); ++it_x, ++it_y, ++it_z, ++it_i) {
       PointXYZI point;
       point.x = *it_x;
@@ -380,9 +404,8 @@ void PointCloudConcatenateDataSynchronizerComponent::cloud_callback(
   const sensor_msgs::msg::PointCloud2::ConstSharedPtr & input_ptr, const std::string & topic_name)
 {
   std::lock_guard<std::mutex> lock(mutex_);
-  auto input = std::make_shared<sensor_msgs::msg::PointCloud2>(*input_ptr);
   sensor_msgs::msg::PointCloud2::SharedPtr xyzi_input_ptr(new sensor_msgs::msg::PointCloud2());
-  convertToXYZICloud(input, xyzi_input_ptr);
+  convertToXYZICloud(input_ptr, xyzi_input_ptr);
 
   const bool is_already_subscribed_this = (cloud_stdmap_[topic_name] != nullptr);
   const bool is_already_subscribed_tmp = std::any_of(
@@ -16,6 +16,7 @@
 
 #include "tier4_autoware_utils/math/trigonometry.hpp"
 
+#include <algorithm>
 #include <deque>
 #include <string>
 #include <utility>
@@ -63,6 +64,8 @@ void DistortionCorrectorComponent::onTwistWithCovarianceStamped(
   geometry_msgs::msg::TwistStamped msg;
   msg.header = twist_msg->header;
   msg.twist = twist_msg->twist.twist;
+
+  std::lock_guard<std::mutex> lock(mutex_);
   twist_queue_.push_back(msg);
 
   while (!twist_queue_.empty()) {
@@ -96,6 +99,8 @@ void DistortionCorrectorComponent::onImu(const sensor_msgs::msg::Imu::ConstShare
   geometry_msgs::msg::Vector3Stamped transformed_angular_velocity;
   tf2::doTransform(angular_velocity, transformed_angular_velocity, *tf_base2imu_ptr);
   transformed_angular_velocity.header = imu_msg->header;
+
+  std::lock_guard<std::mutex> lock(mutex_);
   angular_velocity_queue_.push_back(transformed_angular_velocity);
 
   while (!angular_velocity_queue_.empty()) {
@@ -123,10 +128,7 @@ void DistortionCorrectorComponent::onPointCloud(PointCloud2::UniquePtr points_ms
     return;
   }
 
-  tf2::Transform tf2_base_link_to_sensor{};
-  getTransform(points_msg->header.frame_id, base_link_frame_, &tf2_base_link_to_sensor);
-
-  undistortPointCloud(tf2_base_link_to_sensor, *points_msg);
+  undistortPointCloud(*points_msg);
 
   undistorted_points_pub_->publish(std::move(points_msg));
 
@@ -167,6 +169,15 @@ bool DistortionCorrectorComponent::getTransform(
   return true;
 }
 
+bool DistortionCorrectorComponent::undistortPointCloud(PointCloud2 & points)
+{
+  tf2::Transform tf2_base_link_to_sensor{};
+  getTransform(points.header.frame_id, base_link_frame_, &tf2_base_link_to_sensor);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  return undistortPointCloud(tf2_base_link_to_sensor, points);
+}
+
 bool DistortionCorrectorComponent::undistortPointCloud(
   const tf2::Transform & tf2_base_link_to_sensor, PointCloud2 & points)
 {
@@ -189,60 +200,68 @@ bool DistortionCorrectorComponent::undistortPointCloud(
     return false;
   }
 
-  sensor_msgs::PointCloud2Iterator<float> it_x(points, "x");
-  sensor_msgs::PointCloud2Iterator<float> it_y(points, "y");
-  sensor_msgs::PointCloud2Iterator<float> it_z(points, "z");
+  const std::size_t num_points = points.width * points.height;
+  x_buf_.resize(num_points);
+  y_buf_.resize(num_points);
+  z_buf_.resize(num_points);
+  cos_theta_buf_.resize(num_points);
+  sin_theta_buf_.resize(num_points);
+  odom_x_buf_.resize(num_points);
+  odom_y_buf_.resize(num_points);
+
+  // For performance, do not instantiate `rclcpp::Time` inside of the for-loop
+  twist_stamps_.clear();
+  for (const auto & twist : twist_queue_) {
+    twist_stamps_.push_back(rclcpp::Time(twist.header.stamp).seconds());
+  }
+  const bool use_imu = use_imu_ && !angular_velocity_queue_.empty();
+  imu_stamps_.clear();
+  if (use_imu) {
+    for (const auto & angular_velocity : angular_velocity_queue_) {
+      imu_stamps_.push_back(rclcpp::Time(angular_velocity.header.stamp).seconds());
+    }
+  }
+
+  sensor_msgs::PointCloud2ConstIterator<float> it_x(points, "x");
+  sensor_msgs::PointCloud2ConstIterator<float> it_y(points, "y");
+  sensor_msgs::PointCloud2ConstIterator<float> it_z(points, "z");
   sensor_msgs::PointCloud2ConstIterator<double> it_time_stamp(points, time_stamp_field_name_);
 
   float theta{0.0f};
   float x{0.0f};
   float y{0.0f};
+  float cos_theta{1.0f};
+  float sin_theta{0.0f};
   double prev_time_stamp_sec{*it_time_stamp};
   const double first_point_time_stamp_sec{*it_time_stamp};
 
-  auto twist_it = std::lower_bound(
-    std::begin(twist_queue_), std::end(twist_queue_), first_point_time_stamp_sec,
-    [](const geometry_msgs::msg::TwistStamped & x, const double t) {
-      return rclcpp::Time(x.header.stamp).seconds() < t;
-    });
-  twist_it = twist_it == std::end(twist_queue_) ? std::end(twist_queue_) - 1 : twist_it;
-
-  decltype(angular_velocity_queue_)::iterator imu_it;
-  if (use_imu_ && !angular_velocity_queue_.empty()) {
-    imu_it = std::lower_bound(
-      std::begin(angular_velocity_queue_), std::end(angular_velocity_queue_),
-      first_point_time_stamp_sec, [](const geometry_msgs::msg::Vector3Stamped & x, const double t) {
-        return rclcpp::Time(x.header.stamp).seconds() < t;
-      });
-    imu_it =
-      imu_it == std::end(angular_velocity_queue_) ? std::end(angular_velocity_queue_) - 1 : imu_it;
+  std::size_t twist_idx = std::distance(
+    std::cbegin(twist_stamps_),
+    std::lower_bound(
+      std::cbegin(twist_stamps_), std::cend(twist_stamps_), first_point_time_stamp_sec));
+  twist_idx = std::min(twist_idx, twist_stamps_.size() - 1);
+
+  std::size_t imu_idx = 0;
+  if (use_imu) {
+    imu_idx = std::distance(
+      std::cbegin(imu_stamps_),
+      std::lower_bound(
+        std::cbegin(imu_stamps_), std::cend(imu_stamps_), first_point_time_stamp_sec));
+    imu_idx = std::min(imu_idx, imu_stamps_.size() - 1);
   }
 
-  const tf2::Transform tf2_base_link_to_sensor_inv{tf2_base_link_to_sensor.inverse()};
-
-  // For performance, do not instantiate `rclcpp::Time` inside of the for-loop
-  double twist_stamp = rclcpp::Time(twist_it->header.stamp).seconds();
-  double imu_stamp = rclcpp::Time(imu_it->header.stamp).seconds();
-
-  // For performance, instantiate outside of the for-loop
-  tf2::Quaternion baselink_quat{};
-  tf2::Transform baselink_tf_odom{};
-  tf2::Vector3 point{};
-  tf2::Vector3 undistorted_point{};
-
-  // For performance, avoid transform computation if unnecessary
-  bool need_transform = points.header.frame_id != base_link_frame_;
-
-  for (; it_x != it_x.end(); ++it_x, ++it_y, ++it_z, ++it_time_stamp) {
-    while (twist_it != std::end(twist_queue_) - 1 && *it_time_stamp > twist_stamp) {
-      ++twist_it;
-      twist_stamp = rclcpp::Time(twist_it->header.stamp).seconds();
+  // Pass 1: integrate the ego pose at every point time. Points fired at the same time share the
+  // same pose, so the trigonometric functions are only evaluated when the yaw changes.
+  for (std::size_t i = 0; i < num_points; ++i, ++it_x, ++it_y, ++it_z, ++it_time_stamp) {
+    const double time_stamp = *it_time_stamp;
+    while (twist_idx != twist_stamps_.size() - 1 && time_stamp > twist_stamps_[twist_idx]) {
+      ++twist_idx;
     }
 
-    float v{static_cast<float>(twist_it->twist.linear.x)};
-    float w{static_cast<float>(twist_it->twist.angular.z)};
+    float v{static_cast<float>(twist_queue_[twist_idx].twist.linear.x)};
+    float w{static_cast<float>(twist_queue_[twist_idx].twist.angular.z)};
 
-    if (std::abs(*it_time_stamp - twist_stamp) > 0.1) {
+    if (std::abs(time_stamp - twist_stamps_[twist_idx]) > 0.1) {
       RCLCPP_WARN_STREAM_THROTTLE(
         get_logger(), *get_clock(), 10000 /* ms */,
         "twist time_stamp is too late. Could not interpolate.");
@@ -250,57 +269,97 @@ bool DistortionCorrectorComponent::undistortPointCloud(
       w = 0.0f;
     }
 
-    if (use_imu_ && !angular_velocity_queue_.empty()) {
-      for (;
-           (imu_it != std::end(angular_velocity_queue_) - 1 &&
-            *it_time_stamp > rclcpp::Time(imu_it->header.stamp).seconds());
-           ++imu_it) {
-      }
-
-      while (imu_it != std::end(angular_velocity_queue_) - 1 && *it_time_stamp > imu_stamp) {
-        ++imu_it;
-        imu_stamp = rclcpp::Time(imu_it->header.stamp).seconds();
+    if (use_imu) {
+      while (imu_idx != imu_stamps_.size() - 1 && time_stamp > imu_stamps_[imu_idx]) {
+        ++imu_idx;
       }
 
-      if (std::abs(*it_time_stamp - imu_stamp) > 0.1) {
+      if (std::abs(time_stamp - imu_stamps_[imu_idx]) > 0.1) {
         RCLCPP_WARN_STREAM_THROTTLE(
           get_logger(), *get_clock(), 10000 /* ms */,
           "imu time_stamp is too late. Could not interpolate.");
       } else {
-        w = static_cast<float>(imu_it->vector.z);
+        w = static_cast<float>(angular_velocity_queue_[imu_idx].vector.z);
       }
     }
 
-    const auto time_offset = static_cast<float>(*it_time_stamp - prev_time_stamp_sec);
-
-    point.setValue(*it_x, *it_y, *it_z);
-
-    if (need_transform) {
-      point = tf2_base_link_to_sensor_inv * point;
+    const auto time_offset = static_cast<float>(time_stamp - prev_time_stamp_sec);
+    if (time_offset != 0.0f) {
+      theta += w * time_offset;
+      cos_theta = tier4_autoware_utils::cos(theta);
+      sin_theta = tier4_autoware_utils::sin(theta);
+      const float dis = v * time_offset;
+      x += dis * cos_theta;
+      y += dis * sin_theta;
     }
 
-    theta += w * time_offset;
-    baselink_quat.setValue(
-      0, 0, tier4_autoware_utils::sin(theta * 0.5f),
-      tier4_autoware_utils::cos(theta * 0.5f));  // baselink_quat.setRPY(0.0, 0.0, theta);
-    const float dis = v * time_offset;
-    x += dis * tier4_autoware_utils::cos(theta);
-    y += dis * tier4_autoware_utils::sin(theta);
+    x_buf_[i] = *it_x;
+    y_buf_[i] = *it_y;
+    z_buf_[i] = *it_z;
+    cos_theta_buf_[i] = cos_theta;
+    sin_theta_buf_[i] = sin_theta;
+    odom_x_buf_[i] = x;
+    odom_y_buf_[i] = y;
 
-    baselink_tf_odom.setOrigin(tf2::Vector3(x, y, 0.0));
-    baselink_tf_odom.setRotation(baselink_quat);
+    prev_time_stamp_sec = time_stamp;
+  }
 
-    undistorted_point = baselink_tf_odom * point;
+  // Pass 2: apply sensor -> base_link, the per-point ego motion and base_link -> sensor over the
+  // contiguous lanes. The loop bodies are branch-free so that they vectorize.
+  float * const px = x_buf_.data();
+  float * const py = y_buf_.data();
+  float * const pz = z_buf_.data();
+  const float * const pc = cos_theta_buf_.data();
+  const float * const ps = sin_theta_buf_.data();
+  const float * const ox = odom_x_buf_.data();
+  const float * const oy = odom_y_buf_.data();
 
-    if (need_transform) {
-      undistorted_point = tf2_base_link_to_sensor * undistorted_point;
+  // For performance, avoid transform computation if unnecessary
+  const bool need_transform = points.header.frame_id != base_link_frame_;
+  if (need_transform) {
+    const tf2::Transform tf2_base_link_to_sensor_inv{tf2_base_link_to_sensor.inverse()};
+    float a[3][3];
+    float a_t[3];
+    float b[3][3];
+    float b_t[3];
+    for (int r = 0; r < 3; ++r) {
+      for (int c = 0; c < 3; ++c) {
+        a[r][c] = static_cast<float>(tf2_base_link_to_sensor_inv.getBasis()[r][c]);
+        b[r][c] = static_cast<float>(tf2_base_link_to_sensor.getBasis()[r][c]);
+      }
+      a_t[r] = static_cast<float>(tf2_base_link_to_sensor_inv.getOrigin()[r]);
+      b_t[r] = static_cast<float>(tf2_base_link_to_sensor.getOrigin()[r]);
     }
 
-    *it_x = static_cast<float>(undistorted_point.getX());
-    *it_y = static_cast<float>(undistorted_point.getY());
-    *it_z = static_cast<float>(undistorted_point.getZ());
+    for (std::size_t i = 0; i < num_points; ++i) {
+      // sensor -> base_link
+      const float bx = a[0][0] * px[i] + a[0][1] * py[i] + a[0][2] * pz[i] + a_t[0];
+      const float by = a[1][0] * px[i] + a[1][1] * py[i] + a[1][2] * pz[i] + a_t[1];
+      const float bz = a[2][0] * px[i] + a[2][1] * py[i] + a[2][2] * pz[i] + a_t[2];
+      // undistort in base_link
+      const float ux = pc[i] * bx - ps[i] * by + ox[i];
+      const float uy = ps[i] * bx + pc[i] * by + oy[i];
+      // base_link -> sensor
+      px[i] = b[0][0] * ux + b[0][1] * uy + b[0][2] * bz + b_t[0];
+      py[i] = b[1][0] * ux + b[1][1] * uy + b[1][2] * bz + b_t[1];
+      pz[i] = b[2][0] * ux + b[2][1] * uy + b[2][2] * bz + b_t[2];
+    }
+  } else {
+    for (std::size_t i = 0; i < num_points; ++i) {
+      const float ux = pc[i] * px[i] - ps[i] * py[i] + ox[i];
+      const float uy = ps[i] * px[i] + pc[i] * py[i] + oy[i];
+      px[i] = ux;
+      py[i] = uy;
+    }
+  }
 
-    prev_time_stamp_sec = *it_time_stamp;
+  sensor_msgs::PointCloud2Iterator<float> out_x(points, "x");
+  sensor_msgs::PointCloud2Iterator<float> out_y(points, "y");
+  sensor_msgs::PointCloud2Iterator<float> out_z(points, "z");
+  for (std::size_t i = 0; i < num_points; ++i, ++out_x, ++out_y, ++out_z) {
+    *out_x = px[i];
+    *out_y = py[i];
+    *out_z = pz[i];
   }
   return true;
 }
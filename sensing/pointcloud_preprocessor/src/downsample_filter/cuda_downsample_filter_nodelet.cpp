@@ -0,0 +1,155 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pointcloud_preprocessor/downsample_filter/cuda_downsample_filter_nodelet.hpp"
+
+#include <sensor_msgs/point_cloud2_iterator.hpp>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace pointcloud_preprocessor
+{
+CudaVoxelGridDownsampleFilterComponent::CudaVoxelGridDownsampleFilterComponent(
+  const rclcpp::NodeOptions & options)
+: CudaVoxelGridDownsampleFilterComponent(
+    "CudaVoxelGridDownsampleFilter", options, CudaVoxelGridDownsample::Mode::Centroid)
+{
+}
+
+CudaVoxelGridDownsampleFilterComponent::CudaVoxelGridDownsampleFilterComponent(
+  const std::string & filter_name, const rclcpp::NodeOptions & options,
+  const CudaVoxelGridDownsample::Mode mode)
+: Filter(filter_name, options), mode_(mode)
+{
+  // initialize debug tool
+  {
+    using tier4_autoware_utils::DebugPublisher;
+    using tier4_autoware_utils::StopWatch;
+    stop_watch_ptr_ = std::make_unique<StopWatch<std::chrono::milliseconds>>();
+    debug_publisher_ = std::make_unique<DebugPublisher>(this, "cuda_voxel_grid_downsample_filter");
+    stop_watch_ptr_->tic("cyclic_time");
+    stop_watch_ptr_->tic("processing_time");
+  }
+
+  // set initial parameters
+  {
+    voxel_size_x_ = static_cast<double>(declare_parameter("voxel_size_x", 0.3));
+    voxel_size_y_ = static_cast<double>(declare_parameter("voxel_size_y", 0.3));
+    voxel_size_z_ = static_cast<double>(declare_parameter("voxel_size_z", 0.1));
+  }
+
+  using std::placeholders::_1;
+  set_param_res_ = this->add_on_set_parameters_callback(
+    std::bind(&CudaVoxelGridDownsampleFilterComponent::paramCallback, this, _1));
+}
+
+void CudaVoxelGridDownsampleFilterComponent::filter(
+  const PointCloud2ConstPtr & input, const IndicesPtr & /*indices*/, PointCloud2 & output)
+{
+  std::scoped_lock lock(mutex_);
+  downsample(*input, TransformInfo(), input->header.frame_id, output);
+  output.header = input->header;
+}
+
+void CudaVoxelGridDownsampleFilterComponent::faster_filter(
+  const PointCloud2ConstPtr & input, const IndicesPtr & /*indices*/, PointCloud2 & output,
+  const TransformInfo & transform_info)
+{
+  std::scoped_lock lock(mutex_);
+  // Note that `input->header.frame_id` is data before converted when `need_transform == true`
+  downsample(
+    *input, transform_info, !tf_input_frame_.empty() ? tf_input_frame_ : tf_input_orig_frame_,
+    output);
+}
+
+void CudaVoxelGridDownsampleFilterComponent::downsample(
+  const PointCloud2 & input, const TransformInfo & transform_info, const std::string & frame_id,
+  PointCloud2 & output)
+{
+  stop_watch_ptr_->toc("processing_time", true);
+
+  CudaVoxelGridParam param;
+  param.voxel_size_x = static_cast<float>(voxel_size_x_);
+  param.voxel_size_y = static_cast<float>(voxel_size_y_);
+  param.voxel_size_z = static_cast<float>(voxel_size_z_);
+  for (int row = 0; row < 4; ++row) {
+    for (int col = 0; col < 4; ++col) {
+      param.transform[row * 4 + col] = transform_info.eigen_transform(row, col);
+    }
+  }
+  param.need_transform = transform_info.need_transform;
+
+  const std::size_t num_output = downsampler_.downsampleHost(
+    input.data.data(), input.width * input.height, input.point_step,
+    input.fields[pcl::getFieldIndex(input, "x")].offset,
+    input.fields[pcl::getFieldIndex(input, "y")].offset,
+    input.fields[pcl::getFieldIndex(input, "z")].offset, param, mode_);
+
+  // same layout as pcl::PointXYZ, so the pinned result is copied point by point
+  sensor_msgs::PointCloud2Modifier modifier(output);
+  modifier.setPointCloud2FieldsByString(1, "xyz");
+  modifier.resize(num_output);
+  const float4 * points = downsampler_.outputHost();
+  for (std::size_t i = 0; i < num_output; ++i) {
+    std::memcpy(&output.data[i * output.point_step], &points[i], 3 * sizeof(float));
+  }
+  output.header.frame_id = frame_id;
+  output.is_dense = true;
+
+  // add processing time for debug
+  if (debug_publisher_) {
+    const double cyclic_time_ms = stop_watch_ptr_->toc("cyclic_time", true);
+    const double processing_time_ms = stop_watch_ptr_->toc("processing_time", true);
+    debug_publisher_->publish<tier4_debug_msgs::msg::Float64Stamped>(
+      "debug/cyclic_time_ms", cyclic_time_ms);
+    debug_publisher_->publish<tier4_debug_msgs::msg::Float64Stamped>(
+      "debug/processing_time_ms", processing_time_ms);
+  }
+}
+
+rcl_interfaces::msg::SetParametersResult CudaVoxelGridDownsampleFilterComponent::paramCallback(
+  const std::vector<rclcpp::Parameter> & p)
+{
+  std::scoped_lock lock(mutex_);
+
+  if (get_param(p, "voxel_size_x", voxel_size_x_)) {
+    RCLCPP_DEBUG(get_logger(), "Setting new voxel size x to: %f.", voxel_size_x_);
+  }
+  if (get_param(p, "voxel_size_y", voxel_size_y_)) {
+    RCLCPP_DEBUG(get_logger(), "Setting new voxel size y to: %f.", voxel_size_y_);
+  }
+  if (get_param(p, "voxel_size_z", voxel_size_z_)) {
+    RCLCPP_DEBUG(get_logger(), "Setting new voxel size z to: %f.", voxel_size_z_);
+  }
+
+  rcl_interfaces::msg::SetParametersResult result;
+  result.successful = true;
+  result.reason = "success";
+
+  return result;
+}
+
+CudaApproximateDownsampleFilterComponent::CudaApproximateDownsampleFilterComponent(
+  const rclcpp::NodeOptions & options)
+: CudaVoxelGridDownsampleFilterComponent(
+    "CudaApproximateDownsampleFilter", options, CudaVoxelGridDownsample::Mode::NearestCentroid)
+{
+}
+}  // namespace pointcloud_preprocessor
+
+#include <rclcpp_components/register_node_macro.hpp>
+RCLCPP_COMPONENTS_REGISTER_NODE(pointcloud_preprocessor::CudaVoxelGridDownsampleFilterComponent)
+RCLCPP_COMPONENTS_REGISTER_NODE(pointcloud_preprocessor::CudaApproximateDownsampleFilterComponent)
@@ -0,0 +1,261 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pointcloud_preprocessor/downsample_filter/cuda_voxel_grid_downsample.hpp"
+
+namespace
+{
+const std::size_t THREADS_PER_BLOCK = 256;
+const unsigned long long EMPTY_KEY = ~0ULL;  // NOLINT
+const std::uint32_t INVALID_SLOT = ~0U;
+// 21 bits per axis, voxel indices are biased so that negative coordinates stay positive
+const int KEY_AXIS_BITS = 21;
+const int KEY_AXIS_BIAS = 1 << (KEY_AXIS_BITS - 1);
+const unsigned long long KEY_AXIS_MASK = (1ULL << KEY_AXIS_BITS) - 1ULL;  // NOLINT
+
+std::size_t divup(const std::size_t a, const std::size_t b)
+{
+  return (a + b - 1) / b;
+}
+
+std::size_t nextPowerOfTwo(const std::size_t n)
+{
+  std::size_t p = 1;
+  while (p < n) {
+    p <<= 1;
+  }
+  return p;
+}
+}  // namespace
+
+namespace pointcloud_preprocessor
+{
+struct VoxelGridKernelParam
+{
+  float inverse_voxel_size_x;
+  float inverse_voxel_size_y;
+  float inverse_voxel_size_z;
+  float transform[16];
+  bool need_transform;
+};
+
+__device__ inline unsigned long long hashKey(unsigned long long key)  // NOLINT
+{
+  // splitmix64 finalizer
+  key ^= key >> 30;
+  key *= 0xbf58476d1ce4e5b9ULL;
+  key ^= key >> 27;
+  key *= 0x94d049bb133111ebULL;
+  key ^= key >> 31;
+  return key;
+}
+
+__global__ void insertPoints_kernel(
+  const std::uint8_t * data, const std::size_t num_points, const std::size_t point_step,
+  const std::size_t x_offset, const std::size_t y_offset, const std::size_t z_offset,
+  const VoxelGridKernelParam param, const std::size_t table_mask, float4 * points,
+  std::uint32_t * point_slots, unsigned long long * table_keys, float4 * table_sums)  // NOLINT
+{
+  const std::size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= num_points) return;
+
+  const std::uint8_t * point = data + idx * point_step;
+  float x = *reinterpret_cast<const float *>(point + x_offset);
+  float y = *reinterpret_cast<const float *>(point + y_offset);
+  float z = *reinterpret_cast<const float *>(point + z_offset);
+  if (!isfinite(x) || !isfinite(y) || !isfinite(z)) {
+    point_slots[idx] = INVALID_SLOT;
+    return;
+  }
+  if (param.need_transform) {
+    const float * m = param.transform;
+    const float tx = m[0] * x + m[1] * y + m[2] * z + m[3];
+    const float ty = m[4] * x + m[5] * y + m[6] * z + m[7];
+    const float tz = m[8] * x + m[9] * y + m[10] * z + m[11];
+    x = tx;
+    y = ty;
+    z = tz;
+  }
+  points[idx] = make_float4(x, y, z, 1.0f);
+
+  const int ix = static_cast<int>(floorf(x * param.inverse_voxel_size_x)) + KEY_AXIS_BIAS;
+  const int iy = static_cast<int>(floorf(y * param.inverse_voxel_size_y)) + KEY_AXIS_BIAS;
+  const int iz = static_cast<int>(floorf(z * param.inverse_voxel_size_z)) + KEY_AXIS_BIAS;
+  const unsigned long long key =  // NOLINT
+    ((static_cast<unsigned long long>(ix) & KEY_AXIS_MASK) << (2 * KEY_AXIS_BITS)) |  // NOLINT
+    ((static_cast<unsigned long long>(iy) & KEY_AXIS_MASK) << KEY_AXIS_BITS) |  // NOLINT
+    (static_cast<unsigned long long>(iz) & KEY_AXIS_MASK);  // NOLINT
+
+  // linear probing, the table holds at least twice as many slots as points
+  std::size_t slot = hashKey(key) & table_mask;
+  while (true) {
+    const unsigned long long prev = atomicCAS(&table_keys[slot], EMPTY_KEY, key);  // NOLINT
+    if (prev == EMPTY_KEY || prev == key) break;
+    slot = (slot + 1) & table_mask;
+  }
+  point_slots[idx] = static_cast<std::uint32_t>(slot);
+
+  atomicAdd(&table_sums[slot].x, x);
+  atomicAdd(&table_sums[slot].y, y);
+  atomicAdd(&table_sums[slot].z, z);
+  atomicAdd(&table_sums[slot].w, 1.0f);
+}
+
+__global__ void findNearestToCentroid_kernel(
+  const float4 * points, const std::uint32_t * point_slots, const std::size_t num_points,
+  const float4 * table_sums, unsigned long long * table_nearest)  // NOLINT
+{
+  const std::size_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= num_points) return;
+
+  const std::uint32_t slot = point_slots[idx];
+  if (slot == INVALID_SLOT) return;
+
+  const float4 sum = table_sums[slot];
+  const float4 p = points[idx];
+  const float dx = p.x - sum.x / sum.w;
+  const float dy = p.y - sum.y / sum.w;
+  const float dz = p.z - sum.z / sum.w;
+  // squared distances are non-negative, so their bit patterns order like the values
+  const std::uint32_t distance_bits = __float_as_uint(dx * dx + dy * dy + dz * dz);
+  const unsigned long long packed =  // NOLINT
+    (static_cast<unsigned long long>(distance_bits) << 32) |  // NOLINT
+    static_cast<unsigned long long>(idx);  // NOLINT
+  atomicMin(&table_nearest[slot], packed);
+}
+
+__global__ void compactCentroids_kernel(
+  const unsigned long long * table_keys, const float4 * table_sums,  // NOLINT
+  const std::size_t table_size, float4 * output, std::uint32_t * num_output)
+{
+  const std::size_t slot = blockIdx.x * blockDim.x + threadIdx.x;
+  if (slot >= table_size || table_keys[slot] == EMPTY_KEY) return;
+
+  const float4 sum = table_sums[slot];
+  const std::uint32_t out_idx = atomicAdd(num_output, 1U);
+  output[out_idx] = make_float4(sum.x / sum.w, sum.y / sum.w, sum.z / sum.w, 0.0f);
+}
+
+__global__ void compactNearest_kernel(
+  const unsigned long long * table_keys, const unsigned long long * table_nearest,  // NOLINT
+  const float4 * points, const std::size_t table_size, float4 * output,
+  std::uint32_t * num_output)
+{
+  const std::size_t slot = blockIdx.x * blockDim.x + threadIdx.x;
+  if (slot >= table_size || table_keys[slot] == EMPTY_KEY) return;
+
+  const float4 p = points[table_nearest[slot] & 0xffffffffULL];
+  const std::uint32_t out_idx = atomicAdd(num_output, 1U);
+  output[out_idx] = make_float4(p.x, p.y, p.z, 0.0f);
+}
+
+CudaVoxelGridDownsample::CudaVoxelGridDownsample()
+: stream_(cuda_utils::makeCudaStream(cudaStreamNonBlocking)),
+  num_output_d_(cuda_utils::make_unique<std::uint32_t>()),
+  num_output_h_(cuda_utils::make_unique_host<std::uint32_t>(cudaHostAllocDefault))
+{
+}
+
+void CudaVoxelGridDownsample::reserve(const std::size_t num_points)
+{
+  if (num_points > points_capacity_) {
+    points_capacity_ = nextPowerOfTwo(num_points);
+    table_size_ = 2 * points_capacity_;
+    points_d_ = cuda_utils::make_unique<float4[]>(points_capacity_);
+    point_slots_d_ = cuda_utils::make_unique<std::uint32_t[]>(points_capacity_);
+    table_keys_d_ = cuda_utils::make_unique<unsigned long long[]>(table_size_);  // NOLINT
+    table_sums_d_ = cuda_utils::make_unique<float4[]>(table_size_);
+    table_nearest_d_ = cuda_utils::make_unique<unsigned long long[]>(table_size_);  // NOLINT
+    output_d_ = cuda_utils::make_unique<float4[]>(points_capacity_);
+    output_h_ = cuda_utils::make_unique_host<float4[]>(points_capacity_, cudaHostAllocDefault);
+  }
+}
+
+std::size_t CudaVoxelGridDownsample::downsampleHost(
+  const std::uint8_t * data, const std::size_t num_points, const std::size_t point_step,
+  const std::size_t x_offset, const std::size_t y_offset, const std::size_t z_offset,
+  const CudaVoxelGridParam & param, const Mode mode)
+{
+  if (num_points == 0) return 0;
+
+  const std::size_t data_size = num_points * point_step;
+  if (data_size > data_capacity_) {
+    data_capacity_ = nextPowerOfTwo(data_size);
+    data_d_ = cuda_utils::make_unique<std::uint8_t[]>(data_capacity_);
+  }
+  CHECK_CUDA_ERROR(cudaMemcpyAsync(
+    data_d_.get(), data, data_size, cudaMemcpyHostToDevice, *stream_));
+  const std::size_t num_output = downsampleDevice(
+    data_d_.get(), num_points, point_step, x_offset, y_offset, z_offset, param, mode);
+
+  CHECK_CUDA_ERROR(cudaMemcpyAsync(
+    output_h_.get(), output_d_.get(), num_output * sizeof(float4), cudaMemcpyDeviceToHost,
+    *stream_));
+  CHECK_CUDA_ERROR(cudaStreamSynchronize(*stream_));
+  return num_output;
+}
+
+std::size_t CudaVoxelGridDownsample::downsampleDevice(
+  const std::uint8_t * data_d, const std::size_t num_points, const std::size_t point_step,
+  const std::size_t x_offset, const std::size_t y_offset, const std::size_t z_offset,
+  const CudaVoxelGridParam & param, const Mode mode)
+{
+  if (num_points == 0) return 0;
+
+  reserve(num_points);
+
+  VoxelGridKernelParam kernel_param;
+  kernel_param.inverse_voxel_size_x = 1.0f / param.voxel_size_x;
+  kernel_param.inverse_voxel_size_y = 1.0f / param.voxel_size_y;
+  kernel_param.inverse_voxel_size_z = 1.0f / param.voxel_size_z;
+  for (int i = 0; i < 16; ++i) {
+    kernel_param.transform[i] = param.transform[i];
+  }
+  kernel_param.need_transform = param.need_transform;
+
+  CHECK_CUDA_ERROR(cudaMemsetAsync(
+    table_keys_d_.get(), 0xff, table_size_ * sizeof(unsigned long long), *stream_));  // NOLINT
+  CHECK_CUDA_ERROR(cudaMemsetAsync(table_sums_d_.get(), 0, table_size_ * sizeof(float4), *stream_));
+  CHECK_CUDA_ERROR(cudaMemsetAsync(num_output_d_.get(), 0, sizeof(std::uint32_t), *stream_));
+
+  const std::size_t point_blocks = divup(num_points, THREADS_PER_BLOCK);
+  const std::size_t table_blocks = divup(table_size_, THREADS_PER_BLOCK);
+  insertPoints_kernel<<<point_blocks, THREADS_PER_BLOCK, 0, *stream_>>>(
+    data_d, num_points, point_step, x_offset, y_offset, z_offset, kernel_param, table_size_ - 1,
+    points_d_.get(), point_slots_d_.get(), table_keys_d_.get(), table_sums_d_.get());
+
+  if (mode == Mode::NearestCentroid) {
+    CHECK_CUDA_ERROR(cudaMemsetAsync(
+      table_nearest_d_.get(), 0xff, table_size_ * sizeof(unsigned long long),  // NOLINT
+      *stream_));
+    findNearestToCentroid_kernel<<<point_blocks, THREADS_PER_BLOCK, 0, *stream_>>>(
+      points_d_.get(), point_slots_d_.get(), num_points, table_sums_d_.get(),
+      table_nearest_d_.get());
+    compactNearest_kernel<<<table_blocks, THREADS_PER_BLOCK, 0, *stream_>>>(
+      table_keys_d_.get(), table_nearest_d_.get(), points_d_.get(), table_size_,
+      output_d_.get(), num_output_d_.get());
+  } else {
+    compactCentroids_kernel<<<table_blocks, THREADS_PER_BLOCK, 0, *stream_>>>(
+      table_keys_d_.get(), table_sums_d_.get(), table_size_, output_d_.get(),
+      num_output_d_.get());
+  }
+  CHECK_CUDA_ERROR(cudaGetLastError());
+
+  CHECK_CUDA_ERROR(cudaMemcpyAsync(
+    num_output_h_.get(), num_output_d_.get(), sizeof(std::uint32_t), cudaMemcpyDeviceToHost,
+    *stream_));
+  CHECK_CUDA_ERROR(cudaStreamSynchronize(*stream_));
+  return *num_output_h_;
+}
+}  // namespace pointcloud_preprocessor
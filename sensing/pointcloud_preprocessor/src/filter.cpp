@@ -120,11 +120,8 @@ void pointcloud_preprocessor::Filter::subscribe()
 
 void pointcloud_preprocessor::Filter::subscribe(const std::string & filter_name)
 {
-  // TODO(sykwer): Change the corresponding node to subscribe to `faster_input_indices_callback`
-  // each time a child class supports the faster version.
-  // When all the child classes support the faster version, this workaround is deleted.
-  auto callback = filter_name == "CropBoxFilter" ? &Filter::faster_input_indices_callback
-                                                 : &Filter::input_indices_callback;
+  (void)filter_name;
+  auto callback = &Filter::input_indices_callback;
 
   if (use_indices_) {
     // Subscribe to the input using a filter
@@ -170,24 +167,27 @@ void pointcloud_preprocessor::Filter::unsubscribe()
   }
 }
 
-//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// TODO(sykwer): Temporary Implementation: Delete this function definition when all the filter nodes
-// conform to new API.
-void pointcloud_preprocessor::Filter::computePublish(
-  const PointCloud2ConstPtr & input, const IndicesPtr & indices)
+//////////////////////////////////////////////////////////////////////////////////////////////
+bool pointcloud_preprocessor::Filter::runFilter(
+  const PointCloud2ConstPtr & input, std::unique_ptr<PointCloud2> & output)
 {
-  auto output = std::make_unique<PointCloud2>();
+  if (!isValid(input)) {
+    RCLCPP_ERROR(this->get_logger(), "[runFilter] Invalid input!");
+    return false;
+  }
 
-  // Call the virtual method in the child
-  filter(input, indices, *output);
+  tf_input_orig_frame_ = input->header.frame_id;
+  auto filtered = std::make_unique<PointCloud2>();
 
-  if (!convert_output_costly(output)) return;
+  TransformInfo transform_info;
+  if (!calculate_transform_matrix(tf_input_frame_, *input, transform_info)) return false;
+  faster_filter(input, IndicesPtr(), *filtered, transform_info);
 
-  // Copy timestamp to keep it
-  output->header.stamp = input->header.stamp;
+  if (!convert_output_costly(filtered)) return false;
 
-  // Publish a boost shared ptr
-  pub_output_->publish(std::move(output));
+  filtered->header.stamp = input->header.stamp;
+  output = std::move(filtered);
+  return true;
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////
@@ -210,83 +210,6 @@ rcl_interfaces::msg::SetParametersResult pointcloud_preprocessor::Filter::filter
   return result;
 }
 
-//////////////////////////////////////////////////////////////////////////////////////////////
-// TODO(sykwer): Temporary Implementation: Delete this function definition when all the filter nodes
-// conform to new API.
-void pointcloud_preprocessor::Filter::input_indices_callback(
-  const PointCloud2ConstPtr cloud, const PointIndicesConstPtr indices)
-{
-  // If cloud is given, check if it's valid
-  if (!isValid(cloud)) {
-    RCLCPP_ERROR(this->get_logger(), "[input_indices_callback] Invalid input!");
-    return;
-  }
-  // If indices are given, check if they are valid
-  if (indices && !isValid(indices)) {
-    RCLCPP_ERROR(this->get_logger(), "[input_indices_callback] Invalid indices!");
-    return;
-  }
-
-  /// DEBUG
-  if (indices) {
-    RCLCPP_DEBUG(
-      this->get_logger(),
-      "[input_indices_callback]\n"
-      "   - PointCloud with %d data points (%s), stamp %f, and frame %s on input topic received.\n"
-      "   - PointIndices with %zu values, stamp %f, and frame %s on indices topic received.",
-      cloud->width * cloud->height, pcl::getFieldsList(*cloud).c_str(),
-      rclcpp::Time(cloud->header.stamp).seconds(), cloud->header.frame_id.c_str(),
-      indices->indices.size(), rclcpp::Time(indices->header.stamp).seconds(),
-      indices->header.frame_id.c_str());
-  } else {
-    RCLCPP_DEBUG(
-      this->get_logger(),
-      "[input_indices_callback] PointCloud with %d data points and frame %s on input topic "
-      "received.",
-      cloud->width * cloud->height, cloud->header.frame_id.c_str());
-  }
-  ///
-
-  // Check whether the user has given a different input TF frame
-  tf_input_orig_frame_ = cloud->header.frame_id;
-  PointCloud2ConstPtr cloud_tf;
-  if (!tf_input_frame_.empty() && cloud->header.frame_id != tf_input_frame_) {
-    RCLCPP_DEBUG(
-      this->get_logger(), "[input_indices_callback] Transforming input dataset from %s to %s.",
-      cloud->header.frame_id.c_str(), tf_input_frame_.c_str());
-    // Save the original frame ID
-    // Convert the cloud into the different frame
-    PointCloud2 cloud_transformed;
-
-    if (!tf_buffer_->canTransform(
-          tf_input_frame_, cloud->header.frame_id, this->now(),
-          rclcpp::Duration::from_seconds(1.0))) {
-      RCLCPP_ERROR_STREAM(
-        this->get_logger(), "[input_indices_callback] timeout tf: " << cloud->header.frame_id
-                                                                    << "->" << tf_input_frame_);
-      return;
-    }
-
-    if (!pcl_ros::transformPointCloud(tf_input_frame_, *cloud, cloud_transformed, *tf_buffer_)) {
-      RCLCPP_ERROR(
-        this->get_logger(),
-        "[input_indices_callback] Error converting input dataset from %s to %s.",
-        cloud->header.frame_id.c_str(), tf_input_frame_.c_str());
-      return;
-    }
-    cloud_tf = std::make_shared<PointCloud2>(cloud_transformed);
-  } else {
-    cloud_tf = cloud;
-  }
-  // Need setInputCloud () here because we have to extract x/y/z
-  IndicesPtr vindices;
-  if (indices) {
-    vindices.reset(new std::vector<int>(indices->indices));
-  }
-
-  computePublish(cloud_tf, vindices);
-}
-
 // For performance reason, we get only a transformation matrix here.
 // The implementation is based on the one shown in the URL below.
 // https://github.com/ros-perception/perception_pcl/blob/628aaec1dc73ef4adea01e9d28f11eb417b948fd/pcl_ros/src/transforms.cpp#L61-L94
@@ -396,10 +319,7 @@ bool pointcloud_preprocessor::Filter::convert_output_costly(std::unique_ptr<Poin
   return true;
 }
 
-// TODO(sykwer): Temporary Implementation: Rename this function to `input_indices_callback()` when
-// all the filter nodes conform to new API. Then delete the old `input_indices_callback()` defined
-// above.
-void pointcloud_preprocessor::Filter::faster_input_indices_callback(
+void pointcloud_preprocessor::Filter::input_indices_callback(
   const PointCloud2ConstPtr cloud, const PointIndicesConstPtr indices)
 {
   if (!isValid(cloud)) {
@@ -445,7 +365,6 @@ void pointcloud_preprocessor::Filter::faster_input_indices_callback(
 
   auto output = std::make_unique<PointCloud2>();
 
-  // TODO(sykwer): Change to `filter()` call after when the filter nodes conform to new API.
   faster_filter(cloud, vindices, *output, transform_info);
 
   if (!convert_output_costly(output)) return;
@@ -454,15 +373,36 @@ void pointcloud_preprocessor::Filter::faster_input_indices_callback(
   pub_output_->publish(std::move(output));
 }
 
-// TODO(sykwer): Temporary Implementation: Remove this interface when all the filter nodes conform
-// to new API. It's not a pure virtual function so that a child class does not have to implement
-// this function.
+// Fallback for the filters that only implement `filter()`: transform the input with the already
+// computed matrix and run `filter()` on it. This pays for an extra copy of the cloud and, in most
+// of the filters, for the PCL conversions inside `filter()`, so it is reported on diagnostics.
 void pointcloud_preprocessor::Filter::faster_filter(
   const PointCloud2ConstPtr & input, const IndicesPtr & indices, PointCloud2 & output,
   const TransformInfo & transform_info)
 {
-  (void)input;
-  (void)indices;
-  (void)output;
-  (void)transform_info;
+  if (!legacy_path_updater_) {
+    RCLCPP_WARN(
+      this->get_logger(),
+      "%s has no native faster_filter() implementation, falling back to filter().",
+      filter_field_name_.c_str());
+    legacy_path_updater_ = std::make_unique<diagnostic_updater::Updater>(this);
+    legacy_path_updater_->setHardwareID(filter_field_name_);
+    legacy_path_updater_->add(
+      "filter_path", [](diagnostic_updater::DiagnosticStatusWrapper & stat) {
+        stat.add("native_implementation", false);
+        stat.summary(
+          diagnostic_msgs::msg::DiagnosticStatus::OK,
+          "filter() runs through the legacy conversion path");
+      });
+  }
+
+  if (!transform_info.need_transform) {
+    filter(input, indices, output);
+    return;
+  }
+
+  auto input_transformed = std::make_shared<PointCloud2>();
+  pcl_ros::transformPointCloud(transform_info.eigen_transform, *input, *input_transformed);
+  input_transformed->header.frame_id = tf_input_frame_;
+  filter(input_transformed, indices, output);
 }
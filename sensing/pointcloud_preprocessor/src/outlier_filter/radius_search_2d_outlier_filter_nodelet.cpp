@@ -17,6 +17,7 @@
 #include <pcl/kdtree/kdtree_flann.h>
 #include <pcl/search/kdtree.h>
 #include <pcl/segmentation/segment_differences.h>
+#include <sensor_msgs/point_cloud2_iterator.hpp>
 
 #include <vector>
 
@@ -68,6 +69,35 @@ void RadiusSearch2DOutlierFilterComponent::filter(
   output.header = input->header;
 }
 
+void RadiusSearch2DOutlierFilterComponent::faster_filter(
+  const PointCloud2ConstPtr & input, [[maybe_unused]] const IndicesPtr & indices,
+  PointCloud2 & output, const TransformInfo & transform_info)
+{
+  std::scoped_lock lock(mutex_);
+  pcl::PointCloud<pcl::PointXY>::Ptr xy_cloud(new pcl::PointCloud<pcl::PointXY>);
+  xy_cloud->points.reserve(input->width * input->height);
+  for (sensor_msgs::PointCloud2ConstIterator<float> iter_x(*input, "x"), iter_y(*input, "y"),
+       iter_z(*input, "z");
+       iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
+    Eigen::Vector4f point(*iter_x, *iter_y, *iter_z, 1);
+    if (transform_info.need_transform && point.allFinite()) {
+      point = transform_info.eigen_transform * point;
+    }
+    pcl::PointXY xy;
+    xy.x = point[0];
+    xy.y = point[1];
+    xy_cloud->points.push_back(xy);
+  }
+
+  std::vector<int> k_indices(xy_cloud->points.size());
+  std::vector<float> k_sqr_distances(xy_cloud->points.size());
+  kd_tree_->setInputCloud(xy_cloud);
+  copyPointsIf(*input, transform_info, output, [&](const size_t i, const Eigen::Vector4f &) {
+    const size_t k = kd_tree_->radiusSearch(i, search_radius_, k_indices, k_sqr_distances);
+    return k >= min_neighbors_;
+  });
+}
+
 rcl_interfaces::msg::SetParametersResult RadiusSearch2DOutlierFilterComponent::paramCallback(
   const std::vector<rclcpp::Parameter> & p)
 {
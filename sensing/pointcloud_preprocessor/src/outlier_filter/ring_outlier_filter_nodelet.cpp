@@ -15,6 +15,7 @@
 #include "pointcloud_preprocessor/outlier_filter/ring_outlier_filter_nodelet.hpp"
 
 #include <algorithm>
+#include <cstring>
 #include <vector>
 namespace pointcloud_preprocessor
 {
@@ -44,56 +45,93 @@ RingOutlierFilterComponent::RingOutlierFilterComponent(const rclcpp::NodeOptions
     std::bind(&RingOutlierFilterComponent::paramCallback, this, _1));
 }
 
+void RingOutlierFilterComponent::bucketByRing(
+  const PointCloud2 & input, const std::size_t ring_offset)
+{
+  const auto * data = input.data.data();
+  const std::size_t data_size = input.data.size();
+
+  // count points per ring, then turn the counts into bucket start positions
+  std::fill(ring_bucket_begin_.begin(), ring_bucket_begin_.end(), 0U);
+  for (std::size_t idx = 0U; idx < data_size; idx += input.point_step) {
+    const auto ring = *reinterpret_cast<const uint16_t *>(data + idx + ring_offset);
+    if (ring + 2U > ring_bucket_begin_.size()) {
+      ring_bucket_begin_.resize(ring + 2U, 0U);
+    }
+    ++ring_bucket_begin_[ring + 1U];
+  }
+  for (std::size_t ring = 1U; ring < ring_bucket_begin_.size(); ++ring) {
+    ring_bucket_begin_[ring] += ring_bucket_begin_[ring - 1U];
+  }
+
+  // stable scatter so that every ring keeps the scan order
+  ring_sorted_offsets_.resize(data_size / input.point_step);
+  ring_bucket_cursor_.assign(ring_bucket_begin_.begin(), ring_bucket_begin_.end());
+  for (std::size_t idx = 0U; idx < data_size; idx += input.point_step) {
+    const auto ring = *reinterpret_cast<const uint16_t *>(data + idx + ring_offset);
+    ring_sorted_offsets_[ring_bucket_cursor_[ring]++] = idx;
+  }
+}
+
 void RingOutlierFilterComponent::filter(
   const PointCloud2ConstPtr & input, [[maybe_unused]] const IndicesPtr & indices,
   PointCloud2 & output)
 {
   std::scoped_lock lock(mutex_);
   stop_watch_ptr_->toc("processing_time", true);
-  std::unordered_map<uint16_t, std::vector<std::size_t>> input_ring_map;
-  input_ring_map.reserve(128);
-  sensor_msgs::msg::PointCloud2::SharedPtr input_ptr =
-    std::make_shared<sensor_msgs::msg::PointCloud2>(*input);
 
   const auto ring_offset =
     input->fields.at(static_cast<size_t>(autoware_point_types::PointIndex::Ring)).offset;
-  for (std::size_t idx = 0U; idx < input_ptr->data.size(); idx += input_ptr->point_step) {
-    input_ring_map[*reinterpret_cast<uint16_t *>(&input_ptr->data[idx + ring_offset])].push_back(
-      idx);
-  }
+  bucketByRing(*input, ring_offset);
 
+  // the output can never be larger than the input, so size it once and shrink at the end
   PointCloud2Modifier<PointXYZI> output_modifier{output, input->header.frame_id};
-  output_modifier.reserve(input->width);
-
-  std::vector<std::size_t> tmp_indices;
-  tmp_indices.reserve(input->width);
+  output_modifier.resize(ring_sorted_offsets_.size());
+  auto * output_data = output.data.data();
+  std::size_t num_output_points = 0U;
+
+  const auto * data = input->data.data();
+  const auto emit_cluster = [&](const std::size_t begin, const std::size_t end) {
+    if (!isCluster(
+          data, ring_sorted_offsets_[begin], ring_sorted_offsets_[end - 1U], end - begin)) {
+      return;
+    }
+    for (std::size_t i = begin; i < end; ++i) {
+      std::memcpy(
+        output_data + num_output_points * sizeof(PointXYZI), data + ring_sorted_offsets_[i],
+        sizeof(PointXYZI));
+      ++num_output_points;
+    }
+  };
 
   const auto azimuth_offset =
     input->fields.at(static_cast<size_t>(autoware_point_types::PointIndex::Azimuth)).offset;
   const auto distance_offset =
     input->fields.at(static_cast<size_t>(autoware_point_types::PointIndex::Distance)).offset;
-  for (const auto & ring_indices : input_ring_map) {
-    if (ring_indices.second.size() < 2) {
+  for (std::size_t ring = 0U; ring + 1U < ring_bucket_begin_.size(); ++ring) {
+    const std::size_t ring_begin = ring_bucket_begin_[ring];
+    const std::size_t ring_end = ring_bucket_begin_[ring + 1U];
+    if (ring_end - ring_begin < 2U) {
       continue;
     }
 
-    for (size_t idx = 0U; idx < ring_indices.second.size() - 1; ++idx) {
-      const auto & current_idx = ring_indices.second.at(idx);
-      const auto & next_idx = ring_indices.second.at(idx + 1);
-      tmp_indices.emplace_back(current_idx);
+    std::size_t cluster_begin = ring_begin;
+    for (std::size_t idx = ring_begin; idx < ring_end - 1U; ++idx) {
+      const auto current_idx = ring_sorted_offsets_[idx];
+      const auto next_idx = ring_sorted_offsets_[idx + 1U];
 
       // if(std::abs(iter->distance - (iter+1)->distance) <= std::sqrt(iter->distance) * 0.08)
       const auto current_pt_azimuth =
-        *reinterpret_cast<float *>(&input_ptr->data[current_idx + azimuth_offset]);
+        *reinterpret_cast<const float *>(data + current_idx + azimuth_offset);
       const auto next_pt_azimuth =
-        *reinterpret_cast<float *>(&input_ptr->data[next_idx + azimuth_offset]);
+        *reinterpret_cast<const float *>(data + next_idx + azimuth_offset);
       float azimuth_diff = next_pt_azimuth - current_pt_azimuth;
       azimuth_diff = azimuth_diff < 0.f ? azimuth_diff + 36000.f : azimuth_diff;
 
       const auto current_pt_distance =
-        *reinterpret_cast<float *>(&input_ptr->data[current_idx + distance_offset]);
+        *reinterpret_cast<const float *>(data + current_idx + distance_offset);
       const auto next_pt_distance =
-        *reinterpret_cast<float *>(&input_ptr->data[next_idx + distance_offset]);
+        *reinterpret_cast<const float *>(data + next_idx + distance_offset);
 
       if (
         std::max(current_pt_distance, next_pt_distance) <
@@ -101,25 +139,16 @@ void RingOutlierFilterComponent::filter(
         azimuth_diff < 100.f) {
         continue;
       }
-      if (isCluster(input_ptr, tmp_indices)) {
-        for (const auto & tmp_idx : tmp_indices) {
-          output_modifier.push_back(
-            std::move(*reinterpret_cast<PointXYZI *>(&input_ptr->data[tmp_idx])));
-        }
-      }
-      tmp_indices.clear();
+      emit_cluster(cluster_begin, idx + 1U);
+      cluster_begin = idx + 1U;
     }
-    if (tmp_indices.empty()) {
-      continue;
-    }
-    if (isCluster(input_ptr, tmp_indices)) {
-      for (const auto & tmp_idx : tmp_indices) {
-        output_modifier.push_back(
-          std::move(*reinterpret_cast<PointXYZI *>(&input_ptr->data[tmp_idx])));
-      }
+    // flush the remaining run, the last point of the ring is not part of it
+    if (cluster_begin < ring_end - 1U) {
+      emit_cluster(cluster_begin, ring_end - 1U);
     }
-    tmp_indices.clear();
   }
+  output_modifier.resize(num_output_points);
+
   // add processing time for debug
   if (debug_publisher_) {
     const double cyclic_time_ms = stop_watch_ptr_->toc("cyclic_time", true);
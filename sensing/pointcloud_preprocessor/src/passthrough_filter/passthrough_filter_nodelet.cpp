@@ -74,6 +74,19 @@ void PassThroughFilterComponent::filter(
   output = *input;
 }
 
+void PassThroughFilterComponent::faster_filter(
+  const PointCloud2ConstPtr & input, [[maybe_unused]] const IndicesPtr & indices,
+  PointCloud2 & output, const TransformInfo & transform_info)
+{
+  std::scoped_lock lock(mutex_);
+  if (!transform_info.need_transform) {
+    output = *input;
+    return;
+  }
+  copyPointsIf(
+    *input, transform_info, output, [](const size_t, const Eigen::Vector4f &) { return true; });
+}
+
 rcl_interfaces::msg::SetParametersResult PassThroughFilterComponent::paramCallback(
   [[maybe_unused]] const std::vector<rclcpp::Parameter> & p)
 {
@@ -0,0 +1,193 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pointcloud_preprocessor/pipeline_filter/pipeline_filter_nodelet.hpp"
+
+#include "pointcloud_preprocessor/crop_box_filter/crop_box_filter_nodelet.hpp"
+#include "pointcloud_preprocessor/downsample_filter/voxel_grid_downsample_filter_nodelet.hpp"
+#include "pointcloud_preprocessor/outlier_filter/ring_outlier_filter_nodelet.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace pointcloud_preprocessor
+{
+PipelineFilterComponent::PipelineFilterComponent(const rclcpp::NodeOptions & options)
+: Filter("PipelineFilter", options)
+{
+  // initialize debug tool
+  {
+    using tier4_autoware_utils::DebugPublisher;
+    using tier4_autoware_utils::StopWatch;
+    stop_watch_ptr_ = std::make_unique<StopWatch<std::chrono::milliseconds>>();
+    debug_publisher_ = std::make_unique<DebugPublisher>(this, "pipeline_filter");
+    stop_watch_ptr_->tic("cyclic_time");
+    stop_watch_ptr_->tic("processing_time");
+  }
+
+  // set initial parameters
+  const auto stage_names = declare_parameter("stages", std::vector<std::string>{});
+  const bool publish_debug_taps = declare_parameter("publish_debug_taps", false);
+  if (stage_names.empty()) {
+    throw std::invalid_argument("Pipeline filter requires at least one stage");
+  }
+
+  // create stages
+  {
+    rclcpp::ExecutorOptions executor_options;
+    executor_options.context = options.context();
+    stage_executor_ = std::make_shared<rclcpp::executors::SingleThreadedExecutor>(executor_options);
+
+    for (const auto & stage_name : stage_names) {
+      const bool is_duplicated = std::any_of(
+        stages_.cbegin(), stages_.cend(),
+        [&stage_name](const Stage & stage) { return stage.name == stage_name; });
+      if (is_duplicated) {
+        throw std::invalid_argument("Pipeline stage " + stage_name + " is given twice");
+      }
+
+      auto stage = createStage(options, stage_name);
+      if (publish_debug_taps) {
+        stage.debug_pub = this->create_publisher<PointCloud2>(
+          "~/debug/" + stage_name + "/output", rclcpp::SensorDataQoS());
+      }
+      stages_.push_back(std::move(stage));
+    }
+
+    stage_executor_thread_ = std::thread([this]() { stage_executor_->spin(); });
+  }
+
+  RCLCPP_INFO_STREAM(get_logger(), "Pipeline filter created with " << stages_.size() << " stages");
+}
+
+PipelineFilterComponent::~PipelineFilterComponent()
+{
+  stage_executor_->cancel();
+  if (stage_executor_thread_.joinable()) {
+    stage_executor_thread_.join();
+  }
+}
+
+rclcpp::NodeOptions PipelineFilterComponent::createStageOptions(
+  const rclcpp::NodeOptions & options, const std::string & stage_name) const
+{
+  // forward "<stage_name>.<parameter>" overrides of this node to the stage as "<parameter>"
+  std::vector<rclcpp::Parameter> parameter_overrides;
+  const std::string prefix = stage_name + ".";
+  for (const auto & parameter : options.parameter_overrides()) {
+    if (parameter.get_name().rfind(prefix, 0) == 0) {
+      parameter_overrides.emplace_back(
+        parameter.get_name().substr(prefix.size()), parameter.get_parameter_value());
+    }
+  }
+
+  // The stage's own input/output topics are never used. The first matching remap rule wins, so
+  // these take precedence over the remaps given to this node, which are kept for the other topics
+  // of the stage (e.g. ~/input/twist of the distortion corrector).
+  std::vector<std::string> arguments{
+    "--ros-args",
+    "-r",
+    "__node:=" + std::string(get_name()) + "_" + stage_name,
+    "-r",
+    "input:=~/input",
+    "-r",
+    "indices:=~/indices",
+    "-r",
+    "output:=~/output"};
+  arguments.insert(arguments.end(), options.arguments().cbegin(), options.arguments().cend());
+
+  return rclcpp::NodeOptions(options).arguments(arguments).parameter_overrides(parameter_overrides);
+}
+
+PipelineFilterComponent::Stage PipelineFilterComponent::createStage(
+  const rclcpp::NodeOptions & options, const std::string & stage_name)
+{
+  const auto stage_options = createStageOptions(options, stage_name);
+
+  Stage stage;
+  stage.name = stage_name;
+  if (stage_name == "crop_box_filter") {
+    stage.filter = std::make_shared<CropBoxFilterComponent>(stage_options);
+  } else if (stage_name == "ring_outlier_filter") {
+    stage.filter = std::make_shared<RingOutlierFilterComponent>(stage_options);
+  } else if (stage_name == "voxel_grid_downsample_filter") {
+    stage.filter = std::make_shared<VoxelGridDownsampleFilterComponent>(stage_options);
+  } else if (stage_name == "distortion_corrector") {
+    stage.distortion_corrector = std::make_shared<DistortionCorrectorComponent>(stage_options);
+  } else {
+    throw std::invalid_argument("Unknown pipeline stage: " + stage_name);
+  }
+
+  if (stage.filter) {
+    stage_executor_->add_node(stage.filter);
+  } else {
+    stage_executor_->add_node(stage.distortion_corrector);
+  }
+  return stage;
+}
+
+void PipelineFilterComponent::filter(
+  const PointCloud2ConstPtr & input, [[maybe_unused]] const IndicesPtr & indices,
+  PointCloud2 & output)
+{
+  std::scoped_lock lock(mutex_);
+  stop_watch_ptr_->toc("processing_time", true);
+
+  // `current` is the read-only input of the next stage, `owned` holds the latest stage output so
+  // that in-place stages can modify it without a copy.
+  PointCloud2ConstPtr current = input;
+  std::unique_ptr<PointCloud2> owned;
+  for (const auto & stage : stages_) {
+    if (stage.filter) {
+      if (owned) {
+        current = std::move(owned);
+      }
+      if (!stage.filter->runFilter(current, owned)) {
+        RCLCPP_WARN_THROTTLE(
+          get_logger(), *get_clock(), 5000, "Pipeline stage %s failed, skipping the cloud.",
+          stage.name.c_str());
+        return;
+      }
+    } else {
+      if (!owned) {
+        owned = std::make_unique<PointCloud2>(*current);
+      }
+      stage.distortion_corrector->undistortPointCloud(*owned);
+    }
+
+    if (
+      stage.debug_pub && (stage.debug_pub->get_subscription_count() +
+                          stage.debug_pub->get_intra_process_subscription_count()) > 0) {
+      stage.debug_pub->publish(*owned);
+    }
+  }
+  output = std::move(*owned);
+
+  // add processing time for debug
+  if (debug_publisher_) {
+    const double cyclic_time_ms = stop_watch_ptr_->toc("cyclic_time", true);
+    const double processing_time_ms = stop_watch_ptr_->toc("processing_time", true);
+    debug_publisher_->publish<tier4_debug_msgs::msg::Float64Stamped>(
+      "debug/cyclic_time_ms", cyclic_time_ms);
+    debug_publisher_->publish<tier4_debug_msgs::msg::Float64Stamped>(
+      "debug/processing_time_ms", processing_time_ms);
+  }
+}
+}  // namespace pointcloud_preprocessor
+
+#include <rclcpp_components/register_node_macro.hpp>
+RCLCPP_COMPONENTS_REGISTER_NODE(pointcloud_preprocessor::PipelineFilterComponent)
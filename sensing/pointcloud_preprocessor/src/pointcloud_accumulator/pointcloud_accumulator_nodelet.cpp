@@ -14,6 +14,9 @@
 
 #include "pointcloud_preprocessor/pointcloud_accumulator/pointcloud_accumulator_nodelet.hpp"
 
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <cstring>
 #include <vector>
 
 namespace pointcloud_preprocessor
@@ -38,19 +41,49 @@ void PointcloudAccumulatorComponent::filter(
   PointCloud2 & output)
 {
   std::scoped_lock lock(mutex_);
-  pointcloud_buffer_.push_front(input);
-  rclcpp::Time last_time = input->header.stamp;
-  pcl::PointCloud<pcl::PointXYZ> pcl_input;
-  pcl::PointCloud<pcl::PointXYZ> pcl_output;
-  for (size_t i = 0; i < pointcloud_buffer_.size(); i++) {
-    if (accumulation_time_sec_ < (last_time - pointcloud_buffer_.at(i)->header.stamp).seconds()) {
+  const rclcpp::Time last_time = input->header.stamp;
+
+  // convert only the new pointcloud, the buffered ones were converted when they arrived
+  auto pcl_input = std::make_shared<pcl::PointCloud<pcl::PointXYZ>>();
+  pcl::fromROSMsg(*input, *pcl_input);
+  pointcloud_buffer_.push_front(AccumulatedPointCloud{last_time, pcl_input});
+
+  const auto is_expired = [&](const AccumulatedPointCloud & accumulated) {
+    return accumulation_time_sec_ < (last_time - accumulated.stamp).seconds();
+  };
+
+  // drop the oldest pointclouds out of the accumulation time
+  while (!pointcloud_buffer_.empty() && is_expired(pointcloud_buffer_.back())) {
+    pointcloud_buffer_.pop_back();
+  }
+
+  size_t num_clouds = 0;
+  size_t num_points = 0;
+  bool is_dense = true;
+  for (; num_clouds < pointcloud_buffer_.size(); ++num_clouds) {
+    const auto & accumulated = pointcloud_buffer_.at(num_clouds);
+    if (is_expired(accumulated)) {
       break;
     }
-    pcl::fromROSMsg(*pointcloud_buffer_.at(i), pcl_input);
-    pcl_output += pcl_input;
+    num_points += accumulated.points->size();
+    is_dense = is_dense && accumulated.points->is_dense;
   }
-  pcl::toROSMsg(pcl_output, output);
+
+  // copy the points into the output at once in the same layout as pcl::toROSMsg()
+  pcl::toROSMsg(pcl::PointCloud<pcl::PointXYZ>{}, output);
   output.header = input->header;
+  output.height = 1;
+  output.width = num_points;
+  output.row_step = output.point_step * output.width;
+  output.is_dense = is_dense;
+  output.data.resize(output.row_step);
+  auto * data = output.data.data();
+  for (size_t i = 0; i < num_clouds; ++i) {
+    const auto & points = pointcloud_buffer_.at(i).points->points;
+    const size_t size = points.size() * sizeof(pcl::PointXYZ);
+    std::memcpy(data, points.data(), size);
+    data += size;
+  }
 }
 
 rcl_interfaces::msg::SetParametersResult PointcloudAccumulatorComponent::paramCallback(
@@ -64,6 +64,29 @@ void PolygonRemoverComponent::filter(
   }
 }
 
+void PolygonRemoverComponent::faster_filter(
+  const PointCloud2ConstPtr & input, [[maybe_unused]] const IndicesPtr & indices,
+  PointCloud2 & output, const TransformInfo & transform_info)
+{
+  if (!this->polygon_is_initialized_) {
+    RCLCPP_INFO_STREAM(get_logger(), "Polygon is not initialized, publishing incoming cloud.");
+    copyPointsIf(
+      *input, transform_info, output, [](const size_t, const Eigen::Vector4f &) { return true; });
+    return;
+  }
+
+  copyPointsIf(
+    *input, transform_info, output, [this](const size_t, const Eigen::Vector4f & point) {
+      return CGAL::bounded_side_2(
+               polygon_cgal_.begin(), polygon_cgal_.end(), PointCgal(point[0], point[1]), K()) ==
+             CGAL::ON_UNBOUNDED_SIDE;
+    });
+  if (will_visualize_) {
+    marker_.header.frame_id = output.header.frame_id;
+    pub_marker_ptr_->publish(marker_);
+  }
+}
+
 void PolygonRemoverComponent::update_polygon(
   const geometry_msgs::msg::Polygon::ConstSharedPtr & polygon_in)
 {
@@ -19,17 +19,143 @@
 #include <pcl_ros/transforms.hpp>
 
 #include <boost/geometry/algorithms/convex_hull.hpp>
+#include <boost/geometry/algorithms/envelope.hpp>
 #include <boost/geometry/algorithms/intersects.hpp>
 
 #include <lanelet2_core/geometry/Polygon.h>
 #include <tf2_ros/create_timer_ros.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
 #include <memory>
+#include <numeric>
+#include <stdexcept>
 #include <string>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
+namespace
+{
+// Rasterized road lanelets around the pointcloud. A cell that no lanelet edge passes through is
+// entirely inside or entirely outside each lanelet, so only the cells crossed by an edge need the
+// exact point-in-polygon test.
+class LaneletMask
+{
+public:
+  enum class Cell : uint8_t { OUTSIDE, BOUNDARY, INSIDE };
+
+  LaneletMask(const Box2d & area, const double resolution)
+  : origin_x_(area.min_corner().x()),
+    origin_y_(area.min_corner().y()),
+    resolution_(resolution),
+    width_(static_cast<int>(std::floor((area.max_corner().x() - origin_x_) / resolution)) + 1),
+    height_(static_cast<int>(std::floor((area.max_corner().y() - origin_y_) / resolution)) + 1),
+    cells_(static_cast<size_t>(width_) * height_, Cell::OUTSIDE)
+  {
+  }
+
+  void addPolygon(const lanelet::BasicPolygon2d & polygon)
+  {
+    if (polygon.size() < 3) {
+      return;
+    }
+    Box2d envelope;
+    boost::geometry::envelope(polygon, envelope);
+    const int x_min = std::max(toCellX(envelope.min_corner().x()), 0);
+    const int x_max = std::min(toCellX(envelope.max_corner().x()), width_ - 1);
+    const int y_min = std::max(toCellY(envelope.min_corner().y()), 0);
+    const int y_max = std::min(toCellY(envelope.max_corner().y()), height_ - 1);
+    if (x_min > x_max || y_min > y_max) {
+      return;
+    }
+    const int local_width = x_max - x_min + 1;
+    const auto local_index = [&](const int x, const int y) {
+      return static_cast<size_t>(y - y_min) * local_width + (x - x_min);
+    };
+
+    // mark the cells crossed by the edges: the edges are sampled at most one cell apart, so every
+    // cell an edge passes through is a neighbor of the cell of one of its samples
+    std::vector<bool> is_boundary(static_cast<size_t>(local_width) * (y_max - y_min + 1), false);
+    for (size_t i = 0; i < polygon.size(); ++i) {
+      const auto & p0 = polygon.at(i);
+      const auto & p1 = polygon.at((i + 1) % polygon.size());
+      const int num_steps =
+        std::max(static_cast<int>(std::ceil((p1 - p0).norm() / resolution_)), 1);
+      for (int step = 0; step <= num_steps; ++step) {
+        const Eigen::Vector2d p = p0 + (p1 - p0) * (static_cast<double>(step) / num_steps);
+        const int cx = toCellX(p.x());
+        const int cy = toCellY(p.y());
+        for (int y = std::max(cy - 1, y_min); y <= std::min(cy + 1, y_max); ++y) {
+          for (int x = std::max(cx - 1, x_min); x <= std::min(cx + 1, x_max); ++x) {
+            is_boundary.at(local_index(x, y)) = true;
+          }
+        }
+      }
+    }
+
+    // fill the other cells whose center is inside the polygon, row by row
+    std::vector<double> crossings;
+    for (int y = y_min; y <= y_max; ++y) {
+      const double center_y = origin_y_ + (y + 0.5) * resolution_;
+      crossings.clear();
+      for (size_t i = 0; i < polygon.size(); ++i) {
+        const auto & p0 = polygon.at(i);
+        const auto & p1 = polygon.at((i + 1) % polygon.size());
+        if ((p0.y() > center_y) != (p1.y() > center_y)) {
+          crossings.push_back(p0.x() + (center_y - p0.y()) * (p1.x() - p0.x()) / (p1.y() - p0.y()));
+        }
+      }
+      std::sort(crossings.begin(), crossings.end());
+      for (size_t i = 0; i + 1 < crossings.size(); i += 2) {
+        const int begin = std::max(toCellX(crossings.at(i) - 0.5 * resolution_) + 1, x_min);
+        const int end = std::min(toCellX(crossings.at(i + 1) - 0.5 * resolution_), x_max);
+        for (int x = begin; x <= end; ++x) {
+          if (!is_boundary.at(local_index(x, y))) {
+            at(x, y) = Cell::INSIDE;
+          }
+        }
+      }
+      for (int x = x_min; x <= x_max; ++x) {
+        if (is_boundary.at(local_index(x, y)) && at(x, y) == Cell::OUTSIDE) {
+          at(x, y) = Cell::BOUNDARY;
+        }
+      }
+    }
+  }
+
+  Cell getCell(const double x, const double y) const
+  {
+    const int cx = toCellX(x);
+    const int cy = toCellY(y);
+    if (cx < 0 || cx >= width_ || cy < 0 || cy >= height_) {
+      return Cell::OUTSIDE;
+    }
+    return cells_.at(static_cast<size_t>(cy) * width_ + cx);
+  }
+
+private:
+  int toCellX(const double x) const
+  {
+    return static_cast<int>(std::floor((x - origin_x_) / resolution_));
+  }
+  int toCellY(const double y) const
+  {
+    return static_cast<int>(std::floor((y - origin_y_) / resolution_));
+  }
+  Cell & at(const int x, const int y) { return cells_.at(static_cast<size_t>(y) * width_ + x); }
+
+  double origin_x_;
+  double origin_y_;
+  double resolution_;
+  int width_;
+  int height_;
+  std::vector<Cell> cells_;
+};
+}  // namespace
+
 namespace pointcloud_preprocessor
 {
 Lanelet2MapFilterComponent::Lanelet2MapFilterComponent(const rclcpp::NodeOptions & node_options)
@@ -41,6 +167,10 @@ Lanelet2MapFilterComponent::Lanelet2MapFilterComponent(const rclcpp::NodeOptions
   {
     voxel_size_x_ = declare_parameter("voxel_size_x", 0.04);
     voxel_size_y_ = declare_parameter("voxel_size_y", 0.04);
+    mask_resolution_ = declare_parameter("mask_resolution", 0.5);
+    if (!(mask_resolution_ > 0.0)) {
+      throw std::invalid_argument("mask_resolution must be positive");
+    }
   }
 
   // Set publisher
@@ -79,6 +209,19 @@ Lanelet2MapFilterComponent::Lanelet2MapFilterComponent(const rclcpp::NodeOptions
 rcl_interfaces::msg::SetParametersResult Lanelet2MapFilterComponent::paramCallback(
   const std::vector<rclcpp::Parameter> & p)
 {
+  rcl_interfaces::msg::SetParametersResult result;
+
+  double mask_resolution;
+  if (get_param(p, "mask_resolution", mask_resolution)) {
+    if (!(mask_resolution > 0.0)) {
+      result.successful = false;
+      result.reason = "mask_resolution must be positive";
+      return result;
+    }
+    mask_resolution_ = mask_resolution;
+    RCLCPP_DEBUG(get_logger(), "Setting mask_resolution to: %f.", mask_resolution_);
+  }
+
   if (get_param(p, "voxel_size_x", voxel_size_x_)) {
     RCLCPP_DEBUG(get_logger(), "Setting voxel_size_x to: %f.", voxel_size_x_);
   }
@@ -87,7 +230,6 @@ rcl_interfaces::msg::SetParametersResult Lanelet2MapFilterComponent::paramCallba
     RCLCPP_DEBUG(get_logger(), "Setting voxel_size_y to: %f.", voxel_size_y_);
   }
 
-  rcl_interfaces::msg::SetParametersResult result;
   result.successful = true;
   result.reason = "success";
 
@@ -141,23 +283,35 @@ LinearRing2d Lanelet2MapFilterComponent::getConvexHull(
   return convex_hull;
 }
 
-lanelet::ConstLanelets Lanelet2MapFilterComponent::getIntersectedLanelets(
-  const LinearRing2d & convex_hull, const lanelet::ConstLanelets & road_lanelets)
+std::vector<size_t> Lanelet2MapFilterComponent::getIntersectedLanelets(
+  const LinearRing2d & convex_hull)
 {
-  lanelet::ConstLanelets intersected_lanelets;
-  for (const auto & road_lanelet : road_lanelets) {
-    if (boost::geometry::intersects(convex_hull, road_lanelet.polygon2d().basicPolygon())) {
-      intersected_lanelets.push_back(road_lanelet);
+  Box2d envelope;
+  boost::geometry::envelope(convex_hull, envelope);
+  std::vector<std::pair<Box2d, size_t>> candidates;
+  road_polygons_rtree_.query(
+    boost::geometry::index::intersects(envelope), std::back_inserter(candidates));
+
+  std::vector<size_t> intersected_lanelets;
+  for (const auto & candidate : candidates) {
+    if (boost::geometry::intersects(convex_hull, road_polygons_.at(candidate.second))) {
+      intersected_lanelets.push_back(candidate.second);
     }
   }
+  std::sort(intersected_lanelets.begin(), intersected_lanelets.end());
   return intersected_lanelets;
 }
 
 bool Lanelet2MapFilterComponent::pointWithinLanelets(
-  const Point2d & point, const lanelet::ConstLanelets & intersected_lanelets)
+  const Point2d & point, const std::vector<bool> & is_intersected)
 {
-  for (const auto & lanelet : intersected_lanelets) {
-    if (boost::geometry::within(point, lanelet.polygon2d().basicPolygon())) {
+  std::vector<std::pair<Box2d, size_t>> candidates;
+  road_polygons_rtree_.query(
+    boost::geometry::index::intersects(point), std::back_inserter(candidates));
+  for (const auto & candidate : candidates) {
+    if (
+      is_intersected.at(candidate.second) &&
+      boost::geometry::within(point, road_polygons_.at(candidate.second))) {
       return true;
     }
   }
@@ -165,7 +319,7 @@ bool Lanelet2MapFilterComponent::pointWithinLanelets(
 }
 
 pcl::PointCloud<pcl::PointXYZ> Lanelet2MapFilterComponent::getLaneFilteredPointCloud(
-  const lanelet::ConstLanelets & intersected_lanelets,
+  const std::vector<size_t> & intersected_lanelets,
   const pcl::PointCloud<pcl::PointXYZ>::Ptr & cloud)
 {
   pcl::PointCloud<pcl::PointXYZ> filtered_cloud;
@@ -190,28 +344,71 @@ pcl::PointCloud<pcl::PointXYZ> Lanelet2MapFilterComponent::getLaneFilteredPointC
   voxel_grid.setInputCloud(centralized_cloud);
   voxel_grid.setSaveLeafLayout(true);
   voxel_grid.filter(*downsampled_cloud);
+  if (downsampled_cloud->points.empty()) {
+    return filtered_cloud;
+  }
 
-  std::unordered_map<size_t, pcl::PointCloud<pcl::PointXYZ>> downsampled2original_map;
-  for (const auto & p : centralized_cloud->points) {
+  // group the original points by voxel with a counting sort: the points of the i-th voxel are
+  // voxel_points[voxel_offsets[i]] to voxel_points[voxel_offsets[i + 1] - 1] in input order
+  std::vector<int> voxel_indices(centralized_cloud->points.size(), -1);
+  std::vector<size_t> voxel_offsets(downsampled_cloud->points.size() + 1, 0);
+  for (size_t i = 0; i < centralized_cloud->points.size(); ++i) {
+    const auto & p = centralized_cloud->points[i];
     if (std::isnan(p.x) || std::isnan(p.y) || std::isnan(p.z)) {
       continue;
     }
-    const size_t index = voxel_grid.getCentroidIndex(p);
-    downsampled2original_map[index].points.push_back(p);
+    const int index = voxel_grid.getCentroidIndex(p);
+    if (index < 0) {
+      continue;
+    }
+    voxel_indices[i] = index;
+    ++voxel_offsets[index + 1];
+  }
+  std::partial_sum(voxel_offsets.begin(), voxel_offsets.end(), voxel_offsets.begin());
+  std::vector<size_t> voxel_points(voxel_offsets.back());
+  {
+    std::vector<size_t> next_slots(voxel_offsets.begin(), voxel_offsets.end() - 1);
+    for (size_t i = 0; i < voxel_indices.size(); ++i) {
+      if (voxel_indices[i] >= 0) {
+        voxel_points[next_slots[voxel_indices[i]]++] = i;
+      }
+    }
   }
 
-  for (auto & point : downsampled_cloud->points) {
-    if (pointWithinLanelets(
-          Point2d(point.x + centroid[0], point.y + centroid[1]), intersected_lanelets)) {
-      const size_t index = voxel_grid.getCentroidIndex(point);
-      for (auto & original_point : downsampled2original_map[index].points) {
-        original_point.x += centroid[0];
-        original_point.y += centroid[1];
-        original_point.z += centroid[2];
-        filtered_cloud.points.push_back(original_point);
+  // rasterize the intersected lanelets over the area of the downsampled points
+  Box2d area{
+    Point2d(std::numeric_limits<double>::max(), std::numeric_limits<double>::max()),
+    Point2d(std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest())};
+  for (const auto & p : downsampled_cloud->points) {
+    const double x = p.x + centroid[0];
+    const double y = p.y + centroid[1];
+    area.min_corner().x(std::min(area.min_corner().x(), x));
+    area.min_corner().y(std::min(area.min_corner().y(), y));
+    area.max_corner().x(std::max(area.max_corner().x(), x));
+    area.max_corner().y(std::max(area.max_corner().y(), y));
+  }
+  LaneletMask mask(area, mask_resolution_);
+  std::vector<bool> is_intersected(road_polygons_.size(), false);
+  for (const auto index : intersected_lanelets) {
+    mask.addPolygon(road_polygons_.at(index));
+    is_intersected.at(index) = true;
+  }
+
+  filtered_cloud.points.reserve(voxel_points.size());
+  for (size_t i = 0; i < downsampled_cloud->points.size(); ++i) {
+    const auto & point = downsampled_cloud->points[i];
+    const Point2d point2d(point.x + centroid[0], point.y + centroid[1]);
+    const auto cell = mask.getCell(point2d.x(), point2d.y());
+    if (
+      cell == LaneletMask::Cell::INSIDE ||
+      (cell == LaneletMask::Cell::BOUNDARY && pointWithinLanelets(point2d, is_intersected))) {
+      for (size_t j = voxel_offsets[i]; j < voxel_offsets[i + 1]; ++j) {
+        filtered_cloud.points.push_back(cloud->points[voxel_points[j]]);
       }
     }
   }
+  filtered_cloud.width = filtered_cloud.points.size();
+  filtered_cloud.height = 1;
 
   return filtered_cloud;
 }
@@ -239,7 +436,7 @@ void Lanelet2MapFilterComponent::pointcloudCallback(const PointCloud2ConstPtr cl
   // calculate convex hull
   const auto convex_hull = getConvexHull(cloud);
   // get intersected lanelets
-  lanelet::ConstLanelets intersected_lanelets = getIntersectedLanelets(convex_hull, road_lanelets_);
+  const auto intersected_lanelets = getIntersectedLanelets(convex_hull);
   // filter pointcloud by lanelet
   const auto filtered_cloud = getLaneFilteredPointCloud(intersected_lanelets, cloud);
   // transform pointcloud to input frame
@@ -265,6 +462,16 @@ void Lanelet2MapFilterComponent::mapCallback(
   lanelet::utils::conversion::fromBinMsg(*map_msg, lanelet_map_ptr_);
   const lanelet::ConstLanelets all_lanelets = lanelet::utils::query::laneletLayer(lanelet_map_ptr_);
   road_lanelets_ = lanelet::utils::query::roadLanelets(all_lanelets);
+
+  road_polygons_.clear();
+  std::vector<std::pair<Box2d, size_t>> envelopes;
+  for (const auto & road_lanelet : road_lanelets_) {
+    road_polygons_.push_back(road_lanelet.polygon2d().basicPolygon());
+    Box2d envelope;
+    boost::geometry::envelope(road_polygons_.back(), envelope);
+    envelopes.emplace_back(envelope, road_polygons_.size() - 1);
+  }
+  road_polygons_rtree_ = decltype(road_polygons_rtree_)(envelopes);
 }
 
 }  // namespace pointcloud_preprocessor
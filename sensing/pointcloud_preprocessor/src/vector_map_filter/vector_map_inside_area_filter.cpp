@@ -103,6 +103,49 @@ void VectorMapInsideAreaFilterComponent::filter(
   output.header = input->header;
 }
 
+void VectorMapInsideAreaFilterComponent::faster_filter(
+  const PointCloud2ConstPtr & input, [[maybe_unused]] const IndicesPtr & indices,
+  PointCloud2 & output, const TransformInfo & transform_info)
+{
+  if (polygon_lanelets_.empty()) {
+    copyPointsIf(
+      *input, transform_info, output, [](const size_t, const Eigen::Vector4f &) { return true; });
+    return;
+  }
+
+  // calculate bounding box of points
+  MultiPoint2d candidate_points;
+  candidate_points.reserve(input->width * input->height);
+  for (sensor_msgs::PointCloud2ConstIterator<float> iter_x(*input, "x"), iter_y(*input, "y"),
+       iter_z(*input, "z");
+       iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
+    Eigen::Vector4f point(*iter_x, *iter_y, *iter_z, 1);
+    if (transform_info.need_transform && point.allFinite()) {
+      point = transform_info.eigen_transform * point;
+    }
+    candidate_points.emplace_back(point[0], point[1]);
+  }
+  const auto bounding_box =
+    boost::geometry::return_envelope<tier4_autoware_utils::Box2d>(candidate_points);
+
+  // use only intersected lanelets to reduce calculation cost
+  const auto intersected_lanelets = calcIntersectedPolygons(bounding_box, polygon_lanelets_);
+  std::vector<PolygonCgal> cgal_polys;
+  for (const auto & polygon : intersected_lanelets) {
+    PolygonCgal cgal_poly;
+    pointcloud_preprocessor::utils::to_cgal_polygon(
+      lanelet::utils::to2D(polygon).basicPolygon(), cgal_poly);
+    cgal_polys.emplace_back(cgal_poly);
+  }
+
+  // filter pointcloud by lanelet
+  copyPointsIf(
+    *input, transform_info, output, [&cgal_polys](const size_t, const Eigen::Vector4f & point) {
+      return !pointcloud_preprocessor::utils::point_within_cgal_polys(
+        pcl::PointXYZ(point[0], point[1], point[2]), cgal_polys);
+    });
+}
+
 void VectorMapInsideAreaFilterComponent::mapCallback(
   const autoware_auto_mapping_msgs::msg::HADMapBin::ConstSharedPtr map_msg)
 {
@@ -0,0 +1,91 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RADAR_PREPROCESSOR__RADAR_PREPROCESSOR_NODE_HPP_
+#define RADAR_PREPROCESSOR__RADAR_PREPROCESSOR_NODE_HPP_
+
+#include "radar_preprocessor/radar_utils.hpp"
+#include "tier4_autoware_utils/tier4_autoware_utils.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <nav_msgs/msg/odometry.hpp>
+#include <radar_msgs/msg/radar_scan.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <message_filters/subscriber.h>
+#include <message_filters/sync_policies/approximate_time.h>
+#include <message_filters/synchronizer.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace radar_preprocessor
+{
+using nav_msgs::msg::Odometry;
+using radar_msgs::msg::RadarReturn;
+using radar_msgs::msg::RadarScan;
+using sensor_msgs::msg::PointCloud2;
+
+// radar_threshold_filter, radar_static_pointcloud_filter and radar_scan_to_pointcloud2 applied in a
+// single pass over each RadarScan, without passing the intermediate scans between nodes
+class RadarPreprocessorNode : public rclcpp::Node
+{
+public:
+  explicit RadarPreprocessorNode(const rclcpp::NodeOptions & node_options);
+
+  struct NodeParam : public ThresholdParam
+  {
+    double doppler_velocity_sd{};
+    bool publish_amplitude_pointcloud{};
+    bool publish_doppler_pointcloud{};
+  };
+
+private:
+  // Subscriber
+  message_filters::Subscriber<RadarScan> sub_radar_{};
+  message_filters::Subscriber<Odometry> sub_odometry_{};
+  std::shared_ptr<tier4_autoware_utils::TransformListener> transform_listener_;
+
+  using SyncPolicy = message_filters::sync_policies::ApproximateTime<RadarScan, Odometry>;
+  using Sync = message_filters::Synchronizer<SyncPolicy>;
+  typename std::shared_ptr<Sync> sync_ptr_;
+
+  // Callback
+  void onData(const RadarScan::ConstSharedPtr radar_msg, const Odometry::ConstSharedPtr odom_msg);
+
+  // Publisher
+  rclcpp::Publisher<RadarScan>::SharedPtr pub_static_radar_{};
+  rclcpp::Publisher<RadarScan>::SharedPtr pub_dynamic_radar_{};
+  rclcpp::Publisher<PointCloud2>::SharedPtr pub_amplitude_pointcloud_{};
+  rclcpp::Publisher<PointCloud2>::SharedPtr pub_doppler_pointcloud_{};
+
+  // Parameter Server
+  OnSetParametersCallbackHandle::SharedPtr set_param_res_;
+  rcl_interfaces::msg::SetParametersResult onSetParam(
+    const std::vector<rclcpp::Parameter> & params);
+
+  // Parameter
+  NodeParam node_param_{};
+
+  // Output buffers, their capacity is kept from one scan to the next
+  RadarScan static_radar_{};
+  RadarScan dynamic_radar_{};
+  PointCloud2 amplitude_pointcloud_{};
+  PointCloud2 doppler_pointcloud_{};
+};
+}  // namespace radar_preprocessor
+
+#endif  // RADAR_PREPROCESSOR__RADAR_PREPROCESSOR_NODE_HPP_
@@ -0,0 +1,67 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RADAR_PREPROCESSOR__RADAR_UTILS_HPP_
+#define RADAR_PREPROCESSOR__RADAR_UTILS_HPP_
+
+#include <geometry_msgs/msg/vector3.hpp>
+#include <radar_msgs/msg/radar_return.hpp>
+
+#include <pcl/point_types.h>
+#include <tf2/LinearMath/Matrix3x3.h>
+
+namespace radar_preprocessor
+{
+// processing of a radar return shared by radar_threshold_filter, radar_static_pointcloud_filter,
+// radar_scan_to_pointcloud2 and radar_preprocessor
+
+struct ThresholdParam
+{
+  bool is_amplitude_filter{};
+  double amplitude_min{};
+  double amplitude_max{};
+  bool is_range_filter{};
+  double range_min{};
+  double range_max{};
+  bool is_azimuth_filter{};
+  double azimuth_min{};
+  double azimuth_max{};
+  bool is_z_filter{};
+  double z_min{};
+  double z_max{};
+};
+
+/**
+ * @brief return true if the return is strictly inside the limits of every enabled filter
+ */
+bool isWithinThreshold(
+  const radar_msgs::msg::RadarReturn & radar_return, const ThresholdParam & param);
+
+/**
+ * @brief return true if the doppler velocity compensated by the ego velocity is lower than
+ *        doppler_velocity_sd in x
+ * @param rotation rotation from the radar frame to the frame of the ego velocity
+ */
+bool isStaticReturn(
+  const radar_msgs::msg::RadarReturn & radar_return, const tf2::Matrix3x3 & rotation,
+  const geometry_msgs::msg::Vector3 & ego_velocity, const double doppler_velocity_sd);
+
+/**
+ * @brief convert the return to a point of the radar frame with the given intensity
+ */
+pcl::PointXYZI getPointXYZI(
+  const radar_msgs::msg::RadarReturn & radar_return, const float intensity);
+}  // namespace radar_preprocessor
+
+#endif  // RADAR_PREPROCESSOR__RADAR_UTILS_HPP_
@@ -0,0 +1,236 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "radar_preprocessor/radar_preprocessor_node.hpp"
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#include <pcl_conversions/pcl_conversions.h>
+#include <tf2/LinearMath/Matrix3x3.h>
+#include <tf2/LinearMath/Quaternion.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+template <class T>
+bool update_param(
+  const std::vector<rclcpp::Parameter> & params, const std::string & name, T & value)
+{
+  const auto itr = std::find_if(
+    params.cbegin(), params.cend(),
+    [&name](const rclcpp::Parameter & p) { return p.get_name() == name; });
+
+  // Not found
+  if (itr == params.cend()) {
+    return false;
+  }
+
+  value = itr->template get_value<T>();
+  return true;
+}
+
+template <class PublisherT>
+bool hasSubscriber(const PublisherT & publisher)
+{
+  return publisher->get_subscription_count() > 0 ||
+         publisher->get_intra_process_subscription_count() > 0;
+}
+
+void setPoint(
+  const size_t index, const pcl::PointXYZI & point, sensor_msgs::msg::PointCloud2 & pointcloud)
+{
+  std::memcpy(&pointcloud.data[index * pointcloud.point_step], &point, sizeof(pcl::PointXYZI));
+}
+
+void resizePointcloud(const size_t num_points, sensor_msgs::msg::PointCloud2 & pointcloud)
+{
+  pointcloud.width = num_points;
+  pointcloud.height = 1;
+  pointcloud.row_step = num_points * pointcloud.point_step;
+  pointcloud.data.resize(pointcloud.row_step);
+}
+}  // namespace
+
+namespace radar_preprocessor
+{
+RadarPreprocessorNode::RadarPreprocessorNode(const rclcpp::NodeOptions & node_options)
+: Node("radar_preprocessor", node_options)
+{
+  using std::placeholders::_1;
+  using std::placeholders::_2;
+
+  // Parameter Server
+  set_param_res_ = this->add_on_set_parameters_callback(
+    std::bind(&RadarPreprocessorNode::onSetParam, this, _1));
+
+  // Node Parameter
+  node_param_.is_amplitude_filter =
+    declare_parameter<bool>("node_params.is_amplitude_filter", false);
+  node_param_.amplitude_min = declare_parameter<double>("node_params.amplitude_min", 0.0);
+  node_param_.amplitude_max = declare_parameter<double>("node_params.amplitude_max", 0.0);
+  node_param_.is_range_filter = declare_parameter<bool>("node_params.is_range_filter", false);
+  node_param_.range_min = declare_parameter<double>("node_params.range_min", 0.0);
+  node_param_.range_max = declare_parameter<double>("node_params.range_max", 0.0);
+  node_param_.is_azimuth_filter = declare_parameter<bool>("node_params.is_azimuth_filter", false);
+  node_param_.azimuth_min = declare_parameter<double>("node_params.azimuth_min", 0.0);
+  node_param_.azimuth_max = declare_parameter<double>("node_params.azimuth_max", 0.0);
+  node_param_.is_z_filter = declare_parameter<bool>("node_params.is_z_filter", false);
+  node_param_.z_min = declare_parameter<double>("node_params.z_min", 0.0);
+  node_param_.z_max = declare_parameter<double>("node_params.z_max", 0.0);
+  node_param_.doppler_velocity_sd =
+    declare_parameter<double>("node_params.doppler_velocity_sd", 2.0);
+  node_param_.publish_amplitude_pointcloud =
+    declare_parameter<bool>("node_params.publish_amplitude_pointcloud", true);
+  node_param_.publish_doppler_pointcloud =
+    declare_parameter<bool>("node_params.publish_doppler_pointcloud", false);
+
+  // Subscriber
+  transform_listener_ = std::make_shared<tier4_autoware_utils::TransformListener>(this);
+
+  sub_radar_.subscribe(this, "~/input/radar", rclcpp::QoS{1}.get_rmw_qos_profile());
+  sub_odometry_.subscribe(this, "~/input/odometry", rclcpp::QoS{1}.get_rmw_qos_profile());
+
+  sync_ptr_ = std::make_shared<Sync>(SyncPolicy(10), sub_radar_, sub_odometry_);
+  sync_ptr_->registerCallback(std::bind(&RadarPreprocessorNode::onData, this, _1, _2));
+
+  // Publisher
+  pub_static_radar_ = create_publisher<RadarScan>("~/output/static_radar_scan", 1);
+  pub_dynamic_radar_ = create_publisher<RadarScan>("~/output/dynamic_radar_scan", 1);
+  pub_amplitude_pointcloud_ = create_publisher<PointCloud2>("~/output/amplitude_pointcloud", 1);
+  pub_doppler_pointcloud_ = create_publisher<PointCloud2>("~/output/doppler_pointcloud", 1);
+
+  // The point layout is the one of radar_scan_to_pointcloud2, set once
+  pcl::toROSMsg(pcl::PointCloud<pcl::PointXYZI>{}, amplitude_pointcloud_);
+  pcl::toROSMsg(pcl::PointCloud<pcl::PointXYZI>{}, doppler_pointcloud_);
+}
+
+rcl_interfaces::msg::SetParametersResult RadarPreprocessorNode::onSetParam(
+  const std::vector<rclcpp::Parameter> & params)
+{
+  rcl_interfaces::msg::SetParametersResult result;
+  try {
+    {
+      auto & p = node_param_;
+      update_param(params, "node_params.is_amplitude_filter", p.is_amplitude_filter);
+      update_param(params, "node_params.amplitude_min", p.amplitude_min);
+      update_param(params, "node_params.amplitude_max", p.amplitude_max);
+      update_param(params, "node_params.is_range_filter", p.is_range_filter);
+      update_param(params, "node_params.range_min", p.range_min);
+      update_param(params, "node_params.range_max", p.range_max);
+      update_param(params, "node_params.is_azimuth_filter", p.is_azimuth_filter);
+      update_param(params, "node_params.azimuth_min", p.azimuth_min);
+      update_param(params, "node_params.azimuth_max", p.azimuth_max);
+      update_param(params, "node_params.is_z_filter", p.is_z_filter);
+      update_param(params, "node_params.z_min", p.z_min);
+      update_param(params, "node_params.z_max", p.z_max);
+      update_param(params, "node_params.doppler_velocity_sd", p.doppler_velocity_sd);
+      update_param(
+        params, "node_params.publish_amplitude_pointcloud", p.publish_amplitude_pointcloud);
+      update_param(params, "node_params.publish_doppler_pointcloud", p.publish_doppler_pointcloud);
+    }
+  } catch (const rclcpp::exceptions::InvalidParameterTypeException & e) {
+    result.successful = false;
+    result.reason = e.what();
+    return result;
+  }
+  result.successful = true;
+  result.reason = "success";
+  return result;
+}
+
+void RadarPreprocessorNode::onData(
+  const RadarScan::ConstSharedPtr radar_msg, const Odometry::ConstSharedPtr odom_msg)
+{
+  geometry_msgs::msg::TransformStamped::ConstSharedPtr transform;
+
+  try {
+    transform = transform_listener_->getTransform(
+      odom_msg->header.frame_id, radar_msg->header.frame_id, odom_msg->header.stamp,
+      rclcpp::Duration::from_seconds(0.2));
+  } catch (tf2::TransformException & ex) {
+    RCLCPP_INFO(this->get_logger(), "Could not transform");
+    return;
+  }
+
+  // The rotation of the doppler velocity and the ego velocity are the same for all the returns
+  const auto & q = transform->transform.rotation;
+  const tf2::Matrix3x3 rotation(tf2::Quaternion(q.x, q.y, q.z, q.w));
+  const auto & ego_velocity = odom_msg->twist.twist.linear;
+
+  const bool publish_static = hasSubscriber(pub_static_radar_);
+  const bool publish_dynamic = hasSubscriber(pub_dynamic_radar_);
+  const bool publish_amplitude = node_param_.publish_amplitude_pointcloud;
+  const bool publish_doppler = node_param_.publish_doppler_pointcloud;
+
+  static_radar_.header = radar_msg->header;
+  dynamic_radar_.header = radar_msg->header;
+  static_radar_.returns.clear();
+  dynamic_radar_.returns.clear();
+  resizePointcloud(publish_amplitude ? radar_msg->returns.size() : 0, amplitude_pointcloud_);
+  resizePointcloud(publish_doppler ? radar_msg->returns.size() : 0, doppler_pointcloud_);
+
+  size_t num_points = 0;
+  for (const auto & radar_return : radar_msg->returns) {
+    if (!isWithinThreshold(radar_return, node_param_)) {
+      continue;
+    }
+
+    if (publish_static || publish_dynamic) {
+      const bool is_static =
+        isStaticReturn(radar_return, rotation, ego_velocity, node_param_.doppler_velocity_sd);
+      if (is_static && publish_static) {
+        static_radar_.returns.push_back(radar_return);
+      } else if (!is_static && publish_dynamic) {
+        dynamic_radar_.returns.push_back(radar_return);
+      }
+    }
+
+    if (publish_amplitude) {
+      setPoint(
+        num_points, getPointXYZI(radar_return, radar_return.amplitude), amplitude_pointcloud_);
+    }
+    if (publish_doppler) {
+      setPoint(
+        num_points, getPointXYZI(radar_return, radar_return.doppler_velocity), doppler_pointcloud_);
+    }
+    ++num_points;
+  }
+
+  if (publish_static) {
+    pub_static_radar_->publish(static_radar_);
+  }
+  if (publish_dynamic) {
+    pub_dynamic_radar_->publish(dynamic_radar_);
+  }
+  if (publish_amplitude) {
+    resizePointcloud(num_points, amplitude_pointcloud_);
+    amplitude_pointcloud_.header = radar_msg->header;
+    pub_amplitude_pointcloud_->publish(amplitude_pointcloud_);
+  }
+  if (publish_doppler) {
+    resizePointcloud(num_points, doppler_pointcloud_);
+    doppler_pointcloud_.header = radar_msg->header;
+    pub_doppler_pointcloud_->publish(doppler_pointcloud_);
+  }
+}
+
+}  // namespace radar_preprocessor
+
+#include "rclcpp_components/register_node_macro.hpp"
+RCLCPP_COMPONENTS_REGISTER_NODE(radar_preprocessor::RadarPreprocessorNode)
@@ -0,0 +1,79 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "radar_preprocessor/radar_utils.hpp"
+
+#include <tf2/LinearMath/Vector3.h>
+
+#include <cmath>
+
+namespace
+{
+bool isWithin(double value, double max, double min) { return min < value && value < max; }
+}  // namespace
+
+namespace radar_preprocessor
+{
+bool isWithinThreshold(
+  const radar_msgs::msg::RadarReturn & radar_return, const ThresholdParam & param)
+{
+  if (
+    param.is_amplitude_filter &&
+    !isWithin(radar_return.amplitude, param.amplitude_max, param.amplitude_min)) {
+    return false;
+  }
+
+  if (param.is_range_filter && !isWithin(radar_return.range, param.range_max, param.range_min)) {
+    return false;
+  }
+
+  if (
+    param.is_azimuth_filter &&
+    !isWithin(radar_return.azimuth, param.azimuth_max, param.azimuth_min)) {
+    return false;
+  }
+
+  if (param.is_z_filter) {
+    const auto z = radar_return.range * std::sin(radar_return.elevation);
+    if (!isWithin(z, param.z_max, param.z_min)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool isStaticReturn(
+  const radar_msgs::msg::RadarReturn & radar_return, const tf2::Matrix3x3 & rotation,
+  const geometry_msgs::msg::Vector3 & ego_velocity, const double doppler_velocity_sd)
+{
+  const tf2::Vector3 radar_velocity(
+    radar_return.doppler_velocity * std::cos(radar_return.azimuth),
+    radar_return.doppler_velocity * std::sin(radar_return.azimuth), 0.0);
+  const double compensated_velocity_x = (rotation * radar_velocity).x() + ego_velocity.x;
+  return (-doppler_velocity_sd < compensated_velocity_x) &&
+         (compensated_velocity_x < doppler_velocity_sd);
+}
+
+pcl::PointXYZI getPointXYZI(
+  const radar_msgs::msg::RadarReturn & radar_return, const float intensity)
+{
+  pcl::PointXYZI point;
+  const float r_xy = radar_return.range * std::cos(radar_return.elevation);
+  point.x = r_xy * std::cos(radar_return.azimuth);
+  point.y = r_xy * std::sin(radar_return.azimuth);
+  point.z = radar_return.range * std::sin(radar_return.elevation);
+  point.intensity = intensity;
+  return point;
+}
+}  // namespace radar_preprocessor
@@ -0,0 +1,121 @@
+// Copyright 2023 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "radar_preprocessor/radar_utils.hpp"
+
+#include <gtest/gtest.h>
+#include <tf2/LinearMath/Quaternion.h>
+
+#include <cmath>
+
+using radar_msgs::msg::RadarReturn;
+using radar_preprocessor::ThresholdParam;
+
+namespace
+{
+RadarReturn createRadarReturn(
+  const float range, const float azimuth, const float elevation, const float doppler_velocity,
+  const float amplitude)
+{
+  RadarReturn radar_return;
+  radar_return.range = range;
+  radar_return.azimuth = azimuth;
+  radar_return.elevation = elevation;
+  radar_return.doppler_velocity = doppler_velocity;
+  radar_return.amplitude = amplitude;
+  return radar_return;
+}
+
+geometry_msgs::msg::Vector3 createVelocity(const double x)
+{
+  geometry_msgs::msg::Vector3 velocity;
+  velocity.x = x;
+  return velocity;
+}
+}  // namespace
+
+TEST(RadarUtils, isWithinThreshold)
+{
+  const auto radar_return = createRadarReturn(10.0F, 0.2F, 0.1F, 1.0F, 20.0F);
+
+  // no filter
+  ThresholdParam param;
+  EXPECT_TRUE(radar_preprocessor::isWithinThreshold(radar_return, param));
+
+  param.is_amplitude_filter = true;
+  param.amplitude_min = 10.0;
+  param.amplitude_max = 30.0;
+  EXPECT_TRUE(radar_preprocessor::isWithinThreshold(radar_return, param));
+  // the limits are excluded
+  param.amplitude_min = 20.0;
+  EXPECT_FALSE(radar_preprocessor::isWithinThreshold(radar_return, param));
+  param.amplitude_min = 10.0;
+
+  param.is_range_filter = true;
+  param.range_min = 0.0;
+  param.range_max = 5.0;
+  EXPECT_FALSE(radar_preprocessor::isWithinThreshold(radar_return, param));
+  param.range_max = 50.0;
+  EXPECT_TRUE(radar_preprocessor::isWithinThreshold(radar_return, param));
+
+  param.is_azimuth_filter = true;
+  param.azimuth_min = -0.1;
+  param.azimuth_max = 0.1;
+  EXPECT_FALSE(radar_preprocessor::isWithinThreshold(radar_return, param));
+  param.azimuth_max = 0.3;
+  EXPECT_TRUE(radar_preprocessor::isWithinThreshold(radar_return, param));
+
+  // z = 10 sin(0.1) ~= 0.998
+  param.is_z_filter = true;
+  param.z_min = 1.0;
+  param.z_max = 2.0;
+  EXPECT_FALSE(radar_preprocessor::isWithinThreshold(radar_return, param));
+  param.z_min = 0.9;
+  EXPECT_TRUE(radar_preprocessor::isWithinThreshold(radar_return, param));
+}
+
+TEST(RadarUtils, isStaticReturn)
+{
+  const tf2::Matrix3x3 identity(tf2::Quaternion::getIdentity());
+
+  // an object ahead at rest approaches the ego vehicle at the ego velocity
+  const auto ahead = createRadarReturn(10.0F, 0.0F, 0.0F, -5.0F, 20.0F);
+  EXPECT_TRUE(radar_preprocessor::isStaticReturn(ahead, identity, createVelocity(5.0), 1.0));
+  EXPECT_FALSE(radar_preprocessor::isStaticReturn(ahead, identity, createVelocity(0.0), 1.0));
+  EXPECT_TRUE(radar_preprocessor::isStaticReturn(ahead, identity, createVelocity(0.0), 6.0));
+
+  // the x of the doppler velocity is cos(azimuth) of it
+  const auto side = createRadarReturn(10.0F, M_PI / 3.0, 0.0F, -5.0F, 20.0F);
+  EXPECT_TRUE(radar_preprocessor::isStaticReturn(side, identity, createVelocity(2.5), 0.1));
+
+  // the doppler velocity of a radar looking backward is rotated into the ego frame
+  tf2::Quaternion backward;
+  backward.setRPY(0.0, 0.0, M_PI);
+  const tf2::Matrix3x3 rotation(backward);
+  const auto behind = createRadarReturn(10.0F, 0.0F, 0.0F, 5.0F, 20.0F);
+  EXPECT_TRUE(radar_preprocessor::isStaticReturn(behind, rotation, createVelocity(5.0), 1.0));
+  EXPECT_FALSE(radar_preprocessor::isStaticReturn(behind, identity, createVelocity(5.0), 1.0));
+}
+
+TEST(RadarUtils, getPointXYZI)
+{
+  const auto radar_return = createRadarReturn(10.0F, M_PI / 6.0, M_PI / 4.0, -2.0F, 20.0F);
+  const auto point = radar_preprocessor::getPointXYZI(radar_return, radar_return.amplitude);
+  const float r_xy = 10.0F * std::cos(M_PI / 4.0);
+  EXPECT_NEAR(point.x, r_xy * std::cos(M_PI / 6.0), 1e-5);
+  EXPECT_NEAR(point.y, r_xy * std::sin(M_PI / 6.0), 1e-5);
+  EXPECT_NEAR(point.z, 10.0F * std::sin(M_PI / 4.0), 1e-5);
+  EXPECT_FLOAT_EQ(point.intensity, 20.0F);
+  EXPECT_NEAR(std::hypot(point.x, point.y, point.z), 10.0F, 1e-5);
+}
@@ -14,6 +14,8 @@
 
 #include "radar_scan_to_pointcloud2/radar_scan_to_pointcloud2_node.hpp"
 
+#include <radar_preprocessor/radar_utils.hpp>
+
 #include <pcl/pcl_base.h>
 #include <pcl/point_cloud.h>
 #include <pcl/point_types.h>
@@ -39,22 +41,11 @@ bool update_param(
   return true;
 }
 
-pcl::PointXYZI getPointXYZI(const radar_msgs::msg::RadarReturn & radar, float intensity)
-{
-  pcl::PointXYZI point;
-  const float r_xy = radar.range * std::cos(radar.elevation);
-  point.x = r_xy * std::cos(radar.azimuth);
-  point.y = r_xy * std::sin(radar.azimuth);
-  point.z = radar.range * std::sin(radar.elevation);
-  point.intensity = intensity;
-  return point;
-}
-
 pcl::PointCloud<pcl::PointXYZI> toAmplitudePCL(const radar_msgs::msg::RadarScan & radar_scan)
 {
   pcl::PointCloud<pcl::PointXYZI> pcl;
   for (const auto & radar : radar_scan.returns) {
-    pcl.push_back(getPointXYZI(radar, radar.amplitude));
+    pcl.push_back(radar_preprocessor::getPointXYZI(radar, radar.amplitude));
   }
   return pcl;
 }
@@ -72,7 +63,7 @@ pcl::PointCloud<pcl::PointXYZI> toDopplerPCL(const radar_msgs::msg::RadarScan &
 {
   pcl::PointCloud<pcl::PointXYZI> pcl;
   for (const auto & radar : radar_scan.returns) {
-    pcl.push_back(getPointXYZI(radar, radar.doppler_velocity));
+    pcl.push_back(radar_preprocessor::getPointXYZI(radar, radar.doppler_velocity));
   }
   return pcl;
 }
@@ -14,9 +14,12 @@
 
 #include "radar_static_pointcloud_filter/radar_static_pointcloud_filter_node.hpp"
 
+#include <radar_preprocessor/radar_utils.hpp>
+
 #include <geometry_msgs/msg/transform_stamped.hpp>
-#include <geometry_msgs/msg/twist_with_covariance.hpp>
-#include <geometry_msgs/msg/vector3_stamped.hpp>
+
+#include <tf2/LinearMath/Matrix3x3.h>
+#include <tf2/LinearMath/Quaternion.h>
 
 #include <memory>
 #include <string>
@@ -38,40 +41,6 @@ bool update_param(
   value = itr->template get_value<T>();
   return true;
 }
-
-geometry_msgs::msg::Vector3 getVelocity(const radar_msgs::msg::RadarReturn & radar)
-{
-  return geometry_msgs::build<geometry_msgs::msg::Vector3>()
-    .x(radar.doppler_velocity * std::cos(radar.azimuth))
-    .y(radar.doppler_velocity * std::sin(radar.azimuth))
-    .z(0.0);
-}
-
-geometry_msgs::msg::Vector3 getTransformedVelocity(
-  const geometry_msgs::msg::Vector3 velocity,
-  geometry_msgs::msg::TransformStamped::ConstSharedPtr transform)
-{
-  geometry_msgs::msg::Vector3Stamped velocity_stamped{};
-  velocity_stamped.vector = velocity;
-  geometry_msgs::msg::Vector3Stamped transformed_velocity_stamped{};
-  tf2::doTransform(velocity_stamped, transformed_velocity_stamped, *transform);
-  return velocity_stamped.vector;
-}
-
-geometry_msgs::msg::Vector3 compensateEgoVehicleTwist(
-  const radar_msgs::msg::RadarReturn & radar,
-  const geometry_msgs::msg::TwistWithCovariance & ego_vehicle_twist_with_covariance,
-  geometry_msgs::msg::TransformStamped::ConstSharedPtr transform)
-{
-  const geometry_msgs::msg::Vector3 radar_velocity = getVelocity(radar);
-  const geometry_msgs::msg::Vector3 v_r = getTransformedVelocity(radar_velocity, transform);
-
-  const auto v_e = ego_vehicle_twist_with_covariance.twist.linear;
-  return geometry_msgs::build<geometry_msgs::msg::Vector3>()
-    .x(v_r.x + v_e.x)
-    .y(v_r.y + v_e.y)
-    .z(v_r.z + v_e.z);
-}
 }  // namespace
 
 namespace radar_static_pointcloud_filter
@@ -159,11 +128,10 @@ bool RadarStaticPointcloudFilterNode::isStaticPointcloud(
   const RadarReturn & radar_return, const Odometry::ConstSharedPtr & odom_msg,
   geometry_msgs::msg::TransformStamped::ConstSharedPtr transform)
 {
-  geometry_msgs::msg::Vector3 compensated_velocity =
-    compensateEgoVehicleTwist(radar_return, odom_msg->twist, transform);
-
-  return (-node_param_.doppler_velocity_sd < compensated_velocity.x) &&
-         (compensated_velocity.x < node_param_.doppler_velocity_sd);
+  const auto & q = transform->transform.rotation;
+  const tf2::Matrix3x3 rotation(tf2::Quaternion(q.x, q.y, q.z, q.w));
+  return radar_preprocessor::isStaticReturn(
+    radar_return, rotation, odom_msg->twist.twist.linear, node_param_.doppler_velocity_sd);
 }
 
 }  // namespace radar_static_pointcloud_filter
@@ -15,6 +15,7 @@
 #ifndef RADAR_THRESHOLD_FILTER__RADAR_THRESHOLD_FILTER_NODE_HPP_
 #define RADAR_THRESHOLD_FILTER__RADAR_THRESHOLD_FILTER_NODE_HPP_
 
+#include <radar_preprocessor/radar_utils.hpp>
 #include <rclcpp/rclcpp.hpp>
 
 #include <radar_msgs/msg/radar_scan.hpp>
@@ -34,21 +35,7 @@ class RadarThresholdFilterNode : public rclcpp::Node
 public:
   explicit RadarThresholdFilterNode(const rclcpp::NodeOptions & node_options);
 
-  struct NodeParam
-  {
-    bool is_amplitude_filter{};
-    double amplitude_min{};
-    double amplitude_max{};
-    bool is_range_filter{};
-    double range_min{};
-    double range_max{};
-    bool is_azimuth_filter{};
-    double azimuth_min{};
-    double azimuth_max{};
-    bool is_z_filter{};
-    double z_min{};
-    double z_max{};
-  };
+  using NodeParam = radar_preprocessor::ThresholdParam;
 
 private:
   // Subscriber
@@ -67,9 +54,6 @@ private:
 
   // Parameter
   NodeParam node_param_{};
-
-  // Function
-  bool isWithinThreshold(const RadarReturn & radar_return);
 };
 
 }  // namespace radar_threshold_filter
@@ -40,15 +40,6 @@ bool update_param(
   value = itr->template get_value<T>();
   return true;
 }
-
-bool isWithin(double value, double max, double min)
-{
-  if (min < value && value < max) {
-    return true;
-  } else {
-    return false;
-  }
-}
 }  // namespace
 
 namespace radar_threshold_filter
@@ -115,42 +106,13 @@ void RadarThresholdFilterNode::onData(const RadarScan::ConstSharedPtr radar_msg)
   RadarScan output;
   output.header = radar_msg->header;
   for (const auto & radar_return : radar_msg->returns) {
-    if (isWithinThreshold(radar_return)) {
+    if (radar_preprocessor::isWithinThreshold(radar_return, node_param_)) {
       output.returns.push_back(radar_return);
     }
   }
   pub_radar_->publish(output);
 }
 
-bool RadarThresholdFilterNode::isWithinThreshold(const RadarReturn & radar_return)
-{
-  if (
-    node_param_.is_amplitude_filter &&
-    !isWithin(radar_return.amplitude, node_param_.amplitude_max, node_param_.amplitude_min)) {
-    return false;
-  }
-
-  if (
-    node_param_.is_range_filter &&
-    !isWithin(radar_return.range, node_param_.range_max, node_param_.range_min)) {
-    return false;
-  }
-
-  if (
-    node_param_.is_azimuth_filter &&
-    !isWithin(radar_return.azimuth, node_param_.azimuth_max, node_param_.azimuth_min)) {
-    return false;
-  }
-
-  if (node_param_.is_z_filter) {
-    const auto z = radar_return.range * std::sin(radar_return.elevation);
-    if (!isWithin(z, node_param_.z_max, node_param_.z_min)) {
-      return false;
-    }
-  }
-  return true;
-}
-
 }  // namespace radar_threshold_filter
 
 #include "rclcpp_components/register_node_macro.hpp"
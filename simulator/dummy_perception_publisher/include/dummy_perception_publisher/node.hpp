@@ -90,7 +90,10 @@ private:
 class EgoCentricPointCloudCreator : public PointCloudCreator
 {
 public:
-  explicit EgoCentricPointCloudCreator(double visible_range) : visible_range_(visible_range) {}
+  EgoCentricPointCloudCreator(double visible_range, int num_threads)
+  : visible_range_(visible_range), num_threads_(num_threads)
+  {
+  }
   std::vector<pcl::PointCloud<pcl::PointXYZ>::Ptr> create_pointclouds(
     const std::vector<ObjectInfo> & obj_infos, const tf2::Transform & tf_base_link2map,
     std::mt19937 & random_generator,
@@ -98,6 +101,7 @@ public:
 
 private:
   double visible_range_;
+  int num_threads_;
 };
 
 class DummyPerceptionPublisherNode : public rclcpp::Node
@@ -33,6 +33,10 @@ public:
   double getSphereTracingDist(
     double x_start, double y_start, double angle,
     double max_dist = std::numeric_limits<double>::infinity(), double eps = 1e-2) const;
+  // distance to the first surface crossed by the ray, infinity if it is farther than max_dist
+  virtual double getRayIntersectionDist(
+    double x_start, double y_start, double angle,
+    double max_dist = std::numeric_limits<double>::infinity()) const;
   virtual ~AbstractSignedDistanceFunction() {}
 };
 
@@ -44,6 +48,9 @@ public:
   {
   }
   double operator()(double x, double y) const override;
+  double getRayIntersectionDist(
+    double x_start, double y_start, double angle,
+    double max_dist = std::numeric_limits<double>::infinity()) const override;
 
 private:
   double length_;
@@ -62,6 +69,9 @@ public:
     }
   }
   double operator()(double x, double y) const override;
+  double getRayIntersectionDist(
+    double x_start, double y_start, double angle,
+    double max_dist = std::numeric_limits<double>::infinity()) const override;
 
   size_t nearest_sdf_index(double x, double y) const;
 
@@ -26,6 +26,7 @@
 #include <tf2_geometry_msgs/tf2_geometry_msgs.hpp>
 #endif
 
+#include <algorithm>
 #include <functional>
 #include <limits>
 #include <memory>
@@ -114,8 +115,9 @@ DummyPerceptionPublisherNode::DummyPerceptionPublisherNode()
     pointcloud_creator_ =
       std::unique_ptr<PointCloudCreator>(new ObjectCentricPointCloudCreator(enable_ray_tracing_));
   } else {
-    pointcloud_creator_ =
-      std::unique_ptr<PointCloudCreator>(new EgoCentricPointCloudCreator(visible_range_));
+    const int num_threads = std::max(this->declare_parameter("num_threads", 1), 1);
+    pointcloud_creator_ = std::unique_ptr<PointCloudCreator>(
+      new EgoCentricPointCloudCreator(visible_range_, num_threads));
   }
 
   // parameters for vehicle centric point cloud generation
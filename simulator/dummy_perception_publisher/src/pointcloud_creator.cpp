@@ -21,9 +21,13 @@
 #include <tf2/LinearMath/Transform.h>
 #include <tf2/LinearMath/Vector3.h>
 
+#include <algorithm>
+#include <cmath>
 #include <functional>
 #include <limits>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace
 {
@@ -37,6 +41,8 @@ static constexpr double horizontal_theta_step = (0.1 / 180.0) * M_PI;
 static constexpr double horizontal_min_theta = (-180.0 / 180.0) * M_PI;
 static constexpr double horizontal_max_theta = (180.0 / 180.0) * M_PI;
 
+static constexpr int rays_per_chunk = 100;
+
 pcl::PointXYZ getPointWrtBaseLink(
   const tf2::Transform & tf_base_link2moved_object, double x, double y, double z)
 {
@@ -44,6 +50,50 @@ pcl::PointXYZ getPointWrtBaseLink(
   return pcl::PointXYZ(p_wrt_base.x(), p_wrt_base.y(), p_wrt_base.z());
 }
 
+const std::vector<double> & getVerticalTangents()
+{
+  static const std::vector<double> vertical_tangents = [] {
+    std::vector<double> tangents;
+    for (double vertical_theta = vertical_min_theta; vertical_theta <= vertical_max_theta + epsilon;
+         vertical_theta += vertical_theta_step) {
+      tangents.push_back(std::tan(vertical_theta));
+    }
+    return tangents;
+  }();
+  return vertical_tangents;
+}
+
+// Indices [first, last] of the rays which can hit the object outside the ego vehicle. Ray i is
+// casted at the angle (i + 1) * horizontal_theta_step, and the range is widened by one ray on each
+// side. first can be negative since the range may wrap around.
+std::pair<int, int> getRayIndexRange(
+  const ObjectInfo & obj_info, const tf2::Transform & tf_base_link2moved_object)
+{
+  const auto & center = tf_base_link2moved_object.getOrigin();
+  const double center_angle = std::atan2(center.y(), center.x());
+  double min_delta = 0.0;
+  double max_delta = 0.0;
+  for (const double x : {-0.5 * obj_info.length, 0.5 * obj_info.length}) {
+    for (const double y : {-0.5 * obj_info.width, 0.5 * obj_info.width}) {
+      const auto corner = tf_base_link2moved_object(tf2::Vector3(x, y, 0.0));
+      const double delta =
+        std::remainder(std::atan2(corner.y(), corner.x()) - center_angle, 2.0 * M_PI);
+      min_delta = std::min(min_delta, delta);
+      max_delta = std::max(max_delta, delta);
+    }
+  }
+  const int first =
+    static_cast<int>(std::floor((center_angle + min_delta) / horizontal_theta_step)) - 2;
+  const int last = static_cast<int>(std::ceil((center_angle + max_delta) / horizontal_theta_step));
+  return {first, last};
+}
+
+bool isInRayIndexRange(const int index, const std::pair<int, int> & range, const int n_scan)
+{
+  const int offset = ((index - range.first) % n_scan + n_scan) % n_scan;
+  return range.second - range.first + 1 >= n_scan || offset <= range.second - range.first;
+}
+
 }  // namespace
 
 void ObjectCentricPointCloudCreator::create_object_pointcloud(
@@ -199,64 +249,123 @@ std::vector<pcl::PointCloud<pcl::PointXYZ>::Ptr> EgoCentricPointCloudCreator::cr
   const std::vector<ObjectInfo> & obj_infos, const tf2::Transform & tf_base_link2map,
   std::mt19937 & random_generator, pcl::PointCloud<pcl::PointXYZ>::Ptr & merged_pointcloud) const
 {
-  std::vector<std::shared_ptr<signed_distance_function::AbstractSignedDistanceFunction>> sdf_ptrs;
+  const auto n_scan = static_cast<int>(std::floor(2 * M_PI / horizontal_theta_step));
+  const auto & vertical_tangents = getVerticalTangents();
+
+  std::vector<signed_distance_function::BoxSDF> sdfs;
+  std::vector<std::pair<int, int>> ray_index_ranges;
+  std::vector<double> min_zs;
+  std::vector<double> max_zs;
+  sdfs.reserve(obj_infos.size());
+  ray_index_ranges.reserve(obj_infos.size());
+  min_zs.reserve(obj_infos.size());
+  max_zs.reserve(obj_infos.size());
   for (const auto & obj_info : obj_infos) {
-    const auto sdf_ptr = std::make_shared<signed_distance_function::BoxSDF>(
-      obj_info.length, obj_info.width, tf_base_link2map * obj_info.tf_map2moved_object);
-    sdf_ptrs.push_back(sdf_ptr);
-  }
-  const auto composite_sdf = signed_distance_function::CompositeSDF(sdf_ptrs);
+    const auto tf_base_link2moved_object = tf_base_link2map * obj_info.tf_map2moved_object;
+    sdfs.emplace_back(obj_info.length, obj_info.width, tf_base_link2moved_object);
+    min_zs.push_back(-1.0 * (obj_info.height / 2.0) + tf_base_link2moved_object.getOrigin().z());
+    max_zs.push_back(1.0 * (obj_info.height / 2.0) + tf_base_link2moved_object.getOrigin().z());
 
-  std::vector<pcl::PointCloud<pcl::PointXYZ>::Ptr> pointclouds(obj_infos.size());
-  for (size_t i = 0; i < obj_infos.size(); ++i) {
-    pointclouds.at(i) = (pcl::PointCloud<pcl::PointXYZ>::Ptr(new pcl::PointCloud<pcl::PointXYZ>));
+    // each object is tested only against the rays within its angular span
+    const double dist_from_origin = sdfs.back()(0.0, 0.0);
+    if (dist_from_origin > visible_range_) {
+      ray_index_ranges.emplace_back(0, -1);
+    } else if (dist_from_origin <= 0.0) {
+      ray_index_ranges.emplace_back(0, n_scan - 1);
+    } else {
+      ray_index_ranges.push_back(getRayIndexRange(obj_info, tf_base_link2moved_object));
+    }
   }
 
-  std::vector<double> min_zs(obj_infos.size());
-  std::vector<double> max_zs(obj_infos.size());
+  // find the nearest hit of each ray and the number of the vertical points on it
+  std::vector<double> hit_dists(n_scan, std::numeric_limits<double>::infinity());
+  std::vector<int> hit_indices(n_scan, -1);
+  std::vector<size_t> n_points(n_scan, 0);
+#pragma omp parallel for num_threads(num_threads_) schedule(static)
+  for (int i = 0; i < n_scan; ++i) {
+    const double angle = (i + 1) * horizontal_theta_step;
+    for (size_t idx = 0; idx < sdfs.size(); ++idx) {
+      if (!isInRayIndexRange(i, ray_index_ranges.at(idx), n_scan)) {
+        continue;
+      }
+      const auto dist = sdfs.at(idx).getRayIntersectionDist(0.0, 0.0, angle, visible_range_);
+      if (dist < hit_dists.at(i)) {
+        hit_dists.at(i) = dist;
+        hit_indices.at(i) = static_cast<int>(idx);
+      }
+    }
+    if (hit_indices.at(i) < 0) {
+      continue;
+    }
+    for (const auto tangent : vertical_tangents) {
+      const double z = hit_dists.at(i) * tangent;
+      if (min_zs.at(hit_indices.at(i)) <= z && z <= max_zs.at(hit_indices.at(i)) + epsilon) {
+        ++n_points.at(i);
+      }
+    }
+  }
 
+  // preallocate the clouds so that the rays can write their points in parallel
+  std::vector<size_t> ray_offsets(n_scan, 0);
+  std::vector<size_t> object_sizes(obj_infos.size(), 0);
+  for (int i = 0; i < n_scan; ++i) {
+    if (hit_indices.at(i) >= 0) {
+      ray_offsets.at(i) = object_sizes.at(hit_indices.at(i));
+      object_sizes.at(hit_indices.at(i)) += n_points.at(i);
+    }
+  }
+  std::vector<pcl::PointCloud<pcl::PointXYZ>::Ptr> pointclouds(obj_infos.size());
+  std::vector<size_t> merged_offsets(obj_infos.size());
+  size_t merged_size = merged_pointcloud->size();
   for (size_t idx = 0; idx < obj_infos.size(); ++idx) {
-    const auto & obj_info = obj_infos.at(idx);
-    const auto tf_base_link2moved_object = tf_base_link2map * obj_info.tf_map2moved_object;
-    const double min_z = -1.0 * (obj_info.height / 2.0) + tf_base_link2moved_object.getOrigin().z();
-    const double max_z = 1.0 * (obj_info.height / 2.0) + tf_base_link2moved_object.getOrigin().z();
-    min_zs.at(idx) = min_z;
-    max_zs.at(idx) = max_z;
+    pointclouds.at(idx) = pcl::PointCloud<pcl::PointXYZ>::Ptr(new pcl::PointCloud<pcl::PointXYZ>);
+    pointclouds.at(idx)->resize(object_sizes.at(idx));
+    merged_offsets.at(idx) = merged_size;
+    merged_size += object_sizes.at(idx);
   }
+  merged_pointcloud->resize(merged_size);
 
-  double angle = 0.0;
-  const auto n_scan = static_cast<size_t>(std::floor(2 * M_PI / horizontal_theta_step));
-  for (size_t i = 0; i < n_scan; ++i) {
-    angle += horizontal_theta_step;
-    const auto dist = composite_sdf.getSphereTracingDist(0.0, 0.0, angle, visible_range_);
+  // each chunk of rays has its own random stream seeded in order, so that the result does not
+  // depend on the number of threads
+  const int n_chunks = (n_scan + rays_per_chunk - 1) / rays_per_chunk;
+  std::vector<std::mt19937::result_type> seeds(n_chunks);
+  for (auto & seed : seeds) {
+    seed = random_generator();
+  }
 
-    if (std::isfinite(dist)) {
-      const auto x_hit = dist * cos(angle);
-      const auto y_hit = dist * sin(angle);
-      const auto idx_hit = composite_sdf.nearest_sdf_index(x_hit, y_hit);
-      const auto obj_info_here = obj_infos.at(idx_hit);
+#pragma omp parallel for num_threads(num_threads_) schedule(static)
+  for (int chunk = 0; chunk < n_chunks; ++chunk) {
+    std::mt19937 chunk_random_generator(seeds.at(chunk));
+    std::normal_distribution<> standard_random(0.0, 1.0);
+    const int end = std::min(n_scan, (chunk + 1) * rays_per_chunk);
+    for (int i = chunk * rays_per_chunk; i < end; ++i) {
+      const auto idx_hit = hit_indices.at(i);
+      if (idx_hit < 0) {
+        continue;
+      }
+      const auto & obj_info_here = obj_infos.at(idx_hit);
       const auto min_z_here = min_zs.at(idx_hit);
       const auto max_z_here = max_zs.at(idx_hit);
-      std::normal_distribution<> x_random(0.0, obj_info_here.std_dev_x);
-      std::normal_distribution<> y_random(0.0, obj_info_here.std_dev_y);
-      std::normal_distribution<> z_random(0.0, obj_info_here.std_dev_z);
+      const double angle = (i + 1) * horizontal_theta_step;
+      const auto x_hit = hit_dists.at(i) * cos(angle);
+      const auto y_hit = hit_dists.at(i) * sin(angle);
 
-      for (double vertical_theta = vertical_min_theta;
-           vertical_theta <= vertical_max_theta + epsilon; vertical_theta += vertical_theta_step) {
-        const double z = dist * std::tan(vertical_theta);
+      auto & pointcloud = *pointclouds.at(idx_hit);
+      size_t point_idx = ray_offsets.at(i);
+      for (const auto tangent : vertical_tangents) {
+        const double z = hit_dists.at(i) * tangent;
         if (min_z_here <= z && z <= max_z_here + epsilon) {
-          pointclouds.at(idx_hit)->push_back(pcl::PointXYZ(
-            x_hit + x_random(random_generator), y_hit + y_random(random_generator),
-            z + z_random(random_generator)));
+          pcl::PointXYZ point;
+          point.x = x_hit + obj_info_here.std_dev_x * standard_random(chunk_random_generator);
+          point.y = y_hit + obj_info_here.std_dev_y * standard_random(chunk_random_generator);
+          point.z = z + obj_info_here.std_dev_z * standard_random(chunk_random_generator);
+          pointcloud.at(point_idx) = point;
+          merged_pointcloud->at(merged_offsets.at(idx_hit) + point_idx) = point;
+          ++point_idx;
         }
       }
     }
   }
 
-  for (const auto & cloud : pointclouds) {
-    for (const auto & pt : *cloud) {
-      merged_pointcloud->push_back(pt);
-    }
-  }
   return pointclouds;
 }
@@ -16,6 +16,8 @@
 
 #include <tf2/LinearMath/Vector3.h>
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <limits>
 
@@ -48,6 +50,12 @@ double AbstractSignedDistanceFunction::getSphereTracingDist(
   return std::numeric_limits<double>::infinity();
 }
 
+double AbstractSignedDistanceFunction::getRayIntersectionDist(
+  double x_start, double y_start, double angle, double max_dist) const
+{
+  return getSphereTracingDist(x_start, y_start, angle, max_dist);
+}
+
 double BoxSDF::operator()(double x, double y) const
 {
   const auto && vec_global = tf2::Vector3(x, y, 0.0);
@@ -68,12 +76,56 @@ double BoxSDF::operator()(double x, double y) const
   return negative_dist;
 }
 
+double BoxSDF::getRayIntersectionDist(
+  double x_start, double y_start, double angle, double max_dist) const
+{
+  // slab method in the box coordinates
+  const auto origin = tf_local_to_global_(tf2::Vector3(x_start, y_start, 0.0));
+  const auto direction = tf_local_to_global_.getBasis() * tf2::Vector3(cos(angle), sin(angle), 0.0);
+  const double half_extents[2] = {0.5 * length_, 0.5 * width_};
+
+  double t_near = -std::numeric_limits<double>::infinity();
+  double t_far = std::numeric_limits<double>::infinity();
+  for (int axis = 0; axis < 2; ++axis) {
+    const double o = origin[axis];
+    const double d = direction[axis];
+    if (std::abs(d) < std::numeric_limits<double>::epsilon()) {
+      if (std::abs(o) > half_extents[axis]) {
+        return std::numeric_limits<double>::infinity();
+      }
+      continue;
+    }
+    const double t1 = (-half_extents[axis] - o) / d;
+    const double t2 = (half_extents[axis] - o) / d;
+    t_near = std::max(t_near, std::min(t1, t2));
+    t_far = std::min(t_far, std::max(t1, t2));
+  }
+
+  if (t_far < std::max(t_near, 0.0)) {
+    return std::numeric_limits<double>::infinity();
+  }
+  // the exit point is the first surface crossed when the ray starts inside the box
+  const double dist = t_near >= 0.0 ? t_near : t_far;
+  return dist > max_dist ? std::numeric_limits<double>::infinity() : dist;
+}
+
 double CompositeSDF::operator()(double x, double y) const
 {
   const size_t nearest_idx = nearest_sdf_index(x, y);
   return sdf_ptrs_.at(nearest_idx)->operator()(x, y);
 }
 
+double CompositeSDF::getRayIntersectionDist(
+  double x_start, double y_start, double angle, double max_dist) const
+{
+  double min_dist = std::numeric_limits<double>::infinity();
+  for (const auto & sdf_ptr : sdf_ptrs_) {
+    min_dist =
+      std::min(min_dist, sdf_ptr->getRayIntersectionDist(x_start, y_start, angle, max_dist));
+  }
+  return min_dist;
+}
+
 size_t CompositeSDF::nearest_sdf_index(double x, double y) const
 {
   double min_value = std::numeric_limits<double>::infinity();
@@ -77,6 +77,47 @@ TEST(SignedDistanceFunctionTest, CompositeSDF)
   // ASSERT_NEAR(func.getSphereTracingDist(0.0, 1.0, M_PI * -0.5, eps), 0.5, eps);
 }
 
+TEST(SignedDistanceFunctionTest, BoxRayIntersection)
+{
+  const double eps = 1e-5;
+
+  {
+    // test with identity transform
+    const auto q = tf2::Quaternion(tf2::Vector3(0, 0, 1.0), 0.0);
+    const auto func = sdf::BoxSDF(1., 2., tf2::Transform(q));
+    ASSERT_NEAR(func.getRayIntersectionDist(2.0, 0.0, M_PI * -1.0), 1.5, eps);
+    ASSERT_NEAR(func.getRayIntersectionDist(1.0, 1.5, M_PI * 1.25), sqrt(2.0) * 0.5, eps);
+    ASSERT_NEAR(func.getRayIntersectionDist(0.0, 0.0, 0.0), 0.5, eps);  // from inside
+    ASSERT_TRUE(std::isinf(func.getRayIntersectionDist(2.0, 0.0, 0.0)));
+    ASSERT_TRUE(std::isinf(func.getRayIntersectionDist(2.0, 0.0, M_PI * -1.0, 1.0)));
+    ASSERT_TRUE(std::isinf(func.getRayIntersectionDist(0.0, 1.5, 0.0)));
+  }
+
+  {
+    // test with rotation (90 deg) and translation
+    const auto q = tf2::Quaternion(tf2::Vector3(0, 0, 1.0), M_PI * 0.5);
+    const auto tf_global2local = tf2::Transform(q, tf2::Vector3(1.0, 1.0, 0.0));
+    const auto func = sdf::BoxSDF(1., 2., tf_global2local);
+    ASSERT_NEAR(func.getRayIntersectionDist(0.0, 1.0, 0.0), 0.0, eps);
+    ASSERT_NEAR(func.getRayIntersectionDist(-1.0, 1.0, 0.0), 1.0, eps);
+    ASSERT_NEAR(func.getRayIntersectionDist(1.0, -1.0, M_PI * 0.5), 1.5, eps);
+    ASSERT_NEAR(func.getRayIntersectionDist(0.0, 0.0, M_PI * 0.25), sqrt(2.0) * 0.5, eps);
+  }
+
+  {
+    // the nearest box is hit
+    const auto q_identity = tf2::Quaternion(tf2::Vector3(0, 0, 1.0), 0.0);
+    const auto f1 =
+      std::make_shared<sdf::BoxSDF>(1., 1., tf2::Transform(q_identity, tf2::Vector3(2.0, 0, 0)));
+    const auto f2 =
+      std::make_shared<sdf::BoxSDF>(1., 1., tf2::Transform(q_identity, tf2::Vector3(4.0, 0, 0)));
+    const auto func =
+      sdf::CompositeSDF(std::vector<std::shared_ptr<sdf::AbstractSignedDistanceFunction>>{f2, f1});
+    ASSERT_NEAR(func.getRayIntersectionDist(0.0, 0.0, 0.0), 1.5, eps);
+    ASSERT_TRUE(std::isinf(func.getRayIntersectionDist(0.0, 0.0, M_PI)));
+  }
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
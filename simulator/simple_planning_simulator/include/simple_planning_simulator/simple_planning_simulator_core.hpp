@@ -44,7 +44,9 @@
 #include "geometry_msgs/msg/twist.hpp"
 #include "geometry_msgs/msg/twist_stamped.hpp"
 #include "nav_msgs/msg/odometry.hpp"
+#include "rosgraph_msgs/msg/clock.hpp"
 #include "sensor_msgs/msg/imu.hpp"
+#include "std_srvs/srv/trigger.hpp"
 #include "tier4_external_api_msgs/srv/initialize_pose.hpp"
 
 #include <tf2_ros/buffer.h>
@@ -83,7 +85,9 @@ using geometry_msgs::msg::TransformStamped;
 using geometry_msgs::msg::Twist;
 using geometry_msgs::msg::TwistStamped;
 using nav_msgs::msg::Odometry;
+using rosgraph_msgs::msg::Clock;
 using sensor_msgs::msg::Imu;
+using std_srvs::srv::Trigger;
 using tier4_external_api_msgs::srv::InitializePose;
 
 class DeltaTime
@@ -135,6 +139,7 @@ private:
   rclcpp::Publisher<HazardLightsReport>::SharedPtr pub_hazard_lights_report_;
   rclcpp::Publisher<tf2_msgs::msg::TFMessage>::SharedPtr pub_tf_;
   rclcpp::Publisher<PoseStamped>::SharedPtr pub_current_pose_;
+  rclcpp::Publisher<Clock>::SharedPtr pub_clock_;
 
   rclcpp::Subscription<GearCommand>::SharedPtr sub_gear_cmd_;
   rclcpp::Subscription<GearCommand>::SharedPtr sub_manual_gear_cmd_;
@@ -149,12 +154,15 @@ private:
   rclcpp::Subscription<Engage>::SharedPtr sub_engage_;
 
   rclcpp::Service<ControlModeCommand>::SharedPtr srv_mode_req_;
+  rclcpp::Service<Trigger>::SharedPtr srv_step_;
 
   rclcpp::CallbackGroup::SharedPtr group_api_service_;
   tier4_api_utils::Service<InitializePose>::SharedPtr srv_set_pose_;
 
   uint32_t timer_sampling_time_ms_;        //!< @brief timer sampling time
   rclcpp::TimerBase::SharedPtr on_timer_;  //!< @brief timer for simulation
+  bool lockstep_mode_;                     //!< @brief step on each control command instead of timer
+  rclcpp::Time simulated_time_;            //!< @brief time published on /clock in lockstep mode
 
   OnSetParametersCallbackHandle::SharedPtr set_param_res_;
   rcl_interfaces::msg::SetParametersResult on_parameter(
@@ -281,6 +289,29 @@ private:
    */
   void on_timer();
 
+  /**
+   * @brief advance the simulation by one timer_sampling_time_ms on the control command in the
+   * lockstep mode
+   */
+  void on_lockstep_command();
+
+  /**
+   * @brief advance the simulation by one timer_sampling_time_ms on the current command in the
+   * lockstep mode, for a scenario runner to step the simulation without a new command
+   */
+  void on_step(const Trigger::Request::SharedPtr request, Trigger::Response::SharedPtr response);
+
+  /**
+   * @brief set the current command to the vehicle model and update it
+   * @param [in] dt time step [s]
+   */
+  void update_vehicle_model(const double dt);
+
+  /**
+   * @brief publish the current state of the vehicle model
+   */
+  void publish_state();
+
   /**
    * @brief initialize vehicle_model_ptr
    */
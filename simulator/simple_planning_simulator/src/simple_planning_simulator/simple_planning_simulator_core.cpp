@@ -91,10 +91,20 @@ SimplePlanningSimulator::SimplePlanningSimulator(const rclcpp::NodeOptions & opt
     "input/initialtwist", QoS{1}, std::bind(&SimplePlanningSimulator::on_initialtwist, this, _1));
   sub_ackermann_cmd_ = create_subscription<AckermannControlCommand>(
     "input/ackermann_control_command", QoS{1},
-    [this](const AckermannControlCommand::SharedPtr msg) { current_ackermann_cmd_ = *msg; });
+    [this](const AckermannControlCommand::SharedPtr msg) {
+      current_ackermann_cmd_ = *msg;
+      if (lockstep_mode_ && current_control_mode_.mode == ControlModeReport::AUTONOMOUS) {
+        on_lockstep_command();
+      }
+    });
   sub_manual_ackermann_cmd_ = create_subscription<AckermannControlCommand>(
     "input/manual_ackermann_control_command", QoS{1},
-    [this](const AckermannControlCommand::SharedPtr msg) { current_manual_ackermann_cmd_ = *msg; });
+    [this](const AckermannControlCommand::SharedPtr msg) {
+      current_manual_ackermann_cmd_ = *msg;
+      if (lockstep_mode_ && current_control_mode_.mode != ControlModeReport::AUTONOMOUS) {
+        on_lockstep_command();
+      }
+    });
   sub_gear_cmd_ = create_subscription<GearCommand>(
     "input/gear_command", QoS{1},
     [this](const GearCommand::SharedPtr msg) { current_gear_cmd_ = *msg; });
@@ -138,9 +148,18 @@ SimplePlanningSimulator::SimplePlanningSimulator(const rclcpp::NodeOptions & opt
     std::bind(&SimplePlanningSimulator::on_parameter, this, _1));
 
   timer_sampling_time_ms_ = static_cast<uint32_t>(declare_parameter("timer_sampling_time_ms", 25));
-  on_timer_ = rclcpp::create_timer(
-    this, get_clock(), std::chrono::milliseconds(timer_sampling_time_ms_),
-    std::bind(&SimplePlanningSimulator::on_timer, this));
+  lockstep_mode_ = declare_parameter("lockstep_mode", false);
+  if (lockstep_mode_) {
+    // the simulation owns the time, the other nodes follow it with use_sim_time
+    simulated_time_ = get_clock()->now();
+    pub_clock_ = create_publisher<Clock>("/clock", QoS{1});
+    srv_step_ = create_service<Trigger>(
+      "~/step", std::bind(&SimplePlanningSimulator::on_step, this, _1, _2));
+  } else {
+    on_timer_ = rclcpp::create_timer(
+      this, get_clock(), std::chrono::milliseconds(timer_sampling_time_ms_),
+      std::bind(&SimplePlanningSimulator::on_timer, this));
+  }
 
   tier4_api_utils::ServiceProxyNodeInterface proxy(this);
   group_api_service_ = create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
@@ -258,23 +277,58 @@ void SimplePlanningSimulator::on_timer()
     return;
   }
 
-  // update vehicle dynamics
-  {
-    const double dt = delta_time_.get_dt(get_clock()->now());
-
-    if (current_control_mode_.mode == ControlModeReport::AUTONOMOUS) {
-      vehicle_model_ptr_->setGear(current_gear_cmd_.command);
-      set_input(current_ackermann_cmd_);
-    } else {
-      vehicle_model_ptr_->setGear(current_manual_gear_cmd_.command);
-      set_input(current_manual_ackermann_cmd_);
-    }
+  update_vehicle_model(delta_time_.get_dt(get_clock()->now()));
+  publish_state();
+}
 
-    if (simulate_motion_) {
-      vehicle_model_ptr_->update(dt);
-    }
+void SimplePlanningSimulator::on_lockstep_command()
+{
+  if (!is_initialized_) {
+    RCLCPP_INFO_THROTTLE(get_logger(), *get_clock(), 5000, "waiting initialization...");
+    return;
   }
 
+  // advance by exactly one sampling period per command so that the result does not depend on how
+  // fast the commands arrive
+  update_vehicle_model(timer_sampling_time_ms_ / 1000.0);
+  publish_state();
+
+  simulated_time_ += rclcpp::Duration(std::chrono::milliseconds(timer_sampling_time_ms_));
+  Clock clock;
+  clock.clock = simulated_time_;
+  pub_clock_->publish(clock);
+}
+
+void SimplePlanningSimulator::on_step(
+  [[maybe_unused]] const Trigger::Request::SharedPtr request, Trigger::Response::SharedPtr response)
+{
+  if (!is_initialized_) {
+    response->success = false;
+    response->message = "waiting initialization";
+    return;
+  }
+
+  on_lockstep_command();
+  response->success = true;
+}
+
+void SimplePlanningSimulator::update_vehicle_model(const double dt)
+{
+  if (current_control_mode_.mode == ControlModeReport::AUTONOMOUS) {
+    vehicle_model_ptr_->setGear(current_gear_cmd_.command);
+    set_input(current_ackermann_cmd_);
+  } else {
+    vehicle_model_ptr_->setGear(current_manual_gear_cmd_.command);
+    set_input(current_manual_ackermann_cmd_);
+  }
+
+  if (simulate_motion_) {
+    vehicle_model_ptr_->update(dt);
+  }
+}
+
+void SimplePlanningSimulator::publish_state()
+{
   // set current state
   current_odometry_ = to_odometry(vehicle_model_ptr_);
   current_odometry_.pose.pose.position.z = get_z_pose_from_trajectory(
@@ -475,6 +529,11 @@ void SimplePlanningSimulator::set_initial_state(const Pose & pose, const Twist &
   vehicle_model_ptr_->setState(state);
 
   is_initialized_ = true;
+
+  // there is no timer in the lockstep mode, so publish the initial state for the control to start
+  if (lockstep_mode_) {
+    publish_state();
+  }
 }
 
 double SimplePlanningSimulator::get_z_pose_from_trajectory(const double x, const double y)
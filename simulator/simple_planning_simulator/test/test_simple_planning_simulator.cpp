@@ -28,6 +28,8 @@ using autoware_auto_control_msgs::msg::AckermannControlCommand;
 using autoware_auto_vehicle_msgs::msg::GearCommand;
 using geometry_msgs::msg::PoseWithCovarianceStamped;
 using nav_msgs::msg::Odometry;
+using rosgraph_msgs::msg::Clock;
+using std_srvs::srv::Trigger;
 
 using simulation::simple_planning_simulator::SimplePlanningSimulator;
 
@@ -55,14 +57,20 @@ public:
     pub_initialpose_ =
       create_publisher<PoseWithCovarianceStamped>("input/initialpose", rclcpp::QoS{1});
     pub_gear_cmd_ = create_publisher<GearCommand>("input/gear_command", rclcpp::QoS{1});
+    clock_sub_ = create_subscription<Clock>(
+      "/clock", rclcpp::QoS{1}, [this](const Clock::SharedPtr msg) { current_clock_ = msg; });
+    step_client_ = create_client<Trigger>("simple_planning_simulator/step");
   }
 
   rclcpp::Subscription<Odometry>::SharedPtr current_odom_sub_;
   rclcpp::Publisher<AckermannControlCommand>::SharedPtr pub_ackermann_command_;
   rclcpp::Publisher<GearCommand>::SharedPtr pub_gear_cmd_;
   rclcpp::Publisher<PoseWithCovarianceStamped>::SharedPtr pub_initialpose_;
+  rclcpp::Subscription<Clock>::SharedPtr clock_sub_;
+  rclcpp::Client<Trigger>::SharedPtr step_client_;
 
   Odometry::SharedPtr current_odom_;
+  Clock::SharedPtr current_clock_;
 };
 
 /**
@@ -136,6 +144,25 @@ void sendCommand(
   }
 }
 
+/**
+ * @brief call the step service of the simulation in the lockstep mode
+ * @param [in] sim_node pointer to the simulation node
+ * @param [in] pub_sub_node pointer to the node used for communication
+ * @return whether the simulation stepped
+ */
+bool callStep(rclcpp::Node::SharedPtr sim_node, std::shared_ptr<PubSubNode> pub_sub_node)
+{
+  auto result =
+    pub_sub_node->step_client_->async_send_request(std::make_shared<Trigger::Request>());
+  for (int i = 0; i < 10; ++i) {
+    rclcpp::spin_some(sim_node);
+    rclcpp::spin_some(pub_sub_node);
+    std::this_thread::sleep_for(std::chrono::milliseconds{10LL});
+  }
+  return result.wait_for(std::chrono::seconds(0)) == std::future_status::ready &&
+         result.get()->success;
+}
+
 // Check which direction the vehicle is heading on the baselink coordinates.
 //                      y
 //                      |
@@ -268,6 +295,75 @@ TEST_P(TestSimplePlanningSimulator, TestIdealSteerVel)
   rclcpp::shutdown();
 }
 
+TEST_P(TestSimplePlanningSimulator, TestLockstep)
+{
+  rclcpp::init(0, nullptr);
+
+  const auto vehicle_model_type = GetParam();
+
+  rclcpp::NodeOptions node_options;
+  node_options.append_parameter_override("initialize_source", "INITIAL_POSE_TOPIC");
+  node_options.append_parameter_override("vehicle_model_type", vehicle_model_type);
+  node_options.append_parameter_override("initial_engage_state", true);
+  node_options.append_parameter_override("add_measurement_noise", false);
+  node_options.append_parameter_override("lockstep_mode", true);
+  declareVehicleInfoParams(node_options);
+  const auto sim_node = std::make_shared<SimplePlanningSimulator>(node_options);
+
+  const auto pub_sub_node = std::make_shared<PubSubNode>();
+
+  // the initial state is published without any command
+  resetInitialpose(sim_node, pub_sub_node);
+  ASSERT_TRUE(pub_sub_node->current_odom_);
+  const auto init_state = *(pub_sub_node->current_odom_);
+
+  // each command advances the simulation by one step
+  sendGear(GearCommand::DRIVE, sim_node, pub_sub_node);
+  sendCommand(cmdGen(sim_node->now(), 0.0f, 0.0f, 5.0f, 5.0f, 0.0f), sim_node, pub_sub_node);
+  isOnForward(*(pub_sub_node->current_odom_), init_state);
+
+  rclcpp::shutdown();
+}
+
+TEST_P(TestSimplePlanningSimulator, TestLockstepStep)
+{
+  rclcpp::init(0, nullptr);
+
+  const auto vehicle_model_type = GetParam();
+
+  rclcpp::NodeOptions node_options;
+  node_options.append_parameter_override("initialize_source", "INITIAL_POSE_TOPIC");
+  node_options.append_parameter_override("vehicle_model_type", vehicle_model_type);
+  node_options.append_parameter_override("initial_engage_state", true);
+  node_options.append_parameter_override("add_measurement_noise", false);
+  node_options.append_parameter_override("lockstep_mode", true);
+  declareVehicleInfoParams(node_options);
+  const auto sim_node = std::make_shared<SimplePlanningSimulator>(node_options);
+  const auto sampling_time_ms = sim_node->get_parameter("timer_sampling_time_ms").as_int();
+
+  const auto pub_sub_node = std::make_shared<PubSubNode>();
+  ASSERT_TRUE(pub_sub_node->step_client_->wait_for_service(std::chrono::seconds(1)));
+
+  // the simulation does not step before it is initialized
+  EXPECT_FALSE(callStep(sim_node, pub_sub_node));
+  EXPECT_FALSE(pub_sub_node->current_clock_);
+
+  resetInitialpose(sim_node, pub_sub_node);
+
+  // each step advances the simulated time by one sampling period
+  ASSERT_TRUE(callStep(sim_node, pub_sub_node));
+  ASSERT_TRUE(pub_sub_node->current_clock_);
+  const rclcpp::Time first_time(pub_sub_node->current_clock_->clock);
+  constexpr int num_steps = 4;
+  for (int i = 0; i < num_steps; ++i) {
+    ASSERT_TRUE(callStep(sim_node, pub_sub_node));
+  }
+  const rclcpp::Time last_time(pub_sub_node->current_clock_->clock);
+  EXPECT_EQ((last_time - first_time).nanoseconds(), num_steps * sampling_time_ms * 1000000LL);
+
+  rclcpp::shutdown();
+}
+
 // clang-format off
 const std::string VEHICLE_MODEL_LIST[] = {   // NOLINT
   "IDEAL_STEER_VEL", "IDEAL_STEER_ACC", "IDEAL_STEER_ACC_GEARED",
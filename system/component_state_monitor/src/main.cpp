@@ -67,8 +67,14 @@ StateMonitor::StateMonitor(const rclcpp::NodeOptions & options) : Node("state",
   for (const auto & type : types) {
     for (const auto & module : modules) {
       for (const auto & topic : topics_[type][module]) {
-        levels_[topic] = DiagnosticStatus::STALE;
+        const auto [iter, inserted] = slots_.emplace(topic, levels_.size());
+        if (inserted) {
+          levels_.push_back(DiagnosticStatus::STALE);
+          dependents_.emplace_back();
+        }
+        dependents_[iter->second].emplace_back(type, module);
       }
+      not_ok_counts_[type][module] = topics_[type][module].size();
     }
   }
 
@@ -83,8 +89,8 @@ StateMonitor::StateMonitor(const rclcpp::NodeOptions & options) : Node("state",
   sub_diag_ = create_subscription<DiagnosticArray>(
     "/diagnostics", 100, std::bind(&StateMonitor::on_diag, this, std::placeholders::_1));
 
-  const auto rate = rclcpp::Rate(10.0);
-  timer_ = rclcpp::create_timer(this, get_clock(), rate.period(), [this] { on_timer(); });
+  // Publish the initial states, after that the states are published only when they change.
+  update_states();
 }
 
 void StateMonitor::update_state(const StateType & type, const Module & module, bool state)
@@ -98,19 +104,11 @@ void StateMonitor::update_state(const StateType & type, const Module & module, b
   states_[type][module] = state;
 }
 
-void StateMonitor::on_timer()
+void StateMonitor::update_states()
 {
-  const auto is_ok = [this](const std::string & name) {
-    return levels_[name] == DiagnosticStatus::OK;
-  };
-
-  const auto state = [is_ok](const std::vector<std::string> & names) {
-    return std::all_of(names.begin(), names.end(), is_ok);
-  };
-
   for (const auto & module : modules) {
-    const auto launch_state = state(topics_[StateType::kLaunch][module]);
-    const auto auto_state = state(topics_[StateType::kAutonomous][module]);
+    const auto launch_state = not_ok_counts_[StateType::kLaunch][module] == 0;
+    const auto auto_state = not_ok_counts_[StateType::kAutonomous][module] == 0;
     update_state(StateType::kLaunch, module, launch_state);
     update_state(StateType::kAutonomous, module, launch_state & auto_state);
   }
@@ -118,12 +116,35 @@ void StateMonitor::on_timer()
 
 void StateMonitor::on_diag(const DiagnosticArray::ConstSharedPtr msg)
 {
+  bool is_changed = false;
+
   for (const auto & status : msg->status) {
-    if (status.hardware_id == "topic_state_monitor") {
-      if (levels_.count(status.name)) {
-        levels_[status.name] = status.level;
-      }
+    if (status.hardware_id != "topic_state_monitor") {
+      continue;
+    }
+    const auto iter = slots_.find(status.name);
+    if (iter == slots_.end()) {
+      continue;
     }
+
+    auto & level = levels_[iter->second];
+    const bool was_ok = level == DiagnosticStatus::OK;
+    const bool is_ok = status.level == DiagnosticStatus::OK;
+    level = status.level;
+    if (was_ok == is_ok) {
+      continue;
+    }
+
+    for (const auto & [type, module] : dependents_[iter->second]) {
+      auto & count = not_ok_counts_[type][module];
+      count = is_ok ? count - 1 : count + 1;
+    }
+    is_changed = true;
+  }
+
+  // Publish the states as soon as they change instead of waiting for a timer.
+  if (is_changed) {
+    update_states();
   }
 }
 
@@ -22,6 +22,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace component_state_monitor
@@ -61,15 +62,20 @@ private:
   template <class T>
   using TypeModuleMap = std::unordered_map<StateType, std::unordered_map<Module, T>>;
 
-  rclcpp::TimerBase::SharedPtr timer_;
   rclcpp::Subscription<DiagnosticArray>::SharedPtr sub_diag_;
   TypeModuleMap<rclcpp::Publisher<ModeChangeAvailable>::SharedPtr> pubs_;
   TypeModuleMap<bool> states_;
   TypeModuleMap<std::vector<std::string>> topics_;
-  std::unordered_map<std::string, DiagnosticLevel> levels_;
+
+  // The levels are stored in slots, and each slot knows the type and module lists containing it.
+  // The lists keep the count of their topics that are not OK, so a level change updates them.
+  std::unordered_map<std::string, size_t> slots_;
+  std::vector<DiagnosticLevel> levels_;
+  std::vector<std::vector<std::pair<StateType, Module>>> dependents_;
+  TypeModuleMap<size_t> not_ok_counts_;
 
   void update_state(const StateType & type, const Module & module, bool state);
-  void on_timer();
+  void update_states();
   void on_diag(const DiagnosticArray::ConstSharedPtr msg);
 };
 
@@ -47,15 +47,12 @@ OperationModeNode::OperationModeNode(const rclcpp::NodeOptions & options)
     const auto name = "/system/component_state_monitor/component/autonomous/" + module_names[i];
     const auto qos = rclcpp::QoS(1).transient_local();
     const auto callback = [this, i](const ModeChangeAvailable::ConstSharedPtr msg) {
-      module_states_[i] = msg->available;
+      on_module_state(i, msg->available);
     };
     sub_module_states_.push_back(create_subscription<ModeChangeAvailable>(name, qos, callback));
   }
   module_states_.resize(module_names.size());
 
-  timer_ = rclcpp::create_timer(
-    this, get_clock(), rclcpp::Rate(5.0).period(), std::bind(&OperationModeNode::on_timer, this));
-
   curr_state_.mode = OperationModeState::Message::UNKNOWN;
   prev_state_.mode = OperationModeState::Message::UNKNOWN;
   mode_available_[OperationModeState::Message::UNKNOWN] = false;
@@ -134,8 +131,14 @@ void OperationModeNode::on_state(const OperationModeState::Message::ConstSharedP
   update_state();
 }
 
-void OperationModeNode::on_timer()
+void OperationModeNode::on_module_state(const size_t index, const bool available)
 {
+  // The availability only changes here, so there is no need to poll it.
+  if (module_states_[index] == available) {
+    return;
+  }
+  module_states_[index] = available;
+
   bool autonomous_available = true;
   for (const auto & state : module_states_) {
     autonomous_available &= state;
@@ -53,7 +53,6 @@ private:
   std::unordered_map<OperationModeState::Message::_mode_type, bool> mode_available_;
 
   rclcpp::CallbackGroup::SharedPtr group_cli_;
-  rclcpp::TimerBase::SharedPtr timer_;
   Pub<autoware_ad_api::operation_mode::OperationModeState> pub_state_;
   Srv<autoware_ad_api::operation_mode::ChangeToStop> srv_stop_mode_;
   Srv<autoware_ad_api::operation_mode::ChangeToAutonomous> srv_autonomous_mode_;
@@ -88,7 +87,7 @@ private:
     const DisableAutowareControl::Service::Response::SharedPtr res);
 
   void on_state(const OperationModeState::Message::ConstSharedPtr msg);
-  void on_timer();
+  void on_module_state(const size_t index, const bool available);
   void update_state();
 
   template <class ResponseT>
@@ -130,6 +130,7 @@ private:
 
   bool isDataReady();
   void onTimer();
+  void evaluate();
 
   // Heartbeat
   rclcpp::Time stamp_hazard_status_;
@@ -18,6 +18,17 @@
 #include <string>
 #include <utility>
 
+namespace
+{
+bool isHazardStatusChanged(
+  const autoware_auto_system_msgs::msg::HazardStatus & prev,
+  const autoware_auto_system_msgs::msg::HazardStatus & curr)
+{
+  return prev.level != curr.level || prev.emergency != curr.emergency ||
+         prev.emergency_holding != curr.emergency_holding;
+}
+}  // namespace
+
 EmergencyHandler::EmergencyHandler() : Node("emergency_handler")
 {
   // Parameter
@@ -95,8 +106,16 @@ EmergencyHandler::EmergencyHandler() : Node("emergency_handler")
 void EmergencyHandler::onHazardStatusStamped(
   const autoware_auto_system_msgs::msg::HazardStatusStamped::ConstSharedPtr msg)
 {
+  const bool is_changed =
+    !hazard_status_stamped_ || isHazardStatusChanged(hazard_status_stamped_->status, msg->status);
+
   hazard_status_stamped_ = msg;
   stamp_hazard_status_ = this->now();
+
+  // Evaluate immediately instead of waiting for the next timer tick
+  if (is_changed) {
+    evaluate();
+  }
 }
 
 void EmergencyHandler::onPrevControlCommand(
@@ -122,13 +141,25 @@ void EmergencyHandler::onControlMode(
 void EmergencyHandler::onMrmComfortableStopStatus(
   const tier4_system_msgs::msg::MrmBehaviorStatus::ConstSharedPtr msg)
 {
+  const bool is_changed = mrm_comfortable_stop_status_->state != msg->state;
+
   mrm_comfortable_stop_status_ = msg;
+
+  if (is_changed) {
+    evaluate();
+  }
 }
 
 void EmergencyHandler::onMrmEmergencyStopStatus(
   const tier4_system_msgs::msg::MrmBehaviorStatus::ConstSharedPtr msg)
 {
+  const bool is_changed = mrm_emergency_stop_status_->state != msg->state;
+
   mrm_emergency_stop_status_ = msg;
+
+  if (is_changed) {
+    evaluate();
+  }
 }
 
 autoware_auto_vehicle_msgs::msg::HazardLightsCommand EmergencyHandler::createHazardCmdMsg()
@@ -312,6 +343,12 @@ bool EmergencyHandler::isDataReady()
 }
 
 void EmergencyHandler::onTimer()
+{
+  // Heartbeat: keep publishing and catch timeouts even if no input changes
+  evaluate();
+}
+
+void EmergencyHandler::evaluate()
 {
   if (!isDataReady()) {
     return;
@@ -18,6 +18,7 @@
 #include <diagnostic_msgs/msg/diagnostic_status.hpp>
 
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -98,6 +99,47 @@ inline std::vector<diagnostic_msgs::msg::DiagnosticStatus> extractLeafChildrenDi
   return leaf_children_diagnostics;
 }
 
+/**
+ * @brief index from a diagnostic name to its leaf descendants, built once per DiagnosticArray so
+ * that the leaf children of a diagnostic can be looked up without scanning all the diagnostics
+ */
+class DiagnosticsTree
+{
+public:
+  void build(const std::vector<diagnostic_msgs::msg::DiagnosticStatus> & diagnostics)
+  {
+    // Keep the keys and the capacities of the previous array, which mostly has the same names
+    for (auto & leaf_children : leaf_children_map_) {
+      leaf_children.second.clear();
+    }
+
+    const auto diag_name_set = createDiagNameSet(diagnostics);
+    for (size_t i = 0; i < diagnostics.size(); ++i) {
+      if (!isLeaf(diag_name_set, diagnostics.at(i))) {
+        continue;
+      }
+
+      // Same ancestors as isChild
+      auto name = splitStringByLastSlash(diagnostics.at(i).name);
+      while (name != "") {
+        leaf_children_map_[name].push_back(i);
+        name = splitStringByLastSlash(name);
+      }
+    }
+  }
+
+  // Indices of the leaf children of the parent in the diagnostics given to build()
+  const std::vector<size_t> & getLeafChildren(const std::string & parent_name) const
+  {
+    const auto itr = leaf_children_map_.find(parent_name);
+    return (itr != leaf_children_map_.end()) ? itr->second : empty_;
+  }
+
+private:
+  std::unordered_map<std::string, std::vector<size_t>> leaf_children_map_;
+  const std::vector<size_t> empty_;
+};
+
 }  // namespace diagnostics_filter
 
 #endif  // SYSTEM_ERROR_MONITOR__DIAGNOSTICS_FILTER_HPP_
@@ -15,6 +15,8 @@
 #ifndef SYSTEM_ERROR_MONITOR__SYSTEM_ERROR_MONITOR_CORE_HPP_
 #define SYSTEM_ERROR_MONITOR__SYSTEM_ERROR_MONITOR_CORE_HPP_
 
+#include "system_error_monitor/diagnostics_filter.hpp"
+
 #include <rclcpp/create_timer.hpp>
 #include <rclcpp/rclcpp.hpp>
 
@@ -27,7 +29,6 @@
 
 #include <boost/optional.hpp>
 
-#include <deque>
 #include <map>
 #include <string>
 #include <unordered_map>
@@ -39,7 +40,38 @@ struct DiagStamped
   diagnostic_msgs::msg::DiagnosticStatus status;
 };
 
-using DiagBuffer = std::deque<DiagStamped>;
+/**
+ * @brief fixed-capacity ring buffer of diagnostics, which overwrites the oldest one in place
+ */
+class DiagBuffer
+{
+public:
+  explicit DiagBuffer(const size_t capacity) : capacity_(capacity) { buffer_.reserve(capacity); }
+
+  void push_back(
+    const std_msgs::msg::Header & header, const diagnostic_msgs::msg::DiagnosticStatus & status)
+  {
+    if (buffer_.size() < capacity_) {
+      buffer_.push_back(DiagStamped{header, status});
+      latest_ = buffer_.size() - 1;
+      return;
+    }
+
+    // Assignment reuses the memory of the strings and the values of the oldest one
+    latest_ = (latest_ + 1) % capacity_;
+    buffer_.at(latest_).header = header;
+    buffer_.at(latest_).status = status;
+  }
+
+  bool empty() const { return buffer_.empty(); }
+  size_t size() const { return buffer_.size(); }
+  const DiagStamped & back() const { return buffer_.at(latest_); }
+
+private:
+  size_t capacity_;
+  size_t latest_ = 0;
+  std::vector<DiagStamped> buffer_;
+};
 
 struct DiagConfig
 {
@@ -111,6 +143,7 @@ private:
   const size_t diag_buffer_size_ = 100;
   std::unordered_map<std::string, DiagBuffer> diag_buffer_map_;
   diagnostic_msgs::msg::DiagnosticArray::ConstSharedPtr diag_array_;
+  diagnostics_filter::DiagnosticsTree diag_tree_;
   autoware_auto_system_msgs::msg::AutowareState::ConstSharedPtr autoware_state_;
   tier4_control_msgs::msg::GateMode::ConstSharedPtr current_gate_mode_;
   autoware_auto_vehicle_msgs::msg::ControlModeReport::ConstSharedPtr control_mode_;
@@ -339,16 +339,17 @@ void AutowareErrorMonitor::onDiagArray(
   const auto & header = msg->header;
 
   for (const auto & diag : msg->status) {
-    if (diag_buffer_map_.count(diag.name) == 0) {
-      diag_buffer_map_.insert(std::make_pair(diag.name, DiagBuffer{}));
+    auto itr = diag_buffer_map_.find(diag.name);
+    if (itr == diag_buffer_map_.end()) {
+      itr = diag_buffer_map_.emplace(diag.name, DiagBuffer(diag_buffer_size_)).first;
     }
 
-    auto & diag_buffer = diag_buffer_map_.at(diag.name);
-    diag_buffer.push_back(DiagStamped{header, diag});
+    itr->second.push_back(header, diag);
+  }
 
-    while (diag_buffer.size() > diag_buffer_size_) {
-      diag_buffer.pop_front();
-    }
+  // Index the leaf children once per array instead of once per required module
+  if (params_.add_leaf_diagnostics) {
+    diag_tree_.build(msg->status);
   }
 
   // for Heartbeat
@@ -472,11 +473,12 @@ void AutowareErrorMonitor::onTimer()
 boost::optional<DiagStamped> AutowareErrorMonitor::getLatestDiag(
   const std::string & diag_name) const
 {
-  if (diag_buffer_map_.count(diag_name) == 0) {
+  const auto itr = diag_buffer_map_.find(diag_name);
+  if (itr == diag_buffer_map_.end()) {
     return {};
   }
 
-  const auto & diag_buffer = diag_buffer_map_.at(diag_name);
+  const auto & diag_buffer = itr->second;
 
   if (diag_buffer.empty()) {
     return {};
@@ -513,9 +515,8 @@ void AutowareErrorMonitor::appendHazardDiag(
   target_diagnostics_ref.push_back(hazard_diag);
 
   if (params_.add_leaf_diagnostics) {
-    for (const auto & diag :
-         diagnostics_filter::extractLeafChildrenDiagnostics(hazard_diag, diag_array_->status)) {
-      target_diagnostics_ref.push_back(diag);
+    for (const auto index : diag_tree_.getLeafChildren(hazard_diag.name)) {
+      target_diagnostics_ref.push_back(diag_array_->status.at(index));
     }
   }
 
@@ -26,6 +26,7 @@
 #include <tier4_external_api_msgs/msg/cpu_usage.hpp>
 
 #include <climits>
+#include <cstdint>
 #include <map>
 #include <string>
 #include <vector>
@@ -54,9 +55,45 @@ typedef struct cpu_freq_info
   cpu_freq_info(int index, const std::string & path) : index_(index), path_(path) {}
 } cpu_freq_info;
 
+/**
+ * @brief CPU time counters of a cpu line of /proc/stat
+ */
+typedef struct cpu_stat_info
+{
+  uint64_t user_;        //!< @brief time in user mode, including guest
+  uint64_t nice_;        //!< @brief time in user mode with low priority, including guest_nice
+  uint64_t system_;      //!< @brief time in system mode
+  uint64_t idle_;        //!< @brief time in the idle task
+  uint64_t iowait_;      //!< @brief time waiting for I/O to complete
+  uint64_t irq_;         //!< @brief time servicing interrupts
+  uint64_t softirq_;     //!< @brief time servicing softirqs
+  uint64_t steal_;       //!< @brief stolen time
+  uint64_t guest_;       //!< @brief time running a virtual CPU for guest operating systems
+  uint64_t guest_nice_;  //!< @brief time running a niced guest
+
+  cpu_stat_info()
+  : user_(0),
+    nice_(0),
+    system_(0),
+    idle_(0),
+    iowait_(0),
+    irq_(0),
+    softirq_(0),
+    steal_(0),
+    guest_(0),
+    guest_nice_(0)
+  {
+  }
+} cpu_stat_info;
+
 class CPUMonitorBase : public rclcpp::Node
 {
 public:
+  /**
+   * @brief destructor
+   */
+  ~CPUMonitorBase() override;
+
   /**
    * @brief Update the diagnostic state.
    */
@@ -100,6 +137,24 @@ protected:
   virtual void checkUsage(
     diagnostic_updater::DiagnosticStatusWrapper & stat);  // NOLINT(runtime/references)
 
+  /**
+   * @brief check CPU usage with mpstat, measured over one second
+   * @param [out] stat diagnostic message passed directly to diagnostic publish calls
+   * @note NOLINT syntax is needed since diagnostic_updater asks for a non-const reference
+   * to pass diagnostic message updated in this function to diagnostic publish calls.
+   */
+  virtual void checkUsageByMpstat(
+    diagnostic_updater::DiagnosticStatusWrapper & stat);  // NOLINT(runtime/references)
+
+  /**
+   * @brief check CPU usage from the /proc/stat counters since the previous check
+   * @param [out] stat diagnostic message passed directly to diagnostic publish calls
+   * @note NOLINT syntax is needed since diagnostic_updater asks for a non-const reference
+   * to pass diagnostic message updated in this function to diagnostic publish calls.
+   */
+  virtual void checkUsageByProcStat(
+    diagnostic_updater::DiagnosticStatusWrapper & stat);  // NOLINT(runtime/references)
+
   /**
    * @brief convert Cpu Usage To diagnostic Level
    * @param [cpu_name] mpstat cpu name
@@ -133,6 +188,14 @@ protected:
   virtual void checkFrequency(
     diagnostic_updater::DiagnosticStatusWrapper & stat);  // NOLINT(runtime/references)
 
+  /**
+   * @brief read a whole procfs or sysfs file through a file descriptor kept open
+   * @param [in] path path of the file
+   * @param [out] content content of the file
+   * @return true on success
+   */
+  bool readFile(const std::string & path, std::string & content);
+
   diagnostic_updater::Updater updater_;  //!< @brief Updater class which advertises to /diagnostics
 
   char hostname_[HOST_NAME_MAX + 1];        //!< @brief host name
@@ -142,6 +205,7 @@ protected:
   std::vector<int> usage_warn_check_cnt_;   //!< @brief CPU list for usage over warn check counter
   std::vector<int> usage_error_check_cnt_;  //!< @brief CPU list for usage over error check counter
   bool mpstat_exists_;                      //!< @brief flag if mpstat exists
+  bool use_mpstat_;                         //!< @brief flag to get CPU usage from mpstat
 
   float usage_warn_;       //!< @brief CPU usage(%) to generate warning
   float usage_error_;      //!< @brief CPU usage(%) to generate error
@@ -149,6 +213,16 @@ protected:
   int usage_error_count_;  //!< @brief continuous count over usage_error_ to generate error
   bool usage_avg_;         //!< @brief Check CPU usage calculated as averages among all processors
 
+  /**
+   * @brief /proc/stat counters at the previous usage check, by cpu name ("all", "0", "1", ...)
+   */
+  std::map<std::string, cpu_stat_info> prev_cpu_stats_;
+
+  /**
+   * @brief file descriptors of the files read by readFile, by path
+   */
+  std::map<std::string, int> file_descriptors_;
+
   /**
    * @brief CPU temperature status messages
    */
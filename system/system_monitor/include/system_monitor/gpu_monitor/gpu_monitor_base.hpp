@@ -24,6 +24,7 @@
 
 #include <climits>
 #include <map>
+#include <mutex>
 #include <string>
 
 class GPUMonitorBase : public rclcpp::Node
@@ -96,6 +97,11 @@ protected:
   virtual void checkFrequency(
     diagnostic_updater::DiagnosticStatusWrapper & stat);  // NOLINT(runtime/references)
 
+  /**
+   * @brief timer callback to sample GPU metrics for the diagnostic callbacks
+   */
+  virtual void onTimer();
+
   diagnostic_updater::Updater updater_;  //!< @brief Updater class which advertises to /diagnostics
 
   char hostname_[HOST_NAME_MAX + 1];  //!< @brief host name
@@ -106,6 +112,11 @@ protected:
   float gpu_usage_error_;     //!< @brief GPU usage(%) to generate error
   float memory_usage_warn_;   //!< @brief GPU memory usage(%) to generate warning
   float memory_usage_error_;  //!< @brief GPU memory usage(%) to generate error
+  double sampling_period_;    //!< @brief period(sec) to sample GPU metrics
+
+  std::mutex mutex_;                                       //!< @brief mutex for sampled metrics
+  rclcpp::CallbackGroup::SharedPtr timer_callback_group_;  //!< @brief Callback Group
+  rclcpp::TimerBase::SharedPtr timer_;                     //!< @brief timer to sample GPU metrics
 
   /**
    * @brief GPU temperature status messages
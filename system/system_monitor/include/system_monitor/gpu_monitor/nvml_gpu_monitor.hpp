@@ -41,6 +41,39 @@
    : ((X)&nvmlClocksThrottleReasonDisplayClockSetting)       ? "DisplayClockSetting"       \
                                                              : "UNKNOWN")
 
+/**
+ * @brief GPU usage per process
+ */
+struct process_usage
+{
+  unsigned int pid;    //!< @brief process ID
+  std::string name;    //!< @brief process name
+  unsigned int usage;  //!< @brief SM utilization(%)
+};
+
+/**
+ * @brief GPU metrics sampled by the timer
+ */
+struct gpu_sample
+{
+  nvmlReturn_t temp_ret;                 //!< @brief result of getting temperature
+  unsigned int temp;                     //!< @brief GPU temperature(DegC)
+  nvmlReturn_t utilization_ret;          //!< @brief result of getting utilization rates
+  nvmlUtilization_t utilization;         //!< @brief Utilization information for a device
+  std::vector<process_usage> processes;  //!< @brief GPU usage per process
+  nvmlReturn_t memory_ret;               //!< @brief result of getting memory information
+  nvmlMemory_t memory;                   //!< @brief amount of used, free and total memory
+  nvmlReturn_t clock_ret;                //!< @brief result of getting graphics clock
+  unsigned int clock;                    //!< @brief graphics clock(MHz)
+  nvmlReturn_t throttle_ret;             //!< @brief result of getting throttling reasons
+  /**
+   * @brief latest throttling reasons, and the ones seen since the last report so that short
+   * throttling between reports is not missed
+   */
+  unsigned long long throttle_reasons;       // NOLINT(runtime/int)
+  unsigned long long throttle_reasons_seen;  // NOLINT(runtime/int)
+};
+
 /**
  * @brief GPU information
  */
@@ -49,8 +82,8 @@ struct gpu_info
   nvmlDevice_t device;                          //!< @brief handle for a particular device
   char name[NVML_DEVICE_NAME_BUFFER_SIZE];      //!< @brief name of device
   nvmlPciInfo_t pci;                            //!< @brief PCI information about a GPU device
-  nvmlUtilization_t utilization;                //!< @brief Utilization information for a device
   std::set<unsigned int> supported_gpu_clocks;  //!< @brief list of supported GPU clocks
+  gpu_sample sample;                            //!< @brief latest sampled metrics
 };
 
 class GPUMonitor : public GPUMonitorBase
@@ -92,11 +125,31 @@ protected:
   /**
    * @brief add stat of GPU usage per process
    * @param [in] index GPU index
-   * @param [in] device GPU device
+   * @param [in] processes GPU usage per process
    * @param [out] stat diagnostic message passed directly to diagnostic publish calls
    */
-  void addProcessUsage(
-    int index, nvmlDevice_t device, diagnostic_updater::DiagnosticStatusWrapper & stat);
+  static void addProcessUsage(
+    int index, const std::vector<process_usage> & processes,
+    diagnostic_updater::DiagnosticStatusWrapper & stat);
+
+  /**
+   * @brief sample all metrics of all GPUs
+   */
+  void onTimer() override;
+
+  /**
+   * @brief sample all metrics of a GPU
+   * @param [in] device GPU device
+   * @param [out] sample sampled metrics
+   */
+  void sampleGPU(nvmlDevice_t device, gpu_sample & sample);
+
+  /**
+   * @brief get GPU usage per process
+   * @param [in] device GPU device
+   * @param [out] processes GPU usage per process
+   */
+  void getProcessUsage(nvmlDevice_t device, std::vector<process_usage> & processes);
 
   /**
    * @brief check GPU memory usage
@@ -148,7 +201,7 @@ protected:
   static const size_t MAX_NAME_LENGTH = 128;
 
   std::vector<gpu_info> gpus_;      //!< @brief list of gpus
-  uint64_t current_timestamp_ = 0;  //!< @brief latest timestamp[usec] of addProcessUsage()
+  uint64_t current_timestamp_ = 0;  //!< @brief latest timestamp[usec] of getProcessUsage()
 
   /**
    * @brief GPU frequency status messages
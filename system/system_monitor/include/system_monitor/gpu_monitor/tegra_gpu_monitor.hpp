@@ -21,13 +21,16 @@
 
 #include "system_monitor/gpu_monitor/gpu_monitor_base.hpp"
 
+#include <map>
 #include <string>
 #include <vector>
 
 struct gpu_info
 {
-  std::string label_;  //!< @brief gpu label
-  std::string path_;   //!< @brief sysfs path to gpu temperature
+  std::string label_;    //!< @brief gpu label
+  std::string path_;     //!< @brief sysfs path to gpu temperature
+  bool is_read_{false};  //!< @brief whether the file was read by the last sample
+  std::string content_;  //!< @brief content of the file read by the last sample
 
   gpu_info() : label_(), path_() {}
   gpu_info(const std::string & l, const std::string & p) : label_(l), path_(p) {}
@@ -43,6 +46,11 @@ public:
    */
   explicit GPUMonitor(const rclcpp::NodeOptions & options);
 
+  /**
+   * @brief destructor
+   */
+  ~GPUMonitor() override;
+
 protected:
   /**
    * @brief check GPU temperature
@@ -80,6 +88,19 @@ protected:
   void checkFrequency(
     diagnostic_updater::DiagnosticStatusWrapper & stat) override;  // NOLINT(runtime/references)
 
+  /**
+   * @brief read all gpu files
+   */
+  void onTimer() override;
+
+  /**
+   * @brief read a file through a descriptor kept open
+   * @param [in] path path to the file
+   * @param [out] content content of the file
+   * @return true on success, false on error
+   */
+  bool readFile(const std::string & path, std::string & content);
+
   /**
    * @brief get names for gpu temperature files
    */
@@ -98,6 +119,8 @@ protected:
   std::vector<gpu_info> temps_;  //!< @brief GPU list for temperature
   std::vector<gpu_info> loads_;  //!< @brief GPU list for utilization
   std::vector<gpu_info> freqs_;  //!< @brief GPU list for frequency
+
+  std::map<std::string, int> file_descriptors_;  //!< @brief descriptors of the files kept open
 };
 
 #endif  // SYSTEM_MONITOR__GPU_MONITOR__TEGRA_GPU_MONITOR_HPP_
@@ -136,6 +136,11 @@ public:
    */
   explicit HddMonitor(const rclcpp::NodeOptions & options);
 
+  /**
+   * @brief destructor
+   */
+  ~HddMonitor() override;
+
 protected:
   using DiagStatus = diagnostic_msgs::msg::DiagnosticStatus;
 
@@ -270,6 +275,31 @@ protected:
    */
   std::string getDeviceFromMountPoint(const std::string & mount_point);
 
+  /**
+   * @brief connect to hdd_reader
+   * @param [out] error_command name of the failed function
+   * @param [out] error error message
+   * @return true on success
+   */
+  bool connectHddReader(std::string & error_command, std::string & error);
+
+  /**
+   * @brief close the connection to hdd_reader
+   */
+  void closeHddReader();
+
+  /**
+   * @brief send a request to hdd_reader and receive the response over the kept connection
+   * @param [in] request serialized request
+   * @param [out] response serialized response
+   * @param [out] error_command name of the failed function
+   * @param [out] error error message
+   * @return true on success
+   */
+  bool requestHddReader(
+    const std::string & request, std::string & response, std::string & error_command,
+    std::string & error);
+
   /**
    * @brief timer callback
    */
@@ -326,6 +356,7 @@ protected:
   char hostname_[HOST_NAME_MAX + 1];  //!< @brief host name
 
   int hdd_reader_port_;                         //!< @brief port number to connect to hdd_reader
+  int hdd_reader_socket_;                       //!< @brief socket connected to hdd_reader, or -1
   std::map<std::string, HddParam> hdd_params_;  //!< @brief list of error and warning levels
   std::map<std::string, bool>
     hdd_connected_flags_;  //!< @brief list of flag whether HDD is connected
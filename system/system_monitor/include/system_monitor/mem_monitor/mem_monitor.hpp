@@ -54,10 +54,10 @@ protected:
 
   /**
    * @brief get human-readable output for memory size
-   * @param [in] str size with bytes
+   * @param [in] bytes size with bytes
    * @return human-readable output
    */
-  std::string toHumanReadable(const std::string & str);
+  std::string toHumanReadable(size_t bytes);
 
   diagnostic_updater::Updater updater_;  //!< @brief Updater class which advertises to /diagnostics
 
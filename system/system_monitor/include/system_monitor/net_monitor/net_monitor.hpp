@@ -29,6 +29,7 @@
 
 #include <climits>
 #include <deque>
+#include <fstream>
 #include <map>
 #include <memory>
 #include <string>
@@ -171,6 +172,27 @@ protected:
    */
   void update_network_list();
 
+  /**
+   * @brief Send request to dump all links to routing netlink
+   * @return true on success, false on error
+   */
+  bool send_link_dump_request();
+
+  /**
+   * @brief Receive dump of all links from routing netlink and update network information
+   * @param [in] duration Time from previous measurement
+   * @return 0 on success, otherwise error code
+   */
+  int receive_link_dump(const rclcpp::Duration & duration);
+
+  /**
+   * @brief Update network information by using a link message of routing netlink
+   * @param [in] header Pointer to netlink message of RTM_NEWLINK
+   * @param [in] duration Time from previous measurement
+   */
+  void update_network_information_by_link_message(
+    struct nlmsghdr * header, const rclcpp::Duration & duration);
+
   /**
    * @brief Update network information by using socket
    * @param [out] network Network information
@@ -260,8 +282,9 @@ protected:
   /**
    * @brief Receive data from traffic-reader service
    * @param [out] result Status from traffic-reader service
+   * @return true on success, false on error
    */
-  void receive_data(traffic_reader_service::Result & result);
+  bool receive_data(traffic_reader_service::Result & result);
 
   /**
    * @brief Close connection with traffic-reader service
@@ -288,8 +311,12 @@ protected:
   rclcpp::Time last_update_time_;                //!< @brief last update time
   std::vector<std::string> device_params_;       //!< @brief list of devices
   NL80211 nl80211_;                              //!< @brief 802.11 netlink-based interface
-  int getifaddrs_error_code_;                    //!< @brief Error code set by getifaddrs()
+  int netlink_error_code_;                       //!< @brief Error code set by routing netlink
   std::vector<NetworkInfomation> network_list_;  //!< @brief List of Network information
+  int ioctl_socket_;                             //!< @brief Socket for ioctl() on interfaces
+  int netlink_socket_;                           //!< @brief Socket for routing netlink
+  unsigned int netlink_sequence_;                //!< @brief Sequence number of netlink request
+  std::vector<char> netlink_buffer_;             //!< @brief Buffer to receive netlink messages
 
   std::string monitor_program_;         //!< @brief nethogs monitor program name
   std::string socket_path_;             //!< @brief Path of UNIX domain socket
@@ -311,6 +338,7 @@ protected:
     reassembles_failed_check_count_;  //!< @brief IP packet reassembles failed check count threshold
   unsigned int reassembles_failed_column_index_;  //!< @brief column index of IP Reassembles failed
                                                   //!< in /proc/net/snmp
+  std::ifstream snmp_stream_;                     //!< @brief /proc/net/snmp kept open
 
   /**
    * @brief Network connection status messages
@@ -26,6 +26,10 @@
 
 #include <boost/process.hpp>
 
+#include <sys/types.h>
+
+#include <cstdint>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -33,6 +37,49 @@
 
 namespace bp = boost::process;
 
+/**
+ * @brief number of tasks by state
+ */
+typedef struct tasks_summary
+{
+  int total_;     //!< @brief total number of tasks
+  int running_;   //!< @brief number of running tasks
+  int sleeping_;  //!< @brief number of sleeping tasks
+  int stopped_;   //!< @brief number of stopped tasks
+  int zombie_;    //!< @brief number of zombie tasks
+
+  tasks_summary() : total_(0), running_(0), sleeping_(0), stopped_(0), zombie_(0) {}
+} tasks_summary;
+
+/**
+ * @brief process information read from /proc/[pid]/stat and /proc/[pid]/statm
+ */
+typedef struct process_info
+{
+  int pid_;              //!< @brief process id
+  uid_t uid_;            //!< @brief user id
+  char state_;           //!< @brief process state
+  int64_t priority_;     //!< @brief priority
+  int64_t nice_;         //!< @brief nice value
+  uint64_t virt_;        //!< @brief virtual memory size (KiB)
+  uint64_t res_;         //!< @brief resident size (KiB)
+  uint64_t shr_;         //!< @brief shared memory size (KiB)
+  uint64_t ticks_;       //!< @brief user and system CPU time (clock ticks)
+  uint64_t start_time_;  //!< @brief start time after system boot (clock ticks)
+  float cpu_;            //!< @brief CPU usage since the previous scan (%)
+  float mem_;            //!< @brief memory usage (%)
+  std::string command_;  //!< @brief command name
+} process_info;
+
+/**
+ * @brief CPU time of a process at the previous scan
+ */
+typedef struct process_ticks
+{
+  uint64_t ticks_;       //!< @brief user and system CPU time (clock ticks)
+  uint64_t start_time_;  //!< @brief start time after system boot, to detect reused pids
+} process_ticks;
+
 class ProcessMonitor : public rclcpp::Node
 {
 public:
@@ -54,6 +101,24 @@ protected:
   void monitorProcesses(
     diagnostic_updater::DiagnosticStatusWrapper & stat);  // NOLINT(runtime/references)
 
+  /**
+   * @brief monitor processes with the output of top command
+   * @param [out] stat diagnostic message passed directly to diagnostic publish calls
+   * @note NOLINT syntax is needed since diagnostic_updater asks for a non-const reference
+   * to pass diagnostic message updated in this function to diagnostic publish calls.
+   */
+  void monitorProcessesByTop(
+    diagnostic_updater::DiagnosticStatusWrapper & stat);  // NOLINT(runtime/references)
+
+  /**
+   * @brief monitor processes with the result of the last /proc scan
+   * @param [out] stat diagnostic message passed directly to diagnostic publish calls
+   * @note NOLINT syntax is needed since diagnostic_updater asks for a non-const reference
+   * to pass diagnostic message updated in this function to diagnostic publish calls.
+   */
+  void monitorProcessesByProcFs(
+    diagnostic_updater::DiagnosticStatusWrapper & stat);  // NOLINT(runtime/references)
+
   /**
    * @brief get task summary
    * @param [out] stat diagnostic message passed directly to diagnostic publish calls
@@ -107,15 +172,49 @@ protected:
     const std::string & error_command, const std::string & content);
 
   /**
-   * @brief timer callback to execute top command
+   * @brief set process information to diagnostics tasks
+   * @param [in] tasks list of diagnostics tasks
+   * @param [in] procs top-rated processes
+   */
+  void setProcessContent(
+    std::vector<std::shared_ptr<DiagTask>> * tasks, const std::vector<process_info> & procs);
+
+  /**
+   * @brief timer callback to execute top command or to scan /proc
    */
   void onTimer();
 
+  /**
+   * @brief execute top command
+   */
+  void executeTop();
+
+  /**
+   * @brief scan /proc for tasks summary and top-rated processes by CPU and memory usage
+   */
+  void scanProcFs();
+
+  /**
+   * @brief read a process from /proc/[pid]/stat and /proc/[pid]/statm
+   * @param [in] pid process id
+   * @param [out] proc process information
+   * @return true on success
+   */
+  bool readProcess(int pid, process_info & proc);
+
+  /**
+   * @brief get user name of user id
+   * @param [in] uid user id
+   * @return user name, or user id if not found
+   */
+  const std::string & getUserName(uid_t uid);
+
   diagnostic_updater::Updater updater_;  //!< @brief Updater class which advertises to /diagnostics
 
   char hostname_[HOST_NAME_MAX + 1];  //!< @brief host name
 
   int num_of_procs_;  //!< @brief number of processes to show
+  bool use_top_;      //!< @brief flag to get processes from top command
   std::vector<std::shared_ptr<DiagTask>>
     load_tasks_;  //!< @brief list of diagnostics tasks for high load procs
   std::vector<std::shared_ptr<DiagTask>>
@@ -127,6 +226,18 @@ protected:
   double elapsed_ms_;                   //!< @brief Execution time of top command
   std::mutex mutex_;                    //!< @brief mutex for output from top command
   rclcpp::CallbackGroup::SharedPtr timer_callback_group_;  //!< @brief Callback Group
+
+  bool is_scanned_;                              //!< @brief flag if /proc has been scanned
+  bool is_proc_error_;                           //!< @brief flag if a /proc error occurs
+  std::string proc_error_;                       //!< @brief error of /proc scan
+  tasks_summary tasks_summary_;                  //!< @brief tasks summary of the last scan
+  std::vector<process_info> high_load_procs_;    //!< @brief high load procs of the last scan
+  std::vector<process_info> high_memory_procs_;  //!< @brief high memory procs of the last scan
+  std::vector<process_info> procs_;              //!< @brief buffer of the processes in a scan
+  std::map<int, process_ticks> prev_ticks_;      //!< @brief CPU time by pid at the last scan
+  std::map<int, process_ticks> curr_ticks_;      //!< @brief CPU time by pid at the current scan
+  double prev_scan_time_;                        //!< @brief time of the last scan after boot (s)
+  std::map<uid_t, std::string> user_names_;      //!< @brief user name by user id
 };
 
 #endif  // SYSTEM_MONITOR__PROCESS_MONITOR__PROCESS_MONITOR_HPP_
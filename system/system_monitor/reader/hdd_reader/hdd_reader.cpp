@@ -573,62 +573,62 @@ void run(int port)
       return;
     }
 
-    // Receive list of device from a socket
-    char buf[1024]{};
-    ret = recv(new_sock, buf, sizeof(buf) - 1, 0);
-    if (ret < 0) {
-      syslog(LOG_ERR, "Failed to receive. %s\n", strerror(errno));
-      close(new_sock);
-      close(sock);
-      return;
-    }
-    // No data received
-    if (ret == 0) {
-      syslog(LOG_ERR, "No data received. %s\n", strerror(errno));
-      close(new_sock);
-      close(sock);
-      return;
-    }
-
-    uint8_t request_id;
+    // Serve requests until the client closes the connection
+    while (true) {
+      // Receive list of device from a socket
+      char buf[1024]{};
+      ret = recv(new_sock, buf, sizeof(buf) - 1, 0);
+      if (ret < 0) {
+        syslog(LOG_ERR, "Failed to receive. %s\n", strerror(errno));
+        close(new_sock);
+        close(sock);
+        return;
+      }
+      // Connection closed by the client
+      if (ret == 0) {
+        break;
+      }
 
-    buf[sizeof(buf) - 1] = '\0';
-    std::istringstream iss(buf);
-    boost::archive::text_iarchive ia(iss);
+      uint8_t request_id;
 
-    try {
-      ia & request_id;
-    } catch (const std::exception & e) {
-      syslog(LOG_ERR, "exception. %s\n", e.what());
-      close(new_sock);
-      close(sock);
-      return;
-    }
+      buf[sizeof(buf) - 1] = '\0';
+      std::istringstream iss(buf);
+      boost::archive::text_iarchive ia(iss);
 
-    std::ostringstream oss;
-    boost::archive::text_oarchive oa(oss);
+      try {
+        ia & request_id;
+      } catch (const std::exception & e) {
+        syslog(LOG_ERR, "exception. %s\n", e.what());
+        close(new_sock);
+        close(sock);
+        return;
+      }
 
-    switch (request_id) {
-      case HddReaderRequestId::GetHddInfo:
-        ret = get_hdd_info(ia, oa);
-        break;
-      case HddReaderRequestId::UnmountDevice:
-        ret = unmount_device_with_lazy(ia, oa);
-        break;
-      default:
-        syslog(LOG_ERR, "Request ID is invalid. %d\n", request_id);
-        continue;
-    }
-    if (ret != 0) {
-      close(new_sock);
-      close(sock);
-      return;
-    }
+      std::ostringstream oss;
+      boost::archive::text_oarchive oa(oss);
+
+      switch (request_id) {
+        case HddReaderRequestId::GetHddInfo:
+          ret = get_hdd_info(ia, oa);
+          break;
+        case HddReaderRequestId::UnmountDevice:
+          ret = unmount_device_with_lazy(ia, oa);
+          break;
+        default:
+          syslog(LOG_ERR, "Request ID is invalid. %d\n", request_id);
+          continue;
+      }
+      if (ret != 0) {
+        close(new_sock);
+        close(sock);
+        return;
+      }
 
-    // Write N bytes of BUF to FD
-    ret = write(new_sock, oss.str().c_str(), oss.str().length());
-    if (ret < 0) {
-      syslog(LOG_ERR, "Failed to write N bytes of BUF to FD. %s\n", strerror(errno));
+      // Write N bytes of BUF to FD
+      ret = write(new_sock, oss.str().c_str(), oss.str().length());
+      if (ret < 0) {
+        syslog(LOG_ERR, "Failed to write N bytes of BUF to FD. %s\n", strerror(errno));
+      }
     }
 
     // Close the file descriptor FD
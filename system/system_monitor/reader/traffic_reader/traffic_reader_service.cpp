@@ -78,19 +78,25 @@ void TrafficReaderService::run()
       continue;
     }
 
-    // Read data from socket
-    char buffer[1024]{};
-    socket_->read_some(boost::asio::buffer(buffer, sizeof(buffer)), error_code);
+    // Serve requests until the client closes the connection
+    while (true) {
+      // Read data from socket
+      char buffer[1024]{};
+      socket_->read_some(boost::asio::buffer(buffer, sizeof(buffer)), error_code);
+
+      // Connection closed by the client
+      if (error_code == boost::asio::error::eof) {
+        break;
+      }
+      if (error_code) {
+        syslog(LOG_ERR, "Failed to read data from socket. %s\n", error_code.message().c_str());
+        break;
+      }
 
-    if (error_code) {
-      syslog(LOG_ERR, "Failed to read data from socket. %s\n", error_code.message().c_str());
-      socket_->close();
-      continue;
+      // Handle message
+      handle_message(buffer);
     }
 
-    // Handle message
-    handle_message(buffer);
-
     socket_->close();
   }
 }
@@ -201,7 +207,9 @@ void TrafficReaderService::execute_nethogs()
   while (std::getline(is_out, line)) {
     // Exit loop when stop is requested
     std::lock_guard<std::mutex> lock(mutex_);
-    if (stop_) break;
+    if (stop_) {
+      break;
+    }
 
     // Skip if line is empty
     if (line.empty()) {
@@ -27,10 +27,16 @@
 #include <boost/property_tree/ptree.hpp>
 #include <boost/thread.hpp>
 
+#include <fcntl.h>
 #include <fmt/format.h>
+#include <unistd.h>
 
 #include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
 #include <regex>
+#include <sstream>
 #include <string>
 
 namespace bp = boost::process;
@@ -45,6 +51,7 @@ CPUMonitorBase::CPUMonitorBase(const std::string & node_name, const rclcpp::Node
   temps_(),
   freqs_(),
   mpstat_exists_(false),
+  use_mpstat_(declare_parameter<bool>("use_mpstat", false)),
   usage_warn_(declare_parameter<float>("usage_warn", 0.96)),
   usage_error_(declare_parameter<float>("usage_error", 0.96)),
   usage_warn_count_(declare_parameter<int>("usage_warn_count", 1)),
@@ -74,6 +81,13 @@ CPUMonitorBase::CPUMonitorBase(const std::string & node_name, const rclcpp::Node
     this->create_publisher<tier4_external_api_msgs::msg::CpuUsage>("~/cpu_usage", durable_qos);
 }
 
+CPUMonitorBase::~CPUMonitorBase()
+{
+  for (const auto & file_descriptor : file_descriptors_) {
+    close(file_descriptor.second);
+  }
+}
+
 void CPUMonitorBase::update() { updater_.force_update(); }
 
 void CPUMonitorBase::checkTemp(diagnostic_updater::DiagnosticStatusWrapper & stat)
@@ -91,17 +105,14 @@ void CPUMonitorBase::checkTemp(diagnostic_updater::DiagnosticStatusWrapper & sta
 
   for (auto itr = temps_.begin(); itr != temps_.end(); ++itr) {
     // Read temperature file
-    const fs::path path(itr->path_);
-    fs::ifstream ifs(path, std::ios::in);
-    if (!ifs) {
+    std::string content;
+    if (!readFile(itr->path_, content)) {
       stat.add("file open error", itr->path_);
       error_str = "file open error";
       continue;
     }
 
-    float temp;
-    ifs >> temp;
-    ifs.close();
+    float temp = std::strtof(content.c_str(), nullptr);
     temp /= 1000;
     stat.addf(itr->label_, "%.1f DegC", temp);
   }
@@ -117,6 +128,15 @@ void CPUMonitorBase::checkTemp(diagnostic_updater::DiagnosticStatusWrapper & sta
 }
 
 void CPUMonitorBase::checkUsage(diagnostic_updater::DiagnosticStatusWrapper & stat)
+{
+  if (use_mpstat_) {
+    checkUsageByMpstat(stat);
+  } else {
+    checkUsageByProcStat(stat);
+  }
+}
+
+void CPUMonitorBase::checkUsageByMpstat(diagnostic_updater::DiagnosticStatusWrapper & stat)
 {
   // Remember start time to measure elapsed time
   const auto t_start = SystemMonitorUtility::startMeasurement();
@@ -275,6 +295,108 @@ void CPUMonitorBase::checkUsage(diagnostic_updater::DiagnosticStatusWrapper & st
   SystemMonitorUtility::stopMeasurement(t_start, stat);
 }
 
+void CPUMonitorBase::checkUsageByProcStat(diagnostic_updater::DiagnosticStatusWrapper & stat)
+{
+  // Remember start time to measure elapsed time
+  const auto t_start = SystemMonitorUtility::startMeasurement();
+
+  tier4_external_api_msgs::msg::CpuUsage cpu_usage;
+  using CpuStatus = tier4_external_api_msgs::msg::CpuStatus;
+
+  std::string content;
+  if (!readFile("/proc/stat", content)) {
+    stat.summary(DiagStatus::ERROR, "stat error");
+    stat.add("/proc/stat", strerror(errno));
+    cpu_usage.all.status = CpuStatus::STALE;
+    publishCpuUsage(cpu_usage);
+    return;
+  }
+
+  int whole_level = DiagStatus::OK;
+  std::istringstream iss(content);
+  std::string line;
+  // the cpu lines come first: "cpu" for all the cpus, then "cpu0", "cpu1", ...
+  while (std::getline(iss, line) && line.compare(0, 3, "cpu") == 0) {
+    cpu_stat_info curr;
+    char name[32];
+    if (
+      sscanf(
+        line.c_str(),
+        "%31s %" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64
+        " %" SCNu64 " %" SCNu64 " %" SCNu64,
+        name, &curr.user_, &curr.nice_, &curr.system_, &curr.idle_, &curr.iowait_, &curr.irq_,
+        &curr.softirq_, &curr.steal_, &curr.guest_, &curr.guest_nice_) < 5) {
+      continue;
+    }
+    const std::string cpu_name = (std::string(name) == "cpu") ? "all" : std::string(name + 3);
+
+    // usage since the previous check, or since boot for the first check
+    cpu_stat_info & prev = prev_cpu_stats_[cpu_name];
+    auto delta = [](const uint64_t curr_value, const uint64_t prev_value) {
+      return static_cast<float>(curr_value > prev_value ? curr_value - prev_value : 0);
+    };
+    const float user = delta(curr.user_, prev.user_);
+    const float nice_time = delta(curr.nice_, prev.nice_);
+    const float system = delta(curr.system_, prev.system_);
+    const float idle_time = delta(curr.idle_, prev.idle_);
+    const float iowait_time = delta(curr.iowait_, prev.iowait_);
+    const float guest = delta(curr.guest_, prev.guest_);
+    const float guest_nice = delta(curr.guest_nice_, prev.guest_nice_);
+    // guest time is already accounted in user and nice time
+    const float total_time = user + nice_time + system + idle_time + iowait_time +
+                             delta(curr.irq_, prev.irq_) + delta(curr.softirq_, prev.softirq_) +
+                             delta(curr.steal_, prev.steal_);
+    prev = curr;
+
+    CpuStatus cpu_status;
+    float iowait{0.0};
+    if (total_time > 0.0) {
+      cpu_status.usr = std::max(user - guest, 0.0f) / total_time * 100.0;
+      cpu_status.nice = std::max(nice_time - guest_nice, 0.0f) / total_time * 100.0;
+      cpu_status.sys = system / total_time * 100.0;
+      cpu_status.idle = idle_time / total_time * 100.0;
+      iowait = iowait_time / total_time * 100.0;
+    } else {
+      cpu_status.idle = 100.0;
+    }
+
+    const float total = 100.0 - iowait - cpu_status.idle;
+    const int level = CpuUsageToLevel(cpu_name, total * 1e-2);
+
+    cpu_status.total = total;
+    cpu_status.status = level;
+
+    stat.add(fmt::format("CPU {}: status", cpu_name), load_dict_.at(level));
+    stat.addf(fmt::format("CPU {}: total", cpu_name), "%.2f%%", total);
+    stat.addf(fmt::format("CPU {}: usr", cpu_name), "%.2f%%", cpu_status.usr);
+    stat.addf(fmt::format("CPU {}: nice", cpu_name), "%.2f%%", cpu_status.nice);
+    stat.addf(fmt::format("CPU {}: sys", cpu_name), "%.2f%%", cpu_status.sys);
+    stat.addf(fmt::format("CPU {}: idle", cpu_name), "%.2f%%", cpu_status.idle);
+
+    if (usage_avg_ == true) {
+      if (cpu_name == "all") {
+        whole_level = level;
+      }
+    } else {
+      whole_level = std::max(whole_level, level);
+    }
+
+    if (cpu_name == "all") {
+      cpu_usage.all = cpu_status;
+    } else {
+      cpu_usage.cpus.push_back(cpu_status);
+    }
+  }
+
+  stat.summary(whole_level, load_dict_.at(whole_level));
+
+  // Publish msg
+  publishCpuUsage(cpu_usage);
+
+  // Measure elapsed time since start time and report
+  SystemMonitorUtility::stopMeasurement(t_start, stat);
+}
+
 int CPUMonitorBase::CpuUsageToLevel(const std::string & cpu_name, float usage)
 {
   // cpu name to counter index
@@ -379,15 +501,11 @@ void CPUMonitorBase::checkFrequency(diagnostic_updater::DiagnosticStatusWrapper
 
   for (auto itr = freqs_.begin(); itr != freqs_.end(); ++itr) {
     // Read scaling_cur_freq file
-    const fs::path path(itr->path_);
-    fs::ifstream ifs(path, std::ios::in);
-    if (ifs) {
-      std::string line;
-      if (std::getline(ifs, line)) {
-        stat.addf(fmt::format("CPU {}: clock", itr->index_), "%d MHz", std::stoi(line) / 1000);
-      }
+    std::string content;
+    if (readFile(itr->path_, content) && !content.empty()) {
+      stat.addf(
+        fmt::format("CPU {}: clock", itr->index_), "%d MHz", std::atoi(content.c_str()) / 1000);
     }
-    ifs.close();
   }
 
   stat.summary(DiagStatus::OK, "OK");
@@ -396,6 +514,37 @@ void CPUMonitorBase::checkFrequency(diagnostic_updater::DiagnosticStatusWrapper
   SystemMonitorUtility::stopMeasurement(t_start, stat);
 }
 
+bool CPUMonitorBase::readFile(const std::string & path, std::string & content)
+{
+  auto itr = file_descriptors_.find(path);
+  if (itr == file_descriptors_.end()) {
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      return false;
+    }
+    itr = file_descriptors_.emplace(path, fd).first;
+  }
+
+  // procfs and sysfs files are generated again when read from the beginning
+  content.clear();
+  char buffer[4096];
+  off_t offset = 0;
+  while (true) {
+    const ssize_t size = pread(itr->second, buffer, sizeof(buffer), offset);
+    if (size < 0) {
+      close(itr->second);
+      file_descriptors_.erase(itr);
+      return false;
+    }
+    if (size == 0) {
+      break;
+    }
+    content.append(buffer, size);
+    offset += size;
+  }
+  return true;
+}
+
 void CPUMonitorBase::getTempNames()
 {
   RCLCPP_INFO(this->get_logger(), "CPUMonitorBase::getTempNames not implemented.");
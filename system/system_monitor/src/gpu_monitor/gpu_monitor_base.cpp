@@ -32,7 +32,8 @@ GPUMonitorBase::GPUMonitorBase(const std::string & node_name, const rclcpp::Node
   gpu_usage_warn_(declare_parameter<float>("gpu_usage_warn", 0.90)),
   gpu_usage_error_(declare_parameter<float>("gpu_usage_error", 1.00)),
   memory_usage_warn_(declare_parameter<float>("memory_usage_warn", 0.95)),
-  memory_usage_error_(declare_parameter<float>("memory_usage_error", 0.99))
+  memory_usage_error_(declare_parameter<float>("memory_usage_error", 0.99)),
+  sampling_period_(declare_parameter<double>("sampling_period", 1.0))
 {
   gethostname(hostname_, sizeof(hostname_));
 
@@ -42,9 +43,19 @@ GPUMonitorBase::GPUMonitorBase(const std::string & node_name, const rclcpp::Node
   updater_.add("GPU Memory Usage", this, &GPUMonitorBase::checkMemoryUsage);
   updater_.add("GPU Thermal Throttling", this, &GPUMonitorBase::checkThrottling);
   updater_.add("GPU Frequency", this, &GPUMonitorBase::checkFrequency);
+
+  // Start timer to sample GPU metrics, the diagnostic callbacks only read the samples
+  timer_callback_group_ = this->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+  timer_ = rclcpp::create_timer(
+    this, get_clock(), rclcpp::Duration::from_seconds(sampling_period_), [this]() { onTimer(); },
+    timer_callback_group_);
 }
 
-void GPUMonitorBase::update() { updater_.force_update(); }
+void GPUMonitorBase::update()
+{
+  onTimer();
+  updater_.force_update();
+}
 
 void GPUMonitorBase::shut_down()
 { /*NOOP by default.*/
@@ -74,3 +85,7 @@ void GPUMonitorBase::checkFrequency(diagnostic_updater::DiagnosticStatusWrapper
 {
   RCLCPP_INFO_ONCE(get_logger(), "GPUMonitorBase::checkFrequency not implemented.");
 }
+
+void GPUMonitorBase::onTimer()
+{ /*NOOP by default.*/
+}
@@ -30,6 +30,7 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 GPUMonitor::GPUMonitor(const rclcpp::NodeOptions & options) : GPUMonitorBase("gpu_monitor", options)
@@ -75,6 +76,9 @@ GPUMonitor::GPUMonitor(const rclcpp::NodeOptions & options) : GPUMonitorBase("gp
     }
     gpus_.push_back(info);
   }
+
+  // Take the first sample before the first diagnostics
+  onTimer();
 }
 
 void GPUMonitor::shut_down()
@@ -99,9 +103,11 @@ void GPUMonitor::checkTemp(diagnostic_updater::DiagnosticStatusWrapper & stat)
     return;
   }
 
+  std::lock_guard<std::mutex> lock(mutex_);
+
   for (auto itr = gpus_.begin(); itr != gpus_.end(); ++itr, ++index) {
-    unsigned int temp = 0;
-    ret = nvmlDeviceGetTemperature(itr->device, NVML_TEMPERATURE_GPU, &temp);
+    const unsigned int temp = itr->sample.temp;
+    ret = itr->sample.temp_ret;
     if (ret != NVML_SUCCESS) {
       stat.summary(DiagStatus::ERROR, "Failed to retrieve the current temperature");
       stat.add(fmt::format("GPU {}: name", index), itr->name);
@@ -140,8 +146,10 @@ void GPUMonitor::checkUsage(diagnostic_updater::DiagnosticStatusWrapper & stat)
     return;
   }
 
+  std::lock_guard<std::mutex> lock(mutex_);
+
   for (auto itr = gpus_.begin(); itr != gpus_.end(); ++itr, ++index) {
-    ret = nvmlDeviceGetUtilizationRates(itr->device, &itr->utilization);
+    ret = itr->sample.utilization_ret;
     if (ret != NVML_SUCCESS) {
       stat.summary(DiagStatus::ERROR, "Failed to retrieve the current utilization rates");
       stat.add(fmt::format("GPU {}: name", index), itr->name);
@@ -151,7 +159,7 @@ void GPUMonitor::checkUsage(diagnostic_updater::DiagnosticStatusWrapper & stat)
     }
 
     level = DiagStatus::OK;
-    float usage = static_cast<float>(itr->utilization.gpu) / 100.0;
+    float usage = static_cast<float>(itr->sample.utilization.gpu) / 100.0;
     if (usage >= gpu_usage_error_) {
       level = std::max(level, static_cast<int>(DiagStatus::ERROR));
     } else if (usage >= gpu_usage_warn_) {
@@ -160,9 +168,9 @@ void GPUMonitor::checkUsage(diagnostic_updater::DiagnosticStatusWrapper & stat)
 
     stat.add(fmt::format("GPU {}: status", index), load_dict_.at(level));
     stat.add(fmt::format("GPU {}: name", index), itr->name);
-    stat.addf(fmt::format("GPU {}: usage", index), "%d.0%%", itr->utilization.gpu);
+    stat.addf(fmt::format("GPU {}: usage", index), "%d.0%%", itr->sample.utilization.gpu);
 
-    addProcessUsage(index, itr->device, stat);
+    addProcessUsage(index, itr->sample.processes, stat);
 
     whole_level = std::max(whole_level, level);
   }
@@ -174,7 +182,19 @@ void GPUMonitor::checkUsage(diagnostic_updater::DiagnosticStatusWrapper & stat)
 }
 
 void GPUMonitor::addProcessUsage(
-  int index, nvmlDevice_t device, diagnostic_updater::DiagnosticStatusWrapper & stat)
+  int index, const std::vector<process_usage> & processes,
+  diagnostic_updater::DiagnosticStatusWrapper & stat)
+{
+  int add_cnt = 0;
+  for (const auto & process : processes) {
+    stat.add(fmt::format("GPU {0}: process {1}: pid", index, add_cnt), process.pid);
+    stat.add(fmt::format("GPU {0}: process {1}: name", index, add_cnt), process.name);
+    stat.addf(fmt::format("GPU {0}: process {1}: usage", index, add_cnt), "%ld.0%%", process.usage);
+    ++add_cnt;
+  }
+}
+
+void GPUMonitor::getProcessUsage(nvmlDevice_t device, std::vector<process_usage> & processes)
 {
   nvmlReturn_t ret{};
   std::list<uint32_t> running_pid_list;
@@ -235,20 +255,15 @@ void GPUMonitor::addProcessUsage(
     return;
   }
 
-  // Add data to diagnostic
-  int add_cnt = 0;
+  // Add data to list
   for (uint32_t cnt = 0; cnt < util_count; ++cnt) {
     for (auto pid : running_pid_list) {
       // PID check, because it contains illegal PID data. ex) PID:0
       if (utils[cnt].pid == pid) {
         char name[MAX_NAME_LENGTH + 1] = {};
         nvmlSystemGetProcessName(utils[cnt].pid, name, MAX_NAME_LENGTH);
-        stat.add(fmt::format("GPU {0}: process {1}: pid", index, add_cnt), utils[cnt].pid);
-        stat.add(fmt::format("GPU {0}: process {1}: name", index, add_cnt), name);
-        stat.addf(
-          fmt::format("GPU {0}: process {1}: usage", index, add_cnt), "%ld.0%%",
-          ((utils[cnt].smUtil != UINT32_MAX) ? utils[cnt].smUtil : 0));
-        ++add_cnt;
+        processes.push_back(
+          {utils[cnt].pid, name, ((utils[cnt].smUtil != UINT32_MAX) ? utils[cnt].smUtil : 0)});
         break;
       }
     }
@@ -274,9 +289,11 @@ void GPUMonitor::checkMemoryUsage(diagnostic_updater::DiagnosticStatusWrapper &
     return;
   }
 
+  std::lock_guard<std::mutex> lock(mutex_);
+
   for (auto itr = gpus_.begin(); itr != gpus_.end(); ++itr, ++index) {
-    nvmlMemory_t memory;
-    ret = nvmlDeviceGetMemoryInfo(itr->device, &memory);
+    const nvmlMemory_t & memory = itr->sample.memory;
+    ret = itr->sample.memory_ret;
     if (ret != NVML_SUCCESS) {
       stat.summary(
         DiagStatus::ERROR, "Failed to retrieve the amount of used, free and total memory");
@@ -287,7 +304,7 @@ void GPUMonitor::checkMemoryUsage(diagnostic_updater::DiagnosticStatusWrapper &
     }
 
     level = DiagStatus::OK;
-    float usage = static_cast<float>(itr->utilization.memory) / 100.0;
+    float usage = static_cast<float>(itr->sample.utilization.memory) / 100.0;
     if (usage >= memory_usage_error_) {
       level = std::max(level, static_cast<int>(DiagStatus::ERROR));
     } else if (usage >= memory_usage_warn_) {
@@ -296,7 +313,7 @@ void GPUMonitor::checkMemoryUsage(diagnostic_updater::DiagnosticStatusWrapper &
 
     stat.add(fmt::format("GPU {}: status", index), load_dict_.at(level));
     stat.add(fmt::format("GPU {}: name", index), itr->name);
-    stat.addf(fmt::format("GPU {}: usage", index), "%d.0%%", itr->utilization.memory);
+    stat.addf(fmt::format("GPU {}: usage", index), "%d.0%%", itr->sample.utilization.memory);
     stat.add(fmt::format("GPU {}: total", index), toHumanReadable(memory.total));
     stat.add(fmt::format("GPU {}: used", index), toHumanReadable(memory.used));
     stat.add(fmt::format("GPU {}: free", index), toHumanReadable(memory.free));
@@ -326,9 +343,11 @@ void GPUMonitor::checkThrottling(diagnostic_updater::DiagnosticStatusWrapper & s
     return;
   }
 
+  std::lock_guard<std::mutex> lock(mutex_);
+
   for (auto itr = gpus_.begin(); itr != gpus_.end(); ++itr, ++index) {
-    unsigned int clock = 0;
-    ret = nvmlDeviceGetClockInfo(itr->device, NVML_CLOCK_GRAPHICS, &clock);
+    const unsigned int clock = itr->sample.clock;
+    ret = itr->sample.clock_ret;
     if (ret != NVML_SUCCESS) {
       stat.summary(DiagStatus::ERROR, "Failed to retrieve the current clock speeds");
       stat.add(fmt::format("GPU {}: name", index), itr->name);
@@ -337,8 +356,11 @@ void GPUMonitor::checkThrottling(diagnostic_updater::DiagnosticStatusWrapper & s
       return;
     }
 
-    unsigned long long clocksThrottleReasons = 0LL;  // NOLINT
-    ret = nvmlDeviceGetCurrentClocksThrottleReasons(itr->device, &clocksThrottleReasons);
+    // Report the reasons seen since the last report as well as the latest ones
+    unsigned long long clocksThrottleReasons =  // NOLINT
+      itr->sample.throttle_reasons | itr->sample.throttle_reasons_seen;
+    itr->sample.throttle_reasons_seen = 0LL;
+    ret = itr->sample.throttle_ret;
     if (ret != NVML_SUCCESS) {
       stat.summary(DiagStatus::ERROR, "Failed to retrieve current clocks throttling reasons");
       stat.add(fmt::format("GPU {}: name", index), itr->name);
@@ -411,10 +433,12 @@ void GPUMonitor::checkFrequency(diagnostic_updater::DiagnosticStatusWrapper & st
     return;
   }
 
+  std::lock_guard<std::mutex> lock(mutex_);
+
   for (auto itr = gpus_.begin(); itr != gpus_.end(); ++itr, ++index) {
     int level = DiagStatus::OK;
-    unsigned int clock = 0;
-    ret = nvmlDeviceGetClockInfo(itr->device, NVML_CLOCK_GRAPHICS, &clock);
+    const unsigned int clock = itr->sample.clock;
+    ret = itr->sample.clock_ret;
     if (ret != NVML_SUCCESS) {
       stat.summary(DiagStatus::ERROR, "Failed to retrieve the current clock speeds");
       stat.add(fmt::format("GPU {}: name", index), itr->name);
@@ -440,6 +464,31 @@ void GPUMonitor::checkFrequency(diagnostic_updater::DiagnosticStatusWrapper & st
   SystemMonitorUtility::stopMeasurement(t_start, stat);
 }
 
+void GPUMonitor::onTimer()
+{
+  for (auto & gpu : gpus_) {
+    // Sample without the lock, NVML calls can take a while
+    gpu_sample sample{};
+    sampleGPU(gpu.device, sample);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    sample.throttle_reasons_seen = gpu.sample.throttle_reasons_seen | sample.throttle_reasons;
+    gpu.sample = std::move(sample);
+  }
+}
+
+void GPUMonitor::sampleGPU(nvmlDevice_t device, gpu_sample & sample)
+{
+  sample.temp_ret = nvmlDeviceGetTemperature(device, NVML_TEMPERATURE_GPU, &sample.temp);
+  sample.utilization_ret = nvmlDeviceGetUtilizationRates(device, &sample.utilization);
+  if (sample.utilization_ret == NVML_SUCCESS) {
+    getProcessUsage(device, sample.processes);
+  }
+  sample.memory_ret = nvmlDeviceGetMemoryInfo(device, &sample.memory);
+  sample.clock_ret = nvmlDeviceGetClockInfo(device, NVML_CLOCK_GRAPHICS, &sample.clock);
+  sample.throttle_ret = nvmlDeviceGetCurrentClocksThrottleReasons(device, &sample.throttle_reasons);
+}
+
 bool GPUMonitor::getSupportedGPUClocks(
   int index, nvmlDevice_t & device, std::set<unsigned int> & supported_gpu_clocks)
 {
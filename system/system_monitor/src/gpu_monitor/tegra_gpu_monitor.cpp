@@ -23,9 +23,12 @@
 
 #include <boost/filesystem.hpp>
 
+#include <fcntl.h>
 #include <fmt/format.h>
+#include <unistd.h>
 
 #include <algorithm>
+#include <cstdlib>
 #include <regex>
 #include <string>
 #include <vector>
@@ -43,6 +46,16 @@ GPUMonitor::GPUMonitor(const rclcpp::NodeOptions & options) : GPUMonitorBase("gp
   // There is no event record for thermal throttling.
   // Need to manually monitor temperature to figure out if thermal limits crossed or not.
   updater_.removeByName("GPU Thermal Throttling");
+
+  // Take the first sample before the first diagnostics
+  onTimer();
+}
+
+GPUMonitor::~GPUMonitor()
+{
+  for (const auto & file_descriptor : file_descriptors_) {
+    close(file_descriptor.second);
+  }
 }
 
 void GPUMonitor::checkTemp(diagnostic_updater::DiagnosticStatusWrapper & stat)
@@ -55,19 +68,17 @@ void GPUMonitor::checkTemp(diagnostic_updater::DiagnosticStatusWrapper & stat)
   int level = DiagStatus::OK;
   std::string error_str;
 
+  std::lock_guard<std::mutex> lock(mutex_);
+
   for (const auto & itr : temps_) {
-    // Read temperature file
-    const fs::path path(itr.path_);
-    fs::ifstream ifs(path, std::ios::in);
-    if (!ifs) {
+    // Temperature file read by the last sample
+    if (!itr.is_read_) {
       stat.add("file open error", itr.path_);
       error_str = "file open error";
       continue;
     }
 
-    float temp{};
-    ifs >> temp;
-    ifs.close();
+    float temp = std::strtof(itr.content_.c_str(), nullptr);
     temp /= 1000;
     stat.addf(itr.label_, "%.1f DegC", temp);
 
@@ -96,19 +107,17 @@ void GPUMonitor::checkUsage(diagnostic_updater::DiagnosticStatusWrapper & stat)
   int level = DiagStatus::OK;
   std::string error_str;
 
+  std::lock_guard<std::mutex> lock(mutex_);
+
   for (const auto & itr : loads_) {
-    // Read load file
-    const fs::path path(itr.path_);
-    fs::ifstream ifs(path, std::ios::in);
-    if (!ifs) {
+    // Load file read by the last sample
+    if (!itr.is_read_) {
       stat.add("file open error", itr.path_);
       error_str = "file open error";
       continue;
     }
 
-    float load{};
-    ifs >> load;
-    ifs.close();
+    float load = std::strtof(itr.content_.c_str(), nullptr);
     stat.addf(itr.label_, "%.1f%%", load / 10);
 
     level = DiagStatus::OK;
@@ -141,22 +150,61 @@ void GPUMonitor::checkFrequency(diagnostic_updater::DiagnosticStatusWrapper & st
     return;
   }
 
+  std::lock_guard<std::mutex> lock(mutex_);
+
   for (const auto & freq : freqs_) {
-    // Read cur_freq file
-    const fs::path path(freq.path_);
-    fs::ifstream ifs(path, std::ios::in);
-    if (ifs) {
-      std::string line;
-      if (std::getline(ifs, line)) {
-        stat.addf(fmt::format("GPU {}: clock", freq.label_), "%d MHz", std::stoi(line) / 1000000);
-      }
+    // cur_freq file read by the last sample
+    if (freq.is_read_ && !freq.content_.empty()) {
+      stat.addf(
+        fmt::format("GPU {}: clock", freq.label_), "%d MHz", std::stoi(freq.content_) / 1000000);
     }
-    ifs.close();
   }
 
   stat.summary(DiagStatus::OK, "OK");
 }
 
+void GPUMonitor::onTimer()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  for (auto * list : {&temps_, &loads_, &freqs_}) {
+    for (auto & itr : *list) {
+      itr.is_read_ = readFile(itr.path_, itr.content_);
+    }
+  }
+}
+
+bool GPUMonitor::readFile(const std::string & path, std::string & content)
+{
+  auto itr = file_descriptors_.find(path);
+  if (itr == file_descriptors_.end()) {
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      return false;
+    }
+    itr = file_descriptors_.emplace(path, fd).first;
+  }
+
+  // sysfs files are generated again when read from the beginning
+  content.clear();
+  char buffer[4096];
+  off_t offset = 0;
+  while (true) {
+    const ssize_t size = pread(itr->second, buffer, sizeof(buffer), offset);
+    if (size < 0) {
+      close(itr->second);
+      file_descriptors_.erase(itr);
+      return false;
+    }
+    if (size == 0) {
+      break;
+    }
+    content.append(buffer, size);
+    offset += size;
+  }
+  return true;
+}
+
 void GPUMonitor::getTempNames()
 {
   // Jetson TX1 TX2 Nano: thermal_zone1, Xavier: thermal_zone0
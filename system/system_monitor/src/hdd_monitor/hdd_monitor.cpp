@@ -26,23 +26,29 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/archive/text_iarchive.hpp>
 #include <boost/archive/text_oarchive.hpp>
-#include <boost/process.hpp>
 #include <boost/serialization/vector.hpp>
 
 #include <fmt/format.h>
+#include <mntent.h>
+#include <netinet/in.h>
 #include <stdio.h>
+#include <sys/socket.h>
+#include <sys/statvfs.h>
+#include <unistd.h>
 
 #include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <filesystem>
+#include <regex>
 #include <string>
 #include <vector>
 
-namespace bp = boost::process;
-
 HddMonitor::HddMonitor(const rclcpp::NodeOptions & options)
 : Node("hdd_monitor", options),
   updater_(this),
   hdd_reader_port_(declare_parameter<int>("hdd_reader_port", 7635)),
+  hdd_reader_socket_(-1),
   last_hdd_stat_update_time_{0, 0, this->get_clock()->get_clock_type()}
 {
   using namespace std::literals::chrono_literals;
@@ -75,6 +81,8 @@ HddMonitor::HddMonitor(const rclcpp::NodeOptions & options)
   timer_ = rclcpp::create_timer(this, get_clock(), 1s, std::bind(&HddMonitor::onTimer, this));
 }
 
+HddMonitor::~HddMonitor() { closeHddReader(); }
+
 void HddMonitor::checkSmartTemperature(diagnostic_updater::DiagnosticStatusWrapper & stat)
 {
   checkSmart(stat, HddSmartInfoItem::TEMPERATURE);
@@ -251,97 +259,44 @@ void HddMonitor::checkUsage(diagnostic_updater::DiagnosticStatusWrapper & stat)
       continue;
     }
 
-    // Get summary of disk space usage of ext4
-
-    // boost::process create file descriptor without O_CLOEXEC required for multithreading.
-    // So create file descriptor with O_CLOEXEC and pass it to boost::process.
-    int out_fd[2];
-    if (pipe2(out_fd, O_CLOEXEC) != 0) {
-      error_str = "pipe2 error";
-      stat.add(fmt::format("HDD {}: status", hdd_index), "pipe2 error");
+    // Get summary of disk space usage of the file system mounted on the mount point
+    struct statvfs buf;
+    if (statvfs(itr->first.c_str(), &buf) != 0) {
+      error_str = "statvfs error";
+      stat.add(fmt::format("HDD {}: status", hdd_index), "statvfs error");
       stat.add(fmt::format("HDD {}: name", hdd_index), itr->first.c_str());
-      stat.add(fmt::format("HDD {}: pipe2", hdd_index), strerror(errno));
+      stat.add(fmt::format("HDD {}: statvfs", hdd_index), strerror(errno));
       continue;
     }
-    bp::pipe out_pipe{out_fd[0], out_fd[1]};
-    bp::ipstream is_out{std::move(out_pipe)};
 
-    int err_fd[2];
-    if (pipe2(err_fd, O_CLOEXEC) != 0) {
-      error_str = "pipe2 error";
-      stat.add(fmt::format("HDD {}: status", hdd_index), "pipe2 error");
-      stat.add(fmt::format("HDD {}: name", hdd_index), itr->first.c_str());
-      stat.add(fmt::format("HDD {}: pipe2", hdd_index), strerror(errno));
-      continue;
-    }
-    bp::pipe err_pipe{err_fd[0], err_fd[1]};
-    bp::ipstream is_err{std::move(err_pipe)};
-
-    // Invoke shell to use shell wildcard expansion
-    bp::child c(
-      "/bin/sh", "-c", fmt::format("df -Pm {}*", itr->second.part_device_.c_str()),
-      bp::std_out > is_out, bp::std_err > is_err);
-    c.wait();
-
-    if (c.exit_code() != 0) {
-      std::ostringstream os;
-      is_err >> os.rdbuf();
-      error_str = "df error";
-      stat.add(fmt::format("HDD {}: status", hdd_index), "df error");
-      stat.add(fmt::format("HDD {}: name", hdd_index), itr->second.part_device_.c_str());
-      stat.add(fmt::format("HDD {}: df", hdd_index), os.str().c_str());
-      continue;
-    }
+    // same as df -Pm, which rounds up to MiB
+    const double mib = 1024.0 * 1024.0;
+    const uint64_t used_blocks = buf.f_blocks - buf.f_bfree;
+    const int size = static_cast<int>(std::ceil(buf.f_blocks * buf.f_frsize / mib));
+    const int used = static_cast<int>(std::ceil(used_blocks * buf.f_frsize / mib));
+    const int avail = static_cast<int>(std::ceil(buf.f_bavail * buf.f_frsize / mib));
+    const uint64_t usable_blocks = used_blocks + buf.f_bavail;
+    const int use =
+      (usable_blocks > 0) ? static_cast<int>(std::ceil(used_blocks * 100.0 / usable_blocks)) : 0;
 
     int level = DiagStatus::OK;
-    std::string line;
-    int index = 0;
-    std::vector<std::string> list;
-    int avail;
-
-    while (std::getline(is_out, line) && !line.empty()) {
-      // Skip header
-      if (index <= 0) {
-        ++index;
-        continue;
-      }
-
-      boost::split(list, line, boost::is_space(), boost::token_compress_on);
-
-      try {
-        avail = std::stoi(list[3].c_str());
-      } catch (std::exception & e) {
-        avail = -1;
-        error_str = e.what();
-        stat.add(fmt::format("HDD {}: status", hdd_index), "avail string error");
-      }
-
-      if (avail <= itr->second.free_error_) {
-        level = DiagStatus::ERROR;
-      } else if (avail <= itr->second.free_warn_) {
-        level = DiagStatus::WARN;
-      } else {
-        level = DiagStatus::OK;
-      }
+    if (avail <= itr->second.free_error_) {
+      level = DiagStatus::ERROR;
+    } else if (avail <= itr->second.free_warn_) {
+      level = DiagStatus::WARN;
+    } else {
+      level = DiagStatus::OK;
+    }
 
-      stat.add(fmt::format("HDD {}: status", hdd_index), usage_dict_.at(level));
-      stat.add(fmt::format("HDD {}: filesystem", hdd_index), list[0].c_str());
-      stat.add(fmt::format("HDD {}: size", hdd_index), (list[1] + " MiB").c_str());
-      stat.add(fmt::format("HDD {}: used", hdd_index), (list[2] + " MiB").c_str());
-      stat.add(fmt::format("HDD {}: avail", hdd_index), (list[3] + " MiB").c_str());
-      stat.add(fmt::format("HDD {}: use", hdd_index), list[4].c_str());
-      std::string mounted_ = list[5];
-      if (list.size() > 6) {
-        std::string::size_type pos = line.find("% /");
-        if (pos != std::string::npos) {
-          mounted_ = line.substr(pos + 2);  // 2 is "% " length
-        }
-      }
-      stat.add(fmt::format("HDD {}: mounted on", hdd_index), mounted_.c_str());
+    stat.add(fmt::format("HDD {}: status", hdd_index), usage_dict_.at(level));
+    stat.add(fmt::format("HDD {}: filesystem", hdd_index), itr->second.part_device_.c_str());
+    stat.add(fmt::format("HDD {}: size", hdd_index), fmt::format("{} MiB", size));
+    stat.add(fmt::format("HDD {}: used", hdd_index), fmt::format("{} MiB", used));
+    stat.add(fmt::format("HDD {}: avail", hdd_index), fmt::format("{} MiB", avail));
+    stat.add(fmt::format("HDD {}: use", hdd_index), fmt::format("{}%", use));
+    stat.add(fmt::format("HDD {}: mounted on", hdd_index), itr->first.c_str());
 
-      whole_level = std::max(whole_level, level);
-      ++index;
-    }
+    whole_level = std::max(whole_level, level);
   }
 
   if (!error_str.empty()) {
@@ -541,37 +496,24 @@ std::string HddMonitor::getDeviceFromMountPoint(const std::string & mount_point)
 {
   std::string ret;
 
-  // boost::process create file descriptor without O_CLOEXEC required for multithreading.
-  // So create file descriptor with O_CLOEXEC and pass it to boost::process.
-  int out_fd[2];
-  if (pipe2(out_fd, O_CLOEXEC) != 0) {
-    RCLCPP_ERROR(get_logger(), "Failed to execute pipe2. %s", strerror(errno));
-    return "";
-  }
-  bp::pipe out_pipe{out_fd[0], out_fd[1]};
-  bp::ipstream is_out{std::move(out_pipe)};
-
-  int err_fd[2];
-  if (pipe2(err_fd, O_CLOEXEC) != 0) {
-    RCLCPP_ERROR(get_logger(), "Failed to execute pipe2. %s", strerror(errno));
+  FILE * fp = setmntent("/proc/self/mounts", "r");
+  if (fp == nullptr) {
+    RCLCPP_ERROR(get_logger(), "Failed to open /proc/self/mounts. %s", strerror(errno));
     return "";
   }
-  bp::pipe err_pipe{err_fd[0], err_fd[1]};
-  bp::ipstream is_err{std::move(err_pipe)};
-
-  bp::child c(
-    "/bin/sh", "-c", fmt::format("findmnt -n -o SOURCE {}", mount_point.c_str()),
-    bp::std_out > is_out, bp::std_err > is_err);
-  c.wait();
 
-  if (c.exit_code() != 0) {
-    RCLCPP_ERROR(get_logger(), "Failed to execute findmnt. %s", mount_point.c_str());
-    return "";
+  // the last entry is the visible one if file systems are stacked on the mount point
+  mntent entry;
+  char buf[4096];
+  while (getmntent_r(fp, &entry, buf, sizeof(buf)) != nullptr) {
+    if (mount_point == entry.mnt_dir) {
+      ret = entry.mnt_fsname;
+    }
   }
+  endmntent(fp);
 
-  if (!std::getline(is_out, ret)) {
+  if (ret.empty()) {
     RCLCPP_ERROR(get_logger(), "Failed to find device name. %s", mount_point.c_str());
-    return "";
   }
 
   return ret;
@@ -590,40 +532,6 @@ void HddMonitor::updateHddInfoList()
   connect_diag_.clear();
   connect_diag_.clearSummary();
 
-  // Create a new socket
-  int sock = socket(AF_INET, SOCK_STREAM, 0);
-  if (sock < 0) {
-    connect_diag_.summary(DiagStatus::ERROR, "socket error");
-    connect_diag_.add("socket", strerror(errno));
-    return;
-  }
-
-  // Specify the receiving timeouts until reporting an error
-  struct timeval tv;
-  tv.tv_sec = 10;
-  tv.tv_usec = 0;
-  int ret = setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
-  if (ret < 0) {
-    connect_diag_.summary(DiagStatus::ERROR, "setsockopt error");
-    connect_diag_.add("setsockopt", strerror(errno));
-    close(sock);
-    return;
-  }
-
-  // Connect the socket referred to by the file descriptor
-  sockaddr_in addr;
-  memset(&addr, 0, sizeof(sockaddr_in));
-  addr.sin_family = AF_INET;
-  addr.sin_port = htons(hdd_reader_port_);
-  addr.sin_addr.s_addr = htonl(INADDR_ANY);
-  ret = connect(sock, (struct sockaddr *)&addr, sizeof(addr));
-  if (ret < 0) {
-    connect_diag_.summary(DiagStatus::ERROR, "connect error");
-    connect_diag_.add("connect", strerror(errno));
-    close(sock);
-    return;
-  }
-
   uint8_t request_id = HddReaderRequestId::GetHddInfo;
   std::vector<HddDevice> hdd_devices;
   for (auto itr = hdd_params_.begin(); itr != hdd_params_.end(); ++itr) {
@@ -646,44 +554,18 @@ void HddMonitor::updateHddInfoList()
   oa & request_id;
   oa & hdd_devices;
 
-  // Write list of devices to FD
-  ret = write(sock, oss.str().c_str(), oss.str().length());
-  if (ret < 0) {
-    connect_diag_.summary(DiagStatus::ERROR, "write error");
-    connect_diag_.add("write", strerror(errno));
-    RCLCPP_ERROR(get_logger(), "write error");
-    close(sock);
-    return;
-  }
-
-  // Receive messages from a socket
-  char buf[1024] = "";
-  ret = recv(sock, buf, sizeof(buf) - 1, 0);
-  if (ret < 0) {
-    connect_diag_.summary(DiagStatus::ERROR, "recv error");
-    connect_diag_.add("recv", strerror(errno));
-    close(sock);
-    return;
-  }
-  // No data received
-  if (ret == 0) {
-    connect_diag_.summary(DiagStatus::ERROR, "recv error");
-    connect_diag_.add("recv", "No data received");
-    close(sock);
-    return;
-  }
-
-  // Close the file descriptor FD
-  ret = close(sock);
-  if (ret < 0) {
-    connect_diag_.summary(DiagStatus::ERROR, "close error");
-    connect_diag_.add("close", strerror(errno));
+  std::string response;
+  std::string error_command;
+  std::string error;
+  if (!requestHddReader(oss.str(), response, error_command, error)) {
+    connect_diag_.summary(DiagStatus::ERROR, fmt::format("{} error", error_command));
+    connect_diag_.add(error_command, error);
     return;
   }
 
   // Restore HDD information list
   try {
-    std::istringstream iss(buf);
+    std::istringstream iss(response);
     boost::archive::text_iarchive oa(iss);
     oa >> hdd_info_list_;
   } catch (const std::exception & e) {
@@ -830,12 +712,53 @@ void HddMonitor::updateHddConnections()
 }
 
 int HddMonitor::unmountDevice(std::string & device)
+{
+  uint8_t request_id = HddReaderRequestId::UnmountDevice;
+  std::vector<UnmountDeviceInfo> umount_dev_infos;
+  UnmountDeviceInfo dev_info;
+
+  dev_info.part_device_ = device;
+  umount_dev_infos.push_back(dev_info);
+
+  std::ostringstream oss;
+  boost::archive::text_oarchive oa(oss);
+  oa & request_id;
+  oa & umount_dev_infos;
+
+  std::string response;
+  std::string error_command;
+  std::string error;
+  if (!requestHddReader(oss.str(), response, error_command, error)) {
+    RCLCPP_ERROR(get_logger(), "socket %s error. %s", error_command.c_str(), error.c_str());
+    return -1;
+  }
+
+  std::vector<int> responses;
+
+  // Restore responses
+  try {
+    std::istringstream iss(response);
+    boost::archive::text_iarchive ia(iss);
+    ia >> responses;
+  } catch (const std::exception & e) {
+    RCLCPP_ERROR(get_logger(), "restore responses exception. %s", e.what());
+    return -1;
+  }
+  if (responses.empty()) {
+    RCLCPP_ERROR(get_logger(), "responses from hdd_reader is empty.");
+    return -1;
+  }
+  return responses[0];
+}
+
+bool HddMonitor::connectHddReader(std::string & error_command, std::string & error)
 {
   // Create a new socket
-  int sock = socket(AF_INET, SOCK_STREAM, 0);
+  int sock = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
   if (sock < 0) {
-    RCLCPP_ERROR(get_logger(), "socket create error. %s", strerror(errno));
-    return -1;
+    error_command = "socket";
+    error = strerror(errno);
+    return false;
   }
 
   // Specify the receiving timeouts until reporting an error
@@ -844,9 +767,10 @@ int HddMonitor::unmountDevice(std::string & device)
   tv.tv_usec = 0;
   int ret = setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
   if (ret < 0) {
-    RCLCPP_ERROR(get_logger(), "setsockopt error. %s", strerror(errno));
+    error_command = "setsockopt";
+    error = strerror(errno);
     close(sock);
-    return -1;
+    return false;
   }
 
   // Connect the socket referred to by the file descriptor
@@ -857,69 +781,73 @@ int HddMonitor::unmountDevice(std::string & device)
   addr.sin_addr.s_addr = htonl(INADDR_ANY);
   ret = connect(sock, (struct sockaddr *)&addr, sizeof(addr));
   if (ret < 0) {
-    RCLCPP_ERROR(get_logger(), "socket connect error. %s", strerror(errno));
+    error_command = "connect";
+    error = strerror(errno);
     close(sock);
-    return -1;
+    return false;
   }
 
-  uint8_t request_id = HddReaderRequestId::UnmountDevice;
-  std::vector<UnmountDeviceInfo> umount_dev_infos;
-  UnmountDeviceInfo dev_info;
-
-  dev_info.part_device_ = device;
-  umount_dev_infos.push_back(dev_info);
-
-  std::ostringstream oss;
-  boost::archive::text_oarchive oa(oss);
-  oa & request_id;
-  oa & umount_dev_infos;
+  hdd_reader_socket_ = sock;
+  return true;
+}
 
-  // Write list of devices to FD
-  ret = write(sock, oss.str().c_str(), oss.str().length());
-  if (ret < 0) {
-    RCLCPP_ERROR(get_logger(), "socket write error. %s", strerror(errno));
-    close(sock);
-    return -1;
+void HddMonitor::closeHddReader()
+{
+  if (hdd_reader_socket_ >= 0) {
+    close(hdd_reader_socket_);
+    hdd_reader_socket_ = -1;
   }
+}
 
-  // Receive messages from a socket
-  char buf[1024] = "";
-  ret = recv(sock, buf, sizeof(buf) - 1, 0);
-  if (ret < 0) {
-    RCLCPP_ERROR(get_logger(), "socket recv error. %s", strerror(errno));
-    close(sock);
-    return -1;
-  }
-  // No data received
-  if (ret == 0) {
-    RCLCPP_ERROR(get_logger(), "no data received from hdd_reader.");
-    close(sock);
-    return -1;
-  }
+bool HddMonitor::requestHddReader(
+  const std::string & request, std::string & response, std::string & error_command,
+  std::string & error)
+{
+  // hdd_reader may have closed the kept connection, e.g. when restarted,
+  // so retry once with a new connection
+  for (int attempt = 0; attempt < 2; ++attempt) {
+    const bool is_reused = (hdd_reader_socket_ >= 0);
+    if (!is_reused && !connectHddReader(error_command, error)) {
+      return false;
+    }
 
-  // Close the file descriptor FD
-  ret = close(sock);
-  if (ret < 0) {
-    RCLCPP_ERROR(get_logger(), "socket close error. %s", strerror(errno));
-    return -1;
-  }
+    // Write request to FD
+    ssize_t ret = send(hdd_reader_socket_, request.c_str(), request.length(), MSG_NOSIGNAL);
+    if (ret < 0) {
+      error_command = "write";
+      error = strerror(errno);
+      closeHddReader();
+      if (is_reused) {
+        continue;
+      }
+      return false;
+    }
 
-  std::vector<int> responses;
+    // Receive messages from a socket
+    char buf[1024] = "";
+    ret = recv(hdd_reader_socket_, buf, sizeof(buf) - 1, 0);
+    if (ret < 0) {
+      error_command = "recv";
+      error = strerror(errno);
+      // a late response would be taken for the next one
+      closeHddReader();
+      return false;
+    }
+    // No data received
+    if (ret == 0) {
+      error_command = "recv";
+      error = "No data received";
+      closeHddReader();
+      if (is_reused) {
+        continue;
+      }
+      return false;
+    }
 
-  // Restore responses
-  try {
-    std::istringstream iss(buf);
-    boost::archive::text_iarchive ia(iss);
-    ia >> responses;
-  } catch (const std::exception & e) {
-    RCLCPP_ERROR(get_logger(), "restore responses exception. %s", e.what());
-    return -1;
+    response.assign(buf, ret);
+    return true;
   }
-  if (responses.empty()) {
-    RCLCPP_ERROR(get_logger(), "responses from hdd_reader is empty.");
-    return -1;
-  }
-  return responses[0];
+  return false;
 }
 
 #include <rclcpp_components/register_node_macro.hpp>
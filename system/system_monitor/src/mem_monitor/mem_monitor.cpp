@@ -21,14 +21,13 @@
 
 #include "system_monitor/system_monitor_utility.hpp"
 
-#include <boost/process.hpp>
-
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <map>
 #include <string>
-#include <vector>
-
-namespace bp = boost::process;
 
 MemMonitor::MemMonitor(const rclcpp::NodeOptions & options)
 : Node("mem_monitor", options),
@@ -48,95 +47,66 @@ void MemMonitor::checkUsage(diagnostic_updater::DiagnosticStatusWrapper & stat)
   const auto t_start = SystemMonitorUtility::startMeasurement();
 
   // Get total amount of free and used memory
-
-  // boost::process create file descriptor without O_CLOEXEC required for multithreading.
-  // So create file descriptor with O_CLOEXEC and pass it to boost::process.
-  int out_fd[2];
-  if (pipe2(out_fd, O_CLOEXEC) != 0) {
-    stat.summary(DiagStatus::ERROR, "pipe2 error");
-    stat.add("pipe2", strerror(errno));
-    return;
-  }
-  bp::pipe out_pipe{out_fd[0], out_fd[1]};
-  bp::ipstream is_out{std::move(out_pipe)};
-
-  int err_fd[2];
-  if (pipe2(err_fd, O_CLOEXEC) != 0) {
-    stat.summary(DiagStatus::ERROR, "pipe2 error");
-    stat.add("pipe2", strerror(errno));
-    return;
-  }
-  bp::pipe err_pipe{err_fd[0], err_fd[1]};
-  bp::ipstream is_err{std::move(err_pipe)};
-
-  bp::child c("free -tb", bp::std_out > is_out, bp::std_err > is_err);
-  c.wait();
-  if (c.exit_code() != 0) {
-    std::ostringstream os;
-    is_err >> os.rdbuf();
-    stat.summary(DiagStatus::ERROR, "free error");
-    stat.add("free", os.str().c_str());
+  std::ifstream ifs("/proc/meminfo");
+  if (!ifs) {
+    stat.summary(DiagStatus::ERROR, "meminfo error");
+    stat.add("meminfo", strerror(errno));
     return;
   }
 
+  // Values in bytes, by field name
+  std::map<std::string, size_t> meminfo;
   std::string line;
-  int index = 0;
-  std::vector<std::string> list;
-  float usage;
-  size_t mem_total = 0;
-  size_t mem_shared = 0;
-  size_t mem_available = 0;
-  size_t used_plus = 0;
-
-  /*
-   Output example of `free -tb`
-
-             list[0]     list[1]     list[2]     list[3]     list[4]     list[5]     list[6]
-   index 0 |               total        used        free      shared  buff/cache   available
-   index 1 | Mem:       32809744    12554780    13090376      292840     7164588    19622092
-   index 2 | Swap:      33554428     1767680    31786748
-   index 3 | Total:     66364172    14322460    44877124
-  */
-  while (std::getline(is_out, line) && !line.empty()) {
-    // Skip header
-    if (index <= 0) {
-      ++index;
-      continue;
-    }
-
-    boost::split(list, line, boost::is_space(), boost::token_compress_on);
-
-    // Physical memory
-    if (index == 1) {
-      mem_total = std::atoll(list[1].c_str());
-      mem_shared = std::atoll(list[4].c_str());
-      mem_available = std::atoll(list[6].c_str());
-
-      // available divided by total is available memory including calculation for buff/cache,
-      // so the subtraction of this from 1 gives real usage.
-      usage = 1.0f - static_cast<double>(mem_available) / mem_total;
-      stat.addf(fmt::format("{} usage", list[0]), "%.2f%%", usage * 1e+2);
-    }
-
-    stat.add(fmt::format("{} total", list[0]), toHumanReadable(list[1]));
-    stat.add(fmt::format("{} used", list[0]), toHumanReadable(list[2]));
-    stat.add(fmt::format("{} free", list[0]), toHumanReadable(list[3]));
-
-    // Add an additional information for physical memory
-    if (index == 1) {
-      stat.add(fmt::format("{} shared", list[0]), toHumanReadable(list[4]));
-      stat.add(fmt::format("{} buff/cache", list[0]), toHumanReadable(list[5]));
-      stat.add(fmt::format("{} available", list[0]), toHumanReadable(list[6]));
-    } else if (index == 3) {
-      // Total:used + Mem:shared
-      used_plus = std::atoll(list[2].c_str()) + mem_shared;
-      double giga = static_cast<double>(used_plus) / (1024 * 1024 * 1024);
-      stat.add(fmt::format("{} used+", list[0]), fmt::format("{:.1f}{}", giga, "G"));
-    } else {
-      /* nothing */
+  while (std::getline(ifs, line)) {
+    char name[64];
+    size_t value;
+    // "MemTotal:       32809744 kB"
+    if (sscanf(line.c_str(), "%63[^:]: %zu", name, &value) == 2) {
+      meminfo[name] = value * 1024;
     }
-    ++index;
   }
+  auto get = [&meminfo](const std::string & name) {
+    const auto itr = meminfo.find(name);
+    return (itr != meminfo.end()) ? itr->second : 0;
+  };
+
+  // Same as `free -tb` of procps-ng 3.3
+  const size_t mem_total = get("MemTotal");
+  const size_t mem_free = get("MemFree");
+  const size_t mem_shared = get("Shmem");
+  const size_t mem_buff_cache = get("Buffers") + get("Cached") + get("SReclaimable");
+  const size_t mem_available = meminfo.count("MemAvailable") ? get("MemAvailable") : mem_free;
+  const size_t mem_used = (mem_total >= mem_free + mem_buff_cache)
+                            ? mem_total - mem_free - mem_buff_cache
+                            : mem_total - std::min(mem_total, mem_free);
+  const size_t swap_total = get("SwapTotal");
+  const size_t swap_free = get("SwapFree");
+  const size_t swap_used = swap_total - std::min(swap_total, swap_free);
+
+  // available divided by total is available memory including calculation for buff/cache,
+  // so the subtraction of this from 1 gives real usage.
+  const float usage =
+    (mem_total > 0) ? 1.0f - static_cast<double>(mem_available) / mem_total : 0.0f;
+  stat.addf("Mem: usage", "%.2f%%", usage * 1e+2);
+  stat.add("Mem: total", toHumanReadable(mem_total));
+  stat.add("Mem: used", toHumanReadable(mem_used));
+  stat.add("Mem: free", toHumanReadable(mem_free));
+  stat.add("Mem: shared", toHumanReadable(mem_shared));
+  stat.add("Mem: buff/cache", toHumanReadable(mem_buff_cache));
+  stat.add("Mem: available", toHumanReadable(mem_available));
+
+  stat.add("Swap: total", toHumanReadable(swap_total));
+  stat.add("Swap: used", toHumanReadable(swap_used));
+  stat.add("Swap: free", toHumanReadable(swap_free));
+
+  stat.add("Total: total", toHumanReadable(mem_total + swap_total));
+  stat.add("Total: used", toHumanReadable(mem_used + swap_used));
+  stat.add("Total: free", toHumanReadable(mem_free + swap_free));
+
+  // Total:used + Mem:shared
+  const size_t used_plus = mem_used + swap_used + mem_shared;
+  const double giga = static_cast<double>(used_plus) / (1024 * 1024 * 1024);
+  stat.add("Total: used+", fmt::format("{:.1f}{}", giga, "G"));
 
   int level;
   if (mem_total > used_plus) {
@@ -153,11 +123,11 @@ void MemMonitor::checkUsage(diagnostic_updater::DiagnosticStatusWrapper & stat)
   SystemMonitorUtility::stopMeasurement(t_start, stat);
 }
 
-std::string MemMonitor::toHumanReadable(const std::string & str)
+std::string MemMonitor::toHumanReadable(size_t bytes)
 {
   const char * units[] = {"B", "K", "M", "G", "T"};
   int count = 0;
-  double size = std::atol(str.c_str());
+  double size = bytes;
 
   while (size > 1024) {
     size /= 1024;
@@ -29,10 +29,14 @@
 
 #define FMT_HEADER_ONLY
 #include <fmt/format.h>
-#include <ifaddrs.h>
 #include <linux/ethtool.h>
 #include <linux/if_link.h>
+#include <linux/rtnetlink.h>
 #include <linux/sockios.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
 
 NetMonitor::NetMonitor(const rclcpp::NodeOptions & options)
 : Node("net_monitor", options),
@@ -41,7 +45,11 @@ NetMonitor::NetMonitor(const rclcpp::NodeOptions & options)
   last_update_time_{0, 0, this->get_clock()->get_clock_type()},
   device_params_(
     declare_parameter<std::vector<std::string>>("devices", std::vector<std::string>())),
-  getifaddrs_error_code_(0),
+  netlink_error_code_(0),
+  ioctl_socket_(-1),
+  netlink_socket_(-1),
+  netlink_sequence_(0),
+  netlink_buffer_(32768),
   monitor_program_(declare_parameter<std::string>("monitor_program", "greengrass")),
   socket_path_(declare_parameter("socket_path", traffic_reader_service::socket_path)),
   crc_error_check_duration_(declare_parameter<int>("crc_error_check_duration", 1)),
@@ -85,7 +93,17 @@ NetMonitor::NetMonitor(const rclcpp::NodeOptions & options)
   send_start_nethogs_request();
 }
 
-NetMonitor::~NetMonitor() { shutdown_nl80211(); }
+NetMonitor::~NetMonitor()
+{
+  shutdown_nl80211();
+  close_connection();
+  if (ioctl_socket_ >= 0) {
+    close(ioctl_socket_);
+  }
+  if (netlink_socket_ >= 0) {
+    close(netlink_socket_);
+  }
+}
 
 void NetMonitor::check_connection(diagnostic_updater::DiagnosticStatusWrapper & status)
 {
@@ -96,9 +114,9 @@ void NetMonitor::check_connection(diagnostic_updater::DiagnosticStatusWrapper &
     status.summary(DiagStatus::ERROR, "invalid device parameter");
     return;
   }
-  if (getifaddrs_error_code_ != 0) {
-    status.summary(DiagStatus::ERROR, "getifaddrs error");
-    status.add("getifaddrs", strerror(getifaddrs_error_code_));
+  if (netlink_error_code_ != 0) {
+    status.summary(DiagStatus::ERROR, "netlink error");
+    status.add("RTM_GETLINK", strerror(netlink_error_code_));
     return;
   }
 
@@ -119,7 +137,9 @@ void NetMonitor::check_connection(diagnostic_updater::DiagnosticStatusWrapper &
   // Check if specified device exists
   for (const auto & device : device_params_) {
     // Skip if device not specified
-    if (device == "*") continue;
+    if (device == "*") {
+      continue;
+    }
 
     // Check if device exists in detected networks
     const auto object = std::find_if(
@@ -159,7 +179,9 @@ void NetMonitor::check_usage(diagnostic_updater::DiagnosticStatusWrapper & statu
 
   for (const auto & network : network_list_) {
     // Skip if network is not supported
-    if (network.is_invalid) continue;
+    if (network.is_invalid) {
+      continue;
+    }
 
     level = network.is_running ? DiagStatus::OK : DiagStatus::ERROR;
 
@@ -197,7 +219,9 @@ void NetMonitor::check_crc_error(diagnostic_updater::DiagnosticStatusWrapper & s
 
   for (const auto & network : network_list_) {
     // Skip if network is not supported
-    if (network.is_invalid) continue;
+    if (network.is_invalid) {
+      continue;
+    }
 
     CrcErrors & crc_errors = crc_errors_[network.interface_name];
     unsigned int unit_rx_crc_errors = 0;
@@ -253,7 +277,9 @@ void NetMonitor::monitor_traffic(diagnostic_updater::DiagnosticStatusWrapper & s
       std::vector<std::string> list;
       int index = 0;
       while (std::getline(lines, line)) {
-        if (line.empty()) continue;
+        if (line.empty()) {
+          continue;
+        }
 
         boost::split(list, line, boost::is_any_of("\t"), boost::token_compress_on);
         if (list.size() >= 3) {
@@ -363,66 +389,166 @@ void NetMonitor::update_network_list()
 {
   rclcpp::Duration duration = this->now() - last_update_time_;
 
-  struct ifaddrs * interfaces = {};
   network_list_.clear();
 
-  // Get network interfaces
-  if (getifaddrs(&interfaces) < 0) {
-    getifaddrs_error_code_ = errno;
+  // Get network interfaces and their stats with a single dump, as getifaddrs() does internally
+  if (!send_link_dump_request()) {
+    netlink_error_code_ = errno;
+    return;
+  }
+  netlink_error_code_ = receive_link_dump(duration);
+  if (netlink_error_code_ != 0) {
+    // Discard the rest of the dump
+    network_list_.clear();
+    close(netlink_socket_);
+    netlink_socket_ = -1;
     return;
   }
 
-  for (const auto * interface = interfaces; interface; interface = interface->ifa_next) {
-    // Skip no addr
-    if (!interface->ifa_addr) {
-      continue;
-    }
-    // Skip loopback
-    if (interface->ifa_flags & IFF_LOOPBACK) {
-      continue;
+  last_update_time_ = this->now();
+}
+
+bool NetMonitor::send_link_dump_request()
+{
+  if (netlink_socket_ < 0) {
+    netlink_socket_ = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (netlink_socket_ < 0) {
+      return false;
     }
-    // Skip non AF_PACKET
-    if (interface->ifa_addr->sa_family != AF_PACKET) {
-      continue;
+  }
+
+  struct
+  {
+    struct nlmsghdr header;
+    struct ifinfomsg message;
+  } request{};
+  request.header.nlmsg_len = NLMSG_LENGTH(sizeof(struct ifinfomsg));
+  request.header.nlmsg_type = RTM_GETLINK;
+  request.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+  request.header.nlmsg_seq = ++netlink_sequence_;
+  request.message.ifi_family = AF_UNSPEC;
+
+  if (send(netlink_socket_, &request, request.header.nlmsg_len, 0) < 0) {
+    const int error_code = errno;
+    close(netlink_socket_);
+    netlink_socket_ = -1;
+    errno = error_code;
+    return false;
+  }
+
+  return true;
+}
+
+int NetMonitor::receive_link_dump(const rclcpp::Duration & duration)
+{
+  while (true) {
+    const ssize_t size = recv(netlink_socket_, netlink_buffer_.data(), netlink_buffer_.size(), 0);
+    if (size < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return errno;
     }
-    // Skip device not specified
-    const auto object = std::find_if(
-      device_params_.begin(), device_params_.end(),
-      [&interface](const auto & device) { return device == "*" || device == interface->ifa_name; });
-    if (object == device_params_.end()) {
-      continue;
+    if (size == 0) {
+      return EIO;
     }
 
-    NetworkInfomation network{};
-    network.interface_name = interface->ifa_name;
-    network.is_running = (interface->ifa_flags & IFF_RUNNING);
+    int remaining = static_cast<int>(size);
+    for (auto * header = reinterpret_cast<struct nlmsghdr *>(netlink_buffer_.data());
+         NLMSG_OK(header, remaining); header = NLMSG_NEXT(header, remaining)) {
+      // Skip messages left from an earlier request
+      if (header->nlmsg_seq != netlink_sequence_) {
+        continue;
+      }
 
-    // Update network information using socket
-    update_network_information_by_socket(network);
+      if (header->nlmsg_type == NLMSG_DONE) {
+        return 0;
+      }
+      if (header->nlmsg_type == NLMSG_ERROR) {
+        const auto * error = static_cast<struct nlmsgerr *>(NLMSG_DATA(header));
+        return error->error != 0 ? -error->error : EIO;
+      }
+      if (header->nlmsg_type == RTM_NEWLINK) {
+        update_network_information_by_link_message(header, duration);
+      }
+    }
+  }
+}
 
-    // Update network information using routing netlink stats
-    update_network_information_by_routing_netlink(network, interface->ifa_data, duration);
+void NetMonitor::update_network_information_by_link_message(
+  struct nlmsghdr * header, const rclcpp::Duration & duration)
+{
+  auto * message = static_cast<struct ifinfomsg *>(NLMSG_DATA(header));
+
+  const char * interface_name = nullptr;
+  struct rtnl_link_stats * stats = nullptr;
+  bool has_address = false;
+
+  int length = static_cast<int>(IFLA_PAYLOAD(header));
+  for (auto * attribute = IFLA_RTA(message); RTA_OK(attribute, length);
+       attribute = RTA_NEXT(attribute, length)) {
+    switch (attribute->rta_type) {
+      case IFLA_IFNAME:
+        interface_name = static_cast<const char *>(RTA_DATA(attribute));
+        break;
+      case IFLA_ADDRESS:
+        has_address = true;
+        break;
+      case IFLA_STATS:
+        if (RTA_PAYLOAD(attribute) >= sizeof(struct rtnl_link_stats)) {
+          stats = static_cast<struct rtnl_link_stats *>(RTA_DATA(attribute));
+        }
+        break;
+      default:
+        break;
+    }
+  }
 
-    network_list_.emplace_back(network);
+  // Skip no name or no stats
+  if (!interface_name || !stats) {
+    return;
+  }
+  // Skip no addr, getifaddrs() leaves ifa_addr empty for these links
+  if (!has_address) {
+    return;
+  }
+  // Skip loopback
+  if (message->ifi_flags & IFF_LOOPBACK) {
+    return;
+  }
+  // Skip device not specified
+  const auto object = std::find_if(
+    device_params_.begin(), device_params_.end(),
+    [&interface_name](const auto & device) { return device == "*" || device == interface_name; });
+  if (object == device_params_.end()) {
+    return;
   }
 
-  freeifaddrs(interfaces);
+  NetworkInfomation network{};
+  network.interface_name = interface_name;
+  network.is_running = (message->ifi_flags & IFF_RUNNING);
 
-  last_update_time_ = this->now();
+  // Update network information using socket
+  update_network_information_by_socket(network);
+
+  // Update network information using routing netlink stats
+  update_network_information_by_routing_netlink(network, stats, duration);
+
+  network_list_.emplace_back(network);
 }
 
 void NetMonitor::update_network_information_by_socket(NetworkInfomation & network)
 {
-  // Get MTU information
-  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  // Keep the socket open for the node's lifetime
+  if (ioctl_socket_ < 0) {
+    ioctl_socket_ = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+  }
 
   // Update MTU information
-  update_mtu(network, fd);
+  update_mtu(network, ioctl_socket_);
 
   // Update network capacity
-  update_network_capacity(network, fd);
-
-  close(fd);
+  update_network_capacity(network, ioctl_socket_);
 }
 
 void NetMonitor::update_mtu(NetworkInfomation & network, int socket)
@@ -513,15 +639,15 @@ void NetMonitor::update_crc_error(NetworkInfomation & network, const struct rtnl
 
 void NetMonitor::get_reassembles_failed_column_index()
 {
-  std::ifstream ifs("/proc/net/snmp");
-  if (!ifs) {
+  snmp_stream_.open("/proc/net/snmp");
+  if (!snmp_stream_) {
     RCLCPP_WARN(get_logger(), "Failed to open /proc/net/snmp.");
     return;
   }
 
   // Find column index of 'ReasmFails'
   std::string line;
-  if (!std::getline(ifs, line)) {
+  if (!std::getline(snmp_stream_, line)) {
     RCLCPP_WARN(get_logger(), "Failed to get header of /proc/net/snmp.");
     return;
   }
@@ -559,8 +685,10 @@ bool NetMonitor::get_reassembles_failed(uint64_t & reassembles_failed)
     return false;
   }
 
-  std::ifstream ifs("/proc/net/snmp");
-  if (!ifs) {
+  // procfs files are generated again when read from the beginning
+  snmp_stream_.clear();
+  snmp_stream_.seekg(0);
+  if (!snmp_stream_) {
     RCLCPP_WARN(get_logger(), "Failed to open /proc/net/snmp.");
     return false;
   }
@@ -568,13 +696,13 @@ bool NetMonitor::get_reassembles_failed(uint64_t & reassembles_failed)
   std::string line;
 
   // Skip header row
-  if (!std::getline(ifs, line)) {
+  if (!std::getline(snmp_stream_, line)) {
     RCLCPP_WARN(get_logger(), "Failed to get header of /proc/net/snmp.");
     return false;
   }
 
   // Find a value of 'ReasmFails'
-  if (!std::getline(ifs, line)) {
+  if (!std::getline(snmp_stream_, line)) {
     RCLCPP_WARN(get_logger(), "Failed to get a line of /proc/net/snmp.");
     return false;
   }
@@ -608,42 +736,51 @@ void NetMonitor::send_start_nethogs_request()
 
   for (const auto & network : network_list_) {
     // Skip if network is not supported
-    if (network.is_invalid) continue;
+    if (network.is_invalid) {
+      continue;
+    }
 
     interface_names.push_back(network.interface_name);
   }
 
-  // Send data to traffic-reader service
-  send_data_with_parameters(
-    traffic_reader_service::START_NETHOGS, interface_names, monitor_program_);
-
-  // Close connection with traffic-reader service
-  close_connection();
+  // Send data to traffic-reader service, and keep the connection for the results
+  if (!send_data_with_parameters(
+        traffic_reader_service::START_NETHOGS, interface_names, monitor_program_)) {
+    close_connection();
+  }
 }
 
 void NetMonitor::get_nethogs_result(traffic_reader_service::Result & result)
 {
-  // Connect to traffic-reader service
-  if (!connect_service()) {
-    close_connection();
-    return;
-  }
+  // Retry once with a new connection if traffic-reader service closed the kept one
+  for (int attempt = 0; attempt < 2; ++attempt) {
+    const bool is_reused = socket_ && socket_->is_open();
+
+    // Connect to traffic-reader service
+    if (!connect_service()) {
+      close_connection();
+      return;
+    }
+
+    // Send data to traffic-reader service and receive data from it
+    if (send_data(traffic_reader_service::Request::GET_RESULT) && receive_data(result)) {
+      return;
+    }
 
-  // Send data to traffic-reader service
-  if (!send_data(traffic_reader_service::Request::GET_RESULT)) {
     close_connection();
-    return;
+    if (!is_reused) {
+      return;
+    }
   }
-
-  // Receive data from traffic-reader service
-  receive_data(result);
-
-  // Close connection with traffic-reader service
-  close_connection();
 }
 
 bool NetMonitor::connect_service()
 {
+  // Reuse the connection kept open
+  if (socket_ && socket_->is_open()) {
+    return true;
+  }
+
   local::stream_protocol::endpoint endpoint(socket_path_);
   socket_ = std::make_unique<local::stream_protocol::socket>(io_service_);
 
@@ -701,7 +838,7 @@ bool NetMonitor::send_data_with_parameters(
   return true;
 }
 
-void NetMonitor::receive_data(traffic_reader_service::Result & result)
+bool NetMonitor::receive_data(traffic_reader_service::Result & result)
 {
   uint8_t request_id = traffic_reader_service::Request::NONE;
 
@@ -713,7 +850,7 @@ void NetMonitor::receive_data(traffic_reader_service::Result & result)
   if (error_code) {
     RCLCPP_ERROR(
       get_logger(), "Failed to read data from socket. %s\n", error_code.message().c_str());
-    return;
+    return false;
   }
 
   // Restore device status list
@@ -725,12 +862,16 @@ void NetMonitor::receive_data(traffic_reader_service::Result & result)
   } catch (const std::exception & e) {
     RCLCPP_ERROR(get_logger(), "Failed to restore message. %s\n", e.what());
   }
+
+  return true;
 }
 
 void NetMonitor::close_connection()
 {
   // Close socket
-  socket_->close();
+  if (socket_) {
+    socket_->close();
+  }
 }
 
 #include <rclcpp_components/register_node_macro.hpp>
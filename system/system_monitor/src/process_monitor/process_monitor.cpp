@@ -23,8 +23,19 @@
 
 #include <tier4_autoware_utils/system/stop_watch.hpp>
 
+#include <dirent.h>
+#include <fcntl.h>
 #include <fmt/format.h>
-
+#include <pwd.h>
+#include <sys/stat.h>
+#include <sys/sysinfo.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
 #include <memory>
 #include <regex>
 #include <string>
@@ -34,8 +45,12 @@ ProcessMonitor::ProcessMonitor(const rclcpp::NodeOptions & options)
 : Node("process_monitor", options),
   updater_(this),
   num_of_procs_(declare_parameter<int>("num_of_procs", 5)),
+  use_top_(declare_parameter<bool>("use_top", false)),
   is_top_error_(false),
-  is_pipe2_error_(false)
+  is_pipe2_error_(false),
+  is_scanned_(false),
+  is_proc_error_(false),
+  prev_scan_time_(0.0)
 {
   using namespace std::literals::chrono_literals;
 
@@ -64,6 +79,15 @@ ProcessMonitor::ProcessMonitor(const rclcpp::NodeOptions & options)
 }
 
 void ProcessMonitor::monitorProcesses(diagnostic_updater::DiagnosticStatusWrapper & stat)
+{
+  if (use_top_) {
+    monitorProcessesByTop(stat);
+  } else {
+    monitorProcessesByProcFs(stat);
+  }
+}
+
+void ProcessMonitor::monitorProcessesByTop(diagnostic_updater::DiagnosticStatusWrapper & stat)
 {
   // thread-safe read
   std::string str;
@@ -114,6 +138,55 @@ void ProcessMonitor::monitorProcesses(diagnostic_updater::DiagnosticStatusWrappe
   stat.addf("execution time", "%f ms", elapsed_ms);
 }
 
+void ProcessMonitor::monitorProcessesByProcFs(diagnostic_updater::DiagnosticStatusWrapper & stat)
+{
+  // thread-safe read
+  bool is_scanned;
+  bool is_proc_error;
+  std::string proc_error;
+  tasks_summary summary;
+  std::vector<process_info> high_load_procs;
+  std::vector<process_info> high_memory_procs;
+  double elapsed_ms;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_scanned = is_scanned_;
+    is_proc_error = is_proc_error_;
+    proc_error = proc_error_;
+    summary = tasks_summary_;
+    high_load_procs = high_load_procs_;
+    high_memory_procs = high_memory_procs_;
+    elapsed_ms = elapsed_ms_;
+  }
+
+  if (is_proc_error) {
+    stat.summary(DiagStatus::ERROR, "proc error");
+    stat.add("/proc", proc_error);
+    setErrorContent(&load_tasks_, "proc error", "/proc", proc_error);
+    setErrorContent(&memory_tasks_, "proc error", "/proc", proc_error);
+    return;
+  }
+
+  // If /proc not scanned yet
+  if (!is_scanned) {
+    // Send OK tentatively
+    stat.summary(DiagStatus::OK, "starting up");
+    return;
+  }
+
+  stat.add("total", summary.total_);
+  stat.add("running", summary.running_);
+  stat.add("sleeping", summary.sleeping_);
+  stat.add("stopped", summary.stopped_);
+  stat.add("zombie", summary.zombie_);
+  stat.summary(DiagStatus::OK, "OK");
+
+  setProcessContent(&load_tasks_, high_load_procs);
+  setProcessContent(&memory_tasks_, high_memory_procs);
+
+  stat.addf("execution time", "%f ms", elapsed_ms);
+}
+
 void ProcessMonitor::getTasksSummary(
   diagnostic_updater::DiagnosticStatusWrapper & stat, const std::string & output)
 {
@@ -490,7 +563,46 @@ void ProcessMonitor::setErrorContent(
   }
 }
 
+void ProcessMonitor::setProcessContent(
+  std::vector<std::shared_ptr<DiagTask>> * tasks, const std::vector<process_info> & procs)
+{
+  if (tasks == nullptr) {
+    return;
+  }
+
+  for (size_t index = 0; index < procs.size() && index < tasks->size(); ++index) {
+    const process_info & proc = procs[index];
+    const auto & task = tasks->at(index);
+    // same format as top command
+    const uint64_t centiseconds = proc.ticks_ * 100 / sysconf(_SC_CLK_TCK);
+
+    task->setDiagnosticsStatus(DiagStatus::OK, "OK");
+    task->setProcessId(std::to_string(proc.pid_));
+    task->setUserName(getUserName(proc.uid_));
+    task->setPriority(proc.priority_ <= -100 ? "rt" : std::to_string(proc.priority_));
+    task->setNiceValue(std::to_string(proc.nice_));
+    task->setVirtualImage(std::to_string(proc.virt_));
+    task->setResidentSize(std::to_string(proc.res_));
+    task->setSharedMemSize(std::to_string(proc.shr_));
+    task->setProcessStatus(std::string(1, proc.state_));
+    task->setCPUUsage(fmt::format("{:.1f}", proc.cpu_));
+    task->setMemoryUsage(fmt::format("{:.1f}", proc.mem_));
+    task->setCPUTime(fmt::format(
+      "{}:{:02}.{:02}", centiseconds / 6000, centiseconds / 100 % 60, centiseconds % 100));
+    task->setCommandName(proc.command_);
+  }
+}
+
 void ProcessMonitor::onTimer()
+{
+  if (use_top_) {
+    executeTop();
+  } else {
+    scanProcFs();
+  }
+}
+
+void ProcessMonitor::executeTop()
 {
   bool is_top_error = false;
 
@@ -543,5 +655,191 @@ void ProcessMonitor::onTimer()
   }
 }
 
+void ProcessMonitor::scanProcFs()
+{
+  // Start to measure elapsed time
+  tier4_autoware_utils::StopWatch<std::chrono::milliseconds> stop_watch;
+  stop_watch.tic("execution_time");
+
+  DIR * dir = opendir("/proc");
+  if (dir == nullptr) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    proc_error_ = std::string(strerror(errno));
+    is_proc_error_ = true;
+    return;
+  }
+
+  // the same clock as the start time of processes
+  timespec now;
+  clock_gettime(CLOCK_BOOTTIME, &now);
+  const double scan_time = now.tv_sec + now.tv_nsec * 1e-9;
+  const double ticks_per_second = sysconf(_SC_CLK_TCK);
+
+  struct sysinfo info;
+  const double mem_total_kib =
+    (sysinfo(&info) == 0) ? static_cast<double>(info.totalram) * info.mem_unit / 1024 : 0.0;
+
+  tasks_summary summary;
+  procs_.clear();
+  curr_ticks_.clear();
+
+  const dirent * entry;
+  while ((entry = readdir(dir)) != nullptr) {
+    char * end;
+    const int pid = std::strtol(entry->d_name, &end, 10);
+    if (*end != '\0' || pid <= 0) {
+      continue;
+    }
+    process_info proc;
+    // the process may have exited after readdir
+    if (!readProcess(pid, proc)) {
+      continue;
+    }
+
+    // CPU usage since the previous scan, or since the process started
+    const auto prev = prev_ticks_.find(pid);
+    double elapsed;
+    uint64_t ticks;
+    if (prev != prev_ticks_.end() && prev->second.start_time_ == proc.start_time_) {
+      elapsed = scan_time - prev_scan_time_;
+      ticks = proc.ticks_ - std::min(proc.ticks_, prev->second.ticks_);
+    } else {
+      elapsed = scan_time - proc.start_time_ / ticks_per_second;
+      ticks = proc.ticks_;
+    }
+    proc.cpu_ = (elapsed > 0.0) ? ticks / ticks_per_second / elapsed * 100.0 : 0.0;
+    proc.mem_ = (mem_total_kib > 0.0) ? proc.res_ / mem_total_kib * 100.0 : 0.0;
+    curr_ticks_[pid] = process_ticks{proc.ticks_, proc.start_time_};
+
+    ++summary.total_;
+    switch (proc.state_) {
+      case 'R':
+        ++summary.running_;
+        break;
+      case 'S':
+      case 'D':
+      case 'I':
+        ++summary.sleeping_;
+        break;
+      case 'T':
+      case 't':
+        ++summary.stopped_;
+        break;
+      case 'Z':
+        ++summary.zombie_;
+        break;
+      default:
+        break;
+    }
+    procs_.push_back(std::move(proc));
+  }
+  closedir(dir);
+
+  prev_ticks_.swap(curr_ticks_);
+  prev_scan_time_ = scan_time;
+
+  // Only the top-rated processes need to be sorted
+  const auto num_of_procs = std::min(procs_.size(), static_cast<size_t>(num_of_procs_));
+  std::vector<process_info> high_load_procs(num_of_procs);
+  std::partial_sort_copy(
+    procs_.begin(), procs_.end(), high_load_procs.begin(), high_load_procs.end(),
+    [](const process_info & a, const process_info & b) { return a.cpu_ > b.cpu_; });
+  std::vector<process_info> high_memory_procs(num_of_procs);
+  std::partial_sort_copy(
+    procs_.begin(), procs_.end(), high_memory_procs.begin(), high_memory_procs.end(),
+    [](const process_info & a, const process_info & b) { return a.res_ > b.res_; });
+
+  const double elapsed_ms = stop_watch.toc("execution_time");
+
+  // thread-safe copy
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_summary_ = summary;
+    high_load_procs_.swap(high_load_procs);
+    high_memory_procs_.swap(high_memory_procs);
+    is_scanned_ = true;
+    is_proc_error_ = false;
+    elapsed_ms_ = elapsed_ms;
+  }
+}
+
+bool ProcessMonitor::readProcess(int pid, process_info & proc)
+{
+  char path[32];
+  char buffer[1024];
+
+  snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+  int fd = open(path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  const bool is_stat_ok = (fstat(fd, &st) == 0);
+  ssize_t size = read(fd, buffer, sizeof(buffer) - 1);
+  close(fd);
+  if (!is_stat_ok || size <= 0) {
+    return false;
+  }
+  buffer[size] = '\0';
+
+  // comm is enclosed in parentheses and may contain spaces and parentheses
+  const char * begin = strchr(buffer, '(');
+  const char * end = strrchr(buffer, ')');
+  if (begin == nullptr || end == nullptr || end < begin) {
+    return false;
+  }
+  uint64_t utime;
+  uint64_t stime;
+  if (
+    sscanf(
+      end + 2,
+      "%c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %" SCNu64 " %" SCNu64 " %*d %*d %" SCNd64
+      " %" SCNd64 " %*d %*d %" SCNu64,
+      &proc.state_, &utime, &stime, &proc.priority_, &proc.nice_, &proc.start_time_) != 6) {
+    return false;
+  }
+  proc.pid_ = pid;
+  proc.uid_ = st.st_uid;
+  proc.ticks_ = utime + stime;
+  proc.command_.assign(begin + 1, end);
+
+  snprintf(path, sizeof(path), "/proc/%d/statm", pid);
+  fd = open(path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+  size = read(fd, buffer, sizeof(buffer) - 1);
+  close(fd);
+  if (size <= 0) {
+    return false;
+  }
+  buffer[size] = '\0';
+
+  uint64_t virt;
+  uint64_t res;
+  uint64_t shr;
+  if (sscanf(buffer, "%" SCNu64 " %" SCNu64 " %" SCNu64, &virt, &res, &shr) != 3) {
+    return false;
+  }
+  const uint64_t page_kib = sysconf(_SC_PAGESIZE) / 1024;
+  proc.virt_ = virt * page_kib;
+  proc.res_ = res * page_kib;
+  proc.shr_ = shr * page_kib;
+  return true;
+}
+
+const std::string & ProcessMonitor::getUserName(uid_t uid)
+{
+  auto itr = user_names_.find(uid);
+  if (itr == user_names_.end()) {
+    passwd pwd;
+    passwd * result = nullptr;
+    char buffer[1024];
+    getpwuid_r(uid, &pwd, buffer, sizeof(buffer), &result);
+    itr = user_names_.emplace(uid, result ? result->pw_name : std::to_string(uid)).first;
+  }
+  return itr->second;
+}
+
 #include <rclcpp_components/register_node_macro.hpp>
 RCLCPP_COMPONENTS_REGISTER_NODE(ProcessMonitor)
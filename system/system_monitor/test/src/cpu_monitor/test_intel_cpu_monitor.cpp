@@ -65,6 +65,7 @@ public:
 
   void changeUsageWarn(float usage_warn) { usage_warn_ = usage_warn; }
   void changeUsageError(float usage_error) { usage_error_ = usage_error; }
+  void setUseMpstat(bool use_mpstat) { use_mpstat_ = use_mpstat; }
 
   void update() { updater_.force_update(); }
 
@@ -562,6 +563,9 @@ TEST_F(CPUMonitorTestSuite, usageErrorTest)
 
 TEST_F(CPUMonitorTestSuite, usageMpstatNotFoundTest)
 {
+  // Use mpstat backend
+  monitor_->setUseMpstat(true);
+
   // Set flag false
   monitor_->setMpstatExists(false);
 
@@ -838,6 +842,9 @@ TEST_F(CPUMonitorTestSuite, freqFrequencyFilesNotFoundTest)
 
 TEST_F(CPUMonitorTestSuite, usageMpstatErrorTest)
 {
+  // Use mpstat backend
+  monitor_->setUseMpstat(true);
+
   // Symlink mpstat1 to mpstat
   fs::create_symlink(exe_dir_ + "/mpstat1", mpstat_);
 
@@ -862,6 +869,9 @@ TEST_F(CPUMonitorTestSuite, usageMpstatErrorTest)
 
 TEST_F(CPUMonitorTestSuite, usageMpstatExceptionTest)
 {
+  // Use mpstat backend
+  monitor_->setUseMpstat(true);
+
   // Symlink mpstat2 to mpstat
   fs::create_symlink(exe_dir_ + "/mpstat2", mpstat_);
 
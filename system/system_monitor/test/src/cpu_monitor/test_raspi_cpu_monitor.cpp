@@ -60,6 +60,7 @@ public:
 
   void changeUsageWarn(float usage_warn) { usage_warn_ = usage_warn; }
   void changeUsageError(float usage_error) { usage_error_ = usage_error; }
+  void setUseMpstat(bool use_mpstat) { use_mpstat_ = use_mpstat; }
 
   void changeLoad1Warn(float load1_warn) { load1_warn_ = load1_warn; }
   void changeLoad5Warn(float load5_warn) { load5_warn_ = load5_warn; }
@@ -431,6 +432,9 @@ TEST_F(CPUMonitorTestSuite, usageErrorTest)
 
 TEST_F(CPUMonitorTestSuite, usageMpstatNotFoundTest)
 {
+  // Use mpstat backend
+  monitor_->setUseMpstat(true);
+
   // Set flag false
   monitor_->setMpstatExists(false);
 
@@ -615,6 +619,9 @@ TEST_F(CPUMonitorTestSuite, freqFrequencyFilesNotFoundTest)
 
 TEST_F(CPUMonitorTestSuite, usageMpstatErrorTest)
 {
+  // Use mpstat backend
+  monitor_->setUseMpstat(true);
+
   // Symlink mpstat1 to mpstat
   fs::create_symlink(exe_dir_ + "/mpstat1", mpstat_);
 
@@ -640,6 +647,9 @@ TEST_F(CPUMonitorTestSuite, usageMpstatErrorTest)
 
 TEST_F(CPUMonitorTestSuite, usageMpstatExceptionTest)
 {
+  // Use mpstat backend
+  monitor_->setUseMpstat(true);
+
   // Symlink mpstat2 to mpstat
   fs::create_symlink(exe_dir_ + "/mpstat2", mpstat_);
 
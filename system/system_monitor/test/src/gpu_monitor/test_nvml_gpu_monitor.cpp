@@ -55,7 +55,7 @@ public:
     memory_usage_error_ = memory_usage_error;
   }
 
-  void update() { updater_.force_update(); }
+  void update() { GPUMonitor::update(); }
 
   const std::string removePrefix(const std::string & name)
   {
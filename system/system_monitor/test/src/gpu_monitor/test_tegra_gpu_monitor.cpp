@@ -53,7 +53,7 @@ public:
   void addFreqName(const std::string & path) { freqs_.emplace_back(path, path); }
   void clearFreqNames() { freqs_.clear(); }
 
-  void update() { updater_.force_update(); }
+  void update() { GPUMonitor::update(); }
 
   const std::string removePrefix(const std::string & name)
   {
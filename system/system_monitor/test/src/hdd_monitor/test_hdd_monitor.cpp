@@ -19,16 +19,12 @@
 
 #include <boost/algorithm/string.hpp>
 #include <boost/archive/text_oarchive.hpp>
-#include <boost/filesystem.hpp>
-#include <boost/process.hpp>
 
-#include <fmt/format.h>
 #include <gtest/gtest.h>
 
 #include <memory>
 #include <string>
 
-namespace fs = boost::filesystem;
 using DiagStatus = diagnostic_msgs::msg::DiagnosticStatus;
 
 char ** argv_;
@@ -82,6 +78,8 @@ public:
 
   void clearHddParams() { hdd_params_.clear(); }
 
+  void setHddConnected(const std::string & name) { hdd_connected_flags_[name] = true; }
+
   void update() { updater_.force_update(); }
 
   const std::string removePrefix(const std::string & name)
@@ -107,21 +105,9 @@ private:
 
 class HddMonitorTestSuite : public ::testing::Test
 {
-public:
-  HddMonitorTestSuite()
-  {
-    // Get directory of executable
-    const fs::path exe_path(argv_[0]);
-    exe_dir_ = exe_path.parent_path().generic_string();
-    // Get dummy executable path
-    df_ = exe_dir_ + "/df";
-  }
-
 protected:
   std::unique_ptr<TestHddMonitor> monitor_;
   rclcpp::Subscription<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr sub_;
-  std::string exe_dir_;
-  std::string df_;
 
   void SetUp()
   {
@@ -131,18 +117,10 @@ protected:
     monitor_ = std::make_unique<TestHddMonitor>("test_hdd_monitor", node_options);
     sub_ = monitor_->create_subscription<diagnostic_msgs::msg::DiagnosticArray>(
       "/diagnostics", 1000, std::bind(&TestHddMonitor::diagCallback, monitor_.get(), _1));
-    // Remove dummy executable if exists
-    if (fs::exists(df_)) {
-      fs::remove(df_);
-    }
   }
 
   void TearDown()
   {
-    // Remove dummy executable if exists
-    if (fs::exists(df_)) {
-      fs::remove(df_);
-    }
     rclcpp::shutdown();
   }
 
@@ -156,15 +134,6 @@ protected:
     }
     return false;
   }
-
-  void modifyPath()
-  {
-    // Modify PATH temporarily
-    auto env = boost::this_process::environment();
-    std::string new_path = env["PATH"].to_string();
-    new_path.insert(0, fmt::format("{}:", exe_dir_));
-    env["PATH"] = new_path;
-  }
 };
 
 enum ThreadTestMode {
@@ -678,13 +647,12 @@ TEST_F(HddMonitorTestSuite, usageErrorTest)
   }
 }
 
-TEST_F(HddMonitorTestSuite, usageDfErrorTest)
+TEST_F(HddMonitorTestSuite, usageStatvfsErrorTest)
 {
-  // Symlink df1 to df
-  fs::create_symlink(exe_dir_ + "/df1", df_);
-
-  // Modify PATH temporarily
-  modifyPath();
+  // Mount point which does not exist
+  monitor_->clearHddParams();
+  monitor_->addHddParams("/nonexistent_mount_point", 55.0, 77.0, 0.95, 0.99);
+  monitor_->setHddConnected("/nonexistent_mount_point");
 
   // Publish topic
   monitor_->update();
@@ -699,8 +667,8 @@ TEST_F(HddMonitorTestSuite, usageDfErrorTest)
 
   ASSERT_TRUE(monitor_->findDiagStatus("HDD Usage", status));
   ASSERT_EQ(status.level, DiagStatus::ERROR);
-  ASSERT_STREQ(status.message.c_str(), "df error");
-  ASSERT_TRUE(findValue(status, "HDD 0: df", value));
+  ASSERT_STREQ(status.message.c_str(), "statvfs error");
+  ASSERT_TRUE(findValue(status, "HDD 0: statvfs", value));
 }
 
 int main(int argc, char ** argv)
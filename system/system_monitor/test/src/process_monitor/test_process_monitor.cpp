@@ -49,6 +49,8 @@ public:
 
   int getNumOfProcs() const { return num_of_procs_; }
 
+  void setUseTop(bool use_top) { use_top_ = use_top; }
+
   void update() { updater_.force_update(); }
 
   const std::string removePrefix(const std::string & name)
@@ -214,6 +216,9 @@ TEST_F(ProcessMonitorTestSuite, highMemProcTest)
 
 TEST_F(ProcessMonitorTestSuite, topErrorTest)
 {
+  // Use top backend
+  monitor_->setUseTop(true);
+
   // Symlink top1 to top
   fs::create_symlink(exe_dir_ + "/top1", top_);
 
@@ -250,6 +255,9 @@ TEST_F(ProcessMonitorTestSuite, topErrorTest)
 
 TEST_F(ProcessMonitorTestSuite, matchingPatternNotFoundTest)
 {
+  // Use top backend
+  monitor_->setUseTop(true);
+
   // Symlink top2 to top
   fs::create_symlink(exe_dir_ + "/top2", top_);
 
@@ -274,6 +282,9 @@ TEST_F(ProcessMonitorTestSuite, matchingPatternNotFoundTest)
 
 TEST_F(ProcessMonitorTestSuite, invalidFormatTest)
 {
+  // Use top backend
+  monitor_->setUseTop(true);
+
   // Symlink top3 to top
   fs::create_symlink(exe_dir_ + "/top3", top_);
 
@@ -298,6 +309,9 @@ TEST_F(ProcessMonitorTestSuite, invalidFormatTest)
 
 TEST_F(ProcessMonitorTestSuite, echoErrorTest)
 {
+  // Use top backend
+  monitor_->setUseTop(true);
+
   // Symlink sed1 to sed
   fs::create_symlink(exe_dir_ + "/echo1", echo_);
 
@@ -322,6 +336,9 @@ TEST_F(ProcessMonitorTestSuite, echoErrorTest)
 
 TEST_F(ProcessMonitorTestSuite, sedErrorTest)
 {
+  // Use top backend
+  monitor_->setUseTop(true);
+
   // Symlink sed1 to sed
   fs::create_symlink(exe_dir_ + "/sed1", sed_);
 
@@ -346,6 +363,9 @@ TEST_F(ProcessMonitorTestSuite, sedErrorTest)
 
 TEST_F(ProcessMonitorTestSuite, sortErrorTest)
 {
+  // Use top backend
+  monitor_->setUseTop(true);
+
   // Symlink sort1 to sort
   fs::create_symlink(exe_dir_ + "/sort1", sort_);
 
@@ -33,6 +33,10 @@ namespace topic_state_monitor
 struct NodeParam
 {
   double update_rate;
+};
+
+struct TopicParam
+{
   std::string diag_name;
   std::string topic;
   std::string topic_type;
@@ -51,7 +55,14 @@ public:
 private:
   // Parameter
   NodeParam node_param_;
-  Param param_;
+
+  // Monitored topics, one element per topic
+  // The parameters of each topic are prefixed with "<name>." if they are given by "topics"
+  std::vector<std::string> param_prefixes_;
+  std::vector<TopicParam> topic_params_;
+  std::vector<Param> params_;
+
+  void declareTopicParam(const std::string & prefix, const Param & default_param);
 
   // Parameter Reconfigure
   OnSetParametersCallbackHandle::SharedPtr set_param_res_;
@@ -59,11 +70,12 @@ private:
     const std::vector<rclcpp::Parameter> & parameters);
 
   // Core
-  std::unique_ptr<TopicStateMonitor> topic_state_monitor_;
+  std::vector<TopicStateMonitor> topic_state_monitors_;
 
   // Subscriber
-  rclcpp::GenericSubscription::SharedPtr sub_topic_;
-  rclcpp::Subscription<tf2_msgs::msg::TFMessage>::SharedPtr sub_transform_;
+  std::vector<rclcpp::GenericSubscription::SharedPtr> sub_topics_;
+  std::vector<rclcpp::Subscription<tf2_msgs::msg::TFMessage>::SharedPtr> sub_transforms_;
+  std::map<std::string, std::vector<size_t>> transform_indices_;  // by transform topic
 
   // Timer
   void onTimer();
@@ -72,7 +84,7 @@ private:
   // Diagnostic Updater
   diagnostic_updater::Updater updater_;
 
-  void checkTopicStatus(diagnostic_updater::DiagnosticStatusWrapper & stat);
+  void checkTopicStatus(diagnostic_updater::DiagnosticStatusWrapper & stat, const size_t index);
 };
 }  // namespace topic_state_monitor
 
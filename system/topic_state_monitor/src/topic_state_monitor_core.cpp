@@ -14,6 +14,7 @@
 
 #include "topic_state_monitor/topic_state_monitor_core.hpp"
 
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -43,63 +44,83 @@ TopicStateMonitorNode::TopicStateMonitorNode(const rclcpp::NodeOptions & node_op
 
   // Parameter
   node_param_.update_rate = declare_parameter("update_rate", 10.0);
-  node_param_.topic = declare_parameter<std::string>("topic");
-  node_param_.transient_local = declare_parameter("transient_local", false);
-  node_param_.best_effort = declare_parameter("best_effort", false);
-  node_param_.diag_name = declare_parameter<std::string>("diag_name");
-  node_param_.is_transform = (node_param_.topic == "/tf" || node_param_.topic == "/tf_static");
-
-  if (node_param_.is_transform) {
-    node_param_.frame_id = declare_parameter<std::string>("frame_id");
-    node_param_.child_frame_id = declare_parameter<std::string>("child_frame_id");
+
+  Param default_param;
+  default_param.warn_rate = declare_parameter("warn_rate", 0.5);
+  default_param.error_rate = declare_parameter("error_rate", 0.1);
+  default_param.timeout = declare_parameter("timeout", 1.0);
+  default_param.window_size = declare_parameter("window_size", 10);
+
+  // Monitor the topics listed in "topics" with "<name>." prefixed parameters,
+  // or the single topic given by the parameters without prefix
+  const auto topic_names =
+    declare_parameter<std::vector<std::string>>("topics", std::vector<std::string>{});
+  if (topic_names.empty()) {
+    declareTopicParam("", default_param);
   } else {
-    node_param_.topic_type = declare_parameter<std::string>("topic_type");
+    for (const auto & topic_name : topic_names) {
+      declareTopicParam(topic_name + ".", default_param);
+    }
   }
 
-  param_.warn_rate = declare_parameter("warn_rate", 0.5);
-  param_.error_rate = declare_parameter("error_rate", 0.1);
-  param_.timeout = declare_parameter("timeout", 1.0);
-  param_.window_size = declare_parameter("window_size", 10);
-
   // Parameter Reconfigure
   set_param_res_ =
     this->add_on_set_parameters_callback(std::bind(&TopicStateMonitorNode::onParameter, this, _1));
 
   // Core
-  topic_state_monitor_ = std::make_unique<TopicStateMonitor>(*this);
-  topic_state_monitor_->setParam(param_);
+  topic_state_monitors_.reserve(topic_params_.size());
+  for (const auto & param : params_) {
+    topic_state_monitors_.emplace_back(*this);
+    topic_state_monitors_.back().setParam(param);
+  }
 
   // Subscriber
-  rclcpp::QoS qos = rclcpp::QoS{1};
-  if (node_param_.transient_local) {
-    qos.transient_local();
-  }
-  if (node_param_.best_effort) {
-    qos.best_effort();
-  }
+  // Transforms of the same topic share one subscription since they need to be deserialized
+  for (size_t i = 0; i < topic_params_.size(); ++i) {
+    const auto & topic_param = topic_params_.at(i);
+
+    rclcpp::QoS qos = rclcpp::QoS{1};
+    if (topic_param.transient_local) {
+      qos.transient_local();
+    }
+    if (topic_param.best_effort) {
+      qos.best_effort();
+    }
 
-  if (node_param_.is_transform) {
-    sub_transform_ = this->create_subscription<tf2_msgs::msg::TFMessage>(
-      node_param_.topic, qos, [this](tf2_msgs::msg::TFMessage::ConstSharedPtr msg) {
-        for (const auto & transform : msg->transforms) {
-          if (
-            transform.header.frame_id == node_param_.frame_id &&
-            transform.child_frame_id == node_param_.child_frame_id) {
-            topic_state_monitor_->update();
+    if (topic_param.is_transform) {
+      auto & indices = transform_indices_[topic_param.topic];
+      indices.push_back(i);
+      if (indices.size() > 1) {
+        continue;
+      }
+      sub_transforms_.push_back(this->create_subscription<tf2_msgs::msg::TFMessage>(
+        topic_param.topic, qos, [this, &indices](tf2_msgs::msg::TFMessage::ConstSharedPtr msg) {
+          for (const auto & transform : msg->transforms) {
+            for (const auto index : indices) {
+              if (
+                transform.header.frame_id == topic_params_.at(index).frame_id &&
+                transform.child_frame_id == topic_params_.at(index).child_frame_id) {
+                topic_state_monitors_.at(index).update();
+              }
+            }
           }
-        }
-      });
-  } else {
-    sub_topic_ = this->create_generic_subscription(
-      node_param_.topic, node_param_.topic_type, qos,
-      [this]([[maybe_unused]] std::shared_ptr<rclcpp::SerializedMessage> msg) {
-        topic_state_monitor_->update();
-      });
+        }));
+    } else {
+      sub_topics_.push_back(this->create_generic_subscription(
+        topic_param.topic, topic_param.topic_type, qos,
+        [this, i]([[maybe_unused]] std::shared_ptr<rclcpp::SerializedMessage> msg) {
+          topic_state_monitors_.at(i).update();
+        }));
+    }
   }
 
   // Diagnostic Updater
   updater_.setHardwareID("topic_state_monitor");
-  updater_.add(node_param_.diag_name, this, &TopicStateMonitorNode::checkTopicStatus);
+  for (size_t i = 0; i < topic_params_.size(); ++i) {
+    updater_.add(
+      topic_params_.at(i).diag_name,
+      [this, i](diagnostic_updater::DiagnosticStatusWrapper & stat) { checkTopicStatus(stat, i); });
+  }
 
   // Timer
   const auto period_ns = rclcpp::Rate(node_param_.update_rate).period();
@@ -107,6 +128,36 @@ TopicStateMonitorNode::TopicStateMonitorNode(const rclcpp::NodeOptions & node_op
     this, get_clock(), period_ns, std::bind(&TopicStateMonitorNode::onTimer, this));
 }
 
+void TopicStateMonitorNode::declareTopicParam(
+  const std::string & prefix, const Param & default_param)
+{
+  TopicParam topic_param;
+  topic_param.topic = declare_parameter<std::string>(prefix + "topic");
+  topic_param.transient_local = declare_parameter(prefix + "transient_local", false);
+  topic_param.best_effort = declare_parameter(prefix + "best_effort", false);
+  topic_param.diag_name = declare_parameter<std::string>(prefix + "diag_name");
+  topic_param.is_transform = (topic_param.topic == "/tf" || topic_param.topic == "/tf_static");
+
+  if (topic_param.is_transform) {
+    topic_param.frame_id = declare_parameter<std::string>(prefix + "frame_id");
+    topic_param.child_frame_id = declare_parameter<std::string>(prefix + "child_frame_id");
+  } else {
+    topic_param.topic_type = declare_parameter<std::string>(prefix + "topic_type");
+  }
+
+  Param param = default_param;
+  if (!prefix.empty()) {
+    param.warn_rate = declare_parameter(prefix + "warn_rate", default_param.warn_rate);
+    param.error_rate = declare_parameter(prefix + "error_rate", default_param.error_rate);
+    param.timeout = declare_parameter(prefix + "timeout", default_param.timeout);
+    param.window_size = declare_parameter(prefix + "window_size", default_param.window_size);
+  }
+
+  param_prefixes_.push_back(prefix);
+  topic_params_.push_back(topic_param);
+  params_.push_back(param);
+}
+
 rcl_interfaces::msg::SetParametersResult TopicStateMonitorNode::onParameter(
   const std::vector<rclcpp::Parameter> & parameters)
 {
@@ -115,11 +166,15 @@ rcl_interfaces::msg::SetParametersResult TopicStateMonitorNode::onParameter(
   result.reason = "success";
 
   try {
-    update_param(parameters, "warn_rate", param_.warn_rate);
-    update_param(parameters, "error_rate", param_.error_rate);
-    update_param(parameters, "timeout", param_.timeout);
-    update_param(parameters, "window_size", param_.window_size);
-    topic_state_monitor_->setParam(param_);
+    for (size_t i = 0; i < params_.size(); ++i) {
+      const auto & prefix = param_prefixes_.at(i);
+      auto & param = params_.at(i);
+      update_param(parameters, prefix + "warn_rate", param.warn_rate);
+      update_param(parameters, prefix + "error_rate", param.error_rate);
+      update_param(parameters, prefix + "timeout", param.timeout);
+      update_param(parameters, prefix + "window_size", param.window_size);
+      topic_state_monitors_.at(i).setParam(param);
+    }
   } catch (const rclcpp::exceptions::InvalidParameterTypeException & e) {
     result.successful = false;
     result.reason = e.what();
@@ -134,21 +189,26 @@ void TopicStateMonitorNode::onTimer()
   updater_.force_update();
 }
 
-void TopicStateMonitorNode::checkTopicStatus(diagnostic_updater::DiagnosticStatusWrapper & stat)
+void TopicStateMonitorNode::checkTopicStatus(
+  diagnostic_updater::DiagnosticStatusWrapper & stat, const size_t index)
 {
   using diagnostic_msgs::msg::DiagnosticStatus;
 
+  const auto & topic_param = topic_params_.at(index);
+  const auto & param = params_.at(index);
+  const auto & topic_state_monitor = topic_state_monitors_.at(index);
+
   // Get information
-  const auto topic_status = topic_state_monitor_->getTopicStatus();
-  const auto last_message_time = topic_state_monitor_->getLastMessageTime();
-  const auto topic_rate = topic_state_monitor_->getTopicRate();
+  const auto topic_status = topic_state_monitor.getTopicStatus();
+  const auto last_message_time = topic_state_monitor.getLastMessageTime();
+  const auto topic_rate = topic_state_monitor.getTopicRate();
 
   // Add topic name
-  if (node_param_.is_transform) {
-    const auto frame = "(" + node_param_.frame_id + " to " + node_param_.child_frame_id + ")";
-    stat.addf("topic", "%s %s", node_param_.topic.c_str(), frame.c_str());
+  if (topic_param.is_transform) {
+    const auto frame = "(" + topic_param.frame_id + " to " + topic_param.child_frame_id + ")";
+    stat.addf("topic", "%s %s", topic_param.topic.c_str(), frame.c_str());
   } else {
-    stat.addf("topic", "%s", node_param_.topic.c_str());
+    stat.addf("topic", "%s", topic_param.topic.c_str());
   }
 
   // Judge level
@@ -171,9 +231,9 @@ void TopicStateMonitorNode::checkTopicStatus(diagnostic_updater::DiagnosticStatu
   }
 
   // Add key-value
-  stat.addf("warn_rate", "%.2f [Hz]", param_.warn_rate);
-  stat.addf("error_rate", "%.2f [Hz]", param_.error_rate);
-  stat.addf("timeout", "%.2f [s]", param_.timeout);
+  stat.addf("warn_rate", "%.2f [Hz]", param.warn_rate);
+  stat.addf("error_rate", "%.2f [Hz]", param.error_rate);
+  stat.addf("timeout", "%.2f [s]", param.timeout);
   stat.addf("measured_rate", "%.2f [Hz]", topic_rate);
   stat.addf("now", "%.2f [s]", this->now().seconds());
   stat.addf("last_message_time", "%.2f [s]", last_message_time.seconds());
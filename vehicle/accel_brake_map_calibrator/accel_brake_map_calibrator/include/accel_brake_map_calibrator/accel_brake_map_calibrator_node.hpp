@@ -21,6 +21,7 @@
 #include "raw_vehicle_cmd_converter/accel_map.hpp"
 #include "raw_vehicle_cmd_converter/brake_map.hpp"
 #include "rclcpp/rclcpp.hpp"
+#include "tf2/buffer_core.h"
 #include "tf2/utils.h"
 #include "tier4_autoware_utils/ros/transform_listener.hpp"
 
@@ -31,11 +32,13 @@
 #include "autoware_auto_vehicle_msgs/msg/velocity_report.hpp"
 #include "geometry_msgs/msg/twist_stamped.hpp"
 #include "nav_msgs/msg/occupancy_grid.hpp"
+#include "rosbag2_storage/serialized_bag_message.hpp"
 #include "std_msgs/msg/bool.hpp"
 #include "std_msgs/msg/float32_multi_array.hpp"
 #include "std_msgs/msg/multi_array_dimension.hpp"
 #include "std_msgs/msg/string.hpp"
 #include "tf2_geometry_msgs/tf2_geometry_msgs.hpp"
+#include "tf2_msgs/msg/tf_message.hpp"
 #include "tier4_debug_msgs/msg/float32_multi_array_stamped.hpp"
 #include "tier4_debug_msgs/msg/float32_stamped.hpp"
 #include "tier4_external_api_msgs/msg/calibration_status.hpp"
@@ -64,6 +67,7 @@ using std_msgs::msg::Float32MultiArray;
 using tier4_debug_msgs::msg::Float32MultiArrayStamped;
 using tier4_debug_msgs::msg::Float32Stamped;
 using tier4_external_api_msgs::msg::CalibrationStatus;
+using tf2_msgs::msg::TFMessage;
 using tier4_vehicle_msgs::msg::ActuationStatusStamped;
 using visualization_msgs::msg::MarkerArray;
 
@@ -215,6 +219,17 @@ private:
   int too_large_pedal_spd_count_ = 0;
   int update_fail_count_ = 0;
 
+  // for four cell around update
+  Map accel_map_offset_vec_;
+  Map brake_map_offset_vec_;
+  std::vector<std::vector<Eigen::Matrix4d>> accel_covariance_mat_;
+  std::vector<std::vector<Eigen::Matrix4d>> brake_covariance_mat_;
+
+  // for offline calibration
+  std::string offline_bag_path_;
+  std::unique_ptr<tf2::BufferCore> offline_tf_buffer_;
+  rclcpp::Time offline_time_{0, 0, RCL_ROS_TIME};
+
   // for map update
   double map_offset_ = 0.0;
   double map_coef_ = 1.0;
@@ -226,6 +241,8 @@ private:
   std::ofstream output_log_;
 
   bool getCurrentPitchFromTF(double * pitch);
+  rclcpp::Time getCurrentTime();
+  void dispatchOfflineMessage(const rosbag2_storage::SerializedBagMessage & bag_msg);
   void timerCallback();
   void timerCallbackOutputCSV();
   void executeUpdate(
@@ -359,6 +376,10 @@ private:
 
 public:
   explicit AccelBrakeMapCalibrator(const rclcpp::NodeOptions & node_options);
+
+  // offline mode: the recorded bag is replayed by runOfflineCalibration() instead of subscribing
+  bool isOfflineMode() const { return !offline_bag_path_.empty(); }
+  bool runOfflineCalibration();
 };
 
 }  // namespace accel_brake_map_calibrator
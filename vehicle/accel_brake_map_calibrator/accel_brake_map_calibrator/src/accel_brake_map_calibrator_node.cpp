@@ -17,10 +17,13 @@
 #include "accel_brake_map_calibrator/accel_brake_map_calibrator_node.hpp"
 
 #include "rclcpp/logging.hpp"
+#include "rclcpp/serialization.hpp"
+#include "rosbag2_cpp/reader.hpp"
 
 #include <algorithm>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <queue>
 #include <string>
 #include <utility>
@@ -28,6 +31,18 @@
 
 namespace accel_brake_map_calibrator
 {
+namespace
+{
+template <class T>
+std::shared_ptr<T> deserializeBagMessage(const rosbag2_storage::SerializedBagMessage & bag_msg)
+{
+  static rclcpp::Serialization<T> serialization;
+  const rclcpp::SerializedMessage serialized_msg(*bag_msg.serialized_data);
+  auto msg = std::make_shared<T>();
+  serialization.deserialize_message(&serialized_msg, msg.get());
+  return msg;
+}
+}  // namespace
 
 AccelBrakeMapCalibrator::AccelBrakeMapCalibrator(const rclcpp::NodeOptions & node_options)
 : Node("accel_brake_map_calibrator", node_options)
@@ -168,6 +183,21 @@ AccelBrakeMapCalibrator::AccelBrakeMapCalibrator(const rclcpp::NodeOptions & nod
     brake_data_num_ = genConstMat(brake_map_value_, 1);
   }
 
+  // initialize offset and covariance for four cell around update
+  {
+    const auto genCovarianceMat = [this](const Map & map) {
+      return std::vector<std::vector<Eigen::Matrix4d>>(
+        map.size() - 1, std::vector<Eigen::Matrix4d>(
+                          map.at(0).size() - 1, Eigen::Matrix4d::Identity() * covariance_));
+    };
+    accel_map_offset_vec_ =
+      Map(accel_map_value_.size(), std::vector<double>(accel_map_value_.at(0).size(), map_offset_));
+    brake_map_offset_vec_ =
+      Map(brake_map_value_.size(), std::vector<double>(brake_map_value_.at(0).size(), map_offset_));
+    accel_covariance_mat_ = genCovarianceMat(accel_map_value_);
+    brake_covariance_mat_ = genCovarianceMat(brake_map_value_);
+  }
+
   // publisher
   update_suggest_pub_ =
     create_publisher<std_msgs::msg::Bool>("~/output/update_suggest", durable_qos);
@@ -191,6 +221,13 @@ AccelBrakeMapCalibrator::AccelBrakeMapCalibrator(const rclcpp::NodeOptions & nod
   offset_covariance_pub_ =
     create_publisher<Float32MultiArray>("~/debug/offset_covariance", durable_qos);
 
+  // in offline mode the recorded bag is replayed by runOfflineCalibration()
+  offline_bag_path_ = declare_parameter("offline_bag_path", std::string(""));
+  if (isOfflineMode()) {
+    offline_tf_buffer_ = std::make_unique<tf2::BufferCore>();
+    return;
+  }
+
   // subscriber
   using std::placeholders::_1;
   using std::placeholders::_2;
@@ -241,8 +278,17 @@ bool AccelBrakeMapCalibrator::getCurrentPitchFromTF(double * pitch)
   }
 
   // get tf
-  const auto transform = transform_listener_->getTransform(
-    "map", "base_link", rclcpp::Time(0), rclcpp::Duration::from_seconds(0.5));
+  geometry_msgs::msg::TransformStamped::ConstSharedPtr transform;
+  if (isOfflineMode()) {
+    try {
+      transform = std::make_shared<const geometry_msgs::msg::TransformStamped>(
+        offline_tf_buffer_->lookupTransform("map", "base_link", tf2::TimePointZero));
+    } catch (const tf2::TransformException &) {
+    }
+  } else {
+    transform = transform_listener_->getTransform(
+      "map", "base_link", rclcpp::Time(0), rclcpp::Duration::from_seconds(0.5));
+  }
   if (!transform) {
     RCLCPP_WARN_STREAM_THROTTLE(
       get_logger(), *get_clock(), 5000, "cannot get map to base_link transform. ");
@@ -256,6 +302,81 @@ bool AccelBrakeMapCalibrator::getCurrentPitchFromTF(double * pitch)
   return true;
 }
 
+rclcpp::Time AccelBrakeMapCalibrator::getCurrentTime()
+{
+  // in offline mode the clock is driven by the receive time of the replayed messages
+  return isOfflineMode() ? offline_time_ : this->now();
+}
+
+bool AccelBrakeMapCalibrator::runOfflineCalibration()
+{
+  const std::string velocity_topic =
+    get_node_topics_interface()->resolve_topic_name("~/input/velocity");
+  const std::string steer_topic = get_node_topics_interface()->resolve_topic_name("~/input/steer");
+  const std::string actuation_status_topic =
+    get_node_topics_interface()->resolve_topic_name("~/input/actuation_status");
+
+  rosbag2_cpp::Reader reader;
+  try {
+    reader.open(offline_bag_path_);
+  } catch (const std::exception & e) {
+    RCLCPP_ERROR_STREAM(
+      get_logger(), "Cannot open bag. path = " << offline_bag_path_ << ": " << e.what());
+    return false;
+  }
+  rosbag2_storage::StorageFilter filter;
+  filter.topics = {velocity_topic, steer_topic, actuation_status_topic, "/tf", "/tf_static"};
+  reader.set_filter(filter);
+
+  RCLCPP_INFO_STREAM(get_logger(), "start offline calibration. bag path = " << offline_bag_path_);
+
+  // run the timer callbacks in the time of the recorded data as fast as possible
+  const auto timer_period = rclcpp::Duration::from_seconds(1.0 / update_hz_);
+  const auto output_csv_period = rclcpp::Duration::from_seconds(30.0);
+  std::optional<rclcpp::Time> next_timer_time;
+  std::optional<rclcpp::Time> next_output_csv_time;
+  while (reader.has_next() && rclcpp::ok()) {
+    const auto bag_msg = reader.read_next();
+    const rclcpp::Time receive_time(bag_msg->time_stamp, RCL_ROS_TIME);
+    if (!next_timer_time) {
+      next_timer_time = receive_time + timer_period;
+      next_output_csv_time = receive_time + output_csv_period;
+    }
+    while (*next_timer_time <= receive_time) {
+      offline_time_ = *next_timer_time;
+      timerCallback();
+      *next_timer_time += timer_period;
+    }
+    if (*next_output_csv_time <= receive_time) {
+      offline_time_ = *next_output_csv_time;
+      timerCallbackOutputCSV();
+      *next_output_csv_time += output_csv_period;
+    }
+
+    offline_time_ = receive_time;
+    if (bag_msg->topic_name == velocity_topic) {
+      callbackVelocity(deserializeBagMessage<VelocityReport>(*bag_msg));
+    } else if (bag_msg->topic_name == steer_topic) {
+      callbackSteer(deserializeBagMessage<SteeringReport>(*bag_msg));
+    } else if (bag_msg->topic_name == actuation_status_topic) {
+      callbackActuationStatus(deserializeBagMessage<ActuationStatusStamped>(*bag_msg));
+    } else {
+      const bool is_static = bag_msg->topic_name == "/tf_static";
+      for (const auto & transform : deserializeBagMessage<TFMessage>(*bag_msg)->transforms) {
+        offline_tf_buffer_->setTransform(transform, "offline_calibration", is_static);
+      }
+    }
+  }
+
+  timerCallbackOutputCSV();
+  RCLCPP_INFO_STREAM(
+    get_logger(), "finish offline calibration. count: "
+                    << update_success_count_ << " / " << update_count_
+                    << ", current map error: " << part_original_accel_rmse_
+                    << ", updated map error: " << new_accel_rmse_);
+  return true;
+}
+
 void AccelBrakeMapCalibrator::timerCallback()
 {
   update_count_++;
@@ -317,19 +438,21 @@ void AccelBrakeMapCalibrator::timerCallback()
       new_accel_rmse_);
   }
 
-  /* publish map  & debug_values*/
-  publishMap(accel_map_value_, brake_map_value_, "original");
-  publishMap(update_accel_map_value_, update_brake_map_value_, "update");
-  publishOffsetCovMap(accel_offset_covariance_value_, brake_offset_covariance_value_);
-  publishCountMap();
-  publishIndex();
-  publishUpdateSuggestFlag();
-  debug_pub_->publish(debug_values_);
-  publishFloat32("current_map_error", part_original_accel_rmse_);
-  publishFloat32("updated_map_error", new_accel_rmse_);
-  publishFloat32(
-    "map_error_ratio",
-    part_original_accel_rmse_ != 0.0 ? new_accel_rmse_ / part_original_accel_rmse_ : 1.0);
+  /* publish map  & debug_values (skipped in offline mode, where nobody subscribes) */
+  if (!isOfflineMode()) {
+    publishMap(accel_map_value_, brake_map_value_, "original");
+    publishMap(update_accel_map_value_, update_brake_map_value_, "update");
+    publishOffsetCovMap(accel_offset_covariance_value_, brake_offset_covariance_value_);
+    publishCountMap();
+    publishIndex();
+    publishUpdateSuggestFlag();
+    debug_pub_->publish(debug_values_);
+    publishFloat32("current_map_error", part_original_accel_rmse_);
+    publishFloat32("updated_map_error", new_accel_rmse_);
+    publishFloat32(
+      "map_error_ratio",
+      part_original_accel_rmse_ != 0.0 ? new_accel_rmse_ / part_original_accel_rmse_ : 1.0);
+  }
 
   // -- processing start --
 
@@ -402,7 +525,7 @@ void AccelBrakeMapCalibrator::timerCallback()
 void AccelBrakeMapCalibrator::timerCallbackOutputCSV()
 {
   // write accel/ brake map to file
-  const auto ros_time = std::to_string(this->now().seconds());
+  const auto ros_time = std::to_string(getCurrentTime().seconds());
   writeMapToCSV(accel_vel_index_, accel_pedal_index_, update_accel_map_value_, output_accel_file_);
   writeMapToCSV(brake_vel_index_, brake_pedal_index_, update_brake_map_value_, output_brake_file_);
   if (progress_file_output_) {
@@ -456,7 +579,7 @@ void AccelBrakeMapCalibrator::callbackVelocity(const VelocityReport::ConstShared
 
     // calculate jerk
     if (
-      this->now().seconds() - pre_acceleration_time_ > timeout_sec_ ||
+      getCurrentTime().seconds() - pre_acceleration_time_ > timeout_sec_ ||
       (acceleration_time_ - pre_acceleration_time_) <= std::numeric_limits<double>::epsilon()) {
       RCLCPP_DEBUG_STREAM_THROTTLE(get_logger(), *get_clock(), 5000, "cannot calculate jerk");
       // does not update jerk
@@ -817,20 +940,6 @@ bool AccelBrakeMapCalibrator::updateFourCellAroundOffset(
   const bool accel_mode, const int accel_pedal_index, const int accel_vel_index,
   const int brake_pedal_index, const int brake_vel_index, const double measured_acc)
 {
-  // pre-defined
-  static Map accel_map_offset_vec_(
-    accel_map_value_.size(), std::vector<double>(accel_map_value_.at(0).size(), map_offset_));
-  static Map brake_map_offset_vec_(
-    brake_map_value_.size(), std::vector<double>(accel_map_value_.at(0).size(), map_offset_));
-  static std::vector<std::vector<Eigen::MatrixXd>> accel_covariance_mat_(
-    accel_map_value_.size() - 1,
-    std::vector<Eigen::MatrixXd>(
-      accel_map_value_.at(0).size() - 1, Eigen::MatrixXd::Identity(4, 4) * covariance_));
-  static std::vector<std::vector<Eigen::MatrixXd>> brake_covariance_mat_(
-    brake_map_value_.size() - 1,
-    std::vector<Eigen::MatrixXd>(
-      accel_map_value_.at(0).size() - 1, Eigen::MatrixXd::Identity(4, 4) * covariance_));
-
   auto & update_map_value = accel_mode ? update_accel_map_value_ : update_brake_map_value_;
   auto & offset_covariance_value =
     accel_mode ? accel_offset_covariance_value_ : brake_offset_covariance_value_;
@@ -859,25 +968,25 @@ bool AccelBrakeMapCalibrator::updateFourCellAroundOffset(
   const double yh = vel_index_.at(vel_index + 1);
   const double ry = (twist_ptr_->twist.linear.x - yl) / (yh - yl);
 
-  Eigen::Vector4d phi(4);
+  Eigen::Vector4d phi;
   phi << (1 - rx) * (1 - ry), rx * (1 - ry), (1 - rx) * ry, rx * ry;
 
-  Eigen::Vector4d theta(4);
+  Eigen::Vector4d theta;
   theta << zll, zhl, zlh, zhh;
 
-  Eigen::Vector4d weighted_sum(4);
+  Eigen::Vector4d weighted_sum;
   weighted_sum << data_weighted_num(pedal_index + 0, vel_index + 0),
     data_weighted_num(pedal_index + 1, vel_index + 0),
     data_weighted_num(pedal_index + 0, vel_index + 1),
     data_weighted_num(pedal_index + 1, vel_index + 1);
 
-  Eigen::Vector4d sigma(4);
+  Eigen::Vector4d sigma;
   sigma << data_covariance_mat(pedal_index + 0, vel_index + 0),
     data_covariance_mat(pedal_index + 1, vel_index + 0),
     data_covariance_mat(pedal_index + 0, vel_index + 1),
     data_covariance_mat(pedal_index + 1, vel_index + 1);
 
-  Eigen::Vector4d mean(4);
+  Eigen::Vector4d mean;
   mean << data_mean_mat(pedal_index + 0, vel_index + 0),
     data_mean_mat(pedal_index + 1, vel_index + 0), data_mean_mat(pedal_index + 0, vel_index + 1),
     data_mean_mat(pedal_index + 1, vel_index + 1);
@@ -887,29 +996,25 @@ bool AccelBrakeMapCalibrator::updateFourCellAroundOffset(
   const int ped_idx_l = pedal_index + 0;
   const int ped_idx_h = pedal_index + 1;
 
-  Eigen::VectorXd map_offset(4);
+  Eigen::Vector4d map_offset;
   map_offset(0) = map_offset_vec.at(ped_idx_l).at(vel_idx_l);
   map_offset(1) = map_offset_vec.at(ped_idx_h).at(vel_idx_l);
   map_offset(2) = map_offset_vec.at(ped_idx_l).at(vel_idx_h);
   map_offset(3) = map_offset_vec.at(ped_idx_h).at(vel_idx_h);
 
-  Eigen::VectorXd updated_map_offset(4);
-
-  Eigen::MatrixXd covariance = covariance_mat.at(ped_idx_l).at(vel_idx_l);
+  Eigen::Matrix4d covariance = covariance_mat.at(ped_idx_l).at(vel_idx_l);
 
   /* calculate adaptive map offset */
-  Eigen::MatrixXd G(4, 4);
-  Eigen::RowVectorXd phiT(4);
-  phiT = phi.transpose();
+  const Eigen::RowVector4d phiT = phi.transpose();
   double rk = phiT * covariance * phi;
 
-  G = covariance * phi / (forgetting_factor_ + rk);
+  const Eigen::Vector4d G = covariance * phi / (forgetting_factor_ + rk);
   double beta = rk > 0 ? (forgetting_factor_ - (1 - forgetting_factor_) / rk) : 1;
   covariance = covariance - covariance * phi * phiT * covariance / (1 / beta + rk);  // anti-windup
   double eta_hat = phiT * theta;
 
   const double error_map_offset = measured_acc - eta_hat;
-  updated_map_offset = map_offset + G * error_map_offset;
+  const Eigen::Vector4d updated_map_offset = map_offset + G * error_map_offset;
 
   for (int i = 0; i < 4; i++) {
     const double pre_mean = mean(i);
@@ -1243,14 +1348,14 @@ double AccelBrakeMapCalibrator::getStandardDeviation(const std::vector<double> &
 bool AccelBrakeMapCalibrator::isTimeout(
   const builtin_interfaces::msg::Time & stamp, const double timeout_sec)
 {
-  const double dt = this->now().seconds() - rclcpp::Time(stamp).seconds();
+  const double dt = getCurrentTime().seconds() - rclcpp::Time(stamp).seconds();
   return dt > timeout_sec;
 }
 
 bool AccelBrakeMapCalibrator::isTimeout(
   const DataStampedPtr & data_stamped, const double timeout_sec)
 {
-  const double dt = (this->now() - data_stamped->data_time).seconds();
+  const double dt = (getCurrentTime() - data_stamped->data_time).seconds();
   return dt > timeout_sec;
 }
 
@@ -22,7 +22,12 @@ int main(int argc, char ** argv)
 {
   rclcpp::init(argc, argv);
   rclcpp::NodeOptions node_options;
-  rclcpp::spin(std::make_shared<accel_brake_map_calibrator::AccelBrakeMapCalibrator>(node_options));
+  auto node = std::make_shared<accel_brake_map_calibrator::AccelBrakeMapCalibrator>(node_options);
+  if (node->isOfflineMode()) {
+    node->runOfflineCalibration();
+  } else {
+    rclcpp::spin(node);
+  }
   rclcpp::shutdown();
   return 0;
 }
@@ -15,6 +15,7 @@
 #ifndef RAW_VEHICLE_CMD_CONVERTER__ACCEL_MAP_HPP_
 #define RAW_VEHICLE_CMD_CONVERTER__ACCEL_MAP_HPP_
 
+#include "raw_vehicle_cmd_converter/column_major_map.hpp"
 #include "raw_vehicle_cmd_converter/csv_loader.hpp"
 
 #include <rclcpp/rclcpp.hpp>
@@ -43,6 +44,7 @@ private:
   std::vector<double> vel_index_;
   std::vector<double> throttle_index_;
   std::vector<std::vector<double>> accel_map_;
+  ColumnMajorMap accel_map_by_vel_;
 };
 }  // namespace raw_vehicle_cmd_converter
 
@@ -15,6 +15,7 @@
 #ifndef RAW_VEHICLE_CMD_CONVERTER__BRAKE_MAP_HPP_
 #define RAW_VEHICLE_CMD_CONVERTER__BRAKE_MAP_HPP_
 
+#include "raw_vehicle_cmd_converter/column_major_map.hpp"
 #include "raw_vehicle_cmd_converter/csv_loader.hpp"
 
 #include <rclcpp/rclcpp.hpp>
@@ -42,8 +43,8 @@ private:
   std::string vehicle_name_;
   std::vector<double> vel_index_;
   std::vector<double> brake_index_;
-  std::vector<double> brake_index_rev_;
   std::vector<std::vector<double>> brake_map_;
+  ColumnMajorMap brake_map_by_vel_;
 };
 }  // namespace raw_vehicle_cmd_converter
 
@@ -0,0 +1,87 @@
+//  Copyright 2023 Tier IV, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef RAW_VEHICLE_CMD_CONVERTER__COLUMN_MAJOR_MAP_HPP_
+#define RAW_VEHICLE_CMD_CONVERTER__COLUMN_MAJOR_MAP_HPP_
+
+#include "raw_vehicle_cmd_converter/csv_loader.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace raw_vehicle_cmd_converter
+{
+/**
+ * @brief index i of the segment [keys[i], keys[i + 1]] used to interpolate at the query, selected
+ * in the same way as interpolation::lerp
+ */
+size_t findSegmentIndex(const std::vector<double> & keys, const double query);
+
+/**
+ * @brief map stored contiguously column by column, so that the lookups at a fixed column key
+ * read two contiguous arrays and allocate nothing
+ */
+class ColumnMajorMap
+{
+public:
+  /**
+   * @brief values of all the rows linearly interpolated between two adjacent columns
+   */
+  class Column
+  {
+  public:
+    Column(const double * left, const double * right, const double ratio, const size_t size)
+    : left_(left), right_(right), ratio_(ratio), size_(size)
+    {
+    }
+    double operator[](const size_t row) const;
+    double front() const { return (*this)[0]; }
+    double back() const { return (*this)[size_ - 1]; }
+    size_t size() const { return size_; }
+
+    /**
+     * @brief index i of the segment [(*this)[i], (*this)[i + 1]] used to interpolate at the query,
+     * in O(log n) for the increasing or decreasing values
+     */
+    size_t findSegmentIndex(const double query, const bool is_increasing) const;
+
+    /**
+     * @brief interpolate the values paired with the rows at the query on the monotone column, as
+     * interpolation::lerp(column, values, query) does on the increasing or reversed column
+     */
+    double inverseLerp(
+      const std::vector<double> & values, const double query, const bool is_increasing) const;
+
+  private:
+    const double * left_;
+    const double * right_;
+    double ratio_;
+    size_t size_;
+  };
+
+  ColumnMajorMap() = default;
+  explicit ColumnMajorMap(const Map & map);
+
+  /**
+   * @brief column interpolated at the query within the given column keys
+   */
+  Column getColumn(const std::vector<double> & column_keys, const double query) const;
+
+private:
+  size_t rows_{0};
+  std::vector<double> values_;
+};
+}  // namespace raw_vehicle_cmd_converter
+
+#endif  // RAW_VEHICLE_CMD_CONVERTER__COLUMN_MAJOR_MAP_HPP_
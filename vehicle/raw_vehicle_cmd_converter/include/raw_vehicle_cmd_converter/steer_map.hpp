@@ -15,6 +15,7 @@
 #ifndef RAW_VEHICLE_CMD_CONVERTER__STEER_MAP_HPP_
 #define RAW_VEHICLE_CMD_CONVERTER__STEER_MAP_HPP_
 
+#include "raw_vehicle_cmd_converter/column_major_map.hpp"
 #include "raw_vehicle_cmd_converter/csv_loader.hpp"
 #include "raw_vehicle_cmd_converter/pid.hpp"
 
@@ -36,6 +37,7 @@ private:
   std::vector<double> steer_index_;
   std::vector<double> output_index_;
   std::vector<std::vector<double>> steer_map_;
+  ColumnMajorMap steer_map_by_steer_;
   rclcpp::Logger logger_{rclcpp::get_logger("raw_vehicle_cmd_converter").get_child("steer_map")};
 };
 }  // namespace raw_vehicle_cmd_converter
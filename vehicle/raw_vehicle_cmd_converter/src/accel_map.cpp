@@ -41,45 +41,43 @@ bool AccelMap::readAccelMapFromCSV(const std::string & csv_path, const bool vali
   if (validation && !CSVLoader::validateMap(accel_map_, true)) {
     return false;
   }
+  accel_map_by_vel_ = ColumnMajorMap(accel_map_);
   return true;
 }
 
 bool AccelMap::getThrottle(const double acc, double vel, double & throttle) const
 {
-  std::vector<double> interpolated_acc_vec;
   const double clamped_vel = CSVLoader::clampValue(vel, vel_index_, "throttle: vel");
   // (throttle, vel, acc) map => (throttle, acc) map by fixing vel
-  for (std::vector<double> accelerations : accel_map_) {
-    interpolated_acc_vec.push_back(interpolation::lerp(vel_index_, accelerations, clamped_vel));
-  }
+  const auto interpolated_acc = accel_map_by_vel_.getColumn(vel_index_, clamped_vel);
   // calculate throttle
   // When the desired acceleration is smaller than the throttle area, return false => brake sequence
   // When the desired acceleration is greater than the throttle area, return max throttle
-  if (acc < interpolated_acc_vec.front()) {
+  if (acc < interpolated_acc.front()) {
     return false;
-  } else if (interpolated_acc_vec.back() < acc) {
+  } else if (interpolated_acc.back() < acc) {
     throttle = throttle_index_.back();
     return true;
   }
-  throttle = interpolation::lerp(interpolated_acc_vec, throttle_index_, acc);
+  throttle = interpolated_acc.inverseLerp(throttle_index_, acc, true);
   return true;
 }
 
 bool AccelMap::getAcceleration(const double throttle, const double vel, double & acc) const
 {
-  std::vector<double> interpolated_acc_vec;
   const double clamped_vel = CSVLoader::clampValue(vel, vel_index_, "throttle: vel");
 
   // (throttle, vel, acc) map => (throttle, acc) map by fixing vel
-  for (const auto & acc_vec : accel_map_) {
-    interpolated_acc_vec.push_back(interpolation::lerp(vel_index_, acc_vec, clamped_vel));
-  }
+  const auto interpolated_acc = accel_map_by_vel_.getColumn(vel_index_, clamped_vel);
 
   // calculate throttle
   // When the desired acceleration is smaller than the throttle area, return min acc
   // When the desired acceleration is greater than the throttle area, return max acc
   const double clamped_throttle = CSVLoader::clampValue(throttle, throttle_index_, "throttle: acc");
-  acc = interpolation::lerp(throttle_index_, interpolated_acc_vec, clamped_throttle);
+  const size_t i = findSegmentIndex(throttle_index_, clamped_throttle);
+  const double ratio =
+    (clamped_throttle - throttle_index_[i]) / (throttle_index_[i + 1] - throttle_index_[i]);
+  acc = interpolation::lerp(interpolated_acc[i], interpolated_acc[i + 1], ratio);
 
   return true;
 }
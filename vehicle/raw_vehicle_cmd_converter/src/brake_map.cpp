@@ -35,62 +35,58 @@ bool BrakeMap::readBrakeMapFromCSV(const std::string & csv_path, const bool vali
   vel_index_ = CSVLoader::getRowIndex(table);
   brake_index_ = CSVLoader::getColumnIndex(table);
   brake_map_ = CSVLoader::getMap(table);
-  brake_index_rev_ = brake_index_;
   if (validation && !CSVLoader::validateMap(brake_map_, false)) {
     return false;
   }
-  std::reverse(std::begin(brake_index_rev_), std::end(brake_index_rev_));
+  brake_map_by_vel_ = ColumnMajorMap(brake_map_);
 
   return true;
 }
 
 bool BrakeMap::getBrake(const double acc, const double vel, double & brake)
 {
-  std::vector<double> interpolated_acc_vec;
   const double clamped_vel = CSVLoader::clampValue(vel, vel_index_, "brake: vel");
 
   // (throttle, vel, acc) map => (throttle, acc) map by fixing vel
-  for (std::vector<double> accelerations : brake_map_) {
-    interpolated_acc_vec.push_back(interpolation::lerp(vel_index_, accelerations, clamped_vel));
-  }
+  const auto interpolated_acc = brake_map_by_vel_.getColumn(vel_index_, clamped_vel);
 
   // calculate brake
   // When the desired acceleration is smaller than the brake area, return max brake on the map
   // When the desired acceleration is greater than the brake area, return min brake on the map
-  if (acc < interpolated_acc_vec.back()) {
+  if (acc < interpolated_acc.back()) {
     RCLCPP_WARN_SKIPFIRST_THROTTLE(
       logger_, clock_, 1000,
       "Exceeding the acc range. Desired acc: %f < min acc on map: %f. return max "
       "value.",
-      acc, interpolated_acc_vec.back());
+      acc, interpolated_acc.back());
     brake = brake_index_.back();
     return true;
-  } else if (interpolated_acc_vec.front() < acc) {
+  } else if (interpolated_acc.front() < acc) {
     brake = brake_index_.front();
     return true;
   }
 
-  std::reverse(std::begin(interpolated_acc_vec), std::end(interpolated_acc_vec));
-  brake = interpolation::lerp(interpolated_acc_vec, brake_index_rev_, acc);
+  // the acceleration decreases as the brake increases
+  brake = interpolated_acc.inverseLerp(brake_index_, acc, false);
 
   return true;
 }
 
 bool BrakeMap::getAcceleration(const double brake, const double vel, double & acc) const
 {
-  std::vector<double> interpolated_acc_vec;
   const double clamped_vel = CSVLoader::clampValue(vel, vel_index_, "brake: vel");
 
   // (throttle, vel, acc) map => (throttle, acc) map by fixing vel
-  for (const auto & acc_vec : brake_map_) {
-    interpolated_acc_vec.push_back(interpolation::lerp(vel_index_, acc_vec, clamped_vel));
-  }
+  const auto interpolated_acc = brake_map_by_vel_.getColumn(vel_index_, clamped_vel);
 
   // calculate brake
   // When the desired acceleration is smaller than the brake area, return min acc
   // When the desired acceleration is greater than the brake area, return min acc
   const double clamped_brake = CSVLoader::clampValue(brake, brake_index_, "brake: acc");
-  acc = interpolation::lerp(brake_index_, interpolated_acc_vec, clamped_brake);
+  const size_t i = findSegmentIndex(brake_index_, clamped_brake);
+  const double ratio =
+    (clamped_brake - brake_index_[i]) / (brake_index_[i + 1] - brake_index_[i]);
+  acc = interpolation::lerp(interpolated_acc[i], interpolated_acc[i + 1], ratio);
 
   return true;
 }
@@ -0,0 +1,97 @@
+//  Copyright 2023 Tier IV, Inc. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "raw_vehicle_cmd_converter/column_major_map.hpp"
+
+#include "interpolation/linear_interpolation.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace raw_vehicle_cmd_converter
+{
+size_t findSegmentIndex(const std::vector<double> & keys, const double query)
+{
+  if (keys.size() < 2) {
+    throw std::invalid_argument("The size of keys is less than 2.");
+  }
+  // first i such that keys[i + 1] >= query, up to the last segment
+  const auto it = std::lower_bound(keys.begin() + 1, keys.end() - 1, query);
+  return static_cast<size_t>(std::distance(keys.begin(), it)) - 1;
+}
+
+double ColumnMajorMap::Column::operator[](const size_t row) const
+{
+  return interpolation::lerp(left_[row], right_[row], ratio_);
+}
+
+size_t ColumnMajorMap::Column::findSegmentIndex(const double query, const bool is_increasing) const
+{
+  // number of the leading values on the near side of the query, in [lo, hi)
+  const auto partition_point = [&](size_t lo, size_t hi, const auto & is_before) {
+    while (lo < hi) {
+      const size_t mid = lo + (hi - lo) / 2;
+      if (is_before((*this)[mid])) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo;
+  };
+
+  if (size_ < 2) {
+    throw std::invalid_argument("The size of the column is less than 2.");
+  }
+  if (is_increasing) {
+    // first i such that (*this)[i + 1] >= query
+    return partition_point(1, size_ - 1, [&](const double v) { return v < query; }) - 1;
+  }
+  // on the reversed column, the first segment whose end is <= query from the back
+  const size_t n_not_less =
+    partition_point(0, size_ - 1, [&](const double v) { return v >= query; });
+  return n_not_less == 0 ? 0 : n_not_less - 1;
+}
+
+double ColumnMajorMap::Column::inverseLerp(
+  const std::vector<double> & values, const double query, const bool is_increasing) const
+{
+  const size_t i = findSegmentIndex(query, is_increasing);
+  // interpolate from the key nearer to the front of the increasing keys
+  const size_t from = is_increasing ? i : i + 1;
+  const size_t to = is_increasing ? i + 1 : i;
+  const double ratio = (query - (*this)[from]) / ((*this)[to] - (*this)[from]);
+  return interpolation::lerp(values.at(from), values.at(to), ratio);
+}
+
+ColumnMajorMap::ColumnMajorMap(const Map & map) : rows_(map.size())
+{
+  const size_t cols = map.empty() ? 0 : map.front().size();
+  values_.resize(rows_ * cols);
+  for (size_t row = 0; row < rows_; ++row) {
+    for (size_t col = 0; col < cols; ++col) {
+      values_[col * rows_ + row] = map[row][col];
+    }
+  }
+}
+
+ColumnMajorMap::Column ColumnMajorMap::getColumn(
+  const std::vector<double> & column_keys, const double query) const
+{
+  const size_t col = findSegmentIndex(column_keys, query);
+  const double ratio = (query - column_keys[col]) / (column_keys[col + 1] - column_keys[col]);
+  return Column(&values_[col * rows_], &values_[(col + 1) * rows_], ratio, rows_);
+}
+}  // namespace raw_vehicle_cmd_converter
@@ -38,19 +38,17 @@ bool SteerMap::readSteerMapFromCSV(const std::string & csv_path, const bool vali
   if (validation && !CSVLoader::validateMap(steer_map_, true)) {
     return false;
   }
+  steer_map_by_steer_ = ColumnMajorMap(steer_map_);
   return true;
 }
 
 void SteerMap::getSteer(const double steer_rate, const double steer, double & output) const
 {
   const double clamped_steer = CSVLoader::clampValue(steer, steer_index_, "steer: steer");
-  std::vector<double> steer_rate_interp = {};
-  for (const auto & steer_rate_vec : steer_map_) {
-    steer_rate_interp.push_back(interpolation::lerp(steer_index_, steer_rate_vec, clamped_steer));
-  }
+  const auto steer_rate_interp = steer_map_by_steer_.getColumn(steer_index_, clamped_steer);
 
-  const double clamped_steer_rate =
-    CSVLoader::clampValue(steer_rate, steer_rate_interp, "steer: steer_rate");
-  output = interpolation::lerp(steer_rate_interp, output_index_, clamped_steer_rate);
+  const double clamped_steer_rate = CSVLoader::clampValue(
+    steer_rate, steer_rate_interp.front(), steer_rate_interp.back(), "steer: steer_rate");
+  output = steer_rate_interp.inverseLerp(output_index_, clamped_steer_rate, true);
 }
 }  // namespace raw_vehicle_cmd_converter